@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COMPONENTHANDLE_HH_
+#define GZ_SIM_COMPONENTHANDLE_HH_
+
+#include <cstdint>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/EntityComponentManager.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class ComponentHandle ComponentHandle.hh gz/sim/ComponentHandle.hh
+    /// \brief A cached reference to a component of an entity, which can be
+    /// kept across simulation steps to avoid looking the component up in the
+    /// EntityComponentManager every time it's used.
+    ///
+    /// The handle keeps a pointer to the component, together with a counter
+    /// of the manager that changes whenever components may be destroyed,
+    /// such as when components or entities are removed. Accessing the
+    /// component only compares that counter while it's unchanged, and looks
+    /// the component up again otherwise. While the entity doesn't have the
+    /// component, it's looked up again only after components are added to
+    /// any entity, so the handle picks up the component once it's created,
+    /// and checking for components that are usually missing is cheap too.
+    ///
+    /// Like EntityComponentManager::Component, modifying the component
+    /// through the handle doesn't mark it as changed. The handle must not
+    /// outlive its manager.
+    ///
+    /// Usage:
+    /// \code
+    ///   // Once, for example in Configure
+    ///   this->poseHandle = _ecm.Handle<components::Pose>(entity);
+    ///
+    ///   // Every step
+    ///   if (auto pose = this->poseHandle.Get())
+    ///     pose->Data().Pos().X() += 1.0;
+    /// \endcode
+    ///
+    /// \tparam ComponentTypeT Type of the component.
+    template<typename ComponentTypeT>
+    class ComponentHandle
+    {
+      /// \brief Default constructor. The handle doesn't refer to any
+      /// component.
+      public: ComponentHandle() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _ecm Manager that holds the component.
+      /// \param[in] _entity Entity that has the component.
+      public: ComponentHandle(EntityComponentManager &_ecm,
+                  const sim::Entity _entity)
+        : ecm(&_ecm), entity(_entity)
+      {
+        this->Refresh();
+      }
+
+      /// \brief Get the component, looking it up again if it may have been
+      /// removed since the last access.
+      /// \return The component, or nullptr if the entity doesn't have it.
+      public: ComponentTypeT *Get()
+      {
+        if (nullptr == this->ecm)
+          return nullptr;
+
+        if (this->version != this->ecm->StorageVersion() ||
+            (nullptr == this->component &&
+             this->creationVersion != this->ecm->CreationVersion()))
+        {
+          this->Refresh();
+        }
+        return this->component;
+      }
+
+      /// \brief Check whether the cached pointer can still be used without
+      /// looking the component up again. This is a cheap check, and a false
+      /// result doesn't mean that the entity doesn't have the component
+      /// anymore, only that Get() will look it up.
+      /// \return True if the cached pointer is current.
+      public: bool Valid() const
+      {
+        return nullptr != this->ecm && nullptr != this->component &&
+            this->version == this->ecm->StorageVersion();
+      }
+
+      /// \brief Get the entity the handle refers to.
+      /// \return The entity, or kNullEntity for default constructed handles.
+      public: sim::Entity Entity() const
+      {
+        return this->entity;
+      }
+
+      /// \brief Access the component. It must exist.
+      /// \return The component.
+      public: ComponentTypeT *operator->()
+      {
+        return this->Get();
+      }
+
+      /// \brief Access the component. It must exist.
+      /// \return The component.
+      public: ComponentTypeT &operator*()
+      {
+        return *this->Get();
+      }
+
+      /// \brief Check whether the entity has the component. This looks the
+      /// component up again if needed.
+      /// \return True if the component exists.
+      public: explicit operator bool()
+      {
+        return nullptr != this->Get();
+      }
+
+      /// \brief Look the component up in the manager.
+      private: void Refresh()
+      {
+        this->version = this->ecm->StorageVersion();
+        this->creationVersion = this->ecm->CreationVersion();
+        this->component = this->ecm->template Component<ComponentTypeT>(
+            this->entity);
+      }
+
+      /// \brief Manager that holds the component.
+      private: EntityComponentManager *ecm{nullptr};
+
+      /// \brief Entity that has the component.
+      private: sim::Entity entity{kNullEntity};
+
+      /// \brief Cached pointer to the component.
+      private: ComponentTypeT *component{nullptr};
+
+      /// \brief Storage version of the manager when the component was looked
+      /// up.
+      private: std::uint64_t version{0};
+
+      /// \brief Creation version of the manager when the component was
+      /// looked up.
+      private: std::uint64_t creationVersion{0};
+    };
+
+    //////////////////////////////////////////////////
+    template<typename ComponentTypeT>
+    ComponentHandle<ComponentTypeT> EntityComponentManager::Handle(
+        const Entity _entity)
+    {
+      return ComponentHandle<ComponentTypeT>(*this, _entity);
+    }
+    }
+  }
+}
+#endif
@@ -20,6 +20,8 @@
 #include <gz/msgs/serialized.pb.h>
 #include <gz/msgs/serialized_map.pb.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
@@ -33,6 +35,7 @@
 #include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/math/Pose3.hh>
 #include <gz/math/graph/Graph.hh>
 #include "gz/sim/Entity.hh"
 #include "gz/sim/Export.hh"
@@ -50,6 +53,10 @@ namespace gz
     // Forward declarations.
     class GZ_SIM_HIDDEN EntityComponentManagerPrivate;
     class EntityComponentManagerDiff;
+    class FrameArena;
+    class StateSnapshotWriter;
+    class WrenchAccumulator;
+    template<typename ComponentTypeT> class ComponentHandle;
 
     /// \brief Type alias for the graph that holds entities.
     /// Each vertex is an entity, and the direction points from the parent to
@@ -80,6 +87,64 @@ namespace gz
       /// \param[in] _from Object to copy from
       public: void CopyFrom(const EntityComponentManager &_fromEcm);
 
+      /// \brief Make this a copy-on-write fork of another manager. It holds
+      /// the same entities and components as after CopyFrom, but components
+      /// are shared with _fromEcm until they may be written, through
+      /// non-const accessors such as Component, SetComponentData or Each,
+      /// which copies all components of that type. Forking is therefore
+      /// cheap, and a fork only copies the types it writes, such as poses
+      /// and velocities.
+      /// _fromEcm must outlive the fork, and the components it shares must
+      /// not be changed or removed until the fork is destroyed or reset with
+      /// CopyFrom, so it's typically paused while forks run.
+      /// All entities of the fork are new, so that systems stepping it
+      /// create their state from them.
+      /// \param[in] _fromEcm Object to fork.
+      /// \sa CopyFrom
+      public: void ForkFrom(const EntityComponentManager &_fromEcm);
+
+      /// \brief Move all entities and components of another manager into
+      /// this one in a single batch, without copying them. This lets
+      /// entities be created concurrently in separate staging managers,
+      /// which are then committed one after the other.
+      /// Entity IDs are kept, so the staging manager must create IDs that
+      /// aren't used by this one, see SetEntityCreateOffset. The moved
+      /// entities are new, and their components are marked as changed.
+      /// \param[in, out] _fromEcm Staging manager, which is left empty.
+      /// \return False if an entity of _fromEcm already exists in this
+      /// manager, in which case nothing is moved.
+      public: bool MoveEntitiesFrom(EntityComponentManager &_fromEcm);
+
+      /// \brief Start inserting many entities and components at once, for
+      /// example while loading a world or spawning a model. Until the
+      /// matching EndBulkInsert, new components aren't checked against every
+      /// view; the inserted entities are added to the views once, when the
+      /// bulk insert ends or the next time a view is looked up.
+      /// Calls can be nested, and only the outermost EndBulkInsert updates
+      /// the views.
+      /// \param[in] _entities Expected number of new entities, used to
+      /// reserve storage. Zero if unknown.
+      /// \sa EndBulkInsert
+      public: void BeginBulkInsert(std::size_t _entities = 0);
+
+      /// \brief Finish inserting entities started with BeginBulkInsert, and
+      /// add the inserted entities to the views that match them.
+      /// \sa BeginBulkInsert
+      public: void EndBulkInsert();
+
+      /// \brief Set the memory layout used to store components. The layout
+      /// can only be changed while the manager holds no components, typically
+      /// right after construction.
+      /// \param[in] _type Storage layout to use.
+      /// \return True if the layout was changed, false if components have
+      /// already been created.
+      /// \sa ComponentStorageType
+      public: bool SetComponentStorage(const ComponentStorageType _type);
+
+      /// \brief Get the memory layout used to store components.
+      /// \return The storage layout.
+      public: ComponentStorageType ComponentStorage() const;
+
       /// \brief Creates a new Entity.
       /// \return An id for the Entity, or kNullEntity on failure.
       public: Entity CreateEntity();
@@ -253,7 +318,9 @@ namespace gz
       /// component type.
       /// \param[in] _entity The entity.
       /// \return The component of the specified type assigned to specified
-      /// Entity, or nullptr if the component could not be found.
+      /// Entity, or nullptr if the component could not be found. If the
+      /// component is shared among entities, the pointer is invalidated when
+      /// the entity gets its own copy, see InternComponents.
       public: template<typename ComponentTypeT>
               const ComponentTypeT *Component(const Entity _entity) const;
 
@@ -265,6 +332,29 @@ namespace gz
       public: template<typename ComponentTypeT>
               ComponentTypeT *Component(const Entity _entity);
 
+      /// \brief Get the pose of an entity in the world frame, composing the
+      /// Pose components of the entity and of its ancestors through their
+      /// ParentEntity components, up to the first ancestor without a pose.
+      /// While systems run PostUpdate, poses can't change, so the result
+      /// for each entity and its ancestors is computed once per iteration
+      /// and shared by all callers.
+      /// \param[in] _entity The entity.
+      /// \return The world pose, or std::nullopt if the entity doesn't have
+      /// a Pose component.
+      /// \sa gz::sim::worldPose
+      public: std::optional<math::Pose3d> WorldPose(const Entity _entity)
+                  const;
+
+      /// \brief Get a handle to a component of an entity, which caches the
+      /// component so that later accesses don't need to look it up. Handles
+      /// can be kept across simulation steps.
+      /// \param[in] _entity The entity.
+      /// \return A handle to the component. Its Get function returns nullptr
+      /// while the entity doesn't have the component.
+      /// \sa ComponentHandle
+      public: template<typename ComponentTypeT>
+              ComponentHandle<ComponentTypeT> Handle(const Entity _entity);
+
       /// \brief Get a mutable component assigned to an entity based on a
       /// component type. If the component doesn't exist, create it and
       /// initialize with the given default value.
@@ -304,6 +394,20 @@ namespace gz
               bool SetComponentData(const Entity _entity,
               const typename ComponentTypeT::Type &_data);
 
+      /// \brief Set the data of a component on an entity and on all its
+      /// descendants that have all of the given component types, such as
+      /// all the visuals of a model, including nested models. The new
+      /// components are inserted in bulk, see BeginBulkInsert, and changed
+      /// components are marked as one-time changes.
+      /// \param[in] _entity Root of the subtree.
+      /// \param[in] _data New component data
+      /// \tparam ComponentTypeT Component type
+      /// \tparam FilterTypeTs Component types an entity must have to be set.
+      /// \return Number of entities whose component was created or changed.
+      public: template<typename ComponentTypeT, typename ...FilterTypeTs>
+              std::size_t SetDescendantsComponentData(const Entity _entity,
+              const typename ComponentTypeT::Type &_data);
+
       /// \brief Get the type IDs of all components attached to an entity.
       /// \param[in] _entity Entity to check.
       /// \return All the component type IDs.
@@ -317,7 +421,9 @@ namespace gz
       ///  auto entity = EntityByComponents(components::Name("name"),
       ///    components::Model());
       ///
-      /// \details Component type must have inequality operator.
+      /// \details Component type must have inequality operator. If one of
+      /// the components is a name, only the entities with that name are
+      /// checked, as returned by EntitiesByName or ChildrenByName.
       ///
       /// \param[in] _desiredComponents All the components which must match.
       /// \return Entity or kNullEntity if no entity has the exact components.
@@ -332,7 +438,9 @@ namespace gz
       ///  auto entities = EntitiesByComponents(components::Name("camera"),
       ///    components::Sensor());
       ///
-      /// \details Component type must have inequality operator.
+      /// \details Component type must have inequality operator. If one of
+      /// the components is a name, only the entities with that name are
+      /// checked, as returned by EntitiesByName or ChildrenByName.
       ///
       /// \param[in] _desiredComponents All the components which must match.
       /// \return All matching entities, or an empty vector if no child entity
@@ -360,10 +468,59 @@ namespace gz
               std::vector<Entity> ChildrenByComponents(Entity _parent,
                    const ComponentTypeTs &..._desiredComponents) const;
 
+      /// \brief Get all entities with a name. The names are kept in a hash
+      /// index, so this doesn't visit other entities. The index follows
+      /// names created, removed or set with SetComponentData(). Since names
+      /// and parents may be written through the mutable pointers returned
+      /// by Component(), the index is rebuilt after such a pointer was
+      /// obtained. Pointers kept across calls must still be marked with
+      /// SetChanged() after writing. This is thread safe.
+      /// \param[in] _name Name of the entities.
+      /// \return The entities, sorted, or an empty vector if none has the
+      /// name.
+      /// \sa ChildrenByName
+      public: std::vector<Entity> EntitiesByName(
+                  const std::string &_name) const;
+
+      /// \brief Get all entities with a name whose
+      /// `components::ParentEntity` is a given entity, from the same index
+      /// as EntitiesByName. This is thread safe.
+      /// \param[in] _parent Parent of the entities, or kNullEntity for
+      /// entities without a parent.
+      /// \param[in] _name Name of the entities.
+      /// \return The entities, sorted, or an empty vector if none matches.
+      public: std::vector<Entity> ChildrenByName(Entity _parent,
+                  const std::string &_name) const;
+
       /// why is this required?
       private: template <typename T>
                struct identity;  // NOLINT
 
+      /// \brief Update the name index after the name or parent component of
+      /// an entity was set.
+      /// \param[in] _entity The entity.
+      /// \param[in] _typeId Type of the component.
+      private: void MarkNameChanged(const Entity _entity,
+                   const ComponentTypeId _typeId);
+
+      /// \brief Get the entities from the name index that share the name,
+      /// and the parent if given, of a list of components.
+      /// \param[in] _components Components to match.
+      /// \return The entities, sorted, or nullopt if none of the components
+      /// is a `components::Name`.
+      private: template<typename ...ComponentTypeTs>
+               std::optional<std::vector<Entity>> EntitiesByNameOf(
+                   const ComponentTypeTs &..._components) const;
+
+      /// \brief Check whether an entity has all the given components, with
+      /// equal values.
+      /// \param[in] _entity The entity.
+      /// \param[in] _components Components to compare.
+      /// \return True if all components match.
+      private: template<typename ...ComponentTypeTs>
+               bool EntityHasComponents(Entity _entity,
+                   const ComponentTypeTs &..._components) const;
+
       /// \brief Helper function for cloning an entity and its children (this
       /// includes cloning components attached to these entities). This method
       /// should never be called directly - it is called internally from the
@@ -447,6 +604,51 @@ namespace gz
                   bool(const Entity &_entity,
                        ComponentTypeTs *...)>>::type _f);
 
+      /// \brief Parallel version of Each(). The entities which contain the
+      /// given component types are split into chunks that are processed
+      /// concurrently by a process-wide thread pool, and the call blocks
+      /// until every entity has been visited. Entities are not visited in
+      /// any particular order and iteration can't be stopped early.
+      ///
+      /// The callback may be called concurrently from several threads, so
+      /// it must only:
+      /// * read and modify the data of the components that are passed to it;
+      /// * read other components through Component() or ComponentData().
+      ///
+      /// Anything that modifies the manager itself is not allowed inside the
+      /// callback. This includes creating or removing entities and
+      /// components, SetComponentData(), SetChanged(), and functions that
+      /// may create views, such as Each(), EachNew(), EntityByComponents()
+      /// or ChildrenByComponents(). Collect the results in per-entity storage
+      /// and apply such changes after this call returns.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \param[in] _grainSize Maximum number of entities processed by each
+      /// chunk. Zero picks a size based on the number of threads.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      public: template<typename ...ComponentTypeTs>
+              void EachParallel(typename identity<std::function<
+                  void(const Entity &_entity,
+                       const ComponentTypeTs *...)>>::type _f,
+                  std::size_t _grainSize = 0) const;
+
+      /// \brief Parallel version of Each() with mutable components.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \param[in] _grainSize Maximum number of entities processed by each
+      /// chunk. Zero picks a size based on the number of threads.
+      /// \tparam ComponentTypeTs All the desired mutable component types.
+      /// \sa EachParallel(std::function<void(const Entity &,
+      /// const ComponentTypeTs *...)>, std::size_t) const for the rules that
+      /// apply to the callback.
+      public: template<typename ...ComponentTypeTs>
+              void EachParallel(typename identity<std::function<
+                  void(const Entity &_entity,
+                       ComponentTypeTs *...)>>::type _f,
+                  std::size_t _grainSize = 0);
+
       /// \brief Call a function for each parameter in a pack.
       /// \param[in] _f Function to be called.
       /// \param[in] _components Parameters which should be passed to the
@@ -506,7 +708,9 @@ namespace gz
                        const ComponentTypeTs *...)>>::type _f) const;
 
       /// \brief Get a graph with all the entities. Entities are vertices and
-      /// edges point from parent to children.
+      /// edges point from parent to children. The graph is built on demand
+      /// and cached until entities or their parents change, so prefer
+      /// ParentEntity, Descendants or ChildrenByComponents for queries.
       /// \return Entity graph.
       public: const EntityGraph &Entities() const;
 
@@ -517,6 +721,52 @@ namespace gz
       /// empty if the entity doesn't exist.
       public: std::unordered_set<Entity> Descendants(Entity _entity) const;
 
+      /// \brief Share one instance of a component type among the entities
+      /// whose components hold the same data, such as the sensors of many
+      /// copies of a robot. Data is identified by the serialized component,
+      /// plus the SDF for SDF DOM objects, see
+      /// components::ComponentDataOps::InternKey.
+      ///
+      /// An entity gets its own copy again as soon as its component may be
+      /// written: through the non-const Component function, or through Each
+      /// and EachNew with non-const component pointers, which copy the
+      /// components of all entities. Reading through a const manager keeps
+      /// them shared. This must not be called while systems are running.
+      ///
+      /// Sharing and unsharing replace the component instance of an entity,
+      /// so pointers to components of the type, including const pointers
+      /// kept from earlier reads, are invalidated by this call and by any
+      /// later write of the type that copies a shared component back.
+      /// Components must be looked up again instead of keeping pointers
+      /// to them across steps. The server only calls this if
+      /// ServerConfig::SetShareIdenticalComponents is enabled.
+      /// \param[in] _type Id of the component type.
+      /// \param[in] _newEntitiesOnly True to only consider the entities
+      /// created since the last ClearNewlyCreatedEntities. They still share
+      /// the instances of the other entities.
+      /// \return Number of components whose data is now held by another
+      /// entity's component.
+      public: std::size_t InternComponents(const ComponentTypeId _type,
+                  const bool _newEntitiesOnly = false);
+
+      /// \brief Get the memory held by the components of each type. Heap
+      /// usage is estimated by each component type's descriptor, see
+      /// components::ComponentHeapSize. Components marked as removed aren't
+      /// counted, and the memory of components shared among entities is
+      /// counted once, see InternComponents.
+      /// \return Memory usage keyed by component type.
+      public: std::map<ComponentTypeId, ComponentMemoryUsage>
+                  ComponentMemoryUsageByType() const;
+
+      /// \brief Get the memory held by the components of each top-level
+      /// model, that is, a model whose parent isn't a model, and all of its
+      /// descendants. Components of entities outside of models, such as the
+      /// world and its lights, are keyed by kNullEntity.
+      /// \return Memory usage keyed by top-level model entity.
+      /// \sa ComponentMemoryUsageByType
+      public: std::map<Entity, ComponentMemoryUsage>
+                  ComponentMemoryUsageByModel() const;
+
       /// \brief Get a message with the serialized state of the given entities
       /// and components.
       /// \details The header of the message will not be populated, it is the
@@ -551,6 +801,39 @@ namespace gz
       /// \return True if there are entities marked to be removed.
       public: bool HasEntitiesMarkedForRemoval() const;
 
+      /// \brief Get the accumulator for wrenches that systems add to links
+      /// during the current step, which are applied before physics. Adding
+      /// wrenches to it only reads the manager, so it can be done from
+      /// PostUpdate or from several threads.
+      /// \return The accumulator of the simulation runner that owns this
+      /// manager, or null when systems aren't updated by a runner, such as
+      /// in tests.
+      /// \sa WrenchAccumulator
+      public: WrenchAccumulator *Wrenches() const;
+
+      /// \brief Get memory for scratch data of systems that's released
+      /// after PostUpdate, so it's only valid during the current step. It
+      /// may be used concurrently from PostUpdate.
+      /// \return The arena of the simulation runner that owns this manager,
+      /// or null when systems aren't updated by a runner, such as in tests.
+      /// \sa FrameArena
+      public: FrameArena *StepArena() const;
+
+      /// \brief Get data shared by the systems of the world simulated by
+      /// this manager, such as an index of entities they all query,
+      /// creating it if no system holds it. It's destroyed once no system
+      /// holds it, or with the manager, and it isn't copied by CopyFrom or
+      /// ForkFrom, since copies and forks simulate separate worlds. It may
+      /// be called concurrently.
+      /// \tparam T Type of the data, default constructible.
+      /// \param[in] _key Name of the data, unique among the systems that
+      /// share data, such as the name of the system.
+      /// \return The data, the same for every caller with the same key, or
+      /// null if the key is used for another type.
+      public: template<typename T>
+              std::shared_ptr<T> SystemSharedData(
+                  const std::string &_key) const;
+
       /// \brief Get whether there are one-time component changes. These changes
       /// do not happen frequently and should be processed immediately.
       /// \return True if there are any components with one-time changes.
@@ -631,8 +914,24 @@ namespace gz
       /// \param[in] _state New serialized state.
       /// \details The header of the message will not be populated, it is the
       /// responsibility of the caller to timestamp it before use.
+      /// While systems run PostUpdate, the changed state is serialized only
+      /// once per iteration and shared by all callers.
       public: void ChangedState(msgs::SerializedStateMap &_state) const;
 
+      /// \brief Get a message with the serialized state of some of the
+      /// entities and components that are changing in the current iteration.
+      /// Unlike filtering the result of ChangedState, the entities and
+      /// components that are left out aren't serialized at all.
+      /// \param[out] _state The serialized state message to populate.
+      /// \param[in] _entities Entities to be serialized. Leave empty to get
+      /// all entities.
+      /// \param[in] _types Type ID of components to be serialized. Leave empty
+      /// to get all components.
+      /// \sa ChangedState(msgs::SerializedStateMap &)
+      public: void ChangedState(msgs::SerializedStateMap &_state,
+                  const std::unordered_set<Entity> &_entities,
+                  const std::unordered_set<ComponentTypeId> &_types) const;
+
       /// \brief Set the absolute state of the ECM from a serialized message.
       /// Entities / components that are in the new state but not in the old
       /// one will be created.
@@ -640,9 +939,51 @@ namespace gz
       /// they won't be removed if they're not present in the state.
       /// \details The header of the message will not be handled, it is the
       /// responsibility of the caller to use the timestamp.
+      /// The components are deserialized concurrently, then added and marked
+      /// as changed on the calling thread.
       /// \param[in] _stateMsg Message containing state to be set.
       public: void SetState(const msgs::SerializedStateMap &_stateMsg);
 
+      /// \brief Write the same changes as ChangedState into a flat binary
+      /// snapshot, an alternative wire format to msgs::SerializedStateMap.
+      /// Components whose data has a fixed layout, such as poses, velocities
+      /// and joint positions, are copied without allocating, and the others
+      /// fall back to their stream serialization.
+      /// \param[out] _buffer Buffer that receives the snapshot. Its previous
+      /// contents are discarded, but its capacity is reused, so keeping the
+      /// buffer across iterations avoids allocations.
+      /// \sa SetStateSnapshot
+      public: void ChangedStateSnapshot(std::vector<std::uint8_t> &_buffer)
+                  const;
+
+      /// \brief Write the state of entities and components into a flat
+      /// binary snapshot.
+      /// \param[out] _buffer Buffer that receives the snapshot. Its previous
+      /// contents are discarded, but its capacity is reused.
+      /// \param[in] _entities Entities to be serialized. Leave empty to get
+      /// all entities.
+      /// \param[in] _types Type ID of components to be serialized. Leave empty
+      /// to get all components.
+      /// \param[in] _full True to get all the entities and components.
+      /// False will get only components and entities that have changed.
+      /// \sa SetStateSnapshot
+      public: void StateSnapshot(std::vector<std::uint8_t> &_buffer,
+                  const std::unordered_set<Entity> &_entities = {},
+                  const std::unordered_set<ComponentTypeId> &_types = {},
+                  bool _full = false) const;
+
+      /// \brief Set the state of the ECM from a flat binary snapshot, with
+      /// the same semantics as SetState(const msgs::SerializedStateMap &).
+      /// The snapshot is read in place, so it can point into a memory mapped
+      /// file.
+      /// \param[in] _data Start of the snapshot.
+      /// \param[in] _size Size of the snapshot in bytes.
+      /// \return False if the snapshot is malformed. Records before the
+      /// malformed one are still applied.
+      /// \sa ChangedStateSnapshot
+      public: bool SetStateSnapshot(const std::uint8_t *_data,
+                  std::size_t _size);
+
       /// \brief Set the changed state of a component.
       /// \param[in] _entity The entity.
       /// \param[in] _type Type of the component.
@@ -658,12 +999,122 @@ namespace gz
       public: sim::ComponentState ComponentState(const Entity _entity,
           const ComponentTypeId _typeId) const;
 
+      /// \brief Get the entities whose component of a given type is marked
+      /// as changed, either as a one-time or a periodic change. This is
+      /// cheaper than checking the state of the component of every entity
+      /// when few of them change.
+      /// \param[in] _typeId Component type ID.
+      /// \return Entities with a changed component of that type.
+      public: std::unordered_set<Entity> EntitiesWithChangedComponent(
+          const ComponentTypeId _typeId) const;
+
+      /// \brief Get the version stamp of the latest change. Every component
+      /// creation, change marked with SetChanged, and removal gets the next
+      /// stamp. Unlike the changed state, stamps aren't cleared at the end of
+      /// an iteration, so a consumer that doesn't run every iteration can
+      /// keep the stamp of its last look and pass it to ChangesSince.
+      /// \return The stamp, or 0 if nothing changed yet.
+      /// \sa ChangesSince
+      public: std::uint64_t ChangeVersion() const;
+
+      /// \brief Get a stamp that changes after components may have been
+      /// written through mutable pointers, such as the ones returned by
+      /// Component() and used by SetComponentData(). These writes aren't
+      /// stamped by ChangeVersion unless they're marked with SetChanged, so
+      /// consumers that keep data derived from components compare this
+      /// stamp too. Pointers kept and written later must still be marked
+      /// with SetChanged. Copies start with the stamp of the manager they
+      /// were copied from.
+      /// \return The stamp.
+      /// \sa ChangeVersion
+      public: std::uint64_t PointerWriteVersion() const;
+
+      /// \brief Get the version stamp of the latest change to a component.
+      /// Components modified without being marked as changed keep their
+      /// stamp.
+      /// \param[in] _entity Entity that contains the component.
+      /// \param[in] _typeId Component type ID.
+      /// \return The stamp, or 0 if the entity doesn't have the component.
+      public: std::uint64_t ComponentVersion(const Entity _entity,
+          const ComponentTypeId _typeId) const;
+
+      /// \brief Get the changes made after a version stamp. This visits the
+      /// stamps of the component types that changed since, so it's much
+      /// cheaper than taking the full state.
+      /// \param[in] _version Stamp of the last look, as returned by
+      /// ChangeVersion.
+      /// \param[out] _changed Components created or changed since, keyed by
+      /// type.
+      /// \param[out] _removedEntities Entities removed since.
+      /// \param[out] _removedComponents Components removed since from
+      /// entities that still exist, keyed by type.
+      /// \return False if the stamp is older than the removals that are
+      /// kept, in which case some removals are missing and the full state
+      /// should be taken instead.
+      /// \sa ChangeVersion
+      public: bool ChangesSince(std::uint64_t _version,
+          std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+          &_changed,
+          std::unordered_set<Entity> &_removedEntities,
+          std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+          &_removedComponents) const;
+
+      /// \brief Get the entities whose component of one type was created or
+      /// changed after a version stamp. Only the stamps of that type are
+      /// visited, so this is cheaper than ChangesSince for consumers that
+      /// track a few rarely changing types.
+      /// \param[in] _version Stamp of the last look, as returned by
+      /// ChangeVersion.
+      /// \param[in] _typeId Component type ID.
+      /// \return Entities with a component of that type created or changed
+      /// since.
+      /// \sa ChangesSince
+      public: std::unordered_set<Entity> EntitiesChangedSince(
+          std::uint64_t _version, const ComponentTypeId _typeId) const;
+
       /// \brief All future entities will have an id that starts at _offset.
       /// This can be used to avoid entity id collisions, such as during log
       /// playback.
       /// \param[in] _offset Offset value.
       public: void SetEntityCreateOffset(uint64_t _offset);
 
+      /// \brief Get the offset from which new entity IDs are created. It's
+      /// the ID of the entity created last, and the next entity gets the ID
+      /// that follows it.
+      /// \return Offset value.
+      /// \sa SetEntityCreateOffset
+      public: uint64_t EntityCreateOffset() const;
+
+      /// \brief Set whether every live entity gets a dense index, which is
+      /// recycled when the entity is removed. Entity IDs themselves are
+      /// unchanged: they use the full range of Entity, follow the entity
+      /// create offset, and are never reused, so a new entity never gets the
+      /// ID of one that was removed.
+      /// This can only be changed before any entity is created.
+      /// \param[in] _recycle True to recycle entity indices.
+      /// \return False if entities were already created.
+      /// \sa EntityIndex
+      public: bool SetEntityIdRecycling(bool _recycle);
+
+      /// \brief Get whether the indices of removed entities are recycled.
+      /// \return True if indices are recycled.
+      /// \sa SetEntityIdRecycling
+      public: bool EntityIdRecycling() const;
+
+      /// \brief Get the dense index of an entity, which can be used to keep
+      /// per-entity data in flat arrays. Indices are only available while
+      /// entity index recycling is enabled, see SetEntityIdRecycling, and
+      /// are reused by new entities after an entity is removed.
+      /// \param[in] _entity The entity.
+      /// \return The index, smaller than EntityIndexCapacity(), or
+      /// std::nullopt if the entity doesn't have one.
+      public: std::optional<std::size_t> EntityIndex(
+                  const Entity _entity) const;
+
+      /// \brief Get the size of flat arrays indexed by EntityIndex.
+      /// \return One past the largest index handed out so far.
+      public: std::size_t EntityIndexCapacity() const;
+
       /// \brief Given a diff, apply it to this ECM. Note that for removed
       /// entities, this would mark them for removal instead of actually
       /// removing the entities.
@@ -671,6 +1122,26 @@ namespace gz
       /// was computed.
       public: void ResetTo(const EntityComponentManager &_other);
 
+      /// \brief Reset this ECM to another one, touching only what differs
+      /// between them, which is much cheaper than ResetTo when most of the
+      /// world is unchanged. Entities missing from _other are marked for
+      /// removal and entities missing from this ECM are created as new ones,
+      /// as with ResetTo. Entities in both keep their state otherwise:
+      /// components are added and removed to match _other, and components
+      /// whose data differs are overwritten in place and marked as one-time
+      /// changes. Data that can't be compared is always overwritten.
+      ///
+      /// If _other is an unmodified copy of this ECM, made with CopyFrom,
+      /// only the components changed since the copy are compared, so the
+      /// reset takes time proportional to the changes rather than to the
+      /// world. Components written through pointers without being marked as
+      /// changed are found by their type, so all components of the types
+      /// that were ever written this way are compared.
+      /// \param[in] _other EntityComponentManager to reset to, typically a
+      /// copy of this one made earlier.
+      /// \sa ResetTo
+      public: void IncrementalResetTo(const EntityComponentManager &_other);
+
       /// \brief Return true if there are components marked for removal.
       /// \return True if there are components marked for removal.
       public: bool HasRemovedComponents() const;
@@ -692,6 +1163,22 @@ namespace gz
       /// \brief Mark all components as not changed.
       protected: void SetAllComponentsUnchanged();
 
+      /// \brief Set whether ChangedState(msgs::SerializedStateMap &) should
+      /// serialize the changed state only once and reuse it for later calls.
+      /// This must only be enabled while the state can't change, such as
+      /// during system PostUpdates. The cached state is dropped when caching
+      /// is disabled. This function is protected to facilitate testing.
+      /// \param[in] _cache True to enable caching.
+      protected: void CacheChangedState(bool _cache);
+
+      /// \brief Set whether WorldPose should keep the poses it computes and
+      /// reuse them for later calls. This must only be enabled while poses
+      /// can't change, such as during system PostUpdates. The cached poses
+      /// are dropped whenever this is called. This function is protected to
+      /// facilitate testing.
+      /// \param[in] _cache True to enable caching.
+      protected: void CacheWorldPoses(bool _cache);
+
       /// Compute the diff between this EntityComponentManager and _other at the
       /// entity level. This does not compute the diff between components of an
       /// entity.
@@ -703,6 +1190,19 @@ namespace gz
       protected: EntityComponentManagerDiff ComputeEntityDiff(
                      const EntityComponentManager &_other) const;
 
+      /// \brief Add the components that may differ between this ECM and
+      /// another one to a diff, as modified components. Only entities
+      /// that both have are considered. If _other is an unmodified copy of
+      /// an earlier state of this ECM, these are the components added,
+      /// marked as changed or removed since the copy, and the ones of types
+      /// that may have been written through pointers. Otherwise these are
+      /// all the components of both.
+      /// \param[in] _other EntityComponentManager to compare to.
+      /// \param[in,out] _diff Diff to add the components to.
+      protected: void ComputeComponentDiff(
+                     const EntityComponentManager &_other,
+                     EntityComponentManagerDiff &_diff) const;
+
       /// \brief Given an entity diff, apply it to this ECM. Note that for
       /// removed entities, this would mark them for removal instead of actually
       /// removing the entities.
@@ -754,6 +1254,56 @@ namespace gz
                    const Entity _entity,
                    const ComponentTypeId _type);
 
+      /// \brief Get a counter that changes whenever components may have been
+      /// destroyed, such as when components or entities are removed. It's
+      /// used by component handles to know whether their cached pointers are
+      /// still valid.
+      /// \return The storage version.
+      private: std::uint64_t StorageVersion() const;
+
+      /// \brief Stop sharing the components of a type with the manager this
+      /// one was forked from, by copying them, because they may be written.
+      /// Components shared among entities are copied back into their entity.
+      /// When an entity is given, only its component is copied, so the
+      /// other entities keep sharing theirs.
+      /// The type is also recorded as written through pointers, so that
+      /// IncrementalResetTo compares its components.
+      /// \param[in] _type Id of the component type.
+      /// \param[in] _entity Entity that may be written, or kNullEntity if
+      /// all entities with the component type may be.
+      /// \param[in] _pointerWrite False if the components are only written
+      /// before being marked as changed, so the type isn't recorded.
+      /// \sa ForkFrom
+      /// \sa InternComponents
+      private: void UnshareComponents(const ComponentTypeId _type,
+                   const Entity _entity = kNullEntity,
+                   const bool _pointerWrite = true);
+
+      /// \brief Get a component that was just created or overwritten and
+      /// marked as changed, such as by CreateComponent.
+      /// \param[in] _entity The entity.
+      /// \param[in] _type Id of the component type.
+      /// \return The component, or nullptr if it could not be found.
+      private: components::BaseComponent *CreatedComponentImplementation(
+                   const Entity _entity,
+                   const ComponentTypeId _type);
+
+      /// \brief Get a counter that changes whenever components are added to
+      /// entities. It's used by component handles of missing components to
+      /// know whether they should look them up again.
+      /// \return The creation version.
+      private: std::uint64_t CreationVersion() const;
+
+      /// \brief Get the children of an entity, without building the entity
+      /// graph.
+      /// \param[in] _parent Parent entity.
+      /// \return The children, sorted in ascending order.
+      private: std::vector<Entity> ChildEntities(const Entity _parent) const;
+
+      /// \brief Get all entities, without building the entity graph.
+      /// \return The entities, sorted in ascending order.
+      private: std::vector<Entity> AllEntities() const;
+
       /// \brief Find a View that matches the set of ComponentTypeIds. If
       /// a match is not found, then a new view is created.
       /// \tparam ComponentTypeTs All the component types that define a view.
@@ -761,6 +1311,18 @@ namespace gz
       private: template<typename ...ComponentTypeTs>
           detail::View *FindView() const;
 
+      /// \brief Call a function over the range [0, _count) in chunks which
+      /// are processed concurrently by the thread pool used by
+      /// EachParallel().
+      /// \param[in] _count Number of elements.
+      /// \param[in] _grainSize Maximum number of elements per chunk, or zero
+      /// to pick a size based on the number of threads.
+      /// \param[in] _fn Function called with the [begin, end) range of each
+      /// chunk.
+      private: void ParallelFor(std::size_t _count, std::size_t _grainSize,
+                   const std::function<void(std::size_t, std::size_t)> &_fn)
+                   const;
+
       /// \brief Find a view based on the provided component type ids.
       /// \param[in] _types The component type ids that serve as a key into
       /// a map of views.
@@ -771,6 +1333,29 @@ namespace gz
       private: std::pair<detail::BaseView *, std::mutex *> FindView(
                    const std::vector<ComponentTypeId> &_types) const;
 
+      /// \brief Get a new process-wide index to cache the view of a list of
+      /// component types in each ECM. Each instantiation of the templated
+      /// FindView gets its index once.
+      /// \return The new index.
+      private: static std::size_t NextViewCacheSlot();
+
+      /// \brief Get the view cached at an index with CacheView. This doesn't
+      /// allocate, hash nor lock, unlike FindView with the component types.
+      /// \param[in] _slot Index from NextViewCacheSlot.
+      /// \return Same as FindView, nullptrs if no view is cached at the
+      /// index.
+      private: std::pair<detail::BaseView *, std::mutex *> CachedView(
+                   std::size_t _slot) const;
+
+      /// \brief Cache a view found with FindView at an index, until the
+      /// views are cleared. Indices past the capacity of the cache are
+      /// ignored.
+      /// \param[in] _slot Index from NextViewCacheSlot.
+      /// \param[in] _viewMutexPair The view and its mutex.
+      private: void CacheView(std::size_t _slot,
+          const std::pair<detail::BaseView *, std::mutex *> &_viewMutexPair)
+          const;
+
       /// \brief Add a new view to the set of stored views.
       /// \param[in] _types The set of component type ids that act as the key
       /// for the view.
@@ -806,6 +1391,18 @@ namespace gz
           const std::unordered_set<ComponentTypeId> &_types = {},
           bool _full = false) const;
 
+      /// \brief Add an entity and its components to a state snapshot.
+      /// \param[in] _writer Writer of the snapshot.
+      /// \param[in] _entity The entity to be added.
+      /// \param[in] _types Component types to be added. Leave empty for all
+      /// components.
+      /// \param[in] _full True to add all the components, false to add only
+      /// the components that have changed.
+      private: void AddEntityToSnapshot(StateSnapshotWriter &_writer,
+          Entity _entity,
+          const std::unordered_set<ComponentTypeId> &_types = {},
+          bool _full = false) const;
+
       /// \brief Set whether views should be locked when entities are being
       /// added to them. This can be used to prevent race conditions in
       /// system PostUpdates, since these are run in parallel (entities are
@@ -822,21 +1419,75 @@ namespace gz
       /// otherwise.
       private: bool LockAddingEntitiesToViews() const;
 
+      /// \brief Add the entities that are waiting to be added to each view.
+      /// Views are normally updated lazily, the next time they're used. This
+      /// updates all of them at once, so that systems that run concurrently
+      /// only read the views afterwards.
+      private: void AddPendingEntitiesToViews();
+
+      /// \brief Mark the entities inserted in bulk so far to be added to the
+      /// views that match them.
+      /// \sa BeginBulkInsert
+      private: void AddBulkEntitiesToViews() const;
+
+      /// \brief Set the accumulator returned by Wrenches().
+      /// \param[in] _wrenches Accumulator owned by the caller, which must
+      /// outlive its use by this manager, or null.
+      private: void SetWrenches(WrenchAccumulator *_wrenches);
+
+      /// \brief Set the arena returned by StepArena().
+      /// \param[in] _arena Arena owned by the caller, which must outlive
+      /// its use by this manager, or null.
+      private: void SetStepArena(FrameArena *_arena);
+
+      /// \brief Implementation of SystemSharedData. The data is created
+      /// and destroyed through function pointers, so nothing of the
+      /// library that created it is needed once it's destroyed, even if
+      /// the library is unloaded before the manager.
+      /// \param[in] _key Name of the data.
+      /// \param[in] _typeName Name of the type of the data.
+      /// \param[in] _create Function that creates the data.
+      /// \param[in] _destroy Function that destroys the data.
+      /// \return The data, or null if _key is used for another type.
+      private: std::shared_ptr<void> SystemSharedDataImpl(
+                   const std::string &_key, const char *_typeName,
+                   void *(*_create)(), void (*_destroy)(void *)) const;
+
       // Make runners friends so that they can manage entity creation and
       // removal. This should be safe since runners are internal
       // to Gazebo.
       friend class GuiRunner;
       friend class SimulationRunner;
 
+      // Log replay steps through states without a runner, so it does the
+      // same bookkeeping at the end of each step.
+      friend class LogReplay;
+
       // Make network managers friends so they have control over component
       // states. Like the runners, the managers are internal.
       friend class NetworkManagerPrimary;
       friend class NetworkManagerSecondary;
+
+      // Make the system manager a friend so it can prepare the views before
+      // running systems concurrently. It's also internal.
+      friend class SystemManager;
+
+      // Rollouts step forks without a runner, and do the same bookkeeping
+      // at the end of each step as log replay.
+      friend class Rollout;
+
+      // State hashes serialize components by type ID, like state messages.
+      friend class StateHashPrivate;
+
+      // Component handles check the storage version before using their
+      // cached pointers.
+      template<typename ComponentTypeT> friend class ComponentHandle;
     };
     }
   }
 }
 
 #include "gz/sim/detail/EntityComponentManager.hh"
+#include "gz/sim/ComponentHandle.hh"
 
 #endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_EVENTCHANNEL_HH_
+#define GZ_SIM_EVENTCHANNEL_HH_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Event.hh>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \brief Event for signals emitted at a high rate, such as every step or
+    /// every contact point. It can be used anywhere a common::EventT is used,
+    /// including with the EventManager.
+    ///
+    /// Emitting doesn't take any lock: connecting and disconnecting publish
+    /// a new immutable list of subscribers, which emitters read through an
+    /// atomic pointer. Lists replaced while an emission is in progress are
+    /// freed by the next change made once no emission is in progress.
+    ///
+    /// Subscribers connected while an event is emitted are called starting
+    /// with the next emission. Subscribers disconnected while an event is
+    /// emitted aren't called anymore, as with common::EventT.
+    ///
+    /// \tparam T Function signature of the subscribers.
+    /// \tparam N Tag to tell apart events with the same signature.
+    template <typename T, typename N = void>
+    class EventChannel;
+
+    /// \brief Specialization for callbacks that don't return anything.
+    template <typename ...Args, typename N>
+    class EventChannel<void(Args...), N> : public common::Event
+    {
+      /// \brief Callback type.
+      public: using CallbackT = std::function<void(Args...)>;
+
+      /// \brief Constructor.
+      public: EventChannel() = default;
+
+      public: EventChannel(const EventChannel &) = delete;
+      public: EventChannel &operator=(const EventChannel &) = delete;
+
+      /// \brief Destructor.
+      public: ~EventChannel() override = default;
+
+      /// \brief Connect a callback to the event.
+      /// \param[in] _subscriber Callback.
+      /// \return Connection, which disconnects the callback when it's
+      /// destroyed. It must not outlive the event.
+      public: common::ConnectionPtr Connect(const CallbackT &_subscriber)
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                const int id = this->nextId++;
+                auto next = std::make_unique<SubscriberList>();
+                if (this->subscribers)
+                  *next = *this->subscribers;
+                next->push_back(std::make_shared<Subscriber>(id, _subscriber));
+                this->Publish(std::move(next));
+                return std::make_shared<common::Connection>(this, id);
+              }
+
+      /// \brief Disconnect a callback.
+      /// \param[in] _id ID of the connection.
+      public: void Disconnect(int _id) override
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!this->subscribers)
+                  return;
+
+                auto next = std::make_unique<SubscriberList>();
+                next->reserve(this->subscribers->size());
+                for (const auto &subscriber : *this->subscribers)
+                {
+                  if (subscriber->id == _id)
+                    subscriber->connected.store(false);
+                  else
+                    next->push_back(subscriber);
+                }
+                this->Publish(std::move(next));
+              }
+
+      /// \brief Get the number of connected callbacks.
+      /// \return Number of connections.
+      public: unsigned int ConnectionCount() const
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                return this->subscribers ?
+                    static_cast<unsigned int>(this->subscribers->size()) : 0u;
+              }
+
+      /// \brief Call all connected callbacks. This is thread safe.
+      /// \param[in] _args Arguments passed to every callback.
+      public: template <typename ...Params>
+              void Signal(Params &&..._args)
+              {
+                // Signaled isn't set, it's not atomic and is only used for a
+                // warning when a connection is destroyed right away
+                EmitGuard guard(this->emitting);
+                const SubscriberList *list =
+                    this->current.load(std::memory_order_seq_cst);
+                if (nullptr == list)
+                  return;
+                for (const auto &subscriber : *list)
+                {
+                  if (subscriber->connected.load(std::memory_order_relaxed))
+                    subscriber->callback(_args...);
+                }
+              }
+
+      /// \brief Call all connected callbacks, same as Signal.
+      /// \param[in] _args Arguments passed to every callback.
+      public: template <typename ...Params>
+              void operator()(Params &&..._args)
+              {
+                this->Signal(std::forward<Params>(_args)...);
+              }
+
+      /// \brief A connected callback.
+      private: struct Subscriber
+               {
+                 /// \brief Constructor.
+                 /// \param[in] _id Connection ID.
+                 /// \param[in] _callback Callback.
+                 Subscriber(int _id, const CallbackT &_callback)
+                   : id(_id), callback(_callback)
+                 {
+                 }
+
+                 /// \brief Connection ID.
+                 int id;
+
+                 /// \brief Callback.
+                 CallbackT callback;
+
+                 /// \brief Cleared on disconnection, for lists that are
+                 /// still being emitted to.
+                 std::atomic<bool> connected{true};
+               };
+
+      /// \brief Immutable list of subscribers read by emitters.
+      private: using SubscriberList = std::vector<std::shared_ptr<Subscriber>>;
+
+      /// \brief Counts an emission in progress for its scope.
+      private: struct EmitGuard
+               {
+                 /// \brief Constructor.
+                 /// \param[in] _count Count of emissions in progress.
+                 explicit EmitGuard(std::atomic<unsigned int> &_count)
+                   : count(_count)
+                 {
+                   this->count.fetch_add(1u, std::memory_order_seq_cst);
+                 }
+
+                 /// \brief Destructor.
+                 ~EmitGuard()
+                 {
+                   this->count.fetch_sub(1u, std::memory_order_release);
+                 }
+
+                 /// \brief Count of emissions in progress.
+                 std::atomic<unsigned int> &count;
+               };
+
+      /// \brief Make a list the one read by emitters. The mutex must be
+      /// locked.
+      /// \param[in] _next New list of subscribers.
+      private: void Publish(std::unique_ptr<const SubscriberList> _next)
+               {
+                 this->current.store(_next.get(), std::memory_order_seq_cst);
+                 if (this->subscribers)
+                   this->retired.push_back(std::move(this->subscribers));
+                 this->subscribers = std::move(_next);
+
+                 // An emission that starts after this reads the new list, so
+                 // the old ones can only be in use if one is in progress
+                 if (this->emitting.load(std::memory_order_seq_cst) == 0u)
+                   this->retired.clear();
+               }
+
+      /// \brief List read by emitters, owned by subscribers.
+      private: std::atomic<const SubscriberList *> current{nullptr};
+
+      /// \brief Number of emissions in progress.
+      private: std::atomic<unsigned int> emitting{0u};
+
+      /// \brief Current list of subscribers.
+      private: std::unique_ptr<const SubscriberList> subscribers;
+
+      /// \brief Replaced lists that may still be in use by emitters.
+      private: std::vector<std::unique_ptr<const SubscriberList>> retired;
+
+      /// \brief ID of the next connection.
+      private: int nextId{0};
+
+      /// \brief Protects the lists and IDs.
+      private: mutable std::mutex mutex;
+    };
+    }
+  }
+}
+#endif  // GZ_SIM_EVENTCHANNEL_HH_
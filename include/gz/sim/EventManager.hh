@@ -27,6 +27,7 @@
 #include <gz/common/Event.hh>
 
 #include <gz/sim/config.hh>
+#include <gz/sim/EventChannel.hh>
 #include <gz/sim/Export.hh>
 #include <gz/sim/Types.hh>
 
@@ -121,6 +122,25 @@ namespace gz
                 }
               }
 
+      /// \brief Get an event to connect to or emit directly, skipping the
+      /// lookup that Connect and Emit do on every call. This is meant for
+      /// events emitted at a high rate, which should be an EventChannel.
+      ///
+      /// The reference stays valid as long as the event manager.
+      /// \return The event of type E, created if needed.
+      public: template <typename E>
+              E &Channel()
+              {
+                auto it = this->events.find(typeid(E));
+                if (it == this->events.end())
+                {
+                  it = this->events.emplace(typeid(E),
+                      std::make_unique<E>()).first;
+                }
+                // Events are stored by their own type.
+                return static_cast<E &>(*it->second);
+              }
+
       /// \brief Get connection count for a particular event
       /// Connection count for the event
       public: template <typename E>
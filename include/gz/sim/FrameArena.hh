@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_FRAMEARENA_HH_
+#define GZ_SIM_FRAMEARENA_HH_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/Export.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+/// \brief Memory for scratch data that only lives during a simulation step.
+///
+/// Allocating bumps an offset into a block of memory with an atomic
+/// operation, so systems running concurrently in PostUpdate can allocate
+/// without contending on the heap. Nothing is freed individually: the
+/// simulation runner resets the arena after PostUpdate, and the blocks are
+/// kept for the next step. After a step that needed more than one block,
+/// they're merged into a single block large enough for the whole step.
+///
+/// Destructors aren't called on reset, so only trivially destructible
+/// objects can be created in the arena, and containers must use
+/// FrameAllocator.
+///
+/// ## Usage
+///
+/// ```
+/// void PostUpdate(const UpdateInfo &_info,
+///     const EntityComponentManager &_ecm) override
+/// {
+///   FrameVector<math::Pose3d> poses(*_ecm.StepArena());
+///   poses.reserve(count);
+///   ...
+/// }
+/// ```
+///
+/// \sa EntityComponentManager::StepArena
+class GZ_SIM_VISIBLE FrameArena
+{
+  /// \brief Constructor.
+  /// \param[in] _blockSize Size in bytes of the first block.
+  public: explicit FrameArena(std::size_t _blockSize = 64u * 1024u);
+
+  /// \brief Get memory that's valid until the next call to Reset. This is
+  /// thread safe.
+  /// \param[in] _size Size in bytes.
+  /// \param[in] _alignment Alignment in bytes, which must be a power of 2.
+  /// \return Pointer to the memory.
+  public: void *Allocate(std::size_t _size,
+              std::size_t _alignment = alignof(std::max_align_t));
+
+  /// \brief Create an object in the arena. This is thread safe.
+  /// \param[in] _args Arguments forwarded to the constructor.
+  /// \tparam T Type of the object, which must be trivially destructible.
+  /// \return Pointer to the object, valid until the next call to Reset.
+  public: template <typename T, typename ...Args>
+          T *Create(Args &&..._args)
+  {
+    static_assert(std::is_trivially_destructible_v<T>,
+        "Objects in a FrameArena are never destroyed");
+    return new (this->Allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(_args)...);
+  }
+
+  /// \brief Release all memory handed out since the last reset, so it can
+  /// be reused. This must not be called while other threads allocate.
+  public: void Reset();
+
+  /// \brief Get the number of bytes handed out since the last reset,
+  /// including alignment padding.
+  /// \return Number of bytes.
+  public: std::size_t Used() const;
+
+  /// \brief Get the number of bytes reserved by the arena.
+  /// \return Number of bytes.
+  public: std::size_t Capacity() const;
+
+  /// \brief Private data pointer.
+  GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+
+/// \brief Standard allocator that takes its memory from a FrameArena, for
+/// containers holding scratch data of a step. Deallocating does nothing.
+/// \tparam T Type of the allocated objects.
+template <typename T>
+class FrameAllocator
+{
+  /// \brief Allocated type.
+  public: using value_type = T;
+
+  /// \brief Constructor.
+  /// \param[in] _arena Arena to allocate from, which must outlive the
+  /// allocator.
+  public: FrameAllocator(FrameArena &_arena) noexcept  // NOLINT
+    : arena(&_arena)
+  {
+  }
+
+  /// \brief Conversion from an allocator of another type.
+  /// \param[in] _other Allocator to copy the arena from.
+  public: template <typename U>
+          FrameAllocator(const FrameAllocator<U> &_other) noexcept  // NOLINT
+    : arena(_other.Arena())
+  {
+  }
+
+  /// \brief Allocate memory for objects.
+  /// \param[in] _count Number of objects.
+  /// \return Pointer to the memory.
+  public: T *allocate(std::size_t _count)
+  {
+    return static_cast<T *>(this->arena->Allocate(_count * sizeof(T),
+        alignof(T)));
+  }
+
+  /// \brief Do nothing, the memory is released when the arena is reset.
+  public: void deallocate(T *, std::size_t) noexcept
+  {
+  }
+
+  /// \brief Get the arena.
+  /// \return The arena.
+  public: FrameArena *Arena() const noexcept
+  {
+    return this->arena;
+  }
+
+  /// \brief Arena to allocate from.
+  private: FrameArena *arena;
+};
+
+/// \brief Allocators are equal if they use the same arena.
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T> &_a, const FrameAllocator<U> &_b)
+{
+  return _a.Arena() == _b.Arena();
+}
+
+/// \brief Allocators are equal if they use the same arena.
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T> &_a, const FrameAllocator<U> &_b)
+{
+  return !(_a == _b);
+}
+
+/// \brief Vector whose memory comes from a FrameArena.
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
+}
+}
+#endif
@@ -33,6 +33,7 @@
 #include <gz/sim/Export.hh>
 #include <gz/sim/Model.hh>
 #include <gz/sim/Types.hh>
+#include <gz/sim/WrenchAccumulator.hh>
 
 namespace gz
 {
@@ -327,6 +328,58 @@ namespace gz
                                   const math::Vector3d &_torque,
                                   const math::Vector3d &_offset) const;
 
+      /// \brief Add a force expressed in world coordinates and applied at
+      /// an offset from the center of mass of the link to a wrench
+      /// accumulator, which applies it before physics.
+      /// \param[in] _ecm Mutable Entity-component manager.
+      /// \param[in] _accumulator Accumulator, usually
+      /// EntityComponentManager::Wrenches(). If it's null, the force is added
+      /// like with AddWorldForce(EntityComponentManager &, ...).
+      /// \param[in] _force Force to be applied expressed in world coordinates
+      /// \param[in] _position The point of application of the force expressed
+      /// in the link-fixed frame.
+      public: void AddWorldForce(EntityComponentManager &_ecm,
+                                 WrenchAccumulator *_accumulator,
+                                 const math::Vector3d &_force,
+                                 const math::Vector3d &_position =
+                                     math::Vector3d::Zero) const;
+
+      /// \brief Add a wrench expressed in world coordinates and applied to
+      /// the link at an offset from the link's origin to a wrench
+      /// accumulator, which applies it before physics.
+      /// \param[in] _ecm Mutable Entity-component manager.
+      /// \param[in] _accumulator Accumulator, usually
+      /// EntityComponentManager::Wrenches(). If it's null, the wrench is added
+      /// like with AddWorldWrench(EntityComponentManager &, ...).
+      /// \param[in] _force Force to be applied expressed in world coordinates
+      /// \param[in] _torque Torque to be applied expressed in world coordinates
+      /// \param[in] _offset The point of application of the force expressed
+      /// in the link frame
+      public: void AddWorldWrench(EntityComponentManager &_ecm,
+                                  WrenchAccumulator *_accumulator,
+                                  const math::Vector3d &_force,
+                                  const math::Vector3d &_torque,
+                                  const math::Vector3d &_offset =
+                                      math::Vector3d::Zero) const;
+
+      /// \brief Add a wrench expressed in world coordinates and applied to
+      /// the link at an offset from the link's origin to a wrench
+      /// accumulator. This only reads the Entity-component manager, so it
+      /// can be called from several threads.
+      /// \param[in] _ecm Entity-component manager.
+      /// \param[in] _accumulator Accumulator, usually
+      /// EntityComponentManager::Wrenches().
+      /// \param[in] _force Force to be applied expressed in world coordinates
+      /// \param[in] _torque Torque to be applied expressed in world coordinates
+      /// \param[in] _offset The point of application of the force expressed
+      /// in the link frame
+      public: void AddWorldWrench(const EntityComponentManager &_ecm,
+                                  WrenchAccumulator &_accumulator,
+                                  const math::Vector3d &_force,
+                                  const math::Vector3d &_torque,
+                                  const math::Vector3d &_offset =
+                                      math::Vector3d::Zero) const;
+
       /// \brief Pointer to private data.
       private: std::unique_ptr<LinkPrivate> dataPtr;
     };
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_REGULARGRID_HH_
+#define GZ_SIM_REGULARGRID_HH_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/Export.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+/// \brief Environmental data sampled on a rectilinear grid, which may have a
+/// different spacing along each axis. Lookups compute the cell holding a
+/// position directly, or with a binary search on unevenly spaced axes, and
+/// interpolate trilinearly in space and linearly in time.
+///
+/// Values are stored as floats, with x varying fastest, then y, z, time and
+/// field. Missing values are NaN, and are left out of interpolations.
+///
+/// ## Usage
+///
+/// ```
+/// // Once, when the data is set
+/// auto field = grid->FieldIndex("temperature");
+/// auto session = grid->CreateSession();
+///
+/// // Every step, the session moves forward from where it was
+/// session = grid->StepTo(*session, simTime);
+/// auto value = grid->LookUp(*session, *field, position);
+/// ```
+///
+/// \sa components::EnvironmentalData
+class GZ_SIM_VISIBLE RegularGrid
+{
+  /// \brief Position in time of lookups. Keeping it between steps makes
+  /// stepping forward constant time.
+  public: struct Session
+  {
+    /// \brief Index of the time sample at or before the time.
+    std::size_t index{0u};
+
+    /// \brief Weight of the next time sample, between 0 and 1.
+    double weight{0.0};
+  };
+
+  /// \brief Constructor.
+  /// \param[in] _axes Sorted coordinates of the samples along time, x, y and
+  /// z, each of them with at least one sample.
+  /// \param[in] _fields Names of the fields.
+  /// \param[in] _values Values of the fields, which must hold one value
+  /// per sample per field.
+  public: RegularGrid(std::array<std::vector<double>, 4> _axes,
+              std::vector<std::string> _fields,
+              std::vector<float> _values);
+
+  /// \brief Get the coordinates of the samples along an axis.
+  /// \param[in] _axis 0 for time, then 1, 2 and 3 for x, y and z.
+  /// \return The sorted coordinates.
+  public: const std::vector<double> &Axis(std::size_t _axis) const;
+
+  /// \brief Get the names of the fields.
+  /// \return The names, in the order they're stored.
+  public: const std::vector<std::string> &Fields() const;
+
+  /// \brief Get the index of a field, to look it up.
+  /// \param[in] _name Name of the field.
+  /// \return The index, or nullopt if there's no such field.
+  public: std::optional<std::size_t> FieldIndex(
+              const std::string &_name) const;
+
+  /// \brief Get all values.
+  /// \return Values of all the fields.
+  public: const std::vector<float> &Values() const;
+
+  /// \brief Create a session at the first time sample.
+  /// \return The session.
+  public: Session CreateSession() const;
+
+  /// \brief Move a session to a time.
+  /// \param[in] _session Session to start from. Stepping forward by a few
+  /// samples is quicker than jumping.
+  /// \param[in] _time Time to move to.
+  /// \return The session, or nullopt if the time is outside of the data.
+  public: std::optional<Session> StepTo(const Session &_session,
+              double _time) const;
+
+  /// \brief Look up a field at a position.
+  /// \param[in] _session Time of the lookup.
+  /// \param[in] _field Index of the field.
+  /// \param[in] _position Position, in the coordinates of the data.
+  /// \return The interpolated value, or nullopt if the position is outside
+  /// of the grid or all the samples around it are missing.
+  public: std::optional<double> LookUp(const Session &_session,
+              std::size_t _field, const math::Vector3d &_position) const;
+
+  /// \brief Look up several fields at a position, sharing the search of the
+  /// cell holding it.
+  /// \param[in] _session Time of the lookup.
+  /// \param[in] _fields Indices of the fields.
+  /// \param[in] _position Position, in the coordinates of the data.
+  /// \param[out] _values Value of each field, as returned by LookUp.
+  public: void LookUp(const Session &_session,
+              const std::vector<std::size_t> &_fields,
+              const math::Vector3d &_position,
+              std::vector<std::optional<double>> &_values) const;
+
+  /// \brief Look up a field at several positions, such as the ones of many
+  /// vehicles.
+  /// \param[in] _session Time of the lookups.
+  /// \param[in] _field Index of the field.
+  /// \param[in] _positions Positions, in the coordinates of the data.
+  /// \param[out] _values Value at each position, as returned by LookUp.
+  public: void LookUp(const Session &_session, std::size_t _field,
+              const std::vector<math::Vector3d> &_positions,
+              std::vector<std::optional<double>> &_values) const;
+
+  /// \brief Private data pointer.
+  GZ_UTILS_IMPL_PTR(dataPtr)
+};
+}
+}
+}
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_ROLLOUT_HH_
+#define GZ_SIM_ROLLOUT_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <sdf/Element.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Export.hh"
+#include "gz/sim/System.hh"
+#include "gz/sim/SystemPluginPtr.hh"
+#include "gz/sim/Types.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+/// \brief A short simulation branched from the current state of a world. It
+/// steps its own systems, such as a physics system, on a copy-on-write fork
+/// of the world's entity component manager, so it's cheap to create many of
+/// them, for example to evaluate the candidate actions of a model predictive
+/// planner.
+///
+/// ## Usage
+///
+/// ```
+/// // In a system's PostUpdate, while the world doesn't change
+/// std::vector<std::unique_ptr<gz::sim::Rollout>> rollouts;
+/// for (int i = 0; i < 32; ++i)
+/// {
+///   rollouts.push_back(std::make_unique<gz::sim::Rollout>(_ecm, _info));
+///   rollouts.back()->AddSystem(loader.LoadPlugin(physicsPlugin).value());
+/// }
+/// gz::sim::Rollout::StepAll(rollouts, 100);
+/// ```
+///
+/// \sa EntityComponentManager::ForkFrom
+class GZ_SIM_VISIBLE Rollout
+{
+  /// \brief Constructor.
+  /// \param[in] _ecm Entity component manager to fork. It must outlive the
+  /// rollout and not change while the rollout exists.
+  /// \param[in] _info Time of the state being forked. Each step advances it
+  /// by its dt.
+  public: Rollout(const EntityComponentManager &_ecm,
+              const UpdateInfo &_info);
+
+  /// \brief Destructor.
+  public: ~Rollout();
+
+  /// \brief Add a system, which is configured right away with the world
+  /// entity.
+  /// \param[in] _system System loaded from a plugin.
+  /// \param[in] _sdf SDF passed to the system's Configure, optional.
+  public: void AddSystem(const SystemPluginPtr &_system,
+              const std::shared_ptr<const sdf::Element> &_sdf = nullptr);
+
+  /// \brief Add a system, which is configured right away with the world
+  /// entity.
+  /// \param[in] _system System created in memory.
+  /// \param[in] _sdf SDF passed to the system's Configure, optional.
+  public: void AddSystem(const std::shared_ptr<System> &_system,
+              const std::shared_ptr<const sdf::Element> &_sdf = nullptr);
+
+  /// \brief Step the rollout's systems. The rollout is never paused.
+  /// \param[in] _iterations Number of iterations.
+  public: void Step(const uint64_t _iterations = 1);
+
+  /// \brief Step many rollouts concurrently on the shared thread pool.
+  /// \param[in] _rollouts Rollouts to step.
+  /// \param[in] _iterations Number of iterations of each rollout.
+  public: static void StepAll(
+              const std::vector<std::unique_ptr<Rollout>> &_rollouts,
+              const uint64_t _iterations);
+
+  /// \brief Get the forked entity component manager, with the state reached
+  /// by the rollout.
+  /// \return The entity component manager.
+  public: const EntityComponentManager &EntityCompMgr() const;
+
+  /// \brief Get the time information of the latest step.
+  /// \return The update info.
+  public: const UpdateInfo &Info() const;
+
+  /// \internal
+  /// \brief Pointer to private data.
+  private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+}
+#endif
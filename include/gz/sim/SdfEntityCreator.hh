@@ -18,6 +18,7 @@
 #define GZ_SIM_CREATEREMOVE_HH_
 
 #include <memory>
+#include <vector>
 
 #include <sdf/Actor.hh>
 #include <sdf/Collision.hh>
@@ -99,6 +100,18 @@ namespace gz
       /// \return Model entity.
       public: Entity CreateEntities(const sdf::Model *_model);
 
+      /// \brief Create all entities of many models and load their plugins.
+      /// The entities, including their IDs, and the order in which plugins
+      /// are loaded are the same as when calling CreateEntities for each
+      /// model in order. When there are enough models, their components are
+      /// created concurrently in staging entity component managers, which
+      /// are then moved into the entity component manager in one batch. In
+      /// that case, all models exist by the time the first plugin is loaded.
+      /// \param[in] _models SDF model objects.
+      /// \return Model entities, in the same order as the models.
+      public: std::vector<Entity> CreateEntities(
+          const std::vector<const sdf::Model *> &_models);
+
       /// \brief Create all entities that exist in the sdf::Actor object and
       /// load their plugins.
       /// \param[in] _actor SDF actor object.
@@ -18,6 +18,7 @@
 #define GZ_SIM_SERVER_HH_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -26,6 +27,7 @@
 #include <gz/sim/Export.hh>
 #include <gz/sim/ServerConfig.hh>
 #include <gz/sim/SystemPluginPtr.hh>
+#include <gz/sim/Types.hh>
 #include <sdf/Element.hh>
 #include <sdf/Plugin.hh>
 
@@ -162,6 +164,31 @@ namespace gz
       /// not being initialized, or if the server is already running.
       public: bool RunOnce(const bool _paused = true);
 
+      /// \brief Function called with the results of each world at the end
+      /// of RunBatch.
+      /// \param[in] _worldIndex Index of the world.
+      /// \param[in] _info Time information of the world's last iteration.
+      /// \param[in] _ecm Entity component manager of the world.
+      public: using BatchCallback = std::function<void(
+                  unsigned int _worldIndex, const UpdateInfo &_info,
+                  const EntityComponentManager &_ecm)>;
+
+      /// \brief Step all worlds in lockstep for a number of iterations, as
+      /// fast as possible, and collect their results. This is meant for many
+      /// small independent worlds, such as reinforcement learning
+      /// environments. Every iteration steps all worlds concurrently on the
+      /// shared thread pool, and waits until all of them are done before the
+      /// next one. The update period is ignored, and all worlds are
+      /// unpaused. This is a blocking call.
+      /// \param[in] _iterations Number of iterations to step each world.
+      /// \param[in] _callback Optional function called for every world once
+      /// all iterations are done. It's called concurrently for different
+      /// worlds, from the pool threads.
+      /// \return False if the server is already running, if it's part of a
+      /// distributed simulation, or if it was stopped before completing.
+      public: bool RunBatch(const uint64_t _iterations,
+                  const BatchCallback &_callback = nullptr);
+
       /// \brief Get whether the server is running. The server can have zero
       /// or more simulation worlds, each of which may or may not be
       /// running. See Running(const unsigned int) to get the running status
@@ -335,6 +362,16 @@ namespace gz
                                       bool _recursive = true,
                                       const unsigned int _worldIndex = 0);
 
+      /// \brief Reset a world to its initial state right away, the same
+      /// way a reset world control request does on the next iteration:
+      /// time is rewound, the entities and components are restored, and
+      /// systems are reset. This lets a server be reused instead of
+      /// constructed again.
+      /// \param[in] _worldIndex Index of the world.
+      /// \return True if the world exists and was reset, false if it
+      /// doesn't exist or if the server is running.
+      public: bool Reset(const unsigned int _worldIndex = 0);
+
       /// \brief Stop the server. This will stop all running simulations.
       public: void Stop();
 
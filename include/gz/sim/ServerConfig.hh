@@ -28,6 +28,7 @@
 #include <sdf/Root.hh>
 #include <gz/sim/config.hh>
 #include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
 
 namespace gz
 {
@@ -219,6 +220,256 @@ namespace gz
       /// \param[in] _levels Value to set.
       public: void SetUseLevels(const bool _levels);
 
+      /// \brief Set whether the top-level includes of a world file which
+      /// are referenced by levels are parsed only when their level becomes
+      /// active, instead of with the rest of the world. This lowers the
+      /// memory and time needed to load worlds made of many tiles. It only
+      /// applies to files holding a single world, when levels are used, and
+      /// disables the world cache for them. The default is false.
+      /// \param[in] _defer True to defer the includes of levels.
+      public: void SetDeferLevelIncludes(const bool _defer);
+
+      /// \brief Get whether the includes of levels are parsed when their
+      /// level becomes active.
+      /// \return True if they're deferred.
+      public: bool DeferLevelIncludes() const;
+
+      /// \brief Set the memory layout used by the entity component manager to
+      /// store components. The default is ComponentStorageType::kHeap.
+      /// \param[in] _type Storage layout to use.
+      public: void SetComponentStorage(const ComponentStorageType _type);
+
+      /// \brief Get the memory layout used by the entity component manager to
+      /// store components.
+      /// \return The storage layout.
+      public: ComponentStorageType ComponentStorage() const;
+
+      /// \brief Set whether entities whose immutable components hold the
+      /// same data, such as file paths, geometries, materials and sensor
+      /// SDF, share one instance of them until they're written. This saves
+      /// memory in worlds with many copies of the same model. The default is
+      /// false, because sharing invalidates pointers to components that
+      /// systems may have kept, see EntityComponentManager::InternComponents.
+      /// Only enable it if the systems look components up each step.
+      /// \param[in] _share True to share identical components.
+      /// \sa EntityComponentManager::InternComponents
+      public: void SetShareIdenticalComponents(const bool _share);
+
+      /// \brief Get whether identical immutable components are shared.
+      /// \return True if they're shared.
+      public: bool ShareIdenticalComponents() const;
+
+      /// \brief Set whether the collision meshes of a world are always
+      /// loaded before its entities are created. They're decoded
+      /// concurrently, and their files are hashed, so that files with the
+      /// same content under different paths are only decoded once. Hashing
+      /// reads every collision mesh file once more, so by default only
+      /// worlds with at least 16 distinct collision mesh files are
+      /// preloaded. The default is false.
+      /// \param[in] _preload True to preload the collision meshes of all
+      /// worlds.
+      public: void SetPreloadMeshes(const bool _preload);
+
+      /// \brief Get whether collision meshes are preloaded.
+      /// \return True if they're preloaded.
+      /// \sa SetPreloadMeshes
+      public: bool PreloadMeshes() const;
+
+      /// \brief Set the number of worker threads used to run system
+      /// PostUpdates. The thread stepping the simulation also runs systems,
+      /// so a good value is one less than the number of cores the server may
+      /// use. The default, zero, uses a pool shared across the process, with
+      /// one thread less than the number of hardware threads.
+      /// \param[in] _threads Number of worker threads.
+      public: void SetPostUpdateThreadCount(unsigned int _threads);
+
+      /// \brief Get the number of worker threads used to run system
+      /// PostUpdates.
+      /// \return Number of worker threads, or zero if the process-wide pool
+      /// is used.
+      public: unsigned int PostUpdateThreadCount() const;
+
+      /// \brief Set whether parallel loops are split the same way with any
+      /// number of threads, so that results accumulated per chunk, such as
+      /// sums, are bit-reproducible when the number of threads changes.
+      /// This applies to the whole process while a server in deterministic
+      /// mode exists. The default is false.
+      /// \param[in] _deterministic True to make parallel loops independent
+      /// of the number of threads.
+      public: void SetDeterministic(const bool _deterministic);
+
+      /// \brief Get whether parallel loops are split the same way with any
+      /// number of threads.
+      /// \return True in deterministic mode.
+      public: bool Deterministic() const;
+
+      /// \brief Set whether a hash of the ECM state is computed after every
+      /// step. Only the components changed during the step are hashed
+      /// again. The hash of the whole state, of each component type and of
+      /// each top-level model is published on the `state_hash` topic of the
+      /// world, which log recording records, and the hash of the whole
+      /// state is added to the world statistics. Comparing the hashes of
+      /// two runs tells at which step and where they diverged. The default
+      /// is false.
+      /// \param[in] _hash True to hash the state.
+      public: void SetStateHashing(const bool _hash);
+
+      /// \brief Get whether a hash of the ECM state is computed after every
+      /// step.
+      /// \return True if the state is hashed.
+      public: bool StateHashing() const;
+
+      /// \brief Set whether steps are paced precisely. Instead of sleeping
+      /// for the remaining time of the update period, the simulation thread
+      /// sleeps until an absolute deadline and busy-waits for the last
+      /// microseconds, which gives steadier step periods at the cost of some
+      /// CPU time. The jitter of the step start times is then published with
+      /// the world statistics. The default is false.
+      /// \param[in] _precise True to pace steps precisely.
+      public: void SetPreciseStepPacing(const bool _precise);
+
+      /// \brief Get whether steps are paced precisely.
+      /// \return True if steps are paced precisely.
+      public: bool PreciseStepPacing() const;
+
+      /// \brief Set the CPU the simulation thread is pinned to. Only
+      /// supported on Linux. The default, -1, doesn't pin the thread.
+      /// \param[in] _cpu Index of the CPU, or -1.
+      public: void SetSimulationThreadCpu(const int _cpu);
+
+      /// \brief Get the CPU the simulation thread is pinned to.
+      /// \return Index of the CPU, or -1 if the thread isn't pinned.
+      public: int SimulationThreadCpu() const;
+
+      /// \brief Set the real-time priority of the simulation thread. A
+      /// positive priority runs the thread with the SCHED_FIFO policy, which
+      /// requires the corresponding privileges. Only supported on Linux. The
+      /// default, 0, keeps the default scheduling policy.
+      /// \param[in] _priority SCHED_FIFO priority, or 0.
+      public: void SetSimulationThreadPriority(const int _priority);
+
+      /// \brief Get the real-time priority of the simulation thread.
+      /// \return SCHED_FIFO priority, or 0 for the default policy.
+      public: int SimulationThreadPriority() const;
+
+      /// \brief Set whether simulation is stepped in lockstep with an
+      /// external process. Instead of pacing steps with the update rate,
+      /// an unpaused world waits for step credits, which are granted by
+      /// publishing a gz.msgs.UInt32 with the number of steps on the
+      /// `/world/<world_name>/lockstep/step` topic. A gz.msgs.Clock with
+      /// the simulation time is published on
+      /// `/world/<world_name>/lockstep/done` at the end of each of those
+      /// steps. The default is false.
+      /// \param[in] _lockstep True to step in lockstep.
+      public: void SetLockstep(const bool _lockstep);
+
+      /// \brief Get whether simulation is stepped in lockstep with an
+      /// external process.
+      /// \return True if simulation is stepped in lockstep.
+      public: bool Lockstep() const;
+
+      /// \brief Set the rate at which world statistics are published on
+      /// the `/world/<world_name>/stats` and `/stats` topics. The
+      /// statistics are copied on each step, and published at this rate
+      /// from a background thread, as well as right away when simulation is
+      /// paused or resumed. A rate of zero or less builds and publishes
+      /// them from the simulation thread on every step instead, throttled
+      /// to 10 messages per second. The default is 10 Hz.
+      /// \param[in] _hz Publication rate in Hz.
+      public: void SetStatsPublishRate(const double _hz);
+
+      /// \brief Get the rate at which world statistics are published.
+      /// \return Publication rate in Hz, zero or less to publish on every
+      /// step.
+      /// \sa SetStatsPublishRate
+      public: double StatsPublishRate() const;
+
+      /// \brief Set the rate at which the clock is published on the
+      /// `/world/<world_name>/clock` and `/clock` topics, from a background
+      /// thread and independently of the world statistics. A rate of zero or
+      /// less publishes the clock from the simulation thread on every step,
+      /// which is the default.
+      /// \param[in] _hz Publication rate in Hz.
+      public: void SetClockPublishRate(const double _hz);
+
+      /// \brief Get the rate at which the clock is published.
+      /// \return Publication rate in Hz, zero or less to publish on every
+      /// step.
+      /// \sa SetClockPublishRate
+      public: double ClockPublishRate() const;
+
+      /// \brief Set whether the default systems listed in `server.config`
+      /// are loaded for worlds that don't load any system. Use false to only
+      /// run the systems that are explicitly requested, such as in tests.
+      /// The default is true.
+      /// \param[in] _default True to load the default systems.
+      public: void SetUseDefaultPlugins(const bool _default);
+
+      /// \brief Get whether the default systems are loaded for worlds
+      /// that don't load any system.
+      /// \return True if the default systems are loaded.
+      public: bool UseDefaultPlugins() const;
+
+      /// \brief Set whether the server advertises its services and topics,
+      /// such as world control, world statistics and clock. Without
+      /// transport, simulation can only be controlled through the Server
+      /// API, which saves the cost of setting them up and publishing on each
+      /// step. Systems may still use transport. The default is true.
+      /// \param[in] _transport True to advertise services and topics.
+      public: void SetUseTransport(const bool _transport);
+
+      /// \brief Get whether the server advertises its services and topics.
+      /// \return True if the server uses transport, which is false in
+      /// compute-only mode.
+      /// \sa SetComputeOnly
+      public: bool UseTransport() const;
+
+      /// \brief Set whether the server only computes, for headless batch
+      /// experiments such as parameter sweeps. In compute-only mode:
+      ///
+      /// * The server doesn't use transport, see SetUseTransport, so there
+      ///   are no world control services, statistics or clock.
+      /// * The default systems that only serve transport clients, the user
+      ///   commands and the scene broadcaster, aren't loaded. Physics still
+      ///   is.
+      /// * Unpaused steps run back to back, ignoring the update rate.
+      ///
+      /// Simulation is then controlled through the Server API only. The
+      /// default is false.
+      /// \param[in] _computeOnly True to only compute.
+      public: void SetComputeOnly(const bool _computeOnly);
+
+      /// \brief Get whether the server only computes.
+      /// \return True in compute-only mode.
+      /// \sa SetComputeOnly
+      public: bool ComputeOnly() const;
+
+      /// \brief Set whether to time the PreUpdate, Update and PostUpdate
+      /// calls of each system. When enabled, the statistics are published on
+      /// the `/world/<world_name>/profile` topic and printed when the server
+      /// shuts down, and the memory used by the largest component types is
+      /// published on `/world/<world_name>/profile/memory` every 10 seconds.
+      /// The default is false.
+      /// \param[in] _profiling True to enable system profiling.
+      public: void SetUseSystemProfiling(const bool _profiling);
+
+      /// \brief Get whether the calls of each system are timed.
+      /// \return True if system profiling is enabled.
+      public: bool UseSystemProfiling() const;
+
+      /// \brief Set whether every entity gets a dense index, which is
+      /// recycled when the entity is removed. This bounds the size of flat
+      /// per-entity arrays in worlds that keep spawning and removing
+      /// entities. Entity IDs are unchanged and never reused.
+      /// The default is false.
+      /// \param[in] _recycle True to recycle entity indices.
+      /// \sa EntityComponentManager::SetEntityIdRecycling
+      public: void SetEntityIdRecycling(const bool _recycle);
+
+      /// \brief Get whether the indices of removed entities are recycled.
+      /// \return True if entity indices are recycled.
+      public: bool EntityIdRecycling() const;
+
       /// \brief Get whether the server is using the distributed sim system
       /// \return True if the server is set to use the distributed simulation
       /// system
@@ -345,6 +596,49 @@ namespace gz
       /// ~/.gz/fuel.
       public: void SetResourceCache(const std::string &_path);
 
+      /// \brief Path to where loaded world files are stored, so launching
+      /// the same world file again skips resolving its includes and
+      /// resources. Only worlds loaded from a file are cached. Inertias
+      /// computed for meshes are stored in its mesh_inertia subdirectory.
+      /// \return Path to a location on disk. An empty string indicates that
+      /// the GZ_SIM_WORLD_CACHE environment variable will be used, and that
+      /// worlds aren't cached if it isn't set either.
+      public: const std::string &WorldCache() const;
+
+      /// \brief Set the path to where loaded world files are stored.
+      /// \param[in] _path Path to a location on disk. An empty string
+      /// indicates that the GZ_SIM_WORLD_CACHE environment variable will be
+      /// used.
+      /// \sa WorldCache
+      public: void SetWorldCache(const std::string &_path);
+
+      /// \brief Path to a checkpoint saved by the "checkpoint" service of a
+      /// world, that the simulation is resumed from.
+      /// \return Path to the checkpoint, empty to start a new simulation.
+      public: const std::string &RestoreFile() const;
+
+      /// \brief Set the path to a checkpoint to resume the simulation from.
+      /// The checkpoint holds the world it was taken from, with its includes
+      /// expanded, which is loaded instead of the SDF file or string of this
+      /// configuration.
+      /// \param[in] _path Path to the checkpoint, empty to start a new
+      /// simulation.
+      /// \sa RestoreFile
+      public: void SetRestoreFile(const std::string &_path);
+
+      /// \brief Get the number of Fuel models included by the world that
+      /// are downloaded at the same time before the world is loaded.
+      /// \return Number of concurrent downloads, zero if models are only
+      /// fetched one after the other while the world is loaded.
+      public: unsigned int ResourcePrefetchThreads() const;
+
+      /// \brief Set the number of Fuel models included by the world that
+      /// are downloaded at the same time before the world is loaded.
+      /// The default is 8.
+      /// \param[in] _threads Number of concurrent downloads, zero to disable
+      /// prefetching.
+      public: void SetResourcePrefetchThreads(unsigned int _threads);
+
       /// \brief Physics engine plugin library to load.
       /// \return File containing physics engine library.
       public: const std::string &PhysicsEngine() const;
@@ -353,6 +647,20 @@ namespace gz
       /// \param[in] _physicsEngine File containing physics engine library.
       public: void SetPhysicsEngine(const std::string &_physicsEngine);
 
+      /// \brief Get the number of physics steps run per simulation
+      /// iteration.
+      /// \return Number of substeps, zero if the physics system's
+      /// `<substeps>` parameter is used.
+      public: unsigned int PhysicsSubsteps() const;
+
+      /// \brief Set the number of physics steps run per simulation
+      /// iteration. It's set as the world's PhysicsSubsteps component, which
+      /// overrides the physics system's `<substeps>` parameter. The
+      /// component can be changed at runtime. The default is zero.
+      /// \param[in] _substeps Number of substeps, zero to use the physics
+      /// system's `<substeps>` parameter.
+      public: void SetPhysicsSubsteps(unsigned int _substeps);
+
       /// \brief Render engine plugin library to load.
       /// \return File containing render engine library.
       public: const std::string &RenderEngineServer() const;
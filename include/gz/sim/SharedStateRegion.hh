@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SHAREDSTATEREGION_HH_
+#define GZ_SIM_SHAREDSTATEREGION_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/Export.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+/// \brief Kind of entity in a shared state region.
+enum class SharedStateEntityType : std::uint32_t
+{
+  /// \brief A model, with its world pose.
+  Model = 0,
+
+  /// \brief A link, with its world pose and velocities.
+  Link = 1,
+
+  /// \brief A joint, with its positions and velocities.
+  Joint = 2,
+};
+
+/// \brief State of an entity in a shared state region. The layout is fixed,
+/// so the records are copied to and from shared memory as they are.
+struct SharedStateEntity
+{
+  /// \brief The entity.
+  std::uint64_t entity{0u};
+
+  /// \brief Parent of the entity, such as the model of a link.
+  std::uint64_t parent{0u};
+
+  /// \brief Kind of entity.
+  SharedStateEntityType type{SharedStateEntityType::Model};
+
+  /// \brief Number of joint axes, zero for other entities.
+  std::uint32_t jointDofs{0u};
+
+  /// \brief Index of the joint positions in SharedStateFrame::jointValues,
+  /// followed by the velocities.
+  std::uint64_t jointOffset{0u};
+
+  /// \brief Name of the entity, not scoped, truncated and null terminated.
+  char name[64]{};
+
+  /// \brief World pose, as x, y, z, qw, qx, qy, qz.
+  double pose[7]{0, 0, 0, 1, 0, 0, 0};
+
+  /// \brief Linear velocity in the world frame, only set for links.
+  double linearVelocity[3]{};
+
+  /// \brief Angular velocity in the world frame, only set for links.
+  double angularVelocity[3]{};
+};
+
+/// \brief Latest state written to a shared state region.
+struct SharedStateFrame
+{
+  /// \brief Sequence number of the frame, which increases with every write.
+  std::uint64_t sequence{0u};
+
+  /// \brief Changes whenever entities are added or removed, so readers can
+  /// keep lookups by name until it changes.
+  std::uint64_t entitySetVersion{0u};
+
+  /// \brief Simulation time of the step.
+  std::chrono::steady_clock::duration simTime{0};
+
+  /// \brief Iteration of the step.
+  std::uint64_t iterations{0u};
+
+  /// \brief State of the entities.
+  std::vector<SharedStateEntity> entities;
+
+  /// \brief Joint positions and velocities.
+  /// \sa SharedStateEntity::jointOffset
+  std::vector<double> jointValues;
+};
+
+/// \brief Latest simulation state in POSIX shared memory, written by the
+/// SharedMemoryState system and read by processes on the same host.
+///
+/// The region holds a single frame protected by a sequence lock: the writer
+/// makes the sequence odd while it copies the frame in, and readers retry
+/// until they copy a frame with the same even sequence before and after.
+/// The writer never waits for readers, and readers don't need any
+/// transport or serialization. There must be a single writer. Regions
+/// aren't available on Windows.
+///
+/// ## Usage
+///
+/// ```
+/// auto region = SharedStateRegion::Open("/gz_sim_state_default");
+/// SharedStateFrame frame;
+/// while (running)
+/// {
+///   if (region->Sequence() != frame.sequence && region->Read(frame))
+///     plan(frame);
+/// }
+/// ```
+class GZ_SIM_VISIBLE SharedStateRegion
+{
+  /// \brief Create a region, replacing a stale one with the same name. The
+  /// region is removed from the system when the returned object is
+  /// destroyed.
+  /// \param[in] _name Name of the region, starting with "/".
+  /// \param[in] _maxEntities Number of entity records the region can hold.
+  /// \param[in] _maxJointValues Number of joint positions and velocities
+  /// the region can hold.
+  /// \return The region, or nullptr if it couldn't be created.
+  public: static std::unique_ptr<SharedStateRegion> Create(
+              const std::string &_name, std::size_t _maxEntities,
+              std::size_t _maxJointValues);
+
+  /// \brief Open a region created by another process, for reading.
+  /// \param[in] _name Name of the region, starting with "/".
+  /// \return The region, or nullptr if it doesn't exist or is invalid.
+  public: static std::unique_ptr<SharedStateRegion> Open(
+              const std::string &_name);
+
+  /// \brief Destructor. Unmaps the region, and removes it if it was
+  /// created by this object.
+  public: ~SharedStateRegion();
+
+  /// \brief Write a frame, replacing the previous one. Only regions
+  /// returned by Create can be written.
+  /// \param[in] _frame The frame. Its sequence is ignored.
+  /// \return False if the region can't be written, or if the frame didn't
+  /// fit, in which case the entities and joint values that fit are written.
+  public: bool Write(const SharedStateFrame &_frame);
+
+  /// \brief Copy the latest frame. The vectors of the frame keep their
+  /// capacity, so reusing the frame doesn't allocate.
+  /// \param[out] _frame The frame.
+  /// \param[in] _attempts How many times to retry while the writer is
+  /// copying a frame in.
+  /// \return False if nothing was written yet, or if no consistent frame
+  /// was read in the given attempts.
+  public: bool Read(SharedStateFrame &_frame,
+              unsigned int _attempts = 1000u) const;
+
+  /// \brief Get the sequence number of the latest frame without reading
+  /// it, to poll for new frames.
+  /// \return The sequence number, odd while a frame is being written, zero
+  /// if nothing was written yet.
+  public: std::uint64_t Sequence() const;
+
+  /// \brief Number of entity records the region can hold.
+  /// \return Number of records.
+  public: std::size_t MaxEntities() const;
+
+  /// \brief Number of joint values the region can hold.
+  /// \return Number of values.
+  public: std::size_t MaxJointValues() const;
+
+  /// \brief Name of the region.
+  /// \return The name.
+  public: const std::string &Name() const;
+
+  /// \brief Constructor, use Create or Open instead.
+  private: SharedStateRegion();
+
+  /// \brief Private data pointer.
+  GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+}
+#endif
@@ -17,7 +17,9 @@
 #ifndef GZ_SIM_SYSTEM_HH_
 #define GZ_SIM_SYSTEM_HH_
 
+#include <istream>
 #include <memory>
+#include <ostream>
 
 #include <gz/sim/config.hh>
 #include <gz/sim/EntityComponentManager.hh>
@@ -141,6 +143,49 @@ namespace gz
       public: virtual void PostUpdate(const UpdateInfo &_info,
                                       const EntityComponentManager &_ecm) = 0;
     };
+
+    /// \class ISystemConcurrentConfigure ISystem.hh gz/sim/System.hh
+    /// \brief Interface for a system whose Configure and ConfigureParameters
+    /// can run concurrently with those of other systems, for example because
+    /// they spend most of their time loading files or models.
+    ///
+    /// The calls of these systems are deferred until the systems are
+    /// activated, right before the next step, and are then run on the
+    /// shared thread pool. While configuring, such a system may only read
+    /// the entity component manager and must not create, remove or modify
+    /// entities or components, emit events or load other systems. Work that
+    /// needs any of these can be done in the first PreUpdate.
+    class ISystemConcurrentConfigure {
+      /// \brief Whether the system can be configured concurrently. This is
+      /// queried once, when the system is added.
+      /// \return True to allow concurrent configuration.
+      public: virtual bool ConcurrentConfigure() const
+      {
+        return true;
+      }
+    };
+
+    /// \class ISystemSerialize ISystem.hh gz/sim/System.hh
+    /// \brief Interface for a system that keeps state outside of the entity
+    /// component manager, for example controller integrators or random
+    /// number generators, and wants it saved in simulation checkpoints.
+    ///
+    /// Both functions are called on the simulation thread between steps.
+    /// The data is opaque to the simulator, so systems should write a
+    /// version of their own format first. Systems are matched to their
+    /// saved state by parent entity, plugin name and load order.
+    class ISystemSerialize {
+      /// \brief Write the state of the system.
+      /// \param[in] _out Stream to write the state to.
+      /// \return True if the state was written.
+      public: virtual bool SerializeState(std::ostream &_out) const = 0;
+
+      /// \brief Restore the state written by SerializeState. This is called
+      /// after Configure, before the first step of a restored simulation.
+      /// \param[in] _in Stream to read the state from.
+      /// \return True if the state was restored.
+      public: virtual bool DeserializeState(std::istream &_in) = 0;
+    };
   }
   }
 }
@@ -39,7 +39,8 @@ namespace gz
     class GZ_SIM_HIDDEN SystemLoaderPrivate;
 
     /// \class SystemLoader SystemLoader.hh gz/sim/SystemLoader.hh
-    /// \brief Class for loading/unloading System plugins.
+    /// \brief Class for loading/unloading System plugins. A loader can be
+    /// used from several threads at once.
     class GZ_SIM_VISIBLE SystemLoader
     {
       /// \brief Constructor
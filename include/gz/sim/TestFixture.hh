@@ -55,6 +55,22 @@ inline namespace GZ_SIM_VERSION_NAMESPACE {
 /// fixture.Server()->Run(true, 1000, false);
 /// ```
 ///
+/// Tests that don't need the default systems nor transport can start faster
+/// with a fixture constructed from MinimalConfig, and share it across tests
+/// by calling Reset between them, instead of constructing a server for each
+/// test:
+///
+/// ```
+/// // Load the world once, with only the systems in its SDF
+/// static gz::sim::TestFixture fixture(
+///     gz::sim::TestFixture::MinimalConfig("path_to.sdf"));
+/// fixture.Finalize();
+///
+/// // At the start of each test
+/// fixture.Reset().OnPostUpdate(...);
+/// fixture.Server()->Run(true, 1000, false);
+/// ```
+///
 class GZ_SIM_VISIBLE TestFixture
 {
   /// \brief Constructor
@@ -68,6 +84,22 @@ class GZ_SIM_VISIBLE TestFixture
   /// \brief Destructor
   public: virtual ~TestFixture() = default;
 
+  /// \brief Get a server configuration for fast tests, which only loads
+  /// the systems in the SDF file and those added explicitly, and doesn't set
+  /// up the server services and topics.
+  /// \param[in] _path Path to SDF file.
+  /// \return Server configuration.
+  /// \sa ServerConfig::SetUseDefaultPlugins
+  /// \sa ServerConfig::SetUseTransport
+  public: static ServerConfig MinimalConfig(const std::string &_path);
+
+  /// \brief Reset all worlds of the server to their initial state, and
+  /// clear all the callbacks, so that the fixture can be reused by another
+  /// test. The `OnConfigure` callback isn't called again. Reset must not be
+  /// called while the server is running.
+  /// \return Reference to self.
+  public: TestFixture &Reset();
+
   /// \brief Wrapper around a system's pre-update callback
   /// \param[in] _cb Function to be called every pre-update
   /// The _entity and _sdf will correspond to the world entity.
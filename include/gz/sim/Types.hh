@@ -18,6 +18,7 @@
 #define GZ_SIM_TYPES_HH_
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <utility>
@@ -77,6 +78,22 @@ namespace gz
       OneTimeChange = 2
     };
 
+    /// \brief Memory layouts the EntityComponentManager can use to store
+    /// component instances.
+    enum class ComponentStorageType
+    {
+      /// \brief Every component instance is allocated individually on the
+      /// heap. This is the default.
+      kHeap = 0,
+
+      /// \brief Component instances of the same type are packed into
+      /// contiguous, fixed-size chunks. Entities created one after another
+      /// (e.g. all links of a model) end up next to each other in memory,
+      /// which makes iterating over views more cache friendly. Component
+      /// addresses remain stable for the lifetime of the component.
+      kContiguous = 1
+    };
+
     /// \brief A unique identifier for a component type. A component type
     /// must be derived from `components::BaseComponent` and can contain plain
     /// data or something more complex like `gz::math::Pose3d`.
@@ -88,6 +105,22 @@ namespace gz
 
     /// \brief Id that indicates an invalid component type.
     static const ComponentTypeId kComponentTypeIdInvalid = UINT64_MAX;
+
+    /// \brief Memory held by a group of components, such as all components
+    /// of a type or all components of a model's entities.
+    /// \sa EntityComponentManager::ComponentMemoryUsageByType
+    struct ComponentMemoryUsage
+    {
+      /// \brief Number of components.
+      std::size_t count{0};
+
+      /// \brief Bytes taken by the component objects themselves.
+      std::size_t bytes{0};
+
+      /// \brief Estimated bytes allocated on the heap by the components'
+      /// data, such as strings, SDF elements and environmental data.
+      std::size_t heapBytes{0};
+    };
     }
   }
 }
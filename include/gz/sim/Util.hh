@@ -19,6 +19,7 @@
 
 #include <gz/msgs/entity.pb.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -190,6 +191,32 @@ namespace gz
         const Entity &_entity,
         const EntityComponentManager &_ecm);
 
+    /// \brief Get the activity level of an entity, which is the activity
+    /// level of its top level model. The level manager sets it from the
+    /// distance to the nearest performer when `<activity>` is configured.
+    /// \param[in] _entity Input entity
+    /// \param[in] _ecm Constant reference to ECM.
+    /// \return Activity level, 0 if the entity is fully active or has no
+    /// activity level.
+    /// \sa components::ActivityLevel
+    unsigned int GZ_SIM_VISIBLE activityLevel(
+        const Entity &_entity,
+        const EntityComponentManager &_ecm);
+
+    /// \brief Check whether an entity should be updated on an iteration,
+    /// for systems that update far entities at reduced rates. Entities at
+    /// activity level 0 are updated on every iteration, and entities at
+    /// level N every 2^N iterations. Top level models are spread over those
+    /// iterations, so they aren't all updated on the same one.
+    /// \param[in] _entity Input entity
+    /// \param[in] _ecm Constant reference to ECM.
+    /// \param[in] _iteration Iteration being updated.
+    /// \return True if the entity should be updated.
+    bool GZ_SIM_VISIBLE activityUpdateDue(
+        const Entity &_entity,
+        const EntityComponentManager &_ecm,
+        const uint64_t _iteration);
+
     /// \brief Helper function to generate a valid transport topic, given
     /// a list of topics ordered by preference. The generated topic will be,
     /// in this order:
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_WAVEFIELD_HH_
+#define GZ_SIM_WAVEFIELD_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/Export.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+/// \brief Surface of a body of water, as a sum of Gerstner waves in deep
+/// water. The mean surface is at z = 0.
+///
+/// The field is defined by its waves only, so every consumer which has a
+/// copy, whether in the server or in a GUI, sees the same surface at the
+/// same time. Queries take many points at once: the parameters of the waves
+/// and the coordinates of the points are stored in contiguous arrays and
+/// evaluated wave by wave, in loops over the points which the compiler can
+/// vectorize.
+///
+/// \sa components::Waves
+class GZ_SIM_VISIBLE WaveField
+{
+  /// \brief A single wave.
+  public: struct Wave
+  {
+    /// \brief Height of the crests above the mean surface [m].
+    double amplitude{0.0};
+
+    /// \brief Distance between crests [m].
+    double wavelength{1.0};
+
+    /// \brief Direction of propagation, counter clockwise from +x [rad].
+    double direction{0.0};
+
+    /// \brief Phase at the origin at time 0 [rad].
+    double phase{0.0};
+
+    /// \brief Horizontal motion of the surface, as a fraction of the
+    /// amplitude, between 0 for sine waves and 1 for the circular orbits
+    /// of deep water waves, which have sharper crests.
+    double steepness{0.0};
+  };
+
+  /// \brief Parameters of a Pierson-Moskowitz spectrum of a fully
+  /// developed sea.
+  public: struct Spectrum
+  {
+    /// \brief Wind speed at 19.5 m above the surface [m/s].
+    double windSpeed{5.0};
+
+    /// \brief Direction the wind blows towards, counter clockwise from +x
+    /// [rad].
+    double windDirection{0.0};
+
+    /// \brief Number of waves to sample.
+    std::size_t count{16u};
+
+    /// \brief Largest angle between a wave and the wind [rad].
+    double spread{0.5};
+
+    /// \brief Steepness of every wave, as in Wave.
+    double steepness{0.0};
+
+    /// \brief Seed of the phases and directions of the waves.
+    std::uint32_t seed{0u};
+  };
+
+  /// \brief Constructor of a flat surface.
+  public: WaveField();
+
+  /// \brief Constructor.
+  /// \param[in] _waves Waves. Waves without an amplitude or with a
+  /// wavelength which isn't positive are dropped.
+  /// \param[in] _gravity Magnitude of gravity, which sets the speed of the
+  /// waves [m/s^2].
+  public: explicit WaveField(const std::vector<Wave> &_waves,
+              double _gravity = 9.80665);
+
+  /// \brief Sample waves from a spectrum. The same parameters always give
+  /// the same waves.
+  /// \param[in] _spectrum Parameters of the spectrum.
+  /// \param[in] _gravity Magnitude of gravity [m/s^2].
+  /// \return The waves, or none if the wind speed isn't positive.
+  public: static std::vector<Wave> FromSpectrum(const Spectrum &_spectrum,
+              double _gravity = 9.80665);
+
+  /// \brief Get the waves.
+  /// \return The waves.
+  public: const std::vector<Wave> &Waves() const;
+
+  /// \brief Get the magnitude of gravity.
+  /// \return Gravity [m/s^2].
+  public: double Gravity() const;
+
+  /// \brief Get the height of the surface at a position.
+  /// \param[in] _time Simulation time [s].
+  /// \param[in] _position Horizontal position [m].
+  /// \return Height above the mean surface [m].
+  public: double Height(double _time, const math::Vector2d &_position) const;
+
+  /// \brief Get the height of the surface at several positions.
+  /// \param[in] _time Simulation time [s].
+  /// \param[in] _positions Horizontal positions [m].
+  /// \param[out] _heights Height at each position [m].
+  public: void Heights(double _time,
+              const std::vector<math::Vector2d> &_positions,
+              std::vector<double> &_heights) const;
+
+  /// \brief Get the velocity of the water at a point.
+  /// \param[in] _time Simulation time [s].
+  /// \param[in] _position Point [m]. The orbits shrink with depth, and
+  /// points above the mean surface move as the surface does.
+  /// \return Velocity [m/s].
+  public: math::Vector3d Velocity(double _time,
+              const math::Vector3d &_position) const;
+
+  /// \brief Get the velocity of the water at several points.
+  /// \param[in] _time Simulation time [s].
+  /// \param[in] _positions Points [m], as in Velocity.
+  /// \param[out] _velocities Velocity at each point [m/s].
+  public: void Velocities(double _time,
+              const std::vector<math::Vector3d> &_positions,
+              std::vector<math::Vector3d> &_velocities) const;
+
+  /// \brief Get where points of the surface are, such as the vertices of a
+  /// mesh rendering it.
+  /// \param[in] _time Simulation time [s].
+  /// \param[in] _rest Horizontal position of each point on the flat
+  /// surface [m].
+  /// \param[out] _points Position of each point on the waves [m].
+  public: void Displacements(double _time,
+              const std::vector<math::Vector2d> &_rest,
+              std::vector<math::Vector3d> &_points) const;
+
+  /// \brief Private data pointer.
+  GZ_UTILS_IMPL_PTR(dataPtr)
+};
+
+/// \brief Write the waves of a field, which is enough to rebuild it.
+/// \param[in] _out Output stream.
+/// \param[in] _field The field.
+/// \return The stream.
+GZ_SIM_VISIBLE std::ostream &operator<<(std::ostream &_out,
+    const WaveField &_field);
+
+/// \brief Read a field written by operator<<.
+/// \param[in] _in Input stream.
+/// \param[out] _field The field, unchanged if the stream isn't valid.
+/// \return The stream.
+GZ_SIM_VISIBLE std::istream &operator>>(std::istream &_in,
+    WaveField &_field);
+}
+}
+}
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_WRENCHACCUMULATOR_HH_
+#define GZ_SIM_WRENCHACCUMULATOR_HH_
+
+#include <cstddef>
+
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/Entity.hh"
+#include "gz/sim/Export.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+// Forward declarations.
+class EntityComponentManager;
+
+/// \brief Wrenches added to links during a step, which are merged into
+/// their `components::ExternalWorldWrenchCmd` before physics.
+///
+/// Systems such as buoyancy, hydrodynamics or lift and drag add wrenches
+/// to the same links every step. Adding them to the accumulator only reads
+/// the entity component manager, and it's thread safe: each thread appends
+/// to one of several buffers, so threads rarely contend. The simulation
+/// runner applies the accumulated wrenches after PreUpdate, and the physics
+/// system before it steps, so wrenches added during Update before physics
+/// are applied in the same step. The wrenches of each link are summed in an
+/// order that only depends on their values, so the result doesn't depend
+/// on which threads added them.
+///
+/// ## Usage
+///
+/// ```
+/// void PreUpdate(const UpdateInfo &_info,
+///     EntityComponentManager &_ecm) override
+/// {
+///   Link(this->link).AddWorldWrench(_ecm, _ecm.Wrenches(), force, torque);
+/// }
+/// ```
+///
+/// \sa EntityComponentManager::Wrenches
+class GZ_SIM_VISIBLE WrenchAccumulator
+{
+  /// \brief Constructor.
+  public: WrenchAccumulator();
+
+  /// \brief Add a wrench to a link. This is thread safe.
+  /// \param[in] _link The link entity.
+  /// \param[in] _force Force expressed in world coordinates and applied at
+  /// the link origin.
+  /// \param[in] _torque Torque expressed in world coordinates.
+  public: void Add(const Entity _link, const math::Vector3d &_force,
+              const math::Vector3d &_torque);
+
+  /// \brief Get the sum of the wrenches added to a link since they were
+  /// last applied. This is thread safe.
+  /// \param[in] _link The link entity.
+  /// \param[out] _force Sum of the forces.
+  /// \param[out] _torque Sum of the torques.
+  /// \return False if no wrench was added to the link.
+  public: bool Wrench(const Entity _link, math::Vector3d &_force,
+              math::Vector3d &_torque) const;
+
+  /// \brief Get the number of wrenches added since they were last applied.
+  /// \return Number of wrenches.
+  public: std::size_t Size() const;
+
+  /// \brief Sum the added wrenches of each link and add them to its
+  /// `components::ExternalWorldWrenchCmd`, creating it if needed. Wrenches
+  /// of entities that don't exist are dropped. This must not be called
+  /// while other threads add wrenches.
+  /// \param[in] _ecm Mutable reference to the ECM.
+  public: void Apply(EntityComponentManager &_ecm);
+
+  /// \brief Drop the added wrenches without applying them.
+  public: void Clear();
+
+  /// \brief Private data pointer.
+  GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+}
+#endif
@@ -71,6 +71,11 @@ namespace comms
   ///                    The default value is "/broker/bind"
   ///    <unbind_service>: Service name used to unbind from an address.
   ///                      The default value is "/broker/unbind"
+  ///    <batch_delivery>: If true, all the messages delivered to an address
+  ///                      in a step are published together as a single
+  ///                      message, which can be unpacked with
+  ///                      comms::UnpackMsgs or by a CommsEndpoint system.
+  ///                      The default value is false.
   ///
   /// Here's an example:
   /// <plugin
@@ -125,7 +130,8 @@ namespace comms
     public: void OnUnbind(const gz::msgs::StringMsg_V &_req);
 
     /// \brief Callback executed to process a communication request from one of
-    /// the clients.
+    /// the clients. This doesn't wait for the mutex: if it's locked, the
+    /// message is placed in the outbound queue when it's next locked.
     /// \param[in] _msg The message from the client.
     public: void OnMsg(const gz::msgs::Dataframe &_msg);
 
@@ -137,7 +143,8 @@ namespace comms
     /// \return The mutable reference.
     public: MsgManager &DataManager();
 
-    /// \brief Lock the mutex to access the message manager.
+    /// \brief Lock the mutex to access the message manager. Messages received
+    /// while it was locked are placed in their outbound queues.
     public: void Lock();
 
     /// \brief Unlock the mutex to access the message manager.
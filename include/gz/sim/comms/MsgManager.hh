@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <gz/transport/Node.hh>
 #include <gz/utils/ImplPtr.hh>
@@ -71,6 +72,26 @@ struct AddressContent
 /// information associated to each address (subscribers, queues, ...).
 using Registry = std::unordered_map<std::string, AddressContent>;
 
+/// \brief Key of the header data of a batch of messages. Its value is the
+/// number of messages in the batch.
+/// \sa PackMsgs
+constexpr const char *kBatchSizeKey = "batch_size";
+
+/// \brief Pack messages into a single message. The messages are serialized
+/// in order into its data, each preceded by its size in bytes as 4 bytes in
+/// little endian order, and the header data gets a kBatchSizeKey entry.
+/// \param[in] _msgs The messages.
+/// \param[out] _batch The message holding all of them.
+void GZ_SIM_VISIBLE PackMsgs(const DataQueue &_msgs,
+                             msgs::Dataframe &_batch);
+
+/// \brief Unpack the messages packed by PackMsgs.
+/// \param[in] _batch The message holding the batch.
+/// \param[out] _msgs The messages, in the order in which they were packed.
+/// \return False if _batch isn't a batch or is malformed.
+bool GZ_SIM_VISIBLE UnpackMsgs(const msgs::Dataframe &_batch,
+                               std::vector<msgs::Dataframe> &_msgs);
+
 /// \brief Class to handle messages and subscriptions.
 class GZ_SIM_VISIBLE MsgManager
 {
@@ -124,8 +145,22 @@ class GZ_SIM_VISIBLE MsgManager
 
   /// \brief This function delivers all the messages in the inbound queue to
   /// the appropriate subscribers. This function also clears the inbound queue.
+  /// In batched mode, the messages of each address are published together as
+  /// a single message.
+  /// \sa SetBatched
   public: void DeliverMsgs();
 
+  /// \brief Set whether the inbound messages of an address are delivered as
+  /// a single message packed by PackMsgs instead of one by one. This reduces
+  /// the number of publications when addresses receive many small messages.
+  /// \param[in] _batched True to pack the messages.
+  public: void SetBatched(bool _batched);
+
+  /// \brief Get whether the messages are delivered in batches.
+  /// \return True if they are.
+  /// \sa SetBatched
+  public: bool Batched() const;
+
   /// \brief Get an inmutable reference to the data containing subscriptions and
   /// data queues.
   /// \return A const reference to the data.
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_COMPONENTS_ACTIVITYLEVEL_HH_
+#define GZ_SIM_COMPONENTS_ACTIVITYLEVEL_HH_
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+#include "gz/sim/components/Factory.hh"
+#include "gz/sim/components/Component.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace components
+{
+  /// \brief Activity level of a top-level model, set by the level manager
+  /// from the distance to the nearest performer. Level 0 is fully active,
+  /// and higher levels are farther away from all performers, so systems
+  /// may update them at reduced rates.
+  /// \sa activityLevel, activityUpdateDue
+  using ActivityLevel = Component<unsigned int, class ActivityLevelTag>;
+  GZ_SIM_REGISTER_COMPONENT("gz_sim_components.ActivityLevel",
+      ActivityLevel)
+}
+}
+}
+}
+#endif
@@ -17,8 +17,10 @@
 #ifndef GZ_SIM_COMPONENTS_COMPONENT_HH_
 #define GZ_SIM_COMPONENTS_COMPONENT_HH_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <sstream>
 #include <utility>
@@ -96,6 +98,30 @@ namespace traits
     public: static constexpr bool value =  // NOLINT
                 decltype(Test<Stream, DataType>(0))::value;
   };
+
+  /// \brief Type trait that determines if a serializer can also write its
+  /// data into a byte buffer, i.e, it checks if the function
+  /// `std::optional<std::size_t> Serializer::SerializedSize(const Args&...)`
+  /// exists. Serializers of components without data take no arguments.
+  /// Example:
+  /// \code
+  ///    constexpr bool hasBinaryString = HasBinarySerializer<
+  ///       StringSerializer, std::string>::value
+  /// \endcode
+  template <typename Serializer, typename... Args>
+  class HasBinarySerializer
+  {
+    private: template <typename SerializerArg>
+    static auto Test(int _test)
+      -> decltype(SerializerArg::SerializedSize(
+                      std::declval<const Args &>()...), std::true_type());
+
+    private: template <typename>
+    static auto Test(...) -> std::false_type;
+
+    public: static constexpr bool value =  // NOLINT
+                decltype(Test<Serializer>(0))::value;
+  };
 }
 
 namespace serializers
@@ -221,6 +247,24 @@ namespace serializers
     {
       return _in;
     }
+
+    public: static std::optional<std::size_t> SerializedSize()
+    {
+      return 1u;
+    }
+
+    public: static bool SerializeTo(char *_out, std::size_t _size)
+    {
+      if (_size != 1u)
+        return false;
+      _out[0] = '-';
+      return true;
+    }
+
+    public: static bool DeserializeFrom(const char *, std::size_t)
+    {
+      return true;
+    }
   };
 }
 
@@ -358,6 +402,28 @@ namespace components
     // Documentation inherited
     public: void Deserialize(std::istream &_in) override;
 
+    /// \brief Get the size of the binary serialization of the component, so
+    /// that a buffer can be allocated before calling SerializeTo. This avoids
+    /// the stream allocations of Serialize. The bytes written are the same as
+    /// Serialize's, since they may be read with Deserialize. Type-erased
+    /// callers reach this through ComponentDataOps::SerializedSize.
+    /// \return Size in bytes, or nullopt if the serializer doesn't have a
+    /// binary form.
+    public: std::optional<std::size_t> SerializedSize() const;
+
+    /// \brief Write the binary serialization of the component into a buffer.
+    /// \param[out] _out Buffer to write to.
+    /// \param[in] _size Size of the buffer, which must be SerializedSize().
+    /// \return True if the component was written.
+    public: bool SerializeTo(char *_out, std::size_t _size) const;
+
+    /// \brief Fill the component from a buffer written by SerializeTo.
+    /// \param[in] _in Buffer to read from.
+    /// \param[in] _size Size of the buffer.
+    /// \return True if the component was read, false if the buffer must be
+    /// read with Deserialize instead.
+    public: bool DeserializeFrom(const char *_in, std::size_t _size);
+
     /// \brief Get the mutable component data. This function will be
     /// deprecated in Gazebo 3, replaced by const DataType &Data() const.
     /// Use void SetData(const DataType &) to modify data.
@@ -427,6 +493,28 @@ namespace components
     // Documentation inherited
     public: void Deserialize(std::istream &_in) override;
 
+    /// \brief Get the size of the binary serialization of the component, so
+    /// that a buffer can be allocated before calling SerializeTo. This avoids
+    /// the stream allocations of Serialize. The bytes written are the same as
+    /// Serialize's, since they may be read with Deserialize. Type-erased
+    /// callers reach this through ComponentDataOps::SerializedSize.
+    /// \return Size in bytes, or nullopt if the serializer doesn't have a
+    /// binary form.
+    public: std::optional<std::size_t> SerializedSize() const;
+
+    /// \brief Write the binary serialization of the component into a buffer.
+    /// \param[out] _out Buffer to write to.
+    /// \param[in] _size Size of the buffer, which must be SerializedSize().
+    /// \return True if the component was written.
+    public: bool SerializeTo(char *_out, std::size_t _size) const;
+
+    /// \brief Fill the component from a buffer written by SerializeTo.
+    /// \param[in] _in Buffer to read from.
+    /// \param[in] _size Size of the buffer.
+    /// \return True if the component was read, false if the buffer must be
+    /// read with Deserialize instead.
+    public: bool DeserializeFrom(const char *_in, std::size_t _size);
+
     /// \brief Unique ID for this component type. This is set through the
     /// Factory registration.
     public: inline static ComponentTypeId typeId{0};
@@ -500,6 +588,51 @@ namespace components
     Serializer::Deserialize(_in, this->Data());
   }
 
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  std::optional<std::size_t>
+  Component<DataType, Identifier, Serializer>::SerializedSize() const
+  {
+    if constexpr (traits::HasBinarySerializer<Serializer, DataType>::value)
+      return Serializer::SerializedSize(this->Data());
+    else
+      return std::nullopt;
+  }
+
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  bool Component<DataType, Identifier, Serializer>::SerializeTo(
+      char *_out, std::size_t _size) const
+  {
+    if constexpr (traits::HasBinarySerializer<Serializer, DataType>::value)
+    {
+      return Serializer::SerializeTo(_out, _size, this->Data());
+    }
+    else
+    {
+      (void)_out;
+      (void)_size;
+      return false;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  bool Component<DataType, Identifier, Serializer>::DeserializeFrom(
+      const char *_in, std::size_t _size)
+  {
+    if constexpr (traits::HasBinarySerializer<Serializer, DataType>::value)
+    {
+      return Serializer::DeserializeFrom(_in, _size, this->Data());
+    }
+    else
+    {
+      (void)_in;
+      (void)_size;
+      return false;
+    }
+  }
+
   //////////////////////////////////////////////////
   template <typename DataType, typename Identifier, typename Serializer>
   std::unique_ptr<BaseComponent>
@@ -563,6 +696,51 @@ namespace components
   {
     Serializer::Deserialize(_in);
   }
+
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  std::optional<std::size_t>
+  Component<NoData, Identifier, Serializer>::SerializedSize() const
+  {
+    if constexpr (traits::HasBinarySerializer<Serializer>::value)
+      return Serializer::SerializedSize();
+    else
+      return std::nullopt;
+  }
+
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  bool Component<NoData, Identifier, Serializer>::SerializeTo(
+      char *_out, std::size_t _size) const
+  {
+    if constexpr (traits::HasBinarySerializer<Serializer>::value)
+    {
+      return Serializer::SerializeTo(_out, _size);
+    }
+    else
+    {
+      (void)_out;
+      (void)_size;
+      return false;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  bool Component<NoData, Identifier, Serializer>::DeserializeFrom(
+      const char *_in, std::size_t _size)
+  {
+    if constexpr (traits::HasBinarySerializer<Serializer>::value)
+    {
+      return Serializer::DeserializeFrom(_in, _size);
+    }
+    else
+    {
+      (void)_in;
+      (void)_size;
+      return false;
+    }
+  }
 }
 }
 }
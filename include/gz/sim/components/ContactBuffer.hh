@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_COMPONENTS_CONTACTBUFFER_HH_
+#define GZ_SIM_COMPONENTS_CONTACTBUFFER_HH_
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include <gz/msgs/contacts.pb.h>
+#include <gz/msgs/Utility.hh>
+
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/Entity.hh>
+#include <gz/sim/components/Component.hh>
+#include <gz/sim/components/Factory.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace components
+{
+  /// \brief Contacts of a collision with other collisions during the last
+  /// physics step, stored in flat arrays instead of messages. The physics
+  /// system reuses the arrays every step, so reading contacts doesn't
+  /// allocate, and they only need to be converted to messages when they're
+  /// published, see AppendTo.
+  struct ContactBufferData
+  {
+    /// \brief Contacts with one other collision. They're a range of the
+    /// contact point arrays.
+    public: struct Pair
+    {
+      /// \brief The other collision.
+      public: Entity collision2{kNullEntity};
+
+      /// \brief Index of the first contact point of the pair.
+      public: std::size_t first{0};
+
+      /// \brief Number of contact points of the pair.
+      public: std::size_t count{0};
+
+      /// \brief Equality operator.
+      /// \param[in] _pair Pair to compare to.
+      /// \return True if the pairs are equal.
+      public: bool operator==(const Pair &_pair) const
+      {
+        return this->collision2 == _pair.collision2 &&
+               this->first == _pair.first && this->count == _pair.count;
+      }
+    };
+
+    /// \brief Remove all contacts, keeping the storage.
+    public: void Clear()
+    {
+      this->pairs.clear();
+      this->positions.clear();
+      this->normals.clear();
+      this->forces.clear();
+      this->depths.clear();
+    }
+
+    /// \brief Check whether there are no contacts.
+    /// \return True if there are no contacts.
+    public: bool Empty() const
+    {
+      return this->positions.empty();
+    }
+
+    /// \brief Check whether the normals, forces and depths of the contact
+    /// points are available. Not all physics engines provide them.
+    /// \return True if they're available.
+    public: bool HasExtraData() const
+    {
+      return !this->positions.empty() &&
+             this->normals.size() == this->positions.size();
+    }
+
+    /// \brief Append the contacts to a message, one contact per pair. The
+    /// collision names aren't set.
+    /// \param[in] _collision1 The collision that has the contacts.
+    /// \param[out] _contacts Message to append to.
+    public: void AppendTo(const Entity _collision1,
+                          msgs::Contacts &_contacts) const
+    {
+      const bool extraData = this->HasExtraData();
+      for (const auto &pair : this->pairs)
+      {
+        auto *contactMsg = _contacts.add_contact();
+        contactMsg->mutable_collision1()->set_id(_collision1);
+        contactMsg->mutable_collision2()->set_id(pair.collision2);
+        for (std::size_t i = pair.first; i < pair.first + pair.count; ++i)
+        {
+          msgs::Set(contactMsg->add_position(), this->positions[i]);
+          if (!extraData)
+            continue;
+
+          msgs::Set(contactMsg->add_normal(), this->normals[i]);
+          auto *wrench = contactMsg->add_wrench();
+          msgs::Set(wrench->mutable_body_1_wrench()->mutable_force(),
+              this->forces[i]);
+          // The force on the second body is equal and opposite
+          msgs::Set(wrench->mutable_body_2_wrench()->mutable_force(),
+              -this->forces[i]);
+          contactMsg->add_depth(this->depths[i]);
+        }
+      }
+    }
+
+    /// \brief Equality operator.
+    /// \param[in] _data Data to compare to.
+    /// \return True if the contacts are equal.
+    public: bool operator==(const ContactBufferData &_data) const
+    {
+      return this->pairs == _data.pairs &&
+             this->positions == _data.positions &&
+             this->normals == _data.normals &&
+             this->forces == _data.forces &&
+             this->depths == _data.depths &&
+             this->entityNames == _data.entityNames;
+    }
+
+    /// \brief Inequality operator.
+    /// \param[in] _data Data to compare to.
+    /// \return True if the contacts are different.
+    public: bool operator!=(const ContactBufferData &_data) const
+    {
+      return !(*this == _data);
+    }
+
+    /// \brief Contacts grouped by the other collision.
+    public: std::vector<Pair> pairs;
+
+    /// \brief Position of each contact point, in the world frame.
+    public: std::vector<math::Vector3d> positions;
+
+    /// \brief Normal of each contact point, in the world frame. Empty if
+    /// the physics engine doesn't provide it.
+    public: std::vector<math::Vector3d> normals;
+
+    /// \brief Force on this collision at each contact point, in the world
+    /// frame. Empty if the physics engine doesn't provide it.
+    public: std::vector<math::Vector3d> forces;
+
+    /// \brief Penetration depth of each contact point. Empty if the physics
+    /// engine doesn't provide it.
+    public: std::vector<double> depths;
+
+    /// \brief Whether the collision names should be set when the contacts
+    /// are published. The physics system sets it from the
+    /// `<include_entity_names>` element of its configuration.
+    public: bool entityNames{true};
+  };
+}
+
+namespace serializers
+{
+  /// \brief Serializer for ContactBufferData object
+  class ContactBufferSerializer
+  {
+    /// \brief Serialization for `ContactBufferData`.
+    /// \param[in] _out Output stream.
+    /// \param[in] _data ContactBufferData object to stream
+    /// \return The stream.
+    public: static std::ostream &Serialize(
+                std::ostream &_out,
+                const components::ContactBufferData &_data)
+    {
+      _out << _data.pairs.size();
+      for (const auto &pair : _data.pairs)
+        _out << " " << pair.collision2 << " " << pair.first << " "
+             << pair.count;
+
+      const bool extraData = _data.HasExtraData();
+      _out << " " << _data.positions.size() << " " << extraData;
+      for (std::size_t i = 0; i < _data.positions.size(); ++i)
+      {
+        _out << " " << _data.positions[i];
+        if (extraData)
+        {
+          _out << " " << _data.normals[i] << " " << _data.forces[i] << " "
+               << _data.depths[i];
+        }
+      }
+      _out << " " << _data.entityNames;
+      return _out;
+    }
+
+    /// \brief Deserialization for `ContactBufferData`.
+    /// \param[in] _in Input stream.
+    /// \param[out] _data ContactBufferData object to populate
+    /// \return The stream.
+    public: static std::istream &Deserialize(
+                std::istream &_in, components::ContactBufferData &_data)
+    {
+      _data.Clear();
+
+      std::size_t pairCount{0};
+      _in >> pairCount;
+      for (std::size_t i = 0; i < pairCount && _in; ++i)
+      {
+        components::ContactBufferData::Pair pair;
+        _in >> pair.collision2 >> pair.first >> pair.count;
+        _data.pairs.push_back(pair);
+      }
+
+      std::size_t pointCount{0};
+      bool extraData{false};
+      _in >> pointCount >> extraData;
+      for (std::size_t i = 0; i < pointCount && _in; ++i)
+      {
+        math::Vector3d position;
+        _in >> position;
+        _data.positions.push_back(position);
+        if (extraData)
+        {
+          math::Vector3d normal;
+          math::Vector3d force;
+          double depth{0.0};
+          _in >> normal >> force >> depth;
+          _data.normals.push_back(normal);
+          _data.forces.push_back(force);
+          _data.depths.push_back(depth);
+        }
+      }
+
+      // Older data doesn't have the flag, keep the default then
+      bool entityNames{true};
+      if (_in >> entityNames)
+        _data.entityNames = entityNames;
+      else if (_in.eof())
+        _in.clear(std::ios::eofbit);
+      return _in;
+    }
+  };
+}
+
+namespace components
+{
+  /// \brief A component with the contacts of a collision from the last
+  /// physics step, in a layout that can be read without allocating.
+  /// Systems that need contacts of a collision create this component, and
+  /// the physics system fills it. Unlike ContactSensorData, it doesn't use
+  /// messages, so it's cheaper to fill and read in scenes with many
+  /// contacts.
+  using ContactBuffer =
+      Component<ContactBufferData, class ContactBufferTag,
+                serializers::ContactBufferSerializer>;
+  GZ_SIM_REGISTER_COMPONENT("gz_sim_components.ContactBuffer",
+                                ContactBuffer)
+}
+}
+}
+}
+
+#endif
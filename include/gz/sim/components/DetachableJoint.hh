@@ -96,6 +96,16 @@ namespace components
                 serializers::DetachableJointInfoSerializer>;
   GZ_SIM_REGISTER_COMPONENT("gz_sim_components.DetachableJoint",
                                 DetachableJoint)
+
+  /// \brief A component that enables or disables a detachable joint in
+  /// place. While it's false, the physics system detaches the links, and
+  /// setting it back to true attaches them again at their current relative
+  /// pose, without creating or removing the joint entity. Detachable joints
+  /// without this component are enabled.
+  using DetachableJointEnabled =
+      Component<bool, class DetachableJointEnabledTag>;
+  GZ_SIM_REGISTER_COMPONENT("gz_sim_components.DetachableJointEnabled",
+                                DetachableJointEnabled)
 }
 }
 }
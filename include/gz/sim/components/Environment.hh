@@ -18,6 +18,7 @@
 #ifndef GZ_SIM_ENVIRONMENT_HH_
 #define GZ_SIM_ENVIRONMENT_HH_
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -28,6 +29,8 @@
 
 #include <gz/sim/components/Factory.hh>
 #include <gz/sim/components/Component.hh>
+#include <gz/sim/components/HeapSize.hh>
+#include <gz/sim/RegularGrid.hh>
 
 namespace gz
 {
@@ -82,6 +85,31 @@ namespace components
 
     /// \brief Use time axis or not.
     bool staticTime;
+
+    /// \brief Estimated number of bytes held by the frame, set by whoever
+    /// loads the data. Zero if unknown.
+    std::size_t frameBytes{0};
+
+    /// \brief The same data as the frame, if it's sampled on a regular
+    /// grid, for faster lookups. May be nullptr.
+    std::shared_ptr<const RegularGrid> grid;
+  };
+
+  /// \brief The frame's storage can't be inspected, so the estimate made
+  /// when the data was loaded is used.
+  template <>
+  struct HeapSize<EnvironmentalData>
+  {
+    /// \brief Whether the heap usage can be estimated from the data.
+    static constexpr bool kSupported = true;
+
+    /// \brief Estimated heap bytes.
+    /// \param[in] _data The environmental data.
+    /// \return The estimate of the frame size.
+    static std::size_t Of(const EnvironmentalData &_data)
+    {
+      return _data.frameBytes;
+    }
   };
 
   /// \brief A component type that contains a environment data.
@@ -17,18 +17,25 @@
 #ifndef GZ_SIM_COMPONENTS_FACTORY_HH_
 #define GZ_SIM_COMPONENTS_FACTORY_HH_
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <deque>
 #include <map>
 #include <memory>
+#include <new>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <gz/common/SingletonT.hh>
 #include <gz/common/Util.hh>
 #include <gz/sim/components/Component.hh>
+#include <gz/sim/components/FlatSerialization.hh>
+#include <gz/sim/components/HeapSize.hh>
 #include <gz/sim/config.hh>
 #include <gz/sim/Export.hh>
 #include <gz/sim/Types.hh>
@@ -59,11 +66,192 @@ namespace components
                 const components::BaseComponent *_data) const = 0;
   };
 
+  /// \brief Operations on the data of a component type, which the
+  /// entity-component manager uses for pooled storage, in-place resets,
+  /// flat snapshots, binary serialization, interning and memory reports.
+  /// \details These are kept apart from ComponentDescriptorBase so that its
+  /// vtable stays the same as in earlier releases of this major version.
+  /// ComponentDescriptor implements both. The operations of a type are
+  /// found through Factory::DataOps, and are missing for descriptors built
+  /// against headers that predate this class, in which case these features
+  /// are skipped for that type.
+  class GZ_SIM_VISIBLE ComponentDataOps
+  {
+    /// \brief Destructor
+    public: virtual ~ComponentDataOps();
+
+    /// \brief Size in bytes of an instance of the component.
+    /// \return Size of the component, or 0 if the descriptor doesn't support
+    /// in-place construction.
+    /// \sa Construct
+    public: virtual std::size_t Size() const = 0;
+
+    /// \brief Alignment requirement in bytes of an instance of the component.
+    /// \return Alignment of the component.
+    public: virtual std::size_t Alignment() const = 0;
+
+    /// \brief Construct a copy of a component in memory that is owned by the
+    /// caller. The caller is responsible for calling the component's
+    /// destructor before releasing the memory.
+    /// \param[in] _buffer Memory of at least Size() bytes, aligned to
+    /// Alignment().
+    /// \param[in] _data The data to populate the component with.
+    /// \return Pointer to the constructed component, or nullptr if the
+    /// descriptor doesn't support in-place construction.
+    public: virtual BaseComponent *Construct(void *_buffer,
+                const components::BaseComponent *_data) const = 0;
+
+    /// \brief Copy the data of a component into an existing instance of the
+    /// same type, in place.
+    /// \param[in] _from The component to copy.
+    /// \param[out] _to The component to overwrite.
+    /// \return False if the descriptor doesn't support copying in place.
+    public: virtual bool CopyData(const components::BaseComponent *_from,
+                components::BaseComponent *_to) const = 0;
+
+    /// \brief Check if two components of the same type hold exactly the same
+    /// data.
+    /// \param[in] _a First component.
+    /// \param[in] _b Second component.
+    /// \return True if they're known to be the same, false if they differ
+    /// or the descriptor can't compare them.
+    public: virtual bool SameData(const components::BaseComponent *_a,
+                const components::BaseComponent *_b) const = 0;
+
+    /// \brief Whether the component data has a fixed layout that can be
+    /// copied to and from a flat buffer without streams.
+    /// \return True if FlatSize, FlatWrite and FlatRead are supported.
+    /// \sa FlatCodec
+    public: virtual bool FlatSerializable() const = 0;
+
+    /// \brief Number of bytes FlatWrite writes for a component.
+    /// \param[in] _data The component.
+    /// \return Size of the flat data.
+    public: virtual std::size_t FlatSize(
+                const components::BaseComponent *_data) const = 0;
+
+    /// \brief Write a component's data into a flat buffer.
+    /// \param[in] _data The component.
+    /// \param[out] _out Buffer of at least FlatSize(_data) bytes.
+    public: virtual void FlatWrite(const components::BaseComponent *_data,
+                std::uint8_t *_out) const = 0;
+
+    /// \brief Read a component's data from a flat buffer.
+    /// \param[out] _data The component to update.
+    /// \param[in] _in Flat data written by FlatWrite.
+    /// \param[in] _size Size of the flat data.
+    /// \return True if the data was read.
+    public: virtual bool FlatRead(components::BaseComponent *_data,
+                const std::uint8_t *_in, std::size_t _size) const = 0;
+
+    /// \brief Get a key identifying the data of a component, so that
+    /// components holding the same data can share one instance.
+    /// \param[in] _data The component.
+    /// \return The key, or an empty string if the data can't be identified.
+    /// \sa EntityComponentManager::InternComponents
+    public: virtual std::string InternKey(
+                const components::BaseComponent *_data) const = 0;
+
+    /// \brief Estimated number of bytes a component's data allocates on the
+    /// heap, not counting the component itself, whose size is Size().
+    /// \param[in] _data The component.
+    /// \return Estimated heap bytes.
+    /// \sa ComponentHeapSize
+    public: virtual std::size_t HeapSize(
+                const components::BaseComponent *_data) const = 0;
+
+    /// \brief Size of the binary serialization of a component.
+    /// \param[in] _data The component.
+    /// \return Size in bytes, or nullopt if the component can only be
+    /// serialized with streams.
+    /// \sa Component::SerializedSize
+    public: virtual std::optional<std::size_t> SerializedSize(
+                const components::BaseComponent *_data) const = 0;
+
+    /// \brief Write the binary serialization of a component into a buffer.
+    /// \param[in] _data The component.
+    /// \param[out] _out Buffer to write to.
+    /// \param[in] _size Size of the buffer, which must be SerializedSize().
+    /// \return True if the component was written.
+    public: virtual bool SerializeTo(const components::BaseComponent *_data,
+                char *_out, std::size_t _size) const = 0;
+
+    /// \brief Fill a component from a buffer written by SerializeTo.
+    /// \param[out] _data The component.
+    /// \param[in] _in Buffer to read from.
+    /// \param[in] _size Size of the buffer.
+    /// \return True if the component was read, false if the buffer must be
+    /// read with Deserialize instead.
+    public: virtual bool DeserializeFrom(components::BaseComponent *_data,
+                const char *_in, std::size_t _size) const = 0;
+  };
+
+  /// \brief Whether a component holds no data, such as a tag.
+  /// \tparam ComponentTypeT Type of the component.
+  template <typename ComponentTypeT>
+  struct IsNoDataComponent : std::false_type
+  {
+  };
+
+  /// \brief Specialization for components without data.
+  template <typename Identifier, typename Serializer>
+  struct IsNoDataComponent<Component<NoData, Identifier, Serializer>>
+    : std::true_type
+  {
+  };
+
+  /// \brief Whether a component holds a string.
+  /// \tparam ComponentTypeT Type of the component.
+  template <typename ComponentTypeT, typename Enable = void>
+  struct IsStringComponent : std::false_type
+  {
+  };
+
+  /// \brief Specialization for components that hold data.
+  template <typename ComponentTypeT>
+  struct IsStringComponent<ComponentTypeT,
+      std::void_t<typename ComponentTypeT::Type>>
+    : std::is_same<typename ComponentTypeT::Type, std::string>
+  {
+  };
+
+  /// \brief Whether a data type keeps the SDF element it was loaded from, as
+  /// SDF DOM objects do.
+  /// \tparam DataType Type of the data.
+  template <typename DataType, typename Enable = void>
+  struct HasSdfElement : std::false_type
+  {
+  };
+
+  /// \brief Specialization for types with an Element function.
+  template <typename DataType>
+  struct HasSdfElement<DataType,
+      std::void_t<decltype(std::declval<const DataType &>().Element())>>
+    : std::true_type
+  {
+  };
+
+  /// \brief Whether a component type has a binary serialization, as
+  /// Component does.
+  /// \tparam ComponentTypeT Type of the component.
+  template <typename ComponentTypeT, typename Enable = void>
+  struct HasBinarySerialization : std::false_type
+  {
+  };
+
+  /// \brief Specialization for types with a SerializedSize function.
+  template <typename ComponentTypeT>
+  struct HasBinarySerialization<ComponentTypeT, std::void_t<
+      decltype(std::declval<const ComponentTypeT &>().SerializedSize())>>
+    : std::true_type
+  {
+  };
+
   /// \brief A class for an object responsible for creating components.
   /// \tparam ComponentTypeT type of component to describe.
   template <typename ComponentTypeT>
   class ComponentDescriptor
-    : public ComponentDescriptorBase
+    : public ComponentDescriptorBase, public ComponentDataOps
   {
     /// \brief Documentation inherited
     public: std::unique_ptr<BaseComponent> Create() const override
@@ -78,6 +266,226 @@ namespace components
       ComponentTypeT comp(*static_cast<const ComponentTypeT *>(_data));
       return std::make_unique<ComponentTypeT>(comp);
     }
+
+    /// \brief Documentation inherited
+    public: std::size_t Size() const override
+    {
+      return sizeof(ComponentTypeT);
+    }
+
+    /// \brief Documentation inherited
+    public: std::size_t Alignment() const override
+    {
+      return alignof(ComponentTypeT);
+    }
+
+    /// \brief Documentation inherited
+    public: BaseComponent *Construct(void *_buffer,
+                const components::BaseComponent *_data) const override
+    {
+      return new (_buffer) ComponentTypeT(
+          *static_cast<const ComponentTypeT *>(_data));
+    }
+
+    /// \brief Documentation inherited
+    public: bool CopyData(const components::BaseComponent *_from,
+                components::BaseComponent *_to) const override
+    {
+      if constexpr (std::is_copy_assignable_v<ComponentTypeT>)
+      {
+        *static_cast<ComponentTypeT *>(_to) =
+            *static_cast<const ComponentTypeT *>(_from);
+        return true;
+      }
+      else
+      {
+        (void)_from;
+        (void)_to;
+        return false;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: bool SameData(const components::BaseComponent *_a,
+                const components::BaseComponent *_b) const override
+    {
+      const auto *a = static_cast<const ComponentTypeT *>(_a);
+      const auto *b = static_cast<const ComponentTypeT *>(_b);
+      if constexpr (IsNoDataComponent<ComponentTypeT>::value)
+      {
+        (void)a;
+        (void)b;
+        return true;
+      }
+      else if constexpr (IsStringComponent<ComponentTypeT>::value)
+      {
+        return a->Data() == b->Data();
+      }
+      else if constexpr (ComponentFlatCodec<ComponentTypeT>::kSupported)
+      {
+        // Compare the flat layouts, since the comparison operators of math
+        // types have a tolerance
+        using Codec = typename ComponentFlatCodec<ComponentTypeT>::Codec;
+        const auto size = Codec::Size(a->Data());
+        if (size != Codec::Size(b->Data()))
+          return false;
+        std::vector<std::uint8_t> aData(size);
+        std::vector<std::uint8_t> bData(size);
+        Codec::Write(a->Data(), aData.data());
+        Codec::Write(b->Data(), bData.data());
+        return aData == bData;
+      }
+      else
+      {
+        (void)a;
+        (void)b;
+        return false;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: bool FlatSerializable() const override
+    {
+      return ComponentFlatCodec<ComponentTypeT>::kSupported;
+    }
+
+    /// \brief Documentation inherited
+    public: std::size_t FlatSize(
+                const components::BaseComponent *_data) const override
+    {
+      if constexpr (ComponentFlatCodec<ComponentTypeT>::kSupported)
+      {
+        using Codec = typename ComponentFlatCodec<ComponentTypeT>::Codec;
+        return Codec::Size(
+            static_cast<const ComponentTypeT *>(_data)->Data());
+      }
+      else
+      {
+        (void)_data;
+        return 0;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: void FlatWrite(const components::BaseComponent *_data,
+                std::uint8_t *_out) const override
+    {
+      if constexpr (ComponentFlatCodec<ComponentTypeT>::kSupported)
+      {
+        using Codec = typename ComponentFlatCodec<ComponentTypeT>::Codec;
+        Codec::Write(static_cast<const ComponentTypeT *>(_data)->Data(),
+            _out);
+      }
+      else
+      {
+        (void)_data;
+        (void)_out;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: bool FlatRead(components::BaseComponent *_data,
+                const std::uint8_t *_in, std::size_t _size) const override
+    {
+      if constexpr (ComponentFlatCodec<ComponentTypeT>::kSupported)
+      {
+        using Codec = typename ComponentFlatCodec<ComponentTypeT>::Codec;
+        return Codec::Read(static_cast<ComponentTypeT *>(_data)->Data(),
+            _in, _size);
+      }
+      else
+      {
+        (void)_data;
+        (void)_in;
+        (void)_size;
+        return false;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: std::string InternKey(
+                const components::BaseComponent *_data) const override
+    {
+      if constexpr (IsNoDataComponent<ComponentTypeT>::value)
+      {
+        (void)_data;
+        return std::string();
+      }
+      else
+      {
+        // The serialized form of SDF DOM objects may leave out parts of the
+        // SDF, such as plugins and custom elements
+        auto comp = static_cast<const ComponentTypeT *>(_data);
+        std::ostringstream out;
+        comp->Serialize(out);
+        if constexpr (HasSdfElement<typename ComponentTypeT::Type>::value)
+        {
+          auto element = comp->Data().Element();
+          if (nullptr != element)
+            out << element->ToString("");
+        }
+        return out.str();
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: std::size_t HeapSize(
+                const components::BaseComponent *_data) const override
+    {
+      return ComponentHeapSize<ComponentTypeT>::Of(
+          *static_cast<const ComponentTypeT *>(_data));
+    }
+
+    /// \brief Documentation inherited
+    public: std::optional<std::size_t> SerializedSize(
+                const components::BaseComponent *_data) const override
+    {
+      if constexpr (HasBinarySerialization<ComponentTypeT>::value)
+      {
+        return static_cast<const ComponentTypeT *>(_data)->SerializedSize();
+      }
+      else
+      {
+        (void)_data;
+        return std::nullopt;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: bool SerializeTo(const components::BaseComponent *_data,
+                char *_out, std::size_t _size) const override
+    {
+      if constexpr (HasBinarySerialization<ComponentTypeT>::value)
+      {
+        return static_cast<const ComponentTypeT *>(_data)->SerializeTo(
+            _out, _size);
+      }
+      else
+      {
+        (void)_data;
+        (void)_out;
+        (void)_size;
+        return false;
+      }
+    }
+
+    /// \brief Documentation inherited
+    public: bool DeserializeFrom(components::BaseComponent *_data,
+                const char *_in, std::size_t _size) const override
+    {
+      if constexpr (HasBinarySerialization<ComponentTypeT>::value)
+      {
+        return static_cast<ComponentTypeT *>(_data)->DeserializeFrom(
+            _in, _size);
+      }
+      else
+      {
+        (void)_data;
+        (void)_in;
+        (void)_size;
+        return false;
+      }
+    }
   };
 
   /// \brief A wrapper around uintptr_t to prevent implicit conversions.
@@ -187,6 +595,17 @@ namespace components
       return {};
     }
 
+    /// \brief Get the latest available component descriptor.
+    /// \return The descriptor, or nullptr if the queue is empty.
+    public: GZ_SIM_HIDDEN const ComponentDescriptorBase *Descriptor() const
+    {
+      if (!this->queue.empty())
+      {
+        return this->queue.front().second;
+      }
+      return nullptr;
+    }
+
     /// \brief Queue of component descriptors registered by static registration
     /// objects.
     private: std::deque<std::pair<RegistrationObjectId,
@@ -424,6 +843,33 @@ namespace components
       return comp;
     }
 
+    /// \brief Get the descriptor currently used to create components of a
+    /// given type. The descriptor may be invalidated when the library which
+    /// registered it is unloaded.
+    /// \param[in] _type Component id.
+    /// \return The descriptor, or nullptr if the type is not registered.
+    public: const ComponentDescriptorBase *Descriptor(
+        const ComponentTypeId &_type) const
+    {
+      auto it = this->compsById.find(_type);
+      if (it != this->compsById.end())
+        return it->second.Descriptor();
+      return nullptr;
+    }
+
+    /// \brief Get the data operations of the descriptor currently used to
+    /// create components of a given type. They're invalidated along with the
+    /// descriptor.
+    /// \param[in] _type Component id.
+    /// \return The operations, or nullptr if the type is not registered or
+    /// its descriptor doesn't implement them.
+    /// \sa ComponentDataOps
+    public: const ComponentDataOps *DataOps(
+        const ComponentTypeId &_type) const
+    {
+      return dynamic_cast<const ComponentDataOps *>(this->Descriptor(_type));
+    }
+
     /// \brief Get all the registered component types by ID.
     /// return Vector of component IDs.
     public: std::vector<ComponentTypeId> TypeIds() const
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COMPONENTS_FLATSERIALIZATION_HH_
+#define GZ_SIM_COMPONENTS_FLATSERIALIZATION_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/config.hh>
+
+// This header holds fixed-layout codecs used to write component data into
+// flat binary state snapshots without going through streams.
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace components
+{
+  /// \brief Codec that copies a data type to and from a flat buffer using a
+  /// fixed layout. Values are stored in host byte order. The primary template
+  /// is used for types that have no flat layout, and its kSupported is false.
+  ///
+  /// Specializations provide:
+  /// * `static std::size_t Size(const DataType &)`: number of bytes written.
+  /// * `static void Write(const DataType &, std::uint8_t *)`: write exactly
+  ///   Size() bytes.
+  /// * `static bool Read(DataType &, const std::uint8_t *, std::size_t)`: read
+  ///   the data back, returning false if the size doesn't match the layout.
+  /// \tparam DataType Type of the component data.
+  template <typename DataType, typename Enable = void>
+  class FlatCodec
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = false;
+  };
+
+  /// \brief Codec for arithmetic types.
+  template <typename DataType>
+  class FlatCodec<DataType,
+      std::enable_if_t<std::is_arithmetic_v<DataType>>>
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = true;
+
+    /// \brief Size in bytes of the flat data.
+    public: static std::size_t Size(const DataType &)
+    {
+      return sizeof(DataType);
+    }
+
+    /// \brief Write the data into a buffer of at least Size() bytes.
+    public: static void Write(const DataType &_data, std::uint8_t *_out)
+    {
+      std::memcpy(_out, &_data, sizeof(DataType));
+    }
+
+    /// \brief Read the data from a buffer.
+    public: static bool Read(DataType &_data, const std::uint8_t *_in,
+                std::size_t _size)
+    {
+      if (_size != sizeof(DataType))
+        return false;
+      std::memcpy(&_data, _in, sizeof(DataType));
+      return true;
+    }
+  };
+
+  /// \brief Codec for 2D vectors, stored as X, Y.
+  template <typename T>
+  class FlatCodec<math::Vector2<T>, std::enable_if_t<std::is_arithmetic_v<T>>>
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = true;
+
+    /// \brief Size in bytes of the flat data.
+    public: static std::size_t Size(const math::Vector2<T> &)
+    {
+      return 2 * sizeof(T);
+    }
+
+    /// \brief Write the data into a buffer of at least Size() bytes.
+    public: static void Write(const math::Vector2<T> &_data,
+                std::uint8_t *_out)
+    {
+      const T values[2] = {_data.X(), _data.Y()};
+      std::memcpy(_out, values, sizeof(values));
+    }
+
+    /// \brief Read the data from a buffer.
+    public: static bool Read(math::Vector2<T> &_data, const std::uint8_t *_in,
+                std::size_t _size)
+    {
+      T values[2];
+      if (_size != sizeof(values))
+        return false;
+      std::memcpy(values, _in, sizeof(values));
+      _data.Set(values[0], values[1]);
+      return true;
+    }
+  };
+
+  /// \brief Codec for 3D vectors, stored as X, Y, Z.
+  template <typename T>
+  class FlatCodec<math::Vector3<T>, std::enable_if_t<std::is_arithmetic_v<T>>>
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = true;
+
+    /// \brief Size in bytes of the flat data.
+    public: static std::size_t Size(const math::Vector3<T> &)
+    {
+      return 3 * sizeof(T);
+    }
+
+    /// \brief Write the data into a buffer of at least Size() bytes.
+    public: static void Write(const math::Vector3<T> &_data,
+                std::uint8_t *_out)
+    {
+      const T values[3] = {_data.X(), _data.Y(), _data.Z()};
+      std::memcpy(_out, values, sizeof(values));
+    }
+
+    /// \brief Read the data from a buffer.
+    public: static bool Read(math::Vector3<T> &_data, const std::uint8_t *_in,
+                std::size_t _size)
+    {
+      T values[3];
+      if (_size != sizeof(values))
+        return false;
+      std::memcpy(values, _in, sizeof(values));
+      _data.Set(values[0], values[1], values[2]);
+      return true;
+    }
+  };
+
+  /// \brief Codec for quaternions, stored as W, X, Y, Z.
+  template <typename T>
+  class FlatCodec<math::Quaternion<T>,
+      std::enable_if_t<std::is_arithmetic_v<T>>>
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = true;
+
+    /// \brief Size in bytes of the flat data.
+    public: static std::size_t Size(const math::Quaternion<T> &)
+    {
+      return 4 * sizeof(T);
+    }
+
+    /// \brief Write the data into a buffer of at least Size() bytes.
+    public: static void Write(const math::Quaternion<T> &_data,
+                std::uint8_t *_out)
+    {
+      const T values[4] = {_data.W(), _data.X(), _data.Y(), _data.Z()};
+      std::memcpy(_out, values, sizeof(values));
+    }
+
+    /// \brief Read the data from a buffer.
+    public: static bool Read(math::Quaternion<T> &_data,
+                const std::uint8_t *_in, std::size_t _size)
+    {
+      T values[4];
+      if (_size != sizeof(values))
+        return false;
+      std::memcpy(values, _in, sizeof(values));
+      _data.Set(values[0], values[1], values[2], values[3]);
+      return true;
+    }
+  };
+
+  /// \brief Codec for poses, stored as the position followed by the
+  /// orientation.
+  template <typename T>
+  class FlatCodec<math::Pose3<T>, std::enable_if_t<std::is_arithmetic_v<T>>>
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = true;
+
+    /// \brief Size in bytes of the flat data.
+    public: static std::size_t Size(const math::Pose3<T> &)
+    {
+      return 7 * sizeof(T);
+    }
+
+    /// \brief Write the data into a buffer of at least Size() bytes.
+    public: static void Write(const math::Pose3<T> &_data,
+                std::uint8_t *_out)
+    {
+      FlatCodec<math::Vector3<T>>::Write(_data.Pos(), _out);
+      FlatCodec<math::Quaternion<T>>::Write(_data.Rot(), _out + 3 * sizeof(T));
+    }
+
+    /// \brief Read the data from a buffer.
+    public: static bool Read(math::Pose3<T> &_data, const std::uint8_t *_in,
+                std::size_t _size)
+    {
+      if (_size != 7 * sizeof(T))
+        return false;
+      return FlatCodec<math::Vector3<T>>::Read(_data.Pos(), _in,
+                 3 * sizeof(T)) &&
+             FlatCodec<math::Quaternion<T>>::Read(_data.Rot(),
+                 _in + 3 * sizeof(T), 4 * sizeof(T));
+    }
+  };
+
+  /// \brief Codec for vectors of arithmetic types, such as joint positions.
+  /// The number of elements is implied by the size of the data.
+  template <typename T>
+  class FlatCodec<std::vector<T>, std::enable_if_t<std::is_arithmetic_v<T>>>
+  {
+    /// \brief Whether the data type has a flat layout.
+    public: static constexpr bool kSupported = true;
+
+    /// \brief Size in bytes of the flat data.
+    public: static std::size_t Size(const std::vector<T> &_data)
+    {
+      return _data.size() * sizeof(T);
+    }
+
+    /// \brief Write the data into a buffer of at least Size() bytes.
+    public: static void Write(const std::vector<T> &_data, std::uint8_t *_out)
+    {
+      if (!_data.empty())
+        std::memcpy(_out, _data.data(), _data.size() * sizeof(T));
+    }
+
+    /// \brief Read the data from a buffer. The vector's storage is reused
+    /// when it is large enough.
+    public: static bool Read(std::vector<T> &_data, const std::uint8_t *_in,
+                std::size_t _size)
+    {
+      if (_size % sizeof(T) != 0)
+        return false;
+      _data.resize(_size / sizeof(T));
+      if (_size > 0)
+        std::memcpy(_data.data(), _in, _size);
+      return true;
+    }
+  };
+
+  /// \brief Selects the flat codec of a component's data type. Components
+  /// without data, such as tags, have no flat layout.
+  /// \tparam ComponentTypeT Type of the component.
+  template <typename ComponentTypeT, typename Enable = void>
+  struct ComponentFlatCodec
+  {
+    /// \brief Whether the component has a flat layout.
+    static constexpr bool kSupported = false;
+  };
+
+  /// \brief Specialization for components that hold data.
+  template <typename ComponentTypeT>
+  struct ComponentFlatCodec<ComponentTypeT,
+      std::void_t<typename ComponentTypeT::Type>>
+  {
+    /// \brief Codec of the component's data.
+    using Codec = FlatCodec<typename ComponentTypeT::Type>;
+
+    /// \brief Whether the component has a flat layout.
+    static constexpr bool kSupported = Codec::kSupported;
+  };
+}
+}
+}
+}
+
+#endif
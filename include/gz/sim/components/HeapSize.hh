@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COMPONENTS_HEAPSIZE_HH_
+#define GZ_SIM_COMPONENTS_HEAPSIZE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/config.hh>
+
+// This header holds the estimates of the memory that component data
+// allocates on the heap, used for memory accounting.
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace components
+{
+  /// \brief Whether a data type never owns heap memory.
+  /// \tparam DataType Type of the data.
+  template <typename DataType>
+  struct OwnsNoHeap : std::is_trivially_copyable<DataType>
+  {
+  };
+
+  /// \brief Math vectors hold their values inline.
+  template <typename T>
+  struct OwnsNoHeap<math::Vector2<T>> : std::true_type
+  {
+  };
+
+  /// \brief Math vectors hold their values inline.
+  template <typename T>
+  struct OwnsNoHeap<math::Vector3<T>> : std::true_type
+  {
+  };
+
+  /// \brief Quaternions hold their values inline.
+  template <typename T>
+  struct OwnsNoHeap<math::Quaternion<T>> : std::true_type
+  {
+  };
+
+  /// \brief Poses hold their values inline.
+  template <typename T>
+  struct OwnsNoHeap<math::Pose3<T>> : std::true_type
+  {
+  };
+
+  /// \brief Estimates the number of bytes a data type allocates on the heap,
+  /// not counting the object itself. The primary template is used for types
+  /// whose heap usage isn't known, and its kSupported is false.
+  ///
+  /// Specializations provide:
+  /// * `static std::size_t Of(const DataType &)`: estimated heap bytes.
+  /// * `static constexpr bool kSupported = true`.
+  /// \tparam DataType Type of the data.
+  template <typename DataType, typename Enable = void>
+  struct HeapSize
+  {
+    /// \brief Whether the heap usage can be estimated from the data.
+    static constexpr bool kSupported = false;
+
+    /// \brief Estimated heap bytes.
+    /// \return Zero, the usage is unknown.
+    static std::size_t Of(const DataType &)
+    {
+      return 0;
+    }
+  };
+
+  /// \brief Specialization for types that don't own any heap memory.
+  template <typename DataType>
+  struct HeapSize<DataType, std::enable_if_t<OwnsNoHeap<DataType>::value>>
+  {
+    /// \brief Whether the heap usage can be estimated from the data.
+    static constexpr bool kSupported = true;
+
+    /// \brief Estimated heap bytes.
+    /// \return Zero.
+    static std::size_t Of(const DataType &)
+    {
+      return 0;
+    }
+  };
+
+  /// \brief Strings own their buffer, unless it's small enough to be stored
+  /// in the string itself.
+  template <>
+  struct HeapSize<std::string>
+  {
+    /// \brief Whether the heap usage can be estimated from the data.
+    static constexpr bool kSupported = true;
+
+    /// \brief Estimated heap bytes.
+    /// \param[in] _data The string.
+    /// \return Size of the buffer.
+    static std::size_t Of(const std::string &_data)
+    {
+      return _data.capacity() < sizeof(std::string) ? 0 :
+          _data.capacity() + 1;
+    }
+  };
+
+  /// \brief Vectors own their elements and whatever the elements own.
+  template <typename T>
+  struct HeapSize<std::vector<T>,
+      std::enable_if_t<HeapSize<T>::kSupported>>
+  {
+    /// \brief Whether the heap usage can be estimated from the data.
+    static constexpr bool kSupported = true;
+
+    /// \brief Estimated heap bytes.
+    /// \param[in] _data The vector.
+    /// \return Size of the elements.
+    static std::size_t Of(const std::vector<T> &_data)
+    {
+      std::size_t bytes = _data.capacity() * sizeof(T);
+      if constexpr (!OwnsNoHeap<T>::value)
+      {
+        for (const auto &element : _data)
+          bytes += HeapSize<T>::Of(element);
+      }
+      return bytes;
+    }
+  };
+
+  /// \brief Shared pointers own the object they point to. Objects shared by
+  /// several components are counted once per component.
+  template <typename T>
+  struct HeapSize<std::shared_ptr<T>,
+      std::enable_if_t<HeapSize<T>::kSupported>>
+  {
+    /// \brief Whether the heap usage can be estimated from the data.
+    static constexpr bool kSupported = true;
+
+    /// \brief Estimated heap bytes.
+    /// \param[in] _data The pointer.
+    /// \return Size of the object, if any.
+    static std::size_t Of(const std::shared_ptr<T> &_data)
+    {
+      if (nullptr == _data)
+        return 0;
+      return sizeof(T) + HeapSize<T>::Of(*_data);
+    }
+  };
+
+  /// \brief Stream buffer that only counts the bytes written to it.
+  class CountingStreamBuf : public std::streambuf
+  {
+    /// \brief Number of bytes written.
+    public: std::size_t count{0};
+
+    // Documentation inherited
+    protected: std::streamsize xsputn(const char *,
+                   std::streamsize _n) override
+    {
+      this->count += static_cast<std::size_t>(_n);
+      return _n;
+    }
+
+    // Documentation inherited
+    protected: int_type overflow(int_type _c) override
+    {
+      if (!traits_type::eq_int_type(_c, traits_type::eof()))
+        ++this->count;
+      return traits_type::not_eof(_c);
+    }
+  };
+
+  /// \brief Estimates the heap bytes owned by a component. Data types with a
+  /// HeapSize specialization use it, and the size of the serialized
+  /// component is used as an estimate for the others, such as SDF elements
+  /// and geometries.
+  /// \tparam ComponentTypeT Type of the component.
+  template <typename ComponentTypeT, typename Enable = void>
+  struct ComponentHeapSize
+  {
+    /// \brief Estimated heap bytes.
+    /// \return Zero, components without data own nothing.
+    static std::size_t Of(const ComponentTypeT &)
+    {
+      return 0;
+    }
+  };
+
+  /// \brief Specialization for components that hold data.
+  template <typename ComponentTypeT>
+  struct ComponentHeapSize<ComponentTypeT,
+      std::void_t<typename ComponentTypeT::Type>>
+  {
+    /// \brief Estimated heap bytes.
+    /// \param[in] _component The component.
+    /// \return Estimated heap bytes.
+    static std::size_t Of(const ComponentTypeT &_component)
+    {
+      using DataType = typename ComponentTypeT::Type;
+      if constexpr (HeapSize<DataType>::kSupported)
+      {
+        return HeapSize<DataType>::Of(_component.Data());
+      }
+      else
+      {
+        CountingStreamBuf buffer;
+        std::ostream out(&buffer);
+        _component.Serialize(out);
+        return buffer.count;
+      }
+    }
+  };
+}
+}
+}
+}
+
+#endif
@@ -17,6 +17,7 @@
 #ifndef GZ_SIM_COMPONENTS_PHYSICS_HH_
 #define GZ_SIM_COMPONENTS_PHYSICS_HH_
 
+#include <cstdint>
 #include <string>
 
 #include <gz/msgs/physics.pb.h>
@@ -65,6 +66,15 @@ namespace components
       class PhysicsSolverTag, serializers::StringSerializer>;
   GZ_SIM_REGISTER_COMPONENT("gz_sim_components.PhysicsSolver",
        PhysicsSolver)
+
+  /// \brief Number of physics steps run per simulation iteration by the
+  /// physics system. It's set on the World entity, from
+  /// ServerConfig::PhysicsSubsteps or else the physics system's
+  /// `<substeps>` parameter. Changing it changes the number of substeps
+  /// from the next iteration.
+  using PhysicsSubsteps = Component<uint32_t, class PhysicsSubstepsTag>;
+  GZ_SIM_REGISTER_COMPONENT("gz_sim_components.PhysicsSubsteps",
+       PhysicsSubsteps)
 }
 }
 }
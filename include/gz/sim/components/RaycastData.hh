@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COMPONENTS_RAYCASTDATA_HH_
+#define GZ_SIM_COMPONENTS_RAYCASTDATA_HH_
+
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/components/Component.hh>
+#include <gz/sim/components/Factory.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace components
+{
+  /// \brief A ray to cast, as a segment in the frame of the entity that
+  /// has the RaycastData component.
+  struct RayInfo
+  {
+    /// \brief Start of the ray.
+    public: math::Vector3d start;
+
+    /// \brief End of the ray.
+    public: math::Vector3d end;
+
+    /// \brief Equality operator.
+    /// \param[in] _ray Ray to compare to.
+    /// \return True if the rays are equal.
+    public: bool operator==(const RayInfo &_ray) const
+    {
+      return this->start == _ray.start && this->end == _ray.end;
+    }
+  };
+
+  /// \brief Closest hit of a ray.
+  struct RaycastResultInfo
+  {
+    /// \brief Check whether the ray hit anything.
+    /// \return True if there's a hit.
+    public: bool Hit() const
+    {
+      return this->fraction <= 1.0;
+    }
+
+    /// \brief Hit point in the world frame, NaN if there's no hit.
+    public: math::Vector3d point{math::Vector3d::NaN};
+
+    /// \brief Distance from the start of the ray to the hit point, as a
+    /// fraction of the length of the ray, NaN if there's no hit.
+    public: double fraction{std::numeric_limits<double>::quiet_NaN()};
+
+    /// \brief Equality operator. Results without a hit are equal.
+    /// \param[in] _result Result to compare to.
+    /// \return True if the results are equal.
+    public: bool operator==(const RaycastResultInfo &_result) const
+    {
+      if (!this->Hit() || !_result.Hit())
+        return this->Hit() == _result.Hit();
+      return this->point == _result.point &&
+             this->fraction == _result.fraction;
+    }
+  };
+
+  /// \brief Rays cast by an entity and their results.
+  struct RaycastDataInfo
+  {
+    /// \brief Equality operator.
+    /// \param[in] _data Data to compare to.
+    /// \return True if the rays and results are equal.
+    public: bool operator==(const RaycastDataInfo &_data) const
+    {
+      return this->rays == _data.rays && this->results == _data.results;
+    }
+
+    /// \brief Inequality operator.
+    /// \param[in] _data Data to compare to.
+    /// \return True if the rays or results are different.
+    public: bool operator!=(const RaycastDataInfo &_data) const
+    {
+      return !(*this == _data);
+    }
+
+    /// \brief Rays to cast, set by the systems that need them.
+    public: std::vector<RayInfo> rays;
+
+    /// \brief Result of each ray during the last physics step, in the same
+    /// order as the rays, set by the physics system.
+    public: std::vector<RaycastResultInfo> results;
+  };
+}
+
+namespace serializers
+{
+  /// \brief Serializer for RaycastDataInfo object. Only the rays are
+  /// serialized, results are recomputed every step.
+  class RaycastDataSerializer
+  {
+    /// \brief Serialization for `RaycastDataInfo`.
+    /// \param[in] _out Output stream.
+    /// \param[in] _data RaycastDataInfo object to stream
+    /// \return The stream.
+    public: static std::ostream &Serialize(
+                std::ostream &_out,
+                const components::RaycastDataInfo &_data)
+    {
+      _out << _data.rays.size();
+      for (const auto &ray : _data.rays)
+        _out << " " << ray.start << " " << ray.end;
+      return _out;
+    }
+
+    /// \brief Deserialization for `RaycastDataInfo`.
+    /// \param[in] _in Input stream.
+    /// \param[out] _data RaycastDataInfo object to populate
+    /// \return The stream.
+    public: static std::istream &Deserialize(
+                std::istream &_in, components::RaycastDataInfo &_data)
+    {
+      _data.rays.clear();
+      _data.results.clear();
+
+      std::size_t count{0};
+      _in >> count;
+      for (std::size_t i = 0; i < count && _in; ++i)
+      {
+        components::RayInfo ray;
+        _in >> ray.start >> ray.end;
+        _data.rays.push_back(ray);
+      }
+      return _in;
+    }
+  };
+}
+
+namespace components
+{
+  /// \brief A component with rays that the physics system casts against the
+  /// collisions of the world after every step. Any system can create it on
+  /// an entity, such as a link, and read the results after the next
+  /// physics update. The rays of all entities are cast together.
+  using RaycastData =
+      Component<RaycastDataInfo, class RaycastDataTag,
+                serializers::RaycastDataSerializer>;
+  GZ_SIM_REGISTER_COMPONENT("gz_sim_components.RaycastData", RaycastData)
+}
+}
+}
+}
+
+#endif
@@ -30,6 +30,10 @@
 
 #include <gz/msgs/double_v.pb.h>
 
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
 #include <string>
 #include <vector>
 #include <sdf/Sensor.hh>
@@ -209,6 +213,44 @@ namespace serializers
       _msg.ParseFromIstream(&_in);
       return _in;
     }
+
+    /// \brief Get the size of the binary serialization, which is the same
+    /// as the one written by Serialize.
+    /// \param[in] _msg Message to serialize.
+    /// \return Size in bytes.
+    public: static std::optional<std::size_t> SerializedSize(
+        const google::protobuf::Message &_msg)
+    {
+      return _msg.ByteSizeLong();
+    }
+
+    /// \brief Binary serialization into a buffer.
+    /// \param[out] _out Buffer to write to.
+    /// \param[in] _size Size of the buffer, which must be SerializedSize().
+    /// \param[in] _msg Message to serialize.
+    /// \return True if the message was written.
+    public: static bool SerializeTo(char *_out, std::size_t _size,
+        const google::protobuf::Message &_msg)
+    {
+      if (_size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        return false;
+      return _msg.SerializeToArray(_out, static_cast<int>(_size));
+    }
+
+    /// \brief Binary deserialization from a buffer.
+    /// \param[in] _in Buffer to read from.
+    /// \param[in] _size Size of the buffer.
+    /// \param[out] _msg Message to populate.
+    /// \return True if the buffer size can be parsed. Parse errors are
+    /// ignored, like in Deserialize.
+    public: static bool DeserializeFrom(const char *_in, std::size_t _size,
+        google::protobuf::Message &_msg)
+    {
+      if (_size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        return false;
+      _msg.ParseFromArray(_in, static_cast<int>(_size));
+      return true;
+    }
   };
 
   /// \brief Serializer for components that hold std::string.
@@ -235,6 +277,43 @@ namespace serializers
       _data = std::string(std::istreambuf_iterator<char>(_in), {});
       return _in;
     }
+
+    /// \brief Get the size of the binary serialization, which is the same
+    /// as the one written by Serialize.
+    /// \param[in] _data Data to serialize.
+    /// \return Size in bytes.
+    public: static std::optional<std::size_t> SerializedSize(
+        const std::string &_data)
+    {
+      return _data.size();
+    }
+
+    /// \brief Binary serialization into a buffer.
+    /// \param[out] _out Buffer to write to.
+    /// \param[in] _size Size of the buffer, which must be SerializedSize().
+    /// \param[in] _data Data to serialize.
+    /// \return True if the data was written.
+    public: static bool SerializeTo(char *_out, std::size_t _size,
+        const std::string &_data)
+    {
+      if (_size != _data.size())
+        return false;
+      if (_size > 0u)
+        std::memcpy(_out, _data.data(), _size);
+      return true;
+    }
+
+    /// \brief Binary deserialization from a buffer.
+    /// \param[in] _in Buffer to read from.
+    /// \param[in] _size Size of the buffer.
+    /// \param[out] _data Data to populate.
+    /// \return True.
+    public: static bool DeserializeFrom(const char *_in, std::size_t _size,
+        std::string &_data)
+    {
+      _data.assign(_in, _size);
+      return true;
+    }
   };
 
   template <typename T>
@@ -37,7 +37,9 @@ namespace components
   /// \brief A component type that contains the slip compliance parameters to be
   /// set on a collision. The 0 and 1 index values correspond to the slip
   /// compliance parameters in friction direction 1 (fdir1) and friction
-  /// direction 2 (fdir2) respectively.
+  /// direction 2 (fdir2) respectively. The command stays in effect until
+  /// it's changed, and the physics system only sets it on the collision
+  /// when its values change.
   using SlipComplianceCmd =
     Component<std::vector<double>, class SlipComplianceCmdTag>;
   GZ_SIM_REGISTER_COMPONENT("gz_sim_components.SlipComplianceCmd ",
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_COMPONENTS_WAVES_HH_
+#define GZ_SIM_COMPONENTS_WAVES_HH_
+
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include <gz/sim/components/Factory.hh>
+#include <gz/sim/components/Component.hh>
+#include <gz/sim/config.hh>
+#include <gz/sim/WaveField.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace serializers
+{
+  /// \brief Serializer for a shared wave field, which writes its waves so
+  /// that GUIs and other processes rebuild the same surface.
+  class WavesSerializer
+  {
+    /// \brief Serialization.
+    /// \param[in] _out Output stream.
+    /// \param[in] _field Field to stream, may be nullptr.
+    /// \return The stream.
+    public: static std::ostream &Serialize(std::ostream &_out,
+                const std::shared_ptr<const WaveField> &_field)
+    {
+      if (_field)
+        _out << *_field;
+      else
+        _out << WaveField();
+      return _out;
+    }
+
+    /// \brief Deserialization.
+    /// \param[in] _in Input stream.
+    /// \param[out] _field New field read from the stream.
+    /// \return The stream.
+    public: static std::istream &Deserialize(std::istream &_in,
+                std::shared_ptr<const WaveField> &_field)
+    {
+      auto field = std::make_shared<WaveField>();
+      _in >> *field;
+      _field = field;
+      return _in;
+    }
+  };
+}
+
+namespace components
+{
+  /// \brief Waves on the surface of the water of a world, set on the world
+  /// entity by the Waves system. Ownership is shared, so every system
+  /// queries the same field.
+  using Waves = Component<std::shared_ptr<const WaveField>, class WavesTag,
+      serializers::WavesSerializer>;
+  GZ_SIM_REGISTER_COMPONENT("gz_sim_components.Waves", Waves)
+}
+}
+}
+}
+
+#endif
@@ -18,6 +18,8 @@
 #define GZ_SIM_DETAIL_BASEVIEW_HH_
 
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -32,6 +34,11 @@ namespace sim
 {
 // Inline bracket to help doxygen filtering.
 inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace components
+{
+class BaseComponent;
+}
+
 namespace detail
 {
 /// \brief A key into the map of views
@@ -130,18 +137,48 @@ class GZ_SIM_VISIBLE BaseView
   public: virtual bool NotifyComponentRemoval(const Entity _entity,
               const ComponentTypeId _typeId) = 0;
 
+  /// \brief Replace the cached pointer to one of an entity's components,
+  /// because the component was moved to another instance. A View updates the
+  /// pointer in place. Other views drop the entity and cache it again the
+  /// next time they're used, so they must not be iterated over while
+  /// components are moved.
+  /// \param[in] _entity The entity
+  /// \param[in] _old Pointer to the previous instance of the component.
+  /// \param[in] _new Pointer to the new instance.
+  /// \return True if the view held the previous instance.
+  public: bool ReplaceComponent(const Entity _entity,
+              const components::BaseComponent *_old,
+              components::BaseComponent *_new);
+
   /// \brief Remove an entity from the view.
   /// \param[in] _entity The entity to remove.
   /// \return True if the entity was removed, false if the entity did not
   /// exist in the view.
   public: virtual bool RemoveEntity(const Entity _entity) = 0;
 
+  /// \brief Remove several entities from the view. A View removes them all
+  /// in a single pass, which is much cheaper than calling RemoveEntity for
+  /// each of them when many entities are removed. Other views call
+  /// RemoveEntity for each entity.
+  /// \param[in] _entities The entities to remove, sorted in ascending order.
+  /// \return Number of entities that were removed.
+  public: std::size_t RemoveEntities(
+              const std::vector<Entity> &_entities);
+
   /// \brief Add the entity to the list of entities to be removed
   /// \param[in] _entity The entity to add.
   /// \return True if the entity was added to the list, false if the entity
   /// was not associated with the view.
   public: bool MarkEntityToRemove(const Entity _entity);
 
+  /// \brief Add several entities to the list of entities to be removed,
+  /// merging them in a single pass.
+  /// \param[in] _entities The entities to add, sorted in ascending order.
+  /// Entities that aren't associated with the view are skipped.
+  /// \return Number of entities that were added to the list.
+  public: std::size_t MarkEntitiesToRemove(
+              const std::vector<Entity> &_entities);
+
   /// \brief Update the entities in the view to no longer appear as newly
   /// created. This method should be called whenever a new simulation step is
   /// about to take place.
@@ -155,8 +192,10 @@ class GZ_SIM_VISIBLE BaseView
   /// state.
   public: virtual void Reset() = 0;
 
-  /// \brief Get all of the entities in the view
-  /// \return The entities in the view
+  /// \brief Get all of the entities in the view. The view keeps them in a
+  /// sorted vector, which is copied into the returned set when it changed.
+  /// \return All of the entities in the view.
+  /// \sa SortedEntities
   public: const std::set<Entity> &Entities() const;
 
   /// \brief Get all of the entities in the view that are considered "newly
@@ -166,12 +205,53 @@ class GZ_SIM_VISIBLE BaseView
   /// view). An entity's "newness" is determined by the entity component
   /// manager.
   /// \return The newly created entities that are a part of the view
+  /// \sa SortedNewEntities
   public: const std::set<Entity> &NewEntities() const;
 
   /// \brief Get all of the entities to be removed from the view
   /// \return The entities to be removed from the view
+  /// \sa SortedToRemoveEntities
   public: const std::set<Entity> &ToRemoveEntities() const;
 
+  /// \brief Get all of the entities in the view, without copying them.
+  /// \return The entities in the view, sorted in ascending order.
+  public: const std::vector<Entity> &SortedEntities() const;
+
+  /// \brief Get the entities in the view that are considered "newly
+  /// created", without copying them.
+  /// \return The newly created entities that are a part of the view, sorted
+  /// in ascending order.
+  /// \sa NewEntities
+  public: const std::vector<Entity> &SortedNewEntities() const;
+
+  /// \brief Get the entities to be removed from the view, without copying
+  /// them.
+  /// \return The entities to be removed from the view, sorted in ascending
+  /// order.
+  public: const std::vector<Entity> &SortedToRemoveEntities() const;
+
+  /// \brief Get the index at which iteration over a sorted entity vector
+  /// should continue after visiting the entity at _index. This keeps loops
+  /// over SortedEntities(), SortedNewEntities() or SortedToRemoveEntities()
+  /// valid when the
+  /// loop body adds or removes entities from the view: iteration resumes at
+  /// the first entity greater than _entity.
+  /// \param[in] _entities The vector being iterated.
+  /// \param[in] _index Index of the entity that was just visited.
+  /// \param[in] _entity The entity that was just visited.
+  /// \return Index of the next entity to visit.
+  public: static std::size_t NextIndex(const std::vector<Entity> &_entities,
+              std::size_t _index, const Entity _entity);
+
+  /// \brief Index of an entity in SortedEntities().
+  /// \param[in] _entity The entity
+  /// \return The index, or kInvalidIndex if _entity isn't part of the view.
+  public: std::size_t EntityIndex(const Entity _entity) const;
+
+  /// \brief Value returned by EntityIndex when an entity isn't in the view.
+  public: static constexpr std::size_t kInvalidIndex =
+              static_cast<std::size_t>(-1);
+
   /// \brief Get all of the entities that should be added to the view. This is
   /// useful for adding entities to the view before the view is used to ensure
   /// that the view is up-to-date. Once all entities marked "to be added" are
@@ -187,23 +267,66 @@ class GZ_SIM_VISIBLE BaseView
   /// \sa ToAddEntities
   public: void ClearToAddEntities();
 
-  // TODO(adlarkin) make this a std::unordered_set for better performance.
-  // We need to make sure nothing else depends on the ordered preserved by
-  // std::set first
-  /// \brief All the entities that belong to this view.
-  protected: std::set<Entity> entities;
+  /// \brief Add an entity to the entities that belong to this view.
+  /// \param[in] _entity The entity to add.
+  /// \return Index of the entity in the entities vector.
+  protected: std::size_t InsertEntity(const Entity _entity);
+
+  /// \brief Remove an entity from the entities that belong to this view.
+  /// Also removes the entity from the new entities.
+  /// \param[in] _entity The entity to remove.
+  /// \return Index the entity had in the entities vector, or kInvalidIndex
+  /// if it didn't belong to the view.
+  protected: std::size_t EraseEntity(const Entity _entity);
+
+  /// \brief Insert an entity into a sorted vector, if it's not there yet.
+  /// \param[in, out] _entities Sorted vector.
+  /// \param[in] _entity The entity to insert.
+  /// \return True if the entity was inserted.
+  protected: static bool SortedInsert(std::vector<Entity> &_entities,
+                 const Entity _entity);
+
+  /// \brief Erase an entity from a sorted vector.
+  /// \param[in, out] _entities Sorted vector.
+  /// \param[in] _entity The entity to erase.
+  /// \return True if the entity was erased.
+  protected: static bool SortedErase(std::vector<Entity> &_entities,
+                 const Entity _entity);
+
+  /// \brief Erase several entities from a sorted vector in a single pass.
+  /// \param[in, out] _entities Sorted vector.
+  /// \param[in] _toErase The entities to erase, sorted in ascending order.
+  protected: static void SortedErase(std::vector<Entity> &_entities,
+                 const std::vector<Entity> &_toErase);
+
+  /// \brief All the entities that belong to this view, sorted in ascending
+  /// order. Entities are usually created with increasing IDs, so insertions
+  /// are mostly appends.
+  protected: std::vector<Entity> entities;
+
+  /// \brief Membership bitset for entities, indexed by entity ID. Entities
+  /// with IDs beyond kDenseEntityLimit are looked up by binary search
+  /// instead, to bound memory usage.
+  protected: std::vector<bool> entityBits;
+
+  /// \brief Largest entity ID tracked in entityBits.
+  protected: static constexpr Entity kDenseEntityLimit = 1u << 24;
+
+  /// \brief List of newly created entities, sorted in ascending order.
+  protected: std::vector<Entity> newEntities;
+
+  /// \brief List of entities about to be removed, sorted in ascending order.
+  protected: std::vector<Entity> toRemoveEntities;
 
-  // TODO(adlarkin) make this a std::unordered_set for better performance.
-  // We need to make sure nothing else depends on the ordered preserved by
-  // std::set first
-  /// \brief List of newly created entities
-  protected: std::set<Entity> newEntities;
+  /// \brief Incremented whenever entities changes, so that Entities() only
+  /// copies it into a set when it changed.
+  protected: std::uint64_t entitiesVersion{0};
 
-  // TODO(adlarkin) make this a std::unordered_set for better performance.
-  // We need to make sure nothing else depends on the ordered preserved by
-  // std::set first
-  /// \brief List of entities about to be removed
-  protected: std::set<Entity> toRemoveEntities;
+  /// \brief Incremented whenever newEntities changes.
+  protected: std::uint64_t newEntitiesVersion{0};
+
+  /// \brief Incremented whenever toRemoveEntities changes.
+  protected: std::uint64_t toRemoveEntitiesVersion{0};
 
   /// \brief List of entities to be added to the view. The value of the map
   /// indicates whether the entity is new to the entity component manager or not
@@ -211,6 +334,30 @@ class GZ_SIM_VISIBLE BaseView
 
   /// \brief The component types in the view
   protected: std::set<ComponentTypeId> componentTypes;
+
+  /// \brief Copies of entities, newEntities and toRemoveEntities returned
+  /// by the std::set accessors. They're only updated by those accessors.
+  private: mutable std::set<Entity> entitiesSet;
+
+  /// \brief See entitiesSet.
+  private: mutable std::set<Entity> newEntitiesSet;
+
+  /// \brief See entitiesSet.
+  private: mutable std::set<Entity> toRemoveEntitiesSet;
+
+  /// \brief Value of entitiesVersion when entitiesSet was last updated.
+  private: mutable std::uint64_t entitiesSetVersion{0};
+
+  /// \brief Value of newEntitiesVersion when newEntitiesSet was last
+  /// updated.
+  private: mutable std::uint64_t newEntitiesSetVersion{0};
+
+  /// \brief Value of toRemoveEntitiesVersion when toRemoveEntitiesSet was
+  /// last updated.
+  private: mutable std::uint64_t toRemoveEntitiesSetVersion{0};
+
+  /// \brief Protects the sets, since views may be read concurrently.
+  private: mutable std::mutex setsMutex;
 };
 }  // namespace detail
 }  // namespace GZ_SIM_VERSION_NAMESPACE
@@ -17,20 +17,25 @@
 #ifndef GZ_SIM_DETAIL_ENTITYCOMPONENTMANAGER_HH_
 #define GZ_SIM_DETAIL_ENTITYCOMPONENTMANAGER_HH_
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
+#include <string>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
 #include <gz/math/Helpers.hh>
 
 #include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
 
 namespace gz
 {
@@ -96,7 +101,8 @@ ComponentTypeT *EntityComponentManager::CreateComponent(const Entity _entity,
 {
   auto updateData = this->CreateComponentImplementation(_entity,
       ComponentTypeT::typeId, &_data);
-  auto comp = this->Component<ComponentTypeT>(_entity);
+  auto comp = static_cast<ComponentTypeT *>(
+      this->CreatedComponentImplementation(_entity, ComponentTypeT::typeId));
   if (updateData)
   {
     if (!comp)
@@ -173,7 +179,48 @@ bool EntityComponentManager::SetComponentData(const Entity _entity,
     return true;
   }
 
-  return comp->SetData(_data, CompareData<typename ComponentTypeT::Type>);
+  const bool changed =
+      comp->SetData(_data, CompareData<typename ComponentTypeT::Type>);
+  if constexpr (std::is_same_v<ComponentTypeT, components::Name> ||
+      std::is_same_v<ComponentTypeT, components::ParentEntity>)
+  {
+    if (changed)
+      this->MarkNameChanged(_entity, ComponentTypeT::typeId);
+  }
+  return changed;
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT, typename ...FilterTypeTs>
+std::size_t EntityComponentManager::SetDescendantsComponentData(
+    const Entity _entity, const typename ComponentTypeT::Type &_data)
+{
+  // Sorted, so the components are stored in entity order
+  const auto descendants = this->Descendants(_entity);
+  std::vector<Entity> entities(descendants.begin(), descendants.end());
+  std::sort(entities.begin(), entities.end());
+
+  std::size_t count{0u};
+  this->BeginBulkInsert();
+  for (const Entity entity : entities)
+  {
+    if (!(this->EntityHasComponentType(entity, FilterTypeTs::typeId) && ...))
+      continue;
+
+    auto comp = this->Component<ComponentTypeT>(entity);
+    if (nullptr == comp)
+    {
+      this->CreateComponent(entity, ComponentTypeT(_data));
+      ++count;
+    }
+    else if (comp->SetData(_data, CompareData<typename ComponentTypeT::Type>))
+    {
+      this->SetChanged(entity, ComponentTypeT::typeId);
+      ++count;
+    }
+  }
+  this->EndBulkInsert();
+  return count;
 }
 
 //////////////////////////////////////////////////
@@ -181,12 +228,23 @@ template<typename ...ComponentTypeTs>
 Entity EntityComponentManager::EntityByComponents(
     const ComponentTypeTs &..._desiredComponents) const
 {
+  // Only the entities with the name are checked
+  if (auto named = this->EntitiesByNameOf(_desiredComponents...))
+  {
+    for (const Entity entity : *named)
+    {
+      if (this->EntityHasComponents(entity, _desiredComponents...))
+        return entity;
+    }
+    return kNullEntity;
+  }
+
   // Get all entities which have components of the desired types
   const auto &view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over entities
   Entity result{kNullEntity};
-  for (const Entity entity : view->Entities())
+  for (const Entity entity : view->SortedEntities())
   {
     bool different{false};
 
@@ -219,12 +277,24 @@ template<typename ...ComponentTypeTs>
 std::vector<Entity> EntityComponentManager::EntitiesByComponents(
     const ComponentTypeTs &..._desiredComponents) const
 {
+  // Only the entities with the name are checked
+  if (auto named = this->EntitiesByNameOf(_desiredComponents...))
+  {
+    std::vector<Entity> result;
+    for (const Entity entity : *named)
+    {
+      if (this->EntityHasComponents(entity, _desiredComponents...))
+        result.push_back(entity);
+    }
+    return result;
+  }
+
   // Get all entities which have components of the desired types
   const auto &view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over entities
   std::vector<Entity> result;
-  for (const Entity entity : view->Entities())
+  for (const Entity entity : view->SortedEntities())
   {
     bool different{false};
 
@@ -256,21 +326,13 @@ template<typename ...ComponentTypeTs>
 std::vector<Entity> EntityComponentManager::ChildrenByComponents(Entity _parent,
      const ComponentTypeTs &..._desiredComponents) const
 {
-  // Get all entities which have components of the desired types
-  const auto &view = this->FindView<ComponentTypeTs...>();
-
-  // Get all entities which are immediate children of the given parent
-  auto children = this->Entities().AdjacentsFrom(_parent);
-
-  // Iterate over entities
+  // Parents have few children, so they're checked directly instead of
+  // scanning a view of all entities with the desired components. This also
+  // works during a bulk insert, without updating the views.
+  // Children are sorted by entity, like the entities of a view.
   std::vector<Entity> result;
-  for (const Entity entity : view->Entities())
+  for (const Entity entity : this->ChildEntities(_parent))
   {
-    if (children.find(entity) == children.end())
-    {
-      continue;
-    }
-
     // Iterate over desired components, comparing each of them to the
     // equivalent component in the entity.
     bool different{false};
@@ -280,7 +342,7 @@ std::vector<Entity> EntityComponentManager::ChildrenByComponents(Entity _parent,
           std::remove_cv_t<std::remove_reference_t<
               decltype(_desiredComponent)>>>(entity);
 
-      if (*entityComponent != _desiredComponent)
+      if (nullptr == entityComponent || *entityComponent != _desiredComponent)
       {
         different = true;
       }
@@ -295,6 +357,46 @@ std::vector<Entity> EntityComponentManager::ChildrenByComponents(Entity _parent,
   return result;
 }
 
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+std::optional<std::vector<Entity>> EntityComponentManager::EntitiesByNameOf(
+    const ComponentTypeTs &..._components) const
+{
+  const std::string *name{nullptr};
+  std::optional<Entity> parent;
+  ForEach([&](const auto &_component)
+  {
+    using T = std::remove_cv_t<std::remove_reference_t<decltype(_component)>>;
+    if constexpr (std::is_same_v<T, components::Name>)
+      name = &_component.Data();
+    else if constexpr (std::is_same_v<T, components::ParentEntity>)
+      parent = _component.Data();
+  }, _components...);
+
+  if (nullptr == name)
+    return std::nullopt;
+  if (parent)
+    return this->ChildrenByName(*parent, *name);
+  return this->EntitiesByName(*name);
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+bool EntityComponentManager::EntityHasComponents(Entity _entity,
+    const ComponentTypeTs &..._components) const
+{
+  bool different{false};
+  ForEach([&](const auto &_component)
+  {
+    auto entityComponent = this->Component<
+        std::remove_cv_t<std::remove_reference_t<decltype(_component)>>>(
+        _entity);
+    if (nullptr == entityComponent || *entityComponent != _component)
+      different = true;
+  }, _components...);
+  return !different;
+}
+
 //////////////////////////////////////////////////
 template <typename T>
 struct EntityComponentManager::identity  // NOLINT
@@ -307,9 +409,8 @@ template<typename ...ComponentTypeTs>
 void EntityComponentManager::EachNoCache(typename identity<std::function<
     bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
 {
-  for (const auto &vertex : this->Entities().Vertices())
+  for (const Entity entity : this->AllEntities())
   {
-    Entity entity = vertex.first;
     auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
     if (this->EntityMatches(entity, types))
@@ -328,9 +429,8 @@ template<typename ...ComponentTypeTs>
 void EntityComponentManager::EachNoCache(typename identity<std::function<
     bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
 {
-  for (const auto &vertex : this->Entities().Vertices())
+  for (const Entity entity : this->AllEntities())
   {
-    Entity entity = vertex.first;
     auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
     if (this->EntityMatches(entity, types))
@@ -356,13 +456,13 @@ namespace detail
 /// _data.
 /// \param[in] _f The callback function
 /// \param[in] _entity The entity associated with the components.
-/// \param[in] _data A vector of component pointers that will be expanded to
+/// \param[in] _data An array of component pointers that will be expanded to
 /// become the arguments of the callback function _f.
 /// \return The value of return by the function _f.
 template <typename... ComponentTypeTs, typename FuncT, typename BaseComponentT,
           std::size_t... Is>
 constexpr bool applyFunctionImpl(const FuncT &_f, const Entity &_entity,
-                       const std::vector<BaseComponentT *> &_data,
+                       BaseComponentT *const *_data,
                        std::index_sequence<Is...>)
 {
   return _f(_entity, static_cast<ComponentTypeTs *>(_data[Is])...);
@@ -376,12 +476,12 @@ constexpr bool applyFunctionImpl(const FuncT &_f, const Entity &_entity,
 /// \tparam BaseComponentT Either "BaseComponent" or "const BaseComponent"
 /// \param[in] _f The callback function
 /// \param[in] _entity The entity associated with the components.
-/// \param[in] _data A vector of component pointers that will be expanded to
+/// \param[in] _data An array of component pointers that will be expanded to
 /// become the arguments of the callback function _f.
 /// \return The value of return by the function _f.
 template <typename... ComponentTypeTs, typename FuncT, typename BaseComponentT>
 constexpr bool applyFunction(const FuncT &_f, const Entity &_entity,
-                   const std::vector<BaseComponentT *> &_data)
+                   BaseComponentT *const *_data)
 {
   return applyFunctionImpl<ComponentTypeTs...>(
       _f, _entity, _data, std::index_sequence_for<ComponentTypeTs...>{});
@@ -398,14 +498,18 @@ void EntityComponentManager::Each(typename identity<std::function<
   auto view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over the entities in the view, and invoke the callback
-  // function.
-  for (const Entity entity : view->Entities())
+  // function. The callback may add or remove entities from the view, so the
+  // position is recomputed after each call.
+  const auto &entities = view->SortedEntities();
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
+    const Entity entity = entities[i];
+    const auto data = view->EntityComponentDataAt(i);
     if (!detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
+    i = detail::BaseView::NextIndex(entities, i, entity);
   }
 }
 
@@ -419,17 +523,90 @@ void EntityComponentManager::Each(typename identity<std::function<
   auto view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over the entities in the view, and invoke the callback
-  // function.
-  for (const Entity entity : view->Entities())
+  // function. The callback may add or remove entities from the view, so the
+  // position is recomputed after each call.
+  const auto &entities = view->SortedEntities();
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
+    const Entity entity = entities[i];
+
+    // Only the components handed to the callback may be written. Unsharing
+    // them updates the view in place.
+    (this->UnshareComponents(ComponentTypeTs::typeId, entity), ...);
+    const auto data = view->EntityComponentDataAt(i);
     if (!detail::applyFunction<ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
+    i = detail::BaseView::NextIndex(entities, i, entity);
   }
 }
 
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachParallel(typename identity<std::function<
+    void(const Entity &_entity, const ComponentTypeTs *...)>>::type _f,
+    std::size_t _grainSize) const
+{
+  // Find the view and add pending entities to it before dispatching, so that
+  // the view isn't modified while worker threads read it.
+  auto view = this->FindView<ComponentTypeTs...>();
+
+  const auto &entities = view->SortedEntities();
+
+  auto callback = [&_f](const Entity &_entity,
+      const ComponentTypeTs *..._comps) -> bool
+  {
+    _f(_entity, _comps...);
+    return true;
+  };
+
+  this->ParallelFor(entities.size(), _grainSize,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const components::BaseComponent *const *data =
+              view->EntityComponentDataAt(i);
+          detail::applyFunction<const ComponentTypeTs...>(
+              callback, entities[i], data);
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachParallel(typename identity<std::function<
+    void(const Entity &_entity, ComponentTypeTs *...)>>::type _f,
+    std::size_t _grainSize)
+{
+  (this->UnshareComponents(ComponentTypeTs::typeId), ...);
+
+  // Find the view and add pending entities to it before dispatching, so that
+  // the view isn't modified while worker threads read it.
+  auto view = this->FindView<ComponentTypeTs...>();
+
+  const auto &entities = view->SortedEntities();
+
+  auto callback = [&_f](const Entity &_entity,
+      ComponentTypeTs *..._comps) -> bool
+  {
+    _f(_entity, _comps...);
+    return true;
+  };
+
+  this->ParallelFor(entities.size(), _grainSize,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const auto data = view->EntityComponentDataAt(i);
+          detail::applyFunction<ComponentTypeTs...>(
+              callback, entities[i], data);
+        }
+      });
+}
+
 //////////////////////////////////////////////////
 template <class Function, class... ComponentTypeTs>
 void EntityComponentManager::ForEach(Function _f,
@@ -450,13 +627,18 @@ void EntityComponentManager::EachNew(typename identity<std::function<
   // Iterate over the entities in the view and in the newly created
   // entities list, and invoke the callback
   // function.
-  for (const Entity entity : view->NewEntities())
+  const auto &entities = view->SortedNewEntities();
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<ComponentTypeTs...>(_f, entity, data))
+    const Entity entity = entities[i];
+    (this->UnshareComponents(ComponentTypeTs::typeId, entity), ...);
+    const auto data = view->EntityComponentData(entity);
+    if (nullptr != data &&
+        !detail::applyFunction<ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
+    i = detail::BaseView::NextIndex(entities, i, entity);
   }
 }
 
@@ -472,13 +654,17 @@ void EntityComponentManager::EachNew(typename identity<std::function<
   // Iterate over the entities in the view and in the newly created
   // entities list, and invoke the callback
   // function.
-  for (const Entity entity : view->NewEntities())
+  const auto &entities = view->SortedNewEntities();
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
+    const Entity entity = entities[i];
+    const auto data = view->EntityComponentData(entity);
+    if (nullptr != data &&
+        !detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
+    i = detail::BaseView::NextIndex(entities, i, entity);
   }
 }
 
@@ -494,13 +680,17 @@ void EntityComponentManager::EachRemoved(typename identity<std::function<
   // Iterate over the entities in the view and in the newly created
   // entities list, and invoke the callback
   // function.
-  for (const Entity entity : view->ToRemoveEntities())
+  const auto &entities = view->SortedToRemoveEntities();
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
+    const Entity entity = entities[i];
+    const auto data = view->EntityComponentData(entity);
+    if (nullptr != data &&
+        !detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
+    i = detail::BaseView::NextIndex(entities, i, entity);
   }
 }
 
@@ -508,9 +698,18 @@ void EntityComponentManager::EachRemoved(typename identity<std::function<
 template<typename ...ComponentTypeTs>
 detail::View *EntityComponentManager::FindView() const
 {
-  auto viewKey = std::vector<ComponentTypeId>{ComponentTypeTs::typeId...};
+  // The view of these component types is looked up by key once per ECM, and
+  // then read from the cache
+  static const std::size_t cacheSlot = NextViewCacheSlot();
 
-  auto baseViewMutexPair = this->FindView(viewKey);
+  auto baseViewMutexPair = this->CachedView(cacheSlot);
+  if (nullptr == baseViewMutexPair.first)
+  {
+    baseViewMutexPair = this->FindView(
+        std::vector<ComponentTypeId>{ComponentTypeTs::typeId...});
+    if (nullptr != baseViewMutexPair.first)
+      this->CacheView(cacheSlot, baseViewMutexPair);
+  }
   auto baseViewPtr = baseViewMutexPair.first;
   if (nullptr != baseViewPtr)
   {
@@ -533,14 +732,14 @@ detail::View *EntityComponentManager::FindView() const
       viewLock = std::make_unique<std::lock_guard<std::mutex>>(*mutexPtr);
     }
 
-    // add any new entities to the view before using it
+    // add any new entities to the view before using it. The components are
+    // only looked up, so that building views doesn't count as a write.
+    // Writers unshare the components they get, which updates the views.
     for (const auto &[entity, isNew] : view->ToAddEntities())
     {
-      view->AddEntityWithConstComps(entity, isNew,
-          this->Component<ComponentTypeTs>(entity)...);
       view->AddEntityWithComps(entity, isNew,
-          const_cast<EntityComponentManager*>(this)->Component<ComponentTypeTs>(
-            entity)...);
+          const_cast<ComponentTypeTs *>(static_cast<const ComponentTypeTs *>(
+          this->ComponentImplementation(entity, ComponentTypeTs::typeId)))...);
     }
     view->ClearToAddEntities();
 
@@ -550,24 +749,21 @@ detail::View *EntityComponentManager::FindView() const
   // create a new view if one wasn't found
   detail::View view(std::set<ComponentTypeId>{ComponentTypeTs::typeId...});
 
-  for (const auto &vertex : this->Entities().Vertices())
+  for (const Entity entity : this->AllEntities())
   {
-    Entity entity = vertex.first;
-
     // only add entities to the view that have all of the components in viewKey
     if (!this->EntityMatches(entity, view.ComponentTypes()))
       continue;
 
-    view.AddEntityWithConstComps(entity, this->IsNewEntity(entity),
-        this->Component<ComponentTypeTs>(entity)...);
     view.AddEntityWithComps(entity, this->IsNewEntity(entity),
-        const_cast<EntityComponentManager*>(this)->Component<ComponentTypeTs>(
-            entity)...);
+        const_cast<ComponentTypeTs *>(static_cast<const ComponentTypeTs *>(
+        this->ComponentImplementation(entity, ComponentTypeTs::typeId)))...);
     if (this->IsMarkedForRemoval(entity))
       view.MarkEntityToRemove(entity);
   }
 
-  baseViewPtr = this->AddView(viewKey,
+  baseViewPtr = this->AddView(
+      std::vector<ComponentTypeId>{ComponentTypeTs::typeId...},
       std::make_unique<detail::View>(std::move(view)));
   return static_cast<detail::View *>(baseViewPtr);
 }
@@ -579,6 +775,17 @@ bool EntityComponentManager::RemoveComponent(Entity _entity)
   const auto typeId = ComponentTypeT::typeId;
   return this->RemoveComponent(_entity, typeId);
 }
+
+//////////////////////////////////////////////////
+template<typename T>
+std::shared_ptr<T> EntityComponentManager::SystemSharedData(
+    const std::string &_key) const
+{
+  return std::static_pointer_cast<T>(this->SystemSharedDataImpl(_key,
+      typeid(T).name(),
+      []() -> void * { return new T(); },
+      [](void *_data) { delete static_cast<T *>(_data); }));
+}
 }
 }
 }
@@ -47,12 +47,10 @@ namespace detail
 /// gz::sim::detail) directly.
 class GZ_SIM_VISIBLE View : public BaseView
 {
-  /// \brief Alias for containers that hold and entity and its component data.
+  /// \brief Alias for containers that hold an entity's component data.
   /// The component types held in this container match the component types that
   /// were specified when creating the view.
   private: using ComponentData = std::vector<components::BaseComponent *>;
-  private: using ConstComponentData =
-               std::vector<const components::BaseComponent *>;
 
   /// \brief Constructor
   /// \param[in] _compIds a set of IDs of the components cached by this View.
@@ -64,23 +62,48 @@ class GZ_SIM_VISIBLE View : public BaseView
   /// \brief Documentation inherited
   public: bool RemoveEntity(const Entity _entity) override;
 
-  /// \brief Get an entity and its component data. It is assumed that the entity
-  /// being requested exists in the view.
+  /// \brief Remove several entities from the view in a single pass.
+  /// BaseView::RemoveEntities forwards to this, which keeps it out of the
+  /// BaseView vtable.
+  /// \param[in] _entities The entities to remove, sorted in ascending order.
+  /// \return Number of entities that were removed.
+  public: std::size_t RemoveEntities(const std::vector<Entity> &_entities);
+
+  /// \brief Replace the cached pointer to one of an entity's components in
+  /// place. BaseView::ReplaceComponent forwards to this.
+  /// \param[in] _entity The entity
+  /// \param[in] _old Pointer to the previous instance of the component.
+  /// \param[in] _new Pointer to the new instance.
+  /// \return True if the view held the previous instance.
+  public: bool ReplaceComponent(const Entity _entity,
+              const components::BaseComponent *_old,
+              components::BaseComponent *_new);
+
+  /// \brief Get an entity's component data.
   /// \param[_in] _entity The entity
-  /// \return The entity and its component data. Const pointers to the component
-  /// data are returned.
-  public: const ConstComponentData &EntityComponentConstData(
+  /// \return Const pointers to the entity's components, in the order of the
+  /// types used to create the view, or nullptr if the entity isn't part of
+  /// the view.
+  public: const components::BaseComponent *const *EntityComponentConstData(
               const Entity _entity) const;
 
-  /// \brief Get an entity and its component data. It is assumed that the entity
-  /// being requested exists in the view.
+  /// \brief Get an entity's component data.
   /// \param[_in] _entity The entity
-  /// \return The entity and its component data. Mutable pointers to the
-  /// component data are returned.
-  public: const ComponentData &EntityComponentData(const Entity _entity) const;
+  /// \return Mutable pointers to the entity's components, in the order of
+  /// the types used to create the view, or nullptr if the entity isn't part of
+  /// the view.
+  public: components::BaseComponent *const *EntityComponentData(
+              const Entity _entity) const;
 
-  /// \brief Add an entity with its component data to the view. It is assumed
-  /// that the entity to be added does not already exist in the view.
+  /// \brief Get the component data of the entity at a given position of
+  /// SortedEntities(). This avoids looking up the entity while iterating.
+  /// \param[_in] _index Index into SortedEntities(). It must be valid.
+  /// \return Mutable pointers to the entity's components.
+  public: components::BaseComponent *const *EntityComponentDataAt(
+              const std::size_t _index) const;
+
+  /// \brief Add an entity with its component data to the view. If the entity
+  /// is already part of the view, its component data is replaced.
   /// \tparam ComponentTypeTs The component type(s) that are stored in this
   /// view. These types correspond to each of the types in the _compPtrs
   /// parameter of this function.
@@ -94,8 +117,8 @@ class GZ_SIM_VISIBLE View : public BaseView
           void AddEntityWithConstComps(const Entity &_entity, const bool _new,
               const ComponentTypeTs*... _compPtrs);
 
-  /// \brief Add an entity with its component data to the view. It is assumed
-  /// that the entity to be added does not already exist in the view.
+  /// \brief Add an entity with its component data to the view. If the entity
+  /// is already part of the view, its component data is replaced.
   /// \tparam ComponentTypeTs The component type(s) that are stored in this
   /// view. These types correspond to each of the types in the _compPtrs
   /// parameter of this function.
@@ -120,40 +143,47 @@ class GZ_SIM_VISIBLE View : public BaseView
   /// \brief Documentation inherited
   public: void Reset() override;
 
-  /// \brief A map of entities to their component data. Since tuples are defined
-  /// at compile time, we need separate containers that have tuples for both
-  /// non-const and const component pointers (calls to ECM::Each can have a
-  /// method signature that uses either non-const or const pointers)
-  private: std::unordered_map<Entity, ComponentData> validData;
-  private: std::unordered_map<Entity, ConstComponentData> validConstData;
-
-  /// \brief A map of invalid entities to their component data. The difference
-  /// between invalidData and validData is that the entities in invalidData were
-  /// once in validData, but they had a component removed, so the entity no
-  /// longer meets the component requirements of the view. If the missing
-  /// component data is ever added back to an entity in invalidData, then this
-  /// entity will be moved back to validData. The usage of invalidData is an
-  /// implementation detail that should be ignored by those using the View API;
-  /// from a user's point of view, entities that belong to invalidData don't
-  /// appear to be a part of the view at all.
+  /// \brief Add an entity and its component pointers to the view. If the
+  /// entity is already part of the view, its component data is replaced.
+  /// \param[in] _entity The entity
+  /// \param[in] _new Whether the entity is new to the entity component
+  /// manager.
+  /// \param[in] _data Pointers to the entity's components, in the order of the
+  /// types used to create the view. Must have one element per component type
+  /// of the view.
+  public: void AddEntity(const Entity _entity, const bool _new,
+              const components::BaseComponent *const *_data);
+
+  /// \brief Component pointers of all entities that belong to the view,
+  /// packed row by row. The row at index i holds the components of the entity
+  /// at index i of the entities vector, and has one pointer per component
+  /// type. Both const and non-const callbacks use the same pointers.
+  private: ComponentData componentData;
+
+  /// \brief A map of invalid entities to their component data. The entities
+  /// in invalidData were once part of the view, but they had a component
+  /// removed, so the entity no longer meets the component requirements of the
+  /// view. If the missing component data is ever added back to an entity in
+  /// invalidData, then this entity will be moved back to the view. The usage
+  /// of invalidData is an implementation detail that should be ignored by
+  /// those using the View API; from a user's point of view, entities that
+  /// belong to invalidData don't appear to be a part of the view at all.
   ///
   /// The reason for moving entities with missing components to invalidData
   /// instead of completely deleting them from the view is because if components
   /// are added back later and the entity needs to be re-added to the view,
-  /// tuple creation can be costly. So, this approach is used instead to
-  /// maintain runtime performance (the tradeoff of mainting performance is
-  /// increased complexity and memory usage).
+  /// looking up its components again can be costly. So, this approach is used
+  /// instead to maintain runtime performance (the tradeoff of mainting
+  /// performance is increased complexity and memory usage).
   ///
   /// \sa missingCompTracker
   private: std::unordered_map<Entity, ComponentData> invalidData;
-  private: std::unordered_map<Entity, ConstComponentData> invalidConstData;
 
   /// \brief A map that keeps track of which component types for entities in
   /// invalidData need to be added back to the entity in order to move the
-  /// entity back to validData. If the set of types (value in the map) becomes
+  /// entity back to the view. If the set of types (value in the map) becomes
   /// empty, then this means that the entity (key in the map) has all of the
-  /// component types defined by the view, so the entity can be moved back to
-  /// validData.
+  /// component types defined by the view, so the entity can be moved back.
   ///
   /// \sa invalidData
   private: std::unordered_map<Entity, std::unordered_set<ComponentTypeId>>
@@ -165,11 +195,8 @@ template <typename... ComponentTypeTs>
 void View::AddEntityWithConstComps(const Entity &_entity, const bool _new,
                                    const ComponentTypeTs *... _compPtrs)
 {
-  this->validConstData[_entity] =
-      std::vector<const components::BaseComponent *>{_compPtrs...};
-  this->entities.insert(_entity);
-  if (_new)
-    this->newEntities.insert(_entity);
+  const components::BaseComponent *data[] = {_compPtrs...};
+  this->AddEntity(_entity, _new, data);
 }
 
 //////////////////////////////////////////////////
@@ -177,11 +204,8 @@ template <typename... ComponentTypeTs>
 void View::AddEntityWithComps(const Entity &_entity, const bool _new,
                               ComponentTypeTs *... _compPtrs)
 {
-  this->validData[_entity] =
-      std::vector<components::BaseComponent *>{_compPtrs...};
-  this->entities.insert(_entity);
-  if (_new)
-    this->newEntities.insert(_entity);
+  const components::BaseComponent *data[] = {_compPtrs...};
+  this->AddEntity(_entity, _new, data);
 }
 }  // namespace detail
 }  // namespace GZ_SIM_VERSION_NAMESPACE
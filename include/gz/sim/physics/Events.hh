@@ -25,6 +25,7 @@
 
 #include "gz/sim/config.hh"
 #include "gz/sim/Entity.hh"
+#include "gz/sim/EventChannel.hh"
 
 #include <Eigen/Geometry>
 
@@ -44,7 +45,9 @@ namespace gz
       /// is called during the Update phase after collision checking has been
       /// finished and before the physics update has happened. The event
       /// subscribers are expected to change the `params` argument.
-      using CollectContactSurfaceProperties = gz::common::EventT<
+      ///
+      /// It's emitted for every contact point, so it's an EventChannel.
+      using CollectContactSurfaceProperties = EventChannel<
         void(
           const Entity& /* collision1 */,
           const Entity& /* collision2 */,
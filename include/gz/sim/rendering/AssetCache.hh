@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_RENDERING_ASSETCACHE_HH_
+#define GZ_SIM_RENDERING_ASSETCACHE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gz/common/geospatial/HeightmapData.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/rendering/RenderTypes.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/rendering/Export.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+  /// \brief Kinds of assets held by the AssetCache.
+  enum class AssetType
+  {
+    /// \brief Mesh geometry, uploaded once per scene.
+    MESH = 0,
+
+    /// \brief Material shared between visuals of a scene.
+    MATERIAL = 1,
+
+    /// \brief Texture file used by a shared material.
+    TEXTURE = 2,
+
+    /// \brief Heightmap data loaded from an image or a DEM, which is shared
+    /// by all scenes.
+    HEIGHTMAP = 3,
+  };
+
+  /// \brief Usage of one kind of asset in the AssetCache.
+  struct AssetCacheStats
+  {
+    /// \brief Number of requests that found the asset in the cache.
+    std::size_t hits{0u};
+
+    /// \brief Number of requests that had to load the asset.
+    std::size_t misses{0u};
+
+    /// \brief Number of assets currently held.
+    std::size_t entries{0u};
+
+    /// \brief Estimated memory in bytes taken by the assets currently held,
+    /// on the GPU for meshes and textures and on the CPU for heightmaps.
+    std::size_t bytes{0u};
+
+    /// \brief Get the fraction of requests that found the asset.
+    /// \return Hit rate between 0 and 1, or 0 without requests.
+    public: double HitRate() const
+    {
+      const std::size_t total = this->hits + this->misses;
+      return total == 0u ? 0.0 : static_cast<double>(this->hits) / total;
+    }
+  };
+
+  /// \brief Process-wide cache of the assets loaded by scene managers.
+  ///
+  /// Render utils running in the same process, such as the Sensors system
+  /// and the GUI scene, find their scene by name in the same render engine,
+  /// so they usually render into the same scene. Assets are cached per
+  /// scene, so a mesh, material or texture loaded by one scene manager is
+  /// reused by the others instead of being loaded again. Heightmap data
+  /// doesn't depend on the scene and is shared by all of them.
+  ///
+  /// Assets are reference counted: every visual that uses an asset holds a
+  /// reference, which the scene manager releases when the visual is
+  /// removed or the scene is cleared. The cache drops an asset when its
+  /// last reference is released. It's safe to use from several threads.
+  class GZ_SIM_RENDERING_VISIBLE AssetCache
+  {
+    /// \brief Constructor
+    public: AssetCache();
+
+    /// \brief Get the cache shared by the whole process.
+    /// \return The shared cache.
+    public: static AssetCache &Instance();
+
+    /// \brief Find a mesh loaded for a scene and take a reference to it.
+    /// \param[in] _scene Scene the mesh is uploaded to.
+    /// \param[in] _key Description of the mesh before its files are looked
+    /// up, such as its URI and SDF path.
+    /// \return The mesh, owned by common::MeshManager, or nullptr if it
+    /// wasn't loaded, in which case no reference is taken.
+    public: const common::Mesh *AcquireMesh(
+        const rendering::ScenePtr &_scene, const std::string &_key);
+
+    /// \brief Add a mesh loaded for a scene, taking a reference to it.
+    /// \param[in] _scene Scene the mesh is uploaded to.
+    /// \param[in] _key Description of the mesh, see AcquireMesh.
+    /// \param[in] _mesh The mesh, which must be owned by common::MeshManager.
+    public: void AddMesh(const rendering::ScenePtr &_scene,
+        const std::string &_key, const common::Mesh *_mesh);
+
+    /// \brief Find a material created in a scene and take a reference to it.
+    /// \param[in] _scene Scene the material belongs to.
+    /// \param[in] _key Description of the material and of how visuals
+    /// modify it.
+    /// \return The material, or nullptr if it wasn't created, in which case
+    /// no reference is taken. It must not be modified in place.
+    public: rendering::MaterialPtr AcquireMaterial(
+        const rendering::ScenePtr &_scene, const std::string &_key);
+
+    /// \brief Add a material created in a scene, taking a reference to it
+    /// and to each of its textures.
+    /// \param[in] _scene Scene the material belongs to.
+    /// \param[in] _key Description of the material, see AcquireMaterial.
+    /// \param[in] _material The material.
+    public: void AddMaterial(const rendering::ScenePtr &_scene,
+        const std::string &_key, const rendering::MaterialPtr &_material);
+
+    /// \brief Find heightmap data and take a reference to it.
+    /// \param[in] _key Path of the heightmap file, and anything else that
+    /// changes how it's loaded.
+    /// \return The data, or nullptr if it wasn't loaded, in which case no
+    /// reference is taken.
+    public: std::shared_ptr<common::HeightmapData> AcquireHeightmap(
+        const std::string &_key);
+
+    /// \brief Add heightmap data, taking a reference to it.
+    /// \param[in] _key Description of the heightmap, see AcquireHeightmap.
+    /// \param[in] _data The loaded data.
+    public: void AddHeightmap(const std::string &_key,
+        const std::shared_ptr<common::HeightmapData> &_data);
+
+    /// \brief Release a reference taken by one of the Acquire or Add
+    /// functions. Materials also release the references to their textures.
+    /// \param[in] _scene Scene of the asset, ignored for heightmaps.
+    /// \param[in] _type Kind of asset.
+    /// \param[in] _key Key the asset was acquired or added with.
+    public: void Release(const rendering::ScenePtr &_scene, AssetType _type,
+        const std::string &_key);
+
+    /// \brief Get the usage of one kind of asset. The memory taken by
+    /// textures is estimated from their image files the first time this is
+    /// called after they were added.
+    /// \param[in] _type Kind of asset.
+    /// \return Hits and misses since the last ResetStats, and the assets
+    /// currently held.
+    public: AssetCacheStats Stats(AssetType _type) const;
+
+    /// \brief Get a human readable report of the usage of all kinds of
+    /// assets, with one line per kind.
+    /// \return The report.
+    public: std::string Report() const;
+
+    /// \brief Reset the hit and miss counters of all kinds of assets.
+    public: void ResetStats();
+
+    /// \brief Private data pointer.
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+}
+}
+#endif
@@ -21,6 +21,7 @@
 #include <gz/common/Event.hh>
 
 #include "gz/sim/config.hh"
+#include "gz/sim/EventChannel.hh"
 
 namespace gz
 {
@@ -41,7 +42,7 @@ namespace gz
       /// \code
       /// eventManager.Emit<gz::sim::events::SceneUpdate>();
       /// \endcode
-      using SceneUpdate = gz::common::EventT<void(void),
+      using SceneUpdate = EventChannel<void(void),
           struct SceneUpdateTag>;
 
       /// \brief The pre render event is emitted before rendering updates.
@@ -52,7 +53,7 @@ namespace gz
       /// \code
       /// eventManager.Emit<gz::sim::events::PreRender>();
       /// \endcode
-      using PreRender = gz::common::EventT<void(void),
+      using PreRender = EventChannel<void(void),
           struct PreRenderTag>;
 
       /// \brief The render event is emitted during rendering updates.
@@ -63,7 +64,7 @@ namespace gz
       /// \code
       /// eventManager.Emit<gz::sim::events::Render>();
       /// \endcode
-      using Render = gz::common::EventT<void(void),
+      using Render = EventChannel<void(void),
           struct RenderTag>;
 
       /// \brief The post render event is emitted after rendering updates.
@@ -74,7 +75,7 @@ namespace gz
       /// \code
       /// eventManager.Emit<gz::sim::events::PostRender>();
       /// \endcode
-      using PostRender = gz::common::EventT<void(void),
+      using PostRender = EventChannel<void(void),
           struct PostRenderTag>;
 
       /// \brief The render teardown event is emitted right before the
@@ -17,6 +17,7 @@
 #ifndef GZ_SIM_RENDERUTIL_HH_
 #define GZ_SIM_RENDERUTIL_HH_
 
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
@@ -159,6 +160,62 @@ inline namespace GZ_SIM_VERSION_NAMESPACE {
         std::string(const sim::Entity &, const sdf::Sensor &,
           const std::string &)> _createSensorCb = {});
 
+    /// \brief Set whether only the poses that changed in the
+    /// EntityComponentManager are copied to the scene on each update. This
+    /// makes updates scale with the number of entities that move rather than
+    /// with the size of the scene, but poses written through component
+    /// pointers without being marked as changed aren't copied, and poses
+    /// set on scene nodes directly, without changing the ECM, aren't
+    /// restored. Poses of all entities are
+    /// still copied on the first update after enabling this, and after
+    /// simulation time goes back, such as when simulation is reset.
+    /// Disabled by default.
+    /// \param[in] _enable True to only copy changed poses.
+    public: void SetIncrementalPoseUpdates(bool _enable);
+
+    /// \brief Set the distance beyond which top level visuals are hidden,
+    /// for scenes that are only rendered by sensors. A visual is hidden
+    /// while its bounding sphere is farther than this distance, or than
+    /// the far clip distance of the sensor if that's closer, from every
+    /// rendering sensor, so far away models don't cost render and scene
+    /// update time. Culling is skipped while there are no rendering
+    /// sensors. It's disabled by default.
+    /// \param[in] _distance Culling distance in meters. Zero or less
+    /// disables culling and shows all culled visuals again.
+    public: void SetSensorCullingDistance(double _distance);
+
+    /// \brief Show or hide the visual of an entity. Unlike calling
+    /// rendering::Visual::SetVisible directly, this is remembered apart
+    /// from culling, see SetSensorCullingDistance, so a hidden visual
+    /// isn't shown again when it comes back in range of a sensor.
+    /// \param[in] _entity Entity whose visual is shown or hidden.
+    /// \param[in] _visible False to hide the visual.
+    public: void SetEntityVisible(Entity _entity, bool _visible);
+
+    /// \brief Set whether to only update the skeleton animation of actors
+    /// that could be seen by a camera, such as a camera sensor or the GUI
+    /// camera. An actor is animated while its bounding sphere intersects a
+    /// cone around the view frustum of any camera in the scene. Actor poses
+    /// are always updated, and all actors are animated while there are
+    /// rendering sensors which aren't cameras, such as GPU lidars. It's
+    /// disabled by default.
+    /// \param[in] _enable True to skip animating actors out of view.
+    public: void SetActorAnimationCulling(bool _enable);
+
+    /// \brief Set how long each update may spend creating new entities in
+    /// the scene. When creating all of them takes longer, such as when a
+    /// large world is loaded, the rest are created in the following
+    /// updates, so the first frames aren't delayed. A top level model,
+    /// actor or light is created in one update, together with everything
+    /// in it. Models with sensors are created first, and then those
+    /// nearest to the sensors in the scene, such as the GUI camera, or to
+    /// the models with sensors. At least one top level entity is created
+    /// per update. It's disabled by default.
+    /// \param[in] _budget Time per update. Zero or less creates all new
+    /// entities in the same update.
+    public: void SetCreationTimeBudget(
+        const std::chrono::steady_clock::duration &_budget);
+
     /// \brief Set the callback function for removing the sensors
     /// \param[in] _removeSensorCb Callback function for removing the sensors
     /// The callback function arg is the sensor entity to remove
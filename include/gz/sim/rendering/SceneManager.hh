@@ -126,6 +126,27 @@ inline namespace GZ_SIM_VERSION_NAMESPACE {
     public: void SetSphericalCoordinates(
         const math::SphericalCoordinates &_sphericalCoordinates);
 
+    /// \brief Set whether visuals with identical materials share a single
+    /// rendering material, instead of each getting its own copy. Visuals
+    /// that share the same mesh and material can then be batched into
+    /// instanced draw calls by the render engine, which reduces draw calls
+    /// and GPU memory in scenes with many copies of the same model. Shared
+    /// materials must not be modified in place, see IsSharedMaterial.
+    /// Shared materials are held by the AssetCache, so they're also shared
+    /// with other scene managers of the same scene.
+    /// Only affects visuals created afterwards. Disabled by default.
+    /// \param[in] _share True to share materials.
+    public: void SetShareMaterials(bool _share);
+
+    /// \brief Check whether a material is shared by several visuals. Shared
+    /// materials should be replaced by a copy, for example by calling
+    /// rendering::Geometry::SetMaterial with it, before being modified for a
+    /// single visual.
+    /// \param[in] _material Material to check.
+    /// \return True if the material is shared.
+    public: bool IsSharedMaterial(
+        const rendering::MaterialPtr &_material) const;
+
     /// \brief Create a model
     /// \param[in] _id Unique model id
     /// \param[in] _model Model sdf dom
@@ -213,6 +234,27 @@ inline namespace GZ_SIM_VERSION_NAMESPACE {
     /// \return Pointer to requested visual
     public: rendering::VisualPtr VisualById(Entity _id);
 
+    /// \brief Set the entity of a visual in its "gazebo-entity" user data,
+    /// and add it to the index of its scene, so it can be found with
+    /// VisualByEntity. All visuals created for entities by scene managers
+    /// are indexed, other visuals representing entities, such as those
+    /// created by GUI plugins, should be indexed with this function.
+    /// \param[in] _id Entity of the visual.
+    /// \param[in] _visual Visual to index.
+    public: static void IndexVisual(Entity _id,
+        const rendering::VisualPtr &_visual);
+
+    /// \brief Get the visual of an entity in a scene, created by any scene
+    /// manager of the scene or indexed with IndexVisual. This is a lookup
+    /// in an index instead of a walk over all visuals of the scene, and it
+    /// can be used by GUI plugins which don't own the scene manager that
+    /// created the visual.
+    /// \param[in] _scene Scene of the visual.
+    /// \param[in] _id Entity of the visual.
+    /// \return The visual, or null if the entity has no visual.
+    public: static rendering::VisualPtr VisualByEntity(
+        const rendering::ScenePtr &_scene, Entity _id);
+
     /// \brief Load Actor animations
     /// \param[in] _actor Actor
     /// \return Animation name to ID map
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "BatchRunner.hh"
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/TestFixture.hh"
+#include "gz/sim/Util.hh"
+
+namespace py = pybind11;
+
+namespace gz
+{
+namespace sim
+{
+namespace python
+{
+namespace
+{
+/// \brief Number of values stored for each pose: x, y, z, qw, qx, qy, qz.
+constexpr std::size_t kPoseSize{7u};
+
+/// \brief Observations of one fixture, written by its post-update
+/// callback on the simulation thread.
+struct Observations
+{
+  /// \brief Scoped names of the observed entities.
+  std::vector<std::string> names;
+
+  /// \brief Observed entities, or kNullEntity while they aren't found.
+  std::vector<Entity> entities;
+
+  /// \brief World pose of each observed entity, or NaN while it isn't
+  /// found.
+  std::vector<double> poses;
+
+  /// \brief Protects poses.
+  std::mutex mutex;
+
+  /// \brief Record the poses of the observed entities.
+  /// \param[in] _ecm Entity component manager.
+  void Record(const EntityComponentManager &_ecm)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (std::size_t i = 0u; i < this->names.size(); ++i)
+    {
+      if (this->entities[i] == kNullEntity)
+      {
+        auto found = entitiesFromScopedName(this->names[i], _ecm);
+        if (found.empty())
+          continue;
+        this->entities[i] = *found.begin();
+      }
+
+      const math::Pose3d pose = worldPose(this->entities[i], _ecm);
+      double *out = &this->poses[i * kPoseSize];
+      out[0] = pose.Pos().X();
+      out[1] = pose.Pos().Y();
+      out[2] = pose.Pos().Z();
+      out[3] = pose.Rot().W();
+      out[4] = pose.Rot().X();
+      out[5] = pose.Rot().Y();
+      out[6] = pose.Rot().Z();
+    }
+  }
+};
+
+/// \brief Steps several fixtures together, recording observations on the
+/// simulation threads so that Python isn't entered on every iteration.
+class BatchRunner
+{
+  /// \brief Constructor. Replaces the post-update callback of each fixture.
+  /// \param[in] _fixtures Fixtures to step, one per environment.
+  /// \param[in] _names Scoped names of the entities to observe.
+  public: BatchRunner(
+      const std::vector<std::shared_ptr<TestFixture>> &_fixtures,
+      const std::vector<std::string> &_names)
+    : fixtures(_fixtures)
+  {
+    for (auto &fixture : this->fixtures)
+    {
+      auto obs = std::make_shared<Observations>();
+      obs->names = _names;
+      obs->entities.assign(_names.size(), kNullEntity);
+      obs->poses.assign(_names.size() * kPoseSize,
+          std::numeric_limits<double>::quiet_NaN());
+      fixture->OnPostUpdate(
+          [obs](const UpdateInfo &, const EntityComponentManager &_ecm)
+          {
+            obs->Record(_ecm);
+          });
+      this->observations.push_back(obs);
+    }
+  }
+
+  /// \brief Run all the fixtures for a number of iterations, each one on
+  /// its own thread.
+  /// \param[in] _iterations Number of iterations.
+  /// \return True if all the servers ran.
+  public: bool Run(std::uint64_t _iterations)
+  {
+    std::vector<char> results(this->fixtures.size(), false);
+    {
+      py::gil_scoped_release release;
+      std::vector<std::thread> threads;
+      for (std::size_t i = 0u; i < this->fixtures.size(); ++i)
+      {
+        threads.emplace_back([this, &results, i, _iterations]
+            {
+              results[i] = this->fixtures[i]->Server()->Run(
+                  true, _iterations, false);
+            });
+      }
+      for (auto &thread : threads)
+        thread.join();
+    }
+    return std::all_of(results.begin(), results.end(),
+        [](char _result) { return _result; });
+  }
+
+  /// \brief Get the last recorded observations.
+  /// \return Array of size fixtures x names x 7.
+  public: py::array_t<double> WorldPoses() const
+  {
+    const std::size_t count =
+        this->observations.empty() ? 0u :
+        this->observations.front()->names.size();
+    py::array_t<double> result(
+        {this->observations.size(), count, kPoseSize});
+    double *out = result.mutable_data();
+    for (const auto &obs : this->observations)
+    {
+      std::lock_guard<std::mutex> lock(obs->mutex);
+      out = std::copy(obs->poses.begin(), obs->poses.end(), out);
+    }
+    return result;
+  }
+
+  /// \brief Fixtures being stepped.
+  private: std::vector<std::shared_ptr<TestFixture>> fixtures;
+
+  /// \brief Observations of each fixture.
+  private: std::vector<std::shared_ptr<Observations>> observations;
+};
+}  // namespace
+
+/////////////////////////////////////////////////
+void defineSimBatchRunner(pybind11::object module)
+{
+  py::class_<BatchRunner>(module, "BatchRunner")
+  .def(py::init<const std::vector<std::shared_ptr<TestFixture>> &,
+                const std::vector<std::string> &>(),
+      py::arg("fixtures"),
+      py::arg("observed_entities") = std::vector<std::string>(),
+      "Step several fixtures together. The world poses of the entities "
+      "with the given scoped names are recorded after each iteration "
+      "without calling into Python. This replaces each fixture's "
+      "post-update callback.")
+  .def("run", &BatchRunner::Run,
+      py::arg("iterations"),
+      "Run all the fixtures for a number of iterations in parallel, "
+      "returning once all of them are done.")
+  .def("world_poses", &BatchRunner::WorldPoses,
+      "Get the world poses recorded on the last iteration as a "
+      "fixtures x entities x 7 array of x, y, z, qw, qx, qy, qz values. "
+      "Poses of entities that weren't found are NaN.");
+}
+}  // namespace python
+}  // namespace sim
+}  // namespace gz
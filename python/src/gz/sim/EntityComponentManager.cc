@@ -13,22 +13,162 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <limits>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
 
 #include "EntityComponentManager.hh"
 
+#include "gz/sim/components/AngularVelocity.hh"
+#include "gz/sim/components/JointForceCmd.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/JointVelocityCmd.hh"
+#include "gz/sim/components/LinearVelocity.hh"
+#include "gz/sim/Util.hh"
+
+namespace py = pybind11;
+
 namespace gz
 {
 namespace sim
 {
 namespace python
 {
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Copy a 3D vector component of each entity into the rows of an
+/// array, or NaN for entities without the component.
+template<typename ComponentT>
+py::array_t<double> vectors(const EntityComponentManager &_ecm,
+    const std::vector<Entity> &_entities)
+{
+  py::array_t<double> result({_entities.size(), std::size_t{3u}});
+  auto out = result.mutable_unchecked<2>();
+  for (std::size_t i = 0u; i < _entities.size(); ++i)
+  {
+    auto comp = _ecm.Component<ComponentT>(_entities[i]);
+    const math::Vector3d v = comp ? comp->Data() : math::Vector3d::NaN;
+    out(i, 0) = v.X();
+    out(i, 1) = v.Y();
+    out(i, 2) = v.Z();
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy the first axis of a joint state component of each entity
+/// into an array, or NaN for entities without the component.
+template<typename ComponentT>
+py::array_t<double> firstAxis(const EntityComponentManager &_ecm,
+    const std::vector<Entity> &_entities)
+{
+  py::array_t<double> result(_entities.size());
+  auto out = result.mutable_unchecked<1>();
+  for (std::size_t i = 0u; i < _entities.size(); ++i)
+  {
+    auto comp = _ecm.Component<ComponentT>(_entities[i]);
+    out(i) = comp && !comp->Data().empty() ? comp->Data()[0] :
+        std::numeric_limits<double>::quiet_NaN();
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Set the first axis of a joint command component of each entity,
+/// creating the component if needed.
+template<typename ComponentT>
+void setFirstAxis(EntityComponentManager &_ecm,
+    const std::vector<Entity> &_entities,
+    const py::array_t<double, py::array::c_style | py::array::forcecast>
+        &_values)
+{
+  if (_values.ndim() != 1 ||
+      static_cast<std::size_t>(_values.shape(0)) != _entities.size())
+  {
+    throw py::value_error(
+        "Expected one value per entity in a 1-dimensional array");
+  }
+
+  auto in = _values.unchecked<1>();
+  for (std::size_t i = 0u; i < _entities.size(); ++i)
+  {
+    auto comp = _ecm.Component<ComponentT>(_entities[i]);
+    if (!comp)
+      _ecm.CreateComponent(_entities[i], ComponentT({in(i)}));
+    else
+      comp->Data() = {in(i)};
+  }
+}
+}  // namespace
+
 /////////////////////////////////////////////////
 void defineSimEntityComponentManager(pybind11::object module)
 {
   pybind11::class_<gz::sim::EntityComponentManager>(
       module, "EntityComponentManager")
-  .def(pybind11::init<>());
+  .def(pybind11::init<>())
+  .def("world_poses",
+      [](const EntityComponentManager &_ecm,
+         const std::vector<Entity> &_entities)
+      {
+        py::array_t<double> result({_entities.size(), std::size_t{7u}});
+        auto out = result.mutable_unchecked<2>();
+        for (std::size_t i = 0u; i < _entities.size(); ++i)
+        {
+          const math::Pose3d pose = worldPose(_entities[i], _ecm);
+          out(i, 0) = pose.Pos().X();
+          out(i, 1) = pose.Pos().Y();
+          out(i, 2) = pose.Pos().Z();
+          out(i, 3) = pose.Rot().W();
+          out(i, 4) = pose.Rot().X();
+          out(i, 5) = pose.Rot().Y();
+          out(i, 6) = pose.Rot().Z();
+        }
+        return result;
+      },
+      py::arg("entities"),
+      "Get the world poses of several entities as an N x 7 array of "
+      "x, y, z, qw, qx, qy, qz rows.")
+  .def("world_linear_velocities",
+      &vectors<components::WorldLinearVelocity>,
+      py::arg("entities"),
+      "Get the world linear velocities of several links as an N x 3 "
+      "array. Rows are NaN for links without velocity checks enabled.")
+  .def("world_angular_velocities",
+      &vectors<components::WorldAngularVelocity>,
+      py::arg("entities"),
+      "Get the world angular velocities of several links as an N x 3 "
+      "array. Rows are NaN for links without velocity checks enabled.")
+  .def("joint_positions",
+      &firstAxis<components::JointPosition>,
+      py::arg("entities"),
+      "Get the position of the first axis of several joints as an array. "
+      "Values are NaN for joints without position checks enabled.")
+  .def("joint_velocities",
+      &firstAxis<components::JointVelocity>,
+      py::arg("entities"),
+      "Get the velocity of the first axis of several joints as an array. "
+      "Values are NaN for joints without velocity checks enabled.")
+  .def("set_joint_forces",
+      &setFirstAxis<components::JointForceCmd>,
+      py::arg("entities"),
+      py::arg("forces"),
+      "Set the force commands on the first axis of several joints, with "
+      "one value per joint.")
+  .def("set_joint_velocities",
+      &setFirstAxis<components::JointVelocityCmd>,
+      py::arg("entities"),
+      py::arg("velocities"),
+      "Set the velocity commands on the first axis of several joints, with "
+      "one value per joint.");
 }
 }  // namespace python
 }  // namespace sim
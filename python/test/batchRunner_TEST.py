@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+# Copyright (C) 2024 Open Source Robotics Foundation
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#       http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+import os
+import unittest
+
+from gz_test_deps.common import set_verbosity
+from gz_test_deps.sim import BatchRunner, TestFixture
+
+
+class TestBatchRunner(unittest.TestCase):
+
+    def test_batch_runner(self):
+        set_verbosity(4)
+
+        file_path = os.path.dirname(os.path.realpath(__file__))
+        fixtures = [TestFixture(os.path.join(file_path, 'gravity.sdf'))
+                    for _ in range(3)]
+        runner = BatchRunner(fixtures, ['falling::link', 'missing'])
+        for fixture in fixtures:
+            fixture.finalize()
+
+        poses = runner.world_poses()
+        self.assertEqual((3, 2, 7), poses.shape)
+        self.assertTrue(math.isnan(poses[0][0][0]))
+
+        self.assertTrue(runner.run(100))
+        poses = runner.world_poses()
+        self.assertEqual((3, 2, 7), poses.shape)
+        for env in range(3):
+            # The link falls the same way in every world
+            self.assertLess(poses[env][0][2], 0)
+            self.assertAlmostEqual(poses[0][0][2], poses[env][0][2])
+            self.assertAlmostEqual(1, poses[env][0][3])
+            self.assertTrue(math.isnan(poses[env][1][0]))
+
+        # Running again continues from the current state
+        falling = poses[0][0][2]
+        self.assertTrue(runner.run(100))
+        self.assertLess(runner.world_poses()[0][0][2], falling)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# Copyright (C) 2024 Open Source Robotics Foundation
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#       http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+import os
+import unittest
+
+from gz_test_deps.common import set_verbosity
+from gz_test_deps.sim import (K_NULL_ENTITY, TestFixture,
+                              Joint, Link, Model, World, world_entity)
+
+
+class TestEntityComponentManager(unittest.TestCase):
+    pre_iterations = 0
+
+    def test_bulk_accessors(self):
+        set_verbosity(4)
+
+        file_path = os.path.dirname(os.path.realpath(__file__))
+        fixture = TestFixture(os.path.join(file_path, 'joint_test.sdf'))
+
+        def on_pre_udpate_cb(_info, _ecm):
+            self.pre_iterations += 1
+            world_e = world_entity(_ecm)
+            self.assertNotEqual(K_NULL_ENTITY, world_e)
+            w = World(world_e)
+            m = Model(w.model_by_name(_ecm, 'model_test'))
+            links = [m.link_by_name(_ecm, 'link_test_1'),
+                     m.link_by_name(_ecm, 'link_test_2')]
+            joints = [m.joint_by_name(_ecm, 'joint_test')]
+
+            # Poses
+            poses = _ecm.world_poses(links)
+            self.assertEqual((2, 7), poses.shape)
+
+            # Velocities are NaN until the checks are enabled
+            if self.pre_iterations == 1:
+                self.assertEqual([0, 0, 0, 1, 0, 0, 0], list(poses[0]))
+                velocities = _ecm.world_linear_velocities(links)
+                self.assertEqual((2, 3), velocities.shape)
+                self.assertTrue(math.isnan(velocities[0][0]))
+                self.assertTrue(math.isnan(
+                    _ecm.joint_positions(joints)[0]))
+                for link in links:
+                    Link(link).enable_velocity_checks(_ecm, True)
+                Joint(joints[0]).enable_position_check(_ecm, True)
+                Joint(joints[0]).enable_velocity_check(_ecm, True)
+            else:
+                self.assertFalse(math.isnan(
+                    _ecm.world_angular_velocities(links)[1][0]))
+                self.assertFalse(math.isnan(
+                    _ecm.joint_positions(joints)[0]))
+
+            if self.pre_iterations > 2:
+                self.assertAlmostEqual(10, _ecm.joint_velocities(joints)[0])
+
+            # Commands
+            _ecm.set_joint_velocities(joints, [10])
+            with self.assertRaises(ValueError):
+                _ecm.set_joint_forces(joints, [1, 2])
+
+        fixture.on_pre_update(on_pre_udpate_cb)
+        fixture.finalize()
+
+        server = fixture.server()
+        server.run(True, 3, False)
+
+        self.assertEqual(3, self.pre_iterations)
+
+
+if __name__ == '__main__':
+    unittest.main()
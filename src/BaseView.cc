@@ -16,6 +16,10 @@
 */
 #include "gz/sim/detail/BaseView.hh"
 
+#include <algorithm>
+
+#include "gz/sim/components/Component.hh"
+#include "gz/sim/detail/View.hh"
 #include "gz/sim/Entity.hh"
 #include "gz/sim/Types.hh"
 
@@ -23,13 +27,162 @@ using namespace gz;
 using namespace sim;
 using namespace detail;
 
+namespace
+{
+//////////////////////////////////////////////////
+/// \brief Make a set hold the entities of a sorted vector.
+/// \param[in] _entities Sorted entities.
+/// \param[in] _version Version of _entities.
+/// \param[in, out] _set Set to update, if _entities changed since it was
+/// last updated.
+/// \param[in, out] _setVersion Version of _entities that _set holds.
+/// \return _set
+const std::set<Entity> &syncSet(const std::vector<Entity> &_entities,
+    std::uint64_t _version, std::set<Entity> &_set,
+    std::uint64_t &_setVersion)
+{
+  if (_setVersion != _version)
+  {
+    // Sorted input is inserted in linear time
+    _set = std::set<Entity>(_entities.begin(), _entities.end());
+    _setVersion = _version;
+  }
+  return _set;
+}
+}  // namespace
+
 //////////////////////////////////////////////////
 BaseView::~BaseView() = default;
 
 //////////////////////////////////////////////////
 bool BaseView::HasEntity(const Entity _entity) const
 {
-  return this->entities.find(_entity) != this->entities.end();
+  if (_entity < this->entityBits.size())
+    return this->entityBits[_entity];
+  if (_entity <= kDenseEntityLimit)
+    return false;
+  return std::binary_search(this->entities.begin(), this->entities.end(),
+      _entity);
+}
+
+//////////////////////////////////////////////////
+std::size_t BaseView::EntityIndex(const Entity _entity) const
+{
+  if (!this->HasEntity(_entity))
+    return kInvalidIndex;
+
+  auto it = std::lower_bound(this->entities.begin(), this->entities.end(),
+      _entity);
+  return static_cast<std::size_t>(it - this->entities.begin());
+}
+
+//////////////////////////////////////////////////
+std::size_t BaseView::NextIndex(const std::vector<Entity> &_entities,
+    std::size_t _index, const Entity _entity)
+{
+  // Fast path: the vector wasn't modified around the visited entity
+  if (_index < _entities.size() && _entities[_index] == _entity)
+    return _index + 1;
+
+  auto it = std::upper_bound(_entities.begin(), _entities.end(), _entity);
+  return static_cast<std::size_t>(it - _entities.begin());
+}
+
+//////////////////////////////////////////////////
+std::size_t BaseView::InsertEntity(const Entity _entity)
+{
+  std::size_t index;
+  if (this->entities.empty() || this->entities.back() < _entity)
+  {
+    index = this->entities.size();
+    this->entities.push_back(_entity);
+    ++this->entitiesVersion;
+  }
+  else
+  {
+    auto it = std::lower_bound(this->entities.begin(), this->entities.end(),
+        _entity);
+    index = static_cast<std::size_t>(it - this->entities.begin());
+    if (it == this->entities.end() || *it != _entity)
+    {
+      this->entities.insert(it, _entity);
+      ++this->entitiesVersion;
+    }
+  }
+
+  if (_entity <= kDenseEntityLimit)
+  {
+    if (_entity >= this->entityBits.size())
+    {
+      this->entityBits.resize(std::max<std::size_t>(_entity + 1,
+          this->entityBits.size() * 2), false);
+    }
+    this->entityBits[_entity] = true;
+  }
+
+  return index;
+}
+
+//////////////////////////////////////////////////
+std::size_t BaseView::EraseEntity(const Entity _entity)
+{
+  const std::size_t index = this->EntityIndex(_entity);
+  if (index == kInvalidIndex)
+    return kInvalidIndex;
+
+  this->entities.erase(this->entities.begin() + index);
+  ++this->entitiesVersion;
+  if (_entity < this->entityBits.size())
+    this->entityBits[_entity] = false;
+  if (SortedErase(this->newEntities, _entity))
+    ++this->newEntitiesVersion;
+
+  return index;
+}
+
+//////////////////////////////////////////////////
+bool BaseView::SortedInsert(std::vector<Entity> &_entities,
+    const Entity _entity)
+{
+  if (_entities.empty() || _entities.back() < _entity)
+  {
+    _entities.push_back(_entity);
+    return true;
+  }
+
+  auto it = std::lower_bound(_entities.begin(), _entities.end(), _entity);
+  if (it != _entities.end() && *it == _entity)
+    return false;
+
+  _entities.insert(it, _entity);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BaseView::SortedErase(std::vector<Entity> &_entities,
+    const Entity _entity)
+{
+  auto it = std::lower_bound(_entities.begin(), _entities.end(), _entity);
+  if (it == _entities.end() || *it != _entity)
+    return false;
+
+  _entities.erase(it);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BaseView::SortedErase(std::vector<Entity> &_entities,
+    const std::vector<Entity> &_toErase)
+{
+  if (_entities.empty() || _toErase.empty())
+    return;
+
+  auto newEnd = std::remove_if(_entities.begin(), _entities.end(),
+      [&](const Entity _entity)
+      {
+        return std::binary_search(_toErase.begin(), _toErase.end(), _entity);
+      });
+  _entities.erase(newEnd, _entities.end());
 }
 
 //////////////////////////////////////////////////
@@ -60,16 +213,85 @@ bool BaseView::MarkEntityToRemove(const Entity _entity)
   if (this->HasCachedComponentData(_entity) ||
       this->IsEntityMarkedForAddition(_entity))
   {
-    this->toRemoveEntities.insert(_entity);
+    if (SortedInsert(this->toRemoveEntities, _entity))
+      ++this->toRemoveEntitiesVersion;
     return true;
   }
   return false;
 }
 
+//////////////////////////////////////////////////
+std::size_t BaseView::MarkEntitiesToRemove(
+    const std::vector<Entity> &_entities)
+{
+  std::vector<Entity> marked;
+  for (const Entity entity : _entities)
+  {
+    if (this->HasCachedComponentData(entity) ||
+        this->IsEntityMarkedForAddition(entity))
+    {
+      marked.push_back(entity);
+    }
+  }
+  if (marked.empty())
+    return 0u;
+
+  const auto middle = this->toRemoveEntities.size();
+  this->toRemoveEntities.insert(this->toRemoveEntities.end(), marked.begin(),
+      marked.end());
+  std::inplace_merge(this->toRemoveEntities.begin(),
+      this->toRemoveEntities.begin() + middle, this->toRemoveEntities.end());
+  this->toRemoveEntities.erase(std::unique(this->toRemoveEntities.begin(),
+      this->toRemoveEntities.end()), this->toRemoveEntities.end());
+  ++this->toRemoveEntitiesVersion;
+  return marked.size();
+}
+
+//////////////////////////////////////////////////
+bool BaseView::ReplaceComponent(const Entity _entity,
+    const components::BaseComponent *_old, components::BaseComponent *_new)
+{
+  // Dispatched here rather than through a virtual function, so that the
+  // vtable of BaseView is unchanged
+  if (auto view = dynamic_cast<View *>(this))
+    return view->ReplaceComponent(_entity, _old, _new);
+
+  if (nullptr == _new || !this->RequiresComponent(_new->TypeId()) ||
+      !this->HasCachedComponentData(_entity))
+  {
+    return false;
+  }
+
+  const bool isNew = std::binary_search(this->newEntities.begin(),
+      this->newEntities.end(), _entity);
+  this->RemoveEntity(_entity);
+  this->MarkEntityToAdd(_entity, isNew);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t BaseView::RemoveEntities(const std::vector<Entity> &_entities)
+{
+  if (auto view = dynamic_cast<View *>(this))
+    return view->RemoveEntities(_entities);
+
+  std::size_t removed{0u};
+  for (const Entity entity : _entities)
+  {
+    if (this->RemoveEntity(entity))
+      ++removed;
+  }
+  return removed;
+}
+
 //////////////////////////////////////////////////
 void BaseView::ResetNewEntityState()
 {
-  this->newEntities.clear();
+  if (!this->newEntities.empty())
+  {
+    this->newEntities.clear();
+    ++this->newEntitiesVersion;
+  }
 
   // mark all entities in the toAddEntities map as not newly created
   for (auto &entityNewPair : this->toAddEntities)
@@ -82,19 +304,44 @@ const std::set<ComponentTypeId> &BaseView::ComponentTypes() const
   return this->componentTypes;
 }
 
+//////////////////////////////////////////////////
 const std::set<Entity> &BaseView::Entities() const
 {
-  return this->entities;
+  std::lock_guard<std::mutex> lock(this->setsMutex);
+  return syncSet(this->entities, this->entitiesVersion, this->entitiesSet,
+      this->entitiesSetVersion);
 }
 
 //////////////////////////////////////////////////
 const std::set<Entity> &BaseView::NewEntities() const
 {
-  return this->newEntities;
+  std::lock_guard<std::mutex> lock(this->setsMutex);
+  return syncSet(this->newEntities, this->newEntitiesVersion,
+      this->newEntitiesSet, this->newEntitiesSetVersion);
 }
 
 //////////////////////////////////////////////////
 const std::set<Entity> &BaseView::ToRemoveEntities() const
+{
+  std::lock_guard<std::mutex> lock(this->setsMutex);
+  return syncSet(this->toRemoveEntities, this->toRemoveEntitiesVersion,
+      this->toRemoveEntitiesSet, this->toRemoveEntitiesSetVersion);
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &BaseView::SortedEntities() const
+{
+  return this->entities;
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &BaseView::SortedNewEntities() const
+{
+  return this->newEntities;
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &BaseView::SortedToRemoveEntities() const
 {
   return this->toRemoveEntities;
 }
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <set>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/sim/Entity.hh"
@@ -36,6 +40,14 @@ class BaseViewTest : public InternalFixture<::testing::Test>
 {
 };
 
+/// \brief Check whether a container of entities contains an entity.
+template<typename ContainerT>
+bool contains(const ContainerT &_entities, const Entity _entity)
+{
+  return std::find(_entities.begin(), _entities.end(), _entity) !=
+      _entities.end();
+}
+
 /////////////////////////////////////////////////
 TEST_F(BaseViewTest, ComponentTypes)
 {
@@ -148,29 +160,28 @@ TEST_F(BaseViewTest, AddEntities)
   EXPECT_TRUE(modelNameView.HasCachedComponentData(e1));
   EXPECT_TRUE(modelNameView.HasCachedComponentData(e2));
   EXPECT_EQ(2u, modelNameView.Entities().size());
-  EXPECT_NE(modelNameView.Entities().find(e1), modelNameView.Entities().end());
-  EXPECT_NE(modelNameView.Entities().find(e2), modelNameView.Entities().end());
+  EXPECT_TRUE(contains(modelNameView.Entities(), e1));
+  EXPECT_TRUE(contains(modelNameView.Entities(), e2));
   EXPECT_EQ(1u, modelNameView.NewEntities().size());
-  EXPECT_NE(modelNameView.NewEntities().find(e2),
-      modelNameView.NewEntities().end());
+  EXPECT_TRUE(contains(modelNameView.NewEntities(), e2));
 
   auto e1ConstData = modelNameView.EntityComponentConstData(e1);
-  ASSERT_EQ(2u, e1ConstData.size());
+  ASSERT_NE(nullptr, e1ConstData);
   EXPECT_EQ(&e1ModelComp, e1ConstData[0]);
   EXPECT_EQ(&e1NameComp, e1ConstData[1]);
 
   auto e1Data = modelNameView.EntityComponentData(e1);
-  ASSERT_EQ(2u, e1Data.size());
+  ASSERT_NE(nullptr, e1Data);
   EXPECT_EQ(&e1ModelComp, e1Data[0]);
   EXPECT_EQ(&e1NameComp, e1Data[1]);
 
   auto e2ConstData = modelNameView .EntityComponentConstData(e2);
-  ASSERT_EQ(2u, e2ConstData.size());
+  ASSERT_NE(nullptr, e2ConstData);
   EXPECT_EQ(&e2ModelComp, e2ConstData[0]);
   EXPECT_EQ(&e2NameComp, e2ConstData[1]);
 
   auto e2Data = modelNameView.EntityComponentData(e2);
-  ASSERT_EQ(2u, e2Data.size());
+  ASSERT_NE(nullptr, e2Data);
   EXPECT_EQ(&e2ModelComp, e2Data[0]);
   EXPECT_EQ(&e2NameComp, e2Data[1]);
 }
@@ -216,7 +227,7 @@ TEST_F(BaseViewTest, RemoveEntities)
   EXPECT_EQ(1u, view.ToAddEntities().size());
   EXPECT_NE(view.ToAddEntities().end(), view.ToAddEntities().find(e1));
   EXPECT_EQ(1u, view.ToRemoveEntities().size());
-  EXPECT_NE(view.ToRemoveEntities().end(), view.ToRemoveEntities().find(e1));
+  EXPECT_TRUE(contains(view.ToRemoveEntities(), e1));
 
   // remove entities e1 and e2 from the view and make sure that the toAdd and
   // toRemove queues are updated to no longer have the removed entities
@@ -225,6 +236,81 @@ TEST_F(BaseViewTest, RemoveEntities)
   EXPECT_EQ(0u, view.ToRemoveEntities().size());
 }
 
+/////////////////////////////////////////////////
+TEST_F(BaseViewTest, RemoveEntitiesInBulk)
+{
+  auto view = detail::View({components::Model::typeId});
+
+  std::vector<components::Model> comps(10);
+  for (Entity e = 1; e <= 10; ++e)
+    view.AddEntityWithComps(e, e % 2 == 0, &comps[e - 1]);
+  EXPECT_TRUE(view.MarkEntityToAdd(20));
+
+  // Entities that aren't in the view aren't marked
+  EXPECT_EQ(4u, view.MarkEntitiesToRemove({2, 4, 6, 15, 20, 30}));
+  EXPECT_EQ(std::vector<Entity>({2, 4, 6, 20}),
+      view.SortedToRemoveEntities());
+  EXPECT_EQ(std::set<Entity>({2, 4, 6, 20}), view.ToRemoveEntities());
+  EXPECT_TRUE(view.MarkEntityToRemove(1));
+  EXPECT_EQ(std::vector<Entity>({1, 2, 4, 6, 20}),
+      view.SortedToRemoveEntities());
+  EXPECT_EQ(std::set<Entity>({1, 2, 4, 6, 20}), view.ToRemoveEntities());
+
+  // The remaining entities keep their component data
+  EXPECT_EQ(5u, view.RemoveEntities({1, 2, 4, 6, 15, 20}));
+  EXPECT_EQ(std::vector<Entity>({3, 5, 7, 8, 9, 10}), view.SortedEntities());
+  EXPECT_EQ(std::set<Entity>({3, 5, 7, 8, 9, 10}), view.Entities());
+  EXPECT_EQ(std::vector<Entity>({8, 10}), view.SortedNewEntities());
+  EXPECT_EQ(std::set<Entity>({8, 10}), view.NewEntities());
+  EXPECT_TRUE(view.SortedToRemoveEntities().empty());
+  EXPECT_TRUE(view.ToRemoveEntities().empty());
+  EXPECT_TRUE(view.ToAddEntities().empty());
+  EXPECT_FALSE(view.HasEntity(4));
+  for (const Entity e : view.SortedEntities())
+  {
+    ASSERT_NE(nullptr, view.EntityComponentConstData(e));
+    EXPECT_EQ(&comps[e - 1], view.EntityComponentConstData(e)[0]);
+  }
+  EXPECT_EQ(0u, view.RemoveEntities({1, 2}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(BaseViewTest, SetsFollowChanges)
+{
+  auto view = detail::View({components::Model::typeId});
+
+  std::vector<components::Model> comps(3);
+  for (Entity e = 1; e <= 3; ++e)
+    view.AddEntityWithComps(e, true, &comps[e - 1]);
+
+  const auto &entities = view.Entities();
+  EXPECT_EQ(std::set<Entity>({1, 2, 3}), entities);
+  EXPECT_EQ(&entities, &view.Entities());
+  EXPECT_EQ(std::set<Entity>({1, 2, 3}), view.NewEntities());
+
+  // Replacing the data of an entity doesn't change the sets
+  view.AddEntityWithComps(2, true, &comps[0]);
+  EXPECT_EQ(std::set<Entity>({1, 2, 3}), view.Entities());
+
+  view.ResetNewEntityState();
+  EXPECT_TRUE(view.NewEntities().empty());
+  EXPECT_EQ(std::set<Entity>({1, 2, 3}), view.Entities());
+
+  EXPECT_TRUE(view.MarkEntityToRemove(3));
+  EXPECT_EQ(std::set<Entity>({3}), view.ToRemoveEntities());
+  EXPECT_TRUE(view.RemoveEntity(3));
+  EXPECT_EQ(std::set<Entity>({1, 2}), view.Entities());
+  EXPECT_TRUE(view.ToRemoveEntities().empty());
+
+  view.AddEntityWithComps(4, true, &comps[2]);
+  EXPECT_EQ(std::set<Entity>({1, 2, 4}), view.Entities());
+  EXPECT_EQ(std::set<Entity>({4}), view.NewEntities());
+
+  view.Reset();
+  EXPECT_TRUE(view.Entities().empty());
+  EXPECT_TRUE(view.NewEntities().empty());
+}
+
 /////////////////////////////////////////////////
 TEST_F(BaseViewTest, Reset)
 {
@@ -320,17 +406,73 @@ TEST_F(BaseViewTest, CachedComponentData)
   view.AddEntityWithConstComps(e1, e1IsNew, &e1ModelComp);
   EXPECT_TRUE(view.HasCachedComponentData(e1));
 
-  // reset the view and add only const component data this time
+  // adding the same entity twice doesn't duplicate it
+  EXPECT_EQ(1u, view.Entities().size());
+
+  // const and non-const callbacks share the same component data, so adding
+  // either of them is enough
   view.Reset();
   EXPECT_FALSE(view.HasCachedComponentData(e1));
   view.AddEntityWithConstComps(e1, e1IsNew, &e1ModelComp);
-  EXPECT_FALSE(view.HasCachedComponentData(e1));
+  EXPECT_TRUE(view.HasCachedComponentData(e1));
 
-  // reset the view and add only non-const component data this time
   view.Reset();
   EXPECT_FALSE(view.HasCachedComponentData(e1));
   view.AddEntityWithComps(e1, e1IsNew, &e1ModelComp);
-  EXPECT_FALSE(view.HasCachedComponentData(e1));
+  EXPECT_TRUE(view.HasCachedComponentData(e1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(BaseViewTest, SortedEntities)
+{
+  auto view = detail::View({components::Model::typeId});
+
+  std::vector<components::Model> comps(6);
+
+  // add entities out of order, plus one with a large ID that isn't tracked
+  // by the membership bitset
+  const Entity large = Entity{1} << 40;
+  const std::vector<Entity> toAdd{5, 2, large, 4, 1, 3};
+  for (std::size_t i = 0; i < toAdd.size(); ++i)
+    view.AddEntityWithComps(toAdd[i], false, &comps[i]);
+
+  const std::vector<Entity> expected{1, 2, 3, 4, 5, large};
+  EXPECT_EQ(expected, view.SortedEntities());
+  for (std::size_t i = 0; i < toAdd.size(); ++i)
+  {
+    EXPECT_TRUE(view.HasEntity(toAdd[i]));
+    auto data = view.EntityComponentData(toAdd[i]);
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(&comps[i], data[0]);
+
+    auto index = view.EntityIndex(toAdd[i]);
+    ASSERT_NE(detail::BaseView::kInvalidIndex, index);
+    EXPECT_EQ(toAdd[i], view.SortedEntities()[index]);
+    EXPECT_EQ(&comps[i], view.EntityComponentDataAt(index)[0]);
+  }
+  EXPECT_FALSE(view.HasEntity(6));
+  EXPECT_FALSE(view.HasEntity(large + 1));
+  EXPECT_EQ(nullptr, view.EntityComponentData(6));
+  EXPECT_EQ(detail::BaseView::kInvalidIndex, view.EntityIndex(6));
+
+  // removing entities keeps the component data aligned with the entities
+  EXPECT_TRUE(view.RemoveEntity(3));
+  EXPECT_TRUE(view.RemoveEntity(large));
+  EXPECT_FALSE(view.HasEntity(3));
+  EXPECT_FALSE(view.HasEntity(large));
+  const std::vector<Entity> remaining{1, 2, 4, 5};
+  EXPECT_EQ(remaining, view.SortedEntities());
+  EXPECT_EQ(std::set<Entity>(remaining.begin(), remaining.end()),
+      view.Entities());
+  EXPECT_EQ(&comps[0], view.EntityComponentData(5)[0]);
+  EXPECT_EQ(&comps[3], view.EntityComponentData(4)[0]);
+
+  // iteration resumes after the visited entity, even if the vector changed
+  const auto &entities = view.SortedEntities();
+  EXPECT_EQ(2u, detail::BaseView::NextIndex(entities, 1, 2));
+  EXPECT_TRUE(view.RemoveEntity(2));
+  EXPECT_EQ(1u, detail::BaseView::NextIndex(entities, 1, 2));
+  EXPECT_EQ(4, entities[1]);
 }
 
 /////////////////////////////////////////////////
@@ -350,9 +492,9 @@ TEST_F(BaseViewTest, ComponentChangeNotification)
   EXPECT_TRUE(view.HasCachedComponentData(e1));
   EXPECT_TRUE(view.HasEntity(e1));
   EXPECT_EQ(1u, view.Entities().size());
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e1));
+  EXPECT_TRUE(contains(view.Entities(), e1));
   EXPECT_EQ(1u, view.NewEntities().size());
-  EXPECT_NE(view.NewEntities().end(), view.NewEntities().find(e1));
+  EXPECT_TRUE(contains(view.NewEntities(), e1));
 
   // mimic a removal of e1's model component by notifying the view that this
   // component was removed
@@ -388,9 +530,9 @@ TEST_F(BaseViewTest, ComponentChangeNotification)
   EXPECT_TRUE(view.HasCachedComponentData(e1));
   EXPECT_TRUE(view.HasEntity(e1));
   EXPECT_EQ(1u, view.Entities().size());
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e1));
+  EXPECT_TRUE(contains(view.Entities(), e1));
   EXPECT_EQ(1u, view.NewEntities().size());
-  EXPECT_NE(view.NewEntities().end(), view.NewEntities().find(e1));
+  EXPECT_TRUE(contains(view.NewEntities(), e1));
 
   // try to call NotifyComponent* methods with component types that don't
   // belong to the view
@@ -426,16 +568,16 @@ TEST_F(BaseViewTest, ComponentChangeNotification)
   EXPECT_TRUE(view.HasCachedComponentData(e2));
   EXPECT_TRUE(view.HasEntity(e2));
   EXPECT_EQ(2u, view.Entities().size());
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e1));
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e2));
+  EXPECT_TRUE(contains(view.Entities(), e1));
+  EXPECT_TRUE(contains(view.Entities(), e2));
   EXPECT_EQ(1u, view.NewEntities().size());
-  EXPECT_EQ(view.NewEntities().end(), view.NewEntities().find(e2));
+  EXPECT_FALSE(contains(view.NewEntities(), e2));
 
   // call NotifyComponentRemoval on the entity that was just added to the view
   EXPECT_TRUE(view.NotifyComponentRemoval(e2, components::Model::typeId));
   EXPECT_FALSE(view.HasEntity(e2));
   EXPECT_EQ(1u, view.Entities().size());
-  EXPECT_EQ(view.Entities().end(), view.Entities().find(e2));
+  EXPECT_FALSE(contains(view.Entities(), e2));
   EXPECT_EQ(1u, view.NewEntities().size());
   EXPECT_TRUE(view.HasCachedComponentData(e2));
 
@@ -445,7 +587,7 @@ TEST_F(BaseViewTest, ComponentChangeNotification)
   EXPECT_TRUE(view.NotifyComponentRemoval(e2, components::Model::typeId));
   EXPECT_FALSE(view.HasEntity(e2));
   EXPECT_EQ(1u, view.Entities().size());
-  EXPECT_EQ(view.Entities().end(), view.Entities().find(e2));
+  EXPECT_FALSE(contains(view.Entities(), e2));
   EXPECT_EQ(1u, view.NewEntities().size());
   EXPECT_TRUE(view.HasCachedComponentData(e2));
 
@@ -455,10 +597,10 @@ TEST_F(BaseViewTest, ComponentChangeNotification)
   EXPECT_TRUE(view.HasCachedComponentData(e2));
   EXPECT_TRUE(view.HasEntity(e2));
   EXPECT_EQ(2u, view.Entities().size());
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e1));
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e2));
+  EXPECT_TRUE(contains(view.Entities(), e1));
+  EXPECT_TRUE(contains(view.Entities(), e2));
   EXPECT_EQ(1u, view.NewEntities().size());
-  EXPECT_EQ(view.NewEntities().end(), view.NewEntities().find(e2));
+  EXPECT_FALSE(contains(view.NewEntities(), e2));
 
   // call NotifyComponentAddition on a component that was already notified of
   // addition. While the notification should still take place, it will have no
@@ -468,10 +610,10 @@ TEST_F(BaseViewTest, ComponentChangeNotification)
   EXPECT_TRUE(view.HasCachedComponentData(e2));
   EXPECT_TRUE(view.HasEntity(e2));
   EXPECT_EQ(2u, view.Entities().size());
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e1));
-  EXPECT_NE(view.Entities().end(), view.Entities().find(e2));
+  EXPECT_TRUE(contains(view.Entities(), e1));
+  EXPECT_TRUE(contains(view.Entities(), e2));
   EXPECT_EQ(1u, view.NewEntities().size());
-  EXPECT_EQ(view.NewEntities().end(), view.NewEntities().find(e2));
+  EXPECT_FALSE(contains(view.NewEntities(), e2));
 }
 
 /////////////////////////////////////////////////
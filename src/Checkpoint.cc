@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "Checkpoint.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+
+#include <gz/common/Uuid.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace
+{
+/// \brief Start of every checkpoint.
+constexpr char kCheckpointMagic[4] = {'G', 'Z', 'C', 'P'};
+
+/// \brief Version of the format, increased whenever it changes.
+constexpr std::uint32_t kCheckpointVersion{1u};
+
+/// \brief Written in host byte order, so checkpoints from hosts with a
+/// different byte order are rejected.
+constexpr std::uint32_t kByteOrderMarker{0x01020304u};
+
+/// \brief Sizes larger than this are considered corrupted, instead of
+/// trying to allocate them.
+constexpr std::uint64_t kMaxSize{std::uint64_t{1u} << 40};
+
+//////////////////////////////////////////////////
+template <typename T>
+void writeValue(std::ostream &_out, T _value)
+{
+  static_assert(std::is_arithmetic_v<T>);
+  _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+}
+
+//////////////////////////////////////////////////
+template <typename T>
+bool readValue(std::istream &_in, T &_value)
+{
+  static_assert(std::is_arithmetic_v<T>);
+  _in.read(reinterpret_cast<char *>(&_value), sizeof(T));
+  return static_cast<bool>(_in);
+}
+
+//////////////////////////////////////////////////
+void writeBytes(std::ostream &_out, const void *_data, std::uint64_t _size)
+{
+  writeValue(_out, _size);
+  if (_size > 0u)
+  {
+    _out.write(static_cast<const char *>(_data),
+        static_cast<std::streamsize>(_size));
+  }
+}
+
+//////////////////////////////////////////////////
+template <typename ContainerT>
+bool readBytes(std::istream &_in, ContainerT &_data)
+{
+  std::uint64_t size{0u};
+  if (!readValue(_in, size) || size > kMaxSize)
+    return false;
+  _data.resize(size);
+  if (size > 0u)
+  {
+    _in.read(reinterpret_cast<char *>(_data.data()),
+        static_cast<std::streamsize>(size));
+  }
+  return static_cast<bool>(_in);
+}
+}
+
+//////////////////////////////////////////////////
+bool writeCheckpoint(std::ostream &_out, const Checkpoint &_checkpoint)
+{
+  _out.write(kCheckpointMagic, sizeof(kCheckpointMagic));
+  writeValue(_out, kCheckpointVersion);
+  writeValue(_out, kByteOrderMarker);
+
+  writeBytes(_out, _checkpoint.worldName.data(),
+      _checkpoint.worldName.size());
+  writeBytes(_out, _checkpoint.worldSdf.data(), _checkpoint.worldSdf.size());
+  writeValue(_out, static_cast<std::int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _checkpoint.simTime).count()));
+  writeValue(_out, _checkpoint.iterations);
+  writeBytes(_out, _checkpoint.state.data(), _checkpoint.state.size());
+
+  writeValue(_out, static_cast<std::uint64_t>(_checkpoint.systems.size()));
+  for (const auto &system : _checkpoint.systems)
+  {
+    writeValue(_out, static_cast<std::uint64_t>(system.parentEntity));
+    writeBytes(_out, system.name.data(), system.name.size());
+    writeBytes(_out, system.data.data(), system.data.size());
+  }
+  return static_cast<bool>(_out);
+}
+
+//////////////////////////////////////////////////
+bool readCheckpoint(std::istream &_in, Checkpoint &_checkpoint)
+{
+  char magic[sizeof(kCheckpointMagic)];
+  _in.read(magic, sizeof(magic));
+  if (!_in || !std::equal(magic, magic + sizeof(magic), kCheckpointMagic))
+    return false;
+
+  std::uint32_t version{0u};
+  std::uint32_t byteOrder{0u};
+  if (!readValue(_in, version) || version != kCheckpointVersion ||
+      !readValue(_in, byteOrder) || byteOrder != kByteOrderMarker)
+  {
+    return false;
+  }
+
+  std::int64_t simTime{0};
+  if (!readBytes(_in, _checkpoint.worldName) ||
+      !readBytes(_in, _checkpoint.worldSdf) ||
+      !readValue(_in, simTime) ||
+      !readValue(_in, _checkpoint.iterations) ||
+      !readBytes(_in, _checkpoint.state))
+  {
+    return false;
+  }
+  _checkpoint.simTime = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(std::chrono::nanoseconds(simTime));
+
+  std::uint64_t systemCount{0u};
+  if (!readValue(_in, systemCount) || systemCount > kMaxSize)
+    return false;
+  _checkpoint.systems.clear();
+  for (std::uint64_t i = 0u; i < systemCount; ++i)
+  {
+    CheckpointSystemState system;
+    std::uint64_t parentEntity{0u};
+    if (!readValue(_in, parentEntity) || !readBytes(_in, system.name) ||
+        !readBytes(_in, system.data))
+    {
+      return false;
+    }
+    system.parentEntity = static_cast<Entity>(parentEntity);
+    _checkpoint.systems.push_back(std::move(system));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool saveCheckpoint(const std::string &_path, const Checkpoint &_checkpoint)
+{
+  // Write to a unique file and move it in place, so a checkpoint that is
+  // interrupted doesn't replace the previous one
+  const auto tmpPath = _path + "." + common::Uuid().String() + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    if (!file || !writeCheckpoint(file, _checkpoint))
+    {
+      file.close();
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+    file.close();
+    if (file.fail())
+    {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmpPath.c_str(), _path.c_str()) != 0)
+  {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::optional<Checkpoint> loadCheckpoint(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  if (!file)
+    return std::nullopt;
+
+  Checkpoint checkpoint;
+  if (!readCheckpoint(file, checkpoint))
+    return std::nullopt;
+  return checkpoint;
+}
+}
+}
+}
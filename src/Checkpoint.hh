@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_CHECKPOINT_HH_
+#define GZ_SIM_CHECKPOINT_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \brief State saved by a system that implements ISystemSerialize.
+    struct CheckpointSystemState
+    {
+      /// \brief Entity the system is attached to.
+      Entity parentEntity{kNullEntity};
+
+      /// \brief Name of the system's plugin, empty for systems that weren't
+      /// loaded from a plugin.
+      std::string name;
+
+      /// \brief Data written by ISystemSerialize::SerializeState.
+      std::string data;
+    };
+
+    /// \brief Everything needed to resume a simulation from where it was
+    /// checkpointed.
+    struct Checkpoint
+    {
+      /// \brief Name of the world.
+      std::string worldName;
+
+      /// \brief SDFormat of the world as it was loaded, with its includes
+      /// expanded, so that restoring doesn't resolve or fetch anything.
+      std::string worldSdf;
+
+      /// \brief Simulation time of the last step before the checkpoint.
+      std::chrono::steady_clock::duration simTime{0};
+
+      /// \brief Number of steps before the checkpoint.
+      uint64_t iterations{0u};
+
+      /// \brief Full state of the ECM as a flat binary snapshot.
+      /// \sa EntityComponentManager::StateSnapshot
+      std::vector<std::uint8_t> state;
+
+      /// \brief State of the systems, in the order the systems were loaded.
+      std::vector<CheckpointSystemState> systems;
+    };
+
+    /// \brief Write a checkpoint. The format starts with the "GZCP" magic,
+    /// a format version and a byte order marker, followed by the fields of
+    /// the checkpoint, strings and buffers being prefixed with their size.
+    /// Like state snapshots, numbers are stored in host byte order.
+    /// \param[out] _out Stream to write to, opened in binary mode.
+    /// \param[in] _checkpoint The checkpoint.
+    /// \return True if successful.
+    bool GZ_SIM_VISIBLE writeCheckpoint(std::ostream &_out,
+        const Checkpoint &_checkpoint);
+
+    /// \brief Read a checkpoint written by writeCheckpoint.
+    /// \param[in] _in Stream to read from, opened in binary mode.
+    /// \param[out] _checkpoint The checkpoint.
+    /// \return False if the stream doesn't hold a valid checkpoint.
+    bool GZ_SIM_VISIBLE readCheckpoint(std::istream &_in,
+        Checkpoint &_checkpoint);
+
+    /// \brief Save a checkpoint to a file. It's written to a temporary file
+    /// first, which is then renamed, so the file is either the previous
+    /// checkpoint or the new one, even if the process is killed while
+    /// writing.
+    /// \param[in] _path Path of the file.
+    /// \param[in] _checkpoint The checkpoint.
+    /// \return True if successful.
+    bool GZ_SIM_VISIBLE saveCheckpoint(const std::string &_path,
+        const Checkpoint &_checkpoint);
+
+    /// \brief Load a checkpoint saved by saveCheckpoint.
+    /// \param[in] _path Path of the file.
+    /// \return The checkpoint, or nullopt if the file couldn't be read or
+    /// isn't a valid checkpoint.
+    std::optional<Checkpoint> GZ_SIM_VISIBLE loadCheckpoint(
+        const std::string &_path);
+    }
+  }
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "Checkpoint.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(Checkpoint, RoundTrip)
+{
+  EntityComponentManager ecm;
+  const Entity entity = ecm.CreateEntity();
+  ecm.CreateComponent(entity, components::Name("box"));
+  ecm.CreateComponent(entity, components::Pose(math::Pose3d(1, 2, 3, 0, 0, 0)));
+
+  Checkpoint checkpoint;
+  checkpoint.worldName = "default";
+  checkpoint.worldSdf = "<sdf version='1.6'><world name='default'/></sdf>";
+  checkpoint.simTime = 12s + 3ms;
+  checkpoint.iterations = 12003u;
+  ecm.StateSnapshot(checkpoint.state, {}, {}, true);
+  checkpoint.systems.push_back({1u, "gz::sim::systems::A", "a state"});
+  checkpoint.systems.push_back({entity, "", std::string(3, '\0')});
+
+  std::stringstream stream;
+  ASSERT_TRUE(writeCheckpoint(stream, checkpoint));
+
+  Checkpoint read;
+  ASSERT_TRUE(readCheckpoint(stream, read));
+  EXPECT_EQ(checkpoint.worldName, read.worldName);
+  EXPECT_EQ(checkpoint.worldSdf, read.worldSdf);
+  EXPECT_EQ(checkpoint.simTime, read.simTime);
+  EXPECT_EQ(checkpoint.iterations, read.iterations);
+  EXPECT_EQ(checkpoint.state, read.state);
+  ASSERT_EQ(2u, read.systems.size());
+  EXPECT_EQ(1u, read.systems[0].parentEntity);
+  EXPECT_EQ("gz::sim::systems::A", read.systems[0].name);
+  EXPECT_EQ("a state", read.systems[0].data);
+  EXPECT_EQ(entity, read.systems[1].parentEntity);
+  EXPECT_EQ(std::string(3, '\0'), read.systems[1].data);
+
+  // The restored state holds the entity
+  EntityComponentManager restored;
+  ASSERT_TRUE(restored.SetStateSnapshot(read.state.data(),
+      read.state.size()));
+  auto pose = restored.Component<components::Pose>(entity);
+  ASSERT_NE(nullptr, pose);
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), pose->Data());
+
+  // Truncated checkpoints are rejected
+  const auto data = stream.str();
+  std::stringstream truncated(data.substr(0, data.size() - 1));
+  EXPECT_FALSE(readCheckpoint(truncated, read));
+
+  std::stringstream invalid("GZSS not a checkpoint");
+  EXPECT_FALSE(readCheckpoint(invalid, read));
+}
+
+/////////////////////////////////////////////////
+TEST(Checkpoint, File)
+{
+  common::TempDirectory tempDir("checkpoint", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto path = common::joinPaths(tempDir.Path(), "sim.ckpt");
+  EXPECT_FALSE(loadCheckpoint(path));
+
+  Checkpoint checkpoint;
+  checkpoint.worldName = "first";
+  ASSERT_TRUE(saveCheckpoint(path, checkpoint));
+
+  // Saving again replaces the file
+  checkpoint.worldName = "second";
+  checkpoint.iterations = 5u;
+  ASSERT_TRUE(saveCheckpoint(path, checkpoint));
+
+  auto loaded = loadCheckpoint(path);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ("second", loaded->worldName);
+  EXPECT_EQ(5u, loaded->iterations);
+
+  // Only the checkpoint is left in the directory
+  int files{0};
+  for (common::DirIter it(tempDir.Path()); it != common::DirIter(); ++it)
+    ++files;
+  EXPECT_EQ(1, files);
+
+  EXPECT_FALSE(saveCheckpoint(
+      common::joinPaths(tempDir.Path(), "missing", "sim.ckpt"), checkpoint));
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "CollisionRayCaster.hh"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/common/SubMesh.hh>
+
+#include <sdf/Geometry.hh>
+#include <sdf/Mesh.hh>
+
+#include "gz/sim/components/Collision.hh"
+#include "gz/sim/Util.hh"
+
+#include "RayCaster.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Private data for CollisionRayCaster.
+class gz::sim::CollisionRayCaster::Implementation
+{
+  /// \brief Get the triangles of a mesh, loading them the first time.
+  /// \param[in] _mesh Mesh SDF DOM.
+  /// \return Scaled triangles, or nullptr if the mesh can't be loaded.
+  public: std::shared_ptr<const TriangleMesh> MeshTriangles(
+      const sdf::Mesh &_mesh);
+
+  /// \brief Collision shapes of the world.
+  public: RayCaster caster;
+
+  /// \brief Link of each shape of the caster, in the same order.
+  public: std::vector<Entity> shapeLinks;
+
+  /// \brief Triangles of meshes, by URI and scale.
+  public: std::unordered_map<std::string,
+      std::shared_ptr<const TriangleMesh>> meshes;
+
+  /// \brief Protects the updates of shared casters.
+  public: std::mutex updateMutex;
+
+  /// \brief Whether the shapes were updated during a step.
+  public: bool updated{false};
+
+  /// \brief Iteration of the step the shapes were last updated during.
+  public: std::uint64_t updateIteration{0};
+
+  /// \brief Collisions whose shape isn't supported, so they're only
+  /// reported once.
+  public: std::unordered_set<Entity> unsupported;
+};
+
+//////////////////////////////////////////////////
+CollisionRayCaster::CollisionRayCaster()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<CollisionRayCaster> CollisionRayCaster::Shared(
+    const EntityComponentManager &_ecm)
+{
+  return _ecm.SystemSharedData<CollisionRayCaster>("CollisionRayCaster");
+}
+
+//////////////////////////////////////////////////
+void CollisionRayCaster::Update(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+
+  // Poses may change without a step while paused
+  if (!_info.paused && this->dataPtr->updated &&
+      this->dataPtr->updateIteration == _info.iterations)
+  {
+    return;
+  }
+  this->dataPtr->updated = true;
+  this->dataPtr->updateIteration = _info.iterations;
+  this->RemoveEntities(_ecm);
+  this->Update(_ecm);
+}
+
+//////////////////////////////////////////////////
+void CollisionRayCaster::Update(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("CollisionRayCaster::Update");
+  auto &caster = this->dataPtr->caster;
+  auto &shapeLinks = this->dataPtr->shapeLinks;
+  caster.Clear();
+  shapeLinks.clear();
+  _ecm.Each<components::Collision, components::CollisionElement>(
+    [&](const Entity &_entity, const components::Collision *,
+        const components::CollisionElement *_collision) -> bool
+    {
+      const sdf::Geometry *geom = _collision->Data().Geom();
+      if (nullptr == geom)
+        return true;
+
+      const auto pose = worldPose(_entity, _ecm);
+      const std::size_t count = caster.ShapeCount();
+      switch (geom->Type())
+      {
+        case sdf::GeometryType::BOX:
+          caster.AddBox(pose, geom->BoxShape()->Size());
+          break;
+        case sdf::GeometryType::SPHERE:
+          caster.AddSphere(pose, geom->SphereShape()->Radius());
+          break;
+        case sdf::GeometryType::CYLINDER:
+          caster.AddCylinder(pose, geom->CylinderShape()->Radius(),
+              geom->CylinderShape()->Length());
+          break;
+        case sdf::GeometryType::CAPSULE:
+          caster.AddCapsule(pose, geom->CapsuleShape()->Radius(),
+              geom->CapsuleShape()->Length());
+          break;
+        case sdf::GeometryType::ELLIPSOID:
+          caster.AddEllipsoid(pose, geom->EllipsoidShape()->Radii());
+          break;
+        case sdf::GeometryType::PLANE:
+          caster.AddPlane(pose, geom->PlaneShape()->Normal(),
+              geom->PlaneShape()->Size());
+          break;
+        case sdf::GeometryType::MESH:
+        {
+          auto triangles = this->dataPtr->MeshTriangles(*geom->MeshShape());
+          if (triangles)
+          {
+            caster.AddMesh(pose, std::move(triangles));
+            break;
+          }
+          [[fallthrough]];
+        }
+        default:
+          if (this->dataPtr->unsupported.insert(_entity).second)
+          {
+            gzwarn << "Collision [" << scopedName(_entity, _ecm)
+                   << "] has a shape that isn't supported by CPU ray "
+                   << "casts, it won't be detected by ray queries and CPU "
+                   << "sensors." << std::endl;
+          }
+          break;
+      }
+
+      // Empty meshes don't add a shape
+      if (caster.ShapeCount() > count)
+        shapeLinks.push_back(_ecm.ParentEntity(_entity));
+      return true;
+    });
+}
+
+//////////////////////////////////////////////////
+void CollisionRayCaster::RemoveEntities(const EntityComponentManager &_ecm)
+{
+  _ecm.EachRemoved<components::Collision>(
+    [&](const Entity &_entity, const components::Collision *) -> bool
+    {
+      this->dataPtr->unsupported.erase(_entity);
+      return true;
+    });
+}
+
+//////////////////////////////////////////////////
+std::size_t CollisionRayCaster::ShapeCount() const
+{
+  return this->dataPtr->caster.ShapeCount();
+}
+
+//////////////////////////////////////////////////
+double CollisionRayCaster::Cast(const math::Vector3d &_origin,
+    const math::Vector3d &_dir, double _max) const
+{
+  return this->dataPtr->caster.Cast(_origin, _dir, _max);
+}
+
+//////////////////////////////////////////////////
+double CollisionRayCaster::Cast(const math::Vector3d &_origin,
+    const math::Vector3d &_dir, double _max,
+    const std::unordered_set<Entity> &_excludedLinks) const
+{
+  if (_excludedLinks.empty())
+    return this->dataPtr->caster.Cast(_origin, _dir, _max);
+
+  const auto &shapeLinks = this->dataPtr->shapeLinks;
+  return this->dataPtr->caster.Cast(_origin, _dir, _max,
+      [&](std::size_t _shape)
+      {
+        return _excludedLinks.count(shapeLinks[_shape]) > 0;
+      });
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const TriangleMesh>
+    CollisionRayCaster::Implementation::MeshTriangles(const sdf::Mesh &_mesh)
+{
+  const std::string key = _mesh.FilePath() + "|" + _mesh.Uri() + "|" +
+      _mesh.Submesh() + "|" + std::to_string(_mesh.Scale().X()) + " " +
+      std::to_string(_mesh.Scale().Y()) + " " +
+      std::to_string(_mesh.Scale().Z());
+  auto it = this->meshes.find(key);
+  if (it != this->meshes.end())
+    return it->second;
+
+  Triangles triangles;
+  const common::Mesh *mesh = loadMesh(_mesh);
+  if (nullptr != mesh)
+  {
+    for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+    {
+      auto subMesh = mesh->SubMeshByIndex(i).lock();
+      if (!subMesh)
+        continue;
+      if (!_mesh.Submesh().empty() && subMesh->Name() != _mesh.Submesh())
+        continue;
+
+      for (unsigned int j = 0; j + 2 < subMesh->IndexCount(); j += 3)
+      {
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const auto index =
+              static_cast<unsigned int>(subMesh->Index(j + k));
+          triangles.push_back(subMesh->Vertex(index) * _mesh.Scale());
+        }
+      }
+    }
+  }
+
+  // Meshes that fail to load are remembered too, so they're only loaded
+  // once
+  std::shared_ptr<const TriangleMesh> result;
+  if (!triangles.empty())
+    result = std::make_shared<TriangleMesh>(std::move(triangles));
+  this->meshes[key] = result;
+  return result;
+}
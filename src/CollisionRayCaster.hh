@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COLLISIONRAYCASTER_HH_
+#define GZ_SIM_COLLISIONRAYCASTER_HH_
+
+#include <cstddef>
+#include <memory>
+#include <unordered_set>
+
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/EntityComponentManager.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class CollisionRayCaster CollisionRayCaster.hh
+    /// \brief Casts rays against the collision geometry of the world, for
+    /// the physics ray queries and the sensor systems that don't use
+    /// rendering.
+    ///
+    /// Boxes, spheres, cylinders, capsules, ellipsoids, planes and meshes
+    /// are supported, other collision shapes are reported once and are
+    /// invisible to the rays. Meshes are loaded once, sorted into a
+    /// bounding volume hierarchy and shared by all collisions that use them.
+    /// Rays that start inside a collision don't hit it.
+    class GZ_SIM_VISIBLE CollisionRayCaster
+    {
+      /// \brief Constructor.
+      public: CollisionRayCaster();
+
+      /// \brief Get the caster shared by all the systems of a world, so
+      /// the collisions are gathered once per step for all of them.
+      /// \param[in] _ecm Entity component manager of the world.
+      /// \return The shared caster, which lives as long as a system holds
+      /// it.
+      public: static std::shared_ptr<CollisionRayCaster> Shared(
+                  const EntityComponentManager &_ecm);
+
+      /// \brief Forget removed collisions, then replace the shapes with the
+      /// collisions of the world at their current poses, unless that was
+      /// already done during the same simulation step. This is thread safe,
+      /// so systems sharing the caster can call it from any update
+      /// callback after the physics step, before they cast rays.
+      /// \param[in] _info Update info of the step.
+      /// \param[in] _ecm Entity component manager.
+      public: void Update(const UpdateInfo &_info,
+                  const EntityComponentManager &_ecm);
+
+      /// \brief Replace the shapes with the collisions of the world at their
+      /// current poses.
+      /// \param[in] _ecm Entity component manager.
+      public: void Update(const EntityComponentManager &_ecm);
+
+      /// \brief Forget removed collisions.
+      /// \param[in] _ecm Entity component manager.
+      public: void RemoveEntities(const EntityComponentManager &_ecm);
+
+      /// \brief Get the number of shapes since the last update.
+      /// \return Number of shapes.
+      public: std::size_t ShapeCount() const;
+
+      /// \brief Cast a ray against the shapes of the last update. This is
+      /// thread safe.
+      /// \param[in] _origin Origin of the ray in world coordinates.
+      /// \param[in] _dir Unit direction of the ray in world coordinates.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \return Distance to the closest hit, or infinity if there's no hit
+      /// closer than _max.
+      public: double Cast(const math::Vector3d &_origin,
+                  const math::Vector3d &_dir, double _max) const;
+
+      /// \brief Cast a ray against the shapes of the last update, except the
+      /// collisions of some links, such as the link of the sensor casting
+      /// the ray. This is thread safe.
+      /// \param[in] _origin Origin of the ray in world coordinates.
+      /// \param[in] _dir Unit direction of the ray in world coordinates.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[in] _excludedLinks Links whose collisions are ignored.
+      /// \return Distance to the closest hit, or infinity if there's no hit
+      /// closer than _max.
+      public: double Cast(const math::Vector3d &_origin,
+                  const math::Vector3d &_dir, double _max,
+                  const std::unordered_set<Entity> &_excludedLinks) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
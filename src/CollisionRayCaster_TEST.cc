@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <unordered_set>
+
+#include <sdf/Box.hh>
+#include <sdf/Collision.hh>
+#include <sdf/Geometry.hh>
+
+#include "gz/sim/components/Collision.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/EntityComponentManager.hh"
+
+#include "CollisionRayCaster.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+/// \brief Create a collision entity.
+/// \param[in] _ecm ECM to create it in.
+/// \param[in] _pose Pose of the collision.
+/// \param[in] _geometry Geometry of the collision.
+/// \return The entity.
+Entity createCollision(EntityComponentManager &_ecm,
+    const math::Pose3d &_pose, const sdf::Geometry &_geometry)
+{
+  sdf::Collision collision;
+  collision.SetGeom(_geometry);
+  const Entity entity = _ecm.CreateEntity();
+  _ecm.CreateComponent(entity, components::Collision());
+  _ecm.CreateComponent(entity, components::CollisionElement(collision));
+  _ecm.CreateComponent(entity, components::Pose(_pose));
+  return entity;
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionRayCaster, Cast)
+{
+  EntityComponentManager ecm;
+  sdf::Box box;
+  box.SetSize({2, 2, 2});
+  sdf::Geometry boxGeometry;
+  boxGeometry.SetType(sdf::GeometryType::BOX);
+  boxGeometry.SetBoxShape(box);
+  const Entity boxEntity = createCollision(ecm, {10, 0, 0, 0, 0, 0},
+      boxGeometry);
+
+  // Heightmaps aren't supported
+  sdf::Geometry heightmapGeometry;
+  heightmapGeometry.SetType(sdf::GeometryType::HEIGHTMAP);
+  createCollision(ecm, {-10, 0, 0, 0, 0, 0}, heightmapGeometry);
+
+  CollisionRayCaster caster;
+  EXPECT_EQ(0u, caster.ShapeCount());
+  caster.Update(ecm);
+  EXPECT_EQ(1u, caster.ShapeCount());
+
+  const math::Vector3d origin{0, 0, 0};
+  EXPECT_NEAR(9.0, caster.Cast(origin, math::Vector3d::UnitX, 100.0), 1e-6);
+  EXPECT_TRUE(std::isinf(caster.Cast(origin, -math::Vector3d::UnitX,
+      100.0)));
+  EXPECT_TRUE(std::isinf(caster.Cast(origin, math::Vector3d::UnitX, 5.0)));
+
+  // Shapes follow the collisions
+  ecm.SetComponentData<components::Pose>(boxEntity,
+      math::Pose3d(0, 0, -5, 0, 0, 0));
+  caster.Update(ecm);
+  EXPECT_NEAR(4.0, caster.Cast(origin, -math::Vector3d::UnitZ, 100.0),
+      1e-6);
+
+  ecm.RequestRemoveEntity(boxEntity);
+  caster.RemoveEntities(ecm);
+  ecm.ProcessRemoveEntityRequests();
+  caster.Update(ecm);
+  EXPECT_EQ(0u, caster.ShapeCount());
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionRayCaster, ExcludedLinks)
+{
+  EntityComponentManager ecm;
+  sdf::Box box;
+  box.SetSize({2, 2, 2});
+  sdf::Geometry boxGeometry;
+  boxGeometry.SetType(sdf::GeometryType::BOX);
+  boxGeometry.SetBoxShape(box);
+
+  // A sensor's own link in front of another box
+  const Entity sensorLink = ecm.CreateEntity();
+  const Entity sensorCollision = createCollision(ecm, {5, 0, 0, 0, 0, 0},
+      boxGeometry);
+  ecm.CreateComponent(sensorCollision, components::ParentEntity(sensorLink));
+  ecm.SetParentEntity(sensorCollision, sensorLink);
+  createCollision(ecm, {10, 0, 0, 0, 0, 0}, boxGeometry);
+
+  CollisionRayCaster caster;
+  caster.Update(ecm);
+  ASSERT_EQ(2u, caster.ShapeCount());
+
+  const math::Vector3d origin{0, 0, 0};
+  EXPECT_NEAR(4.0, caster.Cast(origin, math::Vector3d::UnitX, 100.0, {}),
+      1e-6);
+  EXPECT_NEAR(9.0, caster.Cast(origin, math::Vector3d::UnitX, 100.0,
+      {sensorLink}), 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionRayCaster, Shared)
+{
+  EntityComponentManager ecm;
+  auto caster = CollisionRayCaster::Shared(ecm);
+  ASSERT_NE(nullptr, caster);
+  EXPECT_EQ(caster, CollisionRayCaster::Shared(ecm));
+
+  sdf::Box box;
+  box.SetSize({2, 2, 2});
+  sdf::Geometry boxGeometry;
+  boxGeometry.SetType(sdf::GeometryType::BOX);
+  boxGeometry.SetBoxShape(box);
+  const Entity boxEntity = createCollision(ecm, {10, 0, 0, 0, 0, 0},
+      boxGeometry);
+
+  UpdateInfo info;
+  info.iterations = 1;
+  caster->Update(info, ecm);
+  const math::Vector3d origin{0, 0, 0};
+  EXPECT_NEAR(9.0, caster->Cast(origin, math::Vector3d::UnitX, 100.0),
+      1e-6);
+
+  // Only updated once per step
+  ecm.SetComponentData<components::Pose>(boxEntity,
+      math::Pose3d(20, 0, 0, 0, 0, 0));
+  caster->Update(info, ecm);
+  EXPECT_NEAR(9.0, caster->Cast(origin, math::Vector3d::UnitX, 100.0),
+      1e-6);
+
+  // But every time while paused
+  info.paused = true;
+  caster->Update(info, ecm);
+  EXPECT_NEAR(19.0, caster->Cast(origin, math::Vector3d::UnitX, 100.0),
+      1e-6);
+
+  ecm.SetComponentData<components::Pose>(boxEntity,
+      math::Pose3d(30, 0, 0, 0, 0, 0));
+  info.paused = false;
+  info.iterations = 2;
+  caster->Update(info, ecm);
+  EXPECT_NEAR(29.0, caster->Cast(origin, math::Vector3d::UnitX, 100.0),
+      1e-6);
+}
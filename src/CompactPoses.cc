@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "CompactPoses.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <gz/common/Console.hh>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Frame header.
+struct FrameHeader
+{
+  /// \brief Always "GZCP".
+  char magic[4];
+
+  /// \brief Format version.
+  std::uint16_t version;
+
+  /// \brief Frame flags.
+  std::uint16_t flags;
+
+  /// \brief Id of the keyframe this frame builds on.
+  std::uint32_t keyframeId;
+
+  /// \brief Number of records.
+  std::uint32_t count;
+
+  /// \brief Sim time in nanoseconds.
+  std::int64_t simTime;
+
+  /// \brief Size of a position step in meters.
+  double resolution;
+};
+
+static_assert(sizeof(FrameHeader) == 32, "Unexpected header padding");
+
+/// \brief Magic bytes at the start of every frame.
+constexpr char kMagic[4] = {'G', 'Z', 'C', 'P'};
+
+/// \brief Current format version.
+constexpr std::uint16_t kVersion = 1;
+
+/// \brief Flag set on keyframes.
+constexpr std::uint16_t kKeyframeFlag = 1;
+
+/// \brief Scale of the quantized quaternion components, which are at most
+/// 1/sqrt(2) once the largest component is dropped.
+const double kQuatScale = 32767.0 * std::sqrt(2.0);
+
+//////////////////////////////////////////////////
+void writeVarint(std::uint64_t _value, std::string &_out)
+{
+  while (_value >= 0x80)
+  {
+    _out.push_back(static_cast<char>((_value & 0x7F) | 0x80));
+    _value >>= 7;
+  }
+  _out.push_back(static_cast<char>(_value));
+}
+
+//////////////////////////////////////////////////
+bool readVarint(const std::string &_data, std::size_t &_offset,
+    std::uint64_t &_value)
+{
+  _value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    if (_offset >= _data.size())
+      return false;
+    const auto byte = static_cast<std::uint8_t>(_data[_offset++]);
+    _value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t zigzag(std::int64_t _value)
+{
+  return (static_cast<std::uint64_t>(_value) << 1) ^
+      static_cast<std::uint64_t>(_value >> 63);
+}
+
+//////////////////////////////////////////////////
+std::int64_t unzigzag(std::uint64_t _value)
+{
+  return static_cast<std::int64_t>(_value >> 1) ^
+      -static_cast<std::int64_t>(_value & 1);
+}
+
+//////////////////////////////////////////////////
+void writeRecord(const Entity _delta, const math::Pose3d &_pose,
+    const double _resolution, std::string &_out)
+{
+  writeVarint(_delta, _out);
+  for (int i = 0; i < 3; ++i)
+  {
+    writeVarint(zigzag(static_cast<std::int64_t>(
+        std::llround(_pose.Pos()[i] / _resolution))), _out);
+  }
+
+  // Smallest three, with the largest component made positive since q and -q
+  // are the same rotation
+  auto rot = _pose.Rot();
+  rot.Normalize();
+  const double q[4] = {rot.W(), rot.X(), rot.Y(), rot.Z()};
+  int largest = 0;
+  for (int i = 1; i < 4; ++i)
+  {
+    if (std::abs(q[i]) > std::abs(q[largest]))
+      largest = i;
+  }
+  const double sign = q[largest] < 0 ? -1.0 : 1.0;
+  _out.push_back(static_cast<char>(largest));
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+    const auto value = static_cast<std::int16_t>(std::clamp(
+        std::lround(q[i] * sign * kQuatScale), -32767L, 32767L));
+    char bytes[2];
+    std::memcpy(bytes, &value, sizeof(value));
+    _out.append(bytes, sizeof(bytes));
+  }
+}
+
+//////////////////////////////////////////////////
+bool readRecord(const std::string &_data, std::size_t &_offset,
+    const double _resolution, Entity &_delta, math::Pose3d &_pose)
+{
+  std::uint64_t value;
+  if (!readVarint(_data, _offset, value))
+    return false;
+  _delta = value;
+
+  math::Vector3d pos;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!readVarint(_data, _offset, value))
+      return false;
+    pos[i] = static_cast<double>(unzigzag(value)) * _resolution;
+  }
+
+  if (_offset + 7 > _data.size())
+    return false;
+  const auto largest = static_cast<int>(_data[_offset++]);
+  if (largest < 0 || largest > 3)
+    return false;
+
+  double q[4];
+  double sum = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+    std::int16_t quantized;
+    std::memcpy(&quantized, _data.data() + _offset, sizeof(quantized));
+    _offset += sizeof(quantized);
+    q[i] = quantized / kQuatScale;
+    sum += q[i] * q[i];
+  }
+  q[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+
+  _pose.Set(pos, math::Quaterniond(q[0], q[1], q[2], q[3]));
+  return true;
+}
+}
+
+//////////////////////////////////////////////////
+void CompactPoseEncoder::SetPositionResolution(double _resolution)
+{
+  if (_resolution <= 0)
+  {
+    gzerr << "Position resolution must be positive, got [" << _resolution
+          << "]." << std::endl;
+    return;
+  }
+  this->resolution = _resolution;
+  this->forceKeyframe = true;
+}
+
+//////////////////////////////////////////////////
+void CompactPoseEncoder::SetPositionThreshold(double _threshold)
+{
+  this->positionThreshold = std::max(0.0, _threshold);
+}
+
+//////////////////////////////////////////////////
+void CompactPoseEncoder::SetAngleThreshold(double _threshold)
+{
+  this->angleThreshold = std::max(0.0, _threshold);
+}
+
+//////////////////////////////////////////////////
+void CompactPoseEncoder::SetKeyframeInterval(unsigned int _interval)
+{
+  this->keyframeInterval = std::max(1u, _interval);
+}
+
+//////////////////////////////////////////////////
+void CompactPoseEncoder::ForceKeyframe()
+{
+  this->forceKeyframe = true;
+}
+
+//////////////////////////////////////////////////
+void CompactPoseEncoder::Add(Entity _entity, const math::Pose3d &_pose)
+{
+  this->pending.emplace_back(_entity, _pose);
+}
+
+//////////////////////////////////////////////////
+std::size_t CompactPoseEncoder::Encode(
+    const std::chrono::steady_clock::duration &_simTime, std::string &_out)
+{
+  const bool isKeyframe = this->forceKeyframe ||
+      this->framesSinceKeyframe + 1 >= this->keyframeInterval;
+  if (isKeyframe)
+  {
+    ++this->keyframeId;
+    this->framesSinceKeyframe = 0;
+    this->forceKeyframe = false;
+    this->lastSent.clear();
+  }
+  else
+  {
+    ++this->framesSinceKeyframe;
+  }
+
+  std::sort(this->pending.begin(), this->pending.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  _out.assign(sizeof(FrameHeader), '\0');
+  std::uint32_t count = 0;
+  Entity previous = 0;
+  for (const auto &[entity, pose] : this->pending)
+  {
+    if (!isKeyframe)
+    {
+      auto it = this->lastSent.find(entity);
+      if (it != this->lastSent.end())
+      {
+        const double dot = std::min(1.0,
+            std::abs(it->second.Rot().Dot(pose.Rot())));
+        if (it->second.Pos().Distance(pose.Pos()) <= this->positionThreshold
+            && 2.0 * std::acos(dot) <= this->angleThreshold)
+        {
+          continue;
+        }
+      }
+    }
+
+    writeRecord(entity - previous, pose, this->resolution, _out);
+    previous = entity;
+    this->lastSent[entity] = pose;
+    ++count;
+  }
+  this->pending.clear();
+
+  FrameHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.flags = isKeyframe ? kKeyframeFlag : 0;
+  header.keyframeId = this->keyframeId;
+  header.count = count;
+  header.simTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _simTime).count();
+  header.resolution = this->resolution;
+  std::memcpy(_out.data(), &header, sizeof(header));
+  return count;
+}
+
+//////////////////////////////////////////////////
+bool CompactPoseDecoder::Decode(const std::string &_data)
+{
+  FrameHeader header;
+  if (_data.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, _data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || !(header.resolution > 0))
+  {
+    return false;
+  }
+
+  const bool isKeyframe = (header.flags & kKeyframeFlag) != 0;
+  if (!isKeyframe &&
+      (!this->hasKeyframe || header.keyframeId != this->keyframeId))
+  {
+    return false;
+  }
+
+  // Decode into a copy, so invalid frames don't change the poses
+  std::vector<std::pair<Entity, math::Pose3d>> records;
+  records.reserve(header.count);
+  std::size_t offset = sizeof(header);
+  Entity entity = 0;
+  for (std::uint32_t i = 0; i < header.count; ++i)
+  {
+    Entity delta;
+    math::Pose3d pose;
+    if (!readRecord(_data, offset, header.resolution, delta, pose))
+      return false;
+    entity += delta;
+    records.emplace_back(entity, pose);
+  }
+
+  if (isKeyframe)
+  {
+    this->poses.clear();
+    this->keyframeId = header.keyframeId;
+    this->hasKeyframe = true;
+  }
+  this->keyframe = isKeyframe;
+  this->simTime = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(
+      std::chrono::nanoseconds(header.simTime));
+
+  this->changed.clear();
+  for (const auto &[id, pose] : records)
+  {
+    this->poses[id] = pose;
+    this->changed.push_back(id);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::unordered_map<Entity, math::Pose3d> &
+    CompactPoseDecoder::Poses() const
+{
+  return this->poses;
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &CompactPoseDecoder::Changed() const
+{
+  return this->changed;
+}
+
+//////////////////////////////////////////////////
+bool CompactPoseDecoder::Keyframe() const
+{
+  return this->keyframe;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration CompactPoseDecoder::SimTime() const
+{
+  return this->simTime;
+}
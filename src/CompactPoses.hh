@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COMPACTPOSES_HH_
+#define GZ_SIM_COMPACTPOSES_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class CompactPoseEncoder CompactPoses.hh
+    /// \brief Encodes entity poses into a compact binary stream, an
+    /// alternative to msgs::Pose_V for slow links.
+    ///
+    /// Each frame is a 32 byte header followed by one record per pose. The
+    /// header holds the "GZCP" magic, the format version, flags, the id of
+    /// the latest keyframe, the number of records, the sim time and the
+    /// position resolution. Each record holds the entity as a varint delta
+    /// from the previous record, the position as zigzag varints in units of
+    /// the resolution, and the orientation with its largest component
+    /// dropped and the other three quantized to 16 bits. Numbers in the
+    /// header are stored in host byte order.
+    ///
+    /// Keyframes hold every pose. The frames in between only hold the poses
+    /// that moved beyond a threshold since they were last sent, so the error
+    /// of a decoded pose is bounded by the thresholds plus the quantization.
+    class GZ_SIM_VISIBLE CompactPoseEncoder
+    {
+      /// \brief Set the size of a position step.
+      /// \param[in] _resolution Resolution in meters, greater than zero.
+      public: void SetPositionResolution(double _resolution);
+
+      /// \brief Set how far an entity has to move before its pose is sent
+      /// again.
+      /// \param[in] _threshold Distance in meters.
+      public: void SetPositionThreshold(double _threshold);
+
+      /// \brief Set how far an entity has to rotate before its pose is sent
+      /// again.
+      /// \param[in] _threshold Angle in radians.
+      public: void SetAngleThreshold(double _threshold);
+
+      /// \brief Set the number of frames between keyframes.
+      /// \param[in] _interval Number of frames, 1 to only send keyframes.
+      public: void SetKeyframeInterval(unsigned int _interval);
+
+      /// \brief Make the next frame a keyframe, for example after entities
+      /// were removed or a new decoder connected.
+      public: void ForceKeyframe();
+
+      /// \brief Add the current pose of an entity to the next frame.
+      /// \param[in] _entity The entity.
+      /// \param[in] _pose Its pose.
+      public: void Add(Entity _entity, const math::Pose3d &_pose);
+
+      /// \brief Encode the poses added since the last frame.
+      /// \param[in] _simTime Sim time of the poses.
+      /// \param[out] _out The encoded frame.
+      /// \return Number of poses in the frame.
+      public: std::size_t Encode(
+                  const std::chrono::steady_clock::duration &_simTime,
+                  std::string &_out);
+
+      /// \brief Poses added since the last frame.
+      private: std::vector<std::pair<Entity, math::Pose3d>> pending;
+
+      /// \brief Last pose sent for each entity since the latest keyframe.
+      private: std::unordered_map<Entity, math::Pose3d> lastSent;
+
+      /// \brief Size of a position step in meters.
+      private: double resolution{1e-3};
+
+      /// \brief Minimum distance to send a pose again.
+      private: double positionThreshold{1e-3};
+
+      /// \brief Minimum angle to send a pose again.
+      private: double angleThreshold{1e-3};
+
+      /// \brief Number of frames between keyframes.
+      private: unsigned int keyframeInterval{60u};
+
+      /// \brief Frames encoded since the latest keyframe.
+      private: unsigned int framesSinceKeyframe{0u};
+
+      /// \brief Id of the latest keyframe.
+      private: std::uint32_t keyframeId{0u};
+
+      /// \brief True to make the next frame a keyframe.
+      private: bool forceKeyframe{true};
+    };
+
+    /// \class CompactPoseDecoder CompactPoses.hh
+    /// \brief Decodes the frames written by CompactPoseEncoder, keeping the
+    /// latest pose of every entity.
+    ///
+    /// Frames between keyframes are only applied if their keyframe was
+    /// decoded, so a decoder that joins a stream, or misses a keyframe,
+    /// waits for the next one.
+    class GZ_SIM_VISIBLE CompactPoseDecoder
+    {
+      /// \brief Decode a frame.
+      /// \param[in] _data The encoded frame.
+      /// \return True if the frame was applied, false if it's invalid or
+      /// the decoder is waiting for a keyframe.
+      public: bool Decode(const std::string &_data);
+
+      /// \brief Latest pose of every entity in the stream.
+      /// \return Poses by entity.
+      public: const std::unordered_map<Entity, math::Pose3d> &Poses() const;
+
+      /// \brief Entities whose pose was in the latest decoded frame.
+      /// \return The entities.
+      public: const std::vector<Entity> &Changed() const;
+
+      /// \brief Whether the latest decoded frame was a keyframe.
+      /// \return True for keyframes.
+      public: bool Keyframe() const;
+
+      /// \brief Sim time of the latest decoded frame.
+      /// \return Sim time.
+      public: std::chrono::steady_clock::duration SimTime() const;
+
+      /// \brief Latest pose of every entity.
+      private: std::unordered_map<Entity, math::Pose3d> poses;
+
+      /// \brief Entities in the latest decoded frame.
+      private: std::vector<Entity> changed;
+
+      /// \brief Sim time of the latest decoded frame.
+      private: std::chrono::steady_clock::duration simTime{0};
+
+      /// \brief Id of the latest decoded keyframe.
+      private: std::uint32_t keyframeId{0u};
+
+      /// \brief True once a keyframe was decoded.
+      private: bool hasKeyframe{false};
+
+      /// \brief Whether the latest decoded frame was a keyframe.
+      private: bool keyframe{false};
+    };
+    }
+  }
+}
+#endif
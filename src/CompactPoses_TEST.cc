@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include "CompactPoses.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Check that two poses are the same within a tolerance.
+void expectNear(const math::Pose3d &_expected, const math::Pose3d &_actual,
+    double _tol)
+{
+  EXPECT_NEAR(_expected.Pos().X(), _actual.Pos().X(), _tol);
+  EXPECT_NEAR(_expected.Pos().Y(), _actual.Pos().Y(), _tol);
+  EXPECT_NEAR(_expected.Pos().Z(), _actual.Pos().Z(), _tol);
+  EXPECT_NEAR(1.0, std::abs(_expected.Rot().Dot(_actual.Rot())), _tol);
+}
+
+/////////////////////////////////////////////////
+TEST(CompactPoses, KeyframeRoundTrip)
+{
+  const math::Pose3d pose1(1.2345, -20.5, 0.001, 0.1, -0.2, 3.0);
+  const math::Pose3d pose2(-300, 400, 5, -3.1, 1.5, -0.7);
+
+  CompactPoseEncoder encoder;
+  encoder.Add(20, pose2);
+  encoder.Add(7, pose1);
+  std::string frame;
+  EXPECT_EQ(2u, encoder.Encode(1500ms, frame));
+
+  // Much smaller than the 16 doubles of the poses alone
+  EXPECT_LT(frame.size(), 32u + 2u * 20u);
+
+  CompactPoseDecoder decoder;
+  ASSERT_TRUE(decoder.Decode(frame));
+  EXPECT_TRUE(decoder.Keyframe());
+  EXPECT_EQ(1500ms, decoder.SimTime());
+  ASSERT_EQ(2u, decoder.Poses().size());
+  ASSERT_EQ(2u, decoder.Changed().size());
+  EXPECT_EQ(7u, decoder.Changed()[0]);
+  EXPECT_EQ(20u, decoder.Changed()[1]);
+  expectNear(pose1, decoder.Poses().at(7), 1e-3);
+  expectNear(pose2, decoder.Poses().at(20), 1e-3);
+}
+
+/////////////////////////////////////////////////
+TEST(CompactPoses, DeltaFrames)
+{
+  CompactPoseEncoder encoder;
+  encoder.SetKeyframeInterval(3);
+  encoder.SetPositionThreshold(0.01);
+  encoder.SetAngleThreshold(0.01);
+
+  CompactPoseDecoder decoder;
+  std::string frame;
+
+  // Keyframe
+  encoder.Add(1, math::Pose3d(0, 0, 0, 0, 0, 0));
+  encoder.Add(2, math::Pose3d(1, 0, 0, 0, 0, 0));
+  EXPECT_EQ(2u, encoder.Encode(1ms, frame));
+  ASSERT_TRUE(decoder.Decode(frame));
+
+  // Only the entity that moved beyond the threshold is sent
+  encoder.Add(1, math::Pose3d(0.005, 0, 0, 0, 0, 0));
+  encoder.Add(2, math::Pose3d(1, 0, 0, 0, 0, 0.5));
+  EXPECT_EQ(1u, encoder.Encode(2ms, frame));
+  ASSERT_TRUE(decoder.Decode(frame));
+  EXPECT_FALSE(decoder.Keyframe());
+  ASSERT_EQ(1u, decoder.Changed().size());
+  EXPECT_EQ(2u, decoder.Changed()[0]);
+  expectNear(math::Pose3d(0, 0, 0, 0, 0, 0), decoder.Poses().at(1), 1e-3);
+  expectNear(math::Pose3d(1, 0, 0, 0, 0, 0.5), decoder.Poses().at(2), 1e-3);
+
+  // Small moves accumulate until they cross the threshold
+  encoder.Add(1, math::Pose3d(0.02, 0, 0, 0, 0, 0));
+  encoder.Add(2, math::Pose3d(1, 0, 0, 0, 0, 0.5));
+  EXPECT_EQ(1u, encoder.Encode(3ms, frame));
+  ASSERT_TRUE(decoder.Decode(frame));
+  ASSERT_EQ(1u, decoder.Changed().size());
+  EXPECT_EQ(1u, decoder.Changed()[0]);
+  expectNear(math::Pose3d(0.02, 0, 0, 0, 0, 0), decoder.Poses().at(1), 1e-3);
+
+  // The fourth frame is a keyframe with every pose, and entities missing
+  // from it are dropped
+  encoder.Add(1, math::Pose3d(0.02, 0, 0, 0, 0, 0));
+  EXPECT_EQ(1u, encoder.Encode(4ms, frame));
+  ASSERT_TRUE(decoder.Decode(frame));
+  EXPECT_TRUE(decoder.Keyframe());
+  EXPECT_EQ(1u, decoder.Poses().size());
+  EXPECT_EQ(0u, decoder.Poses().count(2));
+}
+
+/////////////////////////////////////////////////
+TEST(CompactPoses, WaitForKeyframe)
+{
+  CompactPoseEncoder encoder;
+  encoder.SetKeyframeInterval(10);
+  std::string frame;
+
+  encoder.Add(1, math::Pose3d(0, 0, 0, 0, 0, 0));
+  encoder.Encode(1ms, frame);
+  encoder.Add(1, math::Pose3d(1, 0, 0, 0, 0, 0));
+  encoder.Encode(2ms, frame);
+
+  // A decoder that joins the stream late ignores frames until a keyframe
+  CompactPoseDecoder decoder;
+  EXPECT_FALSE(decoder.Decode(frame));
+  EXPECT_TRUE(decoder.Poses().empty());
+
+  encoder.ForceKeyframe();
+  encoder.Add(1, math::Pose3d(2, 0, 0, 0, 0, 0));
+  encoder.Encode(3ms, frame);
+  EXPECT_TRUE(decoder.Decode(frame));
+  expectNear(math::Pose3d(2, 0, 0, 0, 0, 0), decoder.Poses().at(1), 1e-3);
+
+  // Invalid data is rejected and doesn't change the poses
+  EXPECT_FALSE(decoder.Decode(std::string()));
+  EXPECT_FALSE(decoder.Decode(std::string(64, 'x')));
+  EXPECT_FALSE(decoder.Decode(frame.substr(0, frame.size() - 1)));
+  EXPECT_EQ(1u, decoder.Poses().size());
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "CompactState.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Frame header.
+struct FrameHeader
+{
+  /// \brief Always "GZCS".
+  char magic[4];
+
+  /// \brief Format version.
+  std::uint16_t version;
+
+  /// \brief Frame flags.
+  std::uint16_t flags;
+
+  /// \brief Id of the session, started by the latest keyframe.
+  std::uint32_t sessionId;
+
+  /// \brief Number of the frame in the session, 0 for keyframes.
+  std::uint32_t frame;
+
+  /// \brief Sim time in nanoseconds.
+  std::int64_t simTime;
+
+  /// \brief Number of records.
+  std::uint64_t count;
+};
+
+static_assert(sizeof(FrameHeader) == 32, "Unexpected header padding");
+
+/// \brief Magic bytes at the start of every frame.
+constexpr char kMagic[4] = {'G', 'Z', 'C', 'S'};
+
+/// \brief Current format version.
+constexpr std::uint16_t kVersion = 1;
+
+/// \brief Flag set on keyframes.
+constexpr std::uint16_t kKeyframeFlag = 1u << 0;
+
+/// \brief Flag set when the state holds one-time component changes.
+constexpr std::uint16_t kOneTimeChangesFlag = 1u << 1;
+
+//////////////////////////////////////////////////
+void writeVarint(std::uint64_t _value, std::string &_out)
+{
+  while (_value >= 0x80)
+  {
+    _out.push_back(static_cast<char>((_value & 0x7F) | 0x80));
+    _value >>= 7;
+  }
+  _out.push_back(static_cast<char>(_value));
+}
+
+//////////////////////////////////////////////////
+bool readVarint(const std::string &_data, std::size_t &_offset,
+    std::uint64_t &_value)
+{
+  _value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    if (_offset >= _data.size())
+      return false;
+    const auto byte = static_cast<std::uint8_t>(_data[_offset++]);
+    _value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a reference to a dictionary entry, adding the entry if it's
+/// defined by the reference.
+/// \param[in] _data The encoded frame.
+/// \param[in, out] _offset Offset of the reference.
+/// \param[in, out] _dictionary Entries of the session.
+/// \param[out] _value The referenced entry.
+/// \return False if the reference is invalid.
+bool readReference(const std::string &_data, std::size_t &_offset,
+    std::vector<std::uint64_t> &_dictionary, std::uint64_t &_value)
+{
+  std::uint64_t index;
+  if (!readVarint(_data, _offset, index))
+    return false;
+  if (index < _dictionary.size())
+  {
+    _value = _dictionary[index];
+    return true;
+  }
+
+  // Entries are defined in order, so a gap means a frame was missed
+  if (index != _dictionary.size() || !readVarint(_data, _offset, _value))
+    return false;
+  _dictionary.push_back(_value);
+  return true;
+}
+}
+
+//////////////////////////////////////////////////
+void CompactStateEncoder::SetKeyframeInterval(unsigned int _interval)
+{
+  this->keyframeInterval = std::max(1u, _interval);
+}
+
+//////////////////////////////////////////////////
+void CompactStateEncoder::ForceKeyframe()
+{
+  this->forceKeyframe = true;
+}
+
+//////////////////////////////////////////////////
+void CompactStateEncoder::WriteEntity(Entity _entity, std::string &_out)
+{
+  const auto [it, added] = this->entities.emplace(_entity,
+      this->entities.size());
+  writeVarint(it->second, _out);
+  if (added)
+    writeVarint(_entity, _out);
+}
+
+//////////////////////////////////////////////////
+void CompactStateEncoder::WriteType(ComponentTypeId _typeId,
+    std::string &_out)
+{
+  const auto [it, added] = this->types.emplace(_typeId, this->types.size());
+  writeVarint(it->second, _out);
+  if (added)
+    writeVarint(_typeId, _out);
+}
+
+//////////////////////////////////////////////////
+std::size_t CompactStateEncoder::Encode(
+    const msgs::SerializedStateMap &_state,
+    const std::chrono::steady_clock::duration &_simTime, std::string &_out)
+{
+  const bool isKeyframe = this->forceKeyframe ||
+      this->framesSinceKeyframe + 1 >= this->keyframeInterval;
+  if (isKeyframe)
+  {
+    ++this->sessionId;
+    this->framesSinceKeyframe = 0;
+    this->forceKeyframe = false;
+    this->entities.clear();
+    this->types.clear();
+  }
+  else
+  {
+    ++this->framesSinceKeyframe;
+  }
+
+  _out.assign(sizeof(FrameHeader), '\0');
+  for (const auto &[id, entityMsg] : _state.entities())
+  {
+    this->WriteEntity(entityMsg.id(), _out);
+    writeVarint((static_cast<std::uint64_t>(entityMsg.components_size()) << 1)
+        | (entityMsg.remove() ? 1u : 0u), _out);
+    for (const auto &[type, compMsg] : entityMsg.components())
+    {
+      this->WriteType(compMsg.type(), _out);
+
+      // Removed components have no data, and are written as size 0
+      if (compMsg.remove())
+      {
+        writeVarint(0u, _out);
+        continue;
+      }
+      const auto &data = compMsg.component();
+      writeVarint(data.size() + 1u, _out);
+      _out.append(data);
+    }
+  }
+
+  FrameHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.flags = (isKeyframe ? kKeyframeFlag : 0u) |
+      (_state.has_one_time_component_changes() ? kOneTimeChangesFlag : 0u);
+  header.sessionId = this->sessionId;
+  header.frame = this->framesSinceKeyframe;
+  header.simTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _simTime).count();
+  header.count = static_cast<std::uint64_t>(_state.entities_size());
+  std::memcpy(_out.data(), &header, sizeof(header));
+  return static_cast<std::size_t>(header.count);
+}
+
+//////////////////////////////////////////////////
+bool CompactStateDecoder::Decode(const std::string &_data,
+    msgs::SerializedStateMap &_state)
+{
+  FrameHeader header;
+  if (_data.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, _data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion)
+  {
+    return false;
+  }
+
+  const bool isKeyframe = (header.flags & kKeyframeFlag) != 0;
+  if (!isKeyframe && (!this->inSession ||
+      header.sessionId != this->sessionId || header.frame != this->frame + 1))
+  {
+    this->inSession = false;
+    return false;
+  }
+
+  // Decode with copies of the dictionaries, so invalid frames don't change
+  // them
+  std::vector<std::uint64_t> entityIds;
+  std::vector<std::uint64_t> typeIds;
+  if (!isKeyframe)
+  {
+    entityIds = this->entities;
+    typeIds = this->types;
+  }
+
+  msgs::SerializedStateMap state;
+  state.set_has_one_time_component_changes(
+      (header.flags & kOneTimeChangesFlag) != 0);
+  auto &stateEntities = *state.mutable_entities();
+  std::size_t offset = sizeof(header);
+  for (std::uint64_t i = 0; i < header.count; ++i)
+  {
+    std::uint64_t entity;
+    std::uint64_t entityInfo;
+    if (!readReference(_data, offset, entityIds, entity) ||
+        !readVarint(_data, offset, entityInfo))
+    {
+      return false;
+    }
+
+    auto &entityMsg = stateEntities[entity];
+    entityMsg.set_id(entity);
+    if ((entityInfo & 1u) != 0)
+      entityMsg.set_remove(true);
+
+    auto &components = *entityMsg.mutable_components();
+    for (std::uint64_t c = 0; c < (entityInfo >> 1); ++c)
+    {
+      std::uint64_t type;
+      std::uint64_t size;
+      if (!readReference(_data, offset, typeIds, type) ||
+          !readVarint(_data, offset, size))
+      {
+        return false;
+      }
+
+      auto &compMsg = components[type];
+      compMsg.set_type(type);
+      if (0u == size)
+      {
+        compMsg.set_remove(true);
+        continue;
+      }
+      --size;
+      if (size > _data.size() - offset)
+        return false;
+      compMsg.set_component(_data.data() + offset, size);
+      offset += size;
+    }
+  }
+
+  this->entities = std::move(entityIds);
+  this->types = std::move(typeIds);
+  this->sessionId = header.sessionId;
+  this->frame = header.frame;
+  this->inSession = true;
+  this->keyframe = isKeyframe;
+  this->simTime = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(
+      std::chrono::nanoseconds(header.simTime));
+  _state = std::move(state);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool CompactStateDecoder::Keyframe() const
+{
+  return this->keyframe;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration CompactStateDecoder::SimTime() const
+{
+  return this->simTime;
+}
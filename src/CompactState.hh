@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_COMPACTSTATE_HH_
+#define GZ_SIM_COMPACTSTATE_HH_
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class CompactStateEncoder CompactState.hh
+    /// \brief Encodes msgs::SerializedStateMap messages into a compact
+    /// binary stream, where entities and component types are referred to by
+    /// small indices instead of 64 bit IDs.
+    ///
+    /// Each frame is a 32 byte header followed by one record per entity.
+    /// The header holds the "GZCS" magic, the format version, flags, the id
+    /// of the session, the number of the frame in the session, the sim time
+    /// and the number of records. Each record
+    /// holds the entity, the number of components and whether the entity
+    /// was removed, followed by the components, each with its type and its
+    /// serialized data. Numbers after the header are varints, and numbers in
+    /// the header are stored in host byte order.
+    ///
+    /// Entities and component types are numbered in the order they first
+    /// appear in a session. The first time one appears, its index is the
+    /// number of known ones and it's followed by its ID. Afterwards only
+    /// the index is written. A new session starts on keyframes, which are
+    /// forced when decoders may not know the dictionary, and sent at an
+    /// interval so that decoders that join a stream can catch up.
+    class GZ_SIM_VISIBLE CompactStateEncoder
+    {
+      /// \brief Set the number of frames between keyframes.
+      /// \param[in] _interval Number of frames, 1 to only send keyframes.
+      public: void SetKeyframeInterval(unsigned int _interval);
+
+      /// \brief Make the next frame a keyframe, for example after a full
+      /// state or a jump back in time.
+      public: void ForceKeyframe();
+
+      /// \brief Encode a state.
+      /// \param[in] _state The state.
+      /// \param[in] _simTime Sim time of the state.
+      /// \param[out] _out The encoded frame.
+      /// \return Number of entities in the frame.
+      public: std::size_t Encode(const msgs::SerializedStateMap &_state,
+                  const std::chrono::steady_clock::duration &_simTime,
+                  std::string &_out);
+
+      /// \brief Write an entity, adding it to the dictionary if needed.
+      /// \param[in] _entity The entity.
+      /// \param[out] _out Frame being encoded.
+      private: void WriteEntity(Entity _entity, std::string &_out);
+
+      /// \brief Write a component type, adding it to the dictionary if
+      /// needed.
+      /// \param[in] _typeId The component type.
+      /// \param[out] _out Frame being encoded.
+      private: void WriteType(ComponentTypeId _typeId, std::string &_out);
+
+      /// \brief Index of every entity in the session.
+      private: std::unordered_map<Entity, std::uint64_t> entities;
+
+      /// \brief Index of every component type in the session.
+      private: std::unordered_map<ComponentTypeId, std::uint64_t> types;
+
+      /// \brief Number of frames between keyframes.
+      private: unsigned int keyframeInterval{60u};
+
+      /// \brief Frames encoded since the latest keyframe, which is also the
+      /// number of the next frame in the session.
+      private: unsigned int framesSinceKeyframe{0u};
+
+      /// \brief Id of the current session.
+      private: std::uint32_t sessionId{0u};
+
+      /// \brief True to make the next frame a keyframe.
+      private: bool forceKeyframe{true};
+    };
+
+    /// \class CompactStateDecoder CompactState.hh
+    /// \brief Decodes the frames written by CompactStateEncoder back into
+    /// msgs::SerializedStateMap messages.
+    ///
+    /// Frames are only decoded if the keyframe that started their session
+    /// and every frame since were decoded, so a decoder that joins a
+    /// stream, or misses a frame, waits for the next keyframe.
+    class GZ_SIM_VISIBLE CompactStateDecoder
+    {
+      /// \brief Decode a frame.
+      /// \param[in] _data The encoded frame.
+      /// \param[out] _state The decoded state.
+      /// \return True if the frame was decoded, false if it's invalid or
+      /// the decoder is waiting for a keyframe.
+      public: bool Decode(const std::string &_data,
+                  msgs::SerializedStateMap &_state);
+
+      /// \brief Whether the latest decoded frame was a keyframe.
+      /// \return True for keyframes.
+      public: bool Keyframe() const;
+
+      /// \brief Sim time of the latest decoded frame.
+      /// \return Sim time.
+      public: std::chrono::steady_clock::duration SimTime() const;
+
+      /// \brief Entities of the session, by index.
+      private: std::vector<Entity> entities;
+
+      /// \brief Component types of the session, by index.
+      private: std::vector<ComponentTypeId> types;
+
+      /// \brief Sim time of the latest decoded frame.
+      private: std::chrono::steady_clock::duration simTime{0};
+
+      /// \brief Id of the current session.
+      private: std::uint32_t sessionId{0u};
+
+      /// \brief Number of the latest decoded frame in the session.
+      private: std::uint32_t frame{0u};
+
+      /// \brief True while the session's frames can be decoded.
+      private: bool inSession{false};
+
+      /// \brief Whether the latest decoded frame was a keyframe.
+      private: bool keyframe{false};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "CompactState.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Add a component to a state message.
+/// \param[in] _state The state.
+/// \param[in] _entity Entity of the component.
+/// \param[in] _typeId Type of the component.
+/// \param[in] _data Serialized data, or empty if the component was removed.
+void addComponent(msgs::SerializedStateMap &_state, Entity _entity,
+    ComponentTypeId _typeId, const std::string &_data)
+{
+  auto &entityMsg = (*_state.mutable_entities())[_entity];
+  entityMsg.set_id(_entity);
+  auto &compMsg = (*entityMsg.mutable_components())[_typeId];
+  compMsg.set_type(_typeId);
+  if (_data.empty())
+    compMsg.set_remove(true);
+  else
+    compMsg.set_component(_data);
+}
+
+/////////////////////////////////////////////////
+TEST(CompactState, RoundTrip)
+{
+  const ComponentTypeId poseType{0x1234567890abcdefu};
+  const ComponentTypeId nameType{0xfedcba0987654321u};
+
+  msgs::SerializedStateMap state;
+  state.set_has_one_time_component_changes(true);
+  addComponent(state, 5, poseType, std::string("pose\0data", 9));
+  addComponent(state, 5, nameType, "link");
+  addComponent(state, 9, poseType, "other");
+  addComponent(state, 9, nameType, "");
+  (*state.mutable_entities())[12].set_id(12);
+  (*state.mutable_entities())[12].set_remove(true);
+
+  CompactStateEncoder encoder;
+  std::string frame;
+  EXPECT_EQ(3u, encoder.Encode(state, 1500ms, frame));
+
+  CompactStateDecoder decoder;
+  msgs::SerializedStateMap decoded;
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  EXPECT_TRUE(decoder.Keyframe());
+  EXPECT_EQ(1500ms, decoder.SimTime());
+  EXPECT_TRUE(decoded.has_one_time_component_changes());
+  ASSERT_EQ(3, decoded.entities_size());
+  const auto &entity5 = decoded.entities().at(5);
+  EXPECT_EQ(5u, entity5.id());
+  EXPECT_EQ(std::string("pose\0data", 9),
+      entity5.components().at(poseType).component());
+  EXPECT_EQ(poseType, entity5.components().at(poseType).type());
+  EXPECT_EQ("link", entity5.components().at(nameType).component());
+  EXPECT_TRUE(decoded.entities().at(9).components().at(nameType).remove());
+  EXPECT_TRUE(decoded.entities().at(12).remove());
+
+  // Once known, entities and types are referred to by a byte each
+  msgs::SerializedStateMap delta;
+  addComponent(delta, 9, poseType, "moved");
+  const auto protobufSize = delta.ByteSizeLong();
+  ASSERT_EQ(1u, encoder.Encode(delta, 1600ms, frame));
+  EXPECT_EQ(32u + 4u + 5u, frame.size());
+  EXPECT_LT(frame.size() - 32u, protobufSize);
+
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  EXPECT_FALSE(decoder.Keyframe());
+  ASSERT_EQ(1, decoded.entities_size());
+  EXPECT_EQ("moved",
+      decoded.entities().at(9).components().at(poseType).component());
+}
+
+/////////////////////////////////////////////////
+TEST(CompactState, MissedFrames)
+{
+  CompactStateEncoder encoder;
+  encoder.SetKeyframeInterval(3);
+
+  std::string keyframe;
+  std::string frame1;
+  std::string frame2;
+  msgs::SerializedStateMap state;
+  addComponent(state, 1, 10, "a");
+  encoder.Encode(state, 0ms, keyframe);
+  addComponent(state, 2, 10, "b");
+  encoder.Encode(state, 1ms, frame1);
+  encoder.Encode(state, 2ms, frame2);
+
+  // A decoder that joins after the keyframe waits for the next one
+  CompactStateDecoder decoder;
+  msgs::SerializedStateMap decoded;
+  EXPECT_FALSE(decoder.Decode(frame1, decoded));
+  ASSERT_TRUE(decoder.Decode(keyframe, decoded));
+
+  // Skipping a frame stops decoding until the next keyframe
+  EXPECT_FALSE(decoder.Decode(frame2, decoded));
+  EXPECT_FALSE(decoder.Decode(frame1, decoded));
+
+  std::string next;
+  encoder.Encode(state, 3ms, next);
+  ASSERT_TRUE(decoder.Decode(next, decoded));
+  EXPECT_TRUE(decoder.Keyframe());
+  EXPECT_EQ(2, decoded.entities_size());
+
+  // Truncated frames are rejected
+  encoder.Encode(state, 4ms, next);
+  next.resize(next.size() - 1);
+  EXPECT_FALSE(decoder.Decode(next, decoded));
+  EXPECT_FALSE(decoder.Decode("garbage", decoded));
+}
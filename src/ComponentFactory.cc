@@ -17,8 +17,11 @@
 
 #include "gz/sim/components/Factory.hh"
 
+using ComponentDataOps = gz::sim::components::ComponentDataOps;
 using Factory = gz::sim::components::Factory;
 
+ComponentDataOps::~ComponentDataOps() = default;
+
 Factory *Factory::Instance()
 {
   static gz::utils::NeverDestroyed<Factory> instance;
@@ -206,3 +206,46 @@ TEST_F(ComponentFactoryTest, New)
     ASSERT_EQ(nullptr, comp);
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(ComponentFactoryTest, DataOps)
+{
+  auto factory = components::Factory::Instance();
+
+  EXPECT_EQ(nullptr, factory->DataOps(123456789));
+
+  auto ops = factory->DataOps(components::Pose::typeId);
+  ASSERT_NE(nullptr, ops);
+  EXPECT_EQ(sizeof(components::Pose), ops->Size());
+  EXPECT_EQ(alignof(components::Pose), ops->Alignment());
+
+  // A descriptor which only implements the creation functions, like those
+  // built against older headers
+  using MyLegacy = components::Component<int, class MyLegacyTag>;
+  class LegacyDescriptor : public components::ComponentDescriptorBase
+  {
+    public: std::unique_ptr<components::BaseComponent> Create() const override
+    {
+      return std::make_unique<MyLegacy>();
+    }
+
+    public: std::unique_ptr<components::BaseComponent> Create(
+                const components::BaseComponent *_data) const override
+    {
+      return std::make_unique<MyLegacy>(
+          *static_cast<const MyLegacy *>(_data));
+    }
+  };
+
+  factory->Register<MyLegacy>("gz_sim_components.MyLegacy",
+      new LegacyDescriptor(), components::RegistrationObjectId(this));
+  EXPECT_NE(nullptr, factory->Descriptor(MyLegacy::typeId));
+  EXPECT_EQ(nullptr, factory->DataOps(MyLegacy::typeId));
+
+  MyLegacy legacy(3);
+  auto comp = factory->New(MyLegacy::typeId, &legacy);
+  ASSERT_NE(nullptr, comp);
+  EXPECT_EQ(3, static_cast<MyLegacy *>(comp.get())->Data());
+
+  factory->Unregister<MyLegacy>(components::RegistrationObjectId(this));
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "ComponentPool.hh"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+ComponentPool::ComponentPool(std::size_t _size, std::size_t _alignment,
+    std::size_t _chunkCapacity)
+  : alignment(std::max<std::size_t>(_alignment, 1u)),
+    chunkCapacity(std::max<std::size_t>(_chunkCapacity, 1u))
+{
+  // Round the slot size up to the alignment so that every slot in a chunk is
+  // properly aligned.
+  const std::size_t size = std::max<std::size_t>(_size, 1u);
+  this->slotSize =
+      ((size + this->alignment - 1) / this->alignment) * this->alignment;
+}
+
+//////////////////////////////////////////////////
+ComponentPool::~ComponentPool()
+{
+  for (auto *chunk : this->chunks)
+  {
+    ::operator delete(chunk, std::align_val_t(this->alignment));
+  }
+}
+
+//////////////////////////////////////////////////
+void *ComponentPool::Allocate()
+{
+  ++this->count;
+
+  if (!this->freeSlots.empty())
+  {
+    void *slot = this->freeSlots.back();
+    this->freeSlots.pop_back();
+    return slot;
+  }
+
+  if (this->chunks.empty() || this->nextSlot >= this->chunkCapacity)
+    this->AddChunk();
+
+  return this->chunks.back() + (this->nextSlot++ * this->slotSize);
+}
+
+//////////////////////////////////////////////////
+void ComponentPool::Release(void *_slot)
+{
+  if (nullptr == _slot)
+    return;
+
+  --this->count;
+  this->freeSlots.push_back(_slot);
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentPool::SlotSize() const
+{
+  return this->slotSize;
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentPool::Count() const
+{
+  return this->count;
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentPool::ChunkCount() const
+{
+  return this->chunks.size();
+}
+
+//////////////////////////////////////////////////
+bool ComponentPool::Owns(const void *_ptr) const
+{
+  const auto *ptr = static_cast<const unsigned char *>(_ptr);
+  const std::size_t chunkBytes = this->slotSize * this->chunkCapacity;
+  std::less_equal<const unsigned char *> lessEqual;
+  std::less<const unsigned char *> less;
+  for (const auto *chunk : this->chunks)
+  {
+    if (lessEqual(chunk, ptr) && less(ptr, chunk + chunkBytes))
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void ComponentPool::AddChunk()
+{
+  auto *chunk = static_cast<unsigned char *>(::operator new(
+      this->slotSize * this->chunkCapacity,
+      std::align_val_t(this->alignment)));
+  this->chunks.push_back(chunk);
+  this->nextSlot = 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_COMPONENTPOOL_HH_
+#define GZ_SIM_COMPONENTPOOL_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class ComponentPool ComponentPool.hh
+    /// \brief Fixed-size slot allocator used to keep component instances of
+    /// the same type in contiguous memory.
+    ///
+    /// Memory is reserved in chunks of `_chunkCapacity` slots. Chunks are
+    /// never moved or released until the pool is destroyed, so the address of
+    /// an allocated slot is stable until the slot is released. This is
+    /// required because views and systems keep raw pointers to components.
+    ///
+    /// Released slots are reused before new memory is handed out. The pool is
+    /// not thread safe.
+    class GZ_SIM_VISIBLE ComponentPool
+    {
+      /// \brief Constructor
+      /// \param[in] _size Size in bytes of each slot.
+      /// \param[in] _alignment Alignment in bytes of each slot.
+      /// \param[in] _chunkCapacity Number of slots per chunk.
+      public: ComponentPool(std::size_t _size, std::size_t _alignment,
+                  std::size_t _chunkCapacity = 256u);
+
+      /// \brief Destructor. All memory is released, regardless of whether
+      /// slots are still in use. Objects living in the slots must have been
+      /// destroyed by the caller.
+      public: ~ComponentPool();
+
+      /// \brief No copy constructor.
+      public: ComponentPool(const ComponentPool &) = delete;
+
+      /// \brief No copy assignment.
+      public: ComponentPool &operator=(const ComponentPool &) = delete;
+
+      /// \brief Get an uninitialized slot.
+      /// \return Pointer to memory of at least SlotSize() bytes.
+      public: void *Allocate();
+
+      /// \brief Return a slot to the pool. The object living in the slot
+      /// must have been destroyed already.
+      /// \param[in] _slot Pointer previously returned by Allocate().
+      public: void Release(void *_slot);
+
+      /// \brief Get the size of each slot, including padding.
+      /// \return Size in bytes.
+      public: std::size_t SlotSize() const;
+
+      /// \brief Get the number of slots currently in use.
+      /// \return Number of allocated slots.
+      public: std::size_t Count() const;
+
+      /// \brief Get the number of chunks reserved by the pool.
+      /// \return Number of chunks.
+      public: std::size_t ChunkCount() const;
+
+      /// \brief Check whether a pointer belongs to memory owned by this pool.
+      /// \param[in] _ptr Pointer to check.
+      /// \return True if _ptr points inside one of the pool's chunks.
+      public: bool Owns(const void *_ptr) const;
+
+      /// \brief Reserve a new chunk.
+      private: void AddChunk();
+
+      /// \brief Size of each slot, rounded up to the alignment.
+      private: std::size_t slotSize;
+
+      /// \brief Alignment of each slot.
+      private: std::size_t alignment;
+
+      /// \brief Number of slots per chunk.
+      private: std::size_t chunkCapacity;
+
+      /// \brief All chunks, in allocation order.
+      private: std::vector<unsigned char *> chunks;
+
+      /// \brief Slots that were released and can be reused.
+      private: std::vector<void *> freeSlots;
+
+      /// \brief Index of the next never-used slot in the last chunk.
+      private: std::size_t nextSlot{0};
+
+      /// \brief Number of slots in use.
+      private: std::size_t count{0};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "ComponentPool.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(ComponentPool, SlotSizeAndAlignment)
+{
+  ComponentPool pool(10, 8, 4);
+  EXPECT_EQ(16u, pool.SlotSize());
+  EXPECT_EQ(0u, pool.Count());
+  EXPECT_EQ(0u, pool.ChunkCount());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    void *slot = pool.Allocate();
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(slot) % 8u);
+    EXPECT_TRUE(pool.Owns(slot));
+  }
+  EXPECT_EQ(10u, pool.Count());
+  EXPECT_EQ(3u, pool.ChunkCount());
+
+  int notOwned{0};
+  EXPECT_FALSE(pool.Owns(&notOwned));
+}
+
+/////////////////////////////////////////////////
+TEST(ComponentPool, ContiguousAndReuse)
+{
+  ComponentPool pool(sizeof(double), alignof(double), 8);
+
+  std::vector<void *> slots;
+  for (int i = 0; i < 8; ++i)
+    slots.push_back(pool.Allocate());
+
+  // Slots within a chunk are contiguous
+  for (std::size_t i = 1; i < slots.size(); ++i)
+  {
+    EXPECT_EQ(static_cast<unsigned char *>(slots[i - 1]) + pool.SlotSize(),
+        static_cast<unsigned char *>(slots[i]));
+  }
+  EXPECT_EQ(1u, pool.ChunkCount());
+
+  // Released slots are reused before reserving more memory
+  pool.Release(slots[3]);
+  EXPECT_EQ(7u, pool.Count());
+  EXPECT_EQ(slots[3], pool.Allocate());
+  EXPECT_EQ(1u, pool.ChunkCount());
+  EXPECT_EQ(8u, pool.Count());
+
+  // All slots are unique
+  std::set<void *> unique(slots.begin(), slots.end());
+  unique.insert(pool.Allocate());
+  EXPECT_EQ(9u, unique.size());
+  EXPECT_EQ(2u, pool.ChunkCount());
+
+  // Releasing null is a no-op
+  pool.Release(nullptr);
+  EXPECT_EQ(9u, pool.Count());
+}
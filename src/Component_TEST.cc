@@ -24,10 +24,13 @@
 #include <sdf/Element.hh>
 #include <gz/common/Console.hh>
 #include <gz/math/Inertial.hh>
+#include <gz/math/Pose3.hh>
 
 #include "gz/sim/components/Component.hh"
 #include "gz/sim/components/Serialization.hh"
+#include "gz/sim/components/Factory.hh"
 #include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
 #include "gz/sim/EntityComponentManager.hh"
 
 #include "../test/helpers/EnvTestFixture.hh"
@@ -597,3 +600,94 @@ TEST_F(ComponentTest, Clone)
     EXPECT_NE(&comp, derivedClone);
   }
 }
+
+//////////////////////////////////////////////////
+TEST_F(ComponentTest, BinarySerialization)
+{
+  // Component without data
+  {
+    using Custom = components::Component<components::NoData,
+        class CustomTag>;
+
+    Custom comp;
+    auto size = comp.SerializedSize();
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(1u, *size);
+
+    std::string data(*size, ' ');
+    EXPECT_TRUE(comp.SerializeTo(data.data(), *size));
+    std::ostringstream ostr;
+    comp.Serialize(ostr);
+    EXPECT_EQ(ostr.str(), data);
+    EXPECT_TRUE(comp.DeserializeFrom(data.data(), data.size()));
+  }
+
+  // Components with protobuf messages and strings write the same bytes as
+  // their streams
+  {
+    using Custom = components::Component<msgs::Int32, class CustomTag,
+        serializers::MsgSerializer>;
+
+    msgs::Int32 msg;
+    msg.set_data(42);
+    Custom comp(msg);
+    auto size = comp.SerializedSize();
+    ASSERT_TRUE(size.has_value());
+
+    std::string data(*size, ' ');
+    EXPECT_TRUE(comp.SerializeTo(data.data(), *size));
+    std::ostringstream ostr;
+    comp.Serialize(ostr);
+    EXPECT_EQ(ostr.str(), data);
+
+    Custom other;
+    EXPECT_TRUE(other.DeserializeFrom(data.data(), data.size()));
+    EXPECT_EQ(42, other.Data().data());
+  }
+  {
+    components::Name comp("banana split");
+    auto size = comp.SerializedSize();
+    ASSERT_TRUE(size.has_value());
+
+    std::string data(*size, ' ');
+    EXPECT_TRUE(comp.SerializeTo(data.data(), *size));
+    EXPECT_EQ("banana split", data);
+
+    components::Name other;
+    EXPECT_TRUE(other.DeserializeFrom(data.data(), data.size()));
+    EXPECT_EQ("banana split", other.Data());
+
+    // Type-erased callers go through the data operations of the type
+    auto ops = components::Factory::Instance()->DataOps(
+        components::Name::typeId);
+    ASSERT_NE(nullptr, ops);
+    EXPECT_EQ(size, ops->SerializedSize(&comp));
+    std::string opsData(*size, ' ');
+    EXPECT_TRUE(ops->SerializeTo(&comp, opsData.data(), *size));
+    EXPECT_EQ(data, opsData);
+    components::Name opsOther;
+    EXPECT_TRUE(ops->DeserializeFrom(&opsOther, opsData.data(),
+        opsData.size()));
+    EXPECT_EQ("banana split", opsOther.Data());
+  }
+
+  // Components without a binary serializer use streams
+  {
+    using Custom = components::Component<math::Pose3d, class CustomTag>;
+
+    Custom comp(math::Pose3d(1, 2, 3, 0, 0, 0));
+    EXPECT_FALSE(comp.SerializedSize().has_value());
+    char data{0};
+    EXPECT_FALSE(comp.SerializeTo(&data, 1));
+    EXPECT_FALSE(comp.DeserializeFrom(&data, 1));
+  }
+
+  // Which the data operations of the type report too
+  {
+    auto ops = components::Factory::Instance()->DataOps(
+        components::Pose::typeId);
+    ASSERT_NE(nullptr, ops);
+    components::Pose pose;
+    EXPECT_FALSE(ops->SerializedSize(&pose).has_value());
+  }
+}
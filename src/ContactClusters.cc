@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ContactClusters.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+
+#include <gz/msgs/Utility.hh>
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+std::size_t ContactClusters::CellHash::operator()(const Cell &_cell) const
+{
+  std::size_t hash{0u};
+  for (const auto index : _cell)
+  {
+    hash ^= std::hash<std::int64_t>()(index) + 0x9e3779b9u + (hash << 6) +
+        (hash >> 2);
+  }
+  return hash;
+}
+
+//////////////////////////////////////////////////
+ContactClusters::ContactClusters(double _cellSize, std::size_t _maxPoints)
+  : cellSize(_cellSize > 0.0 ? _cellSize : 0.05), maxPoints(_maxPoints)
+{
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::SetCellSize(double _cellSize)
+{
+  if (_cellSize <= 0.0)
+    return;
+  this->cellSize = _cellSize;
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+double ContactClusters::CellSize() const
+{
+  return this->cellSize;
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::SetMaxPoints(std::size_t _maxPoints)
+{
+  this->maxPoints = _maxPoints;
+}
+
+//////////////////////////////////////////////////
+std::size_t ContactClusters::MaxPoints() const
+{
+  return this->maxPoints;
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::Add(const math::Vector3d &_position)
+{
+  if (!_position.IsFinite())
+    return;
+
+  const Cell cell{
+      static_cast<std::int64_t>(std::floor(_position.X() / this->cellSize)),
+      static_cast<std::int64_t>(std::floor(_position.Y() / this->cellSize)),
+      static_cast<std::int64_t>(std::floor(_position.Z() / this->cellSize))};
+  auto &cluster = this->clusters[cell];
+  cluster.sum += _position;
+  ++cluster.count;
+  ++this->contactCount;
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::Add(const components::ContactBufferData &_contacts)
+{
+  for (const auto &position : _contacts.positions)
+    this->Add(position);
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::Add(const msgs::Contacts &_contacts)
+{
+  for (const auto &contact : _contacts.contact())
+  {
+    for (const auto &position : contact.position())
+      this->Add(msgs::Convert(position));
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t ContactClusters::ContactCount() const
+{
+  return this->contactCount;
+}
+
+//////////////////////////////////////////////////
+std::size_t ContactClusters::ClusterCount() const
+{
+  return this->clusters.size();
+}
+
+//////////////////////////////////////////////////
+std::vector<math::Vector3d> ContactClusters::Points() const
+{
+  std::vector<std::pair<const Cell *, const Cluster *>> sorted;
+  sorted.reserve(this->clusters.size());
+  for (const auto &[cell, cluster] : this->clusters)
+    sorted.emplace_back(&cell, &cluster);
+
+  // Sorted by cell among equal counts, so the result doesn't depend on the
+  // order of the hash map
+  auto compare = [](const std::pair<const Cell *, const Cluster *> &_a,
+      const std::pair<const Cell *, const Cluster *> &_b)
+  {
+    if (_a.second->count != _b.second->count)
+      return _a.second->count > _b.second->count;
+    return *_a.first < *_b.first;
+  };
+
+  std::size_t count = sorted.size();
+  if (this->maxPoints > 0u && count > this->maxPoints)
+  {
+    count = this->maxPoints;
+    std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+        compare);
+  }
+  else
+  {
+    std::sort(sorted.begin(), sorted.end(), compare);
+  }
+
+  std::vector<math::Vector3d> points;
+  points.reserve(count);
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    points.push_back(sorted[i].second->sum /
+        static_cast<double>(sorted[i].second->count));
+  }
+  return points;
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::AppendTo(msgs::Contact &_msg) const
+{
+  for (const auto &point : this->Points())
+    msgs::Set(_msg.add_position(), point);
+}
+
+//////////////////////////////////////////////////
+void ContactClusters::Clear()
+{
+  this->clusters.clear();
+  this->contactCount = 0u;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_CONTACTCLUSTERS_HH_
+#define GZ_SIM_CONTACTCLUSTERS_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/msgs/contact.pb.h>
+#include <gz/msgs/contacts.pb.h>
+
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/components/ContactBuffer.hh>
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class ContactClusters ContactClusters.hh
+    /// \brief Decimates contact points for visualization. Points are merged
+    /// into the cubic cell of a grid they fall in, and each cell is
+    /// represented by the centroid of its points. When there are more cells
+    /// than allowed, the ones with the most points are kept.
+    ///
+    /// Adding a point is a hash map update, so thousands of contacts can be
+    /// summarized every update.
+    class GZ_SIM_VISIBLE ContactClusters
+    {
+      /// \brief Constructor.
+      /// \param[in] _cellSize Size of the cells points are merged in, in
+      /// meters.
+      /// \param[in] _maxPoints Maximum number of points returned by Points,
+      /// or 0 for no limit.
+      public: explicit ContactClusters(double _cellSize = 0.05,
+                  std::size_t _maxPoints = 0u);
+
+      /// \brief Set the size of the cells. This removes all points.
+      /// \param[in] _cellSize Size in meters. Sizes that aren't positive
+      /// are ignored.
+      public: void SetCellSize(double _cellSize);
+
+      /// \brief Get the size of the cells.
+      /// \return Size in meters.
+      public: double CellSize() const;
+
+      /// \brief Set the maximum number of points returned by Points.
+      /// \param[in] _maxPoints Maximum number of points, or 0 for no limit.
+      public: void SetMaxPoints(std::size_t _maxPoints);
+
+      /// \brief Get the maximum number of points returned by Points.
+      /// \return Maximum number of points, or 0 for no limit.
+      public: std::size_t MaxPoints() const;
+
+      /// \brief Add a contact point. Points that aren't finite are ignored.
+      /// \param[in] _position Position of the contact.
+      public: void Add(const math::Vector3d &_position);
+
+      /// \brief Add the contact points of a collision.
+      /// \param[in] _contacts Contacts filled by the physics system.
+      public: void Add(const components::ContactBufferData &_contacts);
+
+      /// \brief Add the contact points of a message.
+      /// \param[in] _contacts Contacts message.
+      public: void Add(const msgs::Contacts &_contacts);
+
+      /// \brief Get the number of points added since the last Clear.
+      /// \return Number of points.
+      public: std::size_t ContactCount() const;
+
+      /// \brief Get the number of cells holding points.
+      /// \return Number of cells.
+      public: std::size_t ClusterCount() const;
+
+      /// \brief Get the centroid of the points of each cell, at most
+      /// MaxPoints of them, the cells with the most points first.
+      /// \return Cluster positions.
+      public: std::vector<math::Vector3d> Points() const;
+
+      /// \brief Append the cluster positions to a contact message.
+      /// \param[out] _msg Message whose positions are appended to.
+      public: void AppendTo(msgs::Contact &_msg) const;
+
+      /// \brief Remove all points.
+      public: void Clear();
+
+      /// \brief Index of a cell along each axis.
+      private: using Cell = std::array<std::int64_t, 3>;
+
+      /// \brief Hash of a cell.
+      private: struct CellHash
+      {
+        /// \brief Hash a cell.
+        /// \param[in] _cell Cell to hash.
+        /// \return Hash value.
+        std::size_t operator()(const Cell &_cell) const;
+      };
+
+      /// \brief Points merged into a cell.
+      private: struct Cluster
+      {
+        /// \brief Sum of the positions of the points.
+        math::Vector3d sum;
+
+        /// \brief Number of points.
+        std::size_t count{0u};
+      };
+
+      /// \brief Size of the cells in meters.
+      private: double cellSize;
+
+      /// \brief Maximum number of points returned by Points.
+      private: std::size_t maxPoints;
+
+      /// \brief Number of points added.
+      private: std::size_t contactCount{0u};
+
+      /// \brief Clusters of the cells holding points.
+      private: std::unordered_map<Cell, Cluster, CellHash> clusters;
+    };
+    }
+  }
+}
+#endif
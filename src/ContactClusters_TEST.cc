@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gz/msgs/Utility.hh>
+
+#include "ContactClusters.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(ContactClusters, MergeInCells)
+{
+  ContactClusters clusters(1.0);
+  EXPECT_TRUE(clusters.Points().empty());
+
+  clusters.Add(math::Vector3d(0.2, 0.2, 0.2));
+  clusters.Add(math::Vector3d(0.4, 0.6, 0.8));
+  clusters.Add(math::Vector3d(-0.5, 0.5, 0.5));
+  clusters.Add(math::Vector3d(NAN, 0.0, 0.0));
+  EXPECT_EQ(3u, clusters.ContactCount());
+  EXPECT_EQ(2u, clusters.ClusterCount());
+
+  // Centroids, most populated first
+  auto points = clusters.Points();
+  ASSERT_EQ(2u, points.size());
+  EXPECT_EQ(math::Vector3d(0.3, 0.4, 0.5), points[0]);
+  EXPECT_EQ(math::Vector3d(-0.5, 0.5, 0.5), points[1]);
+
+  components::ContactBufferData buffer;
+  buffer.positions.push_back(math::Vector3d(-0.5, 0.5, 0.5));
+  buffer.positions.push_back(math::Vector3d(-0.5, 0.5, 0.5));
+  clusters.Add(buffer);
+  points = clusters.Points();
+  ASSERT_EQ(2u, points.size());
+  EXPECT_EQ(math::Vector3d(-0.5, 0.5, 0.5), points[0]);
+
+  // Changing the cell size starts over
+  clusters.SetCellSize(0.1);
+  EXPECT_DOUBLE_EQ(0.1, clusters.CellSize());
+  EXPECT_EQ(0u, clusters.ContactCount());
+  clusters.SetCellSize(-1.0);
+  EXPECT_DOUBLE_EQ(0.1, clusters.CellSize());
+}
+
+/////////////////////////////////////////////////
+TEST(ContactClusters, MaxPoints)
+{
+  ContactClusters clusters(1.0, 2u);
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j <= i; ++j)
+      clusters.Add(math::Vector3d(i + 0.5, 0.5, 0.5));
+  }
+  EXPECT_EQ(10u, clusters.ClusterCount());
+
+  auto points = clusters.Points();
+  ASSERT_EQ(2u, points.size());
+  EXPECT_EQ(math::Vector3d(9.5, 0.5, 0.5), points[0]);
+  EXPECT_EQ(math::Vector3d(8.5, 0.5, 0.5), points[1]);
+
+  msgs::Contacts contacts;
+  msgs::Set(contacts.add_contact()->add_position(),
+      math::Vector3d(20.5, 0.5, 0.5));
+  clusters.Add(contacts);
+  EXPECT_EQ(11u, clusters.ClusterCount());
+
+  clusters.SetMaxPoints(0u);
+  msgs::Contact msg;
+  clusters.AppendTo(msg);
+  EXPECT_EQ(11, msg.position_size());
+
+  clusters.Clear();
+  EXPECT_EQ(0u, clusters.ClusterCount());
+}
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "DeferredIncludes.hh"
+
+#include <tinyxml2.h>
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <sdf/Element.hh>
+#include <sdf/parser.hh>
+#include <sdf/SDFImpl.hh>
+#include <sdf/World.hh>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/common/StringUtils.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Private data for the DeferredIncludes class.
+class gz::sim::DeferredIncludesPrivate
+{
+  /// \brief Parser configuration used to load the includes.
+  public: sdf::ParserConfig config;
+
+  /// \brief SDF version of the world file.
+  public: std::string version;
+
+  /// \brief Name of the world.
+  public: std::string worldName;
+
+  /// \brief XML of each deferred include, by model name.
+  public: std::map<std::string, std::string> includes;
+
+  /// \brief DOM of each parsed model, by model name.
+  public: std::map<std::string, std::unique_ptr<sdf::Root>> roots;
+
+  /// \brief Protects roots, since models may be parsed in the background.
+  public: mutable std::mutex mutex;
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the trimmed text of an XML element.
+/// \param[in] _elem Element, possibly nullptr.
+/// \return The text, or an empty string.
+static std::string elementText(const tinyxml2::XMLElement *_elem)
+{
+  if (nullptr == _elem || nullptr == _elem->GetText())
+    return std::string();
+  return common::trimmed(_elem->GetText());
+}
+
+//////////////////////////////////////////////////
+/// \brief Set the file path of an SDF element and its descendants, except
+/// for the ones which come from other files, such as included models.
+/// \param[in] _elem SDF element.
+/// \param[in] _filePath Path of the file.
+static void setFilePath(const sdf::ElementPtr &_elem,
+    const std::string &_filePath)
+{
+  if (!common::isFile(_elem->FilePath()))
+    _elem->SetFilePath(_filePath);
+
+  for (auto child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    setFilePath(child, _filePath);
+  }
+}
+
+//////////////////////////////////////////////////
+DeferredIncludes::DeferredIncludes(const sdf::ParserConfig &_config)
+  : dataPtr(std::make_unique<DeferredIncludesPrivate>())
+{
+  this->dataPtr->config = _config;
+}
+
+//////////////////////////////////////////////////
+DeferredIncludes::~DeferredIncludes() = default;
+
+//////////////////////////////////////////////////
+std::string DeferredIncludes::Extract(const std::string &_sdf,
+    const std::string &_worldDir)
+{
+  GZ_PROFILE("DeferredIncludes::Extract");
+
+  // Invalid documents are reported when they're loaded
+  tinyxml2::XMLDocument doc;
+  if (doc.Parse(_sdf.c_str()) != tinyxml2::XML_SUCCESS ||
+      nullptr == doc.RootElement() ||
+      std::string(doc.RootElement()->Name()) != "sdf")
+  {
+    return _sdf;
+  }
+
+  auto world = doc.RootElement()->FirstChildElement("world");
+  if (nullptr == world || nullptr != world->NextSiblingElement("world"))
+    return _sdf;
+
+  // Entities referenced by levels, and performers, which are always loaded
+  std::set<std::string> levelRefs;
+  std::set<std::string> performerRefs;
+  for (auto plugin = world->FirstChildElement("plugin"); plugin;
+       plugin = plugin->NextSiblingElement("plugin"))
+  {
+    for (auto level = plugin->FirstChildElement("level"); level;
+         level = level->NextSiblingElement("level"))
+    {
+      for (auto ref = level->FirstChildElement("ref"); ref;
+           ref = ref->NextSiblingElement("ref"))
+      {
+        levelRefs.insert(elementText(ref));
+      }
+    }
+    for (auto performer = plugin->FirstChildElement("performer"); performer;
+         performer = performer->NextSiblingElement("performer"))
+    {
+      performerRefs.insert(elementText(performer->FirstChildElement("ref")));
+    }
+  }
+
+  std::vector<tinyxml2::XMLElement *> deferred;
+  for (auto include = world->FirstChildElement("include"); include;
+       include = include->NextSiblingElement("include"))
+  {
+    // The world is loaded from a string, so relative URIs can't be resolved
+    // against its file anymore
+    auto uriElem = include->FirstChildElement("uri");
+    const auto uri = elementText(uriElem);
+    if (!uri.empty() && uri.find("://") == std::string::npos &&
+        std::filesystem::path(uri).is_relative())
+    {
+      uriElem->SetText(common::joinPaths(_worldDir, uri).c_str());
+    }
+
+    const auto name = elementText(include->FirstChildElement("name"));
+    if (!name.empty() && levelRefs.count(name) > 0 &&
+        performerRefs.count(name) == 0 &&
+        this->dataPtr->includes.count(name) == 0)
+    {
+      deferred.push_back(include);
+    }
+  }
+
+  if (deferred.empty())
+    return _sdf;
+
+  const char *version = doc.RootElement()->Attribute("version");
+  const char *worldName = world->Attribute("name");
+  this->dataPtr->version = nullptr == version ? "" : version;
+  this->dataPtr->worldName = nullptr == worldName ? "" : worldName;
+
+  for (auto include : deferred)
+  {
+    tinyxml2::XMLPrinter printer;
+    include->Accept(&printer);
+    this->dataPtr->includes[elementText(include->FirstChildElement("name"))] =
+        printer.CStr();
+    world->DeleteChild(include);
+  }
+
+  gzmsg << "Deferred loading [" << deferred.size() << "] included models "
+        << "until their levels are active.\n";
+
+  tinyxml2::XMLPrinter printer;
+  doc.Print(&printer);
+  return printer.CStr();
+}
+
+//////////////////////////////////////////////////
+std::set<std::string> DeferredIncludes::Names() const
+{
+  std::set<std::string> names;
+  for (const auto &include : this->dataPtr->includes)
+    names.insert(include.first);
+  return names;
+}
+
+//////////////////////////////////////////////////
+bool DeferredIncludes::Has(const std::string &_name) const
+{
+  return this->dataPtr->includes.find(_name) != this->dataPtr->includes.end();
+}
+
+//////////////////////////////////////////////////
+const sdf::Model *DeferredIncludes::Load(const std::string &_name)
+{
+  GZ_PROFILE("DeferredIncludes::Load");
+
+  auto includeIt = this->dataPtr->includes.find(_name);
+  if (includeIt == this->dataPtr->includes.end())
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &root = this->dataPtr->roots[_name];
+  if (nullptr == root)
+  {
+    root = std::make_unique<sdf::Root>();
+    const std::string sdf = "<?xml version='1.0'?><sdf version='" +
+        this->dataPtr->version + "'><world name='" +
+        this->dataPtr->worldName + "'>" + includeIt->second +
+        "</world></sdf>";
+    auto errors = root->LoadSdfString(sdf, this->dataPtr->config);
+    root->ResolveAutoInertials(errors, this->dataPtr->config);
+    for (const auto &error : errors)
+      gzerr << error << "\n";
+  }
+
+  const auto world = root->WorldByIndex(0);
+  const auto model = nullptr == world ? nullptr : world->ModelByName(_name);
+  if (nullptr == model)
+  {
+    gzerr << "Failed to load deferred model [" << _name << "]."
+          << std::endl;
+  }
+  return model;
+}
+
+//////////////////////////////////////////////////
+void DeferredIncludes::Release(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->roots.erase(_name);
+}
+
+//////////////////////////////////////////////////
+std::size_t DeferredIncludes::LoadedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->roots.size();
+}
+
+//////////////////////////////////////////////////
+sdf::Errors DeferredIncludes::LoadFileString(sdf::Root &_root,
+    const std::string &_sdf, const std::string &_filePath,
+    const sdf::ParserConfig &_config)
+{
+  sdf::Errors errors;
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  if (!sdf::readString(_sdf, _config, sdfParsed, errors))
+  {
+    if (errors.empty())
+    {
+      errors.push_back({sdf::ErrorCode::STRING_READ,
+          "Unable to read SDF of file [" + _filePath + "]."});
+    }
+    return errors;
+  }
+
+  // Paths in the world, such as the ones of meshes, are relative to its file
+  sdfParsed->SetFilePath(_filePath);
+  setFilePath(sdfParsed->Root(), _filePath);
+
+  auto loadErrors = _root.Load(sdfParsed, _config);
+  errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
+  return errors;
+}
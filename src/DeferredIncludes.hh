@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_DEFERREDINCLUDES_HH_
+#define GZ_SIM_DEFERREDINCLUDES_HH_
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <sdf/Error.hh>
+#include <sdf/Model.hh>
+#include <sdf/ParserConfig.hh>
+#include <sdf/Root.hh>
+
+#include <gz/sim/Export.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class DeferredIncludesPrivate;
+
+    /// \class DeferredIncludes DeferredIncludes.hh
+    /// \brief Top-level includes of a world file which are parsed only when
+    /// the level holding them becomes active.
+    ///
+    /// libsdformat builds the DOM of a whole world, with all of its included
+    /// models, before any entity is created. Worlds made of thousands of
+    /// tiles, each one referenced by a level, don't need most of them at
+    /// once. The includes named by a level's `<ref>` are taken out of the
+    /// world before it's loaded, and each one is parsed into a DOM of its
+    /// own when its level is activated. The DOM is released once its
+    /// entities are created, since they keep copies of what they need.
+    ///
+    /// Includes without a `<name>`, and the ones of performers, are loaded
+    /// with the world.
+    class GZ_SIM_VISIBLE DeferredIncludes
+    {
+      /// \brief Constructor
+      /// \param[in] _config Parser configuration used to load the includes.
+      public: explicit DeferredIncludes(const sdf::ParserConfig &_config);
+
+      /// \brief Destructor
+      public: ~DeferredIncludes();
+
+      /// \brief Take the includes referenced by levels out of a world.
+      /// Relative URIs of the remaining top-level includes are made
+      /// absolute, so the world can be loaded from a string.
+      /// \param[in] _sdf SDF of a file holding a single world.
+      /// \param[in] _worldDir Directory of the world file.
+      /// \return SDF of the world without the deferred includes, or _sdf if
+      /// nothing was deferred.
+      public: std::string Extract(const std::string &_sdf,
+                  const std::string &_worldDir);
+
+      /// \brief Get the names of the deferred models.
+      /// \return Names of the models.
+      public: std::set<std::string> Names() const;
+
+      /// \brief Get whether a model is deferred.
+      /// \param[in] _name Name of the model.
+      /// \return True if it's deferred.
+      public: bool Has(const std::string &_name) const;
+
+      /// \brief Parse a deferred model, unless it's already parsed. This may
+      /// be called from a background thread.
+      /// \param[in] _name Name of the model.
+      /// \return The model, valid until Release is called, or nullptr if it
+      /// isn't deferred or fails to load.
+      public: const sdf::Model *Load(const std::string &_name);
+
+      /// \brief Drop the DOM of a parsed model.
+      /// \param[in] _name Name of the model.
+      public: void Release(const std::string &_name);
+
+      /// \brief Get the number of models whose DOM is held.
+      /// \return Number of parsed models.
+      public: std::size_t LoadedCount() const;
+
+      /// \brief Load a root from the SDF of a file which was modified, so
+      /// that its elements keep the path of the file.
+      /// \param[out] _root Root to load.
+      /// \param[in] _sdf SDF string.
+      /// \param[in] _filePath Path of the file _sdf comes from.
+      /// \param[in] _config Parser configuration.
+      /// \return Errors found while loading.
+      public: static sdf::Errors LoadFileString(sdf::Root &_root,
+                  const std::string &_sdf, const std::string &_filePath,
+                  const sdf::ParserConfig &_config);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<DeferredIncludesPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
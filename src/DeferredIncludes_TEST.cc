@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <set>
+#include <string>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/math/Pose3.hh>
+
+#include "DeferredIncludes.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Model included by the tiles of the world.
+static const char kTile[] = R"(<?xml version="1.0" ?>
+<sdf version="1.6">
+  <model name="tile">
+    <static>true</static>
+    <link name="link"/>
+  </model>
+</sdf>)";
+
+/// \brief World with two tiles in a level, a performer and a tile which
+/// isn't in any level.
+static const char kWorld[] = R"(<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="tiled">
+    <include>
+      <name>tile_0</name>
+      <uri>tile.sdf</uri>
+    </include>
+    <include>
+      <name>tile_1</name>
+      <uri>tile.sdf</uri>
+      <pose>10 0 0 0 0 0</pose>
+    </include>
+    <include>
+      <name>tile_2</name>
+      <uri>tile.sdf</uri>
+    </include>
+    <include>
+      <name>robot</name>
+      <uri>tile.sdf</uri>
+    </include>
+    <plugin name="gz::sim" filename="dummy">
+      <performer name="perf">
+        <ref>robot</ref>
+        <geometry><box><size>1 1 1</size></box></geometry>
+      </performer>
+      <level name="level0">
+        <ref>tile_0</ref>
+        <ref>tile_1</ref>
+        <ref>robot</ref>
+        <geometry><box><size>20 20 20</size></box></geometry>
+      </level>
+    </plugin>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream file(_path);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(DeferredIncludes, Extract)
+{
+  common::TempDirectory tempDir("deferred_includes", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  writeFile(common::joinPaths(tempDir.Path(), "tile.sdf"), kTile);
+  const auto worldFile = common::joinPaths(tempDir.Path(), "world.sdf");
+
+  DeferredIncludes deferred{sdf::ParserConfig()};
+  const auto world = deferred.Extract(kWorld, tempDir.Path());
+
+  // Performers are always loaded, and the other tile isn't in a level
+  EXPECT_EQ(std::set<std::string>({"tile_0", "tile_1"}), deferred.Names());
+  EXPECT_TRUE(deferred.Has("tile_0"));
+  EXPECT_FALSE(deferred.Has("tile_2"));
+  EXPECT_FALSE(deferred.Has("robot"));
+
+  // The world has the remaining models, found through their absolute URIs
+  sdf::Root root;
+  EXPECT_TRUE(DeferredIncludes::LoadFileString(root, world, worldFile,
+      sdf::ParserConfig()).empty());
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  EXPECT_EQ(2u, root.WorldByIndex(0)->ModelCount());
+  EXPECT_FALSE(root.WorldByIndex(0)->ModelNameExists("tile_0"));
+  EXPECT_TRUE(root.WorldByIndex(0)->ModelNameExists("tile_2"));
+  EXPECT_TRUE(root.WorldByIndex(0)->ModelNameExists("robot"));
+  EXPECT_EQ(worldFile, root.WorldByIndex(0)->Element()->FilePath());
+
+  // Deferred models are parsed on demand, until they're released
+  EXPECT_EQ(0u, deferred.LoadedCount());
+  auto tile = deferred.Load("tile_1");
+  ASSERT_NE(nullptr, tile);
+  EXPECT_EQ("tile_1", tile->Name());
+  EXPECT_EQ(math::Pose3d(10, 0, 0, 0, 0, 0), tile->RawPose());
+  EXPECT_EQ(tile, deferred.Load("tile_1"));
+  EXPECT_EQ(1u, deferred.LoadedCount());
+
+  deferred.Release("tile_1");
+  EXPECT_EQ(0u, deferred.LoadedCount());
+  EXPECT_EQ(nullptr, deferred.Load("tile_2"));
+}
+
+/////////////////////////////////////////////////
+TEST(DeferredIncludes, NothingDeferred)
+{
+  const std::string world = R"(<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="default">
+    <include>
+      <uri>model://unnamed</uri>
+    </include>
+  </world>
+</sdf>)";
+
+  // Includes without a name aren't known to be in a level
+  DeferredIncludes deferred{sdf::ParserConfig()};
+  EXPECT_EQ(world, deferred.Extract(world, "/tmp"));
+  EXPECT_TRUE(deferred.Names().empty());
+
+  // Invalid documents are left as they are
+  EXPECT_EQ("<sdf", deferred.Extract("<sdf", "/tmp"));
+}
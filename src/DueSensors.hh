@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_DUESENSORS_HH_
+#define GZ_SIM_DUESENSORS_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+
+#include "ThreadPool.hh"
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class DueSensors DueSensors.hh
+    /// \brief Sensors of one type that need new data at the current step.
+    ///
+    /// Non-rendering sensor systems use it in PostUpdate to skip the
+    /// sensors that aren't due or have no subscribers, and to set the data
+    /// of the remaining ones and update them concurrently on the shared
+    /// ThreadPool. Sensor systems already run their PostUpdate in parallel,
+    /// so the work of all sensor types shares the same threads.
+    /// \tparam SensorT Type of the gz-sensors sensor.
+    template <typename SensorT>
+    class DueSensors
+    {
+      /// \brief Find the sensors that are due.
+      /// \param[in] _sensors Map of entity to sensor pointer.
+      /// \param[in] _simTime Current simulation time.
+      /// \param[in] _hasConnections Optional function telling whether a
+      /// sensor has subscribers other than those of its own topic.
+      /// \return True if at least one sensor is due.
+      public: template <typename MapT>
+              bool Gather(const MapT &_sensors,
+                  const std::chrono::steady_clock::duration &_simTime,
+                  const std::function<bool(Entity)> &_hasConnections =
+                      nullptr)
+      {
+        this->sensors.clear();
+        for (const auto &[entity, sensor] : _sensors)
+        {
+          if (sensor->NextDataUpdateTime() <= _simTime &&
+              (sensor->HasConnections() ||
+              (_hasConnections && _hasConnections(entity))))
+          {
+            this->sensors.emplace_back(entity, sensor.get());
+          }
+        }
+        return !this->sensors.empty();
+      }
+
+      /// \brief Get the number of sensors found by the last call to Gather.
+      /// \return Number of due sensors.
+      public: std::size_t Size() const
+      {
+        return this->sensors.size();
+      }
+
+      /// \brief Set the data of the due sensors and update them, which
+      /// publishes their measurements. Sensors are processed concurrently.
+      /// \param[in] _simTime Current simulation time.
+      /// \param[in] _setData Function that sets the data of a sensor before
+      /// it's updated. It may be called concurrently for different sensors,
+      /// so it must only read shared state.
+      /// \param[in] _updated Optional function called after a sensor
+      /// generated new data, with the same constraints as _setData.
+      public: void Update(const std::chrono::steady_clock::duration &_simTime,
+                  const std::function<void(Entity, SensorT &)> &_setData,
+                  const std::function<void(Entity, SensorT &)> &_updated =
+                      nullptr)
+      {
+        auto &pool = ThreadPool::Shared();
+        // Keep enough chunks to balance the threads, but don't split a
+        // handful of sensors
+        pool.ParallelFor(this->sensors.size(),
+            pool.GrainSize(this->sensors.size(), kMinGrainSize),
+            [&](std::size_t _begin, std::size_t _end)
+            {
+              for (std::size_t i = _begin; i < _end; ++i)
+              {
+                auto &[entity, sensor] = this->sensors[i];
+                _setData(entity, *sensor);
+                // Call the base class update, which keeps track of the
+                // update rate. Some sensors hide it with their own overload.
+                const bool updated =
+                    static_cast<typename SensorT::Sensor &>(*sensor).Update(
+                        _simTime, false);
+                if (updated && _updated)
+                  _updated(entity, *sensor);
+              }
+            });
+      }
+
+      /// \brief Minimum number of sensors updated by a thread.
+      private: static constexpr std::size_t kMinGrainSize{8u};
+
+      /// \brief Due sensors and their entities.
+      private: std::vector<std::pair<Entity, SensorT *>> sensors;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+
+#include "DueSensors.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/// \brief Base of the test sensor, named like the gz-sensors base class.
+class Sensor
+{
+  public: bool Update(const std::chrono::steady_clock::duration &_now,
+              bool)
+  {
+    this->updateTime = _now;
+    this->next = _now + 10ms;
+    return true;
+  }
+
+  public: std::chrono::steady_clock::duration NextDataUpdateTime() const
+  {
+    return this->next;
+  }
+
+  public: std::chrono::steady_clock::duration next{0};
+  public: std::chrono::steady_clock::duration updateTime{-1};
+};
+
+/// \brief Test sensor, which hides the base class update.
+class TestSensor : public Sensor
+{
+  public: bool Update(const std::chrono::steady_clock::duration &)
+  {
+    return false;
+  }
+
+  public: bool HasConnections() const
+  {
+    return this->connections;
+  }
+
+  public: bool connections{true};
+  public: double data{0.0};
+};
+
+/////////////////////////////////////////////////
+TEST(DueSensors, GatherAndUpdate)
+{
+  std::map<Entity, std::unique_ptr<TestSensor>> sensors;
+  for (Entity entity = 1; entity <= 100; ++entity)
+    sensors[entity] = std::make_unique<TestSensor>();
+  sensors[2]->connections = false;
+  sensors[3]->next = 1s;
+
+  DueSensors<TestSensor> due;
+  ASSERT_TRUE(due.Gather(sensors, 0s));
+  EXPECT_EQ(98u, due.Size());
+
+  due.Update(0s, [](Entity _entity, TestSensor &_sensor)
+  {
+    _sensor.data = static_cast<double>(_entity);
+  });
+  for (const auto &[entity, sensor] : sensors)
+  {
+    if (entity == 2 || entity == 3)
+    {
+      EXPECT_DOUBLE_EQ(0.0, sensor->data);
+      EXPECT_EQ(-1, sensor->updateTime.count());
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(static_cast<double>(entity), sensor->data);
+      EXPECT_EQ(0s, sensor->updateTime);
+    }
+  }
+
+  // Not due until their next update time
+  EXPECT_FALSE(due.Gather(sensors, 5ms));
+  EXPECT_EQ(0u, due.Size());
+  EXPECT_TRUE(due.Gather(sensors, 10ms));
+  EXPECT_EQ(98u, due.Size());
+}
@@ -17,10 +17,23 @@
 
 #include "gz/sim/EntityComponentManager.hh"
 #include "EntityComponentManagerDiff.hh"
-
+#include "ComponentPool.hh"
+#include "EntityHierarchy.hh"
+#include "EntityIndexAllocator.hh"
+#include "StateSnapshot.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -29,23 +42,286 @@
 #include <vector>
 
 #include <gz/common/Profiler.hh>
-#include <gz/math/graph/GraphAlgorithms.hh>
 
+#include "gz/sim/components/AngularVelocity.hh"
 #include "gz/sim/components/CanonicalLink.hh"
 #include "gz/sim/components/ChildLinkName.hh"
 #include "gz/sim/components/Component.hh"
 #include "gz/sim/components/Factory.hh"
 #include "gz/sim/components/Joint.hh"
+#include "gz/sim/components/JointForce.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/LinearVelocity.hh"
 #include "gz/sim/components/Link.hh"
+#include "gz/sim/components/Model.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/ParentLinkName.hh"
+#include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Recreate.hh"
 #include "gz/sim/components/World.hh"
 
 using namespace gz;
 using namespace sim;
 
+//////////////////////////////////////////////////
+/// \brief Serialize a component into the bytes of a state message, using
+/// its binary serializer if it has one, and streams otherwise.
+/// \param[in] _comp Component to serialize.
+/// \param[out] _out Serialized component.
+static void SerializeComponent(const components::BaseComponent &_comp,
+    std::string &_out)
+{
+  const auto *ops = components::Factory::Instance()->DataOps(_comp.TypeId());
+  const auto size = nullptr != ops ? ops->SerializedSize(&_comp) :
+      std::nullopt;
+  if (size)
+  {
+    _out.resize(*size);
+    if (ops->SerializeTo(&_comp, _out.data(), *size))
+      return;
+  }
+
+  std::ostringstream ostr;
+  _comp.Serialize(ostr);
+  _out = ostr.str();
+}
+
+//////////////////////////////////////////////////
+/// \brief Deserialize a component from the bytes of a state message, which
+/// may have been written by its binary serializer or by streams.
+/// \param[in,out] _comp Component to update.
+/// \param[in] _in Serialized component.
+static void DeserializeComponent(components::BaseComponent &_comp,
+    const std::string &_in)
+{
+  const auto *ops = components::Factory::Instance()->DataOps(_comp.TypeId());
+  if (nullptr != ops && ops->DeserializeFrom(&_comp, _in.data(), _in.size()))
+    return;
+
+  std::istringstream istr(_in);
+  _comp.Deserialize(istr);
+}
+
+/// \brief Check whether components of a type can be deserialized
+/// concurrently with each other. Only types that hold plain values are
+/// listed, since other serializers may use shared state, such as the SDF
+/// parser or message descriptors, that isn't thread safe.
+/// \param[in] _typeId Type of the components.
+/// \return True if they can be deserialized concurrently.
+static bool ConcurrentlyDeserializable(const ComponentTypeId _typeId)
+{
+  static const std::unordered_set<ComponentTypeId> kTypes{
+      components::Pose::typeId,
+      components::WorldPose::typeId,
+      components::LinearVelocity::typeId,
+      components::WorldLinearVelocity::typeId,
+      components::AngularVelocity::typeId,
+      components::WorldAngularVelocity::typeId,
+      components::JointPosition::typeId,
+      components::JointVelocity::typeId,
+      components::JointForce::typeId,
+      components::Name::typeId,
+      components::ParentEntity::typeId};
+  return kTypes.find(_typeId) != kTypes.end();
+}
+
+/// \brief Number of component type lists whose views can be cached in each
+/// ECM. Views of the type lists past it are looked up by key every time.
+constexpr std::size_t kViewCacheSlots{512};
+
+/// \brief Number of removals kept to answer ChangesSince. Consumers that
+/// look less often than this many removals take the full state instead.
+constexpr std::size_t kRemovalHistorySize{4096};
+
+/// \brief Number of bits tracking the component types that may have been
+/// written through pointers. Types share a bit if their IDs collide, which
+/// only makes resets compare more components.
+constexpr std::size_t kWrittenTypeBits{1024};
+
+//////////////////////////////////////////////////
+/// \brief Get an ID that no other history of a manager has.
+/// \return The ID, starting at 1.
+static std::uint64_t NextHistoryId()
+{
+  static std::atomic<std::uint64_t> lastId{0};
+  return ++lastId;
+}
+
+/// \brief Removal of an entity or of one of its components.
+struct RemovalRecord
+{
+  /// \brief Version stamp of the removal.
+  std::uint64_t version;
+
+  /// \brief The entity.
+  Entity entity;
+
+  /// \brief Type of the removed component, or kComponentTypeIdInvalid if
+  /// the whole entity was removed.
+  ComponentTypeId typeId;
+};
+
+/// \brief Hash of a parent entity and a name.
+struct ParentNameHash
+{
+  /// \brief Hash a key.
+  /// \param[in] _key Parent and name.
+  /// \return The hash.
+  std::size_t operator()(const std::pair<Entity, std::string> &_key) const
+  {
+    return std::hash<std::string>()(_key.second) ^
+        (std::hash<Entity>()(_key.first) * 0x9e3779b97f4a7c15ull);
+  }
+};
+
+/// \brief Entities indexed by name, and by parent and name.
+struct NameIndex
+{
+  /// \brief Entities with each name.
+  std::unordered_map<std::string, std::set<Entity>> byName;
+
+  /// \brief Entities with each parent and name.
+  std::unordered_map<std::pair<Entity, std::string>, std::set<Entity>,
+      ParentNameHash> byParentName;
+
+  /// \brief Parent and name each entity is indexed under.
+  std::unordered_map<Entity, std::pair<Entity, std::string>> keys;
+
+  /// \brief Entities whose name or parent may have changed since they
+  /// were indexed.
+  std::vector<Entity> dirty;
+
+  /// \brief Whether the index was built. It's built the first time it's
+  /// used, so managers that are never searched by name don't pay for it.
+  bool built{false};
+
+  /// \brief Value of namePointerWrites when the index was built.
+  std::uint64_t pointerWrites{0};
+};
+
+/// \brief View cached for a list of component types.
+struct CachedViewEntry
+{
+  /// \brief The view, or nullptr if not cached yet.
+  std::atomic<detail::BaseView *> view{nullptr};
+
+  /// \brief The mutex of the view.
+  std::atomic<std::mutex *> mutex{nullptr};
+};
+
+/// \brief Reference held by an entity to a component shared among entities.
+struct InternedReference
+{
+  /// \brief The shared instance.
+  std::shared_ptr<components::BaseComponent> component;
+
+  /// \brief Number of storage entries holding an instance of the type.
+  std::atomic<std::size_t> *count;
+};
+
+/// \brief Deleter for components held in the component storage. Components
+/// allocated on the heap are deleted, while components living in a
+/// ComponentPool are destroyed in place and their slot is returned to the pool.
+struct ComponentDeleter
+{
+  /// \brief Default constructor, used for heap allocated components.
+  ComponentDeleter() = default;
+
+  /// \brief Implicit conversion from the default deleter, so that components
+  /// created by the factory can be moved into the storage.
+  // cppcheck-suppress noExplicitConstructor
+  ComponentDeleter(std::default_delete<components::BaseComponent>) {}
+
+  /// \brief Constructor for components living in a pool.
+  /// \param[in] _pool Pool owning the component's memory.
+  /// \param[in] _slot Slot returned by the pool when allocating.
+  ComponentDeleter(ComponentPool *_pool, void *_slot)
+    : pool(_pool), slot(_slot)
+  {
+  }
+
+  /// \brief Deleter for components owned by another manager, which are
+  /// shared until they're written.
+  /// \return The deleter, which does nothing.
+  static ComponentDeleter Borrowed()
+  {
+    ComponentDeleter deleter;
+    deleter.owned = false;
+    return deleter;
+  }
+
+  /// \brief Deleter for components shared among entities, see
+  /// EntityComponentManager::InternComponents.
+  /// \param[in] _comp The shared instance.
+  /// \param[in] _count Count of the storage entries holding an instance of
+  /// the type, decremented when the entry is destroyed.
+  /// \return The deleter, which releases its reference.
+  static ComponentDeleter Interned(
+      std::shared_ptr<components::BaseComponent> _comp,
+      std::atomic<std::size_t> *_count)
+  {
+    ComponentDeleter deleter;
+    deleter.owned = false;
+    deleter.interned = true;
+    deleter.slot = new InternedReference{std::move(_comp), _count};
+    ++*_count;
+    return deleter;
+  }
+
+  /// \brief Destroy the component.
+  /// \param[in] _comp Component to destroy.
+  void operator()(components::BaseComponent *_comp) const
+  {
+    if (this->interned)
+    {
+      auto reference = static_cast<InternedReference *>(this->slot);
+      --*reference->count;
+      delete reference;
+      return;
+    }
+    if (!this->owned)
+      return;
+    if (nullptr == this->pool)
+    {
+      delete _comp;
+      return;
+    }
+    _comp->~BaseComponent();
+    this->pool->Release(this->slot);
+  }
+
+  /// \brief Pool owning the component's memory, null for heap allocations.
+  ComponentPool *pool{nullptr};
+
+  /// \brief Pool slot holding the component.
+  void *slot{nullptr};
+
+  /// \brief False if the component belongs to another manager.
+  bool owned{true};
+
+  /// \brief True if the component is shared among entities, in which case
+  /// the slot holds an InternedReference.
+  bool interned{false};
+};
+
+/// \brief Instances of a component type shared among entities.
+struct InternedComponents
+{
+  /// \brief Shared instances, keyed by the data they hold. Entries expire
+  /// once no entity holds the instance.
+  std::unordered_map<std::string,
+      std::weak_ptr<components::BaseComponent>> instances;
+
+  /// \brief Number of storage entries holding one of the instances.
+  std::atomic<std::size_t> count{0};
+};
+
+/// \brief Owning pointer to a component in the component storage.
+using ComponentPtr = std::unique_ptr<components::BaseComponent,
+    ComponentDeleter>;
+
 class gz::sim::EntityComponentManagerPrivate
 {
   /// \brief Implementation of the CreateEntity function, which takes a specific
@@ -72,13 +348,24 @@ class gz::sim::EntityComponentManagerPrivate
   /// `AddEntityToMessage`.
   public: void CalculateStateThreadLoad();
 
+  /// \brief Create a copy of a component using the configured storage
+  /// layout.
+  /// \param[in] _typeId Type of the component.
+  /// \param[in] _data Data to copy into the new component.
+  /// \return The new component, or nullptr on failure.
+  public: ComponentPtr NewComponent(const ComponentTypeId _typeId,
+      const components::BaseComponent *_data);
+
   /// \brief Copies the contents of `_from` into this object.
+  /// \param[in] _share True to share the components of `_from` until they're
+  /// written instead of copying them.
   /// \note This is a member function instead of a copy constructor so that
   /// it can have additional parameters if the need arises in the future.
   /// Additionally, not every data member is copied making its behavior
   /// different from what would be expected from a copy constructor.
   /// \param[in] _from Object to copy from
-  public: void CopyFrom(const EntityComponentManagerPrivate &_from);
+  public: void CopyFrom(const EntityComponentManagerPrivate &_from,
+      bool _share = false);
 
   /// \brief Create a message for the removed components
   /// \param[in] _entity Entity with the removed components
@@ -104,6 +391,62 @@ class gz::sim::EntityComponentManagerPrivate
   /// \param[in] _entity Entity that has component newly modified
   public: void AddModifiedComponent(const Entity &_entity);
 
+  /// \brief Give the next version stamp to a component. The caller must
+  /// hold changedComponentsMutex.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Type of the component.
+  public: void StampComponent(const Entity _entity,
+              const ComponentTypeId _typeId);
+
+  /// \brief Record the removal of a component or entity so that it's
+  /// reported by ChangesSince. The caller must hold changedComponentsMutex.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Type of the removed component, or
+  /// kComponentTypeIdInvalid if the whole entity was removed.
+  public: void RecordRemoval(const Entity _entity,
+              const ComponentTypeId _typeId);
+
+  /// \brief Mark the name index entry of an entity as outdated if a
+  /// component that's indexed changed. This is thread safe.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Type of the changed component, or
+  /// kComponentTypeIdInvalid if the whole entity was removed.
+  public: void MarkNameChanged(const Entity _entity,
+              const ComponentTypeId _typeId);
+
+  /// \brief Drop the name index, so it's built again when it's next used.
+  /// This is thread safe.
+  public: void ClearNameIndex();
+
+  /// \brief Bring the name index up to date. The caller must hold
+  /// nameIndexMutex.
+  /// \param[in] _ecm Manager that owns this data.
+  public: void UpdateNameIndex(const EntityComponentManager &_ecm) const;
+
+  /// \brief Record that components of a type may be written through a
+  /// pointer, without being marked as changed. This is thread safe.
+  /// \param[in] _typeId Type of the components.
+  public: void MarkWritten(const ComponentTypeId _typeId);
+
+  /// \brief Check whether components of a type may have been written
+  /// through a pointer.
+  /// \param[in] _typeId Type of the components.
+  /// \return True if they may have been.
+  public: bool Written(const ComponentTypeId _typeId) const;
+
+  /// \brief Get the stamp of the pointer writes, see
+  /// EntityComponentManager::PointerWriteVersion. This is thread safe.
+  /// \return The stamp.
+  public: std::uint64_t PointerWriteVersion() const;
+
+  /// \brief Check whether another manager is an unmodified copy of an
+  /// earlier state of this one, in which case the differences between them
+  /// are the changes recorded by this manager since the copy.
+  /// \param[in] _copy The other manager.
+  /// \return True if it's such a copy.
+  public: bool IsEarlierCopy(const EntityComponentManagerPrivate &_copy)
+              const;
+
   /// \brief Check whether a component is marked as a component that is
   /// currently removed or not.
   /// \param[in] _entity The entity
@@ -113,6 +456,49 @@ class gz::sim::EntityComponentManagerPrivate
   public: bool ComponentMarkedAsRemoved(const Entity _entity,
               const ComponentTypeId _typeId) const;
 
+  /// \brief Check whether a component is marked as having a one-time or
+  /// periodic change.
+  /// \param[in] _entity The entity
+  /// \param[in] _typeId The type ID for the component that belongs to _entity
+  /// \return True if the component changed.
+  public: bool ComponentChanged(const Entity _entity,
+              const ComponentTypeId _typeId) const;
+
+  /// \brief Give an entity its own copy of a component shared by
+  /// InternComponents, because it may be written.
+  /// \param[in] _entity The entity.
+  /// \param[in] _type Id of the component type.
+  public: void UninternComponent(const Entity _entity,
+              const ComponentTypeId _type);
+
+  /// \brief Give every entity its own copy of the shared components of a
+  /// type.
+  /// \param[in] _type Id of the component type.
+  public: void UninternComponents(const ComponentTypeId _type);
+
+  /// \brief Forget all the cached views, when the views are cleared.
+  public: void ClearCachedViews();
+
+  /// \brief Replace a component in the storage, and in the views that cache
+  /// a pointer to it.
+  /// \param[in] _entity Entity holding the component.
+  /// \param[in] _comp Storage entry of the component.
+  /// \param[in] _replacement Component to store instead.
+  public: void ReplaceComponent(const Entity _entity, ComponentPtr &_comp,
+              ComponentPtr _replacement);
+
+  /// \brief Add the memory held by each component of an entity to the
+  /// usage of a group.
+  /// \param[in] _entity The entity.
+  /// \param[in] _usage Function returning the group of a component type.
+  /// \param[in,out] _shared Components shared among entities that have
+  /// already been counted, since their memory is only counted once.
+  public: void AddMemoryUsage(const Entity _entity,
+              const std::function<ComponentMemoryUsage &(ComponentTypeId)>
+              &_usage,
+              std::unordered_set<const components::BaseComponent *> &_shared)
+              const;
+
   /// \brief Set a cloned joint's parent or child link name.
   /// \param[in] _joint The cloned joint.
   /// \param[in] _originalLink The original joint's parent or child link.
@@ -132,9 +518,18 @@ class gz::sim::EntityComponentManagerPrivate
   /// \brief All component types that have ever been created.
   public: std::unordered_set<ComponentTypeId> createdCompTypes;
 
-  /// \brief A graph holding all entities, arranged according to their
-  /// parenting.
-  public: EntityGraph entities;
+  /// \brief All entities, arranged according to their parenting.
+  public: EntityHierarchy entities;
+
+  /// \brief Graph of the entities returned by Entities(), built from the
+  /// hierarchy the first time it's requested after a change.
+  public: mutable EntityGraph entityGraph;
+
+  /// \brief Version of the hierarchy that entityGraph was built from.
+  public: mutable std::optional<std::uint64_t> entityGraphVersion;
+
+  /// \brief Protects entityGraph, which may be requested concurrently.
+  public: mutable std::mutex entityGraphMutex;
 
   /// \brief Components that have been changed through a periodic change.
   /// The key is the type of component which has changed, and the value is the
@@ -148,6 +543,65 @@ class gz::sim::EntityComponentManagerPrivate
   public: std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
             oneTimeChangedComponents;
 
+  /// \brief Last version stamp handed out. Each component creation, change
+  /// and removal gets the next stamp.
+  public: std::uint64_t changeVersion{0};
+
+  /// \brief Version stamp of the last change to each component. The key is
+  /// the type of component, and the value maps entities to their stamp.
+  public: std::unordered_map<ComponentTypeId,
+              std::unordered_map<Entity, std::uint64_t>> componentVersions;
+
+  /// \brief Largest stamp of the components of each type, so that types
+  /// without recent changes can be skipped.
+  public: std::unordered_map<ComponentTypeId, std::uint64_t> typeVersions;
+
+  /// \brief The latest removals, oldest first.
+  public: std::deque<RemovalRecord> removalHistory;
+
+  /// \brief Stamp of the newest removal that was dropped from
+  /// removalHistory. Changes since an older stamp can't be told.
+  public: std::uint64_t removalHistoryStart{0};
+
+  /// \brief ID of the history of this manager, which is replaced when its
+  /// contents are replaced by CopyFrom.
+  public: std::uint64_t historyId{NextHistoryId()};
+
+  /// \brief History ID of the manager this one was copied from, or 0.
+  public: std::uint64_t sourceHistoryId{0};
+
+  /// \brief Change version of the source when it was copied.
+  public: std::uint64_t sourceChangeVersion{0};
+
+  /// \brief Hierarchy version of the source when it was copied.
+  public: std::uint64_t sourceHierarchyVersion{0};
+
+  /// \brief True if components may have been written through pointers
+  /// since the last copy.
+  public: std::atomic<bool> writtenSinceCopy{false};
+
+  /// \brief True if components may have been written through pointers
+  /// since pointerWriteVersion was last taken.
+  public: mutable std::atomic<bool> writtenSinceWriteVersion{false};
+
+  /// \brief Stamp returned by PointerWriteVersion.
+  public: mutable std::atomic<std::uint64_t> pointerWriteVersion{0};
+
+  /// \brief Bits of the component types that may have been written
+  /// through pointers, indexed by type ID. They're never cleared, because
+  /// systems may keep the pointers.
+  public: std::array<std::atomic<bool>, kWrittenTypeBits> writtenTypes{};
+
+  /// \brief Entities indexed by name.
+  public: mutable NameIndex nameIndex;
+
+  /// \brief Number of mutable pointers to names or parents that were
+  /// handed out. The name index is rebuilt when it changes.
+  public: std::atomic<std::uint64_t> namePointerWrites{0};
+
+  /// \brief Protects nameIndex, which may be searched concurrently.
+  public: mutable std::mutex nameIndexMutex;
+
   /// \brief Entities that have just been created
   public: std::unordered_set<Entity> newlyCreatedEntities;
 
@@ -160,6 +614,25 @@ class gz::sim::EntityComponentManagerPrivate
   /// This is used for the ChangedState functions
   public: std::unordered_set<Entity> modifiedComponents;
 
+  /// \brief Whether ChangedState should reuse the serialized changed state.
+  public: bool cacheChangedState{false};
+
+  /// \brief Changed state serialized by the first ChangedState call since
+  /// caching was enabled. Empty if it hasn't been serialized yet.
+  public: std::optional<msgs::SerializedStateMap> changedStateCache;
+
+  /// \brief Protects changedStateCache, since PostUpdates run concurrently.
+  public: std::mutex changedStateCacheMutex;
+
+  /// \brief Whether WorldPose should keep the poses it computes.
+  public: bool cacheWorldPoses{false};
+
+  /// \brief World poses computed since caching was enabled.
+  public: std::unordered_map<Entity, math::Pose3d> worldPoseCache;
+
+  /// \brief Protects worldPoseCache, since PostUpdates run concurrently.
+  public: std::shared_mutex worldPoseCacheMutex;
+
   /// \brief Flag that indicates if all entities should be removed.
   public: bool removeAllEntities{false};
 
@@ -175,6 +648,10 @@ class gz::sim::EntityComponentManagerPrivate
   /// \brief A mutex to protect removed components
   public: mutable std::mutex removedComponentsMutex;
 
+  /// \brief A mutex to protect the sets of changed components while they're
+  /// being modified by SetChanged.
+  public: mutable std::mutex changedComponentsMutex;
+
   /// \brief The set of all views.
   /// The value is a pair of the view itself and a mutex that can be used for
   /// locking the view to ensure thread safety when adding entities to the view.
@@ -182,6 +659,12 @@ class gz::sim::EntityComponentManagerPrivate
           std::pair<std::unique_ptr<detail::BaseView>,
             std::unique_ptr<std::mutex>>, detail::ComponentTypeHasher> views;
 
+  /// \brief Views cached by the index of their component types, which is
+  /// given to each list of types once per process. The views are owned by
+  /// `views`.
+  public: std::unique_ptr<CachedViewEntry[]> cachedViews{
+      new CachedViewEntry[kViewCacheSlots]};
+
   /// \brief A flag that indicates whether views should be locked while adding
   /// new entities to them or not.
   public: bool lockAddEntitiesToViews{false};
@@ -195,6 +678,21 @@ class gz::sim::EntityComponentManagerPrivate
   /// \brief Keep track of entities already used to ensure uniqueness.
   public: uint64_t entityCount{0};
 
+  /// \brief Whether entities get dense indices from entityIndexAllocator,
+  /// which are recycled when entities are removed.
+  public: bool recycleEntityIds{false};
+
+  /// \brief Allocator of the dense indices of entities.
+  public: EntityIndexAllocator entityIndexAllocator;
+
+  /// \brief Incremented whenever components may have been destroyed, which
+  /// invalidates the pointers cached by component handles.
+  public: std::uint64_t storageVersion{0};
+
+  /// \brief Incremented whenever components are added to entities, so that
+  /// component handles of missing components know when to look them up.
+  public: std::uint64_t creationVersion{0};
+
   /// \brief Unordered map of removed components. The key is the entity to
   /// which belongs the component, and the value is a set of the component types
   /// being removed.
@@ -209,9 +707,33 @@ class gz::sim::EntityComponentManagerPrivate
   public: std::unordered_map<Entity, std::unordered_set<ComponentTypeId>>
     componentsMarkedAsRemoved;
 
+  /// \brief Memory layout used to store new components.
+  public: ComponentStorageType storageType{ComponentStorageType::kHeap};
+
+  /// \brief Components shared among entities by InternComponents, keyed by
+  /// component type. Entries are never erased, since storage entries point
+  /// to their count, and this must be declared before componentStorage.
+  public: std::unordered_map<ComponentTypeId, InternedComponents>
+             internedComponents;
+
+  /// \brief Protects the shared components while they're copied back into
+  /// their entities, since systems running concurrently may write different
+  /// component types at the same time.
+  public: std::mutex internedMutex;
+
+  /// \brief Pools holding the components of each type when using
+  /// ComponentStorageType::kContiguous. This must be declared before
+  /// componentStorage so that the pools outlive the components.
+  public: std::unordered_map<ComponentTypeId, std::unique_ptr<ComponentPool>>
+             componentPools;
+
+  /// \brief Pools of the managers whose entities were moved into this one,
+  /// see MoveEntitiesFrom. They hold some of the components of this manager,
+  /// so they're also declared before componentStorage.
+  public: std::vector<std::unique_ptr<ComponentPool>> adoptedPools;
+
   /// \brief A map of an entity to its components
-  public: std::unordered_map<Entity,
-           std::vector<std::unique_ptr<components::BaseComponent>>>
+  public: std::unordered_map<Entity, std::vector<ComponentPtr>>
              componentStorage;
 
   /// \brief A map that keeps track of where each type of component is
@@ -232,6 +754,13 @@ class gz::sim::EntityComponentManagerPrivate
            std::unordered_map<ComponentTypeId, std::size_t>>
                                 componentTypeIndex;
 
+  /// \brief Depth of nested bulk inserts, see BeginBulkInsert.
+  public: unsigned int bulkInsertDepth{0};
+
+  /// \brief Entities which got new component types during a bulk insert,
+  /// and haven't been checked against the views yet. May hold duplicates.
+  public: std::vector<Entity> bulkEntities;
+
   /// \brief A vector of iterators to evenly distributed spots in the
   /// `componentTypeIndex` map.  Threads in the `State` function use this
   /// vector for easy access of their pre-allocated work.  This vector
@@ -285,6 +814,44 @@ class gz::sim::EntityComponentManagerPrivate
 
   /// \brief Set of entities that are prevented from removal.
   public: std::unordered_set<Entity> pinnedEntities;
+
+  /// \brief Component types whose components may still be shared with the
+  /// manager this one was forked from.
+  public: std::unordered_set<ComponentTypeId> sharedComponentTypes;
+
+  /// \brief Size of sharedComponentTypes, checked before locking it.
+  public: std::atomic<std::size_t> sharedTypeCount{0};
+
+  /// \brief Protects sharedComponentTypes, since systems running
+  /// concurrently may write different component types at the same time.
+  public: std::mutex sharedTypesMutex;
+
+  /// \brief Wrench accumulator of the runner that owns this manager. It's
+  /// not copied by CopyFrom, since it belongs to the runner.
+  public: WrenchAccumulator *wrenches{nullptr};
+
+  /// \brief Scratch memory of the runner that owns this manager. It's not
+  /// copied by CopyFrom either.
+  public: FrameArena *stepArena{nullptr};
+
+  /// \brief Data shared by the systems of this world.
+  public: struct SystemSharedEntry
+  {
+    /// \brief Name of the type of the data.
+    std::string typeName;
+
+    /// \brief The data, held by the systems.
+    std::weak_ptr<void> data;
+  };
+
+  /// \brief Data shared by the systems of this world, by key. It's not
+  /// copied by CopyFrom, since copies simulate separate worlds.
+  public: std::unordered_map<std::string, SystemSharedEntry>
+      systemSharedData;
+
+  /// \brief Protects systemSharedData, since systems may be configured
+  /// concurrently.
+  public: mutable std::mutex systemSharedDataMutex;
 };
 
 //////////////////////////////////////////////////
@@ -298,31 +865,80 @@ EntityComponentManager::~EntityComponentManager() = default;
 
 //////////////////////////////////////////////////
 void EntityComponentManagerPrivate::CopyFrom(
-    const EntityComponentManagerPrivate &_from)
+    const EntityComponentManagerPrivate &_from, bool _share)
 {
   this->createdCompTypes = _from.createdCompTypes;
   this->entities = _from.entities;
+  this->entityGraphVersion.reset();
   this->periodicChangedComponents = _from.periodicChangedComponents;
   this->oneTimeChangedComponents = _from.oneTimeChangedComponents;
+  this->changeVersion = _from.changeVersion;
+  this->componentVersions = _from.componentVersions;
+  this->typeVersions = _from.typeVersions;
+  this->removalHistory = _from.removalHistory;
+  this->removalHistoryStart = _from.removalHistoryStart;
+  this->historyId = NextHistoryId();
+  this->sourceHistoryId = _from.historyId;
+  this->sourceChangeVersion = _from.changeVersion;
+  this->sourceHierarchyVersion = _from.entities.Version();
+  this->writtenSinceCopy = false;
+  this->writtenSinceWriteVersion = false;
+  this->pointerWriteVersion = _from.PointerWriteVersion();
+  for (std::size_t i = 0u; i < kWrittenTypeBits; ++i)
+  {
+    if (_from.writtenTypes[i].load(std::memory_order_relaxed))
+      this->writtenTypes[i].store(true, std::memory_order_relaxed);
+  }
   this->newlyCreatedEntities = _from.newlyCreatedEntities;
   this->toRemoveEntities = _from.toRemoveEntities;
   this->modifiedComponents = _from.modifiedComponents;
   this->removeAllEntities = _from.removeAllEntities;
   this->views.clear();
+  this->ClearCachedViews();
+  this->ClearNameIndex();
   this->lockAddEntitiesToViews = _from.lockAddEntitiesToViews;
   this->descendantCache.clear();
   this->entityCount = _from.entityCount;
+  this->recycleEntityIds = _from.recycleEntityIds;
+  this->entityIndexAllocator = _from.entityIndexAllocator;
+
+  // All components are replaced below
+  ++this->storageVersion;
+  ++this->creationVersion;
   this->removedComponents = _from.removedComponents;
   this->componentsMarkedAsRemoved = _from.componentsMarkedAsRemoved;
 
+  // Keep the storage layout of this object if it already holds components,
+  // since existing pools can't be migrated.
+  if (this->componentStorage.empty())
+    this->storageType = _from.storageType;
+
   for (const auto &[entity, comps] : _from.componentStorage)
   {
     this->componentStorage[entity].clear();
     for (const auto &comp : comps)
     {
-      this->componentStorage[entity].emplace_back(comp->Clone());
+      if (_share)
+      {
+        this->componentStorage[entity].emplace_back(comp.get(),
+            ComponentDeleter::Borrowed());
+      }
+      else
+      {
+        this->componentStorage[entity].emplace_back(
+            this->NewComponent(comp->TypeId(), comp.get()));
+      }
     }
   }
+
+  // Every type is shared until it's written
+  {
+    std::lock_guard<std::mutex> lock(this->sharedTypesMutex);
+    this->sharedComponentTypes.clear();
+    if (_share)
+      this->sharedComponentTypes = _from.createdCompTypes;
+    this->sharedTypeCount = this->sharedComponentTypes.size();
+  }
   this->componentTypeIndex = _from.componentTypeIndex;
   this->componentTypeIndexIterators.clear();
   this->componentTypeIndexDirty = true;
@@ -333,10 +949,86 @@ void EntityComponentManagerPrivate::CopyFrom(
   this->pinnedEntities = _from.pinnedEntities;
 }
 
+//////////////////////////////////////////////////
+ComponentPtr EntityComponentManagerPrivate::NewComponent(
+    const ComponentTypeId _typeId, const components::BaseComponent *_data)
+{
+  auto factory = components::Factory::Instance();
+  if (this->storageType == ComponentStorageType::kContiguous &&
+      nullptr != _data && _data->TypeId() == _typeId)
+  {
+    auto desc = factory->DataOps(_typeId);
+    if (nullptr != desc && desc->Size() > 0)
+    {
+      auto &pool = this->componentPools[_typeId];
+      if (!pool)
+      {
+        pool = std::make_unique<ComponentPool>(desc->Size(),
+            desc->Alignment());
+      }
+
+      // A library may register a different definition of the type after the
+      // pool was created; fall back to the heap if it doesn't fit.
+      if (pool->SlotSize() >= desc->Size())
+      {
+        void *slot = pool->Allocate();
+        auto comp = desc->Construct(slot, _data);
+        if (nullptr != comp)
+          return ComponentPtr(comp, ComponentDeleter(pool.get(), slot));
+        pool->Release(slot);
+      }
+    }
+  }
+
+  return ComponentPtr(factory->New(_typeId, _data).release());
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::SetComponentStorage(
+    const ComponentStorageType _type)
+{
+  if (_type == this->dataPtr->storageType)
+    return true;
+
+  for (const auto &[entity, comps] : this->dataPtr->componentStorage)
+  {
+    if (!comps.empty())
+    {
+      gzerr << "Can't change the component storage layout after components "
+            << "have been created." << std::endl;
+      return false;
+    }
+  }
+
+  this->dataPtr->storageType = _type;
+  return true;
+}
+
+//////////////////////////////////////////////////
+ComponentStorageType EntityComponentManager::ComponentStorage() const
+{
+  return this->dataPtr->storageType;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::ParallelFor(std::size_t _count,
+    std::size_t _grainSize,
+    const std::function<void(std::size_t, std::size_t)> &_fn) const
+{
+  GZ_PROFILE("EntityComponentManager::ParallelFor");
+  auto &pool = ThreadPool::Shared();
+
+  // Don't make chunks so small that the scheduling overhead dominates
+  if (_grainSize == 0)
+    _grainSize = pool.GrainSize(_count, 16u);
+
+  pool.ParallelFor(_count, _grainSize, _fn);
+}
+
 //////////////////////////////////////////////////
 size_t EntityComponentManager::EntityCount() const
 {
-  return this->dataPtr->entities.Vertices().size();
+  return this->dataPtr->entities.Size();
 }
 
 /////////////////////////////////////////////////
@@ -358,7 +1050,9 @@ Entity EntityComponentManager::CreateEntity()
 Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity)
 {
   GZ_PROFILE("EntityComponentManager::CreateEntityImplementation");
-  this->entities.AddVertex(std::to_string(_entity), _entity, _entity);
+  this->entities.AddEntity(_entity);
+  if (this->recycleEntityIds)
+    this->entityIndexAllocator.Assign(_entity);
 
   // Add entity to the list of newly created entities
   {
@@ -370,7 +1064,7 @@ Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity)
   this->descendantCache.clear();
 
   const auto result = this->componentStorage.insert({_entity,
-      std::vector<std::unique_ptr<components::BaseComponent>>()});
+      std::vector<ComponentPtr>()});
   if (!result.second)
   {
     gzwarn << "Attempted to add entity [" << _entity
@@ -400,7 +1094,9 @@ Entity EntityComponentManager::Clone(Entity _entity, Entity _parent,
   this->dataPtr->originalToClonedLink.clear();
   this->dataPtr->clonedToOriginalJointLinks.clear();
 
+  this->BeginBulkInsert();
   auto clonedEntity = this->CloneImpl(_entity, _parent, _name, _allowRename);
+  this->EndBulkInsert();
 
   if (kNullEntity != clonedEntity)
   {
@@ -536,7 +1232,9 @@ Entity EntityComponentManager::CloneImpl(Entity _entity, Entity _parent,
         (type == components::ParentEntity::typeId))
       continue;
 
-    auto originalComp = this->ComponentImplementation(_entity, type);
+    // Reading the original doesn't stop it from being shared
+    auto originalComp = static_cast<const EntityComponentManager &>(
+        *this).ComponentImplementation(_entity, type);
     auto clonedComp = originalComp->Clone();
 
     auto updateData =
@@ -679,10 +1377,10 @@ void EntityComponentManager::ClearRemovedComponents()
 void EntityComponentManagerPrivate::InsertEntityRecursive(Entity _entity,
     std::unordered_set<Entity> &_set)
 {
-  for (const auto &vertex : this->entities.AdjacentsFrom(_entity))
+  this->entities.ForEachChild(_entity, [&](Entity _child)
   {
-    this->InsertEntityRecursive(vertex.first, _set);
-  }
+    this->InsertEntityRecursive(_child, _set);
+  });
   _set.insert(_entity);
 }
 
@@ -690,10 +1388,10 @@ void EntityComponentManagerPrivate::InsertEntityRecursive(Entity _entity,
 void EntityComponentManagerPrivate::EraseEntityRecursive(Entity _entity,
     std::unordered_set<Entity> &_set)
 {
-  for (const auto &vertex : this->entities.AdjacentsFrom(_entity))
+  this->entities.ForEachChild(_entity, [&](Entity _child)
   {
-    this->EraseEntityRecursive(vertex.first, _set);
-  }
+    this->EraseEntityRecursive(_child, _set);
+  });
   _set.erase(_entity);
 }
 
@@ -701,34 +1399,43 @@ void EntityComponentManagerPrivate::EraseEntityRecursive(Entity _entity,
 void EntityComponentManager::RequestRemoveEntity(Entity _entity,
     bool _recursive)
 {
-  // Store the to-be-removed entities in a temporary set so we can call
-  // UpdateViews on each of them
-  std::unordered_set<Entity> tmpToRemoveEntities;
+  GZ_PROFILE("EntityComponentManager::RequestRemoveEntity");
+
+  // Collect the to-be-removed entities once, walking the subtree without
+  // recursion, and sort them so that each view is updated in a single pass
+  std::vector<Entity> tmpToRemoveEntities;
   if (!_recursive)
   {
-    tmpToRemoveEntities.insert(_entity);
+    tmpToRemoveEntities.push_back(_entity);
   }
   else
   {
-    this->dataPtr->InsertEntityRecursive(_entity, tmpToRemoveEntities);
+    std::vector<Entity> toVisit{_entity};
+    while (!toVisit.empty())
+    {
+      const Entity entity = toVisit.back();
+      toVisit.pop_back();
+      tmpToRemoveEntities.push_back(entity);
+      this->dataPtr->entities.ForEachChild(entity, [&](Entity _child)
+      {
+        toVisit.push_back(_child);
+      });
+    }
   }
 
   // Remove entities from tmpToRemoveEntities that are marked as
   // unremovable.
-  for (auto iter = tmpToRemoveEntities.begin();
-       iter != tmpToRemoveEntities.end();)
+  if (!this->dataPtr->pinnedEntities.empty())
   {
-    if (std::find(this->dataPtr->pinnedEntities.begin(),
-                  this->dataPtr->pinnedEntities.end(), *iter) !=
-               this->dataPtr->pinnedEntities.end())
-    {
-      iter = tmpToRemoveEntities.erase(iter);
-    }
-    else
-    {
-      ++iter;
-    }
+    tmpToRemoveEntities.erase(std::remove_if(tmpToRemoveEntities.begin(),
+        tmpToRemoveEntities.end(), [this](const Entity _e)
+        {
+          return this->dataPtr->pinnedEntities.count(_e) > 0u;
+        }), tmpToRemoveEntities.end());
   }
+  std::sort(tmpToRemoveEntities.begin(), tmpToRemoveEntities.end());
+  tmpToRemoveEntities.erase(std::unique(tmpToRemoveEntities.begin(),
+      tmpToRemoveEntities.end()), tmpToRemoveEntities.end());
 
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
@@ -736,12 +1443,9 @@ void EntityComponentManager::RequestRemoveEntity(Entity _entity,
                                           tmpToRemoveEntities.end());
   }
 
-  for (const auto &removedEntity : tmpToRemoveEntities)
+  for (auto &view : this->dataPtr->views)
   {
-    for (auto &view : this->dataPtr->views)
-    {
-      view.second.first->MarkEntityToRemove(removedEntity);
-    }
+    view.second.first->MarkEntitiesToRemove(tmpToRemoveEntities);
   }
 }
 
@@ -762,14 +1466,10 @@ void EntityComponentManager::RequestRemoveEntities()
 
     // Store the to-be-removed entities in a temporary set so we can
     // mark each of them to be removed from views that contain them.
-    for (const auto &vertex : this->dataPtr->entities.Vertices())
+    for (const Entity entity : this->dataPtr->entities.TopologicalOrder())
     {
-      if (std::find(this->dataPtr->pinnedEntities.begin(),
-                    this->dataPtr->pinnedEntities.end(), vertex.first) ==
-          this->dataPtr->pinnedEntities.end())
-      {
-        tmpToRemoveEntities.insert(vertex.first);
-      }
+      if (this->dataPtr->pinnedEntities.count(entity) == 0u)
+        tmpToRemoveEntities.insert(entity);
     }
 
     {
@@ -798,7 +1498,7 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
   {
     GZ_PROFILE("RemoveAll");
     this->dataPtr->removeAllEntities = false;
-    this->dataPtr->entities = EntityGraph();
+    this->dataPtr->entities.Clear();
     this->dataPtr->toRemoveEntities.clear();
     this->dataPtr->componentsMarkedAsRemoved.clear();
 
@@ -806,36 +1506,75 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
     this->dataPtr->componentStorage.clear();
     this->dataPtr->componentTypeIndex.clear();
     this->dataPtr->componentTypeIndexDirty = true;
+    this->dataPtr->entityIndexAllocator.ReleaseAll();
+    ++this->dataPtr->storageVersion;
+
+    // Consumers that looked before now need the full state
+    {
+      std::lock_guard<std::mutex> lock(
+          this->dataPtr->changedComponentsMutex);
+      this->dataPtr->componentVersions.clear();
+      this->dataPtr->typeVersions.clear();
+      this->dataPtr->removalHistory.clear();
+      this->dataPtr->removalHistoryStart = ++this->dataPtr->changeVersion;
+    }
 
     // All views are now invalid.
     this->dataPtr->views.clear();
+    this->dataPtr->ClearCachedViews();
+    this->dataPtr->ClearNameIndex();
   }
   else
   {
     GZ_PROFILE("Remove");
-    // Otherwise iterate through the list of entities to remove.
-    for (const Entity entity : this->dataPtr->toRemoveEntities)
+    std::vector<Entity> removed;
+    removed.reserve(this->dataPtr->toRemoveEntities.size());
     {
-      // Make sure the entity exists and is not removed.
-      if (!this->HasEntity(entity))
-        continue;
+      std::lock_guard<std::mutex> lock(
+          this->dataPtr->changedComponentsMutex);
+
+      // Otherwise iterate through the list of entities to remove.
+      for (const Entity entity : this->dataPtr->toRemoveEntities)
+      {
+        // Make sure the entity exists and is not removed.
+        if (!this->HasEntity(entity))
+          continue;
+
+        // Remove from hierarchy
+        this->dataPtr->entities.RemoveEntity(entity);
+
+        for (const auto &[type, index] :
+            this->dataPtr->componentTypeIndex[entity])
+        {
+          auto versionsIter = this->dataPtr->componentVersions.find(type);
+          if (versionsIter != this->dataPtr->componentVersions.end())
+            versionsIter->second.erase(entity);
+        }
+        this->dataPtr->RecordRemoval(entity, kComponentTypeIdInvalid);
 
-      // Remove from graph
-      this->dataPtr->entities.RemoveVertex(entity);
+        this->dataPtr->componentsMarkedAsRemoved.erase(entity);
+        this->dataPtr->componentStorage.erase(entity);
+        this->dataPtr->componentTypeIndex.erase(entity);
+        this->dataPtr->entityIndexAllocator.Release(entity);
+        removed.push_back(entity);
+      }
+    }
+    // Clear the set of entities to remove.
+    this->dataPtr->toRemoveEntities.clear();
 
-      this->dataPtr->componentsMarkedAsRemoved.erase(entity);
-      this->dataPtr->componentStorage.erase(entity);
-      this->dataPtr->componentTypeIndex.erase(entity);
+    if (!removed.empty())
+    {
       this->dataPtr->componentTypeIndexDirty = true;
+      ++this->dataPtr->storageVersion;
 
-      // Remove the entity from views.
+      // Remove the entities from each view in a single pass, which is much
+      // cheaper than one entity at a time when removing large subtrees
+      std::sort(removed.begin(), removed.end());
       for (auto &view : this->dataPtr->views)
       {
-        view.second.first->RemoveEntity(entity);
+        view.second.first->RemoveEntities(removed);
       }
     }
-    // Clear the set of entities to remove.
-    this->dataPtr->toRemoveEntities.clear();
   }
 
   // Reset descendants cache
@@ -867,10 +1606,16 @@ bool EntityComponentManager::RemoveComponent(
       this->dataPtr->periodicChangedComponents.erase(periodicIter);
   }
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+    this->dataPtr->RecordRemoval(_entity, _typeId);
+  }
+
   auto compPtr = this->ComponentImplementation(_entity, _typeId);
   if (compPtr)
   {
     this->dataPtr->componentsMarkedAsRemoved[_entity].insert(_typeId);
+    ++this->dataPtr->storageVersion;
 
     // update views to reflect the component removal
     for (auto &viewPair : this->dataPtr->views)
@@ -938,6 +1683,7 @@ ComponentState EntityComponentManager::ComponentState(const Entity _entity,
 
   auto typeId = typeIter->first;
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
   auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(typeId);
   if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end() &&
       oneTimeIter->second.find(_entity) != oneTimeIter->second.end())
@@ -957,46 +1703,254 @@ ComponentState EntityComponentManager::ComponentState(const Entity _entity,
 }
 
 /////////////////////////////////////////////////
-bool EntityComponentManager::HasNewEntities() const
+std::unordered_set<Entity>
+    EntityComponentManager::EntitiesWithChangedComponent(
+    const ComponentTypeId _typeId) const
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
-  return !this->dataPtr->newlyCreatedEntities.empty();
+  std::unordered_set<Entity> result;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+    auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(_typeId);
+    if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end())
+      result.insert(oneTimeIter->second.begin(), oneTimeIter->second.end());
+
+    auto periodicIter = this->dataPtr->periodicChangedComponents.find(_typeId);
+    if (periodicIter != this->dataPtr->periodicChangedComponents.end())
+      result.insert(periodicIter->second.begin(), periodicIter->second.end());
+  }
+
+  for (auto it = result.begin(); it != result.end();)
+  {
+    if (this->dataPtr->ComponentMarkedAsRemoved(*it, _typeId))
+      it = result.erase(it);
+    else
+      ++it;
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
-bool EntityComponentManager::HasEntitiesMarkedForRemoval() const
+std::uint64_t EntityComponentManager::ChangeVersion() const
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
-  return this->dataPtr->removeAllEntities ||
-      !this->dataPtr->toRemoveEntities.empty();
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+  return this->dataPtr->changeVersion;
 }
 
 /////////////////////////////////////////////////
-bool EntityComponentManager::HasOneTimeComponentChanges() const
+std::uint64_t EntityComponentManager::PointerWriteVersion() const
 {
-  return !this->dataPtr->oneTimeChangedComponents.empty();
+  return this->dataPtr->PointerWriteVersion();
 }
 
 /////////////////////////////////////////////////
-bool EntityComponentManager::HasPeriodicComponentChanges() const
+std::uint64_t EntityComponentManagerPrivate::PointerWriteVersion() const
 {
-  return !this->dataPtr->periodicChangedComponents.empty();
+  // Writes since the last call are folded into a new stamp, so that the
+  // writes don't need to count anything
+  if (this->writtenSinceWriteVersion.exchange(false))
+    ++this->pointerWriteVersion;
+  return this->pointerWriteVersion.load();
 }
 
 /////////////////////////////////////////////////
-std::unordered_set<ComponentTypeId>
-    EntityComponentManager::ComponentTypesWithPeriodicChanges() const
+std::uint64_t EntityComponentManager::ComponentVersion(const Entity _entity,
+    const ComponentTypeId _typeId) const
 {
-  std::unordered_set<ComponentTypeId> periodicComponents;
-  for (const auto& typeToEntityPtrs : this->dataPtr->periodicChangedComponents)
-  {
-    periodicComponents.insert(typeToEntityPtrs.first);
-  }
-  return periodicComponents;
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+  auto versionsIter = this->dataPtr->componentVersions.find(_typeId);
+  if (versionsIter == this->dataPtr->componentVersions.end())
+    return 0;
+  auto entityIter = versionsIter->second.find(_entity);
+  if (entityIter == versionsIter->second.end())
+    return 0;
+  return entityIter->second;
 }
 
 /////////////////////////////////////////////////
-void EntityComponentManager::UpdatePeriodicChangeCache(
+bool EntityComponentManager::ChangesSince(std::uint64_t _version,
+    std::unordered_map<ComponentTypeId, std::unordered_set<Entity>> &_changed,
+    std::unordered_set<Entity> &_removedEntities,
+    std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+    &_removedComponents) const
+{
+  GZ_PROFILE("EntityComponentManager::ChangesSince");
+  _changed.clear();
+  _removedEntities.clear();
+  _removedComponents.clear();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+  for (const auto &[type, typeVersion] : this->dataPtr->typeVersions)
+  {
+    if (typeVersion <= _version)
+      continue;
+
+    auto versionsIter = this->dataPtr->componentVersions.find(type);
+    if (versionsIter == this->dataPtr->componentVersions.end())
+      continue;
+    for (const auto &[entity, version] : versionsIter->second)
+    {
+      if (version > _version)
+        _changed[type].insert(entity);
+    }
+  }
+
+  // Removals are sorted by stamp, so only the newest ones are visited
+  for (auto it = this->dataPtr->removalHistory.rbegin();
+       it != this->dataPtr->removalHistory.rend() && it->version > _version;
+       ++it)
+  {
+    if (it->typeId == kComponentTypeIdInvalid)
+    {
+      _removedEntities.insert(it->entity);
+      continue;
+    }
+
+    // Skip components that were added back
+    auto versionsIter = this->dataPtr->componentVersions.find(it->typeId);
+    if (versionsIter != this->dataPtr->componentVersions.end() &&
+        versionsIter->second.find(it->entity) != versionsIter->second.end())
+    {
+      continue;
+    }
+    _removedComponents[it->typeId].insert(it->entity);
+  }
+
+  for (auto &[type, entities] : _removedComponents)
+  {
+    for (const Entity entity : _removedEntities)
+      entities.erase(entity);
+  }
+
+  return _version >= this->dataPtr->removalHistoryStart;
+}
+
+/////////////////////////////////////////////////
+std::unordered_set<Entity> EntityComponentManager::EntitiesChangedSince(
+    std::uint64_t _version, const ComponentTypeId _typeId) const
+{
+  std::unordered_set<Entity> result;
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+  auto typeIter = this->dataPtr->typeVersions.find(_typeId);
+  if (typeIter == this->dataPtr->typeVersions.end() ||
+      typeIter->second <= _version)
+  {
+    return result;
+  }
+
+  auto versionsIter = this->dataPtr->componentVersions.find(_typeId);
+  if (versionsIter == this->dataPtr->componentVersions.end())
+    return result;
+  for (const auto &[entity, version] : versionsIter->second)
+  {
+    if (version > _version)
+      result.insert(entity);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::HasNewEntities() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+  return !this->dataPtr->newlyCreatedEntities.empty();
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::HasEntitiesMarkedForRemoval() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
+  return this->dataPtr->removeAllEntities ||
+      !this->dataPtr->toRemoveEntities.empty();
+}
+
+/////////////////////////////////////////////////
+WrenchAccumulator *EntityComponentManager::Wrenches() const
+{
+  return this->dataPtr->wrenches;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::SetWrenches(WrenchAccumulator *_wrenches)
+{
+  this->dataPtr->wrenches = _wrenches;
+}
+
+/////////////////////////////////////////////////
+FrameArena *EntityComponentManager::StepArena() const
+{
+  return this->dataPtr->stepArena;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::SetStepArena(FrameArena *_arena)
+{
+  this->dataPtr->stepArena = _arena;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<void> EntityComponentManager::SystemSharedDataImpl(
+    const std::string &_key, const char *_typeName, void *(*_create)(),
+    void (*_destroy)(void *)) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->systemSharedDataMutex);
+  auto &shared = this->dataPtr->systemSharedData;
+
+  // Drop the data that no system holds anymore
+  for (auto it = shared.begin(); it != shared.end();)
+  {
+    if (it->first != _key && it->second.data.expired())
+      it = shared.erase(it);
+    else
+      ++it;
+  }
+
+  auto &entry = shared[_key];
+  auto data = entry.data.lock();
+  if (data)
+  {
+    if (entry.typeName != _typeName)
+    {
+      gzerr << "System data [" << _key << "] is shared with a different "
+            << "type." << std::endl;
+      return nullptr;
+    }
+    return data;
+  }
+
+  // The control block is created here, so releasing it doesn't run code
+  // of the library that created the data
+  data = std::shared_ptr<void>(_create(), _destroy);
+  entry.typeName = _typeName;
+  entry.data = data;
+  return data;
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::HasOneTimeComponentChanges() const
+{
+  return !this->dataPtr->oneTimeChangedComponents.empty();
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::HasPeriodicComponentChanges() const
+{
+  return !this->dataPtr->periodicChangedComponents.empty();
+}
+
+/////////////////////////////////////////////////
+std::unordered_set<ComponentTypeId>
+    EntityComponentManager::ComponentTypesWithPeriodicChanges() const
+{
+  std::unordered_set<ComponentTypeId> periodicComponents;
+  for (const auto& typeToEntityPtrs : this->dataPtr->periodicChangedComponents)
+  {
+    periodicComponents.insert(typeToEntityPtrs.first);
+  }
+  return periodicComponents;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::UpdatePeriodicChangeCache(
   std::unordered_map<ComponentTypeId,
   std::unordered_set<Entity>> &_changes) const
 {
@@ -1034,42 +1988,25 @@ void EntityComponentManager::UpdatePeriodicChangeCache(
 /////////////////////////////////////////////////
 bool EntityComponentManager::HasEntity(const Entity _entity) const
 {
-  auto vertex = this->dataPtr->entities.VertexFromId(_entity);
-  return vertex.Id() != math::graph::kNullId;
+  return this->dataPtr->entities.HasEntity(_entity);
 }
 
 /////////////////////////////////////////////////
 Entity EntityComponentManager::ParentEntity(const Entity _entity) const
 {
-  auto parents = this->Entities().AdjacentsTo(_entity);
-  if (parents.empty())
-    return kNullEntity;
-
-  // TODO(louise) Do we want to support multiple parents?
-  return parents.begin()->first;
+  return this->dataPtr->entities.Parent(_entity);
 }
 
 /////////////////////////////////////////////////
 bool EntityComponentManager::SetParentEntity(const Entity _child,
     const Entity _parent)
 {
-  // Remove current parent(s)
-  auto parents = this->Entities().AdjacentsTo(_child);
-  for (const auto &parent : parents)
-  {
-    auto edge = this->dataPtr->entities.EdgeFromVertices(parent.first, _child);
-    this->dataPtr->entities.RemoveEdge(edge);
-  }
-
-  // Leave parent-less
-  if (_parent == kNullEntity)
-  {
+  if (this->dataPtr->entities.SetParent(_child, _parent))
     return true;
-  }
 
-  // Add edge
-  auto edge = this->dataPtr->entities.AddEdge({_parent, _child}, true);
-  return (math::graph::kNullId != edge.Id());
+  // The current parent is removed even if the new one is invalid
+  this->dataPtr->entities.SetParent(_child, kNullEntity);
+  return false;
 }
 
 /////////////////////////////////////////////////
@@ -1123,24 +2060,40 @@ bool EntityComponentManager::CreateComponentImplementation(
     return false;
   }
 
-  // Instantiate the new component.
-  auto newComp = components::Factory::Instance()->New(_componentTypeId, _data);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+    this->dataPtr->StampComponent(_entity, _componentTypeId);
+  }
 
   const auto compIdxIter = typeMapIter->second.find(_componentTypeId);
   // If entity has never had a component of this type
   if (compIdxIter == typeMapIter->second.end())
   {
+    // Instantiate the new component.
+    auto newComp = this->dataPtr->NewComponent(_componentTypeId, _data);
+
     const auto vectorIdx = entityCompIter->second.size();
     entityCompIter->second.push_back(std::move(newComp));
     this->dataPtr->componentTypeIndex[_entity][_componentTypeId] = vectorIdx;
     this->dataPtr->componentTypeIndexDirty = true;
+    ++this->dataPtr->creationVersion;
 
     updateData = false;
-    for (auto &viewPair : this->dataPtr->views)
+    if (this->dataPtr->bulkInsertDepth > 0u)
     {
-      auto &view = viewPair.second.first;
-      if (this->EntityMatches(_entity, view->ComponentTypes()))
-        view->MarkEntityToAdd(_entity, this->IsNewEntity(_entity));
+      // Components of an entity are usually created one after the other
+      auto &bulkEntities = this->dataPtr->bulkEntities;
+      if (bulkEntities.empty() || bulkEntities.back() != _entity)
+        bulkEntities.push_back(_entity);
+    }
+    else
+    {
+      for (auto &viewPair : this->dataPtr->views)
+      {
+        auto &view = viewPair.second.first;
+        if (this->EntityMatches(_entity, view->ComponentTypes()))
+          view->MarkEntityToAdd(_entity, this->IsNewEntity(_entity));
+      }
     }
   }
   else
@@ -1166,6 +2119,7 @@ bool EntityComponentManager::CreateComponentImplementation(
     else if (this->dataPtr->ComponentMarkedAsRemoved(_entity, _componentTypeId))
     {
       this->dataPtr->componentsMarkedAsRemoved[_entity].erase(_componentTypeId);
+      ++this->dataPtr->creationVersion;
 
       for (auto &viewPair : this->dataPtr->views)
       {
@@ -1264,150 +2218,491 @@ const components::BaseComponent
 components::BaseComponent *EntityComponentManager::ComponentImplementation(
     const Entity _entity, const ComponentTypeId _type)
 {
+  // The caller may write the component
+  this->UnshareComponents(_type, _entity);
+
   // Call the const version of the function
   return const_cast<components::BaseComponent *>(
       static_cast<const EntityComponentManager &>(
       *this).ComponentImplementation(_entity, _type));
 }
 
-/////////////////////////////////////////////////
-bool EntityComponentManager::HasComponentType(
-    const ComponentTypeId _typeId) const
-{
-  return this->dataPtr->createdCompTypes.find(_typeId) !=
-    this->dataPtr->createdCompTypes.end();
-}
-
 //////////////////////////////////////////////////
-const EntityGraph &EntityComponentManager::Entities() const
+components::BaseComponent
+    *EntityComponentManager::CreatedComponentImplementation(
+    const Entity _entity, const ComponentTypeId _type)
 {
-  return this->dataPtr->entities;
+  this->UnshareComponents(_type, _entity, false);
+  return const_cast<components::BaseComponent *>(
+      static_cast<const EntityComponentManager &>(
+      *this).ComponentImplementation(_entity, _type));
 }
 
 //////////////////////////////////////////////////
-std::pair<detail::BaseView *, std::mutex *> EntityComponentManager::FindView(
-    const std::vector<ComponentTypeId> &_types) const
+void EntityComponentManager::UnshareComponents(const ComponentTypeId _type,
+    const Entity _entity, const bool _pointerWrite)
 {
-  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
-  std::pair<detail::BaseView *, std::mutex *> viewMutexPair(nullptr, nullptr);
-  auto iter = this->dataPtr->views.find(_types);
-  if (iter != this->dataPtr->views.end())
+  // All writes through pointers get the pointers from here
+  if (_pointerWrite)
+    this->dataPtr->MarkWritten(_type);
+
+  if (kNullEntity == _entity)
+    this->dataPtr->UninternComponents(_type);
+  else
+    this->dataPtr->UninternComponent(_entity, _type);
+
+  if (0u == this->dataPtr->sharedTypeCount.load())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->sharedTypesMutex);
+  if (kNullEntity != _entity)
   {
-    viewMutexPair.first = iter->second.first.get();
-    viewMutexPair.second = iter->second.second.get();
+    // The type stays shared, only this component is copied
+    if (0u == this->dataPtr->sharedComponentTypes.count(_type))
+      return;
+    auto typesIt = this->dataPtr->componentTypeIndex.find(_entity);
+    if (typesIt == this->dataPtr->componentTypeIndex.end())
+      return;
+    auto typeIt = typesIt->second.find(_type);
+    if (typeIt == typesIt->second.end())
+      return;
+
+    auto &comp = this->dataPtr->componentStorage[_entity][typeIt->second];
+    if (comp.get_deleter().owned)
+      return;
+    this->dataPtr->ReplaceComponent(_entity, comp,
+        this->dataPtr->NewComponent(_type, comp.get()));
+    ++this->dataPtr->storageVersion;
+    return;
   }
-  return viewMutexPair;
+
+  if (0u == this->dataPtr->sharedComponentTypes.erase(_type))
+    return;
+  this->dataPtr->sharedTypeCount = this->dataPtr->sharedComponentTypes.size();
+
+  GZ_PROFILE("EntityComponentManager::UnshareComponents");
+  for (const auto &[entity, types] : this->dataPtr->componentTypeIndex)
+  {
+    const auto typeIter = types.find(_type);
+    if (typeIter == types.end())
+      continue;
+
+    auto &comp = this->dataPtr->componentStorage[entity][typeIter->second];
+    if (comp.get_deleter().owned)
+      continue;
+
+    this->dataPtr->ReplaceComponent(entity, comp,
+        this->dataPtr->NewComponent(_type, comp.get()));
+  }
+
+  // Handles look up the copies
+  ++this->dataPtr->storageVersion;
 }
 
 //////////////////////////////////////////////////
-detail::BaseView *EntityComponentManager::AddView(
-    const detail::ComponentTypeKey &_types,
-    std::unique_ptr<detail::BaseView> _view) const
+void EntityComponentManagerPrivate::ReplaceComponent(const Entity _entity,
+    ComponentPtr &_comp, ComponentPtr _replacement)
 {
-  // If the view already exists, then the map will return the iterator to
-  // the location that prevented the insertion.
-  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
-  auto iter = this->dataPtr->views.insert(std::make_pair(_types,
-        std::make_pair(std::move(_view),
-          std::make_unique<std::mutex>()))).first;
-  return iter->second.first.get();
+  // Views cache component pointers, which are updated in place since the
+  // caller may be iterating over one of them
+  for (auto &viewPair : this->views)
+  {
+    viewPair.second.first->ReplaceComponent(_entity, _comp.get(),
+        _replacement.get());
+  }
+  _comp = std::move(_replacement);
 }
 
 //////////////////////////////////////////////////
-void EntityComponentManager::RebuildViews()
+void EntityComponentManagerPrivate::UninternComponent(const Entity _entity,
+    const ComponentTypeId _type)
 {
-  GZ_PROFILE("EntityComponentManager::RebuildViews");
-  for (auto &viewPair : this->dataPtr->views)
+  // The interned types only change while systems aren't running
+  auto internedIt = this->internedComponents.find(_type);
+  if (internedIt == this->internedComponents.end() ||
+      0u == internedIt->second.count.load())
   {
-    auto &view = viewPair.second.first;
-    view->Reset();
+    return;
+  }
 
-    // Add all the entities that match the component types to the
-    // view.
-    for (const auto &vertex : this->dataPtr->entities.Vertices())
-    {
-      Entity entity = vertex.first;
-      if (this->EntityMatches(entity, view->ComponentTypes()))
-      {
-        view->MarkEntityToAdd(entity, this->IsNewEntity(entity));
+  auto typesIt = this->componentTypeIndex.find(_entity);
+  if (typesIt == this->componentTypeIndex.end())
+    return;
+  auto typeIt = typesIt->second.find(_type);
+  if (typeIt == typesIt->second.end())
+    return;
 
-        // If there is a request to delete this entity, update the view as
-        // well
-        if (this->IsMarkedForRemoval(entity))
-          view->MarkEntityToRemove(entity);
-      }
-    }
-  }
+  std::lock_guard<std::mutex> lock(this->internedMutex);
+  auto &comp = this->componentStorage[_entity][typeIt->second];
+  if (!comp.get_deleter().interned)
+    return;
+
+  this->ReplaceComponent(_entity, comp, this->NewComponent(_type, comp.get()));
+  ++this->storageVersion;
 }
 
 //////////////////////////////////////////////////
-void EntityComponentManagerPrivate::SetRemovedComponentsMsgs(Entity &_entity,
-    msgs::SerializedEntity *_entityMsg,
-    const std::unordered_set<ComponentTypeId> &_types)
+void EntityComponentManagerPrivate::UninternComponents(
+    const ComponentTypeId _type)
 {
-  std::lock_guard<std::mutex> lock(this->removedComponentsMutex);
-  auto entRemovedCompsIter = this->removedComponents.find(_entity);
-  if (entRemovedCompsIter == this->removedComponents.end())
+  auto internedIt = this->internedComponents.find(_type);
+  if (internedIt == this->internedComponents.end() ||
+      0u == internedIt->second.count.load())
+  {
     return;
-  for (const auto &compType : entRemovedCompsIter->second)
+  }
+
+  GZ_PROFILE("EntityComponentManager::UninternComponents");
+  std::lock_guard<std::mutex> lock(this->internedMutex);
+  for (const auto &[entity, types] : this->componentTypeIndex)
   {
-    if (!_types.empty() && _types.find(compType) == _types.end())
-    {
+    const auto typeIter = types.find(_type);
+    if (typeIter == types.end())
       continue;
-    }
-
-    auto compMsg = _entityMsg->add_components();
 
-    // Empty data is needed for the component to be processed afterwards
-    compMsg->set_component(" ");
-    compMsg->set_type(compType);
-    compMsg->set_remove(true);
+    auto &comp = this->componentStorage[entity][typeIter->second];
+    if (comp.get_deleter().interned)
+    {
+      this->ReplaceComponent(entity, comp,
+          this->NewComponent(_type, comp.get()));
+    }
   }
+
+  // Handles look up the copies
+  ++this->storageVersion;
 }
 
 //////////////////////////////////////////////////
-void EntityComponentManagerPrivate::SetRemovedComponentsMsgs(Entity &_entity,
-    msgs::SerializedStateMap &_msg,
-    const std::unordered_set<ComponentTypeId> &_types)
+std::size_t EntityComponentManager::InternComponents(
+    const ComponentTypeId _type, const bool _newEntitiesOnly)
 {
-  std::lock_guard<std::mutex> lock(this->removedComponentsMutex);
-  auto entRemovedCompsIter = this->removedComponents.find(_entity);
-  if (entRemovedCompsIter == this->removedComponents.end())
-    return;
-  uint64_t nEntityKeys = entRemovedCompsIter->second.size();
-  if (nEntityKeys == 0)
-    return;
+  GZ_PROFILE("EntityComponentManager::InternComponents");
+  auto descriptor = components::Factory::Instance()->DataOps(_type);
+  if (nullptr == descriptor)
+    return 0u;
 
-  // The message need not necessarily contain the entity initially. For
-  // instance, when AddEntityToMessage() calls this function, the entity may
-  // have some removed components but none that changed,
-  // so the entity may not have been added to the message beforehand.
-  auto entIter = _msg.mutable_entities()->find(_entity);
-  if (entIter == _msg.mutable_entities()->end())
+  auto &interned = this->dataPtr->internedComponents[_type];
+  for (auto it = interned.instances.begin(); it != interned.instances.end();)
   {
-    msgs::SerializedEntityMap ent;
-    ent.set_id(_entity);
-    entIter =
-      (_msg.mutable_entities())->insert({static_cast<uint64_t>(_entity), ent})
-      .first;
+    if (it->second.expired())
+      it = interned.instances.erase(it);
+    else
+      ++it;
   }
 
-  for (const auto &compType : entRemovedCompsIter->second)
+  std::size_t count{0u};
+  auto intern = [&](const Entity _entity)
   {
-    if (!_types.empty() && _types.find(compType) == _types.end())
+    auto typesIt = this->dataPtr->componentTypeIndex.find(_entity);
+    if (typesIt == this->dataPtr->componentTypeIndex.end())
+      return;
+    auto typeIt = typesIt->second.find(_type);
+    if (typeIt == typesIt->second.end() ||
+        this->dataPtr->ComponentMarkedAsRemoved(_entity, _type))
     {
-      continue;
+      return;
     }
 
-    msgs::SerializedComponent compMsg;
+    // Components borrowed from a forked manager are left alone
+    auto &comp = this->dataPtr->componentStorage[_entity][typeIt->second];
+    if (!comp.get_deleter().owned)
+      return;
 
-    // Empty data is needed for the component to be processed afterwards
-    compMsg.set_component(" ");
-    compMsg.set_type(compType);
-    compMsg.set_remove(true);
+    auto key = descriptor->InternKey(comp.get());
+    if (key.empty())
+      return;
 
-    (*(entIter->second.mutable_components()))[
-      static_cast<int64_t>(compType)] = compMsg;
+    auto &instance = interned.instances[key];
+    auto shared = instance.lock();
+    if (nullptr == shared)
+    {
+      // The first component holding the data becomes the shared instance
+      auto deleter = comp.get_deleter();
+      shared = std::shared_ptr<components::BaseComponent>(comp.release(),
+          deleter);
+      instance = shared;
+      comp = ComponentPtr(shared.get(),
+          ComponentDeleter::Interned(shared, &interned.count));
+      return;
+    }
+
+    auto reference = shared.get();
+    this->dataPtr->ReplaceComponent(_entity, comp, ComponentPtr(reference,
+        ComponentDeleter::Interned(std::move(shared), &interned.count)));
+    ++count;
+  };
+
+  if (_newEntitiesOnly)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+    for (const Entity entity : this->dataPtr->newlyCreatedEntities)
+      intern(entity);
+  }
+  else
+  {
+    for (const auto &entityTypes : this->dataPtr->componentTypeIndex)
+      intern(entityTypes.first);
+  }
+
+  // Handles look up the shared instances
+  ++this->dataPtr->storageVersion;
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t EntityComponentManager::StorageVersion() const
+{
+  return this->dataPtr->storageVersion;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t EntityComponentManager::CreationVersion() const
+{
+  return this->dataPtr->creationVersion;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::ChildEntities(
+    const Entity _parent) const
+{
+  return this->dataPtr->entities.Children(_parent);
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::MarkNameChanged(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  this->dataPtr->MarkNameChanged(_entity, _typeId);
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::EntitiesByName(
+    const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->nameIndexMutex);
+  this->dataPtr->UpdateNameIndex(*this);
+  const auto &byName = this->dataPtr->nameIndex.byName;
+  auto it = byName.find(_name);
+  if (it == byName.end())
+    return {};
+  return {it->second.begin(), it->second.end()};
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::ChildrenByName(Entity _parent,
+    const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->nameIndexMutex);
+  this->dataPtr->UpdateNameIndex(*this);
+  const auto &byParentName = this->dataPtr->nameIndex.byParentName;
+  auto it = byParentName.find({_parent, _name});
+  if (it == byParentName.end())
+    return {};
+  return {it->second.begin(), it->second.end()};
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::AllEntities() const
+{
+  return this->dataPtr->entities.Entities();
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::HasComponentType(
+    const ComponentTypeId _typeId) const
+{
+  return this->dataPtr->createdCompTypes.find(_typeId) !=
+    this->dataPtr->createdCompTypes.end();
+}
+
+//////////////////////////////////////////////////
+const EntityGraph &EntityComponentManager::Entities() const
+{
+  GZ_PROFILE("EntityComponentManager::Entities");
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityGraphMutex);
+  const auto version = this->dataPtr->entities.Version();
+  if (this->dataPtr->entityGraphVersion != version)
+  {
+    this->dataPtr->entities.BuildGraph(this->dataPtr->entityGraph);
+    this->dataPtr->entityGraphVersion = version;
+  }
+  return this->dataPtr->entityGraph;
+}
+
+//////////////////////////////////////////////////
+std::pair<detail::BaseView *, std::mutex *> EntityComponentManager::FindView(
+    const std::vector<ComponentTypeId> &_types) const
+{
+  // Views must hold the entities inserted so far, even during a bulk insert
+  this->AddBulkEntitiesToViews();
+
+  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+  std::pair<detail::BaseView *, std::mutex *> viewMutexPair(nullptr, nullptr);
+  auto iter = this->dataPtr->views.find(_types);
+  if (iter != this->dataPtr->views.end())
+  {
+    viewMutexPair.first = iter->second.first.get();
+    viewMutexPair.second = iter->second.second.get();
+  }
+  return viewMutexPair;
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityComponentManager::NextViewCacheSlot()
+{
+  static std::atomic<std::size_t> nextSlot{0};
+  return nextSlot++;
+}
+
+//////////////////////////////////////////////////
+std::pair<detail::BaseView *, std::mutex *>
+EntityComponentManager::CachedView(std::size_t _slot) const
+{
+  // Views must hold the entities inserted so far, even during a bulk insert
+  this->AddBulkEntitiesToViews();
+
+  if (_slot >= kViewCacheSlots)
+    return {nullptr, nullptr};
+
+  // The mutex is stored before the view, so it's valid once the view is set
+  const auto &entry = this->dataPtr->cachedViews[_slot];
+  detail::BaseView *view = entry.view.load(std::memory_order_acquire);
+  if (nullptr == view)
+    return {nullptr, nullptr};
+  return {view, entry.mutex.load(std::memory_order_relaxed)};
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::CacheView(std::size_t _slot,
+    const std::pair<detail::BaseView *, std::mutex *> &_viewMutexPair) const
+{
+  if (_slot >= kViewCacheSlots)
+    return;
+
+  auto &entry = this->dataPtr->cachedViews[_slot];
+  entry.mutex.store(_viewMutexPair.second, std::memory_order_relaxed);
+  entry.view.store(_viewMutexPair.first, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManagerPrivate::ClearCachedViews()
+{
+  for (std::size_t i = 0; i < kViewCacheSlots; ++i)
+  {
+    this->cachedViews[i].view.store(nullptr, std::memory_order_relaxed);
+    this->cachedViews[i].mutex.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+//////////////////////////////////////////////////
+detail::BaseView *EntityComponentManager::AddView(
+    const detail::ComponentTypeKey &_types,
+    std::unique_ptr<detail::BaseView> _view) const
+{
+  // If the view already exists, then the map will return the iterator to
+  // the location that prevented the insertion.
+  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+  auto iter = this->dataPtr->views.insert(std::make_pair(_types,
+        std::make_pair(std::move(_view),
+          std::make_unique<std::mutex>()))).first;
+  return iter->second.first.get();
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::RebuildViews()
+{
+  GZ_PROFILE("EntityComponentManager::RebuildViews");
+  this->dataPtr->bulkEntities.clear();
+  for (auto &viewPair : this->dataPtr->views)
+  {
+    auto &view = viewPair.second.first;
+    view->Reset();
+
+    // Add all the entities that match the component types to the
+    // view.
+    for (const Entity entity : this->dataPtr->entities.TopologicalOrder())
+    {
+      if (this->EntityMatches(entity, view->ComponentTypes()))
+      {
+        view->MarkEntityToAdd(entity, this->IsNewEntity(entity));
+
+        // If there is a request to delete this entity, update the view as
+        // well
+        if (this->IsMarkedForRemoval(entity))
+          view->MarkEntityToRemove(entity);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SetRemovedComponentsMsgs(Entity &_entity,
+    msgs::SerializedEntity *_entityMsg,
+    const std::unordered_set<ComponentTypeId> &_types)
+{
+  std::lock_guard<std::mutex> lock(this->removedComponentsMutex);
+  auto entRemovedCompsIter = this->removedComponents.find(_entity);
+  if (entRemovedCompsIter == this->removedComponents.end())
+    return;
+  for (const auto &compType : entRemovedCompsIter->second)
+  {
+    if (!_types.empty() && _types.find(compType) == _types.end())
+    {
+      continue;
+    }
+
+    auto compMsg = _entityMsg->add_components();
+
+    // Empty data is needed for the component to be processed afterwards
+    compMsg->set_component(" ");
+    compMsg->set_type(compType);
+    compMsg->set_remove(true);
+  }
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SetRemovedComponentsMsgs(Entity &_entity,
+    msgs::SerializedStateMap &_msg,
+    const std::unordered_set<ComponentTypeId> &_types)
+{
+  std::lock_guard<std::mutex> lock(this->removedComponentsMutex);
+  auto entRemovedCompsIter = this->removedComponents.find(_entity);
+  if (entRemovedCompsIter == this->removedComponents.end())
+    return;
+  uint64_t nEntityKeys = entRemovedCompsIter->second.size();
+  if (nEntityKeys == 0)
+    return;
+
+  // The message need not necessarily contain the entity initially. For
+  // instance, when AddEntityToMessage() calls this function, the entity may
+  // have some removed components but none that changed,
+  // so the entity may not have been added to the message beforehand.
+  auto entIter = _msg.mutable_entities()->find(_entity);
+  if (entIter == _msg.mutable_entities()->end())
+  {
+    msgs::SerializedEntityMap ent;
+    ent.set_id(_entity);
+    entIter =
+      (_msg.mutable_entities())->insert({static_cast<uint64_t>(_entity), ent})
+      .first;
+  }
+
+  for (const auto &compType : entRemovedCompsIter->second)
+  {
+    if (!_types.empty() && _types.find(compType) == _types.end())
+    {
+      continue;
+    }
+
+    msgs::SerializedComponent compMsg;
+
+    // Empty data is needed for the component to be processed afterwards
+    compMsg.set_component(" ");
+    compMsg.set_type(compType);
+    compMsg.set_remove(true);
+
+    (*(entIter->second.mutable_components()))[
+      static_cast<int64_t>(compType)] = compMsg;
   }
 }
 
@@ -1454,10 +2749,7 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedState &_msg,
     auto compMsg = entityMsg->add_components();
     compMsg->set_type(compBase->TypeId());
 
-    std::ostringstream ostr;
-    compBase->Serialize(ostr);
-
-    compMsg->set_component(ostr.str());
+    SerializeComponent(*compBase, *compMsg->mutable_component());
   }
 
   // Add a component to the message and set it to be removed if the component
@@ -1520,30 +2812,8 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
       this->ComponentImplementation(_entity, type);
 
     // If not sending full state, skip unchanged components
-    if (!_full)
-    {
-      bool noChange = true;
-
-      // see if the entity has a component of this particular type marked as a
-      // one time change
-      auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(type);
-      if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end() &&
-          oneTimeIter->second.find(_entity) != oneTimeIter->second.end())
-        noChange = false;
-
-      if (noChange)
-      {
-        // see if the entity has a component of this particular type marked as a
-        // periodic change
-        auto periodicIter = this->dataPtr->periodicChangedComponents.find(type);
-        if (periodicIter != this->dataPtr->periodicChangedComponents.end() &&
-            periodicIter->second.find(_entity) != periodicIter->second.end())
-          noChange = false;
-      }
-
-      if (noChange)
-        continue;
-    }
+    if (!_full && !this->dataPtr->ComponentChanged(_entity, type))
+      continue;
 
     /// Find the entity in the message, if not already found.
     /// Add the entity to the message, if not already added.
@@ -1572,9 +2842,7 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
     }
 
     // Serialize and store the message
-    std::ostringstream ostr;
-    compBase->Serialize(ostr);
-    compIter->second.set_component(ostr.str());
+    SerializeComponent(*compBase, *compIter->second.mutable_component());
   }
 
   // Add a component to the message and set it to be removed if the component
@@ -1612,23 +2880,74 @@ msgs::SerializedState EntityComponentManager::ChangedState() const
 void EntityComponentManager::ChangedState(
     msgs::SerializedStateMap &_state) const
 {
-  // New entities
-  for (const auto &entity : this->dataPtr->newlyCreatedEntities)
+  auto serialize = [this](msgs::SerializedStateMap &_msg)
+  {
+    // New entities
+    for (const auto &entity : this->dataPtr->newlyCreatedEntities)
+    {
+      this->AddEntityToMessage(_msg, entity);
+    }
+
+    // Entities being removed
+    for (const auto &entity : this->dataPtr->toRemoveEntities)
+    {
+      this->AddEntityToMessage(_msg, entity);
+    }
+
+    // New / removed / changed components
+    for (const auto &entity : this->dataPtr->modifiedComponents)
+    {
+      this->AddEntityToMessage(_msg, entity);
+    }
+  };
+
+  if (!this->dataPtr->cacheChangedState)
   {
-    this->AddEntityToMessage(_state, entity);
+    serialize(_state);
+    return;
   }
 
-  // Entities being removed
-  for (const auto &entity : this->dataPtr->toRemoveEntities)
+  // Serialize once and share the result with the other callers
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedStateCacheMutex);
+  auto &cache = this->dataPtr->changedStateCache;
+  if (!cache)
   {
-    this->AddEntityToMessage(_state, entity);
+    GZ_PROFILE("EntityComponentManager::ChangedState Serialize");
+    cache.emplace();
+    serialize(*cache);
   }
+  _state.MergeFrom(*cache);
+}
 
-  // New / removed / changed components
-  for (const auto &entity : this->dataPtr->modifiedComponents)
+//////////////////////////////////////////////////
+void EntityComponentManager::ChangedState(
+    msgs::SerializedStateMap &_state,
+    const std::unordered_set<Entity> &_entities,
+    const std::unordered_set<ComponentTypeId> &_types) const
+{
+  if (_entities.empty() && _types.empty())
   {
-    this->AddEntityToMessage(_state, entity);
+    this->ChangedState(_state);
+    return;
   }
+
+  auto add = [&](const Entity _entity)
+  {
+    if (_entities.empty() || _entities.find(_entity) != _entities.end())
+      this->AddEntityToMessage(_state, _entity, _types);
+  };
+
+  // New entities
+  for (const auto &entity : this->dataPtr->newlyCreatedEntities)
+    add(entity);
+
+  // Entities being removed
+  for (const auto &entity : this->dataPtr->toRemoveEntities)
+    add(entity);
+
+  // New / removed / changed components
+  for (const auto &entity : this->dataPtr->modifiedComponents)
+    add(entity);
 }
 
 //////////////////////////////////////////////////
@@ -1779,9 +3098,7 @@ void EntityComponentManager::PeriodicStateFromCache(
       // Add the component to the message
       msgs::SerializedComponent cmp;
       cmp.set_type(comp->TypeId());
-      std::ostringstream ostr;
-      comp->Serialize(ostr);
-      cmp.set_component(ostr.str());
+      SerializeComponent(*comp, *cmp.mutable_component());
       (*(entIter->second.mutable_components()))[
       static_cast<int64_t>(typeId)] = cmp;
     }
@@ -1855,8 +3172,6 @@ void EntityComponentManager::SetState(
       // Create if new
       if (nullptr == comp)
       {
-        std::istringstream istr(compMsg.component());
-
         auto newComp = components::Factory::Instance()->New(type);
         if (nullptr == newComp)
         {
@@ -1864,7 +3179,7 @@ void EntityComponentManager::SetState(
             << compMsg.type() << "]" << std::endl;
           continue;
         }
-        newComp->Deserialize(istr);
+        DeserializeComponent(*newComp, compMsg.component());
 
         auto updateData =
           this->CreateComponentImplementation(entity, type, newComp.get());
@@ -1878,9 +3193,9 @@ void EntityComponentManager::SetState(
       // Update component value
       if (comp)
       {
-        std::istringstream istr(compMsg.component());
-        comp->Deserialize(istr);
+        DeserializeComponent(*comp, compMsg.component());
         this->dataPtr->AddModifiedComponent(entity);
+        this->dataPtr->MarkNameChanged(entity, type);
       }
     }
   }
@@ -1891,15 +3206,54 @@ void EntityComponentManager::SetState(
     const msgs::SerializedStateMap &_stateMsg)
 {
   GZ_PROFILE("EntityComponentManager::SetState Map");
-  // Create / remove / update entities
-  for (const auto &iter : _stateMsg.entities())
+
+  /// \brief Component of the message whose data is deserialized before
+  /// it's added, concurrently with the others if its type allows it.
+  struct StagedComponent
   {
-    const auto &entityMsg = iter.second;
+    /// \brief Entity of the component.
+    Entity entity;
 
-    Entity entity{entityMsg.id()};
+    /// \brief Message of the component.
+    const msgs::SerializedComponent *msg;
 
-    // Remove entity
-    if (entityMsg.remove())
+    /// \brief Descriptor of the component type.
+    const components::ComponentDescriptorBase *desc;
+
+    /// \brief Existing component to deserialize into, or nullptr if the
+    /// component is new.
+    components::BaseComponent *existing;
+
+    /// \brief New component, deserialized before being added.
+    std::unique_ptr<components::BaseComponent> created;
+
+    /// \brief True if it's deserialized on the worker threads.
+    bool concurrent;
+  };
+  auto deserialize = [](StagedComponent &_component)
+  {
+    if (nullptr == _component.existing)
+    {
+      _component.created = _component.desc->Create();
+      DeserializeComponent(*_component.created, _component.msg->component());
+    }
+    else
+    {
+      DeserializeComponent(*_component.existing, _component.msg->component());
+    }
+  };
+  std::vector<StagedComponent> staged;
+
+  // Create / remove entities and components, and find the components to
+  // deserialize
+  for (const auto &iter : _stateMsg.entities())
+  {
+    const auto &entityMsg = iter.second;
+
+    Entity entity{entityMsg.id()};
+
+    // Remove entity
+    if (entityMsg.remove())
     {
       this->RequestRemoveEntity(entity);
       continue;
@@ -1911,8 +3265,7 @@ void EntityComponentManager::SetState(
       this->dataPtr->CreateEntityImplementation(entity);
     }
 
-    // Create / remove / update components
-    for (const auto &compIter : iter.second.components())
+    for (const auto &compIter : entityMsg.components())
     {
       const auto &compMsg = compIter.second;
 
@@ -1920,7 +3273,8 @@ void EntityComponentManager::SetState(
 
       // Components which haven't been registered in this process, such as 3rd
       // party components streamed to other secondaries and the GUI.
-      if (!components::Factory::Instance()->HasType(type))
+      const auto *desc = components::Factory::Instance()->Descriptor(type);
+      if (nullptr == desc)
       {
         static std::unordered_set<unsigned int> printedComps;
         if (printedComps.find(type) == printedComps.end())
@@ -1940,46 +3294,272 @@ void EntityComponentManager::SetState(
         continue;
       }
 
-      // Get Component
-      components::BaseComponent *comp =
-        this->ComponentImplementation(entity, compIter.first);
+      // Existing components are unshared here, so the workers only write
+      // their data. Components live in their own allocations, so the
+      // pointers stay valid while new ones are added.
+      staged.push_back({entity, &compMsg, desc,
+          this->CreatedComponentImplementation(entity, compIter.first),
+          nullptr, ConcurrentlyDeserializable(compIter.first)});
+    }
+  }
 
-      // Create if new
-      if (nullptr == comp)
+  // Deserialize the plain values concurrently, since they dominate the
+  // cost of large states, and the rest on this thread
+  this->ParallelFor(staged.size(), 0u,
+      [&staged, &deserialize](std::size_t _begin, std::size_t _end)
       {
-        std::istringstream istr(compMsg.component());
-
-        // Create component
-        auto newComp = components::Factory::Instance()->New(compMsg.type());
-        if (nullptr == newComp)
+        for (std::size_t i = _begin; i < _end; ++i)
         {
-          gzerr << "Failed to create component of type [" << compMsg.type()
-            << "]" << std::endl;
-          continue;
+          if (staged[i].concurrent)
+            deserialize(staged[i]);
         }
-        newComp->Deserialize(istr);
+      });
+  for (auto &component : staged)
+  {
+    if (!component.concurrent)
+      deserialize(component);
+  }
 
-        auto updateData = this->CreateComponentImplementation(
-          entity, newComp->TypeId(), newComp.get());
-        if (updateData)
-        {
-          // Set comp so we deserialize the data below again
-          comp = this->ComponentImplementation(entity, compIter.first);
-        }
+  // Add the new components and mark the updated ones as changed, in the
+  // order of the message
+  const auto changeState = _stateMsg.has_one_time_component_changes() ?
+      ComponentState::OneTimeChange : ComponentState::PeriodicChange;
+  for (auto &component : staged)
+  {
+    const auto type = component.msg->type();
+    if (nullptr != component.created)
+    {
+      if (!this->CreateComponentImplementation(component.entity, type,
+          component.created.get()))
+      {
+        continue;
       }
 
-      // Update component value
-      if (comp)
+      // A removed component is being added back, and it still holds its
+      // previous value, so deserialize the data into it again
+      component.existing =
+          this->CreatedComponentImplementation(component.entity, type);
+      if (nullptr == component.existing)
+        continue;
+      DeserializeComponent(*component.existing, component.msg->component());
+    }
+    this->SetChanged(component.entity, type, changeState);
+  }
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::AddEntityToSnapshot(StateSnapshotWriter &_writer,
+    Entity _entity, const std::unordered_set<ComponentTypeId> &_types,
+    bool _full) const
+{
+  auto iter = this->dataPtr->componentTypeIndex.find(_entity);
+  if (iter == this->dataPtr->componentTypeIndex.end())
+    return;
+
+  // The components of removed entities are not needed by the receiver
+  if (this->dataPtr->toRemoveEntities.find(_entity) !=
+      this->dataPtr->toRemoveEntities.end())
+  {
+    _writer.AddRemovedEntity(_entity);
+    return;
+  }
+
+  auto storageIter = this->dataPtr->componentStorage.find(_entity);
+  if (storageIter == this->dataPtr->componentStorage.end())
+    return;
+
+  for (const auto &[type, index] : iter->second)
+  {
+    if (!_types.empty() && _types.find(type) == _types.end())
+      continue;
+
+    if (this->dataPtr->ComponentMarkedAsRemoved(_entity, type))
+      continue;
+
+    // If not sending full state, skip unchanged components
+    if (!_full && !this->dataPtr->ComponentChanged(_entity, type))
+      continue;
+
+    const components::BaseComponent *compBase =
+      storageIter->second[index].get();
+    if (nullptr != compBase)
+      _writer.AddComponent(_entity, compBase);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->removedComponentsMutex);
+  auto removedIter = this->dataPtr->removedComponents.find(_entity);
+  if (removedIter == this->dataPtr->removedComponents.end())
+    return;
+  for (const auto &type : removedIter->second)
+  {
+    if (_types.empty() || _types.find(type) != _types.end())
+      _writer.AddRemovedComponent(_entity, type);
+  }
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::ChangedStateSnapshot(
+    std::vector<std::uint8_t> &_buffer) const
+{
+  GZ_PROFILE("EntityComponentManager::ChangedStateSnapshot");
+  StateSnapshotWriter writer(_buffer);
+  writer.SetOneTimeChanges(this->HasOneTimeComponentChanges());
+
+  // An entity may be in more than one of these sets, but it must only be
+  // written once
+  const auto &created = this->dataPtr->newlyCreatedEntities;
+  const auto &removed = this->dataPtr->toRemoveEntities;
+
+  // New entities
+  for (const auto &entity : created)
+  {
+    this->AddEntityToSnapshot(writer, entity);
+  }
+
+  // Entities being removed
+  for (const auto &entity : removed)
+  {
+    if (created.find(entity) == created.end())
+      this->AddEntityToSnapshot(writer, entity);
+  }
+
+  // New / removed / changed components
+  for (const auto &entity : this->dataPtr->modifiedComponents)
+  {
+    if (created.find(entity) == created.end() &&
+        removed.find(entity) == removed.end())
+    {
+      this->AddEntityToSnapshot(writer, entity);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::StateSnapshot(
+    std::vector<std::uint8_t> &_buffer,
+    const std::unordered_set<Entity> &_entities,
+    const std::unordered_set<ComponentTypeId> &_types,
+    bool _full) const
+{
+  GZ_PROFILE("EntityComponentManager::StateSnapshot");
+  StateSnapshotWriter writer(_buffer);
+  writer.SetOneTimeChanges(this->HasOneTimeComponentChanges());
+
+  for (const auto &it : this->dataPtr->componentTypeIndex)
+  {
+    if (_entities.empty() || _entities.find(it.first) != _entities.end())
+      this->AddEntityToSnapshot(writer, it.first, _types, _full);
+  }
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::SetStateSnapshot(const std::uint8_t *_data,
+    std::size_t _size)
+{
+  GZ_PROFILE("EntityComponentManager::SetStateSnapshot");
+  StateSnapshotReader reader(_data, _size);
+  if (!reader.Valid())
+    return false;
+
+  const auto changeState = reader.OneTimeChanges() ?
+      ComponentState::OneTimeChange : ComponentState::PeriodicChange;
+
+  // Entities may come before their parents, so their place in the graph is
+  // only updated once all entities exist
+  std::vector<Entity> reparented;
+
+  StateSnapshotRecord record;
+  while (reader.Next(record))
+  {
+    const Entity entity = record.entity;
+
+    // Remove entity
+    if (record.type == StateSnapshotRecordType::RemovedEntity)
+    {
+      this->RequestRemoveEntity(entity);
+      continue;
+    }
+
+    // Create entity if it doesn't exist
+    if (!this->HasEntity(entity))
+    {
+      this->dataPtr->CreateEntityImplementation(entity);
+    }
+
+    // Components which haven't been registered in this process, such as 3rd
+    // party components streamed to other secondaries and the GUI.
+    const auto *desc =
+      components::Factory::Instance()->Descriptor(record.typeId);
+    if (nullptr == desc)
+    {
+      static std::unordered_set<ComponentTypeId> printedComps;
+      if (printedComps.insert(record.typeId).second)
       {
-        std::istringstream istr(compMsg.component());
-        comp->Deserialize(istr);
-        this->SetChanged(entity, compIter.first,
-            _stateMsg.has_one_time_component_changes() ?
-            ComponentState::OneTimeChange :
-            ComponentState::PeriodicChange);
+        gzwarn << "Component type [" << record.typeId << "] has not been "
+                << "registered in this process, so it can't be deserialized."
+                << std::endl;
       }
+      continue;
+    }
+    const auto *ops =
+      components::Factory::Instance()->DataOps(record.typeId);
+
+    // Remove component
+    if (record.type == StateSnapshotRecordType::RemovedComponent)
+    {
+      this->RemoveComponent(entity, record.typeId);
+      continue;
     }
+
+    if (record.typeId == components::ParentEntity::typeId)
+      reparented.push_back(entity);
+
+    // Get Component
+    components::BaseComponent *comp =
+      this->ComponentImplementation(entity, record.typeId);
+
+    // Create if new
+    if (nullptr == comp)
+    {
+      auto newComp = desc->Create();
+      if (!StateSnapshotReader::ReadComponent(record, ops, newComp.get()))
+      {
+        gzerr << "Failed to read component of type [" << record.typeId
+              << "] from state snapshot" << std::endl;
+        continue;
+      }
+
+      auto updateData = this->CreateComponentImplementation(
+        entity, record.typeId, newComp.get());
+      if (!updateData)
+        continue;
+
+      // A removed component is being added back, and it still holds its
+      // previous value, so read the data into it below
+      comp = this->ComponentImplementation(entity, record.typeId);
+    }
+
+    // Update component value
+    if (comp)
+    {
+      if (!StateSnapshotReader::ReadComponent(record, ops, comp))
+      {
+        gzerr << "Failed to read component of type [" << record.typeId
+              << "] from state snapshot" << std::endl;
+        continue;
+      }
+      this->SetChanged(entity, record.typeId, changeState);
+    }
+  }
+
+  for (const auto entity : reparented)
+  {
+    auto parentComp = this->Component<components::ParentEntity>(entity);
+    if (parentComp && this->ParentEntity(entity) != parentComp->Data())
+      this->SetParentEntity(entity, parentComp->Data());
   }
+
+  return reader.Valid();
 }
 
 //////////////////////////////////////////////////
@@ -1998,8 +3578,7 @@ std::unordered_set<Entity> EntityComponentManager::Descendants(Entity _entity)
   if (!this->HasEntity(_entity))
     return descendants;
 
-  auto descVector = math::graph::BreadthFirstSort(this->dataPtr->entities,
-      _entity);
+  auto descVector = this->dataPtr->entities.Descendants(_entity);
   std::move(descVector.begin(), descVector.end(), std::inserter(descendants,
       descendants.end()));
 
@@ -2007,6 +3586,84 @@ std::unordered_set<Entity> EntityComponentManager::Descendants(Entity _entity)
   return descendants;
 }
 
+//////////////////////////////////////////////////
+void EntityComponentManagerPrivate::AddMemoryUsage(const Entity _entity,
+    const std::function<ComponentMemoryUsage &(ComponentTypeId)> &_usage,
+    std::unordered_set<const components::BaseComponent *> &_shared) const
+{
+  auto typesIt = this->componentTypeIndex.find(_entity);
+  auto storageIt = this->componentStorage.find(_entity);
+  if (typesIt == this->componentTypeIndex.end() ||
+      storageIt == this->componentStorage.end())
+  {
+    return;
+  }
+
+  auto factory = components::Factory::Instance();
+  for (const auto &[typeId, index] : typesIt->second)
+  {
+    if (this->ComponentMarkedAsRemoved(_entity, typeId))
+      continue;
+
+    const auto &comp = storageIt->second[index];
+    const auto *component = comp.get();
+    auto descriptor = factory->DataOps(typeId);
+    auto &usage = _usage(typeId);
+    ++usage.count;
+    if (comp.get_deleter().interned && !_shared.insert(component).second)
+      continue;
+    if (nullptr != descriptor)
+    {
+      usage.bytes += descriptor->Size();
+      usage.heapBytes += descriptor->HeapSize(component);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::map<ComponentTypeId, ComponentMemoryUsage>
+    EntityComponentManager::ComponentMemoryUsageByType() const
+{
+  std::map<ComponentTypeId, ComponentMemoryUsage> result;
+  std::unordered_set<const components::BaseComponent *> shared;
+  for (const auto &entityTypes : this->dataPtr->componentTypeIndex)
+  {
+    this->dataPtr->AddMemoryUsage(entityTypes.first,
+        [&result](ComponentTypeId _typeId) -> ComponentMemoryUsage &
+        {
+          return result[_typeId];
+        }, shared);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::map<Entity, ComponentMemoryUsage>
+    EntityComponentManager::ComponentMemoryUsageByModel() const
+{
+  std::map<Entity, ComponentMemoryUsage> result;
+  std::unordered_set<const components::BaseComponent *> shared;
+  for (const auto &entityTypes : this->dataPtr->componentTypeIndex)
+  {
+    // Walk up to the outermost model, if the entity is in one
+    Entity model{kNullEntity};
+    for (Entity entity = entityTypes.first; kNullEntity != entity;
+        entity = this->ParentEntity(entity))
+    {
+      if (this->EntityHasComponentType(entity, components::Model::typeId))
+        model = entity;
+    }
+
+    auto &usage = result[model];
+    this->dataPtr->AddMemoryUsage(entityTypes.first,
+        [&usage](ComponentTypeId) -> ComponentMemoryUsage &
+        {
+          return usage;
+        }, shared);
+  }
+  return result;
+}
+
 //////////////////////////////////////////////////
 void EntityComponentManager::SetAllComponentsUnchanged()
 {
@@ -2030,6 +3687,9 @@ void EntityComponentManager::SetChanged(
       this->dataPtr->ComponentMarkedAsRemoved(_entity, _type))
     return;
 
+  // Systems that run concurrently may mark the components they write as
+  // changed at the same time.
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
   if (_c == ComponentState::PeriodicChange)
   {
     this->dataPtr->periodicChangedComponents[_type].insert(_entity);
@@ -2058,6 +3718,7 @@ void EntityComponentManager::SetChanged(
     return;
   }
 
+  this->dataPtr->StampComponent(_entity, _type);
   this->dataPtr->AddModifiedComponent(_entity);
 }
 
@@ -2092,6 +3753,52 @@ void EntityComponentManager::SetEntityCreateOffset(uint64_t _offset)
   this->dataPtr->entityCount = _offset;
 }
 
+//////////////////////////////////////////////////
+uint64_t EntityComponentManager::EntityCreateOffset() const
+{
+  return this->dataPtr->entityCount;
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::SetEntityIdRecycling(bool _recycle)
+{
+  if (_recycle == this->dataPtr->recycleEntityIds)
+    return true;
+
+  // Only the entities created from now on get indices, and an offset may
+  // have been set already
+  if (this->EntityCount() > 0)
+  {
+    gzerr << "Entity ID recycling can only be changed before entities are "
+          << "created." << std::endl;
+    return false;
+  }
+
+  this->dataPtr->recycleEntityIds = _recycle;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::EntityIdRecycling() const
+{
+  return this->dataPtr->recycleEntityIds;
+}
+
+//////////////////////////////////////////////////
+std::optional<std::size_t> EntityComponentManager::EntityIndex(
+    const Entity _entity) const
+{
+  if (!this->dataPtr->recycleEntityIds)
+    return std::nullopt;
+  return this->dataPtr->entityIndexAllocator.Index(_entity);
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityComponentManager::EntityIndexCapacity() const
+{
+  return this->dataPtr->entityIndexAllocator.Capacity();
+}
+
 /////////////////////////////////////////////////
 void EntityComponentManager::LockAddingEntitiesToViews(bool _lock)
 {
@@ -2104,6 +3811,281 @@ bool EntityComponentManager::LockAddingEntitiesToViews() const
   return this->dataPtr->lockAddEntitiesToViews;
 }
 
+/////////////////////////////////////////////////
+void EntityComponentManager::CacheChangedState(bool _cache)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->changedStateCacheMutex);
+  this->dataPtr->cacheChangedState = _cache;
+  this->dataPtr->changedStateCache.reset();
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::CacheWorldPoses(bool _cache)
+{
+  std::unique_lock<std::shared_mutex> lock(
+      this->dataPtr->worldPoseCacheMutex);
+  this->dataPtr->cacheWorldPoses = _cache;
+  this->dataPtr->worldPoseCache.clear();
+}
+
+/////////////////////////////////////////////////
+std::optional<math::Pose3d> EntityComponentManager::WorldPose(
+    const Entity _entity) const
+{
+  if (!this->dataPtr->cacheWorldPoses)
+  {
+    auto poseComp = this->Component<components::Pose>(_entity);
+    if (nullptr == poseComp)
+      return std::nullopt;
+
+    // work out pose in world frame
+    math::Pose3d pose = poseComp->Data();
+    auto p = this->Component<components::ParentEntity>(_entity);
+    while (p)
+    {
+      // get pose of parent entity
+      auto parentPose = this->Component<components::Pose>(p->Data());
+      if (!parentPose)
+        break;
+      // transform pose
+      pose = parentPose->Data() * pose;
+      // keep going up the tree
+      p = this->Component<components::ParentEntity>(p->Data());
+    }
+    return pose;
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> lock(
+        this->dataPtr->worldPoseCacheMutex);
+    auto it = this->dataPtr->worldPoseCache.find(_entity);
+    if (it != this->dataPtr->worldPoseCache.end())
+      return it->second;
+  }
+
+  auto poseComp = this->Component<components::Pose>(_entity);
+  if (nullptr == poseComp)
+    return std::nullopt;
+
+  std::unique_lock<std::shared_mutex> lock(
+      this->dataPtr->worldPoseCacheMutex);
+  auto &cache = this->dataPtr->worldPoseCache;
+
+  // Walk up until an ancestor whose world pose is known, or the root
+  std::vector<const components::Pose *> chain{poseComp};
+  std::vector<Entity> chainEntities{_entity};
+  math::Pose3d pose;
+  auto p = this->Component<components::ParentEntity>(_entity);
+  while (p)
+  {
+    auto it = cache.find(p->Data());
+    if (it != cache.end())
+    {
+      pose = it->second;
+      break;
+    }
+    auto parentPose = this->Component<components::Pose>(p->Data());
+    if (!parentPose)
+      break;
+    chain.push_back(parentPose);
+    chainEntities.push_back(p->Data());
+    p = this->Component<components::ParentEntity>(p->Data());
+  }
+
+  // Compose the poses from the top down, so that every ancestor is cached
+  // for its other descendants
+  for (std::size_t i = chain.size(); i > 0; --i)
+  {
+    pose = pose * chain[i - 1]->Data();
+    cache[chainEntities[i - 1]] = pose;
+  }
+  return pose;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::AddPendingEntitiesToViews()
+{
+  GZ_PROFILE("EntityComponentManager::AddPendingEntitiesToViews");
+  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+
+  std::vector<const components::BaseComponent *> data;
+  for (auto &[viewKey, viewPair] : this->dataPtr->views)
+  {
+    auto view = static_cast<detail::View *>(viewPair.first.get());
+    if (view->ToAddEntities().empty())
+      continue;
+
+    // The view key holds the component types in the same order as the view
+    // stores their data.
+    data.resize(viewKey.size());
+    const auto &constThis = *this;
+    for (const auto &[entity, isNew] : view->ToAddEntities())
+    {
+      // Reading the components doesn't stop them from being shared
+      for (std::size_t i = 0; i < viewKey.size(); ++i)
+        data[i] = constThis.ComponentImplementation(entity, viewKey[i]);
+      view->AddEntity(entity, isNew, data.data());
+    }
+    view->ClearToAddEntities();
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::StampComponent(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  const std::uint64_t version = ++this->changeVersion;
+  this->componentVersions[_typeId][_entity] = version;
+  this->typeVersions[_typeId] = version;
+  this->MarkNameChanged(_entity, _typeId);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::RecordRemoval(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  if (_typeId != kComponentTypeIdInvalid)
+  {
+    auto versionsIter = this->componentVersions.find(_typeId);
+    if (versionsIter != this->componentVersions.end())
+      versionsIter->second.erase(_entity);
+  }
+
+  this->removalHistory.push_back({++this->changeVersion, _entity, _typeId});
+  this->MarkNameChanged(_entity, _typeId);
+  if (this->removalHistory.size() > kRemovalHistorySize)
+  {
+    this->removalHistoryStart = this->removalHistory.front().version;
+    this->removalHistory.pop_front();
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::MarkNameChanged(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  if (_typeId != kComponentTypeIdInvalid &&
+      _typeId != components::Name::typeId &&
+      _typeId != components::ParentEntity::typeId)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->nameIndexMutex);
+  if (!this->nameIndex.built)
+    return;
+
+  // Rebuilding is cheaper than catching up with a long backlog
+  if (this->nameIndex.dirty.size() > this->nameIndex.keys.size() + 1024u)
+  {
+    this->nameIndex = NameIndex();
+    return;
+  }
+  this->nameIndex.dirty.push_back(_entity);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::ClearNameIndex()
+{
+  std::lock_guard<std::mutex> lock(this->nameIndexMutex);
+  this->nameIndex = NameIndex();
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::UpdateNameIndex(
+    const EntityComponentManager &_ecm) const
+{
+  auto &index = this->nameIndex;
+
+  // Writes through pointers aren't marked, so the index can't follow them
+  const std::uint64_t pointerWrites =
+      this->namePointerWrites.load(std::memory_order_relaxed);
+  if (index.built && index.pointerWrites != pointerWrites)
+    index = NameIndex();
+
+  auto add = [&](const Entity _entity)
+  {
+    const auto *name = _ecm.Component<components::Name>(_entity);
+    if (nullptr == name)
+      return;
+    const auto *parent = _ecm.Component<components::ParentEntity>(_entity);
+    std::pair<Entity, std::string> key{
+        nullptr == parent ? kNullEntity : parent->Data(), name->Data()};
+    index.byName[key.second].insert(_entity);
+    index.byParentName[key].insert(_entity);
+    index.keys.emplace(_entity, std::move(key));
+  };
+
+  if (!index.built)
+  {
+    GZ_PROFILE("EntityComponentManager::BuildNameIndex");
+    for (const Entity entity : this->entities.Entities())
+      add(entity);
+    index.built = true;
+    index.pointerWrites = pointerWrites;
+    return;
+  }
+
+  for (const Entity entity : index.dirty)
+  {
+    auto keyIter = index.keys.find(entity);
+    if (keyIter != index.keys.end())
+    {
+      const auto &key = keyIter->second;
+      auto nameIter = index.byName.find(key.second);
+      nameIter->second.erase(entity);
+      if (nameIter->second.empty())
+        index.byName.erase(nameIter);
+      auto parentNameIter = index.byParentName.find(key);
+      parentNameIter->second.erase(entity);
+      if (parentNameIter->second.empty())
+        index.byParentName.erase(parentNameIter);
+      index.keys.erase(keyIter);
+    }
+    add(entity);
+  }
+  index.dirty.clear();
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::MarkWritten(const ComponentTypeId _typeId)
+{
+  // Loading first keeps the cache line shared once the flags are set
+  auto &written = this->writtenTypes[_typeId % kWrittenTypeBits];
+  if (!written.load(std::memory_order_relaxed))
+    written.store(true, std::memory_order_relaxed);
+  if (!this->writtenSinceCopy.load(std::memory_order_relaxed))
+    this->writtenSinceCopy.store(true, std::memory_order_relaxed);
+  if (!this->writtenSinceWriteVersion.load(std::memory_order_relaxed))
+    this->writtenSinceWriteVersion.store(true, std::memory_order_relaxed);
+  if (_typeId == components::Name::typeId ||
+      _typeId == components::ParentEntity::typeId)
+  {
+    this->namePointerWrites.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManagerPrivate::Written(
+    const ComponentTypeId _typeId) const
+{
+  return this->writtenTypes[_typeId % kWrittenTypeBits].load(
+      std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManagerPrivate::IsEarlierCopy(
+    const EntityComponentManagerPrivate &_copy) const
+{
+  // Stamps and hierarchy versions only grow within a history, so the copy
+  // is unmodified if it still has the versions it was copied with
+  return _copy.sourceHistoryId == this->historyId &&
+      !_copy.writtenSinceCopy.load(std::memory_order_relaxed) &&
+      _copy.changeVersion == _copy.sourceChangeVersion &&
+      _copy.entities.Version() == _copy.sourceHierarchyVersion &&
+      this->changeVersion >= _copy.sourceChangeVersion;
+}
+
 /////////////////////////////////////////////////
 void EntityComponentManagerPrivate::AddModifiedComponent(const Entity &_entity)
 {
@@ -2131,6 +4113,24 @@ bool EntityComponentManagerPrivate::ComponentMarkedAsRemoved(
   return false;
 }
 
+/////////////////////////////////////////////////
+bool EntityComponentManagerPrivate::ComponentChanged(const Entity _entity,
+    const ComponentTypeId _typeId) const
+{
+  // see if the entity has a component of this particular type marked as a
+  // one time change
+  auto oneTimeIter = this->oneTimeChangedComponents.find(_typeId);
+  if (oneTimeIter != this->oneTimeChangedComponents.end() &&
+      oneTimeIter->second.find(_entity) != oneTimeIter->second.end())
+    return true;
+
+  // see if the entity has a component of this particular type marked as a
+  // periodic change
+  auto periodicIter = this->periodicChangedComponents.find(_typeId);
+  return periodicIter != this->periodicChangedComponents.end() &&
+      periodicIter->second.find(_entity) != periodicIter->second.end();
+}
+
 /////////////////////////////////////////////////
 template<typename ComponentTypeT>
 bool EntityComponentManagerPrivate::ClonedJointLinkName(Entity _joint,
@@ -2219,30 +4219,201 @@ void EntityComponentManager::CopyFrom(const EntityComponentManager &_fromEcm)
   this->dataPtr->CopyFrom(*_fromEcm.dataPtr);
 }
 
+/////////////////////////////////////////////////
+void EntityComponentManager::ForkFrom(const EntityComponentManager &_fromEcm)
+{
+  GZ_PROFILE("EntityComponentManager::ForkFrom");
+  this->dataPtr->CopyFrom(*_fromEcm.dataPtr, true);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+  for (const Entity entity : this->dataPtr->entities.TopologicalOrder())
+    this->dataPtr->newlyCreatedEntities.insert(entity);
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::MoveEntitiesFrom(
+    EntityComponentManager &_fromEcm)
+{
+  GZ_PROFILE("EntityComponentManager::MoveEntitiesFrom");
+  auto &from = *_fromEcm.dataPtr;
+
+  if (from.sharedTypeCount.load() > 0u)
+  {
+    gzerr << "Entities can't be moved from a fork." << std::endl;
+    return false;
+  }
+
+  // Shared components reference the other manager
+  for (const auto &interned : from.internedComponents)
+    from.UninternComponents(interned.first);
+  const std::vector<Entity> movedEntities = from.entities.Entities();
+  for (const Entity entity : movedEntities)
+  {
+    if (this->HasEntity(entity))
+    {
+      gzerr << "Failed to move entities, entity [" << entity
+            << "] already exists." << std::endl;
+      return false;
+    }
+  }
+
+  for (const Entity entity : movedEntities)
+  {
+    this->dataPtr->entities.AddEntity(entity);
+    if (this->dataPtr->recycleEntityIds)
+      this->dataPtr->entityIndexAllocator.Assign(entity);
+    this->dataPtr->componentStorage[entity] =
+        std::move(from.componentStorage[entity]);
+    this->dataPtr->componentTypeIndex[entity] =
+        std::move(from.componentTypeIndex[entity]);
+    this->dataPtr->entityCount = std::max(this->dataPtr->entityCount, entity);
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+    this->dataPtr->newlyCreatedEntities.insert(movedEntities.begin(),
+        movedEntities.end());
+  }
+
+  // Parents within the staging manager, the others are set afterwards
+  for (const Entity entity : movedEntities)
+  {
+    const Entity parent = _fromEcm.ParentEntity(entity);
+    if (kNullEntity != parent)
+      this->dataPtr->entities.SetParent(entity, parent);
+  }
+
+  for (const auto &[type, entities] : from.oneTimeChangedComponents)
+  {
+    this->dataPtr->oneTimeChangedComponents[type].insert(entities.begin(),
+        entities.end());
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+    for (const Entity entity : movedEntities)
+    {
+      for (const auto &[type, index] :
+          this->dataPtr->componentTypeIndex[entity])
+      {
+        this->dataPtr->StampComponent(entity, type);
+      }
+    }
+  }
+  this->dataPtr->createdCompTypes.insert(from.createdCompTypes.begin(),
+      from.createdCompTypes.end());
+  for (auto &[type, pool] : from.componentPools)
+    this->dataPtr->adoptedPools.push_back(std::move(pool));
+  for (auto &pool : from.adoptedPools)
+    this->dataPtr->adoptedPools.push_back(std::move(pool));
+
+  this->dataPtr->descendantCache.clear();
+  this->dataPtr->componentTypeIndexDirty = true;
+  ++this->dataPtr->creationVersion;
+
+  // Views are updated once for all moved entities
+  if (this->dataPtr->bulkInsertDepth > 0u)
+  {
+    this->dataPtr->bulkEntities.insert(this->dataPtr->bulkEntities.end(),
+        movedEntities.begin(), movedEntities.end());
+  }
+  else
+  {
+    for (auto &viewPair : this->dataPtr->views)
+    {
+      auto &view = viewPair.second.first;
+      for (const Entity entity : movedEntities)
+      {
+        if (this->EntityMatches(entity, view->ComponentTypes()))
+          view->MarkEntityToAdd(entity, true);
+      }
+    }
+  }
+
+  // The staging manager's views point to the moved components
+  _fromEcm.dataPtr = std::make_unique<EntityComponentManagerPrivate>();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::BeginBulkInsert(std::size_t _entities)
+{
+  if (this->dataPtr->bulkInsertDepth++ == 0u && _entities > 0u)
+  {
+    this->dataPtr->componentStorage.reserve(
+        this->dataPtr->componentStorage.size() + _entities);
+    this->dataPtr->componentTypeIndex.reserve(
+        this->dataPtr->componentTypeIndex.size() + _entities);
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::EndBulkInsert()
+{
+  if (this->dataPtr->bulkInsertDepth == 0u)
+  {
+    gzerr << "Called EndBulkInsert without BeginBulkInsert." << std::endl;
+    return;
+  }
+  if (--this->dataPtr->bulkInsertDepth == 0u)
+    this->AddBulkEntitiesToViews();
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::AddBulkEntitiesToViews() const
+{
+  auto &bulkEntities = this->dataPtr->bulkEntities;
+  if (bulkEntities.empty())
+    return;
+
+  GZ_PROFILE("EntityComponentManager::AddBulkEntitiesToViews");
+  std::sort(bulkEntities.begin(), bulkEntities.end());
+  bulkEntities.erase(std::unique(bulkEntities.begin(), bulkEntities.end()),
+      bulkEntities.end());
+
+  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+  for (auto &viewPair : this->dataPtr->views)
+  {
+    auto &view = viewPair.second.first;
+    for (const Entity entity : bulkEntities)
+    {
+      if (this->EntityMatches(entity, view->ComponentTypes()))
+        view->MarkEntityToAdd(entity, this->IsNewEntity(entity));
+    }
+  }
+  bulkEntities.clear();
+}
+
 /////////////////////////////////////////////////
 EntityComponentManagerDiff EntityComponentManager::ComputeEntityDiff(
     const EntityComponentManager &_other) const
 {
   EntityComponentManagerDiff diff;
-  for (const auto &item : _other.dataPtr->entities.Vertices())
+
+  // Entities and their parents are the same if neither manager changed them
+  // since one was copied from the other
+  if (this->dataPtr->IsEarlierCopy(*_other.dataPtr) &&
+      this->dataPtr->entities.Version() ==
+      _other.dataPtr->sourceHierarchyVersion)
   {
-    const auto &v = item.second.get();
-    if (!this->dataPtr->entities.VertexFromId(v.Id()).Valid())
+    return diff;
+  }
+
+  for (const Entity entity : _other.dataPtr->entities.Entities())
+  {
+    if (!this->dataPtr->entities.HasEntity(entity))
     {
       // In `_other` but not in `this`, so insert the entity as an "added"
       // entity.
-      diff.InsertAddedEntity(v.Data());
+      diff.InsertAddedEntity(entity);
     }
   }
 
-  for (const auto &item : this->dataPtr->entities.Vertices())
+  for (const Entity entity : this->dataPtr->entities.Entities())
   {
-    const auto &v = item.second.get();
-    if (!_other.dataPtr->entities.VertexFromId(v.Id()).Valid())
+    if (!_other.dataPtr->entities.HasEntity(entity))
     {
       // In `this` but not in `other`, so insert the entity as a "removed"
       // entity.
-      diff.InsertRemovedEntity(v.Data());
+      diff.InsertRemovedEntity(entity);
     }
   }
   return diff;
@@ -2314,3 +4485,144 @@ void EntityComponentManager::ResetTo(const EntityComponentManager &_other)
   tmpCopy.ApplyEntityDiff(*this, ecmDiff);
   this->CopyFrom(tmpCopy);
 }
+
+/////////////////////////////////////////////////
+void EntityComponentManager::ComputeComponentDiff(
+    const EntityComponentManager &_other,
+    EntityComponentManagerDiff &_diff) const
+{
+  GZ_PROFILE("EntityComponentManager::ComputeComponentDiff");
+  std::set<std::pair<Entity, ComponentTypeId>> components;
+  auto inBoth = [&](const Entity _entity)
+  {
+    return this->HasEntity(_entity) && _other.HasEntity(_entity);
+  };
+
+  std::unordered_map<ComponentTypeId, std::unordered_set<Entity>> changed;
+  std::unordered_map<ComponentTypeId, std::unordered_set<Entity>> removed;
+  std::unordered_set<Entity> removedEntities;
+  if (this->dataPtr->IsEarlierCopy(*_other.dataPtr) &&
+      this->ChangesSince(_other.dataPtr->sourceChangeVersion, changed,
+          removedEntities, removed))
+  {
+    // Components that were added, marked as changed or removed since the
+    // copy, and the ones that may have been written through pointers
+    for (const auto *typeEntities : {&changed, &removed})
+    {
+      for (const auto &[type, entities] : *typeEntities)
+      {
+        for (const Entity entity : entities)
+        {
+          if (inBoth(entity))
+            components.insert({entity, type});
+        }
+      }
+    }
+    std::unordered_set<ComponentTypeId> written;
+    for (const auto type : _other.dataPtr->createdCompTypes)
+    {
+      if (this->dataPtr->Written(type))
+        written.insert(type);
+    }
+    for (const auto &[entity, types] : _other.dataPtr->componentTypeIndex)
+    {
+      if (written.empty())
+        break;
+      if (!this->HasEntity(entity))
+        continue;
+      for (const auto &[type, index] : types)
+      {
+        if (written.find(type) != written.end())
+          components.insert({entity, type});
+      }
+    }
+  }
+  else
+  {
+    for (const Entity entity : _other.dataPtr->entities.Entities())
+    {
+      if (!this->HasEntity(entity))
+        continue;
+      for (const auto type : _other.ComponentTypes(entity))
+        components.insert({entity, type});
+      for (const auto type : this->ComponentTypes(entity))
+        components.insert({entity, type});
+    }
+  }
+
+  for (const auto &[entity, type] : components)
+    _diff.InsertModifiedComponent(entity, type);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::IncrementalResetTo(
+    const EntityComponentManager &_other)
+{
+  GZ_PROFILE("EntityComponentManager::IncrementalResetTo");
+
+  // Tell what differs before applying anything, since applying the diff
+  // changes this manager
+  const bool sameHierarchy = this->dataPtr->IsEarlierCopy(*_other.dataPtr) &&
+      this->dataPtr->entities.Version() ==
+      _other.dataPtr->sourceHierarchyVersion;
+  auto ecmDiff = this->ComputeEntityDiff(_other);
+  this->ComputeComponentDiff(_other, ecmDiff);
+  this->ApplyEntityDiff(_other, ecmDiff);
+
+  // Components whose data can't be compared are assumed to differ. Writes
+  // are marked as changes, so they don't count as writes through pointers.
+  auto factory = components::Factory::Instance();
+  const auto &constThis = *this;
+  for (const auto &[entity, type] : ecmDiff.ModifiedComponents())
+  {
+    const auto *from = _other.ComponentImplementation(entity, type);
+    const auto *current = constThis.ComponentImplementation(entity, type);
+    if (nullptr == from)
+    {
+      if (nullptr != current)
+        this->RemoveComponent(entity, type);
+      continue;
+    }
+
+    const auto *desc = factory->DataOps(type);
+    components::BaseComponent *to{nullptr};
+    if (nullptr == current)
+    {
+      // Components that were removed come back without their data, and
+      // are already marked as changed
+      if (!this->CreateComponentImplementation(entity, type, from))
+        continue;
+      to = this->CreatedComponentImplementation(entity, type);
+    }
+    else if (nullptr != desc && desc->SameData(from, current))
+    {
+      continue;
+    }
+    else
+    {
+      to = this->CreatedComponentImplementation(entity, type);
+      this->SetChanged(entity, type, ComponentState::OneTimeChange);
+    }
+
+    if (nullptr == desc || !desc->CopyData(from, to))
+    {
+      gzwarn << "Failed to reset component of type [" << type
+             << "] of entity [" << entity << "] in place." << std::endl;
+    }
+  }
+
+  if (sameHierarchy)
+    return;
+
+  const std::unordered_set<Entity> created(ecmDiff.AddedEntities().begin(),
+      ecmDiff.AddedEntities().end());
+  for (const Entity entity : _other.dataPtr->entities.Entities())
+  {
+    if (created.find(entity) != created.end())
+      continue;
+
+    const auto parent = _other.ParentEntity(entity);
+    if (this->ParentEntity(entity) != parent)
+      this->SetParentEntity(entity, parent);
+  }
+}
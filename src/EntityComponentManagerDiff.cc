@@ -57,3 +57,23 @@ void EntityComponentManagerDiff::ClearRemovedEntities()
 {
   this->removedEntities.clear();
 }
+
+//////////////////////////////////////////////////
+void EntityComponentManagerDiff::InsertModifiedComponent(
+    const Entity &_entity, const ComponentTypeId _typeId)
+{
+  this->modifiedComponents.emplace_back(_entity, _typeId);
+}
+
+//////////////////////////////////////////////////
+const std::vector<std::pair<Entity, ComponentTypeId>>
+    &EntityComponentManagerDiff::ModifiedComponents() const
+{
+  return this->modifiedComponents;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManagerDiff::ClearModifiedComponents()
+{
+  this->modifiedComponents.clear();
+}
@@ -22,6 +22,7 @@
 #include "gz/sim/Export.hh"
 #include "gz/sim/Types.hh"
 
+#include <utility>
 #include <vector>
 
 namespace gz
@@ -33,7 +34,8 @@ namespace gz
 
     /// \\brief Used to track the changes in an EntityComponentManager
     ///
-    /// Tracks added and removed entities for the purpose of a reset
+    /// Tracks added and removed entities, and components that may have been
+    /// modified, for the purpose of a reset
     class GZ_SIM_VISIBLE EntityComponentManagerDiff
     {
       /// \brief Add an added entity to the current diff
@@ -58,11 +60,31 @@ namespace gz
       /// \brief Clear the list of removed entities
       public: void ClearRemovedEntities();
 
+      /// \brief Add a component that may have been modified, added or
+      /// removed to the current diff
+      /// \param[in] _entity Entity that has the component
+      /// \param[in] _typeId Type of the component
+      public: void InsertModifiedComponent(const Entity &_entity,
+                  const ComponentTypeId _typeId);
+
+      /// \brief Retrieve the list of modified components
+      /// \return Entity and type of the components modified since
+      /// construction/clear
+      public: const std::vector<std::pair<Entity, ComponentTypeId>>
+                  &ModifiedComponents() const;
+
+      /// \brief Clear the list of modified components
+      public: void ClearModifiedComponents();
+
       /// \brief List of added entities
       private: std::vector<Entity> addedEntities;
 
       /// \brief List of removed entities
       private: std::vector<Entity> removedEntities;
+
+      /// \brief List of modified components
+      private: std::vector<std::pair<Entity, ComponentTypeId>>
+                   modifiedComponents;
     };
   }
   }
@@ -16,6 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <google/protobuf/util/message_differencer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
@@ -28,13 +36,16 @@
 #include "gz/sim/components/Factory.hh"
 #include "gz/sim/components/Joint.hh"
 #include "gz/sim/components/Link.hh"
+#include "gz/sim/components/Model.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/ParentLinkName.hh"
 #include "gz/sim/components/Pose.hh"
+#include "gz/sim/ComponentHandle.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/config.hh"
 #include "EntityComponentManagerDiff.hh"
+#include "StateSnapshot.hh"
 #include "../test/helpers/EnvTestFixture.hh"
 
 using namespace gz;
@@ -107,6 +118,16 @@ class EntityCompMgrTest : public EntityComponentManager
     this->ClearRemovedComponents();
   }
 
+  public: void RunCacheChangedState(bool _cache)
+  {
+    this->CacheChangedState(_cache);
+  }
+
+  public: void RunCacheWorldPoses(bool _cache)
+  {
+    this->CacheWorldPoses(_cache);
+  }
+
   public: EntityComponentManagerDiff RunComputeDiff(
               const EntityComponentManager &_other) const
   {
@@ -118,6 +139,12 @@ class EntityCompMgrTest : public EntityComponentManager
   {
     this->ApplyEntityDiff(_other, _diff);
   }
+
+  public: void RunComputeComponentDiff(const EntityComponentManager &_other,
+                                       EntityComponentManagerDiff &_diff) const
+  {
+    this->ComputeComponentDiff(_other, _diff);
+  }
 };
 
 class EntityComponentManagerFixture
@@ -1934,6 +1961,48 @@ TEST_P(EntityComponentManagerFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(State))
   }
 }
 
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(SetLargeState))
+{
+  // Enough components to be deserialized by several threads
+  const int count{2000};
+  EntityCompMgrTest source;
+  for (int i = 0; i < count; ++i)
+  {
+    Entity entity = source.CreateEntity();
+    source.CreateComponent(entity, IntComponent(i));
+    source.CreateComponent(entity, DoubleComponent(0.5 * i));
+  }
+  msgs::SerializedStateMap stateMsg;
+  source.State(stateMsg);
+
+  // Half of the entities already exist, with other values
+  for (int i = 0; i < count / 2; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(-1));
+  }
+  manager.RunSetAllComponentsUnchanged();
+
+  manager.SetState(stateMsg);
+  EXPECT_EQ(static_cast<std::size_t>(count), manager.EntityCount());
+  for (int i = 0; i < count; ++i)
+  {
+    const Entity entity = static_cast<Entity>(i + 1);
+    auto intComp = manager.Component<IntComponent>(entity);
+    ASSERT_NE(nullptr, intComp);
+    EXPECT_EQ(i, intComp->Data());
+    auto doubleComp = manager.Component<DoubleComponent>(entity);
+    ASSERT_NE(nullptr, doubleComp);
+    EXPECT_DOUBLE_EQ(0.5 * i, doubleComp->Data());
+  }
+
+  // Updated components are marked as changed
+  EXPECT_EQ(ComponentState::PeriodicChange,
+      manager.ComponentState(1, IntComponent::typeId));
+}
+
 /////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture,
        GZ_UTILS_TEST_DISABLED_ON_WIN32(ChangedStateComponents))
@@ -2216,6 +2285,64 @@ TEST_P(EntityComponentManagerFixture, Descendants)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, SetDescendantsComponentData)
+{
+  // - 1 (bool)
+  //   - 2 (bool)
+  //     - 3
+  //       - 4 (bool)
+  //   - 5
+  // - 6 (bool)
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  auto e3 = manager.CreateEntity();
+  auto e4 = manager.CreateEntity();
+  auto e5 = manager.CreateEntity();
+  auto e6 = manager.CreateEntity();
+  manager.SetParentEntity(e2, e1);
+  manager.SetParentEntity(e3, e2);
+  manager.SetParentEntity(e4, e3);
+  manager.SetParentEntity(e5, e1);
+  for (auto entity : {e1, e2, e4, e6})
+    manager.CreateComponent(entity, BoolComponent(true));
+
+  // Only entities with the filter components in the subtree are set
+  EXPECT_EQ(3u, (manager.SetDescendantsComponentData<IntComponent,
+      BoolComponent>(e1, 123)));
+  for (auto entity : {e1, e2, e4})
+  {
+    ASSERT_NE(nullptr, manager.Component<IntComponent>(entity));
+    EXPECT_EQ(123, manager.Component<IntComponent>(entity)->Data());
+  }
+  for (auto entity : {e3, e5, e6})
+    EXPECT_EQ(nullptr, manager.Component<IntComponent>(entity));
+
+  // The new components are in the views
+  EXPECT_EQ(3u, manager.EntitiesByComponents(IntComponent()).size());
+  manager.RunSetAllComponentsUnchanged();
+
+  // Components that already hold the data aren't changed
+  EXPECT_EQ(0u, (manager.SetDescendantsComponentData<IntComponent,
+      BoolComponent>(e2, 123)));
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(e2, IntComponent::typeId));
+
+  EXPECT_EQ(2u, (manager.SetDescendantsComponentData<IntComponent,
+      BoolComponent>(e2, 456)));
+  EXPECT_EQ(456, manager.Component<IntComponent>(e4)->Data());
+  EXPECT_EQ(123, manager.Component<IntComponent>(e1)->Data());
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(e4, IntComponent::typeId));
+
+  // Without filter, every entity in the subtree is set
+  EXPECT_EQ(4u, manager.SetDescendantsComponentData<IntComponent>(e2, 7) +
+      manager.SetDescendantsComponentData<IntComponent>(e5, 7));
+  EXPECT_EQ(7, manager.Component<IntComponent>(e3)->Data());
+  EXPECT_EQ(0u, manager.SetDescendantsComponentData<IntComponent>(
+      kNullEntity, 7));
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture,
        GZ_UTILS_TEST_DISABLED_ON_WIN32(UpdatePeriodicChangeCache))
@@ -2379,6 +2506,203 @@ TEST_P(EntityComponentManagerFixture,
       manager.ComponentState(e2, c2->TypeId()));
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(EntitiesWithChangedComponent))
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  Entity e3 = manager.CreateEntity();
+  auto c1 = manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  ASSERT_NE(nullptr, c1);
+  EXPECT_NE(nullptr, manager.CreateComponent<IntComponent>(e2,
+      IntComponent(2)));
+  EXPECT_NE(nullptr, manager.CreateComponent<IntComponent>(e3,
+      IntComponent(3)));
+  EXPECT_NE(nullptr, manager.CreateComponent<DoubleComponent>(e3,
+      DoubleComponent(3.0)));
+
+  // New components are one-time changes
+  EXPECT_EQ(std::unordered_set<Entity>({e1, e2, e3}),
+      manager.EntitiesWithChangedComponent(IntComponent::typeId));
+  EXPECT_EQ(std::unordered_set<Entity>({e3}),
+      manager.EntitiesWithChangedComponent(DoubleComponent::typeId));
+
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_TRUE(
+      manager.EntitiesWithChangedComponent(IntComponent::typeId).empty());
+
+  // Both kinds of changes are reported
+  manager.SetChanged(e1, IntComponent::typeId, ComponentState::PeriodicChange);
+  manager.SetChanged(e3, IntComponent::typeId, ComponentState::OneTimeChange);
+  EXPECT_EQ(std::unordered_set<Entity>({e1, e3}),
+      manager.EntitiesWithChangedComponent(IntComponent::typeId));
+  EXPECT_TRUE(
+      manager.EntitiesWithChangedComponent(DoubleComponent::typeId).empty());
+
+  // Removed components aren't
+  EXPECT_TRUE(manager.RemoveComponent(e1, IntComponent::typeId));
+  EXPECT_EQ(std::unordered_set<Entity>({e3}),
+      manager.EntitiesWithChangedComponent(IntComponent::typeId));
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(ChangesSince))
+{
+  EXPECT_EQ(0u, manager.ChangeVersion());
+
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  EXPECT_NE(nullptr, manager.CreateComponent<IntComponent>(e1,
+      IntComponent(1)));
+  EXPECT_NE(nullptr, manager.CreateComponent<IntComponent>(e2,
+      IntComponent(2)));
+  EXPECT_NE(nullptr, manager.CreateComponent<DoubleComponent>(e2,
+      DoubleComponent(2.0)));
+  EXPECT_LT(0u, manager.ComponentVersion(e1, IntComponent::typeId));
+  EXPECT_EQ(0u, manager.ComponentVersion(e1, DoubleComponent::typeId));
+
+  std::unordered_map<ComponentTypeId, std::unordered_set<Entity>> changed;
+  std::unordered_set<Entity> removedEntities;
+  std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+      removedComponents;
+  EXPECT_TRUE(manager.ChangesSince(0u, changed, removedEntities,
+      removedComponents));
+  EXPECT_EQ(2u, changed.size());
+  EXPECT_EQ(std::unordered_set<Entity>({e1, e2}),
+      changed[IntComponent::typeId]);
+  EXPECT_EQ(std::unordered_set<Entity>({e2}),
+      changed[DoubleComponent::typeId]);
+  EXPECT_TRUE(removedEntities.empty());
+  EXPECT_TRUE(removedComponents.empty());
+
+  // Stamps outlive the changed state of an iteration
+  const auto lastLook = manager.ChangeVersion();
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_TRUE(manager.ChangesSince(lastLook, changed, removedEntities,
+      removedComponents));
+  EXPECT_TRUE(changed.empty());
+  EXPECT_EQ(std::unordered_set<Entity>({e1, e2}),
+      manager.EntitiesChangedSince(0u, IntComponent::typeId));
+  EXPECT_TRUE(manager.EntitiesChangedSince(lastLook,
+      IntComponent::typeId).empty());
+
+  manager.SetChanged(e2, DoubleComponent::typeId,
+      ComponentState::PeriodicChange);
+  EXPECT_EQ(std::unordered_set<Entity>({e2}),
+      manager.EntitiesChangedSince(lastLook, DoubleComponent::typeId));
+  manager.RunSetAllComponentsUnchanged();
+  manager.SetChanged(e1, IntComponent::typeId, ComponentState::NoChange);
+  EXPECT_TRUE(manager.RemoveComponent(e2, IntComponent::typeId));
+  EXPECT_EQ(0u, manager.ComponentVersion(e2, IntComponent::typeId));
+
+  EXPECT_TRUE(manager.ChangesSince(lastLook, changed, removedEntities,
+      removedComponents));
+  EXPECT_EQ(1u, changed.size());
+  EXPECT_EQ(std::unordered_set<Entity>({e2}),
+      changed[DoubleComponent::typeId]);
+  EXPECT_EQ(1u, removedComponents.size());
+  EXPECT_EQ(std::unordered_set<Entity>({e2}),
+      removedComponents[IntComponent::typeId]);
+
+  // Removed entities are reported on their own
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.ChangesSince(lastLook, changed, removedEntities,
+      removedComponents));
+  EXPECT_TRUE(changed.empty());
+  EXPECT_EQ(std::unordered_set<Entity>({e2}), removedEntities);
+  EXPECT_TRUE(removedComponents.empty());
+
+  // Too many removals since the last look
+  const auto beforeRemovals = manager.ChangeVersion();
+  for (int i = 0; i < 5000; ++i)
+  {
+    EXPECT_NE(nullptr, manager.CreateComponent<DoubleComponent>(e1,
+        DoubleComponent(1.0)));
+    EXPECT_TRUE(manager.RemoveComponent(e1, DoubleComponent::typeId));
+  }
+  EXPECT_FALSE(manager.ChangesSince(beforeRemovals, changed,
+      removedEntities, removedComponents));
+  EXPECT_TRUE(manager.ChangesSince(manager.ChangeVersion() - 1, changed,
+      removedEntities, removedComponents));
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(PointerWriteVersion))
+{
+  Entity e1 = manager.CreateEntity();
+  EXPECT_NE(nullptr, manager.CreateComponent<IntComponent>(e1,
+      IntComponent(1)));
+  auto version = manager.PointerWriteVersion();
+  EXPECT_EQ(version, manager.PointerWriteVersion());
+
+  // Creating and reading components isn't a pointer write
+  EXPECT_NE(nullptr, manager.CreateComponent<IntComponent>(e1,
+      IntComponent(2)));
+  const auto &constManager = manager;
+  EXPECT_NE(nullptr, constManager.Component<IntComponent>(e1));
+  constManager.Each<IntComponent>(
+      [](const Entity &, const IntComponent *) { return true; });
+  EXPECT_EQ(version, manager.PointerWriteVersion());
+
+  // Mutable pointers and SetComponentData are
+  EXPECT_NE(nullptr, manager.Component<IntComponent>(e1));
+  EXPECT_NE(version, manager.PointerWriteVersion());
+  version = manager.PointerWriteVersion();
+  EXPECT_TRUE(manager.SetComponentData<IntComponent>(e1, 3));
+  EXPECT_NE(version, manager.PointerWriteVersion());
+  version = manager.PointerWriteVersion();
+
+  // Copies keep the stamp
+  EntityComponentManager copy;
+  copy.CopyFrom(manager);
+  EXPECT_EQ(version, copy.PointerWriteVersion());
+  EXPECT_NE(nullptr, manager.Component<IntComponent>(e1));
+  copy.CopyFrom(manager);
+  EXPECT_NE(version, copy.PointerWriteVersion());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(SystemSharedData))
+{
+  auto data = manager.SystemSharedData<int>("test");
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(0, *data);
+  *data = 5;
+
+  // Every caller with the same key gets the same data
+  auto same = manager.SystemSharedData<int>("test");
+  EXPECT_EQ(data, same);
+  EXPECT_NE(data, manager.SystemSharedData<int>("other"));
+
+  // A key can't be shared by different types
+  EXPECT_EQ(nullptr, manager.SystemSharedData<double>("test"));
+
+  // Copies and forks simulate other worlds, so they don't share the data
+  EntityComponentManager copy;
+  copy.CopyFrom(manager);
+  auto copied = copy.SystemSharedData<int>("test");
+  ASSERT_NE(nullptr, copied);
+  EXPECT_NE(data, copied);
+  EXPECT_EQ(0, *copied);
+  EntityComponentManager fork;
+  fork.ForkFrom(manager);
+  EXPECT_NE(data, fork.SystemSharedData<int>("test"));
+
+  // The data is destroyed once nothing holds it
+  std::weak_ptr<int> weak = data;
+  data.reset();
+  same.reset();
+  EXPECT_TRUE(weak.expired());
+  auto created = manager.SystemSharedData<int>("test");
+  ASSERT_NE(nullptr, created);
+  EXPECT_EQ(0, *created);
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture,
     GZ_UTILS_TEST_DISABLED_ON_WIN32(SetEntityCreateOffset))
@@ -3333,6 +3657,312 @@ TEST_P(EntityComponentManagerFixture, ResetToWithAddedEntity)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, IncrementalResetTo)
+{
+  math::Pose3d testPose{1, 2, 3, 0.1, 0.2, 0.3};
+  Entity moved = manager.CreateEntity();
+  manager.CreateComponent(moved, Pose{testPose});
+  manager.CreateComponent(moved, Name{"moved"});
+  manager.CreateComponent(moved, DoubleComponent{0.5});
+
+  Entity still = manager.CreateEntity();
+  manager.CreateComponent(still, Pose{testPose});
+  manager.CreateComponent(still, Name{"still"});
+
+  Entity removed = manager.CreateEntity();
+  manager.CreateComponent(removed, Name{"removed"});
+
+  EntityCompMgrTest managerCopy;
+  managerCopy.CopyFrom(manager);
+
+  // Change the world after the copy
+  manager.SetComponentData<Pose>(moved, math::Pose3d(4, 5, 6, 0, 0, 0));
+  manager.CreateComponent(moved, IntComponent{3});
+  manager.RemoveComponent<DoubleComponent>(moved);
+  manager.RequestRemoveEntity(removed);
+  Entity added = manager.CreateEntity();
+  manager.CreateComponent(added, Name{"added"});
+
+  // Emulate a step
+  manager.RunClearNewlyCreatedEntities();
+  manager.ProcessEntityRemovals();
+  manager.RunClearRemovedComponents();
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_FALSE(manager.HasEntity(removed));
+
+  manager.IncrementalResetTo(managerCopy);
+
+  // Only the data that differs is touched
+  EXPECT_EQ(testPose, manager.Component<Pose>(moved)->Data());
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(moved, Pose::typeId));
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(moved, Name::typeId));
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(still, Pose::typeId));
+  EXPECT_EQ(nullptr, manager.Component<IntComponent>(moved));
+  ASSERT_NE(nullptr, manager.Component<DoubleComponent>(moved));
+  EXPECT_DOUBLE_EQ(0.5, manager.Component<DoubleComponent>(moved)->Data());
+
+  // Entities that exist in both aren't new, unlike those created again
+  std::vector<Entity> newEntities;
+  manager.EachNew<Name>(
+      [&](const Entity &_entity, const Name *)
+      {
+        newEntities.push_back(_entity);
+        return true;
+      });
+  ASSERT_EQ(1u, newEntities.size());
+  EXPECT_EQ(removed, newEntities.front());
+  EXPECT_EQ("removed", manager.Component<Name>(removed)->Data());
+
+  std::vector<Entity> removedEntities;
+  manager.EachRemoved<Name>(
+      [&](const Entity &_entity, const Name *)
+      {
+        removedEntities.push_back(_entity);
+        return true;
+      });
+  ASSERT_EQ(1u, removedEntities.size());
+  EXPECT_EQ(added, removedEntities.front());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ComputeComponentDiff)
+{
+  Entity first = manager.CreateEntity();
+  manager.CreateComponent(first, IntComponent{1});
+  manager.CreateComponent(first, DoubleComponent{0.5});
+  Entity second = manager.CreateEntity();
+  manager.CreateComponent(second, IntComponent{2});
+  manager.CreateComponent(second, DoubleComponent{1.5});
+
+  EntityCompMgrTest managerCopy;
+  managerCopy.CopyFrom(manager);
+
+  EntityComponentManagerDiff diff;
+  manager.RunComputeComponentDiff(managerCopy, diff);
+  EXPECT_TRUE(diff.ModifiedComponents().empty());
+  EXPECT_TRUE(manager.RunComputeDiff(managerCopy).AddedEntities().empty());
+
+  // Writing through a pointer makes all components of the type differ,
+  // while marking as changed only affects the component
+  manager.Component<IntComponent>(first)->Data() = 3;
+  manager.SetChanged(second, DoubleComponent::typeId,
+      ComponentState::OneTimeChange);
+  manager.RunComputeComponentDiff(managerCopy, diff);
+  std::vector<std::pair<Entity, ComponentTypeId>> expected{
+      {first, IntComponent::typeId}, {second, IntComponent::typeId},
+      {second, DoubleComponent::typeId}};
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(expected, diff.ModifiedComponents());
+
+  manager.IncrementalResetTo(managerCopy);
+  EXPECT_EQ(1, manager.Component<IntComponent>(first)->Data());
+
+  // All components are compared to managers that aren't copies of this one
+  EntityCompMgrTest otherManager;
+  otherManager.CopyFrom(managerCopy);
+  diff.ClearModifiedComponents();
+  manager.RunComputeComponentDiff(otherManager, diff);
+  EXPECT_EQ(4u, diff.ModifiedComponents().size());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, MoveEntitiesFrom)
+{
+  EXPECT_TRUE(manager.SetComponentStorage(ComponentStorageType::kContiguous));
+  Entity world = manager.CreateEntity();
+  manager.CreateComponent(world, Name{"world"});
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_EQ(world, manager.EntityCreateOffset());
+
+  // Populate the view before moving entities
+  std::size_t count{0u};
+  manager.Each<Pose>([&](const Entity &, const Pose *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(0u, count);
+
+  math::Pose3d testPose{1, 2, 3, 0, 0, 0};
+  EntityComponentManager staging;
+  EXPECT_TRUE(staging.SetComponentStorage(ComponentStorageType::kContiguous));
+  staging.SetEntityCreateOffset(manager.EntityCreateOffset());
+  Entity parent = staging.CreateEntity();
+  staging.CreateComponent(parent, Pose{testPose});
+  Entity child = staging.CreateEntity();
+  staging.CreateComponent(child, Pose{testPose});
+  staging.CreateComponent(child, ParentEntity{parent});
+  EXPECT_EQ(world + 1, parent);
+  EXPECT_EQ(world + 2, child);
+
+  auto stagedPose = staging.Component<Pose>(child);
+  EXPECT_TRUE(manager.MoveEntitiesFrom(staging));
+  EXPECT_EQ(0u, staging.EntityCount());
+
+  // Components are moved, not copied
+  EXPECT_EQ(3u, manager.EntityCount());
+  EXPECT_EQ(child, manager.EntityCreateOffset());
+  EXPECT_EQ(stagedPose, manager.Component<Pose>(child));
+  EXPECT_EQ(testPose, manager.Component<Pose>(parent)->Data());
+  EXPECT_EQ(parent, manager.ParentEntity(child));
+  EXPECT_TRUE(manager.HasNewEntities());
+  EXPECT_TRUE(manager.HasOneTimeComponentChanges());
+
+  manager.Each<Pose>([&](const Entity &, const Pose *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(2u, count);
+
+  // Staging managers must not reuse IDs
+  EntityComponentManager clashing;
+  clashing.CreateEntity();
+  EXPECT_FALSE(manager.MoveEntitiesFrom(clashing));
+  EXPECT_EQ(1u, clashing.EntityCount());
+
+  // Removing a moved entity releases its component to the adopted pool
+  manager.RequestRemoveEntity(child);
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(manager.HasEntity(child));
+  EXPECT_EQ(world + 3, manager.CreateEntity());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, BulkInsert)
+{
+  // Populate the view before inserting entities
+  std::size_t count{0u};
+  auto countPoses = [&]()
+  {
+    count = 0u;
+    manager.Each<Pose, Name>([&](const Entity &, const Pose *,
+        const Name *) -> bool
+        {
+          ++count;
+          return true;
+        });
+    return count;
+  };
+  EXPECT_EQ(0u, countPoses());
+
+  Entity parent = manager.CreateEntity();
+  manager.BeginBulkInsert(10u);
+  manager.BeginBulkInsert();
+  for (int i = 0; i < 5; ++i)
+  {
+    Entity child = manager.CreateEntity();
+    manager.CreateComponent(child, Pose{math::Pose3d(i, 0, 0, 0, 0, 0)});
+    manager.CreateComponent(child, Name{"child" + std::to_string(i)});
+    manager.CreateComponent(child, ParentEntity{parent});
+    manager.SetParentEntity(child, parent);
+  }
+
+  // Children can be found without updating the views
+  auto children = manager.ChildrenByComponents(parent, Name{"child3"});
+  ASSERT_EQ(1u, children.size());
+  EXPECT_EQ(parent + 4, children[0]);
+  EXPECT_TRUE(manager.ChildrenByComponents(parent, Name{"child3"},
+      IntComponent{1}).empty());
+
+  manager.EndBulkInsert();
+
+  // Views are up to date when they're used, even in a bulk insert
+  EXPECT_EQ(5u, countPoses());
+
+  Entity lastChild = manager.CreateEntity();
+  manager.CreateComponent(lastChild, Pose{});
+  manager.CreateComponent(lastChild, Name{"lastChild"});
+  EXPECT_EQ(6u, countPoses());
+  manager.EndBulkInsert();
+  EXPECT_EQ(6u, countPoses());
+
+  // Unmatched calls are ignored
+  manager.EndBulkInsert();
+  Entity single = manager.CreateEntity();
+  manager.CreateComponent(single, Pose{});
+  manager.CreateComponent(single, Name{"single"});
+  EXPECT_EQ(7u, countPoses());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ForkFrom)
+{
+  math::Pose3d testPose{1, 2, 3, 0.1, 0.2, 0.3};
+  Entity entity1 = manager.CreateEntity();
+  manager.CreateComponent(entity1, Pose{testPose});
+  manager.CreateComponent(entity1, Name{"entity1"});
+  Entity entity2 = manager.CreateEntity();
+  manager.CreateComponent(entity2, Pose{testPose});
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+
+  EntityCompMgrTest fork;
+  fork.ForkFrom(manager);
+  const auto &constFork = fork;
+  EXPECT_EQ(2u, fork.EntityCount());
+
+  // Components are shared while they're only read
+  EXPECT_EQ(manager.Component<Pose>(entity1),
+      constFork.Component<Pose>(entity1));
+  EXPECT_EQ(manager.Component<Name>(entity1),
+      constFork.Component<Name>(entity1));
+
+  // Writing copies the component of that entity, and only of that type
+  auto forkPose = fork.Component<Pose>(entity1);
+  ASSERT_NE(nullptr, forkPose);
+  EXPECT_NE(manager.Component<Pose>(entity1), forkPose);
+  EXPECT_EQ(manager.Component<Pose>(entity2),
+      constFork.Component<Pose>(entity2));
+  EXPECT_EQ(manager.Component<Name>(entity1),
+      constFork.Component<Name>(entity1));
+
+  // Iterating copies the components of the entities that are visited
+  int visited{0};
+  fork.Each<Pose>([&](const Entity &, Pose *)
+      {
+        ++visited;
+        return false;
+      });
+  EXPECT_EQ(1, visited);
+  EXPECT_EQ(manager.Component<Pose>(entity2),
+      constFork.Component<Pose>(entity2));
+  fork.Each<Pose>([&](const Entity &, Pose *)
+      {
+        return true;
+      });
+  EXPECT_NE(manager.Component<Pose>(entity2),
+      constFork.Component<Pose>(entity2));
+
+  forkPose->Data() = math::Pose3d(4, 5, 6, 0, 0, 0);
+  EXPECT_EQ(testPose, manager.Component<Pose>(entity1)->Data());
+
+  // Views see the copies
+  fork.Each<Pose, Name>([&](const Entity &, Pose *_pose, Name *)
+      {
+        EXPECT_EQ(math::Pose3d(4, 5, 6, 0, 0, 0), _pose->Data());
+        _pose->Data() = math::Pose3d::Zero;
+        return true;
+      });
+  EXPECT_EQ(math::Pose3d::Zero, fork.Component<Pose>(entity1)->Data());
+  EXPECT_EQ(testPose, manager.Component<Pose>(entity1)->Data());
+  EXPECT_NE(manager.Component<Name>(entity1),
+      constFork.Component<Name>(entity1));
+
+  // Entities of the fork are new, and removing them leaves the original
+  EXPECT_TRUE(fork.HasNewEntities());
+  EXPECT_FALSE(manager.HasNewEntities());
+  fork.RequestRemoveEntity(entity2);
+  fork.ProcessEntityRemovals();
+  EXPECT_FALSE(fork.HasEntity(entity2));
+  EXPECT_EQ(testPose, manager.Component<Pose>(entity2)->Data());
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture,
     GZ_UTILS_TEST_DISABLED_ON_WIN32(AddRemoveAddComponentsStateMap))
@@ -3421,6 +4051,764 @@ TEST_P(EntityComponentManagerFixture,
   EXPECT_EQ(321, comp->Data());
 }
 
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ContiguousComponentStorage)
+{
+  EXPECT_EQ(ComponentStorageType::kHeap, manager.ComponentStorage());
+  EXPECT_TRUE(manager.SetComponentStorage(ComponentStorageType::kContiguous));
+  EXPECT_EQ(ComponentStorageType::kContiguous, manager.ComponentStorage());
+
+  std::vector<Entity> entities;
+  for (int i = 0; i < 10; ++i)
+  {
+    Entity e = manager.CreateEntity();
+    manager.CreateComponent<IntComponent>(e, IntComponent(i));
+    manager.CreateComponent<DoubleComponent>(e, DoubleComponent(i * 0.5));
+    entities.push_back(e);
+  }
+
+  // The layout can't change once components exist
+  EXPECT_FALSE(manager.SetComponentStorage(ComponentStorageType::kHeap));
+  EXPECT_EQ(ComponentStorageType::kContiguous, manager.ComponentStorage());
+
+  // Components of the same type created in sequence are packed together
+  auto first = manager.Component<IntComponent>(entities[0]);
+  auto second = manager.Component<IntComponent>(entities[1]);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  auto distance = reinterpret_cast<const char *>(second) -
+      reinterpret_cast<const char *>(first);
+  EXPECT_EQ(static_cast<std::ptrdiff_t>(sizeof(IntComponent)), distance);
+
+  int count{0};
+  manager.Each<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *_int,
+          const DoubleComponent *_double) -> bool
+      {
+        EXPECT_DOUBLE_EQ(_int->Data() * 0.5, _double->Data());
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(10, count);
+
+  // Pointers are stable when other components are added and removed
+  auto intPtr = manager.Component<IntComponent>(entities[5]);
+  manager.CreateComponent<StringComponent>(entities[5], StringComponent("a"));
+  EXPECT_TRUE(manager.RemoveComponent<DoubleComponent>(entities[5]));
+  EXPECT_EQ(intPtr, manager.Component<IntComponent>(entities[5]));
+  EXPECT_EQ(5, intPtr->Data());
+
+  // Removed entities release their slots, which get reused
+  manager.RequestRemoveEntity(entities[3]);
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(manager.HasEntity(entities[3]));
+  Entity reused = manager.CreateEntity();
+  auto reusedComp =
+      manager.CreateComponent<IntComponent>(reused, IntComponent(42));
+  ASSERT_NE(nullptr, reusedComp);
+  EXPECT_EQ(42, reusedComp->Data());
+
+  // Copies keep the storage layout and the component data
+  EntityComponentManager copy;
+  copy.CopyFrom(manager);
+  EXPECT_EQ(ComponentStorageType::kContiguous, copy.ComponentStorage());
+  auto copied = copy.Component<IntComponent>(entities[7]);
+  ASSERT_NE(nullptr, copied);
+  EXPECT_EQ(7, copied->Data());
+  EXPECT_NE(copied, manager.Component<IntComponent>(entities[7]));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachParallel)
+{
+  const int entityCount = 1000;
+  for (int i = 0; i < entityCount; ++i)
+  {
+    Entity e = manager.CreateEntity();
+    manager.CreateComponent<IntComponent>(e, IntComponent(i));
+    manager.CreateComponent<DoubleComponent>(e, DoubleComponent(0.0));
+    if (i % 2 == 0)
+      manager.CreateComponent<Even>(e, Even());
+  }
+
+  // Mutable components, small chunks to exercise the thread pool
+  std::atomic<int> count{0};
+  manager.EachParallel<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *_int, DoubleComponent *_double)
+      {
+        _double->Data() = _int->Data() * 2.0;
+        ++count;
+      }, 8);
+  EXPECT_EQ(entityCount, count);
+
+  // Const version on a subset, with the default chunk size
+  const auto &constManager = manager;
+  count = 0;
+  std::atomic<int> mismatches{0};
+  constManager.EachParallel<IntComponent, DoubleComponent, Even>(
+      [&](const Entity &_entity, const IntComponent *_int,
+          const DoubleComponent *_double, const Even *)
+      {
+        if (_int->Data() % 2 != 0 ||
+            std::abs(_double->Data() - _int->Data() * 2.0) > 1e-9)
+        {
+          ++mismatches;
+        }
+
+        // Reading other components is allowed
+        if (nullptr == constManager.Component<IntComponent>(_entity))
+          ++mismatches;
+        ++count;
+      });
+  EXPECT_EQ(entityCount / 2, count);
+  EXPECT_EQ(0, mismatches);
+
+  // Results match a serial Each
+  int serialCount{0};
+  manager.Each<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *_int,
+          const DoubleComponent *_double) -> bool
+      {
+        EXPECT_DOUBLE_EQ(_int->Data() * 2.0, _double->Data());
+        ++serialCount;
+        return true;
+      });
+  EXPECT_EQ(entityCount, serialCount);
+
+  // No matching entities
+  bool called{false};
+  manager.EachParallel<StringComponent>(
+      [&](const Entity &, StringComponent *)
+      {
+        called = true;
+      });
+  EXPECT_FALSE(called);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(CachedChangedState))
+{
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.RunClearNewlyCreatedEntities();
+
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  manager.SetComponentData<IntComponent>(e1, 3);
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+
+  msgs::SerializedStateMap uncached;
+  manager.ChangedState(uncached);
+  EXPECT_EQ(2, uncached.entities_size());
+
+  // Every caller gets the same state while caching
+  manager.RunCacheChangedState(true);
+  msgs::SerializedStateMap first;
+  manager.ChangedState(first);
+  msgs::SerializedStateMap second;
+  manager.ChangedState(second);
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+      uncached, first));
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+      uncached, second));
+
+  // Disabling caching drops the cached state
+  manager.RunCacheChangedState(false);
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  msgs::SerializedStateMap unchanged;
+  manager.ChangedState(unchanged);
+  EXPECT_EQ(0, unchanged.entities_size());
+
+  manager.RunCacheChangedState(true);
+  manager.ChangedState(unchanged);
+  EXPECT_EQ(0, unchanged.entities_size());
+  manager.RunCacheChangedState(false);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(FilteredChangedState))
+{
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.5));
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e3, IntComponent(3));
+  manager.RequestRemoveEntity(e3);
+
+  // Empty filters are the same as the unfiltered state
+  msgs::SerializedStateMap all;
+  manager.ChangedState(all);
+  msgs::SerializedStateMap unfiltered;
+  manager.ChangedState(unfiltered, {}, {});
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+      all, unfiltered));
+  EXPECT_EQ(3, all.entities_size());
+
+  // Only some entities
+  msgs::SerializedStateMap entities;
+  manager.ChangedState(entities, {e1, e3}, {});
+  ASSERT_EQ(2, entities.entities_size());
+  EXPECT_EQ(2, entities.entities().at(e1).components_size());
+  EXPECT_TRUE(entities.entities().at(e3).remove());
+  EXPECT_EQ(0u, entities.entities().count(e2));
+
+  // Only some components
+  msgs::SerializedStateMap types;
+  manager.ChangedState(types, {}, {DoubleComponent::typeId});
+  ASSERT_EQ(2, types.entities_size());
+  ASSERT_EQ(1, types.entities().at(e1).components_size());
+  EXPECT_EQ(1u, types.entities().at(e1).components().count(
+      DoubleComponent::typeId));
+  EXPECT_TRUE(types.entities().at(e3).remove());
+
+  // Unchanged entities aren't added
+  manager.RunClearNewlyCreatedEntities();
+  manager.ProcessEntityRemovals();
+  manager.RunSetAllComponentsUnchanged();
+  manager.SetComponentData<IntComponent>(e2, 4);
+  manager.SetChanged(e2, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+  msgs::SerializedStateMap changed;
+  manager.ChangedState(changed, {e1, e2}, {IntComponent::typeId});
+  ASSERT_EQ(1, changed.entities_size());
+  EXPECT_EQ(1, changed.entities().at(e2).components_size());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(WorldPose))
+{
+  Entity model = manager.CreateEntity();
+  manager.CreateComponent(model,
+      components::Pose(math::Pose3d(1, 0, 0, 0, 0, GZ_PI_2)));
+
+  Entity link = manager.CreateEntity();
+  manager.CreateComponent(link, components::ParentEntity(model));
+  manager.CreateComponent(link,
+      components::Pose(math::Pose3d(0, 1, 0, 0, 0, 0)));
+
+  Entity sensor = manager.CreateEntity();
+  manager.CreateComponent(sensor, components::ParentEntity(link));
+  manager.CreateComponent(sensor,
+      components::Pose(math::Pose3d(0, 0, 1, 0, 0, 0)));
+
+  Entity noPose = manager.CreateEntity();
+  manager.CreateComponent(noPose, components::ParentEntity(link));
+
+  const math::Pose3d expectedLink(0, 0, 0, 0, 0, GZ_PI_2);
+  const math::Pose3d expectedSensor(0, 0, 1, 0, 0, GZ_PI_2);
+
+  auto uncached = manager.WorldPose(sensor);
+  ASSERT_TRUE(uncached.has_value());
+  EXPECT_EQ(expectedSensor, *uncached);
+  EXPECT_FALSE(manager.WorldPose(noPose).has_value());
+  EXPECT_FALSE(manager.WorldPose(kNullEntity).has_value());
+
+  // Cached poses match the uncached ones, whichever entity is queried first
+  manager.RunCacheWorldPoses(true);
+  auto cachedSensor = manager.WorldPose(sensor);
+  ASSERT_TRUE(cachedSensor.has_value());
+  EXPECT_EQ(*uncached, *cachedSensor);
+  auto cachedLink = manager.WorldPose(link);
+  ASSERT_TRUE(cachedLink.has_value());
+  EXPECT_EQ(expectedLink, *cachedLink);
+  EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, GZ_PI_2), *manager.WorldPose(model));
+  EXPECT_FALSE(manager.WorldPose(noPose).has_value());
+
+  // The cache is dropped when caching is disabled
+  manager.RunCacheWorldPoses(false);
+  manager.SetComponentData<components::Pose>(model, math::Pose3d::Zero);
+  EXPECT_EQ(math::Pose3d(0, 1, 1, 0, 0, 0), *manager.WorldPose(sensor));
+
+  manager.RunCacheWorldPoses(true);
+  EXPECT_EQ(math::Pose3d(0, 1, 1, 0, 0, 0), *manager.WorldPose(sensor));
+  manager.RunCacheWorldPoses(false);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(StateSnapshot))
+{
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<components::Pose>(e1,
+      components::Pose(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3)));
+
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<StringComponent>(e2, StringComponent("foo"));
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(0.5));
+
+  std::vector<std::uint8_t> buffer;
+  manager.ChangedStateSnapshot(buffer);
+  EXPECT_FALSE(buffer.empty());
+
+  // New entities and components are created
+  EntityCompMgrTest remote;
+  EXPECT_TRUE(remote.SetStateSnapshot(buffer.data(), buffer.size()));
+  EXPECT_EQ(2u, remote.EntityCount());
+  ASSERT_NE(nullptr, remote.Component<IntComponent>(e1));
+  EXPECT_EQ(1, remote.Component<IntComponent>(e1)->Data());
+  ASSERT_NE(nullptr, remote.Component<components::Pose>(e1));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3),
+      remote.Component<components::Pose>(e1)->Data());
+  ASSERT_NE(nullptr, remote.Component<StringComponent>(e2));
+  EXPECT_EQ("foo", remote.Component<StringComponent>(e2)->Data());
+  ASSERT_NE(nullptr, remote.Component<DoubleComponent>(e2));
+  EXPECT_DOUBLE_EQ(0.5, remote.Component<DoubleComponent>(e2)->Data());
+
+  // Only changes are written once entities are no longer new
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  manager.ChangedStateSnapshot(buffer);
+  StateSnapshotReader emptyReader(buffer.data(), buffer.size());
+  EXPECT_TRUE(emptyReader.Valid());
+  EXPECT_EQ(0u, emptyReader.RecordCount());
+
+  manager.SetComponentData<components::Pose>(e1,
+      math::Pose3d(4, 5, 6, 0, 0, 0));
+  manager.SetChanged(e1, components::Pose::typeId,
+      ComponentState::PeriodicChange);
+  EXPECT_TRUE(manager.RemoveComponent<DoubleComponent>(e2));
+  manager.RequestRemoveEntity(e1);
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e3, IntComponent(3));
+
+  const auto *previousData = buffer.data();
+  manager.ChangedStateSnapshot(buffer);
+  EXPECT_EQ(previousData, buffer.data());
+
+  EXPECT_TRUE(remote.SetStateSnapshot(buffer.data(), buffer.size()));
+  EXPECT_TRUE(remote.IsMarkedForRemoval(e1));
+  EXPECT_EQ(nullptr, remote.Component<DoubleComponent>(e2));
+  ASSERT_NE(nullptr, remote.Component<StringComponent>(e2));
+  ASSERT_NE(nullptr, remote.Component<IntComponent>(e3));
+  EXPECT_EQ(3, remote.Component<IntComponent>(e3)->Data());
+
+  // The full state matches the manager's state
+  manager.ProcessEntityRemovals();
+  manager.StateSnapshot(buffer, {}, {}, true);
+  EntityCompMgrTest full;
+  EXPECT_TRUE(full.SetStateSnapshot(buffer.data(), buffer.size()));
+  EXPECT_EQ(manager.EntityCount(), full.EntityCount());
+  ASSERT_NE(nullptr, full.Component<StringComponent>(e2));
+  EXPECT_EQ("foo", full.Component<StringComponent>(e2)->Data());
+  EXPECT_EQ(nullptr, full.Component<DoubleComponent>(e2));
+
+  // Malformed data is rejected
+  EXPECT_FALSE(full.SetStateSnapshot(nullptr, 0));
+  std::vector<std::uint8_t> garbage(64, 0xAB);
+  EXPECT_FALSE(full.SetStateSnapshot(garbage.data(), garbage.size()));
+  // Cut in the middle of the first record header
+  EXPECT_FALSE(full.SetStateSnapshot(buffer.data(), 34u));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EntityIdRecycling)
+{
+  EXPECT_FALSE(manager.EntityIdRecycling());
+  EXPECT_FALSE(manager.EntityIndex(manager.CreateEntity()).has_value());
+
+  // Can't be changed once entities exist
+  EXPECT_FALSE(manager.SetEntityIdRecycling(true));
+
+  EntityCompMgrTest recycling;
+  EXPECT_TRUE(recycling.SetEntityIdRecycling(true));
+  EXPECT_TRUE(recycling.EntityIdRecycling());
+
+  Entity e1 = recycling.CreateEntity();
+  Entity e2 = recycling.CreateEntity();
+  EXPECT_EQ(1u, e1);
+  EXPECT_EQ(2u, e2);
+  recycling.CreateComponent<IntComponent>(e1, IntComponent(1));
+  ASSERT_TRUE(recycling.EntityIndex(e1).has_value());
+  EXPECT_EQ(0u, *recycling.EntityIndex(e1));
+  EXPECT_EQ(1u, *recycling.EntityIndex(e2));
+  EXPECT_EQ(2u, recycling.EntityIndexCapacity());
+
+  // The index is kept until the removal is processed
+  recycling.RequestRemoveEntity(e1);
+  EXPECT_TRUE(recycling.EntityIndex(e1).has_value());
+  recycling.ProcessEntityRemovals();
+  EXPECT_FALSE(recycling.HasEntity(e1));
+  EXPECT_FALSE(recycling.EntityIndex(e1).has_value());
+
+  // The index is reused with a new ID
+  Entity e3 = recycling.CreateEntity();
+  EXPECT_EQ(3u, e3);
+  EXPECT_TRUE(recycling.HasEntity(e3));
+  EXPECT_EQ(nullptr, recycling.Component<IntComponent>(e3));
+  EXPECT_EQ(0u, *recycling.EntityIndex(e3));
+  EXPECT_EQ(2u, recycling.EntityIndexCapacity());
+
+  // Spawning and removing many entities doesn't grow the index
+  for (int i = 0; i < 100; ++i)
+  {
+    Entity e = recycling.CreateEntity();
+    recycling.CreateComponent<IntComponent>(e, IntComponent(i));
+    recycling.RequestRemoveEntity(e);
+    recycling.ProcessEntityRemovals();
+  }
+  EXPECT_EQ(3u, recycling.EntityIndexCapacity());
+  EXPECT_EQ(2u, recycling.EntityCount());
+
+  // Entities created with external IDs, such as through SetState, get
+  // indices too
+  EntityCompMgrTest external;
+  EXPECT_TRUE(external.SetEntityIdRecycling(true));
+  EXPECT_EQ(1u, external.CreateEntity());
+  msgs::SerializedStateMap stateMsg;
+  msgs::SerializedEntityMap entityMsg;
+  entityMsg.set_id(2);
+  (*stateMsg.mutable_entities())[2] = entityMsg;
+  external.SetState(stateMsg);
+  EXPECT_TRUE(external.HasEntity(2));
+  ASSERT_TRUE(external.EntityIndex(2).has_value());
+  EXPECT_EQ(1u, *external.EntityIndex(2));
+  EXPECT_EQ(3u, external.CreateEntity());
+
+  // Create offsets are honored, over the full width of the IDs
+  const Entity offset = std::numeric_limits<Entity>::max() / 2;
+  recycling.SetEntityCreateOffset(offset);
+  Entity e5 = recycling.CreateEntity();
+  EXPECT_EQ(offset + 1, e5);
+  ASSERT_TRUE(recycling.EntityIndex(e5).has_value());
+  EXPECT_EQ(3u, recycling.EntityIndexCapacity());
+
+  // Removing all entities releases all indices
+  recycling.RequestRemoveEntities();
+  recycling.ProcessEntityRemovals();
+  EXPECT_EQ(0u, recycling.EntityCount());
+  Entity e6 = recycling.CreateEntity();
+  EXPECT_EQ(offset + 2, e6);
+  EXPECT_TRUE(recycling.EntityIndex(e6).has_value());
+
+  // Entities moved from a staging manager get indices
+  EntityCompMgrTest staging;
+  staging.SetEntityCreateOffset(recycling.EntityCreateOffset() + 10);
+  Entity staged = staging.CreateEntity();
+  EXPECT_TRUE(recycling.MoveEntitiesFrom(staging));
+  EXPECT_TRUE(recycling.EntityIndex(staged).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ComponentHandle)
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+
+  // Default handles don't refer to anything
+  ComponentHandle<IntComponent> empty;
+  EXPECT_FALSE(empty.Valid());
+  EXPECT_EQ(nullptr, empty.Get());
+  EXPECT_EQ(kNullEntity, empty.Entity());
+
+  auto handle = manager.Handle<IntComponent>(e1);
+  EXPECT_EQ(e1, handle.Entity());
+  EXPECT_TRUE(handle.Valid());
+  ASSERT_NE(nullptr, handle.Get());
+  EXPECT_EQ(manager.Component<IntComponent>(e1), handle.Get());
+  EXPECT_EQ(1, handle->Data());
+
+  // Writes go to the component in the manager
+  handle->Data() = 2;
+  EXPECT_EQ(2, manager.Component<IntComponent>(e1)->Data());
+
+  // Creating other entities and components keeps the handle valid
+  manager.CreateComponent<IntComponent>(e2, IntComponent(3));
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.5));
+  EXPECT_TRUE(handle.Valid());
+
+  // Handles of missing components find them once they're created
+  auto doubleHandle = manager.Handle<DoubleComponent>(e2);
+  EXPECT_FALSE(doubleHandle.Valid());
+  EXPECT_FALSE(doubleHandle);
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(1.5));
+  ASSERT_TRUE(doubleHandle);
+  EXPECT_DOUBLE_EQ(1.5, doubleHandle->Data());
+
+  // Removing a component invalidates it
+  EXPECT_TRUE(manager.RemoveComponent<IntComponent>(e1));
+  EXPECT_FALSE(handle.Valid());
+  EXPECT_EQ(nullptr, handle.Get());
+
+  // Other handles look their component up again, and still find it
+  EXPECT_FALSE(doubleHandle.Valid());
+  EXPECT_NE(nullptr, doubleHandle.Get());
+  EXPECT_TRUE(doubleHandle.Valid());
+
+  // Adding the component back is picked up
+  manager.CreateComponent<IntComponent>(e1, IntComponent(4));
+  ASSERT_NE(nullptr, handle.Get());
+  EXPECT_EQ(4, handle->Data());
+
+  // Removing the entity invalidates its handles
+  auto e2Handle = manager.Handle<IntComponent>(e2);
+  ASSERT_TRUE(e2Handle.Valid());
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(e2Handle.Valid());
+  EXPECT_EQ(nullptr, e2Handle.Get());
+  EXPECT_EQ(nullptr, doubleHandle.Get());
+  EXPECT_NE(nullptr, handle.Get());
+
+  // Processing removals with nothing to remove keeps handles valid
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(handle.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ComponentMemoryUsage)
+{
+  Entity world = manager.CreateEntity();
+  manager.CreateComponent(world, components::Name("world"));
+
+  Entity model = manager.CreateEntity();
+  manager.CreateComponent(model, components::Model());
+  manager.CreateComponent(model, components::Name(std::string(100, 'm')));
+  manager.CreateComponent(model, components::ParentEntity(world));
+
+  Entity nested = manager.CreateEntity();
+  manager.CreateComponent(nested, components::Model());
+  manager.CreateComponent(nested, components::ParentEntity(model));
+
+  Entity link = manager.CreateEntity();
+  manager.CreateComponent(link, components::Link());
+  manager.CreateComponent(link, components::ParentEntity(nested));
+  manager.CreateComponent(link, components::Pose());
+
+  auto byType = manager.ComponentMemoryUsageByType();
+  EXPECT_EQ(2u, byType[components::Name::typeId].count);
+  EXPECT_EQ(2u, byType[components::Model::typeId].count);
+  EXPECT_EQ(3u, byType[components::ParentEntity::typeId].count);
+  EXPECT_EQ(1u, byType[components::Pose::typeId].count);
+  EXPECT_EQ(sizeof(components::Pose),
+      byType[components::Pose::typeId].bytes);
+  EXPECT_EQ(0u, byType[components::Pose::typeId].heapBytes);
+
+  // The long name is held on the heap
+  EXPECT_GT(byType[components::Name::typeId].heapBytes, 100u);
+
+  // The nested model and the link are counted with the top-level model
+  auto byModel = manager.ComponentMemoryUsageByModel();
+  ASSERT_EQ(2u, byModel.size());
+  EXPECT_EQ(1u, byModel[kNullEntity].count);
+  EXPECT_EQ(7u, byModel[model].count);
+  EXPECT_GT(byModel[model].heapBytes, 100u);
+
+  // Removed components aren't counted
+  manager.RemoveComponent<components::Pose>(link);
+  byType = manager.ComponentMemoryUsageByType();
+  EXPECT_EQ(0u, byType[components::Pose::typeId].count);
+  EXPECT_EQ(6u, manager.ComponentMemoryUsageByModel()[model].count);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, InternComponents)
+{
+  const std::string longName(100, 'r');
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent(e1, components::Name(longName));
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent(e2, components::Name(longName));
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent(e3, components::Name("other"));
+
+  const auto &constManager = manager;
+  auto before = manager.ComponentMemoryUsageByType()[components::Name::typeId];
+
+  // Entities with the same data share one instance
+  EXPECT_EQ(1u, manager.InternComponents(components::Name::typeId));
+  EXPECT_EQ(constManager.Component<components::Name>(e1),
+      constManager.Component<components::Name>(e2));
+  EXPECT_NE(constManager.Component<components::Name>(e1),
+      constManager.Component<components::Name>(e3));
+  EXPECT_EQ(longName, constManager.Component<components::Name>(e2)->Data());
+
+  // The shared instance is only counted once
+  auto after = manager.ComponentMemoryUsageByType()[components::Name::typeId];
+  EXPECT_EQ(3u, after.count);
+  EXPECT_LT(after.heapBytes, before.heapBytes);
+
+  // Views see the shared instance
+  constManager.Each<components::Name>(
+      [&](const Entity &_entity, const components::Name *_name) -> bool
+      {
+        EXPECT_EQ(constManager.Component<components::Name>(_entity), _name);
+        return true;
+      });
+
+  // Writing a component copies it first
+  auto name1 = manager.Component<components::Name>(e1);
+  ASSERT_NE(nullptr, name1);
+  EXPECT_NE(constManager.Component<components::Name>(e2), name1);
+  name1->Data() = "changed";
+  EXPECT_EQ(longName, constManager.Component<components::Name>(e2)->Data());
+
+  // Iterating with non-const components copies all of them
+  manager.CreateComponent(e1, components::Name(longName));
+  EXPECT_EQ(1u, manager.InternComponents(components::Name::typeId));
+  manager.Each<components::Name>(
+      [&](const Entity &, components::Name *) -> bool
+      {
+        return true;
+      });
+  EXPECT_NE(constManager.Component<components::Name>(e1),
+      constManager.Component<components::Name>(e2));
+  EXPECT_EQ(longName, constManager.Component<components::Name>(e1)->Data());
+
+  // Only new entities can be considered, and they share older instances
+  EXPECT_EQ(1u, manager.InternComponents(components::Name::typeId));
+  manager.RunClearNewlyCreatedEntities();
+  Entity e4 = manager.CreateEntity();
+  manager.CreateComponent(e4, components::Name(longName));
+  EXPECT_EQ(1u, manager.InternComponents(components::Name::typeId, true));
+  EXPECT_EQ(constManager.Component<components::Name>(e1),
+      constManager.Component<components::Name>(e4));
+
+  // Removing entities releases their reference
+  manager.RequestRemoveEntity(e1);
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(longName, constManager.Component<components::Name>(e4)->Data());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, CachedViewsAfterClear)
+{
+  auto values = [&]()
+  {
+    std::vector<int> result;
+    manager.Each<IntComponent>(
+        [&](const Entity &, const IntComponent *_int) -> bool
+        {
+          result.push_back(_int->Data());
+          return true;
+        });
+    return result;
+  };
+
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  EXPECT_EQ(std::vector<int>({1}), values());
+
+  // Removing all entities clears the views, which must not be used anymore
+  manager.RequestRemoveEntities();
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(values().empty());
+
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent(e2, IntComponent(2));
+  EXPECT_EQ(std::vector<int>({2}), values());
+
+  // Copying also clears the views
+  EntityCompMgrTest other;
+  Entity e3 = other.CreateEntity();
+  other.CreateComponent(e3, IntComponent(3));
+  manager.CopyFrom(other);
+  EXPECT_EQ(std::vector<int>({3}), values());
+
+  // Each ECM has its own views
+  EntityCompMgrTest empty;
+  int count{0};
+  empty.Each<IntComponent>([&](const Entity &, const IntComponent *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(0, count);
+  EXPECT_EQ(std::vector<int>({3}), values());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, NameIndex)
+{
+  Entity model1 = manager.CreateEntity();
+  manager.CreateComponent(model1, components::Name("model"));
+  manager.CreateComponent(model1, components::Model());
+  Entity model2 = manager.CreateEntity();
+  manager.CreateComponent(model2, components::Name("model2"));
+  manager.CreateComponent(model2, components::Model());
+  std::vector<Entity> links;
+  for (Entity parent : {model1, model2})
+  {
+    links.push_back(manager.CreateEntity());
+    manager.CreateComponent(links.back(), components::Name("link"));
+    manager.CreateComponent(links.back(), components::ParentEntity(parent));
+    manager.CreateComponent(links.back(), components::Link());
+  }
+
+  EXPECT_EQ(std::vector<Entity>({model1}), manager.EntitiesByName("model"));
+  EXPECT_EQ(links, manager.EntitiesByName("link"));
+  EXPECT_TRUE(manager.EntitiesByName("missing").empty());
+  EXPECT_EQ(std::vector<Entity>({links[1]}),
+      manager.ChildrenByName(model2, "link"));
+  EXPECT_EQ(std::vector<Entity>({model1}),
+      manager.ChildrenByName(kNullEntity, "model"));
+  EXPECT_EQ(links[1], manager.EntityByComponents(components::Name("link"),
+      components::ParentEntity(model2), components::Link()));
+  EXPECT_EQ(kNullEntity, manager.EntityByComponents(components::Name("link"),
+      components::Model()));
+
+  // Changes made after the index was built are followed
+  manager.SetComponentData<components::Name>(model1, "renamed");
+  EXPECT_TRUE(manager.EntitiesByName("model").empty());
+  manager.Component<components::ParentEntity>(links[0])->Data() = model2;
+  manager.SetChanged(links[0], components::ParentEntity::typeId);
+  EXPECT_EQ(links, manager.ChildrenByName(model2, "link"));
+  EXPECT_EQ(links, manager.EntitiesByComponents(components::Name("link"),
+      components::ParentEntity(model2)));
+
+  manager.RemoveComponent<components::Name>(links[1]);
+  EXPECT_EQ(std::vector<Entity>({links[0]}), manager.EntitiesByName("link"));
+  manager.RequestRemoveEntity(model1, false);
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.EntitiesByName("renamed").empty());
+
+  // A copy has the names of its source
+  EntityCompMgrTest other;
+  Entity entity = other.CreateEntity();
+  other.CreateComponent(entity, components::Name("other"));
+  manager.CopyFrom(other);
+  EXPECT_TRUE(manager.EntitiesByName("link").empty());
+  EXPECT_EQ(std::vector<Entity>({entity}), manager.EntitiesByName("other"));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, NameIndexPointerWrites)
+{
+  Entity model1 = manager.CreateEntity();
+  manager.CreateComponent(model1, components::Name("model1"));
+  Entity model2 = manager.CreateEntity();
+  manager.CreateComponent(model2, components::Name("model2"));
+  Entity link = manager.CreateEntity();
+  manager.CreateComponent(link, components::Name("link"));
+  manager.CreateComponent(link, components::ParentEntity(model1));
+
+  // Build the index
+  EXPECT_EQ(std::vector<Entity>({link}),
+      manager.ChildrenByName(model1, "link"));
+
+  // Reparent and rename through pointers, without marking them as changed
+  manager.Component<components::ParentEntity>(link)->Data() = model2;
+  EXPECT_TRUE(manager.ChildrenByName(model1, "link").empty());
+  EXPECT_EQ(std::vector<Entity>({link}),
+      manager.ChildrenByName(model2, "link"));
+
+  manager.Component<components::Name>(link)->Data() = "renamed";
+  EXPECT_TRUE(manager.EntitiesByName("link").empty());
+  EXPECT_EQ(std::vector<Entity>({link}),
+      manager.ChildrenByName(model2, "renamed"));
+  EXPECT_EQ(link, manager.EntityByComponents(components::Name("renamed"),
+      components::ParentEntity(model2)));
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_SUITE_P(EntityComponentManagerRepeat,
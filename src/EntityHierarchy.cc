@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "EntityHierarchy.hh"
+
+#include <algorithm>
+#include <string>
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::AddEntity(Entity _entity)
+{
+  if (_entity == kNullEntity || this->slots.count(_entity) > 0u)
+    return false;
+
+  std::uint32_t slot;
+  if (!this->freeSlots.empty())
+  {
+    slot = this->freeSlots.back();
+    this->freeSlots.pop_back();
+    this->entities[slot] = _entity;
+  }
+  else
+  {
+    slot = static_cast<std::uint32_t>(this->entities.size());
+    this->entities.push_back(_entity);
+    this->parent.push_back(kNoSlot);
+    this->firstChild.push_back(kNoSlot);
+    this->nextSibling.push_back(kNoSlot);
+    this->prevSibling.push_back(kNoSlot);
+  }
+  this->parent[slot] = kNoSlot;
+  this->firstChild[slot] = kNoSlot;
+  this->nextSibling[slot] = kNoSlot;
+  this->prevSibling[slot] = kNoSlot;
+
+  this->slots[_entity] = slot;
+  ++this->version;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::RemoveEntity(Entity _entity)
+{
+  auto it = this->slots.find(_entity);
+  if (it == this->slots.end())
+    return false;
+  const auto slot = it->second;
+  this->slots.erase(it);
+
+  this->Unlink(slot);
+  for (auto child = this->firstChild[slot]; child != kNoSlot;)
+  {
+    const auto next = this->nextSibling[child];
+    this->parent[child] = kNoSlot;
+    this->nextSibling[child] = kNoSlot;
+    this->prevSibling[child] = kNoSlot;
+    child = next;
+  }
+  this->firstChild[slot] = kNoSlot;
+
+  this->entities[slot] = kNullEntity;
+  this->freeSlots.push_back(slot);
+  ++this->version;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::Clear()
+{
+  this->slots.clear();
+  this->entities.clear();
+  this->parent.clear();
+  this->firstChild.clear();
+  this->nextSibling.clear();
+  this->prevSibling.clear();
+  this->freeSlots.clear();
+  ++this->version;
+}
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::HasEntity(Entity _entity) const
+{
+  return this->slots.find(_entity) != this->slots.end();
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityHierarchy::Size() const
+{
+  return this->slots.size();
+}
+
+//////////////////////////////////////////////////
+Entity EntityHierarchy::Parent(Entity _entity) const
+{
+  const auto slot = this->Slot(_entity);
+  if (slot == kNoSlot || this->parent[slot] == kNoSlot)
+    return kNullEntity;
+  return this->entities[this->parent[slot]];
+}
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::SetParent(Entity _child, Entity _parent)
+{
+  const auto childSlot = this->Slot(_child);
+  if (childSlot == kNoSlot)
+    return false;
+
+  std::uint32_t parentSlot{kNoSlot};
+  if (_parent != kNullEntity)
+  {
+    parentSlot = this->Slot(_parent);
+    if (parentSlot == kNoSlot || parentSlot == childSlot)
+      return false;
+  }
+
+  this->Unlink(childSlot);
+  if (parentSlot != kNoSlot)
+  {
+    this->parent[childSlot] = parentSlot;
+    this->nextSibling[childSlot] = this->firstChild[parentSlot];
+    if (this->firstChild[parentSlot] != kNoSlot)
+      this->prevSibling[this->firstChild[parentSlot]] = childSlot;
+    this->firstChild[parentSlot] = childSlot;
+  }
+  ++this->version;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Children(Entity _entity) const
+{
+  std::vector<Entity> children;
+  this->ForEachChild(_entity, [&](Entity _child)
+      {
+        children.push_back(_child);
+      });
+  std::sort(children.begin(), children.end());
+  return children;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Descendants(Entity _entity) const
+{
+  std::vector<Entity> result;
+  const auto start = this->Slot(_entity);
+  if (start == kNoSlot)
+    return result;
+
+  // The result doubles as the queue of the breadth first search. Since each
+  // entity has a single parent, a cycle can only come back to the start.
+  std::vector<std::uint32_t> queue{start};
+  for (std::size_t i = 0u; i < queue.size(); ++i)
+  {
+    result.push_back(this->entities[queue[i]]);
+    for (auto child = this->firstChild[queue[i]]; child != kNoSlot;
+         child = this->nextSibling[child])
+    {
+      if (child != start)
+        queue.push_back(child);
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Entities() const
+{
+  std::vector<Entity> result;
+  result.reserve(this->slots.size());
+  for (const auto &[entity, slot] : this->slots)
+    result.push_back(entity);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &EntityHierarchy::TopologicalOrder() const
+{
+  if (this->topologicalOrderVersion == this->version)
+    return this->topologicalOrder;
+
+  this->topologicalOrder.clear();
+  this->topologicalOrder.reserve(this->slots.size());
+  std::vector<bool> visited(this->entities.size(), false);
+  std::vector<std::uint32_t> queue;
+  auto visit = [&](std::uint32_t _root)
+  {
+    queue.assign(1u, _root);
+    visited[_root] = true;
+    for (std::size_t i = 0u; i < queue.size(); ++i)
+    {
+      this->topologicalOrder.push_back(this->entities[queue[i]]);
+      for (auto child = this->firstChild[queue[i]]; child != kNoSlot;
+           child = this->nextSibling[child])
+      {
+        if (!visited[child])
+        {
+          visited[child] = true;
+          queue.push_back(child);
+        }
+      }
+    }
+  };
+
+  for (std::uint32_t slot = 0u; slot < this->entities.size(); ++slot)
+  {
+    if (this->entities[slot] != kNullEntity &&
+        this->parent[slot] == kNoSlot)
+    {
+      visit(slot);
+    }
+  }
+
+  // Entities in parent cycles have no root
+  for (std::uint32_t slot = 0u; slot < this->entities.size(); ++slot)
+  {
+    if (this->entities[slot] != kNullEntity && !visited[slot])
+      visit(slot);
+  }
+
+  this->topologicalOrderVersion = this->version;
+  return this->topologicalOrder;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t EntityHierarchy::Version() const
+{
+  return this->version;
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::BuildGraph(
+    math::graph::DirectedGraph<Entity, bool> &_graph) const
+{
+  _graph = math::graph::DirectedGraph<Entity, bool>();
+  for (const Entity entity : this->TopologicalOrder())
+  {
+    _graph.AddVertex(std::to_string(entity), entity, entity);
+    const Entity parentEntity = this->Parent(entity);
+    if (parentEntity != kNullEntity)
+      _graph.AddEdge({parentEntity, entity}, true);
+  }
+}
+
+//////////////////////////////////////////////////
+std::uint32_t EntityHierarchy::Slot(Entity _entity) const
+{
+  auto it = this->slots.find(_entity);
+  return it == this->slots.end() ? kNoSlot : it->second;
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::Unlink(std::uint32_t _slot)
+{
+  const auto parentSlot = this->parent[_slot];
+  if (parentSlot == kNoSlot)
+    return;
+
+  const auto prev = this->prevSibling[_slot];
+  const auto next = this->nextSibling[_slot];
+  if (prev != kNoSlot)
+    this->nextSibling[prev] = next;
+  else
+    this->firstChild[parentSlot] = next;
+  if (next != kNoSlot)
+    this->prevSibling[next] = prev;
+
+  this->parent[_slot] = kNoSlot;
+  this->nextSibling[_slot] = kNoSlot;
+  this->prevSibling[_slot] = kNoSlot;
+}
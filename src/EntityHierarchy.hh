@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_ENTITYHIERARCHY_HH_
+#define GZ_SIM_ENTITYHIERARCHY_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/graph/Graph.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class EntityHierarchy EntityHierarchy.hh
+    /// \brief Parent-child tree of entities.
+    ///
+    /// Each entity gets a slot in flat arrays that hold the slot of its
+    /// parent, of its first child and of its next and previous siblings, so
+    /// parent and child queries don't allocate, and removing an entity
+    /// unlinks it in constant time. Slots of removed entities are reused.
+    /// An entity has at most one parent.
+    ///
+    /// The hierarchy is not thread safe, including the const functions that
+    /// build cached data.
+    class GZ_SIM_VISIBLE EntityHierarchy
+    {
+      /// \brief Add an entity without a parent.
+      /// \param[in] _entity The entity.
+      /// \return False if the entity is kNullEntity or already exists.
+      public: bool AddEntity(Entity _entity);
+
+      /// \brief Remove an entity. It's detached from its parent, and its
+      /// children are left without a parent.
+      /// \param[in] _entity The entity.
+      /// \return False if the entity doesn't exist.
+      public: bool RemoveEntity(Entity _entity);
+
+      /// \brief Remove all entities.
+      public: void Clear();
+
+      /// \brief Get whether an entity exists.
+      /// \param[in] _entity The entity.
+      /// \return True if it exists.
+      public: bool HasEntity(Entity _entity) const;
+
+      /// \brief Get the number of entities.
+      /// \return Number of entities.
+      public: std::size_t Size() const;
+
+      /// \brief Get the parent of an entity.
+      /// \param[in] _entity The entity.
+      /// \return The parent, or kNullEntity if the entity doesn't exist or
+      /// has no parent.
+      public: Entity Parent(Entity _entity) const;
+
+      /// \brief Set the parent of an entity, replacing its current parent.
+      /// \param[in] _child The entity.
+      /// \param[in] _parent The new parent, or kNullEntity to leave the
+      /// entity without a parent.
+      /// \return False if either entity doesn't exist, or if they're the
+      /// same entity. The entity keeps its parent in that case.
+      public: bool SetParent(Entity _child, Entity _parent);
+
+      /// \brief Get the children of an entity.
+      /// \param[in] _entity The entity.
+      /// \return The children, sorted in ascending order.
+      public: std::vector<Entity> Children(Entity _entity) const;
+
+      /// \brief Call a function for each child of an entity, in no
+      /// particular order. The hierarchy must not be modified by the
+      /// function.
+      /// \param[in] _entity The entity.
+      /// \param[in] _f Function called with each child.
+      public: template <typename Function>
+              void ForEachChild(Entity _entity, Function _f) const
+      {
+        const auto slot = this->Slot(_entity);
+        if (slot == kNoSlot)
+          return;
+        for (auto child = this->firstChild[slot]; child != kNoSlot;
+             child = this->nextSibling[child])
+        {
+          _f(this->entities[child]);
+        }
+      }
+
+      /// \brief Get an entity and all of its descendants, in breadth first
+      /// order.
+      /// \param[in] _entity The entity.
+      /// \return The entity followed by its descendants, or an empty vector
+      /// if the entity doesn't exist.
+      public: std::vector<Entity> Descendants(Entity _entity) const;
+
+      /// \brief Get all entities.
+      /// \return The entities, sorted in ascending order.
+      public: std::vector<Entity> Entities() const;
+
+      /// \brief Get all entities, ordered so that parents come before their
+      /// children. The order is cached until the hierarchy changes.
+      /// \return The entities in topological order.
+      public: const std::vector<Entity> &TopologicalOrder() const;
+
+      /// \brief Get a counter that's incremented on every change, so that
+      /// data derived from the hierarchy can be cached.
+      /// \return The version.
+      public: std::uint64_t Version() const;
+
+      /// \brief Build a graph with a vertex per entity, whose ID and data are
+      /// the entity, and an edge from each parent to each of its children.
+      /// \param[out] _graph Graph to fill. Its previous contents are
+      /// discarded.
+      public: void BuildGraph(math::graph::DirectedGraph<Entity, bool> &_graph)
+                  const;
+
+      /// \brief Get the slot of an entity.
+      /// \param[in] _entity The entity.
+      /// \return The slot, or kNoSlot if the entity doesn't exist.
+      private: std::uint32_t Slot(Entity _entity) const;
+
+      /// \brief Detach an entity from its parent and siblings.
+      /// \param[in] _slot Slot of the entity.
+      private: void Unlink(std::uint32_t _slot);
+
+      /// \brief Slot value that stands for no entity.
+      private: static constexpr std::uint32_t kNoSlot{UINT32_MAX};
+
+      /// \brief Slot of each entity.
+      private: std::unordered_map<Entity, std::uint32_t> slots;
+
+      /// \brief Entity of each slot, kNullEntity for free slots.
+      private: std::vector<Entity> entities;
+
+      /// \brief Slot of the parent of each slot.
+      private: std::vector<std::uint32_t> parent;
+
+      /// \brief Slot of the first child of each slot.
+      private: std::vector<std::uint32_t> firstChild;
+
+      /// \brief Slot of the next sibling of each slot.
+      private: std::vector<std::uint32_t> nextSibling;
+
+      /// \brief Slot of the previous sibling of each slot.
+      private: std::vector<std::uint32_t> prevSibling;
+
+      /// \brief Slots of removed entities that can be reused.
+      private: std::vector<std::uint32_t> freeSlots;
+
+      /// \brief Incremented on every change.
+      private: std::uint64_t version{0};
+
+      /// \brief Cached topological order.
+      private: mutable std::vector<Entity> topologicalOrder;
+
+      /// \brief Version of the hierarchy when topologicalOrder was computed.
+      private: mutable std::uint64_t topologicalOrderVersion{UINT64_MAX};
+    };
+    }
+  }
+}
+#endif
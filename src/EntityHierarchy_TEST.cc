@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "EntityHierarchy.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchy, ParentsAndChildren)
+{
+  EntityHierarchy hierarchy;
+  EXPECT_EQ(0u, hierarchy.Size());
+  EXPECT_FALSE(hierarchy.AddEntity(kNullEntity));
+
+  for (Entity entity = 1; entity <= 5; ++entity)
+    EXPECT_TRUE(hierarchy.AddEntity(entity));
+  EXPECT_FALSE(hierarchy.AddEntity(3));
+  EXPECT_EQ(5u, hierarchy.Size());
+
+  EXPECT_TRUE(hierarchy.SetParent(4, 1));
+  EXPECT_TRUE(hierarchy.SetParent(2, 1));
+  EXPECT_TRUE(hierarchy.SetParent(3, 2));
+  EXPECT_FALSE(hierarchy.SetParent(3, 3));
+  EXPECT_FALSE(hierarchy.SetParent(3, 10));
+  EXPECT_FALSE(hierarchy.SetParent(10, 1));
+
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(1));
+  EXPECT_EQ(1u, hierarchy.Parent(2));
+  EXPECT_EQ(2u, hierarchy.Parent(3));
+  EXPECT_EQ((std::vector<Entity>{2, 4}), hierarchy.Children(1));
+  EXPECT_TRUE(hierarchy.Children(5).empty());
+
+  // Reparenting moves the entity with its descendants
+  EXPECT_TRUE(hierarchy.SetParent(2, 5));
+  EXPECT_EQ((std::vector<Entity>{4}), hierarchy.Children(1));
+  EXPECT_EQ((std::vector<Entity>{5, 2, 3}), hierarchy.Descendants(5));
+  EXPECT_TRUE(hierarchy.Descendants(10).empty());
+
+  EXPECT_TRUE(hierarchy.SetParent(2, kNullEntity));
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(2));
+  EXPECT_TRUE(hierarchy.Children(5).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchy, RemoveEntity)
+{
+  EntityHierarchy hierarchy;
+  for (Entity entity = 1; entity <= 4; ++entity)
+    hierarchy.AddEntity(entity);
+  hierarchy.SetParent(2, 1);
+  hierarchy.SetParent(3, 2);
+  hierarchy.SetParent(4, 2);
+
+  EXPECT_TRUE(hierarchy.RemoveEntity(2));
+  EXPECT_FALSE(hierarchy.RemoveEntity(2));
+  EXPECT_FALSE(hierarchy.HasEntity(2));
+  EXPECT_TRUE(hierarchy.Children(1).empty());
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(3));
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(4));
+  EXPECT_EQ((std::vector<Entity>{1, 3, 4}), hierarchy.Entities());
+
+  // The free slot is reused without keeping old links
+  EXPECT_TRUE(hierarchy.AddEntity(7));
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(7));
+  EXPECT_TRUE(hierarchy.Children(7).empty());
+
+  hierarchy.Clear();
+  EXPECT_EQ(0u, hierarchy.Size());
+  EXPECT_FALSE(hierarchy.HasEntity(1));
+}
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchy, TopologicalOrder)
+{
+  EntityHierarchy hierarchy;
+  for (Entity entity = 1; entity <= 6; ++entity)
+    hierarchy.AddEntity(entity);
+  // Children with lower IDs than their parents
+  hierarchy.SetParent(1, 6);
+  hierarchy.SetParent(2, 1);
+  hierarchy.SetParent(3, 6);
+
+  const auto version = hierarchy.Version();
+  auto order = hierarchy.TopologicalOrder();
+  ASSERT_EQ(6u, order.size());
+  auto position = [&](Entity _entity)
+  {
+    return std::find(order.begin(), order.end(), _entity) - order.begin();
+  };
+  EXPECT_LT(position(6), position(1));
+  EXPECT_LT(position(6), position(3));
+  EXPECT_LT(position(1), position(2));
+  EXPECT_EQ(version, hierarchy.Version());
+
+  // A parent cycle has no root, but its entities are still listed
+  hierarchy.SetParent(4, 5);
+  hierarchy.SetParent(5, 4);
+  EXPECT_NE(version, hierarchy.Version());
+  EXPECT_EQ(6u, hierarchy.TopologicalOrder().size());
+  EXPECT_EQ((std::vector<Entity>{4, 5}), hierarchy.Descendants(4));
+
+  math::graph::DirectedGraph<Entity, bool> graph;
+  hierarchy.BuildGraph(graph);
+  EXPECT_EQ(6u, graph.Vertices().size());
+  EXPECT_EQ(5u, graph.Edges().size());
+  EXPECT_EQ(1u, graph.AdjacentsTo(2).count(1));
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "EntityIndexAllocator.hh"
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+std::size_t EntityIndexAllocator::Assign(Entity _entity)
+{
+  auto it = this->indices.find(_entity);
+  if (it != this->indices.end())
+    return it->second;
+
+  std::size_t index;
+  if (!this->freeIndices.empty())
+  {
+    index = this->freeIndices.back();
+    this->freeIndices.pop_back();
+  }
+  else
+  {
+    index = this->capacity++;
+  }
+
+  this->indices.emplace(_entity, index);
+  return index;
+}
+
+//////////////////////////////////////////////////
+bool EntityIndexAllocator::Release(Entity _entity)
+{
+  auto it = this->indices.find(_entity);
+  if (it == this->indices.end())
+    return false;
+
+  this->freeIndices.push_back(it->second);
+  this->indices.erase(it);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void EntityIndexAllocator::ReleaseAll()
+{
+  for (const auto &[entity, index] : this->indices)
+    this->freeIndices.push_back(index);
+  this->indices.clear();
+}
+
+//////////////////////////////////////////////////
+std::optional<std::size_t> EntityIndexAllocator::Index(Entity _entity) const
+{
+  auto it = this->indices.find(_entity);
+  if (it == this->indices.end())
+    return std::nullopt;
+  return it->second;
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityIndexAllocator::Capacity() const
+{
+  return this->capacity;
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityIndexAllocator::Count() const
+{
+  return this->indices.size();
+}
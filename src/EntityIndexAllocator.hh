@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_ENTITYINDEXALLOCATOR_HH_
+#define GZ_SIM_ENTITYINDEXALLOCATOR_HH_
+
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class EntityIndexAllocator EntityIndexAllocator.hh
+    /// \brief Gives live entities dense indices, reusing the indices of
+    /// released entities.
+    ///
+    /// Entity IDs themselves aren't touched: they keep the full width of
+    /// Entity and keep increasing from the entity create offset, so a new
+    /// entity never gets the ID of one that was removed and stale IDs held by
+    /// external clients never resolve to a new entity. Only the index is
+    /// recycled, which is in the range [0, Capacity()) and can be used to
+    /// index flat arrays. Since slots are reused, Capacity() is bounded by
+    /// the largest number of entities alive at once.
+    ///
+    /// The allocator is not thread safe.
+    class GZ_SIM_VISIBLE EntityIndexAllocator
+    {
+      /// \brief Give an entity an index, reusing a released one if there is
+      /// one.
+      /// \param[in] _entity The entity.
+      /// \return The index of the entity, which is its existing index if it
+      /// already had one.
+      public: std::size_t Assign(Entity _entity);
+
+      /// \brief Release the index of an entity so it can be reused.
+      /// \param[in] _entity The entity.
+      /// \return False if the entity doesn't have an index.
+      public: bool Release(Entity _entity);
+
+      /// \brief Release the indices of all entities.
+      public: void ReleaseAll();
+
+      /// \brief Get the dense index of an entity.
+      /// \param[in] _entity The entity.
+      /// \return The index, or std::nullopt if the entity doesn't have one.
+      public: std::optional<std::size_t> Index(Entity _entity) const;
+
+      /// \brief Get the number of indices, used or not. All dense indices are
+      /// smaller than this.
+      /// \return Number of indices.
+      public: std::size_t Capacity() const;
+
+      /// \brief Get the number of entities with an index.
+      /// \return Number of entities.
+      public: std::size_t Count() const;
+
+      /// \brief Index of each entity.
+      private: std::unordered_map<Entity, std::size_t> indices;
+
+      /// \brief Released indices that can be reused.
+      private: std::vector<std::size_t> freeIndices;
+
+      /// \brief Number of indices handed out so far.
+      private: std::size_t capacity{0};
+    };
+    }
+  }
+}
+#endif
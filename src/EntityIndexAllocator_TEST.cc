@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "EntityIndexAllocator.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(EntityIndexAllocator, Consecutive)
+{
+  EntityIndexAllocator allocator;
+  EXPECT_EQ(0u, allocator.Capacity());
+
+  for (Entity entity = 1; entity <= 10; ++entity)
+    EXPECT_EQ(entity - 1, allocator.Assign(entity));
+
+  // Assigning twice keeps the index
+  EXPECT_EQ(4u, allocator.Assign(5));
+
+  EXPECT_EQ(10u, allocator.Count());
+  EXPECT_EQ(10u, allocator.Capacity());
+  ASSERT_TRUE(allocator.Index(1).has_value());
+  EXPECT_EQ(0u, *allocator.Index(1));
+  EXPECT_EQ(9u, *allocator.Index(10));
+  EXPECT_FALSE(allocator.Index(kNullEntity).has_value());
+  EXPECT_FALSE(allocator.Index(11).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityIndexAllocator, Recycle)
+{
+  EntityIndexAllocator allocator;
+  allocator.Assign(1);
+  allocator.Assign(2);
+
+  EXPECT_TRUE(allocator.Release(1));
+  EXPECT_FALSE(allocator.Release(1));
+  EXPECT_FALSE(allocator.Index(1).has_value());
+  EXPECT_EQ(1u, allocator.Count());
+
+  // The index is reused by the next entity
+  EXPECT_EQ(0u, allocator.Assign(3));
+  EXPECT_EQ(1u, *allocator.Index(2));
+  EXPECT_EQ(2u, allocator.Capacity());
+
+  // Stale IDs don't resolve to the new entity
+  EXPECT_FALSE(allocator.Index(1).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityIndexAllocator, FullWidth)
+{
+  // IDs past the create offsets used by log playback and the GUI, and at
+  // the top of the range, keep their own indices
+  EntityIndexAllocator allocator;
+  const Entity offset = std::numeric_limits<Entity>::max() / 2;
+  const Entity last = std::numeric_limits<Entity>::max() - 1;
+  EXPECT_EQ(0u, allocator.Assign(offset + 1));
+  EXPECT_EQ(1u, allocator.Assign(offset + 1 + (Entity{1} << 32)));
+  EXPECT_EQ(2u, allocator.Assign(last));
+  EXPECT_EQ(0u, *allocator.Index(offset + 1));
+  EXPECT_EQ(2u, *allocator.Index(last));
+  EXPECT_FALSE(allocator.Index(offset + 2).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityIndexAllocator, BoundedCapacity)
+{
+  EntityIndexAllocator allocator;
+
+  // Spawning and removing entities keeps reusing the same indices
+  Entity next{1};
+  for (int i = 0; i < 1000; ++i)
+  {
+    const Entity a = next++;
+    const Entity b = next++;
+    allocator.Assign(a);
+    allocator.Assign(b);
+    EXPECT_TRUE(allocator.Release(a));
+    EXPECT_TRUE(allocator.Release(b));
+  }
+  EXPECT_EQ(0u, allocator.Count());
+  EXPECT_EQ(2u, allocator.Capacity());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityIndexAllocator, ReleaseAll)
+{
+  EntityIndexAllocator allocator;
+  allocator.Assign(1);
+  allocator.Assign(2);
+  allocator.ReleaseAll();
+
+  EXPECT_EQ(0u, allocator.Count());
+  EXPECT_FALSE(allocator.Index(1).has_value());
+  EXPECT_FALSE(allocator.Index(2).has_value());
+
+  EXPECT_GT(2u, allocator.Assign(3));
+  EXPECT_EQ(2u, allocator.Capacity());
+}
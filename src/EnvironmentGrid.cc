@@ -0,0 +1,598 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "EnvironmentGrid.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <gz/common/Console.hh>
+#include <gz/common/CSVStreams.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/math/TimeVaryingVolumetricGrid.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Magic string at the start of grid files.
+static const char kGridMagic[8] = {'G', 'Z', 'E', 'N', 'V', 'G', 'R', 'D'};
+
+/// \brief Version of the grid files written.
+static const std::uint32_t kGridVersion{1u};
+
+/// \brief Bytes used by the name of each field.
+static const std::size_t kFieldNameSize{64u};
+
+/// \brief Layout of the start of grid files.
+struct EnvironmentGridHeader
+{
+  /// \brief Always kGridMagic.
+  char magic[8];
+
+  /// \brief Version of the file.
+  std::uint32_t version;
+
+  /// \brief Number of fields.
+  std::uint32_t fieldCount;
+
+  /// \brief Number of samples along the time, x, y and z axes.
+  std::uint64_t counts[4];
+};
+
+static_assert(sizeof(EnvironmentGridHeader) == 48u,
+    "The header of grid files must be 48 bytes");
+
+/// \brief Private data for the EnvironmentGrid class.
+class gz::sim::EnvironmentGridPrivate
+{
+  /// \brief First and one past the last index of samples along time, x, y
+  /// and z.
+  public: using Ranges = std::array<std::pair<std::size_t, std::size_t>, 4>;
+
+  /// \brief Get the samples covering a region and a window of time.
+  /// \param[in] _region The region, or nullopt for all samples.
+  /// \param[in] _times First and last time, or nullopt for all samples.
+  /// \return The samples along each axis.
+  public: Ranges RegionRanges(
+              const std::optional<math::AxisAlignedBox> &_region,
+              const std::optional<std::pair<double, double>> &_times) const;
+
+  /// \brief Get the index of a value.
+  /// \param[in] _field Index of the field.
+  /// \param[in] _indices Index of the sample along time, x, y and z.
+  /// \return Index of the value from the first one.
+  public: std::size_t Index(std::size_t _field,
+              const std::array<std::size_t, 4> &_indices) const
+  {
+    std::size_t index = _field;
+    for (std::size_t axis : {0u, 3u, 2u, 1u})
+      index = index * this->axes[axis].size() + _indices[axis];
+    return index;
+  }
+
+  /// \brief Unmap the file, if any.
+  public: void Close()
+  {
+#ifndef _WIN32
+    if (nullptr != this->mapped)
+      munmap(this->mapped, this->size);
+#endif
+    this->mapped = nullptr;
+    this->buffer.clear();
+    this->values = nullptr;
+  }
+
+  /// \brief Mapped file, or nullptr.
+  public: void *mapped{nullptr};
+
+  /// \brief Content of the file where it can't be mapped.
+  public: std::vector<char> buffer;
+
+  /// \brief Size of the file.
+  public: std::size_t size{0u};
+
+  /// \brief Coordinates of the samples along time, x, y and z.
+  public: std::array<std::vector<double>, 4> axes;
+
+  /// \brief Names of the fields.
+  public: std::vector<std::string> fields;
+
+  /// \brief First value of the first field, within the file.
+  public: const float *values{nullptr};
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the range of samples of an axis covering an interval, with one
+/// more sample on each side.
+/// \param[in] _axis Sorted coordinates.
+/// \param[in] _min Start of the interval.
+/// \param[in] _max End of the interval.
+/// \return First and one past the last index.
+static std::pair<std::size_t, std::size_t> axisRange(
+    const std::vector<double> &_axis, double _min, double _max)
+{
+  auto begin = static_cast<std::size_t>(
+      std::lower_bound(_axis.begin(), _axis.end(), _min) - _axis.begin());
+  auto end = static_cast<std::size_t>(
+      std::upper_bound(_axis.begin(), _axis.end(), _max) - _axis.begin());
+  if (begin > 0u)
+    --begin;
+  if (end < _axis.size())
+    ++end;
+  return {begin, std::max(begin, end)};
+}
+
+//////////////////////////////////////////////////
+EnvironmentGrid::EnvironmentGrid()
+  : dataPtr(std::make_unique<EnvironmentGridPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+EnvironmentGrid::~EnvironmentGrid()
+{
+  this->dataPtr->Close();
+}
+
+//////////////////////////////////////////////////
+bool EnvironmentGrid::IsGridFile(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  char magic[sizeof(kGridMagic)];
+  return file.read(magic, sizeof(magic)) &&
+      std::memcmp(magic, kGridMagic, sizeof(kGridMagic)) == 0;
+}
+
+//////////////////////////////////////////////////
+bool EnvironmentGrid::Open(const std::string &_path)
+{
+  GZ_PROFILE("EnvironmentGrid::Open");
+  this->dataPtr->Close();
+
+  const char *data{nullptr};
+#ifndef _WIN32
+  const int fd = open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    gzerr << "Failed to open environment grid [" << _path << "]: "
+          << std::strerror(errno) << std::endl;
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) == 0 && status.st_size > 0)
+  {
+    this->dataPtr->size = static_cast<std::size_t>(status.st_size);
+    void *memory = mmap(nullptr, this->dataPtr->size, PROT_READ,
+        MAP_PRIVATE, fd, 0);
+    if (memory != MAP_FAILED)
+    {
+      this->dataPtr->mapped = memory;
+      data = static_cast<const char *>(memory);
+    }
+  }
+  close(fd);
+#else
+  std::ifstream file(_path, std::ios::binary);
+  this->dataPtr->buffer.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  this->dataPtr->size = this->dataPtr->buffer.size();
+  if (!this->dataPtr->buffer.empty())
+    data = this->dataPtr->buffer.data();
+#endif
+
+  if (nullptr == data || this->dataPtr->size < sizeof(EnvironmentGridHeader))
+  {
+    gzerr << "Failed to map environment grid [" << _path << "]."
+          << std::endl;
+    this->dataPtr->Close();
+    return false;
+  }
+
+  EnvironmentGridHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, kGridMagic, sizeof(kGridMagic)) != 0 ||
+      header.version != kGridVersion)
+  {
+    gzerr << "File [" << _path << "] isn't a version [" << kGridVersion
+          << "] environment grid." << std::endl;
+    this->dataPtr->Close();
+    return false;
+  }
+
+  // Check that the file holds everything the header describes, without
+  // overflowing on corrupted counts
+  const std::size_t size = this->dataPtr->size;
+  std::size_t axesSize{0u};
+  std::size_t cells{1u};
+  bool valid{true};
+  for (const auto count : header.counts)
+  {
+    valid = valid && count > 0u && count <= size / sizeof(double) &&
+        cells <= size / count;
+    if (!valid)
+      break;
+    axesSize += count;
+    cells *= count;
+  }
+  const std::size_t offset = sizeof(header) + axesSize * sizeof(double) +
+      header.fieldCount * kFieldNameSize;
+  valid = valid && header.fieldCount > 0u && offset <= size &&
+      cells <= (size - offset) / sizeof(float) / header.fieldCount;
+  if (!valid)
+  {
+    gzerr << "Environment grid [" << _path << "] is truncated or corrupted."
+          << std::endl;
+    this->dataPtr->Close();
+    return false;
+  }
+
+  const char *cursor = data + sizeof(header);
+  for (std::size_t axis = 0u; axis < 4u; ++axis)
+  {
+    auto &coordinates = this->dataPtr->axes[axis];
+    coordinates.resize(header.counts[axis]);
+    std::memcpy(coordinates.data(), cursor,
+        coordinates.size() * sizeof(double));
+    cursor += coordinates.size() * sizeof(double);
+  }
+
+  this->dataPtr->fields.clear();
+  for (std::uint32_t field = 0u; field < header.fieldCount; ++field)
+  {
+    this->dataPtr->fields.emplace_back(cursor,
+        strnlen(cursor, kFieldNameSize));
+    cursor += kFieldNameSize;
+  }
+
+  this->dataPtr->values = reinterpret_cast<const float *>(cursor);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &EnvironmentGrid::Axis(std::size_t _axis) const
+{
+  return this->dataPtr->axes.at(_axis);
+}
+
+//////////////////////////////////////////////////
+const std::vector<std::string> &EnvironmentGrid::Fields() const
+{
+  return this->dataPtr->fields;
+}
+
+//////////////////////////////////////////////////
+float EnvironmentGrid::Value(std::size_t _field,
+    const std::array<std::size_t, 4> &_indices) const
+{
+  return this->dataPtr->values[this->dataPtr->Index(_field, _indices)];
+}
+
+//////////////////////////////////////////////////
+EnvironmentGridPrivate::Ranges EnvironmentGridPrivate::RegionRanges(
+    const std::optional<math::AxisAlignedBox> &_region,
+    const std::optional<std::pair<double, double>> &_times) const
+{
+  Ranges ranges;
+  ranges[0] = _times ?
+      axisRange(this->axes[0], _times->first, _times->second) :
+      std::make_pair(std::size_t{0u}, this->axes[0].size());
+  for (std::size_t axis = 1u; axis < 4u; ++axis)
+  {
+    ranges[axis] = _region ?
+        axisRange(this->axes[axis], _region->Min()[axis - 1u],
+            _region->Max()[axis - 1u]) :
+        std::make_pair(std::size_t{0u}, this->axes[axis].size());
+  }
+  return ranges;
+}
+
+//////////////////////////////////////////////////
+components::EnvironmentalData::FrameT EnvironmentGrid::Frame(
+    const std::optional<math::AxisAlignedBox> &_region,
+    std::size_t &_cells,
+    const std::optional<std::pair<double, double>> &_times) const
+{
+  GZ_PROFILE("EnvironmentGrid::Frame");
+
+  const auto &axes = this->dataPtr->axes;
+  const auto ranges = this->dataPtr->RegionRanges(_region, _times);
+  _cells = 1u;
+  for (const auto &range : ranges)
+    _cells *= range.second - range.first;
+
+  components::EnvironmentalData::FrameT frame;
+  for (std::size_t field = 0u; field < this->Fields().size(); ++field)
+  {
+    math::InMemoryTimeVaryingVolumetricGridFactory<double> factory;
+    std::array<std::size_t, 4> i;
+    for (i[0] = ranges[0].first; i[0] < ranges[0].second; ++i[0])
+    {
+      for (i[3] = ranges[3].first; i[3] < ranges[3].second; ++i[3])
+      {
+        for (i[2] = ranges[2].first; i[2] < ranges[2].second; ++i[2])
+        {
+          for (i[1] = ranges[1].first; i[1] < ranges[1].second; ++i[1])
+          {
+            const float value = this->Value(field, i);
+            if (std::isnan(value))
+              continue;
+            factory.AddPoint(axes[0][i[0]],
+                math::Vector3d(axes[1][i[1]], axes[2][i[2]], axes[3][i[3]]),
+                static_cast<double>(value));
+          }
+        }
+      }
+    }
+    frame[this->Fields()[field]] = factory.Build();
+  }
+  return frame;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<RegularGrid> EnvironmentGrid::Grid(
+    const std::optional<math::AxisAlignedBox> &_region,
+    const std::optional<std::pair<double, double>> &_times) const
+{
+  GZ_PROFILE("EnvironmentGrid::Grid");
+
+  const auto ranges = this->dataPtr->RegionRanges(_region, _times);
+  std::array<std::vector<double>, 4> axes;
+  std::size_t cells{1u};
+  for (std::size_t axis = 0u; axis < 4u; ++axis)
+  {
+    const auto &coordinates = this->dataPtr->axes[axis];
+    axes[axis].assign(coordinates.begin() + ranges[axis].first,
+        coordinates.begin() + ranges[axis].second);
+    cells *= axes[axis].size();
+  }
+
+  // Rows along x are contiguous in the file
+  std::vector<float> values;
+  values.reserve(cells * this->Fields().size());
+  for (std::size_t field = 0u; field < this->Fields().size(); ++field)
+  {
+    std::array<std::size_t, 4> i;
+    i[1] = ranges[1].first;
+    for (i[0] = ranges[0].first; i[0] < ranges[0].second; ++i[0])
+    {
+      for (i[3] = ranges[3].first; i[3] < ranges[3].second; ++i[3])
+      {
+        for (i[2] = ranges[2].first; i[2] < ranges[2].second; ++i[2])
+        {
+          const float *row =
+              this->dataPtr->values + this->dataPtr->Index(field, i);
+          values.insert(values.end(), row,
+              row + (ranges[1].second - ranges[1].first));
+        }
+      }
+    }
+  }
+  return std::make_shared<RegularGrid>(std::move(axes), this->Fields(),
+      std::move(values));
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<RegularGrid> EnvironmentGrid::ReadCsv(
+    const std::string &_csvPath, const std::string &_timeColumn,
+    const std::array<std::string, 3> &_spatialColumns, double _minDensity)
+{
+  GZ_PROFILE("EnvironmentGrid::ReadCsv");
+
+  std::ifstream csvFile(_csvPath);
+  if (!csvFile.is_open())
+  {
+    gzerr << "Failed to open [" << _csvPath << "]." << std::endl;
+    return nullptr;
+  }
+
+  // Columns of the time and the coordinates, the time being optional
+  common::CSVIStreamIterator row(csvFile);
+  const common::CSVIStreamIterator end;
+  if (row == end)
+  {
+    gzerr << "CSV file [" << _csvPath << "] is empty." << std::endl;
+    return nullptr;
+  }
+  const std::vector<std::string> header = *row;
+  std::array<std::optional<std::size_t>, 4> axisColumns;
+  std::vector<std::size_t> fieldColumns;
+  std::vector<std::string> fieldNames;
+  for (std::size_t column = 0u; column < header.size(); ++column)
+  {
+    if (header[column] == _timeColumn)
+      axisColumns[0] = column;
+    else if (header[column] == _spatialColumns[0])
+      axisColumns[1] = column;
+    else if (header[column] == _spatialColumns[1])
+      axisColumns[2] = column;
+    else if (header[column] == _spatialColumns[2])
+      axisColumns[3] = column;
+    else
+    {
+      fieldColumns.push_back(column);
+      fieldNames.push_back(header[column].substr(0u, kFieldNameSize - 1u));
+    }
+  }
+  for (std::size_t axis = 1u; axis < 4u; ++axis)
+  {
+    if (!axisColumns[axis])
+    {
+      gzerr << "CSV file [" << _csvPath << "] has no ["
+            << _spatialColumns[axis - 1u] << "] column." << std::endl;
+      return nullptr;
+    }
+  }
+  if (fieldColumns.empty())
+  {
+    gzerr << "CSV file [" << _csvPath << "] has no data columns."
+          << std::endl;
+    return nullptr;
+  }
+
+  // Parse the coordinates of a row
+  auto coordinates = [&](const std::vector<std::string> &_row)
+  {
+    std::array<double, 4> result{0.0, 0.0, 0.0, 0.0};
+    for (std::size_t axis = 0u; axis < 4u; ++axis)
+    {
+      if (axisColumns[axis])
+        result[axis] = std::stod(_row.at(*axisColumns[axis]));
+    }
+    return result;
+  };
+
+  try
+  {
+    // The file is read twice, first to find the grid and then to fill it,
+    // so the rows aren't held in memory
+    std::array<std::set<double>, 4> axisSets;
+    std::size_t rows{0u};
+    for (++row; row != end; ++row, ++rows)
+    {
+      const auto sample = coordinates(*row);
+      for (std::size_t axis = 0u; axis < 4u; ++axis)
+        axisSets[axis].insert(sample[axis]);
+    }
+    std::array<std::vector<double>, 4> axes;
+    std::size_t cells{1u};
+    for (std::size_t axis = 0u; axis < 4u; ++axis)
+    {
+      axes[axis].assign(axisSets[axis].begin(), axisSets[axis].end());
+      axisSets[axis].clear();
+      cells *= axes[axis].size();
+    }
+
+    // Scattered samples would make a huge, mostly empty grid
+    if (static_cast<double>(rows) < _minDensity * static_cast<double>(cells))
+    {
+      gzdbg << "CSV file [" << _csvPath << "] has [" << rows << "] rows "
+            << "for [" << cells << "] grid cells, it isn't a regular grid."
+            << std::endl;
+      return nullptr;
+    }
+
+    std::vector<float> values(fieldNames.size() * cells,
+        std::numeric_limits<float>::quiet_NaN());
+    csvFile.clear();
+    csvFile.seekg(0);
+    row = common::CSVIStreamIterator(csvFile);
+    for (++row; row != end; ++row)
+    {
+      const auto sample = coordinates(*row);
+      std::array<std::size_t, 4> indices;
+      for (std::size_t axis = 0u; axis < 4u; ++axis)
+      {
+        indices[axis] = static_cast<std::size_t>(std::lower_bound(
+            axes[axis].begin(), axes[axis].end(), sample[axis]) -
+            axes[axis].begin());
+      }
+      for (std::size_t field = 0u; field < fieldColumns.size(); ++field)
+      {
+        const auto &text = row->at(fieldColumns[field]);
+        if (text.empty())
+          continue;
+        std::size_t index = field;
+        for (std::size_t axis : {0u, 3u, 2u, 1u})
+          index = index * axes[axis].size() + indices[axis];
+        values[index] = std::stof(text);
+      }
+    }
+
+    return std::make_shared<RegularGrid>(std::move(axes),
+        std::move(fieldNames), std::move(values));
+  }
+  catch (const std::exception &_e)
+  {
+    gzerr << "Failed to read [" << _csvPath << "]: " << _e.what()
+          << std::endl;
+    return nullptr;
+  }
+}
+
+//////////////////////////////////////////////////
+bool EnvironmentGrid::Write(const RegularGrid &_grid,
+    const std::string &_gridPath)
+{
+  EnvironmentGridHeader header;
+  std::memcpy(header.magic, kGridMagic, sizeof(kGridMagic));
+  header.version = kGridVersion;
+  header.fieldCount = static_cast<std::uint32_t>(_grid.Fields().size());
+  for (std::size_t axis = 0u; axis < 4u; ++axis)
+    header.counts[axis] = _grid.Axis(axis).size();
+
+  std::ofstream gridFile(_gridPath, std::ios::binary | std::ios::trunc);
+  gridFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (std::size_t axis = 0u; axis < 4u; ++axis)
+  {
+    const auto &coordinates = _grid.Axis(axis);
+    gridFile.write(reinterpret_cast<const char *>(coordinates.data()),
+        static_cast<std::streamsize>(coordinates.size() * sizeof(double)));
+  }
+  for (const auto &name : _grid.Fields())
+  {
+    char padded[kFieldNameSize] = {};
+    std::memcpy(padded, name.data(),
+        std::min(name.size(), kFieldNameSize - 1u));
+    gridFile.write(padded, sizeof(padded));
+  }
+  const auto &values = _grid.Values();
+  gridFile.write(reinterpret_cast<const char *>(values.data()),
+      static_cast<std::streamsize>(values.size() * sizeof(float)));
+  if (!gridFile)
+  {
+    gzerr << "Failed to write environment grid [" << _gridPath << "]."
+          << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool EnvironmentGrid::ConvertCsv(const std::string &_csvPath,
+    const std::string &_timeColumn,
+    const std::array<std::string, 3> &_spatialColumns,
+    const std::string &_gridPath)
+{
+  GZ_PROFILE("EnvironmentGrid::ConvertCsv");
+
+  const auto grid = ReadCsv(_csvPath, _timeColumn, _spatialColumns, 0.0);
+  if (nullptr == grid || !Write(*grid, _gridPath))
+    return false;
+
+  gzmsg << "Converted [" << _csvPath << "] into a grid of ["
+        << grid->Axis(0).size() << "x" << grid->Axis(1).size() << "x"
+        << grid->Axis(2).size() << "x" << grid->Axis(3).size()
+        << "] samples of [" << grid->Fields().size() << "] fields."
+        << std::endl;
+  return true;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_ENVIRONMENTGRID_HH_
+#define GZ_SIM_ENVIRONMENTGRID_HH_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+
+#include <gz/sim/components/Environment.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/RegularGrid.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class EnvironmentGridPrivate;
+
+    /// \class EnvironmentGrid EnvironmentGrid.hh
+    /// \brief Environmental data sampled on a regular grid, stored in a
+    /// binary file which is memory-mapped instead of parsed.
+    ///
+    /// The file holds, in native byte order, which is little-endian on all
+    /// supported platforms:
+    ///
+    /// 1. A 48 byte header: the magic string "GZENVGRD", a uint32 version,
+    ///    which is 1, a uint32 number of fields, and four uint64 numbers of
+    ///    samples along the time, x, y and z axes.
+    /// 2. The coordinates of the samples along each axis, as sorted doubles,
+    ///    first the times, then x, y and z.
+    /// 3. The name of each field, in 64 bytes padded with zeros.
+    /// 4. The values of each field, as floats, with x varying fastest, then
+    ///    y, z and time. Missing values are NaN.
+    ///
+    /// Only the pages of the samples which are read are loaded from disk,
+    /// so building a frame of a region, or of a window of time, of a large
+    /// grid is quick.
+    /// Convert CSV files with ConvertCsv, or the gz-sim-environment-convert
+    /// tool.
+    class GZ_SIM_VISIBLE EnvironmentGrid
+    {
+      /// \brief Constructor
+      public: EnvironmentGrid();
+
+      /// \brief Destructor. Unmaps the file.
+      public: ~EnvironmentGrid();
+
+      /// \brief Get whether a file starts like a grid file.
+      /// \param[in] _path Path of the file.
+      /// \return True if it's a grid file.
+      public: static bool IsGridFile(const std::string &_path);
+
+      /// \brief Map a grid file.
+      /// \param[in] _path Path of the file.
+      /// \return True if the file is a valid grid.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Get the coordinates of the samples along an axis.
+      /// \param[in] _axis 0 for time, then 1, 2 and 3 for x, y and z.
+      /// \return The sorted coordinates.
+      public: const std::vector<double> &Axis(std::size_t _axis) const;
+
+      /// \brief Get the names of the fields.
+      /// \return The names, in the order they're stored.
+      public: const std::vector<std::string> &Fields() const;
+
+      /// \brief Get a value.
+      /// \param[in] _field Index of the field.
+      /// \param[in] _indices Index of the sample along time, x, y and z.
+      /// \return The value, which is NaN if it's missing.
+      public: float Value(std::size_t _field,
+                  const std::array<std::size_t, 4> &_indices) const;
+
+      /// \brief Build a frame of the data, optionally within a region and
+      /// a window of time.
+      /// \param[in] _region Region of space to load, or nullopt for all of
+      /// the grid. One more sample is kept on each side, so the data can be
+      /// interpolated up to its boundary.
+      /// \param[out] _cells Number of grid cells loaded.
+      /// \param[in] _times First and last time to load, or nullopt for all
+      /// times. One more sample is kept on each side, as for the region.
+      /// \return The frame, with a grid per field.
+      public: components::EnvironmentalData::FrameT Frame(
+                  const std::optional<math::AxisAlignedBox> &_region,
+                  std::size_t &_cells,
+                  const std::optional<std::pair<double, double>> &_times =
+                      std::nullopt) const;
+
+      /// \brief Copy the data, optionally within a region and a window of
+      /// time, into a grid with fast lookups.
+      /// \param[in] _region Region of space to load, or nullopt for all of
+      /// the grid, as in Frame.
+      /// \param[in] _times First and last time to load, or nullopt for all
+      /// times, as in Frame.
+      /// \return The grid.
+      public: std::shared_ptr<RegularGrid> Grid(
+                  const std::optional<math::AxisAlignedBox> &_region,
+                  const std::optional<std::pair<double, double>> &_times =
+                      std::nullopt) const;
+
+      /// \brief Read a CSV file, whose rows are samples of a regular grid,
+      /// as read by common::IO<FrameT>.
+      /// \param[in] _csvPath Path of the CSV file.
+      /// \param[in] _timeColumn Name of the time column. If the file
+      /// doesn't have it, all samples are at time 0.
+      /// \param[in] _spatialColumns Names of the x, y and z columns.
+      /// \param[in] _minDensity Least fraction of the grid's samples which
+      /// the file must have, so that scattered samples don't make a huge
+      /// grid.
+      /// \return The grid, or nullptr if the file can't be read or is too
+      /// sparse.
+      public: static std::shared_ptr<RegularGrid> ReadCsv(
+                  const std::string &_csvPath,
+                  const std::string &_timeColumn,
+                  const std::array<std::string, 3> &_spatialColumns,
+                  double _minDensity);
+
+      /// \brief Write a grid file.
+      /// \param[in] _grid The grid.
+      /// \param[in] _gridPath Path of the file.
+      /// \return True if the file was written.
+      public: static bool Write(const RegularGrid &_grid,
+                  const std::string &_gridPath);
+
+      /// \brief Convert a CSV file, whose rows are samples of a regular
+      /// grid, as read by common::IO<FrameT>, into a grid file.
+      /// \param[in] _csvPath Path of the CSV file.
+      /// \param[in] _timeColumn Name of the time column. If the file
+      /// doesn't have it, all samples are at time 0.
+      /// \param[in] _spatialColumns Names of the x, y and z columns.
+      /// \param[in] _gridPath Path of the grid file to write.
+      /// \return True if the file was written.
+      public: static bool ConvertCsv(const std::string &_csvPath,
+                  const std::string &_timeColumn,
+                  const std::array<std::string, 3> &_spatialColumns,
+                  const std::string &_gridPath);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<EnvironmentGridPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
+
+#include "EnvironmentGrid.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Two time steps of a 3x2x1 grid, with a missing salinity value.
+static const char kCsv[] =
+    "t,temperature,x,y,z,salinity\n"
+    "0,10,0,0,0,35\n"
+    "0,11,1,0,0,35\n"
+    "0,12,2,0,0,\n"
+    "0,13,0,1,0,36\n"
+    "0,14,1,1,0,36\n"
+    "0,15,2,1,0,36\n"
+    "1,20,0,0,0,35\n"
+    "1,21,1,0,0,35\n"
+    "1,22,2,0,0,35\n"
+    "1,23,0,1,0,36\n"
+    "1,24,1,1,0,36\n"
+    "1,25,2,1,0,36\n";
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream file(_path);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(EnvironmentGrid, ConvertCsv)
+{
+  common::TempDirectory tempDir("environment_grid", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto csvPath = common::joinPaths(tempDir.Path(), "data.csv");
+  const auto gridPath = common::joinPaths(tempDir.Path(), "data.gzenv");
+  writeFile(csvPath, kCsv);
+
+  EXPECT_FALSE(EnvironmentGrid::IsGridFile(csvPath));
+  ASSERT_TRUE(EnvironmentGrid::ConvertCsv(csvPath, "t", {"x", "y", "z"},
+      gridPath));
+  EXPECT_TRUE(EnvironmentGrid::IsGridFile(gridPath));
+
+  EnvironmentGrid grid;
+  ASSERT_TRUE(grid.Open(gridPath));
+  EXPECT_EQ(std::vector<double>({0, 1}), grid.Axis(0));
+  EXPECT_EQ(std::vector<double>({0, 1, 2}), grid.Axis(1));
+  EXPECT_EQ(std::vector<double>({0, 1}), grid.Axis(2));
+  EXPECT_EQ(std::vector<double>({0}), grid.Axis(3));
+  EXPECT_EQ(std::vector<std::string>({"temperature", "salinity"}),
+      grid.Fields());
+
+  EXPECT_FLOAT_EQ(10.0f, grid.Value(0, {0, 0, 0, 0}));
+  EXPECT_FLOAT_EQ(25.0f, grid.Value(0, {1, 2, 1, 0}));
+  EXPECT_FLOAT_EQ(36.0f, grid.Value(1, {0, 1, 1, 0}));
+  EXPECT_TRUE(std::isnan(grid.Value(1, {0, 2, 0, 0})));
+
+  // The frame can be looked up like the ones read from CSV
+  std::size_t cells{0u};
+  auto frame = grid.Frame(std::nullopt, cells);
+  EXPECT_EQ(12u, cells);
+  ASSERT_TRUE(frame.Has("temperature"));
+  const auto &temperature = frame["temperature"];
+  auto session = temperature.StepTo(temperature.CreateSession(), 1.0);
+  ASSERT_TRUE(session.has_value());
+  auto value = temperature.LookUp(*session, math::Vector3d(1, 1, 0));
+  ASSERT_TRUE(value.has_value());
+  EXPECT_DOUBLE_EQ(24.0, *value);
+
+  // Regions keep a sample around them
+  frame = grid.Frame(math::AxisAlignedBox(math::Vector3d(-1, -1, -1),
+      math::Vector3d(0.5, 0.5, 1)), cells);
+  EXPECT_EQ(2u * 2u * 2u * 1u, cells);
+  EXPECT_TRUE(frame.Has("salinity"));
+}
+
+/////////////////////////////////////////////////
+TEST(EnvironmentGrid, Invalid)
+{
+  common::TempDirectory tempDir("environment_grid", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto csvPath = common::joinPaths(tempDir.Path(), "data.csv");
+  const auto gridPath = common::joinPaths(tempDir.Path(), "data.gzenv");
+
+  // Missing files and columns
+  EnvironmentGrid grid;
+  EXPECT_FALSE(grid.Open(gridPath));
+  EXPECT_FALSE(EnvironmentGrid::ConvertCsv(csvPath, "t", {"x", "y", "z"},
+      gridPath));
+  writeFile(csvPath, "t,x,y,value\n0,0,0,1\n");
+  EXPECT_FALSE(EnvironmentGrid::ConvertCsv(csvPath, "t", {"x", "y", "z"},
+      gridPath));
+
+  // Truncated grid
+  writeFile(csvPath, kCsv);
+  ASSERT_TRUE(EnvironmentGrid::ConvertCsv(csvPath, "t", {"x", "y", "z"},
+      gridPath));
+  std::ifstream in(gridPath, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  writeFile(gridPath, content.substr(0, content.size() - 4u));
+  EXPECT_TRUE(EnvironmentGrid::IsGridFile(gridPath));
+  EXPECT_FALSE(grid.Open(gridPath));
+}
+
+/////////////////////////////////////////////////
+TEST(EnvironmentGrid, TimeWindow)
+{
+  common::TempDirectory tempDir("environment_grid", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto csvPath = common::joinPaths(tempDir.Path(), "data.csv");
+  const auto gridPath = common::joinPaths(tempDir.Path(), "data.gzenv");
+  writeFile(csvPath,
+      "t,x,y,z,value\n0,0,0,0,0\n1,0,0,0,1\n2,0,0,0,2\n3,0,0,0,3\n"
+      "4,0,0,0,4\n");
+  ASSERT_TRUE(EnvironmentGrid::ConvertCsv(csvPath, "t", {"x", "y", "z"},
+      gridPath));
+  EnvironmentGrid grid;
+  ASSERT_TRUE(grid.Open(gridPath));
+
+  // Windows keep a sample around them, like regions
+  const std::pair<double, double> window{1.5, 2.5};
+  std::size_t cells{0u};
+  auto frame = grid.Frame(std::nullopt, cells, window);
+  EXPECT_EQ(3u, cells);
+  ASSERT_TRUE(frame.Has("value"));
+  auto session = frame["value"].StepTo(frame["value"].CreateSession(), 2.5);
+  ASSERT_TRUE(session.has_value());
+  auto value = frame["value"].LookUp(*session, math::Vector3d::Zero);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_DOUBLE_EQ(2.5, *value);
+
+  auto regular = grid.Grid(std::nullopt, window);
+  ASSERT_NE(nullptr, regular);
+  EXPECT_EQ(std::vector<double>({1, 2, 3}), regular->Axis(0));
+  EXPECT_EQ(std::vector<float>({1, 2, 3}), regular->Values());
+  EXPECT_FALSE(regular->StepTo(regular->CreateSession(), 3.5).has_value());
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/sim/EventChannel.hh"
+#include "gz/sim/EventManager.hh"
+
+using namespace gz::sim;
+
+using TestChannel = EventChannel<void(int), struct TestChannelTag>;
+
+/////////////////////////////////////////////////
+TEST(EventChannel, ConnectEmitDisconnect)
+{
+  TestChannel channel;
+  EXPECT_EQ(0u, channel.ConnectionCount());
+  channel.Signal(1);
+
+  int sum1{0};
+  int sum2{0};
+  auto connection1 = channel.Connect([&](int _value) { sum1 += _value; });
+  auto connection2 = channel.Connect([&](int _value) { sum2 += _value; });
+  EXPECT_EQ(2u, channel.ConnectionCount());
+
+  channel.Signal(2);
+  channel(3);
+  EXPECT_EQ(5, sum1);
+  EXPECT_EQ(5, sum2);
+
+  connection1.reset();
+  EXPECT_EQ(1u, channel.ConnectionCount());
+  channel.Signal(4);
+  EXPECT_EQ(5, sum1);
+  EXPECT_EQ(9, sum2);
+}
+
+/////////////////////////////////////////////////
+TEST(EventChannel, ChangesWhileEmitting)
+{
+  TestChannel channel;
+  std::vector<std::string> calls;
+  gz::common::ConnectionPtr second;
+  gz::common::ConnectionPtr late;
+
+  auto first = channel.Connect([&](int)
+      {
+        calls.push_back("first");
+        // Disconnected subscribers aren't called anymore, and new ones are
+        // only called on the next emission
+        second.reset();
+        if (!late)
+          late = channel.Connect([&](int) { calls.push_back("late"); });
+      });
+  second = channel.Connect([&](int) { calls.push_back("second"); });
+
+  channel.Signal(0);
+  EXPECT_EQ((std::vector<std::string>{"first"}), calls);
+
+  calls.clear();
+  channel.Signal(0);
+  EXPECT_EQ((std::vector<std::string>{"first", "late"}), calls);
+  EXPECT_EQ(2u, channel.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST(EventChannel, Concurrent)
+{
+  TestChannel channel;
+  std::atomic<int> calls{0};
+  auto connection = channel.Connect([&](int) { ++calls; });
+
+  std::atomic<bool> done{false};
+  std::thread churn([&]
+      {
+        while (!done)
+          auto temporary = channel.Connect([](int) {});
+      });
+
+  std::vector<std::thread> emitters;
+  for (int t = 0; t < 4; ++t)
+  {
+    emitters.emplace_back([&]
+        {
+          for (int i = 0; i < 1000; ++i)
+            channel.Signal(i);
+        });
+  }
+  for (auto &emitter : emitters)
+    emitter.join();
+  done = true;
+  churn.join();
+
+  EXPECT_EQ(4000, calls);
+  EXPECT_EQ(1u, channel.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST(EventChannel, EventManager)
+{
+  EventManager eventManager;
+  auto &channel = eventManager.Channel<TestChannel>();
+  EXPECT_EQ(&channel, &eventManager.Channel<TestChannel>());
+
+  // Connections made through the manager are called by the channel and the
+  // other way around
+  int sum{0};
+  auto connection = eventManager.Connect<TestChannel>(
+      [&](int _value) { sum += _value; });
+  EXPECT_EQ(1u, eventManager.ConnectionCount<TestChannel>());
+  channel.Signal(2);
+  eventManager.Emit<TestChannel>(3);
+  EXPECT_EQ(5, sum);
+
+  // Regular events can be used as channels too
+  using TestEvent = gz::common::EventT<void(int), struct TestEventTag>;
+  auto &event = eventManager.Channel<TestEvent>();
+  auto eventConnection = eventManager.Connect<TestEvent>(
+      [&](int _value) { sum += _value; });
+  event.Signal(4);
+  EXPECT_EQ(9, sum);
+}
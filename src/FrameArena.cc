@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "gz/sim/FrameArena.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Contiguous memory handed out by an arena.
+struct Block
+{
+  /// \brief Constructor.
+  /// \param[in] _size Size in bytes.
+  explicit Block(std::size_t _size)
+    : data(std::make_unique<std::byte[]>(_size)), size(_size)
+  {
+  }
+
+  /// \brief Memory of the block.
+  std::unique_ptr<std::byte[]> data;
+
+  /// \brief Size in bytes.
+  std::size_t size;
+
+  /// \brief Offset of the first free byte. Failed allocations may move it
+  /// past the end of the block.
+  std::atomic<std::size_t> offset{0u};
+};
+}
+
+/// \brief Private data for FrameArena.
+class gz::sim::FrameArena::Implementation
+{
+  /// \brief Replace a full block with a new one, unless another thread
+  /// already did.
+  /// \param[in] _full Block that didn't fit the allocation, or nullptr
+  /// before the first block is created.
+  /// \param[in] _minSize Minimum size in bytes of the new block.
+  public: void Grow(Block *_full, std::size_t _minSize);
+
+  /// \brief Size in bytes of the first block.
+  public: std::size_t blockSize;
+
+  /// \brief All blocks, the last one being the current one.
+  public: std::vector<std::unique_ptr<Block>> blocks;
+
+  /// \brief Block that allocations are taken from.
+  public: std::atomic<Block *> current{nullptr};
+
+  /// \brief Protects blocks.
+  public: mutable std::mutex mutex;
+};
+
+//////////////////////////////////////////////////
+void FrameArena::Implementation::Grow(Block *_full, std::size_t _minSize)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->current.load(std::memory_order_acquire) != _full)
+    return;
+
+  const std::size_t size = std::max(_minSize,
+      nullptr == _full ? this->blockSize : 2u * _full->size);
+  this->blocks.push_back(std::make_unique<Block>(size));
+  this->current.store(this->blocks.back().get(), std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+FrameArena::FrameArena(std::size_t _blockSize)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->blockSize = std::max<std::size_t>(_blockSize, 1u);
+}
+
+//////////////////////////////////////////////////
+void *FrameArena::Allocate(std::size_t _size, std::size_t _alignment)
+{
+  // Enough room to align the start of the allocation anywhere in a block
+  const std::size_t padded = std::max<std::size_t>(_size, 1u) +
+      _alignment - 1u;
+  while (true)
+  {
+    Block *block = this->dataPtr->current.load(std::memory_order_acquire);
+    if (nullptr != block)
+    {
+      const std::size_t start =
+          block->offset.fetch_add(padded, std::memory_order_relaxed);
+      if (start + padded <= block->size)
+      {
+        auto address = reinterpret_cast<std::uintptr_t>(block->data.get()) +
+            start;
+        address = (address + _alignment - 1u) &
+            ~static_cast<std::uintptr_t>(_alignment - 1u);
+        return reinterpret_cast<void *>(address);
+      }
+    }
+    this->dataPtr->Grow(block, padded);
+  }
+}
+
+//////////////////////////////////////////////////
+void FrameArena::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &blocks = this->dataPtr->blocks;
+  if (blocks.size() > 1u)
+  {
+    // Steps usually need as much memory as the previous one
+    std::size_t total{0u};
+    for (const auto &block : blocks)
+      total += block->size;
+    blocks.clear();
+    blocks.push_back(std::make_unique<Block>(total));
+  }
+  else if (!blocks.empty())
+  {
+    blocks.front()->offset.store(0u, std::memory_order_relaxed);
+  }
+  this->dataPtr->current.store(blocks.empty() ? nullptr : blocks.front().get(),
+      std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameArena::Used() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::size_t used{0u};
+  for (const auto &block : this->dataPtr->blocks)
+  {
+    used += std::min(block->size,
+        block->offset.load(std::memory_order_relaxed));
+  }
+  return used;
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameArena::Capacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::size_t capacity{0u};
+  for (const auto &block : this->dataPtr->blocks)
+    capacity += block->size;
+  return capacity;
+}
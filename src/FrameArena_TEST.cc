@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gz/sim/FrameArena.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(FrameArena, AlignmentAndReuse)
+{
+  FrameArena arena(256u);
+  EXPECT_EQ(0u, arena.Capacity());
+
+  for (std::size_t alignment : {1u, 8u, 64u})
+  {
+    void *memory = arena.Allocate(3u, alignment);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(memory) % alignment);
+  }
+  auto *value = arena.Create<double>(2.5);
+  EXPECT_DOUBLE_EQ(2.5, *value);
+  EXPECT_EQ(256u, arena.Capacity());
+
+  // Larger than a block
+  arena.Allocate(1000u);
+  EXPECT_LT(256u, arena.Capacity());
+  const auto capacity = arena.Capacity();
+
+  // The blocks are merged, so the next step fits in one
+  arena.Reset();
+  EXPECT_EQ(0u, arena.Used());
+  EXPECT_EQ(capacity, arena.Capacity());
+  arena.Allocate(1000u);
+  EXPECT_EQ(capacity, arena.Capacity());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameArena, Vector)
+{
+  FrameArena arena(64u);
+  FrameVector<int> values(arena);
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(i);
+  ASSERT_EQ(1000u, values.size());
+  EXPECT_EQ(999, values.back());
+  EXPECT_LE(1000u * sizeof(int), arena.Used());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameArena, Concurrent)
+{
+  FrameArena arena(128u);
+  constexpr int kThreads{4};
+  constexpr int kAllocations{1000};
+  std::vector<std::vector<std::uint64_t *>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      for (int i = 0; i < kAllocations; ++i)
+      {
+        results[t].push_back(arena.Create<std::uint64_t>(
+            static_cast<std::uint64_t>(t * kAllocations + i)));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Each allocation is distinct and kept its value
+  std::set<std::uint64_t *> addresses;
+  for (int t = 0; t < kThreads; ++t)
+  {
+    for (int i = 0; i < kAllocations; ++i)
+    {
+      EXPECT_EQ(static_cast<std::uint64_t>(t * kAllocations + i),
+          *results[t][i]);
+      addresses.insert(results[t][i]);
+    }
+  }
+  EXPECT_EQ(static_cast<std::size_t>(kThreads * kAllocations),
+      addresses.size());
+}
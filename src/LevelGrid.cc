@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LevelGrid.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Largest number of cells a box is added to, larger boxes are
+/// returned by every query instead.
+constexpr std::int64_t kMaxCellsPerBox = 64;
+
+/// \brief Largest number of cells a query looks at before falling back to
+/// visiting every cell.
+constexpr std::int64_t kMaxCellsPerQuery = 4096;
+}
+
+//////////////////////////////////////////////////
+void LevelGrid::Build(
+    const std::vector<std::pair<Entity, math::AxisAlignedBox>> &_boxes)
+{
+  this->cells.clear();
+  this->oversized.clear();
+  this->size = _boxes.size();
+  if (_boxes.empty())
+    return;
+
+  // Cells as large as the average box
+  math::Vector3d total;
+  for (const auto &[level, box] : _boxes)
+    total += box.Size();
+  this->cellSize = total / static_cast<double>(_boxes.size());
+  for (int i = 0; i < 3; ++i)
+    this->cellSize[i] = std::max(this->cellSize[i], 1e-3);
+
+  for (const auto &[level, box] : _boxes)
+  {
+    std::int64_t min[3];
+    std::int64_t max[3];
+    this->CellOf(box.Min(), min);
+    this->CellOf(box.Max(), max);
+    if ((max[0] - min[0] + 1) * (max[1] - min[1] + 1) *
+        (max[2] - min[2] + 1) > kMaxCellsPerBox)
+    {
+      this->oversized.push_back(level);
+      continue;
+    }
+
+    for (auto x = min[0]; x <= max[0]; ++x)
+      for (auto y = min[1]; y <= max[1]; ++y)
+        for (auto z = min[2]; z <= max[2]; ++z)
+          this->cells[Key(x, y, z)].push_back(level);
+  }
+}
+
+//////////////////////////////////////////////////
+void LevelGrid::Query(const math::AxisAlignedBox &_box,
+    std::vector<Entity> &_levels) const
+{
+  _levels = this->oversized;
+
+  std::int64_t min[3];
+  std::int64_t max[3];
+  this->CellOf(_box.Min(), min);
+  this->CellOf(_box.Max(), max);
+  const double count = static_cast<double>(max[0] - min[0] + 1) *
+      static_cast<double>(max[1] - min[1] + 1) *
+      static_cast<double>(max[2] - min[2] + 1);
+
+  // Huge query boxes are cheaper to answer by visiting the cells in use
+  if (count > static_cast<double>(std::min<std::size_t>(
+          kMaxCellsPerQuery, this->cells.size())))
+  {
+    for (const auto &cell : this->cells)
+      _levels.insert(_levels.end(), cell.second.begin(), cell.second.end());
+  }
+  else
+  {
+    for (auto x = min[0]; x <= max[0]; ++x)
+    {
+      for (auto y = min[1]; y <= max[1]; ++y)
+      {
+        for (auto z = min[2]; z <= max[2]; ++z)
+        {
+          auto it = this->cells.find(Key(x, y, z));
+          if (it != this->cells.end())
+          {
+            _levels.insert(_levels.end(), it->second.begin(),
+                it->second.end());
+          }
+        }
+      }
+    }
+  }
+
+  std::sort(_levels.begin(), _levels.end());
+  _levels.erase(std::unique(_levels.begin(), _levels.end()), _levels.end());
+}
+
+//////////////////////////////////////////////////
+std::size_t LevelGrid::Size() const
+{
+  return this->size;
+}
+
+//////////////////////////////////////////////////
+void LevelGrid::CellOf(const math::Vector3d &_point,
+    std::int64_t _cell[3]) const
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    // Clamp so points far away don't overflow
+    _cell[i] = static_cast<std::int64_t>(std::floor(std::clamp(
+        _point[i] / this->cellSize[i], -1e6, 1e6)));
+  }
+}
+
+//////////////////////////////////////////////////
+std::uint64_t LevelGrid::Key(std::int64_t _x, std::int64_t _y,
+    std::int64_t _z)
+{
+  // 21 bits per coordinate is enough for the clamped range
+  const auto bits = [](std::int64_t _v)
+  {
+    return static_cast<std::uint64_t>(_v + (1 << 20)) & 0x1FFFFF;
+  };
+  return (bits(_x) << 42) | (bits(_y) << 21) | bits(_z);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_LEVELGRID_HH_
+#define GZ_SIM_LEVELGRID_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class LevelGrid LevelGrid.hh
+    /// \brief Uniform grid over the boxes of levels, to find the levels
+    /// near a performer without testing every level.
+    ///
+    /// The cells are as large as the average box, so most boxes are in a
+    /// few cells. Boxes that would span too many cells are kept aside and
+    /// returned by every query.
+    class GZ_SIM_VISIBLE LevelGrid
+    {
+      /// \brief Replace the boxes in the grid.
+      /// \param[in] _boxes Box of each level. Boxes must not be empty.
+      public: void Build(
+                  const std::vector<std::pair<Entity, math::AxisAlignedBox>>
+                  &_boxes);
+
+      /// \brief Find the levels whose box may intersect a box.
+      /// \param[in] _box The box to look around.
+      /// \param[out] _levels Sorted levels whose box is in one of the cells
+      /// the box overlaps. Each level is only returned once.
+      public: void Query(const math::AxisAlignedBox &_box,
+                  std::vector<Entity> &_levels) const;
+
+      /// \brief Number of boxes in the grid.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Cell coordinates of a point.
+      /// \param[in] _point The point.
+      /// \param[out] _cell Coordinates of the cell it's in.
+      private: void CellOf(const math::Vector3d &_point,
+                   std::int64_t _cell[3]) const;
+
+      /// \brief Key of a cell in the map.
+      /// \param[in] _x X coordinate of the cell.
+      /// \param[in] _y Y coordinate of the cell.
+      /// \param[in] _z Z coordinate of the cell.
+      /// \return The key.
+      private: static std::uint64_t Key(std::int64_t _x, std::int64_t _y,
+                   std::int64_t _z);
+
+      /// \brief Levels in each cell, by key.
+      private: std::unordered_map<std::uint64_t, std::vector<Entity>> cells;
+
+      /// \brief Levels too large to be put in cells.
+      private: std::vector<Entity> oversized;
+
+      /// \brief Size of a cell.
+      private: math::Vector3d cellSize{1, 1, 1};
+
+      /// \brief Number of boxes in the grid.
+      private: std::size_t size{0u};
+    };
+    }
+  }
+}
+#endif
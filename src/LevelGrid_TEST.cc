@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "LevelGrid.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+math::AxisAlignedBox boxAt(double _x, double _y, double _size)
+{
+  const math::Vector3d half(_size / 2, _size / 2, _size / 2);
+  const math::Vector3d center(_x, _y, 0);
+  return math::AxisAlignedBox(center - half, center + half);
+}
+
+/////////////////////////////////////////////////
+TEST(LevelGrid, Empty)
+{
+  LevelGrid grid;
+  grid.Build({});
+  EXPECT_EQ(0u, grid.Size());
+
+  std::vector<Entity> levels{1};
+  grid.Query(boxAt(0, 0, 1), levels);
+  EXPECT_TRUE(levels.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(LevelGrid, Query)
+{
+  // A row of 10 levels, 10 m apart
+  std::vector<std::pair<Entity, math::AxisAlignedBox>> boxes;
+  for (Entity i = 0; i < 10; ++i)
+    boxes.emplace_back(i + 1, boxAt(10.0 * i, 0, 4));
+
+  LevelGrid grid;
+  grid.Build(boxes);
+  EXPECT_EQ(10u, grid.Size());
+
+  // Every level that intersects the query is returned, and few others
+  std::vector<Entity> levels;
+  grid.Query(boxAt(20, 0, 1), levels);
+  EXPECT_NE(levels.end(), std::find(levels.begin(), levels.end(), 3u));
+  EXPECT_LE(levels.size(), 3u);
+
+  // A query between two levels
+  grid.Query(boxAt(45, 0, 8), levels);
+  EXPECT_NE(levels.end(), std::find(levels.begin(), levels.end(), 5u));
+  EXPECT_NE(levels.end(), std::find(levels.begin(), levels.end(), 6u));
+
+  // Far away from every level
+  grid.Query(boxAt(0, 1000, 1), levels);
+  EXPECT_TRUE(levels.empty());
+
+  // A query larger than the grid returns every level once
+  grid.Query(boxAt(50, 0, 1000), levels);
+  EXPECT_EQ(10u, levels.size());
+}
+
+/////////////////////////////////////////////////
+TEST(LevelGrid, Oversized)
+{
+  // A huge level among small ones is returned by every query
+  std::vector<std::pair<Entity, math::AxisAlignedBox>> boxes;
+  for (Entity i = 0; i < 20; ++i)
+    boxes.emplace_back(i + 1, boxAt(2.0 * i, 0, 1));
+  boxes.emplace_back(100, boxAt(0, 0, 500));
+
+  LevelGrid grid;
+  grid.Build(boxes);
+
+  std::vector<Entity> levels;
+  grid.Query(boxAt(-200, -200, 1), levels);
+  ASSERT_EQ(1u, levels.size());
+  EXPECT_EQ(100u, levels[0]);
+
+  grid.Query(boxAt(10, 0, 0.5), levels);
+  EXPECT_NE(levels.end(), std::find(levels.begin(), levels.end(), 6u));
+  EXPECT_NE(levels.end(), std::find(levels.begin(), levels.end(), 100u));
+}
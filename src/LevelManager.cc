@@ -18,6 +18,9 @@
 #include "LevelManager.hh"
 
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
 
 #include <sdf/Actor.hh>
 #include <sdf/Atmosphere.hh>
@@ -32,6 +35,7 @@
 #include "gz/sim/Events.hh"
 #include "gz/sim/EntityComponentManager.hh"
 
+#include "gz/sim/components/ActivityLevel.hh"
 #include "gz/sim/components/Actor.hh"
 #include "gz/sim/components/Atmosphere.hh"
 #include "gz/sim/components/Geometry.hh"
@@ -61,7 +65,9 @@
 #include "gz/sim/components/Wind.hh"
 #include "gz/sim/components/World.hh"
 
+#include "MeshCache.hh"
 #include "SimulationRunner.hh"
+#include "StartupTimeline.hh"
 
 using namespace gz;
 using namespace sim;
@@ -149,6 +155,13 @@ void LevelManager::ReadLevelPerformerInfo()
       components::PhysicsEnginePlugin(
       this->runner->serverConfig.PhysicsEngine()));
 
+  if (this->runner->serverConfig.PhysicsSubsteps() > 0u)
+  {
+    this->runner->entityCompMgr.CreateComponent(this->worldEntity,
+        components::PhysicsSubsteps(
+        this->runner->serverConfig.PhysicsSubsteps()));
+  }
+
   this->runner->entityCompMgr.CreateComponent(this->worldEntity,
       components::RenderEngineServerPlugin(
       this->runner->serverConfig.RenderEngineServer()));
@@ -229,6 +242,7 @@ void LevelManager::ReadLevelPerformerInfo()
   else
   {
     this->ReadPerformers(pluginElem);
+    this->ReadActivity(pluginElem);
     if (this->useLevels)
       this->ReadLevels(pluginElem);
   }
@@ -389,6 +403,8 @@ void LevelManager::ReadLevels(const sdf::ElementPtr &_sdf)
   if (_sdf == nullptr)
     return;
 
+  // Views are updated once, after all levels are created
+  this->runner->entityCompMgr.BeginBulkInsert();
   for (auto level = _sdf->GetElement("level"); level;
        level = level->GetNextElement("level"))
   {
@@ -442,6 +458,94 @@ void LevelManager::ReadLevels(const sdf::ElementPtr &_sdf)
 
     this->entityCreator->SetParent(levelEntity, this->worldEntity);
   }
+  this->runner->entityCompMgr.EndBulkInsert();
+  this->levelGridDirty = true;
+
+  if (_sdf->HasElement("level_streaming"))
+  {
+    auto streamingElem = _sdf->GetElement("level_streaming");
+    const double budget = std::max(0.0,
+        streamingElem->Get<double>("step_budget", 0.002).first);
+    this->prefetchTime = std::max(0.0,
+        streamingElem->Get<double>("prefetch_time", 1.0).first);
+    this->streamingBudget = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(budget));
+    this->streamer = std::make_unique<LevelStreamer>();
+
+    gzmsg << "Streaming levels with a budget of [" << budget * 1000
+          << "] ms per step and a prefetch time of [" << this->prefetchTime
+          << "] s." << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void LevelManager::ReadActivity(const sdf::ElementPtr &_sdf)
+{
+  if (!_sdf->HasElement("activity"))
+    return;
+
+  auto activityElem = _sdf->GetElement("activity");
+  for (auto distanceElem = activityElem->FindElement("distance");
+       distanceElem;
+       distanceElem = distanceElem->GetNextElement("distance"))
+  {
+    const double distance = distanceElem->Get<double>();
+    if (distance <= 0 || (!this->activityDistances.empty() &&
+        distance <= this->activityDistances.back()))
+    {
+      gzerr << "Activity distances must be positive and increasing, "
+             << "ignoring [" << distance << "]." << std::endl;
+      continue;
+    }
+    this->activityDistances.push_back(distance);
+  }
+
+  if (!this->activityDistances.empty())
+  {
+    gzmsg << "Setting the activity level of models from [" <<
+          this->activityDistances.size() << "] distances to performers."
+          << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void LevelManager::UpdateLevelGrid()
+{
+  GZ_PROFILE("LevelManager::UpdateLevelGrid");
+
+  this->levelRegions.clear();
+  std::vector<std::pair<Entity, math::AxisAlignedBox>> boxes;
+  this->runner->entityCompMgr.Each<components::Level, components::Pose,
+    components::Geometry, components::LevelBuffer>(
+        [&](const Entity &_entity, const components::Level *,
+          const components::Pose *_pose,
+          const components::Geometry *_levelGeometry,
+          const components::LevelBuffer *_levelBuffer) -> bool
+        {
+          // assume a box for now
+          auto box = _levelGeometry->Data().BoxShape();
+          if (nullptr == box)
+          {
+            gzerr << "Level [" << _entity
+                  << "]'s geometry is not a box." << std::endl;
+            return true;
+          }
+          auto buffer = _levelBuffer->Data();
+          auto center = _pose->Data().Pos();
+          math::AxisAlignedBox region{center - box->Size() / 2,
+            center + box->Size() / 2};
+          math::AxisAlignedBox outerRegion{
+            center - (box->Size() / 2 + buffer),
+            center + (box->Size() / 2 + buffer)};
+
+          this->levelRegions[_entity] = {region, outerRegion};
+          boxes.emplace_back(_entity, outerRegion);
+          return true;
+        });
+
+  this->levelGrid.Build(boxes);
+  this->levelGridDirty = false;
 }
 
 /////////////////////////////////////////////////
@@ -590,6 +694,8 @@ void LevelManager::UpdateLevelsState()
 
   std::vector<Entity> levelsToLoad;
   std::vector<Entity> levelsToUnload;
+  // Levels whose streamed entities can't wait
+  std::set<Entity> urgentLevels;
 
   {
     std::lock_guard<std::mutex> lock(this->performerToAddMutex);
@@ -614,6 +720,7 @@ void LevelManager::UpdateLevelsState()
           if (!this->IsLevelActive(_entity))
           {
             levelsToLoad.push_back(_entity);
+            urgentLevels.insert(_entity);
           }
           // We assume one default level
           return false;
@@ -621,8 +728,13 @@ void LevelManager::UpdateLevelsState()
   }
 
   // If levels are not being used, we only process the default level.
+  bool checkedPerformers{false};
   if (this->useLevels)
   {
+    if (this->levelGridDirty)
+      this->UpdateLevelGrid();
+
+    std::vector<Entity> candidates;
     this->runner->entityCompMgr.Each<
       components::Performer,
       components::PerformerLevels,
@@ -654,59 +766,34 @@ void LevelManager::UpdateLevelsState()
 
           std::set<Entity> newPerfLevels;
 
-          // loop through levels and check for intersections
+          // Streamed levels are loaded ahead of the performer
+          math::AxisAlignedBox searchVolume = performerVolume;
+          if (this->streamer)
+            searchVolume = this->PredictedVolume(_perfEntity, performerVolume);
+
+          // Only check the levels near the performer.
           // Add all levels with intersections to the levelsToLoad even if they
-          // are currently active.
-          this->runner->entityCompMgr.Each<components::Level, components::Pose,
-            components::Geometry,
-            components::LevelBuffer >(
-                [&](const Entity &_entity, const components::Level *,
-                  const components::Pose *_pose,
-                  const components::Geometry *_levelGeometry,
-                  const components::LevelBuffer *_levelBuffer) -> bool
-                {
-                GZ_PROFILE("CheckPerformerAgainstLevel");
-                // Check if the performer is in this level
-                // assume a box for now
-                auto box = _levelGeometry->Data().BoxShape();
-                if (nullptr == box)
-                {
-                gzerr << "Level [" << _entity
-                << "]'s geometry is not a box." << std::endl;
-                return true;
-                }
-                auto buffer = _levelBuffer->Data();
-                auto center = _pose->Data().Pos();
-                math::AxisAlignedBox region{center - box->Size() / 2,
-                center + box->Size() / 2};
-
-                math::AxisAlignedBox outerRegion{
-                  center - (box->Size() / 2 + buffer),
-                         center + (box->Size() / 2 + buffer)};
-
-                if (region.Intersects(performerVolume))
-                {
-                  newPerfLevels.insert(_entity);
-                  levelsToLoad.push_back(_entity);
-                }
-                else
-                {
-                  // If the level is active, check if the performer is
-                  // outside of the buffer of this level
-                  if (this->IsLevelActive(_entity))
-                  {
-                    if (outerRegion.Intersects(performerVolume))
-                    {
-                      newPerfLevels.insert(_entity);
-                      levelsToLoad.push_back(_entity);
-                      return true;
-                    }
-                    // Otherwise, mark the level to be unloaded
-                    levelsToUnload.push_back(_entity);
-                  }
-                }
-                return true;
-                });
+          // are currently active. Active levels are kept until the performer
+          // leaves their buffer.
+          this->levelGrid.Query(searchVolume, candidates);
+          for (const Entity level : candidates)
+          {
+            GZ_PROFILE("CheckPerformerAgainstLevel");
+            const auto &regions = this->levelRegions.at(level);
+            if (regions.first.Intersects(performerVolume))
+            {
+              newPerfLevels.insert(level);
+              levelsToLoad.push_back(level);
+              urgentLevels.insert(level);
+            }
+            else if ((this->streamer || this->IsLevelActive(level)) &&
+                regions.second.Intersects(searchVolume))
+            {
+              newPerfLevels.insert(level);
+              levelsToLoad.push_back(level);
+            }
+          }
+          checkedPerformers = true;
 
           *_perfLevels = components::PerformerLevels(newPerfLevels);
 
@@ -714,16 +801,25 @@ void LevelManager::UpdateLevelsState()
           });
   }
 
-  // Sort levelsToLoad and levelsToUnload so as to run std::unique on them.
+  // Sort levelsToLoad so as to run std::unique on it.
   std::sort(levelsToLoad.begin(), levelsToLoad.end());
-  std::sort(levelsToUnload.begin(), levelsToUnload.end());
   {
     auto pendingEnd = std::unique(levelsToLoad.begin(), levelsToLoad.end());
     levelsToLoad.erase(pendingEnd, levelsToLoad.end());
   }
+
+  // Unload the active levels which no performer is in or near, as long as
+  // there was a performer to check them against
+  if (checkedPerformers)
   {
-    auto pendingEnd = std::unique(levelsToUnload.begin(), levelsToUnload.end());
-    levelsToUnload.erase(pendingEnd, levelsToUnload.end());
+    for (const auto &level : this->activeLevels)
+    {
+      if (this->levelRegions.find(level) != this->levelRegions.end() &&
+          !std::binary_search(levelsToLoad.begin(), levelsToLoad.end(), level))
+      {
+        levelsToUnload.push_back(level);
+      }
+    }
   }
 
   // Make a list of entity names from all the levels that have been marked to be
@@ -752,16 +848,6 @@ void LevelManager::UpdateLevelsState()
     }
   }
 
-  // First filter levelsToUnload so it doesn't contain any levels that are
-  // already in levelsToLoad
-  auto pendingRemove = std::remove_if(
-      levelsToUnload.begin(), levelsToUnload.end(), [&](Entity _entity)
-      {
-        return std::find(levelsToLoad.begin(), levelsToLoad.end(), _entity) !=
-               levelsToLoad.end();
-      });
-  levelsToUnload.erase(pendingRemove, levelsToUnload.end());
-
   // Make a list of entity names to unload making sure to leave out the ones
   // that have been marked to be loaded above
   std::set<std::string> entityNamesToUnload;
@@ -783,12 +869,25 @@ void LevelManager::UpdateLevelsState()
   // Load and unload the entities
   if (entityNamesToLoad.size() > 0)
   {
-    this->LoadActiveEntities(entityNamesToLoad);
+    if (this->streamer)
+      this->QueueActiveEntities(entityNamesToLoad);
+    else
+      this->LoadActiveEntities(entityNamesToLoad);
   }
   if (entityNamesToUnload.size() > 0)
   {
+    // Entities that are still queued don't need to be removed
+    if (this->streamer)
+    {
+      for (const auto &name : entityNamesToUnload)
+        this->streamer->Cancel(name);
+    }
     this->UnloadInactiveEntities(entityNamesToUnload);
   }
+  if (this->streamer && this->streamer->Pending() > 0u)
+  {
+    this->CommitQueuedEntities(urgentLevels);
+  }
 
   // Finally, upadte the list of active levels
   for (const auto &level : levelsToLoad)
@@ -808,6 +907,73 @@ void LevelManager::UpdateLevelsState()
   }
   // Erase from vector
   this->activeLevels.erase(pendingEnd, this->activeLevels.end());
+
+  this->UpdateActivityLevels();
+}
+
+/////////////////////////////////////////////////
+void LevelManager::UpdateActivityLevels()
+{
+  if (this->activityDistances.empty())
+    return;
+
+  GZ_PROFILE("LevelManager::UpdateActivityLevels");
+
+  auto &ecm = this->runner->entityCompMgr;
+
+  std::vector<math::Vector3d> performerPositions;
+  ecm.Each<components::Performer, components::ParentEntity>(
+      [&](const Entity &, const components::Performer *,
+          const components::ParentEntity *_parent) -> bool
+      {
+        auto pose = ecm.Component<components::Pose>(_parent->Data());
+        if (nullptr != pose)
+          performerPositions.push_back(pose->Data().Pos());
+        return true;
+      });
+
+  // Without performers, there's nothing to measure the distance to
+  if (performerPositions.empty())
+    return;
+
+  std::vector<std::pair<Entity, unsigned int>> levels;
+  ecm.Each<components::Model, components::Pose, components::ParentEntity>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::Pose *_pose,
+          const components::ParentEntity *_parent) -> bool
+      {
+        if (_parent->Data() != this->worldEntity)
+          return true;
+
+        double distance = std::numeric_limits<double>::max();
+        for (const auto &position : performerPositions)
+        {
+          distance = std::min(distance,
+              position.Distance(_pose->Data().Pos()));
+        }
+
+        levels.emplace_back(_entity, static_cast<unsigned int>(
+            std::upper_bound(this->activityDistances.begin(),
+            this->activityDistances.end(), distance) -
+            this->activityDistances.begin()));
+        return true;
+      });
+
+  // Components are created after iterating, since that changes the views
+  for (const auto &[entity, level] : levels)
+  {
+    auto levelComp = ecm.Component<components::ActivityLevel>(entity);
+    if (nullptr == levelComp)
+    {
+      ecm.CreateComponent(entity, components::ActivityLevel(level));
+    }
+    else if (levelComp->Data() != level)
+    {
+      levelComp->Data() = level;
+      ecm.SetChanged(entity, components::ActivityLevel::typeId,
+          ComponentState::OneTimeChange);
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -821,7 +987,13 @@ void LevelManager::LoadActiveEntities(const std::set<std::string> &_namesToLoad)
     return;
   }
 
+  StartupTimeline::Scope createScope("Create entities", "entities");
+
+  // Views are updated once, after all entities of the levels are created
+  this->runner->entityCompMgr.BeginBulkInsert();
+
   // Models
+  std::vector<const sdf::Model *> models;
   for (uint64_t modelIndex = 0;
        modelIndex < this->runner->sdfWorld->ModelCount(); ++modelIndex)
   {
@@ -829,13 +1001,34 @@ void LevelManager::LoadActiveEntities(const std::set<std::string> &_namesToLoad)
     // check if the model is in this level
     auto model = this->runner->sdfWorld->ModelByIndex(modelIndex);
     if (_namesToLoad.find(model->Name()) != _namesToLoad.end())
-    {
-      Entity modelEntity = this->entityCreator->CreateEntities(model);
+      models.push_back(model);
+  }
 
-      this->entityCreator->SetParent(modelEntity, this->worldEntity);
+  // Models whose includes were deferred are parsed now
+  const auto &deferred = this->runner->deferredIncludes;
+  std::vector<std::string> deferredNames;
+  if (nullptr != deferred)
+  {
+    for (const auto &name : _namesToLoad)
+    {
+      if (!deferred->Has(name))
+        continue;
+      auto model = deferred->Load(name);
+      if (nullptr != model)
+        models.push_back(model);
+      deferredNames.push_back(name);
     }
   }
 
+  // Large levels, such as the default level of big worlds, are created
+  // concurrently
+  for (const auto modelEntity : this->entityCreator->CreateEntities(models))
+    this->entityCreator->SetParent(modelEntity, this->worldEntity);
+
+  // The entities keep copies of the DOM they need
+  for (const auto &name : deferredNames)
+    deferred->Release(name);
+
   // Actors
   for (uint64_t actorIndex = 0;
        actorIndex < this->runner->sdfWorld->ActorCount(); ++actorIndex)
@@ -876,11 +1069,178 @@ void LevelManager::LoadActiveEntities(const std::set<std::string> &_namesToLoad)
       this->entityCreator->SetParent(jointEntity, this->worldEntity);
     }
   }
+  this->runner->entityCompMgr.EndBulkInsert();
+
+  this->activeEntityNames.insert(_namesToLoad.begin(), _namesToLoad.end());
+}
+
+/////////////////////////////////////////////////
+void LevelManager::QueueActiveEntities(
+    const std::set<std::string> &_namesToLoad)
+{
+  GZ_PROFILE("LevelManager::QueueActiveEntities");
+
+  if (this->worldEntity == kNullEntity)
+  {
+    gzerr << "Could not find the world entity while loading levels\n";
+    return;
+  }
+
+  // Models hash their collision meshes in the background if meshes are
+  // preloaded. They're queued before the joints, which may refer to them.
+  const bool preloadMeshes = this->runner->serverConfig.PreloadMeshes();
+  for (uint64_t modelIndex = 0;
+       modelIndex < this->runner->sdfWorld->ModelCount(); ++modelIndex)
+  {
+    auto model = this->runner->sdfWorld->ModelByIndex(modelIndex);
+    if (_namesToLoad.find(model->Name()) != _namesToLoad.end())
+    {
+      std::vector<std::string> paths;
+      if (preloadMeshes)
+        paths = MeshCache::CollisionMeshPaths(*model);
+      std::function<void()> prepare;
+      if (!paths.empty())
+      {
+        prepare = [paths = std::move(paths)]
+        {
+          MeshCache::Instance().Decode(paths);
+        };
+      }
+      this->streamer->Queue(model->Name(), std::move(prepare), [this, model]
+          {
+            Entity modelEntity = this->entityCreator->CreateEntities(model);
+            this->entityCreator->SetParent(modelEntity, this->worldEntity);
+          });
+    }
+  }
 
+  // Models whose includes were deferred are parsed in the background too,
+  // and their DOM is released once their entities are created
+  auto deferred = this->runner->deferredIncludes;
+  for (const auto &name : _namesToLoad)
+  {
+    if (nullptr == deferred || !deferred->Has(name))
+      continue;
+
+    auto prepare = [deferred, name, preloadMeshes]
+    {
+      auto model = deferred->Load(name);
+      if (nullptr != model && preloadMeshes)
+        MeshCache::Instance().Decode(MeshCache::CollisionMeshPaths(*model));
+    };
+    this->streamer->Queue(name, std::move(prepare), [this, deferred, name]
+        {
+          auto model = deferred->Load(name);
+          if (nullptr != model)
+          {
+            Entity modelEntity = this->entityCreator->CreateEntities(model);
+            this->entityCreator->SetParent(modelEntity, this->worldEntity);
+          }
+          deferred->Release(name);
+        });
+  }
 
+  for (uint64_t actorIndex = 0;
+       actorIndex < this->runner->sdfWorld->ActorCount(); ++actorIndex)
+  {
+    auto actor = this->runner->sdfWorld->ActorByIndex(actorIndex);
+    if (_namesToLoad.find(actor->Name()) != _namesToLoad.end())
+    {
+      this->streamer->Queue(actor->Name(), nullptr, [this, actor]
+          {
+            Entity actorEntity = this->entityCreator->CreateEntities(actor);
+            this->entityCreator->SetParent(actorEntity, this->worldEntity);
+          });
+    }
+  }
+
+  for (uint64_t lightIndex = 0;
+       lightIndex < this->runner->sdfWorld->LightCount(); ++lightIndex)
+  {
+    auto light = this->runner->sdfWorld->LightByIndex(lightIndex);
+    if (_namesToLoad.find(light->Name()) != _namesToLoad.end())
+    {
+      this->streamer->Queue(light->Name(), nullptr, [this, light]
+          {
+            Entity lightEntity = this->entityCreator->CreateEntities(light);
+            this->entityCreator->SetParent(lightEntity, this->worldEntity);
+          });
+    }
+  }
+
+  for (uint64_t jointIndex = 0;
+       jointIndex < this->runner->sdfWorld->JointCount(); ++jointIndex)
+  {
+    auto joint = this->runner->sdfWorld->JointByIndex(jointIndex);
+    if (_namesToLoad.find(joint->Name()) != _namesToLoad.end())
+    {
+      this->streamer->Queue(joint->Name(), nullptr, [this, joint]
+          {
+            Entity jointEntity = this->entityCreator->CreateEntities(joint);
+            this->entityCreator->SetParent(jointEntity, this->worldEntity);
+          });
+    }
+  }
+
+  // Queued entities count as active, so they aren't queued again
   this->activeEntityNames.insert(_namesToLoad.begin(), _namesToLoad.end());
 }
 
+/////////////////////////////////////////////////
+void LevelManager::CommitQueuedEntities(const std::set<Entity> &_urgentLevels)
+{
+  GZ_PROFILE("LevelManager::CommitQueuedEntities");
+
+  std::set<std::string> urgentNames;
+  for (const auto &level : _urgentLevels)
+  {
+    auto names = this->runner->entityCompMgr
+                     .Component<components::LevelEntityNames>(level);
+    if (names)
+      urgentNames.insert(names->Data().begin(), names->Data().end());
+  }
+
+  // Load the meshes hashed in the background before creating
+  // the entities that use them
+  MeshCache::Instance().RegisterDecoded();
+
+  this->streamer->Commit(this->streamingBudget, urgentNames);
+}
+
+/////////////////////////////////////////////////
+math::AxisAlignedBox LevelManager::PredictedVolume(const Entity _performer,
+    const math::AxisAlignedBox &_volume)
+{
+  const auto simTime = this->runner->currentInfo.simTime;
+  const auto center = _volume.Center();
+
+  auto motionIt = this->performerMotions.find(_performer);
+  if (motionIt == this->performerMotions.end())
+  {
+    this->performerMotions[_performer] = {center, math::Vector3d::Zero,
+        simTime};
+    return _volume;
+  }
+
+  // Keep the velocity while paused, and forget it when jumping back in time
+  auto &motion = motionIt->second;
+  const double dt =
+      std::chrono::duration<double>(simTime - motion.simTime).count();
+  if (dt > 0)
+    motion.velocity = (center - motion.position) / dt;
+  else if (dt < 0)
+    motion.velocity = math::Vector3d::Zero;
+  motion.position = center;
+  motion.simTime = simTime;
+
+  const auto offset = motion.velocity * this->prefetchTime;
+  auto min = _volume.Min();
+  auto max = _volume.Max();
+  min.Min(_volume.Min() + offset);
+  max.Max(_volume.Max() + offset);
+  return math::AxisAlignedBox(min, max);
+}
+
 /////////////////////////////////////////////////
 void LevelManager::UnloadInactiveEntities(
     const std::set<std::string> &_namesToUnload)
@@ -932,6 +1292,11 @@ void LevelManager::UnloadInactiveEntities(
   for (const auto &name : _namesToUnload)
   {
     this->activeEntityNames.erase(name);
+
+    // Deferred models which were parsed but not created, because their
+    // level was unloaded first
+    if (nullptr != this->runner->deferredIncludes)
+      this->runner->deferredIncludes->Release(name);
   }
 }
 
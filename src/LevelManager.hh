@@ -21,6 +21,7 @@
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
+#include <chrono>
 #include <list>
 #include <memory>
 #include <set>
@@ -31,6 +32,8 @@
 
 #include <sdf/Element.hh>
 #include <sdf/Geometry.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
 #include <gz/transport/Node.hh>
 
 #include "gz/sim/config.hh"
@@ -38,6 +41,9 @@
 #include "gz/sim/SdfEntityCreator.hh"
 #include "gz/sim/Types.hh"
 
+#include "LevelGrid.hh"
+#include "LevelStreamer.hh"
+
 namespace gz
 {
   namespace sim
@@ -74,6 +80,21 @@ namespace gz
     ///   when the level is reloaded. Likewise, they should not be deleted.
     /// * Entities spawned during simulation are part of the default level.
     ///
+    /// Levels can be streamed by adding a `<level_streaming>` element to the
+    /// `gz::sim` plugin, next to the levels:
+    ///
+    ///     <level_streaming>
+    ///       <step_budget>0.002</step_budget>
+    ///       <prefetch_time>1.0</prefetch_time>
+    ///     </level_streaming>
+    ///
+    /// Streamed levels start loading as soon as a performer reaches their
+    /// buffer, or is predicted to reach it within `<prefetch_time>` seconds
+    /// at its current velocity. Their collision meshes are decoded on a
+    /// background thread, and their entities are created over several steps,
+    /// spending up to `<step_budget>` seconds per step. The entities of the
+    /// levels a performer is inside are created right away.
+    ///
     class GZ_SIM_VISIBLE LevelManager
     {
       /// \brief Constructor
@@ -98,6 +119,24 @@ namespace gz
       private: void UnloadInactiveEntities(
           const std::set<std::string> &_namesToUnload);
 
+      /// \brief Queue entities to be created by the level streamer.
+      /// \param[in] _namesToLoad Names of the entities.
+      private: void QueueActiveEntities(
+          const std::set<std::string> &_namesToLoad);
+
+      /// \brief Create the entities queued by the level streamer.
+      /// \param[in] _urgentLevels Levels whose entities are created now,
+      /// regardless of the step budget.
+      private: void CommitQueuedEntities(const std::set<Entity> &_urgentLevels);
+
+      /// \brief Volume of a performer extended along its predicted motion
+      /// over the prefetch time.
+      /// \param[in] _performer Performer entity.
+      /// \param[in] _volume Current volume of the performer.
+      /// \return The volume covering the current and predicted volumes.
+      private: math::AxisAlignedBox PredictedVolume(const Entity _performer,
+          const math::AxisAlignedBox &_volume);
+
       /// \brief Read level and performer information from the sdf::World
       /// object
       private: void ReadLevelPerformerInfo();
@@ -116,10 +155,23 @@ namespace gz
       /// \param[in] _sdf sdf::ElementPtr of the gz::sim plugin tag
       private: void ReadLevels(const sdf::ElementPtr &_sdf);
 
+      /// \brief Read the distances to the nearest performer at which the
+      /// activity level of models increases.
+      /// \param[in] _sdf sdf::ElementPtr of the gz::sim plugin tag
+      private: void ReadActivity(const sdf::ElementPtr &_sdf);
+
+      /// \brief Set the activity level of every top level model from its
+      /// distance to the nearest performer.
+      private: void UpdateActivityLevels();
+
       /// \brief Determine which entities belong to the default level and
       /// schedule them to be loaded
       private: void ConfigureDefaultLevel();
 
+      /// \brief Compute the regions of all levels and put them in the grid.
+      /// Levels are only read once, since they shouldn't move.
+      private: void UpdateLevelGrid();
+
       /// \brief Determine if a level is active
       /// \param[in] _entity Entity of level to be checked
       /// \return True of the level is currently active
@@ -178,6 +230,51 @@ namespace gz
 
       /// \brief Mutex to protect performersToAdd list.
       private: std::mutex performerToAddMutex;
+
+      /// \brief Region and region including the buffer of each level.
+      private: std::unordered_map<Entity,
+               std::pair<math::AxisAlignedBox, math::AxisAlignedBox>>
+               levelRegions;
+
+      /// \brief Grid of the level regions including their buffer, to only
+      /// check performers against the levels near them.
+      private: LevelGrid levelGrid;
+
+      /// \brief True if the level grid needs to be rebuilt.
+      private: bool levelGridDirty{true};
+
+      /// \brief Motion of a performer, to predict the levels it'll reach.
+      private: struct PerformerMotion
+      {
+        /// \brief Center of the performer volume.
+        math::Vector3d position;
+
+        /// \brief Estimated linear velocity.
+        math::Vector3d velocity;
+
+        /// \brief Sim time of the position.
+        std::chrono::steady_clock::duration simTime{0};
+      };
+
+      /// \brief Motion of each performer, when streaming levels.
+      private: std::unordered_map<Entity, PerformerMotion> performerMotions;
+
+      /// \brief Time to spend creating streamed entities per step.
+      private: std::chrono::steady_clock::duration streamingBudget{
+               std::chrono::milliseconds(2)};
+
+      /// \brief How far ahead to predict the motion of performers to start
+      /// streaming levels, in seconds.
+      private: double prefetchTime{1.0};
+
+      /// \brief Creates the entities of levels over several steps, null
+      /// unless level streaming is enabled.
+      private: std::unique_ptr<LevelStreamer> streamer;
+
+      /// \brief Increasing distances to the nearest performer at which the
+      /// activity level of models increases by one. Activity levels aren't
+      /// set if it's empty.
+      private: std::vector<double> activityDistances;
     };
     }
   }
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LevelStreamer.hh"
+
+#include <utility>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+LevelStreamer::LevelStreamer()
+{
+  this->thread = std::thread(&LevelStreamer::Run, this);
+}
+
+//////////////////////////////////////////////////
+LevelStreamer::~LevelStreamer()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->cv.notify_all();
+  if (this->thread.joinable())
+    this->thread.join();
+}
+
+//////////////////////////////////////////////////
+void LevelStreamer::Queue(const std::string &_name,
+    std::function<void()> _prepare, std::function<void()> _create)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Item item;
+    item.name = _name;
+    item.prepare = std::move(_prepare);
+    item.create = std::move(_create);
+    item.prepared = !item.prepare;
+    this->items.push_back(std::move(item));
+  }
+  this->cv.notify_all();
+}
+
+//////////////////////////////////////////////////
+bool LevelStreamer::Cancel(const std::string &_name)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  bool found{false};
+  for (auto it = this->items.begin(); it != this->items.end();)
+  {
+    if (it->name != _name)
+    {
+      ++it;
+      continue;
+    }
+
+    // Don't free an entity while it's being prepared
+    const Item *item = &*it;
+    this->cv.wait(lock, [&]{return this->preparing != item;});
+    it = this->items.erase(it);
+    found = true;
+  }
+  return found;
+}
+
+//////////////////////////////////////////////////
+std::size_t LevelStreamer::Commit(
+    const std::chrono::steady_clock::duration &_budget,
+    const std::set<std::string> &_urgent)
+{
+  GZ_PROFILE("LevelStreamer::Commit");
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::function<void()>> toCreate;
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->items.empty())
+      return 0u;
+
+    // Urgent entities, in order, waiting for the one being prepared
+    if (!_urgent.empty())
+    {
+      for (auto it = this->items.begin(); it != this->items.end();)
+      {
+        if (_urgent.find(it->name) == _urgent.end())
+        {
+          ++it;
+          continue;
+        }
+        const Item *item = &*it;
+        this->cv.wait(lock, [&]{return this->preparing != item;});
+        toCreate.push_back(std::move(it->create));
+        it = this->items.erase(it);
+      }
+    }
+  }
+
+  std::size_t count{0u};
+  for (auto &create : toCreate)
+  {
+    create();
+    ++count;
+  }
+
+  // Prepared entities, in order, until the budget is spent
+  while (count == 0u || std::chrono::steady_clock::now() - start < _budget)
+  {
+    std::function<void()> create;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->items.empty() || !this->items.front().prepared)
+        break;
+      create = std::move(this->items.front().create);
+      this->items.pop_front();
+    }
+    create();
+    ++count;
+  }
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::size_t LevelStreamer::Pending() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->items.size();
+}
+
+//////////////////////////////////////////////////
+void LevelStreamer::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    Item *next{nullptr};
+    this->cv.wait(lock, [&]
+    {
+      if (this->stop)
+        return true;
+      for (auto &item : this->items)
+      {
+        if (!item.prepared)
+        {
+          next = &item;
+          return true;
+        }
+      }
+      return false;
+    });
+    if (this->stop)
+      return;
+
+    // Prepare without holding the lock, the item can't be removed while
+    // it's being prepared
+    this->preparing = next;
+    auto prepare = std::move(next->prepare);
+    lock.unlock();
+    {
+      GZ_PROFILE("LevelStreamer::Prepare");
+      prepare();
+    }
+    lock.lock();
+    next->prepared = true;
+    this->preparing = nullptr;
+    this->cv.notify_all();
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_LEVELSTREAMER_HH_
+#define GZ_SIM_LEVELSTREAMER_HH_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class LevelStreamer LevelStreamer.hh
+    /// \brief Spreads the creation of the entities of levels over several
+    /// simulation steps.
+    ///
+    /// Each queued entity has a function to prepare it, which runs on a
+    /// background thread and must not touch the entity component manager,
+    /// and a function to create it, which runs on the simulation thread
+    /// when Commit is called. Entities are created in the order they were
+    /// queued, once they're prepared, until the time budget of the step is
+    /// spent.
+    class GZ_SIM_VISIBLE LevelStreamer
+    {
+      /// \brief Constructor. Starts the background thread.
+      public: LevelStreamer();
+
+      /// \brief Destructor. Stops the background thread, dropping the
+      /// entities that weren't created.
+      public: ~LevelStreamer();
+
+      /// \brief Queue an entity to be prepared and created.
+      /// \param[in] _name Name of the entity.
+      /// \param[in] _prepare Function called on the background thread.
+      /// \param[in] _create Function called on the simulation thread.
+      public: void Queue(const std::string &_name,
+                  std::function<void()> _prepare,
+                  std::function<void()> _create);
+
+      /// \brief Drop a queued entity, for example because its level was
+      /// unloaded before it was created.
+      /// \param[in] _name Name of the entity.
+      /// \return True if the entity was queued.
+      public: bool Cancel(const std::string &_name);
+
+      /// \brief Create queued entities. This blocks until the urgent
+      /// entities are prepared, and then creates prepared entities in order
+      /// until the budget is spent, creating at least one if any is
+      /// prepared.
+      /// \param[in] _budget Time to spend creating entities.
+      /// \param[in] _urgent Names of entities to create now, regardless of
+      /// the budget, such as the ones of levels a performer is already in.
+      /// \return Number of entities created.
+      public: std::size_t Commit(
+                  const std::chrono::steady_clock::duration &_budget,
+                  const std::set<std::string> &_urgent);
+
+      /// \brief Number of entities that weren't created yet.
+      /// \return Number of queued entities.
+      public: std::size_t Pending() const;
+
+      /// \brief Prepare queued entities until stopped.
+      private: void Run();
+
+      /// \brief An entity waiting to be created.
+      private: struct Item
+      {
+        /// \brief Name of the entity.
+        std::string name;
+
+        /// \brief Function called on the background thread.
+        std::function<void()> prepare;
+
+        /// \brief Function called on the simulation thread.
+        std::function<void()> create;
+
+        /// \brief True once prepare returned.
+        bool prepared{false};
+      };
+
+      /// \brief Queued entities, in order.
+      private: std::list<Item> items;
+
+      /// \brief Entity being prepared, or nullptr.
+      private: const Item *preparing{nullptr};
+
+      /// \brief Protects the members above.
+      private: mutable std::mutex mutex;
+
+      /// \brief Notified when entities are queued, prepared or stopped.
+      private: std::condition_variable cv;
+
+      /// \brief True to stop the background thread.
+      private: bool stop{false};
+
+      /// \brief Background thread.
+      private: std::thread thread;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LevelStreamer.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Wait until the streamer prepared a number of entities.
+void waitFor(const std::atomic<int> &_prepared, int _count)
+{
+  for (int i = 0; i < 500 && _prepared < _count; ++i)
+    std::this_thread::sleep_for(10ms);
+  ASSERT_GE(_prepared, _count);
+}
+
+/////////////////////////////////////////////////
+TEST(LevelStreamer, Order)
+{
+  LevelStreamer streamer;
+  EXPECT_EQ(0u, streamer.Commit(1s, {}));
+
+  std::atomic<int> prepared{0};
+  std::vector<std::string> created;
+  for (const auto *name : {"a", "b", "c"})
+  {
+    streamer.Queue(name, [&]{++prepared;},
+        [&created, name]{created.push_back(name);});
+  }
+  EXPECT_EQ(3u, streamer.Pending());
+  waitFor(prepared, 3);
+
+  // A budget of zero still creates one entity per commit
+  EXPECT_EQ(1u, streamer.Commit(0s, {}));
+  ASSERT_EQ(1u, created.size());
+  EXPECT_EQ("a", created[0]);
+
+  EXPECT_EQ(2u, streamer.Commit(1s, {}));
+  ASSERT_EQ(3u, created.size());
+  EXPECT_EQ("b", created[1]);
+  EXPECT_EQ("c", created[2]);
+  EXPECT_EQ(0u, streamer.Pending());
+}
+
+/////////////////////////////////////////////////
+TEST(LevelStreamer, UrgentAndCancel)
+{
+  LevelStreamer streamer;
+
+  // The first entity takes a while to prepare, so nothing behind it is
+  // created unless it's urgent
+  std::atomic<bool> release{false};
+  std::atomic<int> prepared{0};
+  std::vector<std::string> created;
+  streamer.Queue("slow", [&]
+      {
+        while (!release)
+          std::this_thread::sleep_for(1ms);
+        ++prepared;
+      },
+      [&]{created.push_back("slow");});
+  streamer.Queue("urgent", [&]{++prepared;},
+      [&]{created.push_back("urgent");});
+  streamer.Queue("cancelled", [&]{++prepared;},
+      [&]{created.push_back("cancelled");});
+
+  EXPECT_EQ(0u, streamer.Commit(1s, {}));
+  EXPECT_EQ(1u, streamer.Commit(1s, {"urgent"}));
+  ASSERT_EQ(1u, created.size());
+  EXPECT_EQ("urgent", created[0]);
+
+  EXPECT_TRUE(streamer.Cancel("cancelled"));
+  EXPECT_FALSE(streamer.Cancel("cancelled"));
+
+  release = true;
+  waitFor(prepared, 1);
+  EXPECT_EQ(1u, streamer.Commit(1s, {}));
+  ASSERT_EQ(2u, created.size());
+  EXPECT_EQ("slow", created[1]);
+  EXPECT_EQ(0u, streamer.Pending());
+}
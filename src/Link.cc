@@ -21,6 +21,8 @@
 
 #include <gz/msgs/Utility.hh>
 
+#include <utility>
+
 #include "gz/sim/components/AngularAcceleration.hh"
 #include "gz/sim/components/AngularVelocity.hh"
 #include "gz/sim/components/AngularVelocityCmd.hh"
@@ -52,6 +54,42 @@ class gz::sim::LinkPrivate
 using namespace gz;
 using namespace sim;
 
+namespace
+{
+/// \brief Get the torque about a link's origin of a wrench whose force is
+/// applied at an offset from the origin.
+/// \param[in] _link The link.
+/// \param[in] _ecm Entity-component manager.
+/// \param[in] _force Force expressed in world coordinates.
+/// \param[in] _torque Torque expressed in world coordinates.
+/// \param[in] _offset Point of application of the force expressed in the
+/// link frame.
+/// \return Torque about the link origin in world coordinates.
+math::Vector3d torqueAtOrigin(const Entity _link,
+    const EntityComponentManager &_ecm, const math::Vector3d &_force,
+    const math::Vector3d &_torque, const math::Vector3d &_offset)
+{
+  if (_offset == math::Vector3d::Zero)
+    return _torque;
+
+  math::Pose3d linkWorldPose;
+  auto worldPoseComp = _ecm.Component<components::WorldPose>(_link);
+  if (worldPoseComp)
+  {
+    linkWorldPose = worldPoseComp->Data();
+  }
+  else
+  {
+    linkWorldPose = worldPose(_link, _ecm);
+  }
+
+  // We want the force to be applied at an offset from the link origin, so we
+  // must compute the resulting force and torque on the link origin.
+  auto posComWorldCoord = linkWorldPose.Rot().RotateVector(_offset);
+  return _torque + posComWorldCoord.Cross(_force);
+}
+}
+
 //////////////////////////////////////////////////
 Link::Link(sim::Entity _entity)
   : dataPtr(std::make_unique<LinkPrivate>())
@@ -442,21 +480,8 @@ void Link::AddWorldWrench(EntityComponentManager &_ecm,
                           const math::Vector3d &_torque,
                           const math::Vector3d &_offset) const
 {
-  math::Pose3d linkWorldPose;
-  auto worldPoseComp = _ecm.Component<components::WorldPose>(this->dataPtr->id);
-  if (worldPoseComp)
-  {
-    linkWorldPose = worldPoseComp->Data();
-  }
-  else
-  {
-    linkWorldPose = worldPose(this->dataPtr->id, _ecm);
-  }
-
-  // We want the force to be applied at an offset from the link origin, so we
-  // must compute the resulting force and torque on the link origin.
-  auto posComWorldCoord = linkWorldPose.Rot().RotateVector(_offset);
-  math::Vector3d torqueWithOffset = _torque + posComWorldCoord.Cross(_force);
+  const auto torqueWithOffset =
+      torqueAtOrigin(this->dataPtr->id, _ecm, _force, _torque, _offset);
 
   auto linkWrenchComp =
     _ecm.Component<components::ExternalWorldWrenchCmd>(this->dataPtr->id);
@@ -476,3 +501,50 @@ void Link::AddWorldWrench(EntityComponentManager &_ecm,
       msgs::Convert(linkWrenchComp->Data().torque()) + torqueWithOffset);
   }
 }
+
+//////////////////////////////////////////////////
+void Link::AddWorldForce(EntityComponentManager &_ecm,
+                         WrenchAccumulator *_accumulator,
+                         const math::Vector3d &_force,
+                         const math::Vector3d &_position) const
+{
+  if (nullptr == _accumulator)
+  {
+    this->AddWorldForce(_ecm, _force, _position);
+    return;
+  }
+
+  auto inertial = _ecm.Component<components::Inertial>(this->dataPtr->id);
+  if (!inertial)
+    return;
+
+  this->AddWorldWrench(_ecm, *_accumulator, _force, math::Vector3d::Zero,
+      _position + inertial->Data().Pose().Pos());
+}
+
+//////////////////////////////////////////////////
+void Link::AddWorldWrench(EntityComponentManager &_ecm,
+                          WrenchAccumulator *_accumulator,
+                          const math::Vector3d &_force,
+                          const math::Vector3d &_torque,
+                          const math::Vector3d &_offset) const
+{
+  if (nullptr == _accumulator)
+  {
+    this->AddWorldWrench(_ecm, _force, _torque, _offset);
+    return;
+  }
+  this->AddWorldWrench(std::as_const(_ecm), *_accumulator, _force, _torque,
+      _offset);
+}
+
+//////////////////////////////////////////////////
+void Link::AddWorldWrench(const EntityComponentManager &_ecm,
+                          WrenchAccumulator &_accumulator,
+                          const math::Vector3d &_force,
+                          const math::Vector3d &_torque,
+                          const math::Vector3d &_offset) const
+{
+  _accumulator.Add(this->dataPtr->id, _force,
+      torqueAtOrigin(this->dataPtr->id, _ecm, _force, _torque, _offset));
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LogExport.hh"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Profiler.hh>
+
+#include "gz/sim/components/AngularAcceleration.hh"
+#include "gz/sim/components/AngularVelocity.hh"
+#include "gz/sim/components/JointForce.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/LinearAcceleration.hh"
+#include "gz/sim/components/LinearVelocity.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/System.hh"
+#include "gz/sim/Util.hh"
+
+#include "LogReplay.hh"
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Writes the steps of one segment to chunk files.
+class ExportSystem : public System, public ISystemPostUpdate
+{
+  /// \brief Constructor
+  /// \param[in] _dir Directory to write the chunks to.
+  /// \param[in] _onChunk Called with the path of each chunk that's started.
+  public: ExportSystem(const std::string &_dir,
+              std::function<void(const std::string &)> _onChunk)
+          : dir(_dir), onChunk(std::move(_onChunk))
+  {
+  }
+
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &_info,
+              const EntityComponentManager &_ecm) override;
+
+  /// \brief Add the vector fields of a component of every entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _label Label of the component in the column names.
+  /// \param[in] _field Id of the component's first field.
+  /// \tparam ComponentT Component holding a math::Vector3d.
+  private: template <typename ComponentT>
+  void AddVectors(const EntityComponentManager &_ecm,
+      const std::string &_label, std::uint32_t _field)
+  {
+    _ecm.Each<ComponentT>(
+        [&](const Entity &_entity, const ComponentT *_comp) -> bool
+        {
+          const auto &vec = _comp->Data();
+          this->Add(_ecm, _entity, _field, _label + ".x", vec.X());
+          this->Add(_ecm, _entity, _field + 1, _label + ".y", vec.Y());
+          this->Add(_ecm, _entity, _field + 2, _label + ".z", vec.Z());
+          return true;
+        });
+  }
+
+  /// \brief Add the elements of a component holding doubles, such as the
+  /// positions of a joint's axes, of every entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _label Label of the component in the column names.
+  /// \param[in] _field Id of the component's first field.
+  /// \tparam ComponentT Component holding a std::vector<double>.
+  private: template <typename ComponentT>
+  void AddArrays(const EntityComponentManager &_ecm,
+      const std::string &_label, std::uint32_t _field)
+  {
+    _ecm.Each<ComponentT>(
+        [&](const Entity &_entity, const ComponentT *_comp) -> bool
+        {
+          const auto &values = _comp->Data();
+          for (std::size_t i = 0; i < values.size() && i < kArraySize; ++i)
+          {
+            this->Add(_ecm, _entity, _field + static_cast<std::uint32_t>(i),
+                _label + "." + std::to_string(i), values[i]);
+          }
+          return true;
+        });
+  }
+
+  /// \brief Set the value of a field of an entity in the current row.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _entity The entity.
+  /// \param[in] _field Id of the field.
+  /// \param[in] _label Label of the field in the column name.
+  /// \param[in] _value Its value.
+  private: void Add(const EntityComponentManager &_ecm, Entity _entity,
+      std::uint32_t _field, const std::string &_label, double _value);
+
+  /// \brief Start a new chunk.
+  /// \param[in] _simTime Sim time of its first row.
+  /// \return True if it could be opened.
+  private: bool StartChunk(const std::chrono::steady_clock::duration &_simTime);
+
+  /// \brief Maximum number of exported elements of array components.
+  private: static constexpr std::size_t kArraySize{64u};
+
+  /// \brief Directory to write the chunks to.
+  private: std::string dir;
+
+  /// \brief Called with the path of each chunk.
+  private: std::function<void(const std::string &)> onChunk;
+
+  /// \brief Current chunk.
+  private: std::ofstream file;
+
+  /// \brief Column names, without sim time.
+  private: std::vector<std::string> columns;
+
+  /// \brief Column of each field of each entity.
+  private: std::map<std::pair<Entity, std::uint32_t>, std::size_t> columnIds;
+
+  /// \brief Scoped names of the entities.
+  private: std::unordered_map<Entity, std::string> names;
+
+  /// \brief Values of the current row.
+  private: std::vector<double> row;
+
+  /// \brief True if columns were added for the current row.
+  private: bool newColumns{false};
+
+  /// \brief True once writing failed, to stop exporting.
+  private: bool failed{false};
+};
+
+/// \brief Ids of the exported fields. Array components have kArraySize
+/// ids each.
+enum : std::uint32_t
+{
+  kPose = 0u,
+  kLinearVelocity = 6u,
+  kAngularVelocity = 9u,
+  kLinearAcceleration = 12u,
+  kAngularAcceleration = 15u,
+  kWorldLinearVelocity = 18u,
+  kWorldAngularVelocity = 21u,
+  kWorldLinearAcceleration = 24u,
+  kWorldAngularAcceleration = 27u,
+  kJointPosition = 64u,
+  kJointVelocity = 128u,
+  kJointForce = 192u
+};
+
+//////////////////////////////////////////////////
+void ExportSystem::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("ExportSystem::PostUpdate");
+  if (this->failed)
+    return;
+
+  // Entity ids may be reused once removed
+  if (_ecm.HasEntitiesMarkedForRemoval())
+  {
+    _ecm.EachRemoved<components::Name>(
+        [&](const Entity &_entity, const components::Name *) -> bool
+        {
+          this->names.erase(_entity);
+          auto it = this->columnIds.lower_bound({_entity, 0u});
+          while (it != this->columnIds.end() && it->first.first == _entity)
+            it = this->columnIds.erase(it);
+          return true;
+        });
+  }
+
+  this->row.assign(this->columns.size(),
+      std::numeric_limits<double>::quiet_NaN());
+  this->newColumns = false;
+
+  _ecm.Each<components::Pose>(
+      [&](const Entity &_entity, const components::Pose *_pose) -> bool
+      {
+        const auto &pose = _pose->Data();
+        this->Add(_ecm, _entity, kPose, "pose.x", pose.Pos().X());
+        this->Add(_ecm, _entity, kPose + 1, "pose.y", pose.Pos().Y());
+        this->Add(_ecm, _entity, kPose + 2, "pose.z", pose.Pos().Z());
+        this->Add(_ecm, _entity, kPose + 3, "pose.roll", pose.Rot().Roll());
+        this->Add(_ecm, _entity, kPose + 4, "pose.pitch", pose.Rot().Pitch());
+        this->Add(_ecm, _entity, kPose + 5, "pose.yaw", pose.Rot().Yaw());
+        return true;
+      });
+  this->AddVectors<components::LinearVelocity>(_ecm, "linear_velocity",
+      kLinearVelocity);
+  this->AddVectors<components::AngularVelocity>(_ecm, "angular_velocity",
+      kAngularVelocity);
+  this->AddVectors<components::LinearAcceleration>(_ecm,
+      "linear_acceleration", kLinearAcceleration);
+  this->AddVectors<components::AngularAcceleration>(_ecm,
+      "angular_acceleration", kAngularAcceleration);
+  this->AddVectors<components::WorldLinearVelocity>(_ecm,
+      "world_linear_velocity", kWorldLinearVelocity);
+  this->AddVectors<components::WorldAngularVelocity>(_ecm,
+      "world_angular_velocity", kWorldAngularVelocity);
+  this->AddVectors<components::WorldLinearAcceleration>(_ecm,
+      "world_linear_acceleration", kWorldLinearAcceleration);
+  this->AddVectors<components::WorldAngularAcceleration>(_ecm,
+      "world_angular_acceleration", kWorldAngularAcceleration);
+  this->AddArrays<components::JointPosition>(_ecm, "joint_position",
+      kJointPosition);
+  this->AddArrays<components::JointVelocity>(_ecm, "joint_velocity",
+      kJointVelocity);
+  this->AddArrays<components::JointForce>(_ecm, "joint_force", kJointForce);
+
+  // The header of a chunk lists all its columns
+  if ((this->newColumns || !this->file.is_open()) &&
+      !this->StartChunk(_info.simTime))
+  {
+    this->failed = true;
+    return;
+  }
+
+  // Exact sim time in seconds, with nanosecond digits
+  const auto nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _info.simTime).count();
+  char time[32];
+  std::snprintf(time, sizeof(time), "%" PRId64 ".%09" PRId64,
+      static_cast<std::int64_t>(nsec / 1000000000),
+      static_cast<std::int64_t>(nsec % 1000000000));
+  this->file << time;
+  for (const auto value : this->row)
+  {
+    // Adding zero writes negative zeros as 0
+    this->file << ',';
+    if (!std::isnan(value))
+      this->file << value + 0.0;
+  }
+  this->file << '\n';
+
+  if (!this->file)
+  {
+    gzerr << "Failed to write exported state to [" << this->dir << "]."
+          << std::endl;
+    this->failed = true;
+  }
+}
+
+//////////////////////////////////////////////////
+void ExportSystem::Add(const EntityComponentManager &_ecm, Entity _entity,
+    std::uint32_t _field, const std::string &_label, double _value)
+{
+  auto it = this->columnIds.find({_entity, _field});
+  if (it == this->columnIds.end())
+  {
+    auto nameIt = this->names.find(_entity);
+    if (nameIt == this->names.end())
+    {
+      auto name = scopedName(_entity, _ecm, "::", false);
+      if (name.empty())
+        name = std::to_string(_entity);
+      nameIt = this->names.emplace(_entity, name).first;
+    }
+
+    it = this->columnIds.emplace(std::make_pair(_entity, _field),
+        this->columns.size()).first;
+    this->columns.push_back(nameIt->second + "/" + _label);
+    this->row.push_back(std::numeric_limits<double>::quiet_NaN());
+    this->newColumns = true;
+  }
+  this->row[it->second] = _value;
+}
+
+//////////////////////////////////////////////////
+bool ExportSystem::StartChunk(
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  if (this->file.is_open())
+    this->file.close();
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "state_%020" PRId64 ".csv",
+      static_cast<std::int64_t>(std::chrono::duration_cast<
+      std::chrono::nanoseconds>(_simTime).count()));
+  const auto path = common::joinPaths(this->dir, name);
+
+  this->file.open(path, std::ios::out | std::ios::trunc);
+  if (!this->file)
+  {
+    gzerr << "Failed to create [" << path << "]." << std::endl;
+    return false;
+  }
+  this->file.precision(std::numeric_limits<double>::max_digits10);
+  this->onChunk(path);
+
+  this->file << "sim_time";
+  for (const auto &column : this->columns)
+    this->file << ',' << column;
+  this->file << '\n';
+  return true;
+}
+}
+
+//////////////////////////////////////////////////
+LogExport::LogExport(const std::string &_logPath)
+  : path(_logPath)
+{
+}
+
+//////////////////////////////////////////////////
+void LogExport::SetThreads(unsigned int _threads)
+{
+  this->threads = _threads;
+}
+
+//////////////////////////////////////////////////
+bool LogExport::Run(const std::string &_outputDir)
+{
+  GZ_PROFILE("LogExport::Run");
+  {
+    std::lock_guard<std::mutex> lock(this->chunksMutex);
+    this->chunks.clear();
+  }
+
+  const auto dir = common::absPath(_outputDir);
+  if (!common::isDirectory(dir) && !common::createDirectories(dir))
+  {
+    gzerr << "Failed to create export directory [" << dir << "]."
+          << std::endl;
+    return false;
+  }
+
+  // Each segment writes its own chunks
+  LogReplay replay(this->path);
+  replay.SetThreads(this->threads);
+  replay.AddSystem([this, dir]()
+      {
+        return std::make_shared<ExportSystem>(dir,
+            [this](const std::string &_chunk)
+            {
+              std::lock_guard<std::mutex> lock(this->chunksMutex);
+              this->chunks.push_back(_chunk);
+            });
+      });
+  const bool result = replay.Run();
+
+  std::lock_guard<std::mutex> lock(this->chunksMutex);
+  std::sort(this->chunks.begin(), this->chunks.end());
+  gzmsg << "Exported [" << replay.StepCount() << "] steps to ["
+        << this->chunks.size() << "] chunks in [" << dir << "]."
+        << std::endl;
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> LogExport::Chunks() const
+{
+  std::lock_guard<std::mutex> lock(this->chunksMutex);
+  return this->chunks;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_LOGEXPORT_HH_
+#define GZ_SIM_LOGEXPORT_HH_
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class LogExport LogExport.hh
+    /// \brief Exports the states recorded by the LogRecord system to CSV
+    /// files for offline analysis, with one row per recorded step and one
+    /// column per component field of each entity.
+    ///
+    /// The log is replayed with LogReplay, so segments between keyframes
+    /// are exported in parallel, each to its own chunk files. Chunks are
+    /// named after the sim time of their first row in nanoseconds, such as
+    /// "state_00000000000123000000.csv", so sorting their names sorts them
+    /// in time. A new chunk is started whenever new columns appear. Chunks
+    /// may have different columns, which tools like pandas align by name
+    /// when concatenating them.
+    ///
+    /// The first column, "sim_time", holds the sim time in seconds. The
+    /// other columns are named "<scoped name>/<component>.<field>", such as
+    /// "world::box::link/pose.z". Poses, velocities, accelerations, joint
+    /// positions, joint velocities and joint forces are exported. Fields of
+    /// entities that don't exist in a step are left empty.
+    class GZ_SIM_VISIBLE LogExport
+    {
+      /// \brief Constructor
+      /// \param[in] _logPath Path to a recorded state.tlog file, or to the
+      /// directory that holds it.
+      public: explicit LogExport(const std::string &_logPath);
+
+      /// \brief Set the number of segments exported at the same time.
+      /// \param[in] _threads Number of threads, 0 to use one per core.
+      public: void SetThreads(unsigned int _threads);
+
+      /// \brief Export the log.
+      /// \param[in] _outputDir Directory to write the chunks to, created if
+      /// needed.
+      /// \return True if the whole log was exported.
+      public: bool Run(const std::string &_outputDir);
+
+      /// \brief Paths of the chunks written by the latest export, sorted in
+      /// time.
+      /// \return The paths.
+      public: std::vector<std::string> Chunks() const;
+
+      /// \brief Path to the log.
+      private: std::string path;
+
+      /// \brief Number of segments exported at the same time.
+      private: unsigned int threads{0u};
+
+      /// \brief Chunks written by the latest export.
+      private: std::vector<std::string> chunks;
+
+      /// \brief Protects the chunks.
+      private: mutable std::mutex chunksMutex;
+    };
+    }
+  }
+}
+#endif
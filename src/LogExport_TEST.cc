@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/serialized_map.pb.h>
+#include <gz/msgs/time.pb.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/common/Util.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "LogExport.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+class LogExportTest : public ::testing::Test
+{
+  // Write a log where a model moves 1 m per millisecond for 10 ms, with
+  // keyframes at 4 ms and 8 ms, and a joint appears at 6 ms
+  protected: void SetUp() override
+  {
+    ASSERT_TRUE(this->tempDir.Valid());
+    const auto path = common::joinPaths(this->tempDir.Path(), "state.tlog");
+
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(path, std::ios_base::out));
+
+    auto insert = [&](std::chrono::milliseconds _time,
+        const std::string &_topic, const google::protobuf::Message &_msg)
+    {
+      const auto data = _msg.SerializeAsString();
+      ASSERT_TRUE(log.InsertMessage(_time, "/world/export" + _topic,
+          std::string("gz.msgs.") + _msg.GetDescriptor()->name(),
+          data.data(), data.size()));
+    };
+
+    EntityComponentManager ecm;
+    const auto world = ecm.CreateEntity();
+    ecm.CreateComponent(world, components::World());
+    ecm.CreateComponent(world, components::Name("export"));
+    const auto model = ecm.CreateEntity();
+    ecm.CreateComponent(model, components::Model());
+    ecm.CreateComponent(model, components::Name("box"));
+    ecm.CreateComponent(model, components::ParentEntity(world));
+    ecm.CreateComponent(model, components::Pose());
+
+    for (int i = 1; i <= 10; ++i)
+    {
+      ecm.Component<components::Pose>(model)->Data().Pos().X(i);
+      if (i == 6)
+        ecm.CreateComponent(model, components::JointPosition({0.5, -1.0}));
+
+      msgs::SerializedStateMap state;
+      ecm.State(state, {}, {}, true);
+      insert(std::chrono::milliseconds(i), "/changed_state", state);
+
+      if (i % 4 == 0)
+      {
+        insert(std::chrono::milliseconds(i), "/keyframe_state", state);
+        insert(std::chrono::milliseconds(i), "/keyframe_index",
+            convert<msgs::Time>(std::chrono::milliseconds(i)));
+      }
+    }
+  }
+
+  /// \brief Export the log and read the chunks back.
+  /// \param[in] _threads Number of threads.
+  /// \return Rows of each chunk, starting with the header.
+  protected: std::vector<std::vector<std::string>> Export(
+      unsigned int _threads)
+  {
+    const auto dir = common::joinPaths(this->tempDir.Path(),
+        "export_" + std::to_string(_threads));
+    LogExport exporter(this->tempDir.Path());
+    exporter.SetThreads(_threads);
+    EXPECT_TRUE(exporter.Run(dir));
+
+    std::vector<std::vector<std::string>> chunks;
+    for (const auto &chunk : exporter.Chunks())
+    {
+      EXPECT_EQ(dir, common::parentPath(chunk));
+      std::ifstream file(chunk);
+      chunks.emplace_back();
+      for (std::string line; std::getline(file, line);)
+        chunks.back().push_back(line);
+    }
+    return chunks;
+  }
+
+  /// \brief Temporary directory for the log.
+  protected: common::TempDirectory tempDir{"log_export", "gz_sim", true};
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogExportTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SingleThread))
+{
+  // A new chunk starts when the joint positions appear
+  auto chunks = this->Export(1u);
+  ASSERT_EQ(2u, chunks.size());
+
+  ASSERT_EQ(6u, chunks[0].size());
+  EXPECT_EQ("sim_time,export::box/pose.x,export::box/pose.y,"
+      "export::box/pose.z,export::box/pose.roll,export::box/pose.pitch,"
+      "export::box/pose.yaw", chunks[0][0]);
+  EXPECT_EQ("0.001000000,1,0,0,0,0,0", chunks[0][1]);
+  EXPECT_EQ("0.005000000,5,0,0,0,0,0", chunks[0][5]);
+
+  ASSERT_EQ(6u, chunks[1].size());
+  EXPECT_EQ(chunks[0][0] + ",export::box/joint_position.0,"
+      "export::box/joint_position.1", chunks[1][0]);
+  EXPECT_EQ("0.006000000,6,0,0,0,0,0,0.5,-1", chunks[1][1]);
+  EXPECT_EQ("0.010000000,10,0,0,0,0,0,0.5,-1", chunks[1][5]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogExportTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Segments))
+{
+  // Segments end at 4 ms and 8 ms, and the second one also starts a chunk
+  // at 6 ms
+  auto chunks = this->Export(3u);
+  ASSERT_EQ(4u, chunks.size());
+
+  std::vector<std::size_t> rows;
+  for (const auto &chunk : chunks)
+    rows.push_back(chunk.size() - 1u);
+  EXPECT_EQ((std::vector<std::size_t>{4u, 1u, 3u, 2u}), rows);
+
+  // Sorted by time
+  EXPECT_EQ("0.001000000", common::split(chunks[0][1], ",")[0]);
+  EXPECT_EQ("0.005000000", common::split(chunks[1][1], ",")[0]);
+  EXPECT_EQ("0.006000000", common::split(chunks[2][1], ",")[0]);
+  EXPECT_EQ("0.009000000", common::split(chunks[3][1], ",")[0]);
+  EXPECT_EQ("0.010000000,10,0,0,0,0,0,0.5,-1", chunks[3][2]);
+}
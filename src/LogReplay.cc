@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LogReplay.hh"
+
+#include <gz/msgs/serialized.pb.h>
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <regex>
+#include <thread>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/transport/log/Batch.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/transport/log/QualifiedTime.hh>
+#include <gz/transport/log/QueryOptions.hh>
+
+#include "gz/sim/components/World.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/EventManager.hh"
+
+#include "StateCompression.hh"
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Suffix of the topic holding the keyframes.
+const char kKeyframeSuffix[] = "/keyframe_state";
+
+/// \brief Suffix of the topic holding the time of each keyframe.
+const char kKeyframeIndexSuffix[] = "/keyframe_index";
+
+//////////////////////////////////////////////////
+/// \brief Check whether a topic ends with a suffix.
+bool endsWith(const std::string &_topic, const std::string &_suffix)
+{
+  return _topic.size() >= _suffix.size() &&
+      _topic.compare(_topic.size() - _suffix.size(), _suffix.size(),
+      _suffix) == 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Apply a recorded message to an entity component manager, if it
+/// holds state.
+/// \param[in] _ecm The entity component manager.
+/// \param[in] _type Type of the message.
+/// \param[in] _data Serialized message.
+/// \return True if the message held state.
+bool applyState(EntityComponentManager &_ecm, const std::string &_type,
+    const std::string &_data)
+{
+  // Recorded states may be compressed
+  if (_type == kCompressedStateType)
+  {
+    auto type = _type;
+    auto data = _data;
+    return uncompressMessage(type, data) && applyState(_ecm, type, data);
+  }
+
+  // Support ignition.msgs for backwards compatibility. Remove on gz-sim9
+  if (_type == "gz.msgs.SerializedStateMap" ||
+      _type == "ignition.msgs.SerializedStateMap")
+  {
+    msgs::SerializedStateMap msg;
+    if (!msg.ParseFromString(_data))
+      return false;
+    _ecm.SetState(msg);
+    return true;
+  }
+  if (_type == "gz.msgs.SerializedState" ||
+      _type == "ignition.msgs.SerializedState")
+  {
+    msgs::SerializedState msg;
+    if (!msg.ParseFromString(_data))
+      return false;
+    _ecm.SetState(msg);
+    return true;
+  }
+  return false;
+}
+}
+
+//////////////////////////////////////////////////
+LogReplay::LogReplay(const std::string &_logPath)
+  : path(common::absPath(_logPath))
+{
+  if (common::isDirectory(this->path))
+    this->path = common::joinPaths(this->path, "state.tlog");
+}
+
+//////////////////////////////////////////////////
+void LogReplay::AddSystem(const sdf::Plugin &_plugin)
+{
+  this->plugins.push_back(_plugin);
+}
+
+//////////////////////////////////////////////////
+void LogReplay::AddSystem(std::function<std::shared_ptr<System>()> _factory)
+{
+  this->factories.push_back(std::move(_factory));
+}
+
+//////////////////////////////////////////////////
+void LogReplay::SetThreads(unsigned int _threads)
+{
+  this->threads = _threads;
+}
+
+//////////////////////////////////////////////////
+std::size_t LogReplay::SegmentCount() const
+{
+  return this->segmentCount;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t LogReplay::StepCount() const
+{
+  return this->stepCount;
+}
+
+//////////////////////////////////////////////////
+bool LogReplay::Run()
+{
+  GZ_PROFILE("LogReplay::Run");
+  this->segmentCount = 0u;
+  this->stepCount = 0u;
+
+  transport::log::Log log;
+  if (!common::isFile(this->path) || !log.Open(this->path))
+  {
+    gzerr << "Failed to open log file [" << this->path << "]." << std::endl;
+    return false;
+  }
+
+  unsigned int threadCount = this->threads;
+  if (threadCount == 0u)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  // Split the log at its keyframes, which are the only states that can be
+  // set without replaying everything before them
+  std::vector<std::chrono::nanoseconds> keyframes;
+  if (threadCount > 1u)
+  {
+    auto batch = log.QueryMessages(transport::log::TopicPattern(
+        std::regex(std::string(".*") + kKeyframeIndexSuffix)));
+    for (const auto &msg : batch)
+      keyframes.push_back(msg.TimeReceived());
+    std::sort(keyframes.begin(), keyframes.end());
+    keyframes.erase(std::unique(keyframes.begin(), keyframes.end()),
+        keyframes.end());
+  }
+  this->segmentCount = keyframes.size() + 1u;
+  threadCount = static_cast<unsigned int>(
+      std::min<std::size_t>(threadCount, this->segmentCount));
+
+  gzmsg << "Replaying [" << this->path << "] as [" << this->segmentCount
+        << "] segments on [" << threadCount << "] threads." << std::endl;
+
+  std::atomic<std::size_t> next{0u};
+  std::atomic<bool> result{true};
+  auto worker = [&]()
+  {
+    for (std::size_t i = next++; i < this->segmentCount; i = next++)
+    {
+      const auto *begin = i == 0u ? nullptr : &keyframes[i - 1u];
+      const auto *end = i < keyframes.size() ? &keyframes[i] : nullptr;
+      if (!this->ReplaySegment(begin, end))
+        result = false;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 1u; i < threadCount; ++i)
+    workers.emplace_back(worker);
+  worker();
+  for (auto &thread : workers)
+    thread.join();
+
+  gzmsg << "Replayed [" << this->stepCount << "] steps." << std::endl;
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LogReplay::ReplaySegment(const std::chrono::nanoseconds *_begin,
+    const std::chrono::nanoseconds *_end)
+{
+  GZ_PROFILE("LogReplay::ReplaySegment");
+
+  // Each segment has its own connection to the log
+  transport::log::Log log;
+  if (!log.Open(this->path))
+  {
+    gzerr << "Failed to open log file [" << this->path << "]." << std::endl;
+    return false;
+  }
+
+  // Systems are declared last, so they're destroyed before the ECM
+  EntityComponentManager ecm;
+  EventManager eventMgr;
+  std::vector<ReplaySystem> systems;
+  if (!this->CreateSystems(systems))
+    return false;
+
+  using QualifiedTime = transport::log::QualifiedTime;
+  using QualifiedTimeRange = transport::log::QualifiedTimeRange;
+  auto range = QualifiedTimeRange::AllTime();
+  std::chrono::nanoseconds lastTime{0};
+  if (_begin)
+  {
+    // Start from the keyframe, which is also the last step of the previous
+    // segment. Its entities are still new to this segment's systems.
+    auto batch = log.QueryMessages(transport::log::TopicPattern(
+        std::regex(std::string(".*") + kKeyframeSuffix),
+        QualifiedTimeRange(QualifiedTime(*_begin), QualifiedTime(*_begin))));
+    bool found{false};
+    for (const auto &msg : batch)
+    {
+      if (applyState(ecm, msg.Type(), msg.Data()))
+      {
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+    {
+      gzerr << "Failed to load the keyframe at ["
+            << std::chrono::duration<double>(*_begin).count() << "] s."
+            << std::endl;
+      return false;
+    }
+
+    lastTime = *_begin;
+    const QualifiedTime after(*_begin, QualifiedTime::Qualifier::EXCLUSIVE);
+    range = _end ? QualifiedTimeRange(after, QualifiedTime(*_end)) :
+        QualifiedTimeRange::From(after);
+  }
+  else if (_end)
+  {
+    range = QualifiedTimeRange::Until(QualifiedTime(*_end));
+  }
+
+  bool configured{false};
+  std::uint64_t steps{0u};
+  std::optional<std::chrono::nanoseconds> stepTime;
+  auto finishStep = [&]() -> bool
+  {
+    if (!configured)
+    {
+      const auto worldEntity = ecm.EntityByComponents(components::World());
+      if (worldEntity == kNullEntity)
+      {
+        gzerr << "The log doesn't have a world entity." << std::endl;
+        return false;
+      }
+      for (auto &system : systems)
+      {
+        if (system.configure)
+        {
+          system.configure->Configure(worldEntity, system.sdf, ecm,
+              eventMgr);
+        }
+      }
+      configured = true;
+    }
+
+    UpdateInfo info;
+    info.simTime = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(*stepTime);
+    info.dt = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(*stepTime - lastTime);
+    info.iterations = ++steps;
+    info.paused = false;
+    for (auto &system : systems)
+    {
+      if (system.postUpdate)
+        system.postUpdate->PostUpdate(info, ecm);
+    }
+    lastTime = *stepTime;
+    stepTime.reset();
+
+    // Same bookkeeping as the end of a simulation step
+    ecm.ClearNewlyCreatedEntities();
+    ecm.ProcessRemoveEntityRequests();
+    ecm.ClearRemovedComponents();
+    ecm.SetAllComponentsUnchanged();
+    return true;
+  };
+
+  // All the state messages recorded at the same time are one step
+  auto batch = log.QueryMessages(transport::log::AllTopics(range));
+  for (const auto &msg : batch)
+  {
+    if (endsWith(msg.Topic(), kKeyframeSuffix) ||
+        endsWith(msg.Topic(), kKeyframeIndexSuffix))
+    {
+      continue;
+    }
+
+    if (stepTime && msg.TimeReceived() != *stepTime && !finishStep())
+      return false;
+
+    if (applyState(ecm, msg.Type(), msg.Data()))
+      stepTime = msg.TimeReceived();
+  }
+  if (stepTime && !finishStep())
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->countMutex);
+  this->stepCount += steps;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogReplay::CreateSystems(std::vector<ReplaySystem> &_systems)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->loaderMutex);
+    for (const auto &plugin : this->plugins)
+    {
+      auto loaded = this->loader.LoadPlugin(plugin);
+      if (!loaded || !(*loaded))
+      {
+        gzerr << "Failed to load system plugin [" << plugin.Filename()
+              << "]." << std::endl;
+        return false;
+      }
+
+      // The deleter holds the plugin, so it stays loaded while the system
+      // is used
+      SystemPluginPtr systemPlugin = *loaded;
+      ReplaySystem replaySystem;
+      replaySystem.system = std::shared_ptr<System>(
+          systemPlugin->QueryInterface<System>(),
+          [systemPlugin](System *) {});
+      replaySystem.configure =
+          systemPlugin->QueryInterface<ISystemConfigure>();
+      replaySystem.postUpdate =
+          systemPlugin->QueryInterface<ISystemPostUpdate>();
+      replaySystem.sdf = plugin.ToElement();
+      if (!replaySystem.postUpdate)
+      {
+        gzwarn << "System [" << plugin.Name() << "] in [" << plugin.Filename()
+               << "] has no PostUpdate, so it won't see the log."
+               << std::endl;
+      }
+      _systems.push_back(std::move(replaySystem));
+    }
+  }
+
+  for (const auto &factory : this->factories)
+  {
+    ReplaySystem replaySystem;
+    replaySystem.system = factory();
+    if (!replaySystem.system)
+    {
+      gzerr << "Failed to create an analysis system." << std::endl;
+      return false;
+    }
+    replaySystem.configure =
+        dynamic_cast<ISystemConfigure *>(replaySystem.system.get());
+    replaySystem.postUpdate =
+        dynamic_cast<ISystemPostUpdate *>(replaySystem.system.get());
+    replaySystem.sdf = std::make_shared<sdf::Element>();
+    _systems.push_back(std::move(replaySystem));
+  }
+  return true;
+}
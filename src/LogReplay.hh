@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_LOGREPLAY_HH_
+#define GZ_SIM_LOGREPLAY_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sdf/Plugin.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/System.hh>
+#include <gz/sim/SystemLoader.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class LogReplay LogReplay.hh
+    /// \brief Replays the states recorded by the LogRecord system as fast as
+    /// possible, without a simulation loop, and runs analysis systems on
+    /// them.
+    ///
+    /// The log is split into segments at its keyframes. Each segment is
+    /// replayed on its own entity component manager, starting from the
+    /// initial state or from a keyframe, and segments are replayed in
+    /// parallel. Every segment gets its own instance of each analysis
+    /// system, which is configured once the segment's first state is set,
+    /// and whose PostUpdate is called for every recorded step. Other system
+    /// interfaces aren't called, so systems only observe the log.
+    ///
+    /// Systems that need to see the whole log in order should be replayed
+    /// with a single thread, which replays the log as one segment.
+    class GZ_SIM_VISIBLE LogReplay
+    {
+      /// \brief Constructor
+      /// \param[in] _logPath Path to a recorded state.tlog file, or to the
+      /// directory that holds it.
+      public: explicit LogReplay(const std::string &_logPath);
+
+      /// \brief Add an analysis system loaded from a plugin.
+      /// \param[in] _plugin The plugin, loaded once per segment.
+      public: void AddSystem(const sdf::Plugin &_plugin);
+
+      /// \brief Add an analysis system created by a function.
+      /// \param[in] _factory Function called once per segment to create an
+      /// instance of the system.
+      public: void AddSystem(
+                  std::function<std::shared_ptr<System>()> _factory);
+
+      /// \brief Set the number of segments replayed at the same time.
+      /// \param[in] _threads Number of threads, 0 to use one per core.
+      public: void SetThreads(unsigned int _threads);
+
+      /// \brief Replay the log.
+      /// \return True if every segment was replayed.
+      public: bool Run();
+
+      /// \brief Number of segments of the latest replay.
+      /// \return Number of segments.
+      public: std::size_t SegmentCount() const;
+
+      /// \brief Number of steps of the latest replay, over all segments.
+      /// \return Number of steps.
+      public: std::uint64_t StepCount() const;
+
+      /// \brief Replay one segment.
+      /// \param[in] _begin Time of the keyframe the segment starts from,
+      /// null for the start of the log.
+      /// \param[in] _end Time of the last step of the segment, null for the
+      /// end of the log.
+      /// \return True if the segment was replayed.
+      private: bool ReplaySegment(
+                  const std::chrono::nanoseconds *_begin,
+                  const std::chrono::nanoseconds *_end);
+
+      /// \brief An instance of an analysis system.
+      private: struct ReplaySystem
+      {
+        /// \brief The system, which keeps its plugin loaded.
+        std::shared_ptr<System> system;
+
+        /// \brief Its configure interface, if any.
+        ISystemConfigure *configure{nullptr};
+
+        /// \brief Its post-update interface, if any.
+        ISystemPostUpdate *postUpdate{nullptr};
+
+        /// \brief SDF to configure it with.
+        sdf::ElementPtr sdf;
+      };
+
+      /// \brief Create one instance of every analysis system.
+      /// \param[out] _systems The systems.
+      /// \return True if all the systems were created.
+      private: bool CreateSystems(std::vector<ReplaySystem> &_systems);
+
+      /// \brief Path to the state.tlog file.
+      private: std::string path;
+
+      /// \brief Analysis systems loaded from plugins.
+      private: std::vector<sdf::Plugin> plugins;
+
+      /// \brief Analysis systems created by functions.
+      private: std::vector<std::function<std::shared_ptr<System>()>>
+                  factories;
+
+      /// \brief Loads the plugins.
+      private: SystemLoader loader;
+
+      /// \brief Protects the loader.
+      private: std::mutex loaderMutex;
+
+      /// \brief Number of segments replayed at the same time.
+      private: unsigned int threads{0u};
+
+      /// \brief Number of segments of the latest replay.
+      private: std::size_t segmentCount{0u};
+
+      /// \brief Number of steps of the latest replay.
+      private: std::uint64_t stepCount{0u};
+
+      /// \brief Protects the step count.
+      private: std::mutex countMutex;
+    };
+    }
+  }
+}
+#endif
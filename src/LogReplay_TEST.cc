@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/serialized_map.pb.h>
+#include <gz/msgs/time.pb.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "LogReplay.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Records the poses the replay steps through.
+class PoseRecorder : public System, public ISystemConfigure,
+    public ISystemPostUpdate
+{
+  // Documentation inherited
+  public: void Configure(const Entity &_entity,
+      const std::shared_ptr<const sdf::Element> &,
+      EntityComponentManager &, EventManager &) override
+  {
+    std::lock_guard<std::mutex> lock(*this->mutex);
+    EXPECT_NE(kNullEntity, _entity);
+    ++(*this->configured);
+  }
+
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm) override
+  {
+    std::lock_guard<std::mutex> lock(*this->mutex);
+    _ecm.Each<components::Pose>(
+        [&](const Entity &, const components::Pose *_pose) -> bool
+        {
+          // Every step is seen once
+          EXPECT_EQ(0u, this->poses->count(_info.simTime));
+          (*this->poses)[_info.simTime] = _pose->Data().Pos().X();
+          return true;
+        });
+  }
+
+  /// \brief Pose X by sim time, shared by all instances.
+  public: std::map<std::chrono::steady_clock::duration, double> *poses;
+
+  /// \brief Number of configured instances.
+  public: int *configured;
+
+  /// \brief Protects the shared results.
+  public: std::mutex *mutex;
+};
+
+/////////////////////////////////////////////////
+class LogReplayTest : public ::testing::Test
+{
+  // Write a log where a model moves 1 m per millisecond for 10 ms, with
+  // keyframes at 4 ms and 8 ms
+  protected: void SetUp() override
+  {
+    ASSERT_TRUE(this->tempDir.Valid());
+    this->path = common::joinPaths(this->tempDir.Path(), "state.tlog");
+
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(this->path, std::ios_base::out));
+
+    auto insert = [&](std::chrono::milliseconds _time,
+        const std::string &_topic, const google::protobuf::Message &_msg)
+    {
+      const auto data = _msg.SerializeAsString();
+      ASSERT_TRUE(log.InsertMessage(_time, "/world/replay" + _topic,
+          std::string("gz.msgs.") + _msg.GetDescriptor()->name(),
+          data.data(), data.size()));
+    };
+
+    EntityComponentManager ecm;
+    const auto world = ecm.CreateEntity();
+    ecm.CreateComponent(world, components::World());
+    const auto model = ecm.CreateEntity();
+    ecm.CreateComponent(model, components::Pose());
+
+    for (int i = 1; i <= 10; ++i)
+    {
+      ecm.Component<components::Pose>(model)->Data().Pos().X(i);
+
+      msgs::SerializedStateMap state;
+      if (i == 1)
+        ecm.State(state, {}, {}, true);
+      else
+        ecm.State(state, {model}, {}, true);
+      insert(std::chrono::milliseconds(i), "/changed_state", state);
+
+      if (i % 4 == 0)
+      {
+        msgs::SerializedStateMap keyframe;
+        ecm.State(keyframe, {}, {}, true);
+        insert(std::chrono::milliseconds(i), "/keyframe_state", keyframe);
+        insert(std::chrono::milliseconds(i), "/keyframe_index",
+            convert<msgs::Time>(std::chrono::milliseconds(i)));
+      }
+    }
+  }
+
+  /// \brief Replay the log.
+  /// \param[in] _threads Number of threads.
+  /// \param[out] _segments Number of segments.
+  protected: void Replay(unsigned int _threads, std::size_t &_segments)
+  {
+    this->poses.clear();
+    this->configured = 0;
+
+    LogReplay replay(this->tempDir.Path());
+    replay.SetThreads(_threads);
+    replay.AddSystem([this]()
+        {
+          auto system = std::make_shared<PoseRecorder>();
+          system->poses = &this->poses;
+          system->configured = &this->configured;
+          system->mutex = &this->mutex;
+          return system;
+        });
+    EXPECT_TRUE(replay.Run());
+    EXPECT_EQ(10u, replay.StepCount());
+    _segments = replay.SegmentCount();
+
+    // Every step is replayed with its recorded pose
+    ASSERT_EQ(10u, this->poses.size());
+    for (int i = 1; i <= 10; ++i)
+    {
+      EXPECT_DOUBLE_EQ(i,
+          this->poses[std::chrono::milliseconds(i)]) << i;
+    }
+  }
+
+  /// \brief Temporary directory for the log.
+  protected: common::TempDirectory tempDir{"log_replay", "gz_sim", true};
+
+  /// \brief Path to the log.
+  protected: std::string path;
+
+  /// \brief Replayed poses.
+  protected: std::map<std::chrono::steady_clock::duration, double> poses;
+
+  /// \brief Number of configured systems.
+  protected: int configured{0};
+
+  /// \brief Protects the results.
+  protected: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogReplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SingleThread))
+{
+  // The whole log is one segment, with one instance of the system
+  std::size_t segments{0u};
+  this->Replay(1u, segments);
+  EXPECT_EQ(1u, segments);
+  EXPECT_EQ(1, this->configured);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogReplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Segments))
+{
+  // Split at the keyframes, each segment starting from one
+  std::size_t segments{0u};
+  this->Replay(4u, segments);
+  EXPECT_EQ(3u, segments);
+  EXPECT_EQ(3, this->configured);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogReplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(InvalidLog))
+{
+  LogReplay replay(common::joinPaths(this->tempDir.Path(), "missing"));
+  EXPECT_FALSE(replay.Run());
+}
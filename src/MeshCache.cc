@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MeshCache.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sdf/Collision.hh>
+#include <sdf/Geometry.hh>
+#include <sdf/Link.hh>
+#include <sdf/Mesh.hh>
+#include <sdf/Model.hh>
+#include <sdf/World.hh>
+
+#include <gz/common/ColladaLoader.hh>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/OBJLoader.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/common/STLLoader.hh>
+#include <gz/common/URI.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/sim/Util.hh"
+
+#include "StartupTimeline.hh"
+#include "ThreadPool.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Private data for the MeshCache class.
+class gz::sim::MeshCachePrivate
+{
+  /// \brief Protects the maps below.
+  public: mutable std::mutex mutex;
+
+  /// \brief Content hash of each preloaded path.
+  public: std::unordered_map<std::string, std::string> hashOfPath;
+
+  /// \brief Name under which the mesh of each content hash is registered
+  /// with the mesh manager.
+  public: std::unordered_map<std::string, std::string> meshOfHash;
+
+  /// \brief A content that isn't registered with the mesh manager yet.
+  public: struct PendingMesh
+  {
+    /// \brief Path the content was first found at, which it's registered
+    /// under.
+    std::string path;
+
+    /// \brief Decoded mesh, or nullptr to load it through the mesh manager.
+    std::unique_ptr<common::Mesh> mesh;
+
+    /// \brief True while a thread is decoding it.
+    bool decoding{true};
+  };
+
+  /// \brief Content hash of each decoded path that isn't registered yet.
+  public: std::unordered_map<std::string, std::string> pendingHashOfPath;
+
+  /// \brief Contents that aren't registered yet, by hash.
+  public: std::unordered_map<std::string, PendingMesh> pendingMeshOfHash;
+
+  /// \brief Read and hash mesh files, and decode each new content once.
+  /// \param[in] _paths Absolute paths of the mesh files.
+  /// \param[in] _parallel True to decode them on the shared thread pool,
+  /// false to decode them on the calling thread.
+  /// \return Number of contents that were queued.
+  public: std::size_t Decode(const std::vector<std::string> &_paths,
+              bool _parallel);
+
+  /// \brief Register the decoded meshes with the mesh manager.
+  /// \return Number of meshes that were registered.
+  public: std::size_t Register();
+};
+
+namespace
+{
+/// \brief Number of distinct collision mesh files from which worlds are
+/// preloaded even if preloading isn't requested.
+constexpr std::size_t kManyMeshes{16u};
+
+//////////////////////////////////////////////////
+/// \brief Hash the content of a file.
+/// \param[in] _file Path of the file.
+/// \return SHA-1 of the content, or an empty string if the file couldn't
+/// be read.
+std::string hashFile(const std::string &_file)
+{
+  std::ifstream stream(_file, std::ios::binary);
+  if (!stream)
+    return std::string();
+
+  const std::string content((std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+  return common::sha1(content);
+}
+
+//////////////////////////////////////////////////
+/// \brief Decode a mesh file without the mesh manager, with the loader the
+/// mesh manager would use, so it can run on any thread. Each call uses
+/// its own loader.
+/// \param[in] _file Path of the file.
+/// \return The mesh, or nullptr if it must be loaded by the mesh manager,
+/// such as the formats that are loaded with Assimp.
+std::unique_ptr<common::Mesh> decodeMesh(const std::string &_file)
+{
+  // The mesh manager loads everything with Assimp when this is set
+  std::string forceAssimp;
+  if (common::env("GZ_MESH_FORCE_ASSIMP", forceAssimp))
+    return nullptr;
+
+  const auto dot = _file.rfind('.');
+  if (dot == std::string::npos)
+    return nullptr;
+  const std::string extension = common::lowercase(_file.substr(dot + 1));
+
+  common::Mesh *mesh{nullptr};
+  if (extension == "dae")
+  {
+    common::ColladaLoader loader;
+    mesh = loader.Load(_file);
+  }
+  else if (extension == "stl" || extension == "stlb" || extension == "stla")
+  {
+    common::STLLoader loader;
+    mesh = loader.Load(_file);
+  }
+  else if (extension == "obj")
+  {
+    common::OBJLoader loader;
+    mesh = loader.Load(_file);
+  }
+  return std::unique_ptr<common::Mesh>(mesh);
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the collision mesh paths of a model and its nested models.
+/// \param[in] _model The model.
+/// \param[in, out] _seen Paths that were already added.
+/// \param[in, out] _paths Paths of the mesh files.
+void addCollisionMeshPaths(const sdf::Model &_model,
+    std::unordered_set<std::string> &_seen, std::vector<std::string> &_paths)
+{
+  for (uint64_t l = 0; l < _model.LinkCount(); ++l)
+  {
+    const auto *link = _model.LinkByIndex(l);
+    for (uint64_t c = 0; c < link->CollisionCount(); ++c)
+    {
+      const auto *geom = link->CollisionByIndex(c)->Geom();
+      if (nullptr == geom || geom->Type() != sdf::GeometryType::MESH ||
+          nullptr == geom->MeshShape())
+      {
+        continue;
+      }
+
+      const auto *mesh = geom->MeshShape();
+      if (mesh->Uri().empty() || common::URI(mesh->Uri()).Scheme() == "name")
+        continue;
+
+      auto path = asFullPath(mesh->Uri(), mesh->FilePath());
+      if (_seen.insert(path).second)
+        _paths.push_back(std::move(path));
+    }
+  }
+
+  for (uint64_t m = 0; m < _model.ModelCount(); ++m)
+    addCollisionMeshPaths(*_model.ModelByIndex(m), _seen, _paths);
+}
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshCachePrivate::Decode(const std::vector<std::string> &_paths,
+    bool _parallel)
+{
+  struct Job
+  {
+    std::string path;
+    std::string file;
+  };
+
+  // Resolve the files on the calling thread, since finding them may
+  // download them
+  auto &meshManager = *common::MeshManager::Instance();
+  std::vector<Job> jobs;
+  {
+    std::unordered_set<std::string> seen;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (const auto &path : _paths)
+    {
+      if (path.empty() || !seen.insert(path).second ||
+          this->hashOfPath.count(path) > 0u ||
+          this->pendingHashOfPath.count(path) > 0u ||
+          meshManager.HasMesh(path) || !meshManager.IsValidFilename(path))
+      {
+        continue;
+      }
+
+      auto file = common::findFile(path);
+      if (file.empty())
+        continue;
+
+      jobs.push_back({path, file});
+    }
+  }
+
+  if (jobs.empty())
+    return 0u;
+
+  const auto forEach = [&](std::size_t _count,
+      const std::function<void(std::size_t, std::size_t)> &_fn)
+  {
+    if (_parallel)
+      ThreadPool::Shared().ParallelFor(_count, 1u, _fn);
+    else
+      _fn(0u, _count);
+  };
+
+  // Each worker hashes a file, and decodes it right away if its content
+  // wasn't claimed by another file yet, so the decoders find it in the
+  // cache of the file system
+  std::atomic<std::size_t> count{0u};
+  forEach(jobs.size(), [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const auto &job = jobs[i];
+      const std::string hash = hashFile(job.file);
+      if (hash.empty())
+        continue;
+
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pendingHashOfPath[job.path] = hash;
+        if (this->meshOfHash.count(hash) > 0u ||
+            !this->pendingMeshOfHash.emplace(hash,
+                PendingMesh{job.path, nullptr, true}).second)
+        {
+          continue;
+        }
+      }
+
+      auto mesh = decodeMesh(job.file);
+      std::lock_guard<std::mutex> lock(this->mutex);
+      auto &pending = this->pendingMeshOfHash[hash];
+      pending.mesh = std::move(mesh);
+      pending.decoding = false;
+      ++count;
+    }
+  });
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshCachePrivate::Register()
+{
+  // Register the meshes under the first path each content was found at.
+  // Meshes that weren't decoded are loaded by the mesh manager, and those
+  // still being decoded are left for the next call.
+  auto &meshManager = *common::MeshManager::Instance();
+  std::size_t count{0u};
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto it = this->pendingMeshOfHash.begin();
+       it != this->pendingMeshOfHash.end();)
+  {
+    auto &[hash, pending] = *it;
+    if (pending.decoding)
+    {
+      ++it;
+      continue;
+    }
+
+    if (meshManager.HasMesh(pending.path))
+    {
+      this->meshOfHash[hash] = pending.path;
+    }
+    else if (pending.mesh)
+    {
+      pending.mesh->SetName(pending.path);
+      meshManager.AddMesh(pending.mesh.release());
+      this->meshOfHash[hash] = pending.path;
+      ++count;
+    }
+    else if (nullptr != meshManager.Load(pending.path))
+    {
+      this->meshOfHash[hash] = pending.path;
+      ++count;
+    }
+    else
+    {
+      gzwarn << "Failed to preload mesh [" << pending.path << "]."
+             << std::endl;
+    }
+    it = this->pendingMeshOfHash.erase(it);
+  }
+
+  for (auto it = this->pendingHashOfPath.begin();
+       it != this->pendingHashOfPath.end();)
+  {
+    const auto &[path, hash] = *it;
+    if (this->pendingMeshOfHash.count(hash) > 0u)
+    {
+      ++it;
+      continue;
+    }
+    if (this->meshOfHash.count(hash) > 0u)
+      this->hashOfPath[path] = hash;
+    it = this->pendingHashOfPath.erase(it);
+  }
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+MeshCache::MeshCache()
+  : dataPtr(std::make_unique<MeshCachePrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+MeshCache::~MeshCache() = default;
+
+//////////////////////////////////////////////////
+MeshCache &MeshCache::Instance()
+{
+  static MeshCache cache;
+  return cache;
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshCache::Preload(const std::vector<std::string> &_paths)
+{
+  GZ_PROFILE("MeshCache::Preload");
+
+  this->dataPtr->Decode(_paths, true);
+  return this->dataPtr->Register();
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshCache::Decode(const std::vector<std::string> &_paths)
+{
+  GZ_PROFILE("MeshCache::Decode");
+
+  return this->dataPtr->Decode(_paths, false);
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshCache::RegisterDecoded()
+{
+  GZ_PROFILE("MeshCache::RegisterDecoded");
+
+  return this->dataPtr->Register();
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshCache::Preload(const sdf::Root &_root, const bool _always)
+{
+  StartupTimeline::Scope preloadScope("Preload meshes", "sdf");
+  auto paths = CollisionMeshPaths(_root);
+  if (paths.empty() || (!_always && paths.size() < kManyMeshes))
+    return 0u;
+
+  const auto count = this->Preload(paths);
+  gzdbg << "Preloaded [" << count << "] of [" << paths.size()
+        << "] collision meshes." << std::endl;
+  return count;
+}
+
+//////////////////////////////////////////////////
+const common::Mesh *MeshCache::Find(const std::string &_path) const
+{
+  std::string name;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto hashIt = this->dataPtr->hashOfPath.find(_path);
+    if (hashIt == this->dataPtr->hashOfPath.end())
+      return nullptr;
+
+    auto meshIt = this->dataPtr->meshOfHash.find(hashIt->second);
+    if (meshIt == this->dataPtr->meshOfHash.end())
+      return nullptr;
+    name = meshIt->second;
+  }
+
+  // The mesh manager owns the mesh, which may have been removed since
+  return common::MeshManager::Instance()->MeshByName(name);
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::ContentHash(const std::string &_path) const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto hashIt = this->dataPtr->hashOfPath.find(_path);
+    if (hashIt != this->dataPtr->hashOfPath.end())
+      return hashIt->second;
+  }
+
+  auto file = common::findFile(_path);
+  if (file.empty())
+    return std::string();
+  return hashFile(file);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> MeshCache::CollisionMeshPaths(
+    const sdf::Root &_root)
+{
+  std::unordered_set<std::string> seen;
+  std::vector<std::string> paths;
+  for (uint64_t w = 0; w < _root.WorldCount(); ++w)
+  {
+    const auto *world = _root.WorldByIndex(w);
+    for (uint64_t m = 0; m < world->ModelCount(); ++m)
+      addCollisionMeshPaths(*world->ModelByIndex(m), seen, paths);
+  }
+  if (nullptr != _root.Model())
+    addCollisionMeshPaths(*_root.Model(), seen, paths);
+  return paths;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> MeshCache::CollisionMeshPaths(
+    const sdf::Model &_model)
+{
+  std::unordered_set<std::string> seen;
+  std::vector<std::string> paths;
+  addCollisionMeshPaths(_model, seen, paths);
+  return paths;
+}
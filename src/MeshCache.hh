@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_MESHCACHE_HH_
+#define GZ_SIM_MESHCACHE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sdf/Model.hh>
+#include <sdf/Root.hh>
+
+#include <gz/common/Mesh.hh>
+
+#include <gz/sim/Export.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class MeshCachePrivate;
+
+    /// \class MeshCache MeshCache.hh
+    /// \brief Process-wide cache of decoded meshes, addressed by the content
+    /// of their files, so that identical files under different paths, such
+    /// as the same Fuel model cached for several worlds, are decoded once.
+    ///
+    /// Files are hashed and decoded concurrently by Preload, each distinct
+    /// content once, and registered with common::MeshManager under the path
+    /// it was first found at, so everything that loads them through the
+    /// mesh manager finds them decoded. Formats that the mesh manager loads
+    /// with Assimp are loaded by the mesh manager instead. The cache
+    /// outlives servers, so resetting or creating a new server doesn't
+    /// decode the meshes again. The server preloads worlds with many
+    /// collision mesh files, and all worlds if
+    /// ServerConfig::SetPreloadMeshes is enabled.
+    class GZ_SIM_VISIBLE MeshCache
+    {
+      /// \brief Constructor
+      public: MeshCache();
+
+      /// \brief Destructor
+      public: ~MeshCache();
+
+      /// \brief Get the cache shared by the whole process.
+      /// \return The shared cache.
+      public: static MeshCache &Instance();
+
+      /// \brief Hash and decode the given mesh files concurrently, and
+      /// register each new content with common::MeshManager. Files that
+      /// were already loaded, or whose content matches a loaded file, aren't
+      /// decoded again. This must not be called while other threads use
+      /// common::MeshManager.
+      /// \param[in] _paths Absolute paths of the mesh files.
+      /// \return Number of files that were decoded.
+      public: std::size_t Preload(const std::vector<std::string> &_paths);
+
+      /// \brief Preload the collision meshes of all the worlds and models in
+      /// a root.
+      /// \param[in] _root Loaded root.
+      /// \param[in] _always True to preload them however many there are,
+      /// false to only preload roots with at least 16 distinct collision
+      /// mesh files. Hashing reads every file once more, which only pays off
+      /// when there are enough files to decode them concurrently.
+      /// \return Number of files that were decoded.
+      public: std::size_t Preload(const sdf::Root &_root,
+                  bool _always = true);
+
+      /// \brief Read, hash and decode the given mesh files on the calling
+      /// thread, without using common::MeshManager, so this can run on a
+      /// background thread while the simulation uses the mesh manager. The
+      /// new contents are registered by RegisterDecoded.
+      /// \param[in] _paths Absolute paths of the mesh files.
+      /// \return Number of new contents queued to be loaded.
+      public: std::size_t Decode(const std::vector<std::string> &_paths);
+
+      /// \brief Register the contents decoded by Decode with
+      /// common::MeshManager. Contents that are still being decoded are left
+      /// for the next call. This must not be called while other threads use
+      /// common::MeshManager.
+      /// \return Number of meshes that were registered.
+      public: std::size_t RegisterDecoded();
+
+      /// \brief Find a mesh that was decoded from the given path, or from
+      /// another file with the same content.
+      /// \param[in] _path Absolute path of the mesh file.
+      /// \return The mesh, owned by common::MeshManager, or nullptr if no
+      /// such file was preloaded.
+      public: const common::Mesh *Find(const std::string &_path) const;
+
+      /// \brief Get the hash of the content of a mesh file. It's looked up
+      /// for preloaded files, and computed by reading the file otherwise.
+      /// \param[in] _path Absolute path of the mesh file.
+      /// \return SHA-1 of the content, or an empty string if the file
+      /// couldn't be read.
+      public: std::string ContentHash(const std::string &_path) const;
+
+      /// \brief Get the paths of the mesh files used by the collisions of
+      /// all the worlds and models in a root, without repetitions. Meshes
+      /// referenced by name aren't included.
+      /// \param[in] _root Loaded root.
+      /// \return Absolute paths of the mesh files.
+      public: static std::vector<std::string> CollisionMeshPaths(
+                  const sdf::Root &_root);
+
+      /// \brief Get the paths of the mesh files used by the collisions of a
+      /// model and its nested models, without repetitions.
+      /// \param[in] _model The model.
+      /// \return Absolute paths of the mesh files.
+      public: static std::vector<std::string> CollisionMeshPaths(
+                  const sdf::Model &_model);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+#include <sdf/Root.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "MeshCache.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(MeshCache, GZ_UTILS_TEST_DISABLED_ON_WIN32(ContentAddressed))
+{
+  common::TempDirectory tempDir("mesh_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+
+  const std::string source = common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "media", "duck.dae");
+  const std::string first = common::joinPaths(tempDir.Path(), "first.dae");
+  const std::string second = common::joinPaths(tempDir.Path(), "second.dae");
+  ASSERT_TRUE(common::copyFile(source, first));
+  ASSERT_TRUE(common::copyFile(source, second));
+
+  MeshCache cache;
+  EXPECT_EQ(nullptr, cache.Find(first));
+
+  // Files with the same content are decoded once
+  EXPECT_EQ(1u, cache.Preload({first, second, first}));
+  const auto *mesh = cache.Find(first);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(mesh, cache.Find(second));
+  EXPECT_EQ(mesh, common::MeshManager::Instance()->MeshByName(first));
+  EXPECT_LT(0u, mesh->VertexCount());
+
+  // Preloading again doesn't decode anything
+  EXPECT_EQ(0u, cache.Preload({first, second}));
+  EXPECT_EQ(mesh, cache.Find(second));
+
+  // Missing and unsupported files are skipped
+  EXPECT_EQ(0u, cache.Preload({common::joinPaths(tempDir.Path(),
+      "missing.dae"), source + ".txt", ""}));
+}
+
+/////////////////////////////////////////////////
+TEST(MeshCache, GZ_UTILS_TEST_DISABLED_ON_WIN32(DecodeThenRegister))
+{
+  common::TempDirectory tempDir("mesh_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+
+  const std::string source = common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "media", "duck.dae");
+  const std::string path = common::joinPaths(tempDir.Path(), "decoded.dae");
+  ASSERT_TRUE(common::copyFile(source, path));
+
+  // Decoded meshes aren't in the mesh manager until they're registered
+  MeshCache cache;
+  EXPECT_EQ(1u, cache.Decode({path}));
+  EXPECT_EQ(nullptr, cache.Find(path));
+  EXPECT_FALSE(common::MeshManager::Instance()->HasMesh(path));
+
+  // Decoding again before registering doesn't queue anything
+  EXPECT_EQ(0u, cache.Decode({path}));
+
+  EXPECT_EQ(1u, cache.RegisterDecoded());
+  const auto *mesh = cache.Find(path);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(mesh, common::MeshManager::Instance()->MeshByName(path));
+  EXPECT_EQ(0u, cache.RegisterDecoded());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshCache, GZ_UTILS_TEST_DISABLED_ON_WIN32(PreloadRoot))
+{
+  common::TempDirectory tempDir("mesh_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+
+  const std::string source = common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "media", "duck.dae");
+  const std::string path = common::joinPaths(tempDir.Path(), "root.dae");
+  ASSERT_TRUE(common::copyFile(source, path));
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='default'>"
+      << "<model name='duck'><link name='link'>"
+      << "<collision name='mesh'><geometry><mesh><uri>" << path
+      << "</uri></mesh></geometry></collision>"
+      << "</link></model>"
+      << "</world></sdf>";
+
+  sdf::Root root;
+  auto errors = root.LoadSdfString(sdf.str());
+  ASSERT_TRUE(errors.empty()) << errors;
+
+  // Roots with few meshes are only preloaded on request
+  MeshCache cache;
+  EXPECT_EQ(0u, cache.Preload(root, false));
+  EXPECT_EQ(nullptr, cache.Find(path));
+
+  EXPECT_EQ(1u, cache.Preload(root, true));
+  EXPECT_NE(nullptr, cache.Find(path));
+}
+
+/////////////////////////////////////////////////
+TEST(MeshCache, CollisionMeshPaths)
+{
+  const std::string duck = common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "media", "duck.dae");
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='default'>"
+      << "<model name='outer'>"
+      << "<link name='link'>"
+      << "<collision name='mesh'><geometry><mesh><uri>" << duck
+      << "</uri></mesh></geometry></collision>"
+      << "<collision name='box'><geometry><box><size>1 1 1</size></box>"
+      << "</geometry></collision>"
+      << "<collision name='named'><geometry><mesh><uri>name://duck</uri>"
+      << "</mesh></geometry></collision>"
+      << "<visual name='visual'><geometry><mesh><uri>visual.dae</uri>"
+      << "</mesh></geometry></visual>"
+      << "</link>"
+      << "<model name='inner'><link name='link'>"
+      << "<collision name='mesh'><geometry><mesh><uri>" << duck
+      << "</uri></mesh></geometry></collision>"
+      << "</link></model>"
+      << "</model>"
+      << "</world></sdf>";
+
+  sdf::Root root;
+  auto errors = root.LoadSdfString(sdf.str());
+  ASSERT_TRUE(errors.empty()) << errors;
+
+  // Only collision meshes loaded from files, once each
+  auto paths = MeshCache::CollisionMeshPaths(root);
+  ASSERT_EQ(1u, paths.size());
+  EXPECT_EQ(duck, paths[0]);
+}
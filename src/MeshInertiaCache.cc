@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MeshInertiaCache.hh"
+#include "WorldCache.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/Uuid.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Pose3.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Version of the stored files. Bump it whenever the format or the
+/// way inertias are computed changes, so older results aren't reused.
+static const char kMeshInertiaCacheVersion[] = "gz-sim-mesh-inertia 1";
+
+/// \brief Private data for the MeshInertiaCache class.
+class gz::sim::MeshInertiaCachePrivate
+{
+  /// \brief Get the path of the file of a key.
+  /// \param[in] _key The key.
+  /// \return Path of the file.
+  public: std::string File(const std::string &_key) const
+  {
+    return common::joinPaths(this->directory, _key + ".txt");
+  }
+
+  /// \brief Directory where inertias are stored.
+  public: std::string directory;
+};
+
+//////////////////////////////////////////////////
+MeshInertiaCache::MeshInertiaCache(const std::string &_directory)
+  : dataPtr(std::make_unique<MeshInertiaCachePrivate>())
+{
+  this->dataPtr->directory = _directory;
+}
+
+//////////////////////////////////////////////////
+MeshInertiaCache::~MeshInertiaCache() = default;
+
+//////////////////////////////////////////////////
+std::string MeshInertiaCache::Directory(const ServerConfig &_config)
+{
+  const auto worldCache = WorldCache::Directory(_config);
+  if (worldCache.empty())
+    return std::string();
+  return common::joinPaths(worldCache, "mesh_inertia");
+}
+
+//////////////////////////////////////////////////
+const std::string &MeshInertiaCache::Directory() const
+{
+  return this->dataPtr->directory;
+}
+
+//////////////////////////////////////////////////
+std::string MeshInertiaCache::Key(const std::string &_contentHash,
+    const math::Vector3d &_scale, double _density) const
+{
+  if (this->dataPtr->directory.empty() || _contentHash.empty())
+    return std::string();
+
+  std::ostringstream stream;
+  stream << std::setprecision(std::numeric_limits<double>::max_digits10)
+         << kMeshInertiaCacheVersion << " " << _contentHash << " "
+         << _scale.X() << " " << _scale.Y() << " " << _scale.Z() << " "
+         << _density;
+  return common::sha1(stream.str());
+}
+
+//////////////////////////////////////////////////
+std::optional<math::Inertiald> MeshInertiaCache::Load(
+    const std::string &_key) const
+{
+  if (_key.empty())
+    return std::nullopt;
+
+  std::ifstream file(this->dataPtr->File(_key));
+  if (!file)
+    return std::nullopt;
+
+  std::string version;
+  std::getline(file, version);
+  if (version != kMeshInertiaCacheVersion)
+    return std::nullopt;
+
+  double mass, ixx, iyy, izz, ixy, ixz, iyz;
+  double x, y, z, qw, qx, qy, qz;
+  if (!(file >> mass >> ixx >> iyy >> izz >> ixy >> ixz >> iyz
+             >> x >> y >> z >> qw >> qx >> qy >> qz))
+  {
+    gzwarn << "Ignoring invalid mesh inertia ["
+           << this->dataPtr->File(_key) << "]." << std::endl;
+    return std::nullopt;
+  }
+
+  math::Inertiald inertial;
+  if (!inertial.SetMassMatrix(math::MassMatrix3d(mass,
+      math::Vector3d(ixx, iyy, izz), math::Vector3d(ixy, ixz, iyz))))
+  {
+    return std::nullopt;
+  }
+  inertial.SetPose(math::Pose3d(math::Vector3d(x, y, z),
+      math::Quaterniond(qw, qx, qy, qz)));
+  return inertial;
+}
+
+//////////////////////////////////////////////////
+bool MeshInertiaCache::Save(const std::string &_key,
+    const math::Inertiald &_inertial) const
+{
+  if (_key.empty())
+    return false;
+
+  if (!common::isDirectory(this->dataPtr->directory) &&
+      !common::createDirectories(this->dataPtr->directory))
+  {
+    gzwarn << "Failed to create mesh inertia cache ["
+           << this->dataPtr->directory << "]." << std::endl;
+    return false;
+  }
+
+  // Write to a unique file and move it in place, so readers never see a
+  // partially written file
+  const auto path = this->dataPtr->File(_key);
+  const auto tmpPath = path + "." + common::Uuid().String() + ".tmp";
+  {
+    std::ofstream file(tmpPath);
+    if (!file)
+      return false;
+
+    const auto &massMatrix = _inertial.MassMatrix();
+    const auto &pose = _inertial.Pose();
+    file << std::setprecision(std::numeric_limits<double>::max_digits10)
+         << kMeshInertiaCacheVersion << "\n"
+         << massMatrix.Mass() << " "
+         << massMatrix.DiagonalMoments().X() << " "
+         << massMatrix.DiagonalMoments().Y() << " "
+         << massMatrix.DiagonalMoments().Z() << " "
+         << massMatrix.OffDiagonalMoments().X() << " "
+         << massMatrix.OffDiagonalMoments().Y() << " "
+         << massMatrix.OffDiagonalMoments().Z() << "\n"
+         << pose.Pos().X() << " " << pose.Pos().Y() << " " << pose.Pos().Z()
+         << " " << pose.Rot().W() << " " << pose.Rot().X() << " "
+         << pose.Rot().Y() << " " << pose.Rot().Z() << "\n";
+    if (!file)
+    {
+      file.close();
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  // Another process may have stored the same inertia in the meantime
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+  {
+    std::remove(tmpPath.c_str());
+    return common::exists(path);
+  }
+  return true;
+}
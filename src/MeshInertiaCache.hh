@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_MESHINERTIACACHE_HH_
+#define GZ_SIM_MESHINERTIACACHE_HH_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gz/math/Inertial.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/Export.hh>
+#include <gz/sim/ServerConfig.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class MeshInertiaCachePrivate;
+
+    /// \class MeshInertiaCache MeshInertiaCache.hh
+    /// \brief Cache of mesh inertias stored on disk, so they're computed
+    /// once per mesh instead of on every run.
+    ///
+    /// Each inertia is stored in its own file, named after a key derived
+    /// from the content of the mesh file, its scale and its density, so
+    /// editing a mesh or its properties never reuses stale results. Files
+    /// are written atomically, so several processes can share a directory.
+    class GZ_SIM_VISIBLE MeshInertiaCache
+    {
+      /// \brief Constructor
+      /// \param[in] _directory Directory where inertias are stored. It's
+      /// created when the first inertia is saved. An empty directory
+      /// disables the cache.
+      public: explicit MeshInertiaCache(const std::string &_directory);
+
+      /// \brief Destructor
+      public: ~MeshInertiaCache();
+
+      /// \brief Get the directory of the cache used by a server. Inertias
+      /// are stored next to the worlds of the world cache, so the cache is
+      /// disabled unless the world cache is enabled.
+      /// \param[in] _config Configuration of the server.
+      /// \return The mesh_inertia subdirectory of WorldCache::Directory, or
+      /// an empty string if the world cache is disabled.
+      public: static std::string Directory(const ServerConfig &_config);
+
+      /// \brief Get the directory where inertias are stored.
+      /// \return The directory, empty if the cache is disabled.
+      public: const std::string &Directory() const;
+
+      /// \brief Get the key of the inertia of a mesh.
+      /// \param[in] _contentHash Hash of the content of the mesh file.
+      /// \param[in] _scale Scale of the mesh.
+      /// \param[in] _density Density of the mesh.
+      /// \return The key, or an empty string if the cache is disabled or the
+      /// hash is empty.
+      public: std::string Key(const std::string &_contentHash,
+                  const math::Vector3d &_scale, double _density) const;
+
+      /// \brief Load a stored inertia.
+      /// \param[in] _key Key of the inertia.
+      /// \return The inertia, or nullopt if it isn't stored or its file is
+      /// invalid.
+      public: std::optional<math::Inertiald> Load(
+                  const std::string &_key) const;
+
+      /// \brief Store an inertia.
+      /// \param[in] _key Key of the inertia.
+      /// \param[in] _inertial The inertia.
+      /// \return True if it was stored.
+      public: bool Save(const std::string &_key,
+                  const math::Inertiald &_inertial) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshInertiaCachePrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Pose3.hh>
+
+#include "MeshInertiaCache.hh"
+#include "WorldCache.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(MeshInertiaCache, Directory)
+{
+  // The cache is disabled unless the world cache is enabled
+  common::unsetenv(kWorldCachePathEnv);
+  ServerConfig config;
+  EXPECT_TRUE(MeshInertiaCache::Directory(config).empty());
+
+  common::setenv(kWorldCachePathEnv, "env_dir");
+  EXPECT_EQ(common::joinPaths("env_dir", "mesh_inertia"),
+      MeshInertiaCache::Directory(config));
+
+  config.SetWorldCache("config_dir");
+  EXPECT_EQ(common::joinPaths("config_dir", "mesh_inertia"),
+      MeshInertiaCache::Directory(config));
+  common::unsetenv(kWorldCachePathEnv);
+}
+
+/////////////////////////////////////////////////
+TEST(MeshInertiaCache, Key)
+{
+  MeshInertiaCache cache("cache_dir");
+  const math::Vector3d scale(1, 2, 3);
+
+  const auto key = cache.Key("abc", scale, 1000.0);
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(key, cache.Key("abc", scale, 1000.0));
+
+  // Any change of content, scale or density changes the key
+  EXPECT_NE(key, cache.Key("abd", scale, 1000.0));
+  EXPECT_NE(key, cache.Key("abc", math::Vector3d(1, 2, 3.000001), 1000.0));
+  EXPECT_NE(key, cache.Key("abc", scale, 999.0));
+
+  // Unknown content and disabled caches have no keys
+  EXPECT_TRUE(cache.Key("", scale, 1000.0).empty());
+  EXPECT_TRUE(MeshInertiaCache("").Key("abc", scale, 1000.0).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshInertiaCache, SaveLoad)
+{
+  common::TempDirectory tempDir("mesh_inertia_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+
+  // The directory is created on demand
+  const auto directory = common::joinPaths(tempDir.Path(), "a", "b");
+  MeshInertiaCache cache(directory);
+  const auto key = cache.Key("abc", math::Vector3d::One, 1000.0);
+  EXPECT_FALSE(cache.Load(key).has_value());
+
+  math::Inertiald inertial;
+  ASSERT_TRUE(inertial.SetMassMatrix(math::MassMatrix3d(2.5,
+      math::Vector3d(0.1, 0.2, 0.3), math::Vector3d(0.01, 0.02, 0.03))));
+  inertial.SetPose(math::Pose3d(1.0 / 3.0, -2, 1e-9, 0, 0, 0));
+  EXPECT_TRUE(cache.Save(key, inertial));
+  EXPECT_TRUE(common::isDirectory(directory));
+
+  // Values are stored exactly
+  auto loaded = cache.Load(key);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(inertial, *loaded);
+
+  // Another instance using the same directory sees it too
+  loaded = MeshInertiaCache(directory).Load(key);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(inertial, *loaded);
+
+  // Other keys aren't found
+  EXPECT_FALSE(cache.Load(cache.Key("abc", math::Vector3d::One, 1.0)));
+  EXPECT_FALSE(cache.Load(""));
+  EXPECT_FALSE(cache.Save("", inertial));
+}
+
+/////////////////////////////////////////////////
+TEST(MeshInertiaCache, InvalidFiles)
+{
+  common::TempDirectory tempDir("mesh_inertia_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+
+  MeshInertiaCache cache(tempDir.Path());
+  const auto key = cache.Key("abc", math::Vector3d::One, 1000.0);
+  const auto file = common::joinPaths(tempDir.Path(), key + ".txt");
+
+  // Truncated file
+  {
+    std::ofstream stream(file);
+    stream << "gz-sim-mesh-inertia 1\n2.5 0.1 0.2\n";
+  }
+  EXPECT_FALSE(cache.Load(key).has_value());
+
+  // Other version
+  {
+    std::ofstream stream(file);
+    stream << "gz-sim-mesh-inertia 0\n"
+           << "1 1 1 1 0 0 0\n0 0 0 1 0 0 0\n";
+  }
+  EXPECT_FALSE(cache.Load(key).has_value());
+
+  // Invalid mass matrix
+  {
+    std::ofstream stream(file);
+    stream << "gz-sim-mesh-inertia 1\n"
+           << "-1 1 1 1 0 0 0\n0 0 0 1 0 0 0\n";
+  }
+  EXPECT_FALSE(cache.Load(key).has_value());
+}
@@ -17,7 +17,11 @@
 
 #include "MeshInertiaCalculator.hh"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include <sdf/CustomInertiaCalcProperties.hh>
@@ -28,6 +32,7 @@
 #include <gz/common/graphics.hh>
 #include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
+#include <gz/common/Profiler.hh>
 
 #include <gz/math/Vector3.hh>
 #include <gz/math/Pose3.hh>
@@ -35,9 +40,195 @@
 #include <gz/math/Inertial.hh>
 #include <gz/math/Quaternion.hh>
 
+#include "MeshCache.hh"
+#include "MeshInertiaCache.hh"
+#include "ThreadPool.hh"
+
 using namespace gz;
 using namespace sim;
 
+namespace
+{
+/// \brief Number of integral terms accumulated over the triangles.
+constexpr std::size_t kIntegralCount{10};
+
+/// \brief Integral terms accumulated over the triangles of a mesh.
+using Integrals = std::array<double, kIntegralCount>;
+
+/// \brief Number of triangles whose integral terms are accumulated side by
+/// side in separate sums, so that several triangles are processed at once.
+constexpr std::size_t kLanes{4};
+
+/// \brief Number of triangles integrated by each task of the thread pool.
+/// The chunks don't depend on the number of threads, which keeps the
+/// result reproducible.
+constexpr std::size_t kTrianglesPerChunk{16384};
+
+//////////////////////////////////////////////////
+/// \brief Calculate the subexpressions of the integral for one coordinate
+/// of a triangle.
+/// \param[in] _w0 Coordinate of the first vertex.
+/// \param[in] _w1 Coordinate of the second vertex.
+/// \param[in] _w2 Coordinate of the third vertex.
+/// \param[out] _f1 First order subexpression.
+/// \param[out] _f2 Second order subexpression.
+/// \param[out] _f3 Third order subexpression.
+/// \param[out] _g0 Subexpression of the first vertex.
+/// \param[out] _g1 Subexpression of the second vertex.
+/// \param[out] _g2 Subexpression of the third vertex.
+inline void subexpressions(const double _w0, const double _w1,
+    const double _w2, double &_f1, double &_f2, double &_f3, double &_g0,
+    double &_g1, double &_g2)
+{
+  _f1 = _w0 + _w1 + _w2;
+  _f2 = _w0 * _w0 + _w1 * _w1 + _w0 * _w1 + _w2 * _f1;
+  _f3 = _w0 * _w0 * _w0 + _w0 * _w0 * _w1 + _w0 * _w1 * _w1 +
+        _w1 * _w1 * _w1 + _w2 * _f2;
+  _g0 = _f2 + (_w0 + _f1) * _w0;
+  _g1 = _f2 + (_w1 + _f1) * _w1;
+  _g2 = _f2 + (_w2 + _f1) * _w2;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the integral terms of one triangle to the sums of a lane.
+/// \param[in] _t Triangles of the mesh.
+/// \param[in] _j Index of the triangle.
+/// \param[in] _l Lane whose sums are updated.
+/// \param[in,out] _sums Sums of each term per lane.
+inline void accumulate(const TriangleArrays &_t, const std::size_t _j,
+    const std::size_t _l, double (&_sums)[kIntegralCount][kLanes])
+{
+  const double x0 = _t.x0[_j];
+  const double y0 = _t.y0[_j];
+  const double z0 = _t.z0[_j];
+  const double x1 = _t.x1[_j];
+  const double y1 = _t.y1[_j];
+  const double z1 = _t.z1[_j];
+  const double x2 = _t.x2[_j];
+  const double y2 = _t.y2[_j];
+  const double z2 = _t.z2[_j];
+
+  // Cross product of 2 vectors emerging from a common vertex
+  const double ax = x1 - x0;
+  const double ay = y1 - y0;
+  const double az = z1 - z0;
+  const double bx = x2 - x0;
+  const double by = y2 - y0;
+  const double bz = z2 - z0;
+  const double crossX = ay * bz - az * by;
+  const double crossY = az * bx - ax * bz;
+  const double crossZ = ax * by - ay * bx;
+
+  double f1x, f2x, f3x, g0x, g1x, g2x;
+  double f1y, f2y, f3y, g0y, g1y, g2y;
+  double f1z, f2z, f3z, g0z, g1z, g2z;
+  subexpressions(x0, x1, x2, f1x, f2x, f3x, g0x, g1x, g2x);
+  subexpressions(y0, y1, y2, f1y, f2y, f3y, g0y, g1y, g2y);
+  subexpressions(z0, z1, z2, f1z, f2z, f3z, g0z, g1z, g2z);
+
+  _sums[0][_l] += crossX * f1x;
+  _sums[1][_l] += crossX * f2x;
+  _sums[2][_l] += crossY * f2y;
+  _sums[3][_l] += crossZ * f2z;
+  _sums[4][_l] += crossX * f3x;
+  _sums[5][_l] += crossY * f3y;
+  _sums[6][_l] += crossZ * f3z;
+  _sums[7][_l] += crossX * (y0 * g0x + y1 * g1x + y2 * g2x);
+  _sums[8][_l] += crossY * (z0 * g0y + z1 * g1y + z2 * g2y);
+  _sums[9][_l] += crossZ * (x0 * g0z + x1 * g1z + x2 * g2z);
+}
+
+//////////////////////////////////////////////////
+/// \brief Accumulate the integral terms of a range of triangles.
+/// \param[in] _t Triangles of the mesh.
+/// \param[in] _begin Index of the first triangle.
+/// \param[in] _end Index past the last triangle.
+/// \return Integral terms of the triangles, not multiplied by the
+/// coefficients yet.
+Integrals integrate(const TriangleArrays &_t, const std::size_t _begin,
+    const std::size_t _end)
+{
+  // One sum per lane for each term. Lanes are independent, so the compiler
+  // can process them with vector instructions.
+  double sums[kIntegralCount][kLanes] = {};
+
+  // Full blocks have a constant number of lanes, so the compiler can unroll
+  // and vectorize them. The remaining triangles go to the first lanes.
+  const std::size_t fullEnd = _begin + (_end - _begin) / kLanes * kLanes;
+  std::size_t i = _begin;
+  for (; i < fullEnd; i += kLanes)
+  {
+    for (std::size_t l = 0; l < kLanes; ++l)
+      accumulate(_t, i + l, l, sums);
+  }
+  for (std::size_t l = 0; i + l < _end; ++l)
+    accumulate(_t, i + l, l, sums);
+
+  Integrals integral{};
+  for (std::size_t k = 0; k < kIntegralCount; ++k)
+  {
+    for (std::size_t l = 0; l < kLanes; ++l)
+      integral[k] += sums[k][l];
+  }
+  return integral;
+}
+
+//////////////////////////////////////////////////
+/// \brief Calculate the mass properties of a mesh from its integral terms.
+/// \param[in] _integral Integral terms, not multiplied by the coefficients
+/// yet.
+/// \param[in] _density Density of the mesh.
+/// \param[out] _massMatrix Mass and moments of inertia of the mesh.
+/// \param[out] _centreOfMass Centre of mass of the mesh.
+void massProperties(Integrals _integral, const double _density,
+    gz::math::MassMatrix3d &_massMatrix, gz::math::Pose3d &_centreOfMass)
+{
+  // Some coefficients for the calculation of integral terms
+  const double coefficients[kIntegralCount] = {1.0 / 6,   1.0 / 24, 1.0 / 24,
+                                               1.0 / 24,  1.0 / 60, 1.0 / 60,
+                                               1.0 / 60,  1.0 / 120,
+                                               1.0 / 120, 1.0 / 120};
+
+  for (std::size_t i = 0; i < kIntegralCount; ++i)
+  {
+      _integral[i] *= coefficients[i];
+  }
+
+  // Accumulate the result and add it to MassMatrix object of gz::math
+  double volume = _integral[0];
+  double mass = volume * _density;
+  _centreOfMass.SetX(_integral[1] / volume);
+  _centreOfMass.SetY(_integral[2] / volume);
+  _centreOfMass.SetZ(_integral[3] / volume);
+  gz::math::Vector3d ixxyyzz = gz::math::Vector3d();
+  gz::math::Vector3d ixyxzyz = gz::math::Vector3d();
+
+  // Diagonal Elements of the Mass Matrix
+  ixxyyzz.X() = (_integral[5] + _integral[6] - volume *
+                (_centreOfMass.Y() * _centreOfMass.Y() +
+                _centreOfMass.Z() * _centreOfMass.Z()));
+  ixxyyzz.Y() = (_integral[4] + _integral[6] - volume *
+                (_centreOfMass.Z() * _centreOfMass.Z() +
+                _centreOfMass.X() * _centreOfMass.X()));
+  ixxyyzz.Z() = _integral[4] + _integral[5] - volume *
+                (_centreOfMass.X() * _centreOfMass.X() +
+                _centreOfMass.Y() * _centreOfMass.Y());
+
+  // Off Diagonal Elements of the Mass Matrix
+  ixyxzyz.X() =
+      -(_integral[7] - volume * _centreOfMass.X() * _centreOfMass.Y());
+  ixyxzyz.Y() =
+      -(_integral[9] - volume * _centreOfMass.X() * _centreOfMass.Z());
+  ixyxzyz.Z() =
+      -(_integral[8] - volume * _centreOfMass.Y() * _centreOfMass.Z());
+
+  // Set the values in the MassMatrix object
+  _massMatrix.SetMass(mass);
+  _massMatrix.SetDiagonalMoments(ixxyyzz * _density);
+  _massMatrix.SetOffDiagonalMoments(ixyxzyz * _density);
+}
+}
+
 //////////////////////////////////////////////////
 void MeshInertiaCalculator::GetMeshTriangles(
   std::vector<Triangle> &_triangles,
@@ -71,6 +262,38 @@ void MeshInertiaCalculator::GetMeshTriangles(
     triangle.centroid = (triangle.v0 + triangle.v1 + triangle.v2) / 3;
     _triangles.push_back(triangle);
   }
+
+  delete [] vertArray;
+  delete [] indArray;
+}
+
+//////////////////////////////////////////////////
+void MeshInertiaCalculator::GetMeshTriangles(
+  TriangleArrays &_triangles,
+  const gz::math::Vector3d &_meshScale,
+  const gz::common::Mesh* _mesh)
+{
+  // Get the vertices & indices of the mesh
+  double* vertArray = nullptr;
+  int* indArray = nullptr;
+  _mesh->FillArrays(&vertArray, &indArray);
+
+  auto vertex = [&](unsigned int _index)
+  {
+    const auto offset = static_cast<ptrdiff_t>(3 * indArray[_index]);
+    return gz::math::Vector3d(vertArray[offset], vertArray[offset + 1],
+        vertArray[offset + 2]) * _meshScale;
+  };
+
+  // Ignore trailing indices that don't form a whole triangle
+  const unsigned int indexCount =
+      _mesh->IndexCount() - _mesh->IndexCount() % 3;
+  _triangles.Reserve(_triangles.Size() + indexCount / 3);
+  for (unsigned int i = 0; i < indexCount; i += 3)
+    _triangles.Add(vertex(i), vertex(i + 1), vertex(i + 2));
+
+  delete [] vertArray;
+  delete [] indArray;
 }
 
 //////////////////////////////////////////////////
@@ -80,11 +303,6 @@ void MeshInertiaCalculator::CalculateMassProperties(
   gz::math::MassMatrix3d& _massMatrix,
   gz::math::Pose3d& _centreOfMass)
 {
-  // Some coefficients for the calculation of integral terms
-  const double coefficients[10] = {1.0 / 6,   1.0 / 24, 1.0 / 24, 1.0 / 24,
-                                   1.0 / 60,  1.0 / 60, 1.0 / 60, 1.0 / 120,
-                                   1.0 / 120, 1.0 / 120};
-
   // Number of triangles of in the mesh
   std::size_t numTriangles = _triangles.size();
 
@@ -122,7 +340,7 @@ void MeshInertiaCalculator::CalculateMassProperties(
   }
 
   // Calculate integral terms
-  std::vector<double> integral(10);
+  Integrals integral{};
   for (std::size_t i = 0; i < numTriangles; ++i)
   {
       double x0 = _triangles[i].v0.X();
@@ -149,40 +367,54 @@ void MeshInertiaCalculator::CalculateMassProperties(
         (x0 * g0[i].Z() + x1 * g1[i].Z() + x2 * g2[i].Z());
   }
 
-  for (int i = 0; i < 10; ++i)
-  {
-      integral[i] *= coefficients[i];
-  }
+  massProperties(integral, _density, _massMatrix, _centreOfMass);
+}
 
-  // Accumulate the result and add it to MassMatrix object of gz::math
-  double volume = integral[0];
-  double mass = volume * _density;
-  _centreOfMass.SetX(integral[1] / volume);
-  _centreOfMass.SetY(integral[2] / volume);
-  _centreOfMass.SetZ(integral[3] / volume);
-  gz::math::Vector3d ixxyyzz = gz::math::Vector3d();
-  gz::math::Vector3d ixyxzyz = gz::math::Vector3d();
+//////////////////////////////////////////////////
+void MeshInertiaCalculator::CalculateMassProperties(
+  const TriangleArrays &_triangles,
+  double _density,
+  gz::math::MassMatrix3d &_massMatrix,
+  gz::math::Pose3d &_centreOfMass)
+{
+  GZ_PROFILE("MeshInertiaCalculator::CalculateMassProperties");
 
-  // Diagonal Elements of the Mass Matrix
-  ixxyyzz.X() = (integral[5] + integral[6] - volume *
-                (_centreOfMass.Y() * _centreOfMass.Y() +
-                _centreOfMass.Z() * _centreOfMass.Z()));
-  ixxyyzz.Y() = (integral[4] + integral[6] - volume *
-                (_centreOfMass.Z() * _centreOfMass.Z() +
-                _centreOfMass.X() * _centreOfMass.X()));
-  ixxyyzz.Z() = integral[4] + integral[5] - volume *
-                (_centreOfMass.X() * _centreOfMass.X() +
-                _centreOfMass.Y() * _centreOfMass.Y());
+  const std::size_t numTriangles = _triangles.Size();
+  const std::size_t numChunks =
+      (numTriangles + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
 
-  // Off Diagonal Elements of the Mass Matrix
-  ixyxzyz.X() = -(integral[7] - volume * _centreOfMass.X() * _centreOfMass.Y());
-  ixyxzyz.Y() = -(integral[9] - volume * _centreOfMass.X() * _centreOfMass.Z());
-  ixyxzyz.Z() = -(integral[8] - volume * _centreOfMass.Y() * _centreOfMass.Z());
+  std::vector<Integrals> partials(numChunks);
+  auto integrateChunks = [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t c = _begin; c < _end; ++c)
+    {
+      const std::size_t first = c * kTrianglesPerChunk;
+      partials[c] = integrate(_triangles, first,
+          std::min(first + kTrianglesPerChunk, numTriangles));
+    }
+  };
+
+  if (numChunks > 1)
+    ThreadPool::Shared().ParallelFor(numChunks, 1, integrateChunks);
+  else
+    integrateChunks(0, numChunks);
 
-  // Set the values in the MassMatrix object
-  _massMatrix.SetMass(mass);
-  _massMatrix.SetDiagonalMoments(ixxyyzz * _density);
-  _massMatrix.SetOffDiagonalMoments(ixyxzyz * _density);
+  // Combine the partial sums in a fixed order
+  Integrals integral{};
+  for (const auto &partial : partials)
+  {
+    for (std::size_t k = 0; k < kIntegralCount; ++k)
+      integral[k] += partial[k];
+  }
+
+  massProperties(integral, _density, _massMatrix, _centreOfMass);
+}
+
+//////////////////////////////////////////////////
+MeshInertiaCalculator::MeshInertiaCalculator(
+    const std::string &_cacheDirectory)
+  : cacheDirectory(_cacheDirectory)
+{
 }
 
 //////////////////////////////////////////////////
@@ -215,15 +447,33 @@ std::optional<gz::math::Inertiald> MeshInertiaCalculator::operator()
     return std::nullopt;
   }
 
+  // Reuse the inertia computed by an earlier run for the same mesh content,
+  // scale and density. The content is only hashed if the cache is enabled,
+  // since that may read the whole file.
+  const MeshInertiaCache inertiaCache(this->cacheDirectory);
+  std::string cacheKey;
+  if (!inertiaCache.Directory().empty())
+  {
+    cacheKey = inertiaCache.Key(MeshCache::Instance().ContentHash(fullPath),
+        sdfMesh->Scale(), density);
+  }
+  if (auto cachedInertial = inertiaCache.Load(cacheKey))
+    return cachedInertial;
+
   // Load the Mesh
-  gz::common::MeshManager *meshManager = gz::common::MeshManager::Instance();
-  mesh = meshManager->Load(fullPath);
+  mesh = MeshCache::Instance().Find(fullPath);
+  if (!mesh)
+  {
+    gz::common::MeshManager *meshManager =
+        gz::common::MeshManager::Instance();
+    mesh = meshManager->Load(fullPath);
+  }
   if (!mesh)
   {
     gzerr << "Failed to load mesh: " << fullPath << std::endl;
     return std::nullopt;
   }
-  std::vector<Triangle> meshTriangles;
+  TriangleArrays meshTriangles;
   gz::math::MassMatrix3d meshMassMatrix;
   gz::math::Pose3d centreOfMass;
 
@@ -243,6 +493,7 @@ std::optional<gz::math::Inertiald> MeshInertiaCalculator::operator()
   else
   {
     meshInertial.SetPose(centreOfMass);
+    inertiaCache.Save(cacheKey, meshInertial);
     return meshInertial;
   }
 }
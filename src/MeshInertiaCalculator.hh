@@ -18,7 +18,10 @@
 #ifndef GZ_SIM_MESHINERTIACALCULATOR_HH_
 #define GZ_SIM_MESHINERTIACALCULATOR_HH_
 
+#include <cstddef>
+#include <initializer_list>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include <sdf/CustomInertiaCalcProperties.hh>
@@ -58,6 +61,64 @@ namespace gz
         gz::math::Vector3d centroid;
       };
 
+      /// \struct TriangleArrays gz/sim/MeshInertiaCalculator.hh
+      /// \brief The triangles of a mesh stored as a structure of arrays,
+      /// with one array per vertex coordinate, so that the same coordinate
+      /// of consecutive triangles is contiguous in memory. This lets the
+      /// integration over the triangles process several of them at once.
+      struct TriangleArrays
+      {
+        /// \brief Remove all triangles.
+        public: void Clear()
+        {
+          for (auto &coords : {&x0, &y0, &z0, &x1, &y1, &z1, &x2, &y2, &z2})
+            coords->clear();
+        }
+
+        /// \brief Reserve storage for a number of triangles.
+        /// \param[in] _count Number of triangles.
+        public: void Reserve(std::size_t _count)
+        {
+          for (auto &coords : {&x0, &y0, &z0, &x1, &y1, &z1, &x2, &y2, &z2})
+            coords->reserve(_count);
+        }
+
+        /// \brief Add a triangle.
+        /// \param[in] _v0 First vertex.
+        /// \param[in] _v1 Second vertex.
+        /// \param[in] _v2 Third vertex.
+        public: void Add(const gz::math::Vector3d &_v0,
+                    const gz::math::Vector3d &_v1,
+                    const gz::math::Vector3d &_v2)
+        {
+          x0.push_back(_v0.X());
+          y0.push_back(_v0.Y());
+          z0.push_back(_v0.Z());
+          x1.push_back(_v1.X());
+          y1.push_back(_v1.Y());
+          z1.push_back(_v1.Z());
+          x2.push_back(_v2.X());
+          y2.push_back(_v2.Y());
+          z2.push_back(_v2.Z());
+        }
+
+        /// \brief Get the number of triangles.
+        /// \return Number of triangles.
+        public: std::size_t Size() const
+        {
+          return x0.size();
+        }
+
+        /// \brief Coordinates of the first vertex of each triangle.
+        public: std::vector<double> x0, y0, z0;
+
+        /// \brief Coordinates of the second vertex of each triangle.
+        public: std::vector<double> x1, y1, z1;
+
+        /// \brief Coordinates of the third vertex of each triangle.
+        public: std::vector<double> x2, y2, z2;
+      };
+
       /// \class MeshInertiaCalculator gz/sim/MeshInertiaCalculator.hh
       /// \brief Inertial Properties (Mass, Centre of Mass & Moments of
       /// Inertia) calculator for 3D meshes.
@@ -70,11 +131,18 @@ namespace gz
       /// The calculation method used in this class is described here:
       /// https://www.geometrictools.com/Documentation/PolyhedralMassProperties.pdf
       /// and it works on triangle water-tight meshes for simple polyhedron
-      class MeshInertiaCalculator
+      class GZ_SIM_VISIBLE MeshInertiaCalculator
       {
         /// \brief Constructor
         public: MeshInertiaCalculator() = default;
 
+        /// \brief Constructor
+        /// \param[in] _cacheDirectory Directory where computed inertias are
+        /// stored and reused from, see MeshInertiaCache. An empty directory
+        /// disables the cache.
+        public: explicit MeshInertiaCalculator(
+          const std::string &_cacheDirectory);
+
         /// \brief Function to get the vertices & indices of the given mesh
         /// & convert them into instances of the Triangle struct
         /// Each triangle represents a triangle in the mesh & is added
@@ -90,6 +158,19 @@ namespace gz
           const gz::math::Vector3d &_meshScale,
           const gz::common::Mesh* _mesh);
 
+        /// \brief Function to get the triangles of the given mesh as a
+        /// structure of arrays, which is the layout used by the overload of
+        /// CalculateMassProperties that processes several triangles at once.
+        /// \param[out] _triangles Triangles of the mesh. Triangles are
+        /// appended to the existing ones.
+        /// \param[in] _meshScale A vector with the scaling factor
+        /// of all the 3 axes
+        /// \param[in] _mesh Mesh object
+        public: void GetMeshTriangles(
+          TriangleArrays &_triangles,
+          const gz::math::Vector3d &_meshScale,
+          const gz::common::Mesh* _mesh);
+
         /// \brief Function that calculates the mass, mass matrix & centre of
         /// mass of a mesh using a vector of Triangles of the mesh
         /// \param[in] _triangles A vector of all the Triangles of the mesh
@@ -104,6 +185,26 @@ namespace gz
           gz::math::MassMatrix3d& _massMatrix,
           gz::math::Pose3d& _inertiaOrigin);
 
+        /// \brief Function that calculates the mass, mass matrix & centre of
+        /// mass of a mesh from its triangles stored as a structure of arrays.
+        /// The integral terms are accumulated over several triangles at once,
+        /// in a loop the compiler can vectorize, and large meshes are split
+        /// into fixed size chunks that are integrated concurrently. Partial
+        /// sums are combined in chunk order, so the result doesn't depend on
+        /// the number of threads, and matches the result of the overload that
+        /// takes a vector of Triangles up to rounding.
+        /// \param[in] _triangles Triangles of the mesh
+        /// \param[in] _density Density of the mesh
+        /// \param[out] _massMatrix MassMatrix object to hold mass &
+        /// moment of inertia of the mesh
+        /// \param[out] _inertiaOrigin Pose3d object to hold the origin about
+        /// which the inertia tensor was calculated
+        public: void CalculateMassProperties(
+          const TriangleArrays &_triangles,
+          double _density,
+          gz::math::MassMatrix3d& _massMatrix,
+          gz::math::Pose3d& _inertiaOrigin);
+
         /// \brief Overloaded () operator which allows an instance
         /// of this class to be registered as a Custom Inertia
         /// Calculator with libsdformat
@@ -116,6 +217,9 @@ namespace gz
         public: std::optional<gz::math::Inertiald> operator()(
           sdf::Errors& _errors,
           const sdf::CustomInertiaCalcProperties& _calculatorParams);
+
+        /// \brief Directory of the inertia cache, empty if it's disabled
+        private: std::string cacheDirectory;
       };
     }
   }
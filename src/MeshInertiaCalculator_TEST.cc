@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gz/common/MeshManager.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "MeshInertiaCalculator.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+/// \brief Create the triangles of a sphere, in both layouts.
+/// \param[in] _center Center of the sphere.
+/// \param[in] _segments Number of segments along each angle.
+/// \param[out] _triangles Triangles as a vector of structs.
+/// \param[out] _arrays Triangles as a structure of arrays.
+void sphereTriangles(const math::Vector3d &_center, int _segments,
+    std::vector<Triangle> &_triangles, TriangleArrays &_arrays)
+{
+  auto vertex = [&](int _i, int _j)
+  {
+    const double theta = GZ_PI * _i / _segments;
+    const double phi = 2 * GZ_PI * _j / _segments;
+    return _center + math::Vector3d(std::sin(theta) * std::cos(phi),
+        std::sin(theta) * std::sin(phi), std::cos(theta));
+  };
+
+  auto add = [&](const math::Vector3d &_v0, const math::Vector3d &_v1,
+      const math::Vector3d &_v2)
+  {
+    _triangles.push_back({_v0, _v1, _v2, (_v0 + _v1 + _v2) / 3});
+    _arrays.Add(_v0, _v1, _v2);
+  };
+
+  for (int i = 0; i < _segments; ++i)
+  {
+    for (int j = 0; j < _segments; ++j)
+    {
+      add(vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1));
+      add(vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshInertiaCalculator, TriangleArraysMatchTriangles)
+{
+  // Enough triangles to be integrated in several chunks
+  std::vector<Triangle> triangles;
+  TriangleArrays arrays;
+  const math::Vector3d center(1, 2, 3);
+  sphereTriangles(center, 200, triangles, arrays);
+  ASSERT_EQ(triangles.size(), arrays.Size());
+
+  MeshInertiaCalculator calculator;
+  const double density = 1000.0;
+
+  math::MassMatrix3d expectedMassMatrix;
+  math::Pose3d expectedCenter;
+  calculator.CalculateMassProperties(triangles, density,
+      expectedMassMatrix, expectedCenter);
+
+  math::MassMatrix3d massMatrix;
+  math::Pose3d centerOfMass;
+  calculator.CalculateMassProperties(arrays, density, massMatrix,
+      centerOfMass);
+
+  const double mass = expectedMassMatrix.Mass();
+  EXPECT_NEAR(mass, massMatrix.Mass(), 1e-9 * mass);
+  EXPECT_NEAR(expectedCenter.Pos().X(), centerOfMass.Pos().X(), 1e-9);
+  EXPECT_NEAR(expectedCenter.Pos().Y(), centerOfMass.Pos().Y(), 1e-9);
+  EXPECT_NEAR(expectedCenter.Pos().Z(), centerOfMass.Pos().Z(), 1e-9);
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(expectedMassMatrix.DiagonalMoments()[i],
+        massMatrix.DiagonalMoments()[i], 1e-9 * mass);
+    EXPECT_NEAR(expectedMassMatrix.OffDiagonalMoments()[i],
+        massMatrix.OffDiagonalMoments()[i], 1e-9 * mass);
+  }
+
+  // Close to a solid unit sphere
+  const double sphereMass = density * 4.0 / 3.0 * GZ_PI;
+  EXPECT_NEAR(sphereMass, massMatrix.Mass(), 1e-3 * sphereMass);
+  EXPECT_EQ(center, centerOfMass.Pos());
+  EXPECT_NEAR(0.4 * sphereMass, massMatrix.DiagonalMoments().X(),
+      1e-3 * sphereMass);
+
+  // Integrating the same triangles again gives the same result
+  math::MassMatrix3d repeatedMassMatrix;
+  math::Pose3d repeatedCenter;
+  calculator.CalculateMassProperties(arrays, density, repeatedMassMatrix,
+      repeatedCenter);
+  EXPECT_DOUBLE_EQ(massMatrix.Mass(), repeatedMassMatrix.Mass());
+  EXPECT_EQ(massMatrix.DiagonalMoments(),
+      repeatedMassMatrix.DiagonalMoments());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshInertiaCalculator, GetMeshTriangles)
+{
+  auto meshManager = common::MeshManager::Instance();
+  meshManager->CreateBox("mesh_inertia_calculator_box",
+      math::Vector3d(1, 2, 3), math::Vector2d(1, 1));
+  const auto *mesh = meshManager->MeshByName("mesh_inertia_calculator_box");
+  ASSERT_NE(nullptr, mesh);
+
+  MeshInertiaCalculator calculator;
+  const math::Vector3d scale(2, 1, 1);
+
+  std::vector<Triangle> triangles;
+  calculator.GetMeshTriangles(triangles, scale, mesh);
+  TriangleArrays arrays;
+  calculator.GetMeshTriangles(arrays, scale, mesh);
+  ASSERT_EQ(12u, arrays.Size());
+  ASSERT_EQ(triangles.size(), arrays.Size());
+  for (std::size_t i = 0; i < arrays.Size(); ++i)
+  {
+    EXPECT_EQ(triangles[i].v0,
+        math::Vector3d(arrays.x0[i], arrays.y0[i], arrays.z0[i]));
+    EXPECT_EQ(triangles[i].v1,
+        math::Vector3d(arrays.x1[i], arrays.y1[i], arrays.z1[i]));
+    EXPECT_EQ(triangles[i].v2,
+        math::Vector3d(arrays.x2[i], arrays.y2[i], arrays.z2[i]));
+  }
+
+  // A scaled 2x2x3 box
+  math::MassMatrix3d massMatrix;
+  math::Pose3d centerOfMass;
+  calculator.CalculateMassProperties(arrays, 1.0, massMatrix, centerOfMass);
+  const double mass = 12.0;
+  EXPECT_NEAR(mass, massMatrix.Mass(), 1e-9);
+  EXPECT_EQ(math::Vector3d::Zero, centerOfMass.Pos());
+  EXPECT_NEAR(mass / 12 * (4 + 9), massMatrix.DiagonalMoments().X(), 1e-9);
+  EXPECT_NEAR(mass / 12 * (4 + 9), massMatrix.DiagonalMoments().Y(), 1e-9);
+  EXPECT_NEAR(mass / 12 * (4 + 4), massMatrix.DiagonalMoments().Z(), 1e-9);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "NoiseGenerator.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Multipliers of the Philox rounds.
+constexpr std::uint32_t kMultiplier0{0xD2511F53u};
+constexpr std::uint32_t kMultiplier1{0xCD9E8D57u};
+
+/// \brief Increments of the key between Philox rounds.
+constexpr std::uint32_t kWeyl0{0x9E3779B9u};
+constexpr std::uint32_t kWeyl1{0xBB67AE85u};
+
+/// \brief Number of blocks computed together by AddNormal.
+constexpr std::size_t kLanes{16u};
+
+/// \brief Counters of several blocks, with one array per word of the
+/// counter so the rounds vectorize.
+/// \tparam N Number of blocks.
+template <std::size_t N>
+struct Counters
+{
+  std::array<std::uint32_t, N> c0;
+  std::array<std::uint32_t, N> c1;
+  std::array<std::uint32_t, N> c2;
+  std::array<std::uint32_t, N> c3;
+};
+
+/// \brief Turn counters into random bits with the Philox4x32-10 rounds.
+/// \param[in,out] _ctr Counters, replaced by the random bits.
+/// \param[in] _key Key of the generator.
+template <std::size_t N>
+void philox(Counters<N> &_ctr, std::array<std::uint32_t, 2> _key)
+{
+  for (int round = 0; round < 10; ++round)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      const std::uint64_t p0 =
+          static_cast<std::uint64_t>(kMultiplier0) * _ctr.c0[i];
+      const std::uint64_t p1 =
+          static_cast<std::uint64_t>(kMultiplier1) * _ctr.c2[i];
+      const std::uint32_t c1 = _ctr.c1[i];
+      const std::uint32_t c3 = _ctr.c3[i];
+      _ctr.c0[i] = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ _key[0];
+      _ctr.c1[i] = static_cast<std::uint32_t>(p1);
+      _ctr.c2[i] = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ _key[1];
+      _ctr.c3[i] = static_cast<std::uint32_t>(p0);
+    }
+    _key[0] += kWeyl0;
+    _key[1] += kWeyl1;
+  }
+}
+
+/// \brief Map random bits to a uniform sample in (0, 1).
+/// \param[in] _bits Random bits.
+/// \return The sample.
+double uniform(std::uint32_t _bits)
+{
+  return (static_cast<double>(_bits) + 0.5) * (1.0 / 4294967296.0);
+}
+
+/// \brief Turn two pairs of random words into standard normal samples
+/// with the Box-Muller transform.
+/// \param[in] _ctr Random bits.
+/// \param[in] _lane Block to use.
+/// \param[out] _samples The kBlockSize samples.
+template <std::size_t N>
+void normals(const Counters<N> &_ctr, std::size_t _lane, double *_samples)
+{
+  constexpr double kTwoPi{6.283185307179586};
+  const double r0 = std::sqrt(-2.0 * std::log(uniform(_ctr.c0[_lane])));
+  const double a0 = kTwoPi * uniform(_ctr.c1[_lane]);
+  const double r1 = std::sqrt(-2.0 * std::log(uniform(_ctr.c2[_lane])));
+  const double a1 = kTwoPi * uniform(_ctr.c3[_lane]);
+  _samples[0] = r0 * std::cos(a0);
+  _samples[1] = r0 * std::sin(a0);
+  _samples[2] = r1 * std::cos(a1);
+  _samples[3] = r1 * std::sin(a1);
+}
+
+/// \brief Mix the bits of a value, from the SplitMix64 generator.
+/// \param[in] _value Value to mix.
+/// \return Mixed value.
+std::uint64_t mix(std::uint64_t _value)
+{
+  _value += 0x9E3779B97F4A7C15ull;
+  _value = (_value ^ (_value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  _value = (_value ^ (_value >> 27)) * 0x94D049BB133111EBull;
+  return _value ^ (_value >> 31);
+}
+}
+
+//////////////////////////////////////////////////
+NoiseGenerator::NoiseGenerator(std::uint64_t _seed, std::uint64_t _stream)
+{
+  const std::uint64_t key = mix(_seed ^ mix(_stream));
+  this->key = {static_cast<std::uint32_t>(key),
+      static_cast<std::uint32_t>(key >> 32)};
+}
+
+//////////////////////////////////////////////////
+void NoiseGenerator::Reset(std::uint64_t _step, std::uint32_t _substream)
+{
+  this->step = _step;
+  this->substream = _substream;
+  this->block = 0u;
+  this->next = kBlockSize;
+}
+
+//////////////////////////////////////////////////
+double NoiseGenerator::Normal(double _mean, double _stdDev)
+{
+  if (this->next >= kBlockSize)
+    this->Refill();
+  return _mean + _stdDev * this->buffer[this->next++];
+}
+
+//////////////////////////////////////////////////
+void NoiseGenerator::AddNormal(double *_values, std::size_t _count,
+    double _mean, double _stdDev)
+{
+  std::size_t i{0u};
+
+  // Samples left over from single draws come first
+  for (; i < _count && this->next < kBlockSize; ++i)
+    _values[i] += _mean + _stdDev * this->buffer[this->next++];
+
+  // Then whole blocks, computed together
+  Counters<kLanes> ctr;
+  while (_count - i >= kBlockSize)
+  {
+    const std::size_t blocks =
+        std::min(kLanes, (_count - i) / kBlockSize);
+    for (std::size_t lane = 0; lane < kLanes; ++lane)
+    {
+      ctr.c0[lane] = this->block + static_cast<std::uint32_t>(lane);
+      ctr.c1[lane] = this->substream;
+      ctr.c2[lane] = static_cast<std::uint32_t>(this->step);
+      ctr.c3[lane] = static_cast<std::uint32_t>(this->step >> 32);
+    }
+    philox(ctr, this->key);
+
+    for (std::size_t lane = 0; lane < blocks; ++lane)
+    {
+      std::array<double, kBlockSize> samples;
+      normals(ctr, lane, samples.data());
+      for (std::size_t j = 0; j < kBlockSize; ++j, ++i)
+        _values[i] += _mean + _stdDev * samples[j];
+    }
+    this->block += static_cast<std::uint32_t>(blocks);
+  }
+
+  for (; i < _count; ++i)
+    _values[i] += this->Normal(_mean, _stdDev);
+}
+
+//////////////////////////////////////////////////
+void NoiseGenerator::Refill()
+{
+  Counters<1> ctr;
+  ctr.c0[0] = this->block++;
+  ctr.c1[0] = this->substream;
+  ctr.c2[0] = static_cast<std::uint32_t>(this->step);
+  ctr.c3[0] = static_cast<std::uint32_t>(this->step >> 32);
+  philox(ctr, this->key);
+  normals(ctr, 0u, this->buffer.data());
+  this->next = 0u;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_NOISEGENERATOR_HH_
+#define GZ_SIM_NOISEGENERATOR_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class NoiseGenerator NoiseGenerator.hh
+    /// \brief Counter-based generator of Gaussian noise, using the
+    /// Philox4x32-10 algorithm.
+    ///
+    /// Samples are a pure function of the seed, the stream, the step and
+    /// the position of the sample in the step, so they don't depend on the
+    /// order in which threads draw them. Give each noise source, such as a
+    /// sensor entity, its own stream, and reset the generator with the
+    /// simulation iteration before drawing the samples of a step.
+    ///
+    /// Drawing many samples at once with AddNormal computes the random bits
+    /// of several blocks together, which lets the compiler vectorize them.
+    class GZ_SIM_VISIBLE NoiseGenerator
+    {
+      /// \brief Constructor.
+      /// \param[in] _seed Seed shared by all streams, such as the seed of
+      /// the simulation.
+      /// \param[in] _stream Identifier of the noise source.
+      public: NoiseGenerator(std::uint64_t _seed, std::uint64_t _stream);
+
+      /// \brief Start the samples of a step. Resetting with the same values
+      /// gives the same samples again.
+      /// \param[in] _step Step, usually the simulation iteration.
+      /// \param[in] _substream Identifier of an independent sequence within
+      /// the step, such as the row of a scan drawn by its own thread.
+      public: void Reset(std::uint64_t _step, std::uint32_t _substream = 0u);
+
+      /// \brief Draw a sample from a normal distribution.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \return The sample.
+      public: double Normal(double _mean, double _stdDev);
+
+      /// \brief Add samples from a normal distribution to values. This
+      /// gives the same samples as calling Normal _count times.
+      /// \param[in,out] _values Values to add the noise to.
+      /// \param[in] _count Number of values.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      public: void AddNormal(double *_values, std::size_t _count,
+                  double _mean, double _stdDev);
+
+      /// \brief Number of samples computed from each block of random bits.
+      public: static constexpr std::size_t kBlockSize{4u};
+
+      /// \brief Compute the samples of the next block into the buffer.
+      private: void Refill();
+
+      /// \brief Key of the generator, from the seed and the stream.
+      private: std::array<std::uint32_t, 2> key;
+
+      /// \brief Step the counter is at.
+      private: std::uint64_t step{0u};
+
+      /// \brief Substream the counter is at.
+      private: std::uint32_t substream{0u};
+
+      /// \brief Index of the next block in the step.
+      private: std::uint32_t block{0u};
+
+      /// \brief Standard normal samples of the last block.
+      private: std::array<double, kBlockSize> buffer{};
+
+      /// \brief Index of the next unused sample in the buffer.
+      private: std::size_t next{kBlockSize};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "NoiseGenerator.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(NoiseGenerator, Reproducible)
+{
+  NoiseGenerator a(7u, 42u);
+  NoiseGenerator b(7u, 42u);
+  a.Reset(3u);
+  b.Reset(3u);
+  for (int i = 0; i < 10; ++i)
+    EXPECT_DOUBLE_EQ(a.Normal(0.0, 1.0), b.Normal(0.0, 1.0));
+
+  // Resetting repeats the samples of the step
+  a.Reset(3u);
+  const double first = a.Normal(0.0, 1.0);
+  a.Reset(3u);
+  EXPECT_DOUBLE_EQ(first, a.Normal(0.0, 1.0));
+
+  // Other steps, substreams, streams and seeds differ
+  a.Reset(4u);
+  EXPECT_NE(first, a.Normal(0.0, 1.0));
+  a.Reset(3u, 1u);
+  EXPECT_NE(first, a.Normal(0.0, 1.0));
+  NoiseGenerator c(7u, 43u);
+  c.Reset(3u);
+  EXPECT_NE(first, c.Normal(0.0, 1.0));
+  NoiseGenerator d(8u, 42u);
+  d.Reset(3u);
+  EXPECT_NE(first, d.Normal(0.0, 1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(NoiseGenerator, BatchMatchesSingleDraws)
+{
+  NoiseGenerator single(1u, 2u);
+  NoiseGenerator batch(1u, 2u);
+  single.Reset(5u);
+  batch.Reset(5u);
+
+  // Leave part of a block unused before the batch
+  EXPECT_DOUBLE_EQ(single.Normal(1.0, 2.0), batch.Normal(1.0, 2.0));
+
+  std::vector<double> values(203, 10.0);
+  batch.AddNormal(values.data(), values.size(), 1.0, 2.0);
+  for (const double value : values)
+    EXPECT_DOUBLE_EQ(10.0 + single.Normal(1.0, 2.0), value);
+  EXPECT_DOUBLE_EQ(single.Normal(1.0, 2.0), batch.Normal(1.0, 2.0));
+}
+
+/////////////////////////////////////////////////
+TEST(NoiseGenerator, Distribution)
+{
+  NoiseGenerator noise(0u, 0u);
+  noise.Reset(0u);
+  std::vector<double> values(100000, 0.0);
+  noise.AddNormal(values.data(), values.size(), 3.0, 0.5);
+
+  double sum{0.0};
+  double sumSquares{0.0};
+  for (const double value : values)
+  {
+    EXPECT_TRUE(std::isfinite(value));
+    sum += value;
+    sumSquares += value * value;
+  }
+  const double mean = sum / values.size();
+  const double variance = sumSquares / values.size() - mean * mean;
+  EXPECT_NEAR(3.0, mean, 0.01);
+  EXPECT_NEAR(0.5, std::sqrt(variance), 0.01);
+}
@@ -0,0 +1,834 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_RAYCASTER_HH_
+#define GZ_SIM_RAYCASTER_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE
+{
+  /// \brief Triangles of a mesh, three vertices per triangle.
+  using Triangles = std::vector<math::Vector3d>;
+
+  /// \class TriangleMesh RayCaster.hh
+  /// \brief Triangles of a mesh sorted into a bounding volume hierarchy,
+  /// so a ray only tests the triangles near it. Building it is linearithmic
+  /// in the number of triangles, so it should be built once per mesh and
+  /// shared.
+  class TriangleMesh
+  {
+    /// \brief Constructor.
+    /// \param[in] _triangles Triangles of the mesh, already scaled.
+    public: explicit TriangleMesh(Triangles _triangles)
+      : triangles(std::move(_triangles))
+    {
+      this->triangles.resize(this->triangles.size() / 3 * 3);
+      const std::size_t count = this->triangles.size() / 3;
+      if (0u == count)
+        return;
+
+      for (const auto &vertex : this->triangles)
+        this->bounds.Merge(math::AxisAlignedBox(vertex, vertex));
+      this->closed = IsClosed(this->triangles);
+
+      std::vector<std::uint32_t> order(count);
+      for (std::size_t i = 0; i < count; ++i)
+        order[i] = static_cast<std::uint32_t>(i);
+      this->Build(order, 0, count);
+
+      // Store the triangles in the order of the leaves
+      Triangles sorted;
+      sorted.reserve(this->triangles.size());
+      for (const auto index : order)
+      {
+        for (std::size_t k = 0; k < 3; ++k)
+          sorted.push_back(this->triangles[index * 3 + k]);
+      }
+      this->triangles = std::move(sorted);
+    }
+
+    /// \brief Get the number of triangles.
+    /// \return Number of triangles.
+    public: std::size_t TriangleCount() const
+    {
+      return this->triangles.size() / 3;
+    }
+
+    /// \brief Get the bounds of the mesh.
+    /// \return Bounds in the frame of the mesh.
+    public: const math::AxisAlignedBox &Bounds() const
+    {
+      return this->bounds;
+    }
+
+    /// \brief Check whether the mesh is closed, that is, every edge is
+    /// shared by exactly two triangles. Only closed meshes have an inside.
+    /// \return True if the mesh is closed.
+    public: bool Closed() const
+    {
+      return this->closed;
+    }
+
+    /// \brief Intersect a ray with both sides of the triangles.
+    /// \param[in] _o Origin of the ray in the frame of the mesh.
+    /// \param[in] _d Unit direction of the ray in the frame of the mesh.
+    /// \param[in] _max Maximum distance.
+    /// \param[out] _backFace Set to whether the closest hit is on the back
+    /// of its triangle, assuming counterclockwise triangles seen from
+    /// outside.
+    /// \return Distance to the closest hit, or _max if there's no closer
+    /// hit.
+    public: double Intersect(const math::Vector3d &_o,
+                             const math::Vector3d &_d, const double _max,
+                             bool &_backFace) const
+    {
+      double best = _max;
+      if (this->nodes.empty())
+        return best;
+
+      math::Vector3d inv;
+      for (int i = 0; i < 3; ++i)
+      {
+        inv[i] = std::abs(_d[i]) < 1e-12 ?
+            std::numeric_limits<double>::infinity() : 1.0 / _d[i];
+      }
+
+      // The depth of the tree is logarithmic in the number of triangles
+      std::uint32_t stack[64];
+      std::size_t size = 0;
+      stack[size++] = 0;
+      while (size > 0)
+      {
+        const Node &node = this->nodes[stack[--size]];
+        if (Enter(node, _o, inv, best) >= best)
+          continue;
+
+        if (node.count > 0)
+        {
+          for (std::uint32_t i = node.first; i < node.first + node.count;
+               ++i)
+          {
+            double det;
+            const double t = Triangle(i * 3, _o, _d, best, det);
+            if (t < best)
+            {
+              best = t;
+              _backFace = det < 0;
+            }
+          }
+          continue;
+        }
+
+        // Visit the closest child first, so the farther one is more likely
+        // to be discarded
+        const std::uint32_t left = static_cast<std::uint32_t>(
+            &node - this->nodes.data()) + 1;
+        const std::uint32_t right = node.first;
+        const double tLeft = Enter(this->nodes[left], _o, inv, best);
+        const double tRight = Enter(this->nodes[right], _o, inv, best);
+        if (tLeft <= tRight)
+        {
+          if (tRight < best)
+            stack[size++] = right;
+          if (tLeft < best)
+            stack[size++] = left;
+        }
+        else
+        {
+          if (tLeft < best)
+            stack[size++] = left;
+          if (tRight < best)
+            stack[size++] = right;
+        }
+      }
+      return best;
+    }
+
+    /// \brief A node of the hierarchy. The left child of an inner node
+    /// follows it.
+    private: struct Node
+    {
+      /// \brief Minimum corner of the bounds.
+      math::Vector3d min;
+
+      /// \brief Maximum corner of the bounds.
+      math::Vector3d max;
+
+      /// \brief First triangle of a leaf, or right child of an inner node.
+      std::uint32_t first{0};
+
+      /// \brief Number of triangles of a leaf, 0 for inner nodes.
+      std::uint32_t count{0};
+    };
+
+    /// \brief Build the nodes of a range of triangles.
+    /// \param[in, out] _order Triangle indices, sorted into leaves.
+    /// \param[in] _begin First index of the range.
+    /// \param[in] _end End of the range.
+    private: void Build(std::vector<std::uint32_t> &_order,
+                        const std::size_t _begin, const std::size_t _end)
+    {
+      // Triangles per leaf
+      constexpr std::size_t kLeafSize{4u};
+
+      const std::size_t index = this->nodes.size();
+      this->nodes.emplace_back();
+      math::AxisAlignedBox box;
+      math::AxisAlignedBox centers;
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+          const auto &vertex = this->triangles[_order[i] * 3 + k];
+          box.Merge(math::AxisAlignedBox(vertex, vertex));
+        }
+        const auto center = this->Center(_order[i]);
+        centers.Merge(math::AxisAlignedBox(center, center));
+      }
+      this->nodes[index].min = box.Min();
+      this->nodes[index].max = box.Max();
+
+      if (_end - _begin <= kLeafSize)
+      {
+        this->nodes[index].first = static_cast<std::uint32_t>(_begin);
+        this->nodes[index].count = static_cast<std::uint32_t>(_end - _begin);
+        return;
+      }
+
+      // Split at the median along the longest axis of the centers
+      const auto extent = centers.Size();
+      int axis = extent.X() >= extent.Y() ? 0 : 1;
+      if (extent.Z() > extent[axis])
+        axis = 2;
+      const std::size_t mid = _begin + (_end - _begin) / 2;
+      std::nth_element(_order.begin() + _begin, _order.begin() + mid,
+          _order.begin() + _end,
+          [&](const std::uint32_t _a, const std::uint32_t _b)
+          {
+            return this->Center(_a)[axis] < this->Center(_b)[axis];
+          });
+
+      this->Build(_order, _begin, mid);
+      this->nodes[index].first = static_cast<std::uint32_t>(
+          this->nodes.size());
+      this->Build(_order, mid, _end);
+    }
+
+    /// \brief Get the center of a triangle.
+    /// \param[in] _index Index of the triangle.
+    /// \return Sum of its vertices, which sorts like the center.
+    private: math::Vector3d Center(const std::uint32_t _index) const
+    {
+      return this->triangles[_index * 3] + this->triangles[_index * 3 + 1] +
+          this->triangles[_index * 3 + 2];
+    }
+
+    /// \brief Get where a ray enters the bounds of a node.
+    /// \param[in] _node The node.
+    /// \param[in] _o Origin of the ray.
+    /// \param[in] _inv Inverse of the direction of the ray, infinite for
+    /// null components.
+    /// \param[in] _max Maximum distance.
+    /// \return Distance to the entry point, 0 if the origin is inside, or
+    /// infinity if there's no entry closer than _max.
+    private: static double Enter(const Node &_node, const math::Vector3d &_o,
+                                 const math::Vector3d &_inv,
+                                 const double _max)
+    {
+      constexpr double kInf = std::numeric_limits<double>::infinity();
+      double tNear = 0.0;
+      double tFar = _max;
+      for (int i = 0; i < 3; ++i)
+      {
+        if (std::isinf(_inv[i]))
+        {
+          if (_o[i] < _node.min[i] || _o[i] > _node.max[i])
+            return kInf;
+          continue;
+        }
+        double t1 = (_node.min[i] - _o[i]) * _inv[i];
+        double t2 = (_node.max[i] - _o[i]) * _inv[i];
+        if (t1 > t2)
+          std::swap(t1, t2);
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+        if (tNear > tFar)
+          return kInf;
+      }
+      return tNear;
+    }
+
+    /// \brief Intersect a ray with both sides of a triangle, with
+    /// Moller-Trumbore.
+    /// \param[in] _i Index of the first vertex of the triangle.
+    /// \param[in] _o Origin of the ray.
+    /// \param[in] _d Direction of the ray.
+    /// \param[in] _max Maximum distance.
+    /// \param[out] _det Determinant, negative on the back of the triangle.
+    /// \return Distance to the hit, or _max if there's no closer hit.
+    private: double Triangle(const std::size_t _i, const math::Vector3d &_o,
+                             const math::Vector3d &_d, const double _max,
+                             double &_det) const
+    {
+      const auto &tris = this->triangles;
+      const auto e1 = tris[_i + 1] - tris[_i];
+      const auto e2 = tris[_i + 2] - tris[_i];
+      const auto p = _d.Cross(e2);
+      _det = e1.Dot(p);
+      if (std::abs(_det) < 1e-12)
+        return _max;
+      const double invDet = 1.0 / _det;
+      const auto s = _o - tris[_i];
+      const double u = s.Dot(p) * invDet;
+      if (u < 0 || u > 1)
+        return _max;
+      const auto q = s.Cross(e1);
+      const double v = _d.Dot(q) * invDet;
+      if (v < 0 || u + v > 1)
+        return _max;
+      const double t = e2.Dot(q) * invDet;
+      return (t >= 0 && t < _max) ? t : _max;
+    }
+
+    /// \brief Check whether every edge is shared by exactly two triangles.
+    /// Vertices are matched by their exact coordinates.
+    /// \param[in] _triangles Triangles to check.
+    /// \return True if the triangles are closed.
+    private: static bool IsClosed(const Triangles &_triangles)
+    {
+      const auto less = [](const math::Vector3d &_a, const math::Vector3d &_b)
+      {
+        return std::make_tuple(_a.X(), _a.Y(), _a.Z()) <
+            std::make_tuple(_b.X(), _b.Y(), _b.Z());
+      };
+      std::map<math::Vector3d, std::uint64_t, decltype(less)> ids(less);
+      std::vector<std::uint64_t> vertexIds;
+      vertexIds.reserve(_triangles.size());
+      for (const auto &vertex : _triangles)
+      {
+        vertexIds.push_back(
+            ids.emplace(vertex, ids.size()).first->second);
+      }
+
+      std::unordered_map<std::uint64_t, int> edges;
+      for (std::size_t i = 0; i < vertexIds.size(); i += 3)
+      {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+          const auto a = vertexIds[i + k];
+          const auto b = vertexIds[i + (k + 1) % 3];
+          ++edges[(std::min(a, b) << 32) | std::max(a, b)];
+        }
+      }
+      for (const auto &edge : edges)
+      {
+        if (edge.second != 2)
+          return false;
+      }
+      return true;
+    }
+
+    /// \brief Triangles, in the order of the leaves.
+    private: Triangles triangles;
+
+    /// \brief Nodes of the hierarchy, the root first.
+    private: std::vector<Node> nodes;
+
+    /// \brief Bounds of the mesh.
+    private: math::AxisAlignedBox bounds;
+
+    /// \brief Whether the mesh is closed.
+    private: bool closed{false};
+  };
+
+  /// \class RayCaster RayCaster.hh
+  /// \brief Helper class that casts rays against a set of collision shapes
+  /// in world coordinates, without rendering.
+  ///
+  /// Each shape keeps its world pose and a bounding sphere, so rays that
+  /// can't hit a shape are discarded with a single distance check before
+  /// the exact intersection is computed in the shape's frame. Rays that
+  /// start inside a solid shape don't hit it, so a sensor inside a
+  /// collision sees past it. Casting rays doesn't modify the caster, so
+  /// rays can be cast from multiple threads at the same time.
+  class RayCaster
+  {
+    /// \brief Remove all shapes.
+    public: void Clear()
+    {
+      this->shapes.clear();
+    }
+
+    /// \brief Get the number of shapes.
+    /// \return Number of shapes.
+    public: std::size_t ShapeCount() const
+    {
+      return this->shapes.size();
+    }
+
+    /// \brief Add a box centered at its pose.
+    /// \param[in] _pose World pose of the box.
+    /// \param[in] _size Size of the box.
+    public: void AddBox(const math::Pose3d &_pose,
+                        const math::Vector3d &_size)
+    {
+      this->Add(Type::BOX, _pose, _size * 0.5, _size.Length() * 0.5);
+    }
+
+    /// \brief Add a sphere centered at its pose.
+    /// \param[in] _pose World pose of the sphere.
+    /// \param[in] _radius Radius of the sphere.
+    public: void AddSphere(const math::Pose3d &_pose, const double _radius)
+    {
+      this->Add(Type::ELLIPSOID, _pose,
+          math::Vector3d(_radius, _radius, _radius), _radius);
+    }
+
+    /// \brief Add an ellipsoid centered at its pose.
+    /// \param[in] _pose World pose of the ellipsoid.
+    /// \param[in] _radii Radii of the ellipsoid along each axis.
+    public: void AddEllipsoid(const math::Pose3d &_pose,
+                              const math::Vector3d &_radii)
+    {
+      this->Add(Type::ELLIPSOID, _pose, _radii, _radii.Max());
+    }
+
+    /// \brief Add a cylinder centered at its pose, along its Z axis.
+    /// \param[in] _pose World pose of the cylinder.
+    /// \param[in] _radius Radius of the cylinder.
+    /// \param[in] _length Length of the cylinder.
+    public: void AddCylinder(const math::Pose3d &_pose, const double _radius,
+                             const double _length)
+    {
+      this->Add(Type::CYLINDER, _pose,
+          math::Vector3d(_radius, _radius, _length * 0.5),
+          std::hypot(_radius, _length * 0.5));
+    }
+
+    /// \brief Add a capsule centered at its pose, along its Z axis.
+    /// \param[in] _pose World pose of the capsule.
+    /// \param[in] _radius Radius of the capsule.
+    /// \param[in] _length Length of the cylindrical part of the capsule.
+    public: void AddCapsule(const math::Pose3d &_pose, const double _radius,
+                            const double _length)
+    {
+      this->Add(Type::CAPSULE, _pose,
+          math::Vector3d(_radius, _radius, _length * 0.5),
+          _radius + _length * 0.5);
+    }
+
+    /// \brief Add a rectangular plane centered at its pose.
+    /// \param[in] _pose World pose of the plane.
+    /// \param[in] _normal Normal of the plane, in the frame of its pose.
+    /// \param[in] _size Size of the plane.
+    public: void AddPlane(const math::Pose3d &_pose,
+                          const math::Vector3d &_normal,
+                          const math::Vector2d &_size)
+    {
+      // Rotate the plane so its normal is the Z axis
+      math::Quaterniond rot;
+      rot.SetFrom2Axes(math::Vector3d::UnitZ, _normal.Normalized());
+      const math::Vector3d half(_size.X() * 0.5, _size.Y() * 0.5, 0.0);
+      this->Add(Type::PLANE, _pose * math::Pose3d(math::Vector3d::Zero, rot),
+          half, half.Length());
+    }
+
+    /// \brief Add a triangle mesh, building its hierarchy. Prefer the
+    /// TriangleMesh overload for meshes that are added repeatedly.
+    /// \param[in] _pose World pose of the mesh.
+    /// \param[in] _triangles Triangles of the mesh, in the frame of its pose
+    /// and already scaled.
+    public: void AddMesh(const math::Pose3d &_pose,
+                         const std::shared_ptr<const Triangles> &_triangles)
+    {
+      if (_triangles)
+        this->AddMesh(_pose, std::make_shared<TriangleMesh>(*_triangles));
+    }
+
+    /// \brief Add a triangle mesh.
+    /// \param[in] _pose World pose of the mesh.
+    /// \param[in] _mesh Triangles of the mesh, in the frame of its pose. They
+    /// are shared, not copied.
+    public: void AddMesh(const math::Pose3d &_pose,
+                         std::shared_ptr<const TriangleMesh> _mesh)
+    {
+      if (!_mesh || 0u == _mesh->TriangleCount())
+        return;
+
+      const math::AxisAlignedBox &box = _mesh->Bounds();
+
+      // Meshes aren't centered at their origin, so the bounding sphere is
+      // centered at the origin and reaches the farthest corner
+      const auto far = math::Vector3d(
+          std::max(std::abs(box.Min().X()), std::abs(box.Max().X())),
+          std::max(std::abs(box.Min().Y()), std::abs(box.Max().Y())),
+          std::max(std::abs(box.Min().Z()), std::abs(box.Max().Z())));
+      this->Add(Type::MESH, _pose, math::Vector3d::Zero, far.Length());
+      this->shapes.back().mesh = std::move(_mesh);
+    }
+
+    /// \brief Cast a ray against all shapes.
+    /// \param[in] _origin Origin of the ray in world coordinates.
+    /// \param[in] _dir Unit direction of the ray in world coordinates.
+    /// \param[in] _max Maximum distance along the ray.
+    /// \return Distance to the closest hit, or infinity if there's no hit
+    /// closer than _max.
+    public: double Cast(const math::Vector3d &_origin,
+                        const math::Vector3d &_dir, const double _max) const
+    {
+      return this->Cast(_origin, _dir, _max,
+          [](std::size_t) { return false; });
+    }
+
+    /// \brief Cast a ray against the shapes that aren't skipped.
+    /// \param[in] _origin Origin of the ray in world coordinates.
+    /// \param[in] _dir Unit direction of the ray in world coordinates.
+    /// \param[in] _max Maximum distance along the ray.
+    /// \param[in] _skip Called with the index of each shape the ray may
+    /// hit, in the order they were added, returns true to ignore it.
+    /// \return Distance to the closest hit, or infinity if there's no hit
+    /// closer than _max.
+    public: template<typename SkipFn>
+            double Cast(const math::Vector3d &_origin,
+                        const math::Vector3d &_dir, const double _max,
+                        const SkipFn &_skip) const
+    {
+      double best = _max;
+      bool hit = false;
+      for (std::size_t i = 0; i < this->shapes.size(); ++i)
+      {
+        const auto &shape = this->shapes[i];
+        // Discard shapes whose bounding sphere the ray misses
+        const auto toCenter = shape.pose.Pos() - _origin;
+        const double along = toCenter.Dot(_dir);
+        if (along < -shape.radius || along - shape.radius > best)
+          continue;
+        if ((toCenter - _dir * along).SquaredLength() >
+            shape.radius * shape.radius)
+        {
+          continue;
+        }
+        if (_skip(i))
+          continue;
+
+        const auto origin =
+            shape.pose.Rot().RotateVectorReverse(_origin - shape.pose.Pos());
+        const auto dir = shape.pose.Rot().RotateVectorReverse(_dir);
+        double t = Intersect(shape, origin, dir, best);
+        if (t < best)
+        {
+          best = t;
+          hit = true;
+        }
+      }
+      return hit ? best : std::numeric_limits<double>::infinity();
+    }
+
+    /// \brief Kinds of shapes.
+    private: enum class Type
+    {
+      BOX,
+      ELLIPSOID,
+      CYLINDER,
+      CAPSULE,
+      PLANE,
+      MESH
+    };
+
+    /// \brief A shape in world coordinates.
+    private: struct Shape
+    {
+      /// \brief Kind of shape.
+      Type type;
+
+      /// \brief World pose of the shape.
+      math::Pose3d pose;
+
+      /// \brief Half extents, radii or radius and half length, depending on
+      /// the type.
+      math::Vector3d half;
+
+      /// \brief Radius of the bounding sphere around the pose.
+      double radius;
+
+      /// \brief Triangles of meshes.
+      std::shared_ptr<const TriangleMesh> mesh;
+    };
+
+    /// \brief Add a shape.
+    /// \param[in] _type Kind of shape.
+    /// \param[in] _pose World pose.
+    /// \param[in] _half Half extents, see Shape::half.
+    /// \param[in] _radius Radius of the bounding sphere.
+    private: void Add(const Type _type, const math::Pose3d &_pose,
+                      const math::Vector3d &_half, const double _radius)
+    {
+      Shape shape;
+      shape.type = _type;
+      shape.pose = _pose;
+      shape.half = _half;
+      shape.radius = _radius;
+      this->shapes.push_back(std::move(shape));
+    }
+
+    /// \brief Intersect a ray with a shape in the frame of the shape.
+    /// \param[in] _shape The shape.
+    /// \param[in] _o Origin of the ray.
+    /// \param[in] _d Unit direction of the ray.
+    /// \param[in] _max Maximum distance.
+    /// \return Distance to the hit, or _max if there's no closer hit.
+    private: static double Intersect(const Shape &_shape,
+                                     const math::Vector3d &_o,
+                                     const math::Vector3d &_d,
+                                     const double _max)
+    {
+      if (Inside(_shape, _o))
+        return _max;
+
+      switch (_shape.type)
+      {
+        case Type::BOX:
+          return Slab(-_shape.half, _shape.half, _o, _d, _max);
+        case Type::ELLIPSOID:
+          return Ellipsoid(_shape.half, math::Vector3d::Zero, _o, _d, _max);
+        case Type::CYLINDER:
+          return Cylinder(_shape.half.X(), _shape.half.Z(), true, _o, _d,
+              _max);
+        case Type::CAPSULE:
+        {
+          const double r = _shape.half.X();
+          const math::Vector3d radii(r, r, r);
+          const math::Vector3d cap(0, 0, _shape.half.Z());
+          double t = Cylinder(r, _shape.half.Z(), false, _o, _d, _max);
+          t = Ellipsoid(radii, cap, _o, _d, t);
+          return Ellipsoid(radii, -cap, _o, _d, t);
+        }
+        case Type::PLANE:
+        {
+          if (std::abs(_d.Z()) < 1e-12)
+            return _max;
+          const double t = -_o.Z() / _d.Z();
+          if (t < 0 || t >= _max)
+            return _max;
+          const auto p = _o + _d * t;
+          if (std::abs(p.X()) > _shape.half.X() ||
+              std::abs(p.Y()) > _shape.half.Y())
+          {
+            return _max;
+          }
+          return t;
+        }
+        case Type::MESH:
+        {
+          bool backFace{false};
+          const double t = _shape.mesh->Intersect(_o, _d, _max, backFace);
+
+          // The closest hit is on the inside of a closed mesh, so the ray
+          // started in it
+          if (t < _max && backFace && _shape.mesh->Closed())
+            return _max;
+          return t;
+        }
+      }
+      return _max;
+    }
+
+    /// \brief Check whether a point is inside a solid primitive. Meshes are
+    /// checked while they're intersected.
+    /// \param[in] _shape The shape.
+    /// \param[in] _p Point in the frame of the shape.
+    /// \return True if the point is inside.
+    private: static bool Inside(const Shape &_shape, const math::Vector3d &_p)
+    {
+      const auto &half = _shape.half;
+      switch (_shape.type)
+      {
+        case Type::BOX:
+          return std::abs(_p.X()) < half.X() && std::abs(_p.Y()) < half.Y() &&
+              std::abs(_p.Z()) < half.Z();
+        case Type::ELLIPSOID:
+          return (_p / half).SquaredLength() < 1;
+        case Type::CYLINDER:
+          return std::abs(_p.Z()) < half.Z() &&
+              _p.X() * _p.X() + _p.Y() * _p.Y() < half.X() * half.X();
+        case Type::CAPSULE:
+        {
+          const double z = _p.Z() - std::clamp(_p.Z(), -half.Z(), half.Z());
+          return _p.X() * _p.X() + _p.Y() * _p.Y() + z * z <
+              half.X() * half.X();
+        }
+        case Type::PLANE:
+        case Type::MESH:
+          return false;
+      }
+      return false;
+    }
+
+    /// \brief Intersect a ray with an axis aligned box.
+    /// \param[in] _min Minimum corner.
+    /// \param[in] _boxMax Maximum corner.
+    /// \param[in] _o Origin of the ray.
+    /// \param[in] _d Direction of the ray.
+    /// \param[in] _max Maximum distance.
+    /// \return Distance to the entry point, or _max if there's no closer
+    /// entry.
+    private: static double Slab(const math::Vector3d &_min,
+                                const math::Vector3d &_boxMax,
+                                const math::Vector3d &_o,
+                                const math::Vector3d &_d,
+                                const double _max)
+    {
+      double tNear = -std::numeric_limits<double>::infinity();
+      double tFar = std::numeric_limits<double>::infinity();
+      for (int i = 0; i < 3; ++i)
+      {
+        if (std::abs(_d[i]) < 1e-12)
+        {
+          if (_o[i] < _min[i] || _o[i] > _boxMax[i])
+            return _max;
+          continue;
+        }
+        double t1 = (_min[i] - _o[i]) / _d[i];
+        double t2 = (_boxMax[i] - _o[i]) / _d[i];
+        if (t1 > t2)
+          std::swap(t1, t2);
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+        if (tNear > tFar)
+          return _max;
+      }
+      return (tNear >= 0 && tNear < _max) ? tNear : _max;
+    }
+
+    /// \brief Get the smallest root of a quadratic, which is where a ray
+    /// enters a quadric.
+    /// \param[in] _a Quadratic coefficient, positive.
+    /// \param[in] _b Linear coefficient.
+    /// \param[in] _c Constant coefficient.
+    /// \param[in] _max Maximum root.
+    /// \return The root, or _max if it's negative or not smaller.
+    private: static double Root(const double _a, const double _b,
+                                const double _c, const double _max)
+    {
+      if (std::abs(_a) < 1e-12)
+        return _max;
+      const double disc = _b * _b - 4 * _a * _c;
+      if (disc < 0)
+        return _max;
+      const double sqrtDisc = std::sqrt(disc);
+      const double t = (-_b - sqrtDisc) / (2 * _a);
+      return (t >= 0 && t < _max) ? t : _max;
+    }
+
+    /// \brief Intersect a ray with an axis aligned ellipsoid.
+    /// \param[in] _radii Radii of the ellipsoid.
+    /// \param[in] _center Center of the ellipsoid.
+    /// \param[in] _o Origin of the ray.
+    /// \param[in] _d Direction of the ray.
+    /// \param[in] _max Maximum distance.
+    /// \return Distance to the hit, or _max if there's no closer hit.
+    private: static double Ellipsoid(const math::Vector3d &_radii,
+                                     const math::Vector3d &_center,
+                                     const math::Vector3d &_o,
+                                     const math::Vector3d &_d,
+                                     const double _max)
+    {
+      // Scale the ellipsoid into a unit sphere, which keeps the distance
+      // along the ray
+      const auto o = (_o - _center) / _radii;
+      const auto d = _d / _radii;
+      return Root(d.Dot(d), 2 * o.Dot(d), o.Dot(o) - 1, _max);
+    }
+
+    /// \brief Intersect a ray with a cylinder along the Z axis.
+    /// \param[in] _radius Radius of the cylinder.
+    /// \param[in] _halfLength Half of the length of the cylinder.
+    /// \param[in] _caps True to intersect the flat caps too.
+    /// \param[in] _o Origin of the ray.
+    /// \param[in] _d Direction of the ray.
+    /// \param[in] _max Maximum distance.
+    /// \return Distance to the hit, or _max if there's no closer hit.
+    private: static double Cylinder(const double _radius,
+                                    const double _halfLength,
+                                    const bool _caps,
+                                    const math::Vector3d &_o,
+                                    const math::Vector3d &_d,
+                                    const double _max)
+    {
+      double best = _max;
+      const double a = _d.X() * _d.X() + _d.Y() * _d.Y();
+      const double b = 2 * (_o.X() * _d.X() + _o.Y() * _d.Y());
+      const double c =
+          _o.X() * _o.X() + _o.Y() * _o.Y() - _radius * _radius;
+      if (std::abs(a) > 1e-12)
+      {
+        const double disc = b * b - 4 * a * c;
+        if (disc >= 0)
+        {
+          // Only where the ray enters the side
+          const double t = (-b - std::sqrt(disc)) / (2 * a);
+          if (t >= 0 && t < best &&
+              std::abs(_o.Z() + t * _d.Z()) <= _halfLength)
+          {
+            best = t;
+          }
+        }
+      }
+
+      if (_caps && std::abs(_d.Z()) > 1e-12)
+      {
+        for (double z : {-_halfLength, _halfLength})
+        {
+          const double t = (z - _o.Z()) / _d.Z();
+          if (t < 0 || t >= best)
+            continue;
+          const double x = _o.X() + t * _d.X();
+          const double y = _o.Y() + t * _d.Y();
+          if (x * x + y * y <= _radius * _radius)
+            best = t;
+        }
+      }
+      return best;
+    }
+
+    /// \brief All shapes.
+    private: std::vector<Shape> shapes;
+  };
+}
+}
+
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+#include "RayCaster.hh"
+
+using namespace gz;
+using namespace sim;
+
+const math::Vector3d kOrigin{0, 0, 0};
+const math::Vector3d kForward{1, 0, 0};
+
+/////////////////////////////////////////////////
+TEST(RayCaster, Empty)
+{
+  RayCaster caster;
+  EXPECT_EQ(0u, caster.ShapeCount());
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, kForward, 100)));
+}
+
+/////////////////////////////////////////////////
+TEST(RayCaster, Primitives)
+{
+  RayCaster caster;
+
+  // Rotated box, whose closest face is 4.5 m in front of the origin
+  caster.AddBox(math::Pose3d(5, 0, 0, 0, 0, GZ_PI_2),
+      math::Vector3d(2, 1, 1));
+  EXPECT_NEAR(4.5, caster.Cast(kOrigin, kForward, 100), 1e-9);
+
+  // Out of range
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, kForward, 4)));
+
+  // Pointing away from it
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, -kForward, 100)));
+
+  // A closer sphere hides the box
+  caster.AddSphere(math::Pose3d(3, 0, 0, 0, 0, 0), 0.5);
+  EXPECT_NEAR(2.5, caster.Cast(kOrigin, kForward, 100), 1e-9);
+  EXPECT_EQ(2u, caster.ShapeCount());
+
+  caster.Clear();
+  EXPECT_EQ(0u, caster.ShapeCount());
+
+  // Vertical cylinder, hit on its side
+  caster.AddCylinder(math::Pose3d(0, 4, 0, 0, 0, 0), 1, 2);
+  EXPECT_NEAR(3, caster.Cast(kOrigin, math::Vector3d::UnitY, 100), 1e-9);
+
+  // and on its cap from above
+  EXPECT_NEAR(9, caster.Cast(math::Vector3d(0, 4, 10),
+      -math::Vector3d::UnitZ, 100), 1e-9);
+
+  // Capsule hit on its rounded end
+  caster.Clear();
+  caster.AddCapsule(math::Pose3d(0, 0, -5, 0, 0, 0), 0.5, 2);
+  EXPECT_NEAR(3.5, caster.Cast(kOrigin, -math::Vector3d::UnitZ, 100), 1e-9);
+
+  // Ellipsoid stretched along X
+  caster.Clear();
+  caster.AddEllipsoid(math::Pose3d(10, 0, 0, 0, 0, 0),
+      math::Vector3d(3, 1, 1));
+  EXPECT_NEAR(7, caster.Cast(kOrigin, kForward, 100), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(RayCaster, Plane)
+{
+  RayCaster caster;
+  caster.AddPlane(math::Pose3d(0, 0, -1, 0, 0, 0), math::Vector3d::UnitZ,
+      math::Vector2d(10, 10));
+
+  // Looking down and diagonally at the ground
+  EXPECT_NEAR(1, caster.Cast(kOrigin, -math::Vector3d::UnitZ, 100), 1e-9);
+  const auto diagonal = math::Vector3d(1, 0, -1).Normalized();
+  EXPECT_NEAR(std::sqrt(2.0), caster.Cast(kOrigin, diagonal, 100), 1e-9);
+
+  // Parallel to it, and past its edge
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, kForward, 100)));
+  const auto shallow = math::Vector3d(10, 0, -1).Normalized();
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, shallow, 100)));
+}
+
+/////////////////////////////////////////////////
+TEST(RayCaster, Mesh)
+{
+  // A single triangle facing the X axis
+  auto triangles = std::make_shared<Triangles>(Triangles{
+      {0, -1, -1}, {0, 1, -1}, {0, 0, 1}});
+
+  RayCaster caster;
+  caster.AddMesh(math::Pose3d(6, 0, 0, 0, 0, 0), triangles);
+  EXPECT_EQ(1u, caster.ShapeCount());
+  EXPECT_NEAR(6, caster.Cast(kOrigin, kForward, 100), 1e-9);
+
+  // Missing the triangle
+  EXPECT_TRUE(std::isinf(caster.Cast(math::Vector3d(0, 0, 2), kForward,
+      100)));
+
+  // Empty meshes are ignored
+  caster.AddMesh(math::Pose3d::Zero, std::make_shared<Triangles>());
+  EXPECT_EQ(1u, caster.ShapeCount());
+
+  // An open triangle is hit from behind too
+  EXPECT_NEAR(4, caster.Cast(math::Vector3d(10, 0, 0), -kForward, 100),
+      1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(RayCaster, MeshHierarchy)
+{
+  // A grid of 100 x 100 squares in the YZ plane, facing -X
+  constexpr int kCells{100};
+  Triangles triangles;
+  for (int i = 0; i < kCells; ++i)
+  {
+    for (int j = 0; j < kCells; ++j)
+    {
+      const math::Vector3d corner(0, i * 0.1 - 5, j * 0.1 - 5);
+      const math::Vector3d y(0, 0.1, 0);
+      const math::Vector3d z(0, 0, 0.1);
+      triangles.insert(triangles.end(), {corner, corner + z, corner + y});
+      triangles.insert(triangles.end(),
+          {corner + y, corner + z, corner + y + z});
+    }
+  }
+  auto mesh = std::make_shared<TriangleMesh>(triangles);
+  EXPECT_EQ(2u * kCells * kCells, mesh->TriangleCount());
+  EXPECT_FALSE(mesh->Closed());
+
+  RayCaster caster;
+  caster.AddMesh(math::Pose3d(3, 0, 0, 0, 0, 0), mesh);
+
+  // Every cell is hit, like with a brute force search
+  for (double y = -4.95; y < 5; y += 0.5)
+  {
+    for (double z = -4.95; z < 5; z += 0.5)
+    {
+      EXPECT_NEAR(3, caster.Cast(math::Vector3d(0, y, z), kForward, 100),
+          1e-9);
+    }
+  }
+  const auto diagonal = math::Vector3d(1, 1, 1).Normalized();
+  EXPECT_NEAR(3 * std::sqrt(3.0), caster.Cast(kOrigin, diagonal, 100),
+      1e-9);
+
+  // Past its edges
+  EXPECT_TRUE(std::isinf(caster.Cast(math::Vector3d(0, 5.1, 0), kForward,
+      100)));
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, math::Vector3d::UnitY,
+      100)));
+}
+
+/////////////////////////////////////////////////
+TEST(RayCaster, Inside)
+{
+  RayCaster caster;
+
+  // Rays that start inside solid shapes don't hit them, but hit what's
+  // beyond
+  caster.AddBox(math::Pose3d::Zero, math::Vector3d(2, 2, 2));
+  caster.AddSphere(math::Pose3d(5, 0, 0, 0, 0, 0), 1);
+  EXPECT_NEAR(4, caster.Cast(kOrigin, kForward, 100), 1e-9);
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, -kForward, 100)));
+  EXPECT_TRUE(std::isinf(caster.Cast(math::Vector3d(5, 0, 0), -kForward,
+      3)));
+
+  caster.Clear();
+  caster.AddCylinder(math::Pose3d::Zero, 1, 2);
+  caster.AddCapsule(math::Pose3d(0, 0, 10, 0, 0, 0), 1, 2);
+  EXPECT_NEAR(8, caster.Cast(kOrigin, math::Vector3d::UnitZ, 100), 1e-9);
+
+  // From inside the rounded end of the capsule, through its cylinder
+  EXPECT_TRUE(std::isinf(caster.Cast(math::Vector3d(0, 0, 11.5),
+      -math::Vector3d::UnitZ, 5)));
+
+  // Closed meshes have an inside too: a cube with outward triangles
+  const math::Vector3d v[8] = {
+      {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1},
+      {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}};
+  const int faces[12][3] = {
+      {0, 2, 1}, {0, 3, 2}, {4, 5, 6}, {4, 6, 7},
+      {0, 1, 5}, {0, 5, 4}, {2, 3, 7}, {2, 7, 6},
+      {1, 2, 6}, {1, 6, 5}, {3, 0, 4}, {3, 4, 7}};
+  Triangles cube;
+  for (const auto &face : faces)
+  {
+    for (const int index : face)
+      cube.push_back(v[index]);
+  }
+  auto mesh = std::make_shared<TriangleMesh>(cube);
+  EXPECT_TRUE(mesh->Closed());
+
+  caster.Clear();
+  caster.AddMesh(math::Pose3d(5, 0, 0, 0, 0, 0), mesh);
+  EXPECT_NEAR(4, caster.Cast(kOrigin, kForward, 100), 1e-9);
+  EXPECT_NEAR(4, caster.Cast(math::Vector3d(10, 0, 0), -kForward, 100),
+      1e-9);
+  EXPECT_TRUE(std::isinf(caster.Cast(math::Vector3d(5, 0, 0), kForward,
+      100)));
+}
+
+/////////////////////////////////////////////////
+TEST(RayCaster, Skip)
+{
+  RayCaster caster;
+  caster.AddSphere(math::Pose3d(3, 0, 0, 0, 0, 0), 0.5);
+  caster.AddSphere(math::Pose3d(6, 0, 0, 0, 0, 0), 0.5);
+
+  EXPECT_NEAR(2.5, caster.Cast(kOrigin, kForward, 100,
+      [](std::size_t) { return false; }), 1e-9);
+  EXPECT_NEAR(5.5, caster.Cast(kOrigin, kForward, 100,
+      [](std::size_t _shape) { return _shape == 0u; }), 1e-9);
+  EXPECT_TRUE(std::isinf(caster.Cast(kOrigin, kForward, 100,
+      [](std::size_t) { return true; })));
+}
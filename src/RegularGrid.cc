@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "gz/sim/RegularGrid.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <gz/common/Console.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Distance within which a position matches an axis with a single
+/// sample, the same as the default tolerance of gz-math grids.
+static constexpr double kTolerance{1e-6};
+
+/// \brief Private data for RegularGrid.
+class gz::sim::RegularGrid::Implementation
+{
+  /// \brief Samples around a position and their weights.
+  public: struct Stencil
+  {
+    /// \brief Offset of each corner of the cell within a time sample.
+    std::array<std::size_t, 8> offsets;
+
+    /// \brief Weight of each corner.
+    std::array<double, 8> weights;
+  };
+
+  /// \brief Find the cell of a spatial axis holding a coordinate.
+  /// \param[in] _axis 1, 2 or 3 for x, y and z.
+  /// \param[in] _coordinate The coordinate.
+  /// \param[out] _index Index of the sample at or before the coordinate.
+  /// \param[out] _weight Weight of the next sample.
+  /// \return False if the coordinate is outside of the grid.
+  public: bool Find(std::size_t _axis, double _coordinate,
+              std::size_t &_index, double &_weight) const;
+
+  /// \brief Compute the samples around a position.
+  /// \param[in] _position The position.
+  /// \param[out] _stencil The samples.
+  /// \return False if the position is outside of the grid.
+  public: bool MakeStencil(const math::Vector3d &_position,
+              Stencil &_stencil) const;
+
+  /// \brief Interpolate a field.
+  /// \param[in] _session Time of the lookup.
+  /// \param[in] _field Index of the field.
+  /// \param[in] _stencil Samples around the position.
+  /// \return The value, or nullopt if all samples are missing.
+  public: std::optional<double> Interpolate(const Session &_session,
+              std::size_t _field, const Stencil &_stencil) const;
+
+  /// \brief Coordinates of the samples along time, x, y and z.
+  public: std::array<std::vector<double>, 4> axes;
+
+  /// \brief Whether each axis is evenly spaced.
+  public: std::array<bool, 4> uniform{false, false, false, false};
+
+  /// \brief Inverse of the spacing of evenly spaced axes.
+  public: std::array<double, 4> inverseStep{0.0, 0.0, 0.0, 0.0};
+
+  /// \brief Names of the fields.
+  public: std::vector<std::string> fields;
+
+  /// \brief Values of the fields.
+  public: std::vector<float> values;
+
+  /// \brief Number of values in each time sample of a field.
+  public: std::size_t cellCount{0u};
+};
+
+//////////////////////////////////////////////////
+bool RegularGrid::Implementation::Find(std::size_t _axis, double _coordinate,
+    std::size_t &_index, double &_weight) const
+{
+  const auto &samples = this->axes[_axis];
+  if (samples.size() == 1u)
+  {
+    _index = 0u;
+    _weight = 0.0;
+    return std::abs(_coordinate - samples.front()) <= kTolerance;
+  }
+
+  if (_coordinate < samples.front() - kTolerance ||
+      _coordinate > samples.back() + kTolerance)
+  {
+    return false;
+  }
+
+  const auto last = samples.size() - 2u;
+  if (this->uniform[_axis])
+  {
+    const double cell =
+        (_coordinate - samples.front()) * this->inverseStep[_axis];
+    _index = cell <= 0.0 ? 0u :
+        std::min(static_cast<std::size_t>(cell), last);
+  }
+  else
+  {
+    const auto next =
+        std::upper_bound(samples.begin(), samples.end(), _coordinate);
+    _index = next == samples.begin() ? 0u : std::min(
+        static_cast<std::size_t>(next - samples.begin()) - 1u, last);
+  }
+  _weight = std::clamp((_coordinate - samples[_index]) /
+      (samples[_index + 1u] - samples[_index]), 0.0, 1.0);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RegularGrid::Implementation::MakeStencil(
+    const math::Vector3d &_position, Stencil &_stencil) const
+{
+  std::array<std::size_t, 3> index;
+  std::array<double, 3> weight;
+  for (std::size_t axis = 0u; axis < 3u; ++axis)
+  {
+    if (!this->Find(axis + 1u, _position[axis], index[axis], weight[axis]))
+      return false;
+  }
+
+  const auto xCount = this->axes[1].size();
+  const auto yCount = this->axes[2].size();
+  std::size_t corner{0u};
+  for (std::size_t dz = 0u; dz < 2u; ++dz)
+  {
+    for (std::size_t dy = 0u; dy < 2u; ++dy)
+    {
+      for (std::size_t dx = 0u; dx < 2u; ++dx, ++corner)
+      {
+        _stencil.weights[corner] = (dx ? weight[0] : 1.0 - weight[0]) *
+            (dy ? weight[1] : 1.0 - weight[1]) *
+            (dz ? weight[2] : 1.0 - weight[2]);
+
+        // Corners past the last sample have no weight
+        const auto x = std::min(index[0] + dx, xCount - 1u);
+        const auto y = std::min(index[1] + dy, yCount - 1u);
+        const auto z = std::min(index[2] + dz, this->axes[3].size() - 1u);
+        _stencil.offsets[corner] = (z * yCount + y) * xCount + x;
+      }
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::optional<double> RegularGrid::Implementation::Interpolate(
+    const Session &_session, std::size_t _field,
+    const Stencil &_stencil) const
+{
+  if (_field >= this->fields.size())
+    return std::nullopt;
+
+  double sum{0.0};
+  double total{0.0};
+  for (std::size_t step = 0u; step < 2u; ++step)
+  {
+    const double timeWeight = step ? _session.weight : 1.0 - _session.weight;
+    if (timeWeight <= 0.0)
+      continue;
+
+    const float *sample = this->values.data() + this->cellCount *
+        (_field * this->axes[0].size() + _session.index + step);
+    for (std::size_t corner = 0u; corner < 8u; ++corner)
+    {
+      const double weight = timeWeight * _stencil.weights[corner];
+      const float value = sample[_stencil.offsets[corner]];
+      if (weight <= 0.0 || std::isnan(value))
+        continue;
+      sum += weight * value;
+      total += weight;
+    }
+  }
+
+  if (total <= 0.0)
+    return std::nullopt;
+  return sum / total;
+}
+
+//////////////////////////////////////////////////
+RegularGrid::RegularGrid(std::array<std::vector<double>, 4> _axes,
+    std::vector<std::string> _fields, std::vector<float> _values)
+  : dataPtr(utils::MakeImpl<Implementation>())
+{
+  std::size_t samples{1u};
+  for (const auto &axis : _axes)
+    samples *= axis.size();
+  if (samples == 0u || _values.size() != samples * _fields.size())
+  {
+    gzerr << "Regular grid has [" << _values.size() << "] values instead "
+          << "of [" << samples * _fields.size() << "], it will be empty."
+          << std::endl;
+    _fields.clear();
+    _values.clear();
+  }
+
+  for (std::size_t axis = 0u; axis < 4u; ++axis)
+  {
+    const auto &coordinates = _axes[axis];
+    if (coordinates.size() < 2u)
+      continue;
+
+    // Spacing within a small fraction of a cell counts as even
+    const double step = (coordinates.back() - coordinates.front()) /
+        static_cast<double>(coordinates.size() - 1u);
+    bool even = step > 0.0;
+    for (std::size_t i = 1u; even && i < coordinates.size(); ++i)
+    {
+      even = std::abs(coordinates[i] - coordinates.front() -
+          static_cast<double>(i) * step) <= 1e-6 * step;
+    }
+    this->dataPtr->uniform[axis] = even;
+    this->dataPtr->inverseStep[axis] = even ? 1.0 / step : 0.0;
+  }
+
+  this->dataPtr->cellCount = _axes[1].size() * _axes[2].size() *
+      _axes[3].size();
+  this->dataPtr->axes = std::move(_axes);
+  this->dataPtr->fields = std::move(_fields);
+  this->dataPtr->values = std::move(_values);
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &RegularGrid::Axis(std::size_t _axis) const
+{
+  return this->dataPtr->axes.at(_axis);
+}
+
+//////////////////////////////////////////////////
+const std::vector<std::string> &RegularGrid::Fields() const
+{
+  return this->dataPtr->fields;
+}
+
+//////////////////////////////////////////////////
+std::optional<std::size_t> RegularGrid::FieldIndex(
+    const std::string &_name) const
+{
+  const auto &fields = this->dataPtr->fields;
+  const auto it = std::find(fields.begin(), fields.end(), _name);
+  if (it == fields.end())
+    return std::nullopt;
+  return static_cast<std::size_t>(it - fields.begin());
+}
+
+//////////////////////////////////////////////////
+const std::vector<float> &RegularGrid::Values() const
+{
+  return this->dataPtr->values;
+}
+
+//////////////////////////////////////////////////
+RegularGrid::Session RegularGrid::CreateSession() const
+{
+  return Session();
+}
+
+//////////////////////////////////////////////////
+std::optional<RegularGrid::Session> RegularGrid::StepTo(
+    const Session &_session, double _time) const
+{
+  // Data with a single time sample holds at any time
+  const auto &times = this->dataPtr->axes[0];
+  if (times.size() <= 1u)
+    return Session();
+  if (_time < times.front() || _time > times.back())
+    return std::nullopt;
+
+  // Simulation time moves forward by less than a sample per step, so the
+  // session usually stays in its sample or moves to the next one
+  Session session;
+  std::size_t index = std::min(_session.index, times.size() - 1u);
+  if (times[index] > _time)
+  {
+    index = static_cast<std::size_t>(std::upper_bound(times.begin(),
+        times.end(), _time) - times.begin()) - 1u;
+  }
+  for (std::size_t steps = 0u; index + 1u < times.size() &&
+       times[index + 1u] <= _time; ++steps)
+  {
+    if (steps == 4u)
+    {
+      index = static_cast<std::size_t>(std::upper_bound(times.begin(),
+          times.end(), _time) - times.begin()) - 1u;
+      break;
+    }
+    ++index;
+  }
+
+  session.index = index;
+  if (index + 1u < times.size())
+  {
+    session.weight = (_time - times[index]) /
+        (times[index + 1u] - times[index]);
+  }
+  return session;
+}
+
+//////////////////////////////////////////////////
+std::optional<double> RegularGrid::LookUp(const Session &_session,
+    std::size_t _field, const math::Vector3d &_position) const
+{
+  Implementation::Stencil stencil;
+  if (!this->dataPtr->MakeStencil(_position, stencil))
+    return std::nullopt;
+  return this->dataPtr->Interpolate(_session, _field, stencil);
+}
+
+//////////////////////////////////////////////////
+void RegularGrid::LookUp(const Session &_session,
+    const std::vector<std::size_t> &_fields,
+    const math::Vector3d &_position,
+    std::vector<std::optional<double>> &_values) const
+{
+  _values.assign(_fields.size(), std::nullopt);
+  Implementation::Stencil stencil;
+  if (!this->dataPtr->MakeStencil(_position, stencil))
+    return;
+  for (std::size_t i = 0u; i < _fields.size(); ++i)
+    _values[i] = this->dataPtr->Interpolate(_session, _fields[i], stencil);
+}
+
+//////////////////////////////////////////////////
+void RegularGrid::LookUp(const Session &_session, std::size_t _field,
+    const std::vector<math::Vector3d> &_positions,
+    std::vector<std::optional<double>> &_values) const
+{
+  _values.assign(_positions.size(), std::nullopt);
+  Implementation::Stencil stencil;
+  for (std::size_t i = 0u; i < _positions.size(); ++i)
+  {
+    if (this->dataPtr->MakeStencil(_positions[i], stencil))
+      _values[i] = this->dataPtr->Interpolate(_session, _field, stencil);
+  }
+}
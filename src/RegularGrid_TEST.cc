@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "gz/sim/RegularGrid.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+/// \brief Make a 2x2x2 grid at times 0 and 10, with two fields. The first
+/// field is x + 2y + 4z at time 0, plus 8 at time 10, and the second is its
+/// opposite.
+RegularGrid makeGrid()
+{
+  std::vector<float> values;
+  for (float sign : {1.0f, -1.0f})
+  {
+    for (std::size_t t = 0; t < 2u; ++t)
+    {
+      for (std::size_t z = 0; z < 2u; ++z)
+      {
+        for (std::size_t y = 0; y < 2u; ++y)
+        {
+          for (std::size_t x = 0; x < 2u; ++x)
+          {
+            values.push_back(sign * static_cast<float>(
+                x + 2 * y + 4 * z + 8 * t));
+          }
+        }
+      }
+    }
+  }
+  return RegularGrid({{{0, 10}, {0, 1}, {0, 1}, {0, 1}}},
+      {"up", "down"}, values);
+}
+
+/////////////////////////////////////////////////
+TEST(RegularGrid, Fields)
+{
+  const auto grid = makeGrid();
+  ASSERT_EQ(2u, grid.Fields().size());
+  EXPECT_EQ(0u, grid.FieldIndex("up"));
+  EXPECT_EQ(1u, grid.FieldIndex("down"));
+  EXPECT_FALSE(grid.FieldIndex("sideways").has_value());
+  EXPECT_EQ(32u, grid.Values().size());
+  EXPECT_EQ(std::vector<double>({0, 10}), grid.Axis(0));
+
+  // Values which don't fill the grid are dropped
+  RegularGrid empty({{{0}, {0, 1}, {0}, {0}}}, {"a"}, {1.0f});
+  EXPECT_TRUE(empty.Fields().empty());
+  EXPECT_TRUE(empty.Values().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(RegularGrid, Interpolate)
+{
+  const auto grid = makeGrid();
+  const auto session = grid.CreateSession();
+
+  // Samples, and trilinear interpolation between them
+  EXPECT_DOUBLE_EQ(0.0, *grid.LookUp(session, 0, {0, 0, 0}));
+  EXPECT_DOUBLE_EQ(7.0, *grid.LookUp(session, 0, {1, 1, 1}));
+  EXPECT_DOUBLE_EQ(-6.0, *grid.LookUp(session, 1, {0, 1, 1}));
+  EXPECT_DOUBLE_EQ(3.5, *grid.LookUp(session, 0, {0.5, 0.5, 0.5}));
+  EXPECT_DOUBLE_EQ(1.25, *grid.LookUp(session, 0, {0.25, 0.5, 0}));
+
+  // Positions outside of the grid, and fields which don't exist
+  EXPECT_FALSE(grid.LookUp(session, 0, {1.5, 0, 0}).has_value());
+  EXPECT_FALSE(grid.LookUp(session, 0, {0, -0.1, 0}).has_value());
+  EXPECT_FALSE(grid.LookUp(session, 2, {0, 0, 0}).has_value());
+
+  // Interpolation in time
+  auto later = grid.StepTo(session, 5.0);
+  ASSERT_TRUE(later.has_value());
+  EXPECT_DOUBLE_EQ(4.0, *grid.LookUp(*later, 0, {0, 0, 0}));
+  EXPECT_DOUBLE_EQ(-7.5, *grid.LookUp(*later, 1, {0.5, 0.5, 0.5}));
+}
+
+/////////////////////////////////////////////////
+TEST(RegularGrid, MissingValues)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  RegularGrid grid({{{0}, {0, 1}, {0}, {0}}}, {"a"}, {2.0f, nan});
+  const auto session = grid.CreateSession();
+
+  // Missing samples are left out, single-sample axes must match exactly
+  EXPECT_DOUBLE_EQ(2.0, *grid.LookUp(session, 0, {0.5, 0, 0}));
+  EXPECT_FALSE(grid.LookUp(session, 0, {1, 0, 0}).has_value());
+  EXPECT_FALSE(grid.LookUp(session, 0, {0.5, 0.1, 0}).has_value());
+
+  // Data with a single time holds at any time
+  EXPECT_TRUE(grid.StepTo(session, 1e6).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(RegularGrid, Batches)
+{
+  const auto grid = makeGrid();
+  const auto session = grid.CreateSession();
+
+  std::vector<std::optional<double>> values;
+  grid.LookUp(session, {1, 0, 1}, {1, 0, 0}, values);
+  ASSERT_EQ(3u, values.size());
+  EXPECT_DOUBLE_EQ(-1.0, *values[0]);
+  EXPECT_DOUBLE_EQ(1.0, *values[1]);
+  EXPECT_DOUBLE_EQ(-1.0, *values[2]);
+
+  grid.LookUp(session, {0}, {2, 0, 0}, values);
+  ASSERT_EQ(1u, values.size());
+  EXPECT_FALSE(values[0].has_value());
+
+  grid.LookUp(session, 0, {{0, 1, 0}, {5, 0, 0}, {0, 0, 1}}, values);
+  ASSERT_EQ(3u, values.size());
+  EXPECT_DOUBLE_EQ(2.0, *values[0]);
+  EXPECT_FALSE(values[1].has_value());
+  EXPECT_DOUBLE_EQ(4.0, *values[2]);
+}
+
+/////////////////////////////////////////////////
+TEST(RegularGrid, StepTo)
+{
+  std::vector<double> times;
+  for (int t = 0; t <= 100; ++t)
+    times.push_back(t);
+  std::vector<float> values(times.size());
+  for (std::size_t t = 0; t < values.size(); ++t)
+    values[t] = static_cast<float>(t);
+  RegularGrid grid({times, {0}, {0}, {0}}, {"t"}, values);
+
+  // Forward, by small and large steps, then backward
+  auto session = grid.StepTo(grid.CreateSession(), 0.5);
+  for (double time : {0.5, 1.0, 2.25, 80.5, 100.0, 3.75})
+  {
+    session = grid.StepTo(*session, time);
+    ASSERT_TRUE(session.has_value()) << time;
+    EXPECT_DOUBLE_EQ(time, *grid.LookUp(*session, 0, {0, 0, 0})) << time;
+  }
+
+  // Outside of the data
+  EXPECT_FALSE(grid.StepTo(*session, -1.0).has_value());
+  EXPECT_FALSE(grid.StepTo(*session, 100.5).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(RegularGrid, UnevenAxis)
+{
+  RegularGrid grid({{{0}, {0, 1, 3, 7}, {0}, {0}}}, {"x"},
+      {0.0f, 1.0f, 3.0f, 7.0f});
+  const auto session = grid.CreateSession();
+  for (double x : {0.0, 0.5, 1.0, 2.0, 5.5, 7.0})
+    EXPECT_DOUBLE_EQ(x, *grid.LookUp(session, 0, {x, 0, 0})) << x;
+  EXPECT_FALSE(grid.LookUp(session, 0, {7.5, 0, 0}).has_value());
+}
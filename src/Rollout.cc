@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "gz/sim/Rollout.hh"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+
+#include "gz/sim/EventManager.hh"
+#include "gz/sim/Util.hh"
+
+#include "SystemInternal.hh"
+#include "ThreadPool.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Private data for Rollout.
+class gz::sim::Rollout::Implementation
+{
+  /// \brief Add a system and configure it.
+  /// \param[in] _system The system.
+  /// \param[in] _sdf SDF passed to Configure.
+  public: void AddSystem(SystemInternal _system,
+              const std::shared_ptr<const sdf::Element> &_sdf);
+
+  /// \brief Fork of the world's entity component manager.
+  public: EntityComponentManager ecm;
+
+  /// \brief Event manager of the rollout's systems.
+  public: EventManager eventMgr;
+
+  /// \brief Systems stepped by the rollout, in the order they were added.
+  public: std::vector<SystemInternal> systems;
+
+  /// \brief Time of the latest step.
+  public: UpdateInfo info;
+};
+
+//////////////////////////////////////////////////
+void Rollout::Implementation::AddSystem(SystemInternal _system,
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  _system.parentEntity = worldEntity(this->ecm);
+  if (nullptr != _system.configure)
+  {
+    _system.configure->Configure(_system.parentEntity, _sdf, this->ecm,
+        this->eventMgr);
+  }
+  this->systems.push_back(std::move(_system));
+}
+
+//////////////////////////////////////////////////
+Rollout::Rollout(const EntityComponentManager &_ecm, const UpdateInfo &_info)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->ecm.ForkFrom(_ecm);
+  this->dataPtr->info = _info;
+  this->dataPtr->info.paused = false;
+}
+
+//////////////////////////////////////////////////
+Rollout::~Rollout() = default;
+
+//////////////////////////////////////////////////
+void Rollout::AddSystem(const SystemPluginPtr &_system,
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  this->dataPtr->AddSystem(SystemInternal(_system, kNullEntity), _sdf);
+}
+
+//////////////////////////////////////////////////
+void Rollout::AddSystem(const std::shared_ptr<System> &_system,
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  this->dataPtr->AddSystem(SystemInternal(_system, kNullEntity), _sdf);
+}
+
+//////////////////////////////////////////////////
+void Rollout::Step(const uint64_t _iterations)
+{
+  GZ_PROFILE("Rollout::Step");
+  auto &ecm = this->dataPtr->ecm;
+  auto &info = this->dataPtr->info;
+  for (uint64_t i = 0; i < _iterations; ++i)
+  {
+    ++info.iterations;
+    info.simTime += info.dt;
+
+    for (auto &system : this->dataPtr->systems)
+    {
+      if (nullptr != system.preupdate)
+        system.preupdate->PreUpdate(info, ecm);
+    }
+    for (auto &system : this->dataPtr->systems)
+    {
+      if (nullptr != system.update)
+        system.update->Update(info, ecm);
+    }
+    for (auto &system : this->dataPtr->systems)
+    {
+      if (nullptr != system.postupdate)
+        system.postupdate->PostUpdate(info, ecm);
+    }
+
+    // Same bookkeeping as the simulation runner at the end of a step
+    ecm.ClearNewlyCreatedEntities();
+    ecm.ProcessRemoveEntityRequests();
+    ecm.ClearRemovedComponents();
+    ecm.SetAllComponentsUnchanged();
+  }
+}
+
+//////////////////////////////////////////////////
+void Rollout::StepAll(const std::vector<std::unique_ptr<Rollout>> &_rollouts,
+    const uint64_t _iterations)
+{
+  GZ_PROFILE("Rollout::StepAll");
+  // Rollouts take about the same time, so each one is a chunk of its own
+  ThreadPool::Shared().ParallelFor(_rollouts.size(), 1u,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+          _rollouts[i]->Step(_iterations);
+      });
+}
+
+//////////////////////////////////////////////////
+const EntityComponentManager &Rollout::EntityCompMgr() const
+{
+  return this->dataPtr->ecm;
+}
+
+//////////////////////////////////////////////////
+const UpdateInfo &Rollout::Info() const
+{
+  return this->dataPtr->info;
+}
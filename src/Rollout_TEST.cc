@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Rollout.hh"
+#include "gz/sim/Types.hh"
+
+#include "../test/helpers/EnvTestFixture.hh"
+#include "plugins/MockSystem.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+class RolloutTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(RolloutTest, StepForks)
+{
+  EntityComponentManager ecm;
+  Entity world = ecm.CreateEntity();
+  ecm.CreateComponent(world, components::World());
+  ecm.CreateComponent(world, components::Name("world"));
+  Entity body = ecm.CreateEntity();
+  ecm.CreateComponent(body, components::Pose(math::Pose3d::Zero));
+
+  UpdateInfo info;
+  info.iterations = 100;
+  info.simTime = 1s;
+  info.dt = 10ms;
+  info.paused = true;
+
+  // Each rollout moves the body by a different step
+  std::vector<std::unique_ptr<Rollout>> rollouts;
+  std::vector<std::shared_ptr<MockSystem>> systems;
+  for (int i = 0; i < 8; ++i)
+  {
+    auto system = std::make_shared<MockSystem>();
+    system->configureCallback = [&](const Entity &_entity,
+        const std::shared_ptr<const sdf::Element> &,
+        EntityComponentManager &, EventManager &)
+    {
+      EXPECT_EQ(world, _entity);
+    };
+    system->preUpdateCallback = [i, body](const UpdateInfo &,
+        EntityComponentManager &_ecm)
+    {
+      auto pose = _ecm.Component<components::Pose>(body);
+      pose->Data().Pos().X() += i;
+    };
+    rollouts.push_back(std::make_unique<Rollout>(ecm, info));
+    rollouts.back()->AddSystem(system);
+    systems.push_back(system);
+  }
+
+  Rollout::StepAll(rollouts, 10);
+
+  for (int i = 0; i < 8; ++i)
+  {
+    EXPECT_EQ(1u, systems[i]->configureCallCount);
+    EXPECT_EQ(10u, systems[i]->preUpdateCallCount);
+    EXPECT_EQ(10u, systems[i]->postUpdateCallCount);
+
+    const auto &rolloutInfo = rollouts[i]->Info();
+    EXPECT_EQ(110u, rolloutInfo.iterations);
+    EXPECT_EQ(1100ms, rolloutInfo.simTime);
+    EXPECT_FALSE(rolloutInfo.paused);
+
+    const auto &forkEcm = rollouts[i]->EntityCompMgr();
+    EXPECT_DOUBLE_EQ(10.0 * i,
+        forkEcm.Component<components::Pose>(body)->Data().Pos().X());
+
+    // Components that aren't written stay shared
+    EXPECT_EQ(ecm.Component<components::Name>(world),
+        forkEcm.Component<components::Name>(world));
+  }
+
+  // The forked world doesn't change
+  EXPECT_EQ(math::Pose3d::Zero,
+      ecm.Component<components::Pose>(body)->Data());
+}
@@ -15,6 +15,11 @@
  *
 */
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/common/Profiler.hh>
 #include <sdf/Types.hh>
@@ -85,6 +90,7 @@
 #include "gz/sim/components/World.hh"
 
 #include "rendering/MaterialParser/MaterialParser.hh"
+#include "ThreadPool.hh"
 
 class gz::sim::SdfEntityCreatorPrivate
 {
@@ -108,6 +114,10 @@ class gz::sim::SdfEntityCreatorPrivate
 
   /// \brief Parse Gazebo defined materials for visuals
   public: MaterialParser materialParser;
+
+  /// \brief Load the plugins of the new models, sensors and visuals, in
+  /// that order, and forget about them.
+  public: void LoadNewPlugins();
 };
 
 using namespace gz;
@@ -191,6 +201,62 @@ static Entity FindDescendentLinkEntityByName(const std::string &_name,
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Count the entities created for a model by
+/// SdfEntityCreator::CreateEntities, including its descendants. This must be
+/// kept in sync with the functions that create entities.
+/// \param[in] _model SDF model object.
+/// \return Number of entities.
+static std::size_t CountEntities(const sdf::Model *_model)
+{
+  std::size_t count{1u};
+  for (uint64_t linkIndex = 0; linkIndex < _model->LinkCount(); ++linkIndex)
+  {
+    const auto *link = _model->LinkByIndex(linkIndex);
+
+    // Each light has a visual
+    count += 1u + link->VisualCount() + link->CollisionCount() +
+        2u * link->LightCount() + link->SensorCount() +
+        link->ParticleEmitterCount() + link->ProjectorCount();
+  }
+  for (uint64_t jointIndex = 0; jointIndex < _model->JointCount();
+      ++jointIndex)
+  {
+    count += 1u + _model->JointByIndex(jointIndex)->SensorCount();
+  }
+  for (uint64_t modelIndex = 0; modelIndex < _model->ModelCount();
+      ++modelIndex)
+  {
+    count += CountEntities(_model->ModelByIndex(modelIndex));
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+void SdfEntityCreatorPrivate::LoadNewPlugins()
+{
+  // Load all model plugins afterwards, so we get scoped name for nested models.
+  for (const auto &[entity, plugins] : this->newModels)
+  {
+    this->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+  }
+  this->newModels.clear();
+
+  // Load sensor plugins after model, so we get scoped name.
+  for (const auto &[entity, plugins] : this->newSensors)
+  {
+    this->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+  }
+  this->newSensors.clear();
+
+  // Load visual plugins after model, so we get scoped name.
+  for (const auto &[entity, plugins] : this->newVisuals)
+  {
+    this->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+  }
+  this->newVisuals.clear();
+}
+
 //////////////////////////////////////////////////
 SdfEntityCreator::SdfEntityCreator(EntityComponentManager &_ecm,
           EventManager &_eventManager)
@@ -260,12 +326,14 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
   }
 
   // Models
+  std::vector<const sdf::Model *> models;
   for (uint64_t modelIndex = 0; modelIndex < _world->ModelCount();
       ++modelIndex)
   {
-    auto model = _world->ModelByIndex(modelIndex);
-    auto modelEntity = this->CreateEntities(model);
-
+    models.push_back(_world->ModelByIndex(modelIndex));
+  }
+  for (const auto modelEntity : this->CreateEntities(models))
+  {
     this->SetParent(modelEntity, worldEntity);
   }
 
@@ -347,30 +415,141 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Model *_model)
 {
   GZ_PROFILE("SdfEntityCreator::CreateEntities(sdf::Model)");
 
+  // Views are updated once for the whole model, before loading its plugins
+  this->dataPtr->ecm->BeginBulkInsert(CountEntities(_model));
   auto ent = this->CreateEntities(_model, false);
+  this->dataPtr->ecm->EndBulkInsert();
+  this->dataPtr->LoadNewPlugins();
 
-  // Load all model plugins afterwards, so we get scoped name for nested models.
-  for (const auto &[entity, plugins] : this->dataPtr->newModels)
+  return ent;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> SdfEntityCreator::CreateEntities(
+    const std::vector<const sdf::Model *> &_models)
+{
+  GZ_PROFILE("SdfEntityCreator::CreateEntities(sdf::Models)");
+
+  std::vector<Entity> modelEntities;
+  modelEntities.reserve(_models.size());
+
+  // Below this, staging isn't worth it
+  constexpr std::size_t kMinStagedModels{16u};
+  auto &pool = ThreadPool::Shared();
+  if (_models.size() < kMinStagedModels || pool.ThreadCount() == 0u)
   {
-    this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+    for (const auto *model : _models)
+      modelEntities.push_back(this->CreateEntities(model));
+    return modelEntities;
   }
-  this->dataPtr->newModels.clear();
 
-  // Load sensor plugins after model, so we get scoped name.
-  for (const auto &[entity, plugins] : this->dataPtr->newSensors)
+  // Each model gets the range of IDs it would get if the models were created
+  // one after the other
+  std::vector<Entity> firstIds{this->dataPtr->ecm->EntityCreateOffset()};
+  for (const auto *model : _models)
+    firstIds.push_back(firstIds.back() + CountEntities(model));
+
+  /// \brief Plugins of a staged model and its descendants.
+  struct StagedPlugins
+  {
+    /// \brief Plugins of the model and its nested models.
+    std::map<Entity, sdf::Plugins> models;
+
+    /// \brief Plugins of the model's sensors.
+    std::map<Entity, sdf::Plugins> sensors;
+
+    /// \brief Plugins of the model's visuals.
+    std::map<Entity, sdf::Plugins> visuals;
+  };
+
+  /// \brief Models created in the same staging manager.
+  struct Stage
+  {
+    /// \brief Staging manager.
+    std::unique_ptr<EntityComponentManager> ecm;
+
+    /// \brief Plugins of each model, loaded once the stage is committed.
+    std::vector<StagedPlugins> plugins;
+
+    /// \brief False if the entities didn't get the expected IDs.
+    bool valid{true};
+  };
+
+  const std::size_t modelsPerStage = std::max<std::size_t>(1u,
+      _models.size() / (4u * (pool.ThreadCount() + 1u)));
+  std::vector<Stage> stages(
+      (_models.size() + modelsPerStage - 1u) / modelsPerStage);
+
+  pool.ParallelFor(stages.size(), 1u,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t s = _begin; s < _end; ++s)
+        {
+          GZ_PROFILE("StageModels");
+          const std::size_t first = s * modelsPerStage;
+          const std::size_t last = std::min(first + modelsPerStage,
+              _models.size());
+
+          auto &stage = stages[s];
+          stage.ecm = std::make_unique<EntityComponentManager>();
+          stage.ecm->SetComponentStorage(
+              this->dataPtr->ecm->ComponentStorage());
+          stage.ecm->SetEntityCreateOffset(firstIds[first]);
+
+          // Copying the creator reuses its parsed materials
+          SdfEntityCreator creator(*this);
+          creator.dataPtr->ecm = stage.ecm.get();
+
+          for (std::size_t i = first; i < last; ++i)
+          {
+            const Entity modelEntity =
+                creator.CreateEntities(_models[i], false);
+            stage.valid = stage.valid && modelEntity == firstIds[i] + 1u &&
+                stage.ecm->EntityCreateOffset() == firstIds[i + 1u];
+
+            StagedPlugins plugins;
+            plugins.models.swap(creator.dataPtr->newModels);
+            plugins.sensors.swap(creator.dataPtr->newSensors);
+            plugins.visuals.swap(creator.dataPtr->newVisuals);
+            stage.plugins.push_back(std::move(plugins));
+          }
+        }
+      });
+
+  if (!std::all_of(stages.begin(), stages.end(),
+      [](const Stage &_stage) { return _stage.valid; }))
   {
-    this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+    gzerr << "Internal error: staged models didn't get the expected entity "
+          << "IDs, creating them one after the other." << std::endl;
+    for (const auto *model : _models)
+      modelEntities.push_back(this->CreateEntities(model));
+    return modelEntities;
   }
-  this->dataPtr->newSensors.clear();
 
-  // Load visual plugins after model, so we get scoped name.
-  for (const auto &[entity, plugins] : this->dataPtr->newVisuals)
+  // Commit all stages before loading plugins, which may create entities
+  for (auto &stage : stages)
   {
-    this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+    if (!this->dataPtr->ecm->MoveEntitiesFrom(*stage.ecm))
+    {
+      gzerr << "Internal error: failed to commit staged models." << std::endl;
+    }
   }
-  this->dataPtr->newVisuals.clear();
 
-  return ent;
+  // Load the plugins of each model as if it was created on its own
+  std::size_t modelIndex{0u};
+  for (auto &stage : stages)
+  {
+    for (auto &plugins : stage.plugins)
+    {
+      modelEntities.push_back(firstIds[modelIndex++] + 1u);
+      this->dataPtr->newModels.swap(plugins.models);
+      this->dataPtr->newSensors.swap(plugins.sensors);
+      this->dataPtr->newVisuals.swap(plugins.visuals);
+      this->dataPtr->LoadNewPlugins();
+    }
+  }
+
+  return modelEntities;
 }
 
 //////////////////////////////////////////////////
@@ -957,11 +1136,9 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Sensor *_sensor)
   }
   else if (_sensor->Type() == sdf::SensorType::LIDAR)
   {
-    // \todo(anyone) Implement CPU-based lidar
-    // this->dataPtr->ecm->CreateComponent(sensorEntity,
-    //     components::Lidar(*_sensor));
-    gzwarn << "Sensor type LIDAR not supported yet. Try using"
-      << "a GPU LIDAR instead." << std::endl;
+    // Served by the CpuLidar system
+    this->dataPtr->ecm->CreateComponent(sensorEntity,
+        components::Lidar(*_sensor));
   }
   else if (_sensor->Type() == sdf::SensorType::DEPTH_CAMERA)
   {
@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <sdf/Box.hh>
 #include <sdf/Capsule.hh>
@@ -1273,3 +1277,106 @@ TEST_F(SdfEntityCreatorTest, EachRemovedRecursiveRemoved)
   EXPECT_EQ(0u, removedCount<components::Collision>(ecm));
   EXPECT_EQ(0u, removedCount<components::Visual>(ecm));
 }
+
+/////////////////////////////////////////////////
+TEST_F(SdfEntityCreatorTest, CreateManyModels)
+{
+  // Enough models to be staged concurrently
+  std::string sdfStr = R"(<?xml version="1.0" ?>
+<sdf version="1.9">
+  <world name="many_models">)";
+  for (int i = 0; i < 40; ++i)
+  {
+    sdfStr += R"(
+    <model name="model_)" + std::to_string(i) + R"(">
+      <pose>)" + std::to_string(i) + R"( 0 0 0 0 0</pose>
+      <link name="base">
+        <visual name="visual">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </visual>
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+        <light name="light" type="point"/>
+        <sensor name="imu" type="imu"/>
+      </link>
+      <link name="arm"/>
+      <joint name="joint" type="revolute">
+        <parent>base</parent>
+        <child>arm</child>
+        <axis><xyz>0 0 1</xyz></axis>
+      </joint>
+      <model name="nested">
+        <link name="link"/>
+      </model>
+    </model>)";
+  }
+  sdfStr += R"(
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  auto errors = root.LoadSdfString(sdfStr);
+  ASSERT_TRUE(errors.empty()) << errors;
+  const auto *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  std::vector<const sdf::Model *> models;
+  for (uint64_t i = 0; i < world->ModelCount(); ++i)
+    models.push_back(world->ModelByIndex(i));
+
+  // Create the models in one batch
+  SdfEntityCreator creator(this->ecm, this->evm);
+  auto modelEntities = creator.CreateEntities(models);
+  ASSERT_EQ(models.size(), modelEntities.size());
+
+  // And one after the other
+  EntityComponentManager expectedEcm;
+  EventManager expectedEvm;
+  SdfEntityCreator expectedCreator(expectedEcm, expectedEvm);
+  for (std::size_t i = 0; i < models.size(); ++i)
+  {
+    EXPECT_EQ(expectedCreator.CreateEntities(models[i]), modelEntities[i]);
+  }
+
+  // Both have the same entities, with the same components
+  EXPECT_EQ(expectedEcm.EntityCount(), this->ecm.EntityCount());
+  EXPECT_EQ(expectedEcm.EntityCreateOffset(), this->ecm.EntityCreateOffset());
+  for (const auto &vertex : expectedEcm.Entities().Vertices())
+  {
+    const Entity entity = vertex.first;
+    ASSERT_TRUE(this->ecm.HasEntity(entity)) << entity;
+    EXPECT_EQ(expectedEcm.ComponentTypes(entity),
+        this->ecm.ComponentTypes(entity)) << entity;
+    EXPECT_EQ(expectedEcm.ParentEntity(entity),
+        this->ecm.ParentEntity(entity)) << entity;
+
+    auto expectedName = expectedEcm.Component<components::Name>(entity);
+    auto name = this->ecm.Component<components::Name>(entity);
+    ASSERT_NE(nullptr, expectedName);
+    ASSERT_NE(nullptr, name);
+    EXPECT_EQ(expectedName->Data(), name->Data());
+
+    auto expectedCanonical =
+        expectedEcm.Component<components::ModelCanonicalLink>(entity);
+    auto canonical = this->ecm.Component<components::ModelCanonicalLink>(
+        entity);
+    ASSERT_EQ(nullptr == expectedCanonical, nullptr == canonical);
+    if (canonical)
+      EXPECT_EQ(expectedCanonical->Data(), canonical->Data());
+  }
+
+  // The moved entities are in the views
+  std::size_t linkCount{0u};
+  this->ecm.EachNew<components::Link, components::ParentEntity>(
+      [&](const Entity &, const components::Link *,
+          const components::ParentEntity *) -> bool
+      {
+        ++linkCount;
+        return true;
+      });
+  EXPECT_EQ(120u, linkCount);
+
+  // New entities get the following IDs
+  EXPECT_EQ(expectedEcm.CreateEntity(), this->ecm.CreateEntity());
+}
@@ -19,6 +19,11 @@
 
 #include <ctype.h>
 #include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <sdf/sdf.hh>
@@ -271,32 +276,124 @@ namespace sdf_generator
   }
 
   /////////////////////////////////////////////////
-  std::optional<std::string> generateWorld(
-      const EntityComponentManager &_ecm, const Entity &_entity,
-      const IncludeUriMap &_includeUriMap,
+  /// \brief Get the generator configuration of a top level model.
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _modelEntity Model entity
+  /// \param[in] _config Configuration for the world generator
+  /// \returns The global configuration merged with the model's override.
+  static msgs::SdfGeneratorConfig::EntityGeneratorConfig modelGenConfig(
+      const EntityComponentManager &_ecm, const Entity _modelEntity,
       const msgs::SdfGeneratorConfig &_config)
   {
-    sdf::ElementPtr elem = std::make_shared<sdf::Element>();
-    sdf::initFile("root.sdf", elem);
-    auto worldElem = elem->AddElement("world");
-    if (!updateWorldElement(worldElem, _ecm, _entity, _includeUriMap, _config))
-      return std::nullopt;
+    const std::string modelName =
+        scopedName(_modelEntity, _ecm, "::", false);
 
-    return elem->ToString("");
+    auto modelConfig = _config.global_entity_gen_config();
+    auto modelConfigIt =
+        _config.override_entity_gen_configs().find(modelName);
+    if (modelConfigIt != _config.override_entity_gen_configs().end())
+    {
+      mergeWithOverride(modelConfig, modelConfigIt->second);
+    }
+    return modelConfig;
   }
 
   /////////////////////////////////////////////////
-  bool updateWorldElement(sdf::ElementPtr _elem,
-                          const EntityComponentManager &_ecm,
-                          const Entity &_entity,
-                          const IncludeUriMap &_includeUriMap,
-                          const msgs::SdfGeneratorConfig &_config)
+  /// \brief Add the element of a top level model to a world, either as an
+  /// expanded model or as an include.
+  /// \param[in, out] _elem World element
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _modelEntity Model entity
+  /// \param[in] _modelDir Directory containing the model
+  /// \param[in] _worldDir Directory containing the world
+  /// \param[in] _modelConfig Configuration of the model
+  /// \param[in] _includeUriMap Map from file paths to URIs used to preserve
+  /// included Fuel models
+  /// \returns The added element.
+  static sdf::ElementPtr addModelElement(const sdf::ElementPtr &_elem,
+      const EntityComponentManager &_ecm, const Entity _modelEntity,
+      const std::string &_modelDir, const std::string &_worldDir,
+      const msgs::SdfGeneratorConfig::EntityGeneratorConfig &_modelConfig,
+      const IncludeUriMap &_includeUriMap)
   {
-    const auto *worldSdf = _ecm.Component<components::WorldSdf>(_entity);
+    bool modelFromInclude = isModelFromInclude(_modelDir, _worldDir);
+    auto uriMapIt = _includeUriMap.find(_modelDir);
 
-    if (nullptr == worldSdf)
-      return false;
+    sdf::ElementPtr added;
+    if (_modelConfig.expand_include_tags().data() || !modelFromInclude)
+    {
+      added = _elem->AddElement("model");
+      updateModelElement(added, _ecm, _modelEntity);
+
+      // Check & update possible //model/include(s)
+      if (!_modelConfig.expand_include_tags().data())
+      {
+        updateModelElementWithNestedInclude(added,
+              _modelConfig.save_fuel_version().data(), _includeUriMap);
+      }
+    }
+    else if (uriMapIt != _includeUriMap.end())
+    {
+      // The fuel URI might have a version number. If it does, we remove
+      // it unless saveFuelModelVersion is set to true.
+      // Check if this is a fuel URI. We assume that it is a fuel URI if
+      // the scheme is http or https.
+      common::URI uri(uriMapIt->second);
+      if (uri.Scheme() == "http" || uri.Scheme() == "https")
+      {
+        removeVersionFromUri(uri);
+      }
+
+      if (_modelConfig.save_fuel_version().data())
+      {
+        // Find out the model version from the file path. Note that we
+        // do this from the file path instead of the Fuel URI because the
+        // URI may not contain version information.
+        //
+        // We are assuming here that, for Fuel models, the directory
+        // containing the sdf file has the same name as the model version.
+        // For example, if the uri is
+        // https://example.org/1.0/test/models/Backpack
+        // the path to the directory containing the sdf file (_modelDir)
+        // will be:
+        // $HOME/.gz/fuel/example.org/test/models/Backpack/2/
+        // and the basename of the directory is "1", which is the model
+        // version.
+        //
+        // However, if symlinks (or other types of indirection) are used,
+        // the pattern of _modelDir will be different. The assumption here
+        // is that regardless of the indirection, the name of the
+        // directory containing the sdf file can be used as the version
+        // number
+        //
+        uri.Path() /= common::basename(_modelDir);
+      }
+
+      added = _elem->AddElement("include");
+      updateIncludeElement(added, _ecm, _modelEntity, uri.Str());
+    }
+    else
+    {
+      // The model is not in the includeUriMap, but expandIncludeTags =
+      // false, so we will assume that its uri is the file path of the
+      // model on the local machine
+      added = _elem->AddElement("include");
+      const std::string uri = "file://" + _modelDir;
+      updateIncludeElement(added, _ecm, _modelEntity, uri);
+    }
+    return added;
+  }
 
+  /////////////////////////////////////////////////
+  /// \brief Copy the SDF of a world without its models and lights, which
+  /// are added back from the data in the ECM.
+  /// \param[in, out] _elem World element
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _entity World entity
+  /// \returns False if the world has no SDF.
+  static bool copyWorldElement(const sdf::ElementPtr &_elem,
+      const EntityComponentManager &_ecm, const Entity _entity)
+  {
     if (!copySdf(_ecm.Component<components::WorldSdf>(_entity), _elem))
       return false;
 
@@ -326,9 +423,40 @@ namespace sdf_generator
     {
       _elem->RemoveChild(e);
     }
+    return true;
+  }
 
+  /////////////////////////////////////////////////
+  /// \brief Add the models and lights of a world to its element, or print
+  /// them one at a time so that the whole world is never held in memory.
+  /// \param[in, out] _elem World element, from copyWorldElement
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _entity World entity
+  /// \param[in] _includeUriMap Map from file paths to URIs used to preserve
+  /// included Fuel models
+  /// \param[in] _config Configuration for the world generator
+  /// \param[out] _out Stream to print the elements to, in which case they
+  /// are removed from _elem after being printed, or nullptr to keep them.
+  /// \param[in, out] _cache Cache of the models printed to _out, or nullptr.
+  static void addWorldEntities(const sdf::ElementPtr &_elem,
+      const EntityComponentManager &_ecm, const Entity _entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config, std::ostream *_out,
+      ModelSdfCache *_cache)
+  {
+    const auto *worldSdf = _ecm.Component<components::WorldSdf>(_entity);
     auto worldDir = common::parentPath(worldSdf->Data().Element()->FilePath());
 
+    // Children of <world> are printed with the indentation of the document
+    const std::string prefix{"    "};
+    auto print = [&](const sdf::ElementPtr &_child)
+    {
+      const std::string text = _child->ToString(prefix);
+      *_out << text;
+      _elem->RemoveChild(_child);
+      return text;
+    };
+
     // models
     _ecm.Each<components::Model, components::ModelSdf>(
         [&](const Entity &_modelEntity, const components::Model *,
@@ -342,83 +470,35 @@ namespace sdf_generator
 
           auto modelDir =
               common::parentPath(_modelSdf->Data().Element()->FilePath());
+          auto modelConfig = modelGenConfig(_ecm, _modelEntity, _config);
 
-          const std::string modelName =
-              scopedName(_modelEntity, _ecm, "::", false);
-
-          bool modelFromInclude = isModelFromInclude(modelDir, worldDir);
-
-          auto uriMapIt = _includeUriMap.find(modelDir);
-
-          auto modelConfig = _config.global_entity_gen_config();
-          auto modelConfigIt =
-              _config.override_entity_gen_configs().find(modelName);
-          if (modelConfigIt != _config.override_entity_gen_configs().end())
+          if (nullptr == _out)
           {
-            mergeWithOverride(modelConfig, modelConfigIt->second);
+            addModelElement(_elem, _ecm, _modelEntity, modelDir, worldDir,
+                modelConfig, _includeUriMap);
+            return true;
           }
 
-          if (modelConfig.expand_include_tags().data() || !modelFromInclude)
+          // The generated SDF depends on the components of the model and on
+          // these
+          std::string key;
+          if (nullptr != _cache)
           {
-            auto modelElem = _elem->AddElement("model");
-            updateModelElement(modelElem, _ecm, _modelEntity);
-
-            // Check & update possible //model/include(s)
-            if (!modelConfig.expand_include_tags().data())
+            auto uriMapIt = _includeUriMap.find(modelDir);
+            key = modelConfig.SerializeAsString() + '\n' + modelDir + '\n' +
+                (uriMapIt == _includeUriMap.end() ? "" : uriMapIt->second);
+            const std::string *cached = _cache->Find(_modelEntity, key);
+            if (nullptr != cached)
             {
-              updateModelElementWithNestedInclude(modelElem,
-                    modelConfig.save_fuel_version().data(), _includeUriMap);
+              *_out << *cached;
+              return true;
             }
           }
-          else if (uriMapIt != _includeUriMap.end())
-          {
-            // The fuel URI might have a version number. If it does, we remove
-            // it unless saveFuelModelVersion is set to true.
-            // Check if this is a fuel URI. We assume that it is a fuel URI if
-            // the scheme is http or https.
-            common::URI uri(uriMapIt->second);
-            if (uri.Scheme() == "http" || uri.Scheme() == "https")
-            {
-              removeVersionFromUri(uri);
-            }
 
-            if (modelConfig.save_fuel_version().data())
-            {
-              // Find out the model version from the file path. Note that we
-              // do this from the file path instead of the Fuel URI because the
-              // URI may not contain version information.
-              //
-              // We are assuming here that, for Fuel models, the directory
-              // containing the sdf file has the same name as the model version.
-              // For example, if the uri is
-              // https://example.org/1.0/test/models/Backpack
-              // the path to the directory containing the sdf file (modelDir)
-              // will be:
-              // $HOME/.gz/fuel/example.org/test/models/Backpack/2/
-              // and the basename of the directory is "1", which is the model
-              // version.
-              //
-              // However, if symlinks (or other types of indirection) are used,
-              // the pattern of modelDir will be different. The assumption here
-              // is that regardless of the indirection, the name of the
-              // directory containing the sdf file can be used as the version
-              // number
-              //
-              uri.Path() /= common::basename(modelDir);
-            }
-
-            auto includeElem = _elem->AddElement("include");
-            updateIncludeElement(includeElem, _ecm, _modelEntity, uri.Str());
-          }
-          else
-          {
-            // The model is not in the includeUriMap, but expandIncludeTags =
-            // false, so we will assume that its uri is the file path of the
-            // model on the local machine
-            auto includeElem = _elem->AddElement("include");
-            const std::string uri = "file://" + modelDir;
-            updateIncludeElement(includeElem, _ecm, _modelEntity, uri);
-          }
+          auto text = print(addModelElement(_elem, _ecm, _modelEntity,
+              modelDir, worldDir, modelConfig, _includeUriMap));
+          if (nullptr != _cache)
+            _cache->Store(_ecm, _modelEntity, key, std::move(text));
           return true;
         });
 
@@ -433,10 +513,77 @@ namespace sdf_generator
 
            auto lightElem = _elem->AddElement("light");
            updateLightElement(lightElem, _ecm, _lightEntity);
+           if (nullptr != _out)
+             print(lightElem);
 
           return true;
         });
+  }
+
+  /////////////////////////////////////////////////
+  std::optional<std::string> generateWorld(
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config)
+  {
+    sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+    sdf::initFile("root.sdf", elem);
+    auto worldElem = elem->AddElement("world");
+    if (!updateWorldElement(worldElem, _ecm, _entity, _includeUriMap, _config))
+      return std::nullopt;
+
+    return elem->ToString("");
+  }
+
+  /////////////////////////////////////////////////
+  bool generateWorld(std::ostream &_out,
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config, ModelSdfCache *_cache)
+  {
+    sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+    sdf::initFile("root.sdf", elem);
+    auto worldElem = elem->AddElement("world");
+    if (!copyWorldElement(worldElem, _ecm, _entity))
+      return false;
 
+    if (nullptr != _cache)
+      _cache->Update(_ecm);
+
+    // The models and lights go last in the world, so the document is split
+    // before the end of the world to print them in between. A world without
+    // any other child would be printed as an empty element, so it's given a
+    // temporary one.
+    auto placeholder = worldElem->AddElement("model");
+    const std::string document = elem->ToString("");
+    worldElem->RemoveChild(placeholder);
+    const std::string worldEnd{"  </world>\n"};
+    const auto split = document.rfind(worldEnd);
+    if (std::string::npos == split)
+      return false;
+    const auto placeholderStart = document.rfind("\n    <model", split);
+    if (std::string::npos == placeholderStart)
+      return false;
+
+    _out << document.substr(0, placeholderStart + 1);
+    addWorldEntities(worldElem, _ecm, _entity, _includeUriMap, _config, &_out,
+        _cache);
+    _out << document.substr(split);
+    return static_cast<bool>(_out);
+  }
+
+  /////////////////////////////////////////////////
+  bool updateWorldElement(sdf::ElementPtr _elem,
+                          const EntityComponentManager &_ecm,
+                          const Entity &_entity,
+                          const IncludeUriMap &_includeUriMap,
+                          const msgs::SdfGeneratorConfig &_config)
+  {
+    if (!copyWorldElement(_elem, _ecm, _entity))
+      return false;
+
+    addWorldEntities(_elem, _ecm, _entity, _includeUriMap, _config, nullptr,
+        nullptr);
     return true;
   }
 
@@ -1025,6 +1172,99 @@ namespace sdf_generator
     poseElem->Set(poseComp->Data());
     return true;
   }
+
+  /////////////////////////////////////////////////
+  void ModelSdfCache::Update(const EntityComponentManager &_ecm)
+  {
+    this->reused = 0u;
+    const auto version = _ecm.ChangeVersion();
+
+    // Writes through pointers and SetComponentData aren't stamped, so any
+    // of them may have changed a cached model
+    const auto pointerWriteVersion = _ecm.PointerWriteVersion();
+    const bool pointerWrites =
+        pointerWriteVersion != this->pointerWriteVersion;
+    this->pointerWriteVersion = pointerWriteVersion;
+
+    std::unordered_map<ComponentTypeId, std::unordered_set<Entity>> changed;
+    std::unordered_set<Entity> removedEntities;
+    std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+        removedComponents;
+    if (this->models.empty() || pointerWrites || version < this->version ||
+        !_ecm.ChangesSince(this->version, changed, removedEntities,
+            removedComponents))
+    {
+      this->Clear();
+      this->version = version;
+      return;
+    }
+    this->version = version;
+
+    // Drop the model that an entity belonged to when it was cached and the
+    // one it belongs to now, which differ if it was moved
+    auto drop = [&](const Entity _entity)
+    {
+      auto ownerIt = this->owners.find(_entity);
+      if (ownerIt != this->owners.end())
+        this->models.erase(ownerIt->second);
+      for (Entity entity = _entity; kNullEntity != entity;
+           entity = _ecm.ParentEntity(entity))
+      {
+        if (this->models.erase(entity) > 0u)
+          break;
+      }
+    };
+    for (const auto *typeEntities : {&changed, &removedComponents})
+    {
+      for (const auto &[type, entities] : *typeEntities)
+      {
+        for (const Entity entity : entities)
+          drop(entity);
+      }
+    }
+    for (const Entity entity : removedEntities)
+      drop(entity);
+  }
+
+  /////////////////////////////////////////////////
+  const std::string *ModelSdfCache::Find(const Entity _model,
+      const std::string &_key)
+  {
+    auto it = this->models.find(_model);
+    if (it == this->models.end() || it->second.key != _key)
+      return nullptr;
+    ++this->reused;
+    return &it->second.sdf;
+  }
+
+  /////////////////////////////////////////////////
+  void ModelSdfCache::Store(const EntityComponentManager &_ecm,
+      const Entity _model, const std::string &_key, std::string _sdf)
+  {
+    this->models[_model] = {_key, std::move(_sdf)};
+    for (const Entity entity : _ecm.Descendants(_model))
+      this->owners[entity] = _model;
+  }
+
+  /////////////////////////////////////////////////
+  void ModelSdfCache::Clear()
+  {
+    this->models.clear();
+    this->owners.clear();
+    this->reused = 0u;
+  }
+
+  /////////////////////////////////////////////////
+  std::size_t ModelSdfCache::Size() const
+  {
+    return this->models.size();
+  }
+
+  /////////////////////////////////////////////////
+  std::size_t ModelSdfCache::Reused() const
+  {
+    return this->reused;
+  }
 }
 }  // namespace GZ_SIM_VERSION_NAMESPACE
 }  // namespace sim
@@ -20,7 +20,9 @@
 #include <gz/msgs/sdf_generator_config.pb.h>
 
 #include <sdf/Element.hh>
+#include <cstdint>
 #include <optional>
+#include <ostream>
 #include <string>
 #include <unordered_map>
 
@@ -37,6 +39,74 @@ namespace sdf_generator
 {
   using IncludeUriMap = std::unordered_map<std::string, std::string>;
 
+  /// \brief SDFormat generated for the top level models of a world, reused
+  /// while the models don't change.
+  ///
+  /// Changes are found with EntityComponentManager::ChangesSince, so a
+  /// cache must only be used with one manager and its copies, and it
+  /// relies on changes being marked with SetChanged.
+  class GZ_SIM_VISIBLE ModelSdfCache
+  {
+    /// \brief Drop the models that changed since the last update. All
+    /// models are dropped if components may have been written through
+    /// pointers, which isn't tracked per entity.
+    /// \input[in] _ecm Manager the next models are generated from
+    public: void Update(const EntityComponentManager &_ecm);
+
+    /// \brief Get the SDFormat of a model that didn't change.
+    /// \input[in] _model Model entity
+    /// \input[in] _key Everything besides the components that the
+    /// generated SDFormat depends on, such as the generator configuration
+    /// \returns The SDFormat, or nullptr if it must be generated again.
+    public: const std::string *Find(const Entity _model,
+                const std::string &_key);
+
+    /// \brief Keep the SDFormat generated for a model.
+    /// \input[in] _ecm Manager the model was generated from
+    /// \input[in] _model Model entity
+    /// \input[in] _key Key to find the SDFormat with
+    /// \input[in] _sdf Generated SDFormat
+    public: void Store(const EntityComponentManager &_ecm,
+                const Entity _model, const std::string &_key,
+                std::string _sdf);
+
+    /// \brief Forget all models.
+    public: void Clear();
+
+    /// \brief Get the number of cached models.
+    /// \returns Number of models.
+    public: std::size_t Size() const;
+
+    /// \brief Get the number of models found since the last update.
+    /// \returns Number of models.
+    public: std::size_t Reused() const;
+
+    /// \brief Cached SDFormat of a model.
+    private: struct Entry
+    {
+      /// \brief Key the SDFormat was generated with.
+      std::string key;
+
+      /// \brief The SDFormat.
+      std::string sdf;
+    };
+
+    /// \brief Cached models.
+    private: std::unordered_map<Entity, Entry> models;
+
+    /// \brief Model that each descendant of a cached model belonged to.
+    private: std::unordered_map<Entity, Entity> owners;
+
+    /// \brief Change stamp of the last update.
+    private: std::uint64_t version{0u};
+
+    /// \brief Pointer write stamp of the last update.
+    private: std::uint64_t pointerWriteVersion{0u};
+
+    /// \brief Number of models found since the last update.
+    private: std::size_t reused{0u};
+  };
+
   /// \brief Generate the SDFormat representation of a world
   /// \input[in] _ecm Immutable reference to the Entity Component Manager
   /// \input[in] _entity World entity
@@ -51,6 +121,25 @@ namespace sdf_generator
       const IncludeUriMap &_includeUriMap = IncludeUriMap(),
       const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig());
 
+  /// \brief Generate the SDFormat representation of a world into a
+  /// stream, such as a file. The models are printed one at a time, so the
+  /// whole world is never held in memory, and the ones that didn't change
+  /// since a previous generation can be taken from a cache.
+  /// \input[out] _out Stream to print to
+  /// \input[in] _ecm Immutable reference to the Entity Component Manager
+  /// \input[in] _entity World entity
+  /// \input[in] _includeUriMap Map from file paths to URIs used to preserve
+  /// included Fuel models
+  /// \input[in] _config Configuration for the world generator
+  /// \input[in, out] _cache Cache of the generated models, or nullptr
+  /// \returns True if generation succeeded.
+  GZ_SIM_VISIBLE
+  bool generateWorld(std::ostream &_out,
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap = IncludeUriMap(),
+      const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig(),
+      ModelSdfCache *_cache = nullptr);
+
   /// \brief Update a sdf::Element of a world. Intended for internal use.
   /// \input[in, out] _elem sdf::Element to update
   /// \input[in] _ecm Immutable reference to the Entity Component Manager
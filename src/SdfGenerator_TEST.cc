@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <tinyxml2.h>
 
+#include <sstream>
+
 #include <gz/common/Console.hh>
 #include <gz/fuel_tools/ClientConfig.hh>
 #include <gz/fuel_tools/Interface.hh>
@@ -980,6 +982,82 @@ TEST_F(GenerateWorldFixture, ModelsInline)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(GenerateWorldFixture, StreamWithCache)
+{
+  this->LoadWorld(common::joinPaths("test", "worlds", "save_world.sdf"));
+  Entity worldEntity = this->ecm.EntityByComponents(components::World());
+  this->sdfGenConfig.mutable_global_entity_gen_config()
+      ->mutable_expand_include_tags()
+      ->set_data(true);
+
+  auto generate = [&]()
+  {
+    return sdf_generator::generateWorld(
+        this->ecm, worldEntity, this->includeUriMap, this->sdfGenConfig);
+  };
+  sdf_generator::ModelSdfCache cache;
+  auto stream = [&]()
+  {
+    std::ostringstream out;
+    EXPECT_TRUE(sdf_generator::generateWorld(out, this->ecm, worldEntity,
+        this->includeUriMap, this->sdfGenConfig, &cache));
+    return out.str();
+  };
+
+  // Streaming prints the same document
+  auto worldStr = generate();
+  ASSERT_TRUE(worldStr.has_value());
+  EXPECT_EQ(*worldStr, stream());
+  const auto modelCount = cache.Size();
+  EXPECT_LT(0u, modelCount);
+  EXPECT_EQ(0u, cache.Reused());
+
+  // Unchanged models are reused
+  EXPECT_EQ(*worldStr, stream());
+  EXPECT_EQ(modelCount, cache.Reused());
+
+  // A model that moved is generated again. Creating the component again
+  // stamps the change without writing through a pointer
+  const auto &constEcm = this->ecm;
+  Entity model = kNullEntity;
+  constEcm.Each<components::Model, components::ParentEntity>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::ParentEntity *_parent)
+      {
+        if (_parent->Data() != worldEntity)
+          return true;
+        model = _entity;
+        return false;
+      });
+  ASSERT_NE(kNullEntity, model);
+  this->ecm.CreateComponent(model,
+      components::Pose(math::Pose3d(10, 20, 30, 0, 0, 0)));
+
+  worldStr = generate();
+  ASSERT_TRUE(worldStr.has_value());
+  EXPECT_EQ(*worldStr, stream());
+  EXPECT_EQ(modelCount - 1u, cache.Reused());
+  EXPECT_NE(std::string::npos, worldStr->find("10 20 30"));
+
+  // Writes that aren't stamped, like SetComponentData without SetChanged,
+  // drop all models
+  EXPECT_EQ(*worldStr, stream());
+  EXPECT_EQ(modelCount, cache.Reused());
+  this->ecm.SetComponentData<components::Pose>(model,
+      math::Pose3d(40, 50, 60, 0, 0, 0));
+
+  worldStr = generate();
+  ASSERT_TRUE(worldStr.has_value());
+  EXPECT_NE(std::string::npos, worldStr->find("40 50 60"));
+  EXPECT_EQ(*worldStr, stream());
+  EXPECT_EQ(0u, cache.Reused());
+
+  // And the models are reused again afterwards
+  EXPECT_EQ(*worldStr, stream());
+  EXPECT_EQ(modelCount, cache.Reused());
+}
+
 /////////////////////////////////////////////////
 TEST_F(GenerateWorldFixture, PoseWithAttributes)
 {
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SensorBatches.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/Util.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Latest message of a sensor.
+struct BatchSlot
+{
+  /// \brief Name of the sensor.
+  std::string name;
+
+  /// \brief Topic of the group of the sensor.
+  std::string topic;
+
+  /// \brief Serialized message.
+  std::string bytes;
+
+  /// \brief Whether the message was set since the last batch.
+  bool fresh{false};
+};
+
+/// \brief Sensors published together.
+struct BatchGroup
+{
+  /// \brief Publisher of the batches.
+  transport::Node::Publisher pub;
+
+  /// \brief Sensors of the group, in the order they're published.
+  std::vector<Entity> sensors;
+};
+
+/// \brief Private data for SensorBatches.
+class gz::sim::SensorBatches::Implementation
+{
+  /// \brief How sensors are grouped.
+  public: enum class Scope
+  {
+    /// \brief Batches are disabled.
+    NONE,
+
+    /// \brief One group per rate for the whole world.
+    WORLD,
+
+    /// \brief One group per rate and top level model.
+    MODEL
+  };
+
+  /// \brief Type of the sensors.
+  public: std::string type;
+
+  /// \brief How sensors are grouped.
+  public: Scope scope{Scope::NONE};
+
+  /// \brief Latest message of each sensor.
+  public: std::unordered_map<Entity, BatchSlot> slots;
+
+  /// \brief Groups by topic.
+  public: std::unordered_map<std::string, BatchGroup> groups;
+
+  /// \brief Batch being published, reused across steps.
+  public: msgs::Dataframe batch;
+
+  /// \brief Transport node.
+  public: transport::Node node;
+};
+
+//////////////////////////////////////////////////
+SensorBatches::SensorBatches(const std::string &_type)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->type = _type;
+}
+
+//////////////////////////////////////////////////
+void SensorBatches::Load(const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  using Scope = Implementation::Scope;
+  if (!_sdf || !_sdf->HasElement("batch_publish"))
+    return;
+
+  const auto scope = _sdf->Get<std::string>("batch_publish");
+  if (scope == "world")
+    this->dataPtr->scope = Scope::WORLD;
+  else if (scope == "model")
+    this->dataPtr->scope = Scope::MODEL;
+  else
+  {
+    gzerr << "Unknown <batch_publish> [" << scope << "] for "
+          << this->dataPtr->type << " sensors, expected [world] or [model]"
+          << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SensorBatches::Enabled() const
+{
+  return this->dataPtr->scope != Implementation::Scope::NONE;
+}
+
+//////////////////////////////////////////////////
+void SensorBatches::AddSensor(const EntityComponentManager &_ecm,
+    Entity _entity, const std::string &_name, double _rate)
+{
+  if (!this->Enabled())
+    return;
+  this->RemoveSensor(_entity);
+
+  Entity scope{kNullEntity};
+  if (this->dataPtr->scope == Implementation::Scope::MODEL)
+    scope = topLevelModel(_entity, _ecm);
+  if (kNullEntity == scope)
+    scope = worldEntity(_entity, _ecm);
+
+  const long rate = std::lround(std::max(0.0, _rate));
+  const std::string topic = scopedName(scope, _ecm) + "/" +
+      this->dataPtr->type + "_batch/" + std::to_string(rate) + "hz";
+
+  auto &group = this->dataPtr->groups[topic];
+  if (!group.pub)
+  {
+    group.pub = this->dataPtr->node.Advertise<msgs::Dataframe>(topic);
+    if (!group.pub)
+    {
+      gzerr << "Failed to advertise sensor batches on [" << topic << "]"
+            << std::endl;
+    }
+  }
+  group.sensors.push_back(_entity);
+
+  auto &slot = this->dataPtr->slots[_entity];
+  slot.name = _name;
+  slot.topic = topic;
+}
+
+//////////////////////////////////////////////////
+void SensorBatches::RemoveSensor(Entity _entity)
+{
+  auto it = this->dataPtr->slots.find(_entity);
+  if (it == this->dataPtr->slots.end())
+    return;
+
+  auto groupIt = this->dataPtr->groups.find(it->second.topic);
+  if (groupIt != this->dataPtr->groups.end())
+  {
+    auto &sensors = groupIt->second.sensors;
+    sensors.erase(std::remove(sensors.begin(), sensors.end(), _entity),
+        sensors.end());
+    if (sensors.empty())
+      this->dataPtr->groups.erase(groupIt);
+  }
+  this->dataPtr->slots.erase(it);
+}
+
+//////////////////////////////////////////////////
+bool SensorBatches::HasConnections(Entity _entity) const
+{
+  auto it = this->dataPtr->slots.find(_entity);
+  if (it == this->dataPtr->slots.end())
+    return false;
+  auto groupIt = this->dataPtr->groups.find(it->second.topic);
+  return groupIt != this->dataPtr->groups.end() &&
+      groupIt->second.pub.HasConnections();
+}
+
+//////////////////////////////////////////////////
+void SensorBatches::SetMessage(Entity _entity,
+    const google::protobuf::Message &_msg)
+{
+  // The map isn't modified while sensors update, so concurrent lookups
+  // are safe
+  auto it = this->dataPtr->slots.find(_entity);
+  if (it == this->dataPtr->slots.end())
+    return;
+  _msg.SerializeToString(&it->second.bytes);
+  it->second.fresh = true;
+}
+
+//////////////////////////////////////////////////
+void SensorBatches::Publish(const std::chrono::steady_clock::duration &_simTime)
+{
+  auto &batch = this->dataPtr->batch;
+  for (auto &[topic, group] : this->dataPtr->groups)
+  {
+    const bool connected = group.pub.HasConnections();
+    batch.Clear();
+    auto *names = batch.mutable_header()->add_data();
+    names->set_key(kSensorsKey);
+    std::string *data = batch.mutable_data();
+    for (const auto entity : group.sensors)
+    {
+      auto &slot = this->dataPtr->slots[entity];
+      if (!slot.fresh)
+        continue;
+      slot.fresh = false;
+      if (!connected)
+        continue;
+
+      names->add_value(slot.name);
+      const auto size = static_cast<std::uint32_t>(slot.bytes.size());
+      for (int i = 0; i < 4; ++i)
+        data->push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+      data->append(slot.bytes);
+    }
+    if (names->value_size() == 0)
+      continue;
+
+    *batch.mutable_header()->mutable_stamp() = convert<msgs::Time>(_simTime);
+    group.pub.Publish(batch);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SensorBatches::Split(const msgs::Dataframe &_batch,
+    std::vector<std::string> &_names, std::vector<std::string> &_msgs)
+{
+  _names.clear();
+  _msgs.clear();
+  bool isBatch{false};
+  for (const auto &data : _batch.header().data())
+  {
+    if (data.key() != kSensorsKey)
+      continue;
+    isBatch = true;
+    _names.assign(data.value().begin(), data.value().end());
+  }
+  if (!isBatch)
+    return false;
+
+  const std::string &bytes = _batch.data();
+  std::size_t offset{0u};
+  while (offset < bytes.size())
+  {
+    if (bytes.size() - offset < 4u)
+      return false;
+    std::uint32_t size{0u};
+    for (int i = 0; i < 4; ++i)
+    {
+      size |= static_cast<std::uint32_t>(
+          static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+    }
+    offset += 4u;
+    if (bytes.size() - offset < size)
+      return false;
+    _msgs.emplace_back(bytes, offset, size);
+    offset += size;
+  }
+  return _msgs.size() == _names.size();
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SENSORBATCHES_HH_
+#define GZ_SIM_SENSORBATCHES_HH_
+
+#include <gz/msgs/dataframe.pb.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+#include <gz/utils/ImplPtr.hh>
+#include <sdf/Element.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/EntityComponentManager.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class SensorBatches SensorBatches.hh
+    /// \brief Publishes the measurements of the sensors of a system as one
+    /// message per rate group and step, for clients that collect the data
+    /// of many sensors. The sensors keep publishing on their own topics.
+    ///
+    /// It's enabled on a sensor system with:
+    ///
+    /// - `<batch_publish>`: `world` to group all sensors of the world, or
+    ///   `model` to group the sensors of each top level model. Within these,
+    ///   sensors are grouped by update rate, rounded to whole hertz.
+    ///
+    /// Each group is published on `<scope>/<type>_batch/<rate>hz`, where
+    /// `<scope>` is the scoped name of the world or model, for example
+    /// `/world/default/model/robot/imu_batch/100hz`. A rate of zero means
+    /// the sensors update every step.
+    ///
+    /// A batch is a msgs::Dataframe whose data holds the serialized sensor
+    /// messages, each preceded by its size in bytes as 4 bytes in little
+    /// endian order, like comms::PackMsgs. The value of its kSensorsKey
+    /// header entry lists the names of the sensors, in the same order.
+    class GZ_SIM_VISIBLE SensorBatches
+    {
+      /// \brief Key of the header data of a batch listing the sensors.
+      public: static constexpr const char *kSensorsKey = "sensors";
+
+      /// \brief Constructor.
+      /// \param[in] _type Type of the sensors, used in topics, such as
+      /// "imu".
+      public: explicit SensorBatches(const std::string &_type);
+
+      /// \brief Load the configuration of a sensor system.
+      /// \param[in] _sdf SDF of the system.
+      public: void Load(const std::shared_ptr<const sdf::Element> &_sdf);
+
+      /// \brief Get whether batches are published.
+      /// \return True if enabled.
+      public: bool Enabled() const;
+
+      /// \brief Add a sensor to the group of its scope and rate. This does
+      /// nothing if batches aren't enabled.
+      /// \param[in] _ecm Entity component manager.
+      /// \param[in] _entity Sensor entity.
+      /// \param[in] _name Name of the sensor listed in batches.
+      /// \param[in] _rate Update rate of the sensor in hertz.
+      public: void AddSensor(const EntityComponentManager &_ecm,
+                  Entity _entity, const std::string &_name, double _rate);
+
+      /// \brief Remove a sensor.
+      /// \param[in] _entity Sensor entity.
+      public: void RemoveSensor(Entity _entity);
+
+      /// \brief Get whether the group of a sensor has subscribers, in which
+      /// case the sensor must be updated even without subscribers of its
+      /// own.
+      /// \param[in] _entity Sensor entity.
+      /// \return True if a batch containing the sensor is subscribed to.
+      public: bool HasConnections(Entity _entity) const;
+
+      /// \brief Set the latest message of a sensor, to publish with the
+      /// next batch of its group. This may be called concurrently for
+      /// different sensors.
+      /// \param[in] _entity Sensor entity.
+      /// \param[in] _msg Message of the sensor.
+      public: void SetMessage(Entity _entity,
+                  const google::protobuf::Message &_msg);
+
+      /// \brief Publish the groups that got messages since the last call.
+      /// \param[in] _simTime Simulation time to stamp the batches with.
+      public: void Publish(const std::chrono::steady_clock::duration &_simTime);
+
+      /// \brief Split a batch into its serialized messages.
+      /// \param[in] _batch Batch.
+      /// \param[out] _names Names of the sensors.
+      /// \param[out] _msgs Serialized messages.
+      /// \return False if the message isn't a valid batch.
+      public: static bool Split(const msgs::Dataframe &_batch,
+                  std::vector<std::string> &_names,
+                  std::vector<std::string> &_msgs);
+
+      /// \brief Unpack the messages of a batch.
+      /// \param[in] _batch Batch.
+      /// \param[out] _names Names of the sensors.
+      /// \param[out] _msgs Messages of the sensors.
+      /// \tparam MsgT Message type of the sensors.
+      /// \return False if the message isn't a valid batch.
+      public: template <typename MsgT>
+              static bool Unpack(const msgs::Dataframe &_batch,
+                  std::vector<std::string> &_names,
+                  std::vector<MsgT> &_msgs)
+      {
+        std::vector<std::string> serialized;
+        if (!Split(_batch, _names, serialized))
+          return false;
+        _msgs.resize(serialized.size());
+        for (std::size_t i = 0; i < serialized.size(); ++i)
+        {
+          if (!_msgs[i].ParseFromString(serialized[i]))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Private data pointer.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+#include <sdf/Element.hh>
+
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Sensor.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "SensorBatches.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Create the SDF of a system with a <batch_publish> element.
+std::shared_ptr<sdf::Element> batchSdf(const std::string &_scope)
+{
+  auto sdf = std::make_shared<sdf::Element>();
+  sdf->SetName("plugin");
+  auto scope = std::make_shared<sdf::Element>();
+  scope->SetName("batch_publish");
+  scope->AddValue("string", _scope, true);
+  sdf->InsertElement(scope);
+  return sdf;
+}
+
+/////////////////////////////////////////////////
+TEST(SensorBatches, Load)
+{
+  SensorBatches batches("imu");
+  EXPECT_FALSE(batches.Enabled());
+  batches.Load(nullptr);
+  EXPECT_FALSE(batches.Enabled());
+  batches.Load(batchSdf("galaxy"));
+  EXPECT_FALSE(batches.Enabled());
+  batches.Load(batchSdf("world"));
+  EXPECT_TRUE(batches.Enabled());
+}
+
+/////////////////////////////////////////////////
+TEST(SensorBatches, Split)
+{
+  msgs::Dataframe notBatch;
+  std::vector<std::string> names;
+  std::vector<msgs::StringMsg> msgs;
+  EXPECT_FALSE(SensorBatches::Unpack(notBatch, names, msgs));
+
+  msgs::Dataframe truncated;
+  auto *data = truncated.mutable_header()->add_data();
+  data->set_key(SensorBatches::kSensorsKey);
+  data->add_value("a");
+  truncated.set_data(std::string("\x05\x00\x00\x00" "ab", 6));
+  EXPECT_FALSE(SensorBatches::Unpack(truncated, names, msgs));
+}
+
+/////////////////////////////////////////////////
+TEST(SensorBatches, GZ_UTILS_TEST_DISABLED_ON_WIN32(Publish))
+{
+  EntityComponentManager ecm;
+  const Entity world = ecm.CreateEntity();
+  ecm.CreateComponent(world, components::World());
+  ecm.CreateComponent(world, components::Name("batch_test"));
+  const Entity model = ecm.CreateEntity();
+  ecm.CreateComponent(model, components::Model());
+  ecm.CreateComponent(model, components::Name("robot"));
+  ecm.CreateComponent(model, components::ParentEntity(world));
+  std::vector<Entity> sensors;
+  for (const std::string name : {"a", "b", "c"})
+  {
+    sensors.push_back(ecm.CreateEntity());
+    ecm.CreateComponent(sensors.back(), components::Sensor());
+    ecm.CreateComponent(sensors.back(), components::Name(name));
+    ecm.CreateComponent(sensors.back(), components::ParentEntity(model));
+  }
+
+  SensorBatches batches("imu");
+  batches.Load(batchSdf("model"));
+  batches.AddSensor(ecm, sensors[0], "a", 100.0);
+  batches.AddSensor(ecm, sensors[1], "b", 99.8);
+  batches.AddSensor(ecm, sensors[2], "c", 10.0);
+  EXPECT_FALSE(batches.HasConnections(sensors[0]));
+
+  std::mutex mutex;
+  std::vector<std::string> names;
+  std::vector<msgs::StringMsg> received;
+  std::function<void(const msgs::Dataframe &)> cb =
+      [&](const msgs::Dataframe &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_TRUE(SensorBatches::Unpack(_msg, names, received));
+      };
+  transport::Node node;
+  ASSERT_TRUE(node.Subscribe(
+      "/world/batch_test/model/robot/imu_batch/100hz", cb));
+  for (int sleep = 0; sleep < 50 && !batches.HasConnections(sensors[0]);
+      ++sleep)
+  {
+    std::this_thread::sleep_for(100ms);
+  }
+  EXPECT_TRUE(batches.HasConnections(sensors[1]));
+  EXPECT_FALSE(batches.HasConnections(sensors[2]));
+
+  for (int sleep = 0; sleep < 50; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!received.empty())
+        break;
+    }
+    for (std::size_t i = 0; i < sensors.size(); ++i)
+    {
+      msgs::StringMsg msg;
+      msg.set_data("data" + std::to_string(i));
+      batches.SetMessage(sensors[i], msg);
+    }
+    batches.Publish(1s);
+    std::this_thread::sleep_for(100ms);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(2u, received.size());
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), names);
+  EXPECT_EQ("data0", received[0].data());
+  EXPECT_EQ("data1", received[1].data());
+}
@@ -15,12 +15,16 @@
  *
 */
 
+#include <fstream>
+#include <iterator>
 #include <numeric>
+#include <optional>
 
 #ifdef HAVE_PYBIND11
 #include <pybind11/embed.h>
 #endif
 
+#include <gz/common/Filesystem.hh>
 #include <gz/common/SystemPaths.hh>
 #include <gz/fuel_tools/Interface.hh>
 #include <gz/fuel_tools/ClientConfig.hh>
@@ -33,9 +37,15 @@
 #include "gz/sim/Server.hh"
 #include "gz/sim/Util.hh"
 
+#include "Checkpoint.hh"
+#include "DeferredIncludes.hh"
+#include "MeshCache.hh"
+#include "MeshInertiaCache.hh"
 #include "MeshInertiaCalculator.hh"
 #include "ServerPrivate.hh"
 #include "SimulationRunner.hh"
+#include "StartupTimeline.hh"
+#include "WorldCache.hh"
 
 using namespace gz;
 using namespace sim;
@@ -62,6 +72,9 @@ struct DefaultWorld
 Server::Server(const ServerConfig &_config)
   : dataPtr(new ServerPrivate)
 {
+  // Record the startup phases until the first step
+  StartupTimeline::Instance().Restart();
+
 #ifdef HAVE_PYBIND11
   if (Py_IsInitialized() == 0)
   {
@@ -98,7 +111,26 @@ Server::Server(const ServerConfig &_config)
 
   sdf::Errors errors;
 
-  switch (_config.Source())
+  // A checkpoint holds the world it was taken from, with its includes
+  // expanded, which is loaded instead of the configured world
+  std::optional<Checkpoint> checkpoint;
+  auto source = _config.Source();
+  if (!_config.RestoreFile().empty())
+  {
+    StartupTimeline::Scope loadScope("Load checkpoint", "sdf");
+    checkpoint = loadCheckpoint(_config.RestoreFile());
+    if (!checkpoint)
+    {
+      gzerr << "Failed to load checkpoint [" << _config.RestoreFile() << "]"
+            << std::endl;
+      return;
+    }
+    gzmsg << "Restoring world [" << checkpoint->worldName
+          << "] from checkpoint [" << _config.RestoreFile() << "].\n";
+    source = ServerConfig::SourceType::kSdfString;
+  }
+
+  switch (source)
   {
     // Load a world if specified. Check SDF string first, then SDF file
     case ServerConfig::SourceType::kSdfRoot:
@@ -110,8 +142,11 @@ Server::Server(const ServerConfig &_config)
 
     case ServerConfig::SourceType::kSdfString:
     {
+      StartupTimeline::Scope loadScope("Load SDF", "sdf");
       std::string msg = "Loading SDF string. ";
-      if (_config.SdfFile().empty())
+      const std::string &sdfString =
+          checkpoint ? checkpoint->worldSdf : _config.SdfString();
+      if (_config.SdfFile().empty() || checkpoint)
       {
         msg += "File path not available.\n";
       }
@@ -124,14 +159,19 @@ Server::Server(const ServerConfig &_config)
       sdfParserConfig.SetStoreResolvedURIs(true);
       sdfParserConfig.SetCalculateInertialConfiguration(
         sdf::ConfigureResolveAutoInertials::SKIP_CALCULATION_IN_LOAD);
+      this->dataPtr->PrefetchResources(sdfString,
+          _config.ResourcePrefetchThreads());
       errors = this->dataPtr->sdfRoot.LoadSdfString(
-        _config.SdfString(), sdfParserConfig);
+        sdfString, sdfParserConfig);
+      MeshCache::Instance().Preload(this->dataPtr->sdfRoot,
+          _config.PreloadMeshes());
       this->dataPtr->sdfRoot.ResolveAutoInertials(errors, sdfParserConfig);
       break;
     }
 
     case ServerConfig::SourceType::kSdfFile:
     {
+      StartupTimeline::Scope loadScope("Load SDF", "sdf");
       std::string filePath = resolveSdfWorldFile(_config.SdfFile(),
           _config.ResourceCache());
 
@@ -142,22 +182,85 @@ Server::Server(const ServerConfig &_config)
         return;
       }
 
-      gzmsg << "Loading SDF world file[" << filePath << "].\n";
-
-      sdf::Root sdfRoot;
       sdf::ParserConfig sdfParserConfig = sdf::ParserConfig::GlobalConfig();
       sdfParserConfig.SetStoreResolvedURIs(true);
       sdfParserConfig.SetCalculateInertialConfiguration(
         sdf::ConfigureResolveAutoInertials::SKIP_CALCULATION_IN_LOAD);
-
-      MeshInertiaCalculator meshInertiaCalculator;
+      MeshInertiaCalculator meshInertiaCalculator(
+          MeshInertiaCache::Directory(_config));
       sdfParserConfig.RegisterCustomInertiaCalc(meshInertiaCalculator);
+
+      // Includes referenced by levels are parsed when their level becomes
+      // active, so the world is loaded without them
+      std::shared_ptr<DeferredIncludes> deferredIncludes;
+      std::string deferredWorld;
+      if (_config.UseLevels() && _config.DeferLevelIncludes())
+      {
+        std::ifstream worldFile(filePath);
+        deferredIncludes =
+            std::make_shared<DeferredIncludes>(sdfParserConfig);
+        deferredWorld = deferredIncludes->Extract(
+            std::string(std::istreambuf_iterator<char>(worldFile),
+            std::istreambuf_iterator<char>()), common::parentPath(filePath));
+        if (deferredIncludes->Names().empty())
+          deferredIncludes.reset();
+      }
+
+      // A cached world has its includes expanded and its URIs resolved, so
+      // loading it doesn't fetch anything. Worlds with deferred includes
+      // aren't complete, so they aren't cached.
+      const WorldCache worldCache(WorldCache::Directory(_config));
+      const auto cacheKey = nullptr == deferredIncludes ?
+          worldCache.Key(filePath, _config) : std::string();
+      const auto cachedWorld = worldCache.Load(cacheKey);
+      if (cachedWorld)
+      {
+        gzmsg << "Loading SDF world file[" << filePath
+              << "] from the world cache.\n";
+        errors = this->dataPtr->sdfRoot.LoadSdfString(*cachedWorld,
+            sdfParserConfig);
+        MeshCache::Instance().Preload(this->dataPtr->sdfRoot,
+            _config.PreloadMeshes());
+        this->dataPtr->sdfRoot.ResolveAutoInertials(errors, sdfParserConfig);
+        break;
+      }
+
+      gzmsg << "Loading SDF world file[" << filePath << "].\n";
+
+      // Download the included models concurrently, instead of one after the
+      // other as they're found while loading. Deferred includes are fetched
+      // when their level becomes active.
+      if (nullptr != deferredIncludes)
+      {
+        this->dataPtr->PrefetchResources(deferredWorld,
+            _config.ResourcePrefetchThreads());
+      }
+      else if (_config.ResourcePrefetchThreads() > 0u)
+      {
+        std::ifstream worldFile(filePath);
+        this->dataPtr->PrefetchResources(
+            std::string(std::istreambuf_iterator<char>(worldFile),
+            std::istreambuf_iterator<char>()),
+            _config.ResourcePrefetchThreads());
+      }
+
+      sdf::Root sdfRoot;
+
       // \todo(nkoenig) Async resource download.
       // This call can block for a long period of time while
       // resources are downloaded. Blocking here causes the GUI to block with
       // a black screen (search for "Async resource download" in
       // 'src/gui_main.cc'.
-      errors = sdfRoot.Load(filePath, sdfParserConfig);
+      if (nullptr != deferredIncludes)
+      {
+        errors = DeferredIncludes::LoadFileString(sdfRoot, deferredWorld,
+            filePath, sdfParserConfig);
+        this->dataPtr->deferredIncludes = deferredIncludes;
+      }
+      else
+      {
+        errors = sdfRoot.Load(filePath, sdfParserConfig);
+      }
       if (errors.empty() || _config.BehaviorOnSdfErrors() !=
           ServerConfig::SdfErrorBehavior::EXIT_IMMEDIATELY) {
         if (sdfRoot.Model() == nullptr) {
@@ -182,7 +285,21 @@ Server::Server(const ServerConfig &_config)
         }
       }
 
+      // Load the collision meshes once per content before they're needed
+      // to compute inertias and to create the physics entities
+      MeshCache::Instance().Preload(this->dataPtr->sdfRoot,
+          _config.PreloadMeshes());
       this->dataPtr->sdfRoot.ResolveAutoInertials(errors, sdfParserConfig);
+
+      // Worlds with errors are loaded from the file again next time, so the
+      // errors are reported
+      if (errors.empty() && !cacheKey.empty() &&
+          worldCache.Save(cacheKey, this->dataPtr->sdfRoot))
+      {
+        gzmsg << "Stored SDF world file[" << filePath
+              << "] in the world cache [" << WorldCache::Directory(_config)
+              << "].\n";
+      }
       break;
     }
 
@@ -214,7 +331,16 @@ Server::Server(const ServerConfig &_config)
     this->dataPtr->AddRecordPlugin(_config);
   }
 
-  this->dataPtr->CreateEntities();
+  {
+    StartupTimeline::Scope createScope("Create worlds", "entities");
+    this->dataPtr->CreateEntities();
+  }
+
+  if (checkpoint)
+  {
+    StartupTimeline::Scope restoreScope("Restore checkpoint", "entities");
+    this->dataPtr->RestoreCheckpoint(*checkpoint);
+  }
 
   // Set the desired update period, this will override the desired RTF given in
   // the world file which was parsed by CreateEntities.
@@ -224,7 +350,8 @@ Server::Server(const ServerConfig &_config)
   }
 
   // Establish publishers and subscribers.
-  this->dataPtr->SetupTransport();
+  if (_config.UseTransport())
+    this->dataPtr->SetupTransport();
 }
 
 /////////////////////////////////////////////////
@@ -289,6 +416,13 @@ bool Server::RunOnce(const bool _paused)
   return this->Run(true, 1, _paused);
 }
 
+/////////////////////////////////////////////////
+bool Server::RunBatch(const uint64_t _iterations,
+    const BatchCallback &_callback)
+{
+  return this->dataPtr->RunBatch(_iterations, _callback);
+}
+
 /////////////////////////////////////////////////
 void Server::SetUpdatePeriod(
     const std::chrono::steady_clock::duration &_updatePeriod,
@@ -479,6 +613,19 @@ bool Server::RequestRemoveEntity(const Entity _entity,
   return false;
 }
 
+//////////////////////////////////////////////////
+bool Server::Reset(const unsigned int _worldIndex)
+{
+  if (this->dataPtr->running ||
+      _worldIndex >= this->dataPtr->simRunners.size())
+  {
+    return false;
+  }
+
+  this->dataPtr->simRunners[_worldIndex]->Reset();
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Server::Stop()
 {
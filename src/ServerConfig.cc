@@ -190,6 +190,24 @@ class gz::sim::ServerConfigPrivate
             updateRate(_cfg->updateRate),
             initialSimTime(_cfg->initialSimTime),
             useLevels(_cfg->useLevels),
+            deferLevelIncludes(_cfg->deferLevelIncludes),
+            componentStorage(_cfg->componentStorage),
+            shareIdenticalComponents(_cfg->shareIdenticalComponents),
+            preloadMeshes(_cfg->preloadMeshes),
+            postUpdateThreadCount(_cfg->postUpdateThreadCount),
+            deterministic(_cfg->deterministic),
+            stateHashing(_cfg->stateHashing),
+            preciseStepPacing(_cfg->preciseStepPacing),
+            simulationThreadCpu(_cfg->simulationThreadCpu),
+            simulationThreadPriority(_cfg->simulationThreadPriority),
+            lockstep(_cfg->lockstep),
+            statsPublishRate(_cfg->statsPublishRate),
+            clockPublishRate(_cfg->clockPublishRate),
+            useDefaultPlugins(_cfg->useDefaultPlugins),
+            useTransport(_cfg->useTransport),
+            computeOnly(_cfg->computeOnly),
+            useSystemProfiling(_cfg->useSystemProfiling),
+            entityIdRecycling(_cfg->entityIdRecycling),
             useLogRecord(_cfg->useLogRecord),
             logRecordPath(_cfg->logRecordPath),
             logRecordPeriod(_cfg->logRecordPeriod),
@@ -197,7 +215,11 @@ class gz::sim::ServerConfigPrivate
             logRecordResources(_cfg->logRecordResources),
             logRecordCompressPath(_cfg->logRecordCompressPath),
             resourceCache(_cfg->resourceCache),
+            worldCache(_cfg->worldCache),
+            restoreFile(_cfg->restoreFile),
+            resourcePrefetchThreads(_cfg->resourcePrefetchThreads),
             physicsEngine(_cfg->physicsEngine),
+            physicsSubsteps(_cfg->physicsSubsteps),
             renderEngineServer(_cfg->renderEngineServer),
             renderEngineServerApiBackend(_cfg->renderEngineServerApiBackend),
             renderEngineGui(_cfg->renderEngineGui),
@@ -226,6 +248,60 @@ class gz::sim::ServerConfigPrivate
   /// \brief Use the level system
   public: bool useLevels{false};
 
+  /// \brief Parse the includes of levels when their level is active
+  public: bool deferLevelIncludes{false};
+
+  /// \brief Memory layout used to store components
+  public: ComponentStorageType componentStorage{ComponentStorageType::kHeap};
+
+  /// \brief Share immutable components that hold the same data
+  public: bool shareIdenticalComponents{false};
+
+  /// \brief Load collision meshes before creating entities
+  public: bool preloadMeshes{false};
+
+  /// \brief Number of PostUpdate worker threads, zero to use the shared pool
+  public: unsigned int postUpdateThreadCount{0};
+
+  /// \brief Split parallel loops independently of the number of threads
+  public: bool deterministic{false};
+
+  /// \brief Hash the ECM state after every step
+  public: bool stateHashing{false};
+
+  /// \brief Pace steps with absolute deadlines and busy-waiting
+  public: bool preciseStepPacing{false};
+
+  /// \brief CPU the simulation thread is pinned to, or -1
+  public: int simulationThreadCpu{-1};
+
+  /// \brief SCHED_FIFO priority of the simulation thread, or 0
+  public: int simulationThreadPriority{0};
+
+  /// \brief Wait for step credits from an external process
+  public: bool lockstep{false};
+
+  /// \brief Rate of the world statistics in Hz
+  public: double statsPublishRate{10.0};
+
+  /// \brief Rate of the clock in Hz, zero to publish it on every step
+  public: double clockPublishRate{0.0};
+
+  /// \brief Load the default systems for worlds without systems
+  public: bool useDefaultPlugins{true};
+
+  /// \brief Advertise the server services and topics
+  public: bool useTransport{true};
+
+  /// \brief Only compute, without transport or pacing
+  public: bool computeOnly{false};
+
+  /// \brief Time the calls of each system
+  public: bool useSystemProfiling{false};
+
+  /// \brief Recycle the IDs of removed entities
+  public: bool entityIdRecycling{false};
+
   /// \brief Use the logging system to record states
   public: bool useLogRecord{false};
 
@@ -248,9 +324,22 @@ class gz::sim::ServerConfigPrivate
   /// from fuel.gazebosim.org, should be stored.
   public: std::string resourceCache = "";
 
+  /// \brief Path to where loaded world files are stored.
+  public: std::string worldCache = "";
+
+  /// \brief Path to the checkpoint to resume the simulation from.
+  public: std::string restoreFile = "";
+
+  /// \brief Number of concurrent downloads of included Fuel models
+  public: unsigned int resourcePrefetchThreads{8};
+
   /// \brief File containing physics engine plugin. If empty, DART will be used.
   public: std::string physicsEngine = "";
 
+  /// \brief Number of physics steps per iteration. If zero, the physics
+  /// system's configuration is used.
+  public: unsigned int physicsSubsteps{0};
+
   /// \brief File containing render engine server plugin. If empty, OGRE2
   /// will be used.
   public: std::string renderEngineServer = "";
@@ -400,6 +489,222 @@ void ServerConfig::SetUseLevels(const bool _levels)
   this->dataPtr->useLevels = _levels;
 }
 
+/////////////////////////////////////////////////
+void ServerConfig::SetDeferLevelIncludes(const bool _defer)
+{
+  this->dataPtr->deferLevelIncludes = _defer;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::DeferLevelIncludes() const
+{
+  return this->dataPtr->deferLevelIncludes;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetComponentStorage(const ComponentStorageType _type)
+{
+  this->dataPtr->componentStorage = _type;
+}
+
+/////////////////////////////////////////////////
+ComponentStorageType ServerConfig::ComponentStorage() const
+{
+  return this->dataPtr->componentStorage;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetShareIdenticalComponents(const bool _share)
+{
+  this->dataPtr->shareIdenticalComponents = _share;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::ShareIdenticalComponents() const
+{
+  return this->dataPtr->shareIdenticalComponents;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPreloadMeshes(const bool _preload)
+{
+  this->dataPtr->preloadMeshes = _preload;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PreloadMeshes() const
+{
+  return this->dataPtr->preloadMeshes;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPostUpdateThreadCount(unsigned int _threads)
+{
+  this->dataPtr->postUpdateThreadCount = _threads;
+}
+
+/////////////////////////////////////////////////
+unsigned int ServerConfig::PostUpdateThreadCount() const
+{
+  return this->dataPtr->postUpdateThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetDeterministic(const bool _deterministic)
+{
+  this->dataPtr->deterministic = _deterministic;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::Deterministic() const
+{
+  return this->dataPtr->deterministic;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetStateHashing(const bool _hash)
+{
+  this->dataPtr->stateHashing = _hash;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::StateHashing() const
+{
+  return this->dataPtr->stateHashing;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPreciseStepPacing(const bool _precise)
+{
+  this->dataPtr->preciseStepPacing = _precise;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PreciseStepPacing() const
+{
+  return this->dataPtr->preciseStepPacing;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetSimulationThreadCpu(const int _cpu)
+{
+  this->dataPtr->simulationThreadCpu = _cpu;
+}
+
+/////////////////////////////////////////////////
+int ServerConfig::SimulationThreadCpu() const
+{
+  return this->dataPtr->simulationThreadCpu;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetSimulationThreadPriority(const int _priority)
+{
+  this->dataPtr->simulationThreadPriority = _priority;
+}
+
+/////////////////////////////////////////////////
+int ServerConfig::SimulationThreadPriority() const
+{
+  return this->dataPtr->simulationThreadPriority;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetLockstep(const bool _lockstep)
+{
+  this->dataPtr->lockstep = _lockstep;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::Lockstep() const
+{
+  return this->dataPtr->lockstep;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetStatsPublishRate(const double _hz)
+{
+  this->dataPtr->statsPublishRate = _hz;
+}
+
+/////////////////////////////////////////////////
+double ServerConfig::StatsPublishRate() const
+{
+  return this->dataPtr->statsPublishRate;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetClockPublishRate(const double _hz)
+{
+  this->dataPtr->clockPublishRate = _hz;
+}
+
+/////////////////////////////////////////////////
+double ServerConfig::ClockPublishRate() const
+{
+  return this->dataPtr->clockPublishRate;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetUseDefaultPlugins(const bool _default)
+{
+  this->dataPtr->useDefaultPlugins = _default;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::UseDefaultPlugins() const
+{
+  return this->dataPtr->useDefaultPlugins;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetUseTransport(const bool _transport)
+{
+  this->dataPtr->useTransport = _transport;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::UseTransport() const
+{
+  return this->dataPtr->useTransport && !this->dataPtr->computeOnly;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetComputeOnly(const bool _computeOnly)
+{
+  this->dataPtr->computeOnly = _computeOnly;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::ComputeOnly() const
+{
+  return this->dataPtr->computeOnly;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetUseSystemProfiling(const bool _profiling)
+{
+  this->dataPtr->useSystemProfiling = _profiling;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::UseSystemProfiling() const
+{
+  return this->dataPtr->useSystemProfiling;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetEntityIdRecycling(const bool _recycle)
+{
+  this->dataPtr->entityIdRecycling = _recycle;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::EntityIdRecycling() const
+{
+  return this->dataPtr->entityIdRecycling;
+}
+
 /////////////////////////////////////////////////
 void ServerConfig::SetNetworkSecondaries(unsigned int _secondaries)
 {
@@ -530,6 +835,42 @@ void ServerConfig::SetResourceCache(const std::string &_path)
   this->dataPtr->resourceCache = _path;
 }
 
+/////////////////////////////////////////////////
+const std::string &ServerConfig::WorldCache() const
+{
+  return this->dataPtr->worldCache;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetWorldCache(const std::string &_path)
+{
+  this->dataPtr->worldCache = _path;
+}
+
+/////////////////////////////////////////////////
+const std::string &ServerConfig::RestoreFile() const
+{
+  return this->dataPtr->restoreFile;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetRestoreFile(const std::string &_path)
+{
+  this->dataPtr->restoreFile = _path;
+}
+
+/////////////////////////////////////////////////
+unsigned int ServerConfig::ResourcePrefetchThreads() const
+{
+  return this->dataPtr->resourcePrefetchThreads;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetResourcePrefetchThreads(unsigned int _threads)
+{
+  this->dataPtr->resourcePrefetchThreads = _threads;
+}
+
 /////////////////////////////////////////////////
 const std::string &ServerConfig::PhysicsEngine() const
 {
@@ -542,6 +883,18 @@ void ServerConfig::SetPhysicsEngine(const std::string &_physicsEngine)
   this->dataPtr->physicsEngine = _physicsEngine;
 }
 
+/////////////////////////////////////////////////
+unsigned int ServerConfig::PhysicsSubsteps() const
+{
+  return this->dataPtr->physicsSubsteps;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPhysicsSubsteps(unsigned int _substeps)
+{
+  this->dataPtr->physicsSubsteps = _substeps;
+}
+
 /////////////////////////////////////////////////
 const std::string &ServerConfig::RenderEngineServer() const
 {
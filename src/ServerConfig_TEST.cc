@@ -261,3 +261,270 @@ TEST(ServerConfig, SdfRoot)
   EXPECT_TRUE(config.SdfString().empty());
   EXPECT_EQ(ServerConfig::SourceType::kSdfRoot, config.Source());
 }
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, ComponentStorage)
+{
+  ServerConfig config;
+  EXPECT_EQ(ComponentStorageType::kHeap, config.ComponentStorage());
+
+  config.SetComponentStorage(ComponentStorageType::kContiguous);
+  EXPECT_EQ(ComponentStorageType::kContiguous, config.ComponentStorage());
+
+  ServerConfig copy(config);
+  EXPECT_EQ(ComponentStorageType::kContiguous, copy.ComponentStorage());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, PostUpdateThreadCount)
+{
+  ServerConfig config;
+  EXPECT_EQ(0u, config.PostUpdateThreadCount());
+
+  config.SetPostUpdateThreadCount(3u);
+  EXPECT_EQ(3u, config.PostUpdateThreadCount());
+
+  ServerConfig copy(config);
+  EXPECT_EQ(3u, copy.PostUpdateThreadCount());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, Deterministic)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.Deterministic());
+
+  config.SetDeterministic(true);
+  EXPECT_TRUE(config.Deterministic());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.Deterministic());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, StateHashing)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.StateHashing());
+
+  config.SetStateHashing(true);
+  EXPECT_TRUE(config.StateHashing());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.StateHashing());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, StepPacing)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.PreciseStepPacing());
+  EXPECT_EQ(-1, config.SimulationThreadCpu());
+  EXPECT_EQ(0, config.SimulationThreadPriority());
+
+  config.SetPreciseStepPacing(true);
+  config.SetSimulationThreadCpu(2);
+  config.SetSimulationThreadPriority(80);
+  EXPECT_TRUE(config.PreciseStepPacing());
+  EXPECT_EQ(2, config.SimulationThreadCpu());
+  EXPECT_EQ(80, config.SimulationThreadPriority());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.PreciseStepPacing());
+  EXPECT_EQ(2, copy.SimulationThreadCpu());
+  EXPECT_EQ(80, copy.SimulationThreadPriority());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, Lockstep)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.Lockstep());
+
+  config.SetLockstep(true);
+  EXPECT_TRUE(config.Lockstep());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.Lockstep());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, PublishRates)
+{
+  ServerConfig config;
+  EXPECT_DOUBLE_EQ(10.0, config.StatsPublishRate());
+  EXPECT_DOUBLE_EQ(0.0, config.ClockPublishRate());
+
+  config.SetStatsPublishRate(2.0);
+  config.SetClockPublishRate(100.0);
+  EXPECT_DOUBLE_EQ(2.0, config.StatsPublishRate());
+  EXPECT_DOUBLE_EQ(100.0, config.ClockPublishRate());
+
+  ServerConfig copy(config);
+  EXPECT_DOUBLE_EQ(2.0, copy.StatsPublishRate());
+  EXPECT_DOUBLE_EQ(100.0, copy.ClockPublishRate());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, MinimalSetup)
+{
+  ServerConfig config;
+  EXPECT_TRUE(config.UseDefaultPlugins());
+  EXPECT_TRUE(config.UseTransport());
+
+  config.SetUseDefaultPlugins(false);
+  config.SetUseTransport(false);
+  EXPECT_FALSE(config.UseDefaultPlugins());
+  EXPECT_FALSE(config.UseTransport());
+
+  ServerConfig copy(config);
+  EXPECT_FALSE(copy.UseDefaultPlugins());
+  EXPECT_FALSE(copy.UseTransport());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, ComputeOnly)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.ComputeOnly());
+
+  // Compute-only mode turns transport off
+  config.SetComputeOnly(true);
+  EXPECT_TRUE(config.ComputeOnly());
+  EXPECT_FALSE(config.UseTransport());
+  config.SetUseTransport(true);
+  EXPECT_FALSE(config.UseTransport());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.ComputeOnly());
+  EXPECT_FALSE(copy.UseTransport());
+
+  config.SetComputeOnly(false);
+  EXPECT_TRUE(config.UseTransport());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, UseSystemProfiling)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.UseSystemProfiling());
+
+  config.SetUseSystemProfiling(true);
+  EXPECT_TRUE(config.UseSystemProfiling());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.UseSystemProfiling());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, EntityIdRecycling)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.EntityIdRecycling());
+
+  config.SetEntityIdRecycling(true);
+  EXPECT_TRUE(config.EntityIdRecycling());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.EntityIdRecycling());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, WorldCache)
+{
+  ServerConfig config;
+  EXPECT_TRUE(config.WorldCache().empty());
+
+  config.SetWorldCache("world_cache");
+  EXPECT_EQ("world_cache", config.WorldCache());
+
+  ServerConfig copy(config);
+  EXPECT_EQ("world_cache", copy.WorldCache());
+
+  ServerConfig assigned;
+  assigned = config;
+  EXPECT_EQ("world_cache", assigned.WorldCache());
+
+  // An empty path goes back to the environment variable
+  config.SetWorldCache("");
+  EXPECT_TRUE(config.WorldCache().empty());
+  EXPECT_EQ("world_cache", copy.WorldCache());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, RestoreFile)
+{
+  ServerConfig config;
+  EXPECT_TRUE(config.RestoreFile().empty());
+
+  config.SetRestoreFile("sim.ckpt");
+  EXPECT_EQ("sim.ckpt", config.RestoreFile());
+
+  ServerConfig copy(config);
+  EXPECT_EQ("sim.ckpt", copy.RestoreFile());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, ResourcePrefetchThreads)
+{
+  ServerConfig config;
+  EXPECT_EQ(8u, config.ResourcePrefetchThreads());
+
+  config.SetResourcePrefetchThreads(0u);
+  EXPECT_EQ(0u, config.ResourcePrefetchThreads());
+
+  ServerConfig copy(config);
+  EXPECT_EQ(0u, copy.ResourcePrefetchThreads());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, PhysicsSubsteps)
+{
+  ServerConfig config;
+  EXPECT_EQ(0u, config.PhysicsSubsteps());
+
+  config.SetPhysicsSubsteps(10u);
+  EXPECT_EQ(10u, config.PhysicsSubsteps());
+
+  ServerConfig copy(config);
+  EXPECT_EQ(10u, copy.PhysicsSubsteps());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, ShareIdenticalComponents)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.ShareIdenticalComponents());
+
+  config.SetShareIdenticalComponents(true);
+  EXPECT_TRUE(config.ShareIdenticalComponents());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.ShareIdenticalComponents());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, PreloadMeshes)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.PreloadMeshes());
+
+  config.SetPreloadMeshes(true);
+  EXPECT_TRUE(config.PreloadMeshes());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.PreloadMeshes());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, DeferLevelIncludes)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.DeferLevelIncludes());
+
+  config.SetDeferLevelIncludes(true);
+  EXPECT_TRUE(config.DeferLevelIncludes());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.DeferLevelIncludes());
+}
@@ -18,6 +18,9 @@
 
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <set>
+
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/server_control.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
@@ -33,6 +36,8 @@
 
 #include "gz/sim/Util.hh"
 #include "SimulationRunner.hh"
+#include "StartupTimeline.hh"
+#include "ThreadPool.hh"
 
 using namespace gz;
 using namespace sim;
@@ -189,6 +194,59 @@ bool ServerPrivate::Run(const uint64_t _iterations,
   return result;
 }
 
+//////////////////////////////////////////////////
+bool ServerPrivate::RunBatch(const uint64_t _iterations,
+    const Server::BatchCallback &_callback)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->runMutex);
+    if (this->running)
+    {
+      gzwarn << "The server is already running.\n";
+      return false;
+    }
+    if (this->config.UseDistributedSimulation())
+    {
+      gzerr << "Distributed simulations can't be run in batches.\n";
+      return false;
+    }
+    this->running = true;
+  }
+
+  for (auto &runner : this->simRunners)
+    runner->SetPaused(false);
+
+  // Worlds are small, so each one is a chunk of its own, and the pool
+  // balances them over its threads
+  auto &pool = ThreadPool::Shared();
+  const auto stepWorlds = [this](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+      this->simRunners[i]->RunIteration();
+  };
+
+  uint64_t iteration{0};
+  for (; iteration < _iterations && this->running; ++iteration)
+    pool.ParallelFor(this->simRunners.size(), 1u, stepWorlds);
+
+  if (_callback)
+  {
+    pool.ParallelFor(this->simRunners.size(), 1u,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const auto &runner = this->simRunners[i];
+          _callback(static_cast<unsigned int>(i), runner->CurrentInfo(),
+              runner->EntityCompMgr());
+        }
+      });
+  }
+
+  this->running = false;
+  return iteration == _iterations;
+}
+
 //////////////////////////////////////////////////
 void ServerPrivate::AddRecordPlugin(const ServerConfig &_config)
 {
@@ -293,12 +351,27 @@ void ServerPrivate::CreateEntities()
       this->worldNames.push_back(world->Name());
     }
     auto runner = std::make_unique<SimulationRunner>(
-        world, this->systemLoader, this->config);
+        world, this->systemLoader, this->config, this->deferredIncludes);
     runner->SetFuelUriMap(this->fuelUriMap);
     this->simRunners.push_back(std::move(runner));
   }
 }
 
+//////////////////////////////////////////////////
+bool ServerPrivate::RestoreCheckpoint(const Checkpoint &_checkpoint)
+{
+  std::lock_guard<std::mutex> lock(this->worldsMutex);
+  for (std::size_t i = 0; i < this->worldNames.size(); ++i)
+  {
+    if (this->worldNames[i] == _checkpoint.worldName)
+      return this->simRunners[i]->RestoreCheckpoint(_checkpoint);
+  }
+
+  gzerr << "World [" << _checkpoint.worldName << "] of the checkpoint "
+        << "wasn't loaded, it can't be restored." << std::endl;
+  return false;
+}
+
 //////////////////////////////////////////////////
 void ServerPrivate::SetupTransport()
 {
@@ -356,6 +429,19 @@ void ServerPrivate::SetupTransport()
            << "]" << std::endl;
   }
 
+  std::string timelineService{"/gazebo/startup_timeline"};
+  if (this->node.Advertise(timelineService,
+      &ServerPrivate::StartupTimelineService, this))
+  {
+    gzmsg << "Startup timeline service on [" << timelineService << "]."
+           << std::endl;
+  }
+  else
+  {
+    gzerr << "Something went wrong, failed to advertise [" << timelineService
+           << "]" << std::endl;
+  }
+
   std::string pathTopic{"/gazebo/resource_paths"};
   this->pathPub = this->node.Advertise<msgs::StringMsg_V>(pathTopic);
 
@@ -465,6 +551,13 @@ void ServerPrivate::AddResourcePathsService(
   this->pathPub.Publish(msg);
 }
 
+//////////////////////////////////////////////////
+bool ServerPrivate::StartupTimelineService(msgs::StringMsg &_res)
+{
+  _res.set_data(StartupTimeline::Instance().ChromeTrace());
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool ServerPrivate::ResourcePathsService(
     msgs::StringMsg_V &_res)
@@ -565,3 +658,87 @@ std::string ServerPrivate::FetchResourceUri(const common::URI &_uri)
 {
   return this->FetchResource(_uri.Str());
 }
+
+//////////////////////////////////////////////////
+/// \brief Collect the remote URIs included by an SDF element and its
+/// descendants.
+/// \param[in] _elem SDF element.
+/// \param[in, out] _uris URIs found so far.
+static void includedRemoteUris(const tinyxml2::XMLElement *_elem,
+    std::set<std::string> &_uris)
+{
+  for (auto child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    if (std::string(child->Name()) == "include")
+    {
+      auto uriElem = child->FirstChildElement("uri");
+      if (nullptr != uriElem && nullptr != uriElem->GetText())
+      {
+        const auto uri = common::trimmed(uriElem->GetText());
+        if (uri.rfind("http://", 0) == 0 || uri.rfind("https://", 0) == 0)
+          _uris.insert(uri);
+      }
+    }
+    includedRemoteUris(child, _uris);
+  }
+}
+
+//////////////////////////////////////////////////
+void ServerPrivate::PrefetchResources(const std::string &_sdf,
+    unsigned int _threads)
+{
+  if (_threads == 0u || nullptr == this->fuelClient)
+    return;
+
+  // Invalid documents are reported when they're loaded
+  tinyxml2::XMLDocument doc;
+  if (doc.Parse(_sdf.c_str()) != tinyxml2::XML_SUCCESS ||
+      nullptr == doc.RootElement())
+  {
+    return;
+  }
+
+  std::set<std::string> uriSet;
+  includedRemoteUris(doc.RootElement(), uriSet);
+  if (uriSet.empty())
+    return;
+  const std::vector<std::string> uris(uriSet.begin(), uriSet.end());
+
+  StartupTimeline::Scope prefetchScope("Prefetch Fuel models", "fuel");
+  const auto threadCount = std::min<std::size_t>(_threads, uris.size());
+  gzmsg << "Prefetching [" << uris.size() << "] included models with up "
+        << "to [" << threadCount << "] concurrent downloads.\n";
+
+  // Models that are already in the local cache aren't downloaded again
+  std::atomic<std::size_t> next{0u};
+  std::size_t done{0u};
+  std::mutex doneMutex;
+  auto fetch = [&]()
+  {
+    fuel_tools::FuelClient client(this->fuelClient->Config());
+    for (std::size_t i = next++; i < uris.size(); i = next++)
+    {
+      const auto path = fuel_tools::fetchResourceWithClient(uris[i], client);
+
+      std::lock_guard<std::mutex> lock(doneMutex);
+      ++done;
+      if (path.empty())
+      {
+        gzwarn << "Failed to prefetch [" << uris[i] << "], it will be "
+               << "fetched again while loading the world.\n";
+      }
+      else
+      {
+        gzmsg << "Prefetched model [" << done << "/" << uris.size()
+              << "] [" << uris[i] << "].\n";
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0u; i < threadCount; ++i)
+    workers.emplace_back(fetch);
+  for (auto &worker : workers)
+    worker.join();
+}
@@ -45,6 +45,7 @@
 
 #include "gz/sim/config.hh"
 #include "gz/sim/Export.hh"
+#include "gz/sim/Server.hh"
 #include "gz/sim/ServerConfig.hh"
 #include "gz/sim/SystemLoader.hh"
 
@@ -56,6 +57,8 @@ namespace gz
   {
     // Inline bracket to help doxygen filtering.
     inline namespace GZ_SIM_VERSION_NAMESPACE {
+    struct Checkpoint;
+    class DeferredIncludes;
     class SimulationRunner;
 
     // Private data for Server
@@ -74,6 +77,16 @@ namespace gz
       public: bool Run(const uint64_t _iterations,
                  std::optional<std::condition_variable *> _cond = std::nullopt);
 
+      /// \brief Step all simulation runners in lockstep on the shared
+      /// thread pool.
+      /// \param[in] _iterations Number of iterations.
+      /// \param[in] _callback Optional function called for every runner at
+      /// the end.
+      /// \return True if all iterations were run.
+      /// \sa Server::RunBatch
+      public: bool RunBatch(const uint64_t _iterations,
+                  const Server::BatchCallback &_callback);
+
       /// \brief Add logging record plugin.
       /// \param[in] _config Server configuration parameters.
       public: void AddRecordPlugin(const ServerConfig &_config);
@@ -81,6 +94,12 @@ namespace gz
       /// \brief Create all entities that exist in the sdf::Root object.
       public: void CreateEntities();
 
+      /// \brief Resume the world of a checkpoint. This is called after
+      /// CreateEntities, before the simulation runs.
+      /// \param[in] _checkpoint The checkpoint.
+      /// \return True if the world was found and restored.
+      public: bool RestoreCheckpoint(const Checkpoint &_checkpoint);
+
       /// \brief Stop server.
       public: void Stop();
 
@@ -99,6 +118,14 @@ namespace gz
       /// \return Path to the downloaded resource, empty on error.
       public: std::string FetchResourceUri(const common::URI &_uri);
 
+      /// \brief Download the Fuel models included by an SDF document
+      /// concurrently, so that loading it finds them in the local cache
+      /// instead of downloading them one after the other.
+      /// \param[in] _sdf SDF document.
+      /// \param[in] _threads Maximum number of concurrent downloads.
+      public: void PrefetchResources(const std::string &_sdf,
+                  unsigned int _threads);
+
       /// \brief Signal handler callback
       /// \param[in] _sig The signal number
       private: void OnSignal(int _sig);
@@ -118,6 +145,12 @@ namespace gz
       /// \return True if successful.
       private: bool ResourcePathsService(gz::msgs::StringMsg_V &_res);
 
+      /// \brief Callback for the startup timeline service.
+      /// \param[out] _res Response filled with the phases recorded since the
+      /// server was created, as a Chrome trace.
+      /// \return True.
+      private: bool StartupTimelineService(gz::msgs::StringMsg &_res);
+
       /// \brief Callback for a resource path resolve service. This service
       /// will return the full path to a provided resource's URI. An empty
       /// string and return value of false will be used if the resource could
@@ -177,6 +210,10 @@ namespace gz
       /// pointer to child nodes of the root
       public: sdf::Root sdfRoot;
 
+      /// \brief Includes of the world's levels which are parsed when their
+      /// level becomes active, or nullptr if they're loaded with the world.
+      public: std::shared_ptr<DeferredIncludes> deferredIncludes;
+
       /// \brief The server configuration.
       public: ServerConfig config;
 
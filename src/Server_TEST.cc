@@ -23,6 +23,9 @@
 #include <gz/msgs/stringmsg_v.pb.h>
 
 #include <csignal>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <gz/common/StringUtils.hh>
 #include <gz/common/Util.hh>
@@ -43,6 +46,7 @@
 #include "gz/sim/Util.hh"
 #include "test_config.hh"
 
+#include "ThreadPool.hh"
 #include "plugins/MockSystem.hh"
 #include "../test/helpers/Relay.hh"
 #include "../test/helpers/EnvTestFixture.hh"
@@ -539,6 +543,49 @@ TEST_P(ServerFixture, RunBlocking)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(ComputeOnly))
+{
+  sim::ServerConfig serverConfig;
+  serverConfig.SetComputeOnly(true);
+  // 2 seconds for 20 iterations, if they were paced
+  serverConfig.SetUpdateRate(10.0);
+
+  sim::Server server(serverConfig);
+
+  // Only the physics system of the defaults is loaded
+  EXPECT_EQ(1u, *server.SystemCount());
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(server.Run(true, 20, false));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+  EXPECT_EQ(20u, *server.IterationCount());
+}
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, Deterministic)
+{
+  sim::ServerConfig serverConfig;
+  serverConfig.SetDeterministic(true);
+
+  {
+    sim::Server server(serverConfig);
+    EXPECT_TRUE(sim::ThreadPool::Deterministic());
+    {
+      sim::Server other(serverConfig);
+      EXPECT_TRUE(sim::ThreadPool::Deterministic());
+    }
+
+    // The remaining deterministic server keeps the mode on
+    EXPECT_TRUE(sim::ThreadPool::Deterministic());
+  }
+
+  // Later servers aren't affected
+  EXPECT_FALSE(sim::ThreadPool::Deterministic());
+  sim::Server server{sim::ServerConfig()};
+  EXPECT_FALSE(sim::ThreadPool::Deterministic());
+}
+
 /////////////////////////////////////////////////
 TEST_P(ServerFixture, RunNonBlockingPaused)
 {
@@ -1266,6 +1313,48 @@ TEST_P(ServerFixture, Stop)
   EXPECT_FALSE(server.Running());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(RunBatch))
+{
+  std::string sdf = "<?xml version='1.0'?><sdf version='1.6'>";
+  for (int i = 0; i < 3; ++i)
+    sdf += "<world name='env" + std::to_string(i) + "'/>";
+  sdf += "</sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf);
+  sim::Server server(serverConfig);
+  EXPECT_EQ(0u, *server.IterationCount());
+
+  std::mutex resultsMutex;
+  std::map<unsigned int, uint64_t> iterations;
+  const auto collect = [&](unsigned int _worldIndex,
+      const sim::UpdateInfo &_info, const sim::EntityComponentManager &)
+  {
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    iterations[_worldIndex] = _info.iterations;
+  };
+
+  // All worlds step in lockstep
+  EXPECT_TRUE(server.RunBatch(5, collect));
+  ASSERT_EQ(3u, iterations.size());
+  for (const auto &[index, count] : iterations)
+    EXPECT_EQ(5u, count) << index;
+  EXPECT_FALSE(server.Running());
+
+  // Batches continue where the previous one stopped
+  iterations.clear();
+  EXPECT_TRUE(server.RunBatch(3, collect));
+  ASSERT_EQ(3u, iterations.size());
+  for (const auto &[index, count] : iterations)
+    EXPECT_EQ(8u, count) << index;
+
+  // Batches can't run while the server is running
+  EXPECT_TRUE(server.Run(false, 0, false));
+  EXPECT_FALSE(server.RunBatch(1));
+  server.Stop();
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_SUITE_P(ServerRepeat, ServerFixture, ::testing::Range(1, 2));
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gz/sim/SharedStateRegion.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Magic bytes of initialized regions.
+constexpr char kMagic[8] = {'G', 'Z', 'S', 'I', 'M', 'S', 'S', 'T'};
+
+/// \brief Version of the layout, increased whenever it changes.
+constexpr std::uint32_t kVersion{1u};
+
+/// \brief Written in host byte order, so other byte orders are rejected.
+constexpr std::uint32_t kByteOrderMarker{0x01020304u};
+
+static_assert(std::is_trivially_copyable_v<SharedStateEntity>,
+    "Entity records are copied to and from shared memory");
+
+/// \brief Layout of the start of the shared memory, followed by the entity
+/// records and the joint values.
+struct SharedStateHeader
+{
+  /// \brief Always "GZSIMSST", set once the region is initialized.
+  char magic[8];
+
+  /// \brief Version of the layout.
+  std::uint32_t version;
+
+  /// \brief Byte order marker.
+  std::uint32_t byteOrder;
+
+  /// \brief Size of a SharedStateEntity, to catch mismatched builds.
+  std::uint64_t entitySize;
+
+  /// \brief Number of entity records the region can hold.
+  std::uint64_t maxEntities;
+
+  /// \brief Number of joint values the region can hold.
+  std::uint64_t maxJointValues;
+
+  /// \brief Odd while a frame is being written. On its own cache line, so
+  /// readers polling it don't share the line with the frame.
+  alignas(64) std::atomic<std::uint64_t> sequence;
+
+  /// \brief Version of the set of entities of the frame.
+  alignas(64) std::uint64_t entitySetVersion;
+
+  /// \brief Simulation time of the frame in nanoseconds.
+  std::int64_t simTime;
+
+  /// \brief Iteration of the frame.
+  std::uint64_t iterations;
+
+  /// \brief Number of entity records in the frame.
+  std::uint64_t entityCount;
+
+  /// \brief Number of joint values in the frame.
+  std::uint64_t jointValueCount;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+    "The sequence is shared between processes");
+
+/// \brief Size of the shared memory.
+/// \param[in] _maxEntities Number of entity records.
+/// \param[in] _maxJointValues Number of joint values.
+/// \return Size in bytes.
+std::size_t regionSize(std::size_t _maxEntities, std::size_t _maxJointValues)
+{
+  return sizeof(SharedStateHeader) + _maxEntities * sizeof(SharedStateEntity)
+      + _maxJointValues * sizeof(double);
+}
+}
+
+/// \brief Private data for SharedStateRegion.
+class gz::sim::SharedStateRegion::Implementation
+{
+  /// \brief Name of the region.
+  public: std::string name;
+
+  /// \brief Header at the start of the mapped memory.
+  public: SharedStateHeader *header{nullptr};
+
+  /// \brief Entity records following the header.
+  public: SharedStateEntity *entities{nullptr};
+
+  /// \brief Joint values following the entity records.
+  public: double *jointValues{nullptr};
+
+  /// \brief Size of the mapped memory.
+  public: std::size_t mappedSize{0u};
+
+  /// \brief True if this object created the region, and can write it.
+  public: bool owner{false};
+};
+
+//////////////////////////////////////////////////
+SharedStateRegion::SharedStateRegion()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<SharedStateRegion> SharedStateRegion::Create(
+    const std::string &_name, std::size_t _maxEntities,
+    std::size_t _maxJointValues)
+{
+#ifndef _WIN32
+  // A region left behind by a process which crashed is replaced
+  int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 && errno == EEXIST)
+  {
+    shm_unlink(_name.c_str());
+    fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+  if (fd < 0)
+  {
+    gzwarn << "Failed to create shared state region [" << _name << "]: "
+           << std::strerror(errno) << std::endl;
+    return nullptr;
+  }
+
+  const std::size_t size = regionSize(_maxEntities, _maxJointValues);
+  void *memory = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    gzwarn << "Failed to map shared state region [" << _name << "]: "
+           << std::strerror(errno) << std::endl;
+    shm_unlink(_name.c_str());
+    return nullptr;
+  }
+
+  auto header = new (memory) SharedStateHeader;
+  header->version = kVersion;
+  header->byteOrder = kByteOrderMarker;
+  header->entitySize = sizeof(SharedStateEntity);
+  header->maxEntities = _maxEntities;
+  header->maxJointValues = _maxJointValues;
+  header->entitySetVersion = 0u;
+  header->simTime = 0;
+  header->iterations = 0u;
+  header->entityCount = 0u;
+  header->jointValueCount = 0u;
+  header->sequence.store(0u, std::memory_order_relaxed);
+
+  // Readers check the magic last
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header->magic, kMagic, sizeof(kMagic));
+
+  std::unique_ptr<SharedStateRegion> region(new SharedStateRegion);
+  auto &data = *region->dataPtr;
+  data.name = _name;
+  data.header = header;
+  data.entities = reinterpret_cast<SharedStateEntity *>(header + 1);
+  data.jointValues = reinterpret_cast<double *>(data.entities + _maxEntities);
+  data.mappedSize = size;
+  data.owner = true;
+  return region;
+#else
+  gzwarn << "Shared state regions aren't supported on Windows, not "
+         << "creating [" << _name << "] for [" << _maxEntities
+         << "] entities and [" << _maxJointValues << "] joint values."
+         << std::endl;
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<SharedStateRegion> SharedStateRegion::Open(
+    const std::string &_name)
+{
+#ifndef _WIN32
+  // Readers only map the region for reading, so they can't corrupt it
+  const int fd = shm_open(_name.c_str(), O_RDONLY, 0600);
+  if (fd < 0)
+  {
+    gzwarn << "Failed to open shared state region [" << _name << "]: "
+           << std::strerror(errno) << std::endl;
+    return nullptr;
+  }
+
+  struct stat info;
+  void *memory = MAP_FAILED;
+  std::size_t size = 0u;
+  if (fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) >= sizeof(SharedStateHeader))
+  {
+    size = static_cast<std::size_t>(info.st_size);
+    memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    gzwarn << "Failed to map shared state region [" << _name << "]."
+           << std::endl;
+    return nullptr;
+  }
+
+  auto header = static_cast<SharedStateHeader *>(memory);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->byteOrder != kByteOrderMarker ||
+      header->entitySize != sizeof(SharedStateEntity) ||
+      regionSize(header->maxEntities, header->maxJointValues) != size)
+  {
+    gzwarn << "Shared memory [" << _name << "] isn't a valid shared state "
+           << "region." << std::endl;
+    munmap(memory, size);
+    return nullptr;
+  }
+
+  std::unique_ptr<SharedStateRegion> region(new SharedStateRegion);
+  auto &data = *region->dataPtr;
+  data.name = _name;
+  data.header = header;
+  data.entities = reinterpret_cast<SharedStateEntity *>(header + 1);
+  data.jointValues =
+      reinterpret_cast<double *>(data.entities + header->maxEntities);
+  data.mappedSize = size;
+  return region;
+#else
+  gzwarn << "Shared state regions aren't supported on Windows, not "
+         << "opening [" << _name << "]." << std::endl;
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+SharedStateRegion::~SharedStateRegion()
+{
+#ifndef _WIN32
+  if (nullptr == this->dataPtr->header)
+    return;
+  if (this->dataPtr->owner)
+    shm_unlink(this->dataPtr->name.c_str());
+  munmap(this->dataPtr->header, this->dataPtr->mappedSize);
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SharedStateRegion::Write(const SharedStateFrame &_frame)
+{
+  auto &data = *this->dataPtr;
+  if (!data.owner)
+    return false;
+
+  auto header = data.header;
+  const auto entityCount = std::min<std::size_t>(_frame.entities.size(),
+      header->maxEntities);
+  const auto jointValueCount = std::min<std::size_t>(
+      _frame.jointValues.size(), header->maxJointValues);
+
+  // Readers that see the odd sequence, or a different one after copying,
+  // retry
+  const auto sequence = header->sequence.load(std::memory_order_relaxed);
+  header->sequence.store(sequence + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  header->entitySetVersion = _frame.entitySetVersion;
+  header->simTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _frame.simTime).count();
+  header->iterations = _frame.iterations;
+  header->entityCount = entityCount;
+  header->jointValueCount = jointValueCount;
+  if (entityCount > 0u)
+  {
+    std::memcpy(data.entities, _frame.entities.data(),
+        entityCount * sizeof(SharedStateEntity));
+  }
+  if (jointValueCount > 0u)
+  {
+    std::memcpy(data.jointValues, _frame.jointValues.data(),
+        jointValueCount * sizeof(double));
+  }
+
+  header->sequence.store(sequence + 2u, std::memory_order_release);
+  return entityCount == _frame.entities.size() &&
+      jointValueCount == _frame.jointValues.size();
+}
+
+//////////////////////////////////////////////////
+bool SharedStateRegion::Read(SharedStateFrame &_frame,
+    unsigned int _attempts) const
+{
+  const auto &data = *this->dataPtr;
+  const auto header = data.header;
+  for (unsigned int attempt = 0u; attempt < _attempts; ++attempt)
+  {
+    const auto before = header->sequence.load(std::memory_order_acquire);
+    if (0u == before)
+      return false;
+    if (before % 2u == 1u)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // The counts may be torn too, so they're clamped before copying
+    const auto entityCount = std::min<std::uint64_t>(header->entityCount,
+        header->maxEntities);
+    const auto jointValueCount = std::min<std::uint64_t>(
+        header->jointValueCount, header->maxJointValues);
+    _frame.entitySetVersion = header->entitySetVersion;
+    _frame.simTime = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(header->simTime));
+    _frame.iterations = header->iterations;
+    _frame.entities.resize(entityCount);
+    _frame.jointValues.resize(jointValueCount);
+    if (entityCount > 0u)
+    {
+      std::memcpy(_frame.entities.data(), data.entities,
+          entityCount * sizeof(SharedStateEntity));
+    }
+    if (jointValueCount > 0u)
+    {
+      std::memcpy(_frame.jointValues.data(), data.jointValues,
+          jointValueCount * sizeof(double));
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->sequence.load(std::memory_order_relaxed) == before)
+    {
+      _frame.sequence = before;
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t SharedStateRegion::Sequence() const
+{
+  return this->dataPtr->header->sequence.load(std::memory_order_acquire);
+}
+
+//////////////////////////////////////////////////
+std::size_t SharedStateRegion::MaxEntities() const
+{
+  return this->dataPtr->header->maxEntities;
+}
+
+//////////////////////////////////////////////////
+std::size_t SharedStateRegion::MaxJointValues() const
+{
+  return this->dataPtr->header->maxJointValues;
+}
+
+//////////////////////////////////////////////////
+const std::string &SharedStateRegion::Name() const
+{
+  return this->dataPtr->name;
+}
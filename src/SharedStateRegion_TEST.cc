@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/SharedStateRegion.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(SharedStateRegion, GZ_UTILS_TEST_DISABLED_ON_WIN32(RoundTrip))
+{
+  auto writer = SharedStateRegion::Create("/gz_sim_test_state", 2u, 4u);
+  ASSERT_NE(nullptr, writer);
+  auto reader = SharedStateRegion::Open("/gz_sim_test_state");
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ("/gz_sim_test_state", reader->Name());
+  EXPECT_EQ(2u, reader->MaxEntities());
+  EXPECT_EQ(4u, reader->MaxJointValues());
+
+  SharedStateFrame frame;
+  EXPECT_EQ(0u, reader->Sequence());
+  EXPECT_FALSE(reader->Read(frame));
+
+  SharedStateFrame written;
+  written.entitySetVersion = 3u;
+  written.simTime = 1500ms;
+  written.iterations = 1500u;
+  written.entities.resize(2u);
+  written.entities[0].entity = 5u;
+  std::strncpy(written.entities[0].name, "box",
+      sizeof(written.entities[0].name) - 1u);
+  written.entities[0].pose[2] = 0.5;
+  written.entities[1].entity = 6u;
+  written.entities[1].type = SharedStateEntityType::Joint;
+  written.entities[1].jointDofs = 2u;
+  written.jointValues = {0.1, 0.2, 0.3, 0.4};
+  EXPECT_TRUE(writer->Write(written));
+
+  ASSERT_TRUE(reader->Read(frame));
+  EXPECT_EQ(2u, frame.sequence);
+  EXPECT_EQ(reader->Sequence(), frame.sequence);
+  EXPECT_EQ(3u, frame.entitySetVersion);
+  EXPECT_EQ(1500ms, frame.simTime);
+  EXPECT_EQ(1500u, frame.iterations);
+  ASSERT_EQ(2u, frame.entities.size());
+  EXPECT_EQ(5u, frame.entities[0].entity);
+  EXPECT_STREQ("box", frame.entities[0].name);
+  EXPECT_DOUBLE_EQ(0.5, frame.entities[0].pose[2]);
+  EXPECT_DOUBLE_EQ(1.0, frame.entities[0].pose[3]);
+  EXPECT_EQ(SharedStateEntityType::Joint, frame.entities[1].type);
+  EXPECT_EQ(written.jointValues, frame.jointValues);
+
+  // Readers can't write, and frames that don't fit are truncated
+  EXPECT_FALSE(reader->Write(written));
+  written.entities.resize(3u);
+  EXPECT_FALSE(writer->Write(written));
+  ASSERT_TRUE(reader->Read(frame));
+  EXPECT_EQ(4u, frame.sequence);
+  EXPECT_EQ(2u, frame.entities.size());
+
+  EXPECT_EQ(nullptr, SharedStateRegion::Open("/gz_sim_test_missing"));
+}
+
+/////////////////////////////////////////////////
+TEST(SharedStateRegion, GZ_UTILS_TEST_DISABLED_ON_WIN32(ConsistentFrames))
+{
+  auto writer = SharedStateRegion::Create("/gz_sim_test_seqlock", 64u, 256u);
+  ASSERT_NE(nullptr, writer);
+  auto reader = SharedStateRegion::Open("/gz_sim_test_seqlock");
+  ASSERT_NE(nullptr, reader);
+
+  // Every value of a frame is its iteration, so a torn frame mixes them
+  std::atomic<bool> done{false};
+  std::atomic<bool> torn{false};
+  std::atomic<int> reads{0};
+  std::thread readerThread([&]
+  {
+    SharedStateFrame frame;
+    while (!done)
+    {
+      if (!reader->Read(frame))
+        continue;
+      ++reads;
+      for (const auto &entity : frame.entities)
+      {
+        if (entity.entity != frame.iterations)
+          torn = true;
+      }
+      for (const auto value : frame.jointValues)
+      {
+        if (value != static_cast<double>(frame.iterations))
+          torn = true;
+      }
+    }
+  });
+
+  SharedStateFrame frame;
+  frame.entities.resize(64u);
+  frame.jointValues.resize(256u);
+  const auto end = std::chrono::steady_clock::now() + 500ms;
+  for (std::uint64_t i = 1u;
+       std::chrono::steady_clock::now() < end || reads < 100; ++i)
+  {
+    frame.iterations = i;
+    for (auto &entity : frame.entities)
+      entity.entity = i;
+    for (auto &value : frame.jointValues)
+      value = static_cast<double>(i);
+    EXPECT_TRUE(writer->Write(frame));
+  }
+  done = true;
+  readerThread.join();
+  EXPECT_FALSE(torn);
+}
@@ -18,6 +18,20 @@
 #include "SimulationRunner.hh"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
 #ifdef HAVE_PYBIND11
 #include <pybind11/pybind11.h>
 #endif
@@ -26,16 +40,46 @@
 #include <gz/msgs/clock.pb.h>
 #include <gz/msgs/gui.pb.h>
 #include <gz/msgs/log_playback_control.pb.h>
+#include <gz/msgs/param.pb.h>
+#include <gz/msgs/param_v.pb.h>
 #include <gz/msgs/sdf_generator_config.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
+#include <gz/msgs/uint32.pb.h>
 #include <gz/msgs/world_control.pb.h>
 #include <gz/msgs/world_control_state.pb.h>
 #include <gz/msgs/world_stats.pb.h>
 
+#include <sdf/OutputConfig.hh>
 #include <sdf/Root.hh>
+#include <sdf/SDFImpl.hh>
 
 #include "gz/common/Profiler.hh"
+#include "gz/sim/components/AirPressureSensor.hh"
+#include "gz/sim/components/AirSpeedSensor.hh"
+#include "gz/sim/components/Altimeter.hh"
+#include "gz/sim/components/BoundingBoxCamera.hh"
+#include "gz/sim/components/Camera.hh"
+#include "gz/sim/components/CustomSensor.hh"
+#include "gz/sim/components/DepthCamera.hh"
+#include "gz/sim/components/Factory.hh"
+#include "gz/sim/components/ForceTorque.hh"
+#include "gz/sim/components/Geometry.hh"
+#include "gz/sim/components/GpuLidar.hh"
+#include "gz/sim/components/Imu.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointPositionReset.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/JointVelocityReset.hh"
+#include "gz/sim/components/Lidar.hh"
+#include "gz/sim/components/Magnetometer.hh"
+#include "gz/sim/components/Material.hh"
 #include "gz/sim/components/Model.hh"
+#include "gz/sim/components/NavSat.hh"
+#include "gz/sim/components/RgbdCamera.hh"
+#include "gz/sim/components/SegmentationCamera.hh"
+#include "gz/sim/components/SourceFilePath.hh"
+#include "gz/sim/components/ThermalCamera.hh"
+#include "gz/sim/components/WideAngleCamera.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/Visual.hh"
@@ -50,6 +94,8 @@
 #include "gz/transport/TopicUtils.hh"
 #include "network/NetworkManagerPrimary.hh"
 #include "SdfGenerator.hh"
+#include "StartupTimeline.hh"
+#include "StateSnapshot.hh"
 
 using namespace gz;
 using namespace sim;
@@ -85,16 +131,105 @@ struct MaybeGilScopedRelease
     MaybeGilScopedRelease(){}
   };
 #endif
+
+/// \brief Time before a step deadline spent busy-waiting instead of
+/// sleeping, to cover the wake-up latency of the scheduler.
+constexpr std::chrono::microseconds kPacingSpinTime{200};
+
+/// \brief Number of steps over which the pacing jitter is summarized.
+constexpr uint64_t kPacingJitterWindow{1000};
+
+/// \brief Longest wait for a step credit in lockstep before processing
+/// world control requests again.
+constexpr std::chrono::milliseconds kStepCreditTimeout{100};
+
+//////////////////////////////////////////////////
+/// \brief Sleep until shortly before a deadline, then busy-wait until it.
+/// \param[in] _deadline Time to wait for.
+void sleepUntilPrecisely(
+    const std::chrono::steady_clock::time_point &_deadline)
+{
+  const auto wake = _deadline - kPacingSpinTime;
+  if (std::chrono::steady_clock::now() < wake)
+  {
+#ifdef __linux__
+    // The steady clock is CLOCK_MONOTONIC, and an absolute deadline doesn't
+    // accumulate the error of computing a relative one.
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        wake.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);  // NOLINT
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR)
+    {
+    }
+#else
+    std::this_thread::sleep_until(wake);
+#endif
+  }
+
+  while (std::chrono::steady_clock::now() < _deadline)
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Pin the calling thread to a CPU and set its real-time priority.
+/// \param[in] _cpu Index of the CPU, or -1 to not pin the thread.
+/// \param[in] _priority SCHED_FIFO priority, or 0 to keep the policy.
+void configureSimulationThread(int _cpu, int _priority)
+{
+#ifdef __linux__
+  if (_cpu >= 0)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    int err = EINVAL;
+    if (_cpu < CPU_SETSIZE)
+    {
+      CPU_SET(_cpu, &set);
+      err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    if (err != 0)
+    {
+      gzwarn << "Failed to pin the simulation thread to CPU [" << _cpu
+             << "]: " << std::strerror(err) << std::endl;
+    }
+  }
+  if (_priority > 0)
+  {
+    sched_param param{};
+    param.sched_priority = _priority;
+    const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0)
+    {
+      gzwarn << "Failed to set the SCHED_FIFO priority of the simulation "
+             << "thread to [" << _priority << "]: " << std::strerror(err)
+             << std::endl;
+    }
+  }
+#else
+  if (_cpu >= 0 || _priority > 0)
+  {
+    gzwarn << "Pinning the simulation thread and setting its priority are "
+           << "only supported on Linux." << std::endl;
+  }
+#endif
+}
 }
 
 
 //////////////////////////////////////////////////
 SimulationRunner::SimulationRunner(const sdf::World *_world,
                                    const SystemLoaderPtr &_systemLoader,
-                                   const ServerConfig &_config)
+                                   const ServerConfig &_config,
+                                   std::shared_ptr<DeferredIncludes>
+                                       _deferredIncludes)
     // \todo(nkoenig) Either copy the world, or add copy constructor to the
     // World and other elements.
-    : sdfWorld(_world), serverConfig(_config)
+    : sdfWorld(_world), deferredIncludes(std::move(_deferredIncludes)),
+      serverConfig(_config)
 {
   if (nullptr == _world)
   {
@@ -193,11 +328,76 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
 
   this->node = std::make_unique<transport::Node>(opts);
 
+  // Components are created as soon as the world is loaded, so the storage
+  // layout and entity ID allocation need to be set before anything else
+  // touches the ECM.
+  this->entityCompMgr.SetComponentStorage(_config.ComponentStorage());
+  this->entityCompMgr.SetEntityIdRecycling(_config.EntityIdRecycling());
+
+  // Components that are rarely written after they're loaded, and often
+  // identical across copies of a model
+  if (_config.ShareIdenticalComponents())
+  {
+    this->internedComponentTypes = {
+        components::SourceFilePath::typeId,
+        components::Geometry::typeId,
+        components::Material::typeId,
+        components::AirPressureSensor::typeId,
+        components::AirSpeedSensor::typeId,
+        components::Altimeter::typeId,
+        components::BoundingBoxCamera::typeId,
+        components::Camera::typeId,
+        components::CustomSensor::typeId,
+        components::DepthCamera::typeId,
+        components::ForceTorque::typeId,
+        components::GpuLidar::typeId,
+        components::Imu::typeId,
+        components::Lidar::typeId,
+        components::Magnetometer::typeId,
+        components::NavSat::typeId,
+        components::RgbdCamera::typeId,
+        components::SegmentationCamera::typeId,
+        components::ThermalCamera::typeId,
+        components::WideAngleCamera::typeId};
+  }
+
+  if (_config.PostUpdateThreadCount() > 0)
+  {
+    this->postUpdatePool =
+        std::make_unique<ThreadPool>(_config.PostUpdateThreadCount());
+  }
+
+  // Chunking is shared by all pools, so other servers in the process are
+  // deterministic too while this runner exists
+  if (_config.Deterministic())
+  {
+    ThreadPool::SetDeterministic(true);
+    this->deterministic = true;
+  }
+
   // Create the system manager
   this->systemMgr = std::make_unique<SystemManager>(
       _systemLoader, &this->entityCompMgr, &this->eventMgr, validNs,
       this->parametersRegistry.get());
 
+  if (_config.UseSystemProfiling())
+  {
+    this->systemMgr->SetProfiling(true);
+    this->profilePub = this->node->Advertise<msgs::Param_V>("profile");
+    this->memoryProfilePub =
+        this->node->Advertise<msgs::Param_V>("profile/memory");
+    gzmsg << "Publishing system timings on [" << opts.NameSpace()
+          << "/profile]" << std::endl;
+  }
+
+  if (_config.StateHashing())
+  {
+    this->stateHash = std::make_unique<StateHash>();
+    this->stateHashPub = this->node->Advertise<msgs::Param>("state_hash");
+    gzmsg << "Publishing state hashes on [" << opts.NameSpace()
+          << "/state_hash]" << std::endl;
+  }
+
   this->pauseConn = this->eventMgr.Connect<events::Pause>(
       std::bind(&SimulationRunner::SetPaused, this, std::placeholders::_1));
 
@@ -259,17 +459,49 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
 
   // If we have reached this point and no world systems have been loaded, then
   // load a default set of systems.
-  if (this->systemMgr->TotalByEntity(
+  if (this->serverConfig.UseDefaultPlugins() &&
+      this->systemMgr->TotalByEntity(
       worldEntity(this->entityCompMgr)).empty())
   {
     gzmsg << "No systems loaded from SDF, loading defaults" << std::endl;
     bool isPlayback = !this->serverConfig.LogPlaybackPath().empty();
     auto plugins = sim::loadPluginInfo(isPlayback);
+    if (this->serverConfig.ComputeOnly())
+    {
+      // Without transport, nothing uses these systems
+      static const StringSet kTransportOnlySystems{
+          "gz::sim::systems::SceneBroadcaster",
+          "gz::sim::systems::UserCommands"};
+      plugins.remove_if([](const ServerConfig::PluginInfo &_plugin)
+          {
+            return kTransportOnlySystems.count(_plugin.Plugin().Name()) > 0;
+          });
+    }
     this->LoadServerPlugins(plugins);
   }
 
   this->LoadLoggingPlugins(this->serverConfig);
 
+  // Publish empty GUI messages for worlds that have no GUI in the beginning.
+  // In the future, support modifying GUI from the server at runtime.
+  if (_world->Gui())
+  {
+    this->guiMsg = convert<msgs::GUI>(*_world->Gui());
+  }
+
+  gzmsg << "World [" << _world->Name() << "] initialized with ["
+         << physics->Name() << "] physics profile." << std::endl;
+
+  if (!_config.UseTransport())
+  {
+    if (_config.Lockstep())
+    {
+      gzwarn << "Lockstep requires transport, which is disabled. Simulation "
+             << "won't wait for step credits." << std::endl;
+    }
+    return;
+  }
+
   // TODO(louise) Combine both messages into one.
   this->node->Advertise("control", &SimulationRunner::OnWorldControl, this);
   this->node->Advertise("control/state", &SimulationRunner::OnWorldControlState,
@@ -281,34 +513,71 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
          << "/control], [" << opts.NameSpace() << "/control/state] and ["
          << opts.NameSpace() << "/playback/control]" << std::endl;
 
-  // Publish empty GUI messages for worlds that have no GUI in the beginning.
-  // In the future, support modifying GUI from the server at runtime.
-  if (_world->Gui())
-  {
-    this->guiMsg = convert<msgs::GUI>(*_world->Gui());
-  }
-
   std::string infoService{"gui/info"};
   this->node->Advertise(infoService, &SimulationRunner::GuiInfoService, this);
 
   gzmsg << "Serving GUI information on [" << opts.NameSpace() << "/"
          << infoService << "]" << std::endl;
 
-  gzmsg << "World [" << _world->Name() << "] initialized with ["
-         << physics->Name() << "] physics profile." << std::endl;
-
   std::string genWorldSdfService{"generate_world_sdf"};
   this->node->Advertise(
       genWorldSdfService, &SimulationRunner::GenerateWorldSdf, this);
 
   gzmsg << "Serving world SDF generation service on [" << opts.NameSpace()
          << "/" << genWorldSdfService << "]" << std::endl;
+
+  std::string saveWorldSdfService{"save_world_sdf"};
+  this->node->Advertise(
+      saveWorldSdfService, &SimulationRunner::SaveWorldSdf, this);
+
+  gzmsg << "Serving world SDF saving service on [" << opts.NameSpace()
+         << "/" << saveWorldSdfService << "]" << std::endl;
+
+  std::string checkpointService{"checkpoint"};
+  this->node->Advertise(
+      checkpointService, &SimulationRunner::SaveCheckpoint, this);
+
+  gzmsg << "Serving checkpoint service on [" << opts.NameSpace()
+         << "/" << checkpointService << "]" << std::endl;
+
+  std::string memoryUsageService{"memory_usage"};
+  this->node->Advertise(
+      memoryUsageService, &SimulationRunner::MemoryUsageService, this);
+
+  gzmsg << "Serving memory usage on [" << opts.NameSpace() << "/"
+         << memoryUsageService << "]" << std::endl;
+
+  if (_config.Lockstep())
+  {
+    this->node->Subscribe("lockstep/step", &SimulationRunner::OnStepCredits,
+        this);
+    this->lockstepDonePub = this->node->Advertise<msgs::Clock>(
+        "lockstep/done");
+
+    gzmsg << "Stepping in lockstep with credits from [" << opts.NameSpace()
+           << "/lockstep/step], notifying steps on [" << opts.NameSpace()
+           << "/lockstep/done]" << std::endl;
+  }
 }
 
 //////////////////////////////////////////////////
 SimulationRunner::~SimulationRunner()
 {
-  this->StopWorkerThreads();
+  this->StopStatsThread();
+
+  if (this->deterministic)
+    ThreadPool::SetDeterministic(false);
+
+  // The profiler only exists if system profiling was enabled
+  if (this->systemMgr && this->systemMgr->Profiler() &&
+      !this->systemMgr->Profiler()->Timings().empty())
+  {
+    auto summary = this->systemMgr->Profiler()->Summary();
+    if (!summary.empty() && summary.back() == '\n')
+      summary.pop_back();
+    gzmsg << "System timings for world [" << this->worldName << "]:\n"
+          << summary << std::endl;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -435,6 +704,7 @@ void SimulationRunner::UpdatePhysicsParams()
           ComponentState::OneTimeChange);
     }
   }
+
   this->entityCompMgr.RemoveComponent<components::PhysicsCmd>(worldEntity);
 }
 
@@ -443,15 +713,56 @@ void SimulationRunner::PublishStats()
 {
   GZ_PROFILE("SimulationRunner::PublishStats");
 
+  if (!this->serverConfig.UseTransport())
+    return;
+
+  StatsSnapshot stats;
+  stats.info = this->currentInfo;
+  stats.realTimeFactor = this->realTimeFactor;
+  stats.stepping = this->Stepping();
+  stats.pacingJitterMeanNs = this->pacingJitterMeanNs;
+  stats.pacingJitterMaxNs = this->pacingJitterMaxNs;
+  if (this->stateHash)
+    stats.stateHash = this->stateHash->Total();
+
+  if (this->asyncStats || this->asyncClock)
+  {
+    bool urgent{false};
+    {
+      std::lock_guard<std::mutex> lock(this->statsMutex);
+      // Acknowledge pausing, resuming and stepping right away, since the GUI
+      // waits for it
+      urgent = this->asyncStats && (!this->latestStatsValid ||
+          this->latestStats.info.paused != stats.info.paused ||
+          this->latestStats.stepping != stats.stepping);
+      this->statsUrgent = this->statsUrgent || urgent;
+      this->latestStats = stats;
+      this->latestStatsValid = true;
+    }
+    if (urgent)
+      this->statsCv.notify_one();
+  }
+
+  if (!this->asyncStats)
+    this->PublishWorldStats(stats);
+  if (!this->asyncClock)
+    this->PublishClock(stats);
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::PublishWorldStats(const StatsSnapshot &_stats)
+{
+  GZ_PROFILE("SimulationRunner::PublishWorldStats");
+
   // Create the world statistics message.
   msgs::WorldStatistics msg;
-  msg.set_real_time_factor(this->realTimeFactor);
+  msg.set_real_time_factor(_stats.realTimeFactor);
 
   auto realTimeSecNsec =
-    math::durationToSecNsec(this->currentInfo.realTime);
+    math::durationToSecNsec(_stats.info.realTime);
 
   auto simTimeSecNsec =
-    math::durationToSecNsec(this->currentInfo.simTime);
+    math::durationToSecNsec(_stats.info.simTime);
 
   msg.mutable_real_time()->set_sec(realTimeSecNsec.first);
   msg.mutable_real_time()->set_nsec(realTimeSecNsec.second);
@@ -459,13 +770,13 @@ void SimulationRunner::PublishStats()
   msg.mutable_sim_time()->set_sec(simTimeSecNsec.first);
   msg.mutable_sim_time()->set_nsec(simTimeSecNsec.second);
 
-  msg.set_iterations(this->currentInfo.iterations);
+  msg.set_iterations(_stats.info.iterations);
 
-  msg.set_paused(this->currentInfo.paused);
+  msg.set_paused(_stats.info.paused);
 
-  msgs::Set(msg.mutable_step_size(), this->currentInfo.dt);
+  msgs::Set(msg.mutable_step_size(), _stats.info.dt);
 
-  if (this->Stepping())
+  if (_stats.stepping)
   {
     // (deprecated) Remove this header in Gazebo H
     auto headerData = msg.mutable_header()->add_data();
@@ -474,11 +785,43 @@ void SimulationRunner::PublishStats()
     msg.set_stepping(true);
   }
 
-  // Publish the stats message. The stats message is throttled.
+  // Jitter of the step start times over the last window, with precise
+  // pacing
+  if (_stats.pacingJitterMaxNs >= 0)
+  {
+    auto meanData = msg.mutable_header()->add_data();
+    meanData->set_key("pacing_jitter_mean_ns");
+    meanData->add_value(std::to_string(_stats.pacingJitterMeanNs));
+    auto maxData = msg.mutable_header()->add_data();
+    maxData->set_key("pacing_jitter_max_ns");
+    maxData->add_value(std::to_string(_stats.pacingJitterMaxNs));
+  }
+
+  if (_stats.stateHash)
+  {
+    auto hashData = msg.mutable_header()->add_data();
+    hashData->set_key("state_hash");
+    hashData->add_value(StateHash::ToString(*_stats.stateHash));
+  }
+
+  // Publish the stats message. The stats message is throttled when
+  // published on every step.
   this->statsPub.Publish(msg);
 
   if (this->rootStatsPub.Valid())
     this->rootStatsPub.Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::PublishClock(const StatsSnapshot &_stats)
+{
+  GZ_PROFILE("SimulationRunner::PublishClock");
+
+  auto realTimeSecNsec =
+    math::durationToSecNsec(_stats.info.realTime);
+
+  auto simTimeSecNsec =
+    math::durationToSecNsec(_stats.info.simTime);
 
   // Create and publish the clock message. The clock message is not
   // throttled.
@@ -497,6 +840,102 @@ void SimulationRunner::PublishStats()
     this->rootClockPub.Publish(clockMsg);
 }
 
+/////////////////////////////////////////////////
+void SimulationRunner::StartStatsThread()
+{
+  const double statsRate = this->serverConfig.StatsPublishRate();
+  const double clockRate = this->serverConfig.ClockPublishRate();
+  if (this->statsThread.joinable() || !this->serverConfig.UseTransport() ||
+      (statsRate <= 0 && clockRate <= 0))
+  {
+    return;
+  }
+
+  this->asyncStats = statsRate > 0;
+  this->asyncClock = clockRate > 0;
+  this->latestStatsValid = false;
+  this->statsUrgent = false;
+  this->stopStats = false;
+
+  const auto period = [](double _hz)
+  {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(_hz > 0 ? 1.0 / _hz : 0.0));
+  };
+  const auto statsPeriod = period(statsRate);
+  const auto clockPeriod = period(clockRate);
+
+  this->statsThread = std::thread([this, statsPeriod, clockPeriod]
+  {
+    GZ_PROFILE_THREAD_NAME("SimulationRunner stats");
+    auto nextStats = std::chrono::steady_clock::now();
+    auto nextClock = nextStats;
+
+    std::unique_lock<std::mutex> lock(this->statsMutex);
+    while (!this->stopStats)
+    {
+      auto wake = std::chrono::steady_clock::time_point::max();
+      if (this->asyncStats)
+        wake = std::min(wake, nextStats);
+      if (this->asyncClock)
+        wake = std::min(wake, nextClock);
+      this->statsCv.wait_until(lock, wake, [this]
+          {
+            return this->stopStats || this->statsUrgent;
+          });
+      if (this->stopStats)
+        break;
+
+      const auto now = std::chrono::steady_clock::now();
+      const bool publishStats = this->asyncStats &&
+          (this->statsUrgent || now >= nextStats);
+      const bool publishClock = this->asyncClock && now >= nextClock;
+      this->statsUrgent = false;
+      if (publishStats)
+        nextStats = now + statsPeriod;
+      if (publishClock)
+        nextClock = now + clockPeriod;
+      if (!this->latestStatsValid || (!publishStats && !publishClock))
+        continue;
+
+      // Build and publish the messages without holding the lock, so that
+      // the simulation thread isn't blocked
+      const StatsSnapshot stats = this->latestStats;
+      lock.unlock();
+      if (publishStats)
+        this->PublishWorldStats(stats);
+      if (publishClock)
+        this->PublishClock(stats);
+      lock.lock();
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::StopStatsThread()
+{
+  if (!this->statsThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->statsMutex);
+    this->stopStats = true;
+  }
+  this->statsCv.notify_one();
+  this->statsThread.join();
+
+  // Publish the values of the last step, which the thread may have skipped
+  if (this->latestStatsValid)
+  {
+    if (this->asyncStats)
+      this->PublishWorldStats(this->latestStats);
+    if (this->asyncClock)
+      this->PublishClock(this->latestStats);
+  }
+  this->asyncStats = false;
+  this->asyncClock = false;
+}
+
 namespace {
 
 // Create an sdf::ElementPtr that corresponds to an empty `<plugin>` element.
@@ -529,52 +968,139 @@ void SimulationRunner::AddSystem(
 }
 
 /////////////////////////////////////////////////
-void SimulationRunner::ProcessSystemQueue()
+void SimulationRunner::PublishProfile()
 {
-  auto pending = this->systemMgr->PendingCount();
+  auto profiler = this->systemMgr->Profiler();
+  if (nullptr == profiler || !this->profilePub.Valid())
+    return;
 
-  if (0 == pending)
+  auto now = std::chrono::steady_clock::now();
+  if (now - this->lastProfilePublish < std::chrono::seconds(1))
     return;
+  this->lastProfilePublish = now;
 
-  // If additional systems are to be added, stop the existing threads.
-  this->StopWorkerThreads();
+  GZ_PROFILE("SimulationRunner::PublishProfile");
 
-  this->systemMgr->ActivatePendingSystems();
+  msgs::Param_V msg;
+  for (const auto &timing : profiler->Timings())
+  {
+    auto param = msg.add_param();
+    auto &params = *param->mutable_params();
+
+    params["system"].set_type(msgs::Any::STRING);
+    params["system"].set_string_value(timing.system);
+    params["phase"].set_type(msgs::Any::STRING);
+    params["phase"].set_string_value(timing.phase);
+    params["count"].set_type(msgs::Any::DOUBLE);
+    params["count"].set_double_value(static_cast<double>(timing.count));
+    params["min_ns"].set_type(msgs::Any::DOUBLE);
+    params["min_ns"].set_double_value(static_cast<double>(timing.minNs));
+    params["mean_ns"].set_type(msgs::Any::DOUBLE);
+    params["mean_ns"].set_double_value(timing.meanNs);
+    params["p99_ns"].set_type(msgs::Any::DOUBLE);
+    params["p99_ns"].set_double_value(static_cast<double>(timing.p99Ns));
+  }
+
+  this->profilePub.Publish(msg);
+
+  // Going through all components is slower, so it's done less often, from
+  // the simulation thread so the ECM isn't modified meanwhile
+  if (!this->memoryProfilePub.HasConnections() ||
+      now - this->lastMemoryProfilePublish < std::chrono::seconds(10))
+  {
+    return;
+  }
+  this->lastMemoryProfilePublish = now;
+
+  using Row = std::pair<ComponentTypeId, ComponentMemoryUsage>;
+  const auto usage = this->entityCompMgr.ComponentMemoryUsageByType();
+  std::vector<Row> types(usage.begin(), usage.end());
+
+  constexpr std::size_t kMaxTypes{20u};
+  const auto last = types.begin() +
+      static_cast<std::ptrdiff_t>(std::min(kMaxTypes, types.size()));
+  std::partial_sort(types.begin(), last, types.end(),
+      [](const Row &_a, const Row &_b)
+      {
+        return _a.second.bytes + _a.second.heapBytes >
+            _b.second.bytes + _b.second.heapBytes;
+      });
 
-  unsigned int threadCount =
-    static_cast<unsigned int>(this->systemMgr->SystemsPostUpdate().size() + 1u);
+  msgs::Param_V memoryMsg;
+  for (auto it = types.begin(); it != last; ++it)
+  {
+    auto &params = *memoryMsg.add_param()->mutable_params();
+    params["type"].set_type(msgs::Any::STRING);
+    params["type"].set_string_value(
+        components::Factory::Instance()->Name(it->first));
+    params["count"].set_type(msgs::Any::DOUBLE);
+    params["count"].set_double_value(static_cast<double>(it->second.count));
+    params["bytes"].set_type(msgs::Any::DOUBLE);
+    params["bytes"].set_double_value(static_cast<double>(it->second.bytes));
+    params["heap_bytes"].set_type(msgs::Any::DOUBLE);
+    params["heap_bytes"].set_double_value(
+        static_cast<double>(it->second.heapBytes));
+  }
+  this->memoryProfilePub.Publish(memoryMsg);
+}
 
-  gzdbg << "Creating PostUpdate worker threads: "
-    << threadCount << std::endl;
+/////////////////////////////////////////////////
+void SimulationRunner::UpdateStateHash()
+{
+  if (!this->stateHash)
+    return;
 
-  this->postUpdateStartBarrier = std::make_unique<Barrier>(threadCount);
-  this->postUpdateStopBarrier = std::make_unique<Barrier>(threadCount);
+  GZ_PROFILE("SimulationRunner::UpdateStateHash");
+  this->stateHash->Update(this->entityCompMgr);
+  if (this->currentInfo.paused || !this->stateHashPub.HasConnections())
+    return;
 
-  this->postUpdateThreadsRunning = true;
-  int id = 0;
+  msgs::Param msg;
+  auto simTimeSecNsec = math::durationToSecNsec(this->currentInfo.simTime);
+  msg.mutable_header()->mutable_stamp()->set_sec(simTimeSecNsec.first);
+  msg.mutable_header()->mutable_stamp()->set_nsec(simTimeSecNsec.second);
 
-  for (auto &system : this->systemMgr->SystemsPostUpdate())
+  auto &params = *msg.mutable_params();
+  auto setHash = [&params](const std::string &_key, uint64_t _hash)
   {
-    gzdbg << "Creating postupdate worker thread (" << id << ")" << std::endl;
+    params[_key].set_type(msgs::Any::STRING);
+    params[_key].set_string_value(StateHash::ToString(_hash));
+  };
+  params["iterations"].set_type(msgs::Any::DOUBLE);
+  params["iterations"].set_double_value(
+      static_cast<double>(this->currentInfo.iterations));
+  setHash("total", this->stateHash->Total());
+  for (const auto &[type, hash] : this->stateHash->TypeHashes())
+    setHash("type/" + components::Factory::Instance()->Name(type), hash);
+
+  // Top-level entities are keyed by name, so runs with different entity
+  // IDs can be compared
+  for (const auto &[entity, hash] : this->stateHash->TopLevelHashes())
+  {
+    auto name = this->entityCompMgr.ComponentData<components::Name>(entity);
+    setHash("entity/" + name.value_or(std::to_string(entity)), hash);
+  }
+  this->stateHashPub.Publish(msg);
+}
 
-    this->postUpdateThreads.push_back(std::thread([&, id]()
-    {
-      std::stringstream ss;
-      ss << "PostUpdateThread: " << id;
-      GZ_PROFILE_THREAD_NAME(ss.str().c_str());
-      while (this->postUpdateThreadsRunning)
-      {
-        this->postUpdateStartBarrier->Wait();
-        if (this->postUpdateThreadsRunning)
-        {
-          system->PostUpdate(this->currentInfo, this->entityCompMgr);
-        }
-        this->postUpdateStopBarrier->Wait();
-      }
-      gzdbg << "Exiting postupdate worker thread ("
-        << id << ")" << std::endl;
-    }));
-    id++;
+/////////////////////////////////////////////////
+void SimulationRunner::ProcessSystemQueue()
+{
+  auto pending = this->systemMgr->PendingCount();
+
+  if (0 == pending)
+    return;
+
+  this->systemMgr->ActivatePendingSystems();
+
+  // The systems of a restored simulation are configured now
+  if (!this->restoredSystemStates.empty())
+  {
+    const auto restored =
+        this->systemMgr->DeserializeSystems(this->restoredSystemStates);
+    gzmsg << "Restored the state of [" << restored << "] systems from the "
+          << "checkpoint." << std::endl;
+    this->restoredSystemStates.clear();
   }
 }
 
@@ -582,47 +1108,56 @@ void SimulationRunner::ProcessSystemQueue()
 void SimulationRunner::UpdateSystems()
 {
   GZ_PROFILE("SimulationRunner::UpdateSystems");
-  // \todo(nkoenig)  Systems used to be updated in parallel using
-  // a common::WorkerPool. There is overhead associated with
-  // this, most notably the creation and destruction of WorkOrders (see
-  // WorkerPool.cc). We could turn on parallel updates in the future, and/or
-  // turn it on if there are sufficient systems. More testing is required.
 
+  // Release the GIL while systems are updated, so that C++ systems don't
+  // hold it. Systems that call into python lock it from their thread only
+  // while python code runs, including PostUpdates running in the pool.
+  MaybeGilScopedRelease release;
+
+  this->entityCompMgr.SetStepArena(&this->frameArena);
+  this->entityCompMgr.SetWrenches(&this->wrenchAccumulator);
   if (this->resetInitiated)
   {
     GZ_PROFILE("Reset");
     this->systemMgr->Reset(this->currentInfo, this->entityCompMgr);
+    this->frameArena.Reset();
+    this->wrenchAccumulator.Clear();
     return;
   }
 
   {
     GZ_PROFILE("PreUpdate");
-    for (auto& system : this->systemMgr->SystemsPreUpdate())
-      system->PreUpdate(this->currentInfo, this->entityCompMgr);
+    this->systemMgr->PreUpdate(this->currentInfo, this->entityCompMgr);
+    this->wrenchAccumulator.Apply(this->entityCompMgr);
   }
 
   {
     GZ_PROFILE("Update");
-    for (auto& system : this->systemMgr->SystemsUpdate())
-      system->Update(this->currentInfo, this->entityCompMgr);
+    this->systemMgr->Update(this->currentInfo, this->entityCompMgr);
   }
 
   {
     GZ_PROFILE("PostUpdate");
     this->entityCompMgr.LockAddingEntitiesToViews(true);
-    // If no systems implementing PostUpdate have been added, then
-    // the barriers will be uninitialized, so guard against that condition.
-    if (this->postUpdateStartBarrier && this->postUpdateStopBarrier)
+    // The state can't change during PostUpdate, so systems that need the
+    // changed state, such as the scene broadcaster and the log recorder,
+    // share a single serialization of it, and sensors share world poses.
+    this->entityCompMgr.CacheChangedState(true);
+    this->entityCompMgr.CacheWorldPoses(true);
+    if (!this->systemMgr->SystemsPostUpdate().empty())
     {
-      // Release the GIL from the main thread to run PostUpdate threads which
-      // might be calling into python. The system that does call into python
-      // needs to lock the GIL from its thread.
-      MaybeGilScopedRelease release;
-      this->postUpdateStartBarrier->Wait();
-      this->postUpdateStopBarrier->Wait();
+      auto &pool = this->postUpdatePool ?
+          *this->postUpdatePool : ThreadPool::Shared();
+      this->systemMgr->PostUpdate(this->currentInfo, this->entityCompMgr,
+          pool);
     }
+    this->entityCompMgr.CacheWorldPoses(false);
+    this->entityCompMgr.CacheChangedState(false);
     this->entityCompMgr.LockAddingEntitiesToViews(false);
   }
+
+  // PostUpdates have all returned, so no system uses the scratch memory
+  this->frameArena.Reset();
 }
 
 /////////////////////////////////////////////////
@@ -636,25 +1171,37 @@ void SimulationRunner::OnStop()
 {
   this->stopReceived = true;
   this->running = false;
+
+  // Wake up a runner waiting for step credits
+  std::lock_guard<std::mutex> lock(this->stepCreditsMutex);
+  this->stepCreditsCv.notify_all();
 }
 
 /////////////////////////////////////////////////
-void SimulationRunner::StopWorkerThreads()
+void SimulationRunner::OnStepCredits(const msgs::UInt32 &_msg)
 {
-  this->postUpdateThreadsRunning = false;
-  if (this->postUpdateStartBarrier)
-  {
-    this->postUpdateStartBarrier->Cancel();
-  }
-  if (this->postUpdateStopBarrier)
-  {
-    this->postUpdateStopBarrier->Cancel();
-  }
-  for (auto &thread : this->postUpdateThreads)
-  {
-    thread.join();
-  }
-  this->postUpdateThreads.clear();
+  std::lock_guard<std::mutex> lock(this->stepCreditsMutex);
+  this->stepCredits += _msg.data();
+  this->stepCreditsCv.notify_all();
+}
+
+/////////////////////////////////////////////////
+bool SimulationRunner::WaitForStepCredit()
+{
+  GZ_PROFILE("SimulationRunner::WaitForStepCredit");
+  std::unique_lock<std::mutex> lock(this->stepCreditsMutex);
+
+  // Time out now and then, so that world control requests, such as
+  // pausing, are still processed while no credits are granted.
+  this->stepCreditsCv.wait_for(lock, kStepCreditTimeout, [this]
+      {
+        return this->stepCredits > 0 || !this->running;
+      });
+  if (this->stepCredits == 0 || !this->running)
+    return false;
+
+  --this->stepCredits;
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -691,15 +1238,24 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   if (!this->currentInfo.paused)
     this->realTimeWatch.Start();
 
+  configureSimulationThread(this->serverConfig.SimulationThreadCpu(),
+      this->serverConfig.SimulationThreadPriority());
+
   // Variables for time keeping.
   std::chrono::steady_clock::time_point startTime;
   std::chrono::steady_clock::duration sleepTime;
   std::chrono::steady_clock::duration actualSleep;
+  const bool precisePacing = this->serverConfig.PreciseStepPacing();
+  const bool computeOnly = this->serverConfig.ComputeOnly();
+  const bool lockstep = this->serverConfig.Lockstep() &&
+      this->serverConfig.UseTransport();
+  std::chrono::steady_clock::time_point nextStepDeadline =
+      std::chrono::steady_clock::now() - this->updatePeriod;
 
   this->running = true;
 
   // Create the world statistics publisher.
-  if (!this->statsPub.Valid())
+  if (this->serverConfig.UseTransport() && !this->statsPub.Valid())
   {
     transport::AdvertiseMessageOptions advertOpts;
     // publish 10 world statistics msgs/second. A smaller number isn't used
@@ -707,13 +1263,16 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     // pause/play GUI requests have been processed by the server, so we want to
     // make sure that GUI requests are acknowledged quickly (see
     // https://github.com/gazebosim/gz-gui/pull/306 and
-    // https://github.com/gazebosim/gz-sim/pull/1163)
-    advertOpts.SetMsgsPerSec(10);
+    // https://github.com/gazebosim/gz-sim/pull/1163). The statistics thread
+    // already publishes them at its own rate, and acknowledges requests
+    // right away.
+    if (this->serverConfig.StatsPublishRate() <= 0)
+      advertOpts.SetMsgsPerSec(10);
     this->statsPub = this->node->Advertise<msgs::WorldStatistics>(
         "stats", advertOpts);
   }
 
-  if (!this->rootStatsPub.Valid())
+  if (this->serverConfig.UseTransport() && !this->rootStatsPub.Valid())
   {
     // Check for the existence of other publishers on `/stats`
     std::vector<transport::MessagePublisher> publishers;
@@ -743,11 +1302,11 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   }
 
   // Create the clock publisher.
-  if (!this->clockPub.Valid())
+  if (this->serverConfig.UseTransport() && !this->clockPub.Valid())
     this->clockPub = this->node->Advertise<msgs::Clock>("clock");
 
   // Create the global clock publisher.
-  if (!this->rootClockPub.Valid())
+  if (this->serverConfig.UseTransport() && !this->rootClockPub.Valid())
   {
     // Check for the existence of other publishers on `/clock`
     std::vector<transport::MessagePublisher> publishers;
@@ -776,6 +1335,8 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     }
   }
 
+  this->StartStatsThread();
+
   // Keep number of iterations requested by caller
   uint64_t processedIterations{0};
 
@@ -789,38 +1350,86 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     // Update the step size and desired rtf
     this->UpdatePhysicsParams();
 
-    // Compute the time to sleep in order to match, as closely as possible,
-    // the update period.
-    sleepTime = 0ns;
-    actualSleep = 0ns;
-
-    sleepTime = std::max(0ns, this->prevUpdateRealTime +
-        this->updatePeriod - std::chrono::steady_clock::now() -
-        this->sleepOffset);
-
-    // Only sleep if needed.
-    if (sleepTime > 0ns)
+    // Unpaused steps wait for credits in lockstep, and aren't paced. Paused
+    // steps, which keep processing requests, are paced as usual. Steps
+    // requested with a WorldControl multi_step count as credited.
+    // Compute-only steps run back to back, without reading the clock to
+    // pace them, except when paused so that they don't spin.
+    const bool paced = !computeOnly || this->currentInfo.paused;
+    bool creditedStep{false};
+    if (lockstep && !this->currentInfo.paused &&
+        this->pendingSimIterations == 0)
+    {
+      creditedStep = this->WaitForStepCredit();
+      if (!creditedStep)
+      {
+        // Process world control requests while waiting. Only do so when
+        // there are any, so that the stepping state isn't reset outside of
+        // a step.
+        {
+          std::lock_guard<std::mutex> lock(this->msgBufferMutex);
+          if (!this->worldControls.empty())
+            this->ProcessWorldControl();
+        }
+        this->ProcessWorldSdfRequests();
+        this->ProcessCheckpointRequests();
+        this->ProcessMemoryUsageRequests();
+        continue;
+      }
+    }
+    else if (paced && precisePacing)
     {
-      GZ_PROFILE("Sleep");
-      // Get the current time, sleep for the duration needed to match the
-      // updatePeriod, and then record the actual time slept.
-      startTime = std::chrono::steady_clock::now();
-      std::this_thread::sleep_for(sleepTime);
-      actualSleep = std::chrono::steady_clock::now() - startTime;
+      // Steps start at absolute deadlines one update period apart, so that
+      // the period doesn't drift with the time taken to wake up. After an
+      // overrun of more than a period, start again from now instead of
+      // catching up.
+      const auto now = std::chrono::steady_clock::now();
+      nextStepDeadline += this->updatePeriod;
+      if (nextStepDeadline < now - this->updatePeriod)
+        nextStepDeadline = now;
+
+      {
+        GZ_PROFILE("Sleep");
+        sleepUntilPrecisely(nextStepDeadline);
+      }
+      this->RecordPacingJitter(
+          std::chrono::steady_clock::now() - nextStepDeadline);
     }
+    else if (paced)
+    {
+      // Compute the time to sleep in order to match, as closely as
+      // possible, the update period.
+      sleepTime = 0ns;
+      actualSleep = 0ns;
 
-    // Exponentially average out the difference between expected sleep time
-    // and actual sleep time.
-    this->sleepOffset =
-      std::chrono::duration_cast<std::chrono::nanoseconds>(
-          (actualSleep - sleepTime) * 0.01 + this->sleepOffset * 0.99);
+      sleepTime = std::max(0ns, this->prevUpdateRealTime +
+          this->updatePeriod - std::chrono::steady_clock::now() -
+          this->sleepOffset);
+
+      // Only sleep if needed.
+      if (sleepTime > 0ns)
+      {
+        GZ_PROFILE("Sleep");
+        // Get the current time, sleep for the duration needed to match the
+        // updatePeriod, and then record the actual time slept.
+        startTime = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(sleepTime);
+        actualSleep = std::chrono::steady_clock::now() - startTime;
+      }
+
+      // Exponentially average out the difference between expected sleep
+      // time and actual sleep time.
+      this->sleepOffset =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            (actualSleep - sleepTime) * 0.01 + this->sleepOffset * 0.99);
+    }
 
     // Update time information. This will update the iteration count, RTF,
     // and other values.
     this->UpdateCurrentInfo();
     if (this->resetInitiated)
     {
-      this->entityCompMgr.ResetTo(this->initialEntityCompMgr);
+      this->ResetEntityCompMgr();
     }
 
     if (!this->currentInfo.paused)
@@ -840,6 +1449,20 @@ bool SimulationRunner::Run(const uint64_t _iterations)
       this->Step(this->currentInfo);
     }
 
+    if (creditedStep)
+    {
+      const auto simSecNsec =
+          math::durationToSecNsec(this->currentInfo.simTime);
+      const auto realSecNsec =
+          math::durationToSecNsec(this->currentInfo.realTime);
+      msgs::Clock doneMsg;
+      doneMsg.mutable_sim()->set_sec(simSecNsec.first);
+      doneMsg.mutable_sim()->set_nsec(simSecNsec.second);
+      doneMsg.mutable_real()->set_sec(realSecNsec.first);
+      doneMsg.mutable_real()->set_nsec(realSecNsec.second);
+      this->lockstepDonePub.Publish(doneMsg);
+    }
+
     // Handle Server::RunOnce(false) in which a single paused run is executed
     if (this->currentInfo.paused && this->blockingPausedStepPending)
     {
@@ -851,17 +1474,92 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     this->resetInitiated = false;
   }
 
+  this->StopStatsThread();
   this->running = false;
 
   return true;
 }
 
+/////////////////////////////////////////////////
+void SimulationRunner::RecordPacingJitter(
+    const std::chrono::steady_clock::duration &_lateness)
+{
+  const int64_t ns = std::max<int64_t>(0,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_lateness)
+      .count());
+  this->pacingJitterSumNs += ns;
+  this->pacingJitterWindowMaxNs =
+      std::max(this->pacingJitterWindowMaxNs, ns);
+  if (++this->pacingJitterCount < kPacingJitterWindow)
+    return;
+
+  this->pacingJitterMeanNs = this->pacingJitterSumNs /
+      static_cast<int64_t>(this->pacingJitterCount);
+  this->pacingJitterMaxNs = this->pacingJitterWindowMaxNs;
+  this->pacingJitterSumNs = 0;
+  this->pacingJitterWindowMaxNs = 0;
+  this->pacingJitterCount = 0;
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::Reset()
+{
+  GZ_PROFILE("SimulationRunner::Reset");
+  this->requestedRewind = true;
+  this->UpdateCurrentInfo();
+  // The wall clock starts again once running
+  this->realTimeWatch.Reset();
+  this->ResetEntityCompMgr();
+  this->systemMgr->Reset(this->currentInfo, this->entityCompMgr);
+  this->resetInitiated = false;
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::ResetEntityCompMgr()
+{
+  GZ_PROFILE("SimulationRunner::ResetEntityCompMgr");
+  if (this->systemMgr->ResetReloadsSystems())
+    this->entityCompMgr.ResetTo(this->initialEntityCompMgr);
+  else
+    this->entityCompMgr.IncrementalResetTo(this->initialEntityCompMgr);
+
+  if (this->stateHash)
+    this->stateHash->Reset();
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::RunIteration()
+{
+  GZ_PROFILE("SimulationRunner::RunIteration");
+
+  // Started by Run otherwise, and stopped by UpdateCurrentInfo when paused
+  if (!this->currentInfo.paused && !this->realTimeWatch.Running())
+    this->realTimeWatch.Start();
+
+  this->UpdatePhysicsParams();
+  this->UpdateCurrentInfo();
+  if (this->resetInitiated)
+  {
+    this->ResetEntityCompMgr();
+  }
+
+  this->Step(this->currentInfo);
+  this->resetInitiated = false;
+}
+
 /////////////////////////////////////////////////
 void SimulationRunner::Step(const UpdateInfo &_info)
 {
   GZ_PROFILE("SimulationRunner::Step");
   this->currentInfo = _info;
 
+  // The first step creates the physics and rendering entities, and ends the
+  // startup timeline
+  std::optional<StartupTimeline::Scope> firstStepScope;
+  const bool firstStep = StartupTimeline::Instance().Recording();
+  if (firstStep)
+    firstStepScope.emplace("First step", "step");
+
   // Process new ECM state information, typically sent from the GUI after
   // a change was made to the GUI's ECM.
   this->ProcessNewWorldControlState();
@@ -889,6 +1587,8 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Update all the systems.
   this->UpdateSystems();
 
+  this->PublishProfile();
+
   if (!this->Paused() && this->requestedRunToSimTime &&
        this->requestedRunToSimTime.value() > this->simTimeEpoch &&
        this->currentInfo.simTime >= this->requestedRunToSimTime.value())
@@ -912,6 +1612,21 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Process world control messages.
   this->ProcessMessages();
 
+  // The systems are done with the ECM, so it can be copied for the world
+  // SDFormat, checkpoint and memory usage services
+  this->ProcessWorldSdfRequests();
+  this->ProcessCheckpointRequests();
+  this->ProcessMemoryUsageRequests();
+
+  // New entities share the components holding the same data as others,
+  // now that the systems have seen them
+  if (!this->internedComponentTypes.empty() &&
+      this->entityCompMgr.HasNewEntities())
+  {
+    for (const auto type : this->internedComponentTypes)
+      this->entityCompMgr.InternComponents(type, true);
+  }
+
   // Clear all new entities
   this->entityCompMgr.ClearNewlyCreatedEntities();
 
@@ -921,15 +1636,27 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // cloned entities will loose their "New" state.
   this->ProcessRecreateEntitiesCreate();
 
-  // Process entity removals.
+  // Process entity removals. The systems attached to the removed entities
+  // go first, without touching the schedule of the others.
+  if (this->entityCompMgr.HasEntitiesMarkedForRemoval())
+    this->systemMgr->ProcessRemovedEntities(this->entityCompMgr);
   this->entityCompMgr.ProcessRemoveEntityRequests();
 
   // Process components removals
   this->entityCompMgr.ClearRemovedComponents();
 
+  // Hash the state the next step starts from
+  this->UpdateStateHash();
+
   // Each network manager takes care of marking its components as unchanged
   if (!this->networkMgr)
     this->entityCompMgr.SetAllComponentsUnchanged();
+
+  if (firstStep)
+  {
+    firstStepScope.reset();
+    StartupTimeline::Instance().Finish();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -1428,58 +2155,29 @@ void SimulationRunner::SetStepSize(
 /////////////////////////////////////////////////
 bool SimulationRunner::HasEntity(const std::string &_name) const
 {
-  bool result = false;
-  this->entityCompMgr.Each<components::Name>([&](const Entity,
-        const components::Name *_entityName)->bool
-    {
-      if (_entityName->Data() == _name)
-      {
-        result = true;
-        return false;
-      }
-      return true;
-    });
-
-  return result;
+  return !this->entityCompMgr.EntitiesByName(_name).empty();
 }
 
 /////////////////////////////////////////////////
 bool SimulationRunner::RequestRemoveEntity(const std::string &_name,
     bool _recursive)
 {
-  bool result = false;
-  this->entityCompMgr.Each<components::Name>([&](const Entity _entity,
-        const components::Name *_entityName)->bool
-    {
-      if (_entityName->Data() == _name)
-      {
-        this->entityCompMgr.RequestRemoveEntity(_entity, _recursive);
-        result = true;
-        return false;
-      }
-      return true;
-    });
+  const auto entities = this->entityCompMgr.EntitiesByName(_name);
+  if (entities.empty())
+    return false;
 
-  return result;
+  this->entityCompMgr.RequestRemoveEntity(entities.front(), _recursive);
+  return true;
 }
 
 /////////////////////////////////////////////////
 std::optional<Entity> SimulationRunner::EntityByName(
     const std::string &_name) const
 {
-  std::optional<Entity> entity;
-  this->entityCompMgr.Each<components::Name>([&](const Entity _entity,
-        const components::Name *_entityName)->bool
-    {
-      if (_entityName->Data() == _name)
-      {
-        entity = _entity;
-        return false;
-      }
-      return true;
-    });
-
-  return entity;
+  const auto entities = this->entityCompMgr.EntitiesByName(_name);
+  if (entities.empty())
+    return std::nullopt;
+  return entities.front();
 }
 
 /////////////////////////////////////////////////
@@ -1509,17 +2207,353 @@ bool SimulationRunner::GuiInfoService(msgs::GUI &_res)
 bool SimulationRunner::GenerateWorldSdf(const msgs::SdfGeneratorConfig &_req,
                                         msgs::StringMsg &_res)
 {
-  // TODO(addisu) This is not thread-safe. Wait until it is safe to access the
-  // ECM.
-  Entity world = this->entityCompMgr.EntityByComponents(components::World());
-  std::optional<std::string> genString = sdf_generator::generateWorld(
-      this->entityCompMgr, world, this->fuelUriMap, _req);
-  if (genString.has_value())
+  std::ostringstream out;
+  if (!this->WriteWorldSdf(out, _req))
+    return false;
+  _res.set_data(out.str());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::SaveWorldSdf(const msgs::StringMsg &_req,
+                                    msgs::Boolean &_res)
+{
+  std::ofstream out(_req.data(), std::ios::out);
+  if (!out.is_open())
   {
-    _res.set_data(*genString);
-    return true;
+    gzerr << "Failed to open [" << _req.data() << "] to save the world."
+          << std::endl;
+    _res.set_data(false);
+    return false;
   }
-  return false;
+
+  const bool saved = this->WriteWorldSdf(out, msgs::SdfGeneratorConfig());
+  out.close();
+  _res.set_data(saved && !out.fail());
+  return _res.data();
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::WriteWorldSdf(std::ostream &_out,
+    const msgs::SdfGeneratorConfig &_config)
+{
+  auto snapshot = this->TakeWorldSdfSnapshot();
+  Entity world = snapshot->ecm.EntityByComponents(components::World());
+
+  std::lock_guard<std::mutex> lock(this->worldSdfCacheMutex);
+  return sdf_generator::generateWorld(_out, snapshot->ecm, world,
+      snapshot->includeUriMap, _config, &this->worldSdfCache);
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const SimulationRunner::WorldSdfSnapshot>
+    SimulationRunner::TakeWorldSdfSnapshot()
+{
+  std::unique_lock<std::mutex> lock(this->worldSdfMutex);
+  const auto count = this->worldSdfSnapshotCount;
+  ++this->worldSdfRequests;
+  while (count == this->worldSdfSnapshotCount)
+  {
+    // Nothing changes the ECM while the simulation isn't running, so it's
+    // copied right away
+    if (!this->running)
+    {
+      auto snapshot = std::make_shared<WorldSdfSnapshot>();
+      snapshot->ecm.CopyFrom(this->entityCompMgr);
+      snapshot->includeUriMap = this->fuelUriMap;
+      this->worldSdfSnapshot = std::move(snapshot);
+      ++this->worldSdfSnapshotCount;
+      break;
+    }
+    this->worldSdfCv.wait_for(lock, 100ms);
+  }
+  --this->worldSdfRequests;
+  auto snapshot = this->worldSdfSnapshot;
+
+  // The copy can be large, so it isn't kept once every call has it
+  if (0u == this->worldSdfRequests)
+    this->worldSdfSnapshot.reset();
+  return snapshot;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ProcessWorldSdfRequests()
+{
+  std::lock_guard<std::mutex> lock(this->worldSdfMutex);
+  if (0u == this->worldSdfRequests)
+    return;
+
+  GZ_PROFILE("SimulationRunner::ProcessWorldSdfRequests");
+  auto snapshot = std::make_shared<WorldSdfSnapshot>();
+  snapshot->ecm.CopyFrom(this->entityCompMgr);
+  snapshot->includeUriMap = this->fuelUriMap;
+  this->worldSdfSnapshot = std::move(snapshot);
+  ++this->worldSdfSnapshotCount;
+  this->worldSdfCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::SaveCheckpoint(const msgs::StringMsg &_req,
+    msgs::Boolean &_res)
+{
+  _res.set_data(false);
+  if (_req.data().empty())
+  {
+    gzerr << "Missing path of the checkpoint." << std::endl;
+    return false;
+  }
+
+  // The world doesn't change, so it's only written by the first call.
+  // Included models are expanded, so restoring doesn't fetch them.
+  {
+    std::lock_guard<std::mutex> lock(this->checkpointMutex);
+    if (this->checkpointWorldSdf.empty())
+    {
+      sdf::OutputConfig outputConfig;
+      outputConfig.SetToElementUseIncludeTag(false);
+      const auto element = this->sdfWorld->ToElement(outputConfig);
+      if (nullptr == element)
+      {
+        gzerr << "Failed to write the world of the checkpoint." << std::endl;
+        return false;
+      }
+      this->checkpointWorldSdf = "<?xml version='1.0'?><sdf version='" +
+          sdf::SDF::Version() + "'>" + element->ToString("") + "</sdf>";
+    }
+  }
+
+  auto checkpoint = this->TakeCheckpoint();
+  if (!saveCheckpoint(_req.data(), *checkpoint))
+  {
+    gzerr << "Failed to save checkpoint [" << _req.data() << "]."
+          << std::endl;
+    return false;
+  }
+
+  gzmsg << "Saved checkpoint of iteration [" << checkpoint->iterations
+        << "] to [" << _req.data() << "]." << std::endl;
+  _res.set_data(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::RestoreCheckpoint(const Checkpoint &_checkpoint)
+{
+  // The entities of the checkpoint keep their IDs, and entities of the world
+  // that were removed before the checkpoint are removed again
+  std::unordered_set<Entity> saved;
+  {
+    StateSnapshotReader reader(_checkpoint.state.data(),
+        _checkpoint.state.size());
+    StateSnapshotRecord record;
+    while (reader.Next(record))
+    {
+      if (record.type != StateSnapshotRecordType::RemovedEntity)
+        saved.insert(record.entity);
+    }
+  }
+  if (!this->entityCompMgr.SetStateSnapshot(_checkpoint.state.data(),
+      _checkpoint.state.size()))
+  {
+    gzerr << "Failed to restore the entities of the checkpoint of world ["
+          << _checkpoint.worldName << "]." << std::endl;
+    return false;
+  }
+  if (this->stateHash)
+    this->stateHash->Reset();
+
+  for (const auto &vertex : this->entityCompMgr.Entities().Vertices())
+  {
+    if (saved.find(vertex.first) == saved.end())
+      this->entityCompMgr.RequestRemoveEntity(vertex.first, false);
+  }
+  if (this->entityCompMgr.HasEntitiesMarkedForRemoval())
+    this->systemMgr->ProcessRemovedEntities(this->entityCompMgr);
+  this->entityCompMgr.ProcessRemoveEntityRequests();
+  this->entityCompMgr.ClearRemovedComponents();
+
+  // Physics creates joints at their initial position, so their state is
+  // applied as a reset
+  std::vector<std::pair<Entity, std::vector<double>>> positions;
+  std::vector<std::pair<Entity, std::vector<double>>> velocities;
+  this->entityCompMgr.Each<components::JointPosition>(
+      [&](const Entity &_entity,
+          const components::JointPosition *_position) -> bool
+      {
+        positions.emplace_back(_entity, _position->Data());
+        return true;
+      });
+  this->entityCompMgr.Each<components::JointVelocity>(
+      [&](const Entity &_entity,
+          const components::JointVelocity *_velocity) -> bool
+      {
+        velocities.emplace_back(_entity, _velocity->Data());
+        return true;
+      });
+  for (const auto &[entity, position] : positions)
+  {
+    this->entityCompMgr.SetComponentData<components::JointPositionReset>(
+        entity, position);
+  }
+  for (const auto &[entity, velocity] : velocities)
+  {
+    this->entityCompMgr.SetComponentData<components::JointVelocityReset>(
+        entity, velocity);
+  }
+
+  this->currentInfo.simTime = _checkpoint.simTime;
+  this->currentInfo.iterations = _checkpoint.iterations;
+  this->restoredSystemStates = _checkpoint.systems;
+
+  gzmsg << "Restored world [" << _checkpoint.worldName << "] at iteration ["
+        << _checkpoint.iterations << "] with [" << saved.size()
+        << "] entities." << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const Checkpoint> SimulationRunner::TakeCheckpoint()
+{
+  std::unique_lock<std::mutex> lock(this->checkpointMutex);
+  const auto count = this->checkpointCount;
+  ++this->checkpointRequests;
+  while (count == this->checkpointCount)
+  {
+    // Nothing changes the ECM while the simulation isn't running, so the
+    // checkpoint is taken right away
+    if (!this->running)
+    {
+      this->checkpoint = this->CaptureCheckpoint();
+      ++this->checkpointCount;
+      break;
+    }
+    this->checkpointCv.wait_for(lock, 100ms);
+  }
+  --this->checkpointRequests;
+  auto taken = this->checkpoint;
+
+  // The state can be large, so it isn't kept once every call has it
+  if (0u == this->checkpointRequests)
+    this->checkpoint.reset();
+  return taken;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ProcessCheckpointRequests()
+{
+  std::lock_guard<std::mutex> lock(this->checkpointMutex);
+  if (0u == this->checkpointRequests)
+    return;
+
+  GZ_PROFILE("SimulationRunner::ProcessCheckpointRequests");
+  this->checkpoint = this->CaptureCheckpoint();
+  ++this->checkpointCount;
+  this->checkpointCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<Checkpoint> SimulationRunner::CaptureCheckpoint() const
+{
+  // The flat snapshot is a copy of the component data without any
+  // serialization for most components, so the step isn't held up for long
+  auto result = std::make_shared<Checkpoint>();
+  result->worldName = this->worldName;
+  result->worldSdf = this->checkpointWorldSdf;
+  result->simTime = this->currentInfo.simTime;
+  result->iterations = this->currentInfo.iterations;
+  this->entityCompMgr.StateSnapshot(result->state, {}, {}, true);
+  result->systems = this->systemMgr->SerializeSystems();
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::MemoryUsageService(msgs::StringMsg &_res)
+{
+  std::unique_lock<std::mutex> lock(this->memoryUsageMutex);
+  const auto count = this->memoryUsageCount;
+  ++this->memoryUsageRequests;
+  while (count == this->memoryUsageCount)
+  {
+    // Nothing changes the ECM while the simulation isn't running, so the
+    // report is written right away
+    if (!this->running)
+    {
+      this->memoryUsageReport = this->MemoryUsageReport();
+      ++this->memoryUsageCount;
+      break;
+    }
+    this->memoryUsageCv.wait_for(lock, 100ms);
+  }
+  --this->memoryUsageRequests;
+  _res.set_data(this->memoryUsageReport);
+
+  if (0u == this->memoryUsageRequests)
+    this->memoryUsageReport.clear();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ProcessMemoryUsageRequests()
+{
+  std::lock_guard<std::mutex> lock(this->memoryUsageMutex);
+  if (0u == this->memoryUsageRequests)
+    return;
+
+  GZ_PROFILE("SimulationRunner::ProcessMemoryUsageRequests");
+  this->memoryUsageReport = this->MemoryUsageReport();
+  ++this->memoryUsageCount;
+  this->memoryUsageCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+std::string SimulationRunner::MemoryUsageReport() const
+{
+  using Row = std::pair<std::string, ComponentMemoryUsage>;
+  auto print = [](std::ostream &_out, const std::string &_title,
+      std::vector<Row> &_rows)
+  {
+    std::sort(_rows.begin(), _rows.end(), [](const Row &_a, const Row &_b)
+        {
+          return _a.second.bytes + _a.second.heapBytes >
+              _b.second.bytes + _b.second.heapBytes;
+        });
+    _out << std::left << std::setw(48) << _title << std::right
+         << std::setw(10) << "count" << std::setw(14) << "bytes"
+         << std::setw(14) << "heap bytes" << std::endl;
+    for (const auto &[name, usage] : _rows)
+    {
+      _out << std::left << std::setw(48) << name << std::right
+           << std::setw(10) << usage.count << std::setw(14) << usage.bytes
+           << std::setw(14) << usage.heapBytes << std::endl;
+    }
+  };
+
+  const EntityComponentManager &ecm = this->entityCompMgr;
+
+  std::vector<Row> types;
+  for (const auto &[typeId, usage] : ecm.ComponentMemoryUsageByType())
+  {
+    types.emplace_back(components::Factory::Instance()->Name(typeId), usage);
+  }
+
+  std::vector<Row> models;
+  for (const auto &[model, usage] : ecm.ComponentMemoryUsageByModel())
+  {
+    std::string name{"(outside models)"};
+    if (kNullEntity != model)
+    {
+      const auto *nameComp = ecm.Component<components::Name>(model);
+      name = (nullptr == nameComp ? std::string() : nameComp->Data()) +
+          " [" + std::to_string(model) + "]";
+    }
+    models.emplace_back(name, usage);
+  }
+
+  std::ostringstream report;
+  print(report, "component type", types);
+  report << std::endl;
+  print(report, "model", models);
+  return report.str();
 }
 
 //////////////////////////////////////////////////
@@ -22,17 +22,21 @@
 #include <gz/msgs/log_playback_control.pb.h>
 #include <gz/msgs/sdf_generator_config.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
+#include <gz/msgs/uint32.pb.h>
 #include <gz/msgs/world_control.pb.h>
 #include <gz/msgs/world_control_state.pb.h>
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -50,14 +54,20 @@
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/EventManager.hh"
 #include "gz/sim/Export.hh"
+#include "gz/sim/FrameArena.hh"
 #include "gz/sim/ServerConfig.hh"
 #include "gz/sim/SystemLoader.hh"
 #include "gz/sim/Types.hh"
+#include "gz/sim/WrenchAccumulator.hh"
 
 #include "network/NetworkManager.hh"
+#include "Checkpoint.hh"
+#include "DeferredIncludes.hh"
 #include "LevelManager.hh"
+#include "SdfGenerator.hh"
+#include "StateHash.hh"
 #include "SystemManager.hh"
-#include "Barrier.hh"
+#include "ThreadPool.hh"
 #include "WorldControl.hh"
 
 using namespace std::chrono_literals;
@@ -77,9 +87,13 @@ namespace gz
       /// \param[in] _world Pointer to the SDF world.
       /// \param[in] _systemLoader Reference to system manager.
       /// \param[in] _useLevels Whether to use levles or not. False by default.
+      /// \param[in] _deferredIncludes Models of the world's levels which
+      /// aren't in _world, parsed when their level becomes active. Optional.
       public: explicit SimulationRunner(const sdf::World *_world,
                                 const SystemLoaderPtr &_systemLoader,
-                                const ServerConfig &_config = ServerConfig());
+                                const ServerConfig &_config = ServerConfig(),
+                                std::shared_ptr<DeferredIncludes>
+                                    _deferredIncludes = nullptr);
 
       /// \brief Destructor.
       public: virtual ~SimulationRunner();
@@ -90,9 +104,6 @@ namespace gz
       /// \brief Internal method for handling stop event (to prevent recursion)
       private: void OnStop();
 
-      /// \brief Stop and join all post update worker threads
-      private: void StopWorkerThreads();
-
       /// \brief Run the simulationrunner.
       /// \param[in] _iterations Number of iterations.
       /// \return True if the operation completed successfully.
@@ -105,6 +116,11 @@ namespace gz
       /// \param[in] _info Time information for the step.
       public: void Step(const UpdateInfo &_info);
 
+      /// \brief Run a single iteration right away, without waiting for the
+      /// update period, so many runners can be stepped in lockstep.
+      /// Runners of distributed simulations are stepped by Run instead.
+      public: void RunIteration();
+
       /// \brief Add system after the simulation runner has been instantiated
       /// \note This actually adds system to a queue. The system is added to the
       /// runner at the begining of the a simulation cycle (call to Run). It is
@@ -136,9 +152,21 @@ namespace gz
       /// \brief Update all the systems
       public: void UpdateSystems();
 
-      /// \brief Publish current world statistics.
+      /// \brief Publish current world statistics. While running, the
+      /// statistics are only copied here and published by the statistics
+      /// thread, at the rates set in the server configuration.
       public: void PublishStats();
 
+      /// \brief Publish the timing statistics of the systems, if system
+      /// profiling is enabled. Statistics are published once per second of
+      /// wall time.
+      private: void PublishProfile();
+
+      /// \brief Update the hash of the ECM state with the changes of the
+      /// step and publish it, if state hashing is enabled.
+      /// \sa ServerConfig::SetStateHashing
+      private: void UpdateStateHash();
+
       /// \brief Load system plugin for a given entity.
       /// \param[in] _entity The plugins will be associated with this Entity
       /// \param[in] _plugin SDF Plugin to load
@@ -177,6 +205,11 @@ namespace gz
       /// \return The current iteration count.
       public: uint64_t IterationCount() const;
 
+      /// \brief Reset the world to its initial state right away, as a
+      /// reset world control request would on the next iteration. Must not
+      /// be called while running.
+      public: void Reset();
+
       /// \brief Get the number of entities on the runner.
       /// \return Entity count.
       public: size_t EntityCount() const;
@@ -324,9 +357,125 @@ namespace gz
       /// \return True if successful.
       private: bool GuiInfoService(gz::msgs::GUI &_res);
 
+      /// \brief Callback for the memory usage service. Waits for the
+      /// simulation thread to write the report between steps.
+      /// \param[out] _res Report of the memory held by the components of each
+      /// type and of each top-level model, largest first.
+      /// \return True if successful.
+      private: bool MemoryUsageService(msgs::StringMsg &_res);
+
+      /// \brief Write the report requested by MemoryUsageService, if any.
+      /// Called by the simulation thread between steps.
+      private: void ProcessMemoryUsageRequests();
+
+      /// \brief Write the memory usage report of the ECM.
+      /// \return The report.
+      private: std::string MemoryUsageReport() const;
+
+      /// \brief Copy of the ECM that the world SDFormat is generated from.
+      private: struct WorldSdfSnapshot
+      {
+        /// \brief Copy of the ECM.
+        EntityComponentManager ecm;
+
+        /// \brief Copy of the map from file paths to Fuel URIs.
+        sdf_generator::IncludeUriMap includeUriMap;
+      };
+
+      /// \brief Get a copy of the ECM taken between steps, waiting for the
+      /// simulation thread to take it. Called from the service threads, so
+      /// that generating the SDFormat doesn't block the simulation.
+      /// \return The copy.
+      private: std::shared_ptr<const WorldSdfSnapshot> TakeWorldSdfSnapshot();
+
+      /// \brief Take the copy of the ECM requested by TakeWorldSdfSnapshot,
+      /// if any. Called by the simulation thread between steps.
+      private: void ProcessWorldSdfRequests();
+
+      /// \brief Get a checkpoint taken between steps, waiting for the
+      /// simulation thread to take it, like TakeWorldSdfSnapshot.
+      /// \return The checkpoint.
+      private: std::shared_ptr<const Checkpoint> TakeCheckpoint();
+
+      /// \brief Take the checkpoint requested by TakeCheckpoint, if any.
+      /// Called by the simulation thread between steps.
+      private: void ProcessCheckpointRequests();
+
+      /// \brief Copy the state of the ECM, the time and the state of the
+      /// systems into a new checkpoint. checkpointMutex must be locked.
+      /// \return The checkpoint.
+      private: std::shared_ptr<Checkpoint> CaptureCheckpoint() const;
+
+      /// \brief Generate the world SDFormat from a copy of the ECM.
+      /// \param[out] _out Stream to print to.
+      /// \param[in] _config Configuration for the world generator.
+      /// \return True if successful.
+      private: bool WriteWorldSdf(std::ostream &_out,
+                   const msgs::SdfGeneratorConfig &_config);
+
       /// \brief Calculate real time factor and populate currentInfo.
       private: void UpdateCurrentInfo();
 
+      /// \brief Reset the ECM to its initial state. Only what changed since
+      /// is reset, unless some system is reloaded and expects every entity
+      /// to be new again.
+      private: void ResetEntityCompMgr();
+
+      /// \brief Record how late a step started, with precise step pacing.
+      /// \param[in] _lateness Time between the deadline of the step and
+      /// its start.
+      private: void RecordPacingJitter(
+          const std::chrono::steady_clock::duration &_lateness);
+
+      /// \brief Callback granting step credits in lockstep.
+      /// \param[in] _msg Number of steps granted.
+      /// \sa ServerConfig::SetLockstep
+      private: void OnStepCredits(const msgs::UInt32 &_msg);
+
+      /// \brief Wait for a step credit in lockstep, and consume it.
+      /// \return True if a credit was consumed, false if none was granted
+      /// in a while or the runner is stopping.
+      private: bool WaitForStepCredit();
+
+      /// \brief Values published in the world statistics and clock
+      /// messages.
+      private: struct StatsSnapshot
+      {
+        /// \brief Times and iterations of the step.
+        UpdateInfo info;
+
+        /// \brief Real time factor of the step.
+        double realTimeFactor{0.0};
+
+        /// \brief True if the world was stepping.
+        bool stepping{false};
+
+        /// \brief Mean pacing jitter in nanoseconds, or -1.
+        int64_t pacingJitterMeanNs{-1};
+
+        /// \brief Max pacing jitter in nanoseconds, or -1.
+        int64_t pacingJitterMaxNs{-1};
+
+        /// \brief Hash of the ECM state, if state hashing is enabled.
+        std::optional<uint64_t> stateHash;
+      };
+
+      /// \brief Build and publish the world statistics message.
+      /// \param[in] _stats Values to publish.
+      private: void PublishWorldStats(const StatsSnapshot &_stats);
+
+      /// \brief Build and publish the clock message.
+      /// \param[in] _stats Values to publish.
+      private: void PublishClock(const StatsSnapshot &_stats);
+
+      /// \brief Start the thread publishing the world statistics and clock
+      /// messages, if their publication rates are positive.
+      private: void StartStatsThread();
+
+      /// \brief Stop the statistics thread, and publish the last values
+      /// it was given.
+      private: void StopStatsThread();
+
       /// \brief Process all buffered messages. Ths function is called at
       /// the end of an update iteration.
       private: void ProcessMessages();
@@ -350,6 +499,35 @@ namespace gz
       public: bool GenerateWorldSdf(const msgs::SdfGeneratorConfig &_req,
                                     msgs::StringMsg &_res);
 
+      /// \brief Write the current world's SDFormat representation to a file
+      /// on this machine, with the default generator options. The file is
+      /// written as the models are generated, without holding the whole
+      /// world in memory.
+      /// \param[in] _req Path of the file.
+      /// \param[out] _res True if the file was written.
+      /// \return True if successful.
+      public: bool SaveWorldSdf(const msgs::StringMsg &_req,
+                                msgs::Boolean &_res);
+
+      /// \brief Save a checkpoint of the simulation to a file on this
+      /// machine, so that it can be resumed later with
+      /// ServerConfig::SetRestoreFile. The state is copied by the
+      /// simulation thread between steps, and the file is written by the
+      /// calling thread while the simulation keeps running.
+      /// \param[in] _req Path of the file.
+      /// \param[out] _res True if the file was written.
+      /// \return True if successful.
+      public: bool SaveCheckpoint(const msgs::StringMsg &_req,
+                                  msgs::Boolean &_res);
+
+      /// \brief Resume the simulation from a checkpoint of this world. This
+      /// must be called before the simulation runs. The entities and time
+      /// are restored right away, and the state of the systems before the
+      /// first step, once they're configured.
+      /// \param[in] _checkpoint The checkpoint.
+      /// \return True if the state of the entities was restored.
+      public: bool RestoreCheckpoint(const Checkpoint &_checkpoint);
+
       /// \brief Sets the file path to fuel URI map.
       /// \param[in] _map A populated map of file paths to fuel URIs.
       public: void SetFuelUriMap(
@@ -432,6 +610,63 @@ namespace gz
       /// sleep durations.
       private: std::chrono::steady_clock::duration sleepOffset{0};
 
+      /// \brief Sum and maximum in nanoseconds of the time by which steps
+      /// started after their deadline, over the current window, with precise
+      /// step pacing.
+      /// \sa ServerConfig::SetPreciseStepPacing
+      private: int64_t pacingJitterSumNs{0};
+      private: int64_t pacingJitterWindowMaxNs{0};
+
+      /// \brief Number of steps in the current jitter window.
+      private: uint64_t pacingJitterCount{0};
+
+      /// \brief Mean and maximum jitter in nanoseconds of the last complete
+      /// window, or -1 before the first window is complete.
+      private: int64_t pacingJitterMeanNs{-1};
+      private: int64_t pacingJitterMaxNs{-1};
+
+      /// \brief Steps granted in lockstep and not run yet.
+      private: uint64_t stepCredits{0};
+
+      /// \brief Protects stepCredits.
+      private: std::mutex stepCreditsMutex;
+
+      /// \brief Notified when step credits are granted or the runner stops.
+      private: std::condition_variable stepCreditsCv;
+
+      /// \brief Publishes the end of credited steps in lockstep.
+      private: transport::Node::Publisher lockstepDonePub;
+
+      /// \brief Publishes the world statistics and clock at fixed rates
+      /// while running.
+      private: std::thread statsThread;
+
+      /// \brief Protects the values shared with the statistics thread.
+      private: std::mutex statsMutex;
+
+      /// \brief Notified when the statistics thread must wake up.
+      private: std::condition_variable statsCv;
+
+      /// \brief Values of the last step, for the statistics thread.
+      private: StatsSnapshot latestStats;
+
+      /// \brief True once latestStats holds the values of a step.
+      private: bool latestStatsValid{false};
+
+      /// \brief True if the statistics must be published without waiting
+      /// for the next period, such as after pausing.
+      private: bool statsUrgent{false};
+
+      /// \brief True to stop the statistics thread.
+      private: bool stopStats{false};
+
+      /// \brief True while the statistics thread publishes the world
+      /// statistics.
+      private: bool asyncStats{false};
+
+      /// \brief True while the statistics thread publishes the clock.
+      private: bool asyncClock{false};
+
       /// \brief This is the rate at which the systems are updated.
       /// The default update rate is 500hz, which is a period of 2ms.
       private: std::chrono::steady_clock::duration updatePeriod{2ms};
@@ -450,6 +685,27 @@ namespace gz
       /// \brief Clock publisher for the root `/stats` topic.
       private: gz::transport::Node::Publisher rootStatsPub;
 
+      /// \brief Publisher of the system timing statistics.
+      private: gz::transport::Node::Publisher profilePub;
+
+      /// \brief Wall time when the system timing statistics were last
+      /// published.
+      private: std::chrono::steady_clock::time_point lastProfilePublish;
+
+      /// \brief Publisher of the memory used by component types.
+      private: gz::transport::Node::Publisher memoryProfilePub;
+
+      /// \brief Wall time when the component memory usage was last
+      /// published.
+      private: std::chrono::steady_clock::time_point lastMemoryProfilePublish;
+
+      /// \brief Hash of the ECM state, null unless state hashing is
+      /// enabled.
+      private: std::unique_ptr<StateHash> stateHash;
+
+      /// \brief Publisher of the state hashes.
+      private: gz::transport::Node::Publisher stateHashPub;
+
       /// \brief Clock publisher.
       private: gz::transport::Node::Publisher clockPub;
 
@@ -480,6 +736,9 @@ namespace gz
       /// \brief Pointer to the sdf::World object of this runner
       private: const sdf::World *sdfWorld;
 
+      /// \brief Models of the levels which aren't in sdfWorld, or nullptr
+      private: std::shared_ptr<DeferredIncludes> deferredIncludes;
+
       /// \brief The real time factor calculated based on sim and real time
       /// averages.
       private: double realTimeFactor{0.0};
@@ -502,6 +761,14 @@ namespace gz
       /// \brief Keeps the latest simulation info.
       private: UpdateInfo currentInfo;
 
+      /// \brief Scratch memory of systems, reset after each update.
+      /// \sa EntityComponentManager::StepArena
+      private: FrameArena frameArena;
+
+      /// \brief Wrenches added by systems, applied after PreUpdate.
+      /// \sa EntityComponentManager::Wrenches
+      private: WrenchAccumulator wrenchAccumulator;
+
       /// \brief Buffer of world control messages.
       private: std::list<WorldControl> worldControls;
 
@@ -514,21 +781,86 @@ namespace gz
       /// \brief Copy of the server configuration.
       public: ServerConfig serverConfig;
 
-      /// \brief Collection of threads running system PostUpdates
-      private: std::vector<std::thread> postUpdateThreads;
-
-      /// \brief Flag to indicate running status of PostUpdate threads
-      private: std::atomic<bool> postUpdateThreadsRunning{false};
+      /// \brief Types of the components that entities holding the same data
+      /// share, see EntityComponentManager::InternComponents.
+      /// \sa ServerConfig::SetShareIdenticalComponents
+      private: std::vector<ComponentTypeId> internedComponentTypes;
 
-      /// \brief Barrier to signal beginning of PostUpdate thread execution
-      private: std::unique_ptr<Barrier> postUpdateStartBarrier;
+      /// \brief Pool of threads running system PostUpdates, if the server
+      /// was configured with its own thread count. Otherwise the shared pool
+      /// is used.
+      /// \sa ServerConfig::SetPostUpdateThreadCount
+      private: std::unique_ptr<ThreadPool> postUpdatePool;
 
-      /// \brief Barrier to signal end of PostUpdate thread execution
-      private: std::unique_ptr<Barrier> postUpdateStopBarrier;
+      /// \brief Whether this runner turned on the deterministic mode of the
+      /// thread pools, which it turns off again when it's destroyed.
+      /// \sa ServerConfig::SetDeterministic
+      private: bool deterministic{false};
 
       /// \brief Map from file paths to Fuel URIs.
       private: std::unordered_map<std::string, std::string> fuelUriMap;
 
+      /// \brief Protects the world SDFormat snapshot requests.
+      private: std::mutex worldSdfMutex;
+
+      /// \brief Notified when a snapshot for the world SDFormat was taken.
+      private: std::condition_variable worldSdfCv;
+
+      /// \brief Number of service calls waiting for a snapshot.
+      private: unsigned int worldSdfRequests{0u};
+
+      /// \brief Latest snapshot, shared by the calls that waited for it.
+      private: std::shared_ptr<const WorldSdfSnapshot> worldSdfSnapshot;
+
+      /// \brief Number of snapshots taken so far.
+      private: uint64_t worldSdfSnapshotCount{0u};
+
+      /// \brief Models generated by previous calls, reused while they don't
+      /// change.
+      private: sdf_generator::ModelSdfCache worldSdfCache;
+
+      /// \brief Protects worldSdfCache, so generations run one at a time.
+      private: std::mutex worldSdfCacheMutex;
+
+      /// \brief Protects the checkpoint requests.
+      private: std::mutex checkpointMutex;
+
+      /// \brief Notified when a checkpoint was taken.
+      private: std::condition_variable checkpointCv;
+
+      /// \brief Number of service calls waiting for a checkpoint.
+      private: unsigned int checkpointRequests{0u};
+
+      /// \brief Latest checkpoint, shared by the calls that waited for it.
+      private: std::shared_ptr<const Checkpoint> checkpoint;
+
+      /// \brief Number of checkpoints taken so far.
+      private: uint64_t checkpointCount{0u};
+
+      /// \brief Protects the memory usage requests.
+      private: std::mutex memoryUsageMutex;
+
+      /// \brief Notified when a memory usage report was written.
+      private: std::condition_variable memoryUsageCv;
+
+      /// \brief Number of service calls waiting for a memory usage report.
+      private: unsigned int memoryUsageRequests{0u};
+
+      /// \brief Latest memory usage report, shared by the calls that waited
+      /// for it.
+      private: std::string memoryUsageReport;
+
+      /// \brief Number of memory usage reports written so far.
+      private: uint64_t memoryUsageCount{0u};
+
+      /// \brief SDFormat of the world stored in the checkpoints, written by
+      /// the first checkpoint.
+      private: std::string checkpointWorldSdf;
+
+      /// \brief State of the systems restored from a checkpoint, applied
+      /// once the systems are configured.
+      private: std::vector<CheckpointSystemState> restoredSystemStates;
+
       /// \brief True if Server::RunOnce triggered a blocking paused step
       private: bool blockingPausedStepPending{false};
 
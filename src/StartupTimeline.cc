@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StartupTimeline.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Util.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Private data for the StartupTimeline class.
+class gz::sim::StartupTimelinePrivate
+{
+  /// \brief Protects all members.
+  public: mutable std::mutex mutex;
+
+  /// \brief Recorded phases.
+  public: std::vector<StartupPhase> phases;
+
+  /// \brief Whether phases are recorded.
+  public: bool recording{false};
+};
+
+//////////////////////////////////////////////////
+/// \brief Escape a string to be written in JSON.
+/// \param[in] _str The string.
+/// \return The escaped string.
+static std::string escapeJson(const std::string &_str)
+{
+  std::string escaped;
+  escaped.reserve(_str.size());
+  for (const char c : _str)
+  {
+    if (c == '"' || c == '\\')
+      escaped.push_back('\\');
+    if (static_cast<unsigned char>(c) >= 0x20u)
+      escaped.push_back(c);
+  }
+  return escaped;
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert a duration to milliseconds.
+/// \param[in] _duration The duration.
+/// \return Milliseconds.
+static double toMs(std::chrono::steady_clock::duration _duration)
+{
+  return std::chrono::duration<double, std::milli>(_duration).count();
+}
+
+//////////////////////////////////////////////////
+StartupTimeline::Scope::Scope(const std::string &_name,
+    const std::string &_category)
+{
+  if (!StartupTimeline::Instance().Recording())
+    return;
+
+  this->name = _name;
+  this->category = _category;
+  this->start = std::chrono::steady_clock::now();
+}
+
+//////////////////////////////////////////////////
+StartupTimeline::Scope::~Scope()
+{
+  if (this->name.empty())
+    return;
+
+  StartupPhase phase;
+  phase.name = std::move(this->name);
+  phase.category = std::move(this->category);
+  phase.start = this->start;
+  phase.duration = std::chrono::steady_clock::now() - this->start;
+  phase.thread = std::this_thread::get_id();
+  StartupTimeline::Instance().Record(std::move(phase));
+}
+
+//////////////////////////////////////////////////
+StartupTimeline::StartupTimeline()
+  : dataPtr(std::make_unique<StartupTimelinePrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+StartupTimeline::~StartupTimeline() = default;
+
+//////////////////////////////////////////////////
+StartupTimeline &StartupTimeline::Instance()
+{
+  static StartupTimeline timeline;
+  return timeline;
+}
+
+//////////////////////////////////////////////////
+void StartupTimeline::Restart()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->phases.clear();
+  this->dataPtr->recording = true;
+}
+
+//////////////////////////////////////////////////
+bool StartupTimeline::Recording() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->recording;
+}
+
+//////////////////////////////////////////////////
+void StartupTimeline::Record(StartupPhase _phase)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->recording)
+    this->dataPtr->phases.push_back(std::move(_phase));
+}
+
+//////////////////////////////////////////////////
+void StartupTimeline::Finish()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->recording)
+      return;
+    this->dataPtr->recording = false;
+  }
+
+  gzdbg << "Startup timeline:\n" << this->Summary();
+
+  std::string tracePath;
+  if (common::env(kStartupTracePathEnv, tracePath) && !tracePath.empty())
+  {
+    std::ofstream file(tracePath);
+    file << this->ChromeTrace();
+    if (file)
+    {
+      gzmsg << "Wrote startup trace to [" << tracePath << "]." << std::endl;
+    }
+    else
+    {
+      gzerr << "Failed to write startup trace to [" << tracePath << "]."
+            << std::endl;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<StartupPhase> StartupTimeline::Phases() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->phases;
+}
+
+//////////////////////////////////////////////////
+std::string StartupTimeline::Summary() const
+{
+  const auto phases = this->Phases();
+
+  /// \brief Phases of the same name.
+  struct Total
+  {
+    /// \brief Category of the phases.
+    std::string category;
+
+    /// \brief Number of phases.
+    std::size_t count{0u};
+
+    /// \brief Sum of their durations.
+    std::chrono::steady_clock::duration total{0};
+
+    /// \brief Longest of them.
+    std::chrono::steady_clock::duration max{0};
+  };
+  std::map<std::string, Total> totals;
+  std::size_t nameWidth{5};
+  for (const auto &phase : phases)
+  {
+    auto &total = totals[phase.name];
+    total.category = phase.category;
+    ++total.count;
+    total.total += phase.duration;
+    total.max = std::max(total.max, phase.duration);
+    nameWidth = std::max(nameWidth, phase.name.size());
+  }
+
+  std::vector<std::pair<std::string, Total>> sorted(totals.begin(),
+      totals.end());
+  std::stable_sort(sorted.begin(), sorted.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.second.total > _b.second.total;
+      });
+
+  std::ostringstream out;
+  out << std::left << std::setw(static_cast<int>(nameWidth)) << "Phase"
+      << "  " << std::setw(10) << "Category" << std::right
+      << std::setw(10) << "Count"
+      << std::setw(14) << "Total [ms]"
+      << std::setw(14) << "Max [ms]" << "\n";
+  for (const auto &[name, total] : sorted)
+  {
+    out << std::left << std::setw(static_cast<int>(nameWidth)) << name
+        << "  " << std::setw(10) << total.category
+        << std::right << std::setw(10) << total.count
+        << std::fixed << std::setprecision(3)
+        << std::setw(14) << toMs(total.total)
+        << std::setw(14) << toMs(total.max) << "\n";
+  }
+  return out.str();
+}
+
+//////////////////////////////////////////////////
+std::string StartupTimeline::ChromeTrace() const
+{
+  const auto phases = this->Phases();
+
+  std::chrono::steady_clock::time_point origin;
+  if (!phases.empty())
+  {
+    origin = std::min_element(phases.begin(), phases.end(),
+        [](const StartupPhase &_a, const StartupPhase &_b)
+        {
+          return _a.start < _b.start;
+        })->start;
+  }
+
+  // Threads are numbered in the order they appear
+  std::map<std::thread::id, std::size_t> threadIds;
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  for (std::size_t i = 0u; i < phases.size(); ++i)
+  {
+    const auto &phase = phases[i];
+    const auto tid = threadIds.emplace(phase.thread,
+        threadIds.size()).first->second;
+    using Micros = std::chrono::duration<double, std::micro>;
+    out << (i == 0u ? "\n" : ",\n")
+        << "{\"name\":\"" << escapeJson(phase.name)
+        << "\",\"cat\":\"" << escapeJson(phase.category)
+        << "\",\"ph\":\"X\",\"ts\":" << Micros(phase.start - origin).count()
+        << ",\"dur\":" << Micros(phase.duration).count()
+        << ",\"pid\":1,\"tid\":" << tid << "}";
+  }
+  out << "\n]}\n";
+  return out.str();
+}
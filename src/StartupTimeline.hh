@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STARTUPTIMELINE_HH_
+#define GZ_SIM_STARTUPTIMELINE_HH_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class StartupTimelinePrivate;
+
+    /// \brief Environment variable holding the path of a file where the
+    /// startup timeline is written as a Chrome trace, which can be opened
+    /// with chrome://tracing or https://ui.perfetto.dev.
+    const std::string kStartupTracePathEnv{"GZ_SIM_STARTUP_TRACE"};
+
+    /// \brief One phase of the server's startup.
+    struct StartupPhase
+    {
+      /// \brief Name of the phase, such as "Configure gz::sim::systems::X".
+      std::string name;
+
+      /// \brief Category of the phase, such as "systems".
+      std::string category;
+
+      /// \brief When the phase started.
+      std::chrono::steady_clock::time_point start;
+
+      /// \brief How long the phase took.
+      std::chrono::steady_clock::duration duration{0};
+
+      /// \brief Thread that ran the phase.
+      std::thread::id thread;
+    };
+
+    /// \class StartupTimeline StartupTimeline.hh
+    /// \brief Timeline of the phases of the server's startup, such as loading
+    /// SDF, downloading models, creating entities, configuring each system
+    /// and the first step, which creates the physics and rendering
+    /// entities.
+    ///
+    /// Phases are recorded from the moment the server is created until
+    /// Finish is called after the first step, so later entity creation and
+    /// system loading don't grow the timeline. Phases may be recorded
+    /// concurrently.
+    class GZ_SIM_VISIBLE StartupTimeline
+    {
+      /// \brief Records a phase from its construction to its destruction.
+      public: class GZ_SIM_VISIBLE Scope
+      {
+        /// \brief Constructor, which starts the phase.
+        /// \param[in] _name Name of the phase.
+        /// \param[in] _category Category of the phase.
+        public: Scope(const std::string &_name, const std::string &_category);
+
+        /// \brief Destructor, which records the phase.
+        public: ~Scope();
+
+        /// \brief Name of the phase, empty if it isn't recorded.
+        private: std::string name;
+
+        /// \brief Category of the phase.
+        private: std::string category;
+
+        /// \brief When the phase started.
+        private: std::chrono::steady_clock::time_point start;
+      };
+
+      /// \brief Constructor
+      public: StartupTimeline();
+
+      /// \brief Destructor
+      public: ~StartupTimeline();
+
+      /// \brief Get the timeline shared by the whole process.
+      /// \return The shared timeline.
+      public: static StartupTimeline &Instance();
+
+      /// \brief Remove all phases and start recording, typically when a
+      /// server is created.
+      public: void Restart();
+
+      /// \brief Get whether phases are being recorded.
+      /// \return True between Restart and Finish.
+      public: bool Recording() const;
+
+      /// \brief Record a phase, if the timeline is recording.
+      /// \param[in] _phase The phase.
+      public: void Record(StartupPhase _phase);
+
+      /// \brief Stop recording, print the summary and write the Chrome trace
+      /// to the file given by kStartupTracePathEnv, if it's set. Calls after
+      /// the first one have no effect.
+      public: void Finish();
+
+      /// \brief Get the recorded phases.
+      /// \return Phases, in the order they finished.
+      public: std::vector<StartupPhase> Phases() const;
+
+      /// \brief Get a table with the total duration of the phases of each
+      /// name, longest first, meant to be printed to the console.
+      /// \return The table.
+      public: std::string Summary() const;
+
+      /// \brief Get the phases as a Chrome trace.
+      /// \return JSON document in the Chrome trace event format.
+      public: std::string ChromeTrace() const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StartupTimelinePrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
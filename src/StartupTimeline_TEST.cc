@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/common/Util.hh>
+
+#include "StartupTimeline.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(StartupTimeline, Scopes)
+{
+  auto &timeline = StartupTimeline::Instance();
+  timeline.Restart();
+  EXPECT_TRUE(timeline.Recording());
+
+  {
+    StartupTimeline::Scope outer("Load \"SDF\"", "sdf");
+    for (int i = 0; i < 3; ++i)
+    {
+      StartupTimeline::Scope inner("Configure system", "systems");
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+  std::thread([]
+  {
+    StartupTimeline::Scope scope("Prefetch Fuel models", "fuel");
+  }).join();
+
+  // Phases are recorded as they finish
+  auto phases = timeline.Phases();
+  ASSERT_EQ(5u, phases.size());
+  EXPECT_EQ("Configure system", phases[0].name);
+  EXPECT_EQ("systems", phases[0].category);
+  EXPECT_LE(1ms, phases[0].duration);
+  EXPECT_EQ("Load \"SDF\"", phases[3].name);
+  EXPECT_LE(phases[3].start, phases[0].start);
+  EXPECT_LE(3ms, phases[3].duration);
+  EXPECT_NE(phases[3].thread, phases[4].thread);
+
+  // Phases of the same name are summed up
+  const auto summary = timeline.Summary();
+  EXPECT_NE(std::string::npos, summary.find("Configure system"));
+  EXPECT_NE(std::string::npos, summary.find("Prefetch Fuel models"));
+
+  const auto trace = timeline.ChromeTrace();
+  EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"Load \\\"SDF\\\"\""));
+  EXPECT_NE(std::string::npos, trace.find("\"tid\":1"));
+
+  // Nothing is recorded once the timeline finishes
+  common::TempDirectory tempDir("startup_timeline", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto tracePath = common::joinPaths(tempDir.Path(), "trace.json");
+  ASSERT_TRUE(common::setenv(kStartupTracePathEnv, tracePath));
+  timeline.Finish();
+  EXPECT_TRUE(common::unsetenv(kStartupTracePathEnv));
+  EXPECT_FALSE(timeline.Recording());
+  {
+    StartupTimeline::Scope scope("First step", "step");
+  }
+  EXPECT_EQ(5u, timeline.Phases().size());
+
+  std::ifstream file(tracePath);
+  const std::string written{std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+  EXPECT_EQ(trace, written);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StateCompression.hh"
+
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <gz/common/Console.hh>
+
+#include "gz/sim/private_msgs/compressed_state.pb.h"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+//////////////////////////////////////////////////
+bool compressMessage(const std::string &_type, const std::string &_data,
+    int _level, std::string &_out)
+{
+  private_msgs::CompressedState msg;
+  msg.set_type(_type);
+  msg.set_size(_data.size());
+
+  {
+    google::protobuf::io::StringOutputStream output(msg.mutable_data());
+    google::protobuf::io::GzipOutputStream::Options options;
+    options.format = google::protobuf::io::GzipOutputStream::ZLIB;
+    options.compression_level = std::clamp(_level, -1, 9);
+    google::protobuf::io::GzipOutputStream zlib(&output, options);
+
+    std::size_t offset = 0;
+    void *buffer;
+    int size;
+    while (offset < _data.size())
+    {
+      if (!zlib.Next(&buffer, &size))
+      {
+        gzerr << "Failed to compress message of type [" << _type << "]: "
+              << (zlib.ZlibErrorMessage() ? zlib.ZlibErrorMessage() : "")
+              << std::endl;
+        return false;
+      }
+      const auto count = std::min<std::size_t>(size, _data.size() - offset);
+      std::memcpy(buffer, _data.data() + offset, count);
+      offset += count;
+      zlib.BackUp(size - static_cast<int>(count));
+    }
+    if (!zlib.Close())
+    {
+      gzerr << "Failed to compress message of type [" << _type << "]."
+            << std::endl;
+      return false;
+    }
+  }
+
+  return msg.SerializeToString(&_out);
+}
+
+//////////////////////////////////////////////////
+bool uncompressMessage(std::string &_type, std::string &_data)
+{
+  if (_type != kCompressedStateType)
+    return true;
+
+  private_msgs::CompressedState msg;
+  if (!msg.ParseFromString(_data))
+  {
+    gzerr << "Failed to parse compressed message." << std::endl;
+    return false;
+  }
+
+  std::string data;
+  data.reserve(msg.size());
+  google::protobuf::io::ArrayInputStream input(msg.data().data(),
+      static_cast<int>(msg.data().size()));
+  google::protobuf::io::GzipInputStream zlib(&input,
+      google::protobuf::io::GzipInputStream::ZLIB);
+  const void *buffer;
+  int size;
+  while (zlib.Next(&buffer, &size))
+    data.append(static_cast<const char *>(buffer), size);
+
+  if (zlib.ZlibErrorMessage() != nullptr || data.size() != msg.size())
+  {
+    gzerr << "Failed to uncompress message of type [" << msg.type() << "]."
+          << std::endl;
+    return false;
+  }
+
+  _type = msg.type();
+  _data = std::move(data);
+  return true;
+}
+}
+}
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STATECOMPRESSION_HH_
+#define GZ_SIM_STATECOMPRESSION_HH_
+
+#include <string>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \brief Message type of recorded messages compressed by
+    /// compressMessage.
+    const char kCompressedStateType[] = "gz.sim.private_msgs.CompressedState";
+
+    /// \brief Compress a serialized message with zlib, wrapping it in a
+    /// message of type kCompressedStateType that keeps its original type.
+    /// \param[in] _type Type of the message.
+    /// \param[in] _data The serialized message.
+    /// \param[in] _level Compression level, from 0 for none to 9 for the
+    /// smallest output, or -1 for zlib's default.
+    /// \param[out] _out The serialized compressed message.
+    /// \return True on success.
+    bool GZ_SIM_VISIBLE compressMessage(const std::string &_type,
+        const std::string &_data, int _level, std::string &_out);
+
+    /// \brief Undo compressMessage. Messages of other types are left
+    /// unchanged, so this can be called on every recorded message.
+    /// \param[in,out] _type Type of the message, replaced by the type of
+    /// the compressed message.
+    /// \param[in,out] _data The serialized message, replaced by the
+    /// uncompressed message.
+    /// \return False if the message is compressed but invalid, in which
+    /// case _type and _data are unchanged.
+    bool GZ_SIM_VISIBLE uncompressMessage(std::string &_type,
+        std::string &_data);
+    }
+  }
+}
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <string>
+
+#include "StateCompression.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(StateCompression, RoundTrip)
+{
+  msgs::SerializedStateMap state;
+  for (int i = 0; i < 100; ++i)
+  {
+    auto &entity = (*state.mutable_entities())[i];
+    entity.set_id(i);
+    auto &component = (*entity.mutable_components())[1];
+    component.set_type(1);
+    component.set_component(std::string(64, 'a' + i % 4));
+  }
+  const std::string data = state.SerializeAsString();
+
+  std::string compressed;
+  ASSERT_TRUE(compressMessage(state.GetTypeName(), data, -1, compressed));
+  EXPECT_LT(compressed.size(), data.size() / 4);
+
+  std::string type = kCompressedStateType;
+  std::string uncompressed = compressed;
+  ASSERT_TRUE(uncompressMessage(type, uncompressed));
+  EXPECT_EQ("gz.msgs.SerializedStateMap", type);
+  EXPECT_EQ(data, uncompressed);
+
+  // Empty messages
+  ASSERT_TRUE(compressMessage("gz.msgs.Empty", "", 9, compressed));
+  type = kCompressedStateType;
+  ASSERT_TRUE(uncompressMessage(type, compressed));
+  EXPECT_EQ("gz.msgs.Empty", type);
+  EXPECT_TRUE(compressed.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(StateCompression, Uncompressed)
+{
+  // Other messages are left as they are
+  std::string type = "gz.msgs.StringMsg";
+  std::string data = "abc";
+  EXPECT_TRUE(uncompressMessage(type, data));
+  EXPECT_EQ("gz.msgs.StringMsg", type);
+  EXPECT_EQ("abc", data);
+}
+
+/////////////////////////////////////////////////
+TEST(StateCompression, Invalid)
+{
+  std::string compressed;
+  ASSERT_TRUE(compressMessage("gz.msgs.StringMsg",
+      std::string(1000, 'x'), -1, compressed));
+
+  // Truncated and garbage data are rejected and left unchanged
+  for (const auto &invalid : {compressed.substr(0, compressed.size() - 4),
+      std::string(32, '\xff')})
+  {
+    std::string type = kCompressedStateType;
+    std::string data = invalid;
+    EXPECT_FALSE(uncompressMessage(type, data));
+    EXPECT_EQ(kCompressedStateType, type);
+    EXPECT_EQ(invalid, data);
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StateDeltaFilter.hh"
+
+#include <gz/common/Profiler.hh>
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+std::size_t StateDeltaFilter::Filter(msgs::SerializedStateMap &_state)
+{
+  GZ_PROFILE("StateDeltaFilter::Filter");
+  std::size_t removed{0u};
+  auto *entities = _state.mutable_entities();
+  for (auto entityIt = entities->begin(); entityIt != entities->end();)
+  {
+    auto &entityMsg = entityIt->second;
+    const Entity entity{entityMsg.id()};
+
+    if (entityMsg.remove())
+    {
+      this->applied.erase(entity);
+      ++entityIt;
+      continue;
+    }
+
+    auto [cacheIt, newEntity] = this->applied.try_emplace(entity);
+    auto &cache = cacheIt->second;
+
+    auto *components = entityMsg.mutable_components();
+    for (auto compIt = components->begin(); compIt != components->end();)
+    {
+      const auto &compMsg = compIt->second;
+      const ComponentTypeId type = compMsg.type();
+      if (compMsg.remove())
+      {
+        cache.erase(type);
+        ++compIt;
+        continue;
+      }
+
+      auto dataIt = cache.find(type);
+      if (dataIt != cache.end() && dataIt->second == compMsg.component())
+      {
+        compIt = components->erase(compIt);
+        ++removed;
+        continue;
+      }
+
+      cache[type] = compMsg.component();
+      ++compIt;
+    }
+
+    // New entities are kept even without components, so they're created
+    if (!newEntity && components->empty())
+      entityIt = entities->erase(entityIt);
+    else
+      ++entityIt;
+  }
+
+  this->skipped += removed;
+  return removed;
+}
+
+//////////////////////////////////////////////////
+void StateDeltaFilter::Reset()
+{
+  this->applied.clear();
+}
+
+//////////////////////////////////////////////////
+std::size_t StateDeltaFilter::Skipped() const
+{
+  return this->skipped;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STATEDELTAFILTER_HH_
+#define GZ_SIM_STATEDELTAFILTER_HH_
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class StateDeltaFilter StateDeltaFilter.hh
+    /// \brief Removes the components that didn't change from a sequence of
+    /// states before they're applied with
+    /// EntityComponentManager::SetState, so they aren't deserialized again.
+    ///
+    /// The filter keeps the serialized data of every component it let
+    /// through, and drops a component when its data is byte for byte the
+    /// same as the last time. Entities that were seen before and are left
+    /// without components are dropped too. This assumes the states are the
+    /// only source of changes to the entity component manager, so it must
+    /// be reset whenever the manager is changed some other way, such as
+    /// when seeking.
+    class GZ_SIM_VISIBLE StateDeltaFilter
+    {
+      /// \brief Remove the unchanged components of a state.
+      /// \param[in,out] _state State to filter.
+      /// \return Number of components removed.
+      public: std::size_t Filter(msgs::SerializedStateMap &_state);
+
+      /// \brief Forget the data of all components, so the next state is
+      /// let through completely.
+      public: void Reset();
+
+      /// \brief Number of components removed since construction.
+      /// \return Number of components.
+      public: std::size_t Skipped() const;
+
+      /// \brief Serialized data of the components last let through, by
+      /// entity and component type.
+      private: std::unordered_map<Entity,
+                   std::unordered_map<ComponentTypeId, std::string>> applied;
+
+      /// \brief Number of components removed since construction.
+      private: std::size_t skipped{0u};
+    };
+    }
+  }
+}
+#endif
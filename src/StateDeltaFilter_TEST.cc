@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <string>
+
+#include "StateDeltaFilter.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+/// \brief Set a component of an entity in a state.
+void setComponent(msgs::SerializedStateMap &_state, Entity _entity,
+    ComponentTypeId _type, const std::string &_data)
+{
+  auto &entity = (*_state.mutable_entities())[_entity];
+  entity.set_id(_entity);
+  auto &component = (*entity.mutable_components())[_type];
+  component.set_type(_type);
+  component.set_component(_data);
+}
+
+/////////////////////////////////////////////////
+TEST(StateDeltaFilter, SkipUnchanged)
+{
+  StateDeltaFilter filter;
+
+  // Everything is new
+  msgs::SerializedStateMap state;
+  setComponent(state, 1, 10, "a");
+  setComponent(state, 1, 11, "b");
+  setComponent(state, 2, 10, "c");
+  EXPECT_EQ(0u, filter.Filter(state));
+  EXPECT_EQ(2, state.entities().size());
+
+  // Only the changed component of entity 1 is left, and entity 2 is dropped
+  state.Clear();
+  setComponent(state, 1, 10, "a");
+  setComponent(state, 1, 11, "B");
+  setComponent(state, 2, 10, "c");
+  EXPECT_EQ(2u, filter.Filter(state));
+  ASSERT_EQ(1, state.entities().size());
+  ASSERT_EQ(1, state.entities().at(1).components().size());
+  EXPECT_EQ("B", state.entities().at(1).components().at(11).component());
+  EXPECT_EQ(2u, filter.Skipped());
+
+  // New entities are kept without components
+  state.Clear();
+  (*state.mutable_entities())[3].set_id(3);
+  EXPECT_EQ(0u, filter.Filter(state));
+  EXPECT_EQ(1, state.entities().size());
+
+  // A reset lets everything through
+  filter.Reset();
+  state.Clear();
+  setComponent(state, 1, 10, "a");
+  EXPECT_EQ(0u, filter.Filter(state));
+  EXPECT_EQ(1, state.entities().size());
+}
+
+/////////////////////////////////////////////////
+TEST(StateDeltaFilter, Removals)
+{
+  StateDeltaFilter filter;
+  msgs::SerializedStateMap state;
+  setComponent(state, 1, 10, "a");
+  setComponent(state, 2, 10, "b");
+  filter.Filter(state);
+
+  // Removals are kept
+  state.Clear();
+  setComponent(state, 1, 10, "");
+  (*(*state.mutable_entities())[1].mutable_components())[10].set_remove(
+      true);
+  (*state.mutable_entities())[2].set_id(2);
+  (*state.mutable_entities())[2].set_remove(true);
+  EXPECT_EQ(0u, filter.Filter(state));
+  EXPECT_EQ(2, state.entities().size());
+
+  // So the removed component and entity are applied again if they come back
+  state.Clear();
+  setComponent(state, 1, 10, "a");
+  setComponent(state, 2, 10, "b");
+  EXPECT_EQ(0u, filter.Filter(state));
+  EXPECT_EQ(2, state.entities().size());
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StateHash.hh"
+
+#include <cstdio>
+#include <optional>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/components/Factory.hh"
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Sum of the hashes of some components.
+struct Bucket
+{
+  /// \brief Sum of the hashes, wrapping around.
+  std::uint64_t hash{0u};
+
+  /// \brief Number of components.
+  std::size_t count{0u};
+};
+
+/// \brief Terms of the hashes contributed by an entity.
+struct EntityTerms
+{
+  /// \brief Child of the world the entity descends from.
+  Entity top{kNullEntity};
+
+  /// \brief Hash of each component.
+  std::vector<std::pair<ComponentTypeId, std::uint64_t>> components;
+};
+
+//////////////////////////////////////////////////
+/// \brief Scramble the bits of a number, with the finalizer of splitmix64,
+/// so that sums of hashes of similar components are well distributed.
+/// \param[in] _x The number.
+/// \return The scrambled number.
+std::uint64_t mix(std::uint64_t _x)
+{
+  _x = (_x ^ (_x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  _x = (_x ^ (_x >> 27)) * 0x94d049bb133111ebull;
+  return _x ^ (_x >> 31);
+}
+
+//////////////////////////////////////////////////
+/// \brief Hash a component.
+/// \param[in] _entity Entity of the component.
+/// \param[in] _type Type of the component.
+/// \param[in] _data Serialized data of the component.
+/// \return The hash.
+std::uint64_t componentHash(Entity _entity, ComponentTypeId _type,
+    const std::string &_data)
+{
+  // FNV-1a, seeded with the entity and type
+  std::uint64_t hash = mix(mix(_entity) ^ _type) ^ 14695981039346656037ull;
+  for (const char c : _data)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return mix(hash);
+}
+
+//////////////////////////////////////////////////
+/// \brief Serialize a component, using its binary serializer if it has
+/// one, since it writes the same bytes as streams.
+/// \param[in] _comp Component to serialize.
+/// \param[out] _out Serialized component.
+void serialize(const components::BaseComponent &_comp, std::string &_out)
+{
+  const auto *ops = components::Factory::Instance()->DataOps(_comp.TypeId());
+  const auto size = nullptr != ops ? ops->SerializedSize(&_comp) :
+      std::nullopt;
+  if (size)
+  {
+    _out.resize(*size);
+    if (ops->SerializeTo(&_comp, _out.data(), *size))
+      return;
+  }
+
+  std::ostringstream ostr;
+  _comp.Serialize(ostr);
+  _out = ostr.str();
+}
+
+//////////////////////////////////////////////////
+/// \brief Add a term to a bucket.
+/// \param[in, out] _buckets Buckets by key.
+/// \param[in] _key Key of the bucket.
+/// \param[in] _hash The term.
+template <typename Key>
+void add(std::unordered_map<Key, Bucket> &_buckets, Key _key,
+    std::uint64_t _hash)
+{
+  auto &bucket = _buckets[_key];
+  bucket.hash += _hash;
+  ++bucket.count;
+}
+
+//////////////////////////////////////////////////
+/// \brief Subtract a term from a bucket, removing emptied buckets.
+/// \param[in, out] _buckets Buckets by key.
+/// \param[in] _key Key of the bucket.
+/// \param[in] _hash The term.
+template <typename Key>
+void subtract(std::unordered_map<Key, Bucket> &_buckets, Key _key,
+    std::uint64_t _hash)
+{
+  auto it = _buckets.find(_key);
+  if (it == _buckets.end())
+    return;
+  it->second.hash -= _hash;
+  if (--it->second.count == 0u)
+    _buckets.erase(it);
+}
+}
+
+/// \brief Private data for StateHash.
+class gz::sim::StateHashPrivate
+{
+  /// \brief Hash all components of the ECM.
+  /// \param[in] _ecm The ECM.
+  public: void Rebuild(const EntityComponentManager &_ecm);
+
+  /// \brief Hash a component, replacing its previous hash.
+  /// \param[in] _ecm The ECM.
+  /// \param[in] _entity Entity of the component.
+  /// \param[in] _type Type of the component.
+  public: void Hash(const EntityComponentManager &_ecm, Entity _entity,
+              ComponentTypeId _type);
+
+  /// \brief Remove the hash of a component.
+  /// \param[in] _entity Entity of the component.
+  /// \param[in] _type Type of the component.
+  public: void RemoveComponent(Entity _entity, ComponentTypeId _type);
+
+  /// \brief Remove the hashes of all components of an entity.
+  /// \param[in] _entity The entity.
+  public: void RemoveEntity(Entity _entity);
+
+  /// \brief Get the child of the world an entity descends from.
+  /// \param[in] _ecm The ECM.
+  /// \param[in] _entity The entity.
+  /// \return The entity itself if it's the world or a child of it.
+  public: static Entity TopLevel(const EntityComponentManager &_ecm,
+              Entity _entity);
+
+  /// \brief Terms of each entity.
+  public: std::unordered_map<Entity, EntityTerms> entities;
+
+  /// \brief Hashes by component type.
+  public: std::unordered_map<ComponentTypeId, Bucket> types;
+
+  /// \brief Hashes by top-level entity.
+  public: std::unordered_map<Entity, Bucket> tops;
+
+  /// \brief Hash of the whole state.
+  public: std::uint64_t total{0u};
+
+  /// \brief Change version of the ECM at the last update.
+  public: std::uint64_t version{0u};
+
+  /// \brief False until the whole state was hashed.
+  public: bool valid{false};
+
+  /// \brief Number of components hashed by the last update.
+  public: std::size_t hashedCount{0u};
+
+  /// \brief Serialized component, kept to reuse its memory.
+  public: std::string buffer;
+};
+
+//////////////////////////////////////////////////
+void StateHashPrivate::Rebuild(const EntityComponentManager &_ecm)
+{
+  this->entities.clear();
+  this->types.clear();
+  this->tops.clear();
+  this->total = 0u;
+  for (const auto &vertex : _ecm.Entities().Vertices())
+  {
+    for (const auto type : _ecm.ComponentTypes(vertex.first))
+      this->Hash(_ecm, vertex.first, type);
+  }
+}
+
+//////////////////////////////////////////////////
+void StateHashPrivate::Hash(const EntityComponentManager &_ecm,
+    Entity _entity, ComponentTypeId _type)
+{
+  const auto *comp = _ecm.ComponentImplementation(_entity, _type);
+  if (nullptr == comp)
+  {
+    this->RemoveComponent(_entity, _type);
+    return;
+  }
+  serialize(*comp, this->buffer);
+  const std::uint64_t hash = componentHash(_entity, _type, this->buffer);
+  ++this->hashedCount;
+
+  auto &terms = this->entities[_entity];
+  const Entity top = TopLevel(_ecm, _entity);
+  if (terms.top != top)
+  {
+    // The entity was moved to another model
+    for (const auto &[type, term] : terms.components)
+    {
+      subtract(this->tops, terms.top, term);
+      add(this->tops, top, term);
+    }
+    terms.top = top;
+  }
+
+  for (auto &[type, term] : terms.components)
+  {
+    if (type != _type)
+      continue;
+    this->total += hash - term;
+    this->types[_type].hash += hash - term;
+    this->tops[top].hash += hash - term;
+    term = hash;
+    return;
+  }
+  terms.components.emplace_back(_type, hash);
+  this->total += hash;
+  add(this->types, _type, hash);
+  add(this->tops, top, hash);
+}
+
+//////////////////////////////////////////////////
+void StateHashPrivate::RemoveComponent(Entity _entity, ComponentTypeId _type)
+{
+  auto it = this->entities.find(_entity);
+  if (it == this->entities.end())
+    return;
+
+  auto &components = it->second.components;
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    if (components[i].first != _type)
+      continue;
+    const std::uint64_t term = components[i].second;
+    this->total -= term;
+    subtract(this->types, _type, term);
+    subtract(this->tops, it->second.top, term);
+    components[i] = components.back();
+    components.pop_back();
+    break;
+  }
+  if (components.empty())
+    this->entities.erase(it);
+}
+
+//////////////////////////////////////////////////
+void StateHashPrivate::RemoveEntity(Entity _entity)
+{
+  auto it = this->entities.find(_entity);
+  if (it == this->entities.end())
+    return;
+
+  for (const auto &[type, term] : it->second.components)
+  {
+    this->total -= term;
+    subtract(this->types, type, term);
+    subtract(this->tops, it->second.top, term);
+  }
+  this->entities.erase(it);
+}
+
+//////////////////////////////////////////////////
+Entity StateHashPrivate::TopLevel(const EntityComponentManager &_ecm,
+    Entity _entity)
+{
+  Entity parent = _ecm.ParentEntity(_entity);
+  // Bounded in case of a parent cycle
+  for (int depth = 0; depth < 1000 && kNullEntity != parent; ++depth)
+  {
+    const Entity grandparent = _ecm.ParentEntity(parent);
+    if (kNullEntity == grandparent)
+      break;
+    _entity = parent;
+    parent = grandparent;
+  }
+  return _entity;
+}
+
+//////////////////////////////////////////////////
+StateHash::StateHash()
+  : dataPtr(std::make_unique<StateHashPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+StateHash::~StateHash() = default;
+
+//////////////////////////////////////////////////
+void StateHash::Update(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("StateHash::Update");
+  this->dataPtr->hashedCount = 0u;
+
+  std::unordered_map<ComponentTypeId, std::unordered_set<Entity>> changed;
+  std::unordered_set<Entity> removedEntities;
+  std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+      removedComponents;
+  const std::uint64_t version = _ecm.ChangeVersion();
+  if (!this->dataPtr->valid ||
+      !_ecm.ChangesSince(this->dataPtr->version, changed, removedEntities,
+          removedComponents))
+  {
+    this->dataPtr->Rebuild(_ecm);
+    this->dataPtr->valid = true;
+    this->dataPtr->version = version;
+    return;
+  }
+  this->dataPtr->version = version;
+
+  // Removed IDs may have been reused by entities created since, so removals
+  // go first
+  for (const Entity entity : removedEntities)
+    this->dataPtr->RemoveEntity(entity);
+  for (const auto &[type, entities] : removedComponents)
+  {
+    for (const Entity entity : entities)
+      this->dataPtr->RemoveComponent(entity, type);
+  }
+  for (const auto &[type, entities] : changed)
+  {
+    for (const Entity entity : entities)
+      this->dataPtr->Hash(_ecm, entity, type);
+  }
+}
+
+//////////////////////////////////////////////////
+void StateHash::Reset()
+{
+  this->dataPtr->valid = false;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t StateHash::Total() const
+{
+  return this->dataPtr->total;
+}
+
+//////////////////////////////////////////////////
+std::map<ComponentTypeId, std::uint64_t> StateHash::TypeHashes() const
+{
+  std::map<ComponentTypeId, std::uint64_t> result;
+  for (const auto &[type, bucket] : this->dataPtr->types)
+    result[type] = bucket.hash;
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::map<Entity, std::uint64_t> StateHash::TopLevelHashes() const
+{
+  std::map<Entity, std::uint64_t> result;
+  for (const auto &[entity, bucket] : this->dataPtr->tops)
+    result[entity] = bucket.hash;
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::size_t StateHash::LastHashedCount() const
+{
+  return this->dataPtr->hashedCount;
+}
+
+//////////////////////////////////////////////////
+std::string StateHash::ToString(std::uint64_t _hash)
+{
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx",
+      static_cast<unsigned long long>(_hash));
+  return text;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STATEHASH_HH_
+#define GZ_SIM_STATEHASH_HH_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class EntityComponentManager;
+    class StateHashPrivate;
+
+    /// \class StateHash StateHash.hh
+    /// \brief Hash of the state of an ECM, updated incrementally with the
+    /// components changed since the previous update, so that runs can be
+    /// compared step by step without diffing full states.
+    ///
+    /// Each component is hashed with its entity, its type and its
+    /// serialized data. The hashes of the components are added up, so they
+    /// don't depend on the order of the ECM's containers, and changing a
+    /// component only replaces its own term. Besides the hash of the whole
+    /// state, there's a hash for each component type and one for each
+    /// child of the world with its descendants, such as top-level models,
+    /// to tell where two runs diverged.
+    ///
+    /// Like the changed state, this relies on components being marked with
+    /// SetChanged after being modified through a pointer.
+    class GZ_SIM_VISIBLE StateHash
+    {
+      /// \brief Constructor
+      public: StateHash();
+
+      /// \brief Destructor
+      public: ~StateHash();
+
+      /// \brief Update the hashes with the changes of the ECM since the
+      /// previous update. The first update, and updates after the ECM lost
+      /// track of some removals, hash the whole state.
+      /// \param[in] _ecm The ECM, which must be the same at every update.
+      public: void Update(const EntityComponentManager &_ecm);
+
+      /// \brief Forget all hashes, so the next update hashes the whole
+      /// state. This must be called when the ECM is replaced or its state
+      /// set from a snapshot.
+      public: void Reset();
+
+      /// \brief Get the hash of the whole state.
+      /// \return The hash, 0 for an empty state.
+      public: std::uint64_t Total() const;
+
+      /// \brief Get the hashes of the components of each type.
+      /// \return Hashes keyed by component type.
+      public: std::map<ComponentTypeId, std::uint64_t> TypeHashes() const;
+
+      /// \brief Get the hashes of the components of each child of the world
+      /// and its descendants. Components of the world itself are keyed by
+      /// the world.
+      /// \return Hashes keyed by top-level entity.
+      public: std::map<Entity, std::uint64_t> TopLevelHashes() const;
+
+      /// \brief Get the number of components hashed by the last update.
+      /// \return Number of components.
+      public: std::size_t LastHashedCount() const;
+
+      /// \brief Format a hash as 16 hexadecimal digits.
+      /// \param[in] _hash The hash.
+      /// \return The digits.
+      public: static std::string ToString(std::uint64_t _hash);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StateHashPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/World.hh"
+#include "StateHash.hh"
+
+#include "../test/helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief ECM that can process removals like the runner
+class HashedEcm : public EntityComponentManager
+{
+  public: void ProcessEntityRemovals()
+  {
+    this->ProcessRemoveEntityRequests();
+    this->ClearRemovedComponents();
+  }
+};
+
+class StateHashTest : public InternalFixture<::testing::Test>
+{
+  /// \brief Create a world with two models of one link each.
+  /// \param[in] _ecm ECM to create them in.
+  /// \param[in] _reversed Add the components in the opposite order.
+  protected: void CreateWorld(EntityComponentManager &_ecm,
+                 bool _reversed = false)
+  {
+    this->world = _ecm.CreateEntity();
+    _ecm.CreateComponent(this->world, components::World());
+    for (int i = 0; i < 2; ++i)
+    {
+      this->models[i] = _ecm.CreateEntity();
+      this->links[i] = _ecm.CreateEntity();
+    }
+    for (int j = 0; j < 2; ++j)
+    {
+      const int i = _reversed ? 1 - j : j;
+      const std::string suffix = std::to_string(i);
+      if (_reversed)
+      {
+        _ecm.CreateComponent(this->links[i], components::Pose());
+        _ecm.CreateComponent(this->links[i],
+            components::ParentEntity(this->models[i]));
+        _ecm.CreateComponent(this->models[i],
+            components::Pose(math::Pose3d(i, 0, 0, 0, 0, 0)));
+        _ecm.CreateComponent(this->models[i],
+            components::ParentEntity(this->world));
+        _ecm.CreateComponent(this->models[i],
+            components::Name("model_" + suffix));
+      }
+      else
+      {
+        _ecm.CreateComponent(this->models[i],
+            components::Name("model_" + suffix));
+        _ecm.CreateComponent(this->models[i],
+            components::ParentEntity(this->world));
+        _ecm.CreateComponent(this->models[i],
+            components::Pose(math::Pose3d(i, 0, 0, 0, 0, 0)));
+        _ecm.CreateComponent(this->links[i],
+            components::ParentEntity(this->models[i]));
+        _ecm.CreateComponent(this->links[i], components::Pose());
+      }
+    }
+  }
+
+  /// \brief The world.
+  protected: Entity world{kNullEntity};
+
+  /// \brief The models.
+  protected: Entity models[2]{kNullEntity, kNullEntity};
+
+  /// \brief The link of each model.
+  protected: Entity links[2]{kNullEntity, kNullEntity};
+};
+
+/////////////////////////////////////////////////
+TEST_F(StateHashTest, OrderIndependent)
+{
+  EntityComponentManager ecm1;
+  EntityComponentManager ecm2;
+  this->CreateWorld(ecm1);
+  this->CreateWorld(ecm2, true);
+
+  StateHash hash1;
+  StateHash hash2;
+  hash1.Update(ecm1);
+  hash2.Update(ecm2);
+  EXPECT_NE(0u, hash1.Total());
+  EXPECT_EQ(hash1.Total(), hash2.Total());
+  EXPECT_EQ(hash1.TypeHashes(), hash2.TypeHashes());
+  EXPECT_EQ(hash1.TopLevelHashes(), hash2.TopLevelHashes());
+
+  // The world and both models
+  EXPECT_EQ(3u, hash1.TopLevelHashes().size());
+  EXPECT_EQ(4u, hash1.TypeHashes().size());
+  EXPECT_EQ("000000000000002a", StateHash::ToString(42u));
+}
+
+/////////////////////////////////////////////////
+TEST_F(StateHashTest, Incremental)
+{
+  HashedEcm ecm;
+  this->CreateWorld(ecm);
+
+  StateHash hash;
+  hash.Update(ecm);
+  EXPECT_EQ(11u, hash.LastHashedCount());
+  const auto types = hash.TypeHashes();
+  const auto tops = hash.TopLevelHashes();
+
+  // Nothing changed
+  hash.Update(ecm);
+  EXPECT_EQ(0u, hash.LastHashedCount());
+  EXPECT_EQ(tops, hash.TopLevelHashes());
+
+  // Only the changed component is hashed again, and only the hashes of its
+  // type and model change
+  ecm.SetComponentData<components::Pose>(this->links[1],
+      math::Pose3d(0, 0, 1, 0, 0, 0));
+  hash.Update(ecm);
+  EXPECT_EQ(1u, hash.LastHashedCount());
+  auto newTypes = hash.TypeHashes();
+  auto newTops = hash.TopLevelHashes();
+  EXPECT_NE(types.at(components::Pose::typeId),
+      newTypes.at(components::Pose::typeId));
+  EXPECT_EQ(types.at(components::Name::typeId),
+      newTypes.at(components::Name::typeId));
+  EXPECT_EQ(tops.at(this->models[0]), newTops.at(this->models[0]));
+  EXPECT_NE(tops.at(this->models[1]), newTops.at(this->models[1]));
+
+  // Hashing the whole state gives the same result
+  auto check = [&]()
+  {
+    StateHash full;
+    full.Update(ecm);
+    EXPECT_EQ(full.Total(), hash.Total());
+    EXPECT_EQ(full.TypeHashes(), hash.TypeHashes());
+    EXPECT_EQ(full.TopLevelHashes(), hash.TopLevelHashes());
+  };
+  check();
+
+  // Changing it back restores the hashes
+  ecm.SetComponentData<components::Pose>(this->links[1], math::Pose3d());
+  hash.Update(ecm);
+  EXPECT_EQ(types, hash.TypeHashes());
+  EXPECT_EQ(tops, hash.TopLevelHashes());
+
+  ecm.RemoveComponent<components::Name>(this->models[0]);
+  ecm.RequestRemoveEntity(this->models[1]);
+  ecm.ProcessEntityRemovals();
+  hash.Update(ecm);
+  check();
+  EXPECT_EQ(0u, hash.TopLevelHashes().count(this->models[1]));
+
+  // Reset hashes everything again
+  hash.Reset();
+  hash.Update(ecm);
+  EXPECT_EQ(5u, hash.LastHashedCount());
+  check();
+}
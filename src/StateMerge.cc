@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StateMerge.hh"
+
+#include <gz/common/Profiler.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+
+//////////////////////////////////////////////////
+bool mergeState(const msgs::SerializedStateMap &_changes,
+    msgs::SerializedStateMap &_state, bool _full)
+{
+  GZ_PROFILE("mergeState");
+  auto &entities = *_state.mutable_entities();
+
+  // An entity removed by the older changes and created again by the newer
+  // ones must be removed before it's created, which a single state can't
+  // express. A full state has no removals, so this never fails for it.
+  for (const auto &[id, entity] : _changes.entities())
+  {
+    auto iter = entities.find(id);
+    if (iter != entities.end() && iter->second.remove() && !entity.remove())
+      return false;
+  }
+
+  // The flag applies to all of the components in a state, so the merged
+  // changes have one-time changes if either of them had
+  if (!_full)
+  {
+    _state.set_has_one_time_component_changes(
+        _state.has_one_time_component_changes() ||
+        _changes.has_one_time_component_changes());
+  }
+
+  for (const auto &[id, changedEntity] : _changes.entities())
+  {
+    // Removing an entity overrides its older components
+    if (changedEntity.remove())
+    {
+      if (_full)
+        entities.erase(id);
+      else
+        entities[id] = changedEntity;
+      continue;
+    }
+
+    // Components that the newer state doesn't change are kept
+    auto &entity = entities[id];
+    entity.set_id(changedEntity.id());
+    auto &components = *entity.mutable_components();
+    for (const auto &[type, changedComponent] : changedEntity.components())
+    {
+      if (_full && changedComponent.remove())
+        components.erase(type);
+      else
+        components[type] = changedComponent;
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool mergeState(const msgs::SerializedStepMap &_changes,
+    msgs::SerializedStepMap &_state, bool _full)
+{
+  if (!mergeState(_changes.state(), *_state.mutable_state(), _full))
+    return false;
+
+  _state.mutable_stats()->CopyFrom(_changes.stats());
+  return true;
+}
+}
+}
+}
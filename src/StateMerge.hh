@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STATEMERGE_HH_
+#define GZ_SIM_STATEMERGE_HH_
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \brief Merge a state into an older one, so that applying the result
+    /// to an entity component manager is the same as applying both in
+    /// order.
+    ///
+    /// A full state, such as the snapshot served to late joiners, has no
+    /// removals, so removed entities and components are erased from it.
+    /// A state that holds changes which haven't been applied yet keeps the
+    /// removals instead, so they're still applied, and keeps the
+    /// components of an entity that the newer state doesn't change.
+    /// \param[in] _changes The newer state.
+    /// \param[in,out] _state The older state, which receives the changes.
+    /// \param[in] _full True if _state is a full state, false if it holds
+    /// changes.
+    /// \return False if the states can't be merged, which only happens
+    /// when _state holds changes and the newer state creates an entity
+    /// that it removes. _state isn't changed in that case.
+    GZ_SIM_VISIBLE bool mergeState(const msgs::SerializedStateMap &_changes,
+        msgs::SerializedStateMap &_state, bool _full);
+
+    /// \brief Merge a state into an older one, and take the newer
+    /// statistics.
+    /// \param[in] _changes The newer state.
+    /// \param[in,out] _state The older state, which receives the changes.
+    /// \param[in] _full True if _state is a full state, false if it holds
+    /// changes.
+    /// \return False if the states can't be merged. _state isn't changed
+    /// in that case.
+    /// \sa mergeState(const msgs::SerializedStateMap &,
+    /// msgs::SerializedStateMap &, bool)
+    GZ_SIM_VISIBLE bool mergeState(const msgs::SerializedStepMap &_changes,
+        msgs::SerializedStepMap &_state, bool _full);
+    }
+  }
+}
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include "StateMerge.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+/// \brief Add a component to an entity of a state message.
+/// \param[in, out] _msg The state.
+/// \param[in] _entity The entity.
+/// \param[in] _type Component type.
+/// \param[in] _data Serialized component.
+void addComponent(msgs::SerializedStepMap &_msg, std::uint64_t _entity,
+    std::int64_t _type, const std::string &_data)
+{
+  auto &entity = (*_msg.mutable_state()->mutable_entities())[_entity];
+  entity.set_id(_entity);
+  auto &component = (*entity.mutable_components())[_type];
+  component.set_type(_type);
+  component.set_component(_data);
+}
+
+/////////////////////////////////////////////////
+/// \brief Mark an entity as removed in a state message.
+/// \param[in, out] _msg The state.
+/// \param[in] _entity The entity.
+void removeEntity(msgs::SerializedStepMap &_msg, std::uint64_t _entity)
+{
+  auto &entity = (*_msg.mutable_state()->mutable_entities())[_entity];
+  entity.set_id(_entity);
+  entity.set_remove(true);
+}
+
+/////////////////////////////////////////////////
+/// \brief Mark a component as removed in a state message.
+/// \param[in, out] _msg The state.
+/// \param[in] _entity The entity.
+/// \param[in] _type Component type.
+void removeComponent(msgs::SerializedStepMap &_msg, std::uint64_t _entity,
+    std::int64_t _type)
+{
+  auto &entity = (*_msg.mutable_state()->mutable_entities())[_entity];
+  entity.set_id(_entity);
+  auto &component = (*entity.mutable_components())[_type];
+  component.set_type(_type);
+  component.set_remove(true);
+}
+
+/////////////////////////////////////////////////
+TEST(StateMerge, Full)
+{
+  msgs::SerializedStepMap state;
+  addComponent(state, 1, 10, "a");
+  addComponent(state, 1, 11, "b");
+  addComponent(state, 2, 10, "c");
+
+  msgs::SerializedStepMap changes;
+  changes.mutable_stats()->set_iterations(3);
+  changes.mutable_state()->set_has_one_time_component_changes(true);
+  addComponent(changes, 1, 10, "d");
+  addComponent(changes, 3, 10, "e");
+  removeComponent(changes, 1, 11);
+  removeEntity(changes, 2);
+
+  EXPECT_TRUE(mergeState(changes, state, true));
+  EXPECT_EQ(3u, state.stats().iterations());
+
+  // A full state holds every component, so it has no one-time changes
+  EXPECT_FALSE(state.state().has_one_time_component_changes());
+
+  // Removed entities and components are erased
+  const auto &entities = state.state().entities();
+  ASSERT_EQ(2u, entities.size());
+  ASSERT_EQ(1u, entities.count(1));
+  ASSERT_EQ(1u, entities.at(1).components().size());
+  EXPECT_EQ("d", entities.at(1).components().at(10).component());
+  EXPECT_EQ(0u, entities.count(2));
+  EXPECT_EQ("e", entities.at(3).components().at(10).component());
+
+  // An entity can be created again once it's erased
+  msgs::SerializedStepMap recreated;
+  recreated.mutable_stats()->set_iterations(4);
+  addComponent(recreated, 2, 10, "f");
+  EXPECT_TRUE(mergeState(recreated, state, true));
+  EXPECT_EQ(4u, state.stats().iterations());
+  EXPECT_EQ("f", entities.at(2).components().at(10).component());
+}
+
+/////////////////////////////////////////////////
+TEST(StateMerge, Changes)
+{
+  msgs::SerializedStepMap pending;
+  pending.mutable_stats()->set_iterations(1);
+  pending.mutable_state()->set_has_one_time_component_changes(true);
+  addComponent(pending, 1, 10, "name");
+  addComponent(pending, 1, 11, "pose1");
+  addComponent(pending, 1, 12, "joint");
+  addComponent(pending, 2, 10, "other");
+
+  msgs::SerializedStepMap msg;
+  msg.mutable_stats()->set_iterations(2);
+  addComponent(msg, 1, 11, "pose2");
+  addComponent(msg, 3, 10, "new");
+  removeComponent(msg, 1, 12);
+  removeEntity(msg, 2);
+
+  ASSERT_TRUE(mergeState(msg, pending, false));
+  EXPECT_EQ(2u, pending.stats().iterations());
+
+  // The one-time changes of the older state are kept
+  EXPECT_TRUE(pending.state().has_one_time_component_changes());
+
+  const auto &entities = pending.state().entities();
+  ASSERT_EQ(3u, entities.size());
+
+  // Components that the newer state doesn't change are kept, and
+  // removals are kept so they're applied
+  const auto &components = entities.at(1).components();
+  ASSERT_EQ(3u, components.size());
+  EXPECT_EQ("name", components.at(10).component());
+  EXPECT_EQ("pose2", components.at(11).component());
+  EXPECT_TRUE(components.at(12).remove());
+
+  EXPECT_TRUE(entities.at(2).remove());
+  EXPECT_TRUE(entities.at(2).components().empty());
+  EXPECT_EQ("new", entities.at(3).components().at(10).component());
+}
+
+/////////////////////////////////////////////////
+TEST(StateMerge, RecreatedEntity)
+{
+  msgs::SerializedStepMap pending;
+  pending.mutable_stats()->set_iterations(1);
+  addComponent(pending, 1, 11, "pose1");
+  removeEntity(pending, 2);
+
+  // An entity removed by the pending state and created again can't be
+  // merged, and the pending state isn't changed
+  msgs::SerializedStepMap msg;
+  msg.mutable_stats()->set_iterations(2);
+  msg.mutable_state()->set_has_one_time_component_changes(true);
+  addComponent(msg, 1, 11, "pose2");
+  addComponent(msg, 2, 10, "recreated");
+
+  EXPECT_FALSE(mergeState(msg, pending, false));
+  EXPECT_EQ(1u, pending.stats().iterations());
+  EXPECT_FALSE(pending.state().has_one_time_component_changes());
+  EXPECT_EQ("pose1",
+      pending.state().entities().at(1).components().at(11).component());
+  EXPECT_TRUE(pending.state().entities().at(2).remove());
+  EXPECT_TRUE(pending.state().entities().at(2).components().empty());
+
+  // Later states are merged into the one that couldn't be
+  msgs::SerializedStepMap later;
+  later.mutable_stats()->set_iterations(3);
+  addComponent(later, 2, 11, "pose3");
+  EXPECT_TRUE(mergeState(later, msg, false));
+  EXPECT_EQ(3u, msg.stats().iterations());
+  EXPECT_TRUE(msg.state().has_one_time_component_changes());
+  const auto &components = msg.state().entities().at(2).components();
+  EXPECT_EQ("recreated", components.at(10).component());
+  EXPECT_EQ("pose3", components.at(11).component());
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StateRelay.hh"
+#include "StateMerge.hh"
+
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Profiler.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Maximum number of updates kept while waiting for the initial
+/// state.
+static constexpr std::size_t kMaxPendingStates{1000u};
+
+//////////////////////////////////////////////////
+StateRelay::StateRelay(const std::string &_worldName, const std::string &_ns)
+{
+  this->upstream = transport::TopicUtils::AsValidTopic(
+      "/world/" + _worldName);
+  this->downstream = transport::TopicUtils::AsValidTopic(
+      _ns + "/world/" + _worldName);
+}
+
+//////////////////////////////////////////////////
+bool StateRelay::Start(unsigned int _timeout)
+{
+  if (this->upstream.empty() || this->downstream.empty() ||
+      this->upstream == this->downstream)
+  {
+    gzerr << "Invalid relay from [" << this->upstream << "] to ["
+          << this->downstream << "]." << std::endl;
+    return false;
+  }
+
+  this->statePub = this->node.Advertise<msgs::SerializedStepMap>(
+      this->downstream + "/state");
+  this->compactPub = this->node.Advertise<msgs::Bytes>(
+      this->downstream + "/dynamic_pose/compact");
+  if (!this->statePub || !this->compactPub)
+  {
+    gzerr << "Failed to advertise relayed streams on [" << this->downstream
+          << "]." << std::endl;
+    return false;
+  }
+
+  if (!this->node.Advertise(this->downstream + "/state",
+      &StateRelay::StateService, this) ||
+      !this->node.Advertise(this->downstream + "/state_async",
+      &StateRelay::StateAsyncService, this))
+  {
+    gzerr << "Failed to advertise relayed state services on ["
+          << this->downstream << "]." << std::endl;
+    return false;
+  }
+
+  // Subscribe before requesting the initial state, so no update is missed
+  if (!this->node.Subscribe(this->upstream + "/state",
+      &StateRelay::OnState, this))
+  {
+    gzerr << "Failed to subscribe to [" << this->upstream << "/state]."
+          << std::endl;
+    return false;
+  }
+  this->node.Subscribe(this->upstream + "/dynamic_pose/compact",
+      &StateRelay::OnCompactPoses, this);
+
+  msgs::SerializedStepMap state;
+  bool result{false};
+  if (!this->node.Request(this->upstream + "/state", _timeout, state,
+      result) || !result)
+  {
+    gzwarn << "Failed to get the initial state from [" << this->upstream
+           << "/state]." << std::endl;
+    return false;
+  }
+  this->SetInitialState(state);
+
+  gzmsg << "Relaying [" << this->upstream << "] on [" << this->downstream
+        << "]" << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void StateRelay::SetInitialState(const msgs::SerializedStepMap &_state)
+{
+  std::vector<std::string> requests;
+  std::shared_ptr<const msgs::SerializedStepMap> full;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->snapshot = std::make_shared<msgs::SerializedStepMap>(_state);
+
+    // Updates older than the initial state are already part of it
+    for (const auto &pending : this->pendingStates)
+    {
+      if (pending.stats().iterations() > _state.stats().iterations())
+        mergeState(pending, *this->snapshot, true);
+    }
+    this->pendingStates.clear();
+    requests.swap(this->pendingRequests);
+    full = this->snapshot;
+  }
+
+  for (const auto &request : requests)
+    this->node.Request(request, *full);
+}
+
+//////////////////////////////////////////////////
+void StateRelay::OnState(const msgs::SerializedStepMap &_msg)
+{
+  GZ_PROFILE("StateRelay::OnState");
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->snapshot)
+    {
+      if (this->pendingStates.size() < kMaxPendingStates)
+        this->pendingStates.push_back(_msg);
+    }
+    else
+    {
+      // A service is still copying the snapshot, leave it untouched
+      if (this->snapshot.use_count() > 1)
+      {
+        this->snapshot =
+            std::make_shared<msgs::SerializedStepMap>(*this->snapshot);
+      }
+      mergeState(_msg, *this->snapshot, true);
+    }
+  }
+
+  this->statePub.Publish(_msg);
+}
+
+//////////////////////////////////////////////////
+void StateRelay::OnCompactPoses(const msgs::Bytes &_msg)
+{
+  this->compactPub.Publish(_msg);
+}
+
+//////////////////////////////////////////////////
+bool StateRelay::StateService(msgs::SerializedStepMap &_res)
+{
+  std::shared_ptr<const msgs::SerializedStepMap> full;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    full = this->snapshot;
+  }
+  if (!full)
+    return false;
+
+  _res.CopyFrom(*full);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void StateRelay::StateAsyncService(const msgs::StringMsg &_req)
+{
+  std::shared_ptr<const msgs::SerializedStepMap> full;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->snapshot)
+    {
+      this->pendingRequests.push_back(_req.data());
+      return;
+    }
+    full = this->snapshot;
+  }
+  this->node.Request(_req.data(), *full);
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STATERELAY_HH_
+#define GZ_SIM_STATERELAY_HH_
+
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/serialized_map.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gz/transport/Node.hh>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class StateRelay StateRelay.hh
+    /// \brief Subscribes once to the state streams of a world and
+    /// republishes them under a namespace, so many GUIs can follow a
+    /// simulation while the server only serves the relay.
+    ///
+    /// The relay republishes `/world/<world>/state` and
+    /// `/world/<world>/dynamic_pose/compact` as `<ns>/world/<world>/state`
+    /// and `<ns>/world/<world>/dynamic_pose/compact`. It keeps the full
+    /// state, built from the server's state and every update after it, and
+    /// serves it on the `<ns>/world/<world>/state` and
+    /// `<ns>/world/<world>/state_async` services, so GUIs joining late get
+    /// their initial state from the relay too.
+    ///
+    /// GUIs use a relay when the `GZ_SIM_GUI_RELAY` environment variable
+    /// holds its namespace. Other topics and services, like world control,
+    /// still go to the server.
+    class GZ_SIM_VISIBLE StateRelay
+    {
+      /// \brief Constructor
+      /// \param[in] _worldName Name of the world to relay.
+      /// \param[in] _ns Namespace the streams are republished under, such
+      /// as "/relay".
+      public: StateRelay(const std::string &_worldName,
+                  const std::string &_ns);
+
+      /// \brief Subscribe to the server, advertise the relayed streams and
+      /// request the initial state.
+      /// \param[in] _timeout Milliseconds to wait for the initial state.
+      /// \return True if the relay is running. Late joiners are only served
+      /// once the initial state arrives.
+      public: bool Start(unsigned int _timeout = 5000u);
+
+      /// \brief Callback for states from the server.
+      /// \param[in] _msg The state.
+      private: void OnState(const msgs::SerializedStepMap &_msg);
+
+      /// \brief Callback for compact poses from the server.
+      /// \param[in] _msg The compact pose frame.
+      private: void OnCompactPoses(const msgs::Bytes &_msg);
+
+      /// \brief Callback for the state service.
+      /// \param[out] _res The full state.
+      /// \return True if the initial state was received.
+      private: bool StateService(msgs::SerializedStepMap &_res);
+
+      /// \brief Callback for the asynchronous state service.
+      /// \param[in] _req Service the full state is sent to.
+      private: void StateAsyncService(const msgs::StringMsg &_req);
+
+      /// \brief Set the initial state and answer the clients that were
+      /// waiting for it.
+      /// \param[in] _state The full state from the server.
+      private: void SetInitialState(const msgs::SerializedStepMap &_state);
+
+      /// \brief Transport node.
+      private: transport::Node node;
+
+      /// \brief Prefix of the server's topics.
+      private: std::string upstream;
+
+      /// \brief Prefix of the relayed topics.
+      private: std::string downstream;
+
+      /// \brief Publisher of the relayed states.
+      private: transport::Node::Publisher statePub;
+
+      /// \brief Publisher of the relayed compact poses.
+      private: transport::Node::Publisher compactPub;
+
+      /// \brief Full state, null until the initial state arrives. Replaced
+      /// instead of modified while a service is copying it.
+      private: std::shared_ptr<msgs::SerializedStepMap> snapshot;
+
+      /// \brief Updates received before the initial state.
+      private: std::vector<msgs::SerializedStepMap> pendingStates;
+
+      /// \brief Clients that asked for the state before it arrived.
+      private: std::vector<std::string> pendingRequests;
+
+      /// \brief Protects the snapshot and the pending lists.
+      private: std::mutex mutex;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "StateRelay.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Add a component to a state message.
+void addComponent(msgs::SerializedStepMap &_msg, std::uint64_t _entity,
+    std::int64_t _type, const std::string &_data)
+{
+  auto &entity = (*_msg.mutable_state()->mutable_entities())[_entity];
+  entity.set_id(_entity);
+  auto &component = (*entity.mutable_components())[_type];
+  component.set_type(_type);
+  component.set_component(_data);
+}
+
+/////////////////////////////////////////////////
+TEST(StateRelay, GZ_UTILS_TEST_DISABLED_ON_WIN32(Relay))
+{
+  // Stand-in for the scene broadcaster
+  transport::Node server;
+  msgs::SerializedStepMap initial;
+  initial.mutable_stats()->set_iterations(5);
+  addComponent(initial, 1, 10, "a");
+  std::function<bool(msgs::SerializedStepMap &)> stateService =
+      [&](msgs::SerializedStepMap &_res)
+      {
+        _res.CopyFrom(initial);
+        return true;
+      };
+  ASSERT_TRUE(server.Advertise("/world/relay_test/state", stateService));
+  auto pub = server.Advertise<msgs::SerializedStepMap>(
+      "/world/relay_test/state");
+
+  StateRelay relay("relay_test", "/test_relay");
+  ASSERT_TRUE(relay.Start());
+
+  std::mutex mutex;
+  unsigned int received{0u};
+  std::function<void(const msgs::SerializedStepMap &)> cb =
+      [&](const msgs::SerializedStepMap &)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++received;
+      };
+  transport::Node client;
+  ASSERT_TRUE(client.Subscribe("/test_relay/world/relay_test/state", cb));
+
+  // Entity 2 is added and entity 1 removed
+  msgs::SerializedStepMap update;
+  update.mutable_stats()->set_iterations(6);
+  addComponent(update, 2, 10, "b");
+  (*update.mutable_state()->mutable_entities())[1].set_remove(true);
+
+  for (int sleep = 0; sleep < 50; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (received > 0u)
+        break;
+    }
+    pub.Publish(update);
+    std::this_thread::sleep_for(100ms);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GT(received, 0u);
+  }
+
+  // A late joiner gets the merged state from the relay
+  msgs::SerializedStepMap full;
+  bool result{false};
+  ASSERT_TRUE(client.Request("/test_relay/world/relay_test/state", 5000u,
+      full, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(6u, full.stats().iterations());
+  const auto &entities = full.state().entities();
+  EXPECT_EQ(0u, entities.count(1));
+  ASSERT_EQ(1u, entities.count(2));
+  EXPECT_EQ("b", entities.at(2).components().at(10).component());
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StateSnapshot.hh"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include <gz/common/Console.hh>
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Snapshot header.
+struct SnapshotHeader
+{
+  /// \brief Always "GZSS".
+  char magic[4];
+
+  /// \brief Format version.
+  std::uint32_t version;
+
+  /// \brief Always kByteOrder, as written by the host.
+  std::uint32_t byteOrder;
+
+  /// \brief Snapshot flags.
+  std::uint32_t flags;
+
+  /// \brief Number of records.
+  std::uint64_t recordCount;
+};
+
+/// \brief Record header.
+struct RecordHeader
+{
+  /// \brief Entity of the record.
+  std::uint64_t entity;
+
+  /// \brief Component type of the record.
+  std::uint64_t typeId;
+
+  /// \brief StateSnapshotRecordType of the record.
+  std::uint32_t type;
+
+  /// \brief Size of the data, without padding.
+  std::uint32_t size;
+};
+
+static_assert(sizeof(SnapshotHeader) == 24, "Unexpected header padding");
+static_assert(sizeof(RecordHeader) == 24, "Unexpected header padding");
+
+/// \brief Magic bytes at the start of every snapshot.
+constexpr char kMagic[4] = {'G', 'Z', 'S', 'S'};
+
+/// \brief Current format version.
+constexpr std::uint32_t kVersion = 1;
+
+/// \brief Byte order marker.
+constexpr std::uint32_t kByteOrder = 0x01020304;
+
+/// \brief Flag set when component records hold one-time changes.
+constexpr std::uint32_t kOneTimeChangesFlag = 1u << 0;
+
+/// \brief Records are padded to this alignment.
+constexpr std::size_t kAlignment = 8;
+
+/// \brief Round a size up to kAlignment.
+/// \param[in] _size Size in bytes.
+/// \return Padded size.
+constexpr std::size_t Padded(std::size_t _size)
+{
+  return (_size + kAlignment - 1) & ~(kAlignment - 1);
+}
+}
+
+//////////////////////////////////////////////////
+StateSnapshotWriter::StateSnapshotWriter(std::vector<std::uint8_t> &_buffer)
+  : buffer(_buffer)
+{
+  SnapshotHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byteOrder = kByteOrder;
+  header.flags = 0;
+  header.recordCount = 0;
+
+  this->buffer.clear();
+  this->buffer.resize(sizeof(header));
+  std::memcpy(this->buffer.data(), &header, sizeof(header));
+}
+
+//////////////////////////////////////////////////
+void StateSnapshotWriter::SetOneTimeChanges(bool _oneTime)
+{
+  std::uint32_t flags = _oneTime ? kOneTimeChangesFlag : 0u;
+  std::memcpy(this->buffer.data() + offsetof(SnapshotHeader, flags), &flags,
+      sizeof(flags));
+}
+
+//////////////////////////////////////////////////
+void StateSnapshotWriter::AddRemovedEntity(Entity _entity)
+{
+  this->AddRecord(_entity, 0, StateSnapshotRecordType::RemovedEntity, 0);
+}
+
+//////////////////////////////////////////////////
+void StateSnapshotWriter::AddRemovedComponent(Entity _entity,
+    ComponentTypeId _typeId)
+{
+  this->AddRecord(_entity, _typeId, StateSnapshotRecordType::RemovedComponent,
+      0);
+}
+
+//////////////////////////////////////////////////
+void StateSnapshotWriter::AddComponent(Entity _entity,
+    const components::BaseComponent *_component)
+{
+  const auto typeId = _component->TypeId();
+  const auto *ops = components::Factory::Instance()->DataOps(typeId);
+  if (nullptr != ops && ops->FlatSerializable())
+  {
+    auto *out = this->AddRecord(_entity, typeId,
+        StateSnapshotRecordType::FlatComponent, ops->FlatSize(_component));
+    ops->FlatWrite(_component, out);
+    return;
+  }
+
+  // Write the bytes of the binary serializer, which match the stream's,
+  // straight into the record
+  const auto size = nullptr != ops ? ops->SerializedSize(_component) :
+      std::nullopt;
+  if (size)
+  {
+    const auto start = this->buffer.size();
+    auto *out = this->AddRecord(_entity, typeId,
+        StateSnapshotRecordType::StreamComponent, *size);
+    if (ops->SerializeTo(_component, reinterpret_cast<char *>(out), *size))
+      return;
+
+    // Drop the record and fall back to streams
+    this->buffer.resize(start);
+    --this->recordCount;
+    std::memcpy(this->buffer.data() + offsetof(SnapshotHeader, recordCount),
+        &this->recordCount, sizeof(this->recordCount));
+  }
+
+  std::ostringstream ostr;
+  _component->Serialize(ostr);
+  const std::string str = ostr.str();
+  auto *out = this->AddRecord(_entity, typeId,
+      StateSnapshotRecordType::StreamComponent, str.size());
+  std::memcpy(out, str.data(), str.size());
+}
+
+//////////////////////////////////////////////////
+void StateSnapshotWriter::CopyRecord(const StateSnapshotRecord &_record)
+{
+  auto *out = this->AddRecord(_record.entity, _record.typeId, _record.type,
+      _record.size);
+  if (_record.size > 0)
+    std::memcpy(out, _record.data, _record.size);
+}
+
+//////////////////////////////////////////////////
+std::uint64_t StateSnapshotWriter::RecordCount() const
+{
+  return this->recordCount;
+}
+
+//////////////////////////////////////////////////
+std::uint8_t *StateSnapshotWriter::AddRecord(Entity _entity,
+    ComponentTypeId _typeId, StateSnapshotRecordType _type, std::size_t _size)
+{
+  RecordHeader header;
+  header.entity = _entity;
+  header.typeId = _typeId;
+  header.type = static_cast<std::uint32_t>(_type);
+  header.size = static_cast<std::uint32_t>(_size);
+
+  // Resizing zeroes the padding, and grows the capacity geometrically, so a
+  // buffer reused across steps stops allocating once it's large enough.
+  const std::size_t start = this->buffer.size();
+  this->buffer.resize(start + sizeof(header) + Padded(_size));
+  std::memcpy(this->buffer.data() + start, &header, sizeof(header));
+
+  ++this->recordCount;
+  std::memcpy(this->buffer.data() + offsetof(SnapshotHeader, recordCount),
+      &this->recordCount, sizeof(this->recordCount));
+
+  return this->buffer.data() + start + sizeof(header);
+}
+
+//////////////////////////////////////////////////
+StateSnapshotReader::StateSnapshotReader(const std::uint8_t *_data,
+    std::size_t _size)
+  : data(_data), size(_size)
+{
+  SnapshotHeader header;
+  if (nullptr == _data || _size < sizeof(header))
+  {
+    gzerr << "State snapshot is too small [" << _size << " bytes]."
+          << std::endl;
+    return;
+  }
+  std::memcpy(&header, _data, sizeof(header));
+
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+  {
+    gzerr << "Data is not a state snapshot." << std::endl;
+    return;
+  }
+  if (header.version != kVersion)
+  {
+    gzerr << "Unsupported state snapshot version [" << header.version
+          << "], expected [" << kVersion << "]." << std::endl;
+    return;
+  }
+  if (header.byteOrder != kByteOrder)
+  {
+    gzerr << "State snapshot was written with a different byte order."
+          << std::endl;
+    return;
+  }
+
+  this->flags = header.flags;
+  this->recordCount = header.recordCount;
+  this->offset = sizeof(header);
+  this->valid = true;
+}
+
+//////////////////////////////////////////////////
+bool StateSnapshotReader::Valid() const
+{
+  return this->valid;
+}
+
+//////////////////////////////////////////////////
+bool StateSnapshotReader::OneTimeChanges() const
+{
+  return (this->flags & kOneTimeChangesFlag) != 0;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t StateSnapshotReader::RecordCount() const
+{
+  return this->recordCount;
+}
+
+//////////////////////////////////////////////////
+bool StateSnapshotReader::Next(StateSnapshotRecord &_record)
+{
+  if (!this->valid || this->recordsRead >= this->recordCount)
+    return false;
+
+  RecordHeader header;
+  if (this->size - this->offset < sizeof(header))
+  {
+    gzerr << "State snapshot is truncated at record [" << this->recordsRead
+          << "]." << std::endl;
+    this->valid = false;
+    return false;
+  }
+  std::memcpy(&header, this->data + this->offset, sizeof(header));
+
+  const std::size_t dataStart = this->offset + sizeof(header);
+  if (this->size - dataStart < header.size ||
+      header.type > static_cast<std::uint32_t>(
+        StateSnapshotRecordType::RemovedEntity))
+  {
+    gzerr << "State snapshot has an invalid record [" << this->recordsRead
+          << "]." << std::endl;
+    this->valid = false;
+    return false;
+  }
+
+  _record.entity = header.entity;
+  _record.typeId = header.typeId;
+  _record.type = static_cast<StateSnapshotRecordType>(header.type);
+  _record.data = this->data + dataStart;
+  _record.size = header.size;
+
+  // The padding of the last record may be missing if the snapshot was
+  // trimmed, which is harmless.
+  this->offset = std::min(this->size, dataStart + Padded(header.size));
+  ++this->recordsRead;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool StateSnapshotReader::ReadComponent(const StateSnapshotRecord &_record,
+    const components::ComponentDataOps *_ops,
+    components::BaseComponent *_component)
+{
+  if (_record.type == StateSnapshotRecordType::FlatComponent)
+  {
+    return nullptr != _ops && _ops->FlatSerializable() &&
+        _ops->FlatRead(_component, _record.data, _record.size);
+  }
+
+  if (_record.type == StateSnapshotRecordType::StreamComponent)
+  {
+    if (nullptr != _ops && _ops->DeserializeFrom(_component,
+        reinterpret_cast<const char *>(_record.data), _record.size))
+    {
+      return true;
+    }
+
+    std::istringstream istr(std::string(
+        reinterpret_cast<const char *>(_record.data), _record.size));
+    _component->Deserialize(istr);
+    return true;
+  }
+
+  return false;
+}
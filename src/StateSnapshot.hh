@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_STATESNAPSHOT_HH_
+#define GZ_SIM_STATESNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/sim/components/Component.hh>
+#include <gz/sim/components/Factory.hh>
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \brief Kind of a state snapshot record.
+    enum class StateSnapshotRecordType : std::uint32_t
+    {
+      /// \brief Component data in the component's flat layout.
+      /// \sa components::FlatCodec
+      FlatComponent = 0,
+
+      /// \brief Component data written by the component's Serialize
+      /// function, used for components without a flat layout.
+      StreamComponent = 1,
+
+      /// \brief The component was removed. There is no data.
+      RemovedComponent = 2,
+
+      /// \brief The entity was removed. There is no data.
+      RemovedEntity = 3,
+    };
+
+    /// \brief A record read from a state snapshot. The data points into the
+    /// snapshot buffer.
+    struct StateSnapshotRecord
+    {
+      /// \brief Entity the record belongs to.
+      Entity entity{kNullEntity};
+
+      /// \brief Component type, unset for removed entities.
+      ComponentTypeId typeId{0};
+
+      /// \brief Kind of record.
+      StateSnapshotRecordType type{StateSnapshotRecordType::FlatComponent};
+
+      /// \brief Start of the record's data.
+      const std::uint8_t *data{nullptr};
+
+      /// \brief Size of the record's data in bytes.
+      std::size_t size{0};
+    };
+
+    /// \class StateSnapshotWriter StateSnapshot.hh
+    /// \brief Writes a flat binary state snapshot, an alternative to
+    /// msgs::SerializedStateMap meant to be reused between steps and read in
+    /// place, for example from shared or memory mapped files.
+    ///
+    /// A snapshot is a 24 byte header followed by records. The header holds
+    /// the "GZSS" magic, the format version, a byte order marker, flags and
+    /// the number of records. Each record has a 24 byte header with the
+    /// entity, the component type, the record type and the data size,
+    /// followed by the data padded to 8 bytes. Numbers are stored in host
+    /// byte order, and snapshots written on a host with a different byte
+    /// order are rejected by the reader.
+    ///
+    /// Components whose data type has a flat layout, such as poses,
+    /// velocities and joint positions, are copied without any allocation.
+    /// Other components fall back to their stream serialization.
+    class GZ_SIM_VISIBLE StateSnapshotWriter
+    {
+      /// \brief Constructor. Clears the buffer, keeping its capacity, and
+      /// writes the snapshot header.
+      /// \param[in] _buffer Buffer that receives the snapshot. It must
+      /// outlive the writer.
+      public: explicit StateSnapshotWriter(std::vector<std::uint8_t> &_buffer);
+
+      /// \brief Set whether the component records hold one-time changes, as
+      /// opposed to periodic changes.
+      /// \param[in] _oneTime True for one-time changes.
+      public: void SetOneTimeChanges(bool _oneTime);
+
+      /// \brief Add a record for an entity that was removed.
+      /// \param[in] _entity The entity.
+      public: void AddRemovedEntity(Entity _entity);
+
+      /// \brief Add a record for a component that was removed.
+      /// \param[in] _entity The entity.
+      /// \param[in] _typeId Type of the component.
+      public: void AddRemovedComponent(Entity _entity,
+                  ComponentTypeId _typeId);
+
+      /// \brief Add a record with the data of a component.
+      /// \param[in] _entity The entity.
+      /// \param[in] _component The component.
+      public: void AddComponent(Entity _entity,
+                  const components::BaseComponent *_component);
+
+      /// \brief Add a copy of a record read from another snapshot.
+      /// \param[in] _record The record.
+      public: void CopyRecord(const StateSnapshotRecord &_record);
+
+      /// \brief Number of records added so far.
+      /// \return Number of records.
+      public: std::uint64_t RecordCount() const;
+
+      /// \brief Reserve space for a record and write its header.
+      /// \param[in] _entity The entity.
+      /// \param[in] _typeId Type of the component.
+      /// \param[in] _type Kind of record.
+      /// \param[in] _size Size of the data.
+      /// \return Pointer to the data of the record.
+      private: std::uint8_t *AddRecord(Entity _entity, ComponentTypeId _typeId,
+                   StateSnapshotRecordType _type, std::size_t _size);
+
+      /// \brief Buffer that receives the snapshot.
+      private: std::vector<std::uint8_t> &buffer;
+
+      /// \brief Number of records added.
+      private: std::uint64_t recordCount{0};
+    };
+
+    /// \class StateSnapshotReader StateSnapshot.hh
+    /// \brief Reads the records of a state snapshot in place, without
+    /// copying the data.
+    /// \sa StateSnapshotWriter
+    class GZ_SIM_VISIBLE StateSnapshotReader
+    {
+      /// \brief Constructor. Validates the snapshot header.
+      /// \param[in] _data Start of the snapshot. It must outlive the reader.
+      /// \param[in] _size Size of the snapshot in bytes.
+      public: StateSnapshotReader(const std::uint8_t *_data,
+                  std::size_t _size);
+
+      /// \brief Whether the snapshot is valid. A snapshot becomes invalid if
+      /// its header is wrong, or if a record runs past the end of the data.
+      /// \return True if valid.
+      public: bool Valid() const;
+
+      /// \brief Whether the component records hold one-time changes.
+      /// \return True for one-time changes, false for periodic changes.
+      public: bool OneTimeChanges() const;
+
+      /// \brief Number of records in the snapshot.
+      /// \return Number of records.
+      public: std::uint64_t RecordCount() const;
+
+      /// \brief Read the next record.
+      /// \param[out] _record The record.
+      /// \return False when there are no more records or the snapshot is
+      /// invalid.
+      public: bool Next(StateSnapshotRecord &_record);
+
+      /// \brief Copy the data of a component record into a component.
+      /// \param[in] _record A FlatComponent or StreamComponent record.
+      /// \param[in] _ops Data operations of the component type. May be null,
+      /// in which case FlatComponent records can't be read and
+      /// StreamComponent records are read with streams.
+      /// \param[out] _component The component to update.
+      /// \return True if the data was read.
+      public: static bool ReadComponent(const StateSnapshotRecord &_record,
+                  const components::ComponentDataOps *_ops,
+                  components::BaseComponent *_component);
+
+      /// \brief Start of the snapshot.
+      private: const std::uint8_t *data{nullptr};
+
+      /// \brief Size of the snapshot in bytes.
+      private: std::size_t size{0};
+
+      /// \brief Offset of the next record.
+      private: std::size_t offset{0};
+
+      /// \brief Number of records in the snapshot.
+      private: std::uint64_t recordCount{0};
+
+      /// \brief Number of records read.
+      private: std::uint64_t recordsRead{0};
+
+      /// \brief Snapshot flags.
+      private: std::uint32_t flags{0};
+
+      /// \brief Whether the snapshot is valid.
+      private: bool valid{false};
+    };
+    }
+  }
+}
+#endif
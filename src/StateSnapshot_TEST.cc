@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/sim/components/Factory.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "StateSnapshot.hh"
+
+#include "../test/helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+class StateSnapshotTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(StateSnapshotTest, FlatSerializable)
+{
+  auto factory = components::Factory::Instance();
+
+  auto poseOps = factory->DataOps(components::Pose::typeId);
+  ASSERT_NE(nullptr, poseOps);
+  EXPECT_TRUE(poseOps->FlatSerializable());
+
+  auto jointOps = factory->DataOps(components::JointPosition::typeId);
+  ASSERT_NE(nullptr, jointOps);
+  EXPECT_TRUE(jointOps->FlatSerializable());
+
+  auto nameOps = factory->DataOps(components::Name::typeId);
+  ASSERT_NE(nullptr, nameOps);
+  EXPECT_FALSE(nameOps->FlatSerializable());
+
+  components::Pose pose(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  EXPECT_EQ(7 * sizeof(double), poseOps->FlatSize(&pose));
+
+  components::JointPosition joint({0.5, -0.5});
+  EXPECT_EQ(2 * sizeof(double), jointOps->FlatSize(&joint));
+}
+
+/////////////////////////////////////////////////
+TEST_F(StateSnapshotTest, WriteRead)
+{
+  components::Pose pose(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  components::JointPosition joint({0.5, -0.5, 1.5});
+  components::Name name("some_name");
+
+  std::vector<std::uint8_t> buffer;
+  StateSnapshotWriter writer(buffer);
+  writer.SetOneTimeChanges(true);
+  writer.AddComponent(1, &pose);
+  writer.AddComponent(1, &joint);
+  writer.AddComponent(2, &name);
+  writer.AddRemovedComponent(2, components::Pose::typeId);
+  writer.AddRemovedEntity(3);
+  EXPECT_EQ(5u, writer.RecordCount());
+
+  // Records are 8 byte aligned
+  EXPECT_EQ(0u, buffer.size() % 8);
+
+  StateSnapshotReader reader(buffer.data(), buffer.size());
+  ASSERT_TRUE(reader.Valid());
+  EXPECT_TRUE(reader.OneTimeChanges());
+  EXPECT_EQ(5u, reader.RecordCount());
+
+  auto factory = components::Factory::Instance();
+  StateSnapshotRecord record;
+
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(1u, record.entity);
+  EXPECT_EQ(components::Pose::typeId, record.typeId);
+  EXPECT_EQ(StateSnapshotRecordType::FlatComponent, record.type);
+  components::Pose readPose;
+  EXPECT_TRUE(StateSnapshotReader::ReadComponent(record,
+      factory->DataOps(record.typeId), &readPose));
+  EXPECT_EQ(pose.Data(), readPose.Data());
+
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(StateSnapshotRecordType::FlatComponent, record.type);
+  components::JointPosition readJoint;
+  EXPECT_TRUE(StateSnapshotReader::ReadComponent(record,
+      factory->DataOps(record.typeId), &readJoint));
+  EXPECT_EQ(joint.Data(), readJoint.Data());
+
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(2u, record.entity);
+  EXPECT_EQ(StateSnapshotRecordType::StreamComponent, record.type);
+  components::Name readName;
+  EXPECT_TRUE(StateSnapshotReader::ReadComponent(record,
+      factory->DataOps(record.typeId), &readName));
+  EXPECT_EQ("some_name", readName.Data());
+
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(2u, record.entity);
+  EXPECT_EQ(components::Pose::typeId, record.typeId);
+  EXPECT_EQ(StateSnapshotRecordType::RemovedComponent, record.type);
+  EXPECT_EQ(0u, record.size);
+
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(3u, record.entity);
+  EXPECT_EQ(StateSnapshotRecordType::RemovedEntity, record.type);
+
+  EXPECT_FALSE(reader.Next(record));
+  EXPECT_TRUE(reader.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StateSnapshotTest, ReuseBuffer)
+{
+  components::Pose pose(math::Pose3d(1, 2, 3, 0, 0, 0));
+
+  std::vector<std::uint8_t> buffer;
+  {
+    StateSnapshotWriter writer(buffer);
+    for (Entity e = 0; e < 100; ++e)
+      writer.AddComponent(e, &pose);
+  }
+  const auto *data = buffer.data();
+  const auto size = buffer.size();
+
+  // A new snapshot of the same size doesn't reallocate
+  {
+    StateSnapshotWriter writer(buffer);
+    for (Entity e = 0; e < 100; ++e)
+      writer.AddComponent(e, &pose);
+  }
+  EXPECT_EQ(data, buffer.data());
+  EXPECT_EQ(size, buffer.size());
+
+  StateSnapshotReader reader(buffer.data(), buffer.size());
+  EXPECT_TRUE(reader.Valid());
+  EXPECT_FALSE(reader.OneTimeChanges());
+  EXPECT_EQ(100u, reader.RecordCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StateSnapshotTest, Invalid)
+{
+  EXPECT_FALSE(StateSnapshotReader(nullptr, 0).Valid());
+
+  std::vector<std::uint8_t> garbage(64, 0xAB);
+  EXPECT_FALSE(StateSnapshotReader(garbage.data(), garbage.size()).Valid());
+
+  components::JointPosition joint({0.5, -0.5, 1.5});
+  std::vector<std::uint8_t> buffer;
+  StateSnapshotWriter writer(buffer);
+  writer.AddComponent(1, &joint);
+
+  // Data cut in the middle of the record
+  StateSnapshotReader reader(buffer.data(), buffer.size() - 8);
+  ASSERT_TRUE(reader.Valid());
+  StateSnapshotRecord record;
+  EXPECT_FALSE(reader.Next(record));
+  EXPECT_FALSE(reader.Valid());
+
+  // Flat data of the wrong size is rejected
+  StateSnapshotReader fullReader(buffer.data(), buffer.size());
+  ASSERT_TRUE(fullReader.Next(record));
+  record.size = 7;
+  components::JointPosition readJoint;
+  EXPECT_FALSE(StateSnapshotReader::ReadComponent(record,
+      components::Factory::Instance()->DataOps(record.typeId),
+      &readJoint));
+}
@@ -52,6 +52,9 @@ namespace gz
                 preupdate(systemPlugin->QueryInterface<ISystemPreUpdate>()),
                 update(systemPlugin->QueryInterface<ISystemUpdate>()),
                 postupdate(systemPlugin->QueryInterface<ISystemPostUpdate>()),
+                concurrentConfigure(
+                  systemPlugin->QueryInterface<ISystemConcurrentConfigure>()),
+                serialize(systemPlugin->QueryInterface<ISystemSerialize>()),
                 parentEntity(_entity)
       {
       }
@@ -70,6 +73,9 @@ namespace gz
                 preupdate(dynamic_cast<ISystemPreUpdate *>(_system.get())),
                 update(dynamic_cast<ISystemUpdate *>(_system.get())),
                 postupdate(dynamic_cast<ISystemPostUpdate *>(_system.get())),
+                concurrentConfigure(
+                  dynamic_cast<ISystemConcurrentConfigure *>(_system.get())),
+                serialize(dynamic_cast<ISystemSerialize *>(_system.get())),
                 parentEntity(_entity)
       {
       }
@@ -111,6 +117,15 @@ namespace gz
       /// Will be nullptr if the System doesn't implement this interface.
       public: ISystemPostUpdate *postupdate = nullptr;
 
+      /// \brief Access this system via the ISystemConcurrentConfigure
+      /// interface. Will be nullptr if the System doesn't implement this
+      /// interface.
+      public: ISystemConcurrentConfigure *concurrentConfigure = nullptr;
+
+      /// \brief Access this system via the ISystemSerialize interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemSerialize *serialize = nullptr;
+
       /// \brief Entity that the system is attached to. It's passed to the
       /// system during the `Configure` call.
       public: Entity parentEntity = {kNullEntity};
@@ -127,6 +142,13 @@ namespace gz
       /// Useful for if a system needs to be reconfigured at runtime
       public: std::shared_ptr<const sdf::Element> configureSdf = nullptr;
 
+      /// \brief Whether `Configure` is deferred until the system is
+      /// activated, see ISystemConcurrentConfigure.
+      public: bool configureDeferred{false};
+
+      /// \brief SDF passed to the deferred `Configure` call.
+      public: std::shared_ptr<const sdf::Element> deferredSdf = nullptr;
+
       /// \brief Vector of queries and callbacks
       public: std::vector<EntityQueryCallback> updates;
     };
@@ -15,9 +15,11 @@
  *
 */
 
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <gz/sim/SystemLoader.hh>
@@ -45,6 +47,13 @@ class gz::sim::SystemLoaderPrivate
   //////////////////////////////////////////////////
   public: std::list<std::string> PluginPaths() const
   {
+    // Paths only change with the environment variable or through
+    // AddSystemPluginPath, which clears them
+    std::string pluginPathEnvValue;
+    common::env(this->pluginPathEnv, pluginPathEnvValue);
+    if (this->pluginPaths && pluginPathEnvValue == this->pluginPathEnvValue)
+      return *this->pluginPaths;
+
     common::SystemPaths systemPaths;
     systemPaths.SetPluginPathEnv(pluginPathEnv);
 
@@ -57,7 +66,53 @@ class gz::sim::SystemLoaderPrivate
         homePath, ".gz", "sim", "plugins"));
     systemPaths.AddPluginPaths(gz::sim::getPluginInstallDir());
 
-    return systemPaths.PluginPaths();
+    this->pluginPaths = systemPaths.PluginPaths();
+    this->pluginPathEnvValue = pluginPathEnvValue;
+    return *this->pluginPaths;
+  }
+
+  //////////////////////////////////////////////////
+  public: std::string FindSharedLibrary(const std::string &_filename)
+  {
+    const auto paths = this->PluginPaths();
+    if (paths != this->libraryPathsSearched)
+    {
+      this->libraryPaths.clear();
+      this->libraryPathsSearched = paths;
+    }
+
+    auto iter = this->libraryPaths.find(_filename);
+    if (iter != this->libraryPaths.end())
+      return iter->second;
+
+    common::SystemPaths systemPaths;
+    for (const auto &p : paths)
+    {
+      systemPaths.AddPluginPaths(p);
+    }
+
+    // Libraries that aren't found are searched again, in case they're
+    // installed in the meantime
+    auto pathToLib = systemPaths.FindSharedLibrary(_filename);
+    if (!pathToLib.empty())
+      this->libraryPaths[_filename] = pathToLib;
+    return pathToLib;
+  }
+
+  //////////////////////////////////////////////////
+  public: std::unordered_set<std::string> LoadLib(
+              const std::string &_pathToLib)
+  {
+    // Each library is opened and scanned for plugins once, and its plugins
+    // are then instantiated from the loader's factories
+    auto iter = this->libraryPlugins.find(_pathToLib);
+    if (iter != this->libraryPlugins.end())
+      return iter->second;
+
+    auto pluginNames = this->loader.LoadLib(_pathToLib, true);
+    if (!pluginNames.empty())
+      this->libraryPlugins[_pathToLib] = pluginNames;
+    return pluginNames;
   }
 
   //////////////////////////////////////////////////
@@ -76,14 +131,7 @@ class gz::sim::SystemLoaderPrivate
              << "]. Using [" << filename << "] instead." << std::endl;
     }
 
-    std::list<std::string> paths = this->PluginPaths();
-    common::SystemPaths systemPaths;
-    for (const auto &p : paths)
-    {
-      systemPaths.AddPluginPaths(p);
-    }
-
-    auto pathToLib = systemPaths.FindSharedLibrary(filename);
+    auto pathToLib = this->FindSharedLibrary(filename);
     if (pathToLib.empty())
     {
       // We assume gz::sim corresponds to the levels feature
@@ -95,7 +143,7 @@ class gz::sim::SystemLoaderPrivate
       return false;
     }
 
-    auto pluginNames = this->loader.LoadLib(pathToLib, true);
+    auto pluginNames = this->LoadLib(pathToLib);
     if (pluginNames.empty())
     {
       std::stringstream ss;
@@ -207,6 +255,27 @@ class gz::sim::SystemLoaderPrivate
 
   /// \brief Paths to search for system plugins.
   public: std::unordered_set<std::string> systemPluginPaths;
+
+  /// \brief Plugin paths computed last, see PluginPaths.
+  public: mutable std::optional<std::list<std::string>> pluginPaths;
+
+  /// \brief Value of the plugin path environment variable when pluginPaths
+  /// was computed.
+  public: mutable std::string pluginPathEnvValue;
+
+  /// \brief Path of each library filename found in libraryPathsSearched.
+  public: std::unordered_map<std::string, std::string> libraryPaths;
+
+  /// \brief Plugin paths that libraryPaths were found in.
+  public: std::list<std::string> libraryPathsSearched;
+
+  /// \brief Names of the plugins of each loaded library, by library path.
+  public: std::unordered_map<std::string, std::unordered_set<std::string>>
+              libraryPlugins;
+
+  /// \brief Protects the members above, since a loader is shared by all
+  /// the worlds of a server, and plugins can be loaded from service threads.
+  public: mutable std::mutex mutex;
 };
 
 //////////////////////////////////////////////////
@@ -221,13 +290,16 @@ SystemLoader::~SystemLoader() = default;
 //////////////////////////////////////////////////
 std::list<std::string> SystemLoader::PluginPaths() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->PluginPaths();
 }
 
 //////////////////////////////////////////////////
 void SystemLoader::AddSystemPluginPath(const std::string &_path)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->systemPluginPaths.insert(_path);
+  this->dataPtr->pluginPaths.reset();
 }
 
 //////////////////////////////////////////////////
@@ -241,6 +313,7 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
     return {};
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   gz::plugin::PluginPtr plugin;
   auto ret = this->dataPtr->InstantiateSystemPlugin(_plugin, plugin);
   if (ret && plugin)
@@ -252,5 +325,6 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
 //////////////////////////////////////////////////
 std::string SystemLoader::PrettyStr() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->loader.PrettyStr();
 }
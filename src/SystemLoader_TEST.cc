@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
@@ -104,6 +108,57 @@ TEST(SystemLoader, FromPluginPathEnv)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(SystemLoader, LoadSameLibraryTwice)
+{
+  sdf::Plugin plugin("MockSystem", "gz::sim::MockSystem");
+
+  gz::sim::SystemLoader sm;
+  sm.AddSystemPluginPath(common::joinPaths(PROJECT_BINARY_PATH, kPluginDir));
+
+  // The library is only opened once, but each plugin is a new instance
+  auto first = sm.LoadPlugin(plugin);
+  auto second = sm.LoadPlugin(plugin);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_NE(first.value(), second.value());
+  EXPECT_NE(first.value()->QueryInterface<System>(),
+      second.value()->QueryInterface<System>());
+
+  // Adding a path searches the library again
+  sm.AddSystemPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+  EXPECT_TRUE(sm.LoadPlugin(plugin).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(SystemLoader, LoadFromThreads)
+{
+  sdf::Plugin plugin("MockSystem", "gz::sim::MockSystem");
+
+  gz::sim::SystemLoader sm;
+  sm.AddSystemPluginPath(common::joinPaths(PROJECT_BINARY_PATH, kPluginDir));
+
+  // A loader shared by several worlds is used from their threads at once
+  std::atomic<int> loadedCount{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      for (int j = 0; j < 10; ++j)
+      {
+        if (sm.LoadPlugin(plugin).has_value())
+          ++loadedCount;
+        sm.PluginPaths();
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(40, loadedCount);
+}
+
 /////////////////////////////////////////////////
 TEST(SystemLoader, EmptyNames)
 {
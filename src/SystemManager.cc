@@ -15,18 +15,50 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <map>
+#include <optional>
 #include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
 
+#include <gz/common/Profiler.hh>
 #include <gz/common/StringUtils.hh>
 
 #include "gz/sim/components/SystemPluginInfo.hh"
+#include "gz/sim/components/World.hh"
 #include "gz/sim/Conversions.hh"
+#include "StartupTimeline.hh"
 #include "SystemManager.hh"
+#include "ThreadPool.hh"
 
 using namespace gz;
 using namespace sim;
 
+namespace
+{
+/// \brief Index marking a removed system when renumbering systems.
+constexpr std::size_t kRemovedSystem{std::numeric_limits<std::size_t>::max()};
+
+/// \brief Phases that can be profiled, used to index profiler entries.
+enum ProfiledPhase : std::size_t
+{
+  kPreUpdatePhase = 0,
+  kUpdatePhase,
+  kPostUpdatePhase,
+  kPhaseCount
+};
+
+/// \brief Names of the profiled phases.
+const char *const kPhaseNames[kPhaseCount] =
+    {"PreUpdate", "Update", "PostUpdate"};
+}
+
 //////////////////////////////////////////////////
 SystemManager::SystemManager(
   const SystemLoaderPtr &_systemLoader,
@@ -57,23 +89,24 @@ SystemManager::SystemManager(
 void SystemManager::LoadPlugin(const Entity _entity,
                                const sdf::Plugin &_plugin)
 {
-  std::optional<SystemPluginPtr> system;
-  {
-    std::lock_guard<std::mutex> lock(this->systemLoaderMutex);
-    system = this->systemLoader->LoadPlugin(_plugin);
-  }
+  auto system = this->systemLoader->LoadPlugin(_plugin);
 
   // System correctly loaded from library
   if (system)
-  {
-    SystemInternal ss(system.value(), _entity);
-    ss.fname = _plugin.Filename();
-    ss.name = _plugin.Name();
-    ss.configureSdf = _plugin.ToElement();
-    this->AddSystemImpl(ss, ss.configureSdf);
-    gzdbg << "Loaded system [" << _plugin.Name()
-           << "] for entity [" << _entity << "]" << std::endl;
-  }
+    this->AddLoadedSystem(_entity, _plugin, system.value());
+}
+
+//////////////////////////////////////////////////
+void SystemManager::AddLoadedSystem(const Entity _entity,
+    const sdf::Plugin &_plugin, const SystemPluginPtr &_system)
+{
+  SystemInternal ss(_system, _entity);
+  ss.fname = _plugin.Filename();
+  ss.name = _plugin.Name();
+  ss.configureSdf = _plugin.ToElement();
+  this->AddSystemImpl(ss, ss.configureSdf);
+  gzdbg << "Loaded system [" << _plugin.Name()
+         << "] for entity [" << _entity << "]" << std::endl;
 }
 
 //////////////////////////////////////////////////
@@ -98,35 +131,182 @@ size_t SystemManager::PendingCount() const
 //////////////////////////////////////////////////
 size_t SystemManager::ActivatePendingSystems()
 {
+  this->ConfigureDeferredSystems();
+
   std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
 
   auto count = this->pendingSystems.size();
+  const auto first = this->systems.size();
 
   for (const auto& system : this->pendingSystems)
   {
     this->systems.push_back(system);
+    this->AddInterfaces(system);
+  }
+
+  this->pendingSystems.clear();
+
+  // Only the new systems are indexed, so adding systems while simulating,
+  // for example when spawning models, doesn't depend on how many systems
+  // are already running
+  if (count > 0)
+    this->IndexSystems(first);
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+void SystemManager::AddInterfaces(const SystemInternal &_system)
+{
+  if (_system.configure)
+    this->systemsConfigure.push_back(_system.configure);
+
+  if (_system.configureParameters)
+    this->systemsConfigureParameters.push_back(_system.configureParameters);
 
-    if (system.configure)
-      this->systemsConfigure.push_back(system.configure);
+  if (_system.reset)
+    this->systemsReset.push_back(_system.reset);
 
-    if (system.configureParameters)
-      this->systemsConfigureParameters.push_back(system.configureParameters);
+  if (_system.preupdate)
+    this->systemsPreupdate.push_back(_system.preupdate);
 
-    if (system.reset)
-      this->systemsReset.push_back(system.reset);
+  if (_system.update)
+    this->systemsUpdate.push_back(_system.update);
+
+  if (_system.postupdate)
+    this->systemsPostupdate.push_back(_system.postupdate);
+}
+
+//////////////////////////////////////////////////
+void SystemManager::IndexSystems(std::size_t _first)
+{
+  if (0u == _first)
+  {
+    this->preupdateSystems.clear();
+    this->updateSystems.clear();
+    this->postupdateSystems.clear();
+    this->systemLabels.clear();
+  }
+
+  for (std::size_t i = _first; i < this->systems.size(); ++i)
+  {
+    const auto &system = this->systems[i];
+    this->systemLabels.push_back(system.name.empty() ?
+        "System " + std::to_string(i) : system.name);
 
     if (system.preupdate)
-      this->systemsPreupdate.push_back(system.preupdate);
+      this->preupdateSystems.push_back(i);
 
     if (system.update)
-      this->systemsUpdate.push_back(system.update);
+      this->updateSystems.push_back(i);
 
     if (system.postupdate)
-      this->systemsPostupdate.push_back(system.postupdate);
+      this->postupdateSystems.push_back(i);
   }
 
-  this->pendingSystems.clear();
-  return count;
+  this->SetProfilerEntries(_first);
+}
+
+//////////////////////////////////////////////////
+void SystemManager::SetProfilerEntries(std::size_t _first)
+{
+  if (!this->profiler)
+    return;
+
+  for (std::size_t i = _first; i < this->systems.size(); ++i)
+  {
+    for (std::size_t phase = 0; phase < kPhaseCount; ++phase)
+    {
+      this->profiler->SetEntry(i * kPhaseCount + phase,
+          this->systemLabels[i], kPhaseNames[phase]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+template <typename CallT>
+void SystemManager::Call(std::size_t _index, std::size_t _phase,
+    const CallT &_call)
+{
+  GZ_PROFILE_BEGIN(this->systemLabels[_index].c_str());
+  if (nullptr == this->profiler)
+  {
+    _call();
+  }
+  else
+  {
+    const auto start = std::chrono::steady_clock::now();
+    _call();
+    this->profiler->Record(_index * kPhaseCount + _phase,
+        std::chrono::steady_clock::now() - start);
+  }
+  GZ_PROFILE_END();
+}
+
+//////////////////////////////////////////////////
+void SystemManager::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  for (auto index : this->preupdateSystems)
+  {
+    this->Call(index, kPreUpdatePhase, [&]
+    {
+      this->systems[index].preupdate->PreUpdate(_info, _ecm);
+    });
+  }
+}
+
+//////////////////////////////////////////////////
+void SystemManager::Update(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  for (auto index : this->updateSystems)
+  {
+    this->Call(index, kUpdatePhase, [&]
+    {
+      this->systems[index].update->Update(_info, _ecm);
+    });
+  }
+}
+
+//////////////////////////////////////////////////
+void SystemManager::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm, ThreadPool &_pool)
+{
+  _pool.ParallelFor(this->postupdateSystems.size(), 1,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const std::size_t index = this->postupdateSystems[i];
+          this->Call(index, kPostUpdatePhase, [&]
+          {
+            this->systems[index].postupdate->PostUpdate(_info, _ecm);
+          });
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+void SystemManager::SetProfiling(bool _enabled)
+{
+  if (!_enabled)
+  {
+    this->profiler.reset();
+    return;
+  }
+
+  if (this->profiler)
+    return;
+
+  this->profiler = std::make_unique<SystemProfiler>();
+  this->SetProfilerEntries(0u);
+}
+
+//////////////////////////////////////////////////
+const SystemProfiler *SystemManager::Profiler() const
+{
+  return this->profiler.get();
 }
 
 //////////////////////////////////////////////////
@@ -142,7 +322,17 @@ struct PluginInfo {
   sdf::ElementPtr sdf;
 };
 
-//////////////////////////////////////////////////
+///////////////////////////////////////////////////
+bool SystemManager::ResetReloadsSystems() const
+{
+  return std::any_of(this->systems.begin(), this->systems.end(),
+      [](const SystemInternal &_system)
+      {
+        return nullptr == _system.reset && nullptr == _system.systemShared;
+      });
+}
+
+/////////////////////////////////////////////////
 void SystemManager::Reset(const UpdateInfo &_info, EntityComponentManager &_ecm)
 {
   {
@@ -156,6 +346,12 @@ void SystemManager::Reset(const UpdateInfo &_info, EntityComponentManager &_ecm)
   this->systemsPreupdate.clear();
   this->systemsUpdate.clear();
   this->systemsPostupdate.clear();
+  this->preupdateSystems.clear();
+  this->updateSystems.clear();
+  this->postupdateSystems.clear();
+  this->systemLabels.clear();
+  if (this->profiler)
+    this->profiler->Clear();
 
   std::vector<PluginInfo> pluginsToBeLoaded;
 
@@ -225,6 +421,80 @@ void SystemManager::AddSystem(
   this->AddSystemImpl(SystemInternal(_system, _entity), _sdf);
 }
 
+//////////////////////////////////////////////////
+void SystemManager::ConfigureSystem(SystemInternal &_system,
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  // Configure the system, if necessary
+  if (_system.configure && this->entityCompMgr && this->eventMgr)
+  {
+    StartupTimeline::Scope configureScope("Configure " +
+        (_system.name.empty() ? std::string("system") : _system.name),
+        "systems");
+    _system.configure->Configure(_system.parentEntity, _sdf,
+                                 *this->entityCompMgr,
+                                 *this->eventMgr);
+  }
+
+  // Configure the system parameters, if necessary
+  if (
+    _system.configureParameters && this->entityCompMgr &&
+    this->parametersRegistry)
+  {
+    _system.configureParameters->ConfigureParameters(
+      *this->parametersRegistry,
+      *this->entityCompMgr);
+  }
+}
+
+//////////////////////////////////////////////////
+void SystemManager::ConfigureDeferredSystems()
+{
+  std::vector<SystemInternal> systems;
+  {
+    std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+    if (std::none_of(this->pendingSystems.begin(), this->pendingSystems.end(),
+        [](const SystemInternal &_system)
+        {
+          return _system.configureDeferred;
+        }))
+    {
+      return;
+    }
+    systems.swap(this->pendingSystems);
+  }
+
+  std::vector<SystemInternal *> deferred;
+  for (auto &system : systems)
+  {
+    if (system.configureDeferred)
+      deferred.push_back(&system);
+  }
+
+  // Views are updated beforehand, so that the systems only read them
+  this->entityCompMgr->AddPendingEntitiesToViews();
+  this->entityCompMgr->LockAddingEntitiesToViews(true);
+  ThreadPool::Shared().ParallelFor(deferred.size(), 1,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          auto &system = *deferred[i];
+          this->ConfigureSystem(system, system.deferredSdf);
+          system.configureDeferred = false;
+          system.deferredSdf.reset();
+        }
+      });
+  this->entityCompMgr->LockAddingEntitiesToViews(false);
+
+  // Systems keep the order in which they were added
+  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+  systems.insert(systems.end(),
+      std::make_move_iterator(this->pendingSystems.begin()),
+      std::make_move_iterator(this->pendingSystems.end()));
+  this->pendingSystems.swap(systems);
+}
+
 //////////////////////////////////////////////////
 void SystemManager::AddSystemImpl(
       SystemInternal _system,
@@ -253,22 +523,17 @@ void SystemManager::AddSystemImpl(
         components::SystemPluginInfo::typeId);
   }
 
-  // Configure the system, if necessary
-  if (_system.configure && this->entityCompMgr && this->eventMgr)
+  // Systems that can be configured concurrently are configured together,
+  // when they're activated
+  if (nullptr != _system.concurrentConfigure && this->entityCompMgr &&
+      _system.concurrentConfigure->ConcurrentConfigure())
   {
-    _system.configure->Configure(_system.parentEntity, _sdf,
-                                 *this->entityCompMgr,
-                                 *this->eventMgr);
+    _system.configureDeferred = true;
+    _system.deferredSdf = _sdf;
   }
-
-  // Configure the system parameters, if necessary
-  if (
-    _system.configureParameters && this->entityCompMgr &&
-    this->parametersRegistry)
+  else
   {
-    _system.configureParameters->ConfigureParameters(
-      *this->parametersRegistry,
-      *this->entityCompMgr);
+    this->ConfigureSystem(_system, _sdf);
   }
 
   // Update callbacks will be handled later, add to queue
@@ -328,12 +593,96 @@ std::vector<SystemInternal> SystemManager::TotalByEntity(Entity _entity)
   return result;
 }
 
+//////////////////////////////////////////////////
+std::vector<CheckpointSystemState> SystemManager::SerializeSystems() const
+{
+  std::vector<CheckpointSystemState> states;
+  for (const auto &system : this->systems)
+  {
+    if (nullptr == system.serialize)
+      continue;
+
+    std::ostringstream stream(std::ios::binary);
+    if (!system.serialize->SerializeState(stream))
+    {
+      gzwarn << "Failed to serialize the state of system [" << system.name
+             << "] attached to entity [" << system.parentEntity
+             << "], it won't be restored." << std::endl;
+      continue;
+    }
+    states.push_back({system.parentEntity, system.name, stream.str()});
+  }
+  return states;
+}
+
+//////////////////////////////////////////////////
+std::size_t SystemManager::DeserializeSystems(
+    const std::vector<CheckpointSystemState> &_states)
+{
+  // Systems sharing an entity and a name are matched in load order
+  using Key = std::pair<Entity, std::string>;
+  std::map<Key, std::vector<const CheckpointSystemState *>> saved;
+  for (const auto &state : _states)
+    saved[{state.parentEntity, state.name}].push_back(&state);
+
+  std::map<Key, std::size_t> occurrences;
+  std::size_t restored{0u};
+  for (const auto &system : this->systems)
+  {
+    if (nullptr == system.serialize)
+      continue;
+
+    const Key key{system.parentEntity, system.name};
+    const auto index = occurrences[key]++;
+    auto it = saved.find(key);
+    if (it == saved.end() || index >= it->second.size())
+    {
+      gzwarn << "No saved state for system [" << system.name
+             << "] attached to entity [" << system.parentEntity << "]."
+             << std::endl;
+      continue;
+    }
+
+    std::istringstream stream(it->second[index]->data, std::ios::binary);
+    if (!system.serialize->DeserializeState(stream))
+    {
+      gzerr << "Failed to restore the state of system [" << system.name
+            << "] attached to entity [" << system.parentEntity << "]."
+            << std::endl;
+      continue;
+    }
+    ++restored;
+  }
+  return restored;
+}
+
 //////////////////////////////////////////////////
 bool SystemManager::EntitySystemAddService(const msgs::EntityPlugin_V &_req,
                                            msgs::Boolean &_res)
 {
+  // The libraries are loaded here, outside of the simulation thread, so
+  // that only configuring the systems is left for the next step
+  Entity entity = _req.entity().id();
+  if (_req.plugins().empty())
+  {
+    gzwarn << "Unable to add plugins to Entity: '" << entity
+           << "'. No plugins specified." << std::endl;
+  }
+
+  std::vector<LoadedPlugin> loaded;
+  for (auto &pluginMsg : _req.plugins())
+  {
+    sdf::Plugin pluginSDF(pluginMsg.filename(), pluginMsg.name(),
+        pluginMsg.innerxml());
+    auto system = this->systemLoader->LoadPlugin(pluginSDF);
+    if (system)
+      loaded.push_back({entity, std::move(pluginSDF), system.value()});
+  }
+
   std::lock_guard<std::mutex> lock(this->systemsMsgMutex);
-  this->systemsToAdd.push_back(_req);
+  this->systemsToAdd.insert(this->systemsToAdd.end(),
+      std::make_move_iterator(loaded.begin()),
+      std::make_move_iterator(loaded.end()));
   _res.set_data(true);
   return true;
 }
@@ -386,26 +735,87 @@ bool SystemManager::EntitySystemInfoService(const msgs::Empty &,
 //////////////////////////////////////////////////
 void SystemManager::ProcessPendingEntitySystems()
 {
-  std::lock_guard<std::mutex> lock(this->systemsMsgMutex);
-  for (auto &req : this->systemsToAdd)
+  std::vector<LoadedPlugin> systemsToAdd;
   {
-    Entity entity = req.entity().id();
+    std::lock_guard<std::mutex> lock(this->systemsMsgMutex);
+    systemsToAdd.swap(this->systemsToAdd);
+  }
+
+  for (const auto &loaded : systemsToAdd)
+    this->AddLoadedSystem(loaded.entity, loaded.plugin, loaded.system);
+}
+
+//////////////////////////////////////////////////
+std::size_t SystemManager::ProcessRemovedEntities(
+    const EntityComponentManager &_ecm)
+{
+  auto removed = [&_ecm](const SystemInternal &_system)
+  {
+    return kNullEntity != _system.parentEntity &&
+        _ecm.IsMarkedForRemoval(_system.parentEntity) &&
+        nullptr == _ecm.Component<components::World>(_system.parentEntity);
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+    this->pendingSystems.erase(std::remove_if(this->pendingSystems.begin(),
+        this->pendingSystems.end(), removed), this->pendingSystems.end());
+  }
+
+  if (std::none_of(this->systems.begin(), this->systems.end(), removed))
+    return 0u;
 
-    if (req.plugins().empty())
+  std::vector<std::size_t> remap(this->systems.size(), kRemovedSystem);
+  std::vector<SystemInternal> kept;
+  kept.reserve(this->systems.size());
+  std::vector<std::string> labels;
+  labels.reserve(this->systems.size());
+  for (std::size_t i = 0; i < this->systems.size(); ++i)
+  {
+    if (removed(this->systems[i]))
     {
-      gzwarn << "Unable to add plugins to Entity: '" << entity
-             << "'. No plugins specified." << std::endl;
-       continue;
+      gzdbg << "Removing system [" << this->systems[i].name
+            << "] of removed entity [" << this->systems[i].parentEntity
+            << "]" << std::endl;
+      continue;
     }
+    remap[i] = kept.size();
+    kept.push_back(std::move(this->systems[i]));
+    labels.push_back(std::move(this->systemLabels[i]));
+  }
+  const auto count = this->systems.size() - kept.size();
+  this->systems.swap(kept);
+  this->systemLabels.swap(labels);
+
+  this->systemsConfigure.clear();
+  this->systemsConfigureParameters.clear();
+  this->systemsReset.clear();
+  this->systemsPreupdate.clear();
+  this->systemsUpdate.clear();
+  this->systemsPostupdate.clear();
+  for (const auto &system : this->systems)
+    this->AddInterfaces(system);
 
-    for (auto &pluginMsg : req.plugins())
+  auto renumber = [&remap](std::vector<std::size_t> &_indices)
+  {
+    std::vector<std::size_t> kept;
+    for (auto index : _indices)
     {
-      std::string fname = pluginMsg.filename();
-      std::string name = pluginMsg.name();
-      std::string innerxml = pluginMsg.innerxml();
-      sdf::Plugin pluginSDF(fname, name, innerxml);
-      this->LoadPlugin(entity, pluginSDF);
+      if (remap[index] != kRemovedSystem)
+        kept.push_back(remap[index]);
     }
+    _indices.swap(kept);
+  };
+  renumber(this->preupdateSystems);
+  renumber(this->updateSystems);
+  renumber(this->postupdateSystems);
+
+  // Profiler entries are indexed by system, so the timings restart
+  if (this->profiler)
+  {
+    this->profiler->Clear();
+    this->SetProfilerEntries(0u);
   }
-  this->systemsToAdd.clear();
+
+  return count;
 }
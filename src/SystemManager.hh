@@ -32,7 +32,10 @@
 #include "gz/sim/SystemLoader.hh"
 #include "gz/sim/Types.hh"
 
+#include "Checkpoint.hh"
 #include "SystemInternal.hh"
+#include "SystemProfiler.hh"
+#include "ThreadPool.hh"
 
 namespace gz
 {
@@ -94,7 +97,9 @@ namespace gz
       /// \return The count.
       public: size_t TotalCount() const;
 
-      /// \brief Move all "pending" systems to "active" state
+      /// \brief Move all "pending" systems to "active" state. Pending
+      /// systems that implement ISystemConcurrentConfigure are configured
+      /// concurrently first.
       /// \return The number of newly-active systems
       public: size_t ActivatePendingSystems();
 
@@ -112,6 +117,12 @@ namespace gz
       /// \param[in] _ecm Version of the ECM reset to an initial state
       public: void Reset(const UpdateInfo &_info, EntityComponentManager &_ecm);
 
+      /// \brief Whether Reset reloads any plugin, because it doesn't
+      /// implement the ISystemReset interface. Reloaded systems expect all
+      /// entities to be new again.
+      /// \return True if some system will be reloaded.
+      public: bool ResetReloadsSystems() const;
+
       /// \brief Get a vector of all systems implementing "Configure"
       /// \return Vector of systems' configure interfaces.
       public: const std::vector<ISystemConfigure *>& SystemsConfigure();
@@ -138,13 +149,70 @@ namespace gz
       /// \return Vector of systems's post-update interfaces.
       public: const std::vector<ISystemPostUpdate *>& SystemsPostUpdate();
 
+      /// \brief Call PreUpdate on all active systems, in the order in which
+      /// they were added.
+      /// \param[in] _info Update info
+      /// \param[in] _ecm Entity component manager passed to the systems
+      public: void PreUpdate(const UpdateInfo &_info,
+                             EntityComponentManager &_ecm);
+
+      /// \brief Call Update on all active systems, in the order in which
+      /// they were added.
+      /// \param[in] _info Update info
+      /// \param[in] _ecm Entity component manager passed to the systems
+      public: void Update(const UpdateInfo &_info,
+                          EntityComponentManager &_ecm);
+
+      /// \brief Call PostUpdate on all active systems, concurrently.
+      /// \param[in] _info Update info
+      /// \param[in] _ecm Entity component manager passed to the systems
+      /// \param[in] _pool Pool whose threads run the systems, along with the
+      /// calling thread.
+      public: void PostUpdate(const UpdateInfo &_info,
+                              const EntityComponentManager &_ecm,
+                              ThreadPool &_pool);
+
+      /// \brief Enable or disable timing the PreUpdate, Update and PostUpdate
+      /// calls of each system. When disabled, which is the default, calls
+      /// aren't timed at all.
+      /// \param[in] _enabled True to enable.
+      public: void SetProfiling(bool _enabled);
+
+      /// \brief Get the timings of the system calls.
+      /// \return The profiler, or nullptr if profiling is disabled.
+      public: const SystemProfiler *Profiler() const;
+
       /// \brief Get an vector of all systems attached to a given entity.
       /// \return Vector of systems.
       public: std::vector<SystemInternal> TotalByEntity(Entity _entity);
 
-      /// \brief Process system messages and add systems to entities
+      /// \brief Get the state of the active systems that implement
+      /// ISystemSerialize, for a checkpoint.
+      /// \return State of the systems, in the order they were loaded.
+      public: std::vector<CheckpointSystemState> SerializeSystems() const;
+
+      /// \brief Restore the state of the active systems from a checkpoint.
+      /// Systems are matched to the saved state by parent entity, plugin
+      /// name and, for systems sharing both, load order.
+      /// \param[in] _states State of the systems.
+      /// \return Number of systems restored.
+      public: std::size_t DeserializeSystems(
+                  const std::vector<CheckpointSystemState> &_states);
+
+      /// \brief Process system messages and add systems to entities. The
+      /// plugins were already loaded when the messages were received, so
+      /// this only configures the systems.
       public: void ProcessPendingEntitySystems();
 
+      /// \brief Remove the systems attached to entities that are about to
+      /// be removed, without indexing the other systems again.
+      /// Systems attached to worlds are kept. This must be called between
+      /// steps, before the entities are removed from the ECM.
+      /// \param[in] _ecm ECM with the entities marked for removal.
+      /// \return Number of systems removed.
+      public: std::size_t ProcessRemovedEntities(
+                  const EntityComponentManager &_ecm);
+
       /// \brief Implementation for AddSystem functions that takes an SDF
       /// element. This calls the AddSystemImpl that accepts an SDF Plugin.
       /// \param[in] _system Generic representation of a system.
@@ -160,6 +228,48 @@ namespace gz
       private: void AddSystemImpl(SystemInternal _system,
                                   const sdf::Plugin &_sdf);
 
+      /// \brief Add a system loaded from a plugin.
+      /// \param[in] _entity Entity the system is attached to.
+      /// \param[in] _plugin Plugin the system was loaded from.
+      /// \param[in] _system The loaded system.
+      private: void AddLoadedSystem(const Entity _entity,
+                  const sdf::Plugin &_plugin, const SystemPluginPtr &_system);
+
+      /// \brief Add the interfaces of an active system to the lists of
+      /// systems implementing them.
+      /// \param[in] _system The system.
+      private: void AddInterfaces(const SystemInternal &_system);
+
+      /// \brief Call Configure and ConfigureParameters on a system.
+      /// \param[in] _system The system.
+      /// \param[in] _sdf SDF passed to Configure.
+      private: void ConfigureSystem(SystemInternal &_system,
+                  const std::shared_ptr<const sdf::Element> &_sdf);
+
+      /// \brief Configure the pending systems whose configuration was
+      /// deferred, concurrently.
+      private: void ConfigureDeferredSystems();
+
+      /// \brief Add the active systems to the lists of systems run in each
+      /// phase and name them for the profiler.
+      /// \param[in] _first Index of the first system to add. Zero rebuilds
+      /// all lists.
+      private: void IndexSystems(std::size_t _first);
+
+      /// \brief Name the profiler entries of systems, if profiling.
+      /// \param[in] _first Index of the first system to name.
+      private: void SetProfilerEntries(std::size_t _first);
+
+      /// \brief Call one phase of a system. The call shows up in the
+      /// profiler traces under the name of the system, and is timed if
+      /// profiling is enabled.
+      /// \param[in] _index Index of the system in systems.
+      /// \param[in] _phase Index of the phase.
+      /// \param[in] _call Function that calls the system.
+      private: template <typename CallT>
+               void Call(std::size_t _index, std::size_t _phase,
+                         const CallT &_call);
+
       /// \brief Callback for entity add system service.
       /// \param[in] _req Request message containing the entity id and plugins
       /// to add to that entity
@@ -205,20 +315,48 @@ namespace gz
       /// \brief Systems implementing PostUpdate
       private: std::vector<ISystemPostUpdate *> systemsPostupdate;
 
+      /// \brief Indices in systems of the systems implementing PreUpdate.
+      private: std::vector<std::size_t> preupdateSystems;
+
+      /// \brief Indices in systems of the systems implementing Update.
+      private: std::vector<std::size_t> updateSystems;
+
+      /// \brief Indices in systems of the systems implementing PostUpdate.
+      private: std::vector<std::size_t> postupdateSystems;
+
+      /// \brief Names of the systems used in profiler traces, by index in
+      /// systems.
+      private: std::vector<std::string> systemLabels;
+
+      /// \brief Timings of the system calls, null when profiling is
+      /// disabled.
+      private: std::unique_ptr<SystemProfiler> profiler;
+
       /// \brief System loader, for loading system plugins.
       private: SystemLoaderPtr systemLoader;
 
-      /// \brief Mutex to protect systemLoader
-      private: std::mutex systemLoaderMutex;
-
       /// \brief Pointer to associated entity component manager
       private: EntityComponentManager *entityCompMgr;
 
       /// \brief Pointer to associated event manager
       private: EventManager *eventMgr;
 
-      /// \brief A list of entity systems to add
-      private: std::vector<msgs::EntityPlugin_V> systemsToAdd;
+      /// \brief A plugin requested through the entity add system service,
+      /// loaded by the service.
+      private: struct LoadedPlugin
+               {
+                 /// \brief Entity to attach the system to.
+                 Entity entity{kNullEntity};
+
+                 /// \brief The plugin.
+                 sdf::Plugin plugin;
+
+                 /// \brief System loaded from the plugin.
+                 SystemPluginPtr system;
+               };
+
+      /// \brief Systems to add, loaded by the entity add system service
+      private: std::vector<LoadedPlugin> systemsToAdd;
 
       /// \brief Mutex to protect systemsToAdd list
       private: std::mutex systemsMsgMutex;
@@ -17,14 +17,22 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/System.hh"
 #include "gz/sim/SystemLoader.hh"
 #include "gz/sim/Types.hh"
 #include "gz/sim/components/SystemPluginInfo.hh"
+#include "gz/sim/components/World.hh"
 #include "test_config.hh"  // NOLINT(build/include)
 
 #include "SystemManager.hh"
+#include "ThreadPool.hh"
 
 using namespace gz::sim;
 
@@ -49,6 +57,26 @@ class SystemWithConfigure:
   public: int configuredParameters = 0;
 };
 
+/////////////////////////////////////////////////
+class SystemWithConcurrentConfigure:
+  public System,
+  public ISystemConfigure,
+  public ISystemConcurrentConfigure
+{
+  // Documentation inherited
+  public: void Configure(
+                const Entity &,
+                const std::shared_ptr<const sdf::Element> &,
+                EntityComponentManager &,
+                EventManager &) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    configured++;
+  }
+
+  public: std::atomic<int> configured{0};
+};
+
 /////////////////////////////////////////////////
 class SystemWithUpdates:
   public System,
@@ -69,6 +97,46 @@ class SystemWithUpdates:
                 const EntityComponentManager &) override {};
 };
 
+/////////////////////////////////////////////////
+/// \brief Records what the systems of a test do during PreUpdate.
+struct PreUpdateLog
+{
+  /// \brief Names of the systems, in the order their PreUpdate started.
+  std::vector<std::string> order;
+
+  /// \brief Number of systems currently inside PreUpdate.
+  std::atomic<int> running{0};
+
+  /// \brief Largest value reached by running.
+  std::atomic<int> maxRunning{0};
+};
+
+/////////////////////////////////////////////////
+class SystemWithName:
+  public System,
+  public ISystemPreUpdate
+{
+  public: SystemWithName(const std::string &_name, PreUpdateLog &_log)
+          : name(_name), log(_log) {}
+
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &,
+                EntityComponentManager &) override
+  {
+    int running = ++this->log.running;
+    this->log.order.push_back(this->name);
+    if (running > this->log.maxRunning)
+      this->log.maxRunning = running;
+    --this->log.running;
+  }
+
+  /// \brief Name recorded in the log.
+  public: std::string name;
+
+  /// \brief Log shared by the systems of a test.
+  public: PreUpdateLog &log;
+};
+
 /////////////////////////////////////////////////
 TEST(SystemManager, Constructor)
 {
@@ -270,3 +338,169 @@ TEST(SystemManager, AddSystemWithInfo)
       });
   EXPECT_EQ(1, entityCount);
 }
+
+/////////////////////////////////////////////////
+TEST(SystemManager, ConcurrentConfigure)
+{
+  auto loader = std::make_shared<SystemLoader>();
+
+  EntityComponentManager ecm;
+  auto eventManager = EventManager();
+  SystemManager systemMgr(loader, &ecm, &eventManager);
+
+  std::vector<std::shared_ptr<SystemWithConcurrentConfigure>> systems;
+  for (int i = 0; i < 4; ++i)
+  {
+    systems.push_back(std::make_shared<SystemWithConcurrentConfigure>());
+    systemMgr.AddSystem(systems.back(), kNullEntity, nullptr);
+  }
+  auto serialSystem = std::make_shared<SystemWithConfigure>();
+  systemMgr.AddSystem(serialSystem, kNullEntity, nullptr);
+
+  // Only the system that isn't thread-safe is configured right away
+  for (const auto &system : systems)
+    EXPECT_EQ(0, system->configured);
+  EXPECT_EQ(1, serialSystem->configured);
+  EXPECT_EQ(5u, systemMgr.PendingCount());
+
+  systemMgr.ActivatePendingSystems();
+  for (const auto &system : systems)
+    EXPECT_EQ(1, system->configured);
+  EXPECT_EQ(1, serialSystem->configured);
+
+  // Systems keep the order they were added in
+  ASSERT_EQ(5u, systemMgr.SystemsConfigure().size());
+  for (std::size_t i = 0; i < systems.size(); ++i)
+  {
+    EXPECT_EQ(dynamic_cast<ISystemConfigure *>(systems[i].get()),
+        systemMgr.SystemsConfigure()[i]);
+  }
+  EXPECT_EQ(dynamic_cast<ISystemConfigure *>(serialSystem.get()),
+      systemMgr.SystemsConfigure()[4]);
+
+  // Activating again doesn't configure them twice
+  systemMgr.ActivatePendingSystems();
+  for (const auto &system : systems)
+    EXPECT_EQ(1, system->configured);
+}
+
+/////////////////////////////////////////////////
+TEST(SystemManager, SystemsRunInOrder)
+{
+  auto loader = std::make_shared<SystemLoader>();
+  SystemManager systemMgr(loader);
+  EntityComponentManager ecm;
+  PreUpdateLog log;
+
+  for (const auto &name : {"first", "second", "third", "fourth"})
+  {
+    systemMgr.AddSystem(std::make_shared<SystemWithName>(name, log),
+        kNullEntity, nullptr);
+  }
+  systemMgr.ActivatePendingSystems();
+  ASSERT_EQ(4u, systemMgr.SystemsPreUpdate().size());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    log.order.clear();
+    systemMgr.PreUpdate(UpdateInfo(), ecm);
+    EXPECT_EQ((std::vector<std::string>{"first", "second", "third",
+        "fourth"}), log.order);
+  }
+  EXPECT_EQ(1, log.maxRunning);
+}
+
+/////////////////////////////////////////////////
+TEST(SystemManager, Profiling)
+{
+  auto loader = std::make_shared<SystemLoader>();
+  SystemManager systemMgr(loader);
+  EntityComponentManager ecm;
+  ThreadPool pool(0);
+
+  systemMgr.AddSystem(std::make_shared<SystemWithUpdates>(), kNullEntity,
+      nullptr);
+  systemMgr.ActivatePendingSystems();
+
+  // Disabled by default
+  EXPECT_EQ(nullptr, systemMgr.Profiler());
+  systemMgr.PreUpdate(UpdateInfo(), ecm);
+
+  systemMgr.SetProfiling(true);
+  ASSERT_NE(nullptr, systemMgr.Profiler());
+  EXPECT_TRUE(systemMgr.Profiler()->Timings().empty());
+
+  for (int i = 0; i < 3; ++i)
+  {
+    systemMgr.PreUpdate(UpdateInfo(), ecm);
+    systemMgr.Update(UpdateInfo(), ecm);
+    systemMgr.PostUpdate(UpdateInfo(), ecm, pool);
+  }
+
+  auto timings = systemMgr.Profiler()->Timings();
+  ASSERT_EQ(3u, timings.size());
+  EXPECT_EQ("PreUpdate", timings[0].phase);
+  EXPECT_EQ("Update", timings[1].phase);
+  EXPECT_EQ("PostUpdate", timings[2].phase);
+  for (const auto &timing : timings)
+  {
+    EXPECT_EQ("System 0", timing.system);
+    EXPECT_EQ(3u, timing.count);
+    EXPECT_LE(timing.minNs, timing.p99Ns);
+  }
+
+  systemMgr.SetProfiling(false);
+  EXPECT_EQ(nullptr, systemMgr.Profiler());
+}
+
+/////////////////////////////////////////////////
+TEST(SystemManager, AddAndRemoveBetweenSteps)
+{
+  auto loader = std::make_shared<SystemLoader>();
+  EntityComponentManager ecm;
+  auto eventManager = EventManager();
+  SystemManager systemMgr(loader, &ecm, &eventManager);
+  PreUpdateLog log;
+
+  const Entity world = ecm.CreateEntity();
+  ecm.CreateComponent(world, components::World());
+  const Entity model = ecm.CreateEntity();
+
+  systemMgr.AddSystem(std::make_shared<SystemWithName>("world", log), world,
+      nullptr);
+  systemMgr.AddSystem(std::make_shared<SystemWithName>("model", log), model,
+      nullptr);
+  systemMgr.ActivatePendingSystems();
+
+  // Systems added later go after the others
+  systemMgr.AddSystem(std::make_shared<SystemWithName>("unattached", log),
+      kNullEntity, nullptr);
+  systemMgr.ActivatePendingSystems();
+  systemMgr.AddSystem(std::make_shared<SystemWithName>("modelPending", log),
+      model, nullptr);
+  EXPECT_EQ(3u, systemMgr.ActiveCount());
+  EXPECT_EQ(1u, systemMgr.PendingCount());
+
+  systemMgr.PreUpdate(UpdateInfo(), ecm);
+  EXPECT_EQ((std::vector<std::string>{"world", "model", "unattached"}),
+      log.order);
+
+  // Nothing is removed until an entity with systems is
+  EXPECT_EQ(0u, systemMgr.ProcessRemovedEntities(ecm));
+  ecm.RequestRemoveEntity(model);
+  EXPECT_EQ(1u, systemMgr.ProcessRemovedEntities(ecm));
+  EXPECT_EQ(2u, systemMgr.ActiveCount());
+  EXPECT_EQ(0u, systemMgr.PendingCount());
+  EXPECT_TRUE(systemMgr.TotalByEntity(model).empty());
+  ASSERT_EQ(2u, systemMgr.SystemsPreUpdate().size());
+
+  log.order.clear();
+  systemMgr.PreUpdate(UpdateInfo(), ecm);
+  EXPECT_EQ((std::vector<std::string>{"world", "unattached"}), log.order);
+  EXPECT_EQ(1, log.maxRunning);
+
+  // Systems of worlds are kept, even if everything is removed
+  ecm.RequestRemoveEntities();
+  EXPECT_EQ(0u, systemMgr.ProcessRemovedEntities(ecm));
+  EXPECT_EQ(2u, systemMgr.ActiveCount());
+}
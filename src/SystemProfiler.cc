@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SystemProfiler.hh"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Calls recorded for one phase of one system.
+struct ProfileEntry
+{
+  /// \brief Name of the system.
+  std::string system;
+
+  /// \brief Name of the phase.
+  std::string phase;
+
+  /// \brief Ring buffer with the most recent durations, in nanoseconds.
+  std::vector<std::int64_t> samples;
+
+  /// \brief Position in samples where the next duration is written.
+  std::size_t next{0};
+
+  /// \brief Total number of calls recorded.
+  std::uint64_t count{0};
+};
+
+class gz::sim::SystemProfilerPrivate
+{
+  /// \brief Number of durations kept per entry.
+  public: std::size_t window{1000u};
+
+  /// \brief All entries, by index.
+  public: std::vector<ProfileEntry> entries;
+};
+
+//////////////////////////////////////////////////
+SystemProfiler::SystemProfiler(std::size_t _window)
+  : dataPtr(std::make_unique<SystemProfilerPrivate>())
+{
+  this->dataPtr->window = std::max<std::size_t>(_window, 1u);
+}
+
+//////////////////////////////////////////////////
+SystemProfiler::~SystemProfiler() = default;
+
+//////////////////////////////////////////////////
+void SystemProfiler::SetEntry(std::size_t _id, const std::string &_system,
+    const std::string &_phase)
+{
+  if (_id >= this->dataPtr->entries.size())
+    this->dataPtr->entries.resize(_id + 1);
+
+  auto &entry = this->dataPtr->entries[_id];
+  if (entry.system == _system && entry.phase == _phase)
+    return;
+
+  entry = ProfileEntry();
+  entry.system = _system;
+  entry.phase = _phase;
+  entry.samples.reserve(this->dataPtr->window);
+}
+
+//////////////////////////////////////////////////
+void SystemProfiler::Record(std::size_t _id,
+    std::chrono::steady_clock::duration _duration)
+{
+  auto &entry = this->dataPtr->entries[_id];
+  const std::int64_t ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_duration).count();
+
+  if (entry.samples.size() < this->dataPtr->window)
+    entry.samples.push_back(ns);
+  else
+    entry.samples[entry.next] = ns;
+
+  entry.next = (entry.next + 1) % this->dataPtr->window;
+  ++entry.count;
+}
+
+//////////////////////////////////////////////////
+std::vector<SystemTiming> SystemProfiler::Timings() const
+{
+  std::vector<SystemTiming> result;
+  std::vector<std::int64_t> sorted;
+  for (const auto &entry : this->dataPtr->entries)
+  {
+    if (entry.samples.empty())
+      continue;
+
+    SystemTiming timing;
+    timing.system = entry.system;
+    timing.phase = entry.phase;
+    timing.count = entry.count;
+
+    sorted = entry.samples;
+    std::sort(sorted.begin(), sorted.end());
+    timing.minNs = sorted.front();
+    timing.meanNs = static_cast<double>(
+        std::accumulate(sorted.begin(), sorted.end(), std::int64_t{0})) /
+        static_cast<double>(sorted.size());
+
+    // Nearest-rank percentile
+    const std::size_t rank = (sorted.size() * 99 + 99) / 100;
+    timing.p99Ns = sorted[rank - 1];
+
+    result.push_back(timing);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::string SystemProfiler::Summary() const
+{
+  const auto timings = this->Timings();
+
+  std::size_t nameWidth{6};
+  for (const auto &timing : timings)
+    nameWidth = std::max(nameWidth, timing.system.size());
+
+  std::ostringstream out;
+  out << std::left << std::setw(static_cast<int>(nameWidth)) << "System"
+      << "  " << std::setw(10) << "Phase" << std::right
+      << std::setw(10) << "Calls"
+      << std::setw(14) << "Min [ns]"
+      << std::setw(14) << "Mean [ns]"
+      << std::setw(14) << "P99 [ns]" << "\n";
+
+  for (const auto &timing : timings)
+  {
+    out << std::left << std::setw(static_cast<int>(nameWidth))
+        << timing.system << "  " << std::setw(10) << timing.phase
+        << std::right << std::setw(10) << timing.count
+        << std::setw(14) << timing.minNs
+        << std::setw(14) << std::fixed << std::setprecision(0)
+        << timing.meanNs
+        << std::setw(14) << timing.p99Ns << "\n";
+  }
+  return out.str();
+}
+
+//////////////////////////////////////////////////
+void SystemProfiler::Clear()
+{
+  this->dataPtr->entries.clear();
+}
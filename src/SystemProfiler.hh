@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMPROFILER_HH_
+#define GZ_SIM_SYSTEMPROFILER_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class SystemProfilerPrivate;
+
+    /// \brief Timing statistics of one phase of one system.
+    struct SystemTiming
+    {
+      /// \brief Name of the system.
+      std::string system;
+
+      /// \brief Name of the phase, such as "PreUpdate".
+      std::string phase;
+
+      /// \brief Total number of calls recorded.
+      std::uint64_t count{0};
+
+      /// \brief Fastest call in the rolling window, in nanoseconds.
+      std::int64_t minNs{0};
+
+      /// \brief Mean duration of the calls in the rolling window, in
+      /// nanoseconds.
+      double meanNs{0.0};
+
+      /// \brief 99th percentile of the calls in the rolling window, in
+      /// nanoseconds.
+      std::int64_t p99Ns{0};
+    };
+
+    /// \class SystemProfiler SystemProfiler.hh
+    /// \brief Keeps a rolling window of the durations of system calls, and
+    /// computes statistics over it.
+    ///
+    /// Each entry is identified by an index chosen by the caller. Record may
+    /// be called concurrently for different entries, but the other functions
+    /// must not be called while calls are being recorded.
+    class GZ_SIM_VISIBLE SystemProfiler
+    {
+      /// \brief Constructor
+      /// \param[in] _window Number of most recent calls of each entry used to
+      /// compute statistics.
+      public: explicit SystemProfiler(std::size_t _window = 1000u);
+
+      /// \brief Destructor
+      public: ~SystemProfiler();
+
+      /// \brief Set the names of an entry, creating it if needed. The
+      /// recorded calls are kept if the names don't change.
+      /// \param[in] _id Index of the entry.
+      /// \param[in] _system Name of the system.
+      /// \param[in] _phase Name of the phase.
+      public: void SetEntry(std::size_t _id, const std::string &_system,
+                  const std::string &_phase);
+
+      /// \brief Record the duration of a call.
+      /// \param[in] _id Index of the entry, which must have been set.
+      /// \param[in] _duration How long the call took.
+      public: void Record(std::size_t _id,
+                  std::chrono::steady_clock::duration _duration);
+
+      /// \brief Get the statistics of all entries that have recorded calls.
+      /// \return Statistics, in the order of the entry indices.
+      public: std::vector<SystemTiming> Timings() const;
+
+      /// \brief Get a table with the statistics of all entries, meant to be
+      /// printed to the console.
+      /// \return The table.
+      public: std::string Summary() const;
+
+      /// \brief Remove all entries.
+      public: void Clear();
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SystemProfilerPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "SystemProfiler.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(SystemProfiler, Timings)
+{
+  SystemProfiler profiler(100);
+  EXPECT_TRUE(profiler.Timings().empty());
+
+  profiler.SetEntry(0, "physics", "Update");
+  profiler.SetEntry(2, "sensors", "PostUpdate");
+
+  // Entries without calls aren't reported
+  EXPECT_TRUE(profiler.Timings().empty());
+
+  for (int i = 1; i <= 100; ++i)
+    profiler.Record(0, std::chrono::nanoseconds(i));
+  profiler.Record(2, 5us);
+
+  auto timings = profiler.Timings();
+  ASSERT_EQ(2u, timings.size());
+
+  EXPECT_EQ("physics", timings[0].system);
+  EXPECT_EQ("Update", timings[0].phase);
+  EXPECT_EQ(100u, timings[0].count);
+  EXPECT_EQ(1, timings[0].minNs);
+  EXPECT_DOUBLE_EQ(50.5, timings[0].meanNs);
+  EXPECT_EQ(99, timings[0].p99Ns);
+
+  EXPECT_EQ("sensors", timings[1].system);
+  EXPECT_EQ(1u, timings[1].count);
+  EXPECT_EQ(5000, timings[1].minNs);
+  EXPECT_EQ(5000, timings[1].p99Ns);
+
+  // Only the last 100 calls are used for the statistics
+  for (int i = 0; i < 100; ++i)
+    profiler.Record(0, 1ms);
+  timings = profiler.Timings();
+  ASSERT_EQ(2u, timings.size());
+  EXPECT_EQ(200u, timings[0].count);
+  EXPECT_EQ(1000000, timings[0].minNs);
+  EXPECT_DOUBLE_EQ(1e6, timings[0].meanNs);
+
+  auto summary = profiler.Summary();
+  EXPECT_NE(std::string::npos, summary.find("physics"));
+  EXPECT_NE(std::string::npos, summary.find("PostUpdate"));
+
+  // Renaming an entry drops its calls, setting the same names keeps them
+  profiler.SetEntry(2, "sensors", "PostUpdate");
+  profiler.SetEntry(0, "physics", "PreUpdate");
+  timings = profiler.Timings();
+  ASSERT_EQ(1u, timings.size());
+  EXPECT_EQ("sensors", timings[0].system);
+
+  profiler.Clear();
+  EXPECT_TRUE(profiler.Timings().empty());
+}
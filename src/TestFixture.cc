@@ -27,6 +27,7 @@ using namespace sim;
 class HelperSystem :
   public System,
   public ISystemConfigure,
+  public ISystemReset,
   public ISystemPreUpdate,
   public ISystemUpdate,
   public ISystemPostUpdate
@@ -38,6 +39,10 @@ class HelperSystem :
                 EntityComponentManager &_ecm,
                 EventManager &_eventMgr) override;
 
+  // Documentation inherited
+  public: void Reset(const UpdateInfo &_info,
+                EntityComponentManager &_ecm) override;
+
   // Documentation inherited
   public: void PreUpdate(const UpdateInfo &_info,
                 EntityComponentManager &_ecm) override;
@@ -81,6 +86,13 @@ void HelperSystem::Configure(
     this->configureCallback(_entity, _sdf, _ecm, _eventMgr);
 }
 
+/////////////////////////////////////////////////
+void HelperSystem::Reset(const UpdateInfo &, EntityComponentManager &)
+{
+  // Nothing to reset, but implementing the interface keeps the system
+  // running after a reset, since in-memory systems can't be reloaded.
+}
+
 /////////////////////////////////////////////////
 void HelperSystem::PreUpdate(const UpdateInfo &_info,
       EntityComponentManager &_ecm)
@@ -138,6 +150,37 @@ TestFixture::TestFixture(const ServerConfig &_config)
   this->dataPtr->Init(_config);
 }
 
+//////////////////////////////////////////////////
+ServerConfig TestFixture::MinimalConfig(const std::string &_path)
+{
+  ServerConfig config;
+  config.SetSdfFile(_path);
+  config.SetUseDefaultPlugins(false);
+  config.SetUseTransport(false);
+  return config;
+}
+
+//////////////////////////////////////////////////
+TestFixture &TestFixture::Reset()
+{
+  if (this->dataPtr->server->Running())
+  {
+    gzerr << "Can't reset the fixture while the server is running."
+           << std::endl;
+    return *this;
+  }
+
+  unsigned int worldIndex{0u};
+  while (this->dataPtr->server->Reset(worldIndex))
+    ++worldIndex;
+
+  this->dataPtr->helperSystem->configureCallback = nullptr;
+  this->dataPtr->helperSystem->preUpdateCallback = nullptr;
+  this->dataPtr->helperSystem->updateCallback = nullptr;
+  this->dataPtr->helperSystem->postUpdateCallback = nullptr;
+  return *this;
+}
+
 //////////////////////////////////////////////////
 void TestFixture::Implementation::Init(const ServerConfig &_config)
 {
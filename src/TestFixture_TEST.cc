@@ -259,3 +259,53 @@ TEST_F(TestFixtureTest, ChangeCallback)
   // New callback is called
   EXPECT_EQ(expectedIterations, preUpdate2);
 }
+
+/////////////////////////////////////////////////
+TEST_F(TestFixtureTest, MinimalConfigReset)
+{
+  TestFixture testFixture(TestFixture::MinimalConfig(common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "worlds", "shapes.sdf")));
+  ASSERT_NE(nullptr, testFixture.Server());
+
+  // Only the fixture's system is loaded
+  testFixture.Finalize();
+  EXPECT_EQ(1u, *testFixture.Server()->SystemCount());
+
+  unsigned int preUpdate1{0u};
+  testFixture.OnPreUpdate([&](const UpdateInfo &,
+      EntityComponentManager &_ecm)
+    {
+      if (preUpdate1++ == 0u)
+      {
+        auto entity = _ecm.CreateEntity();
+        _ecm.CreateComponent(entity, components::Name("extra"));
+      }
+    });
+
+  unsigned int expectedIterations{10u};
+  testFixture.Server()->Run(true, expectedIterations, false);
+  EXPECT_EQ(expectedIterations, preUpdate1);
+  EXPECT_EQ(expectedIterations, *testFixture.Server()->IterationCount());
+  EXPECT_TRUE(testFixture.Server()->HasEntity("extra"));
+
+  // Time and entities are back to their initial state, and callbacks are
+  // cleared
+  testFixture.Reset();
+  EXPECT_EQ(0u, *testFixture.Server()->IterationCount());
+  EXPECT_FALSE(testFixture.Server()->HasEntity("extra"));
+  EXPECT_TRUE(testFixture.Server()->HasEntity("box"));
+
+  uint64_t lastIteration{0u};
+  unsigned int postUpdate2{0u};
+  testFixture.OnPostUpdate([&](const UpdateInfo &_info,
+      const EntityComponentManager &)
+    {
+      lastIteration = _info.iterations;
+      postUpdate2++;
+    });
+
+  testFixture.Server()->Run(true, expectedIterations, false);
+  EXPECT_EQ(expectedIterations, preUpdate1);
+  EXPECT_EQ(expectedIterations, postUpdate2);
+  EXPECT_EQ(expectedIterations, lastIteration);
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Util.hh>
+#include <gz/utils/NeverDestroyed.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief How long threads keep polling for work, or for their job to finish,
+/// before going to sleep. Waking up a sleeping thread takes much longer, and
+/// at high update rates the next job usually arrives within this time.
+constexpr std::chrono::microseconds kSpinDuration{50};
+
+/// \brief Number of chunks GrainSize splits loops into in deterministic
+/// mode, enough to balance the load of typical machines.
+constexpr std::size_t kDeterministicChunks{64u};
+
+/// \brief Number of users of the deterministic mode. GrainSize ignores the
+/// number of threads while it's not zero.
+static std::atomic<unsigned int> gDeterministicUsers{0u};
+
+/// \brief A single ParallelFor call.
+struct ParallelJob
+{
+  /// \brief Function to call for each chunk.
+  const std::function<void(std::size_t, std::size_t)> *fn{nullptr};
+
+  /// \brief Number of elements.
+  std::size_t count{0};
+
+  /// \brief Maximum number of elements per chunk.
+  std::size_t grainSize{1};
+
+  /// \brief Start of the next chunk to be claimed.
+  std::atomic<std::size_t> next{0};
+
+  /// \brief Number of elements that have been processed.
+  std::atomic<std::size_t> done{0};
+
+  /// \brief Protects finished.
+  std::mutex mutex;
+
+  /// \brief Signals the submitting thread when all elements are processed.
+  std::condition_variable cv;
+
+  /// \brief True when all elements are processed.
+  bool finished{false};
+};
+
+class gz::sim::ThreadPoolPrivate
+{
+  /// \brief Worker thread loop.
+  public: void Worker();
+
+  /// \brief Claim and process chunks of a job until none are left.
+  /// \param[in] _job Job to work on.
+  public: static void Work(ParallelJob &_job);
+
+  /// \brief Remove a job from the queue, if it is still there.
+  /// \param[in] _job Job to remove.
+  public: void Dequeue(const std::shared_ptr<ParallelJob> &_job);
+
+  /// \brief Worker threads.
+  public: std::vector<std::thread> threads;
+
+  /// \brief Jobs that still have unclaimed chunks.
+  public: std::deque<std::shared_ptr<ParallelJob>> jobs;
+
+  /// \brief Protects jobs and sleeping.
+  public: std::mutex mutex;
+
+  /// \brief Wakes up the workers when jobs are added.
+  public: std::condition_variable cv;
+
+  /// \brief Number of jobs in the queue, which workers can poll without
+  /// locking the mutex.
+  public: std::atomic<std::size_t> queued{0};
+
+  /// \brief Number of workers waiting on cv.
+  public: std::size_t sleeping{0};
+
+  /// \brief True when the workers should exit.
+  public: std::atomic<bool> stop{false};
+};
+
+//////////////////////////////////////////////////
+void ThreadPoolPrivate::Worker()
+{
+  while (true)
+  {
+    const auto spinEnd = std::chrono::steady_clock::now() + kSpinDuration;
+    while (this->queued == 0 && !this->stop &&
+        std::chrono::steady_clock::now() < spinEnd)
+    {
+      std::this_thread::yield();
+    }
+
+    std::shared_ptr<ParallelJob> job;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (this->jobs.empty() && !this->stop)
+      {
+        ++this->sleeping;
+        this->cv.wait(lock, [this]{return this->stop || !this->jobs.empty();});
+        --this->sleeping;
+      }
+      if (this->stop)
+        return;
+      job = this->jobs.front();
+    }
+
+    Work(*job);
+    this->Dequeue(job);
+  }
+}
+
+//////////////////////////////////////////////////
+void ThreadPoolPrivate::Work(ParallelJob &_job)
+{
+  while (true)
+  {
+    const std::size_t begin = _job.next.fetch_add(_job.grainSize);
+    if (begin >= _job.count)
+      return;
+
+    const std::size_t end = std::min(begin + _job.grainSize, _job.count);
+    (*_job.fn)(begin, end);
+
+    if (_job.done.fetch_add(end - begin) + (end - begin) == _job.count)
+    {
+      std::lock_guard<std::mutex> lock(_job.mutex);
+      _job.finished = true;
+      _job.cv.notify_all();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ThreadPoolPrivate::Dequeue(const std::shared_ptr<ParallelJob> &_job)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto it = std::find(this->jobs.begin(), this->jobs.end(), _job);
+  if (it != this->jobs.end())
+  {
+    this->jobs.erase(it);
+    this->queued = this->jobs.size();
+  }
+}
+
+//////////////////////////////////////////////////
+ThreadPool::ThreadPool(unsigned int _threadCount)
+  : dataPtr(std::make_unique<ThreadPoolPrivate>())
+{
+  for (unsigned int i = 0; i < _threadCount; ++i)
+  {
+    this->dataPtr->threads.emplace_back(
+        &ThreadPoolPrivate::Worker, this->dataPtr.get());
+  }
+}
+
+//////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->cv.notify_all();
+
+  for (auto &thread : this->dataPtr->threads)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+}
+
+//////////////////////////////////////////////////
+ThreadPool &ThreadPool::Shared()
+{
+  static gz::utils::NeverDestroyed<ThreadPool> pool([]
+  {
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::string value;
+    if (common::env("GZ_SIM_THREADS", value))
+    {
+      try
+      {
+        threads = static_cast<unsigned int>(
+            std::max(std::stoi(value), 1));
+      }
+      catch (...)
+      {
+      }
+    }
+    return threads - 1u;
+  }());
+  return pool.Access();
+}
+
+//////////////////////////////////////////////////
+unsigned int ThreadPool::ThreadCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->threads.size());
+}
+
+//////////////////////////////////////////////////
+std::size_t ThreadPool::GrainSize(std::size_t _count,
+    std::size_t _minGrainSize) const
+{
+  const std::size_t chunks = Deterministic() ? kDeterministicChunks :
+      4u * (this->dataPtr->threads.size() + 1u);
+  return std::max<std::size_t>(std::max<std::size_t>(_minGrainSize, 1u),
+      (_count + chunks - 1u) / chunks);
+}
+
+//////////////////////////////////////////////////
+void ThreadPool::SetDeterministic(bool _deterministic)
+{
+  if (_deterministic)
+  {
+    ++gDeterministicUsers;
+    return;
+  }
+
+  // Unmatched calls with false leave the mode off
+  unsigned int users = gDeterministicUsers.load();
+  while (users > 0u &&
+      !gDeterministicUsers.compare_exchange_weak(users, users - 1u))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+bool ThreadPool::Deterministic()
+{
+  return gDeterministicUsers > 0u;
+}
+
+//////////////////////////////////////////////////
+void ThreadPool::ParallelFor(std::size_t _count, std::size_t _grainSize,
+    const std::function<void(std::size_t, std::size_t)> &_fn)
+{
+  if (_count == 0)
+    return;
+
+  _grainSize = std::max<std::size_t>(_grainSize, 1u);
+
+  // Not worth waking up other threads
+  if (this->dataPtr->threads.empty() || _count <= _grainSize)
+  {
+    for (std::size_t begin = 0; begin < _count; begin += _grainSize)
+      _fn(begin, std::min(begin + _grainSize, _count));
+    return;
+  }
+
+  auto job = std::make_shared<ParallelJob>();
+  job->fn = &_fn;
+  job->count = _count;
+  job->grainSize = _grainSize;
+
+  // Only wake up as many sleeping workers as there are chunks left for
+  // them, the ones still polling will pick up the job on their own.
+  std::size_t wake{0};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->jobs.push_back(job);
+    this->dataPtr->queued = this->dataPtr->jobs.size();
+    const std::size_t chunks = (_count + _grainSize - 1) / _grainSize;
+    wake = std::min(chunks - 1, this->dataPtr->sleeping);
+  }
+  for (std::size_t i = 0; i < wake; ++i)
+    this->dataPtr->cv.notify_one();
+
+  // The calling thread works on its own job, so it's guaranteed to make
+  // progress even if all workers are busy.
+  ThreadPoolPrivate::Work(*job);
+  this->dataPtr->Dequeue(job);
+
+  const auto spinEnd = std::chrono::steady_clock::now() + kSpinDuration;
+  while (job->done != job->count &&
+      std::chrono::steady_clock::now() < spinEnd)
+  {
+    std::this_thread::yield();
+  }
+
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->cv.wait(lock, [&job]{return job->finished;});
+}
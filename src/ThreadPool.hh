@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_SIM_THREADPOOL_HH_
+#define GZ_SIM_THREADPOOL_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class ThreadPoolPrivate;
+
+    /// \class ThreadPool ThreadPool.hh
+    /// \brief Pool of persistent worker threads used to split loops into
+    /// chunks that are processed concurrently.
+    ///
+    /// Work is distributed dynamically: every participating thread keeps
+    /// grabbing the next unprocessed chunk of a job until none are left, so
+    /// threads that finish early pick up the remaining work. The calling
+    /// thread always takes part in its own job, which makes it safe to
+    /// submit jobs from several threads at once, or from inside a job.
+    ///
+    /// Idle threads poll for new work for a short time before going to
+    /// sleep, which keeps the latency low when jobs are submitted at a high
+    /// rate, such as once per simulation step.
+    class GZ_SIM_VISIBLE ThreadPool
+    {
+      /// \brief Constructor
+      /// \param[in] _threadCount Number of worker threads, not counting the
+      /// threads that submit work. Zero means every job runs on the calling
+      /// thread.
+      public: explicit ThreadPool(unsigned int _threadCount);
+
+      /// \brief Destructor. Waits for the worker threads to finish.
+      public: ~ThreadPool();
+
+      /// \brief Get a pool shared by the whole process. It has one thread
+      /// less than the number of hardware threads, since the calling thread
+      /// also does work, unless the GZ_SIM_THREADS environment variable
+      /// sets the number of threads taking part in jobs, including the
+      /// calling thread.
+      /// \return The shared pool.
+      public: static ThreadPool &Shared();
+
+      /// \brief Get the number of worker threads.
+      /// \return Number of worker threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Get a grain size that splits a loop into a few chunks per
+      /// thread, so threads that finish early can balance the load. In
+      /// deterministic mode, the chunks only depend on the number of
+      /// elements, so results accumulated per chunk are the same with any
+      /// number of threads.
+      /// \param[in] _count Number of elements in the loop.
+      /// \param[in] _minGrainSize Smallest chunk worth scheduling.
+      /// \return The grain size to pass to ParallelFor.
+      /// \sa SetDeterministic
+      public: std::size_t GrainSize(std::size_t _count,
+                  std::size_t _minGrainSize = 1u) const;
+
+      /// \brief Set whether GrainSize ignores the number of threads. This
+      /// applies to all pools of the process. Calls nest: the mode stays on
+      /// until each call with true is matched by a call with false, so that
+      /// one user turning it off doesn't affect others. Chunks are still
+      /// claimed dynamically, so code that must be reproducible has to
+      /// combine the results of the chunks in the order of the chunks, not
+      /// in the order they finish.
+      /// \param[in] _deterministic True to make chunks independent of the
+      /// number of threads.
+      /// \sa ServerConfig::SetDeterministic
+      public: static void SetDeterministic(bool _deterministic);
+
+      /// \brief Get whether GrainSize ignores the number of threads.
+      /// \return True in deterministic mode.
+      public: static bool Deterministic();
+
+      /// \brief Call _fn over the range [0, _count), split into chunks of at
+      /// most _grainSize elements, and block until all chunks are done.
+      /// \param[in] _count Number of elements to process.
+      /// \param[in] _grainSize Maximum number of elements per chunk.
+      /// \param[in] _fn Function called with the [begin, end) range of each
+      /// chunk. It may be called concurrently from different threads.
+      public: void ParallelFor(std::size_t _count, std::size_t _grainSize,
+                  const std::function<void(std::size_t, std::size_t)> &_fn);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ThreadPoolPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
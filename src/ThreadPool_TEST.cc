@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(ThreadPool, ParallelFor)
+{
+  for (unsigned int threads : {0u, 1u, 4u})
+  {
+    ThreadPool pool(threads);
+    EXPECT_EQ(threads, pool.ThreadCount());
+
+    std::vector<int> values(1000, 0);
+    pool.ParallelFor(values.size(), 7,
+        [&](std::size_t _begin, std::size_t _end)
+        {
+          EXPECT_LE(_end - _begin, 7u);
+          for (std::size_t i = _begin; i < _end; ++i)
+            values[i] += static_cast<int>(i);
+        });
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+      EXPECT_EQ(static_cast<int>(i), values[i]);
+
+    // Empty range
+    bool called{false};
+    pool.ParallelFor(0, 1, [&](std::size_t, std::size_t){called = true;});
+    EXPECT_FALSE(called);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ThreadPool, ConcurrentAndNestedJobs)
+{
+  ThreadPool pool(3);
+
+  std::atomic<int> total{0};
+  std::vector<std::thread> submitters;
+  for (int t = 0; t < 4; ++t)
+  {
+    submitters.emplace_back([&]
+    {
+      pool.ParallelFor(50, 1, [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          pool.ParallelFor(10, 2, [&](std::size_t _b, std::size_t _e)
+          {
+            total += static_cast<int>(_e - _b);
+          });
+        }
+      });
+    });
+  }
+
+  for (auto &thread : submitters)
+    thread.join();
+
+  EXPECT_EQ(4 * 50 * 10, total);
+}
+
+/////////////////////////////////////////////////
+TEST(ThreadPool, JobsAfterWorkersSleep)
+{
+  ThreadPool pool(2);
+
+  // Alternate between jobs submitted back to back, picked up by polling
+  // workers, and jobs submitted after the workers went to sleep.
+  for (int step = 0; step < 20; ++step)
+  {
+    if (step % 2 == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    std::atomic<int> count{0};
+    pool.ParallelFor(8, 1, [&](std::size_t _begin, std::size_t _end)
+    {
+      count += static_cast<int>(_end - _begin);
+    });
+    EXPECT_EQ(8, count);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ThreadPool, DeterministicGrainSize)
+{
+  ThreadPool serial(0);
+  ThreadPool parallel(7);
+  EXPECT_NE(serial.GrainSize(10000u), parallel.GrainSize(10000u));
+  EXPECT_EQ(16u, parallel.GrainSize(10u, 16u));
+
+  ThreadPool::SetDeterministic(true);
+  EXPECT_TRUE(ThreadPool::Deterministic());
+  EXPECT_EQ(serial.GrainSize(10000u), parallel.GrainSize(10000u));
+  EXPECT_EQ(serial.GrainSize(10000u, 500u), parallel.GrainSize(10000u, 500u));
+  EXPECT_EQ(16u, parallel.GrainSize(10u, 16u));
+  EXPECT_EQ(1u, parallel.GrainSize(0u, 0u));
+
+  ThreadPool::SetDeterministic(false);
+  EXPECT_FALSE(ThreadPool::Deterministic());
+}
+
+/////////////////////////////////////////////////
+TEST(ThreadPool, DeterministicNesting)
+{
+  ThreadPool::SetDeterministic(true);
+  ThreadPool::SetDeterministic(true);
+  ThreadPool::SetDeterministic(false);
+  EXPECT_TRUE(ThreadPool::Deterministic());
+
+  ThreadPool::SetDeterministic(false);
+  EXPECT_FALSE(ThreadPool::Deterministic());
+
+  // Unmatched calls don't underflow
+  ThreadPool::SetDeterministic(false);
+  EXPECT_FALSE(ThreadPool::Deterministic());
+  ThreadPool::SetDeterministic(true);
+  EXPECT_TRUE(ThreadPool::Deterministic());
+  ThreadPool::SetDeterministic(false);
+  EXPECT_FALSE(ThreadPool::Deterministic());
+}
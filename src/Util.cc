@@ -17,6 +17,9 @@
 
 #include <gz/msgs/entity.pb.h>
 
+#include <algorithm>
+#include <cstdint>
+
 #include <gz/common/Filesystem.hh>
 #include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
@@ -33,6 +36,7 @@
 #include <gz/fuel_tools/Interface.hh>
 #include <gz/fuel_tools/ClientConfig.hh>
 
+#include "gz/sim/components/ActivityLevel.hh"
 #include "gz/sim/components/Actor.hh"
 #include "gz/sim/components/AngularVelocity.hh"
 #include "gz/sim/components/Collision.hh"
@@ -55,6 +59,8 @@
 #include "gz/sim/InstallationDirectories.hh"
 #include "gz/sim/Util.hh"
 
+#include "MeshCache.hh"
+
 namespace gz
 {
 namespace sim
@@ -65,29 +71,14 @@ inline namespace GZ_SIM_VERSION_NAMESPACE {
 math::Pose3d worldPose(const Entity &_entity,
     const EntityComponentManager &_ecm)
 {
-  auto poseComp = _ecm.Component<components::Pose>(_entity);
-  if (nullptr == poseComp)
+  auto pose = _ecm.WorldPose(_entity);
+  if (!pose)
   {
     gzwarn << "Trying to get world pose from entity [" << _entity
             << "], which doesn't have a pose component" << std::endl;
     return math::Pose3d();
   }
-
-  // work out pose in world frame
-  math::Pose3d pose = poseComp->Data();
-  auto p = _ecm.Component<components::ParentEntity>(_entity);
-  while (p)
-  {
-    // get pose of parent entity
-    auto parentPose = _ecm.Component<components::Pose>(p->Data());
-    if (!parentPose)
-      break;
-    // transform pose
-    pose = parentPose->Data() * pose;
-    // keep going up the tree
-    p = _ecm.Component<components::ParentEntity>(p->Data());
-  }
-  return pose;
+  return *pose;
 }
 
 //////////////////////////////////////////////////
@@ -572,6 +563,34 @@ sim::Entity topLevelModel(const Entity &_entity,
   return modelEntity;
 }
 
+//////////////////////////////////////////////////
+unsigned int activityLevel(const Entity &_entity,
+    const EntityComponentManager &_ecm)
+{
+  if (!_ecm.HasComponentType(components::ActivityLevel::typeId))
+    return 0u;
+
+  auto level = _ecm.Component<components::ActivityLevel>(
+      topLevelModel(_entity, _ecm));
+  return nullptr == level ? 0u : level->Data();
+}
+
+//////////////////////////////////////////////////
+bool activityUpdateDue(const Entity &_entity,
+    const EntityComponentManager &_ecm, const uint64_t _iteration)
+{
+  if (!_ecm.HasComponentType(components::ActivityLevel::typeId))
+    return true;
+
+  const Entity model = topLevelModel(_entity, _ecm);
+  auto level = _ecm.Component<components::ActivityLevel>(model);
+  if (nullptr == level || 0u == level->Data())
+    return true;
+
+  const uint64_t period = uint64_t{1} << std::min(level->Data(), 63u);
+  return (_iteration + model) % period == 0u;
+}
+
 //////////////////////////////////////////////////
 std::string topicFromScopedName(const Entity &_entity,
     const EntityComponentManager &_ecm, bool _excludeWorld)
@@ -846,9 +865,12 @@ const common::Mesh *loadMesh(const sdf::Mesh &_meshSdf)
   }
   else if (meshManager.IsValidFilename(_meshSdf.Uri()))
   {
-    // load mesh by file path
+    // load mesh by file path, reusing meshes with the same content that
+    // were preloaded from other paths
     auto fullPath = asFullPath(_meshSdf.Uri(), _meshSdf.FilePath());
-    mesh = meshManager.Load(fullPath);
+    mesh = MeshCache::Instance().Find(fullPath);
+    if (nullptr == mesh)
+      mesh = meshManager.Load(fullPath);
     if (nullptr == mesh)
     {
       gzwarn << "Failed to load mesh from [" << fullPath
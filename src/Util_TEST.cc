@@ -23,6 +23,7 @@
 
 #include <gz/fuel_tools/ClientConfig.hh>
 
+#include "gz/sim/components/ActivityLevel.hh"
 #include "gz/sim/components/Actor.hh"
 #include "gz/sim/components/Collision.hh"
 #include "gz/sim/components/Joint.hh"
@@ -613,6 +614,55 @@ TEST_F(UtilTest, ValidTopic)
   EXPECT_EQ("good", validTopic({invalid, good, fixable}));
 }
 
+/////////////////////////////////////////////////
+TEST_F(UtilTest, ActivityLevel)
+{
+  EntityComponentManager ecm;
+
+  auto worldEntity = ecm.CreateEntity();
+  ecm.CreateComponent(worldEntity, components::World());
+
+  auto nearModel = ecm.CreateEntity();
+  ecm.CreateComponent(nearModel, components::Model());
+  ecm.CreateComponent(nearModel, components::ParentEntity(worldEntity));
+
+  auto farModel = ecm.CreateEntity();
+  ecm.CreateComponent(farModel, components::Model());
+  ecm.CreateComponent(farModel, components::ParentEntity(worldEntity));
+
+  auto farLink = ecm.CreateEntity();
+  ecm.CreateComponent(farLink, components::Link());
+  ecm.CreateComponent(farLink, components::ParentEntity(farModel));
+
+  // Everything is active until activity levels are set
+  EXPECT_EQ(0u, activityLevel(farLink, ecm));
+  for (uint64_t i = 0; i < 8; ++i)
+    EXPECT_TRUE(activityUpdateDue(farLink, ecm, i));
+
+  ecm.CreateComponent(nearModel, components::ActivityLevel(0u));
+  ecm.CreateComponent(farModel, components::ActivityLevel(2u));
+
+  EXPECT_EQ(0u, activityLevel(nearModel, ecm));
+  EXPECT_EQ(2u, activityLevel(farModel, ecm));
+  EXPECT_EQ(2u, activityLevel(farLink, ecm));
+  EXPECT_EQ(0u, activityLevel(worldEntity, ecm));
+
+  // The far model and its link are updated together, every 4 iterations
+  unsigned int nearCount{0u};
+  unsigned int farCount{0u};
+  for (uint64_t i = 0; i < 16; ++i)
+  {
+    if (activityUpdateDue(nearModel, ecm, i))
+      ++nearCount;
+    const bool farDue = activityUpdateDue(farModel, ecm, i);
+    EXPECT_EQ(farDue, activityUpdateDue(farLink, ecm, i));
+    if (farDue)
+      ++farCount;
+  }
+  EXPECT_EQ(16u, nearCount);
+  EXPECT_EQ(4u, farCount);
+}
+
 /////////////////////////////////////////////////
 TEST_F(UtilTest, TopicFromScopedName)
 {
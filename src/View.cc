@@ -17,6 +17,8 @@
 
 #include "gz/sim/detail/View.hh"
 
+#include <algorithm>
+
 namespace gz
 {
 namespace sim
@@ -32,63 +34,159 @@ View::View(const std::set<ComponentTypeId>& _compIds)
 }
 
 //////////////////////////////////////////////////
-const std::vector<const components::BaseComponent *>
-    &View::EntityComponentConstData(const Entity _entity) const
+const components::BaseComponent *const *View::EntityComponentConstData(
+    const Entity _entity) const
 {
-  return this->validConstData.at(_entity);
+  return this->EntityComponentData(_entity);
 }
 
 //////////////////////////////////////////////////
-const std::vector<components::BaseComponent *> &View::EntityComponentData(
+components::BaseComponent *const *View::EntityComponentData(
     const Entity _entity) const
 {
-  return this->validData.at(_entity);
+  const auto index = this->EntityIndex(_entity);
+  if (index == kInvalidIndex)
+    return nullptr;
+  return this->EntityComponentDataAt(index);
 }
 
 //////////////////////////////////////////////////
-bool View::HasCachedComponentData(const Entity _entity) const
+components::BaseComponent *const *View::EntityComponentDataAt(
+    const std::size_t _index) const
 {
-  auto cachedComps =
-    this->validData.find(_entity) != this->validData.end() ||
-    this->invalidData.find(_entity) != this->invalidData.end();
-  auto cachedConstComps =
-    this->validConstData.find(_entity) != this->validConstData.end() ||
-    this->invalidConstData.find(_entity) != this->invalidConstData.end();
+  return this->componentData.data() + _index * this->componentTypes.size();
+}
 
-  if (cachedComps && !cachedConstComps)
-  {
-    gzwarn << "Non-const component data is cached for entity " << _entity
-      << ", but const component data is not cached." << std::endl;
-  }
-  else if (cachedConstComps && !cachedComps)
+//////////////////////////////////////////////////
+void View::AddEntity(const Entity _entity, const bool _new,
+    const components::BaseComponent *const *_data)
+{
+  const auto stride = this->componentTypes.size();
+  const bool existing = this->HasEntity(_entity);
+  const auto index = this->InsertEntity(_entity);
+  auto rowIter = this->componentData.begin() + index * stride;
+  if (!existing)
+    rowIter = this->componentData.insert(rowIter, stride, nullptr);
+
+  for (std::size_t i = 0; i < stride; ++i)
   {
-    gzwarn << "Const component data is cached for entity " << _entity
-      << ", but non-const component data is not cached." << std::endl;
+    *(rowIter + i) = const_cast<components::BaseComponent *>(_data[i]);
   }
 
-  return cachedComps && cachedConstComps;
+  if (_new && SortedInsert(this->newEntities, _entity))
+    ++this->newEntitiesVersion;
+}
+
+//////////////////////////////////////////////////
+bool View::HasCachedComponentData(const Entity _entity) const
+{
+  return this->HasEntity(_entity) ||
+    this->invalidData.find(_entity) != this->invalidData.end();
 }
 
 //////////////////////////////////////////////////
 bool View::RemoveEntity(const Entity _entity)
 {
   this->invalidData.erase(_entity);
-  this->invalidConstData.erase(_entity);
   this->missingCompTracker.erase(_entity);
 
   if (!this->HasEntity(_entity) && !this->IsEntityMarkedForAddition(_entity))
     return false;
 
-  this->entities.erase(_entity);
-  this->newEntities.erase(_entity);
-  this->toRemoveEntities.erase(_entity);
+  const auto index = this->EraseEntity(_entity);
+  if (index != kInvalidIndex)
+  {
+    const auto stride = this->componentTypes.size();
+    auto rowIter = this->componentData.begin() + index * stride;
+    this->componentData.erase(rowIter, rowIter + stride);
+  }
+  if (SortedErase(this->toRemoveEntities, _entity))
+    ++this->toRemoveEntitiesVersion;
   this->toAddEntities.erase(_entity);
-  this->validData.erase(_entity);
-  this->validConstData.erase(_entity);
 
   return true;
 }
 
+//////////////////////////////////////////////////
+std::size_t View::RemoveEntities(const std::vector<Entity> &_entities)
+{
+  std::size_t removed{0u};
+  for (const Entity entity : _entities)
+  {
+    this->invalidData.erase(entity);
+    this->missingCompTracker.erase(entity);
+    const bool marked = this->toAddEntities.erase(entity) > 0u;
+    if (marked || this->HasEntity(entity))
+      ++removed;
+  }
+  if (removed == 0u)
+    return 0u;
+
+  // Compact the entities and their component rows, skipping the removed
+  // ones. Both lists are sorted, so they're walked together.
+  const auto stride = this->componentTypes.size();
+  auto removedIt = _entities.begin();
+  std::size_t kept{0u};
+  for (std::size_t i = 0u; i < this->entities.size(); ++i)
+  {
+    const Entity entity = this->entities[i];
+    while (removedIt != _entities.end() && *removedIt < entity)
+      ++removedIt;
+    if (removedIt != _entities.end() && *removedIt == entity)
+    {
+      if (entity < this->entityBits.size())
+        this->entityBits[entity] = false;
+      continue;
+    }
+
+    if (kept != i)
+    {
+      this->entities[kept] = entity;
+      std::copy_n(this->componentData.begin() + i * stride, stride,
+          this->componentData.begin() + kept * stride);
+    }
+    ++kept;
+  }
+  this->entities.resize(kept);
+  this->componentData.resize(kept * stride);
+
+  SortedErase(this->newEntities, _entities);
+  SortedErase(this->toRemoveEntities, _entities);
+  ++this->entitiesVersion;
+  ++this->newEntitiesVersion;
+  ++this->toRemoveEntitiesVersion;
+  return removed;
+}
+
+//////////////////////////////////////////////////
+bool View::ReplaceComponent(const Entity _entity,
+    const components::BaseComponent *_old, components::BaseComponent *_new)
+{
+  ComponentData::iterator begin;
+  ComponentData::iterator end;
+  const auto index = this->EntityIndex(_entity);
+  if (index != kInvalidIndex)
+  {
+    begin = this->componentData.begin() +
+        index * this->componentTypes.size();
+    end = begin + this->componentTypes.size();
+  }
+  else
+  {
+    auto invalidIter = this->invalidData.find(_entity);
+    if (invalidIter == this->invalidData.end())
+      return false;
+    begin = invalidIter->second.begin();
+    end = invalidIter->second.end();
+  }
+
+  auto compIter = std::find(begin, end, _old);
+  if (compIter == end)
+    return false;
+  *compIter = _new;
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool View::NotifyComponentAddition(const Entity _entity,
     bool _newEntity, const ComponentTypeId _typeId)
@@ -114,12 +212,11 @@ bool View::NotifyComponentAddition(const Entity _entity,
   if (missingCompsIter->second.empty())
   {
     auto nh = this->invalidData.extract(_entity);
-    this->validData.insert(std::move(nh));
-    auto constCompNh = this->invalidConstData.extract(_entity);
-    this->validConstData.insert(std::move(constCompNh));
-    this->entities.insert(_entity);
-    if (_newEntity)
-      this->newEntities.insert(_entity);
+    if (!nh.empty())
+    {
+      const auto &data = nh.mapped();
+      this->AddEntity(_entity, _newEntity, data.data());
+    }
     this->missingCompTracker.erase(_entity);
   }
 
@@ -141,19 +238,15 @@ bool View::NotifyComponentRemoval(const Entity _entity,
     return false;
 
   // if the component being removed is the first component that causes _entity
-  // to be invalid for this view, move _entity from validData to invalidData
-  // since _entity should no longer be considered a part of the view
-  auto it = this->validData.find(_entity);
-  auto constCompIt = this->validConstData.find(_entity);
-  if (it != this->validData.end() &&
-      constCompIt != this->validConstData.end())
+  // to be invalid for this view, move _entity's data to invalidData since
+  // _entity should no longer be considered a part of the view
+  const auto index = this->EraseEntity(_entity);
+  if (index != kInvalidIndex)
   {
-    auto nh = this->validData.extract(it);
-    this->invalidData.insert(std::move(nh));
-    auto constCompNh = this->validConstData.extract(constCompIt);
-    this->invalidConstData.insert(std::move(constCompNh));
-    this->entities.erase(_entity);
-    this->newEntities.erase(_entity);
+    const auto stride = this->componentTypes.size();
+    auto rowIter = this->componentData.begin() + index * stride;
+    this->invalidData[_entity] = ComponentData(rowIter, rowIter + stride);
+    this->componentData.erase(rowIter, rowIter + stride);
   }
 
   this->missingCompTracker[_entity].insert(_typeId);
@@ -167,15 +260,17 @@ void View::Reset()
   // reset all data structures in the BaseView except for componentTypes since
   // the view always requires the types in componentTypes
   this->entities.clear();
+  this->entityBits.clear();
   this->newEntities.clear();
   this->toRemoveEntities.clear();
   this->toAddEntities.clear();
+  ++this->entitiesVersion;
+  ++this->newEntitiesVersion;
+  ++this->toRemoveEntitiesVersion;
 
   // reset all data structures unique to the templated view
-  this->validData.clear();
-  this->validConstData.clear();
+  this->componentData.clear();
   this->invalidData.clear();
-  this->invalidConstData.clear();
   this->missingCompTracker.clear();
 }
 
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "gz/sim/WaveField.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <gz/math/Helpers.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Number of fixed-point iterations which find the point of the
+/// surface above a horizontal position, when the waves move it sideways.
+static constexpr int kHeightIterations{4};
+
+/// \brief Private data for WaveField.
+class gz::sim::WaveField::Implementation
+{
+  /// \brief Compute the horizontal displacement of the surface at rest
+  /// positions.
+  /// \param[in] _time Simulation time.
+  /// \param[in] _x X of each rest position.
+  /// \param[in] _y Y of each rest position.
+  /// \param[out] _dx Displacement along x of each position.
+  /// \param[out] _dy Displacement along y of each position.
+  public: void Horizontal(double _time, const std::vector<double> &_x,
+              const std::vector<double> &_y, std::vector<double> &_dx,
+              std::vector<double> &_dy) const;
+
+  /// \brief Compute the height of the surface at rest positions.
+  /// \param[in] _time Simulation time.
+  /// \param[in] _x X of each rest position.
+  /// \param[in] _y Y of each rest position.
+  /// \param[out] _z Height of each position.
+  public: void Vertical(double _time, const std::vector<double> &_x,
+              const std::vector<double> &_y, std::vector<double> &_z) const;
+
+  /// \brief Waves, as given.
+  public: std::vector<Wave> waves;
+
+  /// \brief Magnitude of gravity.
+  public: double gravity{9.80665};
+
+  /// \brief Wave number times the x component of the direction, per wave.
+  public: std::vector<double> kx;
+
+  /// \brief Wave number times the y component of the direction, per wave.
+  public: std::vector<double> ky;
+
+  /// \brief Wave number, per wave.
+  public: std::vector<double> k;
+
+  /// \brief Angular frequency, per wave.
+  public: std::vector<double> omega;
+
+  /// \brief Amplitude, per wave.
+  public: std::vector<double> amplitude;
+
+  /// \brief Phase at the origin at time 0, per wave.
+  public: std::vector<double> phase;
+
+  /// \brief Horizontal amplitude times the x component of the direction,
+  /// per wave.
+  public: std::vector<double> hx;
+
+  /// \brief Horizontal amplitude times the y component of the direction,
+  /// per wave.
+  public: std::vector<double> hy;
+
+  /// \brief Whether any wave moves the surface sideways.
+  public: bool horizontal{false};
+};
+
+//////////////////////////////////////////////////
+void WaveField::Implementation::Horizontal(double _time,
+    const std::vector<double> &_x, const std::vector<double> &_y,
+    std::vector<double> &_dx, std::vector<double> &_dy) const
+{
+  const std::size_t count = _x.size();
+  _dx.assign(count, 0.0);
+  _dy.assign(count, 0.0);
+  for (std::size_t w = 0u; w < this->waves.size(); ++w)
+  {
+    const double kxw = this->kx[w];
+    const double kyw = this->ky[w];
+    const double offset = this->phase[w] - this->omega[w] * _time;
+    const double hxw = this->hx[w];
+    const double hyw = this->hy[w];
+    if (hxw == 0.0 && hyw == 0.0)
+      continue;
+    for (std::size_t p = 0u; p < count; ++p)
+    {
+      const double s = std::sin(kxw * _x[p] + kyw * _y[p] + offset);
+      _dx[p] -= hxw * s;
+      _dy[p] -= hyw * s;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void WaveField::Implementation::Vertical(double _time,
+    const std::vector<double> &_x, const std::vector<double> &_y,
+    std::vector<double> &_z) const
+{
+  const std::size_t count = _x.size();
+  _z.assign(count, 0.0);
+  for (std::size_t w = 0u; w < this->waves.size(); ++w)
+  {
+    const double kxw = this->kx[w];
+    const double kyw = this->ky[w];
+    const double offset = this->phase[w] - this->omega[w] * _time;
+    const double a = this->amplitude[w];
+    for (std::size_t p = 0u; p < count; ++p)
+      _z[p] += a * std::cos(kxw * _x[p] + kyw * _y[p] + offset);
+  }
+}
+
+//////////////////////////////////////////////////
+WaveField::WaveField()
+  : dataPtr(utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+WaveField::WaveField(const std::vector<Wave> &_waves, double _gravity)
+  : dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->gravity = _gravity;
+  for (const auto &wave : _waves)
+  {
+    if (wave.amplitude == 0.0 || !(wave.wavelength > 0.0))
+      continue;
+
+    // Dispersion of waves in deep water
+    const double k = 2.0 * GZ_PI / wave.wavelength;
+    const double dirX = std::cos(wave.direction);
+    const double dirY = std::sin(wave.direction);
+    const double h = std::clamp(wave.steepness, 0.0, 1.0) * wave.amplitude;
+
+    this->dataPtr->waves.push_back(wave);
+    this->dataPtr->kx.push_back(k * dirX);
+    this->dataPtr->ky.push_back(k * dirY);
+    this->dataPtr->k.push_back(k);
+    this->dataPtr->omega.push_back(std::sqrt(std::abs(_gravity) * k));
+    this->dataPtr->amplitude.push_back(wave.amplitude);
+    this->dataPtr->phase.push_back(wave.phase);
+    this->dataPtr->hx.push_back(h * dirX);
+    this->dataPtr->hy.push_back(h * dirY);
+    this->dataPtr->horizontal |= h != 0.0;
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<WaveField::Wave> WaveField::FromSpectrum(
+    const Spectrum &_spectrum, double _gravity)
+{
+  std::vector<Wave> waves;
+  if (!(_spectrum.windSpeed > 0.0) || _spectrum.count == 0u)
+    return waves;
+
+  // Sample frequencies around the peak, where nearly all of the energy is
+  const double g = std::abs(_gravity);
+  const double omega0 = g / _spectrum.windSpeed;
+  const double peak = 0.877 * omega0;
+  const double first = 0.5 * peak;
+  const double last = 3.0 * peak;
+  const double step = (last - first) / static_cast<double>(_spectrum.count);
+
+  // The raw output of the generator is the same on all platforms, unlike
+  // the standard distributions
+  std::mt19937 generator(_spectrum.seed);
+  auto uniform = [&generator]()
+  {
+    return static_cast<double>(generator()) / 4294967296.0;
+  };
+
+  for (std::size_t i = 0u; i < _spectrum.count; ++i)
+  {
+    const double omega = first + (static_cast<double>(i) + 0.5) * step;
+    const double density = 8.1e-3 * g * g / std::pow(omega, 5.0) *
+        std::exp(-0.74 * std::pow(omega0 / omega, 4.0));
+
+    Wave wave;
+    wave.amplitude = std::sqrt(2.0 * density * step);
+    wave.wavelength = 2.0 * GZ_PI * g / (omega * omega);
+    wave.direction = _spectrum.windDirection +
+        _spectrum.spread * (2.0 * uniform() - 1.0);
+    wave.phase = 2.0 * GZ_PI * uniform();
+    wave.steepness = _spectrum.steepness;
+    waves.push_back(wave);
+  }
+  return waves;
+}
+
+//////////////////////////////////////////////////
+const std::vector<WaveField::Wave> &WaveField::Waves() const
+{
+  return this->dataPtr->waves;
+}
+
+//////////////////////////////////////////////////
+double WaveField::Gravity() const
+{
+  return this->dataPtr->gravity;
+}
+
+//////////////////////////////////////////////////
+double WaveField::Height(double _time, const math::Vector2d &_position) const
+{
+  std::vector<double> heights;
+  this->Heights(_time, {_position}, heights);
+  return heights.front();
+}
+
+//////////////////////////////////////////////////
+void WaveField::Heights(double _time,
+    const std::vector<math::Vector2d> &_positions,
+    std::vector<double> &_heights) const
+{
+  const std::size_t count = _positions.size();
+  std::vector<double> x(count);
+  std::vector<double> y(count);
+  for (std::size_t p = 0u; p < count; ++p)
+  {
+    x[p] = _positions[p].X();
+    y[p] = _positions[p].Y();
+  }
+
+  // Find the rest position whose displaced point is above each position.
+  // The iteration converges as long as the crests don't fold over.
+  if (this->dataPtr->horizontal)
+  {
+    std::vector<double> restX(x);
+    std::vector<double> restY(y);
+    std::vector<double> dx;
+    std::vector<double> dy;
+    for (int i = 0; i < kHeightIterations; ++i)
+    {
+      this->dataPtr->Horizontal(_time, restX, restY, dx, dy);
+      for (std::size_t p = 0u; p < count; ++p)
+      {
+        restX[p] = x[p] - dx[p];
+        restY[p] = y[p] - dy[p];
+      }
+    }
+    x.swap(restX);
+    y.swap(restY);
+  }
+  this->dataPtr->Vertical(_time, x, y, _heights);
+}
+
+//////////////////////////////////////////////////
+math::Vector3d WaveField::Velocity(double _time,
+    const math::Vector3d &_position) const
+{
+  std::vector<math::Vector3d> velocities;
+  this->Velocities(_time, {_position}, velocities);
+  return velocities.front();
+}
+
+//////////////////////////////////////////////////
+void WaveField::Velocities(double _time,
+    const std::vector<math::Vector3d> &_positions,
+    std::vector<math::Vector3d> &_velocities) const
+{
+  const std::size_t count = _positions.size();
+  std::vector<double> x(count);
+  std::vector<double> y(count);
+  std::vector<double> z(count);
+  for (std::size_t p = 0u; p < count; ++p)
+  {
+    x[p] = _positions[p].X();
+    y[p] = _positions[p].Y();
+    z[p] = std::min(_positions[p].Z(), 0.0);
+  }
+
+  // Orbital velocity of linear waves, which decays exponentially with
+  // depth
+  std::vector<double> u(count, 0.0);
+  std::vector<double> v(count, 0.0);
+  std::vector<double> w(count, 0.0);
+  const auto &data = *this->dataPtr;
+  for (std::size_t i = 0u; i < data.waves.size(); ++i)
+  {
+    const double kxw = data.kx[i];
+    const double kyw = data.ky[i];
+    const double kw = data.k[i];
+    const double offset = data.phase[i] - data.omega[i] * _time;
+    const double speed = data.amplitude[i] * data.omega[i];
+    const double dirX = kxw / kw;
+    const double dirY = kyw / kw;
+    for (std::size_t p = 0u; p < count; ++p)
+    {
+      const double theta = kxw * x[p] + kyw * y[p] + offset;
+      const double orbit = speed * std::exp(kw * z[p]);
+      const double c = orbit * std::cos(theta);
+      u[p] += c * dirX;
+      v[p] += c * dirY;
+      w[p] += orbit * std::sin(theta);
+    }
+  }
+
+  _velocities.resize(count);
+  for (std::size_t p = 0u; p < count; ++p)
+    _velocities[p].Set(u[p], v[p], w[p]);
+}
+
+//////////////////////////////////////////////////
+void WaveField::Displacements(double _time,
+    const std::vector<math::Vector2d> &_rest,
+    std::vector<math::Vector3d> &_points) const
+{
+  const std::size_t count = _rest.size();
+  std::vector<double> x(count);
+  std::vector<double> y(count);
+  for (std::size_t p = 0u; p < count; ++p)
+  {
+    x[p] = _rest[p].X();
+    y[p] = _rest[p].Y();
+  }
+
+  std::vector<double> dx;
+  std::vector<double> dy;
+  std::vector<double> z;
+  this->dataPtr->Horizontal(_time, x, y, dx, dy);
+  this->dataPtr->Vertical(_time, x, y, z);
+
+  _points.resize(count);
+  for (std::size_t p = 0u; p < count; ++p)
+    _points[p].Set(x[p] + dx[p], y[p] + dy[p], z[p]);
+}
+
+//////////////////////////////////////////////////
+std::ostream &gz::sim::operator<<(std::ostream &_out,
+    const WaveField &_field)
+{
+  const auto precision = _out.precision(
+      std::numeric_limits<double>::max_digits10);
+  _out << _field.Gravity() << " " << _field.Waves().size();
+  for (const auto &wave : _field.Waves())
+  {
+    _out << " " << wave.amplitude << " " << wave.wavelength << " "
+         << wave.direction << " " << wave.phase << " " << wave.steepness;
+  }
+  _out.precision(precision);
+  return _out;
+}
+
+//////////////////////////////////////////////////
+std::istream &gz::sim::operator>>(std::istream &_in, WaveField &_field)
+{
+  double gravity;
+  std::size_t count;
+  if (!(_in >> gravity >> count))
+    return _in;
+
+  std::vector<WaveField::Wave> waves;
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    WaveField::Wave wave;
+    if (!(_in >> wave.amplitude >> wave.wavelength >> wave.direction
+              >> wave.phase >> wave.steepness))
+    {
+      return _in;
+    }
+    waves.push_back(wave);
+  }
+  _field = WaveField(waves, gravity);
+  return _in;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+
+#include "gz/sim/WaveField.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(WaveField, Flat)
+{
+  WaveField flat;
+  EXPECT_TRUE(flat.Waves().empty());
+  EXPECT_DOUBLE_EQ(0.0, flat.Height(3.0, {1, 2}));
+  EXPECT_EQ(math::Vector3d::Zero, flat.Velocity(3.0, {1, 2, -1}));
+
+  // Waves without an amplitude or a wavelength are dropped
+  WaveField::Wave still;
+  WaveField::Wave degenerate;
+  degenerate.amplitude = 1.0;
+  degenerate.wavelength = 0.0;
+  EXPECT_TRUE(WaveField({still, degenerate}).Waves().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(WaveField, SineWave)
+{
+  WaveField::Wave wave;
+  wave.amplitude = 0.5;
+  wave.wavelength = 10.0;
+  wave.phase = 0.3;
+  const double g = 9.8;
+  WaveField field({wave}, g);
+
+  // Deep water dispersion sets the period
+  const double k = 2.0 * GZ_PI / wave.wavelength;
+  const double omega = std::sqrt(g * k);
+  const double period = 2.0 * GZ_PI / omega;
+  EXPECT_NEAR(0.5 * std::cos(0.3), field.Height(0.0, {0, 0}), 1e-12);
+  EXPECT_NEAR(0.5 * std::cos(0.3), field.Height(period, {0, 0}), 1e-12);
+  EXPECT_NEAR(0.5 * std::cos(0.3), field.Height(0.0, {10, 7}), 1e-12);
+  EXPECT_NEAR(0.5 * std::cos(k * 2.5 + 0.3), field.Height(0.0, {2.5, 0}),
+      1e-12);
+
+  // The water at the surface moves up as fast as the surface does
+  const double dt = 1e-6;
+  const double time = 1.3;
+  const math::Vector2d position{1.7, 0};
+  const double rise = (field.Height(time + dt, position) -
+      field.Height(time - dt, position)) / (2 * dt);
+  const auto velocity = field.Velocity(time, {1.7, 0, 0});
+  EXPECT_NEAR(rise, velocity.Z(), 1e-6);
+  EXPECT_NEAR(0.0, velocity.Y(), 1e-12);
+
+  // Orbits shrink with depth, and don't grow above the mean surface
+  const auto deep = field.Velocity(time, {1.7, 0, -3});
+  EXPECT_NEAR(velocity.X() * std::exp(-3 * k), deep.X(), 1e-12);
+  EXPECT_EQ(velocity, field.Velocity(time, {1.7, 0, 2}));
+}
+
+/////////////////////////////////////////////////
+TEST(WaveField, Gerstner)
+{
+  WaveField::Wave first;
+  first.amplitude = 0.4;
+  first.wavelength = 12.0;
+  first.direction = 0.2;
+  first.steepness = 0.8;
+  WaveField::Wave second;
+  second.amplitude = 0.2;
+  second.wavelength = 5.0;
+  second.direction = -0.7;
+  second.phase = 1.0;
+  second.steepness = 0.5;
+  WaveField field({first, second});
+
+  std::vector<math::Vector2d> rest;
+  for (int i = 0; i < 20; ++i)
+    rest.push_back({0.7 * i - 3.0, 0.3 * i});
+  std::vector<math::Vector3d> points;
+  field.Displacements(2.0, rest, points);
+  ASSERT_EQ(rest.size(), points.size());
+
+  // Points move sideways, and the height above where they moved to is
+  // their height
+  std::vector<math::Vector2d> horizontal;
+  bool moved{false};
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    horizontal.push_back({points[i].X(), points[i].Y()});
+    moved |= std::abs(points[i].X() - rest[i].X()) > 1e-3;
+  }
+  EXPECT_TRUE(moved);
+
+  std::vector<double> heights;
+  field.Heights(2.0, horizontal, heights);
+  ASSERT_EQ(points.size(), heights.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_NEAR(points[i].Z(), heights[i], 1e-3) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(WaveField, Spectrum)
+{
+  WaveField::Spectrum spectrum;
+  spectrum.windSpeed = 10.0;
+  spectrum.count = 64u;
+  spectrum.seed = 3u;
+  const auto waves = WaveField::FromSpectrum(spectrum, 9.81);
+  ASSERT_EQ(64u, waves.size());
+
+  // The same parameters give the same waves
+  const auto again = WaveField::FromSpectrum(spectrum, 9.81);
+  for (std::size_t i = 0; i < waves.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(waves[i].phase, again[i].phase);
+    EXPECT_DOUBLE_EQ(waves[i].direction, again[i].direction);
+    EXPECT_LE(std::abs(waves[i].direction), spectrum.spread);
+  }
+
+  // Significant wave height of a fully developed sea, 0.21 U^2 / g
+  double variance{0.0};
+  for (const auto &wave : waves)
+    variance += 0.5 * wave.amplitude * wave.amplitude;
+  EXPECT_NEAR(0.21 * 100 / 9.81, 4.0 * std::sqrt(variance), 0.1);
+
+  spectrum.windSpeed = 0.0;
+  EXPECT_TRUE(WaveField::FromSpectrum(spectrum).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(WaveField, Serialization)
+{
+  WaveField::Spectrum spectrum;
+  spectrum.steepness = 0.4;
+  WaveField field(WaveField::FromSpectrum(spectrum), 3.7);
+
+  std::stringstream stream;
+  stream << field;
+  WaveField copy;
+  stream >> copy;
+  ASSERT_EQ(field.Waves().size(), copy.Waves().size());
+  EXPECT_DOUBLE_EQ(3.7, copy.Gravity());
+  EXPECT_DOUBLE_EQ(field.Height(4.2, {3, -1}), copy.Height(4.2, {3, -1}));
+
+  // Invalid input leaves the field as it was
+  std::stringstream invalid("9.8 2 1 1 0 0");
+  invalid >> copy;
+  EXPECT_EQ(field.Waves().size(), copy.Waves().size());
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "WorldCache.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <sdf/Element.hh>
+#include <sdf/OutputConfig.hh>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/Uuid.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Version of the stored files. Bump it whenever the format or the
+/// way worlds are loaded changes, so older worlds aren't reused.
+static const char kWorldCacheVersion[] = "gz-sim-world 1";
+
+/// \brief Private data for the WorldCache class.
+class gz::sim::WorldCachePrivate
+{
+  /// \brief Get the path of the file of a key.
+  /// \param[in] _key The key.
+  /// \return Path of the file.
+  public: std::string File(const std::string &_key) const
+  {
+    return common::joinPaths(this->directory, _key + ".sdf");
+  }
+
+  /// \brief Directory where worlds are stored.
+  public: std::string directory;
+};
+
+//////////////////////////////////////////////////
+WorldCache::WorldCache(const std::string &_directory)
+  : dataPtr(std::make_unique<WorldCachePrivate>())
+{
+  this->dataPtr->directory = _directory;
+}
+
+//////////////////////////////////////////////////
+WorldCache::~WorldCache() = default;
+
+//////////////////////////////////////////////////
+std::string WorldCache::Directory(const ServerConfig &_config)
+{
+  if (!_config.WorldCache().empty())
+    return _config.WorldCache();
+
+  std::string directory;
+  common::env(kWorldCachePathEnv, directory);
+  return directory;
+}
+
+//////////////////////////////////////////////////
+std::string WorldCache::Key(const std::string &_worldFile,
+    const ServerConfig &_config) const
+{
+  if (this->dataPtr->directory.empty())
+    return std::string();
+
+  std::ifstream file(_worldFile, std::ios::binary);
+  if (!file)
+    return std::string();
+  const std::string content{std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+
+  // Includes are resolved against the world's directory and the resource
+  // paths, so they're part of the key, as well as the plugins added by the
+  // server, which are part of the loaded world
+  std::string resourcePath;
+  common::env("GZ_SIM_RESOURCE_PATH", resourcePath);
+  std::ostringstream stream;
+  stream << kWorldCacheVersion << "\n"
+         << GZ_SIM_VERSION_FULL << "\n"
+         << _worldFile << "\n"
+         << common::sha1(content) << "\n"
+         << resourcePath << "\n"
+         << _config.ResourceCache() << "\n";
+  for (const auto &plugin : _config.Plugins())
+  {
+    stream << plugin.EntityName() << " " << plugin.EntityType() << "\n"
+           << plugin.Plugin().ToElement()->ToString("") << "\n";
+  }
+  return common::sha1(stream.str());
+}
+
+//////////////////////////////////////////////////
+std::optional<std::string> WorldCache::Load(const std::string &_key) const
+{
+  if (_key.empty())
+    return std::nullopt;
+
+  std::ifstream file(this->dataPtr->File(_key), std::ios::binary);
+  if (!file)
+    return std::nullopt;
+
+  std::string version;
+  std::getline(file, version);
+  if (version != kWorldCacheVersion)
+  {
+    gzwarn << "Ignoring invalid cached world ["
+           << this->dataPtr->File(_key) << "]." << std::endl;
+    return std::nullopt;
+  }
+
+  return std::string{std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+}
+
+//////////////////////////////////////////////////
+bool WorldCache::Save(const std::string &_key, const sdf::Root &_root) const
+{
+  if (_key.empty())
+    return false;
+
+  // Included models are expanded, so loading the world doesn't fetch them
+  sdf::OutputConfig outputConfig;
+  outputConfig.SetToElementUseIncludeTag(false);
+  const auto element = _root.ToElement(outputConfig);
+  if (nullptr == element)
+    return false;
+
+  if (!common::isDirectory(this->dataPtr->directory) &&
+      !common::createDirectories(this->dataPtr->directory))
+  {
+    gzwarn << "Failed to create world cache ["
+           << this->dataPtr->directory << "]." << std::endl;
+    return false;
+  }
+
+  // Write to a unique file and move it in place, so readers never see a
+  // partially written file
+  const auto path = this->dataPtr->File(_key);
+  const auto tmpPath = path + "." + common::Uuid().String() + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    if (!file)
+      return false;
+
+    file << kWorldCacheVersion << "\n" << element->ToString("");
+    if (!file)
+    {
+      file.close();
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  // Another process may have stored the same world in the meantime
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+  {
+    std::remove(tmpPath.c_str());
+    return common::exists(path);
+  }
+  return true;
+}
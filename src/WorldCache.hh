@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_WORLDCACHE_HH_
+#define GZ_SIM_WORLDCACHE_HH_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <sdf/Root.hh>
+
+#include <gz/sim/Export.hh>
+#include <gz/sim/ServerConfig.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    // Forward declarations.
+    class WorldCachePrivate;
+
+    /// \brief Environment variable holding the directory where loaded worlds
+    /// are stored, used when ServerConfig::WorldCache isn't set. The cache
+    /// is disabled if neither is set.
+    const std::string kWorldCachePathEnv{"GZ_SIM_WORLD_CACHE"};
+
+    /// \class WorldCache WorldCache.hh
+    /// \brief Cache of loaded world files stored on disk, so that launching
+    /// the same world again doesn't resolve its includes, fetch its
+    /// resources or compute its inertias.
+    ///
+    /// Each world is stored as a single SDF document, with its included
+    /// models expanded, its URIs resolved and its automatic inertias
+    /// computed, in a file named after a key derived from the content of
+    /// the world file, the resource paths and the server plugins. Files are
+    /// written atomically, so several processes can share a directory.
+    /// Editing a model included by a world doesn't change the key, so the
+    /// cache must be cleared, by deleting its directory, when included
+    /// models change.
+    class GZ_SIM_VISIBLE WorldCache
+    {
+      /// \brief Constructor
+      /// \param[in] _directory Directory where worlds are stored. It's
+      /// created when the first world is saved. An empty directory disables
+      /// the cache.
+      public: explicit WorldCache(const std::string &_directory);
+
+      /// \brief Destructor
+      public: ~WorldCache();
+
+      /// \brief Get the directory of the cache used by a server.
+      /// \param[in] _config Configuration of the server.
+      /// \return ServerConfig::WorldCache if it's set, otherwise the value of
+      /// kWorldCachePathEnv, possibly empty.
+      public: static std::string Directory(const ServerConfig &_config);
+
+      /// \brief Get the key of a world file loaded by a server.
+      /// \param[in] _worldFile Absolute path of the world file.
+      /// \param[in] _config Configuration of the server.
+      /// \return The key, or an empty string if the cache is disabled or the
+      /// file can't be read.
+      public: std::string Key(const std::string &_worldFile,
+                  const ServerConfig &_config) const;
+
+      /// \brief Load a stored world.
+      /// \param[in] _key Key of the world.
+      /// \return SDF of the world, or nullopt if it isn't stored or its file
+      /// is invalid.
+      public: std::optional<std::string> Load(const std::string &_key) const;
+
+      /// \brief Store a loaded world.
+      /// \param[in] _key Key of the world.
+      /// \param[in] _root Root holding the world.
+      /// \return True if it was stored.
+      public: bool Save(const std::string &_key,
+                  const sdf::Root &_root) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldCachePrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
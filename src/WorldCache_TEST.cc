@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/sim/ServerConfig.hh"
+#include "WorldCache.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief World with a single model.
+static const char kWorld[] = R"(<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="cached">
+    <model name="box">
+      <link name="link">
+        <pose>1 2 3 0 0 0</pose>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream file(_path);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(WorldCache, Directory)
+{
+  common::unsetenv(kWorldCachePathEnv);
+  ServerConfig config;
+  EXPECT_TRUE(WorldCache::Directory(config).empty());
+
+  common::setenv(kWorldCachePathEnv, "env_dir");
+  EXPECT_EQ("env_dir", WorldCache::Directory(config));
+
+  // The server configuration takes precedence
+  config.SetWorldCache("config_dir");
+  EXPECT_EQ("config_dir", WorldCache::Directory(config));
+  common::unsetenv(kWorldCachePathEnv);
+}
+
+/////////////////////////////////////////////////
+TEST(WorldCache, Key)
+{
+  common::TempDirectory tempDir("world_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto worldFile = common::joinPaths(tempDir.Path(), "world.sdf");
+  writeFile(worldFile, kWorld);
+
+  WorldCache cache(common::joinPaths(tempDir.Path(), "cache"));
+  ServerConfig config;
+  const auto key = cache.Key(worldFile, config);
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(key, cache.Key(worldFile, config));
+
+  // Server plugins are part of the key
+  ServerConfig pluginConfig;
+  sdf::Plugin plugin("gz-sim-physics-system", "gz::sim::systems::Physics");
+  pluginConfig.AddPlugin(ServerConfig::PluginInfo("cached", "world",
+      plugin));
+  EXPECT_NE(key, cache.Key(worldFile, pluginConfig));
+
+  // Any change of the world file changes the key
+  writeFile(worldFile, std::string(kWorld) + "\n");
+  EXPECT_NE(key, cache.Key(worldFile, config));
+
+  // Missing files and disabled caches have no keys
+  EXPECT_TRUE(cache.Key(worldFile + "_missing", config).empty());
+  EXPECT_TRUE(WorldCache("").Key(worldFile, config).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(WorldCache, SaveLoad)
+{
+  common::TempDirectory tempDir("world_cache", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto worldFile = common::joinPaths(tempDir.Path(), "world.sdf");
+  writeFile(worldFile, kWorld);
+
+  // The directory is created on demand
+  const auto directory = common::joinPaths(tempDir.Path(), "a", "b");
+  WorldCache cache(directory);
+  const auto key = cache.Key(worldFile, ServerConfig());
+  EXPECT_FALSE(cache.Load(key).has_value());
+
+  sdf::Root root;
+  ASSERT_TRUE(root.Load(worldFile).empty());
+  EXPECT_TRUE(cache.Save(key, root));
+  EXPECT_TRUE(common::isDirectory(directory));
+
+  // Another instance using the same directory loads the same world
+  const auto loaded = WorldCache(directory).Load(key);
+  ASSERT_TRUE(loaded.has_value());
+  sdf::Root loadedRoot;
+  ASSERT_TRUE(loadedRoot.LoadSdfString(*loaded).empty());
+  ASSERT_EQ(1u, loadedRoot.WorldCount());
+  const auto *world = loadedRoot.WorldByIndex(0);
+  EXPECT_EQ("cached", world->Name());
+  ASSERT_NE(nullptr, world->ModelByName("box"));
+  EXPECT_NE(nullptr, world->ModelByName("box")->LinkByName("link"));
+
+  // Files that aren't cached worlds are ignored
+  writeFile(common::joinPaths(directory, key + ".sdf"), kWorld);
+  EXPECT_FALSE(cache.Load(key).has_value());
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gz/sim/WrenchAccumulator.hh"
+
+#include <gz/msgs/wrench.pb.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gz/msgs/Utility.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/components/ExternalWorldWrenchCmd.hh"
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief A wrench added to a link.
+struct Entry
+{
+  /// \brief The link.
+  Entity link;
+
+  /// \brief Force in world coordinates.
+  math::Vector3d force;
+
+  /// \brief Torque in world coordinates.
+  math::Vector3d torque;
+};
+
+/// \brief Wrenches added by some of the threads. Shards are aligned to
+/// cache lines so threads adding to different shards don't share one.
+struct alignas(64) Shard
+{
+  /// \brief Protects entries.
+  std::mutex mutex;
+
+  /// \brief Added wrenches.
+  std::vector<Entry> entries;
+};
+
+/// \brief Get the bits of a number, which are totally ordered even for
+/// NaN.
+/// \param[in] _value The number.
+/// \return Its bits.
+std::uint64_t bits(const double _value)
+{
+  std::uint64_t result;
+  std::memcpy(&result, &_value, sizeof(result));
+  return result;
+}
+
+/// \brief Get a key that orders wrenches by link, then by value.
+/// \param[in] _entry The wrench.
+/// \return The key.
+auto key(const Entry &_entry)
+{
+  return std::make_tuple(_entry.link,
+      bits(_entry.force.X()), bits(_entry.force.Y()), bits(_entry.force.Z()),
+      bits(_entry.torque.X()), bits(_entry.torque.Y()),
+      bits(_entry.torque.Z()));
+}
+}
+
+/// \brief Private data for WrenchAccumulator.
+class gz::sim::WrenchAccumulator::Implementation
+{
+  /// \brief Get the shard of the calling thread.
+  /// \return The shard.
+  public: Shard &ThreadShard()
+  {
+    const auto hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return this->shards[hash % this->shardCount];
+  }
+
+  /// \brief Number of shards.
+  public: std::size_t shardCount{std::max(1u,
+      std::thread::hardware_concurrency())};
+
+  /// \brief Buffers of added wrenches.
+  public: std::unique_ptr<Shard[]> shards{
+      std::make_unique<Shard[]>(this->shardCount)};
+
+  /// \brief Wrenches of all shards, kept to reuse its memory.
+  public: std::vector<Entry> merged;
+};
+
+namespace
+{
+/// \brief Sort wrenches by link, then by value.
+/// \param[in] _entries The wrenches.
+void sortEntries(std::vector<Entry> &_entries)
+{
+  // Which shard a wrench is in depends on thread scheduling, so sort them
+  // to sum them in the same order every run
+  std::sort(_entries.begin(), _entries.end(),
+      [](const Entry &_a, const Entry &_b)
+      {
+        return key(_a) < key(_b);
+      });
+}
+}
+
+//////////////////////////////////////////////////
+WrenchAccumulator::WrenchAccumulator()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+void WrenchAccumulator::Add(const Entity _link, const math::Vector3d &_force,
+    const math::Vector3d &_torque)
+{
+  auto &shard = this->dataPtr->ThreadShard();
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.entries.push_back({_link, _force, _torque});
+}
+
+//////////////////////////////////////////////////
+bool WrenchAccumulator::Wrench(const Entity _link, math::Vector3d &_force,
+    math::Vector3d &_torque) const
+{
+  std::vector<Entry> entries;
+  for (std::size_t i = 0; i < this->dataPtr->shardCount; ++i)
+  {
+    auto &shard = this->dataPtr->shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (const auto &entry : shard.entries)
+    {
+      if (entry.link == _link)
+        entries.push_back(entry);
+    }
+  }
+  sortEntries(entries);
+
+  _force = math::Vector3d::Zero;
+  _torque = math::Vector3d::Zero;
+  for (const auto &entry : entries)
+  {
+    _force += entry.force;
+    _torque += entry.torque;
+  }
+  return !entries.empty();
+}
+
+//////////////////////////////////////////////////
+std::size_t WrenchAccumulator::Size() const
+{
+  std::size_t size{0u};
+  for (std::size_t i = 0; i < this->dataPtr->shardCount; ++i)
+  {
+    auto &shard = this->dataPtr->shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size += shard.entries.size();
+  }
+  return size;
+}
+
+//////////////////////////////////////////////////
+void WrenchAccumulator::Apply(EntityComponentManager &_ecm)
+{
+  auto &merged = this->dataPtr->merged;
+  merged.clear();
+  for (std::size_t i = 0; i < this->dataPtr->shardCount; ++i)
+  {
+    auto &shard = this->dataPtr->shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    merged.insert(merged.end(), shard.entries.begin(), shard.entries.end());
+    shard.entries.clear();
+  }
+  if (merged.empty())
+    return;
+  sortEntries(merged);
+
+  for (std::size_t begin = 0; begin < merged.size();)
+  {
+    const Entity link = merged[begin].link;
+    math::Vector3d force;
+    math::Vector3d torque;
+    std::size_t end = begin;
+    for (; end < merged.size() && merged[end].link == link; ++end)
+    {
+      force += merged[end].force;
+      torque += merged[end].torque;
+    }
+    begin = end;
+
+    if (!_ecm.HasEntity(link))
+      continue;
+
+    auto wrenchComp = _ecm.Component<components::ExternalWorldWrenchCmd>(link);
+    if (nullptr == wrenchComp)
+    {
+      msgs::Wrench wrench;
+      msgs::Set(wrench.mutable_force(), force);
+      msgs::Set(wrench.mutable_torque(), torque);
+      _ecm.CreateComponent(link, components::ExternalWorldWrenchCmd(wrench));
+      continue;
+    }
+    msgs::Set(wrenchComp->Data().mutable_force(),
+        msgs::Convert(wrenchComp->Data().force()) + force);
+    msgs::Set(wrenchComp->Data().mutable_torque(),
+        msgs::Convert(wrenchComp->Data().torque()) + torque);
+  }
+}
+
+//////////////////////////////////////////////////
+void WrenchAccumulator::Clear()
+{
+  for (std::size_t i = 0; i < this->dataPtr->shardCount; ++i)
+  {
+    auto &shard = this->dataPtr->shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.clear();
+  }
+}
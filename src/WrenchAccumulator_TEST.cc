@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/wrench.pb.h>
+
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/Utility.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/WrenchAccumulator.hh"
+#include "gz/sim/components/ExternalWorldWrenchCmd.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+TEST(WrenchAccumulator, Apply)
+{
+  EntityComponentManager ecm;
+  const Entity first = ecm.CreateEntity();
+  const Entity second = ecm.CreateEntity();
+
+  // The second link already has a wrench from another system
+  msgs::Wrench existing;
+  msgs::Set(existing.mutable_force(), math::Vector3d(0, 0, 1));
+  ecm.CreateComponent(second, components::ExternalWorldWrenchCmd(existing));
+
+  WrenchAccumulator accumulator;
+  accumulator.Add(first, {1, 0, 0}, {0, 1, 0});
+  accumulator.Add(first, {2, 0, 0}, {0, 0, 0});
+  accumulator.Add(second, {0, 0, 2}, {3, 0, 0});
+  accumulator.Add(kNullEntity + 100u, {1, 1, 1}, {1, 1, 1});
+  EXPECT_EQ(4u, accumulator.Size());
+
+  math::Vector3d force;
+  math::Vector3d torque;
+  EXPECT_TRUE(accumulator.Wrench(first, force, torque));
+  EXPECT_EQ(math::Vector3d(3, 0, 0), force);
+  EXPECT_EQ(math::Vector3d(0, 1, 0), torque);
+  EXPECT_FALSE(accumulator.Wrench(kNullEntity, force, torque));
+  EXPECT_EQ(math::Vector3d::Zero, force);
+
+  accumulator.Apply(ecm);
+  EXPECT_EQ(0u, accumulator.Size());
+
+  auto firstWrench = ecm.Component<components::ExternalWorldWrenchCmd>(first);
+  ASSERT_NE(nullptr, firstWrench);
+  EXPECT_EQ(math::Vector3d(3, 0, 0),
+      msgs::Convert(firstWrench->Data().force()));
+  EXPECT_EQ(math::Vector3d(0, 1, 0),
+      msgs::Convert(firstWrench->Data().torque()));
+
+  auto secondWrench =
+      ecm.Component<components::ExternalWorldWrenchCmd>(second);
+  ASSERT_NE(nullptr, secondWrench);
+  EXPECT_EQ(math::Vector3d(0, 0, 3),
+      msgs::Convert(secondWrench->Data().force()));
+  EXPECT_EQ(math::Vector3d(3, 0, 0),
+      msgs::Convert(secondWrench->Data().torque()));
+
+  // Clearing drops the wrenches
+  accumulator.Add(first, {1, 0, 0}, {0, 0, 0});
+  accumulator.Clear();
+  accumulator.Apply(ecm);
+  EXPECT_EQ(math::Vector3d(3, 0, 0),
+      msgs::Convert(firstWrench->Data().force()));
+}
+
+/////////////////////////////////////////////////
+TEST(WrenchAccumulator, Concurrent)
+{
+  EntityComponentManager ecm;
+  const Entity link = ecm.CreateEntity();
+
+  WrenchAccumulator accumulator;
+  constexpr int kThreads{4};
+  constexpr int kWrenches{1000};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      for (int i = 0; i < kWrenches; ++i)
+        accumulator.Add(link, {0.1 * (t + 1), 0, 0}, {0, 0, 0.5});
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(static_cast<std::size_t>(kThreads * kWrenches),
+      accumulator.Size());
+
+  accumulator.Apply(ecm);
+  auto wrench = ecm.Component<components::ExternalWorldWrenchCmd>(link);
+  ASSERT_NE(nullptr, wrench);
+  EXPECT_NEAR(1000.0, wrench->Data().force().x(), 1e-6);
+  EXPECT_NEAR(2000.0, wrench->Data().torque().z(), 1e-6);
+}
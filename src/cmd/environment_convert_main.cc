@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include <gz/common/Console.hh>
+
+#include "../EnvironmentGrid.hh"
+
+/// \brief Convert environmental data from CSV into a binary grid.
+/// Usage: gz-sim-environment-convert <csv> <grid> [time x y z]
+int main(int argc, char* argv[])
+{
+  if (argc != 3 && argc != 7)
+  {
+    std::cerr << "Usage: " << argv[0] << " <csv> <grid> [time x y z]"
+              << std::endl
+              << "Converts the environmental data in <csv> into a binary "
+              << "grid, which EnvironmentPreload maps instead of parsing. "
+              << "The names of the time and coordinate columns default to "
+              << "t, x, y and z." << std::endl;
+    return 1;
+  }
+
+  gz::common::Console::SetVerbosity(3);
+
+  std::string timeColumn{"t"};
+  std::array<std::string, 3> spatialColumns{"x", "y", "z"};
+  if (argc == 7)
+  {
+    timeColumn = argv[3];
+    spatialColumns = {argv[4], argv[5], argv[6]};
+  }
+
+  return gz::sim::EnvironmentGrid::ConvertCsv(argv[1], timeColumn,
+      spatialColumns, argv[2]) ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <iostream>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+
+#include "../StateRelay.hh"
+
+/// \brief Relay the state streams of a world to many GUIs.
+/// Usage: gz-sim-relay <world> [namespace]
+int main(int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <world> [namespace]" << std::endl
+              << "Republishes the state of <world> under [namespace], which "
+              << "defaults to /relay. Point GUIs at it with "
+              << "GZ_SIM_GUI_RELAY=<namespace>." << std::endl;
+    return 1;
+  }
+
+  gz::common::Console::SetVerbosity(3);
+
+  const std::string ns = argc == 3 ? argv[2] : "/relay";
+  gz::sim::StateRelay relay(argv[1], ns);
+  if (!relay.Start(30000u))
+    return 1;
+
+  gz::transport::waitForShutdown();
+  return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <sdf/Box.hh>
+#include <sdf/Capsule.hh>
+#include <sdf/Collision.hh>
+#include <sdf/Cylinder.hh>
+#include <sdf/Ellipsoid.hh>
+#include <sdf/Geometry.hh>
+#include <sdf/Link.hh>
+#include <sdf/Model.hh>
+#include <sdf/Root.hh>
+#include <sdf/Sphere.hh>
+#include <sdf/World.hh>
+
+#include "../systems/rf_comms/PathLossMap.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Get the pose of an SDF element in the frame it's relative to.
+/// \param[in] _semanticPose Semantic pose of the element.
+/// \param[in] _rawPose Pose used if it can't be resolved.
+/// \return The pose.
+template<typename SemanticPoseT>
+static math::Pose3d resolve(const SemanticPoseT &_semanticPose,
+                            const math::Pose3d &_rawPose)
+{
+  math::Pose3d pose;
+  if (!_semanticPose.Resolve(pose).empty())
+    return _rawPose;
+  return pose;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the half size of the box which bounds a geometry.
+/// \param[in] _geometry The geometry.
+/// \param[out] _halfSize Half of the size of the box.
+/// \return False if the geometry has no volume known here, such as meshes.
+static bool halfSize(const sdf::Geometry &_geometry, math::Vector3d &_halfSize)
+{
+  switch (_geometry.Type())
+  {
+    case sdf::GeometryType::BOX:
+      _halfSize = _geometry.BoxShape()->Size() * 0.5;
+      return true;
+    case sdf::GeometryType::CYLINDER:
+    {
+      const double r = _geometry.CylinderShape()->Radius();
+      _halfSize = {r, r, _geometry.CylinderShape()->Length() * 0.5};
+      return true;
+    }
+    case sdf::GeometryType::SPHERE:
+    {
+      const double r = _geometry.SphereShape()->Radius();
+      _halfSize = {r, r, r};
+      return true;
+    }
+    case sdf::GeometryType::CAPSULE:
+    {
+      const double r = _geometry.CapsuleShape()->Radius();
+      _halfSize = {r, r, _geometry.CapsuleShape()->Length() * 0.5 + r};
+      return true;
+    }
+    case sdf::GeometryType::ELLIPSOID:
+      _halfSize = _geometry.EllipsoidShape()->Radii();
+      return true;
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the world boxes bounding the collisions of a static model and
+/// of its nested models.
+/// \param[in] _model The model.
+/// \param[in] _pose World pose of the model.
+/// \param[in] _static True if a parent model is static.
+/// \param[out] _boxes The boxes.
+static void addObstacles(const sdf::Model &_model, const math::Pose3d &_pose,
+    bool _static, std::vector<math::AxisAlignedBox> &_boxes)
+{
+  const bool isStatic = _static || _model.Static();
+  for (uint64_t l = 0; isStatic && l < _model.LinkCount(); ++l)
+  {
+    const sdf::Link *link = _model.LinkByIndex(l);
+    const auto linkPose = _pose *
+        resolve(link->SemanticPose(), link->RawPose());
+    for (uint64_t c = 0; c < link->CollisionCount(); ++c)
+    {
+      const sdf::Collision *collision = link->CollisionByIndex(c);
+      math::Vector3d half;
+      if (!halfSize(*collision->Geom(), half))
+      {
+        std::cerr << "Skipping collision [" << collision->Name()
+                  << "] of link [" << link->Name() << "], whose geometry "
+                  << "isn't supported." << std::endl;
+        continue;
+      }
+
+      // Bound the corners of the rotated box
+      const auto pose = linkPose *
+          resolve(collision->SemanticPose(), collision->RawPose());
+      math::Vector3d min(math::INF_D, math::INF_D, math::INF_D);
+      math::Vector3d max(-math::INF_D, -math::INF_D, -math::INF_D);
+      for (int corner = 0; corner < 8; ++corner)
+      {
+        const math::Vector3d local(
+            (corner & 1) ? half.X() : -half.X(),
+            (corner & 2) ? half.Y() : -half.Y(),
+            (corner & 4) ? half.Z() : -half.Z());
+        const auto world = pose.Pos() + pose.Rot().RotateVector(local);
+        min.Min(world);
+        max.Max(world);
+      }
+      _boxes.emplace_back(min, max);
+    }
+  }
+
+  for (uint64_t m = 0; m < _model.ModelCount(); ++m)
+  {
+    const sdf::Model *nested = _model.ModelByIndex(m);
+    addObstacles(*nested, _pose *
+        resolve(nested->SemanticPose(), nested->RawPose()), isStatic, _boxes);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the length of a segment inside a box.
+/// \param[in] _from Start of the segment.
+/// \param[in] _to End of the segment.
+/// \param[in] _box The box.
+/// \return The length.
+static double lengthInside(const math::Vector3d &_from,
+    const math::Vector3d &_to, const math::AxisAlignedBox &_box)
+{
+  const auto direction = _to - _from;
+  double enter = 0.0;
+  double exit = 1.0;
+  for (int k = 0; k < 3; ++k)
+  {
+    if (std::abs(direction[k]) < 1e-12)
+    {
+      if (_from[k] < _box.Min()[k] || _from[k] > _box.Max()[k])
+        return 0.0;
+      continue;
+    }
+    double t0 = (_box.Min()[k] - _from[k]) / direction[k];
+    double t1 = (_box.Max()[k] - _from[k]) / direction[k];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    if (enter >= exit)
+      return 0.0;
+  }
+  return (exit - enter) * direction.Length();
+}
+
+/////////////////////////////////////////////////
+/// \brief Precompute the path losses caused by the static obstacles of a
+/// world, for the RFComms system.
+/// Usage: gz-sim-rf-path-loss-map <world> <map> <min x y z> <max x y z>
+///   <cell size> [attenuation]
+int main(int argc, char* argv[])
+{
+  if (argc != 10 && argc != 11)
+  {
+    std::cerr << "Usage: " << argv[0] << " <world> <map> <min_x> <min_y> "
+              << "<min_z> <max_x> <max_y> <max_z> <cell_size> [attenuation]"
+              << std::endl
+              << "Casts a ray between the centers of every pair of cells of "
+              << "the grid bounded by min and max, and writes the losses "
+              << "caused by the collisions of the static models of <world> "
+              << "to <map>, which RFComms loads with <path_loss_map>. "
+              << "Losses are proportional to the length of the rays inside "
+              << "the boxes which bound the collisions, with an attenuation "
+              << "in dB/m which defaults to 10." << std::endl;
+    return 1;
+  }
+
+  math::Vector3d min;
+  math::Vector3d max;
+  for (int k = 0; k < 3; ++k)
+  {
+    min[k] = std::atof(argv[3 + k]);
+    max[k] = std::atof(argv[6 + k]);
+  }
+  const double cellSize = std::atof(argv[9]);
+  const double attenuation = argc == 11 ? std::atof(argv[10]) : 10.0;
+  if (!(cellSize > 0.0) || !(max.X() > min.X()) || !(max.Y() > min.Y()) ||
+      !(max.Z() > min.Z()))
+  {
+    std::cerr << "The cell size must be positive, and max greater than min."
+              << std::endl;
+    return 1;
+  }
+
+  sdf::Root root;
+  const auto errors = root.Load(argv[1]);
+  if (!errors.empty() || root.WorldCount() == 0u)
+  {
+    std::cerr << "Failed to load a world from [" << argv[1] << "]:"
+              << std::endl;
+    for (const auto &error : errors)
+      std::cerr << error << std::endl;
+    return 1;
+  }
+
+  std::vector<math::AxisAlignedBox> boxes;
+  const sdf::World *world = root.WorldByIndex(0);
+  for (uint64_t m = 0; m < world->ModelCount(); ++m)
+  {
+    const sdf::Model *model = world->ModelByIndex(m);
+    addObstacles(*model, resolve(model->SemanticPose(), model->RawPose()),
+        false, boxes);
+  }
+  std::cout << "Found " << boxes.size() << " static obstacles." << std::endl;
+
+  std::array<std::size_t, 3> cells;
+  for (std::size_t k = 0; k < 3u; ++k)
+  {
+    cells[k] = static_cast<std::size_t>(
+        std::ceil((max[k] - min[k]) / cellSize));
+  }
+
+  gz::sim::systems::rf_comms::PathLossMap map;
+  std::string error;
+  const bool generated = map.Generate(min, cellSize, cells,
+      [&](const math::Vector3d &_from, const math::Vector3d &_to)
+      {
+        double inside = 0.0;
+        for (const auto &box : boxes)
+          inside += lengthInside(_from, _to, box);
+        return attenuation * inside;
+      }, error);
+  if (!generated || !map.Save(argv[2], error))
+  {
+    std::cerr << "Failed to generate the map: " << error << std::endl;
+    return 1;
+  }
+
+  std::cout << "Wrote the losses between " << map.CellCount() << " cells to ["
+            << argv[2] << "]." << std::endl;
+  return 0;
+}
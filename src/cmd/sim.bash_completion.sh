@@ -34,6 +34,12 @@ GZ_SIM_COMPLETION_LIST="
   --log-overwrite
   --log-compress
   --playback
+  --replay-batch
+  --replay-system
+  --replay-threads
+  --export-log
+  --export-path
+  --profile
   --headless-rendering
   -r
   -s
@@ -20,6 +20,7 @@
 #include <gz/msgs/stringmsg_v.pb.h>
 #include <gz/msgs/time.pb.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -30,15 +31,45 @@
 #include "gz/sim/Conversions.hh"
 #include "gz/sim/Util.hh"
 
+/// \brief A message received while the message manager was locked.
+struct PendingMsg
+{
+  /// \brief The message.
+  gz::msgs::DataframeSharedPtr msg;
+
+  /// \brief The message received before this one.
+  PendingMsg *next{nullptr};
+};
+
 /// \brief Private Broker data class.
 class gz::sim::comms::Broker::Implementation
 {
+  /// \brief Destructor.
+  public: ~Implementation();
+
+  /// \brief Add a message received by a transport thread to the pending
+  /// messages. This doesn't lock, so that transport threads aren't blocked
+  /// while a comms model is stepping.
+  /// \param[in] _msg The message.
+  public: void Push(const gz::msgs::DataframeSharedPtr &_msg);
+
+  /// \brief Move the pending messages to the outbound queues of their
+  /// senders, in the order in which they were received. The mutex must be
+  /// locked.
+  public: void FlushPending();
+
   /// \brief The message manager.
   public: MsgManager data;
 
   /// \brief Protect data from races.
   public: std::mutex mutex;
 
+  /// \brief Last received of the messages that couldn't be placed in an
+  /// outbound queue yet, because the mutex was locked. Transport threads
+  /// push to this lock-free stack and the one holding the mutex takes it
+  /// whole.
+  public: std::atomic<PendingMsg *> pending{nullptr};
+
   /// \brief Topic used to centralize all messages sent from the agents.
   public: std::string msgTopic = "/broker/msgs";
 
@@ -48,8 +79,9 @@ class gz::sim::comms::Broker::Implementation
   /// \brief Service used to unbind from an address.
   public: std::string unbindSrv = "/broker/unbind";
 
-  /// \brief The current time.
-  public: std::chrono::steady_clock::duration time{0};
+  /// \brief The current time, in ticks of a steady clock duration. Atomic,
+  /// as messages are stamped without locking.
+  public: std::atomic<std::chrono::steady_clock::duration::rep> time{0};
 
   /// \brief A Gazebo Transport node for communications.
   public: std::unique_ptr<gz::transport::Node> node;
@@ -59,6 +91,56 @@ using namespace gz;
 using namespace sim;
 using namespace comms;
 
+//////////////////////////////////////////////////
+Broker::Implementation::~Implementation()
+{
+  PendingMsg *msg = this->pending.exchange(nullptr);
+  while (msg)
+  {
+    PendingMsg *next = msg->next;
+    delete msg;
+    msg = next;
+  }
+}
+
+//////////////////////////////////////////////////
+void Broker::Implementation::Push(const gz::msgs::DataframeSharedPtr &_msg)
+{
+  auto *pendingMsg = new PendingMsg{_msg,
+      this->pending.load(std::memory_order_relaxed)};
+  while (!this->pending.compare_exchange_weak(pendingMsg->next, pendingMsg,
+      std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+void Broker::Implementation::FlushPending()
+{
+  PendingMsg *msg = this->pending.exchange(nullptr,
+      std::memory_order_acquire);
+  if (!msg)
+    return;
+
+  // The stack holds the last message first
+  PendingMsg *first = nullptr;
+  while (msg)
+  {
+    PendingMsg *next = msg->next;
+    msg->next = first;
+    first = msg;
+    msg = next;
+  }
+
+  while (first)
+  {
+    PendingMsg *next = first->next;
+    this->data.AddOutbound(first->msg->src_address(), first->msg);
+    delete first;
+    first = next;
+  }
+}
+
 //////////////////////////////////////////////////
 Broker::Broker()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -79,6 +161,8 @@ void Broker::Load(std::shared_ptr<const sdf::Element> _sdf)
     elem->Get<std::string>("bind_service", this->dataPtr->bindSrv).first;
   this->dataPtr->unbindSrv =
     elem->Get<std::string>("unbind_service", this->dataPtr->unbindSrv).first;
+  this->dataPtr->data.SetBatched(
+    elem->Get<bool>("batch_delivery", false).first);
 }
 
 //////////////////////////////////////////////////
@@ -122,13 +206,13 @@ void Broker::Start()
 //////////////////////////////////////////////////
 std::chrono::steady_clock::duration Broker::Time() const
 {
-  return this->dataPtr->time;
+  return std::chrono::steady_clock::duration(this->dataPtr->time.load());
 }
 
 //////////////////////////////////////////////////
 void Broker::SetTime(const std::chrono::steady_clock::duration &_time)
 {
-  this->dataPtr->time = _time;
+  this->dataPtr->time = _time.count();
 }
 
 //////////////////////////////////////////////////
@@ -185,12 +269,20 @@ void Broker::OnMsg(const gz::msgs::Dataframe &_msg)
   // Place the message in the outbound queue of the sender.
   auto msgPtr = std::make_shared<gz::msgs::Dataframe>(_msg);
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
   // Stamp the time.
   msgPtr->mutable_header()->mutable_stamp()->CopyFrom(
-      sim::convert<msgs::Time>(this->dataPtr->time));
+      sim::convert<msgs::Time>(this->Time()));
+
+  // Don't wait for a comms model to finish its step. The message is placed
+  // in the outbound queue when the mutex is next locked.
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    this->dataPtr->Push(msgPtr);
+    return;
+  }
 
+  this->dataPtr->FlushPending();
   this->DataManager().AddOutbound(_msg.src_address(), msgPtr);
 }
 
@@ -211,6 +303,7 @@ MsgManager &Broker::DataManager()
 void Broker::Lock()
 {
   this->dataPtr->mutex.lock();
+  this->dataPtr->FlushPending();
 }
 
 //////////////////////////////////////////////////
@@ -20,6 +20,9 @@
 #include <gz/msgs/dataframe.pb.h>
 #include <gz/msgs/stringmsg_v.pb.h>
 
+#include <string>
+#include <thread>
+
 #include "gz/sim/comms/Broker.hh"
 #include "gz/sim/comms/MsgManager.hh"
 #include "helpers/EnvTestFixture.hh"
@@ -101,3 +104,40 @@ TEST_F(BrokerTest, Broker)
   broker.SetTime(time1);
   EXPECT_EQ(time1, broker.Time());
 }
+
+/////////////////////////////////////////////////
+TEST_F(BrokerTest, MsgWhileLocked)
+{
+  comms::Broker broker;
+  auto &allData = broker.DataManager().Data();
+
+  msgs::StringMsg_V reqBind;
+  reqBind.add_data("addr1");
+  reqBind.add_data("model1");
+  reqBind.add_data("topic");
+  gz::msgs::Boolean unused;
+  EXPECT_TRUE(broker.OnBind(reqBind, unused));
+
+  // Messages received while a comms model is stepping don't wait for it, and
+  // are placed in the outbound queue in order on the next lock.
+  broker.Lock();
+  std::thread sender([&broker]()
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      msgs::Dataframe msg;
+      msg.set_src_address("addr1");
+      msg.set_data(std::to_string(i));
+      broker.OnMsg(msg);
+    }
+  });
+  sender.join();
+  EXPECT_TRUE(allData["addr1"].outboundMsgs.empty());
+  broker.Unlock();
+
+  broker.Lock();
+  ASSERT_EQ(3u, allData["addr1"].outboundMsgs.size());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(std::to_string(i), allData["addr1"].outboundMsgs[i]->data());
+  broker.Unlock();
+}
@@ -44,8 +44,98 @@ class gz::sim::comms::ICommsModel::Implementation
 
   /// \brief Current time.
   public: std::chrono::steady_clock::time_point currentTime;
+
+  /// \brief Make the new registry match the current one. The new registry
+  /// is kept between steps, so that only the queues are copied each step,
+  /// and the subscriptions only when they changed.
+  /// \param[in] _current The current registry.
+  public: void PrepareNewRegistry(const Registry &_current);
+
+  /// \brief Make the current registry match the new one.
+  /// \param[in, out] _current The current registry.
+  public: void ApplyNewRegistry(Registry &_current);
+
+  /// \brief Registry passed as the new registry to the comms model.
+  public: Registry newRegistry;
 };
 
+//////////////////////////////////////////////////
+/// \brief Check whether two addresses have the same subscription topics.
+/// \param[in] _a First subscriptions.
+/// \param[in] _b Second subscriptions.
+/// \return True if the topics are the same.
+static bool sameTopics(const SubscriptionHandler &_a,
+    const SubscriptionHandler &_b)
+{
+  if (_a.size() != _b.size())
+    return false;
+  for (const auto &topic : _a)
+  {
+    if (_b.find(topic.first) == _b.end())
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ICommsModel::Implementation::PrepareNewRegistry(const Registry &_current)
+{
+  if (this->newRegistry.size() != _current.size())
+  {
+    for (auto it = this->newRegistry.begin(); it != this->newRegistry.end();)
+    {
+      if (_current.find(it->first) == _current.end())
+        it = this->newRegistry.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  for (const auto &[address, content] : _current)
+  {
+    auto &newContent = this->newRegistry[address];
+    newContent.inboundMsgs = content.inboundMsgs;
+    newContent.outboundMsgs = content.outboundMsgs;
+    newContent.entity = content.entity;
+    if (newContent.modelName != content.modelName)
+      newContent.modelName = content.modelName;
+    if (!sameTopics(newContent.subscriptions, content.subscriptions))
+      newContent.subscriptions = content.subscriptions;
+  }
+}
+
+//////////////////////////////////////////////////
+void ICommsModel::Implementation::ApplyNewRegistry(Registry &_current)
+{
+  // Addresses erased by the comms model
+  if (this->newRegistry.size() != _current.size())
+  {
+    for (auto it = _current.begin(); it != _current.end();)
+    {
+      if (this->newRegistry.find(it->first) == this->newRegistry.end())
+        it = _current.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  for (auto &[address, newContent] : this->newRegistry)
+  {
+    // Queues are swapped rather than copied. The new registry gets them
+    // copied again on the next step.
+    auto &content = _current[address];
+    content.inboundMsgs.swap(newContent.inboundMsgs);
+    content.outboundMsgs.swap(newContent.outboundMsgs);
+    newContent.inboundMsgs.clear();
+    newContent.outboundMsgs.clear();
+    content.entity = newContent.entity;
+    if (content.modelName != newContent.modelName)
+      content.modelName = newContent.modelName;
+    if (!sameTopics(content.subscriptions, newContent.subscriptions))
+      content.subscriptions = newContent.subscriptions;
+  }
+}
+
 //////////////////////////////////////////////////
 ICommsModel::ICommsModel()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -115,11 +205,10 @@ void ICommsModel::StepImpl(const UpdateInfo &_info,
   this->dataPtr->broker.SetTime(_info.simTime);
 
   // Step the comms model.
-  const Registry &currentRegistry =
-    this->dataPtr->broker.DataManager().DataConst();
-  Registry newRegistry = this->dataPtr->broker.DataManager().Copy();
-  this->Step(_info, currentRegistry, newRegistry, _ecm);
-  this->dataPtr->broker.DataManager().Set(newRegistry);
+  Registry &currentRegistry = this->dataPtr->broker.DataManager().Data();
+  this->dataPtr->PrepareNewRegistry(currentRegistry);
+  this->Step(_info, currentRegistry, this->dataPtr->newRegistry, _ecm);
+  this->dataPtr->ApplyNewRegistry(currentRegistry);
 
   this->dataPtr->broker.Unlock();
 
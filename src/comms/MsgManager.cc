@@ -18,7 +18,9 @@
 #include <gz/msgs/dataframe.pb.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <gz/transport/Node.hh>
 #include <gz/utils/ImplPtr.hh>
@@ -35,12 +37,82 @@ class gz::sim::comms::MsgManager::Implementation
 
   /// \brief A Gazebo Transport node for communications.
   public: std::unique_ptr<gz::transport::Node> node;
+
+  /// \brief True if the messages of an address are delivered together.
+  public: bool batched = false;
+
+  /// \brief Message reused to deliver batches.
+  public: msgs::Dataframe batch;
 };
 
 using namespace gz;
 using namespace sim;
 using namespace comms;
 
+//////////////////////////////////////////////////
+void comms::PackMsgs(const DataQueue &_msgs, msgs::Dataframe &_batch)
+{
+  _batch.Clear();
+  std::string *data = _batch.mutable_data();
+  std::string bytes;
+  for (const auto &msg : _msgs)
+  {
+    msg->SerializeToString(&bytes);
+    const auto size = static_cast<uint32_t>(bytes.size());
+    for (int i = 0; i < 4; ++i)
+      data->push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+    data->append(bytes);
+  }
+
+  auto *sizeData = _batch.mutable_header()->add_data();
+  sizeData->set_key(kBatchSizeKey);
+  sizeData->add_value(std::to_string(_msgs.size()));
+  if (!_msgs.empty())
+  {
+    _batch.set_dst_address(_msgs.front()->dst_address());
+    _batch.mutable_header()->mutable_stamp()->CopyFrom(
+        _msgs.back()->header().stamp());
+  }
+}
+
+//////////////////////////////////////////////////
+bool comms::UnpackMsgs(const msgs::Dataframe &_batch,
+                       std::vector<msgs::Dataframe> &_msgs)
+{
+  _msgs.clear();
+  bool isBatch = false;
+  for (const auto &data : _batch.header().data())
+    isBatch = isBatch || data.key() == kBatchSizeKey;
+  if (!isBatch)
+    return false;
+
+  const std::string &bytes = _batch.data();
+  std::size_t offset = 0;
+  while (offset < bytes.size())
+  {
+    if (bytes.size() - offset < 4u)
+      return false;
+    uint32_t size = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+      size |= static_cast<uint32_t>(
+          static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+    }
+    offset += 4u;
+    if (bytes.size() - offset < size)
+      return false;
+
+    _msgs.emplace_back();
+    if (!_msgs.back().ParseFromArray(bytes.data() + offset,
+        static_cast<int>(size)))
+    {
+      return false;
+    }
+    offset += size;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 MsgManager::MsgManager()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -150,6 +222,19 @@ void MsgManager::DeliverMsgs()
     // Reference to the inbound queue for this address.
     auto &inbound = content.inboundMsgs;
 
+    if (this->dataPtr->batched)
+    {
+      if (!inbound.empty())
+      {
+        // A single publication for all the messages.
+        PackMsgs(inbound, this->dataPtr->batch);
+        for (auto & [topic, publisher] : content.subscriptions)
+          publisher.Publish(this->dataPtr->batch);
+      }
+      content.inboundMsgs.clear();
+      continue;
+    }
+
     // All these messages need to be delivered.
     for (auto &msg : inbound)
     {
@@ -162,6 +247,18 @@ void MsgManager::DeliverMsgs()
   }
 }
 
+//////////////////////////////////////////////////
+void MsgManager::SetBatched(bool _batched)
+{
+  this->dataPtr->batched = _batched;
+}
+
+//////////////////////////////////////////////////
+bool MsgManager::Batched() const
+{
+  return this->dataPtr->batched;
+}
+
 //////////////////////////////////////////////////
 const Registry &MsgManager::DataConst() const
 {
@@ -18,7 +18,10 @@
 #include <gtest/gtest.h>
 #include <gz/msgs/dataframe.pb.h>
 
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "gz/sim/comms/MsgManager.hh"
 #include "helpers/EnvTestFixture.hh"
@@ -144,3 +147,46 @@ TEST_F(MsgManagerTest, MsgManager)
   EXPECT_TRUE(it->second.subscriptions.empty());
 
 }
+
+/////////////////////////////////////////////////
+TEST_F(MsgManagerTest, Batch)
+{
+  comms::DataQueue queue;
+  for (int i = 0; i < 3; ++i)
+  {
+    auto msg = std::make_shared<msgs::Dataframe>();
+    msg->set_src_address("addr" + std::to_string(i));
+    msg->set_dst_address("addr9");
+    msg->set_data(std::string(static_cast<std::size_t>(i * 300), 'x'));
+    queue.push_back(msg);
+  }
+
+  msgs::Dataframe batch;
+  comms::PackMsgs(queue, batch);
+  EXPECT_EQ("addr9", batch.dst_address());
+
+  std::vector<msgs::Dataframe> unpacked;
+  ASSERT_TRUE(comms::UnpackMsgs(batch, unpacked));
+  ASSERT_EQ(queue.size(), unpacked.size());
+  for (std::size_t i = 0; i < queue.size(); ++i)
+  {
+    EXPECT_EQ(queue[i]->src_address(), unpacked[i].src_address());
+    EXPECT_EQ(queue[i]->data(), unpacked[i].data());
+  }
+
+  // Messages which aren't batches, or are truncated
+  EXPECT_FALSE(comms::UnpackMsgs(*queue[1], unpacked));
+  batch.mutable_data()->resize(batch.data().size() - 1);
+  EXPECT_FALSE(comms::UnpackMsgs(batch, unpacked));
+
+  // Batched delivery still clears the inbound queues
+  comms::MsgManager msgManager;
+  EXPECT_FALSE(msgManager.Batched());
+  msgManager.SetBatched(true);
+  EXPECT_TRUE(msgManager.Batched());
+  EXPECT_TRUE(msgManager.AddSubscriber("addr9", "model9", "topic9"));
+  for (const auto &msg : queue)
+    msgManager.AddInbound("addr9", msg);
+  msgManager.DeliverMsgs();
+  EXPECT_TRUE(msgManager.Data()["addr9"].inboundMsgs.empty());
+}
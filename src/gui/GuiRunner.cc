@@ -16,6 +16,7 @@
 */
 
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,7 @@
 
 #include <gz/common/Console.hh>
 #include <gz/common/Profiler.hh>
+#include <gz/common/Util.hh>
 #include <gz/fuel_tools/Interface.hh>
 #include <gz/gui/Application.hh>
 #include <gz/gui/GuiEvents.hh>
@@ -40,6 +42,8 @@
 #include "gz/sim/gui/GuiSystem.hh"
 #include "gz/sim/SystemLoader.hh"
 
+#include "../CompactPoses.hh"
+#include "../StateMerge.hh"
 #include "GuiRunner.hh"
 
 using namespace gz;
@@ -48,6 +52,7 @@ using namespace sim;
 // Register SerializedStepMap to the Qt meta type system so we can pass objects
 // of this type in QMetaObject::invokeMethod
 Q_DECLARE_METATYPE(msgs::SerializedStepMap)
+Q_DECLARE_METATYPE(msgs::Bytes)
 
 /////////////////////////////////////////////////
 class gz::sim::GuiRunner::Implementation
@@ -61,9 +66,24 @@ class gz::sim::GuiRunner::Implementation
   /// \brief Topic to request state
   public: std::string stateTopic;
 
+  /// \brief Topic of the compact pose stream
+  public: std::string compactPoseTopic;
+
+  /// \brief Decodes the compact pose stream, only used from the Qt thread.
+  public: CompactPoseDecoder compactPoseDecoder;
+
   /// \brief Latest update info
   public: UpdateInfo updateInfo;
 
+  /// \brief States received from transport threads that the Qt thread
+  /// hasn't applied yet, oldest first. Each state is merged into the last
+  /// one when possible, so there's usually only one. A call to OnStateQt
+  /// is queued while this isn't empty.
+  public: std::vector<msgs::SerializedStepMap> pendingStates;
+
+  /// \brief Protects pendingStates.
+  public: std::mutex pendingStateMutex;
+
   /// \brief Flag used to end the updateThread.
   public: bool running{false};
 
@@ -110,6 +130,7 @@ GuiRunner::GuiRunner(const std::string &_worldName)
   : dataPtr(utils::MakeUniqueImpl<Implementation>())
 {
   qRegisterMetaType<msgs::SerializedStepMap>();
+  qRegisterMetaType<msgs::Bytes>();
 
   this->setProperty("worldName", QString::fromStdString(_worldName));
 
@@ -132,8 +153,17 @@ GuiRunner::GuiRunner(const std::string &_worldName)
   winWorldNames.append(QString::fromStdString(_worldName));
   win->setProperty("worldNames", winWorldNames);
 
-  this->dataPtr->stateTopic = transport::TopicUtils::AsValidTopic("/world/" +
-      _worldName + "/state");
+  // State streams can come from a relay instead of the server, see
+  // StateRelay
+  std::string relay;
+  if (common::env("GZ_SIM_GUI_RELAY", relay) && !relay.empty())
+  {
+    gzmsg << "Following the state of world [" << _worldName
+          << "] through relay [" << relay << "]" << std::endl;
+  }
+
+  this->dataPtr->stateTopic = transport::TopicUtils::AsValidTopic(relay +
+      "/world/" + _worldName + "/state");
   if (this->dataPtr->stateTopic.empty())
   {
     gzerr << "Failed to generate valid topic for world [" << _worldName << "]"
@@ -141,6 +171,9 @@ GuiRunner::GuiRunner(const std::string &_worldName)
     return;
   }
 
+  this->dataPtr->compactPoseTopic = transport::TopicUtils::AsValidTopic(
+      relay + "/world/" + _worldName + "/dynamic_pose/compact");
+
   common::addFindFileURICallback([] (common::URI _uri)
   {
     return fuel_tools::fetchResource(_uri.Str());
@@ -251,6 +284,14 @@ void GuiRunner::RequestState()
   this->dataPtr->node.Subscribe(this->dataPtr->stateTopic,
       &GuiRunner::OnState, this);
 
+  // Subscribe to the compact pose stream, which is only published if the
+  // scene broadcaster has it enabled, to update poses between states.
+  if (!this->dataPtr->compactPoseTopic.empty())
+  {
+    this->dataPtr->node.Subscribe(this->dataPtr->compactPoseTopic,
+        &GuiRunner::OnCompactPoses, this);
+  }
+
   // send async state request
   this->dataPtr->node.Request(this->dataPtr->stateTopic + "_async", req);
 }
@@ -258,12 +299,7 @@ void GuiRunner::RequestState()
 /////////////////////////////////////////////////
 void GuiRunner::OnStateAsyncService(const msgs::SerializedStepMap &_res)
 {
-  // Since this function may be called from a transport thread, we push the
-  // OnStateQt function to the queue so that its called from the Qt thread. This
-  // ensures that only one thread has access to the ecm and updateInfo
-  // variables.
-  QMetaObject::invokeMethod(this, "OnStateQt", Qt::QueuedConnection,
-                            Q_ARG(msgs::SerializedStepMap, _res));
+  this->QueueState(_res);
   this->dataPtr->receivedInitialState = true;
 
   // todo(anyone) store reqSrv string in a member variable and use it here
@@ -284,24 +320,92 @@ void GuiRunner::OnState(const msgs::SerializedStepMap &_msg)
   if (!this->dataPtr->receivedInitialState)
     return;
 
+  this->QueueState(_msg);
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::QueueState(const msgs::SerializedStepMap &_msg)
+{
+  GZ_PROFILE("GuiRunner::QueueState");
+
   // Since this function may be called from a transport thread, we push the
   // OnStateQt function to the queue so that its called from the Qt thread. This
   // ensures that only one thread has access to the ecm and updateInfo
-  // variables.
-  QMetaObject::invokeMethod(this, "OnStateQt", Qt::QueuedConnection,
-                            Q_ARG(msgs::SerializedStepMap, _msg));
+  // variables. States that arrive while a call is queued are merged into the
+  // pending one, so a busy Qt thread applies a single state instead of
+  // falling further behind.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->pendingStateMutex);
+    auto &pending = this->dataPtr->pendingStates;
+    if (!pending.empty())
+    {
+      if (!mergeState(_msg, pending.back(), false))
+        pending.push_back(_msg);
+      return;
+    }
+    pending.push_back(_msg);
+  }
+
+  QMetaObject::invokeMethod(this, "OnStateQt", Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
-void GuiRunner::OnStateQt(const msgs::SerializedStepMap &_msg)
+void GuiRunner::OnStateQt()
 {
   GZ_PROFILE_THREAD_NAME("Qt thread");
   GZ_PROFILE("GuiRunner::Update");
-  this->dataPtr->ecm.SetState(_msg.state());
 
-  // Update all plugins
-  this->dataPtr->updateInfo = convert<UpdateInfo>(_msg.stats());
-  this->UpdatePlugins();
+  // Take the pending states without copying them, so transport threads can
+  // start merging into new ones right away
+  std::vector<msgs::SerializedStepMap> states;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->pendingStateMutex);
+    states.swap(this->dataPtr->pendingStates);
+  }
+
+  // States that couldn't be merged are applied one at a time, so plugins
+  // see an entity's removal before it's created again
+  for (const auto &msg : states)
+  {
+    this->dataPtr->ecm.SetState(msg.state());
+
+    // Update all plugins
+    this->dataPtr->updateInfo = convert<UpdateInfo>(msg.stats());
+    this->UpdatePlugins();
+  }
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::OnCompactPoses(const msgs::Bytes &_msg)
+{
+  if (!this->dataPtr->receivedInitialState)
+    return;
+
+  QMetaObject::invokeMethod(this, "OnCompactPosesQt", Qt::QueuedConnection,
+                            Q_ARG(msgs::Bytes, _msg));
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::OnCompactPosesQt(const msgs::Bytes &_msg)
+{
+  GZ_PROFILE_THREAD_NAME("Qt thread");
+  GZ_PROFILE("GuiRunner::OnCompactPosesQt");
+  auto &decoder = this->dataPtr->compactPoseDecoder;
+  if (!decoder.Decode(_msg.data()))
+    return;
+
+  // Only update entities the GUI already knows about, new entities arrive
+  // with the state. Plugins are updated by the timer.
+  auto &ecm = this->dataPtr->ecm;
+  for (const auto entity : decoder.Changed())
+  {
+    if (nullptr == ecm.Component<components::Pose>(entity))
+      continue;
+    ecm.SetComponentData<components::Pose>(entity,
+        decoder.Poses().at(entity));
+    ecm.SetChanged(entity, components::Pose::typeId,
+        ComponentState::PeriodicChange);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -320,6 +424,10 @@ void GuiRunner::UpdatePlugins()
   // gz-sim systems
   this->LoadSystems();
   this->UpdateSystems();
+
+  // Like the server does after each step, so plugins can tell which
+  // components changed since their last update
+  this->dataPtr->ecm.SetAllComponentsUnchanged();
 }
 
 /////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 #ifndef GZ_SIM_GUI_GUIRUNNER_HH_
 #define GZ_SIM_GUI_GUIRUNNER_HH_
 
+#include <gz/msgs/bytes.pb.h>
 #include <gz/msgs/serialized_map.pb.h>
 
 #include <QtCore>
@@ -65,9 +66,23 @@ class GZ_SIM_GUI_VISIBLE GuiRunner : public QObject
   /// \param[in] _msg New state message.
   private: void OnState(const msgs::SerializedStepMap &_msg);
 
-  /// \brief Called by the Qt thread to update the ECM with new state
+  /// \brief Queue a state for the Qt thread, merging it into the pending
+  /// state if there's one.
   /// \param[in] _msg New state message.
-  private: Q_INVOKABLE void OnStateQt(const msgs::SerializedStepMap &_msg);
+  private: void QueueState(const msgs::SerializedStepMap &_msg);
+
+  /// \brief Called by the Qt thread to update the ECM with the pending
+  /// state
+  private: Q_INVOKABLE void OnStateQt();
+
+  /// \brief Callback when a compact pose frame is received from the
+  /// server. Actual updating of the ECM is delegated to OnCompactPosesQt
+  /// \param[in] _msg Frame written by CompactPoseEncoder.
+  private: void OnCompactPoses(const msgs::Bytes &_msg);
+
+  /// \brief Called by the Qt thread to update the poses in the ECM
+  /// \param[in] _msg Frame written by CompactPoseEncoder.
+  private: Q_INVOKABLE void OnCompactPosesQt(const msgs::Bytes &_msg);
 
   /// \brief Update the plugins.
   private: Q_INVOKABLE void UpdatePlugins();
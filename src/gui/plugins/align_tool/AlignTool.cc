@@ -45,6 +45,7 @@
 #include "gz/sim/components/World.hh"
 #include "gz/sim/gui/GuiEvents.hh"
 #include "gz/sim/rendering/RenderUtil.hh"
+#include "gz/sim/rendering/SceneManager.hh"
 
 #include "AlignTool.hh"
 
@@ -357,28 +358,21 @@ void AlignTool::Align()
 
   for (const auto &entityId : this->dataPtr->selectedEntities)
   {
-    for (auto i = 0u; i < this->dataPtr->scene->VisualCount(); ++i)
-    {
-      rendering::VisualPtr vis =
-        this->dataPtr->scene->VisualByIndex(i);
-      if (!vis)
-        continue;
+    rendering::VisualPtr vis =
+      SceneManager::VisualByEntity(this->dataPtr->scene, entityId);
+    if (!vis)
+      continue;
 
-      if (vis->HasUserData("gazebo-entity") &&
-          std::get<uint64_t>(vis->UserData("gazebo-entity")) == entityId)
-      {
-        // Check here to see if visual is top level or not, continue if not
-        auto topLevelVis = this->TopLevelVisual(this->dataPtr->scene, vis);
-        if (topLevelVis != vis)
-          continue;
+    // Check here to see if visual is top level or not, continue if not
+    auto topLevelVis = this->TopLevelVisual(this->dataPtr->scene, vis);
+    if (topLevelVis != vis)
+      continue;
 
-        selectedList.push_back(vis);
-      }
-    }
+    selectedList.push_back(vis);
   }
 
-  // Selected links will result in this list being empty as they won't be
-  // found in the above VisualByIndex call
+  // Selected links will result in this list being empty as they aren't
+  // top level visuals
   if (selectedList.size() < 2)
     return;
 
@@ -25,10 +25,12 @@
 #include <gz/msgs/spherical_coordinates.pb.h>
 #include <gz/msgs/empty.pb.h>
 
+#include <chrono>
 #include <iostream>
 #include <list>
 #include <regex>
 #include <unordered_map>
+#include <unordered_set>
 #include <QColorDialog>
 #include <gz/common/Console.hh>
 #include <gz/common/Profiler.hh>
@@ -145,6 +147,23 @@ namespace gz::sim
 
     /// \brief Maps plugin display names to their filenames.
     public: std::unordered_map<std::string, std::string> systemMap;
+
+    /// \brief Entity whose components are displayed. Components are only
+    /// refreshed when they change, unless the inspected entity changes.
+    public: Entity displayedEntity{kNullEntity};
+
+    /// \brief Minimum time between refreshes of a component whose data
+    /// changes periodically, such as a pose.
+    public: std::chrono::steady_clock::duration updatePeriod{
+        std::chrono::milliseconds(100)};
+
+    /// \brief Last time each component type was refreshed.
+    public: std::unordered_map<ComponentTypeId,
+        std::chrono::steady_clock::time_point> lastComponentUpdate;
+
+    /// \brief Components that changed but weren't refreshed yet because
+    /// of the rate limit.
+    public: std::unordered_set<ComponentTypeId> staleComponents;
   };
 }
 
@@ -482,11 +501,32 @@ ComponentInspector::ComponentInspector()
 ComponentInspector::~ComponentInspector() = default;
 
 /////////////////////////////////////////////////
-void ComponentInspector::LoadConfig(const tinyxml2::XMLElement *)
+void ComponentInspector::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Component inspector";
 
+  if (_pluginElem)
+  {
+    auto rateElem = _pluginElem->FirstChildElement("max_update_rate");
+    double rate{0.0};
+    if (nullptr != rateElem &&
+        rateElem->QueryDoubleText(&rate) == tinyxml2::XML_SUCCESS)
+    {
+      if (rate > 0.0)
+      {
+        this->dataPtr->updatePeriod = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+      }
+      else
+      {
+        this->dataPtr->updatePeriod =
+            std::chrono::steady_clock::duration::zero();
+      }
+    }
+  }
+
   gz::gui::App()->findChild<
       gz::gui::MainWindow *>()->installEventFilter(this);
 
@@ -512,6 +552,17 @@ void ComponentInspector::Update(const UpdateInfo &,
 
   auto componentTypes = _ecm.ComponentTypes(this->dataPtr->entity);
 
+  // Refresh everything when the inspected entity changes
+  const bool newEntity =
+      this->dataPtr->displayedEntity != this->dataPtr->entity;
+  if (newEntity)
+  {
+    this->dataPtr->displayedEntity = this->dataPtr->entity;
+    this->dataPtr->lastComponentUpdate.clear();
+    this->dataPtr->staleComponents.clear();
+  }
+  const auto now = std::chrono::steady_clock::now();
+
   // List all components
   for (const auto &typeId : componentTypes)
   {
@@ -530,12 +581,17 @@ void ComponentInspector::Update(const UpdateInfo &,
       // check if entity is nested model
       auto parentComp = _ecm.Component<components::ParentEntity>(
            this->dataPtr->entity);
+      bool nestedModel{false};
       if (parentComp)
       {
         auto modelComp = _ecm.Component<components::Model>(parentComp->Data());
-        this->dataPtr->nestedModel = (modelComp);
+        nestedModel = (modelComp);
+      }
+      if (newEntity || nestedModel != this->dataPtr->nestedModel)
+      {
+        this->dataPtr->nestedModel = nestedModel;
+        this->NestedModelChanged();
       }
-      this->NestedModelChanged();
 
       continue;
     }
@@ -594,6 +650,31 @@ void ComponentInspector::Update(const UpdateInfo &,
     if (itemIt != this->dataPtr->componentsModel.items.end())
     {
       item = itemIt->second;
+
+      // Skip components that didn't change since they were displayed, and
+      // rate limit the ones that change periodically. One-time changes,
+      // such as edits, are shown right away.
+      if (!newEntity)
+      {
+        auto &stale = this->dataPtr->staleComponents;
+        const auto state = _ecm.ComponentState(this->dataPtr->entity,
+            typeId);
+        if (state == ComponentState::NoChange &&
+            stale.find(typeId) == stale.end())
+        {
+          continue;
+        }
+
+        auto lastIt = this->dataPtr->lastComponentUpdate.find(typeId);
+        if (state != ComponentState::OneTimeChange &&
+            lastIt != this->dataPtr->lastComponentUpdate.end() &&
+            now - lastIt->second < this->dataPtr->updatePeriod)
+        {
+          stale.insert(typeId);
+          continue;
+        }
+        stale.erase(typeId);
+      }
     }
     // Add component to list
     else
@@ -601,9 +682,6 @@ void ComponentInspector::Update(const UpdateInfo &,
       item = this->dataPtr->componentsModel.AddComponentType(typeId);
     }
 
-    item->setData(QString::number(this->dataPtr->entity),
-                  ComponentsModel::RoleNames().key("entity"));
-
     if (nullptr == item)
     {
       gzerr << "Failed to get item for component type [" << typeId << "]"
@@ -611,6 +689,10 @@ void ComponentInspector::Update(const UpdateInfo &,
       continue;
     }
 
+    item->setData(QString::number(this->dataPtr->entity),
+                  ComponentsModel::RoleNames().key("entity"));
+    this->dataPtr->lastComponentUpdate[typeId] = now;
+
     // Populate component-specific data
     if (typeId == components::AngularAcceleration::typeId)
     {
@@ -947,6 +1029,8 @@ void ComponentInspector::Update(const UpdateInfo &,
   for (auto typeId : itemsToRemove)
   {
     this->dataPtr->componentsModel.RemoveComponentType(typeId);
+    this->dataPtr->lastComponentUpdate.erase(typeId);
+    this->dataPtr->staleComponents.erase(typeId);
   }
 }
 
@@ -1016,6 +1100,9 @@ QString ComponentInspector::Type() const
 /////////////////////////////////////////////////
 void ComponentInspector::SetType(const QString &_type)
 {
+  if (this->dataPtr->type == _type)
+    return;
+
   this->dataPtr->type = _type;
   this->TypeChanged();
 }
@@ -1042,6 +1129,10 @@ bool ComponentInspector::Paused() const
 /////////////////////////////////////////////////
 void ComponentInspector::SetPaused(bool _paused)
 {
+  // Changes while paused aren't tracked, so refresh everything on resume
+  if (this->dataPtr->paused && !_paused)
+    this->dataPtr->displayedEntity = kNullEntity;
+
   this->dataPtr->paused = _paused;
   this->PausedChanged();
 }
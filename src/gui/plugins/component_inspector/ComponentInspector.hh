@@ -168,8 +168,15 @@ namespace sim
 
   /// \brief Displays a tree view with all the entities in the world.
   ///
+  /// Components are only refreshed when their data changes, and components
+  /// that change periodically, such as poses, are refreshed at a limited
+  /// rate.
+  ///
   /// ## Configuration
-  /// None
+  ///
+  /// - `<max_update_rate>`: Maximum rate in Hz at which each component
+  /// type is refreshed while it changes periodically. Zero or negative
+  /// refreshes on every change. Defaults to 10.
   class ComponentInspector : public sim::GuiSystem
   {
     Q_OBJECT
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <QQmlContext>
+
+#include <gz/gui/Application.hh>
+#include <gz/gui/MainWindow.hh>
+#include <gz/gui/Plugin.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "test_config.hh"
+#include "../../../../test/helpers/EnvTestFixture.hh"
+
+#include "../../GuiRunner.hh"
+#include "ComponentInspector.hh"
+
+int g_argc = 1;
+char **g_argv;
+
+using namespace gz;
+
+/// \brief Tests for the component inspector GUI plugin
+class ComponentInspectorGui : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(ComponentInspectorGui,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnlyChangedComponents))
+{
+  // Create app
+  auto app = std::make_unique<gui::Application>(g_argc, g_argv);
+  ASSERT_NE(nullptr, app);
+  app->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Create GUI runner to handle sim::gui plugins
+  auto runner = new sim::GuiRunner("test");
+  runner->setParent(gui::App());
+
+  // Refresh periodic changes at most twice per second
+  const char *pluginStr =
+    "<plugin filename=\"ComponentInspector\">"
+      "<max_update_rate>2</max_update_rate>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app->LoadPlugin("ComponentInspector",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app->findChild<gui::MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<sim::ComponentInspector *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  auto componentsModel = qobject_cast<sim::ComponentsModel *>(
+      plugin->Context()->contextProperty("ComponentsModel")
+      .value<QObject *>());
+  ASSERT_NE(nullptr, componentsModel);
+
+  // Inspect an entity
+  sim::EntityComponentManager ecm;
+  auto entity = ecm.CreateEntity();
+  ecm.CreateComponent(entity, sim::components::Name("box"));
+  plugin->SetEntity(entity);
+
+  const int dataRole = sim::ComponentsModel::RoleNames().key("data");
+  auto displayedName = [&]() -> std::string
+  {
+    auto itemIt =
+        componentsModel->items.find(sim::components::Name::typeId);
+    if (itemIt == componentsModel->items.end())
+      return std::string();
+    return itemIt->second->data(dataRole).toString().toStdString();
+  };
+
+  sim::UpdateInfo info;
+  plugin->Update(info, ecm);
+  EXPECT_EQ("box", displayedName());
+
+  // Components that aren't marked as changed aren't refreshed
+  ecm.SetAllComponentsUnchanged();
+  ecm.Component<sim::components::Name>(entity)->Data() = "unchanged";
+  plugin->Update(info, ecm);
+  EXPECT_EQ("box", displayedName());
+
+  // One-time changes are shown right away
+  ecm.SetChanged(entity, sim::components::Name::typeId,
+      sim::ComponentState::OneTimeChange);
+  plugin->Update(info, ecm);
+  EXPECT_EQ("unchanged", displayedName());
+
+  // Periodic changes are held back by the rate limit
+  ecm.SetAllComponentsUnchanged();
+  ecm.Component<sim::components::Name>(entity)->Data() = "periodic";
+  ecm.SetChanged(entity, sim::components::Name::typeId,
+      sim::ComponentState::PeriodicChange);
+  plugin->Update(info, ecm);
+  EXPECT_EQ("unchanged", displayedName());
+
+  // The configured rate is used instead of the default 10 Hz
+  ecm.SetAllComponentsUnchanged();
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  plugin->Update(info, ecm);
+  EXPECT_EQ("unchanged", displayedName());
+
+  // The held back value is shown once the period passes, even though the
+  // component didn't change again
+  std::this_thread::sleep_for(std::chrono::milliseconds(450));
+  plugin->Update(info, ecm);
+  EXPECT_EQ("periodic", displayedName());
+
+  // Everything is refreshed when the inspected entity changes
+  auto otherEntity = ecm.CreateEntity();
+  ecm.CreateComponent(otherEntity, sim::components::Name("sphere"));
+  ecm.SetAllComponentsUnchanged();
+  plugin->SetEntity(otherEntity);
+  plugin->Update(info, ecm);
+  EXPECT_EQ("sphere", displayedName());
+
+  // Cleanup
+  plugins.clear();
+}
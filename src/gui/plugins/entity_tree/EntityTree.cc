@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <mutex>
 #include <set>
 #include <string>
@@ -132,8 +133,11 @@ void TreeModel::AddEntity(Entity _entity, const QString &_entityName,
   // check if entity has already been added or not.
   // This could happen because we get new and removed entity updates from both
   // the ECM and GUI events.
-  if (this->entityItems.find(_entity) != this->entityItems.end())
+  if (this->entityItems.find(_entity) != this->entityItems.end() ||
+      this->unfetchedEntities.find(_entity) != this->unfetchedEntities.end())
+  {
     return;
+  }
 
   // Root
   if (_parentEntity == kNullEntity)
@@ -150,23 +154,34 @@ void TreeModel::AddEntity(Entity _entity, const QString &_entityName,
     parentItem = item->second;
   }
 
-  if (nullptr == parentItem)
+  // Children of entities that haven't been expanded only get an item once
+  // they are
+  const EntityInfo info{_entity, _entityName, _parentEntity, _type};
+  const bool parentFetched = _parentEntity == kNullEntity ||
+      this->fetchedParents.find(_parentEntity) != this->fetchedParents.end();
+  if (nullptr != parentItem && parentFetched)
   {
-    this->pendingEntities.push_back(
-      {_entity, _entityName, _parentEntity, _type});
-    return;
+    this->CreateItem(info, parentItem);
   }
+  else if (nullptr != parentItem || this->unfetchedEntities.find(
+      _parentEntity) != this->unfetchedEntities.end())
+  {
+    this->unfetchedEntities[_entity] = info;
+    auto &siblings = this->unfetchedChildren[_parentEntity];
+    siblings.push_back(_entity);
 
-  // New entity item
-  auto entityItem = new QStandardItem(_entityName);
-  entityItem->setData(_entityName, this->roleNames().key("entityName"));
-  entityItem->setData(QString::number(_entity),
-      this->roleNames().key("entity"));
-  entityItem->setData(_type, this->roleNames().key("type"));
-
-  parentItem->appendRow(entityItem);
-
-  this->entityItems[_entity] = entityItem;
+    // Let the view know the parent can be expanded now
+    if (nullptr != parentItem && siblings.size() == 1u)
+    {
+      auto index = this->indexFromItem(parentItem);
+      emit this->dataChanged(index, index);
+    }
+  }
+  else
+  {
+    this->pendingEntities.push_back(info);
+    return;
+  }
 
   // Check if there are pending children
   auto sep = std::partition(this->pendingEntities.begin(),
@@ -195,6 +210,19 @@ void TreeModel::RemoveEntity(Entity _entity)
 
   if (nullptr == item)
   {
+    // See if it's waiting for its parent to be expanded
+    auto unfetchedIt = this->unfetchedEntities.find(_entity);
+    if (unfetchedIt != this->unfetchedEntities.end())
+    {
+      auto &siblings =
+          this->unfetchedChildren[unfetchedIt->second.parentEntity];
+      siblings.erase(std::remove(siblings.begin(), siblings.end(), _entity),
+          siblings.end());
+      this->unfetchedEntities.erase(unfetchedIt);
+      this->ForgetUnfetchedChildren(_entity);
+      return;
+    }
+
     // See if it's pending
     auto toRemove = std::remove_if(this->pendingEntities.begin(),
         this->pendingEntities.end(), [&_entity](const EntityInfo &_entityInfo)
@@ -214,11 +242,14 @@ void TreeModel::RemoveEntity(Entity _entity)
     {
       auto childItem = _item->child(i);
       removeChildren(childItem);
-      this->entityItems.erase(childItem->data(
-          this->roleNames().key("entity")).toUInt());
+      Entity child = childItem->data(
+          this->roleNames().key("entity")).toUInt();
+      this->entityItems.erase(child);
+      this->ForgetUnfetchedChildren(child);
     }
   };
   this->entityItems.erase(_entity);
+  this->ForgetUnfetchedChildren(_entity);
   removeChildren(item);
 
   // Remove from the view
@@ -228,6 +259,182 @@ void TreeModel::RemoveEntity(Entity _entity)
     item->parent()->removeRow(item->row());
 }
 
+/////////////////////////////////////////////////
+void TreeModel::CreateItem(const EntityInfo &_info,
+    QStandardItem *_parentItem)
+{
+  auto entityItem = new QStandardItem(_info.name);
+  entityItem->setData(_info.name, this->roleNames().key("entityName"));
+  entityItem->setData(QString::number(_info.entity),
+      this->roleNames().key("entity"));
+  entityItem->setData(_info.type, this->roleNames().key("type"));
+
+  _parentItem->appendRow(entityItem);
+
+  this->entityItems[_info.entity] = entityItem;
+}
+
+/////////////////////////////////////////////////
+void TreeModel::ForgetUnfetchedChildren(Entity _entity)
+{
+  this->fetchedParents.erase(_entity);
+
+  auto childrenIt = this->unfetchedChildren.find(_entity);
+  if (childrenIt == this->unfetchedChildren.end())
+    return;
+
+  auto children = std::move(childrenIt->second);
+  this->unfetchedChildren.erase(childrenIt);
+  for (const auto &child : children)
+  {
+    this->unfetchedEntities.erase(child);
+    this->ForgetUnfetchedChildren(child);
+  }
+}
+
+/////////////////////////////////////////////////
+void TreeModel::QueueAddEntity(Entity _entity, const QString &_entityName,
+    Entity _parentEntity, const QString &_type)
+{
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  this->queue.push_back({{_entity, _entityName, _parentEntity, _type}, false});
+  if (!this->queueScheduled)
+  {
+    this->queueScheduled = true;
+    QMetaObject::invokeMethod(this, "ProcessQueue", Qt::QueuedConnection);
+  }
+}
+
+/////////////////////////////////////////////////
+void TreeModel::QueueRemoveEntity(Entity _entity)
+{
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  this->queue.push_back({{_entity, QString(), kNullEntity, QString()}, true});
+  if (!this->queueScheduled)
+  {
+    this->queueScheduled = true;
+    QMetaObject::invokeMethod(this, "ProcessQueue", Qt::QueuedConnection);
+  }
+}
+
+/////////////////////////////////////////////////
+void TreeModel::SetBatchSize(std::size_t _batchSize)
+{
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  this->batchSize = std::max<std::size_t>(1u, _batchSize);
+}
+
+/////////////////////////////////////////////////
+void TreeModel::ProcessQueue()
+{
+  GZ_PROFILE_THREAD_NAME("Qt thread");
+  GZ_PROFILE("TreeModel::ProcessQueue");
+
+  std::vector<QueuedEntity> batch;
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    const auto count = std::min(this->batchSize, this->queue.size());
+    batch.assign(std::make_move_iterator(this->queue.begin()),
+        std::make_move_iterator(this->queue.begin() + count));
+    this->queue.erase(this->queue.begin(), this->queue.begin() + count);
+
+    // Let the event loop handle input and paint before the next batch
+    this->queueScheduled = !this->queue.empty();
+    if (this->queueScheduled)
+    {
+      QMetaObject::invokeMethod(this, "ProcessQueue",
+          Qt::QueuedConnection);
+    }
+  }
+
+  for (const auto &queued : batch)
+  {
+    if (queued.remove)
+    {
+      this->RemoveEntity(queued.info.entity);
+    }
+    else
+    {
+      this->AddEntity(queued.info.entity, queued.info.name,
+          queued.info.parentEntity, queued.info.type);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::hasChildren(const QModelIndex &_parent) const
+{
+  return QStandardItemModel::hasChildren(_parent) ||
+      this->canFetchMore(_parent);
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::canFetchMore(const QModelIndex &_parent) const
+{
+  if (!_parent.isValid())
+    return false;
+
+  auto childrenIt = this->unfetchedChildren.find(this->EntityId(_parent));
+  return childrenIt != this->unfetchedChildren.end() &&
+      !childrenIt->second.empty();
+}
+
+/////////////////////////////////////////////////
+void TreeModel::fetchMore(const QModelIndex &_parent)
+{
+  GZ_PROFILE("TreeModel::fetchMore");
+  QStandardItem *parentItem = this->itemFromIndex(_parent);
+  if (nullptr == parentItem)
+    return;
+
+  const Entity parent = this->EntityId(_parent);
+  this->fetchedParents.insert(parent);
+
+  auto childrenIt = this->unfetchedChildren.find(parent);
+  if (childrenIt == this->unfetchedChildren.end())
+    return;
+
+  auto children = std::move(childrenIt->second);
+  this->unfetchedChildren.erase(childrenIt);
+  for (const auto &child : children)
+  {
+    auto infoIt = this->unfetchedEntities.find(child);
+    if (infoIt == this->unfetchedEntities.end())
+      continue;
+    this->CreateItem(infoIt->second, parentItem);
+    this->unfetchedEntities.erase(infoIt);
+  }
+}
+
+/////////////////////////////////////////////////
+QModelIndex TreeModel::IndexFromEntity(qulonglong _entity)
+{
+  // Expand the ancestors that don't have items yet, from the top
+  std::vector<Entity> ancestors;
+  Entity entity = _entity;
+  while (this->entityItems.find(entity) == this->entityItems.end())
+  {
+    auto infoIt = this->unfetchedEntities.find(entity);
+    if (infoIt == this->unfetchedEntities.end())
+      return QModelIndex();
+    entity = infoIt->second.parentEntity;
+    ancestors.push_back(entity);
+  }
+
+  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it)
+  {
+    auto itemIt = this->entityItems.find(*it);
+    if (itemIt == this->entityItems.end())
+      return QModelIndex();
+    this->fetchMore(this->indexFromItem(itemIt->second));
+  }
+
+  auto itemIt = this->entityItems.find(_entity);
+  if (itemIt == this->entityItems.end())
+    return QModelIndex();
+  return this->indexFromItem(itemIt->second);
+}
+
 /////////////////////////////////////////////////
 QString TreeModel::EntityType(const QModelIndex &_index) const
 {
@@ -300,11 +507,22 @@ EntityTree::EntityTree()
 EntityTree::~EntityTree() = default;
 
 /////////////////////////////////////////////////
-void EntityTree::LoadConfig(const tinyxml2::XMLElement *)
+void EntityTree::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Entity tree";
 
+  if (_pluginElem)
+  {
+    auto batchElem = _pluginElem->FirstChildElement("batch_size");
+    unsigned int batchSize{0u};
+    if (nullptr != batchElem &&
+        batchElem->QueryUnsignedText(&batchSize) == tinyxml2::XML_SUCCESS)
+    {
+      this->dataPtr->treeModel.SetBatchSize(batchSize);
+    }
+  }
+
   gz::gui::App()->findChild<
       gz::gui::MainWindow *>()->installEventFilter(this);
 }
@@ -345,12 +563,9 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, _entity),
-          Q_ARG(QString, QString::fromStdString(_name->Data())),
-          Q_ARG(Entity, parentEntity),
-          Q_ARG(QString, entityType(_entity, _ecm)));
+      this->dataPtr->treeModel.QueueAddEntity(_entity,
+          QString::fromStdString(_name->Data()), parentEntity,
+          entityType(_entity, _ecm));
       return true;
     });
 
@@ -375,12 +590,9 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, _entity),
-          Q_ARG(QString, QString::fromStdString(_name->Data())),
-          Q_ARG(Entity, parentEntity),
-          Q_ARG(QString, entityType(_entity, _ecm)));
+      this->dataPtr->treeModel.QueueAddEntity(_entity,
+          QString::fromStdString(_name->Data()), parentEntity,
+          entityType(_entity, _ecm));
       return true;
     });
   }
@@ -389,9 +601,7 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
     [&](const Entity &_entity,
         const components::Name *)->bool
   {
-    QMetaObject::invokeMethod(&this->dataPtr->treeModel, "RemoveEntity",
-        Qt::QueuedConnection,
-        Q_ARG(Entity, _entity));
+    this->dataPtr->treeModel.QueueRemoveEntity(_entity);
     return true;
   });
 
@@ -425,19 +635,14 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, entity),
-          Q_ARG(QString, QString::fromStdString(nameComp->Data())),
-          Q_ARG(Entity, parentEntity),
-          Q_ARG(QString, entityType(entity, _ecm)));
+      this->dataPtr->treeModel.QueueAddEntity(entity,
+          QString::fromStdString(nameComp->Data()), parentEntity,
+          entityType(entity, _ecm));
     }
 
     for (auto entity : this->dataPtr->removedEntities)
     {
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "RemoveEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, entity));
+      this->dataPtr->treeModel.QueueRemoveEntity(entity);
     }
 
     this->dataPtr->newEntities.clear();
@@ -18,8 +18,12 @@
 #ifndef GZ_SIM_GUI_ENTITYTREE_HH_
 #define GZ_SIM_GUI_ENTITYTREE_HH_
 
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <gz/sim/Entity.hh>
@@ -60,6 +64,45 @@ namespace sim
     /// \param[in] _entity Entity to be removed
     public slots: void RemoveEntity(Entity _entity);
 
+    /// \brief Queue an entity to be added to the tree in a later batch.
+    /// Safe to call from any thread.
+    /// \param[in] _entity Entity to be added
+    /// \param[in] _entityName Name of entity to be added
+    /// \param[in] _parentEntity Parent entity, kNullEntity for root entities.
+    /// \param[in] _type Entity type
+    public: void QueueAddEntity(Entity _entity, const QString &_entityName,
+        Entity _parentEntity, const QString &_type);
+
+    /// \brief Queue an entity to be removed from the tree in a later batch.
+    /// Safe to call from any thread.
+    /// \param[in] _entity Entity to be removed
+    public: void QueueRemoveEntity(Entity _entity);
+
+    /// \brief Set the maximum number of queued entities added or removed
+    /// per batch. The Qt event loop runs between batches.
+    /// \param[in] _batchSize Number of entities, at least 1.
+    public: void SetBatchSize(std::size_t _batchSize);
+
+    /// \brief Add and remove a batch of queued entities, and schedule the
+    /// next batch if there are more.
+    public slots: void ProcessQueue();
+
+    // Documentation inherited
+    public: bool hasChildren(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: bool canFetchMore(const QModelIndex &_parent) const override;
+
+    // Documentation inherited
+    public: void fetchMore(const QModelIndex &_parent) override;
+
+    /// \brief Get the index of an entity, creating the items of its
+    /// ancestors' children if they haven't been expanded yet.
+    /// \param[in] _entity Entity ID
+    /// \return Model index, invalid if the entity isn't in the tree.
+    public: Q_INVOKABLE QModelIndex IndexFromEntity(qulonglong _entity);
+
     /// \brief Get the entity type of a tree item at specified index
     /// \param[in] _index Model index
     /// \return Type of entity
@@ -79,7 +122,7 @@ namespace sim
     private: std::map<Entity, QStandardItem *> entityItems;
 
     /// \brief Entity information used to queue the pending entities
-    struct EntityInfo
+    private: struct EntityInfo
     {
       /// \brief Entity ID
       // cppcheck-suppress unmatchedSuppression
@@ -98,15 +141,64 @@ namespace sim
       QString type;
     };
 
+    /// \brief Create the item of an entity.
+    /// \param[in] _info The entity.
+    /// \param[in] _parentItem Item of its parent.
+    private: void CreateItem(const EntityInfo &_info,
+        QStandardItem *_parentItem);
+
+    /// \brief Forget the children of an entity that have no items yet, and
+    /// their children.
+    /// \param[in] _entity The parent entity.
+    private: void ForgetUnfetchedChildren(Entity _entity);
+
     /// \brief If an entity is added before its parent, we queue it in this
     /// vector until their parent shows up or they are deleted.
     private: std::vector<EntityInfo> pendingEntities;
+
+    /// \brief Entities whose item isn't created until their parent is
+    /// expanded.
+    private: std::unordered_map<Entity, EntityInfo> unfetchedEntities;
+
+    /// \brief Children without items for each parent entity.
+    private: std::unordered_map<Entity, std::vector<Entity>> unfetchedChildren;
+
+    /// \brief Entities whose children have items.
+    private: std::set<Entity> fetchedParents;
+
+    /// \brief A queued addition or removal.
+    private: struct QueuedEntity
+    {
+      /// \brief The entity to add or remove.
+      EntityInfo info;
+
+      /// \brief True to remove the entity.
+      bool remove{false};
+    };
+
+    /// \brief Additions and removals waiting for a batch.
+    private: std::deque<QueuedEntity> queue;
+
+    /// \brief True if a call to ProcessQueue is scheduled.
+    private: bool queueScheduled{false};
+
+    /// \brief Protects queue and queueScheduled.
+    private: std::mutex queueMutex;
+
+    /// \brief Maximum number of queued entities per batch.
+    private: std::size_t batchSize{500u};
   };
 
   /// \brief Displays a tree view with all the entities in the world.
   ///
+  /// Entities are added to the tree in batches, so that the GUI stays
+  /// responsive while a large world loads. The items of an entity's
+  /// children are only created once it's expanded.
+  ///
   /// ## Configuration
-  /// None
+  ///
+  /// - `<batch_size>`: Maximum number of entities added or removed at a
+  /// time, before the GUI handles other events. Defaults to 500.
   class EntityTree : public gz::sim::GuiSystem
   {
     Q_OBJECT
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gz/gui/Application.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/Entity.hh"
+#include "test_config.hh"
+#include "../../../../test/helpers/EnvTestFixture.hh"
+
+#include "EntityTree.hh"
+
+int g_argc = 1;
+char **g_argv;
+
+using namespace gz;
+
+/// \brief Tests for the entity tree GUI plugin
+class EntityTreeGui : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Process Qt events until the tree has the given number of top
+/// level rows.
+/// \param[in] _model The tree model.
+/// \param[in] _rows Expected number of rows.
+/// \return True if the rows were reached.
+bool waitForRows(const sim::TreeModel &_model, int _rows)
+{
+  int sleep = 0;
+  int maxSleep = 30;
+  while (_model.rowCount() != _rows && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+  return _model.rowCount() == _rows;
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityTreeGui, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Batches))
+{
+  // Create app
+  auto app = std::make_unique<gui::Application>(g_argc, g_argv);
+  ASSERT_NE(nullptr, app);
+
+  sim::TreeModel model;
+  model.SetBatchSize(2u);
+
+  for (sim::Entity entity = 1; entity <= 5; ++entity)
+  {
+    model.QueueAddEntity(entity, "model_" + QString::number(entity),
+        sim::kNullEntity, "model");
+  }
+
+  // Nothing is added until the Qt thread processes the queue
+  EXPECT_EQ(0, model.rowCount());
+
+  // Each batch only adds as many entities as the batch size
+  model.ProcessQueue();
+  EXPECT_EQ(2, model.rowCount());
+
+  // The remaining batches are scheduled on the event loop
+  EXPECT_TRUE(waitForRows(model, 5));
+
+  // Removals go through the same queue
+  model.QueueRemoveEntity(5);
+  EXPECT_TRUE(waitForRows(model, 4));
+  EXPECT_FALSE(model.IndexFromEntity(5).isValid());
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityTreeGui, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LazyChildren))
+{
+  // Create app
+  auto app = std::make_unique<gui::Application>(g_argc, g_argv);
+  ASSERT_NE(nullptr, app);
+
+  sim::TreeModel model;
+
+  // A grandchild that arrives before its parent waits for it
+  model.AddEntity(3, "visual", 2, "visual");
+  model.AddEntity(1, "model", sim::kNullEntity, "model");
+  model.AddEntity(2, "link", 1, "link");
+  EXPECT_EQ(1, model.rowCount());
+
+  // The children of the model only get items once it's expanded
+  auto modelIndex = model.index(0, 0);
+  ASSERT_TRUE(modelIndex.isValid());
+  EXPECT_EQ(1u, model.EntityId(modelIndex));
+  EXPECT_EQ(0, model.rowCount(modelIndex));
+  EXPECT_TRUE(model.hasChildren(modelIndex));
+  EXPECT_TRUE(model.canFetchMore(modelIndex));
+
+  model.fetchMore(modelIndex);
+  EXPECT_EQ(1, model.rowCount(modelIndex));
+  EXPECT_FALSE(model.canFetchMore(modelIndex));
+
+  auto linkIndex = model.index(0, 0, modelIndex);
+  ASSERT_TRUE(linkIndex.isValid());
+  EXPECT_EQ(2u, model.EntityId(linkIndex));
+  EXPECT_EQ(0, model.rowCount(linkIndex));
+  EXPECT_TRUE(model.canFetchMore(linkIndex));
+
+  // Children added to an expanded entity get their item right away
+  model.AddEntity(4, "collision", 2, "collision");
+  model.AddEntity(5, "joint", 1, "joint");
+  EXPECT_EQ(2, model.rowCount(modelIndex));
+
+  // Looking up an entity creates the items of its ancestors' children
+  auto visualIndex = model.IndexFromEntity(3);
+  ASSERT_TRUE(visualIndex.isValid());
+  EXPECT_EQ(3u, model.EntityId(visualIndex));
+  EXPECT_EQ(linkIndex, visualIndex.parent());
+  EXPECT_EQ(2, model.rowCount(linkIndex));
+  EXPECT_EQ(QString("model::link::visual"), model.ScopedName(visualIndex));
+
+  // Removing an entity forgets its children, with or without items
+  model.AddEntity(6, "nested", 5, "link");
+  model.RemoveEntity(1);
+  EXPECT_EQ(0, model.rowCount());
+  for (sim::Entity entity = 1; entity <= 6; ++entity)
+    EXPECT_FALSE(model.IndexFromEntity(entity).isValid()) << entity;
+
+  // The entities can be added again
+  model.AddEntity(1, "model", sim::kNullEntity, "model");
+  model.AddEntity(2, "link", 1, "link");
+  modelIndex = model.index(0, 0);
+  EXPECT_TRUE(model.canFetchMore(modelIndex));
+  EXPECT_TRUE(model.IndexFromEntity(2).isValid());
+}
@@ -17,6 +17,9 @@
 
 #include <gz/msgs/marker.pb.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <mutex>
 #include <string>
 
@@ -62,12 +65,28 @@ namespace gz::sim::gui
     /// \brief Whether the target name has been changed.
     public: bool targetNameDirty{false};
 
-    /// \brief Current marker message.
-    public: msgs::Marker markerMsg;
+    /// \brief Send a segment of the plot to the marker manager.
+    /// \param[in] _msg Marker message of the segment.
+    public: void Send(msgs::Marker &_msg);
+
+    /// \brief Marker messages of the segments of the plot, oldest first.
+    /// The plot is split in line strips so that a new point only resends
+    /// the last segment, and old points are deleted a whole segment at a
+    /// time. Each segment starts at the last point of the previous one.
+    public: std::deque<msgs::Marker> segments;
+
+    /// \brief Number of points in all segments.
+    public: int pointCount{0};
+
+    /// \brief ID of the next segment marker.
+    public: uint64_t nextSegmentId{0u};
 
     /// \brief Marker color.
     public: math::Color color{math::Color::Blue};
 
+    /// \brief Whether the color changed and the segments must be resent.
+    public: bool colorDirty{false};
+
     /// \brief Previous plotted position.
     public: math::Vector3d prevPos;
 
@@ -92,6 +111,14 @@ using namespace gz;
 using namespace gz::sim;
 using namespace gz::sim::gui;
 
+/////////////////////////////////////////////////
+void Plot3DPrivate::Send(msgs::Marker &_msg)
+{
+  msgs::Set(_msg.mutable_material()->mutable_ambient(), this->color);
+  msgs::Set(_msg.mutable_material()->mutable_diffuse(), this->color);
+  this->node.Request("/marker", _msg);
+}
+
 /////////////////////////////////////////////////
 Plot3D::Plot3D()
   : GuiSystem(), dataPtr(std::make_unique<Plot3DPrivate>())
@@ -163,11 +190,15 @@ void Plot3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 void Plot3D::ClearPlot()
 {
   // Clear previous plot
-  if (this->dataPtr->markerMsg.point().size() > 0)
+  if (!this->dataPtr->segments.empty())
   {
-    this->dataPtr->markerMsg.set_action(msgs::Marker::DELETE_MARKER);
-    this->dataPtr->node.Request("/marker", this->dataPtr->markerMsg);
+    msgs::Marker msg;
+    msg.set_ns(this->dataPtr->segments.front().ns());
+    msg.set_action(msgs::Marker::DELETE_ALL);
+    this->dataPtr->node.Request("/marker", msg);
   }
+  this->dataPtr->segments.clear();
+  this->dataPtr->pointCount = 0;
 }
 
 //////////////////////////////////////////////////
@@ -220,14 +251,6 @@ void Plot3D::Update(const UpdateInfo &, EntityComponentManager &_ecm)
   {
     this->ClearPlot();
 
-    // Reset message
-    this->dataPtr->markerMsg.Clear();
-    this->dataPtr->markerMsg.set_ns("plot_" + this->dataPtr->targetName);
-    this->dataPtr->markerMsg.set_id(this->dataPtr->targetEntity);
-    this->dataPtr->markerMsg.set_action(msgs::Marker::ADD_MODIFY);
-    this->dataPtr->markerMsg.set_type(msgs::Marker::LINE_STRIP);
-    this->dataPtr->markerMsg.set_visibility(msgs::Marker::GUI);
-
     // Update view
     this->TargetEntityChanged();
     this->TargetNameChanged();
@@ -240,24 +263,68 @@ void Plot3D::Update(const UpdateInfo &, EntityComponentManager &_ecm)
 
   auto point = (pose * offsetPose).Pos();
 
+  // Points keep their segment, so a new color is applied to all of them
+  if (this->dataPtr->colorDirty)
+  {
+    this->dataPtr->colorDirty = false;
+    for (auto &segment : this->dataPtr->segments)
+      this->dataPtr->Send(segment);
+  }
+
   // Only add points if the distance is past a threshold.
   if (point.Distance(this->dataPtr->prevPos) < this->dataPtr->minDistance)
     return;
 
   this->dataPtr->prevPos = point;
-  msgs::Set(this->dataPtr->markerMsg.add_point(), point);
 
-  // Reduce message array
-  if (this->dataPtr->markerMsg.point_size() > this->dataPtr->maxPoints)
-    this->dataPtr->markerMsg.mutable_point()->DeleteSubrange(0, 5);
+  // Segments hold a tenth of the plot, so truncating it removes a tenth of
+  // the points at once
+  auto &segments = this->dataPtr->segments;
+  const int segmentSize =
+      std::clamp(this->dataPtr->maxPoints / 10, 2, 100);
+  if (segments.empty() || segments.back().point_size() >= segmentSize)
+  {
+    msgs::Marker segment;
+    segment.set_ns("plot_" + this->dataPtr->targetName + "_" +
+        std::to_string(this->dataPtr->targetEntity));
+    segment.set_id(this->dataPtr->nextSegmentId++);
+    segment.set_action(msgs::Marker::ADD_MODIFY);
+    segment.set_type(msgs::Marker::LINE_STRIP);
+    segment.set_visibility(msgs::Marker::GUI);
+    if (!segments.empty())
+    {
+      *segment.add_point() = segments.back().point(
+          segments.back().point_size() - 1);
+      ++this->dataPtr->pointCount;
+    }
+    segments.push_back(segment);
+  }
+  msgs::Set(segments.back().add_point(), point);
+  ++this->dataPtr->pointCount;
+
+  // Delete the oldest points
+  while (this->dataPtr->pointCount > this->dataPtr->maxPoints)
+  {
+    if (segments.size() == 1u)
+    {
+      const int extra = this->dataPtr->pointCount - this->dataPtr->maxPoints;
+      segments.front().mutable_point()->DeleteSubrange(0,
+          std::min(extra, segments.front().point_size()));
+      this->dataPtr->pointCount = segments.front().point_size();
+      break;
+    }
 
-  msgs::Set(this->dataPtr->markerMsg.mutable_material()->mutable_ambient(),
-    this->dataPtr->color);
-  msgs::Set(this->dataPtr->markerMsg.mutable_material()->mutable_diffuse(),
-    this->dataPtr->color);
+    msgs::Marker msg;
+    msg.set_ns(segments.front().ns());
+    msg.set_id(segments.front().id());
+    msg.set_action(msgs::Marker::DELETE_MARKER);
+    this->dataPtr->node.Request("/marker", msg);
+    this->dataPtr->pointCount -= segments.front().point_size();
+    segments.pop_front();
+  }
 
-  // Request
-  this->dataPtr->node.Request("/marker", this->dataPtr->markerMsg);
+  // Only the last segment changed
+  this->dataPtr->Send(segments.back());
 }
 
 /////////////////////////////////////////////////
@@ -369,6 +436,7 @@ void Plot3D::SetColor(const QVector3D &_color)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->color.Set(_color.x(), _color.y(), _color.z());
+  this->dataPtr->colorDirty = true;
   this->ColorChanged();
 }
 
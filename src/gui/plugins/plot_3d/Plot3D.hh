@@ -56,7 +56,8 @@ namespace gui
   /// this distance from the previous point. Defaults to 0.05 m.
   ///
   /// * `<maximum_points> (optional)`: Maximum number of points on the plot.
-  /// After this number is reached, the older points start being deleted.
+  /// After this number is reached, the older points start being deleted, a
+  /// tenth of the plot at a time.
   /// Defaults to 1000.
   ///
   class Plot3D : public gz::sim::GuiSystem
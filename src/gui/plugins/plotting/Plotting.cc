@@ -17,10 +17,20 @@
 
 #include "Plotting.hh"
 
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/double_v.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include <gz/math/Pose3.hh>
 #include <gz/math/SphericalCoordinates.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
 
 #include "gz/sim/components/AngularAcceleration.hh"
 #include "gz/sim/components/AngularVelocity.hh"
@@ -32,6 +42,7 @@
 #include "gz/sim/components/LinearVelocity.hh"
 #include "gz/sim/components/LinearVelocitySeed.hh"
 #include "gz/sim/components/MagneticField.hh"
+#include "gz/sim/components/Name.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/Physics.hh"
 #include "gz/sim/components/Pose.hh"
@@ -44,8 +55,30 @@
 
 namespace gz::sim
 {
+  /// \brief An attribute streamed by the component sampler system.
+  struct SamplerChannel
+  {
+    /// \brief Topic of the batches, empty until the sampler replied.
+    std::string topic;
+
+    /// \brief True once the topic is subscribed.
+    bool subscribed{false};
+
+    /// \brief (time, minimum, maximum) triples received since the last
+    /// update.
+    std::vector<double> points;
+  };
+
   class PlottingPrivate
   {
+    /// \brief Request a sampler channel for an attribute.
+    /// \param[in] _key "<entity>,<typeId>,<attribute>" of the attribute.
+    public: void AddChannel(const std::string &_key);
+
+    /// \brief Stop streaming an attribute.
+    /// \param[in] _key "<entity>,<typeId>,<attribute>" of the attribute.
+    public: void RemoveChannel(const std::string &_key);
+
     /// \brief Interface to communicate with Qml
     public: std::unique_ptr<gui::PlottingInterface> plottingIface{nullptr};
 
@@ -56,6 +89,28 @@ namespace gz::sim
 
     /// \brief Mutex to protect the components map.
     public: std::recursive_mutex componentsMutex;
+
+    /// \brief Prefix of the sampler services, empty until the world is
+    /// known.
+    public: std::string samplerNs;
+
+    /// \brief Attributes streamed by the sampler, by
+    /// "<entity>,<typeId>,<attribute>". Attributes are plotted from the
+    /// ECM until their channel is subscribed, so worlds without the
+    /// sampler keep working.
+    public: std::map<std::string, SamplerChannel> channels;
+
+    /// \brief Topics of channels that were removed before the sampler
+    /// replied, to be released on the next update.
+    public: std::vector<std::string> orphanTopics;
+
+    /// \brief Protects the channels, which are filled by transport
+    /// callbacks.
+    public: std::mutex channelsMutex;
+
+    /// \brief Transport node used to reach the component sampler. It's
+    /// the last member so its callbacks stop before the rest is destroyed.
+    public: transport::Node node;
   };
 
   class PlotComponentPrivate
@@ -208,6 +263,64 @@ ComponentTypeId PlotComponent::TypeId()
   return this->dataPtr->typeId;
 }
 
+//////////////////////////////////////////////////
+void PlottingPrivate::AddChannel(const std::string &_key)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->channelsMutex);
+    if (this->samplerNs.empty() || this->channels.count(_key) > 0)
+      return;
+    this->channels[_key];
+  }
+
+  // The request waits until a sampler is advertised, and the attribute is
+  // plotted from the ECM in the meantime
+  std::function<void(const msgs::StringMsg &, const bool)> cb =
+      [this, _key](const msgs::StringMsg &_rep, const bool _result)
+      {
+        if (!_result)
+          return;
+        std::lock_guard<std::mutex> lock(this->channelsMutex);
+        auto it = this->channels.find(_key);
+        if (it == this->channels.end())
+          this->orphanTopics.push_back(_rep.data());
+        else
+          it->second.topic = _rep.data();
+      };
+
+  msgs::StringMsg req;
+  req.set_data(_key);
+  this->node.Request(this->samplerNs + "/add", req, cb);
+}
+
+//////////////////////////////////////////////////
+void PlottingPrivate::RemoveChannel(const std::string &_key)
+{
+  std::string topic;
+  bool subscribed{false};
+  {
+    std::lock_guard<std::mutex> lock(this->channelsMutex);
+    auto it = this->channels.find(_key);
+    if (it == this->channels.end())
+      return;
+    topic = it->second.topic;
+    subscribed = it->second.subscribed;
+    this->channels.erase(it);
+  }
+
+  if (topic.empty())
+    return;
+
+  if (subscribed)
+    this->node.Unsubscribe(topic);
+
+  std::function<void(const msgs::Boolean &, const bool)> cb =
+      [](const msgs::Boolean &, const bool) {};
+  msgs::StringMsg req;
+  req.set_data(topic);
+  this->node.Request(this->samplerNs + "/remove", req, cb);
+}
+
 //////////////////////////////////////////////////
 Plotting::Plotting() : GuiSystem(),
   dataPtr(std::make_unique<PlottingPrivate>())
@@ -366,6 +479,7 @@ void Plotting::RegisterChartToComponent(uint64_t _entity, uint64_t _typeId,
   }
 
   this->dataPtr->components[Id]->RegisterChart(_attribute, _chart);
+  this->dataPtr->AddChannel(Id + "," + _attribute);
 }
 
 //////////////////////////////////////////////////
@@ -381,6 +495,11 @@ void Plotting::UnRegisterChartFromComponent(uint64_t _entity, uint64_t _typeId,
 
   this->dataPtr->components[id]->UnRegisterChart(_attribute, _chart);
 
+  auto data = this->dataPtr->components[id]->Data();
+  auto attribute = data.find(_attribute);
+  if (attribute != data.end() && attribute->second->ChartCount() == 0)
+    this->dataPtr->RemoveChannel(id + "," + _attribute);
+
   if (!this->dataPtr->components[id]->HasCharts())
     this->dataPtr->components.erase(id);
 }
@@ -403,6 +522,100 @@ void Plotting::Update(const gz::sim::UpdateInfo &_info,
                        gz::sim::EntityComponentManager &_ecm)
 {
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->componentsMutex);
+
+  if (this->dataPtr->samplerNs.empty())
+  {
+    auto worldEntity = _ecm.EntityByComponents(components::World());
+    auto worldName = _ecm.Component<components::Name>(worldEntity);
+    if (worldName)
+    {
+      this->dataPtr->samplerNs = transport::TopicUtils::AsValidTopic(
+          "/world/" + worldName->Data() + "/sampler");
+
+      // Request channels for the charts registered before the world was
+      // known
+      for (const auto &component : this->dataPtr->components)
+      {
+        for (const auto &attribute : component.second->Data())
+        {
+          if (attribute.second->ChartCount() > 0)
+            this->dataPtr->AddChannel(component.first + "," +
+                attribute.first);
+        }
+      }
+    }
+  }
+
+  // Subscribe to the channels the sampler replied to, release the ones that
+  // are no longer needed, and collect the points received since the last
+  // update
+  std::map<std::string, std::string> newTopics;
+  std::vector<std::string> orphans;
+  {
+    std::lock_guard<std::mutex> channelsLock(this->dataPtr->channelsMutex);
+    for (const auto &[key, channel] : this->dataPtr->channels)
+    {
+      if (!channel.subscribed && !channel.topic.empty())
+        newTopics[key] = channel.topic;
+    }
+    orphans.swap(this->dataPtr->orphanTopics);
+  }
+
+  // Transport calls are made without holding the lock, which the
+  // subscription callbacks take
+  for (const auto &[key, topic] : newTopics)
+  {
+    std::function<void(const msgs::Double_V &)> cb =
+        [this, key = key](const msgs::Double_V &_msg)
+        {
+          std::lock_guard<std::mutex> cbLock(this->dataPtr->channelsMutex);
+          auto it = this->dataPtr->channels.find(key);
+          if (it != this->dataPtr->channels.end())
+          {
+            it->second.points.insert(it->second.points.end(),
+                _msg.data().begin(), _msg.data().end());
+          }
+        };
+    const bool subscribed = this->dataPtr->node.Subscribe(topic, cb);
+    if (!subscribed)
+    {
+      gzwarn << "Failed to subscribe to sampler topic [" << topic
+             << "], plotting [" << key << "] from the GUI." << std::endl;
+    }
+
+    // Failed channels are released and stay plotted from the ECM
+    std::lock_guard<std::mutex> channelsLock(this->dataPtr->channelsMutex);
+    auto it = this->dataPtr->channels.find(key);
+    if (it != this->dataPtr->channels.end())
+    {
+      it->second.subscribed = subscribed;
+      if (!subscribed)
+        it->second.topic.clear();
+    }
+    if (!subscribed)
+      this->dataPtr->orphanTopics.push_back(topic);
+  }
+
+  std::map<std::string, std::vector<double>> sampled;
+  {
+    std::lock_guard<std::mutex> channelsLock(this->dataPtr->channelsMutex);
+    for (auto &[key, channel] : this->dataPtr->channels)
+    {
+      if (channel.subscribed)
+        sampled[key].swap(channel.points);
+    }
+  }
+
+  for (const auto &topic : orphans)
+  {
+    std::function<void(const msgs::Boolean &, const bool)> cb =
+        [](const msgs::Boolean &, const bool) {};
+    msgs::StringMsg req;
+    req.set_data(topic);
+    this->dataPtr->node.Request(this->dataPtr->samplerNs + "/remove", req,
+        cb);
+  }
+
   for (auto component : this->dataPtr->components)
   {
     auto entity = component.second->Entity();
@@ -538,6 +751,29 @@ void Plotting::Update(const gz::sim::UpdateInfo &_info,
 
     for (auto attribute : component.second->Data())
     {
+      // Streamed attributes are plotted as the envelope of every sample,
+      // two points per bucket where the value changed within it
+      auto stream = sampled.find(component.first + "," + attribute.first);
+      if (stream != sampled.end())
+      {
+        QString attributeName = QString::fromStdString(stream->first);
+        const auto &points = stream->second;
+        for (auto chart : attribute.second->Charts())
+        {
+          for (std::size_t i = 0; i + 2 < points.size(); i += 3)
+          {
+            emit this->dataPtr->plottingIface->plot(chart, attributeName,
+                points[i], points[i + 1]);
+            if (points[i + 2] != points[i + 1])
+            {
+              emit this->dataPtr->plottingIface->plot(chart, attributeName,
+                  points[i], points[i + 2]);
+            }
+          }
+        }
+        continue;
+      }
+
       for (auto chart : attribute.second->Charts())
       {
         QString attributeName = QString::fromStdString(
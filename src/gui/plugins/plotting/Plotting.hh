@@ -95,6 +95,13 @@ class PlottingPrivate;
 
 /// \brief Physics data plotting handler that keeps track of the
 /// registered components, update them and update the plot
+///
+/// If the world runs the ComponentSampler system, attributes it supports
+/// are streamed from the server instead: every simulation step is sampled
+/// and the plot receives the minimum and maximum of each batch bucket, so
+/// fast signals aren't aliased by the GUI update rate. Other attributes,
+/// and all attributes in worlds without the sampler, are read from the GUI
+/// ECM on every update.
 class Plotting : public gz::sim::GuiSystem
 {
   Q_OBJECT
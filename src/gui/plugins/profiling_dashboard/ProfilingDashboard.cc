@@ -0,0 +1,529 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ProfilingDashboard.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/gui/Application.hh>
+#include <gz/gui/Helpers.hh>
+#include <gz/msgs/param_v.pb.h>
+#include <gz/msgs/world_stats.pb.h>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+namespace gz::sim
+{
+  /// \brief Timing of a system in a phase.
+  struct PhaseTiming
+  {
+    /// \brief Name of the system.
+    std::string system;
+
+    /// \brief Name of the phase.
+    std::string phase;
+
+    /// \brief Mean duration of the calls, in nanoseconds.
+    double meanNs{0.0};
+
+    /// \brief 99th percentile of the durations, in nanoseconds.
+    double p99Ns{0.0};
+  };
+
+  /// \brief Memory used by the components of a type.
+  struct TypeMemory
+  {
+    /// \brief Name of the component type.
+    std::string type;
+
+    /// \brief Number of components.
+    double count{0.0};
+
+    /// \brief Bytes of the components and of the heap they own.
+    double bytes{0.0};
+  };
+
+  /// \brief Data received on a metered topic since the last refresh.
+  struct TopicTraffic
+  {
+    /// \brief Number of bytes.
+    std::size_t bytes{0u};
+
+    /// \brief Number of messages.
+    std::size_t messages{0u};
+  };
+
+  class ProfilingDashboardPrivate
+  {
+    /// \brief Callback for system timings.
+    /// \param[in] _msg One param per system and phase.
+    public: void OnProfile(const msgs::Param_V &_msg);
+
+    /// \brief Callback for component memory usage.
+    /// \param[in] _msg One param per component type, largest first.
+    public: void OnMemory(const msgs::Param_V &_msg);
+
+    /// \brief Callback for world statistics.
+    /// \param[in] _msg World statistics.
+    public: void OnStats(const msgs::WorldStatistics &_msg);
+
+    /// \brief Build the blocks of the flame graph.
+    /// \param[in] _timings Latest system timings.
+    public: void BuildStepBlocks(std::vector<PhaseTiming> &_timings);
+
+    /// \brief Name of the world.
+    public: std::string worldName;
+
+    /// \brief Number of statistics messages the real time factor jitter is
+    /// computed over.
+    public: std::size_t rtfSamples{100u};
+
+    /// \brief Protects timings, memory, rtf and traffic, which are written
+    /// from transport threads.
+    public: std::mutex mutex;
+
+    /// \brief Latest system timings.
+    public: std::vector<PhaseTiming> timings;
+
+    /// \brief Latest memory usage of component types.
+    public: std::vector<TypeMemory> memory;
+
+    /// \brief Latest real time factors, while not paused.
+    public: std::deque<double> rtf;
+
+    /// \brief Traffic of each metered topic.
+    public: std::map<std::string, TopicTraffic> traffic;
+
+    /// \brief Time of the last refresh.
+    public: std::chrono::steady_clock::time_point lastRefresh;
+
+    /// \brief Blocks of the flame graph.
+    public: QVariantList stepBlocks;
+
+    /// \brief Statistics of the real time factor.
+    public: QVariantMap rtfStats;
+
+    /// \brief Component types using the most memory.
+    public: QVariantList memoryTypes;
+
+    /// \brief Bandwidth of the metered topics.
+    public: QVariantList bandwidth;
+
+    /// \brief Whether system timings were received.
+    public: bool profiling{false};
+
+    /// \brief Timer triggering refreshes.
+    public: QTimer *timer{nullptr};
+
+    /// \brief Node for the profiling and statistics topics. Nodes are
+    /// declared last, so their callbacks stop before the data is destroyed.
+    public: transport::Node node;
+
+    /// \brief Node for the raw subscriptions of metered topics.
+    public: transport::Node meterNode;
+  };
+}
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Format a number of bytes with a readable unit.
+/// \param[in] _bytes Number of bytes.
+/// \return Formatted string, such as "1.5 MB".
+QString formatBytes(double _bytes)
+{
+  const char *units[] = {"B", "kB", "MB", "GB"};
+  std::size_t unit{0u};
+  while (_bytes >= 1000.0 && unit < 3u)
+  {
+    _bytes /= 1000.0;
+    ++unit;
+  }
+  return QString::number(_bytes, 'f', unit == 0u ? 0 : 1) + " " + units[unit];
+}
+
+/// \brief Get a value from the params of a message.
+/// \param[in] _params Params.
+/// \param[in] _key Key of the value.
+/// \return The value, or an empty one if it's missing.
+const msgs::Any &param(
+    const google::protobuf::Map<std::string, msgs::Any> &_params,
+    const std::string &_key)
+{
+  auto it = _params.find(_key);
+  return it == _params.end() ? msgs::Any::default_instance() : it->second;
+}
+
+/// \brief Format a duration in nanoseconds as milliseconds.
+/// \param[in] _ns Duration in nanoseconds.
+/// \return Formatted string, such as "1.25 ms".
+QString formatMs(double _ns)
+{
+  return QString::number(_ns * 1e-6, 'f', 2) + " ms";
+}
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboardPrivate::OnProfile(const msgs::Param_V &_msg)
+{
+  std::vector<PhaseTiming> received;
+  received.reserve(_msg.param_size());
+  for (const auto &row : _msg.param())
+  {
+    PhaseTiming timing;
+    timing.system = param(row.params(), "system").string_value();
+    timing.phase = param(row.params(), "phase").string_value();
+    timing.meanNs = param(row.params(), "mean_ns").double_value();
+    timing.p99Ns = param(row.params(), "p99_ns").double_value();
+    received.push_back(std::move(timing));
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->timings.swap(received);
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboardPrivate::OnMemory(const msgs::Param_V &_msg)
+{
+  std::vector<TypeMemory> received;
+  received.reserve(_msg.param_size());
+  for (const auto &row : _msg.param())
+  {
+    TypeMemory usage;
+    usage.type = param(row.params(), "type").string_value();
+    usage.count = param(row.params(), "count").double_value();
+    usage.bytes = param(row.params(), "bytes").double_value() +
+        param(row.params(), "heap_bytes").double_value();
+    received.push_back(std::move(usage));
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->memory.swap(received);
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboardPrivate::OnStats(const msgs::WorldStatistics &_msg)
+{
+  if (_msg.paused())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->rtf.push_back(_msg.real_time_factor());
+  while (this->rtf.size() > this->rtfSamples)
+    this->rtf.pop_front();
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboardPrivate::BuildStepBlocks(
+    std::vector<PhaseTiming> &_timings)
+{
+  this->stepBlocks.clear();
+  this->profiling = !_timings.empty();
+
+  double total{0.0};
+  for (const auto &timing : _timings)
+    total += timing.meanNs;
+  if (!(total > 0.0))
+    return;
+
+  auto addBlock = [&](const QString &_label, const QString &_tip,
+      int _depth, double _start, double _width, int _phase)
+  {
+    QVariantMap block;
+    block["label"] = _label;
+    block["tip"] = _tip;
+    block["depth"] = _depth;
+    block["start"] = _start / total;
+    block["width"] = _width / total;
+    block["phase"] = _phase;
+    this->stepBlocks.push_back(block);
+  };
+
+  addBlock("Step " + formatMs(total), "Sum of the phases", 0, 0.0, total, -1);
+
+  // Phases in the order they run, each with its systems, slowest first
+  std::sort(_timings.begin(), _timings.end(),
+      [](const PhaseTiming &_a, const PhaseTiming &_b)
+      {
+        return _a.meanNs > _b.meanNs;
+      });
+
+  const std::vector<std::string> phases{"PreUpdate", "Update", "PostUpdate"};
+  double phaseStart{0.0};
+  for (std::size_t i = 0; i < phases.size(); ++i)
+  {
+    const auto index = static_cast<int>(i);
+    double start{phaseStart};
+    for (const auto &timing : _timings)
+    {
+      if (timing.phase != phases[i])
+        continue;
+
+      addBlock(QString::fromStdString(timing.system) + " " +
+          formatMs(timing.meanNs),
+          QString::fromStdString(timing.system + " " + timing.phase) +
+          ": mean " + formatMs(timing.meanNs) + ", p99 " +
+          formatMs(timing.p99Ns),
+          2, start, timing.meanNs, index);
+      start += timing.meanNs;
+    }
+
+    const double phaseTime = start - phaseStart;
+    if (phaseTime > 0.0)
+    {
+      const auto name = QString::fromStdString(phases[i]);
+      addBlock(name + " " + formatMs(phaseTime), name, 1, phaseStart,
+          phaseTime, index);
+    }
+    phaseStart = start;
+  }
+}
+
+/////////////////////////////////////////////////
+ProfilingDashboard::ProfilingDashboard()
+  : gz::gui::Plugin(),
+  dataPtr(std::make_unique<ProfilingDashboardPrivate>())
+{
+  this->dataPtr->lastRefresh = std::chrono::steady_clock::now();
+  this->dataPtr->timer = new QTimer(this);
+  connect(this->dataPtr->timer, &QTimer::timeout,
+      this, &ProfilingDashboard::Refresh);
+  this->dataPtr->timer->start(1000);
+}
+
+/////////////////////////////////////////////////
+ProfilingDashboard::~ProfilingDashboard() = default;
+
+/////////////////////////////////////////////////
+void ProfilingDashboard::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Profiling dashboard";
+
+  const auto worldNames = gz::gui::worldNames();
+  if (worldNames.empty())
+  {
+    gzerr << "Profiling dashboard couldn't find the world name."
+          << std::endl;
+    return;
+  }
+  this->dataPtr->worldName = worldNames[0].toStdString();
+  const std::string prefix{"/world/" + this->dataPtr->worldName};
+
+  std::vector<std::string> topics;
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("rtf_samples"))
+    {
+      int samples{0};
+      if (elem->QueryIntText(&samples) == tinyxml2::XML_SUCCESS &&
+          samples > 0)
+      {
+        this->dataPtr->rtfSamples = static_cast<std::size_t>(samples);
+      }
+    }
+
+    for (auto elem = _pluginElem->FirstChildElement("topic");
+        elem != nullptr; elem = elem->NextSiblingElement("topic"))
+    {
+      if (elem->GetText())
+        topics.push_back(elem->GetText());
+    }
+  }
+
+  // These are all subscribed to by the GUI anyway
+  if (topics.empty())
+    topics = {prefix + "/state", prefix + "/stats", prefix + "/profile"};
+
+  this->dataPtr->node.Subscribe(prefix + "/profile",
+      &ProfilingDashboardPrivate::OnProfile, this->dataPtr.get());
+  this->dataPtr->node.Subscribe(prefix + "/profile/memory",
+      &ProfilingDashboardPrivate::OnMemory, this->dataPtr.get());
+  this->dataPtr->node.Subscribe(prefix + "/stats",
+      &ProfilingDashboardPrivate::OnStats, this->dataPtr.get());
+
+  for (const auto &topic : topics)
+    this->AddTopic(QString::fromStdString(topic));
+}
+
+/////////////////////////////////////////////////
+QVariantList ProfilingDashboard::StepBlocks() const
+{
+  return this->dataPtr->stepBlocks;
+}
+
+/////////////////////////////////////////////////
+QVariantMap ProfilingDashboard::Rtf() const
+{
+  return this->dataPtr->rtfStats;
+}
+
+/////////////////////////////////////////////////
+QVariantList ProfilingDashboard::MemoryTypes() const
+{
+  return this->dataPtr->memoryTypes;
+}
+
+/////////////////////////////////////////////////
+QVariantList ProfilingDashboard::Bandwidth() const
+{
+  return this->dataPtr->bandwidth;
+}
+
+/////////////////////////////////////////////////
+bool ProfilingDashboard::Profiling() const
+{
+  return this->dataPtr->profiling;
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboard::AddTopic(const QString &_topic)
+{
+  const auto topic = transport::TopicUtils::AsValidTopic(
+      _topic.trimmed().toStdString());
+  if (topic.empty())
+  {
+    gzerr << "Can't meter invalid topic [" << _topic.toStdString() << "]."
+          << std::endl;
+    return;
+  }
+
+  auto data = this->dataPtr.get();
+  {
+    std::lock_guard<std::mutex> lock(data->mutex);
+    if (!data->traffic.emplace(topic, TopicTraffic()).second)
+      return;
+  }
+
+  // Messages are only counted, never deserialized
+  auto callback = [data, topic](const char *, const std::size_t _size,
+      const transport::MessageInfo &)
+  {
+    std::lock_guard<std::mutex> lock(data->mutex);
+    auto it = data->traffic.find(topic);
+    if (it != data->traffic.end())
+    {
+      it->second.bytes += _size;
+      ++it->second.messages;
+    }
+  };
+
+  if (!data->meterNode.SubscribeRaw(topic, callback))
+  {
+    gzerr << "Failed to meter topic [" << topic << "]." << std::endl;
+    std::lock_guard<std::mutex> lock(data->mutex);
+    data->traffic.erase(topic);
+  }
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboard::RemoveTopic(const QString &_topic)
+{
+  const auto topic = _topic.toStdString();
+  this->dataPtr->meterNode.Unsubscribe(topic);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->traffic.erase(topic);
+}
+
+/////////////////////////////////////////////////
+void ProfilingDashboard::Refresh()
+{
+  std::vector<PhaseTiming> timings;
+  std::vector<TypeMemory> memory;
+  std::vector<double> rtf;
+  std::map<std::string, TopicTraffic> traffic;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    timings = this->dataPtr->timings;
+    memory = this->dataPtr->memory;
+    rtf.assign(this->dataPtr->rtf.begin(), this->dataPtr->rtf.end());
+    for (auto &[topic, received] : this->dataPtr->traffic)
+    {
+      traffic[topic] = received;
+      received = TopicTraffic();
+    }
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed = std::max(1e-3,
+      std::chrono::duration<double>(now - this->dataPtr->lastRefresh).count());
+  this->dataPtr->lastRefresh = now;
+
+  this->dataPtr->BuildStepBlocks(timings);
+
+  // Jitter is the standard deviation over the latest messages
+  this->dataPtr->rtfStats.clear();
+  if (!rtf.empty())
+  {
+    double mean{0.0};
+    for (double value : rtf)
+      mean += value;
+    mean /= static_cast<double>(rtf.size());
+
+    double variance{0.0};
+    for (double value : rtf)
+      variance += (value - mean) * (value - mean);
+    variance /= static_cast<double>(rtf.size());
+
+    const auto [min, max] = std::minmax_element(rtf.begin(), rtf.end());
+    this->dataPtr->rtfStats["mean"] = QString::number(mean * 100.0, 'f', 1);
+    this->dataPtr->rtfStats["jitter"] =
+        QString::number(std::sqrt(variance) * 100.0, 'f', 1);
+    this->dataPtr->rtfStats["min"] = QString::number(*min * 100.0, 'f', 1);
+    this->dataPtr->rtfStats["max"] = QString::number(*max * 100.0, 'f', 1);
+  }
+
+  this->dataPtr->memoryTypes.clear();
+  for (const auto &usage : memory)
+  {
+    QVariantMap row;
+    row["type"] = QString::fromStdString(usage.type);
+    row["count"] = QString::number(usage.count, 'f', 0);
+    row["memory"] = formatBytes(usage.bytes);
+    this->dataPtr->memoryTypes.push_back(row);
+  }
+
+  this->dataPtr->bandwidth.clear();
+  for (const auto &[topic, received] : traffic)
+  {
+    QVariantMap row;
+    row["topic"] = QString::fromStdString(topic);
+    row["rate"] = formatBytes(static_cast<double>(received.bytes) / elapsed) +
+        "/s";
+    row["messages"] = QString::number(
+        static_cast<double>(received.messages) / elapsed, 'f', 1);
+    this->dataPtr->bandwidth.push_back(row);
+  }
+
+  emit this->Refreshed();
+}
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::sim::ProfilingDashboard,
+              gz::gui::Plugin)
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_GUI_PROFILINGDASHBOARD_HH_
+#define GZ_SIM_GUI_PROFILINGDASHBOARD_HH_
+
+#include <memory>
+
+#include <gz/gui/Plugin.hh>
+
+namespace gz
+{
+namespace sim
+{
+  class ProfilingDashboardPrivate;
+
+  /// \brief Shows where a running server spends its time and memory, so it
+  /// can stay open during long runs.
+  ///
+  /// The dashboard only listens to topics the server already publishes, and
+  /// refreshes once per second:
+  /// * A flame-style breakdown of the step into the PreUpdate, Update and
+  ///   PostUpdate phases and the systems in each of them, from the timings
+  ///   on `/world/<world_name>/profile`. The server must be started with
+  ///   `--profile`. Widths are the mean durations of the calls, so systems
+  ///   running in parallel in PostUpdate add up to more than the wall time.
+  /// * The real time factor from `/world/<world_name>/stats`, with its
+  ///   jitter over the latest messages.
+  /// * The component types using the most memory, from
+  ///   `/world/<world_name>/profile/memory`, which the server only computes
+  ///   while it has subscribers, every 10 seconds.
+  /// * The bandwidth of a few topics, counted without deserializing their
+  ///   messages. Topics that no other part of the GUI subscribes to are
+  ///   only sent to the GUI because they're metered, so metering them adds
+  ///   to the traffic.
+  ///
+  /// ## Configuration
+  ///
+  /// * `<topic>`: Topic to meter, which may be repeated. Defaults to the
+  ///   world's `state`, `stats` and `profile` topics.
+  /// * `<rtf_samples>`: Number of statistics messages the jitter of the real
+  ///   time factor is computed over. Defaults to 100.
+  class ProfilingDashboard : public gz::gui::Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Blocks of the flame graph. Each one is a map with its
+    /// "label", "tip", row "depth", horizontal "start" and "width" as
+    /// fractions of the step, and "phase" index for its color.
+    Q_PROPERTY(
+      QVariantList stepBlocks
+      READ StepBlocks
+      NOTIFY Refreshed
+    )
+
+    /// \brief Real time factor "mean", "jitter" (standard deviation),
+    /// "min" and "max", as percentages in strings.
+    Q_PROPERTY(
+      QVariantMap rtf
+      READ Rtf
+      NOTIFY Refreshed
+    )
+
+    /// \brief Component types using the most memory. Each one is a map with
+    /// the "type", its "count" and its "memory" in a readable unit.
+    Q_PROPERTY(
+      QVariantList memoryTypes
+      READ MemoryTypes
+      NOTIFY Refreshed
+    )
+
+    /// \brief Metered topics, each one a map with the "topic", its "rate"
+    /// in a readable unit and its "messages" per second.
+    Q_PROPERTY(
+      QVariantList bandwidth
+      READ Bandwidth
+      NOTIFY Refreshed
+    )
+
+    /// \brief Whether system timings were received, which means the server
+    /// was started with profiling.
+    Q_PROPERTY(
+      bool profiling
+      READ Profiling
+      NOTIFY Refreshed
+    )
+
+    /// \brief Constructor
+    public: ProfilingDashboard();
+
+    /// \brief Destructor
+    public: ~ProfilingDashboard() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    /// \brief Get the blocks of the flame graph.
+    /// \return List of blocks.
+    public: Q_INVOKABLE QVariantList StepBlocks() const;
+
+    /// \brief Get the statistics of the real time factor.
+    /// \return Map of statistics.
+    public: Q_INVOKABLE QVariantMap Rtf() const;
+
+    /// \brief Get the component types using the most memory.
+    /// \return List of types, largest first.
+    public: Q_INVOKABLE QVariantList MemoryTypes() const;
+
+    /// \brief Get the bandwidth of the metered topics.
+    /// \return List of topics.
+    public: Q_INVOKABLE QVariantList Bandwidth() const;
+
+    /// \brief Get whether system timings were received.
+    /// \return True if the server profiles its systems.
+    public: Q_INVOKABLE bool Profiling() const;
+
+    /// \brief Start metering a topic.
+    /// \param[in] _topic Topic name.
+    public: Q_INVOKABLE void AddTopic(const QString &_topic);
+
+    /// \brief Stop metering a topic.
+    /// \param[in] _topic Topic name.
+    public: Q_INVOKABLE void RemoveTopic(const QString &_topic);
+
+    /// \brief Notify that the displayed values were refreshed.
+    signals: void Refreshed();
+
+    /// \brief Refresh the displayed values from the latest messages, on the
+    /// Qt thread.
+    private slots: void Refresh();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<ProfilingDashboardPrivate> dataPtr;
+  };
+}
+}
+
+#endif
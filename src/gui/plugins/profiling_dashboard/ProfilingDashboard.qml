@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Controls.Material 2.2
+import QtQuick.Layouts 1.3
+
+ScrollView {
+  id: profilingDashboard
+  Layout.minimumWidth: 500
+  Layout.minimumHeight: 500
+  anchors.fill: parent
+  clip: true
+
+  /**
+   * Height of a row of the flame graph.
+   */
+  property int blockHeight: 22
+
+  /**
+   * Colors of the phases, in the order they run.
+   */
+  property var phaseColors: ["#7fb3d5", "#76d7c4", "#f7dc6f"]
+
+  ColumnLayout {
+    width: profilingDashboard.availableWidth
+    spacing: 6
+
+    Label {
+      Layout.fillWidth: true
+      Layout.margins: 10
+      font.bold: true
+      text: ProfilingDashboard.rtf.mean === undefined ?
+          "Real time factor: waiting for statistics" :
+          "Real time factor: " + ProfilingDashboard.rtf.mean + " % ± " +
+          ProfilingDashboard.rtf.jitter + " % (min " +
+          ProfilingDashboard.rtf.min + " %, max " +
+          ProfilingDashboard.rtf.max + " %)"
+    }
+
+    Label {
+      Layout.leftMargin: 10
+      font.bold: true
+      text: "Step time per phase and system"
+    }
+
+    Label {
+      Layout.fillWidth: true
+      Layout.leftMargin: 10
+      visible: !ProfilingDashboard.profiling
+      wrapMode: Text.WordWrap
+      text: "No system timings, start the server with --profile."
+    }
+
+    Item {
+      id: flameGraph
+      Layout.fillWidth: true
+      Layout.leftMargin: 10
+      Layout.rightMargin: 10
+      height: ProfilingDashboard.profiling ? 3 * blockHeight : 0
+
+      Repeater {
+        model: ProfilingDashboard.stepBlocks
+        delegate: Rectangle {
+          x: modelData.start * flameGraph.width
+          y: modelData.depth * blockHeight
+          width: Math.max(1, modelData.width * flameGraph.width - 1)
+          height: blockHeight - 1
+          color: modelData.phase < 0 ? "#d5d8dc" :
+              phaseColors[modelData.phase]
+
+          Text {
+            anchors.fill: parent
+            anchors.leftMargin: 3
+            verticalAlignment: Text.AlignVCenter
+            elide: Text.ElideRight
+            font.pointSize: 8
+            text: modelData.label
+          }
+
+          MouseArea {
+            id: blockArea
+            anchors.fill: parent
+            hoverEnabled: true
+          }
+
+          ToolTip.visible: blockArea.containsMouse
+          ToolTip.delay: 300
+          ToolTip.text: modelData.tip
+        }
+      }
+    }
+
+    Label {
+      Layout.leftMargin: 10
+      Layout.topMargin: 10
+      font.bold: true
+      text: "Largest component types"
+    }
+
+    Label {
+      Layout.leftMargin: 10
+      visible: ProfilingDashboard.memoryTypes.length === 0
+      text: "Waiting for memory usage, published every 10 s while profiling."
+    }
+
+    Repeater {
+      model: ProfilingDashboard.memoryTypes
+      delegate: RowLayout {
+        Layout.fillWidth: true
+        Layout.leftMargin: 10
+        Layout.rightMargin: 10
+
+        Label {
+          Layout.fillWidth: true
+          elide: Text.ElideLeft
+          text: modelData.type
+        }
+        Label {
+          Layout.preferredWidth: 70
+          horizontalAlignment: Text.AlignRight
+          text: modelData.count
+        }
+        Label {
+          Layout.preferredWidth: 80
+          horizontalAlignment: Text.AlignRight
+          text: modelData.memory
+        }
+      }
+    }
+
+    Label {
+      Layout.leftMargin: 10
+      Layout.topMargin: 10
+      font.bold: true
+      text: "Topic bandwidth"
+    }
+
+    Repeater {
+      model: ProfilingDashboard.bandwidth
+      delegate: RowLayout {
+        Layout.fillWidth: true
+        Layout.leftMargin: 10
+        Layout.rightMargin: 10
+
+        Label {
+          Layout.fillWidth: true
+          elide: Text.ElideLeft
+          text: modelData.topic
+        }
+        Label {
+          Layout.preferredWidth: 90
+          horizontalAlignment: Text.AlignRight
+          text: modelData.rate
+        }
+        Label {
+          Layout.preferredWidth: 70
+          horizontalAlignment: Text.AlignRight
+          text: modelData.messages + " Hz"
+        }
+        ToolButton {
+          text: "✕"
+          ToolTip.visible: hovered
+          ToolTip.text: "Stop metering"
+          onClicked: ProfilingDashboard.RemoveTopic(modelData.topic)
+        }
+      }
+    }
+
+    RowLayout {
+      Layout.fillWidth: true
+      Layout.margins: 10
+
+      TextField {
+        id: topicField
+        Layout.fillWidth: true
+        placeholderText: "Topic to meter"
+        onAccepted: meterButton.clicked()
+      }
+      Button {
+        id: meterButton
+        text: "Meter"
+        enabled: topicField.text.length > 0
+        onClicked: {
+          ProfilingDashboard.AddTopic(topicField.text)
+          topicField.text = ""
+        }
+      }
+    }
+  }
+}
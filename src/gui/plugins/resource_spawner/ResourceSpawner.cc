@@ -22,9 +22,13 @@
 #include <gz/msgs/stringmsg_v.pb.h>
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include <sdf/Root.hh>
 #include <sdf/parser.hh>
@@ -45,6 +49,7 @@
 
 
 Q_DECLARE_METATYPE(gz::sim::Resource)
+Q_DECLARE_METATYPE(std::vector<gz::sim::Resource>)
 
 namespace gz::sim
 {
@@ -103,6 +108,72 @@ namespace {
 
 // Default owner to be fetched from Fuel. This owner cannot be removed.
 constexpr const char *kDefaultOwner = "openrobotics";
+
+// Number of resources sent to the GUI thread at once while fetching a list.
+constexpr std::size_t kPageSize = 50u;
+
+/////////////////////////////////////////////////
+/// \brief Get the file where the resource list of an owner is saved.
+/// \param[in] _client Fuel client whose cache holds the file.
+/// \param[in] _owner Name of the owner.
+/// \return Path to the file.
+std::string listCachePath(const gz::fuel_tools::FuelClient &_client,
+    const std::string &_owner)
+{
+  return gz::common::joinPaths(_client.Config().CacheLocation(),
+      "resource_spawner", _owner + ".txt");
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the resource list of an owner saved by a previous session.
+/// Each line holds the name and the unique name of a model, separated by a
+/// tab.
+/// \param[in] _path Path to the file.
+/// \return The resources, empty if there's no saved list.
+std::vector<gz::sim::Resource> readListCache(const std::string &_path)
+{
+  std::vector<gz::sim::Resource> resources;
+  std::ifstream file(_path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const auto tab = line.find('\t');
+    if (tab == std::string::npos)
+      continue;
+    gz::sim::Resource resource;
+    resource.name = line.substr(0, tab);
+    resource.sdfPath = line.substr(tab + 1);
+    resource.isFuel = true;
+    resources.push_back(resource);
+  }
+  return resources;
+}
+
+/////////////////////////////////////////////////
+/// \brief Save the resource list of an owner for the next session.
+/// \param[in] _path Path to the file.
+/// \param[in] _resources Name and unique name of each resource.
+void writeListCache(const std::string &_path,
+    const std::vector<std::pair<std::string, std::string>> &_resources)
+{
+  gz::common::createDirectories(gz::common::parentPath(_path));
+
+  // Written next to the file and moved, so other sessions never read a
+  // partial list
+  const std::string tmpPath = _path + ".tmp";
+  {
+    std::ofstream file(tmpPath);
+    for (const auto &[name, uniqueName] : _resources)
+      file << name << '\t' << uniqueName << '\n';
+    if (!file)
+    {
+      gzwarn << "Failed to save the resource list to [" << _path << "]"
+             << std::endl;
+      return;
+    }
+  }
+  std::rename(tmpPath.c_str(), _path.c_str());
+}
 }
 using namespace gz;
 using namespace sim;
@@ -159,14 +230,55 @@ void ResourceModel::Clear()
 {
   this->clear();
   this->gridIndex = 0;
+  this->keys.clear();
   emit sizeChanged();
 }
 
 /////////////////////////////////////////////////
-void ResourceModel::AddResources(std::vector<Resource> &_resources)
+void ResourceModel::AddResources(const std::vector<Resource> &_resources)
 {
-  for (auto &resource : _resources)
-    this->AddResource(resource);
+  GZ_PROFILE("GridModel::AddResources");
+  if (_resources.empty())
+    return;
+
+  QList<QStandardItem *> items;
+  items.reserve(static_cast<int>(_resources.size()));
+  for (const auto &resource : _resources)
+    items.append(this->NewItem(resource));
+
+  this->invisibleRootItem()->appendRows(items);
+  emit sizeChanged();
+}
+
+/////////////////////////////////////////////////
+void ResourceModel::SetResources(const std::vector<Resource> &_resources)
+{
+  GZ_PROFILE("GridModel::SetResources");
+
+  // Keep the rows that already show the same resources
+  std::size_t kept{0u};
+  while (kept < this->keys.size() && kept < _resources.size())
+  {
+    const auto &resource = _resources[kept];
+    const std::string key = resource.isFuel ?
+        resource.owner + "/" + resource.name : resource.sdfPath;
+    if (key != this->keys[kept])
+      break;
+    this->UpdateResourceModel(static_cast<int>(kept), resource);
+    ++kept;
+  }
+
+  if (kept < this->keys.size())
+  {
+    this->removeRows(static_cast<int>(kept),
+        static_cast<int>(this->keys.size() - kept));
+    this->keys.resize(kept);
+    this->gridIndex = static_cast<int>(kept);
+    emit sizeChanged();
+  }
+
+  this->AddResources(std::vector<Resource>(
+      _resources.begin() + kept, _resources.end()));
 }
 
 /////////////////////////////////////////////////
@@ -175,6 +287,15 @@ void ResourceModel::AddResource(const Resource &_resource)
   GZ_PROFILE_THREAD_NAME("Qt thread");
   GZ_PROFILE("GridModel::AddResource");
 
+  auto resource = this->NewItem(_resource);
+  emit sizeChanged();
+
+  this->appendRow(resource);
+}
+
+/////////////////////////////////////////////////
+QStandardItem *ResourceModel::NewItem(const Resource &_resource)
+{
   auto resource = new QStandardItem(QString::fromStdString(_resource.name));
   resource->setData(_resource.isFuel,
       this->roleNames().key("isFuel"));
@@ -189,25 +310,17 @@ void ResourceModel::AddResource(const Resource &_resource)
   resource->setData(QString::fromStdString(_resource.owner),
       this->roleNames().key("owner"));
 
-  if (_resource.isFuel)
-  {
-    resource->setData(this->gridIndex,
-        this->roleNames().key("index"));
-    this->gridIndex++;
-  }
-  else
-  {
-    resource->setData(this->gridIndex,
-        this->roleNames().key("index"));
-    this->gridIndex++;
-  }
-  emit sizeChanged();
+  resource->setData(this->gridIndex,
+      this->roleNames().key("index"));
+  this->gridIndex++;
+  this->keys.push_back(_resource.isFuel ?
+      _resource.owner + "/" + _resource.name : _resource.sdfPath);
 
-  this->appendRow(resource);
+  return resource;
 }
 
 /////////////////////////////////////////////////
-void ResourceModel::UpdateResourceModel(int index, Resource &_resource)
+void ResourceModel::UpdateResourceModel(int index, const Resource &_resource)
 {
   QStandardItem *parentItem{nullptr};
 
@@ -246,6 +359,8 @@ ResourceSpawner::ResourceSpawner()
   dataPtr(std::make_unique<ResourceSpawnerPrivate>())
 {
   qRegisterMetaType<gz::sim::Resource>();
+  qRegisterMetaType<std::vector<gz::sim::Resource>>(
+      "std::vector<gz::sim::Resource>");
   gz::gui::App()->Engine()->rootContext()->setContextProperty(
       "ResourceList", &this->dataPtr->resourceModel);
   gz::gui::App()->Engine()->rootContext()->setContextProperty(
@@ -525,9 +640,8 @@ void ResourceSpawner::DisplayResources()
   // Sort the resources by the provided search method
   this->SortResources(resources);
 
-  // Clear the qml grid and add the resource results
-  this->dataPtr->resourceModel.Clear();
-  this->dataPtr->resourceModel.AddResources(resources);
+  // Update the qml grid with the resource results
+  this->dataPtr->resourceModel.SetResources(resources);
 }
 
 /////////////////////////////////////////////////
@@ -568,7 +682,7 @@ void ResourceSpawner::OnDownloadFuelResource(const QString &_path,
     if (this->dataPtr->ownerModelMap.find(_owner.toStdString()) !=
         this->dataPtr->ownerModelMap.end())
     {
-      std::vector<Resource> fuelResources =
+      auto &fuelResources =
         this->dataPtr->ownerModelMap[_owner.toStdString()];
       for (auto &resource : fuelResources)
       {
@@ -577,8 +691,7 @@ void ResourceSpawner::OnDownloadFuelResource(const QString &_path,
           resource.isDownloaded = modelResource.isDownloaded;
           resource.isFuel = modelResource.isFuel;
           resource.sdfPath = modelResource.sdfPath;
-          this->SetThumbnail(thumbnailPath, resource);
-          this->dataPtr->ownerModelMap[_owner.toStdString()] = fuelResources;
+          resource.thumbnailPath = modelResource.thumbnailPath;
           break;
         }
       }
@@ -650,24 +763,26 @@ void ResourceSpawner::OnResourceSpawn(const QString &_sdfPath)
 }
 
 /////////////////////////////////////////////////
-void ResourceSpawner::UpdateOwnerListModel(Resource _resource)
+void ResourceSpawner::UpdateOwnerListModel(std::vector<Resource> _resources)
 {
-  // If the resource is cached, we can go ahead and populate the
-  // respective information
-  std::string path;
-  if (this->dataPtr->fuelClient->CachedModel(
-        common::URI(_resource.sdfPath), path))
+  if (_resources.empty())
+    return;
+
+  // Pages may still be queued after the owner was removed
+  const std::string owner = _resources.front().owner;
+  auto workerIt = this->dataPtr->fetchResourceListWorkers.find(owner);
+  if (workerIt != this->dataPtr->fetchResourceListWorkers.end() &&
+      workerIt->second.stopDownloading)
   {
-    _resource.isDownloaded = true;
-    _resource.sdfPath = common::joinPaths(path, "model.sdf");
-    std::string thumbnailPath = common::joinPaths(path, "thumbnails");
-    this->SetThumbnail(thumbnailPath, _resource);
+    return;
   }
 
-  this->dataPtr->ownerModelMap[_resource.owner].push_back(_resource);
-  if (this->dataPtr->displayData.ownerPath == _resource.owner)
+  auto &ownerResources = this->dataPtr->ownerModelMap[owner];
+  ownerResources.insert(ownerResources.end(), _resources.begin(),
+      _resources.end());
+  if (this->dataPtr->displayData.ownerPath == owner)
   {
-    this->dataPtr->resourceModel.AddResource(_resource);
+    this->dataPtr->resourceModel.AddResources(_resources);
   }
 }
 
@@ -720,33 +835,92 @@ void ResourceSpawner::RunFetchResourceListThread(const std::string &_owner)
   this->dataPtr->fetchResourceListWorkers[_owner].thread = std::thread(
       [this, owner = _owner, &worker]
       {
-        int counter = 0;
+        const std::string cachePath = listCachePath(worker.fuelClient, owner);
+
+        // If the resource is cached, we can go ahead and populate the
+        // respective information. This is done here so the GUI thread only
+        // adds rows.
+        auto setDownloaded = [&](Resource &_resource)
+        {
+          std::string path;
+          if (worker.fuelClient.CachedModel(
+                common::URI(_resource.sdfPath), path))
+          {
+            _resource.isDownloaded = true;
+            _resource.sdfPath = common::joinPaths(path, "model.sdf");
+            std::string thumbnailPath = common::joinPaths(path, "thumbnails");
+            this->SetThumbnail(thumbnailPath, _resource);
+          }
+        };
+
+        std::vector<Resource> page;
+        auto sendPage = [&]()
+        {
+          if (page.empty())
+            return;
+          QMetaObject::invokeMethod(
+              this, "UpdateOwnerListModel", Qt::QueuedConnection,
+              Q_ARG(std::vector<gz::sim::Resource>, page));
+          page.clear();
+        };
+
+        // Show the list saved by the previous session right away, while the
+        // list is fetched from Fuel
+        std::unordered_set<std::string> shown;
+        for (auto &resource : readListCache(cachePath))
+        {
+          if (worker.stopDownloading)
+            return;
+          if (!shown.insert(resource.sdfPath).second)
+            continue;
+          resource.owner = owner;
+          setDownloaded(resource);
+          page.push_back(resource);
+          if (page.size() >= kPageSize)
+            sendPage();
+        }
+        sendPage();
+        const bool hasCachedList = !shown.empty();
+
+        // Name and unique name of every resource on Fuel, in order
+        std::vector<std::pair<std::string, std::string>> fetched;
         for (auto const &server : this->dataPtr->servers)
         {
           fuel_tools::ModelIdentifier modelId;
           modelId.SetServer(server);
           modelId.SetOwner(owner);
           for (auto iter = worker.fuelClient.Models(modelId, false);
-               iter; ++iter, ++counter)
+               iter; ++iter)
           {
             if (worker.stopDownloading)
             {
               return;
             }
             auto id = iter->Identification();
+            fetched.emplace_back(id.Name(), id.UniqueName());
+            if (!shown.insert(id.UniqueName()).second)
+              continue;
+
             Resource resource;
             resource.name = id.Name();
             resource.isFuel = true;
             resource.isDownloaded = false;
-            resource.owner = id.Owner();
+            resource.owner = owner;
             resource.sdfPath = id.UniqueName();
+            setDownloaded(resource);
 
-            QMetaObject::invokeMethod(
-                this, "UpdateOwnerListModel", Qt::QueuedConnection,
-                Q_ARG(gz::sim::Resource, resource));
+            page.push_back(resource);
+            if (page.size() >= kPageSize)
+              sendPage();
           }
         }
-        if (counter == 0)
+        sendPage();
+
+        if (!fetched.empty())
+        {
+          writeListCache(cachePath, fetched);
+        }
+        else if (!hasCachedList)
         {
           QString errorMsg = QString("No resources found for %1")
                                  .arg(QString::fromStdString(owner));
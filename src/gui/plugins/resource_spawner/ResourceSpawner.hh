@@ -128,9 +128,17 @@ namespace sim
     /// param[in] _resource The local resource to be added
     public: void AddResource(const Resource &_resource);
 
-    /// \brief Add a vector of resources to the grid view.
+    /// \brief Add a vector of resources to the grid view. They're inserted
+    /// together, so the view is only notified once.
     /// param[in] _resource The vector of local resources to be added
-    public: void AddResources(std::vector<Resource> &_resources);
+    public: void AddResources(const std::vector<Resource> &_resources);
+
+    /// \brief Make the grid view show the given resources. Rows that are
+    /// already displayed in the same order are updated in place and only the
+    /// rest of the rows are replaced, so growing or refreshing a list
+    /// doesn't rebuild the whole grid.
+    /// param[in] _resources Resources to display, in order.
+    public: void SetResources(const std::vector<Resource> &_resources);
 
     /// \brief Clear the current resource model
     public: void Clear();
@@ -140,7 +148,7 @@ namespace sim
     /// \param[in] index The index of the resources within the resource model
     /// \param[in] _resource The resource values with which to update the
     /// existing resource
-    public: void UpdateResourceModel(int index, Resource &_resource);
+    public: void UpdateResourceModel(int index, const Resource &_resource);
 
     // Documentation inherited
     public: QHash<int, QByteArray> roleNames() const override;
@@ -148,9 +156,17 @@ namespace sim
     /// \brief Signal used with the totalCount property
     public: signals: void sizeChanged();
 
+    /// \brief Create the item of a resource at the end of the grid.
+    /// \param[in] _resource The resource.
+    /// \return The item, to be appended to the model.
+    private: QStandardItem *NewItem(const Resource &_resource);
+
     // \brief Index to keep track of the position of each resource in the qml
     // grid, used primarily to access currently loaded resources for updates.
     public: int gridIndex = 0;
+
+    /// \brief Identifier of the resource of each row, see SetResources.
+    private: std::vector<std::string> keys;
   };
 
   /// \brief Provides interface for communicating to backend for generation
@@ -252,12 +268,12 @@ namespace sim
     public: void SetThumbnail(const std::string &_thumbnailPath,
                 Resource &_resource);
 
-    /// \brief Called form a download thread to update the GUI's list of
-    /// resources.
-    /// \param[in] _resource The resource fetched from Fuel. Note that it is
-    /// passed by value as a copy is necessary to update the resource if it's
-    /// cached.
-    public: Q_INVOKABLE void UpdateOwnerListModel(gz::sim::Resource _resource);
+    /// \brief Called from a download thread to update the GUI's list of
+    /// resources with a page of resources of an owner.
+    /// \param[in] _resources The resources fetched from Fuel or from the
+    /// list cache, with their download state already set.
+    public: Q_INVOKABLE void UpdateOwnerListModel(
+                std::vector<gz::sim::Resource> _resources);
 
     /// \brief Add owner to the list of owners whose resources would be fetched
     /// from Fuel.
@@ -278,7 +294,10 @@ namespace sim
     /// \param[in] _errorMsg Error message to be displayed.
     signals: void resourceSpawnerError(const QString &_errorMsg);
 
-    /// \brief Starts a thread that fetches the resources list for a given owner
+    /// \brief Starts a thread that fetches the resources list for a given
+    /// owner. The list saved by the previous session is shown first, then
+    /// resources that are new on Fuel are added, in pages. The saved list
+    /// is replaced once the whole list has been fetched.
     /// \param[in] _owner Name of owner.
     private: void RunFetchResourceListThread(const std::string &_owner);
 
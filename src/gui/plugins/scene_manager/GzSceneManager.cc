@@ -15,6 +15,7 @@
  *
 */
 
+#include <chrono>
 #include <map>
 #include <set>
 #include <string>
@@ -95,7 +96,7 @@ GzSceneManager::GzSceneManager()
 GzSceneManager::~GzSceneManager() = default;
 
 /////////////////////////////////////////////////
-void GzSceneManager::LoadConfig(const tinyxml2::XMLElement *)
+void GzSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Scene Manager";
@@ -111,6 +112,19 @@ void GzSceneManager::LoadConfig(const tinyxml2::XMLElement *)
   }
   done = true;
 
+  if (_pluginElem)
+  {
+    auto budgetElem = _pluginElem->FirstChildElement("creation_time_budget");
+    double budget{0.0};
+    if (nullptr != budgetElem &&
+        budgetElem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS)
+    {
+      this->dataPtr->renderUtil.SetCreationTimeBudget(
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(budget)));
+    }
+  }
+
   gz::gui::App()->findChild<
       gz::gui::MainWindow *>()->installEventFilter(this);
 
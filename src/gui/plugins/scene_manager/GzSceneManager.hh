@@ -36,6 +36,14 @@ inline namespace GZ_SIM_VERSION_NAMESPACE {
   /// scene to the window, such as `gz::gui::plugins::MinimalScene`.
   ///
   /// Only one GzSceneManager can be used at a time.
+  ///
+  /// ## Configuration
+  ///
+  /// * `<creation_time_budget>`: Seconds that each frame may spend creating
+  ///   new entities in the scene, so loading a large world doesn't block
+  ///   the GUI. The entities nearest to the camera are created first, and
+  ///   the rest in the following frames. Defaults to 0, which creates all
+  ///   of them in the same frame. See RenderUtil::SetCreationTimeBudget.
   class GzSceneManager : public GuiSystem
   {
     Q_OBJECT
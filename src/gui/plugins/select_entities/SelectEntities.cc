@@ -37,6 +37,7 @@
 #include "gz/sim/gui/GuiEvents.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/rendering/RenderUtil.hh"
+#include "gz/sim/rendering/SceneManager.hh"
 
 #include "SelectEntities.hh"
 
@@ -539,26 +540,12 @@ bool SelectEntities::eventFilter(QObject *_obj, QEvent *_event)
     {
       for (const auto &entity : selectedEvent->Data())
       {
-        for (unsigned int i = 0; i < this->dataPtr->scene->VisualCount(); i++)
+        auto visual = SceneManager::VisualByEntity(this->dataPtr->scene,
+            entity);
+        if (visual)
         {
-          auto visual = this->dataPtr->scene->VisualByIndex(i);
-
-          Entity entityId = kNullEntity;
-          try
-          {
-            entityId = std::get<uint64_t>(visual->UserData("gazebo-entity"));
-          }
-          catch(std::bad_variant_access &)
-          {
-            // It's ok to get here
-          }
-
-          if (entityId == entity)
-          {
-            this->dataPtr->selectedEntitiesIDNew.push_back(visual->Id());
-            this->dataPtr->receivedSelectedEntities = true;
-            break;
-          }
+          this->dataPtr->selectedEntitiesIDNew.push_back(visual->Id());
+          this->dataPtr->receivedSelectedEntities = true;
         }
       }
     }
@@ -48,6 +48,7 @@
 #include <gz/transport/Publisher.hh>
 
 #include "gz/sim/gui/GuiEvents.hh"
+#include "gz/sim/rendering/SceneManager.hh"
 
 namespace gz::sim
 {
@@ -739,26 +740,8 @@ void TransformControlPrivate::HandleMouseEvents()
         rendering::TransformMode::TM_TRANSLATION)
     {
       Entity nodeId = this->selectedEntities.front();
-      rendering::NodePtr target;
-      for (unsigned int i = 0; i < this->scene->VisualCount(); i++)
-      {
-        auto visual = this->scene->VisualByIndex(i);
-        auto entityId = kNullEntity;
-        try
-        {
-          entityId = std::get<uint64_t>(visual->UserData("gazebo-entity"));
-        }
-        catch (std::bad_variant_access &)
-        {
-          // It's ok to get here
-        }
-        if (entityId == nodeId)
-        {
-          target = std::dynamic_pointer_cast<rendering::Node>(
-            this->scene->VisualById(visual->Id()));
-          break;
-        }
-      }
+      rendering::NodePtr target =
+          SceneManager::VisualByEntity(this->scene, nodeId);
       if (!target)
       {
         gzwarn << "Failed to find node with ID [" << nodeId << "]"
@@ -40,6 +40,7 @@
 
 #include "gz/sim/Entity.hh"
 #include "gz/sim/gui/GuiEvents.hh"
+#include "gz/sim/rendering/SceneManager.hh"
 
 namespace gz::sim
 {
@@ -489,28 +490,10 @@ void ViewAnglePrivate::OnRender()
       {
         for (const auto &entity : this->selectedEntities)
         {
-          for (auto i = 0u; i < this->camera->Scene()->VisualCount();
-              ++i)
-          {
-            auto vis = this->camera->Scene()->VisualByIndex(i);
-            if (!vis)
-              continue;
-
-            try
-            {
-              if (std::get<uint64_t>(vis->UserData("gazebo-entity")) != entity)
-              {
-                continue;
-              }
-            }
-            catch (std::bad_variant_access &)
-            {
-              continue;
-            }
-
-            auto pos = vis->WorldPose().Pos();
-            lookAt += pos;
-          }
+          auto vis = SceneManager::VisualByEntity(this->camera->Scene(),
+              entity);
+          if (vis)
+            lookAt += vis->WorldPose().Pos();
         }
         lookAt /= this->selectedEntities.size();
       }
@@ -1089,7 +1089,7 @@ rendering::VisualPtr VisualizationCapabilitiesPrivate::CreateJointVisual(
 
   rendering::VisualPtr jointVis =
     std::dynamic_pointer_cast<rendering::Visual>(jointVisual);
-  jointVis->SetUserData("gazebo-entity", _id);
+  SceneManager::IndexVisual(_id, jointVis);
   jointVis->SetUserData("pause-update", static_cast<int>(0));
   jointVis->SetUserData("gui-only", static_cast<bool>(true));
   jointVis->SetLocalPose(_joint.RawPose());
@@ -1134,7 +1134,7 @@ rendering::VisualPtr VisualizationCapabilitiesPrivate::CreateInertiaVisual(
 
   rendering::VisualPtr inertiaVis =
     std::dynamic_pointer_cast<rendering::Visual>(inertiaVisual);
-  inertiaVis->SetUserData("gazebo-entity", _id);
+  SceneManager::IndexVisual(_id, inertiaVis);
   inertiaVis->SetUserData("pause-update", static_cast<int>(0));
   inertiaVis->SetUserData("gui-only", static_cast<bool>(true));
   this->visuals[_id] = inertiaVis;
@@ -1523,7 +1523,7 @@ rendering::VisualPtr VisualizationCapabilitiesPrivate::CreateCollisionVisual(
     return vis;
   }
   rendering::VisualPtr visualVis = this->scene->CreateVisual(name);
-  visualVis->SetUserData("gazebo-entity", _id);
+  SceneManager::IndexVisual(_id, visualVis);
   visualVis->SetUserData("pause-update", static_cast<int>(0));
   visualVis->SetLocalPose(_visual.RawPose());
 
@@ -1647,7 +1647,7 @@ rendering::VisualPtr VisualizationCapabilitiesPrivate::CreateCOMVisual(
 
   rendering::VisualPtr comVis =
     std::dynamic_pointer_cast<rendering::Visual>(comVisual);
-  comVis->SetUserData("gazebo-entity", _id);
+  SceneManager::IndexVisual(_id, comVis);
   comVis->SetUserData("pause-update", static_cast<int>(0));
   comVis->SetUserData("gui-only", static_cast<bool>(true));
   this->visuals[_id] = comVis;
@@ -1712,26 +1712,7 @@ rendering::VisualPtr VisualizationCapabilitiesPrivate::CreateFrameVisual(
 rendering::VisualPtr VisualizationCapabilitiesPrivate::VisualByEntity(
   Entity _entity)
 {
-  for (unsigned int i = 0; i < this->scene->VisualCount(); ++i)
-  {
-    auto visual = this->scene->VisualByIndex(i);
-
-    try
-    {
-      Entity visualEntity = std::get<uint64_t>(
-        visual->UserData("gazebo-entity"));
-
-      if (visualEntity == _entity)
-      {
-        return visual;
-      }
-    }
-    catch (std::bad_variant_access &)
-    {
-      // It's ok to get here
-    }
-  }
-  return nullptr;
+  return SceneManager::VisualByEntity(this->scene, _entity);
 }
 
 /////////////////////////////////////////////////
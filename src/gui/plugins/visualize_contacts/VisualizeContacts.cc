@@ -23,17 +23,14 @@
 #include <gz/msgs/entity.pb.h>
 #include <gz/msgs/marker.pb.h>
 
+#include <mutex>
 #include <string>
 #include <vector>
 
-#include <sdf/Link.hh>
-#include <sdf/Model.hh>
-
 #include <gz/common/Profiler.hh>
 
 #include <gz/plugin/Register.hh>
 
-#include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 
 #include <gz/transport/Node.hh>
@@ -43,7 +40,6 @@
 #include <gz/gui/MainWindow.hh>
 
 #include "gz/sim/components/Collision.hh"
-#include "gz/sim/components/ContactSensor.hh"
 #include "gz/sim/components/ContactSensorData.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/World.hh"
@@ -51,6 +47,8 @@
 #include "gz/sim/gui/GuiEvents.hh"
 #include "gz/sim/rendering/RenderUtil.hh"
 
+#include "../../../ContactClusters.hh"
+
 namespace gz
 {
 namespace sim
@@ -65,6 +63,15 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
     /// \param[in] Reference to the GUI Entity Component Manager
     public: void CreateCollisionData(EntityComponentManager &_ecm);
 
+    /// \brief Callback for contact summaries published by the server.
+    /// \param[in] _msg Summary whose positions are contact clusters.
+    public: void OnSummary(const msgs::Contact &_msg);
+
+    /// \brief Whether the server publishes contact summaries.
+    /// \return True if a summary was received or the topic has a
+    /// publisher.
+    public: bool HasSummary();
+
     /// \brief Transport node
     public: transport::Node node;
 
@@ -77,20 +84,42 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
     /// \brief Message for visualizing contact positions
     public: gz::msgs::Marker positionMarkerMsg;
 
-    /// \brief Radius of the visualized contact sphere
-    public: double contactRadius{0.10};
+    /// \brief Whether the position marker is shown.
+    public: bool markerShown{false};
 
-    /// \brief Update time of the markers in milliseconds
-    public: int64_t markerLifetime{200};
+    /// \brief Clusters of the displayed contacts. Their cell size is the
+    /// radius set in the GUI.
+    public: ContactClusters clusters{0.10, 1000u};
+
+    /// \brief Update period of the markers in milliseconds
+    public: int64_t updatePeriod{200};
 
     /// \brief Simulation time for the last markers update
     public: std::chrono::steady_clock::duration lastMarkersUpdateTime{0};
 
     /// \brief Mutex for variable mutated by the checkbox and spinboxes
     /// callbacks.
-    /// The variables are: checkboxState, contactRadius and markerLifetime
+    /// The variables are: checkboxState, clusters and updatePeriod
     public: std::mutex serviceMutex;
 
+    /// \brief Topic of the contact summaries.
+    public: std::string summaryTopic;
+
+    /// \brief Whether the summary topic is subscribed to.
+    public: bool subscribed{false};
+
+    /// \brief Whether a summary was received since subscribing.
+    public: bool summaryReceived{false};
+
+    /// \brief Contact clusters of the last summary.
+    public: std::vector<math::Vector3d> summaryPoints;
+
+    /// \brief Protects summaryReceived and summaryPoints.
+    public: std::mutex summaryMutex;
+
+    /// \brief Whether ContactSensorData was requested for all collisions.
+    public: bool collisionDataCreated{false};
+
     /// \brief Initialization flag
     public: bool initialized{false};
 
@@ -121,22 +150,17 @@ void VisualizeContacts::LoadConfig(const tinyxml2::XMLElement *)
 
   // Configure Marker messages for position of the contacts
 
-  // Blue spheres for positions
+  // Blue points for positions, all contacts in a single marker
 
   // Create the marker message
   this->dataPtr->positionMarkerMsg.set_ns("positions");
+  this->dataPtr->positionMarkerMsg.set_id(1);
   this->dataPtr->positionMarkerMsg.set_action(
     gz::msgs::Marker::ADD_MODIFY);
   this->dataPtr->positionMarkerMsg.set_type(
-    gz::msgs::Marker::SPHERE);
+    gz::msgs::Marker::POINTS);
   this->dataPtr->positionMarkerMsg.set_visibility(
     gz::msgs::Marker::GUI);
-  this->dataPtr->
-    positionMarkerMsg.mutable_lifetime()->
-      set_sec(0);
-  this->dataPtr->
-    positionMarkerMsg.mutable_lifetime()->
-      set_nsec(this->dataPtr->markerLifetime * 1000000);
 
   // Set material properties
   gz::msgs::Set(
@@ -145,12 +169,6 @@ void VisualizeContacts::LoadConfig(const tinyxml2::XMLElement *)
   gz::msgs::Set(
     this->dataPtr->positionMarkerMsg.mutable_material()->mutable_diffuse(),
     gz::math::Color(0, 0, 1, 1));
-
-  // Set contact position scale
-  gz::msgs::Set(this->dataPtr->positionMarkerMsg.mutable_scale(),
-    gz::math::Vector3d(this->dataPtr->contactRadius,
-    this->dataPtr->contactRadius,
-    this->dataPtr->contactRadius));
 }
 
 /////////////////////////////////////////////////
@@ -182,8 +200,8 @@ void VisualizeContacts::Update(const UpdateInfo &_info,
         });
     }
 
-    // Enable collisions
-    this->dataPtr->CreateCollisionData(_ecm);
+    this->dataPtr->summaryTopic =
+        "/world/" + this->dataPtr->worldName + "/contacts/summary";
     this->dataPtr->initialized = true;
   }
 
@@ -191,6 +209,10 @@ void VisualizeContacts::Update(const UpdateInfo &_info,
     std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
     if (this->dataPtr->checkboxPrevState && !this->dataPtr->checkboxState)
     {
+      // Stop receiving summaries, so the server stops collecting contacts
+      this->dataPtr->node.Unsubscribe(this->dataPtr->summaryTopic);
+      this->dataPtr->subscribed = false;
+
       // Remove the markers
       this->dataPtr->positionMarkerMsg.set_action(
         gz::msgs::Marker::DELETE_ALL);
@@ -198,6 +220,7 @@ void VisualizeContacts::Update(const UpdateInfo &_info,
       gzdbg << "Removing markers..." << std::endl;
       this->dataPtr->node.Request(
         "/marker", this->dataPtr->positionMarkerMsg);
+      this->dataPtr->markerShown = false;
 
       // Change action in case checkbox is checked again
       this->dataPtr->positionMarkerMsg.set_action(
@@ -209,44 +232,103 @@ void VisualizeContacts::Update(const UpdateInfo &_info,
       return;
   }
 
+  if (!this->dataPtr->subscribed)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->summaryMutex);
+      this->dataPtr->summaryReceived = false;
+      this->dataPtr->summaryPoints.clear();
+    }
+    this->dataPtr->node.Subscribe(this->dataPtr->summaryTopic,
+        &VisualizeContactsPrivate::OnSummary, this->dataPtr.get());
+    this->dataPtr->subscribed = true;
+  }
+
   // Only publish markers if enough time has passed
   auto timeDiff =
     std::chrono::duration_cast<std::chrono::milliseconds>(_info.simTime -
     this->dataPtr->lastMarkersUpdateTime);
 
-  if (timeDiff.count() < this->dataPtr->markerLifetime)
+  std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
+  if (timeDiff.count() >= 0 && timeDiff.count() < this->dataPtr->updatePeriod)
     return;
 
   // Store simulation time
   this->dataPtr->lastMarkersUpdateTime = _info.simTime;
 
-  // Get the contacts and publish them
-  // Since we are setting a lifetime for the markers, we get all the
-  // contacts instead of getting new and removed ones
-
-  // Variable for setting the markers id through the iteration
-  int markerID = 1;
-  _ecm.Each<components::ContactSensorData>(
-    [&](const Entity &,
-        const components::ContactSensorData *_contacts) -> bool
+  // Merge the contacts into clusters, either from the summary published by
+  // the server or, when the server doesn't publish one, from the contacts of
+  // all collisions
+  auto &clusters = this->dataPtr->clusters;
+  clusters.Clear();
+  if (this->dataPtr->HasSummary())
+  {
+    std::lock_guard<std::mutex> summaryLock(this->dataPtr->summaryMutex);
+    for (const auto &point : this->dataPtr->summaryPoints)
+      clusters.Add(point);
+  }
+  else
+  {
+    // Enable collisions
+    if (!this->dataPtr->collisionDataCreated)
     {
-      for (const auto &contact : _contacts->Data().contact())
+      this->dataPtr->CreateCollisionData(_ecm);
+      this->dataPtr->collisionDataCreated = true;
+    }
+
+    _ecm.Each<components::ContactSensorData>(
+      [&](const Entity &,
+          const components::ContactSensorData *_contacts) -> bool
       {
-        for (int i = 0; i < contact.position_size(); ++i)
-        {
-          // Set marker id, poses and request service
-          this->dataPtr->positionMarkerMsg.set_id(markerID++);
-          gz::msgs::Set(this->dataPtr->positionMarkerMsg.mutable_pose(),
-            gz::math::Pose3d(contact.position(i).x(),
-              contact.position(i).y(), contact.position(i).z(),
-              0, 0, 0));
-
-          this->dataPtr->node.Request(
-            "/marker", this->dataPtr->positionMarkerMsg);
-        }
-      }
+        clusters.Add(_contacts->Data());
+        return true;
+      });
+  }
+
+  // Points only replace the previous ones when there are some, so an empty
+  // marker must be deleted
+  auto &markerMsg = this->dataPtr->positionMarkerMsg;
+  markerMsg.clear_point();
+  if (clusters.ClusterCount() == 0u)
+  {
+    if (!this->dataPtr->markerShown)
+      return;
+    markerMsg.set_action(gz::msgs::Marker::DELETE_MARKER);
+    this->dataPtr->node.Request("/marker", markerMsg);
+    markerMsg.set_action(gz::msgs::Marker::ADD_MODIFY);
+    this->dataPtr->markerShown = false;
+    return;
+  }
+
+  for (const auto &point : clusters.Points())
+    gz::msgs::Set(markerMsg.add_point(), point);
+  this->dataPtr->node.Request("/marker", markerMsg);
+  this->dataPtr->markerShown = true;
+}
+
+//////////////////////////////////////////////////
+void VisualizeContactsPrivate::OnSummary(const msgs::Contact &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->summaryMutex);
+  this->summaryReceived = true;
+  this->summaryPoints.clear();
+  for (const auto &position : _msg.position())
+    this->summaryPoints.push_back(msgs::Convert(position));
+}
+
+//////////////////////////////////////////////////
+bool VisualizeContactsPrivate::HasSummary()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->summaryMutex);
+    if (this->summaryReceived)
       return true;
-    });
+  }
+
+  std::vector<transport::MessagePublisher> publishers;
+  std::vector<transport::MessagePublisher> subscribers;
+  this->node.TopicInfo(this->summaryTopic, publishers, subscribers);
+  return !publishers.empty();
 }
 
 //////////////////////////////////////////////////
@@ -292,24 +374,14 @@ void VisualizeContactsPrivate::CreateCollisionData(
 void VisualizeContacts::UpdateRadius(double _radius)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
-  this->dataPtr->contactRadius = _radius;
-
-  // Set scale
-  gz::msgs::Set(this->dataPtr->positionMarkerMsg.mutable_scale(),
-    gz::math::Vector3d(this->dataPtr->contactRadius,
-    this->dataPtr->contactRadius,
-    this->dataPtr->contactRadius));
+  this->dataPtr->clusters.SetCellSize(_radius);
 }
 
 //////////////////////////////////////////////////
 void VisualizeContacts::UpdatePeriod(double _period)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
-  this->dataPtr->markerLifetime = _period;
-
-  // Set markers lifetime
-  this->dataPtr->
-    positionMarkerMsg.mutable_lifetime()->set_nsec(_period * 1000000);
+  this->dataPtr->updatePeriod = static_cast<int64_t>(_period);
 }
 
 // Register this plugin
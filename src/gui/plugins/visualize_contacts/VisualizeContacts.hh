@@ -35,7 +35,14 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
 
   /// \brief Visualize the contacts returned by the Physics plugin. Use the
   /// checkbox to turn visualization on or off and spin boxes to change
-  /// the size of the markers.
+  /// how close contacts are merged and how often they're updated.
+  ///
+  /// When the server runs the ContactVisualization system, the plugin
+  /// subscribes to its contact summary while visualization is on, so
+  /// contacts are only collected while they're shown. Otherwise, contact
+  /// data is enabled on all collisions when visualization is first turned
+  /// on and read from the GUI entity component manager. Either way, nearby
+  /// contacts are merged and all of them are drawn as a single point marker.
   class VisualizeContacts : public gz::sim::GuiSystem
   {
     Q_OBJECT
@@ -57,8 +64,8 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
     /// \param[in] _checked indicates show or hide contacts
     public slots: void OnVisualize(bool _checked);
 
-    /// \brief Update the radius of the contact
-    /// \param[in] _radius new radius of the contact
+    /// \brief Update the size of the cells nearby contacts are merged in
+    /// \param[in] _radius new size of the cells in meters
     public slots: void UpdateRadius(double _radius);
 
     /// \brief Update the update period of the markers
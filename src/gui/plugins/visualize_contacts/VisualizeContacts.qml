@@ -57,7 +57,7 @@ GridLayout {
     Layout.columnSpan: 2
     id: radiusText
     color: "dimgrey"
-    text: "Radius (m)"
+    text: "Merge radius (m)"
   }
 
   GzSpinBox {
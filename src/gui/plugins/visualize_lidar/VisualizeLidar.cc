@@ -17,6 +17,7 @@
 
 #include "VisualizeLidar.hh"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -69,6 +70,11 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
   /// \brief Private data class for VisualizeLidar
   class VisualizeLidarPrivate
   {
+    /// \brief Apply the latest scan to the lidar visual, keeping every
+    /// Nth ray according to the decimation. Must be called on the render
+    /// thread.
+    public: void ApplyScan();
+
     /// \brief Transport node
     public: transport::Node node;
 
@@ -123,6 +129,21 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
 
     /// \brief lidar sensor entity dirty flag
     public: bool lidarEntityDirty{true};
+
+    /// \brief True if msg holds a scan that wasn't applied to the visual.
+    public: bool scanDirty{false};
+
+    /// \brief True if the visual ranges changed.
+    public: bool rangeDirty{false};
+
+    /// \brief Keep every Nth horizontal ray.
+    public: int horizontalDecimation{1};
+
+    /// \brief Keep every Nth vertical ray.
+    public: int verticalDecimation{1};
+
+    /// \brief Decimated ranges, reused between scans.
+    public: std::vector<double> ranges;
   };
 }
 }
@@ -131,6 +152,63 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
 using namespace gz;
 using namespace sim;
 
+/////////////////////////////////////////////////
+void VisualizeLidarPrivate::ApplyScan()
+{
+  GZ_PROFILE("VisualizeLidar::ApplyScan");
+  const auto cols = this->msg.count();
+  const auto vertical = this->msg.vertical_count();
+  const auto rows = std::max(1u, vertical);
+  const auto h = static_cast<unsigned int>(this->horizontalDecimation);
+  const auto v = static_cast<unsigned int>(this->verticalDecimation);
+
+  double maxHorizontal = this->msg.angle_max();
+  double maxVertical = this->msg.vertical_angle_max();
+  unsigned int keptCols = cols;
+  unsigned int keptRows = vertical;
+  this->ranges.clear();
+  if ((h > 1 || v > 1) && cols > 0 &&
+      static_cast<unsigned int>(this->msg.ranges_size()) == cols * rows)
+  {
+    // Keep rays 0, N, 2N... and shrink the angles to the last kept ray, so
+    // the visual spaces the rays as the sensor did
+    keptCols = (cols + h - 1) / h;
+    const unsigned int outRows = (rows + v - 1) / v;
+    this->ranges.reserve(keptCols * outRows);
+    for (unsigned int r = 0; r < rows; r += v)
+    {
+      for (unsigned int c = 0; c < cols; c += h)
+        this->ranges.push_back(this->msg.ranges(r * cols + c));
+    }
+
+    if (cols > 1)
+    {
+      const double step =
+          (this->msg.angle_max() - this->msg.angle_min()) / (cols - 1);
+      maxHorizontal = this->msg.angle_min() + (keptCols - 1) * h * step;
+    }
+    if (vertical > 1)
+    {
+      const double step = (this->msg.vertical_angle_max() -
+          this->msg.vertical_angle_min()) / (vertical - 1);
+      maxVertical = this->msg.vertical_angle_min() + (outRows - 1) * v * step;
+      keptRows = outRows;
+    }
+  }
+  else
+  {
+    this->ranges.assign(this->msg.ranges().begin(), this->msg.ranges().end());
+  }
+
+  this->lidar->SetVerticalRayCount(keptRows);
+  this->lidar->SetHorizontalRayCount(keptCols);
+  this->lidar->SetMinHorizontalAngle(this->msg.angle_min());
+  this->lidar->SetMaxHorizontalAngle(maxHorizontal);
+  this->lidar->SetMinVerticalAngle(this->msg.vertical_angle_min());
+  this->lidar->SetMaxVerticalAngle(maxVertical);
+  this->lidar->SetPoints(this->ranges);
+}
+
 /////////////////////////////////////////////////
 VisualizeLidar::VisualizeLidar()
   : GuiSystem(), dataPtr(new VisualizeLidarPrivate)
@@ -209,11 +287,29 @@ void VisualizeLidar::LoadLidar()
 }
 
 /////////////////////////////////////////////////
-void VisualizeLidar::LoadConfig(const tinyxml2::XMLElement *)
+void VisualizeLidar::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Visualize lidar";
 
+  if (_pluginElem)
+  {
+    int decimation{1};
+    auto elem = _pluginElem->FirstChildElement("horizontal_decimation");
+    if (nullptr != elem && elem->QueryIntText(&decimation) ==
+        tinyxml2::XML_SUCCESS)
+    {
+      this->SetHorizontalDecimation(decimation);
+    }
+
+    elem = _pluginElem->FirstChildElement("vertical_decimation");
+    if (nullptr != elem && elem->QueryIntText(&decimation) ==
+        tinyxml2::XML_SUCCESS)
+    {
+      this->SetVerticalDecimation(decimation);
+    }
+  }
+
   gz::gui::App()->findChild<
     gz::gui::MainWindow *>()->installEventFilter(this);
 }
@@ -239,6 +335,17 @@ bool VisualizeLidar::eventFilter(QObject *_obj, QEvent *_event)
         this->dataPtr->lidar->ClearPoints();
         this->dataPtr->resetVisual = false;
       }
+      if (this->dataPtr->rangeDirty)
+      {
+        this->dataPtr->lidar->SetMaxRange(this->dataPtr->maxVisualRange);
+        this->dataPtr->lidar->SetMinRange(this->dataPtr->minVisualRange);
+        this->dataPtr->rangeDirty = false;
+      }
+      if (this->dataPtr->scanDirty)
+      {
+        this->dataPtr->ApplyScan();
+        this->dataPtr->scanDirty = false;
+      }
       if (this->dataPtr->visualDirty)
       {
         this->dataPtr->lidar->SetWorldPose(this->dataPtr->lidarPose);
@@ -471,24 +578,10 @@ void VisualizeLidar::OnScan(const msgs::LaserScan &_msg)
   std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
   if (this->dataPtr->initialized)
   {
-    this->dataPtr->msg = std::move(_msg);
-    this->dataPtr->lidar->SetVerticalRayCount(
-                                  this->dataPtr->msg.vertical_count());
-    this->dataPtr->lidar->SetHorizontalRayCount(
-                                  this->dataPtr->msg.count());
-    this->dataPtr->lidar->SetMinHorizontalAngle(
-                                  this->dataPtr->msg.angle_min());
-    this->dataPtr->lidar->SetMaxHorizontalAngle(
-                                  this->dataPtr->msg.angle_max());
-    this->dataPtr->lidar->SetMinVerticalAngle(
-                                  this->dataPtr->msg.vertical_angle_min());
-    this->dataPtr->lidar->SetMaxVerticalAngle(
-                                  this->dataPtr->msg.vertical_angle_max());
-
-    this->dataPtr->lidar->SetPoints(std::vector<double>(
-                                  this->dataPtr->msg.ranges().begin(),
-                                  this->dataPtr->msg.ranges().end()));
-
+    // The scan is applied on the render thread, and scans that arrive
+    // before the next frame replace this one
+    this->dataPtr->msg = _msg;
+    this->dataPtr->scanDirty = true;
     this->dataPtr->visualDirty = true;
 
     for (auto data_values : this->dataPtr->msg.header().data())
@@ -502,8 +595,7 @@ void VisualizeLidar::OnScan(const msgs::LaserScan &_msg)
           this->dataPtr->lidarEntityDirty = true;
           this->dataPtr->maxVisualRange = this->dataPtr->msg.range_max();
           this->dataPtr->minVisualRange = this->dataPtr->msg.range_min();
-          this->dataPtr->lidar->SetMaxRange(this->dataPtr->maxVisualRange);
-          this->dataPtr->lidar->SetMinRange(this->dataPtr->minVisualRange);
+          this->dataPtr->rangeDirty = true;
           this->MinRangeChanged();
           this->MaxRangeChanged();
           break;
@@ -525,6 +617,46 @@ QString VisualizeLidar::MinRange() const
   return QString::fromStdString(std::to_string(this->dataPtr->minVisualRange));
 }
 
+//////////////////////////////////////////////////
+int VisualizeLidar::HorizontalDecimation() const
+{
+  return this->dataPtr->horizontalDecimation;
+}
+
+//////////////////////////////////////////////////
+void VisualizeLidar::SetHorizontalDecimation(int _decimation)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
+    _decimation = std::max(1, _decimation);
+    if (_decimation == this->dataPtr->horizontalDecimation)
+      return;
+    this->dataPtr->horizontalDecimation = _decimation;
+    this->dataPtr->scanDirty = this->dataPtr->msg.count() > 0;
+  }
+  this->HorizontalDecimationChanged();
+}
+
+//////////////////////////////////////////////////
+int VisualizeLidar::VerticalDecimation() const
+{
+  return this->dataPtr->verticalDecimation;
+}
+
+//////////////////////////////////////////////////
+void VisualizeLidar::SetVerticalDecimation(int _decimation)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
+    _decimation = std::max(1, _decimation);
+    if (_decimation == this->dataPtr->verticalDecimation)
+      return;
+    this->dataPtr->verticalDecimation = _decimation;
+    this->dataPtr->scanDirty = this->dataPtr->msg.count() > 0;
+  }
+  this->VerticalDecimationChanged();
+}
+
 // Register this plugin
 GZ_ADD_PLUGIN(gz::sim::VisualizeLidar,
                     gz::gui::Plugin)
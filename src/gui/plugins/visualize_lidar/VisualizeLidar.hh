@@ -37,6 +37,17 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
   /// checkbox to turn visualization of non-hitting rays on or off and
   /// the textfield to select the message to be visualised. The combobox is
   /// used to select the type of visual for the sensor data.
+  ///
+  /// Only the latest scan is kept, and it's applied to the visual on the
+  /// render thread, so scans that arrive faster than the GUI renders are
+  /// dropped instead of queuing up. Dense lidars can be decimated to keep
+  /// every Nth ray horizontally and vertically.
+  ///
+  /// ## Configuration
+  ///
+  /// * `<horizontal_decimation>`: Keep every Nth horizontal ray. Defaults
+  /// to 1, which keeps all of them.
+  /// * `<vertical_decimation>`: Keep every Nth vertical ray. Defaults to 1.
   class VisualizeLidar : public gz::sim::GuiSystem
   {
     Q_OBJECT
@@ -63,6 +74,22 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
       NOTIFY MaxRangeChanged
     )
 
+    /// \brief Horizontal decimation
+    Q_PROPERTY(
+      int horizontalDecimation
+      READ HorizontalDecimation
+      WRITE SetHorizontalDecimation
+      NOTIFY HorizontalDecimationChanged
+    )
+
+    /// \brief Vertical decimation
+    Q_PROPERTY(
+      int verticalDecimation
+      READ VerticalDecimation
+      WRITE SetVerticalDecimation
+      NOTIFY VerticalDecimationChanged
+    )
+
     /// \brief Constructor
     public: VisualizeLidar();
 
@@ -135,6 +162,30 @@ inline namespace GZ_SIM_VERSION_NAMESPACE
     /// \return Range, the minimum distance sensed by the sensor.
     public: Q_INVOKABLE QString MinRange() const;
 
+    /// \brief Get the horizontal decimation.
+    /// \return Every how many horizontal rays one is displayed.
+    public: Q_INVOKABLE int HorizontalDecimation() const;
+
+    /// \brief Set the horizontal decimation.
+    /// \param[in] _decimation Every how many horizontal rays one is
+    /// displayed, at least 1.
+    public: Q_INVOKABLE void SetHorizontalDecimation(int _decimation);
+
+    /// \brief Notify that the horizontal decimation has changed
+    signals: void HorizontalDecimationChanged();
+
+    /// \brief Get the vertical decimation.
+    /// \return Every how many vertical rays one is displayed.
+    public: Q_INVOKABLE int VerticalDecimation() const;
+
+    /// \brief Set the vertical decimation.
+    /// \param[in] _decimation Every how many vertical rays one is
+    /// displayed, at least 1.
+    public: Q_INVOKABLE void SetVerticalDecimation(int _decimation);
+
+    /// \brief Notify that the vertical decimation has changed
+    signals: void VerticalDecimationChanged();
+
     /// \internal
     /// \brief Pointer to private data
     private: std::unique_ptr<VisualizeLidarPrivate> dataPtr;
@@ -143,11 +143,45 @@ GridLayout {
   }
 
   GzSpinBox {
-    Layout.columnSpan: 2
+    Layout.columnSpan: 4
     id: pointSize
     maximumValue: 1000
     minimumValue: 1
     value: 1
     onEditingFinished: VisualizeLidar.UpdateSize(pointSize.value)
   }
+
+  Text {
+    Layout.columnSpan: 2
+    id: horizontalDecimationText
+    color: "dimgrey"
+    text: "Keep Every Nth Column"
+  }
+
+  GzSpinBox {
+    Layout.columnSpan: 4
+    id: horizontalDecimation
+    maximumValue: 100
+    minimumValue: 1
+    value: VisualizeLidar.horizontalDecimation
+    onEditingFinished:
+        VisualizeLidar.SetHorizontalDecimation(horizontalDecimation.value)
+  }
+
+  Text {
+    Layout.columnSpan: 2
+    id: verticalDecimationText
+    color: "dimgrey"
+    text: "Keep Every Nth Row"
+  }
+
+  GzSpinBox {
+    Layout.columnSpan: 4
+    id: verticalDecimation
+    maximumValue: 100
+    minimumValue: 1
+    value: VisualizeLidar.verticalDecimation
+    onEditingFinished:
+        VisualizeLidar.SetVerticalDecimation(verticalDecimation.value)
+  }
 }
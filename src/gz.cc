@@ -31,6 +31,7 @@
 #include <gz/fuel_tools/WorldIdentifier.hh>
 #include <gz/transport/Node.hh>
 #include <sdf/Console.hh>
+#include <sdf/Plugin.hh>
 
 #include "gz/sim/config.hh"
 #include "gz/sim/InstallationDirectories.hh"
@@ -39,6 +40,9 @@
 
 #include "gz/sim/gui/Gui.hh"
 
+#include "LogExport.hh"
+#include "LogReplay.hh"
+
 using namespace gz;
 
 //////////////////////////////////////////////////
@@ -140,7 +144,8 @@ extern "C" int runServer(const char *_sdfString,
     const char *_renderEngineServer, const char *_renderEngineServerApiBackend,
     const char *_renderEngineGui, const char *_renderEngineGuiApiBackend,
     const char *_file, const char *_recordTopics, int _waitGui,
-    int _headless, float _recordPeriod, int _seed)
+    int _headless, float _recordPeriod, int _seed, int _profile,
+    int _stateHash, const char *_restorePath)
 {
   std::string startingWorldPath{""};
   sim::ServerConfig serverConfig;
@@ -399,6 +404,16 @@ extern "C" int runServer(const char *_sdfString,
 
   serverConfig.SetHeadlessRendering(_headless);
 
+  if (_profile > 0)
+  {
+    serverConfig.SetUseSystemProfiling(true);
+  }
+
+  if (_stateHash > 0)
+  {
+    serverConfig.SetStateHashing(true);
+  }
+
   if (_renderEngineServer != nullptr && std::strlen(_renderEngineServer) > 0)
   {
     serverConfig.SetRenderEngineServer(_renderEngineServer);
@@ -425,6 +440,11 @@ extern "C" int runServer(const char *_sdfString,
     gzmsg << "Setting seed value: " << _seed << "\n";
   }
 
+  if (_restorePath != nullptr && std::strlen(_restorePath) > 0)
+  {
+    serverConfig.SetRestoreFile(_restorePath);
+  }
+
   // Create the Gazebo server
   sim::Server server(serverConfig);
 
@@ -435,6 +455,71 @@ extern "C" int runServer(const char *_sdfString,
   return 0;
 }
 
+//////////////////////////////////////////////////
+extern "C" int runLogReplay(const char *_logPath, const char *_systems,
+    int _threads)
+{
+  if (_logPath == nullptr || std::strlen(_logPath) == 0)
+  {
+    gzerr << "Missing path to the log to replay." << std::endl;
+    return 1;
+  }
+
+  sim::LogReplay replay(_logPath);
+  replay.SetThreads(_threads > 0 ? static_cast<unsigned int>(_threads) : 0u);
+
+  // The filename can't hold a colon, but the name usually has "::"
+  std::vector<std::string> systems;
+  if (_systems != nullptr)
+    systems = common::split(_systems, ",");
+  for (const auto &system : systems)
+  {
+    if (system.empty())
+      continue;
+    const auto colon = system.find(':');
+    const std::string filename = system.substr(0, colon);
+    const std::string name =
+        colon == std::string::npos ? "" : system.substr(colon + 1);
+    replay.AddSystem(sdf::Plugin(filename, name));
+    gzmsg << "Replaying with system [" << filename << "] [" << name << "]"
+          << std::endl;
+  }
+
+  if (systems.empty())
+  {
+    gzwarn << "No analysis systems were given with --replay-system, the log "
+           << "will only be read." << std::endl;
+  }
+
+  return replay.Run() ? 0 : 1;
+}
+
+//////////////////////////////////////////////////
+extern "C" int runLogExport(const char *_logPath, const char *_outputPath,
+    int _threads)
+{
+  if (_logPath == nullptr || std::strlen(_logPath) == 0)
+  {
+    gzerr << "Missing path to the log to export." << std::endl;
+    return 1;
+  }
+
+  std::string outputPath;
+  if (_outputPath != nullptr)
+    outputPath = _outputPath;
+  if (outputPath.empty())
+  {
+    auto logDir = common::absPath(_logPath);
+    if (!common::isDirectory(logDir))
+      logDir = common::parentPath(logDir);
+    outputPath = common::joinPaths(logDir, "export");
+  }
+
+  sim::LogExport exporter(_logPath);
+  exporter.SetThreads(_threads > 0 ? static_cast<unsigned int>(_threads) : 0u);
+  return exporter.Run(outputPath) ? 0 : 1;
+}
+
 //////////////////////////////////////////////////
 extern "C" int runGui(const char *_guiConfig, const char *_file, int _waitGui,
                       const char *_renderEngine,
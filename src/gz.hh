@@ -61,6 +61,10 @@ extern "C" GZ_SIM_GZ_VISIBLE const char *worldInstallDir();
 /// \param[in] _headless True if server rendering should run headless
 /// \param[in] _recordPeriod --record-period option
 /// \param[in] _seed --seed value to be used for random number generator.
+/// \param[in] _profile --profile option
+/// \param[in] _stateHash --state-hash option
+/// \param[in] _restorePath --restore option, path to a checkpoint to resume
+/// the simulation from. Leave empty to start a new simulation.
 /// \return 0 if successful, 1 if not.
 extern "C" GZ_SIM_GZ_VISIBLE int runServer(const char *_sdfString,
     int _iterations, int _run, float _hz, double _initialSimTime, int _levels,
@@ -71,7 +75,8 @@ extern "C" GZ_SIM_GZ_VISIBLE int runServer(const char *_sdfString,
     const char *_renderEngineServer, const char *_renderEngineServerApiBackend,
     const char *_renderEngineGui, const char *_renderEngineGuiApiBackend,
     const char *_file, const char *_recordTopics, int _waitGui, int _headless,
-    float _recordPeriod, int _seed);
+    float _recordPeriod, int _seed, int _profile, int _stateHash,
+    const char *_restorePath);
 
 /// \brief External hook to run simulation GUI.
 /// \param[in] _guiConfig Path to Gazebo GUI configuration file.
@@ -95,4 +100,23 @@ int runGui(const char *_guiConfig, const char *_file,
 extern "C" GZ_SIM_GZ_VISIBLE const char *findFuelResource(
     char *_pathToResource);
 
+/// \brief External hook to replay a log as fast as possible, running only
+/// analysis systems on the recorded states.
+/// \param[in] _logPath --replay-batch option, path to the recorded states.
+/// \param[in] _systems Comma separated list of systems, each as
+/// <filename> or <filename>:<name>.
+/// \param[in] _threads --replay-threads option, 0 to use one per core.
+/// \return 0 if successful, 1 if not.
+extern "C" GZ_SIM_GZ_VISIBLE int runLogReplay(const char *_logPath,
+    const char *_systems, int _threads);
+
+/// \brief External hook to export recorded states to CSV files.
+/// \param[in] _logPath --export-log option, path to the recorded states.
+/// \param[in] _outputPath --export-path option, directory to write to.
+/// Empty to use an "export" directory next to the recorded states.
+/// \param[in] _threads --replay-threads option, 0 to use one per core.
+/// \return 0 if successful, 1 if not.
+extern "C" GZ_SIM_GZ_VISIBLE int runLogExport(const char *_logPath,
+    const char *_outputPath, int _threads);
+
 #endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LoadBalancer.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <gz/common/Console.hh>
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+void LoadBalancer::SetImbalanceRatio(double _ratio)
+{
+  if (!(_ratio > 1.0))
+  {
+    gzerr << "Imbalance ratio must be greater than 1, got [" << _ratio
+          << "]." << std::endl;
+    return;
+  }
+  this->imbalanceRatio = _ratio;
+}
+
+//////////////////////////////////////////////////
+void LoadBalancer::SetMinSamples(unsigned int _samples)
+{
+  this->minSamples = std::max(1u, _samples);
+}
+
+//////////////////////////////////////////////////
+void LoadBalancer::AddStepTime(const std::string &_secondary,
+    const std::chrono::steady_clock::duration &_time)
+{
+  auto &measurement = this->measurements[_secondary];
+  const double seconds = std::chrono::duration<double>(_time).count();
+
+  // Plain average until there are enough samples, then a moving average
+  // over about as many steps
+  ++measurement.samples;
+  const double weight = 1.0 / std::min(measurement.samples, this->minSamples);
+  measurement.average += (seconds - measurement.average) * weight;
+}
+
+//////////////////////////////////////////////////
+bool LoadBalancer::Ready() const
+{
+  if (this->measurements.size() < 2u)
+    return false;
+
+  for (const auto &it : this->measurements)
+  {
+    if (it.second.samples < this->minSamples)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LoadBalancer::SetPerformer(Entity _performer,
+    const std::string &_secondary, double _cost)
+{
+  this->performers[_performer] = {_secondary, std::max(0.0, _cost)};
+}
+
+//////////////////////////////////////////////////
+bool LoadBalancer::Balance(Entity &_performer, std::string &_secondary)
+{
+  if (!this->Ready())
+    return false;
+
+  // Performers are set again before every decision
+  const auto current = std::move(this->performers);
+  this->performers.clear();
+
+  auto [fastest, slowest] = std::minmax_element(this->measurements.begin(),
+      this->measurements.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.second.average < _b.second.average;
+      });
+
+  const double slowTime = slowest->second.average;
+  const double fastTime = fastest->second.average;
+  if (slowTime <= fastTime * this->imbalanceRatio)
+    return false;
+
+  double slowCost{0.0};
+  for (const auto &it : current)
+  {
+    if (it.second.first == slowest->first)
+      slowCost += it.second.second;
+  }
+  if (slowCost <= 0.0)
+    return false;
+
+  // Moving a performer only helps if it makes the slowest secondary faster
+  // without making the fastest one slower than it was
+  const double timePerCost = slowTime / slowCost;
+  const double gap = slowTime - fastTime;
+  double bestError{std::numeric_limits<double>::max()};
+  Entity best{kNullEntity};
+  for (const auto &it : current)
+  {
+    if (it.second.first != slowest->first)
+      continue;
+
+    const double time = it.second.second * timePerCost;
+    if (time <= 0.0 || time >= gap)
+      continue;
+
+    const double error = std::abs(time - gap * 0.5);
+    if (error < bestError)
+    {
+      bestError = error;
+      best = it.first;
+    }
+  }
+
+  if (best == kNullEntity)
+    return false;
+
+  _performer = best;
+  _secondary = fastest->first;
+
+  // Measure the new assignment from scratch
+  this->Reset();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LoadBalancer::Reset()
+{
+  this->measurements.clear();
+  this->performers.clear();
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_NETWORK_LOADBALANCER_HH_
+#define GZ_SIM_NETWORK_LOADBALANCER_HH_
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class LoadBalancer LoadBalancer.hh
+    ///   gz/sim/network/LoadBalancer.hh
+    /// \brief Decides which performer to move between secondaries so they
+    /// take a similar time to step.
+    ///
+    /// The balancer keeps a moving average of the step time of each
+    /// secondary, and is told the cost of each performer, for example the
+    /// number of entities in its model. The step time of a secondary is
+    /// assumed to be proportional to the cost of its performers. When the
+    /// slowest secondary is slower than the fastest by more than a ratio,
+    /// the performer of the slowest secondary whose estimated time is closest
+    /// to half the difference is moved to the fastest one. Measurements are
+    /// discarded after every migration, so the next decision is based on
+    /// the new assignment.
+    class GZ_SIM_VISIBLE LoadBalancer
+    {
+      /// \brief Set the ratio between the slowest and the fastest secondary
+      /// step times above which performers are migrated.
+      /// \param[in] _ratio Ratio, greater than 1.
+      public: void SetImbalanceRatio(double _ratio);
+
+      /// \brief Set the number of steps measured on every secondary before
+      /// deciding on a migration.
+      /// \param[in] _samples Number of steps, at least 1.
+      public: void SetMinSamples(unsigned int _samples);
+
+      /// \brief Add the time a secondary took to step.
+      /// \param[in] _secondary Secondary prefix.
+      /// \param[in] _time Wall time of the step.
+      public: void AddStepTime(const std::string &_secondary,
+                  const std::chrono::steady_clock::duration &_time);
+
+      /// \brief Whether every secondary was measured for enough steps.
+      /// \return True if Balance can be called.
+      public: bool Ready() const;
+
+      /// \brief Set the secondary and the cost of a performer. Performers
+      /// are forgotten by Balance, so they're set before every call.
+      /// \param[in] _performer Performer entity.
+      /// \param[in] _secondary Prefix of the secondary it's assigned to.
+      /// \param[in] _cost Cost of the performer, greater than zero.
+      public: void SetPerformer(Entity _performer,
+                  const std::string &_secondary, double _cost);
+
+      /// \brief Pick a performer to migrate, among the performers set since
+      /// the previous call. Does nothing until Ready is true.
+      /// \param[out] _performer Performer to migrate.
+      /// \param[out] _secondary Prefix of the secondary to migrate it to.
+      /// \return True if a performer should be migrated.
+      public: bool Balance(Entity &_performer, std::string &_secondary);
+
+      /// \brief Discard all measurements and performers.
+      public: void Reset();
+
+      /// \brief Step time measurements of a secondary.
+      private: struct Measurement
+      {
+        /// \brief Moving average of the step time, in seconds.
+        double average{0.0};
+
+        /// \brief Number of steps measured.
+        unsigned int samples{0u};
+      };
+
+      /// \brief Measurements by secondary prefix.
+      private: std::map<std::string, Measurement> measurements;
+
+      /// \brief Secondary and cost of every performer.
+      private: std::map<Entity, std::pair<std::string, double>> performers;
+
+      /// \brief Ratio between step times above which performers migrate.
+      private: double imbalanceRatio{1.5};
+
+      /// \brief Number of steps measured before a decision.
+      private: unsigned int minSamples{100u};
+    };
+    }
+  }  // namespace sim
+}  // namespace gz
+
+#endif  // GZ_SIM_NETWORK_LOADBALANCER_HH_
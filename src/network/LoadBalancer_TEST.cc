@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "LoadBalancer.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(LoadBalancer, WaitForSamples)
+{
+  LoadBalancer balancer;
+  balancer.SetMinSamples(3);
+  balancer.SetPerformer(1, "a", 10);
+  balancer.SetPerformer(2, "a", 10);
+
+  Entity performer{kNullEntity};
+  std::string secondary;
+  for (int i = 0; i < 2; ++i)
+  {
+    balancer.AddStepTime("a", 20ms);
+    balancer.AddStepTime("b", 1ms);
+    EXPECT_FALSE(balancer.Ready());
+    EXPECT_FALSE(balancer.Balance(performer, secondary));
+  }
+
+  balancer.AddStepTime("a", 20ms);
+  EXPECT_FALSE(balancer.Ready());
+  balancer.AddStepTime("b", 1ms);
+  EXPECT_TRUE(balancer.Ready());
+}
+
+/////////////////////////////////////////////////
+TEST(LoadBalancer, Migrate)
+{
+  LoadBalancer balancer;
+  balancer.SetMinSamples(1);
+  balancer.SetImbalanceRatio(1.2);
+
+  // Secondary "a" takes 30 ms for a cost of 30, "b" takes 10 ms for 10, so
+  // moving 10 from "a" to "b" evens them out
+  balancer.SetPerformer(1, "a", 5);
+  balancer.SetPerformer(2, "a", 10);
+  balancer.SetPerformer(3, "a", 15);
+  balancer.SetPerformer(4, "b", 10);
+  balancer.AddStepTime("a", 30ms);
+  balancer.AddStepTime("b", 10ms);
+
+  Entity performer{kNullEntity};
+  std::string secondary;
+  ASSERT_TRUE(balancer.Balance(performer, secondary));
+  EXPECT_EQ(2u, performer);
+  EXPECT_EQ("b", secondary);
+
+  // Measurements start over after a migration
+  EXPECT_FALSE(balancer.Ready());
+  EXPECT_FALSE(balancer.Balance(performer, secondary));
+}
+
+/////////////////////////////////////////////////
+TEST(LoadBalancer, Balanced)
+{
+  LoadBalancer balancer;
+  balancer.SetMinSamples(1);
+  balancer.SetImbalanceRatio(1.5);
+
+  Entity performer{kNullEntity};
+  std::string secondary;
+
+  // Within the ratio
+  balancer.SetPerformer(1, "a", 1);
+  balancer.SetPerformer(2, "b", 1);
+  balancer.AddStepTime("a", 14ms);
+  balancer.AddStepTime("b", 10ms);
+  EXPECT_FALSE(balancer.Balance(performer, secondary));
+
+  // A single performer which would make the other secondary just as slow
+  balancer.SetPerformer(1, "a", 1);
+  balancer.SetPerformer(2, "b", 1);
+  balancer.AddStepTime("a", 100ms);
+  EXPECT_FALSE(balancer.Balance(performer, secondary));
+
+  // Moving averages follow later samples
+  balancer.Reset();
+  balancer.SetMinSamples(2);
+  balancer.SetPerformer(1, "a", 1);
+  balancer.SetPerformer(2, "a", 1);
+  for (int i = 0; i < 10; ++i)
+  {
+    balancer.AddStepTime("a", 10ms);
+    balancer.AddStepTime("b", 10ms);
+  }
+  EXPECT_FALSE(balancer.Balance(performer, secondary));
+  for (int i = 0; i < 10; ++i)
+    balancer.AddStepTime("a", 40ms);
+
+  // Performers have to be set again
+  EXPECT_FALSE(balancer.Balance(performer, secondary));
+  balancer.SetPerformer(1, "a", 1);
+  balancer.SetPerformer(2, "a", 1);
+  EXPECT_TRUE(balancer.Balance(performer, secondary));
+  EXPECT_EQ("b", secondary);
+}
@@ -17,6 +17,7 @@
 #include "NetworkConfig.hh"
 
 #include <algorithm>
+#include <string>
 
 #include "gz/common/Console.hh"
 #include "gz/common/Util.hh"
@@ -72,6 +73,21 @@ NetworkConfig NetworkConfig::FromValues(const std::string &_role,
         << "network secondaries not set, "
         << "no distributed sim available" << std::endl;
     }
+
+    std::string lookahead;
+    if (common::env("GZ_SIM_NETWORK_LOOKAHEAD", lookahead) &&
+        !lookahead.empty())
+    {
+      try
+      {
+        config.lookahead = static_cast<unsigned int>(std::stoul(lookahead));
+      }
+      catch (...)
+      {
+        gzwarn << "Invalid setting for network lookahead [" << lookahead
+                << "], stepping in lockstep" << std::endl;
+      }
+    }
   }
 
   return config;
@@ -52,6 +52,12 @@ namespace gz
 
       /// \brief Expect number of network secondaries.
       public: size_t numSecondariesExpected { 0 };
+
+      /// \brief Number of steps secondaries may run ahead of the primary
+      /// while their performers don't share levels. Zero steps everyone in
+      /// lockstep. Set from the GZ_SIM_NETWORK_LOOKAHEAD environment
+      /// variable on the primary.
+      public: unsigned int lookahead { 0 };
     };
     }
   }  // namespace sim
@@ -30,38 +30,45 @@ TEST(NetworkManager, ValueConstructor)
   {
     // Primary without number of secondaries is invalid
     auto config = NetworkConfig::FromValues("PRIMARY", 0);
-    assert(config.role == NetworkRole::None);
-    assert(config.numSecondariesExpected == 0);
+    EXPECT_EQ(NetworkRole::None, config.role);
+    EXPECT_EQ(0u, config.numSecondariesExpected);
     // Expect console warning as well
-    (void) config;
   }
 
   {
     // Primary with number of secondaries is valid
     auto config = NetworkConfig::FromValues("PRIMARY", 3);
-    assert(config.role == NetworkRole::SimulationPrimary);
-    assert(config.numSecondariesExpected == 3);
-    (void) config;
+    EXPECT_EQ(NetworkRole::SimulationPrimary, config.role);
+    EXPECT_EQ(3u, config.numSecondariesExpected);
+  }
+
+  {
+    // Secondaries may run ahead if configured
+    gz::common::setenv("GZ_SIM_NETWORK_LOOKAHEAD", "4");
+    auto config = NetworkConfig::FromValues("PRIMARY", 2);
+    EXPECT_EQ(4u, config.lookahead);
+
+    gz::common::setenv("GZ_SIM_NETWORK_LOOKAHEAD", "many");
+    config = NetworkConfig::FromValues("PRIMARY", 2);
+    EXPECT_EQ(0u, config.lookahead);
+    gz::common::unsetenv("GZ_SIM_NETWORK_LOOKAHEAD");
   }
 
   {
     // Secondary is always valid
     auto config = NetworkConfig::FromValues("SECONDARY", 0);
-    assert(config.role == NetworkRole::SimulationSecondary);
-    (void) config;
+    EXPECT_EQ(NetworkRole::SimulationSecondary, config.role);
   }
 
   {
     // Readonly is always valid
     auto config = NetworkConfig::FromValues("READONLY");
-    assert(config.role == NetworkRole::ReadOnly);
-    (void) config;
+    EXPECT_EQ(NetworkRole::ReadOnly, config.role);
   }
 
   {
     // Anything else is invalid
     auto config = NetworkConfig::FromValues("READ_WRITE");
-    assert(config.role == NetworkRole::None);
-    (void) config;
+    EXPECT_EQ(NetworkRole::None, config.role);
   }
 }
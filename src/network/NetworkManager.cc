@@ -119,9 +119,8 @@ NetworkManager::NetworkManager(
     {
       if (_info.Namespace() != this->Namespace())
       {
-        gzmsg << "Peer [" << _info.Namespace()
-               << "] removed, stopping simulation" << std::endl;
-        this->dataPtr->eventMgr->Emit<events::Stop>();
+        gzmsg << "Peer [" << _info.Namespace() << "] removed" << std::endl;
+        this->OnPeerLost(_info);
       }
     });
 
@@ -130,9 +129,9 @@ NetworkManager::NetworkManager(
     {
       if (_info.Namespace() != this->Namespace())
       {
-        gzerr << "Peer [" << _info.Namespace()
-               << "] went stale, stopping simulation" << std::endl;
-        this->dataPtr->eventMgr->Emit<events::Stop>();
+        gzerr << "Peer [" << _info.Namespace() << "] went stale"
+               << std::endl;
+        this->OnPeerLost(_info);
       }
     });
   }
@@ -175,3 +174,11 @@ NetworkConfig NetworkManager::Config() const
 {
   return this->dataPtr->config;
 }
+
+//////////////////////////////////////////////////
+void NetworkManager::OnPeerLost(const PeerInfo &_info)
+{
+  gzmsg << "Lost peer [" << _info.Namespace() << "], stopping simulation"
+        << std::endl;
+  this->dataPtr->eventMgr->Emit<events::Stop>();
+}
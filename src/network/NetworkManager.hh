@@ -28,6 +28,7 @@
 #include <gz/sim/EventManager.hh>
 
 #include "NetworkConfig.hh"
+#include "PeerInfo.hh"
 
 namespace gz
 {
@@ -118,6 +119,11 @@ namespace gz
       /// \return The manager's config.
       public: NetworkConfig Config() const;
 
+      /// \brief Called when another peer disconnects or goes stale. The
+      /// default behavior is to stop simulation.
+      /// \param[in] _info Information about the lost peer.
+      protected: virtual void OnPeerLost(const PeerInfo &_info);
+
       /// \brief Private data
       protected: std::unique_ptr<NetworkManagerPrivate> dataPtr;
     };
@@ -18,20 +18,24 @@
 #include "NetworkManagerPrimary.hh"
 
 #include <gz/msgs/world_stats.pb.h>
-#include <gz/msgs/serialized_map.pb.h>
 #include "gz/sim/private_msgs/peer_control.pb.h"
 #include "gz/sim/private_msgs/simulation_step.pb.h"
+#include "gz/sim/private_msgs/step_ack.pb.h"
 
 #include <algorithm>
-#include <future>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
 #include <gz/common/Profiler.hh>
 
+#include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/PerformerAffinity.hh"
 #include "gz/sim/components/PerformerLevels.hh"
 #include "gz/sim/Conversions.hh"
@@ -46,6 +50,19 @@ using namespace gz;
 using namespace sim;
 using namespace std::chrono_literals;
 
+/// \brief Size of the shared memory rings. Larger messages are streamed
+/// through them.
+constexpr std::size_t kSharedMemoryCapacity{8u * 1024u * 1024u};
+
+/// \brief Time a secondary may take to acknowledge a step before its step
+/// times are known, or when the step changes affinities.
+constexpr std::chrono::steady_clock::duration kMaxStepTimeout{10s};
+
+/// \brief Minimum time a secondary may take to acknowledge a step, so
+/// hiccups of the network or of the operating system aren't mistaken for
+/// failures.
+constexpr std::chrono::steady_clock::duration kMinStepTimeout{1s};
+
 //////////////////////////////////////////////////
 NetworkManagerPrimary::NetworkManagerPrimary(
     const std::function<void(const UpdateInfo &_info)> &_stepFunction,
@@ -59,6 +76,40 @@ NetworkManagerPrimary::NetworkManagerPrimary(
   this->node.Subscribe("step_ack", &NetworkManagerPrimary::OnStepAck, this);
 }
 
+//////////////////////////////////////////////////
+NetworkManagerPrimary::~NetworkManagerPrimary()
+{
+  // Steps still in flight are drained before their channels are closed, so
+  // secondaries aren't torn down mid-step. Late secondaries aren't recovered
+  // here, each step is only given up to the maximum timeout.
+  {
+    std::unique_lock<std::mutex> lock(this->secondaryStatesMutex);
+    while (!this->pendingAcks.empty())
+    {
+      const auto deadline =
+          this->pendingAcks.begin()->second.sent + kMaxStepTimeout;
+      if (this->secondaryStatesCv.wait_until(lock, deadline) ==
+          std::cv_status::timeout)
+      {
+        gzwarn << "Shutting down with [" << this->pendingAcks.size()
+               << "] unacknowledged steps." << std::endl;
+        break;
+      }
+    }
+  }
+
+  for (auto &secondary : this->secondaries)
+  {
+    auto &sc = secondary.second;
+    if (sc->stepChannel)
+      sc->stepChannel->Close();
+    if (sc->ackChannel)
+      sc->ackChannel->Close();
+    if (sc->ackThread.joinable())
+      sc->ackThread.join();
+  }
+}
+
 //////////////////////////////////////////////////
 void NetworkManagerPrimary::Handshake()
 {
@@ -72,6 +123,20 @@ void NetworkManagerPrimary::Handshake()
     sc->id = peer;
     sc->prefix = peer.substr(0, 8);
 
+    // Secondaries on the same host are offered shared memory channels, and
+    // the network is used if they can't open them
+    std::unique_ptr<SharedMemoryChannel> stepChannel, ackChannel;
+    if (this->dataPtr->tracker->IsLocalPeer(peer))
+    {
+      stepChannel = SharedMemoryChannel::Create(
+          NetworkManagerPrivate::SharedMemoryName(sc->prefix, "step"),
+          kSharedMemoryCapacity);
+      ackChannel = SharedMemoryChannel::Create(
+          NetworkManagerPrivate::SharedMemoryName(sc->prefix, "step_ack"),
+          kSharedMemoryCapacity);
+      req.set_shared_memory(stepChannel && ackChannel);
+    }
+
     bool result;
     std::string topic {sc->prefix + "/control"};
     unsigned int timeout = 5000;
@@ -85,6 +150,16 @@ void NetworkManagerPrimary::Handshake()
       {
         gzmsg << "Peer initialized [" << sc->prefix << "]" << std::endl;
         sc->ready = true;
+
+        if (req.shared_memory() && resp.shared_memory())
+        {
+          gzmsg << "Stepping peer [" << sc->prefix
+                << "] through shared memory" << std::endl;
+          sc->stepChannel = std::move(stepChannel);
+          sc->ackChannel = std::move(ackChannel);
+          sc->ackThread = std::thread(&NetworkManagerPrimary::ReadStepAcks,
+              this, sc.get());
+        }
       }
       else
       {
@@ -98,6 +173,12 @@ void NetworkManagerPrimary::Handshake()
              << timeout << " ms" << std::endl;
     }
 
+    {
+      std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+      auto &timeout = this->stepTimeouts[sc->prefix];
+      timeout.SetInitialTimeout(kMaxStepTimeout);
+      timeout.SetMinTimeout(kMinStepTimeout);
+    }
     this->secondaries[sc->prefix] = std::move(sc);
   }
 }
@@ -131,8 +212,18 @@ bool NetworkManagerPrimary::Step(const UpdateInfo &_info)
     return false;
   }
 
+  // Migrations need the latest state of the performers' models, so steps
+  // which are still in flight are finished first
+  if (!this->pendingMigrations.empty())
+  {
+    if (!this->WaitForSecondaries(0u))
+      return false;
+    this->ApplySecondaryStates();
+  }
+
   private_msgs::SimulationStep step;
   step.mutable_stats()->CopyFrom(convert<msgs::WorldStatistics>(_info));
+  step.set_sequence(this->stepSequence);
 
   // Affinities that changed this step
   this->PopulateAffinities(step);
@@ -145,37 +236,43 @@ bool NetworkManagerPrimary::Step(const UpdateInfo &_info)
   }
 
   // Send step to all secondaries
-  this->secondaryStates.clear();
-  this->secondaryStatesPromise = std::promise<void>{};
-  auto future = this->secondaryStatesPromise.get_future();
-  this->simStepPub.Publish(step);
-
-  // Block until all secondaries are done
   {
-    GZ_PROFILE("Waiting for secondaries");
-
-    auto result = future.wait_for(10s);
-
-    if (std::future_status::ready != result)
+    std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+    auto &pending = this->pendingAcks[this->stepSequence++];
+    pending.sent = std::chrono::steady_clock::now();
+    pending.affinities = step.affinity_size() > 0;
+    for (const auto &secondary : this->secondaries)
+      pending.secondaries.insert(secondary.first);
+  }
+  this->stepData.clear();
+  bool publish{false};
+  for (const auto &secondary : this->secondaries)
+  {
+    auto &channel = secondary.second->stepChannel;
+    if (!channel)
     {
-      gzerr << "Waited 10 s and got only [" << this->secondaryStates.size()
-             << " / " << this->secondaries.size()
-             << "] responses from secondaries. Stopping simulation."
-             << std::endl;
-      this->dataPtr->eventMgr->Emit<events::Stop>();
-      return false;
+      publish = true;
+      continue;
     }
-  }
 
-  // Update primary state with states received from secondaries
-  {
-    GZ_PROFILE("Updating primary state");
-    for (const auto &msg : this->secondaryStates)
+    if (this->stepData.empty())
+      step.SerializeToString(&this->stepData);
+    if (!channel->Write(this->stepData, 10s))
     {
-      this->dataPtr->ecm->SetState(msg);
+      gzerr << "Failed to send step to secondary [" << secondary.first
+             << "] through shared memory." << std::endl;
     }
-    this->secondaryStates.clear();
   }
+  if (publish)
+    this->simStepPub.Publish(step);
+
+  // Block until all secondaries are done, or only keep as many steps in
+  // flight as the lookahead allows. The primary's ECM then lags behind the
+  // secondaries, and catches up as their states arrive.
+  if (!this->WaitForSecondaries(this->Lookahead()))
+    return false;
+
+  this->ApplySecondaryStates();
 
   // Step all systems
   this->dataPtr->stepFunction(_info);
@@ -199,15 +296,303 @@ std::map<std::string, SecondaryControl::Ptr>
 }
 
 //////////////////////////////////////////////////
-void NetworkManagerPrimary::OnStepAck(const msgs::SerializedStateMap &_msg)
+void NetworkManagerPrimary::OnStepAck(const private_msgs::StepAck &_msg)
+{
+  const auto now = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+
+    // Secondaries removed after failing may still be running, and their
+    // acks are ignored
+    const auto &prefix = _msg.secondary_prefix();
+    auto it = this->pendingAcks.find(_msg.sequence());
+    if (it == this->pendingAcks.end() ||
+        it->second.secondaries.erase(prefix) == 0u)
+    {
+      return;
+    }
+
+    this->secondaryStates.push_back(_msg.state());
+    this->secondaryStepTimes[prefix] =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(_msg.step_time()));
+
+    // Steps changing affinities are outliers, since models are loaded
+    // and removed
+    auto timeout = this->stepTimeouts.find(prefix);
+    if (!it->second.affinities && timeout != this->stepTimeouts.end())
+      timeout->second.AddSample(now - it->second.sent);
+
+    if (it->second.secondaries.empty())
+      this->pendingAcks.erase(it);
+  }
+  this->secondaryStatesCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::ReadStepAcks(SecondaryControl *_secondary)
 {
-  this->secondaryStates.push_back(_msg);
-  if (this->secondaryStates.size() == this->secondaries.size())
+  std::string data;
+  private_msgs::StepAck msg;
+  while (!_secondary->ackChannel->Closed())
   {
-    this->secondaryStatesPromise.set_value();
+    if (!_secondary->ackChannel->Read(data, 100ms))
+      continue;
+
+    if (!msg.ParseFromString(data))
+    {
+      gzerr << "Received an invalid step ack from secondary ["
+             << _secondary->prefix << "] through shared memory." << std::endl;
+      continue;
+    }
+    this->OnStepAck(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+bool NetworkManagerPrimary::WaitForSecondaries(std::size_t _maxPending)
+{
+  GZ_PROFILE("Waiting for secondaries");
+
+  std::unique_lock<std::mutex> lock(this->secondaryStatesMutex);
+  while (true)
+  {
+    if (!this->failedSecondaries.empty())
+    {
+      lock.unlock();
+      if (!this->RecoverSecondaries())
+        return false;
+      lock.lock();
+      continue;
+    }
+
+    if (this->pendingAcks.size() <= _maxPending)
+      return true;
+
+    // Secondaries acknowledge steps in order, so the oldest step is the
+    // first one to be late
+    const auto &[sequence, oldest] = *this->pendingAcks.begin();
+    const auto now = std::chrono::steady_clock::now();
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    for (const auto &prefix : oldest.secondaries)
+    {
+      auto timeout = kMaxStepTimeout;
+      auto estimator = this->stepTimeouts.find(prefix);
+      if (!oldest.affinities && estimator != this->stepTimeouts.end())
+        timeout = estimator->second.Timeout();
+
+      if (now - oldest.sent < timeout)
+      {
+        deadline = std::min(deadline, oldest.sent + timeout);
+        continue;
+      }
+
+      gzerr << "Secondary [" << prefix << "] didn't acknowledge step ["
+             << sequence << "] within ["
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                timeout).count() << "] ms." << std::endl;
+      this->failedSecondaries.insert(prefix);
+    }
+
+    if (this->failedSecondaries.empty())
+      this->secondaryStatesCv.wait_until(lock, deadline);
   }
 }
 
+//////////////////////////////////////////////////
+bool NetworkManagerPrimary::RecoverSecondaries()
+{
+  GZ_PROFILE("NetworkManagerPrimary::RecoverSecondaries");
+
+  std::set<std::string> failed;
+  {
+    std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+    failed.swap(this->failedSecondaries);
+
+    // Steps in flight stop waiting for the failed secondaries
+    for (auto it = this->pendingAcks.begin(); it != this->pendingAcks.end();)
+    {
+      for (const auto &prefix : failed)
+        it->second.secondaries.erase(prefix);
+
+      if (it->second.secondaries.empty())
+        it = this->pendingAcks.erase(it);
+      else
+        ++it;
+    }
+
+    for (const auto &prefix : failed)
+    {
+      this->stepTimeouts.erase(prefix);
+      this->secondaryStepTimes.erase(prefix);
+    }
+  }
+
+  // Ack threads take the lock, so they're joined without it
+  for (const auto &prefix : failed)
+  {
+    auto it = this->secondaries.find(prefix);
+    if (it == this->secondaries.end())
+      continue;
+
+    auto &sc = it->second;
+    if (sc->stepChannel)
+      sc->stepChannel->Close();
+    if (sc->ackChannel)
+      sc->ackChannel->Close();
+    if (sc->ackThread.joinable())
+      sc->ackThread.join();
+    this->secondaries.erase(it);
+
+    gzerr << "Removed failed secondary [" << prefix << "], ["
+           << this->secondaries.size() << "] secondaries left." << std::endl;
+  }
+
+  if (this->secondaries.empty())
+  {
+    gzerr << "No secondaries left. Stopping simulation." << std::endl;
+    this->dataPtr->eventMgr->Emit<events::Stop>();
+    return false;
+  }
+
+  // Performers which were going to migrate to a failed secondary stay where
+  // they are
+  for (auto it = this->pendingMigrations.begin();
+      it != this->pendingMigrations.end();)
+  {
+    if (failed.find(it->second) != failed.end())
+      it = this->pendingMigrations.erase(it);
+    else
+      ++it;
+  }
+
+  // Cost of the performers of each remaining secondary, as the number of
+  // entities in their models, and performers left without a secondary
+  std::map<std::string, std::size_t> costs;
+  for (const auto &secondary : this->secondaries)
+    costs[secondary.first] = 0u;
+
+  std::vector<std::pair<std::size_t, Entity>> orphans;
+  this->dataPtr->ecm->Each<components::PerformerAffinity,
+                           components::ParentEntity>(
+    [&](const Entity &_entity,
+        const components::PerformerAffinity *_affinity,
+        const components::ParentEntity *_parent) -> bool
+    {
+      const auto cost = this->dataPtr->ecm->Descendants(_parent->Data()).size();
+      if (failed.find(_affinity->Data()) != failed.end())
+      {
+        orphans.emplace_back(cost, _entity);
+        return true;
+      }
+
+      auto migration = this->pendingMigrations.find(_entity);
+      auto it = costs.find(migration == this->pendingMigrations.end() ?
+          _affinity->Data() : migration->second);
+      if (it != costs.end())
+        it->second += cost;
+      return true;
+    });
+
+  // The primary has the state of the orphans' models up to the last step
+  // their secondary acknowledged, and it's sent to the secondaries they
+  // migrate to on the next step. The most expensive performers are placed
+  // first, each on the secondary with the lowest cost.
+  std::sort(orphans.rbegin(), orphans.rend());
+  for (const auto &[cost, performer] : orphans)
+  {
+    auto target = std::min_element(costs.begin(), costs.end(),
+        [](const auto &_a, const auto &_b)
+        {
+          return _a.second < _b.second;
+        });
+    target->second += cost;
+    this->pendingMigrations[performer] = target->first;
+
+    gzmsg << "Reassigning performer [" << performer << "] to secondary ["
+          << target->first << "]." << std::endl;
+  }
+
+  // Step times were measured with the previous assignment
+  this->balancer.Reset();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::OnPeerLost(const PeerInfo &_info)
+{
+  if (_info.role != NetworkRole::SimulationSecondary)
+  {
+    NetworkManager::OnPeerLost(_info);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+    this->failedSecondaries.insert(_info.id.substr(0, 8));
+  }
+  this->secondaryStatesCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::ApplySecondaryStates()
+{
+  GZ_PROFILE("Updating primary state");
+
+  std::map<std::string, std::chrono::steady_clock::duration> stepTimes;
+  {
+    std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+    this->receivedStates.swap(this->secondaryStates);
+    stepTimes.swap(this->secondaryStepTimes);
+  }
+
+  // States of each secondary arrive in the order of its steps
+  for (const auto &state : this->receivedStates)
+  {
+    // Snapshots are applied in place, without deserializing a message
+    if (!this->dataPtr->ecm->SetStateSnapshot(
+        reinterpret_cast<const std::uint8_t *>(state.data()), state.size()))
+    {
+      gzerr << "Received an invalid state from a secondary." << std::endl;
+    }
+  }
+  this->receivedStates.clear();
+
+  this->BalanceLoad(stepTimes);
+}
+
+//////////////////////////////////////////////////
+std::size_t NetworkManagerPrimary::Lookahead() const
+{
+  const auto lookahead = this->dataPtr->config.lookahead;
+  if (lookahead == 0u)
+    return 0u;
+
+  // Performers of different secondaries on the same level may interact, so
+  // they're kept in lockstep
+  std::map<Entity, std::string> levelSecondaries;
+  bool shared{false};
+  this->dataPtr->ecm->Each<components::PerformerLevels,
+                           components::PerformerAffinity>(
+    [&](const Entity &,
+        const components::PerformerLevels *_levels,
+        const components::PerformerAffinity *_affinity) -> bool
+    {
+      for (const auto &level : _levels->Data())
+      {
+        auto it = levelSecondaries.emplace(level, _affinity->Data()).first;
+        if (it->second != _affinity->Data())
+        {
+          shared = true;
+          return false;
+        }
+      }
+      return true;
+    });
+
+  return shared ? 0u : lookahead;
+}
+
 //////////////////////////////////////////////////
 bool NetworkManagerPrimary::SecondariesCanStep() const
 {
@@ -302,9 +687,67 @@ void NetworkManagerPrimary::PopulateAffinities(
     return;
   }
 
+  // Migrate performers picked by BalanceLoad, along with the state of their
+  // models, which the new secondary removed when they were first assigned
+  for (const auto &[performer, secondary] : this->pendingMigrations)
+  {
+    auto parent =
+        this->dataPtr->ecm->Component<components::ParentEntity>(performer);
+    if (nullptr == parent ||
+        this->secondaries.find(secondary) == this->secondaries.end())
+    {
+      continue;
+    }
+
+    auto affinityMsg = _msg.add_affinity();
+    this->SetAffinity(performer, secondary, affinityMsg);
+
+    std::vector<std::uint8_t> state;
+    this->dataPtr->ecm->StateSnapshot(state,
+        this->dataPtr->ecm->Descendants(parent->Data()), {}, true);
+    affinityMsg->set_state(state.data(), state.size());
+  }
+  this->pendingMigrations.clear();
+
   // TODO(louise) Process level changes
 }
 
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::BalanceLoad(
+    const std::map<std::string, std::chrono::steady_clock::duration>
+    &_stepTimes)
+{
+  GZ_PROFILE("NetworkManagerPrimary::BalanceLoad");
+
+  for (const auto &[prefix, time] : _stepTimes)
+    this->balancer.AddStepTime(prefix, time);
+
+  if (!this->pendingMigrations.empty() || !this->balancer.Ready())
+    return;
+
+  // A performer costs as much as the number of entities in its model
+  this->dataPtr->ecm->Each<components::PerformerAffinity,
+                           components::ParentEntity>(
+    [&](const Entity &_entity,
+        const components::PerformerAffinity *_affinity,
+        const components::ParentEntity *_parent) -> bool
+    {
+      const auto cost = this->dataPtr->ecm->Descendants(_parent->Data()).size();
+      this->balancer.SetPerformer(_entity, _affinity->Data(),
+          static_cast<double>(cost));
+      return true;
+    });
+
+  Entity performer;
+  std::string secondary;
+  if (this->balancer.Balance(performer, secondary))
+  {
+    gzmsg << "Migrating performer [" << performer << "] to secondary ["
+          << secondary << "] to balance the load." << std::endl;
+    this->pendingMigrations[performer] = secondary;
+  }
+}
+
 //////////////////////////////////////////////////
 void NetworkManagerPrimary::SetAffinity(Entity _performer,
     const std::string &_secondary, private_msgs::PerformerAffinity *_msg)
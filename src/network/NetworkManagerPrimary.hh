@@ -17,14 +17,20 @@
 #ifndef GZ_SIM_NETWORK_NETWORKMANAGERPRIMARY_HH_
 #define GZ_SIM_NETWORK_NETWORKMANAGERPRIMARY_HH_
 
-#include <gz/msgs/serialized_map.pb.h>
 #include "gz/sim/private_msgs/simulation_step.pb.h"
+#include "gz/sim/private_msgs/step_ack.pb.h"
 
 #include <atomic>
-#include <future>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gz/sim/config.hh>
@@ -33,7 +39,10 @@
 #include <gz/transport/Node.hh>
 
 
+#include "LoadBalancer.hh"
 #include "NetworkManager.hh"
+#include "SharedMemoryChannel.hh"
+#include "TimeoutEstimator.hh"
 
 namespace gz
 {
@@ -52,6 +61,17 @@ namespace gz
       /// \brief prefix namespace of the secondary peer
       std::string prefix;
 
+      /// \brief Channel carrying steps to the secondary if it runs on the
+      /// same host, null to use the network.
+      std::unique_ptr<SharedMemoryChannel> stepChannel;
+
+      /// \brief Channel carrying step acks from the secondary if it runs on
+      /// the same host.
+      std::unique_ptr<SharedMemoryChannel> ackChannel;
+
+      /// \brief Thread reading the ackChannel.
+      std::thread ackThread;
+
       /// \brief Convenience alias for unique_ptr.
       using Ptr = std::unique_ptr<SecondaryControl>;
     };
@@ -69,6 +89,10 @@ namespace gz
           const NetworkConfig &_config,
           const NodeOptions &_options);
 
+      /// \brief Destructor. Waits for steps in flight to be acknowledged
+      /// before closing the secondaries' channels.
+      public: ~NetworkManagerPrimary() override;
+
       // Documentation inherited
       public: void Handshake() override;
 
@@ -90,18 +114,60 @@ namespace gz
       /// peers.
       public: std::map<std::string, SecondaryControl::Ptr>& Secondaries();
 
+      /// \brief Mark a lost secondary as failed, so its performers are
+      /// reassigned. Other peers stop simulation.
+      /// \param[in] _info Information about the lost peer.
+      protected: void OnPeerLost(const PeerInfo &_info) override;
+
       /// \brief Callback for step ack messages.
-      /// \param[in] _msg Message containing secondary's updated state.
-      private: void OnStepAck(const msgs::SerializedStateMap &_msg);
+      /// \param[in] _msg Message containing the secondary's changed state and
+      /// how long it took to step.
+      private: void OnStepAck(const private_msgs::StepAck &_msg);
+
+      /// \brief Read step acks from a secondary on the same host until its
+      /// channel is closed.
+      /// \param[in] _secondary The secondary.
+      private: void ReadStepAcks(SecondaryControl *_secondary);
 
       /// \brief Check if the step publisher has connections.
       private: bool SecondariesCanStep() const;
 
+      /// \brief Block until at most a number of steps are waiting for
+      /// acknowledgements. Secondaries which take longer than their
+      /// timeout to acknowledge a step, or which the peer tracker lost, are
+      /// removed and their performers reassigned.
+      /// \param[in] _maxPending Number of steps which may stay in flight.
+      /// \return False if no secondary is left, and simulation is stopped.
+      private: bool WaitForSecondaries(std::size_t _maxPending);
+
+      /// \brief Remove the secondaries marked as failed, and migrate their
+      /// performers to the remaining ones with the state they had in the
+      /// last acknowledged step.
+      /// \return False if no secondary is left, and simulation is stopped.
+      private: bool RecoverSecondaries();
+
+      /// \brief Apply the states received from secondaries since the last
+      /// call to the primary's ECM, and measure their load.
+      private: void ApplySecondaryStates();
+
+      /// \brief Number of steps secondaries may run ahead this step. They
+      /// only run ahead while performers of different secondaries don't
+      /// share levels.
+      /// \return Number of steps, zero for lockstep.
+      private: std::size_t Lookahead() const;
+
       /// \brief Populate the step message with the latest affinities according
-      /// to levels.
+      /// to levels and performer migrations.
       /// \param[in] _msg Step message.
       private: void PopulateAffinities(private_msgs::SimulationStep &_msg);
 
+      /// \brief Measure the step times of the secondaries and the cost of
+      /// their performers, and pick a performer to migrate if they're
+      /// imbalanced.
+      /// \param[in] _stepTimes Latest step time of each secondary.
+      private: void BalanceLoad(const std::map<std::string,
+          std::chrono::steady_clock::duration> &_stepTimes);
+
       /// \brief Set the performer to secondary affinity.
       /// \param[in] _performer Performer entity.
       /// \param[in] _secondary Secondary identifier.
@@ -118,11 +184,65 @@ namespace gz
       /// \brief Publisher for network step sync
       private: gz::transport::Node::Publisher simStepPub;
 
-      /// \brief Keep track of states received from secondaries.
-      private: std::vector<msgs::SerializedStateMap> secondaryStates;
+      /// \brief Keep track of states received from secondaries, as state
+      /// snapshots.
+      /// \sa StateSnapshotWriter
+      private: std::vector<std::string> secondaryStates;
+
+      /// \brief Step time of each secondary in the latest step, by prefix.
+      private: std::map<std::string, std::chrono::steady_clock::duration>
+          secondaryStepTimes;
+
+      /// \brief A step waiting for acknowledgements.
+      private: struct PendingStep
+      {
+        /// \brief Time the step was sent.
+        std::chrono::steady_clock::time_point sent;
+
+        /// \brief Prefixes of the secondaries which didn't acknowledge it.
+        std::set<std::string> secondaries;
+
+        /// \brief Whether the step changes affinities, which makes the
+        /// secondaries take unusually long.
+        bool affinities{false};
+      };
+
+      /// \brief Steps in flight, by sequence number.
+      private: std::map<std::uint64_t, PendingStep> pendingAcks;
+
+      /// \brief Estimates how long each secondary may take to acknowledge a
+      /// step, from the time between sending steps and receiving their
+      /// acknowledgements, by prefix.
+      private: std::map<std::string, TimeoutEstimator> stepTimeouts;
+
+      /// \brief Prefixes of the secondaries found to have failed, which are
+      /// removed on the next wait.
+      private: std::set<std::string> failedSecondaries;
+
+      /// \brief Protects secondaryStates, secondaryStepTimes, pendingAcks,
+      /// stepTimeouts and failedSecondaries.
+      private: std::mutex secondaryStatesMutex;
+
+      /// \brief Notified when acknowledgements are received.
+      private: std::condition_variable secondaryStatesCv;
+
+      /// \brief States being applied, swapped with secondaryStates to reuse
+      /// their memory.
+      private: std::vector<std::string> receivedStates;
+
+      /// \brief Sequence number of the next step.
+      private: std::uint64_t stepSequence{0u};
+
+      /// \brief Serialized step for the shared memory channels, reused
+      /// between steps.
+      private: std::string stepData;
+
+      /// \brief Decides which performers to migrate between secondaries.
+      private: LoadBalancer balancer;
 
-      /// \brief Promise used to notify when all secondaryStates where received.
-      private: std::promise<void> secondaryStatesPromise;
+      /// \brief Performers to migrate on the next step, and the prefix of the
+      /// secondary they're migrated to.
+      private: std::map<Entity, std::string> pendingMigrations;
     };
     }
   }  // namespace sim
@@ -19,6 +19,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 
 #include <gz/sim/config.hh>
 #include <gz/sim/Export.hh>
@@ -67,6 +68,17 @@ namespace gz
 
       /// \brief Track connection to "events::Stop" Event
       public: gz::common::ConnectionPtr stoppingConn;
+
+      /// \brief Name of the shared memory channel carrying a topic between
+      /// the primary and a secondary on the same host.
+      /// \param[in] _prefix Namespace of the secondary.
+      /// \param[in] _topic Topic carried by the channel.
+      /// \return Channel name.
+      public: static std::string SharedMemoryName(const std::string &_prefix,
+                  const std::string &_topic)
+              {
+                return "/gz_sim_" + _prefix + "_" + _topic;
+              }
     };
     }
   }  // namespace sim
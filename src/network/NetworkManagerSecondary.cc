@@ -15,17 +15,19 @@
  *
 */
 
-#include <gz/msgs/serialized_map.pb.h>
 #include "gz/sim/private_msgs/peer_control.pb.h"
 #include "gz/sim/private_msgs/simulation_step.pb.h"
+#include "gz/sim/private_msgs/step_ack.pb.h"
 
 #include <algorithm>
+#include <chrono>
 #include <string>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
 #include <gz/common/Profiler.hh>
 
+#include "gz/sim/components/Model.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/Conversions.hh"
 #include "gz/sim/Entity.hh"
@@ -35,9 +37,11 @@
 #include "NetworkManagerPrivate.hh"
 #include "NetworkManagerSecondary.hh"
 #include "PeerTracker.hh"
+#include "../StateSnapshot.hh"
 
 using namespace gz;
 using namespace sim;
+using namespace std::chrono_literals;
 
 //////////////////////////////////////////////////
 NetworkManagerSecondary::NetworkManagerSecondary(
@@ -63,7 +67,19 @@ NetworkManagerSecondary::NetworkManagerSecondary(
 
   this->node.Subscribe("step", &NetworkManagerSecondary::OnStep, this);
 
-  this->stepAckPub = this->node.Advertise<msgs::SerializedStateMap>("step_ack");
+  this->stepAckPub = this->node.Advertise<private_msgs::StepAck>("step_ack");
+  this->stepAckMsg.set_secondary_prefix(this->Namespace());
+}
+
+//////////////////////////////////////////////////
+NetworkManagerSecondary::~NetworkManagerSecondary()
+{
+  if (this->stepChannel)
+    this->stepChannel->Close();
+  if (this->ackChannel)
+    this->ackChannel->Close();
+  if (this->stepThread.joinable())
+    this->stepThread.join();
 }
 
 //////////////////////////////////////////////////
@@ -95,14 +111,66 @@ bool NetworkManagerSecondary::OnControl(const private_msgs::PeerControl &_req,
 {
   this->enableSim = _req.enable_sim();
   _resp.set_enable_sim(this->enableSim);
+
+  // The primary runs on the same host, and the network is used if the
+  // channels can't be opened
+  if (_req.shared_memory() && !this->sharedMemory)
+  {
+    this->stepChannel = SharedMemoryChannel::Open(
+        NetworkManagerPrivate::SharedMemoryName(this->Namespace(), "step"));
+    this->ackChannel = SharedMemoryChannel::Open(
+        NetworkManagerPrivate::SharedMemoryName(this->Namespace(),
+        "step_ack"));
+    if (this->stepChannel && this->ackChannel)
+    {
+      gzmsg << "Stepping through shared memory" << std::endl;
+      this->sharedMemory = true;
+      this->stepThread = std::thread(&NetworkManagerSecondary::ReadSteps,
+          this);
+    }
+    else
+    {
+      this->stepChannel.reset();
+      this->ackChannel.reset();
+    }
+  }
+  _resp.set_shared_memory(this->sharedMemory);
   return true;
 }
 
+//////////////////////////////////////////////////
+void NetworkManagerSecondary::ReadSteps()
+{
+  std::string data;
+  private_msgs::SimulationStep msg;
+  while (!this->stepChannel->Closed() && !this->dataPtr->stopReceived)
+  {
+    if (!this->stepChannel->Read(data, 100ms))
+      continue;
+
+    if (!msg.ParseFromString(data))
+    {
+      gzerr << "Received an invalid step through shared memory."
+             << std::endl;
+      continue;
+    }
+    this->ProcessStep(msg);
+  }
+}
+
 /////////////////////////////////////////////////
 void NetworkManagerSecondary::OnStep(
     const private_msgs::SimulationStep &_msg)
 {
-  GZ_PROFILE("NetworkManagerSecondary::OnStep");
+  if (!this->sharedMemory)
+    this->ProcessStep(_msg);
+}
+
+/////////////////////////////////////////////////
+void NetworkManagerSecondary::ProcessStep(
+    const private_msgs::SimulationStep &_msg)
+{
+  GZ_PROFILE("NetworkManagerSecondary::ProcessStep");
 
   // Throttle the number of step messages going to the debug output.
   if (!_msg.stats().paused() && _msg.stats().iterations() % 1000 == 0)
@@ -112,6 +180,7 @@ void NetworkManagerSecondary::OnStep(
   }
 
   // Update affinities
+  bool performersChanged{false};
   for (int i = 0; i < _msg.affinity_size(); ++i)
   {
     const auto &affinityMsg = _msg.affinity(i);
@@ -120,6 +189,32 @@ void NetworkManagerSecondary::OnStep(
     if (affinityMsg.secondary_prefix() == this->Namespace())
     {
       this->performers.insert(entityId);
+      performersChanged = true;
+
+      // Performers migrated from another secondary come with the state of
+      // their models, whose plugins are loaded again here
+      if (!affinityMsg.state().empty())
+      {
+        const auto &state = affinityMsg.state();
+        if (!this->dataPtr->ecm->SetStateSnapshot(
+            reinterpret_cast<const std::uint8_t *>(state.data()),
+            state.size()))
+        {
+          gzerr << "Received an invalid state for performer [" << entityId
+                 << "]." << std::endl;
+        }
+
+        auto parent =
+            this->dataPtr->ecm->Component<components::ParentEntity>(entityId);
+        auto modelSdf = nullptr == parent ? nullptr :
+            this->dataPtr->ecm->Component<components::ModelSdf>(
+            parent->Data());
+        if (nullptr != modelSdf)
+        {
+          this->dataPtr->eventMgr->Emit<events::LoadSdfPlugins>(
+              parent->Data(), modelSdf->Data().Plugins());
+        }
+      }
 
       gzmsg << "Secondary [" << this->Namespace()
              << "] assigned affinity to performer [" << entityId << "]."
@@ -128,9 +223,12 @@ void NetworkManagerSecondary::OnStep(
     // If performer has been assigned to another secondary, remove it
     else
     {
+      // The model may already be gone, if the performer is migrated between
+      // other secondaries
       auto parent =
           this->dataPtr->ecm->Component<components::ParentEntity>(entityId);
-      this->dataPtr->ecm->RequestRemoveEntity(parent->Data());
+      if (nullptr != parent)
+        this->dataPtr->ecm->RequestRemoveEntity(parent->Data());
 
       if (this->performers.find(entityId) != this->performers.end())
       {
@@ -138,6 +236,7 @@ void NetworkManagerSecondary::OnStep(
                << "] unassigned affinity to performer [" << entityId << "]."
                << std::endl;
         this->performers.erase(entityId);
+        performersChanged = true;
       }
     }
   }
@@ -145,8 +244,12 @@ void NetworkManagerSecondary::OnStep(
   // Update info
   auto info = convert<UpdateInfo>(_msg.stats());
 
-  // Step runner
+  // Step runner, timed so the primary can balance the load
+  const auto stepStart = std::chrono::steady_clock::now();
   this->dataPtr->stepFunction(info);
+  this->stepAckMsg.set_step_time(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - stepStart).count());
 
   // Update state with all the performer's entities
   std::unordered_set<Entity> entities;
@@ -166,13 +269,39 @@ void NetworkManagerSecondary::OnStep(
     entities.insert(children.begin(), children.end());
   }
 
-  msgs::SerializedStateMap stateMsg;
-  if (!entities.empty())
-    this->dataPtr->ecm->State(stateMsg, entities);
-  stateMsg.set_has_one_time_component_changes(
-    this->dataPtr->ecm->HasOneTimeComponentChanges());
+  // Send everything about newly assigned performers, and afterwards only
+  // the components that changed since the last step, which the primary
+  // acknowledged by sending this one
+  if (performersChanged)
+    this->deltaFilter.Reset();
 
-  this->stepAckPub.Publish(stateMsg);
+  if (entities.empty())
+  {
+    StateSnapshotWriter writer(this->snapshot);
+    writer.SetOneTimeChanges(
+        this->dataPtr->ecm->HasOneTimeComponentChanges());
+  }
+  else
+  {
+    this->dataPtr->ecm->StateSnapshot(this->snapshot, entities, {},
+        performersChanged);
+  }
+  this->deltaFilter.Filter(this->snapshot, this->delta);
+
+  this->stepAckMsg.set_state(this->delta.data(), this->delta.size());
+  this->stepAckMsg.set_sequence(_msg.sequence());
+  if (this->ackChannel)
+  {
+    this->stepAckMsg.SerializeToString(&this->stepAckData);
+    if (!this->ackChannel->Write(this->stepAckData, 10s))
+    {
+      gzerr << "Failed to send step ack through shared memory." << std::endl;
+    }
+  }
+  else
+  {
+    this->stepAckPub.Publish(this->stepAckMsg);
+  }
 
   this->dataPtr->ecm->SetAllComponentsUnchanged();
 }
@@ -18,9 +18,12 @@
 #define GZ_SIM_NETWORK_NETWORKMANAGERSECONDARY_HH_
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include <gz/sim/config.hh>
 #include <gz/sim/Export.hh>
@@ -28,8 +31,11 @@
 
 #include "gz/sim/private_msgs/simulation_step.pb.h"
 #include "gz/sim/private_msgs/peer_control.pb.h"
+#include "gz/sim/private_msgs/step_ack.pb.h"
 
 #include "NetworkManager.hh"
+#include "SharedMemoryChannel.hh"
+#include "SnapshotDeltaFilter.hh"
 
 namespace gz
 {
@@ -50,6 +56,9 @@ namespace gz
           const NetworkConfig &_config,
           const NodeOptions &_options);
 
+      /// \brief Destructor.
+      public: ~NetworkManagerSecondary() override;
+
       // Documentation inherited
       public: bool Ready() const override;
 
@@ -67,9 +76,17 @@ namespace gz
                              private_msgs::PeerControl &_resp);
 
       /// \brief Callback when step commands are received from the primary
+      /// through the network. They're ignored when using shared memory.
       /// \param[in] _msg Step message.
       private: void OnStep(const private_msgs::SimulationStep &_msg);
 
+      /// \brief Run a step commanded by the primary and acknowledge it.
+      /// \param[in] _msg Step message.
+      private: void ProcessStep(const private_msgs::SimulationStep &_msg);
+
+      /// \brief Read steps from the shared memory channel until it's closed.
+      private: void ReadSteps();
+
       /// \brief Flag to control enabling/disabling simulation secondary.
       private: std::atomic<bool> enableSim {false};
 
@@ -81,6 +98,37 @@ namespace gz
 
       /// \brief Collection of performers associated with this secondary.
       private: std::unordered_set<Entity> performers;
+
+      /// \brief Snapshot of the performers' changed components, reused
+      /// between steps.
+      private: std::vector<std::uint8_t> snapshot;
+
+      /// \brief Snapshot without the components whose data didn't change
+      /// since the last step, reused between steps.
+      private: std::vector<std::uint8_t> delta;
+
+      /// \brief Removes the components the primary already has.
+      private: SnapshotDeltaFilter deltaFilter;
+
+      /// \brief Step acknowledgement message, reused between steps.
+      private: private_msgs::StepAck stepAckMsg;
+
+      /// \brief Channel carrying steps from the primary, if it runs on the
+      /// same host.
+      private: std::unique_ptr<SharedMemoryChannel> stepChannel;
+
+      /// \brief Channel carrying step acks to the primary.
+      private: std::unique_ptr<SharedMemoryChannel> ackChannel;
+
+      /// \brief True once steps are exchanged through shared memory.
+      private: std::atomic<bool> sharedMemory{false};
+
+      /// \brief Thread reading the stepChannel.
+      private: std::thread stepThread;
+
+      /// \brief Serialized step ack for the shared memory channel, reused
+      /// between steps.
+      private: std::string stepAckData;
     };
     }
   }  // namespace sim
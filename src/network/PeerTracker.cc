@@ -93,6 +93,29 @@ size_t PeerTracker::StaleMultiplier() const
   return this->staleMultiplier;
 }
 
+/////////////////////////////////////////////////
+void PeerTracker::SetMinStaleMultiplier(const size_t &_multiplier)
+{
+  this->minStaleMultiplier = _multiplier;
+}
+
+/////////////////////////////////////////////////
+size_t PeerTracker::MinStaleMultiplier() const
+{
+  return this->minStaleMultiplier;
+}
+
+/////////////////////////////////////////////////
+PeerTracker::Duration PeerTracker::StaleTime(const PeerState &_peer) const
+{
+  const Duration maxTime = this->staleMultiplier * this->heartbeatPeriod;
+  if (_peer.heartbeats.Samples() == 0u)
+    return maxTime;
+
+  const Duration minTime = this->minStaleMultiplier * this->heartbeatPeriod;
+  return std::min(maxTime, std::max(minTime, _peer.heartbeats.Timeout()));
+}
+
 /////////////////////////////////////////////////
 size_t PeerTracker::NumPeers() const
 {
@@ -116,6 +139,16 @@ size_t PeerTracker::NumPeers(const NetworkRole &_role) const
   return count;
 }
 
+/////////////////////////////////////////////////
+bool PeerTracker::IsLocalPeer(const std::string &_id) const
+{
+  auto lock = PeerLock(this->peersMutex);
+
+  auto it = this->peers.find(_id);
+  return it != this->peers.end() &&
+      it->second.info.hostname == this->info.hostname;
+}
+
 /////////////////////////////////////////////////
 void PeerTracker::HeartbeatLoop()
 {
@@ -128,12 +161,16 @@ void PeerTracker::HeartbeatLoop()
     this->heartbeatPub.Publish(toProto(this->info));
 
     std::vector<PeerInfo> toRemove;
-    for (auto peer : this->peers)
     {
-      auto age = Clock::now() - peer.second.lastSeen;
-      if (age > (this->staleMultiplier * this->heartbeatPeriod))
+      auto lock = PeerLock(this->peersMutex);
+      const auto now = Clock::now();
+      for (const auto &peer : this->peers)
       {
-        toRemove.push_back(peer.second.info);
+        auto age = now - peer.second.lastSeen;
+        if (age > this->StaleTime(peer.second))
+        {
+          toRemove.push_back(peer.second.info);
+        }
       }
     }
 
@@ -209,14 +246,19 @@ void PeerTracker::OnPeerHeartbeat(const private_msgs::PeerInfo &_info)
 
   // If it doesn't exist, we may have missed a peer announce,
   // so add it here on the heartbeat.
-  if (this->peers.find(peer.id) == this->peers.end())
+  const bool added = this->peers.find(peer.id) == this->peers.end();
+  if (added)
   {
     this->OnPeerAdded(peer);
   }
 
-  // Update information about the state of this peer.
+  // Update information about the state of this peer. Intervals between
+  // heartbeats are measured to detect when the next one is late.
   auto &peerState = this->peers[peer.id];
-  peerState.lastSeen = std::chrono::steady_clock::now();
+  const auto now = std::chrono::steady_clock::now();
+  if (!added)
+    peerState.heartbeats.AddSample(now - peerState.lastSeen);
+  peerState.lastSeen = now;
   peerState.lastHeader = std::chrono::steady_clock::time_point(
       std::chrono::seconds(_info.header().stamp().sec()) +
       std::chrono::nanoseconds(_info.header().stamp().nsec()));
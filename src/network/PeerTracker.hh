@@ -30,6 +30,7 @@
 #include <gz/transport/Node.hh>
 
 #include "PeerInfo.hh"
+#include "TimeoutEstimator.hh"
 
 namespace gz
 {
@@ -92,6 +93,11 @@ namespace gz
       ///
       /// max = heartbeatPeriod * staleMultiplier
       ///
+      /// A peer whose heartbeats arrive regularly is marked stale sooner,
+      /// once its heartbeat is late by a few times the deviation of the
+      /// intervals between its previous heartbeats.
+      /// \sa SetMinStaleMultiplier
+      ///
       /// \param[in] _multipler Multiplier of heartbeat period.
       public: void SetStaleMultiplier(const size_t &_multiplier);
 
@@ -99,6 +105,19 @@ namespace gz
       /// \return Number of hearbeats before a peer is marked stale.
       public: size_t StaleMultiplier() const;
 
+      /// \brief Set number of heartbeats of this peer under which a peer is
+      /// never marked stale, however regular its heartbeats are. The minimum
+      /// stale time is:
+      ///
+      /// min = heartbeatPeriod * minStaleMultiplier
+      ///
+      /// \param[in] _multiplier Multiplier of heartbeat period.
+      public: void SetMinStaleMultiplier(const size_t &_multiplier);
+
+      /// \brief Get the minimum heartbeat multiplier.
+      /// \return Minimum number of heartbeats before a peer is marked stale.
+      public: size_t MinStaleMultiplier() const;
+
       /// \brief Retrieve total number of detected peers in the network.
       public: size_t NumPeers() const;
 
@@ -136,6 +155,11 @@ namespace gz
                 return ret;
               }
 
+      /// \brief Whether a discovered peer runs on the same host as this one.
+      /// \param[in] _id Id of the peer.
+      /// \return True if the peer is known and has the same hostname.
+      public: bool IsLocalPeer(const std::string &_id) const;
+
       /// \brief Internal loop to announce and check stale peers.
       private: void HeartbeatLoop();
 
@@ -175,8 +199,16 @@ namespace gz
 
         /// \brief Keep last time heartbeat was received
         std::chrono::steady_clock::time_point lastSeen;
+
+        /// \brief Intervals between the heartbeats of the peer.
+        TimeoutEstimator heartbeats;
       };
 
+      /// \brief Time without heartbeats after which a peer is stale.
+      /// \param[in] _peer The peer.
+      /// \return Stale time, between the minimum and maximum ones.
+      private: Duration StaleTime(const PeerState &_peer) const;
+
       /// \brief Convenience type alias
       private: using PeerMutex = std::recursive_mutex;
 
@@ -202,6 +234,9 @@ namespace gz
       /// \brief Timeout to mark a peer as stale.
       private: size_t staleMultiplier {100};
 
+      /// \brief Minimum timeout to mark a peer as stale.
+      private: size_t minStaleMultiplier {20};
+
       /// \brief Peer information that this tracker announces.
       private: PeerInfo info;
 
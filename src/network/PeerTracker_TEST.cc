@@ -120,6 +120,11 @@ TEST(PeerTracker, PeerTracker)
   EXPECT_EQ(1u, tracker5->NumPeers(NetworkRole::ReadOnly));
   EXPECT_EQ(1u, tracker5->NumPeers(NetworkRole::None));
 
+  // All peers run on this host
+  for (const auto &id : tracker1->SecondaryPeers())
+    EXPECT_TRUE(tracker1->IsLocalPeer(id));
+  EXPECT_FALSE(tracker1->IsLocalPeer("unknown"));
+
   tracker6.reset();
   std::this_thread::sleep_for(std::chrono::milliseconds(100));
   EXPECT_EQ(4, peers);
@@ -187,6 +192,49 @@ TEST(PeerTracker, GZ_UTILS_TEST_DISABLED_ON_MAC(PeerTrackerStale))
   // received from stale peer
 }
 
+//////////////////////////////////////////////////
+TEST(PeerTracker, GZ_UTILS_TEST_DISABLED_ON_MAC(AdaptiveStale))
+{
+  gz::common::Console::SetVerbosity(4);
+  EventManager eventMgr;
+
+  // At most 2 s without heartbeats, but 200 ms for regular peers
+  auto tracker1 = std::make_shared<PeerTracker>(
+      PeerInfo(NetworkRole::SimulationPrimary), &eventMgr);
+  tracker1->SetHeartbeatPeriod(std::chrono::milliseconds(20));
+  tracker1->SetStaleMultiplier(100);
+  tracker1->SetMinStaleMultiplier(10);
+  EXPECT_EQ(10u, tracker1->MinStaleMultiplier());
+
+  std::atomic<int> stalePeers = 0;
+  auto stale = eventMgr.Connect<PeerStale>([&](PeerInfo)
+  {
+    stalePeers++;
+  });
+
+  auto tracker2 = std::make_shared<PeerTracker>(
+      PeerInfo(NetworkRole::SimulationSecondary));
+  tracker2->SetHeartbeatPeriod(std::chrono::milliseconds(20));
+
+  int sleep{0};
+  for (; sleep < 100 && tracker1->NumPeers() == 0; ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  ASSERT_EQ(1u, tracker1->NumPeers());
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  // The peer stalls, and is detected long before the maximum stale time
+  tracker2->SetHeartbeatPeriod(std::chrono::milliseconds(1500));
+  const auto start = std::chrono::steady_clock::now();
+  while (stalePeers == 0 &&
+      std::chrono::steady_clock::now() - start < std::chrono::seconds(2))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_LE(1, stalePeers);
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+      std::chrono::milliseconds(1500));
+}
+
 //////////////////////////////////////////////////
 TEST(PeerTracker, Partitioned)
 {
@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SharedMemoryChannel.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+namespace gz
+{
+namespace sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE
+{
+#ifndef _WIN32
+/// \brief Layout of the start of the shared memory.
+struct SharedMemoryHeader
+{
+  /// \brief Always "GZSIMSHM", set once the channel is initialized.
+  char magic[8];
+
+  /// \brief Size of the ring buffer.
+  std::uint64_t capacity;
+
+  /// \brief Total number of bytes written.
+  std::uint64_t written;
+
+  /// \brief Total number of bytes read.
+  std::uint64_t read;
+
+  /// \brief Non zero once either end closed the channel.
+  std::atomic<std::uint32_t> closed;
+
+  /// \brief Protects written and read.
+  pthread_mutex_t mutex;
+
+  /// \brief Notified when written, read or closed change.
+  pthread_cond_t cond;
+};
+#else
+struct SharedMemoryHeader
+{
+};
+#endif
+}
+}
+}
+
+using namespace gz;
+using namespace sim;
+
+#ifndef _WIN32
+namespace
+{
+/// \brief Magic bytes of initialized channels.
+constexpr char kMagic[8] = {'G', 'Z', 'S', 'I', 'M', 'S', 'H', 'M'};
+
+//////////////////////////////////////////////////
+/// \brief Lock a robust mutex, recovering it if its owner died.
+bool lock(pthread_mutex_t *_mutex)
+{
+  const int result = pthread_mutex_lock(_mutex);
+  if (result == EOWNERDEAD)
+    return pthread_mutex_consistent(_mutex) == 0;
+  return result == 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Wait on the condition until a deadline.
+/// \return False on timeout.
+bool wait(pthread_cond_t *_cond, pthread_mutex_t *_mutex,
+    const std::chrono::steady_clock::time_point &_deadline)
+{
+  // The condition uses CLOCK_MONOTONIC, which steady_clock is based on
+  const auto remaining = _deadline - std::chrono::steady_clock::now();
+  if (remaining <= std::chrono::steady_clock::duration::zero())
+    return false;
+
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      remaining).count() + now.tv_nsec;
+  timespec until;
+  until.tv_sec = now.tv_sec + static_cast<time_t>(ns / 1000000000);
+  until.tv_nsec = static_cast<long>(ns % 1000000000);  // NOLINT
+
+  const int result = pthread_cond_timedwait(_cond, _mutex, &until);
+  if (result == EOWNERDEAD)
+    pthread_mutex_consistent(_mutex);
+  return result != ETIMEDOUT;
+}
+}
+#endif
+
+//////////////////////////////////////////////////
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::Create(
+    const std::string &_name, std::size_t _capacity)
+{
+#ifndef _WIN32
+  if (_capacity == 0u)
+  {
+    gzerr << "Shared memory channel [" << _name << "] needs a capacity."
+          << std::endl;
+    return nullptr;
+  }
+
+  // A channel left behind by a process which crashed is replaced
+  int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 && errno == EEXIST)
+  {
+    shm_unlink(_name.c_str());
+    fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+  if (fd < 0)
+  {
+    gzwarn << "Failed to create shared memory channel [" << _name << "]: "
+           << std::strerror(errno) << std::endl;
+    return nullptr;
+  }
+
+  const std::size_t size = sizeof(SharedMemoryHeader) + _capacity;
+  void *memory = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    gzwarn << "Failed to map shared memory channel [" << _name << "]: "
+           << std::strerror(errno) << std::endl;
+    shm_unlink(_name.c_str());
+    return nullptr;
+  }
+
+  auto header = new (memory) SharedMemoryHeader;
+  header->capacity = _capacity;
+  header->written = 0u;
+  header->read = 0u;
+  header->closed = 0u;
+
+  pthread_mutexattr_t mutexAttr;
+  pthread_mutexattr_init(&mutexAttr);
+  pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+  pthread_mutex_init(&header->mutex, &mutexAttr);
+  pthread_mutexattr_destroy(&mutexAttr);
+
+  pthread_condattr_t condAttr;
+  pthread_condattr_init(&condAttr);
+  pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+  pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+  pthread_cond_init(&header->cond, &condAttr);
+  pthread_condattr_destroy(&condAttr);
+
+  std::memcpy(header->magic, kMagic, sizeof(kMagic));
+
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel);
+  channel->name = _name;
+  channel->header = header;
+  channel->ring = static_cast<char *>(memory) + sizeof(SharedMemoryHeader);
+  channel->mappedSize = size;
+  channel->owner = true;
+  return channel;
+#else
+  gzwarn << "Shared memory channels aren't supported on Windows, not "
+         << "creating [" << _name << "] of [" << _capacity << "] bytes."
+         << std::endl;
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::Open(
+    const std::string &_name)
+{
+#ifndef _WIN32
+  const int fd = shm_open(_name.c_str(), O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzwarn << "Failed to open shared memory channel [" << _name << "]: "
+           << std::strerror(errno) << std::endl;
+    return nullptr;
+  }
+
+  struct stat info;
+  void *memory = MAP_FAILED;
+  std::size_t size = 0u;
+  if (fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) > sizeof(SharedMemoryHeader))
+  {
+    size = static_cast<std::size_t>(info.st_size);
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    gzwarn << "Failed to map shared memory channel [" << _name << "]."
+           << std::endl;
+    return nullptr;
+  }
+
+  auto header = static_cast<SharedMemoryHeader *>(memory);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->capacity + sizeof(SharedMemoryHeader) != size)
+  {
+    gzwarn << "Shared memory [" << _name << "] isn't a valid channel."
+           << std::endl;
+    munmap(memory, size);
+    return nullptr;
+  }
+
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel);
+  channel->name = _name;
+  channel->header = header;
+  channel->ring = static_cast<char *>(memory) + sizeof(SharedMemoryHeader);
+  channel->mappedSize = size;
+  return channel;
+#else
+  gzwarn << "Shared memory channels aren't supported on Windows, not "
+         << "opening [" << _name << "]." << std::endl;
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+#ifndef _WIN32
+  this->Close();
+  if (this->owner)
+  {
+    pthread_cond_destroy(&this->header->cond);
+    pthread_mutex_destroy(&this->header->mutex);
+    shm_unlink(this->name.c_str());
+  }
+  munmap(this->header, this->mappedSize);
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryChannel::Write(const std::string &_data,
+    const std::chrono::steady_clock::duration &_timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + _timeout;
+  const std::uint64_t size = _data.size();
+  if (this->Put(reinterpret_cast<const char *>(&size), sizeof(size),
+      deadline) && this->Put(_data.data(), _data.size(), deadline))
+  {
+    return true;
+  }
+
+  // A partly written message can't be recovered by the reader
+  this->Close();
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryChannel::Read(std::string &_data,
+    const std::chrono::steady_clock::duration &_timeout)
+{
+  // Only wait for the start of a message within the timeout, then the rest
+  // of it is bound to follow
+  std::uint64_t messageSize;
+  auto *size = reinterpret_cast<char *>(&messageSize);
+  if (!this->Get(size, 1u, std::chrono::steady_clock::now() + _timeout))
+    return false;
+
+  const auto deadline = std::chrono::steady_clock::now() +
+      std::max(_timeout, std::chrono::steady_clock::duration(
+      std::chrono::seconds(10)));
+  if (this->Get(size + 1, sizeof(messageSize) - 1u, deadline))
+  {
+    _data.resize(messageSize);
+    if (this->Get(_data.data(), _data.size(), deadline))
+      return true;
+  }
+
+  this->Close();
+  return false;
+}
+
+//////////////////////////////////////////////////
+void SharedMemoryChannel::Close()
+{
+#ifndef _WIN32
+  if (!lock(&this->header->mutex))
+    return;
+  this->header->closed = 1u;
+  pthread_cond_broadcast(&this->header->cond);
+  pthread_mutex_unlock(&this->header->mutex);
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryChannel::Closed() const
+{
+#ifndef _WIN32
+  return this->header->closed != 0u;
+#else
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+const std::string &SharedMemoryChannel::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryChannel::Put(const char *_data, std::size_t _size,
+    const std::chrono::steady_clock::time_point &_deadline)
+{
+#ifndef _WIN32
+  auto *h = this->header;
+  while (_size > 0u)
+  {
+    if (!lock(&h->mutex))
+      return false;
+    while (h->written - h->read == h->capacity && h->closed == 0u)
+    {
+      if (!wait(&h->cond, &h->mutex, _deadline))
+        break;
+    }
+    const std::uint64_t free = h->capacity - (h->written - h->read);
+    const std::uint64_t offset = h->written % h->capacity;
+    const bool closed = h->closed != 0u;
+    pthread_mutex_unlock(&h->mutex);
+    if (closed || free == 0u)
+      return false;
+
+    // The reader doesn't touch the free part of the ring, so it's copied
+    // without holding the lock
+    const auto chunk = static_cast<std::size_t>(std::min<std::uint64_t>(
+        {_size, free, h->capacity - offset}));
+    std::memcpy(this->ring + offset, _data, chunk);
+    _data += chunk;
+    _size -= chunk;
+
+    if (!lock(&h->mutex))
+      return false;
+    h->written += chunk;
+    pthread_cond_broadcast(&h->cond);
+    pthread_mutex_unlock(&h->mutex);
+  }
+  return true;
+#else
+  (void) _data;
+  (void) _size;
+  (void) _deadline;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryChannel::Get(char *_data, std::size_t _size,
+    const std::chrono::steady_clock::time_point &_deadline)
+{
+#ifndef _WIN32
+  auto *h = this->header;
+  while (_size > 0u)
+  {
+    if (!lock(&h->mutex))
+      return false;
+    while (h->written == h->read && h->closed == 0u)
+    {
+      if (!wait(&h->cond, &h->mutex, _deadline))
+        break;
+    }
+    const std::uint64_t available = h->written - h->read;
+    const std::uint64_t offset = h->read % h->capacity;
+    const bool closed = h->closed != 0u;
+    pthread_mutex_unlock(&h->mutex);
+    if (closed || available == 0u)
+      return false;
+
+    const auto chunk = static_cast<std::size_t>(std::min<std::uint64_t>(
+        {_size, available, h->capacity - offset}));
+    std::memcpy(_data, this->ring + offset, chunk);
+    _data += chunk;
+    _size -= chunk;
+
+    if (!lock(&h->mutex))
+      return false;
+    h->read += chunk;
+    pthread_cond_broadcast(&h->cond);
+    pthread_mutex_unlock(&h->mutex);
+  }
+  return true;
+#else
+  (void) _data;
+  (void) _size;
+  (void) _deadline;
+  return false;
+#endif
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_NETWORK_SHAREDMEMORYCHANNEL_HH_
+#define GZ_SIM_NETWORK_SHAREDMEMORYCHANNEL_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    struct SharedMemoryHeader;
+
+    /// \class SharedMemoryChannel SharedMemoryChannel.hh
+    ///   gz/sim/network/SharedMemoryChannel.hh
+    /// \brief One way channel carrying messages between two processes on the
+    /// same host through POSIX shared memory.
+    ///
+    /// The channel is a ring buffer with a process shared mutex and
+    /// condition variable. Messages are written as their size followed by
+    /// their bytes, and may be larger than the ring, in which case they're
+    /// streamed through it as the reader makes room. There must be a single
+    /// writer and a single reader. Channels aren't available on Windows.
+    class GZ_SIM_VISIBLE SharedMemoryChannel
+    {
+      /// \brief Create a channel, replacing a stale one with the same name.
+      /// The channel is removed from the system when the returned object is
+      /// destroyed.
+      /// \param[in] _name Name of the channel, starting with "/".
+      /// \param[in] _capacity Size of the ring buffer in bytes.
+      /// \return The channel, or nullptr if it couldn't be created.
+      public: static std::unique_ptr<SharedMemoryChannel> Create(
+                  const std::string &_name, std::size_t _capacity);
+
+      /// \brief Open a channel created by another process.
+      /// \param[in] _name Name of the channel, starting with "/".
+      /// \return The channel, or nullptr if it doesn't exist or is invalid.
+      public: static std::unique_ptr<SharedMemoryChannel> Open(
+                  const std::string &_name);
+
+      /// \brief Destructor. Unmaps the channel, and removes it if it was
+      /// created by this object.
+      public: ~SharedMemoryChannel();
+
+      /// \brief Write a message, blocking while the ring is full.
+      /// \param[in] _data The message.
+      /// \param[in] _timeout How long to wait for the reader to make room.
+      /// \return False if the channel is closed or the reader didn't make
+      /// room in time, in which case the channel is closed.
+      public: bool Write(const std::string &_data,
+                  const std::chrono::steady_clock::duration &_timeout);
+
+      /// \brief Read the next message, blocking until it's available.
+      /// \param[out] _data The message.
+      /// \param[in] _timeout How long to wait for the writer.
+      /// \return False if no message arrived in time or the channel is
+      /// closed.
+      public: bool Read(std::string &_data,
+                  const std::chrono::steady_clock::duration &_timeout);
+
+      /// \brief Close the channel on both ends, waking up blocked calls.
+      public: void Close();
+
+      /// \brief Whether either end closed the channel.
+      /// \return True if closed.
+      public: bool Closed() const;
+
+      /// \brief Name of the channel.
+      /// \return The name.
+      public: const std::string &Name() const;
+
+      /// \brief Constructor, use Create or Open instead.
+      private: SharedMemoryChannel() = default;
+
+      /// \brief Copy bytes into the ring.
+      /// \param[in] _data Bytes to copy.
+      /// \param[in] _size Number of bytes.
+      /// \param[in] _deadline When to give up waiting for room.
+      /// \return False on timeout or if the channel is closed.
+      private: bool Put(const char *_data, std::size_t _size,
+                  const std::chrono::steady_clock::time_point &_deadline);
+
+      /// \brief Copy bytes out of the ring.
+      /// \param[out] _data Destination of the bytes.
+      /// \param[in] _size Number of bytes.
+      /// \param[in] _deadline When to give up waiting for data.
+      /// \return False on timeout or if the channel is closed.
+      private: bool Get(char *_data, std::size_t _size,
+                  const std::chrono::steady_clock::time_point &_deadline);
+
+      /// \brief Name of the channel.
+      private: std::string name;
+
+      /// \brief Header at the start of the mapped memory.
+      private: SharedMemoryHeader *header{nullptr};
+
+      /// \brief Ring buffer following the header.
+      private: char *ring{nullptr};
+
+      /// \brief Size of the mapped memory.
+      private: std::size_t mappedSize{0u};
+
+      /// \brief True if this object created the channel.
+      private: bool owner{false};
+    };
+    }
+  }  // namespace sim
+}  // namespace gz
+
+#endif  // GZ_SIM_NETWORK_SHAREDMEMORYCHANNEL_HH_
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "SharedMemoryChannel.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryChannel, GZ_UTILS_TEST_DISABLED_ON_WIN32(RoundTrip))
+{
+  auto writer = SharedMemoryChannel::Create("/gz_sim_test_round_trip", 64);
+  ASSERT_NE(nullptr, writer);
+  auto reader = SharedMemoryChannel::Open("/gz_sim_test_round_trip");
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ("/gz_sim_test_round_trip", reader->Name());
+
+  std::string data;
+  EXPECT_FALSE(reader->Read(data, 10ms));
+
+  EXPECT_TRUE(writer->Write("first", 1s));
+  EXPECT_TRUE(writer->Write(std::string(), 1s));
+  EXPECT_TRUE(writer->Write("third", 1s));
+
+  ASSERT_TRUE(reader->Read(data, 1s));
+  EXPECT_EQ("first", data);
+  ASSERT_TRUE(reader->Read(data, 1s));
+  EXPECT_TRUE(data.empty());
+  ASSERT_TRUE(reader->Read(data, 1s));
+  EXPECT_EQ("third", data);
+
+  // The ring is full and nobody reads
+  EXPECT_FALSE(writer->Write(std::string(100, 'x'), 10ms));
+  EXPECT_TRUE(reader->Closed());
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryChannel, GZ_UTILS_TEST_DISABLED_ON_WIN32(Streaming))
+{
+  auto writer = SharedMemoryChannel::Create("/gz_sim_test_streaming", 100);
+  ASSERT_NE(nullptr, writer);
+  auto reader = SharedMemoryChannel::Open("/gz_sim_test_streaming");
+  ASSERT_NE(nullptr, reader);
+
+  // Messages much larger than the ring wrap around it many times
+  std::string big;
+  for (int i = 0; i < 10000; ++i)
+    big.push_back(static_cast<char>(i % 251));
+
+  std::thread thread([&]
+      {
+        for (int i = 0; i < 5; ++i)
+          EXPECT_TRUE(writer->Write(big + std::to_string(i), 5s));
+      });
+
+  std::string data;
+  for (int i = 0; i < 5; ++i)
+  {
+    ASSERT_TRUE(reader->Read(data, 5s));
+    EXPECT_EQ(big + std::to_string(i), data);
+  }
+  thread.join();
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryChannel, GZ_UTILS_TEST_DISABLED_ON_WIN32(Close))
+{
+  auto writer = SharedMemoryChannel::Create("/gz_sim_test_close", 64);
+  ASSERT_NE(nullptr, writer);
+  auto reader = SharedMemoryChannel::Open("/gz_sim_test_close");
+  ASSERT_NE(nullptr, reader);
+
+  // Closing wakes up a blocked reader
+  std::thread thread([&]
+      {
+        std::this_thread::sleep_for(50ms);
+        writer->Close();
+      });
+  std::string data;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(reader->Read(data, 10s));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+  thread.join();
+  EXPECT_TRUE(reader->Closed());
+  EXPECT_FALSE(writer->Write("late", 1s));
+
+  // Channels that don't exist can't be opened, and destroying the creator
+  // removes it
+  EXPECT_EQ(nullptr, SharedMemoryChannel::Open("/gz_sim_test_missing"));
+  reader.reset();
+  writer.reset();
+  EXPECT_EQ(nullptr, SharedMemoryChannel::Open("/gz_sim_test_close"));
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SnapshotDeltaFilter.hh"
+
+#include <gz/common/Profiler.hh>
+
+#include "../StateSnapshot.hh"
+
+using namespace gz;
+using namespace sim;
+
+//////////////////////////////////////////////////
+bool SnapshotDeltaFilter::Filter(const std::vector<std::uint8_t> &_in,
+    std::vector<std::uint8_t> &_out)
+{
+  GZ_PROFILE("SnapshotDeltaFilter::Filter");
+
+  StateSnapshotReader reader(_in.data(), _in.size());
+  if (!reader.Valid())
+  {
+    _out.clear();
+    return false;
+  }
+
+  StateSnapshotWriter writer(_out);
+  writer.SetOneTimeChanges(reader.OneTimeChanges());
+
+  StateSnapshotRecord record;
+  while (reader.Next(record))
+  {
+    switch (record.type)
+    {
+      case StateSnapshotRecordType::RemovedEntity:
+        this->sent.erase(record.entity);
+        break;
+      case StateSnapshotRecordType::RemovedComponent:
+      {
+        auto entityIt = this->sent.find(record.entity);
+        if (entityIt != this->sent.end())
+          entityIt->second.erase(record.typeId);
+        break;
+      }
+      default:
+      {
+        auto &last = this->sent[record.entity][record.typeId];
+        const auto *data = reinterpret_cast<const char *>(record.data);
+        if (last.size() == record.size &&
+            last.compare(0, last.size(), data, record.size) == 0)
+        {
+          ++this->skipped;
+          continue;
+        }
+        last.assign(data, record.size);
+        break;
+      }
+    }
+    writer.CopyRecord(record);
+  }
+
+  if (!reader.Valid())
+  {
+    _out.clear();
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SnapshotDeltaFilter::Reset()
+{
+  this->sent.clear();
+}
+
+//////////////////////////////////////////////////
+void SnapshotDeltaFilter::Forget(Entity _entity)
+{
+  this->sent.erase(_entity);
+}
+
+//////////////////////////////////////////////////
+std::size_t SnapshotDeltaFilter::Skipped() const
+{
+  return this->skipped;
+}
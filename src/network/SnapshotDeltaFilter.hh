@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_NETWORK_SNAPSHOTDELTAFILTER_HH_
+#define GZ_SIM_NETWORK_SNAPSHOTDELTAFILTER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Entity.hh>
+#include <gz/sim/Export.hh>
+#include <gz/sim/Types.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class SnapshotDeltaFilter SnapshotDeltaFilter.hh
+    ///   gz/sim/network/SnapshotDeltaFilter.hh
+    /// \brief Removes the component records whose data didn't change from a
+    /// sequence of state snapshots, before they're sent to another process.
+    ///
+    /// Components are often marked as changed without their value changing,
+    /// for example the poses of bodies at rest. The filter keeps the data of
+    /// every component record it let through, and drops a record when its
+    /// data is byte for byte the same as the last time. Removal records are
+    /// always let through. This assumes the receiver applies every filtered
+    /// snapshot, so the filter must be reset whenever the receiver may have
+    /// missed one.
+    /// \sa StateSnapshotWriter
+    class GZ_SIM_VISIBLE SnapshotDeltaFilter
+    {
+      /// \brief Copy the records of a snapshot that changed since the last
+      /// time into another snapshot.
+      /// \param[in] _in Snapshot to filter.
+      /// \param[out] _out Snapshot with the changed records. Its previous
+      /// contents are discarded, but its capacity is reused.
+      /// \return False if _in is malformed, in which case _out is empty.
+      public: bool Filter(const std::vector<std::uint8_t> &_in,
+                  std::vector<std::uint8_t> &_out);
+
+      /// \brief Forget the data of all components, so the next snapshot is
+      /// let through completely.
+      public: void Reset();
+
+      /// \brief Forget the data of an entity's components, so they're let
+      /// through the next time.
+      /// \param[in] _entity The entity.
+      public: void Forget(Entity _entity);
+
+      /// \brief Number of records removed since construction.
+      /// \return Number of records.
+      public: std::size_t Skipped() const;
+
+      /// \brief Data of the component records last let through, by entity
+      /// and component type.
+      private: std::unordered_map<Entity,
+                   std::unordered_map<ComponentTypeId, std::string>> sent;
+
+      /// \brief Number of records removed since construction.
+      private: std::size_t skipped{0u};
+    };
+    }
+  }  // namespace sim
+}  // namespace gz
+
+#endif  // GZ_SIM_NETWORK_SNAPSHOTDELTAFILTER_HH_
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/sim/components/Factory.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "SnapshotDeltaFilter.hh"
+#include "../StateSnapshot.hh"
+
+#include "../../test/helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+class SnapshotDeltaFilterTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Count the records of a snapshot.
+std::uint64_t recordCount(const std::vector<std::uint8_t> &_snapshot)
+{
+  StateSnapshotReader reader(_snapshot.data(), _snapshot.size());
+  std::uint64_t count{0u};
+  StateSnapshotRecord record;
+  while (reader.Next(record))
+    ++count;
+  EXPECT_TRUE(reader.Valid());
+  return count;
+}
+
+/////////////////////////////////////////////////
+TEST_F(SnapshotDeltaFilterTest, Filter)
+{
+  components::Pose pose(math::Pose3d(1, 2, 3, 0, 0, 0));
+  components::Name name("name");
+
+  std::vector<std::uint8_t> in;
+  std::vector<std::uint8_t> out;
+  SnapshotDeltaFilter filter;
+
+  // Everything is new
+  {
+    StateSnapshotWriter writer(in);
+    writer.SetOneTimeChanges(true);
+    writer.AddComponent(1, &pose);
+    writer.AddComponent(1, &name);
+  }
+  ASSERT_TRUE(filter.Filter(in, out));
+  EXPECT_EQ(2u, recordCount(out));
+  EXPECT_TRUE(StateSnapshotReader(out.data(), out.size()).OneTimeChanges());
+
+  // Only the pose changed
+  pose.Data().Pos().X() = 10;
+  {
+    StateSnapshotWriter writer(in);
+    writer.AddComponent(1, &pose);
+    writer.AddComponent(1, &name);
+  }
+  ASSERT_TRUE(filter.Filter(in, out));
+  EXPECT_EQ(1u, recordCount(out));
+  EXPECT_EQ(1u, filter.Skipped());
+
+  StateSnapshotReader reader(out.data(), out.size());
+  StateSnapshotRecord record;
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(components::Pose::typeId, record.typeId);
+  EXPECT_FALSE(reader.OneTimeChanges());
+  components::Pose readPose;
+  EXPECT_TRUE(StateSnapshotReader::ReadComponent(record,
+      components::Factory::Instance()->DataOps(record.typeId),
+      &readPose));
+  EXPECT_EQ(pose.Data(), readPose.Data());
+
+  // Removals always go through, and forget the data
+  {
+    StateSnapshotWriter writer(in);
+    writer.AddRemovedComponent(1, components::Name::typeId);
+    writer.AddComponent(1, &pose);
+  }
+  ASSERT_TRUE(filter.Filter(in, out));
+  EXPECT_EQ(1u, recordCount(out));
+
+  {
+    StateSnapshotWriter writer(in);
+    writer.AddComponent(1, &name);
+  }
+  ASSERT_TRUE(filter.Filter(in, out));
+  EXPECT_EQ(1u, recordCount(out));
+
+  // Forgotten entities are sent again
+  filter.Forget(1);
+  {
+    StateSnapshotWriter writer(in);
+    writer.AddComponent(1, &pose);
+    writer.AddComponent(1, &name);
+  }
+  ASSERT_TRUE(filter.Filter(in, out));
+  EXPECT_EQ(2u, recordCount(out));
+
+  // Malformed input
+  in.resize(4);
+  EXPECT_FALSE(filter.Filter(in, out));
+  EXPECT_TRUE(out.empty());
+}
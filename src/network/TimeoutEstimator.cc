@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TimeoutEstimator.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include <gz/common/Console.hh>
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Weight of a new duration in the moving average, as in RFC 6298.
+constexpr double kAverageGain{1.0 / 8.0};
+
+/// \brief Weight of a new difference in the moving deviation.
+constexpr double kDeviationGain{1.0 / 4.0};
+
+//////////////////////////////////////////////////
+void TimeoutEstimator::SetInitialTimeout(const Duration &_timeout)
+{
+  this->initialTimeout = _timeout;
+}
+
+//////////////////////////////////////////////////
+void TimeoutEstimator::SetMinTimeout(const Duration &_timeout)
+{
+  this->minTimeout = _timeout;
+}
+
+//////////////////////////////////////////////////
+void TimeoutEstimator::SetDeviationFactor(double _factor)
+{
+  if (!(_factor > 0.0))
+  {
+    gzerr << "Deviation factor must be greater than 0, got [" << _factor
+          << "]." << std::endl;
+    return;
+  }
+  this->deviationFactor = _factor;
+}
+
+//////////////////////////////////////////////////
+void TimeoutEstimator::AddSample(const Duration &_duration)
+{
+  const double seconds = std::chrono::duration<double>(_duration).count();
+
+  // The first duration is assumed to deviate by half of itself
+  if (this->samples++ == 0u)
+  {
+    this->average = seconds;
+    this->deviation = seconds * 0.5;
+    return;
+  }
+
+  // The deviation is updated with the previous average
+  this->deviation +=
+      (std::abs(seconds - this->average) - this->deviation) * kDeviationGain;
+  this->average += (seconds - this->average) * kAverageGain;
+}
+
+//////////////////////////////////////////////////
+std::size_t TimeoutEstimator::Samples() const
+{
+  return this->samples;
+}
+
+//////////////////////////////////////////////////
+TimeoutEstimator::Duration TimeoutEstimator::Timeout() const
+{
+  if (this->samples == 0u)
+    return this->initialTimeout;
+
+  const auto estimate = std::chrono::duration_cast<Duration>(
+      std::chrono::duration<double>(
+      this->average + this->deviationFactor * this->deviation));
+  return std::max(this->minTimeout, estimate);
+}
+
+//////////////////////////////////////////////////
+void TimeoutEstimator::Reset()
+{
+  this->average = 0.0;
+  this->deviation = 0.0;
+  this->samples = 0u;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_NETWORK_TIMEOUTESTIMATOR_HH_
+#define GZ_SIM_NETWORK_TIMEOUTESTIMATOR_HH_
+
+#include <chrono>
+#include <cstddef>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/Export.hh>
+
+namespace gz
+{
+  namespace sim
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_SIM_VERSION_NAMESPACE {
+    /// \class TimeoutEstimator TimeoutEstimator.hh
+    ///   gz/sim/network/TimeoutEstimator.hh
+    /// \brief Estimates how long to wait for a peer before considering it
+    /// failed, from the durations it took before.
+    ///
+    /// Like TCP's retransmission timer, the estimator keeps moving averages
+    /// of the durations and of their deviation from the average, and the
+    /// timeout is the average plus a multiple of the deviation. A peer whose
+    /// durations are regular is detected quickly when it stops responding,
+    /// while one whose durations vary a lot is given more time. The timeout
+    /// never goes below a minimum, so that short hiccups of the operating
+    /// system or of the network aren't mistaken for failures.
+    class GZ_SIM_VISIBLE TimeoutEstimator
+    {
+      /// \brief Convenience type alias for duration.
+      public: using Duration = std::chrono::steady_clock::duration;
+
+      /// \brief Set the timeout used before any duration is measured.
+      /// \param[in] _timeout Timeout.
+      public: void SetInitialTimeout(const Duration &_timeout);
+
+      /// \brief Set the lower bound of the timeout.
+      /// \param[in] _timeout Minimum timeout.
+      public: void SetMinTimeout(const Duration &_timeout);
+
+      /// \brief Set how many deviations above the average duration the
+      /// timeout is.
+      /// \param[in] _factor Factor, greater than zero.
+      public: void SetDeviationFactor(double _factor);
+
+      /// \brief Add a measured duration.
+      /// \param[in] _duration Duration.
+      public: void AddSample(const Duration &_duration);
+
+      /// \brief Number of durations measured since the last reset.
+      /// \return Number of samples.
+      public: std::size_t Samples() const;
+
+      /// \brief Get the current timeout.
+      /// \return The initial timeout if nothing was measured, otherwise the
+      /// average plus the deviation factor times the deviation, at least
+      /// the minimum timeout.
+      public: Duration Timeout() const;
+
+      /// \brief Discard all measurements.
+      public: void Reset();
+
+      /// \brief Moving average of the durations, in seconds.
+      private: double average{0.0};
+
+      /// \brief Moving average of the absolute difference between the
+      /// durations and their average, in seconds.
+      private: double deviation{0.0};
+
+      /// \brief Number of durations measured.
+      private: std::size_t samples{0u};
+
+      /// \brief Timeout before measurements.
+      private: Duration initialTimeout{std::chrono::seconds(10)};
+
+      /// \brief Lower bound of the timeout.
+      private: Duration minTimeout{Duration::zero()};
+
+      /// \brief Number of deviations above the average.
+      private: double deviationFactor{4.0};
+    };
+    }
+  }  // namespace sim
+}  // namespace gz
+
+#endif  // GZ_SIM_NETWORK_TIMEOUTESTIMATOR_HH_
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "TimeoutEstimator.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(TimeoutEstimator, InitialAndMinimum)
+{
+  TimeoutEstimator estimator;
+  estimator.SetInitialTimeout(5s);
+  estimator.SetMinTimeout(100ms);
+  EXPECT_EQ(0u, estimator.Samples());
+  EXPECT_EQ(5s, estimator.Timeout());
+
+  // 1 ms deviating by 0.5 ms is far below the minimum
+  estimator.AddSample(1ms);
+  EXPECT_EQ(1u, estimator.Samples());
+  EXPECT_EQ(100ms, estimator.Timeout());
+
+  estimator.Reset();
+  EXPECT_EQ(0u, estimator.Samples());
+  EXPECT_EQ(5s, estimator.Timeout());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeoutEstimator, AdaptToDeviation)
+{
+  TimeoutEstimator steady;
+  TimeoutEstimator jittery;
+  for (int i = 0; i < 100; ++i)
+  {
+    steady.AddSample(100ms);
+    jittery.AddSample(i % 2 == 0 ? 50ms : 150ms);
+  }
+
+  // Regular durations converge to their value
+  EXPECT_NEAR(0.1, std::chrono::duration<double>(steady.Timeout()).count(),
+      1e-3);
+
+  // Irregular ones with the same average leave a margin of 4 deviations
+  EXPECT_NEAR(0.3, std::chrono::duration<double>(jittery.Timeout()).count(),
+      0.02);
+
+  // A slower peer is given more time
+  const auto before = steady.Timeout();
+  steady.AddSample(1s);
+  EXPECT_LT(before, steady.Timeout());
+
+  jittery.SetDeviationFactor(1.0);
+  EXPECT_NEAR(0.15, std::chrono::duration<double>(jittery.Timeout()).count(),
+      0.02);
+
+  // Invalid factors are ignored
+  jittery.SetDeviationFactor(0.0);
+  EXPECT_NEAR(0.15, std::chrono::duration<double>(jittery.Timeout()).count(),
+      0.02);
+}
@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <gz/common/Image.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Scene.hh>
+
+#include "gz/sim/rendering/AssetCache.hh"
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Number of kinds of assets.
+constexpr std::size_t kAssetTypeCount{4u};
+
+/// \brief Names of the kinds of assets, for reports.
+constexpr std::array<const char *, kAssetTypeCount> kAssetTypeNames{
+    "meshes", "materials", "textures", "heightmaps"};
+
+/// \brief Key of an asset: the scene it belongs to, or nullptr for
+/// heightmaps, its kind and its description.
+using AssetKey = std::tuple<const rendering::Scene *, AssetType, std::string>;
+
+/// \brief An asset held by the cache.
+struct AssetEntry
+{
+  /// \brief Scene the asset belongs to, to detect assets of a scene that was
+  /// destroyed while another scene was created at the same address.
+  std::weak_ptr<rendering::Scene> scene;
+
+  /// \brief Number of references.
+  std::size_t refs{0u};
+
+  /// \brief Estimated memory in bytes.
+  std::size_t bytes{0u};
+
+  /// \brief False for textures whose memory wasn't estimated yet.
+  bool bytesKnown{true};
+
+  /// \brief The mesh, for meshes.
+  const common::Mesh *mesh{nullptr};
+
+  /// \brief The material, for materials.
+  rendering::MaterialPtr material;
+
+  /// \brief Paths of the textures of a material.
+  std::vector<std::string> textures;
+
+  /// \brief The data, for heightmaps.
+  std::shared_ptr<common::HeightmapData> heightmap;
+};
+
+/// \brief Get the paths of the textures used by a material.
+/// \param[in] _material The material.
+/// \return Paths of the textures, without empty ones.
+std::vector<std::string> materialTextures(
+    const rendering::MaterialPtr &_material)
+{
+  std::vector<std::string> textures;
+  for (const auto &texture : {_material->Texture(), _material->NormalMap(),
+      _material->RoughnessMap(), _material->MetalnessMap(),
+      _material->EnvironmentMap(), _material->EmissiveMap(),
+      _material->LightMap()})
+  {
+    if (!texture.empty())
+      textures.push_back(texture);
+  }
+  return textures;
+}
+
+/// \brief Estimate the GPU memory taken by a texture with its mipmaps.
+/// \param[in] _path Path of the image file.
+/// \return Bytes, or 0 if the image can't be loaded.
+std::size_t textureBytes(const std::string &_path)
+{
+  common::Image image;
+  if (image.Load(_path) != 0)
+    return 0u;
+  // RGBA texels, plus a third for the mipmaps
+  const std::size_t base = static_cast<std::size_t>(image.Width()) *
+      image.Height() * 4u;
+  return base + base / 3u;
+}
+}
+
+/// \brief Private data for AssetCache.
+class gz::sim::AssetCache::Implementation
+{
+  /// \brief Find a live asset, counting a hit and taking a reference if
+  /// it's found, or a miss otherwise. Assets of destroyed scenes are
+  /// dropped.
+  /// \param[in] _key Key of the asset.
+  /// \return The asset, or nullptr if it isn't held.
+  public: AssetEntry *Acquire(const AssetKey &_key);
+
+  /// \brief Add an asset with one reference, or take another reference to
+  /// it if it was already added.
+  /// \param[in] _scene Scene of the asset, or nullptr for heightmaps.
+  /// \param[in] _key Key of the asset.
+  /// \return The asset, and true if it's new.
+  public: std::pair<AssetEntry *, bool> Add(
+      const rendering::ScenePtr &_scene, const AssetKey &_key);
+
+  /// \brief Release a reference to an asset, dropping it after the last
+  /// one, along with its textures.
+  /// \param[in] _key Key of the asset.
+  public: void Release(const AssetKey &_key);
+
+  /// \brief Assets held by the cache.
+  public: mutable std::map<AssetKey, AssetEntry> entries;
+
+  /// \brief Number of hits per kind of asset.
+  public: std::array<std::size_t, kAssetTypeCount> hits{};
+
+  /// \brief Number of misses per kind of asset.
+  public: std::array<std::size_t, kAssetTypeCount> misses{};
+
+  /// \brief Protects all members.
+  public: mutable std::mutex mutex;
+};
+
+//////////////////////////////////////////////////
+AssetEntry *AssetCache::Implementation::Acquire(const AssetKey &_key)
+{
+  const auto type = static_cast<std::size_t>(std::get<1>(_key));
+  auto it = this->entries.find(_key);
+  if (it != this->entries.end() && nullptr != std::get<0>(_key) &&
+      it->second.scene.expired())
+  {
+    this->entries.erase(it);
+    it = this->entries.end();
+  }
+  if (it == this->entries.end())
+  {
+    ++this->misses[type];
+    return nullptr;
+  }
+  ++this->hits[type];
+  ++it->second.refs;
+  return &it->second;
+}
+
+//////////////////////////////////////////////////
+std::pair<AssetEntry *, bool> AssetCache::Implementation::Add(
+    const rendering::ScenePtr &_scene, const AssetKey &_key)
+{
+  auto [it, inserted] = this->entries.try_emplace(_key);
+  if (!inserted && _scene && it->second.scene.expired())
+  {
+    it->second = AssetEntry();
+    inserted = true;
+  }
+  if (inserted)
+    it->second.scene = _scene;
+  ++it->second.refs;
+  return {&it->second, inserted};
+}
+
+//////////////////////////////////////////////////
+void AssetCache::Implementation::Release(const AssetKey &_key)
+{
+  auto it = this->entries.find(_key);
+  if (it == this->entries.end())
+    return;
+  if (--it->second.refs > 0u)
+    return;
+
+  const auto textures = std::move(it->second.textures);
+  this->entries.erase(it);
+  for (const auto &texture : textures)
+  {
+    this->Release(
+        AssetKey(std::get<0>(_key), AssetType::TEXTURE, texture));
+  }
+}
+
+//////////////////////////////////////////////////
+AssetCache::AssetCache()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+AssetCache &AssetCache::Instance()
+{
+  static AssetCache cache;
+  return cache;
+}
+
+//////////////////////////////////////////////////
+const common::Mesh *AssetCache::AcquireMesh(
+    const rendering::ScenePtr &_scene, const std::string &_key)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto *entry = this->dataPtr->Acquire(
+      AssetKey(_scene.get(), AssetType::MESH, _key));
+  return nullptr == entry ? nullptr : entry->mesh;
+}
+
+//////////////////////////////////////////////////
+void AssetCache::AddMesh(const rendering::ScenePtr &_scene,
+    const std::string &_key, const common::Mesh *_mesh)
+{
+  if (nullptr == _mesh)
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto [entry, inserted] = this->dataPtr->Add(_scene,
+      AssetKey(_scene.get(), AssetType::MESH, _key));
+  if (!inserted)
+    return;
+  entry->mesh = _mesh;
+  // Positions and normals, texture coordinates and 32 bit indices
+  entry->bytes = _mesh->VertexCount() * 8u * sizeof(float) +
+      _mesh->IndexCount() * sizeof(std::uint32_t);
+}
+
+//////////////////////////////////////////////////
+rendering::MaterialPtr AssetCache::AcquireMaterial(
+    const rendering::ScenePtr &_scene, const std::string &_key)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto *entry = this->dataPtr->Acquire(
+      AssetKey(_scene.get(), AssetType::MATERIAL, _key));
+  return nullptr == entry ? nullptr : entry->material;
+}
+
+//////////////////////////////////////////////////
+void AssetCache::AddMaterial(const rendering::ScenePtr &_scene,
+    const std::string &_key, const rendering::MaterialPtr &_material)
+{
+  if (!_material)
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto [entry, inserted] = this->dataPtr->Add(_scene,
+      AssetKey(_scene.get(), AssetType::MATERIAL, _key));
+  if (!inserted)
+    return;
+  entry->material = _material;
+  entry->textures = materialTextures(_material);
+  for (const auto &texture : entry->textures)
+  {
+    const AssetKey textureKey(_scene.get(), AssetType::TEXTURE, texture);
+    if (nullptr == this->dataPtr->Acquire(textureKey))
+      this->dataPtr->Add(_scene, textureKey).first->bytesKnown = false;
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<common::HeightmapData> AssetCache::AcquireHeightmap(
+    const std::string &_key)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto *entry = this->dataPtr->Acquire(
+      AssetKey(nullptr, AssetType::HEIGHTMAP, _key));
+  return nullptr == entry ? nullptr : entry->heightmap;
+}
+
+//////////////////////////////////////////////////
+void AssetCache::AddHeightmap(const std::string &_key,
+    const std::shared_ptr<common::HeightmapData> &_data)
+{
+  if (!_data)
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto [entry, inserted] = this->dataPtr->Add(nullptr,
+      AssetKey(nullptr, AssetType::HEIGHTMAP, _key));
+  if (!inserted)
+    return;
+  entry->heightmap = _data;
+  entry->bytes = static_cast<std::size_t>(_data->Width()) *
+      _data->Height() * sizeof(float);
+}
+
+//////////////////////////////////////////////////
+void AssetCache::Release(const rendering::ScenePtr &_scene, AssetType _type,
+    const std::string &_key)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Release(AssetKey(
+      _type == AssetType::HEIGHTMAP ? nullptr : _scene.get(), _type, _key));
+}
+
+//////////////////////////////////////////////////
+AssetCacheStats AssetCache::Stats(AssetType _type) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const auto type = static_cast<std::size_t>(_type);
+  AssetCacheStats stats;
+  stats.hits = this->dataPtr->hits[type];
+  stats.misses = this->dataPtr->misses[type];
+  for (auto &[key, entry] : this->dataPtr->entries)
+  {
+    if (std::get<1>(key) != _type)
+      continue;
+    if (!entry.bytesKnown)
+    {
+      entry.bytes = textureBytes(std::get<2>(key));
+      entry.bytesKnown = true;
+    }
+    ++stats.entries;
+    stats.bytes += entry.bytes;
+  }
+  return stats;
+}
+
+//////////////////////////////////////////////////
+std::string AssetCache::Report() const
+{
+  std::ostringstream report;
+  report << std::fixed << std::setprecision(1);
+  for (std::size_t type = 0u; type < kAssetTypeCount; ++type)
+  {
+    const auto stats = this->Stats(static_cast<AssetType>(type));
+    report << kAssetTypeNames[type] << ": " << stats.entries << " held, "
+           << stats.hits << " hits, " << stats.misses << " misses ("
+           << stats.HitRate() * 100.0 << "% hit rate), "
+           << stats.bytes / (1024.0 * 1024.0) << " MiB\n";
+  }
+  return report.str();
+}
+
+//////////////////////////////////////////////////
+void AssetCache::ResetStats()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->hits.fill(0u);
+  this->dataPtr->misses.fill(0u);
+}
@@ -20,6 +20,9 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/marker.pb.h>
@@ -44,9 +47,50 @@
 using namespace gz;
 using namespace sim;
 
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Merge a marker message into an older message for the same marker
+/// that hasn't been processed yet, so that processing the result has the
+/// same effect as processing both.
+/// \param[in] _newer The newer message.
+/// \param[in,out] _pending The older message.
+void mergeMarker(const msgs::Marker &_newer, msgs::Marker &_pending)
+{
+  // These are replaced as a whole when present
+  if (_newer.has_pose())
+    _pending.clear_pose();
+  if (_newer.has_scale())
+    _pending.clear_scale();
+  if (_newer.has_material())
+    _pending.clear_material();
+  if (_newer.point_size() > 0)
+    _pending.clear_point();
+
+  _pending.MergeFrom(_newer);
+
+  // These are always applied, even when unset
+  _pending.set_layer(_newer.layer());
+  if (_newer.has_lifetime())
+    _pending.mutable_lifetime()->CopyFrom(_newer.lifetime());
+  else
+    _pending.clear_lifetime();
+}
+}
+
 /// Private data for the MarkerManager class
 class gz::sim::MarkerManagerPrivate
 {
+  /// \brief Points of a marker, kept to update them in place.
+  public: struct MarkerPoints
+  {
+    /// \brief Positions of the points.
+    std::vector<math::Vector3d> positions;
+
+    /// \brief Color of the points.
+    math::Color color;
+  };
+
   /// \brief Processes a marker message.
   /// \param[in] _msg The message data.
   /// \return True if the marker was processed successfully.
@@ -100,6 +144,15 @@ class gz::sim::MarkerManagerPrivate
   /// \param[in] _time The time data.
   public: void SetSimTime(const std::chrono::steady_clock::duration &_time);
 
+  /// \brief Queue a marker message, merging it into the queued update of
+  /// the same marker if there's one.
+  /// \param[in] _msg The message data.
+  public: void QueueMarkerMsg(const msgs::Marker &_msg);
+
+  /// \brief Destroy a marker visual.
+  /// \param[in] _visualPtr The visual.
+  public: void DestroyMarkerVisual(const rendering::VisualPtr &_visualPtr);
+
   /// \brief Previous sim time received
   public: std::chrono::steady_clock::duration lastSimTime;
 
@@ -113,6 +166,15 @@ class gz::sim::MarkerManagerPrivate
   /// \brief List of marker message to process.
   public: std::list<msgs::Marker> markerMsgs;
 
+  /// \brief Queued ADD_MODIFY messages by namespace and id. Clients like
+  /// sensor visualizations send a full update every frame, so only the
+  /// latest one needs to be processed.
+  public: std::map<std::pair<std::string, uint64_t>,
+      std::list<msgs::Marker>::iterator> queuedUpdates;
+
+  /// \brief Points of the markers, by marker id.
+  public: std::unordered_map<unsigned int, MarkerPoints> markerPoints;
+
   /// \brief Pointer to the scene
   public: rendering::ScenePtr scene;
 
@@ -232,6 +294,7 @@ void MarkerManagerPrivate::Update()
     this->markerPub.Publish(*markerIter);
     this->markerMsgs.erase(markerIter++);
   }
+  this->queuedUpdates.clear();
 
 
   // Erase any markers that have a lifetime.
@@ -253,7 +316,7 @@ void MarkerManagerPrivate::Update()
             (markerPtr->Lifetime() <= simTime ||
             this->simTime < this->lastSimTime))
         {
-          this->scene->DestroyVisual(it->second);
+          this->DestroyMarkerVisual(it->second);
           it = mit->second.erase(it);
           break;
         }
@@ -347,11 +410,9 @@ void MarkerManagerPrivate::SetMarker(const msgs::Marker &_msg,
     this->scene->DestroyMaterial(materialPtr);
   }
 
-  // Assume the presence of points means we clear old ones
-  if (_msg.point().size() > 0)
-  {
-    _markerPtr->ClearPoints();
-  }
+  // Assume the presence of points means we replace old ones
+  if (_msg.point().size() == 0)
+    return;
 
   math::Color color(
       _msg.material().diffuse().r(),
@@ -359,16 +420,106 @@ void MarkerManagerPrivate::SetMarker(const msgs::Marker &_msg,
       _msg.material().diffuse().b(),
       _msg.material().diffuse().a());
 
+  // Markers that keep the same number of points and color, like sensor
+  // visualizations that are updated every frame, move their vertices in
+  // place instead of rebuilding their geometry. Markers that only get new
+  // points at their end, like plotted trajectories, only add those.
+  auto &points = this->markerPoints[_markerPtr->Id()];
+  auto &positions = points.positions;
+  const auto count = static_cast<std::size_t>(_msg.point().size());
+  auto position = [&_msg](std::size_t _index)
+  {
+    const auto &point = _msg.point(static_cast<int>(_index));
+    return math::Vector3d(point.x(), point.y(), point.z());
+  };
+
+  const bool sameColor = !positions.empty() && points.color == color;
+  const bool inPlace = sameColor && positions.size() == count;
+  bool append = sameColor && positions.size() < count;
+  for (std::size_t i = 0u; append && i < positions.size(); ++i)
+    append = position(i) == positions[i];
+
+  if (inPlace)
+  {
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+      const auto vector = position(i);
+      if (vector == positions[i])
+        continue;
+      _markerPtr->SetPoint(static_cast<unsigned int>(i), vector);
+      positions[i] = vector;
+    }
+    return;
+  }
+
+  if (!append)
+  {
+    _markerPtr->ClearPoints();
+    positions.clear();
+    points.color = color;
+  }
+
   // Set Marker Points
-  for (int i = 0; i < _msg.point().size(); ++i)
+  positions.reserve(count);
+  for (std::size_t i = positions.size(); i < count; ++i)
   {
-    math::Vector3d vector(
-        _msg.point(i).x(),
-        _msg.point(i).y(),
-        _msg.point(i).z());
+    positions.push_back(position(i));
+    _markerPtr->AddPoint(positions.back(), color);
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::DestroyMarkerVisual(
+    const rendering::VisualPtr &_visualPtr)
+{
+  for (unsigned int i = 0; i < _visualPtr->GeometryCount(); ++i)
+    this->markerPoints.erase(_visualPtr->GeometryByIndex(i)->Id());
+  this->scene->DestroyVisual(_visualPtr);
+}
 
-    _markerPtr->AddPoint(vector, color);
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::QueueMarkerMsg(const msgs::Marker &_msg)
+{
+  const std::string &ns = _msg.ns();
+  if (_msg.action() == msgs::Marker::ADD_MODIFY)
+  {
+    // Markers without an id get a new one each time, so they're never
+    // merged
+    if (_msg.id() == 0)
+    {
+      this->markerMsgs.push_back(_msg);
+      return;
+    }
+
+    auto key = std::make_pair(ns, _msg.id());
+    auto queued = this->queuedUpdates.find(key);
+    if (queued != this->queuedUpdates.end())
+    {
+      mergeMarker(_msg, *queued->second);
+      return;
+    }
+    this->queuedUpdates[key] =
+        this->markerMsgs.insert(this->markerMsgs.end(), _msg);
+    return;
+  }
+
+  // Updates queued before a deletion must be processed before it
+  if (_msg.action() == msgs::Marker::DELETE_MARKER)
+  {
+    this->queuedUpdates.erase(std::make_pair(ns, _msg.id()));
+  }
+  else if (_msg.action() == msgs::Marker::DELETE_ALL)
+  {
+    for (auto it = this->queuedUpdates.begin();
+         it != this->queuedUpdates.end();)
+    {
+      if (ns.empty() || it->first.first == ns)
+        it = this->queuedUpdates.erase(it);
+      else
+        ++it;
+    }
   }
+  this->markerMsgs.push_back(_msg);
 }
 
 /////////////////////////////////////////////////
@@ -549,7 +700,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const msgs::Marker &_msg)
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
     {
-      this->scene->DestroyVisual(visualIter->second);
+      this->DestroyMarkerVisual(visualIter->second);
       this->visuals[ns].erase(visualIter);
 
       // Remove namespace if empty
@@ -578,7 +729,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const msgs::Marker &_msg)
     {
       for (auto it : nsIter->second)
       {
-        this->scene->DestroyVisual(it.second);
+        this->DestroyMarkerVisual(it.second);
       }
       nsIter->second.clear();
       this->visuals.erase(nsIter);
@@ -591,7 +742,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const msgs::Marker &_msg)
       {
         for (auto it : nsIter->second)
         {
-          this->scene->DestroyVisual(it.second);
+          this->DestroyMarkerVisual(it.second);
         }
       }
       this->visuals.clear();
@@ -631,7 +782,7 @@ bool MarkerManagerPrivate::OnList(msgs::Marker_V &_rep)
 void MarkerManagerPrivate::OnMarkerMsg(const msgs::Marker &_req)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->markerMsgs.push_back(_req);
+  this->QueueMarkerMsg(_req);
 }
 
 /////////////////////////////////////////////////
@@ -639,8 +790,8 @@ bool MarkerManagerPrivate::OnMarkerMsgArray(
     const msgs::Marker_V&_req, msgs::Boolean &_res)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_req.marker().begin(), _req.marker().end(),
-            std::back_inserter(this->markerMsgs));
+  for (const auto &marker : _req.marker())
+    this->QueueMarkerMsg(marker);
   _res.set_data(true);
   return true;
 }
@@ -650,5 +801,7 @@ void MarkerManager::Clear()
 {
   this->dataPtr->visuals.clear();
   this->dataPtr->markerMsgs.clear();
+  this->dataPtr->queuedUpdates.clear();
+  this->dataPtr->markerPoints.clear();
   this->dataPtr->scene.reset();
 }
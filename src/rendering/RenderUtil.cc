@@ -15,11 +15,18 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <set>
 #include <stack>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -39,6 +46,7 @@
 #include <gz/common/Skeleton.hh>
 #include <gz/common/SkeletonAnimation.hh>
 
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Matrix4.hh>
@@ -46,6 +54,7 @@
 
 #include <gz/msgs/Utility.hh>
 
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Grid.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
@@ -134,6 +143,83 @@ class gz::sim::RenderUtilPrivate
   public: void CreateEntitiesRuntime(const EntityComponentManager &_ecm,
       const UpdateInfo &_info);
 
+  /// \brief Entities that are created in the same update, because they
+  /// belong to the same top level entity, such as a model and its links,
+  /// visuals and sensors. The elements of the tuples are the same as those
+  /// of the new entity lists, such as newModels.
+  public: struct CreationGroup
+  {
+    /// \brief Entity at the top of the group.
+    Entity root{kNullEntity};
+
+    /// \brief World position of the root entity, used to prioritize the
+    /// group.
+    math::Vector3d position;
+
+    /// \brief True if the group was kept for a later update.
+    bool deferred{false};
+
+    /// \brief New models.
+    std::vector<std::tuple<Entity, sdf::Model, Entity, uint64_t>> models;
+
+    /// \brief New links.
+    std::vector<std::tuple<Entity, sdf::Link, Entity>> links;
+
+    /// \brief New visuals.
+    std::vector<std::tuple<Entity, sdf::Visual, Entity>> visuals;
+
+    /// \brief New actors.
+    std::vector<std::tuple<Entity, sdf::Actor, std::string, Entity>> actors;
+
+    /// \brief New lights.
+    std::vector<std::tuple<Entity, sdf::Light, std::string, Entity>> lights;
+
+    /// \brief New particle emitters.
+    std::vector<std::tuple<Entity, msgs::ParticleEmitter, Entity>>
+        particleEmitters;
+
+    /// \brief New projectors.
+    std::vector<std::tuple<Entity, sdf::Projector, Entity>> projectors;
+
+    /// \brief New sensors.
+    std::vector<std::tuple<Entity, sdf::Sensor, Entity>> sensors;
+  };
+
+  /// \brief Create the entities of a group in the scene, parents first.
+  /// \param[in] _group Entities to create.
+  /// \param[in] _removeEntities Entities removed in this update, with the
+  /// iteration of the removal. Models created before they were removed
+  /// are skipped.
+  public: void CreateEntities(const CreationGroup &_group,
+      const std::unordered_map<Entity, uint64_t> &_removeEntities);
+
+  /// \brief Split new entities into groups, and create the groups in order
+  /// of priority until creationBudget is used. The remaining groups are
+  /// kept in deferredGroups for the next updates. Groups with sensors are
+  /// created first, and then those nearest to the sensors in the scene,
+  /// such as the GUI camera, or to the groups with sensors.
+  /// \param[in] _new New entities of this update.
+  /// \param[in] _removeEntities Entities removed in this update, with the
+  /// iteration of the removal. They're also dropped from the deferred
+  /// groups.
+  public: void CreateEntitiesBudgeted(CreationGroup &&_new,
+      const std::unordered_map<Entity, uint64_t> &_removeEntities);
+
+  /// \brief Time each update may spend creating entities. Zero or less
+  /// creates all of them in the same update.
+  /// \sa RenderUtil::SetCreationTimeBudget
+  public: std::chrono::steady_clock::duration creationBudget{0};
+
+  /// \brief Entities waiting to be created. Key: root entity of the group.
+  public: std::map<Entity, CreationGroup> deferredGroups;
+
+  /// \brief Root of the deferred group of each entity waiting to be
+  /// created.
+  public: std::unordered_map<Entity, Entity> deferredRoots;
+
+  /// \brief Number of sensors in deferredGroups.
+  public: std::atomic<int> deferredSensors{0};
+
   /// \brief Remove rendering entities
   /// \param[in] _ecm The entity-component manager
   public: void RemoveRenderingEntities(const EntityComponentManager &_ecm,
@@ -143,6 +229,15 @@ class gz::sim::RenderUtilPrivate
   /// \param[in] _ecm The entity-component manager
   public: void UpdateRenderingEntities(const EntityComponentManager &_ecm);
 
+  /// \brief Copy the poses of all entities that are rendered, except actors
+  /// \param[in] _ecm The entity-component manager
+  public: void UpdateAllPoses(const EntityComponentManager &_ecm);
+
+  /// \brief Copy the poses of the entities that are rendered, except actors,
+  /// whose pose changed since the last simulation step
+  /// \param[in] _ecm The entity-component manager
+  public: void UpdateChangedPoses(const EntityComponentManager &_ecm);
+
   /// \breif Helper function to add new sensors
   /// \param[in] _ecm The entity-component manager
   /// \param[in] _entity Sensor entity
@@ -358,9 +453,32 @@ class gz::sim::RenderUtilPrivate
   /// All temperatures are in Kelvin.
   public: std::map<Entity, std::tuple<float, float, std::string>> entityTemp;
 
+  /// \brief Copy the temperatures of the visuals whose Temperature,
+  /// TemperatureRange or heat signature changed since temperatureVersion
+  /// to entityTemp. Visual temperatures are set once for all thermal
+  /// cameras, and only when they change.
+  /// \param[in] _ecm The entity-component manager
+  public: void UpdateTemperatures(const EntityComponentManager &_ecm);
+
+  /// \brief ECM version stamp of the last call to UpdateTemperatures.
+  public: std::uint64_t temperatureVersion{0u};
+
+  /// \brief ECM version stamp of the last look for thermal camera
+  /// properties set by the thermal sensor plugin.
+  public: std::uint64_t thermalCameraVersion{0u};
+
   /// \brief A map of entity ids and label data for datasets annotations
   public: std::unordered_map<Entity, int> entityLabel;
 
+  /// \brief Copy the labels of the visuals and actors whose SemanticLabel
+  /// changed since labelVersion to entityLabel, so the table of labels is
+  /// only sent to the rendering thread when it changes.
+  /// \param[in] _ecm The entity-component manager
+  public: void UpdateLabels(const EntityComponentManager &_ecm);
+
+  /// \brief ECM version stamp of the last call to UpdateLabels.
+  public: std::uint64_t labelVersion{0u};
+
   /// \brief A map of entity ids and wire boxes
   public: std::unordered_map<Entity, gz::rendering::WireBoxPtr> wireBoxes;
 
@@ -387,6 +505,82 @@ class gz::sim::RenderUtilPrivate
   //// \brief Flag to indicate whether to create sensors
   public: bool enableSensors = false;
 
+  /// \brief True to only copy the poses that changed in the ECM
+  /// \sa RenderUtil::SetIncrementalPoseUpdates
+  public: bool incrementalPoseUpdates = false;
+
+  /// \brief True to copy the poses of all entities on the next update, even
+  /// if incrementalPoseUpdates is true
+  public: bool fullPoseUpdate = true;
+
+  /// \brief Top level visuals farther than this from every rendering sensor
+  /// are hidden. Zero or less disables culling.
+  /// \sa RenderUtil::SetSensorCullingDistance
+  public: double cullingDistance = 0.0;
+
+  /// \brief Bounding radius of top level visuals around their origin, and
+  /// the scale of the visual when it was computed. It's cleared when
+  /// visuals are created or removed, since that changes the geometry of
+  /// top level visuals, and recomputed when the scale changes.
+  /// Key: rendering visual id.
+  public: std::unordered_map<unsigned int, std::pair<double, math::Vector3d>>
+      visualRadii;
+
+  /// \brief Rendering ids of the top level visuals hidden by culling
+  public: std::unordered_set<unsigned int> culledVisuals;
+
+  /// \brief Rendering ids of the visuals hidden through
+  /// RenderUtil::SetEntityVisible. Culling doesn't show them again.
+  public: std::unordered_set<unsigned int> hiddenVisuals;
+
+  /// \brief Hide the top level visuals that are out of range of every
+  /// rendering sensor, and show the culled ones that came back in range.
+  public: void CullDistantVisuals();
+
+  /// \brief Get the bounding radius of a visual around its origin, which is
+  /// cached in visualRadii.
+  /// \param[in] _vis Visual.
+  /// \param[out] _radius Bounding radius.
+  /// \return False if the visual has no geometry yet.
+  public: bool VisualRadius(const rendering::VisualPtr &_vis,
+              double &_radius);
+
+  /// \brief True to only update the skeleton animation of actors that
+  /// could be seen by a camera.
+  /// \sa RenderUtil::SetActorAnimationCulling
+  public: bool actorAnimationCulling = false;
+
+  /// \brief Cone bounding the view frustum of a camera.
+  public: struct CameraView
+  {
+    /// \brief World position of the camera.
+    math::Vector3d position;
+
+    /// \brief Unit vector along the view direction in the world frame.
+    math::Vector3d direction;
+
+    /// \brief Half angle of the cone around the view direction [rad].
+    double halfAngle;
+
+    /// \brief Far clip distance [m].
+    double farClip;
+  };
+
+  /// \brief Get the views of all the cameras in the scene, for actor
+  /// animation culling.
+  /// \param[out] _views Views of the cameras.
+  /// \return False if all actors must be animated, because there are no
+  /// cameras, or there are rendering sensors which aren't cameras, or
+  /// cameras whose view can't be bounded by a cone.
+  public: bool CameraViews(std::vector<CameraView> &_views) const;
+
+  /// \brief Check if an actor could be seen by any of the cameras.
+  /// \param[in] _actor Actor visual, after its pose was updated.
+  /// \param[in] _views Views of the cameras.
+  /// \return True if the actor's bounding sphere intersects any view.
+  public: bool ActorInView(const rendering::NodePtr &_actor,
+              const std::vector<CameraView> &_views);
+
   /// \brief A set containing all the entities with attached rendering sensors
   public: std::unordered_set<Entity> sensorEntities;
 
@@ -580,7 +774,8 @@ class gz::sim::RenderUtilPrivate
   public: std::unordered_map<Entity,
       std::tuple<double, components::TemperatureRangeInfo>> thermalCameraData;
 
-  /// \brief Update the visuals with label user data
+  /// \brief Update the visuals with label user data. Labels of visuals
+  /// waiting to be created are kept for a later update.
   /// \param[in] _entityLabel Map with key visual entity id and value label
   public: void UpdateVisualLabels(
     const std::unordered_map<Entity, int> &_entityLabel);
@@ -706,46 +901,59 @@ void RenderUtil::UpdateECM(const UpdateInfo &/*_info*/,
     _ecm.RemoveComponent<components::LightCmd>(entity);
   }
 
-  // Update thermal cameras
-  _ecm.Each<components::ThermalCamera>(
-      [&](const Entity &_entity,
-        const components::ThermalCamera *)->bool
-      {
-        // set properties from thermal sensor plugin
-        // Set defaults to invaid values so we know they have not been set.
-        // set UpdateECM(). We check for valid values first before setting
-        // these thermal camera properties..
-        double resolution = 0.0;
-        components::TemperatureRangeInfo range;
-        range.min = std::numeric_limits<double>::max();
-        range.max = 0;
-
-        // resolution
-        auto resolutionComp =
-          _ecm.Component<components::TemperatureLinearResolution>(_entity);
-        if (resolutionComp != nullptr)
-        {
-          resolution = resolutionComp->Data();
-          _ecm.RemoveComponent<components::TemperatureLinearResolution>(
-              _entity);
-        }
+  // Update thermal cameras whose properties were set by the thermal sensor
+  // plugin since the last look, instead of checking all of them every time
+  std::set<Entity> thermalCameras;
+  for (const auto typeId : {components::TemperatureLinearResolution::typeId,
+      components::TemperatureRange::typeId})
+  {
+    for (const auto entity : _ecm.EntitiesChangedSince(
+        this->dataPtr->thermalCameraVersion, typeId))
+    {
+      if (_ecm.EntityHasComponentType(entity,
+          components::ThermalCamera::typeId))
+      {
+        thermalCameras.insert(entity);
+      }
+    }
+  }
+  this->dataPtr->thermalCameraVersion = _ecm.ChangeVersion();
+  for (const auto entity : thermalCameras)
+  {
+    // set properties from thermal sensor plugin
+    // Set defaults to invaid values so we know they have not been set.
+    // set UpdateECM(). We check for valid values first before setting
+    // these thermal camera properties..
+    double resolution = 0.0;
+    components::TemperatureRangeInfo range;
+    range.min = std::numeric_limits<double>::max();
+    range.max = 0;
+
+    // resolution
+    auto resolutionComp =
+      _ecm.Component<components::TemperatureLinearResolution>(entity);
+    if (resolutionComp != nullptr)
+    {
+      resolution = resolutionComp->Data();
+      _ecm.RemoveComponent<components::TemperatureLinearResolution>(
+          entity);
+    }
 
-        // min / max temp
-        auto tempRangeComp =
-          _ecm.Component<components::TemperatureRange>(_entity);
-        if (tempRangeComp != nullptr)
-        {
-          range = tempRangeComp->Data();
-          _ecm.RemoveComponent<components::TemperatureRange>(_entity);
-        }
+    // min / max temp
+    auto tempRangeComp =
+      _ecm.Component<components::TemperatureRange>(entity);
+    if (tempRangeComp != nullptr)
+    {
+      range = tempRangeComp->Data();
+      _ecm.RemoveComponent<components::TemperatureRange>(entity);
+    }
 
-        if (resolutionComp || tempRangeComp)
-        {
-          this->dataPtr->thermalCameraData[_entity] =
-              std::make_tuple(resolution, range);
-        }
-        return true;
-      });
+    if (resolutionComp || tempRangeComp)
+    {
+      this->dataPtr->thermalCameraData[entity] =
+          std::make_tuple(resolution, range);
+    }
+  }
 
   // visual commands
   {
@@ -818,6 +1026,9 @@ void RenderUtil::UpdateFromECM(const UpdateInfo &_info,
 {
   GZ_PROFILE("RenderUtil::UpdateFromECM");
   std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+  // Poses may jump back without being marked as changed, such as on reset
+  if (_info.simTime < this->dataPtr->simTime)
+    this->dataPtr->fullPoseUpdate = true;
   this->dataPtr->simTime = _info.simTime;
 
   this->dataPtr->CreateRenderingEntities(_ecm, _info);
@@ -1081,7 +1292,7 @@ int RenderUtil::PendingSensors() const
   this->dataPtr->updateMutex.lock();
   int nSensors = this->dataPtr->newSensors.size();
   this->dataPtr->updateMutex.unlock();
-  return nSensors;
+  return nSensors + this->dataPtr->deferredSensors;
 }
 
 //////////////////////////////////////////////////
@@ -1108,6 +1319,10 @@ void RenderUtil::Update()
     std::move(this->dataPtr->newParticleEmittersCmds);
   auto newProjectors = std::move(this->dataPtr->newProjectors);
   auto removeEntities = std::move(this->dataPtr->removeEntities);
+  // Created and removed visuals change the bounds of top level visuals
+  const bool visualsChanged = !newModels.empty() || !newLinks.empty() ||
+      !newVisuals.empty() || !removeEntities.empty() ||
+      !this->dataPtr->deferredGroups.empty();
   auto entityPoses = std::move(this->dataPtr->entityPoses);
   auto entityLights = std::move(this->dataPtr->entityLights);
   auto entityVisuals = std::move(this->dataPtr->entityVisuals);
@@ -1210,75 +1425,24 @@ void RenderUtil::Update()
   // create new entities
   {
     GZ_PROFILE("RenderUtil::Update Create");
-    for (const auto &model : newModels)
-    {
-      uint64_t iteration = std::get<3>(model);
-      Entity entityId = std::get<0>(model);
-      // since entites to be created and removed are queued, we need
-      // to check their creation timestamp to make sure we do not create a new
-      // entity when there is also a remove request with a more recent
-      // timestamp
-      // \todo(anyone) add test to check scene entities are properly added
-      // and removed.
-      auto removeIt = removeEntities.find(entityId);
-      if (removeIt != removeEntities.end())
-      {
-        uint64_t removeIteration = removeIt->second;
-        if (iteration < removeIteration)
-          continue;
-      }
-      this->dataPtr->sceneManager.CreateModel(
-          entityId, std::get<1>(model), std::get<2>(model));
-    }
-
-    for (const auto &actor : newActors)
-    {
-      this->dataPtr->sceneManager.CreateActor(
-          std::get<0>(actor), std::get<1>(actor), std::get<2>(actor),
-          std::get<3>(actor));
-    }
-
-    for (const auto &link : newLinks)
-    {
-      this->dataPtr->sceneManager.CreateLink(
-          std::get<0>(link), std::get<1>(link), std::get<2>(link));
-    }
-
-    for (const auto &visual : newVisuals)
+    RenderUtilPrivate::CreationGroup newEntities;
+    newEntities.models = std::move(newModels);
+    newEntities.links = std::move(newLinks);
+    newEntities.visuals = std::move(newVisuals);
+    newEntities.actors = std::move(newActors);
+    newEntities.lights = std::move(newLights);
+    newEntities.particleEmitters = std::move(newParticleEmitters);
+    newEntities.projectors = std::move(newProjectors);
+    newEntities.sensors = std::move(newSensors);
+    if (this->dataPtr->creationBudget <= std::chrono::steady_clock::duration(0)
+        && this->dataPtr->deferredGroups.empty())
     {
-      this->dataPtr->sceneManager.CreateVisual(
-          std::get<0>(visual), std::get<1>(visual), std::get<2>(visual));
-    }
-
-    for (const auto &light : newLights)
-    {
-      auto newLightRendering = this->dataPtr->sceneManager.CreateLight(
-        std::get<0>(light),
-        std::get<1>(light),
-        std::get<2>(light),
-        std::get<3>(light));
-
-      if (newLightRendering)
-      {
-        rendering::VisualPtr lightVisual =
-          this->dataPtr->sceneManager.CreateLightVisual(
-            std::get<0>(light) + 1,
-            std::get<1>(light),
-            std::get<2>(light),
-            std::get<0>(light));
-        this->dataPtr->matchLightWithVisuals[std::get<0>(light)] =
-          std::get<0>(light) + 1;
-      }
-      else
-      {
-        gzerr << "Failed to create light" << std::endl;
-      }
+      this->dataPtr->CreateEntities(newEntities, removeEntities);
     }
-
-    for (const auto &emitter : newParticleEmitters)
+    else
     {
-      this->dataPtr->sceneManager.CreateParticleEmitter(
-          std::get<0>(emitter), std::get<1>(emitter), std::get<2>(emitter));
+      this->dataPtr->CreateEntitiesBudgeted(std::move(newEntities),
+          removeEntities);
     }
 
     for (const auto &emitterCmd : newParticleEmittersCmds)
@@ -1286,45 +1450,6 @@ void RenderUtil::Update()
       this->dataPtr->sceneManager.UpdateParticleEmitter(
           emitterCmd.first, emitterCmd.second);
     }
-
-    for (const auto &projector : newProjectors)
-    {
-      this->dataPtr->sceneManager.CreateProjector(
-          std::get<0>(projector), std::get<1>(projector),
-          std::get<2>(projector));
-    }
-
-    if (this->dataPtr->enableSensors && this->dataPtr->createSensorCb)
-    {
-      for (const auto &sensor : newSensors)
-      {
-        Entity entity = std::get<0>(sensor);
-        const sdf::Sensor &dataSdf = std::get<1>(sensor);
-        Entity parent = std::get<2>(sensor);
-
-        // two sensors with the same name cause conflicts. We'll need to use
-        // scoped names
-        // TODO(anyone) do this in gz-sensors?
-        auto parentNode = this->dataPtr->sceneManager.NodeById(parent);
-        if (!parentNode)
-        {
-          gzerr << "Failed to create sensor with name[" << dataSdf.Name()
-                 << "] for entity [" << entity
-                 << "]. Parent not found with ID[" << parent << "]."
-                 << std::endl;
-          continue;
-        }
-
-        std::string sensorName =
-            this->dataPtr->createSensorCb(entity, dataSdf, parentNode->Name());
-        // Add to the system's scene manager
-        if (!this->dataPtr->sceneManager.AddSensor(entity, sensorName, parent))
-        {
-          gzerr << "Failed to create sensor [" << sensorName << "]"
-                 << std::endl;
-        }
-      }
-    }
   }
 
   this->dataPtr->UpdateLights(entityLights);
@@ -1366,6 +1491,9 @@ void RenderUtil::Update()
     // update entities' local transformations
     if (this->dataPtr->actorManualSkeletonUpdate)
     {
+      std::vector<RenderUtilPrivate::CameraView> views;
+      bool cullActors = this->dataPtr->actorAnimationCulling &&
+          !actorTransforms.empty() && this->dataPtr->CameraViews(views);
       for (auto &tf : actorTransforms)
       {
         auto actorMesh = this->dataPtr->sceneManager.ActorMeshById(tf.first);
@@ -1405,8 +1533,11 @@ void RenderUtil::Update()
         }
 
         tf.second.erase("actorPose");
-        if (actorMesh)
+        if (actorMesh &&
+            (!cullActors || this->dataPtr->ActorInView(actorVisual, views)))
+        {
           actorMesh->SetSkeletonLocalTransforms(tf.second);
+        }
       }
     }
     else
@@ -1417,11 +1548,21 @@ void RenderUtil::Update()
   }
 
   // set visual temperature
+  std::vector<std::pair<Entity, std::tuple<float, float, std::string>>>
+      deferredTemp;
   for (const auto &temp : entityTemp)
   {
     auto node = this->dataPtr->sceneManager.NodeById(temp.first);
     if (!node)
+    {
+      // Visuals waiting to be created get their temperature once they are
+      if (this->dataPtr->deferredRoots.find(temp.first) !=
+          this->dataPtr->deferredRoots.end())
+      {
+        deferredTemp.push_back(temp);
+      }
       continue;
+    }
 
     auto visual = std::dynamic_pointer_cast<rendering::Visual>(node);
     if (!visual)
@@ -1438,6 +1579,13 @@ void RenderUtil::Update()
     }
   }
 
+  if (!deferredTemp.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+    for (auto &temp : deferredTemp)
+      this->dataPtr->entityTemp.emplace(std::move(temp));
+  }
+
   this->dataPtr->UpdateVisualLabels(entityLabel);
 
   // update joint parent visual poses
@@ -1637,6 +1785,13 @@ void RenderUtil::Update()
           if (!geomMat)
             continue;
 
+          // Give the visual its own copy before changing a shared material
+          if (this->dataPtr->sceneManager.IsSharedMaterial(geomMat))
+          {
+            geom->SetMaterial(geomMat);
+            geomMat = geom->Material();
+          }
+
           math::Color color;
           if (matMsg.has_ambient())
           {
@@ -1670,10 +1825,491 @@ void RenderUtil::Update()
     }
   }
 
+  if (visualsChanged)
+    this->dataPtr->visualRadii.clear();
+  this->dataPtr->CullDistantVisuals();
+
   if (this->dataPtr->eventManager)
     this->dataPtr->eventManager->Emit<events::SceneUpdate>();
 }
 
+//////////////////////////////////////////////////
+void RenderUtilPrivate::CullDistantVisuals()
+{
+  if (!this->scene || (this->cullingDistance <= 0.0 &&
+      this->culledVisuals.empty()))
+  {
+    return;
+  }
+
+  GZ_PROFILE("RenderUtilPrivate::CullDistantVisuals");
+
+  // Range of each sensor, which is never farther than what it can see
+  std::vector<std::pair<math::Vector3d, double>> sensorRanges;
+  if (this->cullingDistance > 0.0)
+  {
+    for (const auto &entity : this->sensorEntities)
+    {
+      auto node = this->sceneManager.NodeById(entity);
+      if (!node)
+        continue;
+
+      double range = this->cullingDistance;
+      auto camera = std::dynamic_pointer_cast<rendering::Camera>(node);
+      if (camera)
+        range = std::min(range, camera->FarClipPlane());
+      sensorRanges.emplace_back(node->WorldPosition(), range);
+    }
+  }
+
+  auto root = this->scene->RootVisual();
+  for (unsigned int i = 0; i < root->ChildCount(); ++i)
+  {
+    auto vis = std::dynamic_pointer_cast<rendering::Visual>(
+        root->ChildByIndex(i));
+    if (!vis)
+      continue;
+
+    bool inRange = true;
+    if (!sensorRanges.empty())
+    {
+      // Visuals without geometry yet are never culled
+      double radius;
+      if (!this->VisualRadius(vis, radius))
+        continue;
+
+      auto position = vis->WorldPosition();
+      inRange = std::any_of(sensorRanges.begin(), sensorRanges.end(),
+          [&](const std::pair<math::Vector3d, double> &_sensor)
+          {
+            return position.Distance(_sensor.first) - radius <=
+                _sensor.second;
+          });
+    }
+
+    auto culledIt = this->culledVisuals.find(vis->Id());
+    if (inRange && culledIt != this->culledVisuals.end())
+    {
+      // Visuals that were hidden explicitly stay hidden
+      if (this->hiddenVisuals.find(vis->Id()) == this->hiddenVisuals.end())
+        vis->SetVisible(true);
+      this->culledVisuals.erase(culledIt);
+    }
+    else if (!inRange && culledIt == this->culledVisuals.end())
+    {
+      vis->SetVisible(false);
+      this->culledVisuals.insert(vis->Id());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool RenderUtilPrivate::VisualRadius(const rendering::VisualPtr &_vis,
+    double &_radius)
+{
+  const auto scale = _vis->LocalScale();
+  auto radiusIt = this->visualRadii.find(_vis->Id());
+  if (radiusIt == this->visualRadii.end() || radiusIt->second.second != scale)
+  {
+    auto box = _vis->LocalBoundingBox();
+    if (box.Min().X() > box.Max().X())
+      return false;
+    double radius = box.Center().Length() + box.Size().Length() * 0.5;
+    radiusIt = this->visualRadii.insert_or_assign(_vis->Id(),
+        std::make_pair(radius, scale)).first;
+  }
+  _radius = radiusIt->second.first;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RenderUtilPrivate::CameraViews(std::vector<CameraView> &_views) const
+{
+  _views.clear();
+  if (!this->scene)
+    return false;
+
+  for (unsigned int i = 0; i < this->scene->SensorCount(); ++i)
+  {
+    auto camera = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->SensorByIndex(i));
+    if (!camera)
+      return false;
+
+    // The cone contains the corners of the frustum
+    double hfov = camera->HFOV().Radian();
+    double aspect = camera->AspectRatio();
+    if (hfov >= GZ_PI || aspect <= 0.0)
+      return false;
+    double tanHalf = std::tan(hfov * 0.5);
+
+    CameraView view;
+    view.position = camera->WorldPosition();
+    view.direction = camera->WorldRotation() * math::Vector3d::UnitX;
+    view.halfAngle = std::atan(tanHalf *
+        std::sqrt(1.0 + 1.0 / (aspect * aspect)));
+    view.farClip = camera->FarClipPlane();
+    _views.push_back(view);
+  }
+  return !_views.empty();
+}
+
+//////////////////////////////////////////////////
+bool RenderUtilPrivate::ActorInView(const rendering::NodePtr &_actor,
+    const std::vector<CameraView> &_views)
+{
+  // Actors without geometry yet are always animated
+  auto vis = std::dynamic_pointer_cast<rendering::Visual>(_actor);
+  double radius;
+  if (!vis || !this->VisualRadius(vis, radius))
+    return true;
+
+  if (this->culledVisuals.find(vis->Id()) != this->culledVisuals.end())
+    return false;
+
+  auto position = _actor->WorldPosition();
+  for (const auto &view : _views)
+  {
+    auto diff = position - view.position;
+    double distance = diff.Length();
+    if (distance <= radius)
+      return true;
+    if (distance - radius > view.farClip)
+      continue;
+
+    double angle = std::acos(std::clamp(
+        view.direction.Dot(diff) / distance, -1.0, 1.0));
+    if (angle - std::asin(radius / distance) <= view.halfAngle)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::CreateEntities(const CreationGroup &_group,
+    const std::unordered_map<Entity, uint64_t> &_removeEntities)
+{
+  for (const auto &model : _group.models)
+  {
+    uint64_t iteration = std::get<3>(model);
+    Entity entityId = std::get<0>(model);
+    // since entites to be created and removed are queued, we need
+    // to check their creation timestamp to make sure we do not create a new
+    // entity when there is also a remove request with a more recent
+    // timestamp
+    // \todo(anyone) add test to check scene entities are properly added
+    // and removed.
+    auto removeIt = _removeEntities.find(entityId);
+    if (removeIt != _removeEntities.end())
+    {
+      uint64_t removeIteration = removeIt->second;
+      if (iteration < removeIteration)
+        continue;
+    }
+    this->sceneManager.CreateModel(
+        entityId, std::get<1>(model), std::get<2>(model));
+  }
+
+  for (const auto &actor : _group.actors)
+  {
+    this->sceneManager.CreateActor(
+        std::get<0>(actor), std::get<1>(actor), std::get<2>(actor),
+        std::get<3>(actor));
+  }
+
+  for (const auto &link : _group.links)
+  {
+    this->sceneManager.CreateLink(
+        std::get<0>(link), std::get<1>(link), std::get<2>(link));
+  }
+
+  for (const auto &visual : _group.visuals)
+  {
+    this->sceneManager.CreateVisual(
+        std::get<0>(visual), std::get<1>(visual), std::get<2>(visual));
+  }
+
+  for (const auto &light : _group.lights)
+  {
+    auto newLightRendering = this->sceneManager.CreateLight(
+      std::get<0>(light),
+      std::get<1>(light),
+      std::get<2>(light),
+      std::get<3>(light));
+
+    if (newLightRendering)
+    {
+      rendering::VisualPtr lightVisual =
+        this->sceneManager.CreateLightVisual(
+          std::get<0>(light) + 1,
+          std::get<1>(light),
+          std::get<2>(light),
+          std::get<0>(light));
+      this->matchLightWithVisuals[std::get<0>(light)] =
+        std::get<0>(light) + 1;
+    }
+    else
+    {
+      gzerr << "Failed to create light" << std::endl;
+    }
+  }
+
+  for (const auto &emitter : _group.particleEmitters)
+  {
+    this->sceneManager.CreateParticleEmitter(
+        std::get<0>(emitter), std::get<1>(emitter), std::get<2>(emitter));
+  }
+
+  for (const auto &projector : _group.projectors)
+  {
+    this->sceneManager.CreateProjector(
+        std::get<0>(projector), std::get<1>(projector),
+        std::get<2>(projector));
+  }
+
+  if (this->enableSensors && this->createSensorCb)
+  {
+    for (const auto &sensor : _group.sensors)
+    {
+      Entity entity = std::get<0>(sensor);
+      const sdf::Sensor &dataSdf = std::get<1>(sensor);
+      Entity parent = std::get<2>(sensor);
+
+      // two sensors with the same name cause conflicts. We'll need to use
+      // scoped names
+      // TODO(anyone) do this in gz-sensors?
+      auto parentNode = this->sceneManager.NodeById(parent);
+      if (!parentNode)
+      {
+        gzerr << "Failed to create sensor with name[" << dataSdf.Name()
+               << "] for entity [" << entity
+               << "]. Parent not found with ID[" << parent << "]."
+               << std::endl;
+        continue;
+      }
+
+      std::string sensorName =
+          this->createSensorCb(entity, dataSdf, parentNode->Name());
+      // Add to the system's scene manager
+      if (!this->sceneManager.AddSensor(entity, sensorName, parent))
+      {
+        gzerr << "Failed to create sensor [" << sensorName << "]"
+               << std::endl;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::CreateEntitiesBudgeted(CreationGroup &&_new,
+    const std::unordered_map<Entity, uint64_t> &_removeEntities)
+{
+  // Entities that were removed before they were created
+  for (auto it = this->deferredGroups.begin();
+       it != this->deferredGroups.end();)
+  {
+    auto &group = it->second;
+    auto removed = [&](const auto &_item)
+    {
+      return _removeEntities.find(std::get<0>(_item)) !=
+          _removeEntities.end();
+    };
+    auto eraseRemoved = [&](auto &_items)
+    {
+      _items.erase(std::remove_if(_items.begin(), _items.end(), removed),
+          _items.end());
+    };
+    eraseRemoved(group.models);
+    eraseRemoved(group.links);
+    eraseRemoved(group.visuals);
+    eraseRemoved(group.actors);
+    eraseRemoved(group.lights);
+    eraseRemoved(group.particleEmitters);
+    eraseRemoved(group.projectors);
+    eraseRemoved(group.sensors);
+    if (group.models.empty() && group.links.empty() &&
+        group.visuals.empty() && group.actors.empty() &&
+        group.lights.empty() && group.particleEmitters.empty() &&
+        group.projectors.empty() && group.sensors.empty())
+    {
+      it = this->deferredGroups.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  for (const auto &removed : _removeEntities)
+    this->deferredRoots.erase(removed.first);
+
+  // Group the new entities under their top level new entity, or under the
+  // deferred group of their parent
+  std::unordered_map<Entity, Entity> parents;
+  auto addParent = [&](const auto &_items, auto _parentOf)
+  {
+    for (const auto &item : _items)
+      parents[std::get<0>(item)] = _parentOf(item);
+  };
+  auto parentAt2 = [](const auto &_item) { return std::get<2>(_item); };
+  auto parentAt3 = [](const auto &_item) { return std::get<3>(_item); };
+  addParent(_new.models, parentAt2);
+  addParent(_new.links, parentAt2);
+  addParent(_new.visuals, parentAt2);
+  addParent(_new.actors, parentAt3);
+  addParent(_new.lights, parentAt3);
+  addParent(_new.particleEmitters, parentAt2);
+  addParent(_new.projectors, parentAt2);
+  addParent(_new.sensors, parentAt2);
+
+  auto groupOf = [&](Entity _entity) -> CreationGroup &
+  {
+    Entity root = _entity;
+    for (std::size_t depth = 0u; depth < parents.size(); ++depth)
+    {
+      auto parentIt = parents.find(parents[root]);
+      if (parentIt == parents.end())
+        break;
+      root = parentIt->first;
+    }
+    const Entity parent = parents[root];
+    auto rootIt = this->deferredRoots.find(root);
+    if (rootIt == this->deferredRoots.end())
+      rootIt = this->deferredRoots.find(parent);
+    if (rootIt != this->deferredRoots.end())
+      root = rootIt->second;
+
+    auto [groupIt, inserted] = this->deferredGroups.try_emplace(root);
+    if (inserted)
+    {
+      groupIt->second.root = root;
+      auto parentNode = this->sceneManager.NodeById(parent);
+      if (parentNode)
+        groupIt->second.position = parentNode->WorldPosition();
+    }
+    this->deferredRoots[_entity] = root;
+    return groupIt->second;
+  };
+
+  // Entities at the top of the world are placed by their own pose
+  const Entity worldId = this->sceneManager.WorldId();
+  for (auto &model : _new.models)
+  {
+    auto &group = groupOf(std::get<0>(model));
+    if (group.root == std::get<0>(model) && std::get<2>(model) == worldId)
+      group.position = std::get<1>(model).RawPose().Pos();
+    group.models.push_back(std::move(model));
+  }
+  for (auto &link : _new.links)
+    groupOf(std::get<0>(link)).links.push_back(std::move(link));
+  for (auto &visual : _new.visuals)
+    groupOf(std::get<0>(visual)).visuals.push_back(std::move(visual));
+  for (auto &actor : _new.actors)
+  {
+    auto &group = groupOf(std::get<0>(actor));
+    if (group.root == std::get<0>(actor) && std::get<3>(actor) == worldId)
+      group.position = std::get<1>(actor).RawPose().Pos();
+    group.actors.push_back(std::move(actor));
+  }
+  for (auto &light : _new.lights)
+  {
+    auto &group = groupOf(std::get<0>(light));
+    if (group.root == std::get<0>(light) && std::get<3>(light) == worldId)
+      group.position = std::get<1>(light).RawPose().Pos();
+    group.lights.push_back(std::move(light));
+  }
+  for (auto &emitter : _new.particleEmitters)
+  {
+    groupOf(std::get<0>(emitter)).particleEmitters.push_back(
+        std::move(emitter));
+  }
+  for (auto &projector : _new.projectors)
+  {
+    groupOf(std::get<0>(projector)).projectors.push_back(
+        std::move(projector));
+  }
+  for (auto &sensor : _new.sensors)
+    groupOf(std::get<0>(sensor)).sensors.push_back(std::move(sensor));
+
+  // Groups with sensors first, so they can render as soon as possible, and
+  // then those nearest to what's rendering the scene
+  std::vector<math::Vector3d> viewpoints;
+  for (unsigned int i = 0; i < this->scene->SensorCount(); ++i)
+    viewpoints.push_back(this->scene->SensorByIndex(i)->WorldPosition());
+  for (const auto &[root, group] : this->deferredGroups)
+  {
+    if (!group.sensors.empty())
+      viewpoints.push_back(group.position);
+  }
+
+  std::vector<std::pair<double, CreationGroup *>> order;
+  order.reserve(this->deferredGroups.size());
+  for (auto &[root, group] : this->deferredGroups)
+  {
+    double priority = group.sensors.empty() ? 0.0 : -1.0;
+    if (group.sensors.empty() && !viewpoints.empty())
+    {
+      priority = std::numeric_limits<double>::max();
+      for (const auto &viewpoint : viewpoints)
+      {
+        priority = std::min(priority,
+            viewpoint.SquaredDistance(group.position));
+      }
+    }
+    order.emplace_back(priority, &group);
+  }
+  std::stable_sort(order.begin(), order.end(),
+      [](const auto &_a, const auto &_b) { return _a.first < _b.first; });
+
+  // At least one group is created per update, so creation always progresses
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<Entity> created;
+  bool createdDeferred{false};
+  for (const auto &[priority, group] : order)
+  {
+    if (!created.empty() &&
+        this->creationBudget > std::chrono::steady_clock::duration(0) &&
+        std::chrono::steady_clock::now() - start >= this->creationBudget)
+    {
+      break;
+    }
+    this->CreateEntities(*group, _removeEntities);
+    createdDeferred = createdDeferred || group->deferred;
+    created.push_back(group->root);
+  }
+
+  for (const auto root : created)
+    this->deferredGroups.erase(root);
+  int sensorCount{0};
+  this->deferredRoots.clear();
+  for (auto &[root, group] : this->deferredGroups)
+  {
+    group.deferred = true;
+    sensorCount += static_cast<int>(group.sensors.size());
+    auto addRoots = [&, root = root](const auto &_items)
+    {
+      for (const auto &item : _items)
+        this->deferredRoots[std::get<0>(item)] = root;
+    };
+    addRoots(group.models);
+    addRoots(group.links);
+    addRoots(group.visuals);
+    addRoots(group.actors);
+    addRoots(group.lights);
+    addRoots(group.particleEmitters);
+    addRoots(group.projectors);
+    addRoots(group.sensors);
+  }
+  this->deferredSensors = sensorCount;
+
+  // Poses that changed while entities waited to be created were skipped,
+  // so copy all poses again
+  if (createdDeferred)
+  {
+    std::lock_guard<std::mutex> lock(this->updateMutex);
+    this->fullPoseUpdate = true;
+  }
+}
+
 //////////////////////////////////////////////////
 void RenderUtilPrivate::CreateRenderingEntities(
     const EntityComponentManager &_ecm, const UpdateInfo &_info)
@@ -1802,13 +2438,6 @@ void RenderUtilPrivate::CreateEntitiesFirstUpdate(
         this->newActors.push_back(std::make_tuple(_entity, _actor->Data(),
             _name->Data(), _parent->Data()));
 
-        // set label
-        auto label = _ecm.Component<components::SemanticLabel>(_entity);
-        if (label != nullptr)
-        {
-          this->entityLabel[_entity] = label->Data();
-        }
-
         return true;
       });
 
@@ -2091,13 +2720,6 @@ void RenderUtilPrivate::CreateEntitiesRuntime(
             std::make_tuple(_entity, _actor->Data(), _name->Data(),
               _parent->Data()));
 
-        // set label
-        auto label = _ecm.Component<components::SemanticLabel>(_entity);
-        if (label != nullptr)
-        {
-          this->entityLabel[_entity] = label->Data();
-        }
-
         return true;
       });
 
@@ -2296,33 +2918,13 @@ void RenderUtilPrivate::UpdateRenderingEntities(
     const EntityComponentManager &_ecm)
 {
   GZ_PROFILE("RenderUtilPrivate::UpdateRenderingEntities");
-  _ecm.Each<components::Model, components::Pose>(
-      [&](const Entity &_entity,
-        const components::Model *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  _ecm.Each<components::Link, components::Pose>(
-      [&](const Entity &_entity,
-        const components::Link *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  // visuals
-  _ecm.Each<components::Visual, components::Pose >(
-      [&](const Entity &_entity,
-        const components::Visual *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
+  if (this->incrementalPoseUpdates && !this->fullPoseUpdate)
+    this->UpdateChangedPoses(_ecm);
+  else
+    this->UpdateAllPoses(_ecm);
+  this->fullPoseUpdate = false;
+  this->UpdateTemperatures(_ecm);
+  this->UpdateLabels(_ecm);
 
   // actors
   _ecm.Each<components::Actor, components::Pose>(
@@ -2378,6 +2980,147 @@ void RenderUtilPrivate::UpdateRenderingEntities(
           this->trajectoryPoses[_entity] = trajPoseComp->Data();
         return true;
       });
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::UpdateTemperatures(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("RenderUtilPrivate::UpdateTemperatures");
+  const auto version = _ecm.ChangeVersion();
+  if (version == this->temperatureVersion)
+    return;
+
+  std::set<Entity> visuals;
+  for (const auto typeId : {components::Temperature::typeId,
+      components::TemperatureRange::typeId,
+      components::SourceFilePath::typeId})
+  {
+    for (const auto entity :
+        _ecm.EntitiesChangedSince(this->temperatureVersion, typeId))
+    {
+      if (_ecm.EntityHasComponentType(entity, components::Visual::typeId))
+        visuals.insert(entity);
+    }
+  }
+  this->temperatureVersion = version;
+
+  for (const auto entity : visuals)
+  {
+    if (auto temp = _ecm.Component<components::Temperature>(entity))
+    {
+      // get the uniform temperature for the entity
+      this->entityTemp[entity] = std::make_tuple
+          <float, float, std::string>(temp->Data().Kelvin(), 0.0, "");
+      continue;
+    }
+
+    // entity doesn't have a uniform temperature. Check if it has
+    // a heat signature with an associated temperature range
+    auto heatSignature =
+      _ecm.Component<components::SourceFilePath>(entity);
+    auto tempRange =
+       _ecm.Component<components::TemperatureRange>(entity);
+    if (heatSignature && tempRange)
+    {
+      this->entityTemp[entity] =
+        std::make_tuple<float, float, std::string>(
+            tempRange->Data().min.Kelvin(),
+            tempRange->Data().max.Kelvin(),
+            std::string(heatSignature->Data()));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::UpdateLabels(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("RenderUtilPrivate::UpdateLabels");
+  const auto version = _ecm.ChangeVersion();
+  if (version == this->labelVersion)
+    return;
+
+  for (const auto entity : _ecm.EntitiesChangedSince(this->labelVersion,
+      components::SemanticLabel::typeId))
+  {
+    if (!_ecm.EntityHasComponentType(entity, components::Visual::typeId) &&
+        !_ecm.EntityHasComponentType(entity, components::Actor::typeId))
+    {
+      continue;
+    }
+
+    auto label = _ecm.Component<components::SemanticLabel>(entity);
+    if (label != nullptr)
+      this->entityLabel[entity] = label->Data();
+  }
+  this->labelVersion = version;
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::UpdateChangedPoses(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("RenderUtilPrivate::UpdateChangedPoses");
+  static const std::vector<ComponentTypeId> kRenderedTypes{
+      components::Model::typeId,
+      components::Link::typeId,
+      components::Visual::typeId,
+      components::Light::typeId,
+      components::Camera::typeId,
+      components::DepthCamera::typeId,
+      components::RgbdCamera::typeId,
+      components::GpuLidar::typeId,
+      components::ThermalCamera::typeId,
+      components::SegmentationCamera::typeId,
+      components::BoundingBoxCamera::typeId,
+      components::WideAngleCamera::typeId};
+
+  for (const auto &entity :
+      _ecm.EntitiesWithChangedComponent(components::Pose::typeId))
+  {
+    auto rendered = std::any_of(kRenderedTypes.begin(), kRenderedTypes.end(),
+        [&](const ComponentTypeId _typeId)
+        {
+          return _ecm.EntityHasComponentType(entity, _typeId);
+        });
+    if (!rendered)
+      continue;
+
+    auto poseComp = _ecm.Component<components::Pose>(entity);
+    if (poseComp)
+      this->entityPoses[entity] = poseComp->Data();
+  }
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::UpdateAllPoses(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("RenderUtilPrivate::UpdateAllPoses");
+  _ecm.Each<components::Model, components::Pose>(
+      [&](const Entity &_entity,
+        const components::Model *,
+        const components::Pose *_pose)->bool
+      {
+        this->entityPoses[_entity] = _pose->Data();
+        return true;
+      });
+
+  _ecm.Each<components::Link, components::Pose>(
+      [&](const Entity &_entity,
+        const components::Link *,
+        const components::Pose *_pose)->bool
+      {
+        this->entityPoses[_entity] = _pose->Data();
+        return true;
+      });
+
+  // visuals
+  _ecm.Each<components::Visual, components::Pose >(
+      [&](const Entity &_entity,
+        const components::Visual *,
+        const components::Pose *_pose)->bool
+      {
+        this->entityPoses[_entity] = _pose->Data();
+        return true;
+      });
 
   // update lights
   _ecm.Each<components::Light, components::Pose>(
@@ -2739,6 +3482,9 @@ void RenderUtil::Destroy()
   if (!this->dataPtr->engine || !this->dataPtr->scene)
     return;
   this->dataPtr->wireBoxes.clear();
+  this->dataPtr->deferredGroups.clear();
+  this->dataPtr->deferredRoots.clear();
+  this->dataPtr->deferredSensors = 0;
   this->dataPtr->sceneManager.Clear();
   this->dataPtr->markerManager.Clear();
   this->dataPtr->engine->DestroyScene(this->dataPtr->scene);
@@ -2934,16 +3680,71 @@ void RenderUtil::SetTransformActive(bool _active)
   this->dataPtr->transformActive = _active;
 }
 
+////////////////////////////////////////////////
+void RenderUtil::SetSensorCullingDistance(double _distance)
+{
+  this->dataPtr->cullingDistance = _distance;
+}
+
+////////////////////////////////////////////////
+void RenderUtil::SetEntityVisible(Entity _entity, bool _visible)
+{
+  auto vis = std::dynamic_pointer_cast<rendering::Visual>(
+      this->dataPtr->sceneManager.NodeById(_entity));
+  if (!vis)
+    return;
+
+  if (_visible)
+    this->dataPtr->hiddenVisuals.erase(vis->Id());
+  else
+    this->dataPtr->hiddenVisuals.insert(vis->Id());
+
+  // Culled visuals are shown once they're back in range
+  if (this->dataPtr->culledVisuals.find(vis->Id()) ==
+      this->dataPtr->culledVisuals.end())
+  {
+    vis->SetVisible(_visible);
+  }
+}
+
+////////////////////////////////////////////////
+void RenderUtil::SetActorAnimationCulling(bool _enable)
+{
+  this->dataPtr->actorAnimationCulling = _enable;
+}
+
+////////////////////////////////////////////////
+void RenderUtil::SetCreationTimeBudget(
+    const std::chrono::steady_clock::duration &_budget)
+{
+  this->dataPtr->creationBudget = _budget;
+}
+
+////////////////////////////////////////////////
+void RenderUtil::SetIncrementalPoseUpdates(bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+  if (_enable && !this->dataPtr->incrementalPoseUpdates)
+    this->dataPtr->fullPoseUpdate = true;
+  this->dataPtr->incrementalPoseUpdates = _enable;
+}
+
 ////////////////////////////////////////////////
 void RenderUtilPrivate::UpdateVisualLabels(
   const std::unordered_map<Entity, int> &_entityLabel)
 {
   // set visual label
+  std::vector<std::pair<Entity, int>> deferredLabels;
   for (const auto &label : _entityLabel)
   {
     auto node = this->sceneManager.NodeById(label.first);
     if (!node)
+    {
+      // Visuals waiting to be created get their label once they are
+      if (this->deferredRoots.find(label.first) != this->deferredRoots.end())
+        deferredLabels.push_back(label);
       continue;
+    }
 
     auto visual = std::dynamic_pointer_cast<rendering::Visual>(node);
     if (!visual)
@@ -2951,6 +3752,13 @@ void RenderUtilPrivate::UpdateVisualLabels(
 
     visual->SetUserData("label", label.second);
   }
+
+  if (!deferredLabels.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->updateMutex);
+    for (const auto &label : deferredLabels)
+      this->entityLabel.emplace(label);
+  }
 }
 
 ////////////////////////////////////////////////
@@ -3213,6 +4021,10 @@ void RenderUtilPrivate::UpdateAnimation(const std::unordered_map<Entity,
     const std::unordered_map<Entity, math::Pose3d> &_entityPoses,
     const std::unordered_map<Entity, math::Pose3d> &_trajectoryPoses)
 {
+  std::vector<CameraView> views;
+  bool cullActors = this->actorAnimationCulling &&
+      !_actorAnimationData.empty() && this->CameraViews(views);
+
   for (auto &it : _actorAnimationData)
   {
     auto actorMesh = this->sceneManager.ActorMeshById(it.first);
@@ -3233,6 +4045,45 @@ void RenderUtilPrivate::UpdateAnimation(const std::unordered_map<Entity,
       continue;
     }
 
+    // update actor trajectory animation
+    math::Pose3d globalPose;
+    auto entityPosesIt = _entityPoses.find(it.first);
+    if (entityPosesIt != _entityPoses.end())
+    {
+      globalPose = entityPosesIt->second;
+    }
+
+    math::Pose3d trajPose;
+    // Trajectory from the ECS
+    auto trajectoryPosesIt = _trajectoryPoses.find(it.first);
+    if (trajectoryPosesIt != _trajectoryPoses.end())
+    {
+      trajPose = trajectoryPosesIt->second;
+    }
+    else
+    {
+      // trajectory from sdf script
+      common::PoseKeyFrame poseFrame(0.0);
+      if (animData.followTrajectory)
+        animData.trajectory.Waypoints()->InterpolatedKeyFrame(poseFrame);
+      trajPose.Pos() = poseFrame.Translation();
+      trajPose.Rot() = poseFrame.Rotation();
+    }
+
+    math::Pose3d worldPose = globalPose * trajPose;
+    actorVisual->SetLocalPose(worldPose);
+
+    {
+      // populate world pose map which is used to update ECM
+      std::lock_guard<std::mutex> lock(this->updateMutex);
+      this->actorWorldPoses[it.first] = worldPose;
+    }
+
+    // The skeleton is posed from the animation time alone, so actors out
+    // of view can skip updates and still be correct once they're seen
+    if (cullActors && !this->ActorInView(actorVisual, views))
+      continue;
+
     if (actorMesh && actorSkel)
     {
       // Enable skeleton animation
@@ -3281,38 +4132,6 @@ void RenderUtilPrivate::UpdateAnimation(const std::unordered_map<Entity,
         actorMesh->SetSkeletonLocalTransforms(rootTf);
       }
     }
-
-    // update actor trajectory animation
-    math::Pose3d globalPose;
-    auto entityPosesIt = _entityPoses.find(it.first);
-    if (entityPosesIt != _entityPoses.end())
-    {
-      globalPose = entityPosesIt->second;
-    }
-
-    math::Pose3d trajPose;
-    // Trajectory from the ECS
-    auto trajectoryPosesIt = _trajectoryPoses.find(it.first);
-    if (trajectoryPosesIt != _trajectoryPoses.end())
-    {
-      trajPose = trajectoryPosesIt->second;
-    }
-    else
-    {
-      // trajectory from sdf script
-      common::PoseKeyFrame poseFrame(0.0);
-      if (animData.followTrajectory)
-        animData.trajectory.Waypoints()->InterpolatedKeyFrame(poseFrame);
-      trajPose.Pos() = poseFrame.Translation();
-      trajPose.Rot() = poseFrame.Rotation();
-    }
-
-    math::Pose3d worldPose = globalPose * trajPose;
-    actorVisual->SetLocalPose(worldPose);
-
-    // populate world pose map which is used to update ECM
-    std::lock_guard<std::mutex> lock(this->updateMutex);
-    this->actorWorldPoses[it.first] = worldPose;
   }
 }
 
@@ -3879,37 +4698,8 @@ void RenderUtilPrivate::CreateVisual(
     visual.SetLaserRetro(laserRetro->Data());
   }
 
-  // set label
-  auto label = _ecm.Component<components::SemanticLabel>(_entity);
-  if (label != nullptr)
-  {
-    this->entityLabel[_entity] = label->Data();
-  }
-
-  if (auto temp = _ecm.Component<components::Temperature>(_entity))
-  {
-    // get the uniform temperature for the entity
-    this->entityTemp[_entity] = std::make_tuple
-        <float, float, std::string>(temp->Data().Kelvin(), 0.0, "");
-  }
-  else
-  {
-    // entity doesn't have a uniform temperature. Check if it has
-    // a heat signature with an associated temperature range
-    auto heatSignature =
-      _ecm.Component<components::SourceFilePath>(_entity);
-    auto tempRange =
-       _ecm.Component<components::TemperatureRange>(_entity);
-    if (heatSignature && tempRange)
-    {
-      this->entityTemp[_entity] =
-        std::make_tuple<float, float, std::string>(
-            tempRange->Data().min.Kelvin(),
-            tempRange->Data().max.Kelvin(),
-            std::string(heatSignature->Data()));
-    }
-  }
-
+  // The temperature and label are copied by UpdateTemperatures and
+  // UpdateLabels, since the components are stamped when they're created
   this->newVisuals.push_back(
       std::make_tuple(_entity, visual, _parent->Data()));
 
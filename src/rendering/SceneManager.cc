@@ -16,10 +16,18 @@
  */
 
 
+#include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <sstream>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <sdf/Box.hh>
 #include <sdf/Capsule.hh>
@@ -74,6 +82,7 @@
 
 #include "gz/sim/Conversions.hh"
 #include "gz/sim/Util.hh"
+#include "gz/sim/rendering/AssetCache.hh"
 #include "gz/sim/rendering/SceneManager.hh"
 
 using namespace gz;
@@ -82,6 +91,58 @@ using namespace std::chrono_literals;
 
 using TP = std::chrono::steady_clock::time_point;
 
+namespace
+{
+/// \brief Visuals of the entities of a scene, see SceneManager::IndexVisual.
+struct VisualIndex
+{
+  /// \brief Scene of the visuals, to detect a new scene created at the
+  /// address of a destroyed one.
+  std::weak_ptr<rendering::Scene> scene;
+
+  /// \brief Visual of each entity.
+  std::unordered_map<Entity, std::weak_ptr<rendering::Visual>> visuals;
+};
+
+/// \brief Visual indices of all scenes, shared by all scene managers.
+struct VisualIndices
+{
+  /// \brief Protects scenes. GUI plugins may look up visuals from the
+  /// main thread while the render thread creates them.
+  std::mutex mutex;
+
+  /// \brief Index of each scene.
+  std::map<const rendering::Scene *, VisualIndex> scenes;
+};
+
+/// \brief Get the visual indices.
+/// \return The visual indices.
+VisualIndices &visualIndices()
+{
+  static VisualIndices indices;
+  return indices;
+}
+
+/// \brief Get the visual of an entity if it's still in the scene.
+/// \param[in] _scene Scene of the visual.
+/// \param[in] _visual Indexed visual.
+/// \param[in] _id Entity of the visual.
+/// \return The visual, or null if it was destroyed or reassigned.
+rendering::VisualPtr validVisual(const rendering::ScenePtr &_scene,
+    const std::weak_ptr<rendering::Visual> &_visual, Entity _id)
+{
+  auto visual = _visual.lock();
+  if (!visual || !_scene->HasVisualId(visual->Id()))
+    return nullptr;
+
+  auto entity = visual->UserData("gazebo-entity");
+  auto entityId = std::get_if<uint64_t>(&entity);
+  if (nullptr == entityId || *entityId != _id)
+    return nullptr;
+  return visual;
+}
+}
+
 /// \brief Private data class.
 class gz::sim::SceneManagerPrivate
 {
@@ -106,6 +167,13 @@ class gz::sim::SceneManagerPrivate
   public: std::unordered_map<Entity, std::vector<common::TrajectoryInfo>>
                     actorTrajectories;
 
+  /// \brief Map of actor entity to the index of the trajectory that
+  /// contained the last requested time, so that the next lookup, which is
+  /// usually in the same or a following trajectory, doesn't start from the
+  /// first one.
+  public: mutable std::unordered_map<Entity, std::size_t>
+                    actorTrajectoryCursors;
+
   /// \brief Map of light entity in Gazebo to light pointers.
   public: std::unordered_map<Entity, rendering::LightPtr> lights;
 
@@ -127,6 +195,54 @@ class gz::sim::SceneManagerPrivate
   /// \brief The map of the original depth write values for the nodes.
   public: std::map<std::string, bool> originalDepthWrite;
 
+  /// \brief True to share materials between visuals with identical
+  /// materials.
+  public: bool shareMaterials{false};
+
+  /// \brief All shared materials used by visuals of this scene manager.
+  /// They're held by the AssetCache, which shares them with other scene
+  /// managers of the same scene.
+  public: std::unordered_set<rendering::MaterialPtr> sharedMaterialSet;
+
+  /// \brief Assets of the AssetCache referenced by each visual, released
+  /// when the visual is removed.
+  public: std::unordered_map<Entity,
+      std::vector<std::pair<AssetType, std::string>>> cachedAssets;
+
+  /// \brief Assets of the AssetCache referenced since the last visual was
+  /// created, such as those loaded by LoadGeometry for the visual being
+  /// created. They're released when the scene is cleared if no visual
+  /// takes them.
+  public: std::vector<std::pair<AssetType, std::string>> pendingAssets;
+
+  /// \brief Get the key of the shared material of a visual.
+  /// \param[in] _visual The visual.
+  /// \param[in] _base Description of the material before the visual
+  /// modifies it.
+  /// \return Key in the AssetCache.
+  public: static std::string SharedMaterialKey(const sdf::Visual &_visual,
+      const std::string &_base);
+
+  /// \brief Find a shared material in the AssetCache, and keep a
+  /// reference to it for the visual being created.
+  /// \param[in] _key Key of the material.
+  /// \return The material, or nullptr if it isn't cached.
+  public: rendering::MaterialPtr SharedMaterial(const std::string &_key);
+
+  /// \brief Add a shared material to the AssetCache, keeping a reference to
+  /// it for the visual being created.
+  /// \param[in] _key Key of the material.
+  /// \param[in] _material The material.
+  public: void AddSharedMaterial(const std::string &_key,
+      const rendering::MaterialPtr &_material);
+
+  /// \brief Release the references to cached assets held for a visual.
+  /// \param[in] _id Entity of the visual.
+  public: void ReleaseAssets(Entity _id);
+
+  /// \brief Release all the references to cached assets.
+  public: void ReleaseAllAssets();
+
   /// \brief Helper function to compute actor trajectory at specified tiime
   /// \param[in] _id Actor entity's unique id
   /// \param[in] _time Simulation time
@@ -157,11 +273,15 @@ SceneManager::SceneManager()
 }
 
 /////////////////////////////////////////////////
-SceneManager::~SceneManager() = default;
+SceneManager::~SceneManager()
+{
+  this->dataPtr->ReleaseAllAssets();
+}
 
 /////////////////////////////////////////////////
 void SceneManager::SetScene(rendering::ScenePtr _scene)
 {
+  this->dataPtr->ReleaseAllAssets();
   this->dataPtr->scene = std::move(_scene);
 }
 
@@ -226,7 +346,7 @@ rendering::VisualPtr SceneManager::CreateModel(Entity _id,
 
   rendering::VisualPtr modelVis = this->dataPtr->scene->CreateVisual(name);
 
-  modelVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, modelVis);
   modelVis->SetUserData("pause-update", static_cast<int>(0));
   modelVis->SetLocalPose(_model.RawPose());
   this->dataPtr->visuals[_id] = modelVis;
@@ -271,7 +391,7 @@ rendering::VisualPtr SceneManager::CreateLink(Entity _id,
   if (parent)
     name = parent->Name() + "::" + name;
   rendering::VisualPtr linkVis = this->dataPtr->scene->CreateVisual(name);
-  linkVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, linkVis);
   linkVis->SetUserData("pause-update", static_cast<int>(0));
   linkVis->SetLocalPose(_link.RawPose());
   this->dataPtr->visuals[_id] = linkVis;
@@ -317,7 +437,7 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
   if (parent)
     name = parent->Name() + "::" + name;
   rendering::VisualPtr visualVis = this->dataPtr->scene->CreateVisual(name);
-  visualVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, visualVis);
   visualVis->SetUserData("pause-update", static_cast<int>(0));
   visualVis->SetLocalPose(_visual.RawPose());
 
@@ -353,13 +473,23 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
 
     // set material
     rendering::MaterialPtr material{nullptr};
+    rendering::MaterialPtr sharedMaterial{nullptr};
+    std::string sharedKey;
     if (_visual.Geom()->Type() == sdf::GeometryType::HEIGHTMAP)
     {
       // Heightmap's material is loaded together with it.
     }
     else if (_visual.Material())
     {
-      material = this->LoadMaterial(*_visual.Material());
+      if (this->dataPtr->shareMaterials)
+      {
+        sharedKey = SceneManagerPrivate::SharedMaterialKey(_visual,
+            _visual.Material()->FilePath() + "|" +
+            convert<msgs::Material>(*_visual.Material()).SerializeAsString());
+        sharedMaterial = this->dataPtr->SharedMaterial(sharedKey);
+      }
+      if (!sharedMaterial)
+        material = this->LoadMaterial(*_visual.Material());
     }
     // Don't set a default material for meshes because they
     // may have their own
@@ -383,12 +513,28 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
       // meshes created by mesh loader may have their own materials
       // update/override their properties based on input sdf element values
       auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
+      auto meshSdf = _visual.Geom()->MeshShape();
       for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
       {
         auto submesh = mesh->SubMeshByIndex(i);
         auto submeshMat = submesh->Material();
         if (submeshMat)
         {
+          // Submeshes of the same mesh loaded the same materials
+          std::string submeshKey;
+          if (this->dataPtr->shareMaterials && meshSdf)
+          {
+            submeshKey = SceneManagerPrivate::SharedMaterialKey(_visual,
+                meshSdf->FilePath() + "|" + meshSdf->Uri() + "|" +
+                meshSdf->Submesh() + "|" + std::to_string(i));
+            auto shared = this->dataPtr->SharedMaterial(submeshKey);
+            if (shared)
+            {
+              submesh->SetMaterial(shared, false);
+              continue;
+            }
+          }
+
           double productAlpha = (1.0-_visual.Transparency()) *
               (1.0 - submeshMat->Transparency());
           submeshMat->SetTransparency(1 - productAlpha);
@@ -399,7 +545,16 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
           // \todo(anyone) find way to propate cast shadows changes tos submesh
           // in gz-rendering
           submeshMat->SetCastShadows(_visual.CastShadows());
-          submesh->SetMaterial(submeshMat);
+          if (submeshKey.empty())
+          {
+            submesh->SetMaterial(submeshMat);
+          }
+          else
+          {
+            auto shared = submeshMat->Clone();
+            this->dataPtr->AddSharedMaterial(submeshKey, shared);
+            submesh->SetMaterial(shared, false);
+          }
         }
       }
     }
@@ -412,13 +567,24 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
       // cast shadows
       material->SetCastShadows(_visual.CastShadows());
 
-      geom->SetMaterial(material);
-      // todo(anyone) SetMaterial function clones the input material.
-      // but does not take ownership of it so we need to destroy it here.
-      // This is not ideal. We should let gz-rendering handle the lifetime
-      // of this material
-      this->dataPtr->scene->DestroyMaterial(material);
+      if (!sharedKey.empty())
+      {
+        this->dataPtr->AddSharedMaterial(sharedKey, material);
+        sharedMaterial = material;
+      }
+      else
+      {
+        geom->SetMaterial(material);
+        // todo(anyone) SetMaterial function clones the input material.
+        // but does not take ownership of it so we need to destroy it here.
+        // This is not ideal. We should let gz-rendering handle the lifetime
+        // of this material
+        this->dataPtr->scene->DestroyMaterial(material);
+      }
     }
+
+    if (sharedMaterial)
+      geom->SetMaterial(sharedMaterial, false);
   }
   else
   {
@@ -429,6 +595,15 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
   // visibility flags
   visualVis->SetVisibilityFlags(_visual.VisibilityFlags());
 
+  if (!this->dataPtr->pendingAssets.empty())
+  {
+    auto &assets = this->dataPtr->cachedAssets[_id];
+    assets.insert(assets.end(),
+        std::make_move_iterator(this->dataPtr->pendingAssets.begin()),
+        std::make_move_iterator(this->dataPtr->pendingAssets.end()));
+    this->dataPtr->pendingAssets.clear();
+  }
+
   this->dataPtr->visuals[_id] = visualVis;
   if (parent)
     parent->AddChild(visualVis);
@@ -578,7 +753,7 @@ std::pair<rendering::VisualPtr, std::vector<Entity>> SceneManager::CopyVisual(
       }
 
       this->dataPtr->visuals[childId] = childVisual;
-      childVisual->SetUserData("gazebo-entity", childId);
+      this->IndexVisual(childId, childVisual);
       childVisual->SetUserData("pause-update", static_cast<int>(0));
       childVisualIds.push_back(childId);
 
@@ -594,7 +769,7 @@ std::pair<rendering::VisualPtr, std::vector<Entity>> SceneManager::CopyVisual(
   }
   else
   {
-    clonedVisual->SetUserData("gazebo-entity", _id);
+    this->IndexVisual(_id, clonedVisual);
     clonedVisual->SetUserData("pause-update", static_cast<int>(0));
 
     result = {clonedVisual, std::move(childVisualIds)};
@@ -617,6 +792,53 @@ rendering::VisualPtr SceneManager::VisualById(Entity _id)
   return this->dataPtr->visuals[_id];
 }
 
+/////////////////////////////////////////////////
+void SceneManager::IndexVisual(Entity _id,
+    const rendering::VisualPtr &_visual)
+{
+  if (!_visual)
+    return;
+
+  _visual->SetUserData("gazebo-entity", _id);
+
+  auto scene = _visual->Scene();
+  if (!scene)
+    return;
+
+  auto &indices = visualIndices();
+  std::lock_guard<std::mutex> lock(indices.mutex);
+  auto &index = indices.scenes[scene.get()];
+  if (index.scene.lock() != scene)
+  {
+    index.scene = scene;
+    index.visuals.clear();
+  }
+  index.visuals[_id] = _visual;
+}
+
+/////////////////////////////////////////////////
+rendering::VisualPtr SceneManager::VisualByEntity(
+    const rendering::ScenePtr &_scene, Entity _id)
+{
+  if (!_scene)
+    return nullptr;
+
+  auto &indices = visualIndices();
+  std::lock_guard<std::mutex> lock(indices.mutex);
+  auto index = indices.scenes.find(_scene.get());
+  if (index == indices.scenes.end() || index->second.scene.lock() != _scene)
+    return nullptr;
+
+  auto it = index->second.visuals.find(_id);
+  if (it == index->second.visuals.end())
+    return nullptr;
+
+  auto visual = validVisual(_scene, it->second, _id);
+  if (!visual)
+    index->second.visuals.erase(it);
+  return visual;
+}
+
 /////////////////////////////////////////////////
 rendering::VisualPtr SceneManager::CreateCollision(Entity _id,
     const sdf::Collision &_collision, Entity _parentId)
@@ -702,17 +924,26 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const sdf::Geometry &_geom,
   }
   else if (_geom.Type() == sdf::GeometryType::MESH)
   {
+    // Meshes already loaded for this scene, by this or another scene
+    // manager, are reused without looking up their files again
+    auto &cache = AssetCache::Instance();
+    const std::string meshKey = _geom.MeshShape()->FilePath() + "|" +
+        _geom.MeshShape()->Uri();
     rendering::MeshDescriptor descriptor;
-    descriptor.mesh = loadMesh(*_geom.MeshShape());
+    descriptor.mesh = cache.AcquireMesh(this->dataPtr->scene, meshKey);
     if (!descriptor.mesh)
-      return geom;
+    {
+      descriptor.mesh = loadMesh(*_geom.MeshShape());
+      if (!descriptor.mesh)
+        return geom;
+      cache.AddMesh(this->dataPtr->scene, meshKey, descriptor.mesh);
+    }
+    this->dataPtr->pendingAssets.emplace_back(AssetType::MESH, meshKey);
     std::string meshUri =
         (common::URI(_geom.MeshShape()->Uri()).Scheme() == "name") ?
          common::basename(_geom.MeshShape()->Uri()) :
          asFullPath(_geom.MeshShape()->Uri(),
                     _geom.MeshShape()->FilePath());
-    auto a =     asFullPath(_geom.MeshShape()->Uri(),
-                    _geom.MeshShape()->FilePath());
 
     descriptor.meshName = meshUri;
     descriptor.subMeshName = _geom.MeshShape()->Submesh();
@@ -732,35 +963,60 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const sdf::Geometry &_geom,
     }
 
 
-    std::shared_ptr<common::HeightmapData> data;
+    // Heightmap data doesn't depend on the scene, so it's shared by all
+    // scene managers. DEMs also depend on the world's coordinates.
+    auto &cache = AssetCache::Instance();
     std::string lowerFullPath = common::lowercase(fullPath);
-    // check if heightmap is an image
-    if (common::EndsWith(lowerFullPath, ".png")
+    const bool isImage = common::EndsWith(lowerFullPath, ".png")
         || common::EndsWith(lowerFullPath, ".jpg")
-        || common::EndsWith(lowerFullPath, ".jpeg"))
-    {
-      auto img = std::make_shared<common::ImageHeightmap>();
-      if (img->Load(fullPath) < 0)
+        || common::EndsWith(lowerFullPath, ".jpeg");
+    std::string heightmapKey = fullPath;
+    if (!isImage)
+    {
+      const auto &coordinates = this->dataPtr->sphericalCoordinates;
+      std::ostringstream key;
+      key.precision(17);
+      key << fullPath << "|" << static_cast<int>(coordinates.Surface())
+          << "|" << coordinates.LatitudeReference().Radian()
+          << "|" << coordinates.LongitudeReference().Radian()
+          << "|" << coordinates.ElevationReference()
+          << "|" << coordinates.HeadingOffset().Radian();
+      heightmapKey = key.str();
+    }
+
+    std::shared_ptr<common::HeightmapData> data =
+        cache.AcquireHeightmap(heightmapKey);
+    if (!data)
+    {
+      // check if heightmap is an image
+      if (isImage)
       {
-        gzerr << "Failed to load heightmap image data from ["
-               << fullPath << "]" << std::endl;
-        return geom;
+        auto img = std::make_shared<common::ImageHeightmap>();
+        if (img->Load(fullPath) < 0)
+        {
+          gzerr << "Failed to load heightmap image data from ["
+                 << fullPath << "]" << std::endl;
+          return geom;
+        }
+        data = img;
       }
-      data = img;
-    }
-    // DEM
-    else
-    {
-      auto dem = std::make_shared<common::Dem>();
-      dem->SetSphericalCoordinates(this->dataPtr->sphericalCoordinates);
-      if (dem->Load(fullPath) < 0)
+      // DEM
+      else
       {
-        gzerr << "Failed to load heightmap dem data from ["
-               << fullPath << "]" << std::endl;
-        return geom;
+        auto dem = std::make_shared<common::Dem>();
+        dem->SetSphericalCoordinates(this->dataPtr->sphericalCoordinates);
+        if (dem->Load(fullPath) < 0)
+        {
+          gzerr << "Failed to load heightmap dem data from ["
+                 << fullPath << "]" << std::endl;
+          return geom;
+        }
+        data = dem;
       }
-      data = dem;
+      cache.AddHeightmap(heightmapKey, data);
     }
+    this->dataPtr->pendingAssets.emplace_back(AssetType::HEIGHTMAP,
+        heightmapKey);
 
     rendering::HeightmapDescriptor descriptor;
     descriptor.SetData(data);
@@ -1086,6 +1342,7 @@ rendering::VisualPtr SceneManager::CreateActor(Entity _id,
   }
 
   this->dataPtr->actorTrajectories[_id] = trajectories;
+  this->dataPtr->actorTrajectoryCursors.erase(_id);
 
   rendering::VisualPtr actorVisual = this->dataPtr->scene->CreateVisual(name);
   rendering::MeshPtr actorMesh;
@@ -1103,7 +1360,7 @@ rendering::VisualPtr SceneManager::CreateActor(Entity _id,
   }
 
   actorVisual->SetLocalPose(_actor.RawPose());
-  actorVisual->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, actorVisual);
   actorVisual->SetUserData("pause-update", static_cast<int>(0));
 
   this->dataPtr->visuals[_id] = actorVisual;
@@ -1175,7 +1432,7 @@ rendering::VisualPtr SceneManager::CreateLightVisual(Entity _id,
 
   rendering::VisualPtr lightVis = std::dynamic_pointer_cast<rendering::Visual>(
     lightVisual);
-  lightVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, lightVis);
   lightVis->SetUserData("pause-update", static_cast<int>(0));
   this->dataPtr->visuals[_id] = lightVis;
 
@@ -1316,7 +1573,7 @@ rendering::VisualPtr SceneManager::CreateInertiaVisual(Entity _id,
 
   rendering::VisualPtr inertiaVis =
     std::dynamic_pointer_cast<rendering::Visual>(inertiaVisual);
-  inertiaVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, inertiaVis);
   inertiaVis->SetUserData("pause-update", static_cast<int>(0));
   inertiaVis->SetUserData("gui-only", static_cast<bool>(true));
   this->dataPtr->visuals[_id] = inertiaVis;
@@ -1449,7 +1706,7 @@ rendering::VisualPtr SceneManager::CreateJointVisual(
 
   rendering::VisualPtr jointVis =
     std::dynamic_pointer_cast<rendering::Visual>(jointVisual);
-  jointVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, jointVis);
   jointVis->SetUserData("pause-update", static_cast<int>(0));
   jointVis->SetUserData("gui-only", static_cast<bool>(true));
   jointVis->SetLocalPose(_joint.RawPose());
@@ -1498,7 +1755,7 @@ rendering::VisualPtr SceneManager::CreateCOMVisual(Entity _id,
 
   rendering::VisualPtr comVis =
     std::dynamic_pointer_cast<rendering::Visual>(comVisual);
-  comVis->SetUserData("gazebo-entity", _id);
+  this->IndexVisual(_id, comVis);
   comVis->SetUserData("pause-update", static_cast<int>(0));
   comVis->SetUserData("gui-only", static_cast<bool>(true));
   this->dataPtr->visuals[_id] = comVis;
@@ -2028,6 +2285,7 @@ void SceneManager::RemoveEntity(Entity _id)
     {
       this->dataPtr->actorTrajectories.erase(it);
     }
+    this->dataPtr->actorTrajectoryCursors.erase(_id);
   }
   {
     auto it = this->dataPtr->actorSkeletons.find(_id);
@@ -2054,8 +2312,24 @@ void SceneManager::RemoveEntity(Entity _id)
         this->dataPtr->originalDepthWrite.erase(geom->Name());
       }
 
+      {
+        auto &indices = visualIndices();
+        std::lock_guard<std::mutex> lock(indices.mutex);
+        auto index = indices.scenes.find(this->dataPtr->scene.get());
+        if (index != indices.scenes.end())
+        {
+          auto indexed = index->second.visuals.find(_id);
+          if (indexed != index->second.visuals.end() &&
+              indexed->second.lock() == vis)
+          {
+            index->second.visuals.erase(indexed);
+          }
+        }
+      }
+
       this->dataPtr->scene->DestroyVisual(it->second);
       this->dataPtr->visuals.erase(it);
+      this->dataPtr->ReleaseAssets(_id);
       return;
     }
   }
@@ -2192,6 +2466,13 @@ void SceneManager::UpdateTransparency(const rendering::NodePtr &_node,
     auto geomMat = geom->Material();
     if (nullptr == geomMat || visMat == geomMat)
       continue;
+
+    // Give the geometry its own copy before changing a shared material
+    if (this->IsSharedMaterial(geomMat))
+    {
+      geom->SetMaterial(geomMat);
+      geomMat = geom->Material();
+    }
     auto geomTransparency =
         this->dataPtr->originalTransparency.find(geom->Name());
     auto geomDepthWrite =
@@ -2272,7 +2553,7 @@ AnimationUpdateData SceneManagerPrivate::ActorTrajectoryAt(
   if (trajIt == this->actorTrajectories.end())
     return animData;
 
-  auto trajs = trajIt->second;
+  const auto &trajs = trajIt->second;
   bool followTraj = true;
   if (1 == trajs.size() && nullptr == trajs[0].Waypoints())
     followTraj = false;
@@ -2302,17 +2583,31 @@ AnimationUpdateData SceneManagerPrivate::ActorTrajectoryAt(
 
   if (!noLoop || time <= totalTime)
   {
-    while (time > totalTime)
+    // Wrap into (0, totalTime] in constant time, however long the actor
+    // has been looping
+    if (time > totalTime && totalTime > std::chrono::steady_clock::duration(0))
     {
-      time = time - totalTime;
+      time = time % totalTime;
+      if (time == std::chrono::steady_clock::duration(0))
+        time = totalTime;
     }
     if (followTraj)
     {
-      for (auto &trajectory : trajs)
+      // Resume the search from the last trajectory if all the previous ones
+      // ended before the requested time, otherwise time went backwards
+      std::size_t &cursor = this->actorTrajectoryCursors[_id];
+      if (cursor >= trajs.size() || (cursor > 0u &&
+          trajs[cursor - 1u].EndTime() - firstTraj->StartTime() >= time))
+      {
+        cursor = 0u;
+      }
+      for (std::size_t i = cursor; i < trajs.size(); ++i)
       {
+        const auto &trajectory = trajs[i];
         if (trajectory.StartTime() - firstTraj->StartTime() <= time
             && trajectory.EndTime() - firstTraj->StartTime() >= time)
         {
+          cursor = i;
           traj = trajectory;
           time -= traj.StartTime() - firstTraj->StartTime();
 
@@ -2559,11 +2854,85 @@ void SceneManager::Clear()
   this->dataPtr->actors.clear();
   this->dataPtr->actorSkeletons.clear();
   this->dataPtr->actorTrajectories.clear();
+  this->dataPtr->actorTrajectoryCursors.clear();
   this->dataPtr->lights.clear();
   this->dataPtr->particleEmitters.clear();
   this->dataPtr->projectors.clear();
   this->dataPtr->sensors.clear();
+  this->dataPtr->ReleaseAllAssets();
   this->dataPtr->scene.reset();
   this->dataPtr->originalTransparency.clear();
   this->dataPtr->originalDepthWrite.clear();
+  this->dataPtr->sharedMaterialSet.clear();
+}
+
+/////////////////////////////////////////////////
+void SceneManager::SetShareMaterials(bool _share)
+{
+  this->dataPtr->shareMaterials = _share;
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::IsSharedMaterial(
+    const rendering::MaterialPtr &_material) const
+{
+  return this->dataPtr->sharedMaterialSet.find(_material) !=
+      this->dataPtr->sharedMaterialSet.end();
+}
+
+/////////////////////////////////////////////////
+std::string SceneManagerPrivate::SharedMaterialKey(
+    const sdf::Visual &_visual, const std::string &_base)
+{
+  return _base + "|" + std::to_string(_visual.Transparency()) + "|" +
+      (_visual.CastShadows() ? "1" : "0");
+}
+
+/////////////////////////////////////////////////
+rendering::MaterialPtr SceneManagerPrivate::SharedMaterial(
+    const std::string &_key)
+{
+  auto material = AssetCache::Instance().AcquireMaterial(this->scene, _key);
+  if (material)
+  {
+    this->sharedMaterialSet.insert(material);
+    this->pendingAssets.emplace_back(AssetType::MATERIAL, _key);
+  }
+  return material;
+}
+
+/////////////////////////////////////////////////
+void SceneManagerPrivate::AddSharedMaterial(const std::string &_key,
+    const rendering::MaterialPtr &_material)
+{
+  AssetCache::Instance().AddMaterial(this->scene, _key, _material);
+  this->sharedMaterialSet.insert(_material);
+  this->pendingAssets.emplace_back(AssetType::MATERIAL, _key);
+}
+
+/////////////////////////////////////////////////
+void SceneManagerPrivate::ReleaseAssets(Entity _id)
+{
+  auto it = this->cachedAssets.find(_id);
+  if (it == this->cachedAssets.end())
+    return;
+  auto &cache = AssetCache::Instance();
+  for (const auto &[type, key] : it->second)
+    cache.Release(this->scene, type, key);
+  this->cachedAssets.erase(it);
+}
+
+/////////////////////////////////////////////////
+void SceneManagerPrivate::ReleaseAllAssets()
+{
+  auto &cache = AssetCache::Instance();
+  for (const auto &[id, assets] : this->cachedAssets)
+  {
+    for (const auto &[type, key] : assets)
+      cache.Release(this->scene, type, key);
+  }
+  for (const auto &[type, key] : this->pendingAssets)
+    cache.Release(this->scene, type, key);
+  this->cachedAssets.clear();
+  this->pendingAssets.clear();
 }
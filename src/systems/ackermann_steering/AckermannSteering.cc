@@ -40,9 +40,11 @@
 #include <gz/transport/Node.hh>
 
 #include "gz/sim/components/Actuators.hh"
+#include "gz/sim/components/AngularVelocityCmd.hh"
 #include "gz/sim/components/CanonicalLink.hh"
 #include "gz/sim/components/JointPosition.hh"
 #include "gz/sim/components/JointVelocityCmd.hh"
+#include "gz/sim/components/LinearVelocityCmd.hh"
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
@@ -98,12 +100,24 @@ class gz::sim::systems::AckermannSteeringPrivate
   public: void UpdateAngle(const UpdateInfo &_info,
     const EntityComponentManager &_ecm);
 
+  /// \brief Apply the commanded velocities to the model in kinematic mode.
+  /// \param[in] _ecm The EntityComponentManager of the given simulation
+  /// instance.
+  public: void ApplyKinematicCommands(EntityComponentManager &_ecm);
+
   /// \brief Gazebo communication node.
   public: transport::Node node;
 
   /// \brief Use angle steer only mode.
   public: bool steeringOnly{false};
 
+  /// \brief True to move the model from the commanded velocities instead of
+  /// commanding the joints.
+  public: bool kinematic{false};
+
+  /// \brief Yaw rate resulting from the commands in kinematic mode.
+  public: double kinematicYawRate{0.0};
+
   /// \brief Entity of the left joint
   public: std::vector<Entity> leftJoints;
 
@@ -322,6 +336,8 @@ void AckermannSteering::Configure(const Entity &_entity,
       this->dataPtr->wheelRadius).first;
     this->dataPtr->kingpinWidth = _sdf->Get<double>("kingpin_width",
       this->dataPtr->kingpinWidth).first;
+    this->dataPtr->kinematic = _sdf->Get<bool>("kinematic",
+      this->dataPtr->kinematic).first;
   }
   this->dataPtr->wheelSeparation = _sdf->Get<double>("wheel_separation",
       this->dataPtr->wheelSeparation).first;
@@ -512,6 +528,14 @@ void AckermannSteering::PreUpdate(const UpdateInfo &_info,
         << "s]. System may not work properly." << std::endl;
   }
 
+  // The joints aren't needed in kinematic mode
+  if (this->dataPtr->kinematic)
+  {
+    if (!_info.paused)
+      this->dataPtr->ApplyKinematicCommands(_ecm);
+    return;
+  }
+
   // If the joints haven't been identified yet, look for them
   static std::set<std::string> warnedModels;
   auto modelName = this->dataPtr->model.Name(_ecm);
@@ -696,47 +720,60 @@ void AckermannSteeringPrivate::UpdateOdometry(
   GZ_PROFILE("AckermannSteering::UpdateOdometry");
   // Initialize, if not already initialized.
 
-  if (this->leftJoints.empty() || this->rightJoints.empty() ||
-      this->leftSteeringJoints.empty() || this->rightSteeringJoints.empty())
-    return;
-
-  // Get the first joint positions for the left and right side.
-  auto leftPos = _ecm.Component<components::JointPosition>(this->leftJoints[0]);
-  auto rightPos = _ecm.Component<components::JointPosition>(
-      this->rightJoints[0]);
-  auto leftSteeringPos = _ecm.Component<components::JointPosition>(
-      this->leftSteeringJoints[0]);
-  auto rightSteeringPos = _ecm.Component<components::JointPosition>(
-      this->rightSteeringJoints[0]);
-
-  // Abort if the joints were not found or just created.
-  if (!leftPos || !rightPos || leftPos->Data().empty() ||
-      rightPos->Data().empty() ||
-      !leftSteeringPos || !rightSteeringPos ||
-      leftSteeringPos->Data().empty() ||
-      rightSteeringPos->Data().empty())
+  auto odomTimeDiff = _info.simTime - this->lastOdomTime;
+  double tdiff = std::chrono::duration<double>(odomTimeDiff).count();
+  double dist;
+  double deltaAngle;
+  if (this->kinematic)
   {
-    return;
+    // Integrate the commands applied during the last step
+    dist = this->last0Cmd.lin * tdiff;
+    deltaAngle = this->kinematicYawRate * tdiff;
   }
+  else
+  {
+    if (this->leftJoints.empty() || this->rightJoints.empty() ||
+        this->leftSteeringJoints.empty() || this->rightSteeringJoints.empty())
+      return;
 
-  // Calculate the odometry
-  double phi = 0.5 * (leftSteeringPos->Data()[0] + rightSteeringPos->Data()[0]);
-  double radius = this->wheelBase / tan(phi);
-  double dist = 0.5 * this->wheelRadius *
-      ((leftPos->Data()[0] - this->odomOldLeft) +
-       (rightPos->Data()[0] - this->odomOldRight));
-  double deltaAngle = dist / radius;
+    // Get the first joint positions for the left and right side.
+    auto leftPos = _ecm.Component<components::JointPosition>(
+        this->leftJoints[0]);
+    auto rightPos = _ecm.Component<components::JointPosition>(
+        this->rightJoints[0]);
+    auto leftSteeringPos = _ecm.Component<components::JointPosition>(
+        this->leftSteeringJoints[0]);
+    auto rightSteeringPos = _ecm.Component<components::JointPosition>(
+        this->rightSteeringJoints[0]);
+
+    // Abort if the joints were not found or just created.
+    if (!leftPos || !rightPos || leftPos->Data().empty() ||
+        rightPos->Data().empty() ||
+        !leftSteeringPos || !rightSteeringPos ||
+        leftSteeringPos->Data().empty() ||
+        rightSteeringPos->Data().empty())
+    {
+      return;
+    }
+
+    // Calculate the odometry
+    double phi =
+        0.5 * (leftSteeringPos->Data()[0] + rightSteeringPos->Data()[0]);
+    double radius = this->wheelBase / tan(phi);
+    dist = 0.5 * this->wheelRadius *
+        ((leftPos->Data()[0] - this->odomOldLeft) +
+         (rightPos->Data()[0] - this->odomOldRight));
+    deltaAngle = dist / radius;
+    this->odomOldLeft = leftPos->Data()[0];
+    this->odomOldRight = rightPos->Data()[0];
+  }
   this->odomYaw += deltaAngle;
   this->odomYaw = math::Angle(this->odomYaw).Normalized().Radian();
   this->odomX += dist * cos(this->odomYaw);
   this->odomY += dist * sin(this->odomYaw);
-  auto odomTimeDiff = _info.simTime - this->lastOdomTime;
-  double tdiff = std::chrono::duration<double>(odomTimeDiff).count();
   double odomLinearVelocity = dist / tdiff;
   double odomAngularVelocity = deltaAngle / tdiff;
   this->lastOdomTime = _info.simTime;
-  this->odomOldLeft = leftPos->Data()[0];
-  this->odomOldRight = rightPos->Data()[0];
 
   // Throttle odometry publishing
   auto diff = _info.simTime - this->lastOdomPubTime;
@@ -869,6 +906,14 @@ void AckermannSteeringPrivate::UpdateVelocity(
       (linVel * (1.0 - (this->wheelSeparation * tan(phi)) /
                  (2.0 * this->wheelBase))) / this->wheelRadius;
 
+  // A car can't turn in place, so the yaw rate follows from the linear
+  // velocity and the limited turning radius.
+  if (this->kinematic)
+  {
+    this->kinematicYawRate = linVel / turningRadius;
+    return;
+  }
+
   auto leftSteeringPos = _ecm.Component<components::JointPosition>(
       this->leftSteeringJoints[0]);
   auto rightSteeringPos = _ecm.Component<components::JointPosition>(
@@ -891,6 +936,20 @@ void AckermannSteeringPrivate::UpdateVelocity(
   this->rightSteeringJointSpeed = this->gainPAng * rightDelta;
 }
 
+//////////////////////////////////////////////////
+void AckermannSteeringPrivate::ApplyKinematicCommands(
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("AckermannSteering::ApplyKinematicCommands");
+
+  // Velocity commands are expressed in the model frame and are reset by
+  // physics after every step, so they are set on every iteration.
+  _ecm.SetComponentData<components::LinearVelocityCmd>(
+      this->model.Entity(), {this->last0Cmd.lin, 0, 0});
+  _ecm.SetComponentData<components::AngularVelocityCmd>(
+      this->model.Entity(), {0, 0, this->kinematicYawRate});
+}
+
 //////////////////////////////////////////////////
 void AckermannSteeringPrivate::OnCmdVel(const msgs::Twist &_msg)
 {
@@ -88,6 +88,14 @@ namespace systems
   /// although it is recommended to be included with an appropriate value. The
   /// default value is 0.2m.
   ///
+  /// - `<kinematic>`: If true, the wheel and steering joints aren't
+  /// commanded. Instead, the commanded linear velocity and the yaw rate it
+  /// produces at the limited turning radius are applied directly to the model
+  /// as velocity commands, skipping the wheel dynamics, and odometry is
+  /// integrated from them. This is cheaper to simulate for large fleets, and
+  /// the joints don't need to exist. Ignored in steering only mode. The
+  /// default value is false.
+  ///
   /// - `<odom_publish_frequency>`: Odometry publication frequency. This
   /// element is optional, and the default value is 50Hz.
   ///
@@ -55,6 +55,18 @@ class AcousticComms::Implementation
           <std::shared_ptr<msgs::Dataframe>, math::Vector3d>
           poseSrcAtMsgTimestamp;
 
+  /// \brief World position of the endpoints looked up during the current
+  /// step. Messages in transit are checked every step, so this avoids
+  /// looking up the pose of a receiver once per message.
+  public: std::unordered_map<Entity, math::Vector3d> positions;
+
+  /// \brief Get the world position of an endpoint in the current step.
+  /// \param[in] _entity Entity the endpoint is attached to.
+  /// \param[in] _ecm Entity component manager.
+  /// \return The world position.
+  public: const math::Vector3d &Position(const Entity _entity,
+                                         const EntityComponentManager &_ecm);
+
   /// \brief Map that holds data of the address of a receiver,
   /// the timestamp, length of the last message recevied by it.
   public: std::unordered_map
@@ -134,6 +146,19 @@ bool AcousticComms::Implementation::propagationModel(
   return randDraw > packetDropProb;
 }
 
+//////////////////////////////////////////////////
+const math::Vector3d &AcousticComms::Implementation::Position(
+    const Entity _entity, const EntityComponentManager &_ecm)
+{
+  auto it = this->positions.find(_entity);
+  if (it == this->positions.end())
+  {
+    it = this->positions.emplace(_entity,
+        worldPose(_entity, _ecm).Pos()).first;
+  }
+  return it->second;
+}
+
 //////////////////////////////////////////////////
 AcousticComms::AcousticComms()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -185,6 +210,11 @@ void AcousticComms::Step(
     comms::Registry &_newRegistry,
     EntityComponentManager &_ecm)
 {
+  GZ_PROFILE("AcousticComms::Step");
+
+  // Positions are looked up again as the endpoints move.
+  this->dataPtr->positions.clear();
+
   // Initialize entity if needed.
   for (auto & [address, content] : _currentRegistry)
   {
@@ -241,22 +271,6 @@ void AcousticComms::Step(
         // If it has reached neither the destination nor the maxRange,
         // it is considered in transit.
 
-        if (this->dataPtr->poseSrcAtMsgTimestamp.count(msg) == 0)
-        {
-          // This message is being processed for the first time.
-          // Record the current position of the sender and use it
-          // for distance calculations.
-          this->dataPtr->poseSrcAtMsgTimestamp[msg] =
-            worldPose(itSrc->second.entity, _ecm).Pos();
-        }
-
-        const auto& poseSrc =
-          this->dataPtr->poseSrcAtMsgTimestamp[msg];
-
-        // Calculate distance between the bodies.
-        const auto poseDst = worldPose(itDst->second.entity, _ecm).Pos();
-        const auto distanceToTransmitter = (poseSrc - poseDst).Length();
-
         // Calculate distance covered by the message.
         const std::chrono::steady_clock::time_point currTime(_info.simTime);
         const auto timeOfTransmission = msg->mutable_header()->stamp();
@@ -272,9 +286,27 @@ void AcousticComms::Step(
         const double distanceCoveredByMessage = deltaT.count() *
           this->dataPtr->speedOfSound;
 
-        // Check the msgs that haven't exceeded the maxRange.
+        // Check the msgs that haven't exceeded the maxRange. Messages
+        // beyond it are dropped before looking up any position.
         if (distanceCoveredByMessage <= this->dataPtr->maxRange)
         {
+          auto itPoseSrc = this->dataPtr->poseSrcAtMsgTimestamp.find(msg);
+          if (itPoseSrc == this->dataPtr->poseSrcAtMsgTimestamp.end())
+          {
+            // This message is being processed for the first time.
+            // Record the current position of the sender and use it
+            // for distance calculations.
+            itPoseSrc = this->dataPtr->poseSrcAtMsgTimestamp.emplace(msg,
+                this->dataPtr->Position(itSrc->second.entity, _ecm)).first;
+          }
+
+          const auto &poseSrc = itPoseSrc->second;
+
+          // Calculate distance between the bodies.
+          const auto &poseDst =
+            this->dataPtr->Position(itDst->second.entity, _ecm);
+          const auto distanceToTransmitter = (poseSrc - poseDst).Length();
+
           if (distanceCoveredByMessage >= distanceToTransmitter)
           {
             // This message has effectively reached the destination.
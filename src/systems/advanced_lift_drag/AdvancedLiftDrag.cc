@@ -35,7 +35,11 @@
 #include "AdvancedLiftDrag.hh"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
 
@@ -60,11 +64,69 @@
 #include "gz/sim/components/ExternalWorldWrenchCmd.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Wind.hh"
+#include "gz/sim/components/World.hh"
 
 using namespace gz;
 using namespace sim;
 using namespace systems;
 
+/// \brief Aircraft simulated by the advanced lift drag systems of a world,
+/// so that a world-level instance can update all of them together.
+struct AdvancedLiftDragRegistry
+{
+  /// \brief Protects aircraft.
+  std::mutex mutex;
+
+  /// \brief Data of the registered systems.
+  std::vector<AdvancedLiftDragPrivate *> aircraft;
+
+  /// \brief True while a world-level instance updates the aircraft.
+  std::atomic<bool> batched{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the registry of the world simulated by an ECM.
+/// \param[in] _ecm The Entity Component Manager
+/// \return The registry, shared by the systems of that world.
+std::shared_ptr<AdvancedLiftDragRegistry> registryFor(
+    const EntityComponentManager &_ecm)
+{
+  static std::mutex mutex;
+  static std::unordered_map<const EntityComponentManager *,
+      std::weak_ptr<AdvancedLiftDragRegistry>> registries;
+
+  std::lock_guard lock(mutex);
+  for (auto it = registries.begin(); it != registries.end();)
+  {
+    if (it->second.expired())
+      it = registries.erase(it);
+    else
+      ++it;
+  }
+
+  auto &weak = registries[&_ecm];
+  auto registry = weak.lock();
+  if (!registry)
+  {
+    registry = std::make_shared<AdvancedLiftDragRegistry>();
+    weak = registry;
+  }
+  return registry;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the velocity of the wind, if the world has wind.
+/// \param[in] _ecm The Entity Component Manager
+/// \return The velocity, or nullptr.
+const components::WorldLinearVelocity *worldWind(
+    const EntityComponentManager &_ecm)
+{
+  Entity windEntity = _ecm.EntityByComponents(components::Wind());
+  if (windEntity == kNullEntity)
+    return nullptr;
+  return _ecm.Component<components::WorldLinearVelocity>(windEntity);
+}
+
 class gz::sim::systems::AdvancedLiftDragPrivate
 {
   // Initialize the system
@@ -74,7 +136,17 @@ class gz::sim::systems::AdvancedLiftDragPrivate
   /// \brief Initializes lift and drag forces in order to later
   /// update the corresponding components
   /// \param[in] _ecm Immutable reference to the EntityComponentManager
-  public: void Update(EntityComponentManager &_ecm);
+  /// \param[in] _wind Velocity of the wind, or nullptr without wind
+  public: void Update(EntityComponentManager &_ecm,
+                      const components::WorldLinearVelocity *_wind);
+
+  /// \brief Update all the registered aircraft, looking the wind up once.
+  /// Called on the world-level instance.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager
+  public: void UpdateAll(EntityComponentManager &_ecm);
+
+  /// \brief Destructor, which unregisters the aircraft.
+  public: ~AdvancedLiftDragPrivate();
 
   /// \brief Compute Control Surface effects
   /// \param[in] _ecm Immutable reference to the EntityComponentManager
@@ -286,8 +358,45 @@ class gz::sim::systems::AdvancedLiftDragPrivate
 
   /// \brief Initialization flag
   public: bool initialized{false};
+
+  /// \brief Registry of the aircraft of the world.
+  public: std::shared_ptr<AdvancedLiftDragRegistry> registry;
+
+  /// \brief True if the system is attached to the world rather than to a
+  /// model.
+  public: bool worldLevel{false};
+
+  /// \brief True if this world-level instance updates the aircraft.
+  public: bool batching{false};
 };
 
+//////////////////////////////////////////////////
+AdvancedLiftDragPrivate::~AdvancedLiftDragPrivate()
+{
+  if (!this->registry)
+    return;
+  if (this->batching)
+    this->registry->batched = false;
+
+  std::lock_guard lock(this->registry->mutex);
+  auto &aircraft = this->registry->aircraft;
+  aircraft.erase(std::remove(aircraft.begin(), aircraft.end(), this),
+      aircraft.end());
+}
+
+//////////////////////////////////////////////////
+void AdvancedLiftDragPrivate::UpdateAll(EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("AdvancedLiftDragPrivate::UpdateAll");
+  const auto wind = worldWind(_ecm);
+  std::lock_guard lock(this->registry->mutex);
+  for (auto *aircraft : this->registry->aircraft)
+  {
+    if (aircraft->validConfig)
+      aircraft->Update(_ecm, wind);
+  }
+}
+
 //////////////////////////////////////////////////
 void AdvancedLiftDragPrivate::Load(const EntityComponentManager &_ecm,
                            const sdf::ElementPtr &_sdf)
@@ -471,7 +580,8 @@ AdvancedLiftDrag::AdvancedLiftDrag()
 }
 
 //////////////////////////////////////////////////
-void AdvancedLiftDragPrivate::Update(EntityComponentManager &_ecm)
+void AdvancedLiftDragPrivate::Update(EntityComponentManager &_ecm,
+    const components::WorldLinearVelocity *_wind)
 {
   GZ_PROFILE("AdvancedLiftDragPrivate::Update");
   // get linear velocity at cp in world frame
@@ -483,12 +593,7 @@ void AdvancedLiftDragPrivate::Update(EntityComponentManager &_ecm)
       _ecm.Component<components::WorldPose>(this->linkEntity);
 
   // get wind as a component from the _ecm
-  components::WorldLinearVelocity *windLinearVel = nullptr;
-  if(_ecm.EntityByComponents(components::Wind()) != kNullEntity){
-    Entity windEntity = _ecm.EntityByComponents(components::Wind());
-    windLinearVel =
-        _ecm.Component<components::WorldLinearVelocity>(windEntity);
-  }
+  const auto windLinearVel = _wind;
 
   std::vector<components::JointPosition*> controlJointPosition_vec(
     this->num_ctrl_surfaces);
@@ -782,6 +887,23 @@ void AdvancedLiftDrag::Configure(const Entity &_entity,
                          const std::shared_ptr<const sdf::Element> &_sdf,
                          EntityComponentManager &_ecm, EventManager &)
 {
+  this->dataPtr->registry = registryFor(_ecm);
+
+  // Attached to the world, the system updates the aircraft of all the
+  // model-level instances together
+  if (nullptr != _ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->worldLevel = true;
+    if (this->dataPtr->registry->batched.exchange(true))
+    {
+      gzwarn << "Advanced LiftDrag is already attached to the world, "
+             << "ignoring this instance." << std::endl;
+      return;
+    }
+    this->dataPtr->batching = true;
+    return;
+  }
+
   this->dataPtr->model = Model(_entity);
   if (!this->dataPtr->model.Valid(_ecm))
   {
@@ -798,6 +920,13 @@ void AdvancedLiftDrag::PreUpdate(const UpdateInfo &_info,
 {
   GZ_PROFILE("AdvancedLiftDrag::PreUpdate");
 
+  if (this->dataPtr->worldLevel)
+  {
+    if (this->dataPtr->batching && !_info.paused)
+      this->dataPtr->UpdateAll(_ecm);
+    return;
+  }
+
   // \TODO(anyone) Support rewind
   if (_info.dt < std::chrono::steady_clock::duration::zero())
   {
@@ -828,10 +957,14 @@ void AdvancedLiftDrag::PreUpdate(const UpdateInfo &_info,
                 components::JointPosition());
           }
       }
+
+      std::lock_guard lock(this->dataPtr->registry->mutex);
+      this->dataPtr->registry->aircraft.push_back(this->dataPtr.get());
     }
   }
 
-  if (_info.paused)
+  // The world-level instance updates the aircraft
+  if (_info.paused || this->dataPtr->registry->batched)
     return;
 
   // This is not an "else" because "initialized" can be set in the if block
@@ -839,7 +972,7 @@ void AdvancedLiftDrag::PreUpdate(const UpdateInfo &_info,
   if (this->dataPtr->initialized && this->dataPtr->validConfig)
   {
 
-    this->dataPtr->Update(_ecm);
+    this->dataPtr->Update(_ecm, worldWind(_ecm));
   }
 }
 
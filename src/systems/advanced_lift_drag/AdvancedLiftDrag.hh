@@ -122,6 +122,12 @@ namespace systems
   /// - `<CD_fp_k1>`: The first of the flat plate drag model coefficients
   /// - `<CD_fp_k2>`: The second of the flat plate drag model coefficients
   /// - `<sdfConfig>`: Copy of the sdf configuration used for this plugin
+  ///
+  /// ## World-level evaluation
+  ///
+  /// Attached to the world, without parameters, the system updates the
+  /// aircraft of all the model-level instances in one place, looking the
+  /// wind up once per step instead of once per aircraft.
 
   class AdvancedLiftDrag
       : public System,
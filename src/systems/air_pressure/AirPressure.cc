@@ -43,6 +43,8 @@
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -54,6 +56,9 @@ class gz::sim::systems::AirPressurePrivate
   public: std::unordered_map<Entity,
       std::unique_ptr<sensors::AirPressureSensor>> entitySensorMap;
 
+  /// \brief Air pressure sensors that need data at the current step.
+  public: DueSensors<sensors::AirPressureSensor> dueSensors;
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -80,9 +85,13 @@ class gz::sim::systems::AirPressurePrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update air pressure sensor data based on physics data
+  /// \brief Update air pressure sensor data based on physics data. This
+  /// may be called concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void UpdateAirPressures(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the air pressure sensor
+  /// \param[in] _sensor Air pressure sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::AirPressureSensor &_sensor);
 
   /// \brief Remove air pressure sensors if their entities have been removed
   /// from simulation.
@@ -140,30 +149,17 @@ void AirPressure::PostUpdate(const UpdateInfo &_info,
 
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
+    // we only update sensors that need data and have subscribers.
     // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the AirPressurePrivate::UpdatePressures function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->UpdateAirPressures(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // to avoid doing work in the AirPressurePrivate::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime))
     {
-      // Update measurement time
-      it.second->Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::AirPressureSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          });
     }
   }
 
@@ -246,28 +242,12 @@ void AirPressurePrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void AirPressurePrivate::UpdateAirPressures(const EntityComponentManager &_ecm)
+void AirPressurePrivate::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::AirPressureSensor &_sensor)
 {
-  GZ_PROFILE("AirPressurePrivate::UpdateAirPressures");
-  _ecm.Each<components::AirPressureSensor, components::WorldPose>(
-    [&](const Entity &_entity,
-        const components::AirPressureSensor *,
-        const components::WorldPose *_worldPose)->bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          const math::Pose3d &worldPose = _worldPose->Data();
-          it->second->SetPose(worldPose);
-        }
-        else
-        {
-          gzerr << "Failed to update air pressure: " << _entity << ". "
-                 << "Entity not found." << std::endl;
-        }
-
-        return true;
-      });
+  auto worldPose = _ecm.Component<components::WorldPose>(_entity);
+  if (nullptr != worldPose)
+    _sensor.SetPose(worldPose->Data());
 }
 
 //////////////////////////////////////////////////
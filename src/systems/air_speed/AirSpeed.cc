@@ -43,6 +43,8 @@
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -54,6 +56,9 @@ class gz::sim::systems::AirSpeedPrivate
   public: std::unordered_map<Entity,
       std::unique_ptr<sensors::AirSpeedSensor>> entitySensorMap;
 
+  /// \brief Air speed sensors that need data at the current step.
+  public: DueSensors<sensors::AirSpeedSensor> dueSensors;
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -82,9 +87,13 @@ class gz::sim::systems::AirSpeedPrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update air speed sensor data based on physics data
+  /// \brief Update air speed sensor data based on physics data. This may
+  /// be called concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void UpdateAirSpeeds(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the air speed sensor
+  /// \param[in] _sensor Air speed sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::AirSpeedSensor &_sensor);
 
   /// \brief Remove air speed sensors if their entities have been removed
   /// from simulation.
@@ -142,30 +151,17 @@ void AirSpeed::PostUpdate(const UpdateInfo &_info,
 
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
+    // we only update sensors that need data and have subscribers.
     // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the AirSpeedPrivate::UpdateSpeeds function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->UpdateAirSpeeds(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // to avoid doing work in the AirSpeedPrivate::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime))
     {
-      // Update measurement time
-      it.second->Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::AirSpeedSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          });
     }
   }
 
@@ -249,31 +245,17 @@ void AirSpeedPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void AirSpeedPrivate::UpdateAirSpeeds(const EntityComponentManager &_ecm)
+void AirSpeedPrivate::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::AirSpeedSensor &_sensor)
 {
-  GZ_PROFILE("AirSpeedPrivate::UpdateAirSpeeds");
-  _ecm.Each<components::AirSpeedSensor, components::WorldPose>(
-    [&](const Entity &_entity,
-        const components::AirSpeedSensor *,
-        const components::WorldPose *_worldPose)->bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          const math::Pose3d &worldPose = _worldPose->Data();
-          it->second->SetPose(worldPose);
+  auto worldPose = _ecm.Component<components::WorldPose>(_entity);
+  if (nullptr == worldPose)
+    return;
 
-          math::Vector3d sensorRelativeVel = relativeVel(_entity, _ecm);
-          it->second->SetVelocity(sensorRelativeVel);
-        }
-        else
-        {
-          gzerr << "Failed to update air speed: " << _entity << ". "
-                 << "Entity not found." << std::endl;
-        }
+  _sensor.SetPose(worldPose->Data());
 
-        return true;
-      });
+  math::Vector3d sensorRelativeVel = relativeVel(_entity, _ecm);
+  _sensor.SetVelocity(sensorRelativeVel);
 }
 
 //////////////////////////////////////////////////
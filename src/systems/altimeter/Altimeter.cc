@@ -19,6 +19,8 @@
 
 #include <gz/msgs/altimeter.pb.h>
 
+#include <chrono>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -42,9 +44,13 @@
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+#include "../../SensorBatches.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -56,6 +62,12 @@ class gz::sim::systems::AltimeterPrivate
   public: std::unordered_map<Entity,
       std::unique_ptr<sensors::AltimeterSensor>> entitySensorMap;
 
+  /// \brief Altimeter sensors that need data at the current step.
+  public: DueSensors<sensors::AltimeterSensor> dueSensors;
+
+  /// \brief Batched publication of the readings.
+  public: SensorBatches batches{"altimeter"};
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -82,9 +94,22 @@ class gz::sim::systems::AltimeterPrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update altimeter sensor data based on physics data
+  /// \brief Update altimeter sensor data based on physics data. This may
+  /// be called concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void UpdateAltimeters(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the altimeter
+  /// \param[in] _sensor Altimeter sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::AltimeterSensor &_sensor);
+
+  /// \brief Add the readings of a sensor to its batch. This may be
+  /// called concurrently for different sensors.
+  /// \param[in] _entity Entity of the sensor
+  /// \param[in] _sensor Sensor that was just updated.
+  /// \param[in] _simTime Current simulation time.
+  public: void AddToBatch(const Entity _entity,
+    sensors::AltimeterSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime);
 
   /// \brief Remove altimeter sensors if their entities have been removed from
   /// simulation.
@@ -100,6 +125,15 @@ Altimeter::Altimeter() : System(), dataPtr(std::make_unique<AltimeterPrivate>())
 //////////////////////////////////////////////////
 Altimeter::~Altimeter() = default;
 
+//////////////////////////////////////////////////
+void Altimeter::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->batches.Load(_sdf);
+}
+
 //////////////////////////////////////////////////
 void Altimeter::PreUpdate(const UpdateInfo &/*_info*/,
     EntityComponentManager &_ecm)
@@ -141,30 +175,32 @@ void Altimeter::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the AltimeterPrivate::UpdateAltimeters function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
+    std::function<bool(Entity)> batchConnections;
+    std::function<void(Entity, sensors::AltimeterSensor &)> updated;
+    if (this->dataPtr->batches.Enabled())
     {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
+      batchConnections = [&](const Entity _entity)
+      {
+        return this->dataPtr->batches.HasConnections(_entity);
+      };
+      updated = [&](const Entity _entity, sensors::AltimeterSensor &_sensor)
       {
-        needsUpdate = true;
-        break;
-      }
+        this->dataPtr->AddToBatch(_entity, _sensor, _info.simTime);
+      };
     }
-    if (!needsUpdate)
-      return;
 
-    this->dataPtr->UpdateAltimeters(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // we only update sensors that need data and have subscribers.
+    // note: gz-sensors does its own throttling. Here the check is mainly
+    // to avoid doing work in the AltimeterPrivate::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime, batchConnections))
     {
-      // Update measurement time
-      it.second->Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::AltimeterSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          }, updated);
+      this->dataPtr->batches.Publish(_info.simTime);
     }
   }
 
@@ -211,6 +247,7 @@ void AltimeterPrivate::AddAltimeter(
   sensor->SetVerticalReference(verticalReference);
   sensor->SetPosition(verticalReference);
 
+  this->batches.AddSensor(_ecm, _entity, sensor->Name(), data.UpdateRate());
   this->entitySensorMap.insert(
       std::make_pair(_entity, std::move(sensor)));
   this->newSensors.insert(_entity);
@@ -248,31 +285,30 @@ void AltimeterPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void AltimeterPrivate::UpdateAltimeters(const EntityComponentManager &_ecm)
+void AltimeterPrivate::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::AltimeterSensor &_sensor)
 {
-  GZ_PROFILE("Altimeter::UpdateAltimeters");
-  _ecm.Each<components::Altimeter, components::WorldPose,
-            components::WorldLinearVelocity>(
-    [&](const Entity &_entity,
-        const components::Altimeter * /*_altimeter*/,
-        const components::WorldPose *_worldPose,
-        const components::WorldLinearVelocity *_worldLinearVel)->bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          math::Pose3d worldPose = _worldPose->Data();
-          it->second->SetPosition(worldPose.Pos().Z());
-          it->second->SetVerticalVelocity(_worldLinearVel->Data().Z());
-        }
-        else
-        {
-          gzerr << "Failed to update altimeter: " << _entity << ". "
-                 << "Entity not found." << std::endl;
-        }
+  auto worldPose = _ecm.Component<components::WorldPose>(_entity);
+  auto worldLinearVel =
+      _ecm.Component<components::WorldLinearVelocity>(_entity);
+  if (nullptr == worldPose || nullptr == worldLinearVel)
+    return;
 
-        return true;
-      });
+  _sensor.SetPosition(worldPose->Data().Pos().Z());
+  _sensor.SetVerticalVelocity(worldLinearVel->Data().Z());
+}
+
+//////////////////////////////////////////////////
+void AltimeterPrivate::AddToBatch(const Entity _entity,
+    sensors::AltimeterSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  msgs::Altimeter msg;
+  *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(_simTime);
+  msg.set_vertical_position(_sensor.VerticalPosition());
+  msg.set_vertical_velocity(_sensor.VerticalVelocity());
+  msg.set_vertical_reference(_sensor.VerticalReference());
+  this->batches.SetMessage(_entity, msg);
 }
 
 //////////////////////////////////////////////////
@@ -293,12 +329,14 @@ void AltimeterPrivate::RemoveAltimeterEntities(
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->batches.RemoveSensor(_entity);
 
         return true;
       });
 }
 
 GZ_ADD_PLUGIN(Altimeter, System,
+  Altimeter::ISystemConfigure,
   Altimeter::ISystemPreUpdate,
   Altimeter::ISystemPostUpdate
 )
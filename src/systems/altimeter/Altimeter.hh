@@ -35,8 +35,17 @@ namespace systems
   /// \class Altimeter Altimeter.hh gz/sim/systems/Altimeter.hh
   /// \brief An altimeter sensor that reports vertical position and velocity
   /// readings over gz transport
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<batch_publish>`: Optional. `world` or `model` to also publish the
+  ///   readings of all altimeters of the world, or of each top level model, as
+  ///   one msgs::Dataframe per update rate and step on `<world or model scoped
+  ///   name>/altimeter_batch/<rate>hz`. The altimeters keep publishing on their
+  ///   own topics.
   class Altimeter:
     public System,
+    public ISystemConfigure,
     public ISystemPreUpdate,
     public ISystemPostUpdate
   {
@@ -46,6 +55,12 @@ namespace systems
     /// \brief Destructor
     public: ~Altimeter() override;
 
+    /// Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
     /// Documentation inherited
     public: void PreUpdate(const UpdateInfo &_info,
                            EntityComponentManager &_ecm) final;
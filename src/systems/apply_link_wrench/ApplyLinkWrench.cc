@@ -283,7 +283,8 @@ void ApplyLinkWrench::PreUpdate(const UpdateInfo &_info,
       continue;
     }
 
-    link.AddWorldWrench(_ecm, force, torque, offset);
+    link.AddWorldWrench(_ecm, _ecm.Wrenches(), force, torque,
+        offset);
 
     if (this->dataPtr->verbose)
     {
@@ -308,7 +309,8 @@ void ApplyLinkWrench::PreUpdate(const UpdateInfo &_info,
       // an entity is inserted
       continue;
     }
-    link.AddWorldWrench(_ecm, force, torque, offset);
+    link.AddWorldWrench(_ecm, _ecm.Wrenches(), force, torque,
+        offset);
   }
 }
 
@@ -22,9 +22,14 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <gz/common/Battery.hh>
@@ -53,6 +58,58 @@ using namespace gz;
 using namespace sim;
 using namespace systems;
 
+namespace
+{
+/// \brief Total power load requested from each battery of a world through
+/// BatteryPowerLoad components. All the batteries of a world share it, so
+/// the loads are summed in one pass per step instead of each battery
+/// visiting all loads.
+class PowerLoadIndex
+{
+  /// \brief Get the total load of a battery, summing the loads of all
+  /// batteries first if it wasn't done yet on this iteration. It can be
+  /// called concurrently by all batteries.
+  /// \param[in] _info Current update info.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _battery Battery entity.
+  /// \return Sum of the loads on the battery, in Watts.
+  public: double Load(const UpdateInfo &_info,
+              const EntityComponentManager &_ecm, Entity _battery)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    // Iterations don't advance while paused, so loads are summed each time
+    if (!this->built || this->iteration != _info.iterations || _info.paused)
+    {
+      this->built = true;
+      this->iteration = _info.iterations;
+      this->loads.clear();
+      _ecm.Each<components::BatteryPowerLoad>(
+        [&](const Entity &,
+            const components::BatteryPowerLoad *_batteryPowerLoadInfo)->bool
+        {
+          this->loads[_batteryPowerLoadInfo->Data().batteryId] +=
+              _batteryPowerLoadInfo->Data().batteryPowerLoad;
+          return true;
+        });
+    }
+    auto it = this->loads.find(_battery);
+    return it == this->loads.end() ? 0.0 : it->second;
+  }
+
+  /// \brief Protects the loads.
+  private: std::mutex mutex;
+
+  /// \brief True once the loads were summed.
+  private: bool built{false};
+
+  /// \brief Iteration when the loads were summed.
+  private: std::uint64_t iteration{0u};
+
+  /// \brief Total load of each battery entity.
+  private: std::unordered_map<Entity, double> loads;
+};
+}
+
 class gz::sim::systems::LinearBatteryPluginPrivate
 {
   /// \brief Reset the plugin
@@ -178,6 +235,16 @@ class gz::sim::systems::LinearBatteryPluginPrivate
 
   /// \brief Initial power load set trough config
   public: double initialPowerLoad = 0.0;
+
+  /// \brief Power loads of all the batteries of the world.
+  public: std::shared_ptr<PowerLoadIndex> powerLoads;
+
+  /// \brief Period between battery state messages in simulation time, zero
+  /// to publish on every step.
+  public: std::chrono::steady_clock::duration publishPeriod{0};
+
+  /// \brief Simulation time of the last battery state message.
+  public: std::optional<std::chrono::steady_clock::duration> lastPublishTime;
 };
 
 /////////////////////////////////////////////////
@@ -422,6 +489,18 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     return;
   }
 
+  this->dataPtr->powerLoads =
+      _ecm.SystemSharedData<PowerLoadIndex>("LinearBatteryPlugin");
+
+  const double publishRate = _sdf->Get<double>("state_publish_rate",
+      0.0).first;
+  if (publishRate > 0.0)
+  {
+    this->dataPtr->publishPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / publishRate));
+  }
+
   transport::AdvertiseMessageOptions opts;
   opts.SetMsgsPerSec(50);
   this->dataPtr->statePub = this->dataPtr->node.Advertise<msgs::BatteryState>(
@@ -475,25 +554,18 @@ void LinearBatteryPluginPrivate::OnBatteryStopDrainingMsg(
 
 //////////////////////////////////////////////////
 void LinearBatteryPlugin::PreUpdate(
-  const UpdateInfo &/*_info*/,
+  const UpdateInfo &_info,
   EntityComponentManager &_ecm)
 {
   GZ_PROFILE("LinearBatteryPlugin::PreUpdate");
 
   // Recalculate the total power load among consumers
   double total_power_load = this->dataPtr->initialPowerLoad;
-  _ecm.Each<components::BatteryPowerLoad>(
-    [&](const Entity & /*_entity*/,
-        const components::BatteryPowerLoad *_batteryPowerLoadInfo)->bool
-    {
-      if (_batteryPowerLoadInfo->Data().batteryId ==
-          this->dataPtr->batteryEntity)
-      {
-        total_power_load = total_power_load +
-            _batteryPowerLoadInfo->Data().batteryPowerLoad;
-      }
-      return true;
-    });
+  if (this->dataPtr->powerLoads)
+  {
+    total_power_load += this->dataPtr->powerLoads->Load(_info, _ecm,
+        this->dataPtr->batteryEntity);
+  }
 
   bool success = this->dataPtr->battery->SetPowerLoad(
       this->dataPtr->consumerId, total_power_load);
@@ -607,8 +679,22 @@ void LinearBatteryPlugin::PostUpdate(const UpdateInfo &_info,
 {
   GZ_PROFILE("LinearBatteryPlugin::PostUpdate");
   // Nothing left to do if paused or the publisher wasn't created.
-  if (_info.paused || !this->dataPtr->statePub)
+  if (_info.paused || !this->dataPtr->statePub ||
+      !this->dataPtr->statePub.HasConnections())
+  {
+    return;
+  }
+
+  // Throttle in simulation time, restarting after a jump back in time
+  if (this->dataPtr->publishPeriod.count() > 0 &&
+      this->dataPtr->lastPublishTime &&
+      _info.simTime >= *this->dataPtr->lastPublishTime &&
+      _info.simTime - *this->dataPtr->lastPublishTime <
+      this->dataPtr->publishPeriod)
+  {
     return;
+  }
+  this->dataPtr->lastPublishTime = _info.simTime;
 
   // Publish battery state
   msgs::BatteryState msg;
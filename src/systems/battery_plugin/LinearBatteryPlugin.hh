@@ -69,6 +69,14 @@ namespace systems
   /// - `<stop_power_draining_topic>` A topic that is used to stop battery
   ///   discharge. Any message on the specified topic will cause the battery to
   ///   stop draining.
+  /// - `<state_publish_rate>` Maximum rate in Hz, in simulation time, at
+  ///   which the battery state is published. The state is only built and
+  ///   published while it has subscribers. Zero, the default, publishes on
+  ///   every step, limited to 50 messages per second of wall time.
+  ///
+  /// The power loads of all the batteries of a world, set through
+  /// BatteryPowerLoad components, are summed in a single pass per step
+  /// shared by all the plugin instances.
 
   class LinearBatteryPlugin
       : public System,
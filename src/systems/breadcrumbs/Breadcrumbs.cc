@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <iterator>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 #include <gz/common/Profiler.hh>
@@ -74,6 +75,9 @@ void Breadcrumbs::Configure(const Entity &_entity,
   this->allowRenaming =
       _sdf->Get<bool>("allow_renaming", this->allowRenaming).first;
 
+  this->spawnStatic =
+      _sdf->Get<bool>("spawn_static", this->spawnStatic).first;
+
   this->model = Model(_entity);
   if (!this->model.Valid(_ecm))
   {
@@ -198,6 +202,21 @@ void Breadcrumbs::PreUpdate(const UpdateInfo &_info,
 
     auto poseComp = _ecm.Component<components::Pose>(this->model.Entity());
 
+    // Collect the model names once for all the deployments of this step
+    std::unordered_set<std::string> modelNames;
+    if (!cmds.empty())
+    {
+      _ecm.Each<components::Name, components::Model>(
+          [&modelNames](const Entity &, const components::Name *_name,
+                        const components::Model *)
+          {
+            modelNames.insert(_name->Data());
+            return true;
+          });
+    }
+
+    // Spawn all the breadcrumbs of this step in one batch
+    _ecm.BeginBulkInsert(cmds.size());
     for (std::size_t i = 0; i < cmds.size(); ++i)
     {
       if (this->maxDeployments < 0 ||
@@ -207,18 +226,8 @@ void Breadcrumbs::PreUpdate(const UpdateInfo &_info,
         std::string desiredName =
             modelToSpawn.Name() + "_" + std::to_string(this->numDeployments);
 
-        std::vector<std::string> modelNames;
-        _ecm.Each<components::Name, components::Model>(
-            [&modelNames](const Entity &, const components::Name *_name,
-                          const components::Model *)
-            {
-              modelNames.push_back(_name->Data());
-              return true;
-            });
-
         // Check if there's a model with the same name.
-        auto it = std::find(modelNames.begin(), modelNames.end(), desiredName);
-        if (it != modelNames.end())
+        if (modelNames.count(desiredName) > 0u)
         {
           if (!this->allowRenaming)
           {
@@ -226,20 +235,23 @@ void Breadcrumbs::PreUpdate(const UpdateInfo &_info,
                     << "] already exists and "
                     << "[allow_renaming] is false. Entity not spawned."
                     << std::endl;
+            _ecm.EndBulkInsert();
             return;
           }
 
           std::string newName = desiredName;
           int counter = 0;
-          while (std::find(modelNames.begin(), modelNames.end(), newName) !=
-                 modelNames.end())
+          while (modelNames.count(newName) > 0u)
           {
             newName = desiredName + "_" + std::to_string(++counter);
           }
           desiredName = newName;
         }
+        modelNames.insert(desiredName);
 
         modelToSpawn.SetName(desiredName);
+        if (this->spawnStatic)
+          modelToSpawn.SetStatic(true);
         modelToSpawn.SetRawPose(poseComp->Data() * modelToSpawn.RawPose());
         gzmsg << "Deploying " << modelToSpawn.Name() << " at "
                << modelToSpawn.RawPose() << std::endl;
@@ -287,6 +299,7 @@ void Breadcrumbs::PreUpdate(const UpdateInfo &_info,
       remainingMsg.set_data(this->maxDeployments - this->numDeployments);
       this->remainingPub.Publish(remainingMsg);
     }
+    _ecm.EndBulkInsert();
 
     std::set<Entity> processedEntities;
     for (const auto &e : this->pendingGeometryUpdate)
@@ -321,6 +334,7 @@ void Breadcrumbs::PreUpdate(const UpdateInfo &_info,
     }
 
     // make entities static when auto disable period is reached.
+    _ecm.BeginBulkInsert();
     for (auto it = this->autoStaticEntities.begin();
         it != this->autoStaticEntities.end();)
     {
@@ -344,43 +358,40 @@ void Breadcrumbs::PreUpdate(const UpdateInfo &_info,
         ++it;
       }
     }
+    _ecm.EndBulkInsert();
   }
 }
 
 //////////////////////////////////////////////////
 bool Breadcrumbs::MakeStatic(Entity _entity, EntityComponentManager &_ecm)
 {
-  // make breadcrumb static by spawning a static model and attaching the
-  // breadcrumb to the static model
+  // make breadcrumb static by attaching it to a static model. A single
+  // static model is shared by all the breadcrumbs, since the fixed joint
+  // keeps the relative pose the breadcrumb has when it's attached.
   // todo(anyone) Add a feature in gz-physics to support making a model
   // static
-  if (this->staticModelToSpawn.LinkCount() == 0u)
+  if (this->staticLinkEntity == kNullEntity ||
+      !_ecm.HasEntity(this->staticLinkEntity))
   {
     sdf::ElementPtr staticModelSDF(new sdf::Element);
     sdf::initFile("model.sdf", staticModelSDF);
-    staticModelSDF->GetAttribute("name")->Set("static_model");
+    staticModelSDF->GetAttribute("name")->Set(this->model.Name(_ecm) + "_" +
+        this->modelRoot.Model()->Name() + "__static__");
     staticModelSDF->GetElement("static")->Set(true);
     sdf::ElementPtr linkElem = staticModelSDF->AddElement("link");
     linkElem->GetAttribute("name")->Set("static_link");
-    this->staticModelToSpawn.Load(staticModelSDF);
-  }
+    sdf::Model staticModelToSpawn;
+    staticModelToSpawn.Load(staticModelSDF);
 
-  auto bcPoseComp = _ecm.Component<components::Pose>(_entity);
-  if (!bcPoseComp)
-    return false;
-  math::Pose3d p = bcPoseComp->Data();
-  this->staticModelToSpawn.SetRawPose(p);
+    Entity staticEntity = this->creator->CreateEntities(&staticModelToSpawn);
+    this->creator->SetParent(staticEntity, this->worldEntity);
 
-  auto nameComp = _ecm.Component<components::Name>(_entity);
-  this->staticModelToSpawn.SetName(nameComp->Data() + "__static__");
-
-  Entity staticEntity = this->creator->CreateEntities(&staticModelToSpawn);
-  this->creator->SetParent(staticEntity, this->worldEntity);
-
-  Entity parentLinkEntity = _ecm.EntityByComponents(
-      components::Link(), components::ParentEntity(staticEntity),
-      components::Name("static_link"));
+    this->staticLinkEntity = _ecm.EntityByComponents(
+        components::Link(), components::ParentEntity(staticEntity),
+        components::Name("static_link"));
+  }
 
+  Entity parentLinkEntity = this->staticLinkEntity;
   if (parentLinkEntity == kNullEntity)
     return false;
 
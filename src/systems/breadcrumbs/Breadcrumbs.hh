@@ -80,6 +80,11 @@ namespace systems
   /// another model with the same name already exists in the world. If false
   /// and there is another model with the same name, the breadcrumb will not
   /// be deployed. Defaults to false.
+  /// - `<spawn_static>`: If true, the breadcrumbs are static as soon as
+  /// they're deployed, at the pose where they're deployed, instead of being
+  /// simulated first. This is cheaper than `<disable_physics_time>`, which
+  /// attaches each breadcrumb to a static model once the time has passed.
+  /// Defaults to false.
   /// - `<breadcrumb>`: This is the model used as a template for deploying
   /// breadcrumbs.
   /// - `<topic_statistics>`: If true, then topic statistics are enabled on
@@ -144,6 +149,9 @@ namespace systems
     /// same name already exists
     private: bool allowRenaming{false};
 
+    /// \brief Whether the deployed models are static when spawned
+    private: bool spawnStatic{false};
+
     /// \brief Bounding volume of the performer
     private: std::optional<sdf::Geometry> performerGeometry;
 
@@ -164,8 +172,9 @@ namespace systems
     private: std::unordered_map<Entity, std::chrono::steady_clock::duration>
         autoStaticEntities;
 
-    /// \brief SDF DOM of a static model with empty link
-    private: sdf::Model staticModelToSpawn;
+    /// \brief Link of the static model the breadcrumbs are attached to when
+    /// they're made static.
+    private: Entity staticLinkEntity{kNullEntity};
 
     /// \brief Publishes remaining deployments.
     public: transport::Node::Publisher remainingPub;
@@ -16,8 +16,11 @@
  */
 #include <gz/msgs/wrench.pb.h>
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,11 +30,13 @@
 #include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
 #include <gz/common/Profiler.hh>
+#include <gz/common/SubMesh.hh>
 
 #include <gz/plugin/Register.hh>
 
 #include <gz/math/Helpers.hh>
 #include <gz/math/Pose3.hh>
+#include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
 
 #include <gz/msgs/Utility.hh>
@@ -46,12 +51,15 @@
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Volume.hh"
+#include "gz/sim/components/Waves.hh"
 #include "gz/sim/components/World.hh"
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
+#include "gz/sim/WaveField.hh"
 
 #include "Buoyancy.hh"
+#include "SubmergedHull.hh"
 
 using namespace gz;
 using namespace sim;
@@ -82,12 +90,28 @@ class gz::sim::systems::BuoyancyPrivate
   /// \param[in] _shape The collision mesh of a shape. Currently must
   /// be box or sphere.
   /// \param[in] _gravity Gravity acceleration in the world frame.
+  /// \param[in] _surface Height of the waves above the shape, which moves
+  /// all layers up or down.
   /// Updates this->buoyancyForces containing {force, center_of_volume} to be
   /// applied on the link.
   public:
   template<typename T>
   void GradedFluidDensity(
-    const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity);
+    const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity,
+    double _surface = 0.0);
+
+  /// \brief Query the height of the waves above every collision of the
+  /// links with buoyancy, all at once.
+  /// \param[in] _info Simulation update info.
+  /// \param[in] _ecm The Entity Component Manager.
+  public: void UpdateSurface(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
+
+  /// \brief Get the hull of a mesh, loading it the first time.
+  /// \param[in] _mesh Mesh SDF DOM.
+  /// \return The hull, or nullptr if the mesh can't be loaded.
+  public: std::shared_ptr<const buoyancy::SubmergedHull> MeshHull(
+      const sdf::Mesh &_mesh);
 
   /// \brief Check for new links to apply buoyancy forces to. Calculates the
   /// volume and center of volume for every new link and stages them to be
@@ -160,8 +184,88 @@ class gz::sim::systems::BuoyancyPrivate
 
   /// \brief Volumes to be added on the next.
   public: std::unordered_map<Entity, double> volumes;
+
+  /// \brief Hulls of mesh collisions, used by graded buoyancy. Collisions
+  /// whose mesh can't be loaded have a nullptr.
+  public: std::unordered_map<Entity,
+      std::shared_ptr<const buoyancy::SubmergedHull>> hulls;
+
+  /// \brief Hulls of each mesh and scale, shared by their collisions.
+  public: std::unordered_map<std::string,
+      std::shared_ptr<const buoyancy::SubmergedHull>> meshHulls;
+
+  /// \brief Height of the waves above each collision at this step. Empty
+  /// if the world has no waves.
+  public: std::unordered_map<Entity, double> surfaceHeights;
+
+  /// \brief Collisions whose surface is queried, kept between steps to
+  /// reuse their storage.
+  public: std::vector<Entity> surfaceEntities;
+
+  /// \brief Horizontal position of each collision in surfaceEntities.
+  public: std::vector<math::Vector2d> surfacePositions;
+
+  /// \brief Height of the waves above each collision in surfaceEntities.
+  public: std::vector<double> surfaceValues;
 };
 
+//////////////////////////////////////////////////
+/// \brief Compute the volume of a primitive shape below the surface of a
+/// layer.
+/// \param[in] _shape The shape.
+/// \param[in] _pose World pose of the shape.
+/// \param[in] _height Height of the surface.
+/// \param[out] _center Center of the volume, in the frame of the shape.
+/// \return The volume.
+template<typename T>
+static double volumeBelow(const T &_shape, const math::Pose3d &_pose,
+    double _height, std::optional<math::Vector3d> &_center)
+{
+  // TODO(arjo): Transform plane and slice the shape
+  math::Planed plane{math::Vector3d{0, 0, 1}, _height - _pose.Pos().Z()};
+  auto vol = _shape.VolumeBelow(plane);
+  _center.reset();
+  if (vol > 0)
+    _center = _shape.CenterOfVolumeBelow(plane);
+  return vol;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the volume of a hull below the surface of a layer, in a
+/// single pass.
+/// \param[in] _hull The hull.
+/// \param[in] _pose World pose of the collision.
+/// \param[in] _height Height of the surface.
+/// \param[out] _center Center of the volume, in the frame of the collision.
+/// \return The volume.
+static double volumeBelow(const buoyancy::SubmergedHull &_hull,
+    const math::Pose3d &_pose, double _height,
+    std::optional<math::Vector3d> &_center)
+{
+  // The surface, in the frame of the collision
+  const auto normal = _pose.Rot().RotateVectorReverse(math::Vector3d::UnitZ);
+  return _hull.VolumeBelow(
+      math::Planed(normal, _height - _pose.Pos().Z()), _center);
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the center of volume of a primitive shape.
+/// \return The origin of the shape.
+template<typename T>
+static math::Vector3d centerOfVolume(const T &/*_shape*/)
+{
+  return math::Vector3d{0, 0, 0};
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the center of volume of a hull.
+/// \param[in] _hull The hull.
+/// \return The center, in the frame of the collision.
+static math::Vector3d centerOfVolume(const buoyancy::SubmergedHull &_hull)
+{
+  return _hull.CenterOfVolume();
+}
+
 //////////////////////////////////////////////////
 double BuoyancyPrivate::UniformFluidDensity(const math::Pose3d &/*_pose*/) const
 {
@@ -171,7 +275,8 @@ double BuoyancyPrivate::UniformFluidDensity(const math::Pose3d &/*_pose*/) const
 //////////////////////////////////////////////////
 template<typename T>
 void BuoyancyPrivate::GradedFluidDensity(
-  const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity)
+  const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity,
+  double _surface)
 {
   auto prevLayerFluidDensity = this->fluidDensity;
   auto prevLayerVol = 0.0;
@@ -179,9 +284,8 @@ void BuoyancyPrivate::GradedFluidDensity(
 
   for (const auto &[height, currFluidDensity] : this->layers)
   {
-    // TODO(arjo): Transform plane and slice the shape
-    math::Planed plane{math::Vector3d{0, 0, 1}, height - _pose.Pos().Z()};
-    auto vol = _shape.VolumeBelow(plane);
+    std::optional<math::Vector3d> cov;
+    auto vol = volumeBelow(_shape, _pose, height + _surface, cov);
 
     // Short circuit.
     if (vol <= 0)
@@ -190,9 +294,7 @@ void BuoyancyPrivate::GradedFluidDensity(
       continue;
     }
 
-    // Calculate point from which force is applied
-    auto cov = _shape.CenterOfVolumeBelow(plane);
-
+    // Point from which force is applied
     if (!cov.has_value())
     {
       prevLayerFluidDensity = currFluidDensity;
@@ -229,7 +331,7 @@ void BuoyancyPrivate::GradedFluidDensity(
   auto forceMag = - (vol - prevLayerVol) * _gravity * prevLayerFluidDensity;
 
   // Calculate centre of buoyancy
-  auto cov = math::Vector3d{0, 0, 0};
+  auto cov = centerOfVolume(_shape);
   auto cob =
     (cov * vol - centerOfBuoyancy * prevLayerVol) / (vol - prevLayerVol);
   centerOfBuoyancy = cov;
@@ -242,6 +344,43 @@ void BuoyancyPrivate::GradedFluidDensity(
   this->buoyancyForces.push_back(buoyancyAction);
 }
 
+//////////////////////////////////////////////////
+void BuoyancyPrivate::UpdateSurface(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  this->surfaceHeights.clear();
+  auto waves = _ecm.Component<components::Waves>(this->world);
+  if (nullptr == waves || nullptr == waves->Data() ||
+      waves->Data()->Waves().empty())
+  {
+    return;
+  }
+
+  this->surfaceEntities.clear();
+  this->surfacePositions.clear();
+  _ecm.Each<components::Link,
+            components::Volume,
+            components::CenterOfVolume>(
+      [&](const Entity &_entity,
+          const components::Link *,
+          const components::Volume *,
+          const components::CenterOfVolume *) -> bool
+    {
+      for (auto e : _ecm.ChildrenByComponents(_entity, components::Collision()))
+      {
+        const auto position = worldPose(e, _ecm).Pos();
+        this->surfaceEntities.push_back(e);
+        this->surfacePositions.emplace_back(position.X(), position.Y());
+      }
+      return true;
+    });
+
+  waves->Data()->Heights(std::chrono::duration<double>(_info.simTime).count(),
+      this->surfacePositions, this->surfaceValues);
+  for (std::size_t i = 0u; i < this->surfaceEntities.size(); ++i)
+    this->surfaceHeights[this->surfaceEntities[i]] = this->surfaceValues[i];
+}
+
 //////////////////////////////////////////////////
 std::pair<math::Vector3d, math::Vector3d> BuoyancyPrivate::ResolveForces(
   const math::Pose3d &_linkInWorld)
@@ -269,6 +408,60 @@ std::pair<math::Vector3d, math::Vector3d> BuoyancyPrivate::ResolveForces(
   return {force, torque};
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<const buoyancy::SubmergedHull> BuoyancyPrivate::MeshHull(
+    const sdf::Mesh &_mesh)
+{
+  const std::string key = _mesh.FilePath() + "|" + _mesh.Uri() + "|" +
+      _mesh.Submesh() + "|" + std::to_string(_mesh.Scale().X()) + " " +
+      std::to_string(_mesh.Scale().Y()) + " " +
+      std::to_string(_mesh.Scale().Z());
+  auto it = this->meshHulls.find(key);
+  if (it != this->meshHulls.end())
+    return it->second;
+
+  std::vector<math::Vector3d> triangles;
+  const common::Mesh *mesh = loadMesh(_mesh);
+  if (nullptr != mesh)
+  {
+    for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+    {
+      auto subMesh = mesh->SubMeshByIndex(i).lock();
+      if (!subMesh)
+        continue;
+      if (!_mesh.Submesh().empty() && subMesh->Name() != _mesh.Submesh())
+        continue;
+
+      for (unsigned int j = 0; j + 2 < subMesh->IndexCount(); j += 3)
+      {
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const auto index =
+              static_cast<unsigned int>(subMesh->Index(j + k));
+          triangles.push_back(subMesh->Vertex(index) * _mesh.Scale());
+        }
+      }
+    }
+  }
+
+  // Meshes that fail to load are remembered too, so they're only loaded
+  // once
+  std::shared_ptr<const buoyancy::SubmergedHull> result;
+  if (!triangles.empty())
+  {
+    auto hull = std::make_shared<buoyancy::SubmergedHull>(triangles);
+    if (hull->Volume() > 0.0)
+      result = std::move(hull);
+  }
+  if (nullptr == result)
+  {
+    gzwarn << "Mesh [" << _mesh.Uri() << "] has no volume, it will have no "
+           << "graded buoyancy." << std::endl;
+  }
+  this->meshHulls[key] = result;
+  return result;
+}
+
 //////////////////////////////////////////////////
 void BuoyancyPrivate::CheckForNewEntities(const EntityComponentManager &_ecm)
 {
@@ -539,6 +732,12 @@ void Buoyancy::PreUpdate(const UpdateInfo &_info,
     return;
   }
 
+  if (this->dataPtr->buoyancyType
+    == BuoyancyPrivate::BuoyancyType::GRADED_BUOYANCY)
+  {
+    this->dataPtr->UpdateSurface(_info, _ecm);
+  }
+
   _ecm.Each<components::Link,
             components::Volume,
             components::CenterOfVolume>(
@@ -572,7 +771,7 @@ void Buoyancy::PreUpdate(const UpdateInfo &_info,
 
         // Apply the wrench to the link. This wrench is applied in the
         // Physics System.
-        link.AddWorldWrench(_ecm, buoyancy, torque);
+        link.AddWorldWrench(_ecm, _ecm.Wrenches(), buoyancy, torque);
       }
       else if (this->dataPtr->buoyancyType
         == BuoyancyPrivate::BuoyancyType::GRADED_BUOYANCY)
@@ -587,6 +786,10 @@ void Buoyancy::PreUpdate(const UpdateInfo &_info,
             _ecm.Component<components::CollisionElement>(e);
 
           auto pose = worldPose(e, _ecm);
+          auto surfaceIt = this->dataPtr->surfaceHeights.find(e);
+          const double surface =
+            surfaceIt == this->dataPtr->surfaceHeights.end() ?
+            0.0 : surfaceIt->second;
 
           if (!coll)
           {
@@ -600,21 +803,39 @@ void Buoyancy::PreUpdate(const UpdateInfo &_info,
               this->dataPtr->GradedFluidDensity<math::Boxd>(
                 pose,
                 coll->Data().Geom()->BoxShape()->Shape(),
-                gravity->Data());
+                gravity->Data(), surface);
               break;
             case sdf::GeometryType::SPHERE:
               this->dataPtr->GradedFluidDensity<math::Sphered>(
                 pose,
                 coll->Data().Geom()->SphereShape()->Shape(),
-                gravity->Data());
+                gravity->Data(), surface);
               break;
+            case sdf::GeometryType::MESH:
+            {
+              auto &hulls = this->dataPtr->hulls;
+              auto hull = hulls.find(e);
+              if (hull == hulls.end())
+              {
+                hull = hulls.emplace(e, this->dataPtr->MeshHull(
+                    *coll->Data().Geom()->MeshShape())).first;
+              }
+              if (hull->second)
+              {
+                this->dataPtr->GradedFluidDensity<buoyancy::SubmergedHull>(
+                  pose,
+                  *hull->second,
+                  gravity->Data(), surface);
+              }
+              break;
+            }
             default:
             {
               static bool warned{false};
               if (!warned)
               {
-                gzwarn << "Only <box> and <sphere> collisions are supported "
-                  << "by the graded buoyancy option." << std::endl;
+                gzwarn << "Only <box>, <sphere> and <mesh> collisions are "
+                  << "supported by the graded buoyancy option." << std::endl;
                 warned = true;
               }
               break;
@@ -624,7 +845,7 @@ void Buoyancy::PreUpdate(const UpdateInfo &_info,
         auto [force, torque] = this->dataPtr->ResolveForces(linkWorldPose);
         // Apply the wrench to the link. This wrench is applied in the
         // Physics System.
-        link.AddWorldWrench(_ecm, force, torque);
+        link.AddWorldWrench(_ecm, _ecm.Wrenches(), force, torque);
       }
 
       return true;
@@ -637,6 +858,13 @@ void Buoyancy::PostUpdate(
                 const EntityComponentManager &_ecm)
 {
   this->dataPtr->CheckForNewEntities(_ecm);
+
+  _ecm.EachRemoved<components::Collision>(
+      [&](const Entity &_entity, const components::Collision *) -> bool
+      {
+        this->dataPtr->hulls.erase(_entity);
+        return true;
+      });
 }
 
 //////////////////////////////////////////////////
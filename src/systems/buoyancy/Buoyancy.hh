@@ -52,7 +52,12 @@ namespace systems
   /// simulating an open ocean with its surface and under water behaviour. This
   /// mode slices the volume of each collision mesh according to where the water
   /// line is set. When defining a `<graded_buoyancy>` tag, one must also define
-  /// `<default_density>` and `<density_change>` tags.
+  /// `<default_density>` and `<density_change>` tags. Box, sphere and mesh
+  /// collisions are supported. Meshes should be closed hulls; their
+  /// triangles are loaded once per mesh and clipped exactly by each layer,
+  /// taking the orientation of the collision into account. If the Waves
+  /// system adds waves to the world, the layers move up and down with the
+  /// surface above each collision.
   /// * `<default_density>` is the default fluid which the world should be
   /// filled with. [Units: kgm^-3]
   /// * `<density_change>` allows you to define a new layer.
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_BUOYANCY_SUBMERGED_HULL_HH_
+#define GZ_SIM_SYSTEMS_BUOYANCY_SUBMERGED_HULL_HH_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <gz/math/Plane.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::buoyancy
+{
+  /// \brief Closed triangle mesh of a collision, whose volume and center of
+  /// volume below a plane are computed exactly.
+  ///
+  /// The coordinates of the vertices are stored per component, so that the
+  /// loop over the triangles which are entirely below the plane has no
+  /// branches and can be vectorized by the compiler. Only the triangles
+  /// crossing the plane are clipped. The volume is the sum of the signed
+  /// volumes of the tetrahedra joining each triangle to a point on the
+  /// plane, so the cap closing the clipped hull doesn't need to be built.
+  ///
+  /// Hulls are immutable once built, so they can be shared by all the
+  /// collisions using the same mesh.
+  class SubmergedHull
+  {
+    /// \brief Constructor.
+    /// \param[in] _triangles Vertices of the triangles, three per triangle,
+    /// in the frame of the collision. The mesh should be closed, and it may
+    /// be wound either way.
+    public: explicit SubmergedHull(
+                const std::vector<math::Vector3d> &_triangles)
+    {
+      const std::size_t count = _triangles.size() / 3u;
+      for (auto &coordinates : this->components)
+        coordinates.resize(count);
+
+      math::Vector3d min{_triangles.empty() ? math::Vector3d::Zero :
+          _triangles.front()};
+      math::Vector3d max{min};
+      for (std::size_t i = 0u; i < count * 3u; ++i)
+      {
+        const auto &vertex = _triangles[i];
+        for (unsigned int axis = 0u; axis < 3u; ++axis)
+          this->components[(i % 3u) * 3u + axis][i / 3u] = vertex[axis];
+        min.Min(vertex);
+        max.Max(vertex);
+      }
+      this->center = (min + max) * 0.5;
+      this->halfSize = (max - min) * 0.5;
+
+      // Meshes wound inwards have a negative volume
+      this->volume = this->Accumulate(math::Vector3d::Zero, this->centroid);
+      if (this->volume < 0.0)
+      {
+        for (unsigned int axis = 0u; axis < 3u; ++axis)
+          std::swap(this->components[3u + axis], this->components[6u + axis]);
+        this->volume = -this->volume;
+      }
+    }
+
+    /// \brief Get the number of triangles.
+    /// \return Number of triangles.
+    public: std::size_t TriangleCount() const
+    {
+      return this->components[0].size();
+    }
+
+    /// \brief Get the volume of the hull.
+    /// \return The volume.
+    public: double Volume() const
+    {
+      return this->volume;
+    }
+
+    /// \brief Get the center of volume of the hull.
+    /// \return The center, in the frame of the collision.
+    public: math::Vector3d CenterOfVolume() const
+    {
+      return this->centroid;
+    }
+
+    /// \brief Compute the volume of the hull below a plane.
+    /// \param[in] _plane The plane, in the frame of the collision. Below is
+    /// the side opposite to its normal.
+    /// \param[out] _center Center of the volume below the plane, if it's
+    /// not empty.
+    /// \return The volume below the plane.
+    public: double VolumeBelow(const math::Planed &_plane,
+                std::optional<math::Vector3d> &_center) const
+    {
+      _center.reset();
+      const auto &normal = _plane.Normal();
+      const double length = normal.Length();
+      if (length <= 0.0 || this->volume <= 0.0)
+        return 0.0;
+      const math::Vector3d n = normal / length;
+      const double offset = _plane.Offset() / length;
+
+      // Hulls entirely on one side of the plane
+      const double distance = n.Dot(this->center) - offset;
+      const double extent = std::abs(n.X()) * this->halfSize.X() +
+          std::abs(n.Y()) * this->halfSize.Y() +
+          std::abs(n.Z()) * this->halfSize.Z();
+      if (distance - extent >= 0.0)
+        return 0.0;
+      if (distance + extent <= 0.0)
+      {
+        _center = this->centroid;
+        return this->volume;
+      }
+
+      math::Vector3d weightedCenter;
+      const double submerged = this->Clip(n, offset, weightedCenter);
+      if (submerged <= 0.0)
+        return 0.0;
+      _center = weightedCenter;
+      return submerged;
+    }
+
+    /// \brief Compute the volume of the hull below a plane.
+    /// \param[in] _plane The plane, in the frame of the collision.
+    /// \return The volume below the plane.
+    public: double VolumeBelow(const math::Planed &_plane) const
+    {
+      std::optional<math::Vector3d> unused;
+      return this->VolumeBelow(_plane, unused);
+    }
+
+    /// \brief Compute the center of the volume of the hull below a plane.
+    /// \param[in] _plane The plane, in the frame of the collision.
+    /// \return The center, or nullopt if nothing is below the plane.
+    public: std::optional<math::Vector3d> CenterOfVolumeBelow(
+                const math::Planed &_plane) const
+    {
+      std::optional<math::Vector3d> result;
+      this->VolumeBelow(_plane, result);
+      return result;
+    }
+
+    /// \brief Sum the tetrahedra joining all triangles to an apex.
+    /// \param[in] _apex The apex.
+    /// \param[out] _center Center of the volume.
+    /// \return The signed volume.
+    private: double Accumulate(const math::Vector3d &_apex,
+                 math::Vector3d &_center) const
+    {
+      double sum{0.0};
+      math::Vector3d moment;
+      for (std::size_t i = 0u; i < this->TriangleCount(); ++i)
+      {
+        this->AddTetrahedron(_apex, this->Vertex(0u, i), this->Vertex(1u, i),
+            this->Vertex(2u, i), sum, moment);
+      }
+      _center = this->Center(_apex, sum, moment);
+      return sum / 6.0;
+    }
+
+    /// \brief Sum the tetrahedra joining the parts of the triangles below a
+    /// plane to a point on the plane.
+    /// \param[in] _normal Unit normal of the plane.
+    /// \param[in] _offset Offset of the plane along its normal.
+    /// \param[out] _center Center of the volume.
+    /// \return The volume.
+    private: double Clip(const math::Vector3d &_normal, double _offset,
+                 math::Vector3d &_center) const
+    {
+      // The cap closing the clipped hull is on the plane, and so are the
+      // apexes of its tetrahedra, which then have no volume
+      const math::Vector3d apex = _normal * _offset;
+      const std::size_t count = this->TriangleCount();
+      const auto &c = this->components;
+
+      // Triangles entirely below the plane, without branches
+      double sum{0.0};
+      double mx{0.0}, my{0.0}, mz{0.0};
+      for (std::size_t i = 0u; i < count; ++i)
+      {
+        const double ax = c[0][i] - apex.X();
+        const double ay = c[1][i] - apex.Y();
+        const double az = c[2][i] - apex.Z();
+        const double bx = c[3][i] - apex.X();
+        const double by = c[4][i] - apex.Y();
+        const double bz = c[5][i] - apex.Z();
+        const double cx = c[6][i] - apex.X();
+        const double cy = c[7][i] - apex.Y();
+        const double cz = c[8][i] - apex.Z();
+        const double sa = _normal.X() * ax + _normal.Y() * ay +
+            _normal.Z() * az;
+        const double sb = _normal.X() * bx + _normal.Y() * by +
+            _normal.Z() * bz;
+        const double sc = _normal.X() * cx + _normal.Y() * cy +
+            _normal.Z() * cz;
+        const double below = std::max(sa, std::max(sb, sc)) <= 0.0 ? 1.0 : 0.0;
+        const double v = below * (ax * (by * cz - bz * cy) +
+            ay * (bz * cx - bx * cz) + az * (bx * cy - by * cx));
+        sum += v;
+        mx += v * (ax + bx + cx);
+        my += v * (ay + by + cy);
+        mz += v * (az + bz + cz);
+      }
+      math::Vector3d moment{mx, my, mz};
+
+      // Triangles crossing the plane
+      for (std::size_t i = 0u; i < count; ++i)
+      {
+        const std::array<math::Vector3d, 3> p{this->Vertex(0u, i),
+            this->Vertex(1u, i), this->Vertex(2u, i)};
+        const std::array<double, 3> s{_normal.Dot(p[0]) - _offset,
+            _normal.Dot(p[1]) - _offset, _normal.Dot(p[2]) - _offset};
+        const unsigned int belowCount =
+            (s[0] <= 0.0) + (s[1] <= 0.0) + (s[2] <= 0.0);
+        if (belowCount == 0u || belowCount == 3u)
+          continue;
+
+        // Point where the edge from _i to _j crosses the plane
+        auto cross = [&](unsigned int _i, unsigned int _j)
+        {
+          return p[_i] + (p[_j] - p[_i]) * (s[_i] / (s[_i] - s[_j]));
+        };
+
+        // Rotate the vertices, keeping the winding, so that the vertex on
+        // its own side of the plane is first
+        unsigned int first = 0u;
+        while (((s[first] <= 0.0) ? 1u : 2u) != belowCount)
+          ++first;
+        const unsigned int second = (first + 1u) % 3u;
+        const unsigned int third = (first + 2u) % 3u;
+        if (belowCount == 1u)
+        {
+          this->AddTetrahedron(apex, p[first], cross(first, second),
+              cross(first, third), sum, moment);
+        }
+        else
+        {
+          const auto start = cross(first, second);
+          this->AddTetrahedron(apex, start, p[second], p[third], sum,
+              moment);
+          this->AddTetrahedron(apex, start, p[third], cross(third, first),
+              sum, moment);
+        }
+      }
+
+      // The sums are relative to the apex
+      _center = this->Center(math::Vector3d::Zero, sum, moment) + apex;
+      return sum / 6.0;
+    }
+
+    /// \brief Add a tetrahedron to sums of six times the signed volumes and
+    /// of their moments relative to the apex, times 4.
+    /// \param[in] _apex Apex of the tetrahedron.
+    /// \param[in] _a First vertex of the base.
+    /// \param[in] _b Second vertex of the base.
+    /// \param[in] _c Third vertex of the base.
+    /// \param[in,out] _sum Sum of the volumes.
+    /// \param[in,out] _moment Sum of the moments.
+    private: static void AddTetrahedron(const math::Vector3d &_apex,
+                 const math::Vector3d &_a, const math::Vector3d &_b,
+                 const math::Vector3d &_c, double &_sum,
+                 math::Vector3d &_moment)
+    {
+      const auto a = _a - _apex;
+      const auto b = _b - _apex;
+      const auto c = _c - _apex;
+      const double v = a.Dot(b.Cross(c));
+      _sum += v;
+      _moment += (a + b + c) * v;
+    }
+
+    /// \brief Get the center of volume from the sums of AddTetrahedron.
+    /// \param[in] _apex Apex of the tetrahedra.
+    /// \param[in] _sum Sum of the volumes.
+    /// \param[in] _moment Sum of the moments.
+    /// \return The center.
+    private: static math::Vector3d Center(const math::Vector3d &_apex,
+                 double _sum, const math::Vector3d &_moment)
+    {
+      if (std::abs(_sum) <= 0.0)
+        return _apex;
+      return _apex + _moment / (4.0 * _sum);
+    }
+
+    /// \brief Get a vertex.
+    /// \param[in] _corner 0, 1 or 2.
+    /// \param[in] _triangle Index of the triangle.
+    /// \return The vertex.
+    private: math::Vector3d Vertex(unsigned int _corner,
+                 std::size_t _triangle) const
+    {
+      return {this->components[_corner * 3u][_triangle],
+          this->components[_corner * 3u + 1u][_triangle],
+          this->components[_corner * 3u + 2u][_triangle]};
+    }
+
+    /// \brief Coordinates of the vertices: x, y and z of the first vertex of
+    /// each triangle, then of the second and third.
+    private: std::array<std::vector<double>, 9> components;
+
+    /// \brief Center of the bounding box.
+    private: math::Vector3d center;
+
+    /// \brief Half of the size of the bounding box.
+    private: math::Vector3d halfSize;
+
+    /// \brief Volume of the hull.
+    private: double volume{0.0};
+
+    /// \brief Center of volume of the hull.
+    private: math::Vector3d centroid;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Plane.hh>
+#include <gz/math/Vector3.hh>
+
+#include "SubmergedHull.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::buoyancy;
+
+/////////////////////////////////////////////////
+/// \brief Get the triangles of a unit cube centered at the origin.
+/// \param[in] _outwards Whether the triangles are wound outwards.
+/// \return Three vertices per triangle.
+std::vector<math::Vector3d> cube(bool _outwards)
+{
+  std::vector<math::Vector3d> triangles;
+  const double corners[4][2] = {{-0.5, -0.5}, {0.5, -0.5}, {0.5, 0.5},
+      {-0.5, 0.5}};
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (double side : {-0.5, 0.5})
+    {
+      math::Vector3d quad[4];
+      for (int i = 0; i < 4; ++i)
+      {
+        quad[i][axis] = side;
+        quad[i][(axis + 1) % 3] = corners[i][0];
+        quad[i][(axis + 2) % 3] = corners[i][1];
+      }
+      for (auto [b, c] : {std::make_pair(1, 2), std::make_pair(2, 3)})
+      {
+        math::Vector3d triangle[3] = {quad[0], quad[b], quad[c]};
+        const auto normal =
+            (triangle[1] - triangle[0]).Cross(triangle[2] - triangle[0]);
+        if ((normal.Dot(triangle[0]) > 0) != _outwards)
+          std::swap(triangle[1], triangle[2]);
+        triangles.insert(triangles.end(), triangle, triangle + 3);
+      }
+    }
+  }
+  return triangles;
+}
+
+/////////////////////////////////////////////////
+TEST(SubmergedHull, Cube)
+{
+  SubmergedHull hull(cube(true));
+  EXPECT_EQ(12u, hull.TriangleCount());
+  EXPECT_NEAR(1.0, hull.Volume(), 1e-12);
+  EXPECT_EQ(math::Vector3d::Zero, hull.CenterOfVolume());
+
+  // Halfway
+  std::optional<math::Vector3d> center;
+  EXPECT_NEAR(0.5, hull.VolumeBelow(math::Planed({0, 0, 1}, 0), center),
+      1e-12);
+  ASSERT_TRUE(center.has_value());
+  EXPECT_NEAR(-0.25, center->Z(), 1e-12);
+  EXPECT_NEAR(0.0, center->X(), 1e-12);
+
+  // Three quarters, with an unnormalized normal
+  EXPECT_NEAR(0.75, hull.VolumeBelow(math::Planed({0, 0, 2}, 0.5), center),
+      1e-12);
+  ASSERT_TRUE(center.has_value());
+  EXPECT_NEAR(-0.125, center->Z(), 1e-12);
+
+  // Tilted through the center
+  EXPECT_NEAR(0.5, hull.VolumeBelow(math::Planed({1, 1, 0}, 0), center),
+      1e-12);
+  ASSERT_TRUE(center.has_value());
+  EXPECT_LT(center->X(), 0.0);
+  EXPECT_NEAR(center->X(), center->Y(), 1e-12);
+  EXPECT_NEAR(0.0, center->Z(), 1e-12);
+
+  // Cutting a corner into a tetrahedron
+  const math::Vector3d diagonal{1, 1, 1};
+  const double offset = -1.2 / diagonal.Length();
+  EXPECT_NEAR(0.3 * 0.3 * 0.3 / 6.0,
+      hull.VolumeBelow(math::Planed(diagonal.Normalized(), offset), center),
+      1e-12);
+  ASSERT_TRUE(center.has_value());
+  EXPECT_NEAR(-0.5 + 0.3 / 4.0, center->X(), 1e-12);
+  EXPECT_NEAR(-0.5 + 0.3 / 4.0, center->Z(), 1e-12);
+
+  // Entirely above and below
+  EXPECT_DOUBLE_EQ(0.0, hull.VolumeBelow(math::Planed({0, 0, 1}, -1)));
+  EXPECT_FALSE(
+      hull.CenterOfVolumeBelow(math::Planed({0, 0, 1}, -1)).has_value());
+  EXPECT_DOUBLE_EQ(1.0 * hull.Volume(),
+      hull.VolumeBelow(math::Planed({0, 0, 1}, 1)));
+  EXPECT_EQ(hull.CenterOfVolume(),
+      hull.CenterOfVolumeBelow(math::Planed({0, 0, 1}, 1)));
+}
+
+/////////////////////////////////////////////////
+TEST(SubmergedHull, Winding)
+{
+  // Meshes wound inwards are flipped
+  SubmergedHull hull(cube(false));
+  EXPECT_NEAR(1.0, hull.Volume(), 1e-12);
+  EXPECT_NEAR(0.25, hull.VolumeBelow(math::Planed({0, 0, 1}, -0.25)),
+      1e-12);
+
+  // Offset hulls
+  auto triangles = cube(true);
+  for (auto &vertex : triangles)
+    vertex += math::Vector3d(0, 0, 2);
+  SubmergedHull offset(triangles);
+  EXPECT_NEAR(2.0, offset.CenterOfVolume().Z(), 1e-12);
+  auto center = offset.CenterOfVolumeBelow(math::Planed({0, 0, 1}, 2));
+  ASSERT_TRUE(center.has_value());
+  EXPECT_NEAR(1.75, center->Z(), 1e-12);
+}
+
+/////////////////////////////////////////////////
+TEST(SubmergedHull, Empty)
+{
+  SubmergedHull hull({});
+  EXPECT_EQ(0u, hull.TriangleCount());
+  EXPECT_DOUBLE_EQ(0.0, hull.Volume());
+  EXPECT_DOUBLE_EQ(0.0, hull.VolumeBelow(math::Planed({0, 0, 1}, 1)));
+}
@@ -17,13 +17,22 @@
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/image.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/time.pb.h>
 #include <gz/msgs/video_record.pb.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
 #include <regex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Profiler.hh>
 #include <gz/common/VideoEncoder.hh>
@@ -58,6 +67,9 @@ using namespace systems;
 // Private data class.
 class gz::sim::systems::CameraVideoRecorderPrivate
 {
+  /// \brief Destructor
+  public: ~CameraVideoRecorderPrivate();
+
   /// \brief Callback for the video recorder service
   public: bool OnRecordVideo(const msgs::VideoRecord &_msg,
       msgs::Boolean &_res);
@@ -68,6 +80,29 @@ class gz::sim::systems::CameraVideoRecorderPrivate
   /// \brief Callback for new images
   public: void OnImage(const msgs::Image &_msg);
 
+  /// \brief Queue a frame to be encoded by the encoding thread. The frame
+  /// is dropped if the queue is full.
+  /// \param[in] _data RGB pixels of the frame.
+  /// \param[in] _width Width of the frame.
+  /// \param[in] _height Height of the frame.
+  /// \param[in] _time Timestamp of the frame.
+  public: void QueueFrame(const unsigned char *_data, unsigned int _width,
+      unsigned int _height, const std::chrono::steady_clock::time_point &_time);
+
+  /// \brief Start the encoding thread. The video encoder must be started.
+  public: void StartEncodeThread();
+
+  /// \brief Stop the encoding thread, once it encoded all queued frames.
+  public: void StopEncodeThread();
+
+  /// \brief Function run by the encoding thread.
+  public: void EncodeLoop();
+
+  /// \brief Publish the number of encoded, dropped and queued frames.
+  /// \param[in] _force True to publish even if the status was published
+  /// less than a second ago.
+  public: void PublishStatus(bool _force);
+
   /// \brief Transport node
   public: transport::Node node;
 
@@ -142,12 +177,251 @@ class gz::sim::systems::CameraVideoRecorderPrivate
 
   /// \brief Marker manager
   public: MarkerManager markerManager;
+
+  /// \brief A frame waiting to be encoded
+  public: struct Frame
+  {
+    /// \brief RGB pixels
+    std::vector<unsigned char> data;
+
+    /// \brief Width in pixels
+    unsigned int width{0u};
+
+    /// \brief Height in pixels
+    unsigned int height{0u};
+
+    /// \brief Timestamp
+    std::chrono::steady_clock::time_point time;
+  };
+
+  /// \brief Frames waiting to be encoded, oldest first
+  public: std::deque<Frame> frameQueue;
+
+  /// \brief Pixel buffers of encoded frames, reused for new frames
+  public: std::vector<std::vector<unsigned char>> freeBuffers;
+
+  /// \brief Maximum number of frames waiting to be encoded. Frames that
+  /// arrive while the queue is full are dropped.
+  public: std::size_t maxQueuedFrames = 8u;
+
+  /// \brief Number of frames encoded in the current recording
+  public: uint64_t encodedFrames = 0u;
+
+  /// \brief Number of frames dropped in the current recording
+  public: uint64_t droppedFrames = 0u;
+
+  /// \brief True to stop the encoding thread once the queue is empty
+  public: bool stopEncodeThread = false;
+
+  /// \brief Mutex to protect the frame queue, the free buffers, the frame
+  /// counters and stopEncodeThread
+  public: std::mutex queueMutex;
+
+  /// \brief Signals the encoding thread when frames are queued or it
+  /// should stop
+  public: std::condition_variable queueCv;
+
+  /// \brief Thread that encodes frames, so encoding doesn't block the
+  /// rendering thread
+  public: std::thread encodeThread;
+
+  /// \brief Video recording status publisher
+  public: transport::Node::Publisher recorderStatusPub;
+
+  /// \brief Wall time of the last status published
+  public: std::chrono::steady_clock::time_point lastStatusTime;
+
+  /// \brief True to encode the frames that the sensor publishes, which
+  /// avoids reading every frame back from the GPU a second time. Set to
+  /// false if the sensor publishes images in a format that can't be
+  /// encoded, in which case frames are copied from the rendering camera.
+  public: bool framesFromSensor = true;
 };
 
 //////////////////////////////////////////////////
-void CameraVideoRecorderPrivate::OnImage(const msgs::Image &)
+void CameraVideoRecorderPrivate::OnImage(const msgs::Image &_msg)
 {
-  // No work is done here. We need to subscribe to the sensor to make it active.
+  // Subscribing to the sensor makes it active. Encode the frames it
+  // publishes, so they don't need to be read back from the camera again.
+  GZ_PROFILE("CameraVideoRecorderPrivate::OnImage");
+  std::lock_guard<std::mutex> lock(this->updateMutex);
+  if (!this->framesFromSensor || !this->recordVideo ||
+      !this->encodeThread.joinable())
+  {
+    return;
+  }
+
+  if (_msg.pixel_format_type() != msgs::PixelFormatType::RGB_INT8 ||
+      _msg.data().size() < 3u * _msg.width() * _msg.height())
+  {
+    gzdbg << "Camera [" << this->cameraName << "] publishes images that "
+          << "can't be encoded directly, copying frames from the camera "
+          << "instead." << std::endl;
+    this->framesFromSensor = false;
+    return;
+  }
+
+  std::chrono::steady_clock::time_point t;
+  if (this->recordVideoUseSimTime)
+  {
+    t = std::chrono::steady_clock::time_point(
+        convert<std::chrono::steady_clock::duration>(_msg.header().stamp()));
+  }
+  else
+  {
+    t = std::chrono::steady_clock::now();
+  }
+
+  this->QueueFrame(reinterpret_cast<const unsigned char *>(
+      _msg.data().data()), _msg.width(), _msg.height(), t);
+}
+
+//////////////////////////////////////////////////
+CameraVideoRecorderPrivate::~CameraVideoRecorderPrivate()
+{
+  this->StopEncodeThread();
+}
+
+//////////////////////////////////////////////////
+void CameraVideoRecorderPrivate::QueueFrame(const unsigned char *_data,
+    unsigned int _width, unsigned int _height,
+    const std::chrono::steady_clock::time_point &_time)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    if (this->frameQueue.size() >= this->maxQueuedFrames)
+    {
+      ++this->droppedFrames;
+      return;
+    }
+
+    Frame frame;
+    if (!this->freeBuffers.empty())
+    {
+      frame.data = std::move(this->freeBuffers.back());
+      this->freeBuffers.pop_back();
+    }
+    frame.data.assign(_data, _data + 3u * _width * _height);
+    frame.width = _width;
+    frame.height = _height;
+    frame.time = _time;
+    this->frameQueue.push_back(std::move(frame));
+  }
+  this->queueCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void CameraVideoRecorderPrivate::StartEncodeThread()
+{
+  this->StopEncodeThread();
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->frameQueue.clear();
+    this->encodedFrames = 0u;
+    this->droppedFrames = 0u;
+    this->stopEncodeThread = false;
+  }
+  this->encodeThread =
+      std::thread(&CameraVideoRecorderPrivate::EncodeLoop, this);
+}
+
+//////////////////////////////////////////////////
+void CameraVideoRecorderPrivate::StopEncodeThread()
+{
+  if (!this->encodeThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stopEncodeThread = true;
+  }
+  this->queueCv.notify_one();
+  this->encodeThread.join();
+  this->PublishStatus(true);
+}
+
+//////////////////////////////////////////////////
+void CameraVideoRecorderPrivate::EncodeLoop()
+{
+  GZ_PROFILE_THREAD_NAME("CameraVideoRecorder");
+  while (true)
+  {
+    Frame frame;
+    {
+      std::unique_lock<std::mutex> lock(this->queueMutex);
+      this->queueCv.wait(lock, [this]
+      {
+        return this->stopEncodeThread || !this->frameQueue.empty();
+      });
+
+      // Encode all queued frames before stopping
+      if (this->frameQueue.empty())
+        return;
+
+      frame = std::move(this->frameQueue.front());
+      this->frameQueue.pop_front();
+    }
+
+    GZ_PROFILE("CameraVideoRecorderPrivate::EncodeLoop");
+    bool frameAdded = this->videoEncoder.AddFrame(frame.data.data(),
+        frame.width, frame.height, frame.time);
+
+    {
+      std::lock_guard<std::mutex> lock(this->queueMutex);
+      if (frameAdded)
+        ++this->encodedFrames;
+      this->freeBuffers.push_back(std::move(frame.data));
+    }
+
+    if (!frameAdded)
+      continue;
+
+    // publish recorder stats
+    if (this->recordStartTime ==
+        std::chrono::steady_clock::time_point(
+          std::chrono::duration(std::chrono::seconds(0))))
+    {
+      // start time, i.e. time when first frame is added
+      this->recordStartTime = frame.time;
+    }
+
+    std::chrono::steady_clock::duration dt;
+    dt = frame.time - this->recordStartTime;
+    int64_t sec, nsec;
+    std::tie(sec, nsec) = math::durationToSecNsec(dt);
+    msgs::Time msg;
+    msg.set_sec(sec);
+    msg.set_nsec(nsec);
+    this->recorderStatsPub.Publish(msg);
+
+    this->PublishStatus(false);
+  }
+}
+
+//////////////////////////////////////////////////
+void CameraVideoRecorderPrivate::PublishStatus(bool _force)
+{
+  auto now = std::chrono::steady_clock::now();
+  if (!_force && now - this->lastStatusTime < std::chrono::seconds(1))
+    return;
+  this->lastStatusTime = now;
+
+  msgs::Param msg;
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    auto addCount = [&msg](const std::string &_name, uint64_t _count)
+    {
+      auto &value = (*msg.mutable_params())[_name];
+      value.set_type(msgs::Any_ValueType_INT32);
+      value.set_int_value(static_cast<int32_t>(std::min<uint64_t>(_count,
+          std::numeric_limits<int32_t>::max())));
+    };
+    addCount("encoded_frames", this->encodedFrames);
+    addCount("dropped_frames", this->droppedFrames);
+    addCount("queued_frames", this->frameQueue.size());
+  }
+  this->recorderStatusPub.Publish(msg);
 }
 
 //////////////////////////////////////////////////
@@ -273,6 +547,16 @@ void CameraVideoRecorder::Configure(
   std::string recorderStatsTopic = this->dataPtr->sensorTopic + "/stats";
   this->dataPtr->recorderStatsPub =
     this->dataPtr->node.Advertise<msgs::Time>(recorderStatsTopic);
+
+  // recorder status topic
+  std::string recorderStatusTopic = this->dataPtr->sensorTopic + "/status";
+  this->dataPtr->recorderStatusPub =
+    this->dataPtr->node.Advertise<msgs::Param>(recorderStatusTopic);
+
+  // Get how many frames can wait to be encoded before frames are dropped
+  this->dataPtr->maxQueuedFrames = std::max<std::size_t>(1u,
+      _sdf->Get<unsigned int>("max_queued_frames",
+      static_cast<unsigned int>(this->dataPtr->maxQueuedFrames)).first);
   gzmsg << "Camera Video recorder stats topic advertised on ["
     << recorderStatsTopic << "]" << std::endl;
 }
@@ -333,38 +617,21 @@ void CameraVideoRecorderPrivate::OnPostRender()
       this->cameraImage = this->camera->CreateImage();
     }
 
-    // Video recorder is on. Add more frames to it
+    // Video recorder is on. Add more frames to it, unless they're taken
+    // from the images published by the sensor
     if (this->videoEncoder.IsEncoding())
     {
-      this->camera->Copy(this->cameraImage);
-      std::chrono::steady_clock::time_point t;
-      if (this->recordVideoUseSimTime)
-        t = std::chrono::steady_clock::time_point(this->simTime);
-      else
-        t = std::chrono::steady_clock::now();
-
-      bool frameAdded = this->videoEncoder.AddFrame(
-          this->cameraImage.Data<unsigned char>(), width, height, t);
-
-      if (frameAdded)
+      if (!this->framesFromSensor)
       {
-        // publish recorder stats
-        if (this->recordStartTime ==
-            std::chrono::steady_clock::time_point(
-              std::chrono::duration(std::chrono::seconds(0))))
-        {
-          // start time, i.e. time when first frame is added
-          this->recordStartTime = t;
-        }
-
-        std::chrono::steady_clock::duration dt;
-        dt = t - this->recordStartTime;
-        int64_t sec, nsec;
-        std::tie(sec, nsec) = math::durationToSecNsec(dt);
-        msgs::Time msg;
-        msg.set_sec(sec);
-        msg.set_nsec(nsec);
-        this->recorderStatsPub.Publish(msg);
+        this->camera->Copy(this->cameraImage);
+        std::chrono::steady_clock::time_point t;
+        if (this->recordVideoUseSimTime)
+          t = std::chrono::steady_clock::time_point(this->simTime);
+        else
+          t = std::chrono::steady_clock::now();
+
+        this->QueueFrame(this->cameraImage.Data<unsigned char>(), width,
+            height, t);
       }
     }
     // Video recorder is idle. Start recording.
@@ -384,6 +651,7 @@ void CameraVideoRecorderPrivate::OnPostRender()
 
       this->recordStartTime = std::chrono::steady_clock::time_point(
             std::chrono::duration(std::chrono::seconds(0)));
+      this->StartEncodeThread();
 
       gzmsg << "Start video recording on [" << this->service << "]. "
              << "Encoding to tmp file: ["
@@ -396,7 +664,8 @@ void CameraVideoRecorderPrivate::OnPostRender()
     // other connections
     this->node.Unsubscribe(this->sensorTopic);
 
-    // stop encoding
+    // stop encoding, once the queued frames are encoded
+    this->StopEncodeThread();
     this->videoEncoder.Stop();
 
     gzmsg << "Stop video recording on [" << this->service << "]." << std::endl;
@@ -37,6 +37,17 @@ namespace systems
   ///
   /// \brief Record video from a camera sensor
   ///
+  /// While recording, the frames published by the camera sensor are
+  /// encoded as they're received, so they're read back from the GPU only
+  /// once. If the sensor publishes images in a format other than RGB_INT8,
+  /// frames are copied from the rendering camera instead.
+  ///
+  /// Frames are encoded by a dedicated thread. Frames that arrive while
+  /// `<max_queued_frames>` frames are already waiting to be encoded are
+  /// dropped. Hardware encoders, such as NVENC or VAAPI, are used when
+  /// they're allowed through the `GZ_VIDEO_ALLOWED_ENCODERS` environment
+  /// variable of gz-common's video encoder.
+  ///
   /// ## System Parameters
   ///
   /// - `<service>`:  Name of topic for the video recorder service. If this is
@@ -53,6 +64,20 @@ namespace systems
   ///
   /// - `<bitrate>`: Video recorder bitrate (bps). The default value is
   ///   2070000 bps, and the supported type is unsigned int.
+  ///
+  /// - `<max_queued_frames>`: Maximum number of frames waiting to be
+  ///   encoded. The default value is 8, and the supported type is unsigned
+  ///   int.
+  ///
+  /// ## Topics
+  ///
+  /// - `<sensor_topic>/stats`: Duration of the video recorded so far, as a
+  ///   gz::msgs::Time, published for every encoded frame.
+  ///
+  /// - `<sensor_topic>/status`: Number of encoded, dropped and queued
+  ///   frames of the current recording, as a gz::msgs::Param with the
+  ///   `encoded_frames`, `dropped_frames` and `queued_frames` parameters,
+  ///   published at most once per second and when recording stops.
   class CameraVideoRecorder final:
     public System,
     public ISystemConfigure,
@@ -0,0 +1,448 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ColladaStreamWriter.hh"
+
+#include <iomanip>
+#include <memory>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Escape text for an XML attribute or element.
+/// \param[in] _text Text to escape.
+/// \return Escaped text.
+std::string escape(const std::string &_text)
+{
+  std::string escaped;
+  escaped.reserve(_text.size());
+  for (const char c : _text)
+  {
+    switch (c)
+    {
+      case '&': escaped += "&amp;"; break;
+      case '<': escaped += "&lt;"; break;
+      case '>': escaped += "&gt;"; break;
+      case '"': escaped += "&quot;"; break;
+      case '\'': escaped += "&apos;"; break;
+      default: escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a color element.
+/// \param[in] _out Stream to write to.
+/// \param[in] _tag Name of the element.
+/// \param[in] _color The color.
+void writeColor(std::ostream &_out, const std::string &_tag,
+    const math::Color &_color)
+{
+  _out << "            <" << _tag << "><color>" << _color.R() << " "
+       << _color.G() << " " << _color.B() << " " << _color.A()
+       << "</color></" << _tag << ">\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a source of floats of a mesh.
+/// \param[in] _out Stream to write to.
+/// \param[in] _id ID of the source.
+/// \param[in] _params Names of the components of each value.
+/// \param[in] _count Number of values.
+/// \param[in] _value Function writing the components of a value.
+template <typename ValueFn>
+void writeSource(std::ostream &_out, const std::string &_id,
+    const std::vector<std::string> &_params, unsigned int _count,
+    ValueFn _value)
+{
+  _out << "        <source id=\"" << _id << "\">\n"
+       << "          <float_array id=\"" << _id << "-array\" count=\""
+       << _count * _params.size() << "\">";
+  for (unsigned int i = 0; i < _count; ++i)
+    _value(i);
+  _out << "</float_array>\n"
+       << "          <technique_common>\n"
+       << "            <accessor source=\"#" << _id << "-array\" count=\""
+       << _count << "\" stride=\"" << _params.size() << "\">\n";
+  for (const auto &param : _params)
+  {
+    _out << "              <param name=\"" << param
+         << "\" type=\"float\"/>\n";
+  }
+  _out << "            </accessor>\n"
+       << "          </technique_common>\n"
+       << "        </source>\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a matrix element, in row major order.
+/// \param[in] _out Stream to write to.
+/// \param[in] _matrix The matrix.
+void writeMatrix(std::ostream &_out, const math::Matrix4d &_matrix)
+{
+  _out << "        <matrix>";
+  for (std::size_t row = 0; row < 4; ++row)
+  {
+    for (std::size_t col = 0; col < 4; ++col)
+      _out << (row + col > 0 ? " " : "") << _matrix(row, col);
+  }
+  _out << "</matrix>\n";
+}
+}
+
+/////////////////////////////////////////////////
+bool ColladaStreamWriter::Open(const std::string &_dir,
+    const std::string &_name)
+{
+  this->dir = _dir;
+  const std::string meshDir = common::joinPaths(_dir, "meshes");
+  common::createDirectories(meshDir);
+  this->file.open(common::joinPaths(meshDir, _name + ".dae"));
+  if (!this->file)
+  {
+    gzerr << "Failed to create [" << common::joinPaths(meshDir, _name + ".dae")
+          << "]" << std::endl;
+    return false;
+  }
+
+  this->file << std::setprecision(9);
+  this->file
+      << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+      << "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" "
+      << "version=\"1.4.1\">\n"
+      << "  <asset>\n"
+      << "    <contributor><authoring_tool>Gazebo</authoring_tool>"
+      << "</contributor>\n"
+      << "    <unit name=\"meter\" meter=\"1\"/>\n"
+      << "    <up_axis>Z_UP</up_axis>\n"
+      << "  </asset>\n";
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string ColladaStreamWriter::Geometry(const common::Mesh *_mesh,
+    unsigned int _index)
+{
+  const auto key = std::make_pair(_mesh, _index);
+  auto it = this->geometries.find(key);
+  if (it != this->geometries.end())
+    return it->second;
+
+  auto subMesh = _mesh->SubMeshByIndex(_index).lock();
+  if (nullptr == subMesh || subMesh->IndexCount() < 3u ||
+      subMesh->SubMeshPrimitiveType() != common::SubMesh::TRIANGLES)
+  {
+    gzwarn << "Skipping submesh [" << _index << "] of mesh ["
+           << _mesh->Name() << "], only triangle meshes are exported."
+           << std::endl;
+    this->geometries[key] = "";
+    return "";
+  }
+
+  const std::string id = "geometry_" + std::to_string(this->geometries.size());
+  const unsigned int vertexCount = subMesh->VertexCount();
+  const bool hasNormals = subMesh->NormalCount() == vertexCount;
+  const bool hasTexCoords = subMesh->TexCoordCount() == vertexCount;
+
+  auto &out = this->file;
+  if (!this->geometriesOpen)
+  {
+    out << "  <library_geometries>\n";
+    this->geometriesOpen = true;
+  }
+  out << "    <geometry id=\"" << id << "\" name=\""
+      << escape(subMesh->Name()) << "\">\n"
+      << "      <mesh>\n";
+  writeSource(out, id + "-positions", {"X", "Y", "Z"}, vertexCount,
+      [&](unsigned int _i)
+      {
+        const auto &v = subMesh->Vertex(_i);
+        out << (_i > 0 ? " " : "") << v.X() << " " << v.Y() << " " << v.Z();
+      });
+  if (hasNormals)
+  {
+    writeSource(out, id + "-normals", {"X", "Y", "Z"}, vertexCount,
+        [&](unsigned int _i)
+        {
+          const auto &n = subMesh->Normal(_i);
+          out << (_i > 0 ? " " : "") << n.X() << " " << n.Y() << " "
+              << n.Z();
+        });
+  }
+  if (hasTexCoords)
+  {
+    // Same convention as common::ColladaExporter and ColladaLoader
+    writeSource(out, id + "-uvs", {"S", "T"}, vertexCount,
+        [&](unsigned int _i)
+        {
+          const auto &uv = subMesh->TexCoord(_i);
+          out << (_i > 0 ? " " : "") << uv.X() << " " << 1.0 - uv.Y();
+        });
+  }
+
+  const unsigned int inputCount = 1u + hasNormals + hasTexCoords;
+  out << "        <vertices id=\"" << id << "-vertices\">\n"
+      << "          <input semantic=\"POSITION\" source=\"#" << id
+      << "-positions\"/>\n"
+      << "        </vertices>\n"
+      << "        <triangles material=\"material\" count=\""
+      << subMesh->IndexCount() / 3 << "\">\n"
+      << "          <input semantic=\"VERTEX\" source=\"#" << id
+      << "-vertices\" offset=\"0\"/>\n";
+  unsigned int offset = 1u;
+  if (hasNormals)
+  {
+    out << "          <input semantic=\"NORMAL\" source=\"#" << id
+        << "-normals\" offset=\"" << offset++ << "\"/>\n";
+  }
+  if (hasTexCoords)
+  {
+    out << "          <input semantic=\"TEXCOORD\" source=\"#" << id
+        << "-uvs\" offset=\"" << offset++ << "\" set=\"0\"/>\n";
+  }
+  out << "          <p>";
+  const unsigned int indexCount = subMesh->IndexCount() / 3 * 3;
+  for (unsigned int i = 0; i < indexCount; ++i)
+  {
+    const int index = subMesh->Index(i);
+    for (unsigned int k = 0; k < inputCount; ++k)
+      out << (i + k > 0 ? " " : "") << index;
+  }
+  out << "</p>\n"
+      << "        </triangles>\n"
+      << "      </mesh>\n"
+      << "    </geometry>\n";
+
+  this->geometries[key] = id;
+  return id;
+}
+
+/////////////////////////////////////////////////
+std::string ColladaStreamWriter::Material(
+    const common::MaterialPtr &_material)
+{
+  std::ostringstream keyStream;
+  keyStream << _material->Diffuse() << " " << _material->Ambient() << " "
+            << _material->Emissive() << " " << _material->Specular() << " "
+            << _material->Shininess() << " " << _material->Transparency()
+            << " " << _material->TextureImage();
+  const std::string key = keyStream.str();
+  auto it = this->materialIds.find(key);
+  if (it != this->materialIds.end())
+    return it->second;
+
+  const std::string id = "material_" + std::to_string(this->materialCount++);
+  this->materialIds[key] = id;
+
+  this->materials << "    <material id=\"" << id << "\">\n"
+                  << "      <instance_effect url=\"#" << id << "-fx\"/>\n"
+                  << "    </material>\n";
+
+  // Textures are copied next to the scene
+  std::string texture;
+  const std::string &image = _material->TextureImage();
+  if (!image.empty() && common::exists(image))
+  {
+    const std::string textureDir =
+        common::joinPaths(this->dir, "materials", "textures");
+    common::createDirectories(textureDir);
+    const std::string fileName = common::basename(image);
+    const std::string copy = common::joinPaths(textureDir, fileName);
+    if (common::exists(copy) || common::copyFile(image, copy))
+    {
+      texture = "../materials/textures/" + fileName;
+      this->images << "    <image id=\"" << id << "-image\">\n"
+                   << "      <init_from>" << escape(texture)
+                   << "</init_from>\n"
+                   << "    </image>\n";
+    }
+  }
+
+  auto &out = this->effects;
+  out << "    <effect id=\"" << id << "-fx\">\n"
+      << "      <profile_COMMON>\n";
+  if (!texture.empty())
+  {
+    out << "        <newparam sid=\"" << id << "-surface\">\n"
+        << "          <surface type=\"2D\"><init_from>" << id
+        << "-image</init_from></surface>\n"
+        << "        </newparam>\n"
+        << "        <newparam sid=\"" << id << "-sampler\">\n"
+        << "          <sampler2D><source>" << id
+        << "-surface</source></sampler2D>\n"
+        << "        </newparam>\n";
+  }
+  out << "        <technique sid=\"common\">\n"
+      << "          <phong>\n";
+  writeColor(out, "emission", _material->Emissive());
+  writeColor(out, "ambient", _material->Ambient());
+  if (texture.empty())
+  {
+    writeColor(out, "diffuse", _material->Diffuse());
+  }
+  else
+  {
+    out << "            <diffuse><texture texture=\"" << id
+        << "-sampler\" texcoord=\"UVSET0\"/></diffuse>\n";
+  }
+  writeColor(out, "specular", _material->Specular());
+  out << "            <shininess><float>" << _material->Shininess()
+      << "</float></shininess>\n";
+  if (_material->Transparency() > 0.0)
+  {
+    out << "            <transparency><float>"
+        << 1.0 - _material->Transparency() << "</float></transparency>\n";
+  }
+  out << "          </phong>\n"
+      << "        </technique>\n"
+      << "      </profile_COMMON>\n"
+      << "    </effect>\n";
+  return id;
+}
+
+/////////////////////////////////////////////////
+void ColladaStreamWriter::AddNode(const std::string &_name,
+    const std::string &_geometry, const std::string &_material,
+    const math::Matrix4d &_transform)
+{
+  this->nodes.push_back({_name, _geometry, _material, _transform});
+}
+
+/////////////////////////////////////////////////
+void ColladaStreamWriter::AddLight(const common::ColladaLight &_light)
+{
+  this->lights.push_back(_light);
+}
+
+/////////////////////////////////////////////////
+bool ColladaStreamWriter::Close()
+{
+  auto &out = this->file;
+  if (this->geometriesOpen)
+    out << "  </library_geometries>\n";
+
+  if (!this->images.str().empty())
+  {
+    out << "  <library_images>\n" << this->images.str()
+        << "  </library_images>\n";
+  }
+  if (this->materialCount > 0u)
+  {
+    out << "  <library_effects>\n" << this->effects.str()
+        << "  </library_effects>\n"
+        << "  <library_materials>\n" << this->materials.str()
+        << "  </library_materials>\n";
+  }
+
+  if (!this->lights.empty())
+  {
+    out << "  <library_lights>\n";
+    for (std::size_t i = 0; i < this->lights.size(); ++i)
+    {
+      const auto &light = this->lights[i];
+      const auto &color = light.diffuse;
+      out << "    <light id=\"light_" << i << "\" name=\""
+          << escape(light.name) << "\">\n"
+          << "      <technique_common>\n"
+          << "        <" << light.type << ">\n"
+          << "          <color>" << color.R() << " " << color.G() << " "
+          << color.B() << "</color>\n";
+      if (light.type != "directional")
+      {
+        out << "          <constant_attenuation>"
+            << light.constantAttenuation << "</constant_attenuation>\n"
+            << "          <linear_attenuation>"
+            << light.linearAttenuation << "</linear_attenuation>\n"
+            << "          <quadratic_attenuation>"
+            << light.quadraticAttenuation << "</quadratic_attenuation>\n";
+      }
+      if (light.type == "spot")
+      {
+        out << "          <falloff_angle>" << light.falloffAngleDeg
+            << "</falloff_angle>\n"
+            << "          <falloff_exponent>" << light.falloffExponent
+            << "</falloff_exponent>\n";
+      }
+      out << "        </" << light.type << ">\n"
+          << "      </technique_common>\n"
+          << "    </light>\n";
+    }
+    out << "  </library_lights>\n";
+  }
+
+  out << "  <library_visual_scenes>\n"
+      << "    <visual_scene id=\"scene\" name=\"scene\">\n";
+  for (std::size_t i = 0; i < this->nodes.size(); ++i)
+  {
+    const auto &node = this->nodes[i];
+    out << "      <node id=\"node_" << i << "\" name=\""
+        << escape(node.name) << "\">\n";
+    writeMatrix(out, node.transform);
+    out << "        <instance_geometry url=\"#" << node.geometry << "\">\n"
+        << "          <bind_material><technique_common>\n"
+        << "            <instance_material symbol=\"material\" target=\"#"
+        << node.material << "\"/>\n"
+        << "          </technique_common></bind_material>\n"
+        << "        </instance_geometry>\n"
+        << "      </node>\n";
+  }
+  for (std::size_t i = 0; i < this->lights.size(); ++i)
+  {
+    // Lights point down their local Z axis
+    const auto &light = this->lights[i];
+    math::Quaterniond rot;
+    if (light.direction != math::Vector3d::Zero)
+      rot.SetFrom2Axes(-math::Vector3d::UnitZ, light.direction.Normalized());
+    out << "      <node id=\"light_node_" << i << "\" name=\""
+        << escape(light.name) << "\">\n";
+    writeMatrix(out, math::Matrix4d(math::Pose3d(light.position, rot)));
+    out << "        <instance_light url=\"#light_" << i << "\"/>\n"
+        << "      </node>\n";
+  }
+  out << "    </visual_scene>\n"
+      << "  </library_visual_scenes>\n"
+      << "  <scene><instance_visual_scene url=\"#scene\"/></scene>\n"
+      << "</COLLADA>\n";
+  out.close();
+  return !out.fail();
+}
+
+/////////////////////////////////////////////////
+std::size_t ColladaStreamWriter::GeometryCount() const
+{
+  std::size_t count{0u};
+  for (const auto &geometry : this->geometries)
+    count += geometry.second.empty() ? 0u : 1u;
+  return count;
+}
+
+/////////////////////////////////////////////////
+std::size_t ColladaStreamWriter::NodeCount() const
+{
+  return this->nodes.size();
+}
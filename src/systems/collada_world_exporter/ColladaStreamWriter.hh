@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_COLLADAWORLDEXPORTER_COLLADASTREAMWRITER_HH_
+#define GZ_SIM_SYSTEMS_COLLADAWORLDEXPORTER_COLLADASTREAMWRITER_HH_
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/ColladaExporter.hh>
+#include <gz/common/Material.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/math/Matrix4.hh>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief Writes a COLLADA scene in which every submesh is written once
+  /// and referenced by as many nodes as use it. Geometry is written to the
+  /// file as soon as it's added, so the scene is never held in memory.
+  /// Only materials, lights and nodes are kept until the file is closed.
+  ///
+  /// The layout of the output matches common::ColladaExporter: the scene
+  /// is saved as `<dir>/meshes/<name>.dae` and textures are copied to
+  /// `<dir>/materials/textures`.
+  class ColladaStreamWriter
+  {
+    /// \brief Start writing a scene.
+    /// \param[in] _dir Directory of the output.
+    /// \param[in] _name Name of the scene and of the file.
+    /// \return True if the file could be created.
+    public: bool Open(const std::string &_dir, const std::string &_name);
+
+    /// \brief Get the geometry of a submesh, writing it the first time the
+    /// submesh is used. Only triangle submeshes are supported.
+    /// \param[in] _mesh Mesh that holds the submesh. It must outlive the
+    /// writer, which identifies submeshes by address.
+    /// \param[in] _index Index of the submesh.
+    /// \return ID of the geometry, empty if it can't be written.
+    public: std::string Geometry(const common::Mesh *_mesh,
+                unsigned int _index);
+
+    /// \brief Get the material with the same properties as the given one,
+    /// adding it if there's none.
+    /// \param[in] _material The material.
+    /// \return ID of the material.
+    public: std::string Material(const common::MaterialPtr &_material);
+
+    /// \brief Add a node that instances a geometry.
+    /// \param[in] _name Name of the node.
+    /// \param[in] _geometry ID of the geometry.
+    /// \param[in] _material ID of the material.
+    /// \param[in] _transform Transform from the world to the geometry,
+    /// including scale.
+    public: void AddNode(const std::string &_name,
+                const std::string &_geometry, const std::string &_material,
+                const math::Matrix4d &_transform);
+
+    /// \brief Add a light.
+    /// \param[in] _light The light.
+    public: void AddLight(const common::ColladaLight &_light);
+
+    /// \brief Write the materials, lights and nodes, and close the file.
+    /// \return True if everything was written.
+    public: bool Close();
+
+    /// \brief Get the number of geometries written.
+    /// \return Number of geometries.
+    public: std::size_t GeometryCount() const;
+
+    /// \brief Get the number of nodes added.
+    /// \return Number of nodes.
+    public: std::size_t NodeCount() const;
+
+    /// \brief Node instancing a geometry.
+    private: struct Node
+    {
+      /// \brief Name of the node.
+      std::string name;
+
+      /// \brief ID of the geometry.
+      std::string geometry;
+
+      /// \brief ID of the material.
+      std::string material;
+
+      /// \brief Transform from the world.
+      math::Matrix4d transform;
+    };
+
+    /// \brief Output file.
+    private: std::ofstream file;
+
+    /// \brief Directory of the output.
+    private: std::string dir;
+
+    /// \brief Whether the geometry library was started.
+    private: bool geometriesOpen{false};
+
+    /// \brief Effects written when the file is closed.
+    private: std::ostringstream effects;
+
+    /// \brief Images written when the file is closed.
+    private: std::ostringstream images;
+
+    /// \brief Materials written when the file is closed.
+    private: std::ostringstream materials;
+
+    /// \brief Geometry IDs by submesh.
+    private: std::map<std::pair<const common::Mesh *, unsigned int>,
+             std::string> geometries;
+
+    /// \brief Material IDs by properties.
+    private: std::map<std::string, std::string> materialIds;
+
+    /// \brief Number of materials.
+    private: std::size_t materialCount{0u};
+
+    /// \brief Nodes of the scene.
+    private: std::vector<Node> nodes;
+
+    /// \brief Lights of the scene.
+    private: std::vector<common::ColladaLight> lights;
+  };
+}
+}
+}
+}
+#endif
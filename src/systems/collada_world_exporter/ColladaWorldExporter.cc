@@ -39,6 +39,7 @@
 #include <sdf/Model.hh>
 #include <sdf/Visual.hh>
 
+#include <gz/common/Console.hh>
 #include <gz/common/Material.hh>
 #include <gz/common/MeshManager.hh>
 #include <gz/common/Mesh.hh>
@@ -46,8 +47,7 @@
 
 #include <gz/math/Matrix4.hh>
 
-#include <gz/common/ColladaExporter.hh>
-
+#include "ColladaStreamWriter.hh"
 #include "ColladaWorldExporter.hh"
 
 using namespace gz;
@@ -69,18 +69,26 @@ class gz::sim::systems::ColladaWorldExporterPrivate
   {
     if (this->exported) return;
 
-    common::Mesh worldMesh;
-    std::vector<math::Matrix4d> subMeshMatrix;
-
+    std::string worldName;
     _ecm.Each<components::World, components::Name>(
       [&](const Entity /*& _entity*/,
         const components::World *,
         const components::Name * _name)->bool
     {
-      worldMesh.SetName(_name->Data());
+      worldName = _name->Data();
       return true;
     });
 
+    // Geometry is streamed to the file while visuals are visited, and each
+    // submesh is only written once, however many visuals use it
+    const std::string outputDir = "./" + worldName;
+    ColladaStreamWriter writer;
+    if (!writer.Open(outputDir, worldName))
+    {
+      this->exported = true;
+      return;
+    }
+
     _ecm.Each<components::Visual,
             components::Name,
             components::Geometry,
@@ -108,32 +116,39 @@ class gz::sim::systems::ColladaWorldExporterPrivate
       mat->SetTransparency(_transparency->Data());
 
       const common::Mesh *mesh;
-      std::weak_ptr<common::SubMesh> subm;
       math::Vector3d scale;
       math::Matrix4d matrix(worldPose);
       common::MeshManager *meshManager =
           common::MeshManager::Instance();
 
-      auto addSubmeshFunc = [&](int _matIndex)
+      // The scale is part of the node transform, so scaled instances of a
+      // mesh share its geometry
+      auto addSubmeshFunc = [&](unsigned int _subMeshIndex)
       {
-        int newMatIndex = 0;
-        if (_matIndex != -1)
-        {
-          auto m = mesh->MaterialByIndex(_matIndex);
-          newMatIndex = worldMesh.IndexOfMaterial(m.get());
-          if (newMatIndex < 0)
-          {
-            newMatIndex = worldMesh.AddMaterial(m);
-          }
-        }
-        else
+        auto subMesh = mesh->SubMeshByIndex(_subMeshIndex).lock();
+        if (!subMesh)
+          return;
+
+        auto geometry = writer.Geometry(mesh, _subMeshIndex);
+        if (geometry.empty())
+          return;
+
+        common::MaterialPtr subMeshMat = mat;
+        if (const auto matIndex = subMesh->GetMaterialIndex())
         {
-          newMatIndex = worldMesh.AddMaterial(mat);
+          auto m = mesh->MaterialByIndex(matIndex.value());
+          if (m)
+            subMeshMat = m;
         }
 
-        subm.lock()->SetMaterialIndex(newMatIndex);
-        subm.lock()->Scale(scale);
-        subMeshMatrix.push_back(matrix);
+        math::Matrix4d scaleMatrix(math::Matrix4d::Identity);
+        scaleMatrix(0, 0) = scale.X();
+        scaleMatrix(1, 1) = scale.Y();
+        scaleMatrix(2, 2) = scale.Z();
+
+        writer.AddNode(
+            mesh->SubMeshCount() > 1 ? name + "_" + subMesh->Name() : name,
+            geometry, writer.Material(subMeshMat), matrix * scaleMatrix);
       };
 
       if (_geom->Data().Type() == sdf::GeometryType::BOX)
@@ -142,10 +157,7 @@ class gz::sim::systems::ColladaWorldExporterPrivate
         {
           mesh = meshManager->MeshByName("unit_box");
           scale = _geom->Data().BoxShape()->Size();
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
+          addSubmeshFunc(0);
         }
       }
       else if (_geom->Data().Type() == sdf::GeometryType::CYLINDER)
@@ -156,10 +168,7 @@ class gz::sim::systems::ColladaWorldExporterPrivate
           scale.X() = _geom->Data().CylinderShape()->Radius() * 2;
           scale.Y() = scale.X();
           scale.Z() = _geom->Data().CylinderShape()->Length();
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
+          addSubmeshFunc(0);
         }
       }
       else if (_geom->Data().Type() == sdf::GeometryType::PLANE)
@@ -172,6 +181,7 @@ class gz::sim::systems::ColladaWorldExporterPrivate
 
           scale.X() = _geom->Data().PlaneShape()->Size().X();
           scale.Y() = _geom->Data().PlaneShape()->Size().Y();
+          scale.Z() = 1.0;
 
           // // The rotation is the angle between the +z(0,0,1) vector and the
           // // normal, which are both expressed in the local (Visual) frame.
@@ -181,10 +191,7 @@ class gz::sim::systems::ColladaWorldExporterPrivate
           worldPose.Rot() = worldPose.Rot() * normalRot;
 
           matrix = math::Matrix4d(worldPose);
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
+          addSubmeshFunc(0);
         }
       }
       else if (_geom->Data().Type() == sdf::GeometryType::SPHERE)
@@ -196,11 +203,7 @@ class gz::sim::systems::ColladaWorldExporterPrivate
           scale.X() = _geom->Data().SphereShape()->Radius() * 2;
           scale.Y() = scale.X();
           scale.Z() = scale.X();
-
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
+          addSubmeshFunc(0);
         }
       }
       else if (_geom->Data().Type() == sdf::GeometryType::MESH)
@@ -222,27 +225,14 @@ class gz::sim::systems::ColladaWorldExporterPrivate
 
         const auto subMeshName = _geom->Data().MeshShape()->Submesh();
         scale = _geom->Data().MeshShape()->Scale();
-        if(subMeshName == "")
+        for (unsigned int k = 0; k < mesh->SubMeshCount(); k++)
         {
-          for (unsigned int k = 0; k < mesh->SubMeshCount(); k++)
+          if (subMeshName.empty() ||
+              mesh->SubMeshByIndex(k).lock()->Name() == subMeshName)
           {
-            auto subMeshLock = mesh->SubMeshByIndex(k).lock();
-            subm = worldMesh.AddSubMesh(*subMeshLock.get());
-            if (const auto subMeshIdx = subMeshLock->GetMaterialIndex())
-              addSubmeshFunc(static_cast<int>(subMeshIdx.value()));
-            else
-              addSubmeshFunc(-1);
+            addSubmeshFunc(k);
           }
         }
-        else
-        {
-          auto subMeshLock = mesh->SubMeshByName(subMeshName).lock();
-          subm = worldMesh.AddSubMesh(*subMeshLock.get());
-          if (const auto subMeshIdx = subMeshLock->GetMaterialIndex())
-            addSubmeshFunc(static_cast<int>(subMeshIdx.value()));
-          else
-            addSubmeshFunc(-1);
-        }
       }
       else
       {
@@ -252,7 +242,6 @@ class gz::sim::systems::ColladaWorldExporterPrivate
       return true;
     });
 
-    std::vector<common::ColladaLight> lights;
     _ecm.Each<components::Light,
               components::Name>(
     [&](const Entity &/*_entity*/,
@@ -294,15 +283,24 @@ class gz::sim::systems::ColladaWorldExporterPrivate
       p.falloffAngleDeg = sdfLight.SpotOuterAngle().Degree();
       p.falloffExponent = sdfLight.SpotFalloff();
 
-      lights.push_back(p);
+      // Only types COLLADA knows about
+      if (p.type != "invalid")
+        writer.AddLight(p);
       return true;
     });
 
-    common::ColladaExporter exporter;
-    exporter.Export(&worldMesh, "./" + worldMesh.Name(), true,
-                    subMeshMatrix, lights);
-    gzmsg << "The world has been exported into the "
-           << "./" + worldMesh.Name() << " directory." << std::endl;
+    if (writer.Close())
+    {
+      gzmsg << "The world has been exported into the "
+             << outputDir << " directory, with " << writer.NodeCount()
+             << " nodes sharing " << writer.GeometryCount()
+             << " geometries." << std::endl;
+    }
+    else
+    {
+      gzerr << "Failed to export the world into the " << outputDir
+            << " directory." << std::endl;
+    }
     this->exported = true;
   }
 };
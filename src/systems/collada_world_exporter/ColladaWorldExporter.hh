@@ -35,6 +35,11 @@ namespace systems
   /// \brief A plugin that exports a world to a mesh.
   /// When loaded the plugin will dump a mesh containing all the models in
   /// the world to the current directory.
+  ///
+  /// Each visual is a node of the COLLADA scene. Visuals that use the same
+  /// mesh or primitive shape instance a single geometry, with their scale
+  /// in the node transform, and geometry is written to disk as it's
+  /// visited instead of being merged into one mesh in memory.
   class ColladaWorldExporter final:
     public System,
     public ISystemPostUpdate
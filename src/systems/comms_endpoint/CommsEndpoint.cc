@@ -16,16 +16,19 @@
  */
 
 #include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/dataframe.pb.h>
 #include <gz/msgs/stringmsg_v.pb.h>
 
 #include <atomic>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include <gz/common/Profiler.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 #include <sdf/sdf.hh>
+#include "gz/sim/comms/MsgManager.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
 #include "CommsEndpoint.hh"
@@ -45,6 +48,11 @@ class gz::sim::systems::CommsEndpoint::Implementation
   public: void BindCallback(const gz::msgs::Boolean &_rep,
                             const bool _result);
 
+  /// \brief Callback for the messages delivered to the address, when they
+  /// need to be unpacked.
+  /// \param[in] _msg A batch of messages, or a single message.
+  public: void OnMsg(const gz::msgs::Dataframe &_msg);
+
   /// \brief The address.
   public: std::string address;
 
@@ -77,8 +85,28 @@ class gz::sim::systems::CommsEndpoint::Implementation
 
   /// \brief The Gazebo Transport node.
   public: std::unique_ptr<gz::transport::Node> node;
+
+  /// \brief Publisher of the unpacked messages, if <unpacked_topic> is set.
+  public: gz::transport::Node::Publisher unpackedPub;
+
+  /// \brief Messages unpacked from the last batch.
+  public: std::vector<gz::msgs::Dataframe> unpacked;
 };
 
+//////////////////////////////////////////////////
+void CommsEndpoint::Implementation::OnMsg(const gz::msgs::Dataframe &_msg)
+{
+  if (!comms::UnpackMsgs(_msg, this->unpacked))
+  {
+    // Not a batch.
+    this->unpackedPub.Publish(_msg);
+    return;
+  }
+
+  for (const auto &msg : this->unpacked)
+    this->unpackedPub.Publish(msg);
+}
+
 //////////////////////////////////////////////////
 void CommsEndpoint::Implementation::BindCallback(
   const gz::msgs::Boolean &/*_rep*/, const bool _result)
@@ -139,6 +167,22 @@ void CommsEndpoint::Configure(const Entity &_entity,
   }
   this->dataPtr->topic = _sdf->Get<std::string>("topic");
 
+  // Parse <unpacked_topic>.
+  if (_sdf->HasElement("unpacked_topic"))
+  {
+    auto unpackedTopic = _sdf->Get<std::string>("unpacked_topic");
+    if (unpackedTopic == this->dataPtr->topic)
+    {
+      gzerr << "<unpacked_topic> must be different from <topic>."
+            << std::endl;
+      return;
+    }
+    this->dataPtr->unpackedPub =
+      this->dataPtr->node->Advertise<gz::msgs::Dataframe>(unpackedTopic);
+    this->dataPtr->node->Subscribe(this->dataPtr->topic,
+      &CommsEndpoint::Implementation::OnMsg, this->dataPtr.get());
+  }
+
   // Parse <broker>.
   if (_sdf->HasElement("broker"))
   {
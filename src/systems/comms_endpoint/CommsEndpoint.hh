@@ -50,6 +50,10 @@ namespace systems
   ///     The default value is "/broker/bind"
   ///   - `<unbind_service>`: Service name used to unbind from an address.
   ///     The default value is "/broker/unbind"
+  /// - `<unpacked_topic>`: If the broker delivers messages in batches (see
+  ///   `<batch_delivery>` in comms::Broker), the batches received on
+  ///   `<topic>` are unpacked and each message is published on this topic.
+  ///   Messages which aren't batches are published as they are.
   ///
   /// ## Example
   /// ```
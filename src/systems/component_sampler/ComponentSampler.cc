@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ComponentSampler.hh"
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/double_v.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/common/StringUtils.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/sim/components/AngularAcceleration.hh"
+#include "gz/sim/components/AngularVelocity.hh"
+#include "gz/sim/components/Gravity.hh"
+#include "gz/sim/components/JointForce.hh"
+#include "gz/sim/components/JointForceCmd.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/LinearAcceleration.hh"
+#include "gz/sim/components/LinearVelocity.hh"
+#include "gz/sim/components/LinearVelocitySeed.hh"
+#include "gz/sim/components/MagneticField.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/PoseCmd.hh"
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/World.hh"
+
+#include "SampleRing.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+using namespace component_sampler;
+
+namespace
+{
+/// \brief Function that samples a field of an entity's component.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _entity The entity.
+/// \param[in] _index Index of the field in the component.
+/// \return The value, or nullopt if the entity doesn't have the component.
+using SampleFn = std::optional<double> (*)(const EntityComponentManager &,
+    Entity, std::size_t);
+
+/// \brief Fields of pose components.
+const std::vector<std::string> kPoseFields{
+    "x", "y", "z", "roll", "pitch", "yaw"};
+
+//////////////////////////////////////////////////
+template <typename ComponentT>
+std::optional<double> samplePose(const EntityComponentManager &_ecm,
+    Entity _entity, std::size_t _index)
+{
+  auto comp = _ecm.Component<ComponentT>(_entity);
+  if (nullptr == comp)
+    return std::nullopt;
+  if (_index < 3)
+    return comp->Data().Pos()[_index];
+  return comp->Data().Rot().Euler()[_index - 3];
+}
+
+//////////////////////////////////////////////////
+template <typename ComponentT>
+std::optional<double> sampleVector(const EntityComponentManager &_ecm,
+    Entity _entity, std::size_t _index)
+{
+  auto comp = _ecm.Component<ComponentT>(_entity);
+  if (nullptr == comp)
+    return std::nullopt;
+  return comp->Data()[_index];
+}
+
+//////////////////////////////////////////////////
+template <typename ComponentT>
+std::optional<double> sampleJoint(const EntityComponentManager &_ecm,
+    Entity _entity, std::size_t _index)
+{
+  auto comp = _ecm.Component<ComponentT>(_entity);
+  if (nullptr == comp || _index >= comp->Data().size())
+    return std::nullopt;
+  return comp->Data()[_index];
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse an unsigned integer, rejecting anything else.
+/// \param[in] _str String to parse.
+/// \param[out] _value Parsed value.
+/// \return True if the whole string is a number.
+bool parseUnsigned(const std::string &_str, std::uint64_t &_value)
+{
+  if (_str.empty() || !std::all_of(_str.begin(), _str.end(),
+      [](unsigned char _c) {return std::isdigit(_c);}))
+  {
+    return false;
+  }
+  errno = 0;
+  _value = std::strtoull(_str.c_str(), nullptr, 10);
+  return errno == 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find how to sample a field.
+/// \param[in] _typeId Type of the component.
+/// \param[in] _attribute Name of the field.
+/// \param[out] _index Index of the field in the component.
+/// \return The sampling function, or nullptr if the field isn't supported.
+SampleFn sampleFunction(ComponentTypeId _typeId, const std::string &_attribute,
+    std::size_t &_index)
+{
+  SampleFn pose{nullptr};
+  if (_typeId == components::Pose::typeId)
+    pose = &samplePose<components::Pose>;
+  else if (_typeId == components::WorldPose::typeId)
+    pose = &samplePose<components::WorldPose>;
+  else if (_typeId == components::WorldPoseCmd::typeId)
+    pose = &samplePose<components::WorldPoseCmd>;
+  else if (_typeId == components::TrajectoryPose::typeId)
+    pose = &samplePose<components::TrajectoryPose>;
+
+  SampleFn vector{nullptr};
+  if (_typeId == components::LinearVelocity::typeId)
+    vector = &sampleVector<components::LinearVelocity>;
+  else if (_typeId == components::AngularVelocity::typeId)
+    vector = &sampleVector<components::AngularVelocity>;
+  else if (_typeId == components::LinearAcceleration::typeId)
+    vector = &sampleVector<components::LinearAcceleration>;
+  else if (_typeId == components::AngularAcceleration::typeId)
+    vector = &sampleVector<components::AngularAcceleration>;
+  else if (_typeId == components::WorldLinearVelocity::typeId)
+    vector = &sampleVector<components::WorldLinearVelocity>;
+  else if (_typeId == components::WorldAngularVelocity::typeId)
+    vector = &sampleVector<components::WorldAngularVelocity>;
+  else if (_typeId == components::WorldLinearAcceleration::typeId)
+    vector = &sampleVector<components::WorldLinearAcceleration>;
+  else if (_typeId == components::WorldAngularAcceleration::typeId)
+    vector = &sampleVector<components::WorldAngularAcceleration>;
+  else if (_typeId == components::WorldLinearVelocitySeed::typeId)
+    vector = &sampleVector<components::WorldLinearVelocitySeed>;
+  else if (_typeId == components::Gravity::typeId)
+    vector = &sampleVector<components::Gravity>;
+  else if (_typeId == components::MagneticField::typeId)
+    vector = &sampleVector<components::MagneticField>;
+
+  SampleFn joint{nullptr};
+  if (_typeId == components::JointPosition::typeId)
+    joint = &sampleJoint<components::JointPosition>;
+  else if (_typeId == components::JointVelocity::typeId)
+    joint = &sampleJoint<components::JointVelocity>;
+  else if (_typeId == components::JointForce::typeId)
+    joint = &sampleJoint<components::JointForce>;
+  else if (_typeId == components::JointForceCmd::typeId)
+    joint = &sampleJoint<components::JointForceCmd>;
+
+  if (nullptr != pose || nullptr != vector)
+  {
+    const std::size_t count = nullptr != pose ? 6u : 3u;
+    auto it = std::find(kPoseFields.begin(), kPoseFields.begin() + count,
+        _attribute);
+    if (it == kPoseFields.begin() + count)
+      return nullptr;
+    _index = static_cast<std::size_t>(it - kPoseFields.begin());
+    return nullptr != pose ? pose : vector;
+  }
+
+  if (nullptr != joint)
+  {
+    std::uint64_t index{0u};
+    if (_attribute != "value" &&
+        (_attribute.size() > 3 || !parseUnsigned(_attribute, index)))
+    {
+      return nullptr;
+    }
+    _index = static_cast<std::size_t>(index);
+    return joint;
+  }
+
+  return nullptr;
+}
+
+/// \brief A sampled field and its buffered samples.
+struct Channel
+{
+  /// \brief Constructor
+  /// \param[in] _capacity Capacity of the ring buffer.
+  explicit Channel(std::size_t _capacity) : ring(_capacity)
+  {
+  }
+
+  /// \brief Entity of the component.
+  Entity entity{kNullEntity};
+
+  /// \brief Index of the field in the component.
+  std::size_t index{0u};
+
+  /// \brief Function that samples the field.
+  SampleFn sample{nullptr};
+
+  /// \brief Publisher of the batches.
+  transport::Node::Publisher pub;
+
+  /// \brief Whether the topic had subscribers when last published.
+  bool connected{true};
+
+  /// \brief Number of clients that added the channel.
+  unsigned int clients{0u};
+
+  /// \brief Samples since the last batch.
+  SampleRing ring;
+};
+}
+
+/// \brief Private data class.
+class gz::sim::systems::ComponentSamplerPrivate
+{
+  /// \brief Callback for the add service.
+  /// \param[in] _req "<entity>,<type_id>,<attribute>" of the field.
+  /// \param[out] _res Topic of the channel.
+  /// \return True if the field can be sampled.
+  public: bool AddService(const msgs::StringMsg &_req,
+      msgs::StringMsg &_res);
+
+  /// \brief Callback for the remove service.
+  /// \param[in] _req Topic of the channel.
+  /// \param[out] _res True if the channel existed.
+  /// \return True.
+  public: bool RemoveService(const msgs::StringMsg &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Publish a batch on every channel with samples.
+  /// \param[in] _info Current update info.
+  public: void Publish(const UpdateInfo &_info);
+
+  /// \brief Transport node.
+  public: transport::Node node;
+
+  /// \brief Prefix of the services and topics.
+  public: std::string ns;
+
+  /// \brief Channels by topic.
+  public: std::unordered_map<std::string, std::unique_ptr<Channel>> channels;
+
+  /// \brief Protects the channels, which are added and removed by the
+  /// service callbacks.
+  public: std::mutex mutex;
+
+  /// \brief Number of samples buffered per channel.
+  public: std::size_t bufferSize{10000u};
+
+  /// \brief Maximum number of buckets per batch.
+  public: std::size_t maxPoints{50u};
+
+  /// \brief Wall-clock time between batches.
+  public: std::chrono::steady_clock::duration publishPeriod{
+      std::chrono::milliseconds(33)};
+
+  /// \brief Wall-clock time of the last batch.
+  public: std::chrono::steady_clock::time_point lastPublish;
+
+  /// \brief Envelope of a channel, reused between batches.
+  public: std::vector<double> envelope;
+};
+
+//////////////////////////////////////////////////
+ComponentSampler::ComponentSampler()
+  : dataPtr(std::make_unique<ComponentSamplerPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+ComponentSampler::~ComponentSampler() = default;
+
+//////////////////////////////////////////////////
+void ComponentSampler::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  auto worldName = World(_entity).Name(_ecm);
+  if (!worldName)
+  {
+    gzerr << "ComponentSampler should be attached to a world entity. "
+          << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  if (_sdf->HasElement("buffer_size"))
+  {
+    const auto size = _sdf->Get<int>("buffer_size");
+    if (size > 0)
+      this->dataPtr->bufferSize = static_cast<std::size_t>(size);
+    else
+      gzerr << "<buffer_size> must be positive, got [" << size << "]."
+            << std::endl;
+  }
+
+  if (_sdf->HasElement("max_points"))
+  {
+    const auto points = _sdf->Get<int>("max_points");
+    if (points > 0)
+      this->dataPtr->maxPoints = static_cast<std::size_t>(points);
+    else
+      gzerr << "<max_points> must be positive, got [" << points << "]."
+            << std::endl;
+  }
+
+  if (_sdf->HasElement("publish_rate"))
+  {
+    const auto rate = _sdf->Get<double>("publish_rate");
+    if (rate > 0)
+    {
+      this->dataPtr->publishPeriod =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / rate));
+    }
+    else
+    {
+      gzerr << "<publish_rate> must be positive, got [" << rate << "]."
+            << std::endl;
+    }
+  }
+
+  this->dataPtr->ns = transport::TopicUtils::AsValidTopic(
+      "/world/" + *worldName + "/sampler");
+  if (this->dataPtr->ns.empty())
+  {
+    gzerr << "Invalid world name [" << *worldName << "]. "
+          << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  const std::string addService{this->dataPtr->ns + "/add"};
+  this->dataPtr->node.Advertise(addService,
+      &ComponentSamplerPrivate::AddService, this->dataPtr.get());
+
+  const std::string removeService{this->dataPtr->ns + "/remove"};
+  this->dataPtr->node.Advertise(removeService,
+      &ComponentSamplerPrivate::RemoveService, this->dataPtr.get());
+
+  gzmsg << "Serving component samples on [" << addService << "]"
+        << std::endl;
+}
+
+//////////////////////////////////////////////////
+void ComponentSampler::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("ComponentSampler::PostUpdate");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->channels.empty())
+    return;
+
+  // Paused steps don't advance sim time, so they would only repeat samples
+  if (!_info.paused)
+  {
+    const double time =
+        std::chrono::duration<double>(_info.simTime).count();
+    for (auto &[topic, channel] : this->dataPtr->channels)
+    {
+      if (!channel->connected)
+        continue;
+      auto value = channel->sample(_ecm, channel->entity, channel->index);
+      if (value)
+        channel->ring.Push(time, *value);
+    }
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->dataPtr->lastPublish < this->dataPtr->publishPeriod)
+    return;
+  this->dataPtr->lastPublish = now;
+  this->dataPtr->Publish(_info);
+}
+
+//////////////////////////////////////////////////
+void ComponentSamplerPrivate::Publish(const UpdateInfo &_info)
+{
+  GZ_PROFILE("ComponentSampler::Publish");
+  for (auto &[topic, channel] : this->channels)
+  {
+    channel->connected = channel->pub.HasConnections();
+    if (channel->ring.Size() == 0)
+      continue;
+
+    this->envelope.clear();
+    channel->ring.Drain(this->maxPoints, this->envelope);
+    if (!channel->connected)
+      continue;
+
+    msgs::Double_V msg;
+    msg.mutable_header()->mutable_stamp()->CopyFrom(
+        convert<msgs::Time>(_info.simTime));
+    msg.mutable_data()->Add(this->envelope.begin(), this->envelope.end());
+    channel->pub.Publish(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+bool ComponentSamplerPrivate::AddService(const msgs::StringMsg &_req,
+    msgs::StringMsg &_res)
+{
+  const auto parts = common::Split(_req.data(), ',');
+  std::uint64_t entity{0u};
+  std::uint64_t typeId{0u};
+  if (parts.size() != 3 || !parseUnsigned(parts[0], entity) ||
+      !parseUnsigned(parts[1], typeId))
+  {
+    gzerr << "Sampler channels are requested as "
+          << "[<entity>,<type_id>,<attribute>], got [" << _req.data()
+          << "]." << std::endl;
+    return false;
+  }
+
+  std::size_t index{0u};
+  auto sample = sampleFunction(typeId, parts[2], index);
+  if (nullptr == sample)
+  {
+    gzerr << "Field [" << parts[2] << "] of component type [" << typeId
+          << "] can't be sampled." << std::endl;
+    return false;
+  }
+
+  const std::string topic = this->ns + "/" + parts[0] + "/" + parts[1] +
+      "/" + parts[2];
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto &channel = this->channels[topic];
+  if (!channel)
+  {
+    channel = std::make_unique<Channel>(this->bufferSize);
+    channel->entity = entity;
+    channel->index = index;
+    channel->sample = sample;
+    channel->pub = this->node.Advertise<msgs::Double_V>(topic);
+    if (!channel->pub)
+    {
+      gzerr << "Failed to advertise sampler topic [" << topic << "]"
+            << std::endl;
+      this->channels.erase(topic);
+      return false;
+    }
+    gzdbg << "Sampling [" << _req.data() << "] on [" << topic << "]"
+          << std::endl;
+  }
+  ++channel->clients;
+
+  _res.set_data(topic);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ComponentSamplerPrivate::RemoveService(const msgs::StringMsg &_req,
+    msgs::Boolean &_res)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto it = this->channels.find(_req.data());
+  _res.set_data(it != this->channels.end());
+  if (it != this->channels.end() && --it->second->clients == 0)
+    this->channels.erase(it);
+  return true;
+}
+
+GZ_ADD_PLUGIN(ComponentSampler, System,
+  ComponentSampler::ISystemConfigure,
+  ComponentSampler::ISystemPostUpdate
+)
+
+GZ_ADD_PLUGIN_ALIAS(ComponentSampler,
+    "gz::sim::systems::ComponentSampler")
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_COMPONENT_SAMPLER_HH_
+#define GZ_SIM_SYSTEMS_COMPONENT_SAMPLER_HH_
+
+#include <memory>
+#include <gz/sim/config.hh>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class ComponentSamplerPrivate;
+
+  /// \class ComponentSampler ComponentSampler.hh
+  /// gz/sim/systems/ComponentSampler.hh
+  /// \brief Samples component fields at every simulation step and streams
+  /// them in decimated batches, so fast signals like joint torques can be
+  /// plotted without dropping samples or flooding the GUI with points.
+  ///
+  /// Clients add a channel by calling the `/world/<world>/sampler/add`
+  /// service with a gz::msgs::StringMsg holding
+  /// `<entity>,<type_id>,<attribute>`, the same key the plotting GUI plugin
+  /// uses for its curves, and get back a gz::msgs::StringMsg with the topic
+  /// its batches are published on.
+  /// Channels of the same field are shared between clients, and calling
+  /// `/world/<world>/sampler/remove` with the topic releases one.
+  ///
+  /// Fields are sampled into a ring buffer per channel while the channel
+  /// has subscribers. At the publish rate, the buffered samples are split
+  /// into at most `<max_points>` buckets and published as a
+  /// gz::msgs::Double_V holding a (time, minimum, maximum) triple per
+  /// bucket, with times in seconds of sim time. The envelope keeps peaks
+  /// that plain decimation would hide.
+  ///
+  /// ## Fields
+  ///
+  /// - Pose components (Pose, WorldPose, WorldPoseCmd, TrajectoryPose):
+  /// `x`, `y`, `z`, `roll`, `pitch` and `yaw`.
+  /// - Vector components (LinearVelocity, AngularVelocity,
+  /// LinearAcceleration, AngularAcceleration, their world versions, Gravity
+  /// and MagneticField): `x`, `y` and `z`.
+  /// - Joint components (JointPosition, JointVelocity, JointForce and
+  /// JointForceCmd): `value` for the first axis, or the index of the axis.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<buffer_size>`: Number of samples buffered per channel. Older
+  /// samples are dropped if batches can't be published fast enough.
+  /// Defaults to 10000.
+  /// - `<publish_rate>`: Batches published per second of wall-clock time.
+  /// Defaults to 30.
+  /// - `<max_points>`: Maximum number of buckets per batch. Defaults to
+  /// 50.
+  class ComponentSampler:
+    public System,
+    public ISystemConfigure,
+    public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: explicit ComponentSampler();
+
+    /// \brief Destructor
+    public: ~ComponentSampler() override;
+
+    /// Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
+    /// Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) final;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<ComponentSamplerPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_COMPONENT_SAMPLER_SAMPLE_RING_HH_
+#define GZ_SIM_SYSTEMS_COMPONENT_SAMPLER_SAMPLE_RING_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::component_sampler
+{
+  /// \brief Fixed capacity ring buffer of the timestamped samples of one
+  /// field, which is drained into a min/max envelope.
+  ///
+  /// Once the ring is full the oldest samples are overwritten, so a slow
+  /// consumer loses the oldest part of the history instead of growing the
+  /// buffer.
+  class SampleRing
+  {
+    /// \brief Constructor
+    /// \param[in] _capacity Maximum number of samples, at least 1.
+    public: explicit SampleRing(std::size_t _capacity)
+      : samples(std::max<std::size_t>(1u, _capacity))
+    {
+    }
+
+    /// \brief Add a sample, overwriting the oldest one if the ring is full.
+    /// \param[in] _time Time of the sample.
+    /// \param[in] _value Value of the sample.
+    public: void Push(double _time, double _value)
+    {
+      this->samples[(this->start + this->count) % this->samples.size()] =
+          {_time, _value};
+      if (this->count < this->samples.size())
+      {
+        ++this->count;
+      }
+      else
+      {
+        this->start = (this->start + 1) % this->samples.size();
+        ++this->dropped;
+      }
+    }
+
+    /// \brief Get the number of buffered samples.
+    /// \return Number of samples.
+    public: std::size_t Size() const
+    {
+      return this->count;
+    }
+
+    /// \brief Get the maximum number of buffered samples.
+    /// \return Capacity of the ring.
+    public: std::size_t Capacity() const
+    {
+      return this->samples.size();
+    }
+
+    /// \brief Get the number of samples that were overwritten before being
+    /// drained.
+    /// \return Number of dropped samples.
+    public: std::size_t Dropped() const
+    {
+      return this->dropped;
+    }
+
+    /// \brief Remove all samples, summarizing them as an envelope. The
+    /// samples are split into at most _buckets consecutive buckets of about
+    /// the same size, and each bucket is appended to _out as three values:
+    /// the time of its first sample, its minimum and its maximum.
+    /// \param[in] _buckets Maximum number of buckets.
+    /// \param[out] _out Vector the buckets are appended to.
+    /// \return Number of buckets appended.
+    public: std::size_t Drain(std::size_t _buckets, std::vector<double> &_out)
+    {
+      const std::size_t total = this->count;
+      const std::size_t buckets = std::min(_buckets, total);
+      _out.reserve(_out.size() + 3u * buckets);
+      for (std::size_t b = 0; b < buckets; ++b)
+      {
+        const std::size_t first = b * total / buckets;
+        const std::size_t last = (b + 1) * total / buckets;
+        const auto &sample = this->At(first);
+        double low = sample.value;
+        double high = sample.value;
+        for (std::size_t i = first + 1; i < last; ++i)
+        {
+          low = std::min(low, this->At(i).value);
+          high = std::max(high, this->At(i).value);
+        }
+        _out.push_back(sample.time);
+        _out.push_back(low);
+        _out.push_back(high);
+      }
+      this->start = 0;
+      this->count = 0;
+      return buckets;
+    }
+
+    /// \brief A timestamped value.
+    private: struct Sample
+    {
+      /// \brief Time of the sample.
+      double time{0.0};
+
+      /// \brief Value of the sample.
+      double value{0.0};
+    };
+
+    /// \brief Get a buffered sample.
+    /// \param[in] _index Index from the oldest sample.
+    /// \return The sample.
+    private: const Sample &At(std::size_t _index) const
+    {
+      return this->samples[(this->start + _index) % this->samples.size()];
+    }
+
+    /// \brief Storage of the ring.
+    private: std::vector<Sample> samples;
+
+    /// \brief Index of the oldest sample.
+    private: std::size_t start{0u};
+
+    /// \brief Number of buffered samples.
+    private: std::size_t count{0u};
+
+    /// \brief Number of overwritten samples.
+    private: std::size_t dropped{0u};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "SampleRing.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::component_sampler;
+
+/////////////////////////////////////////////////
+TEST(SampleRing, Envelope)
+{
+  SampleRing ring(100);
+  EXPECT_EQ(100u, ring.Capacity());
+
+  std::vector<double> out;
+  EXPECT_EQ(0u, ring.Drain(10, out));
+  EXPECT_TRUE(out.empty());
+
+  // A square wave sampled 10 times is summarized by 2 buckets
+  for (int i = 0; i < 10; ++i)
+    ring.Push(i * 0.1, i % 2 == 0 ? -1.0 : 1.0);
+  EXPECT_EQ(10u, ring.Size());
+  ASSERT_EQ(2u, ring.Drain(2, out));
+  ASSERT_EQ(6u, out.size());
+  EXPECT_DOUBLE_EQ(0.0, out[0]);
+  EXPECT_DOUBLE_EQ(-1.0, out[1]);
+  EXPECT_DOUBLE_EQ(1.0, out[2]);
+  EXPECT_DOUBLE_EQ(0.5, out[3]);
+  EXPECT_DOUBLE_EQ(-1.0, out[4]);
+  EXPECT_DOUBLE_EQ(1.0, out[5]);
+  EXPECT_EQ(0u, ring.Size());
+
+  // With fewer samples than buckets every sample is its own bucket, and
+  // buckets are appended to the output
+  ring.Push(2.0, 5.0);
+  ring.Push(2.1, 6.0);
+  EXPECT_EQ(2u, ring.Drain(10, out));
+  ASSERT_EQ(12u, out.size());
+  EXPECT_DOUBLE_EQ(2.0, out[6]);
+  EXPECT_DOUBLE_EQ(5.0, out[7]);
+  EXPECT_DOUBLE_EQ(5.0, out[8]);
+  EXPECT_DOUBLE_EQ(2.1, out[9]);
+  EXPECT_DOUBLE_EQ(6.0, out[10]);
+  EXPECT_DOUBLE_EQ(6.0, out[11]);
+}
+
+/////////////////////////////////////////////////
+TEST(SampleRing, Overflow)
+{
+  SampleRing ring(4);
+  for (int i = 0; i < 10; ++i)
+    ring.Push(i, i);
+  EXPECT_EQ(4u, ring.Size());
+  EXPECT_EQ(6u, ring.Dropped());
+
+  // Only the newest samples are kept
+  std::vector<double> out;
+  ASSERT_EQ(1u, ring.Drain(1, out));
+  EXPECT_DOUBLE_EQ(6.0, out[0]);
+  EXPECT_DOUBLE_EQ(6.0, out[1]);
+  EXPECT_DOUBLE_EQ(9.0, out[2]);
+
+  // A zero capacity is raised to 1
+  SampleRing tiny(0);
+  EXPECT_EQ(1u, tiny.Capacity());
+}
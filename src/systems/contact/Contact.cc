@@ -20,6 +20,7 @@
 #include <gz/msgs/contact.pb.h>
 #include <gz/msgs/contacts.pb.h>
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -38,6 +39,7 @@
 #include "gz/sim/components/Collision.hh"
 #include "gz/sim/components/ContactSensor.hh"
 #include "gz/sim/components/ContactSensorData.hh"
+#include "gz/sim/components/ContactBuffer.hh"
 #include "gz/sim/components/Link.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/ParentEntity.hh"
@@ -58,9 +60,24 @@ class ContactSensor
 
   /// \brief Add contacts to the list to be published
   /// \param[in] _stamp Time stamp of the sensor measurement
-  /// \param[in] _contacts A contact message to be added to the list
+  /// \param[in] _collision Collision that has the contacts
+  /// \param[in] _contacts Contacts to be added to the list
+  /// \param[in] _ecm Immutable reference to ECM.
   public: void AddContacts(const std::chrono::steady_clock::duration &_stamp,
-                           const msgs::Contacts &_contacts);
+                           const Entity _collision,
+                           const components::ContactBufferData &_contacts,
+                           const EntityComponentManager &_ecm);
+
+  /// \brief Forget a collision that has been removed from simulation.
+  /// \param[in] _collision Removed collision entity
+  public: void RemoveCollision(const Entity _collision);
+
+  /// \brief Get the name of a collision, as it's set in contact messages.
+  /// \param[in] _collision Collision entity
+  /// \param[in] _ecm Immutable reference to ECM.
+  /// \return Name of the collision.
+  public: const std::string &CollisionName(const Entity _collision,
+                                           const EntityComponentManager &_ecm);
 
   /// \brief Publish sensor data over gz transport
   public: void Publish();
@@ -79,6 +96,10 @@ class ContactSensor
 
   /// \brief Entities for which this sensor publishes data
   public: std::vector<Entity> collisionEntities;
+
+  /// \brief Names of the collisions found in contacts, so they're only
+  /// computed once
+  public: std::unordered_map<Entity, std::string> collisionNames;
 };
 
 class gz::sim::systems::ContactPrivate
@@ -129,19 +150,52 @@ void ContactSensor::Load(const sdf::ElementPtr &_sdf, const std::string &_topic,
 //////////////////////////////////////////////////
 void ContactSensor::AddContacts(
     const std::chrono::steady_clock::duration &_stamp,
-    const msgs::Contacts &_contacts)
+    const Entity _collision,
+    const components::ContactBufferData &_contacts,
+    const EntityComponentManager &_ecm)
 {
   auto stamp = convert<msgs::Time>(_stamp);
-  for (const auto &contact : _contacts.contact())
+  const int first = this->contactsMsg.contact_size();
+  _contacts.AppendTo(_collision, this->contactsMsg);
+  for (int i = first; i < this->contactsMsg.contact_size(); ++i)
   {
-    auto *newContact = this->contactsMsg.add_contact();
-    newContact->CopyFrom(contact);
+    auto *newContact = this->contactsMsg.mutable_contact(i);
+    // Names are only set if physics is configured to include them
+    if (_contacts.entityNames)
+    {
+      newContact->mutable_collision1()->set_name(
+          this->CollisionName(newContact->collision1().id(), _ecm));
+      newContact->mutable_collision2()->set_name(
+          this->CollisionName(newContact->collision2().id(), _ecm));
+    }
     newContact->mutable_header()->mutable_stamp()->CopyFrom(stamp);
   }
 
   this->contactsMsg.mutable_header()->mutable_stamp()->CopyFrom(stamp);
 }
 
+//////////////////////////////////////////////////
+void ContactSensor::RemoveCollision(const Entity _collision)
+{
+  this->collisionNames.erase(_collision);
+  this->collisionEntities.erase(std::remove(this->collisionEntities.begin(),
+      this->collisionEntities.end(), _collision),
+      this->collisionEntities.end());
+}
+
+//////////////////////////////////////////////////
+const std::string &ContactSensor::CollisionName(const Entity _collision,
+    const EntityComponentManager &_ecm)
+{
+  auto it = this->collisionNames.find(_collision);
+  if (it == this->collisionNames.end())
+  {
+    it = this->collisionNames.emplace(_collision, removeParentScope(
+        scopedName(_collision, _ecm, "::", 0), "::")).first;
+  }
+  return it->second;
+}
+
 //////////////////////////////////////////////////
 void ContactSensor::Publish()
 {
@@ -194,9 +248,13 @@ void ContactPrivate::CreateSensors(EntityComponentManager &_ecm)
             // element.
             collisionEntities.push_back(childEntities.front());
 
-            // Create component to be filled by physics.
+            // Create components to be filled by physics. ContactSensorData
+            // is also read by other systems, such as the contact
+            // visualization.
             _ecm.CreateComponent(childEntities.front(),
                                  components::ContactSensorData());
+            _ecm.CreateComponent(childEntities.front(),
+                                 components::ContactBuffer());
           }
         }
 
@@ -220,13 +278,14 @@ void ContactPrivate::UpdateSensors(const UpdateInfo &_info,
   {
     for (const Entity &entity : item.second->collisionEntities)
     {
-      auto contacts = _ecm.Component<components::ContactSensorData>(entity);
+      auto contacts = _ecm.Component<components::ContactBuffer>(entity);
 
-      // We will assume that the ContactData component will have been created if
-      // this entity is in the collisionEntities list
-      if (contacts->Data().contact_size() > 0)
+      // The ContactBuffer component is created with the sensor, but it may
+      // have been removed by another system
+      if (nullptr != contacts && !contacts->Data().Empty())
       {
-        item.second->AddContacts(_info.simTime, contacts->Data());
+        item.second->AddContacts(_info.simTime, entity, contacts->Data(),
+            _ecm);
       }
     }
   }
@@ -253,6 +312,15 @@ void ContactPrivate::RemoveSensors(
 
         return true;
       });
+
+  // Forget removed collisions, so their names aren't kept around
+  _ecm.EachRemoved<components::Collision>(
+    [&](const Entity &_entity, const components::Collision *)->bool
+      {
+        for (auto &item : this->entitySensorMap)
+          item.second->RemoveCollision(_entity);
+        return true;
+      });
 }
 //////////////////////////////////////////////////
 Contact::Contact() : System(), dataPtr(std::make_unique<ContactPrivate>())
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ContactVisualization.hh"
+
+#include <gz/msgs/contact.pb.h>
+
+#include <chrono>
+#include <string>
+#include <unordered_set>
+
+#include <gz/common/Profiler.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/World.hh"
+#include "gz/sim/components/Collision.hh"
+#include "gz/sim/components/ContactBuffer.hh"
+#include "gz/sim/components/ContactSensor.hh"
+#include "gz/sim/components/ContactSensorData.hh"
+#include "gz/sim/components/ParentEntity.hh"
+
+#include "../../ContactClusters.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+/// \brief Private data for ContactVisualization.
+class gz::sim::systems::ContactVisualizationPrivate
+{
+  /// \brief Give a contact buffer to collisions that have none.
+  /// \param[in] _ecm Entity component manager.
+  public: void CreateBuffers(EntityComponentManager &_ecm);
+
+  /// \brief Remove the contact buffers created by this system.
+  /// \param[in] _ecm Entity component manager.
+  public: void RemoveBuffers(EntityComponentManager &_ecm);
+
+  /// \brief Transport node.
+  public: transport::Node node;
+
+  /// \brief Publisher of the summary.
+  public: transport::Node::Publisher pub;
+
+  /// \brief Time between summaries, zero to publish every step.
+  public: std::chrono::steady_clock::duration updatePeriod{
+              std::chrono::milliseconds(100)};
+
+  /// \brief Simulation time of the last summary.
+  public: std::chrono::steady_clock::duration lastUpdateTime{0};
+
+  /// \brief Clusters of the contacts of the last summary.
+  public: ContactClusters clusters{0.05, 1000u};
+
+  /// \brief Summary message, reused to keep its storage.
+  public: msgs::Contact msg;
+
+  /// \brief Collisions this system gave a contact buffer to.
+  public: std::unordered_set<Entity> createdBuffers;
+
+  /// \brief Whether the summary had subscribers in the last step.
+  public: bool active{false};
+};
+
+//////////////////////////////////////////////////
+void ContactVisualizationPrivate::CreateBuffers(EntityComponentManager &_ecm)
+{
+  auto create = [&](const Entity &_entity,
+      const components::Collision *) -> bool
+  {
+    if (_ecm.EntityHasComponentType(_entity,
+            components::ContactBuffer::typeId) ||
+        _ecm.EntityHasComponentType(_entity,
+            components::ContactSensorData::typeId))
+    {
+      return true;
+    }
+    _ecm.CreateComponent(_entity, components::ContactBuffer());
+    this->createdBuffers.insert(_entity);
+    return true;
+  };
+
+  // All collisions when the first subscriber connects, only the new ones
+  // afterwards
+  if (this->active)
+    _ecm.EachNew<components::Collision>(create);
+  else
+    _ecm.Each<components::Collision>(create);
+}
+
+//////////////////////////////////////////////////
+void ContactVisualizationPrivate::RemoveBuffers(EntityComponentManager &_ecm)
+{
+  // Contact sensors may have started using the buffers since they were
+  // created
+  std::unordered_set<Entity> sensorLinks;
+  _ecm.Each<components::ContactSensor, components::ParentEntity>(
+      [&](const Entity &, const components::ContactSensor *,
+          const components::ParentEntity *_parent) -> bool
+      {
+        sensorLinks.insert(_parent->Data());
+        return true;
+      });
+
+  for (const auto entity : this->createdBuffers)
+  {
+    auto *parent = _ecm.Component<components::ParentEntity>(entity);
+    if (nullptr != parent && sensorLinks.count(parent->Data()) > 0u)
+      continue;
+    _ecm.RemoveComponent<components::ContactBuffer>(entity);
+  }
+  this->createdBuffers.clear();
+}
+
+//////////////////////////////////////////////////
+ContactVisualization::ContactVisualization()
+  : System(), dataPtr(std::make_unique<ContactVisualizationPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+ContactVisualization::~ContactVisualization() = default;
+
+//////////////////////////////////////////////////
+void ContactVisualization::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  auto worldName = World(_entity).Name(_ecm);
+  if (!worldName)
+  {
+    gzerr << "ContactVisualization should be attached to a world entity. "
+          << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  if (_sdf->HasElement("update_rate"))
+  {
+    const auto rate = _sdf->Get<double>("update_rate");
+    if (rate > 0.0)
+    {
+      this->dataPtr->updatePeriod =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / rate));
+    }
+    else
+    {
+      this->dataPtr->updatePeriod = std::chrono::steady_clock::duration::zero();
+    }
+  }
+
+  if (_sdf->HasElement("cell_size"))
+  {
+    const auto size = _sdf->Get<double>("cell_size");
+    if (size > 0.0)
+      this->dataPtr->clusters.SetCellSize(size);
+    else
+      gzerr << "<cell_size> must be positive, got [" << size << "]."
+            << std::endl;
+  }
+
+  if (_sdf->HasElement("max_points"))
+  {
+    const auto points = _sdf->Get<int>("max_points");
+    if (points >= 0)
+      this->dataPtr->clusters.SetMaxPoints(static_cast<std::size_t>(points));
+    else
+      gzerr << "<max_points> can't be negative, got [" << points << "]."
+            << std::endl;
+  }
+
+  std::string topic = _sdf->Get<std::string>("topic",
+      "/world/" + worldName.value() + "/contacts/summary").first;
+  topic = transport::TopicUtils::AsValidTopic(topic);
+  if (topic.empty())
+  {
+    gzerr << "Invalid topic for contact visualization. Failed to initialize."
+          << std::endl;
+    return;
+  }
+
+  this->dataPtr->pub = this->dataPtr->node.Advertise<msgs::Contact>(topic);
+  gzmsg << "Publishing contact summaries on [" << topic << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+void ContactVisualization::PreUpdate(const UpdateInfo &,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("ContactVisualization::PreUpdate");
+  if (!this->dataPtr->pub)
+    return;
+
+  const bool active = this->dataPtr->pub.HasConnections();
+  if (active)
+    this->dataPtr->CreateBuffers(_ecm);
+  else if (this->dataPtr->active)
+    this->dataPtr->RemoveBuffers(_ecm);
+  this->dataPtr->active = active;
+}
+
+//////////////////////////////////////////////////
+void ContactVisualization::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("ContactVisualization::PostUpdate");
+  _ecm.EachRemoved<components::Collision>(
+      [&](const Entity &_entity, const components::Collision *) -> bool
+      {
+        this->dataPtr->createdBuffers.erase(_entity);
+        return true;
+      });
+
+  if (!this->dataPtr->active || _info.paused)
+    return;
+
+  // Publish right away after a jump back in time
+  const auto elapsed = _info.simTime - this->dataPtr->lastUpdateTime;
+  if (elapsed > elapsed.zero() && elapsed < this->dataPtr->updatePeriod)
+    return;
+  this->dataPtr->lastUpdateTime = _info.simTime;
+
+  auto &clusters = this->dataPtr->clusters;
+  clusters.Clear();
+  _ecm.Each<components::ContactBuffer>(
+      [&](const Entity &, const components::ContactBuffer *_contacts) -> bool
+      {
+        clusters.Add(_contacts->Data());
+        return true;
+      });
+  _ecm.Each<components::ContactSensorData>(
+      [&](const Entity &,
+          const components::ContactSensorData *_contacts) -> bool
+      {
+        clusters.Add(_contacts->Data());
+        return true;
+      });
+
+  auto &msg = this->dataPtr->msg;
+  msg.clear_position();
+  msg.mutable_header()->mutable_stamp()->CopyFrom(
+      convert<msgs::Time>(_info.simTime));
+  clusters.AppendTo(msg);
+  this->dataPtr->pub.Publish(msg);
+}
+
+GZ_ADD_PLUGIN(ContactVisualization, System,
+  ContactVisualization::ISystemConfigure,
+  ContactVisualization::ISystemPreUpdate,
+  ContactVisualization::ISystemPostUpdate
+)
+
+GZ_ADD_PLUGIN_ALIAS(ContactVisualization,
+    "gz::sim::systems::ContactVisualization")
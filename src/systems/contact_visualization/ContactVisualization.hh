@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_CONTACTVISUALIZATION_HH_
+#define GZ_SIM_SYSTEMS_CONTACTVISUALIZATION_HH_
+
+#include <memory>
+
+#include "gz/sim/System.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class ContactVisualizationPrivate;
+
+  /// \brief World system that publishes a summary of all contacts in the
+  /// world for visualization, used by the VisualizeContacts GUI plugin.
+  ///
+  /// Contact points are read from the contact buffers filled by the Physics
+  /// system, merged into the cells of a grid, and the centroid of each cell
+  /// is published. When there are more cells than the maximum number of
+  /// points, the cells with the most contacts are kept. The summary is
+  /// published at a fixed rate instead of every step, and contacts are only
+  /// collected while the topic has subscribers. Collisions get a contact
+  /// buffer when the first subscriber connects, and the buffers created by
+  /// this system are removed when the last one disconnects, so physics
+  /// doesn't report contacts nobody looks at.
+  ///
+  /// The summary is a `gz::msgs::Contact` message whose positions are the
+  /// cluster centroids.
+  ///
+  /// ## System Parameters
+  /// - <topic> - Topic the summary is published on.
+  ///   [Optional, defaults to `/world/<world_name>/contacts/summary`]
+  /// - <update_rate> - Rate of the summary in Hz, in simulation time.
+  ///   [Optional, defaults to 10]
+  /// - <cell_size> - Size of the cells contacts are merged in, in meters.
+  ///   [Optional, defaults to 0.05]
+  /// - <max_points> - Maximum number of points in a summary, 0 for no
+  ///   limit. [Optional, defaults to 1000]
+  class ContactVisualization final:
+    public System,
+    public ISystemConfigure,
+    public ISystemPreUpdate,
+    public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: ContactVisualization();
+
+    /// \brief Destructor
+    public: ~ContactVisualization() final;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) final;
+
+    // Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) final;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<ContactVisualizationPrivate> dataPtr;
+  };
+}
+}
+}
+}
+#endif
@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "CpuLidar.hh"
+
+#include <gz/msgs/laserscan.pb.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+#include <gz/plugin/Register.hh>
+
+#include <sdf/Lidar.hh>
+#include <sdf/Noise.hh>
+#include <sdf/Sensor.hh>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Rand.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/sim/components/Lidar.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Sensor.hh"
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Util.hh"
+
+#include "../../CollisionRayCaster.hh"
+#include "../../NoiseGenerator.hh"
+#include "../../ThreadPool.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+/// \brief A lidar and its latest scan.
+struct LidarSensor
+{
+  /// \brief Scoped name of the sensor, also used as its frame.
+  std::string name;
+
+  /// \brief Topic the scans are published on.
+  std::string topic;
+
+  /// \brief Lidar properties.
+  sdf::Lidar lidar;
+
+  /// \brief Time between scans, zero to scan every step.
+  std::chrono::steady_clock::duration period{0};
+
+  /// \brief Sim time of the next scan.
+  std::chrono::steady_clock::duration nextUpdate{0};
+
+  /// \brief Publisher of the scans.
+  transport::Node::Publisher pub;
+
+  /// \brief Link the sensor is attached to, whose collisions it doesn't
+  /// see.
+  std::unordered_set<Entity> excludedLinks;
+
+  /// \brief World pose of the sensor for the current scan.
+  math::Pose3d worldPose;
+
+  /// \brief Generator of the range noise, with the sensor as its stream.
+  NoiseGenerator noiseGenerator{0u, 0u};
+
+  /// \brief Simulation iteration of the current scan.
+  std::uint64_t iteration{0u};
+
+  /// \brief Scan being computed, reused across scans.
+  msgs::LaserScan msg;
+};
+
+/// \brief Private CpuLidar data class.
+class gz::sim::systems::CpuLidarPrivate
+{
+  /// \brief Create sensors for new lidar entities.
+  /// \param[in] _ecm Immutable reference to ECM.
+  public: void CreateSensors(const EntityComponentManager &_ecm);
+
+  /// \brief Create a sensor.
+  /// \param[in] _ecm Immutable reference to ECM.
+  /// \param[in] _entity Entity of the lidar.
+  /// \param[in] _lidar Lidar component.
+  public: void AddLidar(const EntityComponentManager &_ecm,
+      const Entity _entity, const components::Lidar *_lidar);
+
+  /// \brief Cast one horizontal row of rays of a lidar.
+  /// \param[in] _sensor The lidar.
+  /// \param[in] _row Index of the vertical sample.
+  public: void CastRow(LidarSensor &_sensor, unsigned int _row) const;
+
+  /// \brief Remove sensors of removed entities.
+  /// \param[in] _ecm Immutable reference to ECM.
+  public: void RemoveSensors(const EntityComponentManager &_ecm);
+
+  /// \brief Lidars by entity.
+  public: std::unordered_map<Entity, LidarSensor> sensors;
+
+  /// \brief Sensors created during the previous PostUpdate, which need a
+  /// topic component.
+  public: std::unordered_set<Entity> newSensors;
+
+  /// \brief Collision shapes of the world, shared with the other systems
+  /// that cast rays.
+  public: std::shared_ptr<CollisionRayCaster> caster;
+
+  /// \brief True to cast rays on the shared thread pool, false to cast
+  /// them on the simulation thread.
+  public: bool parallel{true};
+
+  /// \brief Rows of the lidars being scanned, reused across steps.
+  public: std::vector<std::pair<LidarSensor *, unsigned int>> rows;
+
+  /// \brief Transport node.
+  public: transport::Node node;
+
+  /// \brief True once the sensors that existed before the system was
+  /// loaded were created.
+  public: bool initialized{false};
+};
+
+//////////////////////////////////////////////////
+CpuLidar::CpuLidar() : System(), dataPtr(std::make_unique<CpuLidarPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+CpuLidar::~CpuLidar() = default;
+
+//////////////////////////////////////////////////
+void CpuLidar::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->parallel =
+      _sdf->Get<unsigned int>("threads", 1u).first > 0u;
+
+  gzdbg << "Casting CPU lidar rays "
+        << (this->dataPtr->parallel ? "in parallel." : "sequentially.")
+        << std::endl;
+}
+
+//////////////////////////////////////////////////
+void CpuLidar::PreUpdate(const UpdateInfo &/*_info*/,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("CpuLidar::PreUpdate");
+
+  // Create components
+  for (auto entity : this->dataPtr->newSensors)
+  {
+    auto it = this->dataPtr->sensors.find(entity);
+    if (it == this->dataPtr->sensors.end())
+    {
+      gzerr << "Entity [" << entity
+             << "] isn't in sensor map, this shouldn't happen." << std::endl;
+      continue;
+    }
+    // Set topic
+    _ecm.CreateComponent(entity, components::SensorTopic(it->second.topic));
+  }
+  this->dataPtr->newSensors.clear();
+}
+
+//////////////////////////////////////////////////
+void CpuLidar::PostUpdate(const UpdateInfo &_info,
+                          const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("CpuLidar::PostUpdate");
+
+  this->dataPtr->CreateSensors(_ecm);
+  this->dataPtr->RemoveSensors(_ecm);
+
+  // Only update and publish if not paused.
+  if (_info.paused)
+    return;
+
+  // Find the lidars that are due and have subscribers
+  std::vector<LidarSensor *> due;
+  for (auto &[entity, sensor] : this->dataPtr->sensors)
+  {
+    // Start over after jumping back in time
+    if (sensor.nextUpdate > _info.simTime + sensor.period)
+      sensor.nextUpdate = _info.simTime;
+
+    if (sensor.nextUpdate > _info.simTime)
+      continue;
+    sensor.nextUpdate = _info.simTime + sensor.period;
+
+    if (!sensor.pub.HasConnections())
+      continue;
+
+    sensor.worldPose = worldPose(entity, _ecm);
+    sensor.iteration = _info.iterations;
+    due.push_back(&sensor);
+  }
+  if (due.empty())
+    return;
+
+  if (!this->dataPtr->caster)
+    this->dataPtr->caster = CollisionRayCaster::Shared(_ecm);
+  this->dataPtr->caster->Update(_info, _ecm);
+
+  {
+    GZ_PROFILE("CpuLidar::CastRays");
+    auto &rowsToCast = this->dataPtr->rows;
+    rowsToCast.clear();
+    for (auto *sensor : due)
+    {
+      const auto rows = std::max(1u, sensor->lidar.VerticalScanSamples());
+      const auto cols = std::max(1u, sensor->lidar.HorizontalScanSamples());
+      sensor->msg.mutable_ranges()->Resize(static_cast<int>(rows * cols),
+          0.0);
+
+      for (unsigned int row = 0; row < rows; ++row)
+        rowsToCast.emplace_back(sensor, row);
+    }
+
+    auto castRows = [this, &rowsToCast](std::size_t _begin, std::size_t _end)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+        this->dataPtr->CastRow(*rowsToCast[i].first, rowsToCast[i].second);
+    };
+    if (this->dataPtr->parallel)
+    {
+      auto &pool = ThreadPool::Shared();
+      pool.ParallelFor(rowsToCast.size(), pool.GrainSize(rowsToCast.size()),
+          castRows);
+    }
+    else
+    {
+      castRows(0u, rowsToCast.size());
+    }
+  }
+
+  for (auto *sensor : due)
+  {
+    auto &msg = sensor->msg;
+    *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(
+        _info.simTime);
+    msgs::Set(msg.mutable_world_pose(), sensor->worldPose);
+    sensor->pub.Publish(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+void CpuLidarPrivate::CreateSensors(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("CpuLidar::CreateSensors");
+  auto add = [&](const Entity &_entity,
+                 const components::Lidar *_lidar) -> bool
+  {
+    this->AddLidar(_ecm, _entity, _lidar);
+    return true;
+  };
+
+  if (!this->initialized)
+  {
+    _ecm.Each<components::Lidar>(add);
+    this->initialized = true;
+  }
+  else
+  {
+    _ecm.EachNew<components::Lidar>(add);
+  }
+}
+
+//////////////////////////////////////////////////
+void CpuLidarPrivate::AddLidar(const EntityComponentManager &_ecm,
+    const Entity _entity, const components::Lidar *_lidar)
+{
+  const sdf::Sensor &data = _lidar->Data();
+  if (nullptr == data.LidarSensor())
+  {
+    gzerr << "Lidar [" << data.Name() << "] is missing its <lidar> element."
+          << std::endl;
+    return;
+  }
+
+  LidarSensor sensor;
+  sensor.name = removeParentScope(scopedName(_entity, _ecm, "::", false),
+      "::");
+  sensor.topic = data.Topic();
+  if (sensor.topic.empty())
+    sensor.topic = scopedName(_entity, _ecm) + "/scan";
+  sensor.lidar = *data.LidarSensor();
+  sensor.noiseGenerator = NoiseGenerator(math::Rand::Seed(), _entity);
+  sensor.excludedLinks.insert(_ecm.ParentEntity(_entity));
+  if (data.UpdateRate() > 0)
+  {
+    sensor.period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / data.UpdateRate()));
+  }
+
+  sensor.pub = this->node.Advertise<msgs::LaserScan>(sensor.topic);
+  if (!sensor.pub)
+  {
+    gzerr << "Failed to advertise lidar topic [" << sensor.topic << "]."
+          << std::endl;
+    return;
+  }
+
+  // Fill the fields that don't change between scans
+  const auto &lidar = sensor.lidar;
+  const auto cols = std::max(1u, lidar.HorizontalScanSamples());
+  const auto rows = std::max(1u, lidar.VerticalScanSamples());
+  auto &msg = sensor.msg;
+  auto frame = msg.mutable_header()->add_data();
+  frame->set_key("frame_id");
+  frame->add_value(sensor.name);
+  msg.set_frame(sensor.name);
+  msg.set_count(cols);
+  msg.set_angle_min(lidar.HorizontalScanMinAngle().Radian());
+  msg.set_angle_max(lidar.HorizontalScanMaxAngle().Radian());
+  msg.set_angle_step(cols > 1 ? (msg.angle_max() - msg.angle_min()) /
+      (cols - 1) : 0.0);
+  msg.set_vertical_count(rows);
+  msg.set_vertical_angle_min(lidar.VerticalScanMinAngle().Radian());
+  msg.set_vertical_angle_max(lidar.VerticalScanMaxAngle().Radian());
+  msg.set_vertical_angle_step(rows > 1 ?
+      (msg.vertical_angle_max() - msg.vertical_angle_min()) / (rows - 1) :
+      0.0);
+  msg.set_range_min(lidar.RangeMin());
+  msg.set_range_max(lidar.RangeMax());
+
+  this->sensors[_entity] = std::move(sensor);
+  this->newSensors.insert(_entity);
+}
+
+//////////////////////////////////////////////////
+void CpuLidarPrivate::CastRow(LidarSensor &_sensor, unsigned int _row) const
+{
+  const auto &msg = _sensor.msg;
+  const double vAngle = msg.vertical_angle_min() +
+      _row * msg.vertical_angle_step();
+  const double rangeMin = msg.range_min();
+  const double rangeMax = msg.range_max();
+  const auto &noise = _sensor.lidar.LidarNoise();
+  const bool noisy = noise.Type() == sdf::NoiseType::GAUSSIAN &&
+      noise.StdDev() > 0;
+
+  const auto &pose = _sensor.worldPose;
+  auto *ranges = _sensor.msg.mutable_ranges();
+  const auto cols = msg.count();
+
+  // Rows are cast from multiple threads, so each row is its own substream
+  // of the sensor's noise, and the scan doesn't depend on the schedule
+  thread_local std::vector<double> rowNoise;
+  if (noisy)
+  {
+    rowNoise.assign(cols, 0.0);
+    auto generator = _sensor.noiseGenerator;
+    generator.Reset(_sensor.iteration, _row);
+    generator.AddNormal(rowNoise.data(), rowNoise.size(), noise.Mean(),
+        noise.StdDev());
+  }
+
+  for (unsigned int col = 0; col < cols; ++col)
+  {
+    const double hAngle = msg.angle_min() + col * msg.angle_step();
+    const math::Vector3d localDir(std::cos(vAngle) * std::cos(hAngle),
+        std::cos(vAngle) * std::sin(hAngle), std::sin(vAngle));
+    const auto dir = pose.Rot().RotateVector(localDir);
+
+    double range = this->caster->Cast(pose.Pos(), dir, rangeMax,
+        _sensor.excludedLinks);
+    if (range < rangeMin)
+    {
+      range = -std::numeric_limits<double>::infinity();
+    }
+    else if (noisy && std::isfinite(range))
+    {
+      range = std::clamp(range + rowNoise[col], rangeMin, rangeMax);
+    }
+    ranges->Set(static_cast<int>(_row * cols + col), range);
+  }
+}
+
+//////////////////////////////////////////////////
+void CpuLidarPrivate::RemoveSensors(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("CpuLidar::RemoveSensors");
+  _ecm.EachRemoved<components::Lidar>(
+    [&](const Entity &_entity, const components::Lidar *) -> bool
+    {
+      this->sensors.erase(_entity);
+      this->newSensors.erase(_entity);
+      return true;
+    });
+}
+
+GZ_ADD_PLUGIN(CpuLidar, System,
+  CpuLidar::ISystemConfigure,
+  CpuLidar::ISystemPreUpdate,
+  CpuLidar::ISystemPostUpdate
+)
+
+GZ_ADD_PLUGIN_ALIAS(CpuLidar, "gz::sim::systems::CpuLidar")
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_CPU_LIDAR_HH_
+#define GZ_SIM_SYSTEMS_CPU_LIDAR_HH_
+
+#include <memory>
+#include <gz/sim/config.hh>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class CpuLidarPrivate;
+
+  /// \class CpuLidar CpuLidar.hh gz/sim/systems/CpuLidar.hh
+  /// \brief A lidar that doesn't need rendering. It serves sensors of type
+  /// `lidar` by casting their rays against the collision geometry of the
+  /// world, and publishes the ranges as gz::msgs::LaserScan, like GPU
+  /// lidars do. This lets worlds with lidars run on machines without a GPU.
+  ///
+  /// Boxes, spheres, cylinders, capsules, ellipsoids, planes and meshes are
+  /// supported, other collision shapes are invisible to the lidar. So are
+  /// the collisions of the sensor's link and the collisions the sensor is
+  /// inside of. Rays are cast against the same collisions as the physics
+  /// system's ray queries. Intensities aren't simulated. Ranges closer than
+  /// the minimum range are -inf and rays that don't hit anything within the
+  /// maximum range are +inf. Gaussian noise from the sensor's `<noise>` is
+  /// applied to hits.
+  ///
+  /// A scan is only computed when the sensor is due and its topic has
+  /// subscribers.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<threads>`: Any number above 0 casts rays on the threads of the
+  /// process-wide pool, whose size is set by the GZ_SIM_THREADS environment
+  /// variable, and 0 casts them on the simulation thread. Defaults to 1.
+  class CpuLidar:
+    public System,
+    public ISystemConfigure,
+    public ISystemPreUpdate,
+    public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: explicit CpuLidar();
+
+    /// \brief Destructor
+    public: ~CpuLidar() override;
+
+    /// Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
+    /// Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) final;
+
+    /// Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) final;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<CpuLidarPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
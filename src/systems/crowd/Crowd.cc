@@ -0,0 +1,472 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/plugin/Register.hh>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Profiler.hh>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector2.hh>
+
+#include <gz/sim/components/Actor.hh>
+#include <gz/sim/components/Name.hh>
+#include <gz/sim/components/Pose.hh>
+#include <gz/sim/EntityComponentManager.hh>
+
+#include "../../ThreadPool.hh"
+#include "Crowd.hh"
+#include "SpatialHash.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+namespace
+{
+/// \brief Settings of an agent.
+struct AgentConfig
+{
+  /// \brief Name of the actor.
+  std::string name;
+
+  /// \brief Waypoints visited in a loop.
+  std::vector<math::Vector2d> waypoints;
+
+  /// \brief Preferred speed in m/s.
+  double maxSpeed{1.2};
+
+  /// \brief Radius in meters.
+  double radius{0.3};
+
+  /// \brief Animation to play, empty for the first one.
+  std::string animation;
+};
+
+/// \brief Smallest number of agents whose steering is worth a task.
+constexpr std::size_t kGrainSize{64u};
+
+/// \brief Agents can exceed their preferred speed by this factor when they
+/// are pushed by others.
+constexpr double kSpeedMargin{1.3};
+}
+
+/// \brief Private Crowd data class.
+class gz::sim::systems::CrowdPrivate
+{
+  /// \brief Make an actor an agent of the crowd, taking over its trajectory.
+  /// \param[in] _config Settings of the agent.
+  /// \param[in] _entity Actor entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \return False if the actor has no animation to play.
+  public: bool AddAgent(const AgentConfig &_config, Entity _entity,
+              EntityComponentManager &_ecm);
+
+  /// \brief Remove an agent, swapping the last agent in its place.
+  /// \param[in] _index Index of the agent.
+  public: void RemoveAgent(std::size_t _index);
+
+  /// \brief Compute the new velocities of a range of agents. Only reads the
+  /// state of the agents, so ranges can be computed concurrently.
+  /// \param[in] _begin First agent.
+  /// \param[in] _end Agent past the last one.
+  /// \param[in] _dt Time step in seconds.
+  public: void Steer(std::size_t _begin, std::size_t _end, double _dt);
+
+  /// \brief Default settings of the agents.
+  public: AgentConfig defaults;
+
+  /// \brief Agents whose actors don't exist yet.
+  public: std::vector<AgentConfig> pending;
+
+  /// \brief Settings of each agent.
+  public: std::vector<AgentConfig> configs;
+
+  /// \brief Actor entity of each agent.
+  public: std::vector<Entity> entities;
+
+  /// \brief Position of each agent in the XY plane.
+  public: std::vector<math::Vector2d> positions;
+
+  /// \brief Velocity of each agent.
+  public: std::vector<math::Vector2d> velocities;
+
+  /// \brief Velocity of each agent after the current step.
+  public: std::vector<math::Vector2d> newVelocities;
+
+  /// \brief Yaw of each agent.
+  public: std::vector<double> yaws;
+
+  /// \brief Current waypoint of each agent.
+  public: std::vector<std::size_t> waypointIndices;
+
+  /// \brief Grid of the agent positions, rebuilt on each step.
+  public: systems::crowd::SpatialHash grid;
+
+  /// \brief Agents farther than this don't interact, in meters.
+  public: double neighborDistance{2.0};
+
+  /// \brief Time taken to reach the preferred velocity, in seconds.
+  public: double relaxationTime{0.5};
+
+  /// \brief Repulsion between touching agents, in m/s^2.
+  public: double repulsionStrength{2.0};
+
+  /// \brief Decay distance of the repulsion, in meters.
+  public: double repulsionRange{0.3};
+
+  /// \brief Distance at which a waypoint is reached, in meters.
+  public: double waypointTolerance{0.5};
+
+  /// \brief Velocity of the animation dislocation on the X axis, in m/s.
+  public: double animationXVel{2.0};
+
+  /// \brief True to compute the steering on the shared thread pool, false
+  /// to compute it on the simulation thread.
+  public: bool parallel{true};
+
+  /// \brief Time of the last update.
+  public: std::chrono::steady_clock::duration lastUpdate{0};
+};
+
+//////////////////////////////////////////////////
+bool CrowdPrivate::AddAgent(const AgentConfig &_config, Entity _entity,
+    EntityComponentManager &_ecm)
+{
+  auto actorComp = _ecm.Component<components::Actor>(_entity);
+  std::string animationName = _config.animation;
+  if (animationName.empty())
+  {
+    if (actorComp->Data().AnimationCount() < 1)
+    {
+      gzerr << "Actor [" << _config.name << "] doesn't have any animations, "
+             << "so it won't join the crowd." << std::endl;
+      return false;
+    }
+    animationName = actorComp->Data().AnimationByIndex(0)->Name();
+  }
+
+  auto animationNameComp = _ecm.Component<components::AnimationName>(_entity);
+  if (nullptr == animationNameComp)
+    _ecm.CreateComponent(_entity, components::AnimationName(animationName));
+  else
+    *animationNameComp = components::AnimationName(animationName);
+  // Mark as a one-time-change so that the change is propagated to the GUI
+  _ecm.SetChanged(_entity,
+      components::AnimationName::typeId, ComponentState::OneTimeChange);
+
+  if (nullptr == _ecm.Component<components::AnimationTime>(_entity))
+    _ecm.CreateComponent(_entity, components::AnimationTime());
+
+  // The XY pose and the yaw are controlled through the trajectory pose,
+  // which also prevents the actor from moving with the SDF script
+  math::Pose3d initialPose;
+  auto poseComp = _ecm.Component<components::Pose>(_entity);
+  if (nullptr == poseComp)
+  {
+    _ecm.CreateComponent(_entity, components::Pose(math::Pose3d::Zero));
+  }
+  else
+  {
+    initialPose = poseComp->Data();
+    auto trajPoseComp = _ecm.Component<components::TrajectoryPose>(_entity);
+    if (nullptr != trajPoseComp)
+      initialPose = initialPose * trajPoseComp->Data();
+
+    auto newPose = poseComp->Data();
+    newPose.Pos().X(0);
+    newPose.Pos().Y(0);
+    newPose.Rot() = math::Quaterniond(newPose.Rot().Roll(),
+        newPose.Rot().Pitch(), 0);
+    *poseComp = components::Pose(newPose);
+  }
+
+  const double yaw = initialPose.Rot().Yaw();
+  math::Pose3d trajPose(initialPose.Pos().X(), initialPose.Pos().Y(), 0,
+      0, 0, yaw);
+  auto trajPoseComp = _ecm.Component<components::TrajectoryPose>(_entity);
+  if (nullptr == trajPoseComp)
+    _ecm.CreateComponent(_entity, components::TrajectoryPose(trajPose));
+  else
+    *trajPoseComp = components::TrajectoryPose(trajPose);
+
+  this->configs.push_back(_config);
+  this->entities.push_back(_entity);
+  this->positions.emplace_back(trajPose.Pos().X(), trajPose.Pos().Y());
+  this->velocities.push_back(math::Vector2d::Zero);
+  this->newVelocities.push_back(math::Vector2d::Zero);
+  this->yaws.push_back(yaw);
+  this->waypointIndices.push_back(0u);
+
+  gzdbg << "Actor [" << _config.name << "] joined the crowd." << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void CrowdPrivate::RemoveAgent(std::size_t _index)
+{
+  const std::size_t last = this->entities.size() - 1u;
+  this->configs[_index] = std::move(this->configs[last]);
+  this->entities[_index] = this->entities[last];
+  this->positions[_index] = this->positions[last];
+  this->velocities[_index] = this->velocities[last];
+  this->newVelocities[_index] = this->newVelocities[last];
+  this->yaws[_index] = this->yaws[last];
+  this->waypointIndices[_index] = this->waypointIndices[last];
+
+  this->configs.pop_back();
+  this->entities.pop_back();
+  this->positions.pop_back();
+  this->velocities.pop_back();
+  this->newVelocities.pop_back();
+  this->yaws.pop_back();
+  this->waypointIndices.pop_back();
+}
+
+//////////////////////////////////////////////////
+void CrowdPrivate::Steer(std::size_t _begin, std::size_t _end, double _dt)
+{
+  for (std::size_t i = _begin; i < _end; ++i)
+  {
+    const AgentConfig &config = this->configs[i];
+    const math::Vector2d &position = this->positions[i];
+
+    // Pull towards the waypoint, slowing down when close to it
+    math::Vector2d desired = math::Vector2d::Zero;
+    if (!config.waypoints.empty())
+    {
+      auto toGoal = config.waypoints[this->waypointIndices[i]] - position;
+      const double distance = toGoal.Length();
+      if (distance > 1e-6)
+      {
+        desired = toGoal / distance * config.maxSpeed *
+            std::min(1.0, distance / this->waypointTolerance);
+      }
+    }
+    math::Vector2d force = (desired - this->velocities[i]) /
+        this->relaxationTime;
+
+    // Push away from the neighbors
+    this->grid.Query(position, this->neighborDistance,
+        [&](std::size_t _j, const math::Vector2d &_neighbor)
+        {
+          if (_j == i)
+            return;
+          math::Vector2d away = position - _neighbor;
+          const double gap = away.Length();
+          double distance = gap;
+          if (distance < 1e-9)
+          {
+            // Coincident agents are split along X, in opposite directions
+            away.Set(i < _j ? 1.0 : -1.0, 0.0);
+            distance = 1.0;
+          }
+          const double reach = config.radius + this->configs[_j].radius;
+          force += away / distance * this->repulsionStrength *
+              std::exp((reach - gap) / this->repulsionRange);
+        });
+
+    math::Vector2d velocity = this->velocities[i] + force * _dt;
+    const double maxSpeed = config.maxSpeed * kSpeedMargin;
+    if (velocity.Length() > maxSpeed)
+      velocity = velocity / velocity.Length() * maxSpeed;
+    this->newVelocities[i] = velocity;
+  }
+}
+
+//////////////////////////////////////////////////
+Crowd::Crowd() :
+  System(), dataPtr(std::make_unique<CrowdPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+Crowd::~Crowd() = default;
+
+//////////////////////////////////////////////////
+void Crowd::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  auto &defaults = this->dataPtr->defaults;
+  defaults.maxSpeed = _sdf->Get<double>("max_speed", defaults.maxSpeed).first;
+  defaults.radius = _sdf->Get<double>("radius", defaults.radius).first;
+  defaults.animation = _sdf->Get<std::string>("animation", "").first;
+
+  this->dataPtr->neighborDistance = _sdf->Get<double>("neighbor_distance",
+      this->dataPtr->neighborDistance).first;
+  this->dataPtr->relaxationTime = std::max(1e-3, _sdf->Get<double>(
+      "relaxation_time", this->dataPtr->relaxationTime).first);
+  this->dataPtr->repulsionStrength = _sdf->Get<double>("repulsion_strength",
+      this->dataPtr->repulsionStrength).first;
+  this->dataPtr->repulsionRange = std::max(1e-3, _sdf->Get<double>(
+      "repulsion_range", this->dataPtr->repulsionRange).first);
+  this->dataPtr->waypointTolerance = std::max(1e-3, _sdf->Get<double>(
+      "waypoint_tolerance", this->dataPtr->waypointTolerance).first);
+  this->dataPtr->animationXVel = _sdf->Get<double>("animation_x_vel",
+      this->dataPtr->animationXVel).first;
+
+  for (auto agentElem = _sdf->FindElement("agent"); agentElem;
+       agentElem = agentElem->GetNextElement("agent"))
+  {
+    AgentConfig config = defaults;
+    config.name = agentElem->Get<std::string>("name", "").first;
+    if (config.name.empty())
+    {
+      gzerr << "Crowd <agent> without a <name>, skipping." << std::endl;
+      continue;
+    }
+    for (auto waypointElem = agentElem->FindElement("waypoint");
+         waypointElem;
+         waypointElem = waypointElem->GetNextElement("waypoint"))
+    {
+      config.waypoints.push_back(waypointElem->Get<math::Vector2d>());
+    }
+    config.maxSpeed = agentElem->Get<double>("max_speed",
+        config.maxSpeed).first;
+    config.radius = agentElem->Get<double>("radius", config.radius).first;
+    config.animation = agentElem->Get<std::string>("animation",
+        config.animation).first;
+    this->dataPtr->pending.push_back(config);
+  }
+
+  if (this->dataPtr->pending.empty())
+  {
+    gzerr << "Crowd has no <agent>, so it won't move any actors."
+           << std::endl;
+    return;
+  }
+
+  this->dataPtr->parallel =
+      _sdf->Get<unsigned int>("threads", 1u).first > 0u;
+}
+
+//////////////////////////////////////////////////
+void Crowd::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("Crowd::PreUpdate");
+
+  if (_info.paused)
+    return;
+
+  std::chrono::duration<double> dtDuration = _info.simTime -
+      this->dataPtr->lastUpdate;
+  const double dt = dtDuration.count();
+  this->dataPtr->lastUpdate = _info.simTime;
+
+  // Agents leave the crowd when their actors are removed, and join it when
+  // their actors are spawned
+  auto &data = *this->dataPtr;
+  for (std::size_t i = 0u; i < data.entities.size();)
+  {
+    if (nullptr == _ecm.Component<components::TrajectoryPose>(
+        data.entities[i]))
+    {
+      data.pending.push_back(data.configs[i]);
+      data.RemoveAgent(i);
+      continue;
+    }
+    ++i;
+  }
+  for (auto it = data.pending.begin(); it != data.pending.end();)
+  {
+    auto entity = _ecm.EntityByComponents(components::Name(it->name),
+        components::Actor());
+    if (kNullEntity == entity)
+    {
+      ++it;
+      continue;
+    }
+    data.AddAgent(*it, entity, _ecm);
+    it = data.pending.erase(it);
+  }
+
+  if (data.entities.empty() || dt <= 0.0)
+    return;
+
+  data.grid.Build(data.positions, data.neighborDistance);
+
+  const std::size_t count = data.entities.size();
+  if (data.parallel && count > kGrainSize)
+  {
+    auto &pool = ThreadPool::Shared();
+    pool.ParallelFor(count, pool.GrainSize(count, kGrainSize),
+        [&data, dt](std::size_t _begin, std::size_t _end)
+        {
+          data.Steer(_begin, _end, dt);
+        });
+  }
+  else
+  {
+    data.Steer(0u, count, dt);
+  }
+
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    const math::Vector2d &velocity = data.newVelocities[i];
+    data.velocities[i] = velocity;
+    const math::Vector2d step = velocity * dt;
+    data.positions[i] += step;
+    if (velocity.Length() > 0.05)
+      data.yaws[i] = std::atan2(velocity.Y(), velocity.X());
+
+    const auto &waypoints = data.configs[i].waypoints;
+    if (waypoints.size() > 1u &&
+        data.positions[i].Distance(waypoints[data.waypointIndices[i]]) <
+        data.waypointTolerance)
+    {
+      data.waypointIndices[i] = (data.waypointIndices[i] + 1u) %
+          waypoints.size();
+    }
+
+    const Entity entity = data.entities[i];
+    auto trajPoseComp = _ecm.Component<components::TrajectoryPose>(entity);
+    *trajPoseComp = components::TrajectoryPose(math::Pose3d(
+        data.positions[i].X(), data.positions[i].Y(), 0, 0, 0,
+        data.yaws[i]));
+    // Mark as a one-time-change so that the change is propagated to the GUI
+    _ecm.SetChanged(entity, components::TrajectoryPose::typeId,
+        ComponentState::OneTimeChange);
+
+    // Animation time follows the distance traveled, so feet don't slide
+    auto animTimeComp = _ecm.Component<components::AnimationTime>(entity);
+    if (nullptr == animTimeComp)
+      continue;
+    auto animTime = animTimeComp->Data() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(step.Length() * data.animationXVel));
+    *animTimeComp = components::AnimationTime(animTime);
+    _ecm.SetChanged(entity, components::AnimationTime::typeId,
+        ComponentState::OneTimeChange);
+  }
+}
+
+GZ_ADD_PLUGIN(Crowd, System,
+  Crowd::ISystemConfigure,
+  Crowd::ISystemPreUpdate
+)
+
+GZ_ADD_PLUGIN_ALIAS(Crowd, "gz::sim::systems::Crowd")
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_CROWD_HH_
+#define GZ_SIM_SYSTEMS_CROWD_HH_
+
+#include <memory>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class CrowdPrivate;
+
+  /// \class Crowd Crowd.hh gz/sim/systems/Crowd.hh
+  /// \brief Steer many actors through their waypoints while they avoid
+  /// each other, using the social force model. It's meant to be attached to
+  /// the world, and replaces one FollowActor or scripted trajectory per
+  /// actor.
+  ///
+  /// Each agent is pulled towards its current waypoint at its preferred
+  /// speed and pushed away from the agents around it, which are found with
+  /// a uniform grid rebuilt on each step, so the cost grows linearly with
+  /// the number of agents. The steering of all agents is computed in
+  /// parallel. As with FollowActor, agents move on the XY plane, and the
+  /// poses and animation times are written to the actors'
+  /// TrajectoryPose and AnimationTime components.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<agent>`: An actor managed by the crowd. Required, and can be
+  ///   repeated. It holds:
+  ///   - `<name>`: Name of the actor. Required. Actors that don't exist yet
+  ///     join the crowd once they're spawned.
+  ///   - `<waypoint>`: XY position to walk to. Can be repeated, and
+  ///     waypoints are visited in a loop. Agents without waypoints stay
+  ///     where they are, but still move out of the way of others.
+  ///   - `<max_speed>`, `<radius>` and `<animation>` override the crowd's
+  ///     values for this agent.
+  ///
+  /// - `<max_speed>`: Preferred walking speed in m/s. Defaults to 1.2.
+  ///
+  /// - `<radius>`: Radius of the agents in meters. Defaults to 0.3.
+  ///
+  /// - `<neighbor_distance>`: Agents farther than this distance in meters
+  ///   don't interact. Defaults to 2.
+  ///
+  /// - `<relaxation_time>`: Time in seconds taken by an agent to reach its
+  ///   preferred velocity. Defaults to 0.5.
+  ///
+  /// - `<repulsion_strength>`: Magnitude in m/s^2 of the repulsion between
+  ///   two agents that touch. Defaults to 2.
+  ///
+  /// - `<repulsion_range>`: Distance in meters over which the repulsion
+  ///   decays exponentially. Defaults to 0.3.
+  ///
+  /// - `<waypoint_tolerance>`: Distance in meters to a waypoint at which an
+  ///   agent moves on to the next one. Defaults to 0.5.
+  ///
+  /// - `<animation>`: Actor animation to play. If empty, the first one of
+  ///   each actor is used.
+  ///
+  /// - `<animation_x_vel>`: Velocity of the animation on the X axis, used to
+  ///   coordinate the translational motion with the animation. Defaults
+  ///   to 2.
+  ///
+  /// - `<threads>`: Any number above 0 computes the steering on the
+  ///   threads of the process-wide pool, whose size is set by the
+  ///   GZ_SIM_THREADS environment variable. 0 computes it on the
+  ///   simulation thread. Defaults to 1.
+  class Crowd:
+    public System,
+    public ISystemConfigure,
+    public ISystemPreUpdate
+  {
+    /// \brief Constructor
+    public: explicit Crowd();
+
+    /// \brief Destructor
+    public: ~Crowd() override;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
+    /// Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) final;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<CrowdPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
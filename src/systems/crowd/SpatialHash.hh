@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_CROWD_SPATIALHASH_HH_
+#define GZ_SIM_SYSTEMS_CROWD_SPATIALHASH_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace crowd
+{
+/// \brief Uniform grid over the plane for finding the points near a
+/// position.
+///
+/// The grid is rebuilt from scratch from all the points, which takes linear
+/// time, and cells are hashed into a table sized to the number of points,
+/// so the extent of the world doesn't matter. Points are stored sorted by
+/// bucket, so that a query reads contiguous memory. Once built, the grid
+/// can be queried concurrently from several threads.
+class SpatialHash
+{
+  /// \brief Rebuild the grid.
+  /// \param[in] _points Positions of the points.
+  /// \param[in] _cellSize Size of the square cells. Queries with a radius
+  /// up to this size visit at most 9 cells.
+  public: void Build(const std::vector<math::Vector2d> &_points,
+                     double _cellSize)
+  {
+    this->cellSize = _cellSize > 0.0 ? _cellSize : 1.0;
+
+    std::size_t buckets = 1u;
+    while (buckets < _points.size() * 2u)
+      buckets <<= 1u;
+    this->mask = buckets - 1u;
+
+    // Counting sort of the points by bucket
+    this->bucketStart.assign(buckets + 1u, 0u);
+    std::vector<std::size_t> bucketOfPoint(_points.size());
+    for (std::size_t i = 0u; i < _points.size(); ++i)
+    {
+      bucketOfPoint[i] = this->Bucket(this->CellCoord(_points[i].X()),
+          this->CellCoord(_points[i].Y()));
+      ++this->bucketStart[bucketOfPoint[i] + 1u];
+    }
+    for (std::size_t b = 0u; b < buckets; ++b)
+      this->bucketStart[b + 1u] += this->bucketStart[b];
+
+    this->indices.resize(_points.size());
+    this->points.resize(_points.size());
+    std::vector<std::size_t> next(this->bucketStart.begin(),
+        this->bucketStart.end() - 1);
+    for (std::size_t i = 0u; i < _points.size(); ++i)
+    {
+      const std::size_t slot = next[bucketOfPoint[i]]++;
+      this->indices[slot] = i;
+      this->points[slot] = _points[i];
+    }
+  }
+
+  /// \brief Call a function for each point within a distance of a
+  /// position, including a point at that position.
+  /// \param[in] _position Position to search around.
+  /// \param[in] _radius Search distance.
+  /// \param[in] _f Function called with the index of each point in the
+  /// vector the grid was built from, and its position.
+  public: template<typename Function>
+          void Query(const math::Vector2d &_position, double _radius,
+                     Function _f) const
+  {
+    if (this->indices.empty())
+      return;
+
+    const std::int64_t minX = this->CellCoord(_position.X() - _radius);
+    const std::int64_t maxX = this->CellCoord(_position.X() + _radius);
+    const std::int64_t minY = this->CellCoord(_position.Y() - _radius);
+    const std::int64_t maxY = this->CellCoord(_position.Y() + _radius);
+
+    // Different cells may share a bucket, which must only be visited once
+    std::size_t local[9];
+    std::vector<std::size_t> many;
+    std::size_t *buckets = local;
+    std::size_t count = 0u;
+    const auto cells = static_cast<std::size_t>(
+        (maxX - minX + 1) * (maxY - minY + 1));
+    if (cells > 9u)
+    {
+      many.resize(cells);
+      buckets = many.data();
+    }
+    for (std::int64_t x = minX; x <= maxX; ++x)
+    {
+      for (std::int64_t y = minY; y <= maxY; ++y)
+        buckets[count++] = this->Bucket(x, y);
+    }
+    std::sort(buckets, buckets + count);
+    count = static_cast<std::size_t>(
+        std::unique(buckets, buckets + count) - buckets);
+
+    const double radiusSquared = _radius * _radius;
+    for (std::size_t b = 0u; b < count; ++b)
+    {
+      for (std::size_t slot = this->bucketStart[buckets[b]];
+           slot < this->bucketStart[buckets[b] + 1u]; ++slot)
+      {
+        if ((this->points[slot] - _position).SquaredLength() <=
+            radiusSquared)
+        {
+          _f(this->indices[slot], this->points[slot]);
+        }
+      }
+    }
+  }
+
+  /// \brief Get the cell coordinate of a position coordinate.
+  /// \param[in] _value Position coordinate.
+  /// \return Cell coordinate.
+  private: std::int64_t CellCoord(double _value) const
+  {
+    return static_cast<std::int64_t>(std::floor(_value / this->cellSize));
+  }
+
+  /// \brief Get the bucket of a cell.
+  /// \param[in] _x Cell X coordinate.
+  /// \param[in] _y Cell Y coordinate.
+  /// \return Bucket index.
+  private: std::size_t Bucket(std::int64_t _x, std::int64_t _y) const
+  {
+    const auto hash = static_cast<std::uint64_t>(_x) * 73856093u ^
+        static_cast<std::uint64_t>(_y) * 19349663u;
+    return static_cast<std::size_t>(hash) & this->mask;
+  }
+
+  /// \brief Size of the cells.
+  private: double cellSize{1.0};
+
+  /// \brief Number of buckets minus one, which is a power of two.
+  private: std::size_t mask{0u};
+
+  /// \brief Offset of the first point of each bucket in indices and
+  /// points, followed by the number of points.
+  private: std::vector<std::size_t> bucketStart;
+
+  /// \brief Index of each point, sorted by bucket.
+  private: std::vector<std::size_t> indices;
+
+  /// \brief Position of each point, sorted by bucket.
+  private: std::vector<math::Vector2d> points;
+};
+}
+}
+}
+}
+}
+
+#endif
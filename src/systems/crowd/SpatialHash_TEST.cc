@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+#include "SpatialHash.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::crowd;
+
+/////////////////////////////////////////////////
+TEST(SpatialHash, Empty)
+{
+  SpatialHash grid;
+  grid.Build({}, 1.0);
+  int calls{0};
+  grid.Query({0, 0}, 10.0, [&](std::size_t, const math::Vector2d &)
+      {
+        ++calls;
+      });
+  EXPECT_EQ(0, calls);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHash, MatchesBruteForce)
+{
+  // Points on a jittered lattice, including negative coordinates
+  std::vector<math::Vector2d> points;
+  for (int i = -20; i < 20; ++i)
+  {
+    for (int j = -20; j < 20; ++j)
+      points.emplace_back(i * 0.7 + 0.01 * j, j * 0.45 - 0.02 * i);
+  }
+
+  SpatialHash grid;
+  grid.Build(points, 1.5);
+
+  for (double radius : {0.3, 1.5, 4.0})
+  {
+    for (const math::Vector2d &center :
+        {math::Vector2d(0, 0), math::Vector2d(-13.9, 8.1),
+         math::Vector2d(100, 100)})
+    {
+      std::set<std::size_t> expected;
+      for (std::size_t i = 0u; i < points.size(); ++i)
+      {
+        if (points[i].Distance(center) <= radius)
+          expected.insert(i);
+      }
+
+      std::multiset<std::size_t> found;
+      grid.Query(center, radius,
+          [&](std::size_t _index, const math::Vector2d &_point)
+          {
+            EXPECT_EQ(points[_index], _point);
+            found.insert(_index);
+          });
+      EXPECT_EQ(expected.size(), found.size()) << radius;
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+          found.begin(), found.end())) << radius;
+    }
+  }
+}
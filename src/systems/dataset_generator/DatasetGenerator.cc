@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "DatasetGenerator.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Image.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/common/StringUtils.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/PixelFormat.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include "gz/sim/rendering/Events.hh"
+
+#include "../../ThreadPool.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+namespace
+{
+/// \brief Model placed at random poses.
+struct RandomModel
+{
+  /// \brief Name of the model.
+  std::string name;
+
+  /// \brief Minimum world position.
+  math::Vector3d min;
+
+  /// \brief Maximum world position.
+  math::Vector3d max;
+
+  /// \brief Whether the yaw is random.
+  bool randomYaw{true};
+
+  /// \brief Visual of the model.
+  rendering::VisualPtr visual;
+
+  /// \brief Pose of the visual before the samples, restored at the end.
+  math::Pose3d originalPose;
+
+  /// \brief Category of the model in the annotations.
+  int label{0};
+};
+
+/// \brief Rendered image waiting to be saved.
+struct PendingImage
+{
+  /// \brief Copy of the pixels.
+  std::vector<unsigned char> pixels;
+
+  /// \brief Width in pixels.
+  unsigned int width{0u};
+
+  /// \brief Height in pixels.
+  unsigned int height{0u};
+
+  /// \brief Pixel format.
+  common::Image::PixelFormatType format;
+
+  /// \brief Path of the PNG file.
+  std::string fileName;
+};
+
+/// \brief Get the label set by the Label system on a visual or on its
+/// descendants.
+/// \param[in] _visual Visual to check.
+/// \param[out] _label Label found.
+/// \return True if a label was found.
+bool findLabel(const rendering::VisualPtr &_visual, int &_label)
+{
+  auto data = _visual->UserData("label");
+  if (auto label = std::get_if<int>(&data))
+  {
+    _label = *label;
+    return true;
+  }
+  for (unsigned int i = 0; i < _visual->ChildCount(); ++i)
+  {
+    auto child = std::dynamic_pointer_cast<rendering::Visual>(
+        _visual->ChildByIndex(i));
+    if (child && findLabel(child, _label))
+      return true;
+  }
+  return false;
+}
+}
+
+/// \brief Private DatasetGenerator data class.
+class gz::sim::systems::DatasetGeneratorPrivate
+{
+  /// \brief Callback for post rendering operations, which renders the next
+  /// samples.
+  public: void OnPostRender();
+
+  /// \brief Find the cameras and model visuals in the scene.
+  /// \param[in] _scene Rendering scene.
+  /// \return True if all visuals and at least one camera were found.
+  public: bool Initialize(const rendering::ScenePtr &_scene);
+
+  /// \brief Place the models at random poses and render all cameras.
+  public: void RenderSample();
+
+  /// \brief Queue an image to be saved with the other images of this
+  /// render update.
+  /// \param[in] _image Rendered image.
+  /// \param[in] _fileName Path of the PNG file.
+  public: void SaveImage(const rendering::Image &_image,
+                         const std::string &_fileName);
+
+  /// \brief Add the bounding boxes of all models seen by a camera to the
+  /// annotations.
+  /// \param[in] _camera Camera that rendered the image.
+  /// \param[in] _imageId ID of the image in the annotations.
+  public: void Annotate(const rendering::CameraPtr &_camera, int _imageId);
+
+  /// \brief Save the queued images, on the shared thread pool unless
+  /// parallel is false.
+  public: void SavePendingImages();
+
+  /// \brief Write the annotations.
+  public: void Finish();
+
+  /// \brief Directory of the dataset.
+  public: std::string outputDir{"dataset"};
+
+  /// \brief Number of samples to generate.
+  public: unsigned int samples{100u};
+
+  /// \brief Number of samples rendered per render update.
+  public: unsigned int samplesPerRender{16u};
+
+  /// \brief Index of the next sample.
+  public: unsigned int sample{0u};
+
+  /// \brief Random pose generator.
+  public: std::mt19937 generator;
+
+  /// \brief Models placed at random poses.
+  public: std::vector<RandomModel> models;
+
+  /// \brief Names of the cameras to render, all cameras if empty.
+  public: std::set<std::string> cameraNames;
+
+  /// \brief Cameras rendering the samples.
+  public: std::vector<rendering::CameraPtr> cameras;
+
+  /// \brief True to save images on the shared thread pool, false to save
+  /// them on the rendering thread.
+  public: bool parallel{true};
+
+  /// \brief Images waiting to be saved.
+  public: std::vector<PendingImage> pendingImages;
+
+  /// \brief COCO image entries.
+  public: std::vector<std::string> imageEntries;
+
+  /// \brief COCO annotation entries.
+  public: std::vector<std::string> annotationEntries;
+
+  /// \brief Labels used by the annotations.
+  public: std::set<int> categories;
+
+  /// \brief Whether the cameras and visuals were found.
+  public: bool initialized{false};
+
+  /// \brief Whether all samples were generated.
+  public: bool done{false};
+
+  /// \brief Connection to post-render event callback.
+  public: common::ConnectionPtr connection{nullptr};
+};
+
+//////////////////////////////////////////////////
+DatasetGenerator::DatasetGenerator()
+    : System(), dataPtr(std::make_unique<DatasetGeneratorPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+DatasetGenerator::~DatasetGenerator()
+{
+  this->dataPtr->connection.reset();
+  // Keep the samples generated so far
+  if (this->dataPtr->initialized && !this->dataPtr->done)
+    this->dataPtr->Finish();
+}
+
+//////////////////////////////////////////////////
+void DatasetGenerator::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &_eventMgr)
+{
+  this->dataPtr->outputDir = _sdf->Get<std::string>("output_dir",
+      this->dataPtr->outputDir).first;
+  this->dataPtr->samples = _sdf->Get<unsigned int>("samples",
+      this->dataPtr->samples).first;
+  this->dataPtr->samplesPerRender = std::max(1u,
+      _sdf->Get<unsigned int>("samples_per_render",
+      this->dataPtr->samplesPerRender).first);
+
+  if (_sdf->HasElement("seed"))
+    this->dataPtr->generator.seed(_sdf->Get<unsigned int>("seed"));
+  else
+    this->dataPtr->generator.seed(std::random_device()());
+
+  this->dataPtr->parallel =
+      _sdf->Get<unsigned int>("threads", 1u).first > 0u;
+
+  for (auto elem = _sdf->FindElement("camera"); elem;
+      elem = elem->GetNextElement("camera"))
+  {
+    this->dataPtr->cameraNames.insert(elem->Get<std::string>());
+  }
+
+  for (auto elem = _sdf->FindElement("model"); elem;
+      elem = elem->GetNextElement("model"))
+  {
+    RandomModel model;
+    model.name = elem->Get<std::string>("name");
+    if (model.name.empty())
+    {
+      gzerr << "Model without <name> in DatasetGenerator, ignoring it."
+            << std::endl;
+      continue;
+    }
+    model.min = elem->Get<math::Vector3d>("min", model.min).first;
+    model.max = elem->Get<math::Vector3d>("max", model.min).first;
+    model.max.Max(model.min);
+    model.randomYaw = elem->Get<bool>("random_yaw", model.randomYaw).first;
+    this->dataPtr->models.push_back(model);
+  }
+
+  if (this->dataPtr->models.empty())
+  {
+    gzerr << "DatasetGenerator requires at least one <model>." << std::endl;
+    return;
+  }
+
+  this->dataPtr->connection =
+      _eventMgr.Connect<events::PostRender>(std::bind(
+          &DatasetGeneratorPrivate::OnPostRender, this->dataPtr.get()));
+}
+
+//////////////////////////////////////////////////
+bool DatasetGeneratorPrivate::Initialize(const rendering::ScenePtr &_scene)
+{
+  // Visuals are created by the render updates after the world is loaded
+  for (auto &model : this->models)
+  {
+    model.visual = _scene->VisualByName(model.name);
+    if (!model.visual)
+      return false;
+  }
+
+  this->cameras.clear();
+  for (unsigned int i = 0; i < _scene->NodeCount(); ++i)
+  {
+    auto camera = std::dynamic_pointer_cast<rendering::Camera>(
+        _scene->NodeByIndex(i));
+    if (nullptr == camera)
+      continue;
+
+    if (this->cameraNames.empty())
+    {
+      // Depth and thermal images can't be saved as PNG
+      if (rendering::PixelUtil::BytesPerChannel(camera->ImageFormat()) != 1u)
+        continue;
+    }
+    else if (this->cameraNames.find(camera->Name()) ==
+        this->cameraNames.end())
+    {
+      continue;
+    }
+    this->cameras.push_back(camera);
+  }
+  if (this->cameras.empty() ||
+      (!this->cameraNames.empty() &&
+      this->cameras.size() != this->cameraNames.size()))
+  {
+    return false;
+  }
+
+  for (auto &model : this->models)
+  {
+    model.originalPose = model.visual->WorldPose();
+    findLabel(model.visual, model.label);
+    this->categories.insert(model.label);
+  }
+
+  if (!common::createDirectories(
+      common::joinPaths(this->outputDir, "images")))
+  {
+    gzerr << "Failed to create dataset directory [" << this->outputDir
+          << "]" << std::endl;
+    this->done = true;
+    return false;
+  }
+
+  gzmsg << "Generating " << this->samples << " samples with "
+        << this->cameras.size() << " cameras in [" << this->outputDir
+        << "]" << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void DatasetGeneratorPrivate::OnPostRender()
+{
+  if (this->done)
+    return;
+
+  if (!this->initialized)
+  {
+    auto scene = rendering::sceneFromFirstRenderEngine();
+    if (!scene || !this->Initialize(scene))
+      return;
+    this->initialized = true;
+  }
+
+  const unsigned int end =
+      std::min(this->samples, this->sample + this->samplesPerRender);
+  while (this->sample < end)
+  {
+    this->RenderSample();
+    ++this->sample;
+  }
+  this->SavePendingImages();
+
+  if (this->sample == this->samples)
+  {
+    for (auto &model : this->models)
+      model.visual->SetWorldPose(model.originalPose);
+    this->Finish();
+  }
+}
+
+//////////////////////////////////////////////////
+void DatasetGeneratorPrivate::RenderSample()
+{
+  GZ_PROFILE("DatasetGeneratorPrivate::RenderSample");
+  for (auto &model : this->models)
+  {
+    math::Pose3d pose = model.originalPose;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      std::uniform_real_distribution<double> distribution(
+          model.min[axis], model.max[axis]);
+      pose.Pos()[axis] = distribution(this->generator);
+    }
+    if (model.randomYaw)
+    {
+      std::uniform_real_distribution<double> distribution(-GZ_PI, GZ_PI);
+      auto euler = pose.Rot().Euler();
+      euler.Z(distribution(this->generator));
+      pose.Rot().SetFromEuler(euler);
+    }
+    model.visual->SetWorldPose(pose);
+  }
+
+  for (const auto &camera : this->cameras)
+  {
+    auto image = camera->CreateImage();
+    camera->Capture(image);
+
+    std::string cameraName;
+    common::replaceAll(cameraName, camera->Name(), "::", "_");
+    char index[16];
+    std::snprintf(index, sizeof(index), "%06u", this->sample);
+    const std::string fileName =
+        "images/" + cameraName + "_" + index + ".png";
+    this->SaveImage(image, common::joinPaths(this->outputDir, fileName));
+
+    const int imageId = static_cast<int>(this->imageEntries.size()) + 1;
+    std::ostringstream entry;
+    entry << "{\"id\": " << imageId << ", \"file_name\": \"" << fileName
+          << "\", \"width\": " << camera->ImageWidth()
+          << ", \"height\": " << camera->ImageHeight() << "}";
+    this->imageEntries.push_back(entry.str());
+    this->Annotate(camera, imageId);
+  }
+}
+
+//////////////////////////////////////////////////
+void DatasetGeneratorPrivate::SaveImage(const rendering::Image &_image,
+    const std::string &_fileName)
+{
+  const auto *data = _image.Data<unsigned char>();
+  PendingImage pending;
+  pending.pixels.assign(data, data + _image.MemorySize());
+  pending.format = common::Image::ConvertPixelFormat(
+      rendering::PixelUtil::Name(_image.Format()));
+  pending.width = _image.Width();
+  pending.height = _image.Height();
+  pending.fileName = _fileName;
+  this->pendingImages.push_back(std::move(pending));
+}
+
+//////////////////////////////////////////////////
+void DatasetGeneratorPrivate::SavePendingImages()
+{
+  GZ_PROFILE("DatasetGeneratorPrivate::SavePendingImages");
+  auto save = [this](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const auto &pending = this->pendingImages[i];
+      common::Image image;
+      image.SetFromData(pending.pixels.data(), pending.width,
+          pending.height, pending.format);
+      image.SavePNG(pending.fileName);
+    }
+  };
+
+  // Encoding dominates, so each image is worth a chunk
+  const std::size_t count = this->pendingImages.size();
+  if (this->parallel)
+  {
+    auto &pool = ThreadPool::Shared();
+    pool.ParallelFor(count, pool.GrainSize(count), save);
+  }
+  else
+  {
+    save(0u, count);
+  }
+  this->pendingImages.clear();
+}
+
+//////////////////////////////////////////////////
+void DatasetGeneratorPrivate::Annotate(const rendering::CameraPtr &_camera,
+    int _imageId)
+{
+  const auto cameraPose = _camera->WorldPose();
+  const double width = _camera->ImageWidth();
+  const double height = _camera->ImageHeight();
+  for (const auto &model : this->models)
+  {
+    const math::AxisAlignedBox box = model.visual->BoundingBox();
+    if (!box.Valid())
+      continue;
+
+    math::Vector2d imageMin(width, height);
+    math::Vector2d imageMax(0.0, 0.0);
+    bool behind{false};
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      const math::Vector3d point(
+          (corner & 1) ? box.Max().X() : box.Min().X(),
+          (corner & 2) ? box.Max().Y() : box.Min().Y(),
+          (corner & 4) ? box.Max().Z() : box.Min().Z());
+
+      // Cameras look along +X
+      if (cameraPose.Rot().RotateVectorReverse(
+          point - cameraPose.Pos()).X() <= _camera->NearClipPlane())
+      {
+        behind = true;
+        break;
+      }
+      const auto pixel = _camera->Project(point);
+      imageMin.Min(math::Vector2d(pixel.X(), pixel.Y()));
+      imageMax.Max(math::Vector2d(pixel.X(), pixel.Y()));
+    }
+    if (behind)
+      continue;
+
+    imageMin.Max(math::Vector2d::Zero);
+    imageMax.Min(math::Vector2d(width, height));
+    const double boxWidth = imageMax.X() - imageMin.X();
+    const double boxHeight = imageMax.Y() - imageMin.Y();
+    if (boxWidth <= 0.0 || boxHeight <= 0.0)
+      continue;
+
+    std::ostringstream entry;
+    entry << "{\"id\": " << this->annotationEntries.size() + 1
+          << ", \"image_id\": " << _imageId
+          << ", \"category_id\": " << model.label
+          << ", \"bbox\": [" << imageMin.X() << ", " << imageMin.Y()
+          << ", " << boxWidth << ", " << boxHeight << "]"
+          << ", \"area\": " << boxWidth * boxHeight
+          << ", \"iscrowd\": 0}";
+    this->annotationEntries.push_back(entry.str());
+  }
+}
+
+//////////////////////////////////////////////////
+void DatasetGeneratorPrivate::Finish()
+{
+  this->done = true;
+
+  const auto fileName = common::joinPaths(this->outputDir, "annotations.json");
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    gzerr << "Failed to write annotations to [" << fileName << "]"
+          << std::endl;
+    return;
+  }
+
+  auto writeEntries = [&file](const std::vector<std::string> &_entries)
+  {
+    for (std::size_t i = 0; i < _entries.size(); ++i)
+      file << (i == 0 ? "\n    " : ",\n    ") << _entries[i];
+    file << "\n  ]";
+  };
+
+  file << "{\n  \"images\": [";
+  writeEntries(this->imageEntries);
+  file << ",\n  \"annotations\": [";
+  writeEntries(this->annotationEntries);
+  file << ",\n  \"categories\": [";
+  std::vector<std::string> categoryEntries;
+  for (const int label : this->categories)
+  {
+    categoryEntries.push_back("{\"id\": " + std::to_string(label) +
+        ", \"name\": \"label_" + std::to_string(label) + "\"}");
+  }
+  writeEntries(categoryEntries);
+  file << "\n}\n";
+
+  gzmsg << "Generated " << this->sample << " samples with "
+        << this->imageEntries.size() << " images in [" << this->outputDir
+        << "]" << std::endl;
+}
+
+GZ_ADD_PLUGIN(DatasetGenerator, System,
+              DatasetGenerator::ISystemConfigure)
+
+GZ_ADD_PLUGIN_ALIAS(DatasetGenerator,
+                    "gz::sim::systems::DatasetGenerator")
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_DATASETGENERATOR_HH_
+#define GZ_SIM_SYSTEMS_DATASETGENERATOR_HH_
+
+#include <sdf/sdf.hh>
+
+#include <memory>
+
+#include "gz/sim/System.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class DatasetGeneratorPrivate;
+
+  /// \brief System that generates a synthetic image dataset. For each of a
+  /// number of samples, the configured models are placed at random poses
+  /// and all configured cameras render the scene. Images are saved as PNG
+  /// files and annotations in the COCO format, with the 2D bounding box of
+  /// each model in each image.
+  ///
+  /// Samples are rendered back to back in the rendering thread, several per
+  /// render update, and the random poses are only applied to the rendering
+  /// scene. Physics and the entity component manager aren't involved, so
+  /// the world can be run without the Physics system. The images of each
+  /// render update are encoded and written to disk in parallel, on the
+  /// process-wide thread pool.
+  ///
+  /// Bounding boxes are the projection of the world bounding box of the
+  /// model visual, they don't account for occlusion. The category of a
+  /// model is the label set by the Label system on its visuals, or 0 if it
+  /// has none.
+  ///
+  /// ## System Parameters
+  /// - <output_dir> - Directory where the images and the `annotations.json`
+  ///   file are saved. [Optional, defaults to `dataset`]
+  /// - <samples> - Number of randomized scene configurations.
+  ///   [Optional, defaults to 100]
+  /// - <samples_per_render> - Number of samples rendered in each render
+  ///   update. [Optional, defaults to 16]
+  /// - <seed> - Seed of the random pose generator. [Optional, random by
+  ///   default]
+  /// - <threads> - Any number above 0 writes images on the threads of the
+  ///   process-wide pool, whose size is set by the GZ_SIM_THREADS
+  ///   environment variable, and 0 writes them on the rendering thread.
+  ///   [Optional, defaults to 1]
+  /// - <camera> - Scoped name of a camera sensor that renders the samples,
+  ///   for example `my_model::link::camera`. Can be repeated. [Optional,
+  ///   all cameras with 8 bit channels by default]
+  /// - <model> - Model placed at random poses. Can be repeated. [Required]
+  ///   - <name> - Name of the model. [Required]
+  ///   - <min> - Minimum world position. [Optional, defaults to 0 0 0]
+  ///   - <max> - Maximum world position. [Optional, defaults to <min>]
+  ///   - <random_yaw> - Set to true to use a random yaw. [Optional,
+  ///     defaults to true]
+  ///
+  /// ## Example
+  /// An example configuration is installed with Gazebo. To run it:
+  /// ```
+  /// gz sim dataset_generator.sdf -s -r -v 4
+  /// ```
+  class DatasetGenerator : public System,
+                           public ISystemConfigure
+  {
+    /// \brief Constructor
+    public: DatasetGenerator();
+
+    /// \brief Destructor
+    public: ~DatasetGenerator() override;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                    const std::shared_ptr<const sdf::Element> &_sdf,
+                    EntityComponentManager &_ecm,
+                    EventManager &_eventMgr) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<DatasetGeneratorPrivate> dataPtr;
+  };
+}
+}
+}
+}
+#endif
@@ -209,6 +209,8 @@ void DetachableJoint::Configure(const Entity &_entity,
       _sdf->Get<bool>("suppress_child_warning", this->suppressChildWarning)
           .first;
 
+  this->persistent = _sdf->Get<bool>("persistent", this->persistent).first;
+
   this->validConfig = true;
 }
 
@@ -245,14 +247,42 @@ void DetachableJoint::PreUpdate(
 
       if (kNullEntity != this->childLinkEntity)
       {
+        // A persistent joint to the same child link is enabled again
+        bool enabled{false};
+        if (kNullEntity != this->detachableJointEntity)
+        {
+          auto jointInfo = _ecm.Component<components::DetachableJoint>(
+              this->detachableJointEntity);
+          if (jointInfo &&
+              jointInfo->Data().childLink == this->childLinkEntity)
+          {
+            _ecm.SetComponentData<components::DetachableJointEnabled>(
+                this->detachableJointEntity, true);
+            enabled = true;
+          }
+          else
+          {
+            // The child model was replaced
+            _ecm.RequestRemoveEntity(this->detachableJointEntity);
+          }
+        }
+
         // Attach the models
         // We do this by creating a detachable joint entity.
-        this->detachableJointEntity = _ecm.CreateEntity();
-
-        _ecm.CreateComponent(
-            this->detachableJointEntity,
-            components::DetachableJoint({this->parentLinkEntity,
-                                         this->childLinkEntity, "fixed"}));
+        if (!enabled)
+        {
+          this->detachableJointEntity = _ecm.CreateEntity();
+
+          _ecm.CreateComponent(
+              this->detachableJointEntity,
+              components::DetachableJoint({this->parentLinkEntity,
+                                           this->childLinkEntity, "fixed"}));
+          if (this->persistent)
+          {
+            _ecm.CreateComponent(this->detachableJointEntity,
+                components::DetachableJointEnabled(true));
+          }
+        }
         this->attachRequested = false;
         this->isAttached = true;
         this->PublishJointState(this->isAttached);
@@ -278,9 +308,20 @@ void DetachableJoint::PreUpdate(
     if (this->detachRequested && (kNullEntity != this->detachableJointEntity))
     {
       // Detach the models
-      gzdbg << "Removing entity: " << this->detachableJointEntity << std::endl;
-      _ecm.RequestRemoveEntity(this->detachableJointEntity);
-      this->detachableJointEntity = kNullEntity;
+      if (this->persistent)
+      {
+        gzdbg << "Disabling entity: " << this->detachableJointEntity
+               << std::endl;
+        _ecm.SetComponentData<components::DetachableJointEnabled>(
+            this->detachableJointEntity, false);
+      }
+      else
+      {
+        gzdbg << "Removing entity: " << this->detachableJointEntity
+               << std::endl;
+        _ecm.RequestRemoveEntity(this->detachableJointEntity);
+        this->detachableJointEntity = kNullEntity;
+      }
       this->detachRequested = false;
       this->isAttached = false;
       this->PublishJointState(this->isAttached);
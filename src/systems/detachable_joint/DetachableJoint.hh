@@ -69,6 +69,13 @@ namespace systems
   /// - `<suppress_child_warning>` (optional): If true, the system
   /// will not print a warning message if a child model does not exist yet.
   /// Otherwise, a warning message is printed. Defaults to false.
+  ///
+  /// - `<persistent>` (optional): If true, the joint entity is created on
+  /// the first attachment and kept afterwards. Detaching and attaching
+  /// toggle its `components::DetachableJointEnabled` instead of removing
+  /// and creating it, which avoids entity churn when models are attached
+  /// and detached often, such as for pick and place. The joint is only
+  /// recreated if the child model is replaced. Defaults to false.
 
   class DetachableJoint
       : public System,
@@ -122,6 +129,9 @@ namespace systems
     /// \brief Whether to suppress warning about missing child model.
     private: bool suppressChildWarning{false};
 
+    /// \brief Whether the joint entity is kept while detached.
+    private: bool persistent{false};
+
     /// \brief Entity of attachment link in the parent model
     private: Entity parentLinkEntity{kNullEntity};
 
@@ -37,9 +37,11 @@
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 
+#include "gz/sim/components/AngularVelocityCmd.hh"
 #include "gz/sim/components/CanonicalLink.hh"
 #include "gz/sim/components/JointPosition.hh"
 #include "gz/sim/components/JointVelocityCmd.hh"
+#include "gz/sim/components/LinearVelocityCmd.hh"
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
@@ -84,6 +86,13 @@ class gz::sim::systems::DiffDrivePrivate
   public: void UpdateVelocity(const UpdateInfo &_info,
     const EntityComponentManager &_ecm);
 
+  /// \brief Apply the commanded velocities to the model in kinematic mode.
+  /// \param[in] _info System update information.
+  /// \param[in] _ecm The EntityComponentManager of the given simulation
+  /// instance.
+  public: void ApplyKinematicCommands(const UpdateInfo &_info,
+    EntityComponentManager &_ecm);
+
   /// \brief Gazebo communication node.
   public: transport::Node node;
 
@@ -111,6 +120,16 @@ class gz::sim::systems::DiffDrivePrivate
   /// \brief Wheel radius
   public: double wheelRadius{0.2};
 
+  /// \brief True to move the model from the commanded velocities instead of
+  /// commanding the wheel joints.
+  public: bool kinematic{false};
+
+  /// \brief Angle the left wheels would have rotated by in kinematic mode.
+  public: double kinematicLeftAngle{0.0};
+
+  /// \brief Angle the right wheels would have rotated by in kinematic mode.
+  public: double kinematicRightAngle{0.0};
+
   /// \brief Model interface
   public: Model model{kNullEntity};
 
@@ -205,6 +224,8 @@ void DiffDrive::Configure(const Entity &_entity,
       this->dataPtr->wheelSeparation).first;
   this->dataPtr->wheelRadius = _sdf->Get<double>("wheel_radius",
       this->dataPtr->wheelRadius).first;
+  this->dataPtr->kinematic = _sdf->Get<bool>("kinematic",
+      this->dataPtr->kinematic).first;
 
   // Instantiate the speed limiters.
   this->dataPtr->limiterLin = std::make_unique<math::SpeedLimiter>();
@@ -400,6 +421,14 @@ void DiffDrive::PreUpdate(const UpdateInfo &_info,
         << "s]. System may not work properly." << std::endl;
   }
 
+  // The wheel joints aren't needed in kinematic mode
+  if (this->dataPtr->kinematic)
+  {
+    if (!_info.paused)
+      this->dataPtr->ApplyKinematicCommands(_info, _ecm);
+    return;
+  }
+
   // If the joints haven't been identified yet, look for them
   static std::set<std::string> warnedModels;
   auto modelName = this->dataPtr->model.Name(_ecm);
@@ -518,23 +547,32 @@ void DiffDrivePrivate::UpdateOdometry(const UpdateInfo &_info,
     return;
   }
 
-  if (this->leftJoints.empty() || this->rightJoints.empty())
-    return;
-
-  // Get the first joint positions for the left and right side.
-  auto leftPos = _ecm.Component<components::JointPosition>(this->leftJoints[0]);
-  auto rightPos = _ecm.Component<components::JointPosition>(
-      this->rightJoints[0]);
-
-  // Abort if the joints were not found or just created.
-  if (!leftPos || !rightPos || leftPos->Data().empty() ||
-      rightPos->Data().empty())
+  if (this->kinematic)
   {
-    return;
+    this->odom.Update(this->kinematicLeftAngle, this->kinematicRightAngle,
+        std::chrono::steady_clock::time_point(_info.simTime));
   }
+  else
+  {
+    if (this->leftJoints.empty() || this->rightJoints.empty())
+      return;
+
+    // Get the first joint positions for the left and right side.
+    auto leftPos = _ecm.Component<components::JointPosition>(
+        this->leftJoints[0]);
+    auto rightPos = _ecm.Component<components::JointPosition>(
+        this->rightJoints[0]);
+
+    // Abort if the joints were not found or just created.
+    if (!leftPos || !rightPos || leftPos->Data().empty() ||
+        rightPos->Data().empty())
+    {
+      return;
+    }
 
-  this->odom.Update(leftPos->Data()[0], rightPos->Data()[0],
-      std::chrono::steady_clock::time_point(_info.simTime));
+    this->odom.Update(leftPos->Data()[0], rightPos->Data()[0],
+        std::chrono::steady_clock::time_point(_info.simTime));
+  }
 
   // Throttle publishing
   auto diff = _info.simTime - this->lastOdomPubTime;
@@ -633,6 +671,25 @@ void DiffDrivePrivate::UpdateVelocity(const UpdateInfo &_info,
     (linVel - angVel * this->wheelSeparation / 2.0) / this->wheelRadius;
 }
 
+//////////////////////////////////////////////////
+void DiffDrivePrivate::ApplyKinematicCommands(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("DiffDrive::ApplyKinematicCommands");
+
+  // Velocity commands are expressed in the model frame and are reset by
+  // physics after every step, so they are set on every iteration.
+  _ecm.SetComponentData<components::LinearVelocityCmd>(
+      this->model.Entity(), {this->last0Cmd.lin, 0, 0});
+  _ecm.SetComponentData<components::AngularVelocityCmd>(
+      this->model.Entity(), {0, 0, this->last0Cmd.ang});
+
+  // Keep track of how the wheels would have turned for odometry.
+  double dt = std::chrono::duration<double>(_info.dt).count();
+  this->kinematicLeftAngle += this->leftJointSpeed * dt;
+  this->kinematicRightAngle += this->rightJointSpeed * dt;
+}
+
 //////////////////////////////////////////////////
 void DiffDrivePrivate::OnCmdVel(const msgs::Twist &_msg)
 {
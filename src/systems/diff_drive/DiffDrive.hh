@@ -51,6 +51,13 @@ namespace systems
   /// although it is recommended to be included with an appropriate value. The
   /// default value is 0.2m.
   ///
+  /// - `<kinematic>`: If true, the wheel joints aren't commanded. Instead,
+  /// the commanded velocities are applied directly to the model as linear and
+  /// angular velocity commands, skipping the wheel dynamics, and odometry is
+  /// integrated from the commanded velocities. This is cheaper to simulate
+  /// for large fleets, and the joints don't need to exist. The default value
+  /// is false.
+  ///
   /// - `<odom_publish_frequency>`: Odometry publication frequency. This
   /// element is optional, and the default value is 50Hz.
   ///
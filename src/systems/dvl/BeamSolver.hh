@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_DVL_BEAM_SOLVER_HH_
+#define GZ_SIM_SYSTEMS_DVL_BEAM_SOLVER_HH_
+
+#include <cmath>
+#include <cstddef>
+
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::dvl
+{
+  /// \brief Helper class that estimates the velocity of a DVL from the
+  /// speeds measured along its beams, as the least squares solution of
+  /// axis_i . v = speed_i over all locked beams.
+  class BeamSolver
+  {
+    /// \brief Remove all beams.
+    public: void Clear()
+    {
+      this->normal = math::Matrix3d::Zero;
+      this->projection = math::Vector3d::Zero;
+      this->count = 0u;
+    }
+
+    /// \brief Add a locked beam.
+    /// \param[in] _axis Unit axis of the beam.
+    /// \param[in] _speed Speed measured along the axis.
+    public: void AddBeam(const math::Vector3d &_axis, const double _speed)
+    {
+      this->normal = this->normal + math::Matrix3d(
+          _axis.X() * _axis.X(), _axis.X() * _axis.Y(), _axis.X() * _axis.Z(),
+          _axis.Y() * _axis.X(), _axis.Y() * _axis.Y(), _axis.Y() * _axis.Z(),
+          _axis.Z() * _axis.X(), _axis.Z() * _axis.Y(), _axis.Z() * _axis.Z());
+      this->projection += _axis * _speed;
+      ++this->count;
+    }
+
+    /// \brief Get the number of beams added since the last clear.
+    /// \return Number of beams.
+    public: std::size_t BeamCount() const
+    {
+      return this->count;
+    }
+
+    /// \brief Estimate the velocity.
+    /// \param[out] _velocity Velocity, in the frame of the axes.
+    /// \param[out] _covariance Covariance of the velocity for unit variance
+    /// of the speeds, to be scaled by their actual variance.
+    /// \return False if the beams don't span all three dimensions, such as
+    /// when fewer than three are locked.
+    public: bool Solve(math::Vector3d &_velocity,
+                       math::Matrix3d &_covariance) const
+    {
+      // Unit axes keep the determinant independent of the scale of the
+      // speeds, so a fixed threshold rejects nearly coplanar beams
+      constexpr double kMinDeterminant{1e-6};
+      if (this->count < 3u ||
+          std::abs(this->normal.Determinant()) < kMinDeterminant)
+      {
+        return false;
+      }
+      _covariance = this->normal.Inverse();
+      _velocity = _covariance * this->projection;
+      return true;
+    }
+
+    /// \brief Sum of the outer products of the axes.
+    private: math::Matrix3d normal{math::Matrix3d::Zero};
+
+    /// \brief Sum of the axes scaled by their speeds.
+    private: math::Vector3d projection{math::Vector3d::Zero};
+
+    /// \brief Number of beams.
+    private: std::size_t count{0u};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Quaternion.hh>
+
+#include "BeamSolver.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::dvl;
+
+/////////////////////////////////////////////////
+TEST(BeamSolver, Janus)
+{
+  // Four beams tilted 30 degrees from the vertical, 90 degrees apart
+  const math::Vector3d velocity{1.0, -0.5, 0.2};
+  BeamSolver solver;
+  for (double rotation : {45.0, 135.0, -45.0, -135.0})
+  {
+    const math::Quaterniond rot(0.0, GZ_DTOR(30.0), GZ_DTOR(rotation));
+    const auto axis = rot.RotateVector(-math::Vector3d::UnitZ);
+    solver.AddBeam(axis, axis.Dot(velocity));
+  }
+  EXPECT_EQ(4u, solver.BeamCount());
+
+  math::Vector3d estimate;
+  math::Matrix3d covariance;
+  ASSERT_TRUE(solver.Solve(estimate, covariance));
+  EXPECT_NEAR(velocity.X(), estimate.X(), 1e-9);
+  EXPECT_NEAR(velocity.Y(), estimate.Y(), 1e-9);
+  EXPECT_NEAR(velocity.Z(), estimate.Z(), 1e-9);
+
+  // Beams close to the vertical resolve vertical speeds best
+  EXPECT_NEAR(2.0, covariance(0, 0), 1e-9);
+  EXPECT_NEAR(1.0 / 3.0, covariance(2, 2), 1e-9);
+  EXPECT_DOUBLE_EQ(covariance(0, 1), covariance(1, 0));
+}
+
+/////////////////////////////////////////////////
+TEST(BeamSolver, Underdetermined)
+{
+  BeamSolver solver;
+  math::Vector3d estimate;
+  math::Matrix3d covariance;
+  EXPECT_FALSE(solver.Solve(estimate, covariance));
+
+  solver.AddBeam(math::Vector3d::UnitX, 1.0);
+  solver.AddBeam(math::Vector3d::UnitY, 1.0);
+  EXPECT_FALSE(solver.Solve(estimate, covariance));
+
+  // Coplanar beams
+  solver.AddBeam(math::Vector3d(1, 1, 0).Normalized(), 1.0);
+  EXPECT_FALSE(solver.Solve(estimate, covariance));
+
+  solver.Clear();
+  EXPECT_EQ(0u, solver.BeamCount());
+  solver.AddBeam(math::Vector3d::UnitX, 1.0);
+  solver.AddBeam(math::Vector3d::UnitY, 2.0);
+  solver.AddBeam(math::Vector3d::UnitZ, 3.0);
+  ASSERT_TRUE(solver.Solve(estimate, covariance));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), estimate);
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "CpuBackend.hh"
+
+#include <gz/msgs/dvl_velocity_tracking.pb.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Rand.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/transport/Node.hh>
+
+#include <sdf/Element.hh>
+#include <sdf/Noise.hh>
+
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/Link.hh"
+#include "gz/sim/Util.hh"
+
+#include "../../CollisionRayCaster.hh"
+#include "../../NoiseGenerator.hh"
+#include "../../ThreadPool.hh"
+#include "BeamSolver.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+using namespace dvl;
+
+/// \brief An acoustic beam of a DVL.
+struct Beam
+{
+  /// \brief ID of the beam.
+  int id{0};
+
+  /// \brief Unit axis of the beam in the sensor frame.
+  math::Vector3d axis;
+
+  /// \brief Distance to the hit of the current update, infinity if there
+  /// isn't any.
+  double range{0.0};
+};
+
+/// \brief A DVL and its latest measurement.
+struct CpuDvl
+{
+  /// \brief Scoped name of the sensor, also used as its frame.
+  std::string name;
+
+  /// \brief Link the sensor is attached to.
+  Link link;
+
+  /// \brief The link the sensor is attached to, whose collisions the beams
+  /// don't see.
+  std::unordered_set<Entity> excludedLinks;
+
+  /// \brief Beams of the sensor.
+  std::vector<Beam> beams;
+
+  /// \brief Reference frame of the velocities, in the sensor frame.
+  math::Pose3d referenceFrame;
+
+  /// \brief Type reported in the messages.
+  msgs::DVLVelocityTracking::DVLType type{
+      msgs::DVLVelocityTracking::DVL_TYPE_UNSPECIFIED};
+
+  /// \brief Minimum range of the beams.
+  double minRange{0.1};
+
+  /// \brief Maximum range of the beams.
+  double maxRange{100.0};
+
+  /// \brief Whether bottom tracking is enabled.
+  bool bottomTracking{true};
+
+  /// \brief Noise of the speeds measured by the beams.
+  sdf::Noise noise;
+
+  /// \brief Generator of the noise, with the sensor as its stream.
+  NoiseGenerator noiseGenerator{0u, 0u};
+
+  /// \brief Time between updates, zero to update every step.
+  std::chrono::steady_clock::duration period{0};
+
+  /// \brief Sim time of the next update.
+  std::chrono::steady_clock::duration nextUpdate{0};
+
+  /// \brief Publisher of the measurements.
+  transport::Node::Publisher pub;
+
+  /// \brief World pose of the sensor for the current update.
+  math::Pose3d worldPose;
+
+  /// \brief World velocity of the sensor origin for the current update.
+  math::Vector3d worldVelocity;
+};
+
+/// \brief Private CpuBackend data class.
+class gz::sim::systems::dvl::CpuBackendPrivate
+{
+  /// \brief Fill and publish the message of a sensor whose beams were
+  /// cast.
+  /// \param[in] _info Update info.
+  /// \param[in] _sensor The sensor.
+  public: void Publish(const UpdateInfo &_info, CpuDvl &_sensor);
+
+  /// \brief Sensors by entity.
+  public: std::unordered_map<Entity, CpuDvl> sensors;
+
+  /// \brief Collision shapes of the world, shared with the other systems
+  /// that cast rays.
+  public: std::shared_ptr<CollisionRayCaster> caster;
+
+  /// \brief Message reused across updates.
+  public: msgs::DVLVelocityTracking msg;
+
+  /// \brief Transport node.
+  public: transport::Node node;
+};
+
+//////////////////////////////////////////////////
+CpuBackend::CpuBackend() : dataPtr(std::make_unique<CpuBackendPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+CpuBackend::~CpuBackend() = default;
+
+//////////////////////////////////////////////////
+bool CpuBackend::AddSensor(EntityComponentManager &_ecm,
+    const Entity _entity, const Entity _parent, const sdf::Sensor &_sdf)
+{
+  sdf::ElementPtr root = _sdf.Element();
+  sdf::ElementPtr dvlElem = root ? root->FindElement("gz:dvl") : nullptr;
+  if (!dvlElem)
+  {
+    gzerr << "DVL [" << _sdf.Name() << "] is missing its <gz:dvl> element."
+          << std::endl;
+    return false;
+  }
+
+  CpuDvl sensor;
+  sensor.name = _sdf.Name();
+  sensor.link = Link(_parent);
+  sensor.excludedLinks.insert(_parent);
+  sensor.link.EnableVelocityChecks(_ecm);
+
+  const auto type = dvlElem->Get<std::string>("type", "").first;
+  if (type == "piston")
+    sensor.type = msgs::DVLVelocityTracking::DVL_TYPE_PISTON;
+  else if (type == "phased_array")
+    sensor.type = msgs::DVLVelocityTracking::DVL_TYPE_PHASED_ARRAY;
+
+  sdf::ElementPtr arrangement = dvlElem->FindElement("arrangement");
+  if (!arrangement || !arrangement->HasElement("beam"))
+  {
+    gzerr << "DVL [" << _sdf.Name() << "] has no beams." << std::endl;
+    return false;
+  }
+  const bool degrees = arrangement->Get<bool>("degrees", false).first;
+  const double toRadians = degrees ? GZ_PI / 180.0 : 1.0;
+  int nextId{1};
+  for (auto beamElem = arrangement->FindElement("beam"); beamElem;
+       beamElem = beamElem->GetNextElement("beam"))
+  {
+    Beam beam;
+    beam.id = beamElem->Get<int>("id", nextId).first;
+    nextId = beam.id + 1;
+    const double rotation =
+        beamElem->Get<double>("rotation", 0.0).first * toRadians;
+    const double tilt = beamElem->Get<double>("tilt", 0.0).first * toRadians;
+    // Beams point down, tilted away from the vertical and then rotated
+    // about it
+    beam.axis = math::Quaterniond(0.0, tilt, rotation).RotateVector(
+        -math::Vector3d::UnitZ);
+    sensor.beams.push_back(beam);
+  }
+
+  sensor.minRange = dvlElem->Get<double>("minimum_range",
+      sensor.minRange).first;
+  sensor.maxRange = dvlElem->Get<double>("maximum_range",
+      sensor.maxRange).first;
+  sensor.referenceFrame = dvlElem->Get<math::Pose3d>("reference_frame",
+      math::Pose3d::Zero).first;
+
+  sdf::ElementPtr tracking = dvlElem->FindElement("tracking");
+  if (tracking && tracking->HasElement("water_mass_mode"))
+  {
+    gzwarn << "DVL [" << _sdf.Name() << "] has water mass tracking, which "
+           << "isn't supported by the CPU backend. Only bottom tracking "
+           << "will be simulated." << std::endl;
+  }
+  sdf::ElementPtr bottomMode = tracking && tracking->HasElement(
+      "bottom_mode") ? tracking->GetElement("bottom_mode") : nullptr;
+  if (bottomMode)
+  {
+    sensor.bottomTracking =
+        bottomMode->Get<std::string>("when", "best").first != "never";
+    if (bottomMode->HasElement("noise"))
+      sensor.noise.Load(bottomMode->GetElement("noise"));
+  }
+  sensor.noiseGenerator = NoiseGenerator(math::Rand::Seed(), _entity);
+
+  if (_sdf.UpdateRate() > 0)
+  {
+    sensor.period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / _sdf.UpdateRate()));
+  }
+
+  sensor.pub = this->dataPtr->node.Advertise<msgs::DVLVelocityTracking>(
+      _sdf.Topic());
+  if (!sensor.pub)
+  {
+    gzerr << "Failed to advertise DVL topic [" << _sdf.Topic() << "]."
+          << std::endl;
+    return false;
+  }
+
+  this->dataPtr->sensors[_entity] = std::move(sensor);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void CpuBackend::RemoveSensor(const Entity _entity)
+{
+  this->dataPtr->sensors.erase(_entity);
+}
+
+//////////////////////////////////////////////////
+void CpuBackend::Update(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("DopplerVelocityLogSystem::CpuBackend::Update");
+
+  // Only update and publish if not paused.
+  if (_info.paused)
+    return;
+
+  // Find the sensors that are due and have subscribers
+  std::vector<CpuDvl *> due;
+  for (auto &[entity, sensor] : this->dataPtr->sensors)
+  {
+    // Start over after jumping back in time
+    if (sensor.nextUpdate > _info.simTime + sensor.period)
+      sensor.nextUpdate = _info.simTime;
+
+    if (sensor.nextUpdate > _info.simTime)
+      continue;
+    sensor.nextUpdate = _info.simTime + sensor.period;
+
+    if (!sensor.pub.HasConnections())
+      continue;
+
+    sensor.worldPose = worldPose(entity, _ecm);
+    const auto linkPose = sensor.link.WorldPose(_ecm);
+    const auto offset = linkPose ? linkPose->Rot().RotateVectorReverse(
+        sensor.worldPose.Pos() - linkPose->Pos()) : math::Vector3d::Zero;
+    sensor.worldVelocity = sensor.link.WorldLinearVelocity(_ecm, offset)
+        .value_or(math::Vector3d::Zero);
+    sensor.noiseGenerator.Reset(_info.iterations);
+    due.push_back(&sensor);
+  }
+  if (due.empty())
+    return;
+
+  if (!this->dataPtr->caster)
+    this->dataPtr->caster = CollisionRayCaster::Shared(_ecm);
+  this->dataPtr->caster->Update(_info, _ecm);
+
+  {
+    GZ_PROFILE("DopplerVelocityLogSystem::CpuBackend::CastBeams");
+    // Beams of all sensors are cast as one batch
+    std::vector<std::pair<CpuDvl *, Beam *>> beams;
+    for (auto *sensor : due)
+    {
+      for (auto &beam : sensor->beams)
+        beams.emplace_back(sensor, &beam);
+    }
+
+    auto &pool = ThreadPool::Shared();
+    constexpr std::size_t kMinGrainSize{16u};
+    pool.ParallelFor(beams.size(), pool.GrainSize(beams.size(),
+        kMinGrainSize),
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          auto &[sensor, beam] = beams[i];
+          const auto &pose = sensor->worldPose;
+          beam->range = this->dataPtr->caster->Cast(pose.Pos(),
+              pose.Rot().RotateVector(beam->axis), sensor->maxRange,
+              sensor->excludedLinks);
+        }
+      });
+  }
+
+  for (auto *sensor : due)
+    this->dataPtr->Publish(_info, *sensor);
+}
+
+//////////////////////////////////////////////////
+void CpuBackendPrivate::Publish(const UpdateInfo &_info, CpuDvl &_sensor)
+{
+  auto &msg = this->msg;
+  msg.Clear();
+  *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(
+      _info.simTime);
+  auto frame = msg.mutable_header()->add_data();
+  frame->set_key("frame_id");
+  frame->add_value(_sensor.name);
+  msg.set_type(_sensor.type);
+
+  const bool noisy = _sensor.noise.Type() == sdf::NoiseType::GAUSSIAN &&
+      _sensor.noise.StdDev() > 0;
+  const double variance = noisy ?
+      _sensor.noise.StdDev() * _sensor.noise.StdDev() : 0.0;
+
+  // Velocities are reported in the reference frame
+  const auto &referenceRot = _sensor.referenceFrame.Rot();
+  const auto worldToReference = _sensor.worldPose.Rot() * referenceRot;
+  const auto velocity =
+      worldToReference.RotateVectorReverse(_sensor.worldVelocity);
+
+  BeamSolver solver;
+  double rangeSum{0.0};
+  for (const auto &beam : _sensor.beams)
+  {
+    auto *beamMsg = msg.add_beams();
+    beamMsg->set_id(beam.id);
+    const bool locked = _sensor.bottomTracking &&
+        std::isfinite(beam.range) && beam.range >= _sensor.minRange;
+    beamMsg->set_locked(locked);
+    if (!locked)
+      continue;
+
+    const auto axis = referenceRot.RotateVectorReverse(beam.axis);
+    double speed = axis.Dot(velocity);
+    if (noisy)
+    {
+      speed += _sensor.noiseGenerator.Normal(_sensor.noise.Mean(),
+          _sensor.noise.StdDev());
+    }
+    solver.AddBeam(axis, speed);
+    rangeSum += beam.range;
+
+    beamMsg->mutable_range()->set_mean(beam.range);
+    auto *beamVelocity = beamMsg->mutable_velocity();
+    beamVelocity->set_reference(msgs::DVLKinematicEstimate::DVL_REFERENCE_SHIP);
+    msgs::Set(beamVelocity->mutable_mean(), axis * speed);
+  }
+
+  if (solver.BeamCount() > 0u)
+  {
+    auto *target = msg.mutable_target();
+    target->set_type(msgs::DVLTrackingTarget::DVL_TARGET_BOTTOM);
+    target->mutable_range()->set_mean(
+        rangeSum / static_cast<double>(solver.BeamCount()));
+  }
+
+  math::Vector3d estimate;
+  math::Matrix3d covariance;
+  if (solver.Solve(estimate, covariance))
+  {
+    auto *velocityMsg = msg.mutable_velocity();
+    velocityMsg->set_reference(msgs::DVLKinematicEstimate::DVL_REFERENCE_SHIP);
+    msgs::Set(velocityMsg->mutable_mean(), estimate);
+    for (std::size_t row = 0; row < 3u; ++row)
+    {
+      for (std::size_t col = 0; col < 3u; ++col)
+        velocityMsg->add_covariance(variance * covariance(row, col));
+    }
+  }
+
+  _sensor.pub.Publish(msg);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_DVL_CPU_BACKEND_HH_
+#define GZ_SIM_SYSTEMS_DVL_CPU_BACKEND_HH_
+
+#include <memory>
+
+#include <sdf/Sensor.hh>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/Entity.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Types.hh"
+
+namespace gz::sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::dvl
+{
+  // Forward declarations.
+  class CpuBackendPrivate;
+
+  /// \brief DVL sensors that cast their beams against the collision geometry
+  /// of the world on the CPU instead of rendering them, and publish the
+  /// same gz::msgs::DVLVelocityTracking as the rendering backend.
+  ///
+  /// Only bottom tracking is simulated. Each beam is a single ray along its
+  /// axis, from the sensor origin, so the aperture is ignored. A beam is
+  /// locked when it hits something between the minimum and maximum range,
+  /// and measures the speed of the sensor along its axis, plus the bottom
+  /// mode noise, assuming that what it hit is static. The velocity is the
+  /// least squares fit of the locked beams, in the reference frame, and the
+  /// target range is the mean range of the locked beams.
+  ///
+  /// Rays of all due sensors are cast together on the shared thread pool.
+  class CpuBackend
+  {
+    /// \brief Constructor.
+    public: CpuBackend();
+
+    /// \brief Destructor.
+    public: ~CpuBackend();
+
+    /// \brief Create a sensor.
+    /// \param[in] _ecm Mutable reference to the ECM.
+    /// \param[in] _entity Entity of the sensor.
+    /// \param[in] _parent Link the sensor is attached to.
+    /// \param[in] _sdf Sensor SDF DOM, with its scoped name and topic set.
+    /// \return True if the sensor was created.
+    public: bool AddSensor(EntityComponentManager &_ecm, const Entity _entity,
+                const Entity _parent, const sdf::Sensor &_sdf);
+
+    /// \brief Remove a sensor.
+    /// \param[in] _entity Entity of the sensor.
+    public: void RemoveSensor(const Entity _entity);
+
+    /// \brief Update the sensors that are due and publish their data.
+    /// \param[in] _info Update info.
+    /// \param[in] _ecm Immutable reference to the ECM.
+    public: void Update(const UpdateInfo &_info,
+                const EntityComponentManager &_ecm);
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<CpuBackendPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
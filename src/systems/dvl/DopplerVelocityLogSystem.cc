@@ -28,6 +28,7 @@
 
 #include <gz/sim/components/AngularVelocity.hh>
 #include <gz/sim/components/CustomSensor.hh>
+#include <gz/sim/components/Environment.hh>
 #include <gz/sim/components/LinearVelocity.hh>
 #include <gz/sim/components/Name.hh>
 #include <gz/sim/components/ParentEntity.hh>
@@ -52,6 +53,7 @@
 #include <gz/sensors/DopplerVelocityLog.hh>
 #include <gz/sensors/Manager.hh>
 
+#include "CpuBackend.hh"
 #include "DopplerVelocityLogSystem.hh"
 
 namespace gz
@@ -182,6 +184,9 @@ class gz::sim::systems::DopplerVelocityLogSystem::Implementation
   /// \brief Sensor managers
   public: gz::sensors::Manager sensorManager;
 
+  /// \brief Sensors cast on the CPU, null when rendering is used
+  public: std::unique_ptr<gz::sim::systems::dvl::CpuBackend> cpuBackend;
+
   /// \brief Entities of known sensors (in simulation thread)
   public: std::unordered_set<gz::sim::Entity> knownSensorEntities;
 
@@ -192,6 +197,10 @@ class gz::sim::systems::DopplerVelocityLogSystem::Implementation
   /// \brief IDs of sensors updated in the last rendering pass
   public: std::vector<gz::sensors::SensorId> updatedSensorIds;
 
+  /// \brief Environmental data last sent to the sensors, replaced whenever
+  /// the preload system streams another window of time
+  public: std::shared_ptr<gz::sim::components::EnvironmentalData> envData;
+
   /// \brief Queue of requests from simulation thread to rendering thread
   public: std::vector<requests::SomeRequest> perStepRequests;
 
@@ -232,10 +241,23 @@ using namespace systems;
 //////////////////////////////////////////////////
 void DopplerVelocityLogSystem::Implementation::DoConfigure(
     const gz::sim::Entity &,
-    const std::shared_ptr<const sdf::Element> &,
+    const std::shared_ptr<const sdf::Element> &_sdf,
     gz::sim::EntityComponentManager &,
     gz::sim::EventManager &_eventMgr)
 {
+  const auto backend = _sdf->Get<std::string>("backend", "rendering").first;
+  if (backend == "cpu")
+  {
+    gzdbg << "Casting DVL beams on the CPU." << std::endl;
+    this->cpuBackend = std::make_unique<gz::sim::systems::dvl::CpuBackend>();
+    return;
+  }
+  if (backend != "rendering")
+  {
+    gzwarn << "Unknown DVL backend [" << backend << "], using rendering."
+           << std::endl;
+  }
+
   this->preRenderConn =
       _eventMgr.Connect<gz::sim::events::PreRender>(
           std::bind(&Implementation::OnPreRender, this));
@@ -260,27 +282,25 @@ void DopplerVelocityLogSystem::Implementation::DoPreUpdate(
   const gz::sim::UpdateInfo &,
   gz::sim::EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<gz::sim::components::Environment>(
-    [&](const gz::sim::Entity &_entity,
-        const gz::sim::components::Environment *_env) -> bool
-    {
-      if (_entity == gz::sim::worldEntity(_ecm))
-      {
-        // \todo(anyone) Create an EnvironmentalData DOM class
-        // in sdformat and make gz-sensors and gz-sim use this
-        // generic data structure? Currently the data structure is
-        // duplicated in the two libraries.
-        auto envData = sensors::EnvironmentalData::MakeShared(
-            _env->Data()->frame, _env->Data()->reference,
-            static_cast<gz::sensors::EnvironmentalData::ReferenceUnits>(
-                _env->Data()->units),
-            _env->Data()->staticTime);
-
-        this->perStepRequests.push_back(
-          requests::SetEnvironmentalData{envData});
-      }
-      return true;
-    });
+  auto env = _ecm.Component<gz::sim::components::Environment>(
+      gz::sim::worldEntity(_ecm));
+  if (!this->cpuBackend && nullptr != env && env->Data() != this->envData)
+  {
+    this->envData = env->Data();
+
+    // \todo(anyone) Create an EnvironmentalData DOM class
+    // in sdformat and make gz-sensors and gz-sim use this
+    // generic data structure? Currently the data structure is
+    // duplicated in the two libraries.
+    auto envData = sensors::EnvironmentalData::MakeShared(
+        env->Data()->frame, env->Data()->reference,
+        static_cast<gz::sensors::EnvironmentalData::ReferenceUnits>(
+            env->Data()->units),
+        env->Data()->staticTime);
+
+    this->perStepRequests.push_back(
+      requests::SetEnvironmentalData{envData});
+  }
 
   _ecm.EachNew<gz::sim::components::CustomSensor,
                gz::sim::components::ParentEntity>(
@@ -328,6 +348,13 @@ void DopplerVelocityLogSystem::Implementation::DoPreUpdate(
       enableComponent<components::WorldAngularVelocity>(_ecm, _entity);
       enableComponent<components::WorldLinearVelocity>(_ecm, _entity);
 
+      if (this->cpuBackend)
+      {
+        if (this->cpuBackend->AddSensor(_ecm, _entity, _parent->Data(), sdf))
+          this->knownSensorEntities.insert(_entity);
+        return true;
+      }
+
       this->perStepRequests.push_back(requests::CreateSensor{
           sdf, _entity, _parent->Data(), parentName->Data()});
 
@@ -347,13 +374,26 @@ void DopplerVelocityLogSystem::Implementation::DoPostUpdate(
     {
       if (this->knownSensorEntities.count(_entity))
       {
-        this->perStepRequests.push_back(
-            requests::DestroySensor{_entity});
+        if (this->cpuBackend)
+        {
+          this->cpuBackend->RemoveSensor(_entity);
+        }
+        else
+        {
+          this->perStepRequests.push_back(
+              requests::DestroySensor{_entity});
+        }
         this->knownSensorEntities.erase(_entity);
       }
       return true;
     });
 
+  if (this->cpuBackend)
+  {
+    this->cpuBackend->Update(_info, _ecm);
+    return;
+  }
+
   std::lock_guard<std::mutex> timeLock(this->timeMutex);
 
   if (!this->perStepRequests.empty() || (
@@ -33,6 +33,15 @@ namespace systems
 {
 
 /// \brief System that creates and updates DopplerVelocityLog (DVL) sensors.
+///
+/// ## System Parameters
+///
+/// - `<backend>`: `rendering` (default) to render the beams with
+///   gz-sensors, which needs a GPU, or `cpu` to cast them against the
+///   collision geometry of the world, so DVLs run on machines without one.
+///   The CPU backend only simulates bottom tracking and ignores the beam
+///   apertures. Its beams don't see the collisions of the sensor's link,
+///   and are cast the same way as the physics system's ray queries.
 class DopplerVelocityLogSystem :
   public System,
   public ISystemConfigure,
@@ -17,7 +17,12 @@
 #include "EnvironmentPreload.hh"
 #include "VisualizationTool.hh"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <optional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -27,6 +32,8 @@
 #include <gz/common/DataFrame.hh>
 #include <gz/common/Filesystem.hh>
 
+#include <gz/math/AxisAlignedBox.hh>
+
 #include <gz/plugin/Register.hh>
 
 #include <gz/transport/Node.hh>
@@ -38,6 +45,8 @@
 #include "gz/sim/components/World.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../EnvironmentGrid.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -82,6 +91,27 @@ class gz::sim::systems::EnvironmentPreloadPrivate
   /// \brief Reference to data
   public: std::shared_ptr<components::EnvironmentalData> envData;
 
+  /// \brief Region of binary grids to load, or nullopt to load all of them
+  public: std::optional<math::AxisAlignedBox> region;
+
+  /// \brief Seconds of data of binary grids to keep loaded, or 0 to load
+  /// all of them
+  public: double timeWindow{0.0};
+
+  /// \brief Binary grid whose data is loaded a window of time at a time, or
+  /// nullptr
+  public: std::shared_ptr<EnvironmentGrid> streamedGrid;
+
+  /// \brief First and last time of the loaded window
+  public: std::pair<double, double> window{0.0, 0.0};
+
+  /// \brief First and last time of the next window
+  public: std::pair<double, double> nextTimes{0.0, 0.0};
+
+  /// \brief Next window, being loaded in the background
+  public: std::future<std::shared_ptr<components::EnvironmentalData>>
+      nextWindow;
+
   //////////////////////////////////////////////////
   public: EnvironmentPreloadPrivate() :
     visualizationPtr(new EnvironmentVisualizationTool) {}
@@ -146,6 +176,26 @@ class gz::sim::systems::EnvironmentPreloadPrivate
     }
     this->dataDescription.set_path(dataPath);
 
+    // Large binary grids may be cropped to the area being simulated
+    if (auto regionElem = this->sdf->FindElement("region"))
+    {
+      this->region = math::AxisAlignedBox(
+          regionElem->Get<math::Vector3d>("min"),
+          regionElem->Get<math::Vector3d>("max"));
+    }
+
+    // Long time series of binary grids may be streamed
+    if (this->sdf->HasElement("time_window"))
+    {
+      this->timeWindow = this->sdf->Get<double>("time_window");
+      if (this->timeWindow < 0.0)
+      {
+        gzerr << "Negative <time_window> [" << this->timeWindow
+              << "], all the data will be loaded." << std::endl;
+        this->timeWindow = 0.0;
+      }
+    }
+
     this->dataDescription.set_units(
       Units::DataLoadPathOptions_DataAngularUnits_RADIANS);
     std::string timeColumnName{"t"};
@@ -242,11 +292,115 @@ class gz::sim::systems::EnvironmentPreloadPrivate
   }
 
   //////////////////////////////////////////////////
-  public: void LoadEnvironment(EntityComponentManager &_ecm)
+  /// \brief Load the data of a binary grid.
+  /// \param[in] _grid The grid.
+  /// \param[in] _region Region to load, or nullopt for all of it.
+  /// \param[in] _times Window of time to load, or nullopt for all of it.
+  /// \param[in] _reference Spatial reference of the data.
+  /// \param[in] _units Angular units of the data.
+  /// \param[in] _staticTime Whether to ignore the time of the data.
+  /// \return The data.
+  public: static std::shared_ptr<components::EnvironmentalData> LoadGrid(
+      const EnvironmentGrid &_grid,
+      const std::optional<math::AxisAlignedBox> &_region,
+      const std::optional<std::pair<double, double>> &_times,
+      components::EnvironmentalData::ReferenceT _reference,
+      components::EnvironmentalData::ReferenceUnits _units,
+      bool _staticTime)
+  {
+    using ComponentDataT = components::EnvironmentalData;
+    std::size_t cells{0u};
+    auto data = ComponentDataT::MakeShared(
+        _grid.Frame(_region, cells, _times), _reference, _units,
+        _staticTime);
+    data->grid = _grid.Grid(_region, _times);
+    data->frameBytes = cells * (_grid.Fields().size() *
+        sizeof(std::optional<double>) + 4u * sizeof(double)) +
+        data->grid->Values().size() * sizeof(float);
+    return data;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Set the data of the environment component.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _data The data.
+  public: void SetData(EntityComponentManager &_ecm,
+      std::shared_ptr<components::EnvironmentalData> _data)
+  {
+    this->envData = _data;
+    using ComponentT = components::Environment;
+    auto component = ComponentT{std::move(_data)};
+    _ecm.CreateComponent(worldEntity(_ecm), std::move(component));
+    this->visualizationPtr->resample = true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Swap in the window of a streamed grid holding a time, and start
+  /// loading the next window in the background.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _time Simulation time, in seconds.
+  public: void StreamEnvironment(EntityComponentManager &_ecm, double _time)
+  {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->streamedGrid)
+      return;
+
+    // Use the next window once it's ready, or wait for it if the current
+    // one runs out first
+    if (this->nextWindow.valid() && (_time > this->window.second ||
+        this->nextWindow.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready))
+    {
+      this->window = this->nextTimes;
+      this->SetData(_ecm, this->nextWindow.get());
+    }
+
+    // Jumps in time, such as resets, load the window holding the new time
+    // right away
+    const auto &times = this->streamedGrid->Axis(0);
+    if ((_time < this->window.first && this->window.first > times.front()) ||
+        (_time > this->window.second && this->window.second < times.back()))
+    {
+      gzdbg << "Loading environment data from time [" << _time << "]"
+            << std::endl;
+      this->window = {_time, _time + this->timeWindow};
+      this->SetData(_ecm, LoadGrid(*this->streamedGrid, this->region,
+          this->window, this->envData->reference, this->envData->units,
+          false));
+    }
+
+    // Start loading the next window once half of the current one has
+    // passed, so it's ready before it's needed
+    const double overlap = 0.5 * this->timeWindow;
+    if (!this->nextWindow.valid() &&
+        _time >= this->window.first + overlap &&
+        this->window.second < times.back())
+    {
+      this->nextTimes = {this->window.first + overlap,
+          this->window.second + overlap};
+      this->nextWindow = std::async(std::launch::async,
+          [grid = this->streamedGrid, region = this->region,
+           window = this->nextTimes, reference = this->envData->reference,
+           units = this->envData->units]()
+          {
+            return LoadGrid(*grid, region, window, reference, units, false);
+          });
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Load the data file.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _time Simulation time, in seconds.
+  public: void LoadEnvironment(EntityComponentManager &_ecm, double _time)
   {
     try
     {
       std::lock_guard<std::mutex> lock(this->mtx);
+
+      // Stop streaming the previous file
+      this->nextWindow = {};
+      this->streamedGrid.reset();
       std::array<std::string, 3> spatialColumnNames{
         this->dataDescription.x(),
         this->dataDescription.y(),
@@ -272,17 +426,71 @@ class gz::sim::systems::EnvironmentPreloadPrivate
         std::endl;
 
       using ComponentDataT = components::EnvironmentalData;
-      auto data = ComponentDataT::MakeShared(
-          common::IO<ComponentDataT::FrameT>::ReadFrom(
-              common::CSVIStreamIterator(dataFile),
-              common::CSVIStreamIterator(),
-              this->dataDescription.time(), spatialColumnNames),
-          spatialReference, units, this->dataDescription.static_time());
-      this->envData = data;
-      using ComponentT = components::Environment;
-      auto component = ComponentT{std::move(data)};
-      _ecm.CreateComponent(worldEntity(_ecm), std::move(component));
-      this->visualizationPtr->resample = true;
+      std::shared_ptr<ComponentDataT> data;
+      if (EnvironmentGrid::IsGridFile(this->dataDescription.path()))
+      {
+        // Binary grids are mapped, and only the samples within the region
+        // are read
+        auto grid = std::make_shared<EnvironmentGrid>();
+        if (!grid->Open(this->dataDescription.path()))
+        {
+          this->needsReload = false;
+          return;
+        }
+
+        // Long time series are loaded a window at a time
+        std::optional<std::pair<double, double>> times;
+        if (this->timeWindow > 0.0 && !this->dataDescription.static_time() &&
+            grid->Axis(0).size() > 1u)
+        {
+          this->window = {_time, _time + this->timeWindow};
+          times = this->window;
+        }
+        data = LoadGrid(*grid, this->region, times, spatialReference, units,
+            this->dataDescription.static_time());
+        if (times)
+          this->streamedGrid = grid;
+      }
+      else
+      {
+        // Count the samples for memory accounting, the frame's storage can't
+        // be inspected once it's loaded
+        std::string header;
+        std::getline(dataFile, header);
+        const auto columns =
+            static_cast<std::size_t>(std::count(header.begin(), header.end(),
+            ',')) + 1u;
+        const auto rows = static_cast<std::size_t>(std::count(
+            std::istreambuf_iterator<char>(dataFile),
+            std::istreambuf_iterator<char>(), '\n'));
+        dataFile.clear();
+        dataFile.seekg(0);
+
+        data = ComponentDataT::MakeShared(
+            common::IO<ComponentDataT::FrameT>::ReadFrom(
+                common::CSVIStreamIterator(dataFile),
+                common::CSVIStreamIterator(),
+                this->dataDescription.time(), spatialColumnNames),
+            spatialReference, units, this->dataDescription.static_time());
+        // Each data column holds one optional value per sample, and each
+        // sample is indexed by its time and position
+        const std::size_t dataColumns = columns > 4u ? columns - 4u : 0u;
+        data->frameBytes = rows * (dataColumns *
+            sizeof(std::optional<double>) + 4u * sizeof(double));
+
+        // Most data files are regular grids, which have faster lookups
+        data->grid = EnvironmentGrid::ReadCsv(this->dataDescription.path(),
+            this->dataDescription.time(), spatialColumnNames, 0.5);
+        if (data->grid)
+          data->frameBytes += data->grid->Values().size() * sizeof(float);
+        if (this->timeWindow > 0.0)
+        {
+          gzwarn << "Only binary grids can be streamed, all the data of ["
+                 << this->dataDescription.path() << "] is loaded."
+                 << std::endl;
+        }
+      }
+      this->SetData(_ecm, std::move(data));
       this->fileLoaded = true;
     }
     catch (const std::invalid_argument &exc)
@@ -341,10 +549,12 @@ void EnvironmentPreload::PreUpdate(
     this->dataPtr->ReadSdf(_ecm);
   }
 
+  const double time = std::chrono::duration<double>(_info.simTime).count();
   if (this->dataPtr->needsReload)
   {
-    this->dataPtr->LoadEnvironment(_ecm);
+    this->dataPtr->LoadEnvironment(_ecm, time);
   }
+  this->dataPtr->StreamEnvironment(_ecm, time);
 
   if (this->dataPtr->visualize)
   {
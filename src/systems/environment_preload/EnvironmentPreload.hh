@@ -37,6 +37,18 @@ namespace systems
   **/
   /// \brief A plugin to preload an Environment component
   /// into the ECM upon simulation start-up.
+  ///
+  /// The `<data>` file is either a CSV file or a binary grid, which is
+  /// memory-mapped and loads much faster. Convert CSV files with
+  /// `gz-sim-environment-convert`. Only the samples of a binary grid
+  /// within an optional `<region>`, given by its `<min>` and `<max>`
+  /// corners, are loaded.
+  ///
+  /// Binary grids holding long time series may be streamed: with a
+  /// `<time_window>`, in seconds, only the samples from the current time
+  /// to the end of the window are loaded. The next window is loaded in the
+  /// background once half of the current one has passed, and replaces it
+  /// in the Environment component.
   class EnvironmentPreload :
     public System,
     public ISystemConfigure,
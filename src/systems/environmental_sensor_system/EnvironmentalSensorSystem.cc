@@ -29,6 +29,7 @@
 #include <gz/sim/components/Sensor.hh>
 #include <gz/sim/components/SphericalCoordinates.hh>
 #include <gz/sim/components/LinearVelocity.hh>
+#include <gz/sim/RegularGrid.hh>
 #include <gz/sim/Util.hh>
 
 #include <gz/sensors/SensorFactory.hh>
@@ -43,6 +44,7 @@
 #include <unordered_set>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace gz;
 using namespace gz::sim;
@@ -197,7 +199,27 @@ class EnvironmentalSensor : public gz::sensors::Sensor
 
 
     std::optional<double> dataPoints[3];
-    for (std::size_t i = 0; i < this->numberOfFields; ++i)
+    if (this->useGrid)
+    {
+      // Regular grids look up all fields at once, from a session kept
+      // between steps
+      if (!this->gridSession.has_value()) return false;
+      if (!this->gridField->staticTime)
+      {
+        this->gridSession = this->gridField->grid->StepTo(
+            *this->gridSession, std::chrono::duration<double>(_now).count());
+      }
+      if (!this->gridSession.has_value()) return false;
+
+      this->gridField->grid->LookUp(*this->gridSession, this->gridFields,
+          this->position, this->gridValues);
+      for (std::size_t i = 0, j = 0; i < this->numberOfFields; ++i)
+      {
+        dataPoints[i] = this->fieldName[i] == "" ?
+            std::optional<double>(0) : this->gridValues[j++];
+      }
+    }
+    for (std::size_t i = 0; !this->useGrid && i < this->numberOfFields; ++i)
     {
       if (this->fieldName[i] == "")
       {
@@ -289,6 +311,35 @@ class EnvironmentalSensor : public gz::sensors::Sensor
     }
 
     this->gridField = data;
+
+    // The fast path is used when all fields are in the regular grid
+    this->gridFields.clear();
+    this->useGrid = nullptr != data->grid;
+    for (std::size_t i = 0; this->useGrid && i < this->numberOfFields; ++i)
+    {
+      if (this->fieldName[i] == "")
+        continue;
+      auto index = data->grid->FieldIndex(this->fieldName[i]);
+      this->useGrid = index.has_value();
+      if (index)
+        this->gridFields.push_back(*index);
+    }
+    if (this->useGrid)
+    {
+      this->gridSession = data->grid->CreateSession();
+      if (!data->staticTime)
+      {
+        this->gridSession = data->grid->StepTo(*this->gridSession,
+            std::chrono::duration<double>(_curr_time).count());
+      }
+      if (!this->gridSession.has_value())
+      {
+        gzerr << "Exceeded time stamp." << std::endl;
+      }
+      this->ready = true;
+      return;
+    }
+
     for (std::size_t i = 0; i < this->numberOfFields; ++i)
     {
       if (this->fieldName[i] == "")
@@ -356,6 +407,10 @@ class EnvironmentalSensor : public gz::sensors::Sensor
   private: std::string fieldName[3];
   private: std::string frameId;
   private: std::optional<gz::math::InMemorySession<double, double>> session[3];
+  private: bool useGrid{false};
+  private: std::optional<RegularGrid::Session> gridSession;
+  private: std::vector<std::size_t> gridFields;
+  private: std::vector<std::optional<double>> gridValues;
   private: std::shared_ptr<gz::sim::components::EnvironmentalData>
     gridField;
   private: TransformType transformType{TransformType::GLOBAL};
@@ -367,6 +422,10 @@ class gz::sim::EnvironmentalSensorSystemPrivate {
 
   public: std::unordered_set<std::string> fields;
 
+  /// \brief Data given to the sensors, replaced whenever the preload system
+  /// streams another window of time
+  public: std::shared_ptr<components::EnvironmentalData> envData;
+
   public: void RemoveSensorEntities(
     const gz::sim::EntityComponentManager &_ecm)
   {
@@ -473,15 +532,16 @@ void EnvironmentalSensorSystem::PreUpdate(const gz::sim::UpdateInfo &_info,
 void EnvironmentalSensorSystem::PostUpdate(const gz::sim::UpdateInfo &_info,
     const gz::sim::EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<components::Environment>([&](const Entity &/*_entity*/,
-    const components::Environment *_environmental_data)->bool
+  auto environment =
+      _ecm.Component<components::Environment>(worldEntity(_ecm));
+  if (nullptr != environment && environment->Data() != this->dataPtr->envData)
+  {
+    this->dataPtr->envData = environment->Data();
+    for (auto &[entity, sensor] : this->dataPtr->entitySensorMap)
     {
-      for (auto &[entity, sensor] : this->dataPtr->entitySensorMap)
-      {
-        sensor->SetDataTable(_environmental_data, _info.simTime);
-      }
-      return true;
-    });
+      sensor->SetDataTable(environment, _info.simTime);
+    }
+  }
   // Only update and publish if not paused.
   if (!_info.paused)
   {
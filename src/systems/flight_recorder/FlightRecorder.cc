@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "FlightRecorder.hh"
+
+#include <gz/msgs/serialized_map.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+#include <gz/msgs/time.pb.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/common/Util.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+#include <gz/transport/log/Log.hh>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/EntityComponentManager.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+/// \brief A recorded state.
+struct FlightRecord
+{
+  /// \brief Serialized msgs::SerializedStateMap.
+  std::string data;
+
+  /// \brief Sim time of the state.
+  std::chrono::steady_clock::duration simTime{0};
+
+  /// \brief True if it's a full state, false if it only holds changes.
+  bool keyframe{false};
+};
+
+/// \brief A request to dump the records.
+struct DumpRequest
+{
+  /// \brief Directory of the log.
+  std::string path;
+
+  /// \brief The records to write, oldest first.
+  std::vector<FlightRecord> records;
+
+  /// \brief Whether a service call waits for the dump.
+  bool waited{false};
+};
+
+/// \brief Private data class
+class gz::sim::systems::FlightRecorderPrivate
+{
+  /// \brief Ask for a dump on the next update.
+  /// \param[in] _dir Directory to dump the log in, empty for the default.
+  /// \param[in] _wait True to wait until the log is written.
+  /// \return Path of the log if waiting for it, empty on failure or when
+  /// not waiting.
+  public: std::string RequestDump(const std::string &_dir, bool _wait);
+
+  /// \brief Copy the records since the latest keyframe at least a
+  /// duration old, oldest first.
+  /// \return The records.
+  public: std::vector<FlightRecord> CopyRecords() const;
+
+  /// \brief Write dumps in the background.
+  public: void WriteLoop();
+
+  /// \brief Write a log.
+  /// \param[in] _request The dump request.
+  /// \return True on success.
+  public: bool WriteLog(const DumpRequest &_request) const;
+
+  /// \brief Service callback to dump a log.
+  /// \param[in] _req Directory to dump the log in, empty for the default.
+  /// \param[out] _res Path of the log.
+  /// \return True if the log was written.
+  public: bool OnDump(const msgs::StringMsg &_req, msgs::StringMsg &_res);
+
+  /// \brief Name of the world.
+  public: std::string worldName;
+
+  /// \brief Sim time to keep.
+  public: std::chrono::steady_clock::duration duration{
+      std::chrono::seconds(60)};
+
+  /// \brief Sim time between full states.
+  public: std::chrono::steady_clock::duration keyframePeriod{
+      std::chrono::seconds(10)};
+
+  /// \brief Sim time between records.
+  public: std::chrono::steady_clock::duration recordPeriod{0};
+
+  /// \brief Number of slots requested with <max_records>, zero to derive
+  /// it from the step size.
+  public: std::size_t maxRecords{0u};
+
+  /// \brief Default directory to dump logs in.
+  public: std::string outputPath;
+
+  /// \brief Ring buffer of records, allocated on the first update.
+  public: std::vector<FlightRecord> ring;
+
+  /// \brief Slot of the next record.
+  public: std::size_t head{0u};
+
+  /// \brief Number of slots in use.
+  public: std::size_t count{0u};
+
+  /// \brief Records since the latest keyframe.
+  public: std::size_t recordsSinceKeyframe{0u};
+
+  /// \brief Sim time of the latest record.
+  public: std::optional<std::chrono::steady_clock::duration> lastRecordTime;
+
+  /// \brief Sim time of the latest keyframe.
+  public: std::optional<std::chrono::steady_clock::duration> lastKeyframeTime;
+
+  /// \brief Reused to serialize the state of each step.
+  public: msgs::SerializedStateMap stateMsg;
+
+  /// \brief True when a dump was requested. This is the only member the
+  /// simulation thread reads on every update that another thread writes.
+  public: std::atomic<bool> dumpRequested{false};
+
+  /// \brief Directory of the requested dump, empty for the default.
+  public: std::string requestedPath;
+
+  /// \brief Whether a service call waits for the requested dump.
+  public: bool requestWaited{false};
+
+  /// \brief Dumps waiting to be written.
+  public: std::deque<DumpRequest> dumps;
+
+  /// \brief Path of the latest log written for a service call, empty if it
+  /// failed.
+  public: std::string dumpResult;
+
+  /// \brief Number of logs written or failed for service calls.
+  public: std::size_t dumpsDone{0u};
+
+  /// \brief True to stop the writer thread.
+  public: bool stop{false};
+
+  /// \brief Protects the members shared with the writer thread and the
+  /// transport callbacks.
+  public: std::mutex mutex;
+
+  /// \brief Signals new dumps, finished dumps and stop requests.
+  public: std::condition_variable cv;
+
+  /// \brief Writes the dumps.
+  public: std::thread writeThread;
+
+  /// \brief Transport node.
+  public: transport::Node node;
+};
+
+//////////////////////////////////////////////////
+FlightRecorder::FlightRecorder()
+  : System(), dataPtr(std::make_unique<FlightRecorderPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+FlightRecorder::~FlightRecorder()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->cv.notify_all();
+  if (this->dataPtr->writeThread.joinable())
+    this->dataPtr->writeThread.join();
+}
+
+//////////////////////////////////////////////////
+void FlightRecorder::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm, EventManager &/*_eventMgr*/)
+{
+  auto nameComp = _ecm.Component<components::Name>(_entity);
+  if (nullptr == nameComp)
+  {
+    gzerr << "The FlightRecorder system must be attached to a world."
+          << std::endl;
+    return;
+  }
+  this->dataPtr->worldName = nameComp->Data();
+
+  auto seconds = [&_sdf](const std::string &_tag, double _default)
+  {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(
+        std::max(0.0, _sdf->Get<double>(_tag, _default).first)));
+  };
+  this->dataPtr->duration = seconds("duration", 60.0);
+  this->dataPtr->keyframePeriod = seconds("keyframe_period", 10.0);
+  this->dataPtr->recordPeriod = seconds("record_period", 0.0);
+  this->dataPtr->maxRecords = static_cast<std::size_t>(
+      std::max(0, _sdf->Get<int>("max_records", 0).first));
+
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  this->dataPtr->outputPath = _sdf->Get<std::string>("output_path",
+      common::joinPaths(home, ".gz", "sim", "flight_recorder")).first;
+
+  std::string service = transport::TopicUtils::AsValidTopic(
+      "/world/" + this->dataPtr->worldName + "/flight_recorder/dump");
+  if (service.empty() || !this->dataPtr->node.Advertise(service,
+      &FlightRecorderPrivate::OnDump, this->dataPtr.get()))
+  {
+    gzerr << "Failed to advertise flight recorder service [" << service
+          << "]." << std::endl;
+  }
+
+  if (_sdf->HasElement("trigger_topic"))
+  {
+    auto topic = transport::TopicUtils::AsValidTopic(
+        _sdf->Get<std::string>("trigger_topic"));
+    std::function<void(const transport::ProtoMsg &)> cb =
+        [this](const transport::ProtoMsg &)
+        {
+          this->dataPtr->RequestDump("", false);
+        };
+    if (topic.empty() || !this->dataPtr->node.Subscribe(topic, cb))
+    {
+      gzerr << "Failed to subscribe to flight recorder trigger topic ["
+            << _sdf->Get<std::string>("trigger_topic") << "]." << std::endl;
+    }
+  }
+
+  this->dataPtr->writeThread =
+      std::thread(&FlightRecorderPrivate::WriteLoop, this->dataPtr.get());
+}
+
+//////////////////////////////////////////////////
+void FlightRecorder::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("FlightRecorder::PostUpdate");
+
+  // Spawns, removals and one-time changes are only reported in the step
+  // they happen, so those steps are recorded even if they're paused or
+  // within the record period
+  const bool mustRecord = _ecm.HasNewEntities() ||
+      _ecm.HasEntitiesMarkedForRemoval() || _ecm.HasRemovedComponents() ||
+      _ecm.HasOneTimeComponentChanges();
+  if (!this->dataPtr->worldName.empty() && (mustRecord || (!_info.paused &&
+      (!this->dataPtr->lastRecordTime || _info.simTime -
+      *this->dataPtr->lastRecordTime >= this->dataPtr->recordPeriod))))
+  {
+    // Allocate enough slots for the duration plus a keyframe period at the
+    // first step size, since a dump starts from a keyframe
+    if (this->dataPtr->ring.empty())
+    {
+      auto period = std::max(_info.dt, this->dataPtr->recordPeriod);
+      if (period <= std::chrono::steady_clock::duration::zero())
+        period = std::chrono::milliseconds(1);
+      auto capacity = this->dataPtr->maxRecords;
+      if (capacity == 0u)
+      {
+        capacity = static_cast<std::size_t>(std::ceil(
+            std::chrono::duration<double>(this->dataPtr->duration +
+            this->dataPtr->keyframePeriod) /
+            std::chrono::duration<double>(period))) + 2u;
+      }
+      this->dataPtr->ring.resize(std::max<std::size_t>(2u, capacity));
+      gzmsg << "Flight recorder keeps the latest ["
+            << this->dataPtr->ring.size() << "] states." << std::endl;
+    }
+
+    // Keyframes are also forced before the ring wraps around the latest
+    // one, so there's always one to start a dump from
+    const bool keyframe = !this->dataPtr->lastKeyframeTime ||
+        _info.simTime - *this->dataPtr->lastKeyframeTime >=
+        this->dataPtr->keyframePeriod ||
+        this->dataPtr->recordsSinceKeyframe + 1u >=
+        this->dataPtr->ring.size();
+
+    this->dataPtr->stateMsg.Clear();
+    if (keyframe)
+      _ecm.State(this->dataPtr->stateMsg, {}, {}, true);
+    else
+      _ecm.ChangedState(this->dataPtr->stateMsg);
+
+    if (keyframe || !this->dataPtr->stateMsg.entities().empty())
+    {
+      // The slot's string keeps its capacity, so this doesn't allocate once
+      // the ring has been filled
+      auto &slot = this->dataPtr->ring[this->dataPtr->head];
+      this->dataPtr->stateMsg.SerializeToString(&slot.data);
+      slot.simTime = _info.simTime;
+      slot.keyframe = keyframe;
+
+      this->dataPtr->head =
+          (this->dataPtr->head + 1u) % this->dataPtr->ring.size();
+      this->dataPtr->count = std::min(this->dataPtr->count + 1u,
+          this->dataPtr->ring.size());
+      this->dataPtr->lastRecordTime = _info.simTime;
+      if (keyframe)
+      {
+        this->dataPtr->lastKeyframeTime = _info.simTime;
+        this->dataPtr->recordsSinceKeyframe = 0u;
+      }
+      else
+      {
+        ++this->dataPtr->recordsSinceKeyframe;
+      }
+    }
+  }
+
+  if (!this->dataPtr->dumpRequested.exchange(false))
+    return;
+
+  GZ_PROFILE("FlightRecorder::Dump");
+  DumpRequest request;
+  request.records = this->dataPtr->CopyRecords();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    request.path = this->dataPtr->requestedPath;
+    request.waited = this->dataPtr->requestWaited;
+    this->dataPtr->requestWaited = false;
+    this->dataPtr->dumps.push_back(std::move(request));
+  }
+  this->dataPtr->cv.notify_all();
+}
+
+//////////////////////////////////////////////////
+std::vector<FlightRecord> FlightRecorderPrivate::CopyRecords() const
+{
+  std::vector<FlightRecord> records;
+  if (this->count == 0u)
+    return records;
+
+  const std::size_t oldest =
+      (this->head + this->ring.size() - this->count) % this->ring.size();
+  const std::size_t newest =
+      (this->head + this->ring.size() - 1u) % this->ring.size();
+  const auto &latestTime = this->ring[newest].simTime;
+
+  // Start from the latest keyframe that is at least a duration old, or the
+  // oldest one if the ring doesn't go back that far
+  std::optional<std::size_t> start;
+  for (std::size_t i = 0u; i < this->count; ++i)
+  {
+    const auto &record = this->ring[(oldest + i) % this->ring.size()];
+    if (!record.keyframe)
+      continue;
+    if (!start || latestTime - record.simTime >= this->duration)
+      start = i;
+    else
+      break;
+  }
+  if (!start)
+    return records;
+
+  records.reserve(this->count - *start);
+  for (std::size_t i = *start; i < this->count; ++i)
+    records.push_back(this->ring[(oldest + i) % this->ring.size()]);
+  return records;
+}
+
+//////////////////////////////////////////////////
+std::string FlightRecorderPrivate::RequestDump(const std::string &_dir,
+    bool _wait)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->requestedPath = _dir;
+  this->requestWaited = this->requestWaited || _wait;
+  this->dumpRequested = true;
+  if (!_wait)
+    return std::string();
+
+  // The records are copied on the next update, so give up if the
+  // simulation isn't running
+  const auto done = this->dumpsDone;
+  if (!this->cv.wait_for(lock, std::chrono::seconds(10),
+      [&]() { return this->dumpsDone != done || this->stop; }) ||
+      this->dumpsDone == done)
+  {
+    gzerr << "Timed out waiting for the flight recorder dump." << std::endl;
+    return std::string();
+  }
+  return this->dumpResult;
+}
+
+//////////////////////////////////////////////////
+bool FlightRecorderPrivate::OnDump(const msgs::StringMsg &_req,
+    msgs::StringMsg &_res)
+{
+  _res.set_data(this->RequestDump(_req.data(), true));
+  return !_res.data().empty();
+}
+
+//////////////////////////////////////////////////
+void FlightRecorderPrivate::WriteLoop()
+{
+  while (true)
+  {
+    DumpRequest request;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->cv.wait(lock, [this]()
+          {
+            return this->stop || !this->dumps.empty();
+          });
+      if (this->dumps.empty())
+        return;
+      request = std::move(this->dumps.front());
+      this->dumps.pop_front();
+    }
+
+    // Each dump gets its own directory, named after the time it was made
+    auto dir = request.path.empty() ? this->outputPath : request.path;
+    dir = common::uniqueDirectoryPath(
+        common::joinPaths(dir, common::systemTimeISO()));
+    request.path = dir;
+    const bool result = this->WriteLog(request);
+
+    if (request.waited)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->dumpResult = result ? dir : std::string();
+        ++this->dumpsDone;
+      }
+      this->cv.notify_all();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool FlightRecorderPrivate::WriteLog(const DumpRequest &_request) const
+{
+  GZ_PROFILE("FlightRecorderPrivate::WriteLog");
+  if (_request.records.empty())
+  {
+    gzerr << "The flight recorder has nothing to dump yet." << std::endl;
+    return false;
+  }
+  if (!common::createDirectories(_request.path))
+  {
+    gzerr << "Failed to create flight recorder directory ["
+          << _request.path << "]." << std::endl;
+    return false;
+  }
+
+  const auto dbPath = common::joinPaths(_request.path, "state.tlog");
+  transport::log::Log log;
+  if (!log.Open(dbPath, std::ios_base::out))
+  {
+    gzerr << "Failed to open flight recorder log [" << dbPath << "]."
+          << std::endl;
+    return false;
+  }
+
+  // The same topics as LogRecord, so LogPlayback can play and seek the log
+  const std::string prefix = "/world/" + this->worldName;
+  const std::string stateTopic = prefix + "/changed_state";
+  const std::string keyframeTopic = prefix + "/keyframe_state";
+  const std::string indexTopic = prefix + "/keyframe_index";
+  const std::string stateType = msgs::SerializedStateMap().GetTypeName();
+  const std::string timeType = msgs::Time().GetTypeName();
+
+  // Playback starts at zero, so times are made relative to the first record
+  const auto offset = _request.records.front().simTime;
+  bool result{true};
+  for (const auto &record : _request.records)
+  {
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        record.simTime - offset);
+    result = log.InsertMessage(time, stateTopic, stateType,
+        record.data.data(), record.data.size()) && result;
+    if (!record.keyframe)
+      continue;
+
+    const auto index = convert<msgs::Time>(record.simTime - offset)
+        .SerializeAsString();
+    result = log.InsertMessage(time, keyframeTopic, stateType,
+        record.data.data(), record.data.size()) && result;
+    result = log.InsertMessage(time, indexTopic, timeType, index.data(),
+        index.size()) && result;
+  }
+
+  std::ofstream info(common::joinPaths(_request.path,
+      "flight_recorder.txt"));
+  info << "world " << this->worldName << "\n"
+       << "sim_time_offset " << std::fixed << std::setprecision(9)
+       << std::chrono::duration<double>(offset).count() << "\n"
+       << "records " << _request.records.size() << "\n";
+
+  if (!result)
+  {
+    gzerr << "Failed to write flight recorder log [" << dbPath << "]."
+          << std::endl;
+    return false;
+  }
+  gzmsg << "Flight recorder wrote [" << _request.records.size()
+        << "] states starting at sim time ["
+        << std::chrono::duration<double>(offset).count() << "] s to ["
+        << dbPath << "]." << std::endl;
+  return true;
+}
+
+GZ_ADD_PLUGIN(FlightRecorder,
+              System,
+              FlightRecorder::ISystemConfigure,
+              FlightRecorder::ISystemPostUpdate)
+
+GZ_ADD_PLUGIN_ALIAS(FlightRecorder,
+                    "gz::sim::systems::FlightRecorder")
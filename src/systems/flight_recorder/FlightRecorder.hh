@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_FLIGHTRECORDER_HH_
+#define GZ_SIM_SYSTEMS_FLIGHTRECORDER_HH_
+
+#include <memory>
+
+#include <gz/sim/config.hh>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class FlightRecorderPrivate;
+
+  /// \brief Keeps the most recent changes to the world in memory, and
+  /// writes them to a log that LogPlayback can play when asked to, for
+  /// example when a run fails. This is much cheaper than LogRecord, since
+  /// nothing is written to disk until then.
+  ///
+  /// The changed state of every step is kept in a ring buffer with a fixed
+  /// number of slots, together with a full state every keyframe period, so
+  /// the oldest records can always be played back from a full state. The
+  /// slots are allocated once, and keep their memory when they're reused.
+  /// The simulation thread never waits for a dump. It copies the records
+  /// on the update after the request, and a background thread writes them.
+  ///
+  /// Dumps are directories holding a `state.tlog` file. Sim times in the
+  /// log start at zero, and the sim time of the first record is written to
+  /// `flight_recorder.txt` next to it.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<duration>`: Seconds of sim time to keep. Defaults to 60.
+  ///
+  /// - `<keyframe_period>`: Seconds of sim time between full states.
+  ///   Dumps hold up to this much more than the duration. Defaults to 10.
+  ///
+  /// - `<record_period>`: Seconds of sim time between records. Defaults to
+  ///   0, to record every step. Steps that create or remove entities or
+  ///   components, or that have one-time changes, are always recorded, even
+  ///   while paused, since later records don't include these changes.
+  ///
+  /// - `<max_records>`: Number of slots of the ring buffer. Defaults to
+  ///   the number needed to keep the duration at the first step size.
+  ///
+  /// - `<output_path>`: Directory to dump logs in, each in a subdirectory
+  ///   named after the time of the dump. Defaults to
+  ///   `$HOME/.gz/sim/flight_recorder`.
+  ///
+  /// - `<trigger_topic>`: Optional topic of any type which dumps a log
+  ///   whenever a message is published on it.
+  ///
+  /// ## Services
+  ///
+  /// - `/world/<world_name>/flight_recorder/dump`: Dump a log. The request
+  ///   is a msgs::StringMsg with the directory to write it in, or empty to
+  ///   use the default one, and the response a msgs::StringMsg with the
+  ///   path of the log.
+  ///
+  /// ## Example Usage
+  ///
+  /** \verbatim
+    <plugin filename="gz-sim-flight-recorder-system"
+            name="gz::sim::systems::FlightRecorder">
+      <duration>60</duration>
+      <trigger_topic>/failure</trigger_topic>
+    </plugin>
+  \endverbatim */
+  class FlightRecorder:
+    public System,
+    public ISystemConfigure,
+    public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: FlightRecorder();
+
+    /// \brief Destructor
+    public: ~FlightRecorder() override;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
+    // Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) final;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<FlightRecorderPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
@@ -17,6 +17,10 @@
 
 #include "ForceTorque.hh"
 
+#include <gz/msgs/wrench.pb.h>
+
+#include <chrono>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -30,6 +34,8 @@
 
 #include <gz/transport/Node.hh>
 
+#include <gz/msgs/Utility.hh>
+
 #include <gz/sensors/SensorFactory.hh>
 #include <gz/sensors/ForceTorqueSensor.hh>
 
@@ -44,9 +50,13 @@
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+#include "../../SensorBatches.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -73,6 +83,12 @@ class gz::sim::systems::ForceTorquePrivate
   /// \brief Cache of the entities associated with the sensor
   public: std::unordered_map<Entity, SensorJointAndLinks> sensorJointLinkMap;
 
+  /// \brief Force-torque sensors that need data at the current step.
+  public: DueSensors<sensors::ForceTorqueSensor> dueSensors;
+
+  /// \brief Batched publication of the readings.
+  public: SensorBatches batches{"force_torque"};
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -98,9 +114,13 @@ class gz::sim::systems::ForceTorquePrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update FT sensor data based on physics data
+  /// \brief Update FT sensor data based on physics data. This may be
+  /// called concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the force-torque sensor
+  /// \param[in] _sensor Force-torque sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::ForceTorqueSensor &_sensor);
 
   /// \brief Create sensor
   /// \param[in] _ecm Immutable reference to ECM.
@@ -113,6 +133,15 @@ class gz::sim::systems::ForceTorquePrivate
     const components::ForceTorque *_forceTorque,
     const components::ParentEntity *_parent);
 
+  /// \brief Add the readings of a sensor to its batch. This may be
+  /// called concurrently for different sensors.
+  /// \param[in] _entity Entity of the sensor
+  /// \param[in] _sensor Sensor that was just updated.
+  /// \param[in] _simTime Current simulation time.
+  public: void AddToBatch(const Entity _entity,
+    sensors::ForceTorqueSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime);
+
   /// \brief Remove FT sensors if their entities have been removed from
   /// simulation.
   /// \param[in] _ecm Immutable reference to ECM.
@@ -128,6 +157,15 @@ ForceTorque::ForceTorque()
 //////////////////////////////////////////////////
 ForceTorque::~ForceTorque() = default;
 
+//////////////////////////////////////////////////
+void ForceTorque::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->batches.Load(_sdf);
+}
+
 //////////////////////////////////////////////////
 void ForceTorque::PreUpdate(const UpdateInfo &/*_info*/,
     EntityComponentManager &_ecm)
@@ -175,29 +213,32 @@ void ForceTorque::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the ForceTorquePrivate::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
+    std::function<bool(Entity)> batchConnections;
+    std::function<void(Entity, sensors::ForceTorqueSensor &)> updated;
+    if (this->dataPtr->batches.Enabled())
     {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
+      batchConnections = [&](const Entity _entity)
+      {
+        return this->dataPtr->batches.HasConnections(_entity);
+      };
+      updated = [&](const Entity _entity, sensors::ForceTorqueSensor &_sensor)
       {
-        needsUpdate = true;
-        break;
-      }
+        this->dataPtr->AddToBatch(_entity, _sensor, _info.simTime);
+      };
     }
-    if (!needsUpdate)
-      return;
 
-    this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // we only update sensors that need data and have subscribers.
+    // note: gz-sensors does its own throttling. Here the check is mainly
+    // to avoid doing work in the ForceTorquePrivate::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime, batchConnections))
     {
-      it.second->Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::ForceTorqueSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          }, updated);
+      this->dataPtr->batches.Publish(_info.simTime);
     }
   }
 
@@ -252,76 +293,57 @@ void ForceTorquePrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void ForceTorquePrivate::Update(const EntityComponentManager &_ecm)
+void ForceTorquePrivate::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::ForceTorqueSensor &_sensor)
 {
-  GZ_PROFILE("ForceTorquePrivate::Update");
-  _ecm.Each<components::ForceTorque>(
-      [&](const Entity &_entity, const components::ForceTorque *) -> bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          auto jointLinkIt = this->sensorJointLinkMap.find(_entity);
-          if (jointLinkIt == this->sensorJointLinkMap.end())
-          {
-            gzerr << "Failed to update Force/Torque Sensor: " << _entity
-                   << ". Associated entities not found." << std::endl;
-            return true;
-          }
-
-          // Appropriate components haven't been populated by physics yet
-          auto jointWrench = _ecm.Component<components::JointTransmittedWrench>(
-              jointLinkIt->second.joint);
-          if (nullptr == jointWrench)
-          {
-            return true;
-          }
-
-          // Notation:
-          // X_WJ: Pose of joint in world
-          // X_WP: Pose of parent link in world
-          // X_WC: Pose of child link in world
-          // X_WS: Pose of sensor in world
-          // X_SP: Pose of parent link in sensors frame
-          // X_SC: Pose of child link in sensors frame
-          const auto X_WP =
-              worldPose(jointLinkIt->second.jointParentLink, _ecm);
-          const auto X_WC = worldPose(jointLinkIt->second.jointChildLink, _ecm);
-          // There appears to be a bug worldPose for computing poses of //joint
-          // and its children, so we do it manually here.
-          const auto X_CJ =
-              _ecm.Component<components::Pose>(jointLinkIt->second.joint)
-                  ->Data();
-          auto X_WJ = X_WC * X_CJ;
-
-          auto X_JS = _ecm.Component<components::Pose>(_entity)->Data();
-          auto X_WS = X_WJ * X_JS;
-          auto X_SP = X_WS.Inverse() * X_WP;
-
-          // The joint wrench is computed at the joint frame. We need to
-          // transform it the sensor frame.
-          math::Vector3d force =
-              X_JS.Rot().Inverse() * msgs::Convert(jointWrench->Data().force());
-
-          math::Vector3d torque =
-              X_JS.Rot().Inverse() *
-                  msgs::Convert(jointWrench->Data().torque()) -
-              X_JS.Pos().Cross(force);
-
-          it->second->SetForce(force);
-          it->second->SetTorque(torque);
-          it->second->SetRotationParentInSensor(X_SP.Rot());
-        }
-        else
-        {
-          gzerr << "Failed to update Force/Torque Sensor: " << _entity << ". "
-                 << "Entity not found." << std::endl;
-        }
+  auto jointLinkIt = this->sensorJointLinkMap.find(_entity);
+  if (jointLinkIt == this->sensorJointLinkMap.end())
+  {
+    gzerr << "Failed to update Force/Torque Sensor: " << _entity
+           << ". Associated entities not found." << std::endl;
+    return;
+  }
 
-        return true;
-      });
-}
+  // Appropriate components haven't been populated by physics yet
+  auto jointWrench = _ecm.Component<components::JointTransmittedWrench>(
+      jointLinkIt->second.joint);
+  if (nullptr == jointWrench)
+  {
+    return;
+  }
 
+  // Notation:
+  // X_WJ: Pose of joint in world
+  // X_WP: Pose of parent link in world
+  // X_WC: Pose of child link in world
+  // X_WS: Pose of sensor in world
+  // X_SP: Pose of parent link in sensors frame
+  // X_SC: Pose of child link in sensors frame
+  const auto X_WP = worldPose(jointLinkIt->second.jointParentLink, _ecm);
+  const auto X_WC = worldPose(jointLinkIt->second.jointChildLink, _ecm);
+  // There appears to be a bug worldPose for computing poses of //joint
+  // and its children, so we do it manually here.
+  const auto X_CJ =
+      _ecm.Component<components::Pose>(jointLinkIt->second.joint)->Data();
+  auto X_WJ = X_WC * X_CJ;
+
+  auto X_JS = _ecm.Component<components::Pose>(_entity)->Data();
+  auto X_WS = X_WJ * X_JS;
+  auto X_SP = X_WS.Inverse() * X_WP;
+
+  // The joint wrench is computed at the joint frame. We need to
+  // transform it the sensor frame.
+  math::Vector3d force =
+      X_JS.Rot().Inverse() * msgs::Convert(jointWrench->Data().force());
+
+  math::Vector3d torque =
+      X_JS.Rot().Inverse() * msgs::Convert(jointWrench->Data().torque()) -
+      X_JS.Pos().Cross(force);
+
+  _sensor.SetForce(force);
+  _sensor.SetTorque(torque);
+  _sensor.SetRotationParentInSensor(X_SP.Rot());
+}
 
 //////////////////////////////////////////////////
 void ForceTorquePrivate::AddSensor(
@@ -409,11 +431,24 @@ void ForceTorquePrivate::AddSensor(
   const auto X_SC = X_WS.Inverse() * X_WC;
   sensor->SetRotationChildInSensor(X_SC.Rot());
 
+  this->batches.AddSensor(_ecm, _entity, sensor->Name(), data.UpdateRate());
   this->entitySensorMap.insert(
       std::make_pair(_entity, std::move(sensor)));
   this->newSensors.insert(_entity);
 }
 
+//////////////////////////////////////////////////
+void ForceTorquePrivate::AddToBatch(const Entity _entity,
+    sensors::ForceTorqueSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  msgs::Wrench msg;
+  *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(_simTime);
+  msgs::Set(msg.mutable_force(), _sensor.Force());
+  msgs::Set(msg.mutable_torque(), _sensor.Torque());
+  this->batches.SetMessage(_entity, msg);
+}
+
 //////////////////////////////////////////////////
 void ForceTorquePrivate::RemoveForceTorqueEntities(
     const EntityComponentManager &_ecm)
@@ -432,12 +467,14 @@ void ForceTorquePrivate::RemoveForceTorqueEntities(
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->batches.RemoveSensor(_entity);
 
         return true;
       });
 }
 
 GZ_ADD_PLUGIN(ForceTorque, System,
+  ForceTorque::ISystemConfigure,
   ForceTorque::ISystemPreUpdate,
   ForceTorque::ISystemPostUpdate
 )
@@ -39,8 +39,17 @@ namespace systems
   /// of application of the force is at the sensor's origin.
   /// //sensor/force_torque/frame only changes the coordinate frame in which the
   /// quantites are expressed, not the point of application.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<batch_publish>`: Optional. `world` or `model` to also publish the
+  ///   readings of all force-torque sensors of the world, or of each top level
+  ///   model, as one msgs::Dataframe per update rate and step on `<world or
+  ///   model scoped name>/force_torque_batch/<rate>hz`. The force-torque
+  ///   sensors keep publishing on their own topics.
   class ForceTorque:
     public System,
+    public ISystemConfigure,
     public ISystemPreUpdate,
     public ISystemPostUpdate
   {
@@ -50,6 +59,12 @@ namespace systems
     /// \brief Destructor
     public: ~ForceTorque() override;
 
+    /// Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
     /// Documentation inherited
     public: void PreUpdate(const UpdateInfo &_info,
                            EntityComponentManager &_ecm) final;
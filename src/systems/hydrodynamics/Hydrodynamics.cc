@@ -14,33 +14,87 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <Eigen/Eigen>
 
 #include <gz/msgs/vector3d.pb.h>
 #include <gz/msgs/Utility.hh>
 
+#include <gz/common/Profiler.hh>
 #include <gz/plugin/Register.hh>
 
 #include "gz/sim/components/AngularVelocity.hh"
 #include "gz/sim/components/Environment.hh"
 #include "gz/sim/components/LinearVelocity.hh"
 #include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/Waves.hh"
 #include "gz/sim/components/World.hh"
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/System.hh"
 #include "gz/sim/Util.hh"
+#include "gz/sim/WaveField.hh"
 
 #include "gz/transport/Node.hh"
 
+#include "../../ThreadPool.hh"
 #include "Hydrodynamics.hh"
+#include "HydrodynamicsBatch.hh"
 
 using namespace gz;
 using namespace sim;
 using namespace systems;
 
+/// \brief Links simulated by the hydrodynamics systems of a world, so that
+/// a world-level instance can evaluate all of them together.
+struct HydrodynamicsRegistry
+{
+  /// \brief A registered link.
+  struct Entry
+  {
+    /// \brief Data of the link's system.
+    HydrodynamicsPrivateData *data;
+
+    /// \brief Unique identifier of the registration.
+    uint64_t id;
+  };
+
+  /// \brief Protects links and version.
+  std::mutex mutex;
+
+  /// \brief Registered links.
+  std::vector<Entry> links;
+
+  /// \brief Incremented whenever links changes.
+  uint64_t version{0u};
+
+  /// \brief True while a world-level instance evaluates the links.
+  std::atomic<bool> batched{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the waves of the world, if it has any.
+/// \param[in] _ecm The Entity Component Manager
+/// \return The waves, or nullptr.
+const WaveField *worldWaves(const EntityComponentManager &_ecm)
+{
+  auto waves = _ecm.Component<components::Waves>(worldEntity(_ecm));
+  if (nullptr == waves || nullptr == waves->Data() ||
+      waves->Data()->Waves().empty())
+  {
+    return nullptr;
+  }
+  return waves->Data().get();
+}
+
 /// \brief Private Hydrodynamics data class.
 class gz::sim::systems::HydrodynamicsPrivateData
 {
@@ -107,40 +161,42 @@ class gz::sim::systems::HydrodynamicsPrivateData
     const EntityComponentManager &_ecm,
     const std::chrono::steady_clock::duration &_currTime)
   {
-    _ecm.EachNew<components::Environment>([&](const Entity &/*_entity*/,
-      const components::Environment *_environment) -> bool
-    {
-      this->gridField = _environment->Data();
+    // The data is replaced whenever the preload system streams another
+    // window of time
+    auto environment =
+        _ecm.Component<components::Environment>(worldEntity(_ecm));
+    if (nullptr == environment || environment->Data() == this->gridField)
+      return;
+    this->gridField = environment->Data();
 
-      for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t i = 0; i < 3; i++)
+    {
+      this->session[i].reset();
+      if (!this->axisComponents[i].empty())
       {
-        if (!this->axisComponents[i].empty())
+        if (!this->gridField->frame.Has(this->axisComponents[i]))
         {
-          if (!this->gridField->frame.Has(this->axisComponents[i]))
-          {
-            gzwarn << "Environmental sensor could not find field "
-              << this->axisComponents[i] << "\n";
-            continue;
-          }
+          gzwarn << "Environmental sensor could not find field "
+            << this->axisComponents[i] << "\n";
+          continue;
+        }
 
+        this->session[i] =
+          this->gridField->frame[this->axisComponents[i]].CreateSession();
+        if (!this->gridField->staticTime)
+        {
           this->session[i] =
-            this->gridField->frame[this->axisComponents[i]].CreateSession();
-          if (!this->gridField->staticTime)
-          {
-            this->session[i] =
-              this->gridField->frame[this->axisComponents[i]].StepTo(
-                *this->session[i],
-                std::chrono::duration<double>(_currTime).count());
-          }
-
-          if(!this->session[i].has_value())
-          {
-            gzerr << "Exceeded time stamp." << std::endl;
-          }
+            this->gridField->frame[this->axisComponents[i]].StepTo(
+              *this->session[i],
+              std::chrono::duration<double>(_currTime).count());
+        }
+
+        if(!this->session[i].has_value())
+        {
+          gzerr << "Exceeded time stamp." << std::endl;
         }
       }
-      return true;
-    });
+    }
   }
 
   /////////////////////////////////////////////////
@@ -209,10 +265,260 @@ class gz::sim::systems::HydrodynamicsPrivateData
 
     return current;
   }
+
+  /////////////////////////////////////////////////
+  /// \brief Get the current experienced by the link, from the environment
+  /// or from the topic.
+  /// \param[in] _ecm - The Entity Component Manager
+  /// \param[in] _currTime - The current time
+  /// \return The current vector to be applied to the link.
+  public: math::Vector3d Current(
+    const EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_currTime)
+  {
+    if (this->useCurrentTable)
+    {
+      auto position = Link(this->linkEntity).WorldInertialPose(_ecm);
+      if (!position.has_value())
+        return math::Vector3d::Zero;
+      return this->GetWaterCurrentFromEnvironment(
+        _ecm, _currTime, position.value().Pos());
+    }
+    std::lock_guard lock(this->mtx);
+    return this->currentVector;
+  }
+
+  /// \brief Get the coefficients of the link, for a batch.
+  /// \return The coefficients.
+  public: hydrodynamics::Coefficients BatchCoefficients() const;
+
+  /// \brief Evaluate the registered links together, as the world-level
+  /// instance.
+  /// \param[in] _info - Simulation update info
+  /// \param[in] _ecm - The Entity Component Manager
+  public: void EvaluateBatch(const UpdateInfo &_info,
+    EntityComponentManager &_ecm);
+
+  /// \brief Destructor. Unregisters the link, or stops batching.
+  public: ~HydrodynamicsPrivateData();
+
   /// \brief Mutex
   public: std::mutex mtx;
+
+  /// \brief Registry of the links of the world.
+  public: std::shared_ptr<HydrodynamicsRegistry> registry;
+
+  /// \brief True if the system is attached to the world rather than to a
+  /// model.
+  public: bool worldLevel{false};
+
+  /// \brief True if this world-level instance evaluates the links.
+  public: bool batching{false};
+
+  /// \brief Wrenches of the links, evaluated together.
+  public: hydrodynamics::HydrodynamicsBatch batch;
+
+  /// \brief Registered links, in the order of the batch.
+  public: std::vector<HydrodynamicsRegistry::Entry> batchLinks;
+
+  /// \brief Version of the registry that batchLinks mirrors.
+  public: uint64_t batchVersion{0u};
+
+  /// \brief World rotation of each link at this step.
+  public: std::vector<math::Quaterniond> batchRotations;
+
+  /// \brief World position of each link at this step.
+  public: std::vector<math::Vector3d> batchPositions;
+
+  /// \brief World linear velocity of each link relative to the water at
+  /// this step.
+  public: std::vector<math::Vector3d> batchVelocities;
+
+  /// \brief World angular velocity of each link at this step.
+  public: std::vector<math::Vector3d> batchAngularVelocities;
+
+  /// \brief Orbital velocity of the waves at each link at this step.
+  public: std::vector<math::Vector3d> batchWaveVelocities;
+
+  /// \brief Whether each link has a state at this step.
+  public: std::vector<char> batchValid;
+
+  /// \brief Number of threads to split the links between, or 0 to
+  /// evaluate them on the simulation thread.
+  public: unsigned int threads{0u};
 };
 
+/////////////////////////////////////////////////
+HydrodynamicsPrivateData::~HydrodynamicsPrivateData()
+{
+  if (!this->registry)
+    return;
+  if (this->batching)
+    this->registry->batched = false;
+
+  std::lock_guard lock(this->registry->mutex);
+  auto &links = this->registry->links;
+  auto it = std::remove_if(links.begin(), links.end(),
+      [this](const HydrodynamicsRegistry::Entry &_entry)
+      {
+        return _entry.data == this;
+      });
+  if (it != links.end())
+  {
+    links.erase(it, links.end());
+    ++this->registry->version;
+  }
+}
+
+/////////////////////////////////////////////////
+hydrodynamics::Coefficients
+HydrodynamicsPrivateData::BatchCoefficients() const
+{
+  hydrodynamics::Coefficients coefficients;
+  for (int i = 0; i < 36; ++i)
+  {
+    coefficients.addedMass[i] = this->Ma(i / 6, i % 6);
+    coefficients.linear[i] = this->stabilityLinearTerms[i];
+  }
+  std::copy(std::begin(this->stabilityQuadraticDerivative),
+      std::end(this->stabilityQuadraticDerivative),
+      coefficients.quadratic.begin());
+  std::copy(std::begin(this->stabilityQuadraticAbsDerivative),
+      std::end(this->stabilityQuadraticAbsDerivative),
+      coefficients.quadraticAbs.begin());
+  coefficients.disableAddedMass = this->disableAddedMass;
+  coefficients.disableCoriolis = this->disableCoriolis;
+  return coefficients;
+}
+
+/////////////////////////////////////////////////
+void HydrodynamicsPrivateData::EvaluateBatch(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("Hydrodynamics::EvaluateBatch");
+
+  // Mirror the registered links, keeping the state of those which stay
+  {
+    std::lock_guard lock(this->registry->mutex);
+    if (this->batchVersion != this->registry->version)
+    {
+      this->batchVersion = this->registry->version;
+      const auto &links = this->registry->links;
+      auto registered = [](const auto &_entries, uint64_t _id)
+      {
+        return std::any_of(_entries.begin(), _entries.end(),
+            [_id](const HydrodynamicsRegistry::Entry &_entry)
+            {
+              return _entry.id == _id;
+            });
+      };
+      for (std::size_t i = this->batchLinks.size(); i-- > 0u;)
+      {
+        if (!registered(links, this->batchLinks[i].id))
+        {
+          this->batch.Remove(i);
+          this->batchLinks[i] = this->batchLinks.back();
+          this->batchLinks.pop_back();
+        }
+      }
+      for (const auto &entry : links)
+      {
+        if (!registered(this->batchLinks, entry.id))
+        {
+          this->batch.Add(entry.data->BatchCoefficients());
+          this->batchLinks.push_back(entry);
+        }
+      }
+    }
+  }
+
+  if (_info.paused)
+    return;
+
+  // Gather the state of each link in its local frame, relative to the
+  // current
+  const std::size_t count = this->batchLinks.size();
+  this->batchRotations.resize(count);
+  this->batchPositions.assign(count, math::Vector3d::Zero);
+  this->batchVelocities.resize(count);
+  this->batchAngularVelocities.resize(count);
+  this->batchValid.assign(count, 0);
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    auto *link = this->batchLinks[i].data;
+    if (link->useCurrentTable)
+      link->SetWaterCurrentTable(_ecm, _info.simTime);
+
+    Link baseLink(link->linkEntity);
+    auto linearVelocity =
+      _ecm.Component<components::WorldLinearVelocity>(link->linkEntity);
+    auto rotationalVelocity = baseLink.WorldAngularVelocity(_ecm);
+    auto pose = baseLink.WorldPose(_ecm);
+    if (!linearVelocity || !rotationalVelocity || !pose)
+      continue;
+
+    this->batchVelocities[i] =
+      linearVelocity->Data() - link->Current(_ecm, _info.simTime);
+    this->batchAngularVelocities[i] = *rotationalVelocity;
+    this->batchPositions[i] = pose->Pos();
+    this->batchRotations[i] = pose->Rot();
+    this->batchValid[i] = 1;
+  }
+
+  // The water also moves with the waves, queried for all links at once
+  if (auto waves = worldWaves(_ecm))
+  {
+    waves->Velocities(std::chrono::duration<double>(_info.simTime).count(),
+        this->batchPositions, this->batchWaveVelocities);
+    for (std::size_t i = 0u; i < count; ++i)
+      this->batchVelocities[i] -= this->batchWaveVelocities[i];
+  }
+
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    if (!this->batchValid[i])
+      continue;
+    const auto rotation = this->batchRotations[i].Inverse();
+    const auto localLinearVelocity = rotation * this->batchVelocities[i];
+    const auto localRotationalVelocity =
+      rotation * this->batchAngularVelocities[i];
+    this->batch.SetState(i, {
+        localLinearVelocity.X(), localLinearVelocity.Y(),
+        localLinearVelocity.Z(), localRotationalVelocity.X(),
+        localRotationalVelocity.Y(), localRotationalVelocity.Z()});
+  }
+
+  // Split the links between the threads, in ranges large enough to be worth
+  // the hand-off
+  const double dt = std::chrono::duration<double>(_info.dt).count();
+  constexpr std::size_t kMinLinksPerRange{64u};
+  if (0u == this->threads)
+  {
+    this->batch.Evaluate(dt);
+  }
+  else
+  {
+    auto &pool = ThreadPool::Shared();
+    pool.ParallelFor(count, pool.GrainSize(count, kMinLinksPerRange),
+        [this, dt](std::size_t _begin, std::size_t _end)
+        {
+          this->batch.Evaluate(dt, _begin, _end);
+        });
+  }
+
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    if (!this->batchValid[i])
+      continue;
+    const auto wrench = this->batch.Wrench(i);
+    const auto &rotation = this->batchRotations[i];
+    Link(this->batchLinks[i].data->linkEntity).AddWorldWrench(_ecm,
+        _ecm.Wrenches(),
+        rotation * math::Vector3d(wrench[0], wrench[1], wrench[2]),
+        rotation * math::Vector3d(wrench[3], wrench[4], wrench[5]));
+  }
+}
+
 /////////////////////////////////////////////////
 void HydrodynamicsPrivateData::UpdateCurrent(const msgs::Vector3d &_msg)
 {
@@ -293,6 +599,33 @@ void Hydrodynamics::Configure(
   gz::sim::EventManager &/*_eventMgr*/
 )
 {
+  this->dataPtr->registry =
+      _ecm.SystemSharedData<HydrodynamicsRegistry>("Hydrodynamics");
+
+  // Attached to the world, the system evaluates the links of all the
+  // model-level instances together
+  if (nullptr != _ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->worldLevel = true;
+    if (this->dataPtr->registry->batched.exchange(true))
+    {
+      gzwarn << "Hydrodynamics is already attached to the world, ignoring "
+             << "this instance." << std::endl;
+      return;
+    }
+    this->dataPtr->batching = true;
+
+    this->dataPtr->threads =
+      _sdf->Get<unsigned int>("threads", 0u).first;
+    if (this->dataPtr->threads > 0u)
+    {
+      this->dataPtr->threads = ThreadPool::Shared().ThreadCount() + 1u;
+    }
+    gzdbg << "Evaluating hydrodynamics of all links together, on ["
+          << this->dataPtr->threads << "] threads." << std::endl;
+    return;
+  }
+
   this->dataPtr->waterDensity = SdfParamDouble(_sdf, "water_density", 998);
   // Load stability derivatives
   // Use SNAME 1950 convention to load the coeffecients.
@@ -419,6 +752,10 @@ void Hydrodynamics::Configure(
   AddWorldPose(this->dataPtr->linkEntity, _ecm);
   AddAngularVelocityComponent(this->dataPtr->linkEntity, _ecm);
   AddWorldLinearVelocity(this->dataPtr->linkEntity, _ecm);
+
+  std::lock_guard lock(this->dataPtr->registry->mutex);
+  this->dataPtr->registry->links.push_back(
+    {this->dataPtr.get(), ++this->dataPtr->registry->version});
 }
 
 /////////////////////////////////////////////////
@@ -426,12 +763,20 @@ void Hydrodynamics::PreUpdate(
       const gz::sim::UpdateInfo &_info,
       gz::sim::EntityComponentManager &_ecm)
 {
+  if (this->dataPtr->worldLevel)
+  {
+    if (this->dataPtr->batching)
+      this->dataPtr->EvaluateBatch(_info, _ecm);
+    return;
+  }
+
   if (this->dataPtr->useCurrentTable)
   {
     this->dataPtr->SetWaterCurrentTable(_ecm, _info.simTime);
   }
 
-  if (_info.paused)
+  // The world-level instance applies the wrench
+  if (_info.paused || this->dataPtr->registry->batched)
     return;
 
   // These variables follow Fossen's scheme in "Guidance and Control
@@ -459,24 +804,17 @@ void Hydrodynamics::PreUpdate(
   }
 
   // Get current vector
-  math::Vector3d currentVector(0, 0, 0);
+  math::Vector3d currentVector =
+    this->dataPtr->Current(_ecm, _info.simTime);
+  // Transform state to local frame
+  auto pose = baseLink.WorldPose(_ecm);
 
-  if (this->dataPtr->useCurrentTable)
+  // The water also moves with the waves
+  if (auto waves = worldWaves(_ecm))
   {
-    auto position = baseLink.WorldInertialPose(_ecm);
-    if (position.has_value())
-    {
-      currentVector = this->dataPtr->GetWaterCurrentFromEnvironment(
-        _ecm, _info.simTime, position.value().Pos());
-    }
-  }
-  else
-  {
-    std::lock_guard lock(this->dataPtr->mtx);
-    currentVector = this->dataPtr->currentVector;
+    currentVector += waves->Velocity(
+      std::chrono::duration<double>(_info.simTime).count(), pose->Pos());
   }
-  // Transform state to local frame
-  auto pose = baseLink.WorldPose(_ecm);
   // Since we are transforming angular and linear velocity we only care about
   // rotation. Also this is where we apply the effects of current to the link
   auto localLinearVelocity = pose->Rot().Inverse() *
@@ -567,6 +905,7 @@ void Hydrodynamics::PreUpdate(
 
   baseLink.AddWorldWrench(
     _ecm,
+    _ecm.Wrenches(),
     pose->Rot()*(totalForce),
     pose->Rot()*totalTorque);
 }
@@ -576,7 +915,7 @@ void Hydrodynamics::PostUpdate(
       const gz::sim::UpdateInfo &_info,
       const gz::sim::EntityComponentManager &_ecm)
 {
-  if (this->dataPtr->useCurrentTable)
+  if (!this->dataPtr->worldLevel && this->dataPtr->useCurrentTable)
   {
     this->dataPtr->SetWaterCurrentTable(_ecm, _info.simTime);
   }
@@ -112,6 +112,22 @@ namespace systems
   /// by a data file and the topic will be ignored. If one or two fields are
   /// present, the missing fields are assumed to default to zero.
   ///
+  /// If the Waves system adds waves to the world, the orbital velocity of
+  /// the water under them is added to the current.
+  ///
+  /// ### Evaluating many vehicles together
+  /// The system can also be attached to the world, without any of the
+  /// parameters above. The instances attached to models then only read
+  /// their parameters and currents, and the world-level instance computes
+  /// the forces of all their links together at each step, with the
+  /// coefficients of all vehicles stored side by side, so that worlds with
+  /// many vehicles are cheaper to simulate. The forces are the same.
+  ///   * <threads> - Any number above 0 splits the vehicles between the
+  ///     threads of the process-wide pool, whose size is set by the
+  ///     GZ_SIM_THREADS environment variable, and 0 computes them on the
+  ///     simulation thread. Only worth it with hundreds of vehicles.
+  ///     [unsigned int, Default: 0]
+  ///
   /// # Example
   /// An example configuration is provided in the examples folder. The example
   /// uses the LiftDrag plugin to apply steering controls. It also uses the
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_HYDRODYNAMICS_HYDRODYNAMICS_BATCH_HH_
+#define GZ_SIM_SYSTEMS_HYDRODYNAMICS_HYDRODYNAMICS_BATCH_HH_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::hydrodynamics
+{
+  /// \brief Hydrodynamic coefficients of a vehicle, in the SNAME convention,
+  /// as loaded by the Hydrodynamics system. Matrices are row major.
+  struct Coefficients
+  {
+    /// \brief Added mass, such as X_{\dot u}.
+    std::array<double, 36> addedMass{};
+
+    /// \brief Linear damping, such as X_u.
+    std::array<double, 36> linear{};
+
+    /// \brief Quadratic damping, such as X_{uv}, indexed by force, velocity
+    /// and velocity.
+    std::array<double, 216> quadratic{};
+
+    /// \brief Quadratic damping, such as X_{u|u|}, indexed by force,
+    /// velocity and absolute velocity.
+    std::array<double, 216> quadraticAbs{};
+
+    /// \brief Whether to leave out the added mass.
+    bool disableAddedMass{false};
+
+    /// \brief Whether to leave out the Coriolis and centripetal forces.
+    bool disableCoriolis{false};
+  };
+
+  /// \brief Hydrodynamic wrenches of many vehicles, computed together.
+  ///
+  /// The states and wrenches are stored with one array per degree of
+  /// freedom, and each coefficient which isn't zero for every vehicle is
+  /// stored as an array over the vehicles. A wrench is then a sum of a few
+  /// loops over contiguous arrays, which the compiler can vectorize, instead
+  /// of the dense 6x6 matrices of each vehicle, most of whose terms are
+  /// usually zero. Ranges of vehicles can be evaluated from different
+  /// threads.
+  class HydrodynamicsBatch
+  {
+    /// \brief Get the number of vehicles.
+    /// \return Number of vehicles.
+    public: std::size_t Size() const
+    {
+      return this->count;
+    }
+
+    /// \brief Get the number of terms evaluated for each vehicle.
+    /// \return Number of coefficients which aren't zero for all vehicles.
+    public: std::size_t TermCount() const
+    {
+      return this->terms.size();
+    }
+
+    /// \brief Add a vehicle, at rest.
+    /// \param[in] _coefficients Coefficients of the vehicle.
+    /// \return Index of the vehicle.
+    public: std::size_t Add(const Coefficients &_coefficients)
+    {
+      const std::size_t index = this->count++;
+      for (auto *arrays : {&this->state, &this->prevState, &this->stateDot,
+                           &this->wrench})
+      {
+        for (auto &values : *arrays)
+          values.push_back(0.0);
+      }
+      for (auto &term : this->terms)
+        term.coefficients.push_back(0.0);
+
+      for (int i = 0; i < 6; ++i)
+      {
+        for (int j = 0; j < 6; ++j)
+        {
+          if (!_coefficients.disableAddedMass)
+          {
+            this->AddTerm(Kind::ADDED_MASS, i, j, 0,
+                _coefficients.addedMass[i * 6 + j]);
+          }
+          this->AddTerm(Kind::LINEAR, i, j, 0,
+              _coefficients.linear[i * 6 + j]);
+          for (int k = 0; k < 6; ++k)
+          {
+            this->AddTerm(Kind::QUADRATIC, i, j, k,
+                _coefficients.quadratic[i * 36 + j * 6 + k]);
+            this->AddTerm(Kind::QUADRATIC_ABS, i, j, k,
+                _coefficients.quadraticAbs[i * 36 + j * 6 + k]);
+          }
+        }
+      }
+
+      // Coriolis and centripetal forces for under water vehicles (Fossen P.
+      // 37), with only the diagonal terms of the added mass. Each entry of
+      // the matrix is a multiple of a velocity, so its product with the
+      // state is a quadratic term.
+      if (!_coefficients.disableCoriolis)
+      {
+        const auto &ma = _coefficients.addedMass;
+        for (const auto &entry : kCoriolis)
+        {
+          this->AddTerm(Kind::QUADRATIC, entry[0], entry[1], entry[3],
+              entry[4] * ma[entry[2] * 7]);
+        }
+      }
+      return index;
+    }
+
+    /// \brief Remove a vehicle. The last vehicle takes its index.
+    /// \param[in] _index Index of the vehicle.
+    public: void Remove(std::size_t _index)
+    {
+      if (_index >= this->count)
+        return;
+      auto removeFrom = [&](std::vector<double> &_values)
+      {
+        _values[_index] = _values.back();
+        _values.pop_back();
+      };
+      for (auto *arrays : {&this->state, &this->prevState, &this->stateDot,
+                           &this->wrench})
+      {
+        for (auto &values : *arrays)
+          removeFrom(values);
+      }
+      for (auto &term : this->terms)
+        removeFrom(term.coefficients);
+      --this->count;
+    }
+
+    /// \brief Set the velocity of a vehicle.
+    /// \param[in] _index Index of the vehicle.
+    /// \param[in] _state Linear and angular velocity relative to the fluid,
+    /// in the frame of the vehicle.
+    public: void SetState(std::size_t _index,
+                const std::array<double, 6> &_state)
+    {
+      for (std::size_t i = 0u; i < 6u; ++i)
+        this->state[i][_index] = _state[i];
+    }
+
+    /// \brief Compute the wrenches of a range of vehicles. Ranges which
+    /// don't overlap can be evaluated at the same time.
+    /// \param[in] _dt Time since the last evaluation.
+    /// \param[in] _begin Index of the first vehicle.
+    /// \param[in] _end One past the index of the last vehicle.
+    public: void Evaluate(double _dt, std::size_t _begin, std::size_t _end)
+    {
+      _end = std::min(_end, this->count);
+      if (_begin >= _end || _dt <= 0.0)
+        return;
+
+      const double inverseDt = 1.0 / _dt;
+      for (std::size_t i = 0u; i < 6u; ++i)
+      {
+        double *s = this->state[i].data();
+        double *prev = this->prevState[i].data();
+        double *sDot = this->stateDot[i].data();
+        double *w = this->wrench[i].data();
+        for (std::size_t v = _begin; v < _end; ++v)
+        {
+          sDot[v] = (s[v] - prev[v]) * inverseDt;
+          prev[v] = s[v];
+          w[v] = 0.0;
+        }
+      }
+
+      for (const auto &term : this->terms)
+      {
+        const double *c = term.coefficients.data();
+        const double *sj = this->state[term.j].data();
+        const double *sk = this->state[term.k].data();
+        double *w = this->wrench[term.i].data();
+        switch (term.kind)
+        {
+          case Kind::ADDED_MASS:
+          {
+            const double *sDot = this->stateDot[term.j].data();
+            for (std::size_t v = _begin; v < _end; ++v)
+              w[v] += c[v] * sDot[v];
+            break;
+          }
+          case Kind::LINEAR:
+            for (std::size_t v = _begin; v < _end; ++v)
+              w[v] += c[v] * sj[v];
+            break;
+          case Kind::QUADRATIC:
+            for (std::size_t v = _begin; v < _end; ++v)
+              w[v] += c[v] * sj[v] * sk[v];
+            break;
+          case Kind::QUADRATIC_ABS:
+            for (std::size_t v = _begin; v < _end; ++v)
+              w[v] += c[v] * sj[v] * std::abs(sk[v]);
+            break;
+        }
+      }
+    }
+
+    /// \brief Compute the wrenches of all vehicles.
+    /// \param[in] _dt Time since the last evaluation.
+    public: void Evaluate(double _dt)
+    {
+      this->Evaluate(_dt, 0u, this->count);
+    }
+
+    /// \brief Get the wrench to apply to a vehicle.
+    /// \param[in] _index Index of the vehicle.
+    /// \return Force and torque, in the frame of the vehicle.
+    public: std::array<double, 6> Wrench(std::size_t _index) const
+    {
+      std::array<double, 6> result;
+      for (std::size_t i = 0u; i < 6u; ++i)
+        result[i] = this->wrench[i][_index];
+      return result;
+    }
+
+    /// \brief Kinds of terms.
+    private: enum class Kind
+    {
+      /// \brief Coefficient times an acceleration.
+      ADDED_MASS,
+
+      /// \brief Coefficient times a velocity.
+      LINEAR,
+
+      /// \brief Coefficient times the product of two velocities.
+      QUADRATIC,
+
+      /// \brief Coefficient times a velocity and an absolute velocity.
+      QUADRATIC_ABS
+    };
+
+    /// \brief A coefficient of all the vehicles.
+    private: struct Term
+    {
+      /// \brief Kind of term.
+      Kind kind;
+
+      /// \brief Degree of freedom of the wrench.
+      int i;
+
+      /// \brief Degree of freedom of the first velocity.
+      int j;
+
+      /// \brief Degree of freedom of the second velocity, if any.
+      int k;
+
+      /// \brief Coefficient of each vehicle.
+      std::vector<double> coefficients;
+    };
+
+    /// \brief Add a coefficient of the last vehicle to a term, creating the
+    /// term if it's new.
+    /// \param[in] _kind Kind of term.
+    /// \param[in] _i Degree of freedom of the wrench.
+    /// \param[in] _j Degree of freedom of the first velocity.
+    /// \param[in] _k Degree of freedom of the second velocity.
+    /// \param[in] _value Coefficient, which is skipped if it's zero.
+    private: void AddTerm(Kind _kind, int _i, int _j, int _k, double _value)
+    {
+      if (_value == 0.0)
+        return;
+      const std::array<int, 4> key{static_cast<int>(_kind), _i, _j, _k};
+      auto it = this->termIndices.find(key);
+      if (it == this->termIndices.end())
+      {
+        it = this->termIndices.emplace(key, this->terms.size()).first;
+        this->terms.push_back(
+            Term{_kind, _i, _j, _k, std::vector<double>(this->count, 0.0)});
+      }
+      this->terms[it->second].coefficients.back() += _value;
+    }
+
+    /// \brief Entries of the Coriolis matrix applied to the state: the row,
+    /// the column, the diagonal term of the added mass, the velocity it's
+    /// multiplied by and its sign.
+    private: static constexpr int kCoriolis[18][5] = {
+      {0, 4, 2, 2, -1}, {0, 5, 1, 1, -1}, {1, 3, 2, 2, 1}, {1, 5, 0, 0, -1},
+      {2, 3, 1, 1, -1}, {2, 4, 0, 0, 1}, {3, 1, 2, 2, -1}, {3, 2, 1, 1, 1},
+      {3, 4, 5, 5, -1}, {3, 5, 4, 4, 1}, {4, 0, 2, 2, 1}, {4, 2, 0, 0, -1},
+      {4, 3, 5, 5, 1}, {4, 5, 3, 3, -1}, {5, 0, 2, 2, 1}, {5, 1, 0, 0, 1},
+      {5, 3, 4, 4, -1}, {5, 4, 3, 3, 1}};
+
+    /// \brief Number of vehicles.
+    private: std::size_t count{0u};
+
+    /// \brief Velocities of each vehicle, per degree of freedom.
+    private: std::array<std::vector<double>, 6> state;
+
+    /// \brief Velocities at the last evaluation.
+    private: std::array<std::vector<double>, 6> prevState;
+
+    /// \brief Accelerations at the last evaluation.
+    private: std::array<std::vector<double>, 6> stateDot;
+
+    /// \brief Wrenches to apply, per degree of freedom.
+    private: std::array<std::vector<double>, 6> wrench;
+
+    /// \brief Terms which aren't zero for all vehicles.
+    private: std::vector<Term> terms;
+
+    /// \brief Index of each term, by kind and degrees of freedom.
+    private: std::map<std::array<int, 4>, std::size_t> termIndices;
+  };
+}
+}
+}
+
+#endif
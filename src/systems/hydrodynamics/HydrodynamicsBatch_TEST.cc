@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "HydrodynamicsBatch.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::hydrodynamics;
+
+/////////////////////////////////////////////////
+/// \brief Wrench of a single vehicle, computed with dense matrices as the
+/// Hydrodynamics system does for each link.
+/// \param[in] _c Coefficients of the vehicle.
+/// \param[in] _state Velocity of the vehicle.
+/// \param[in] _prevState Velocity at the previous step.
+/// \param[in] _dt Time step.
+/// \return Force and torque to apply.
+std::array<double, 6> reference(const Coefficients &_c,
+    const std::array<double, 6> &_state,
+    const std::array<double, 6> &_prevState, double _dt)
+{
+  const auto &ma = _c.addedMass;
+  const auto &s = _state;
+  double cmat[6][6] = {};
+  cmat[0][4] = -ma[14] * s[2];
+  cmat[0][5] = -ma[7] * s[1];
+  cmat[1][3] = ma[14] * s[2];
+  cmat[1][5] = -ma[0] * s[0];
+  cmat[2][3] = -ma[7] * s[1];
+  cmat[2][4] = ma[0] * s[0];
+  cmat[3][1] = -ma[14] * s[2];
+  cmat[3][2] = ma[7] * s[1];
+  cmat[3][4] = -ma[35] * s[5];
+  cmat[3][5] = ma[28] * s[4];
+  cmat[4][0] = ma[14] * s[2];
+  cmat[4][2] = -ma[0] * s[0];
+  cmat[4][3] = ma[35] * s[5];
+  cmat[4][5] = -ma[21] * s[3];
+  cmat[5][0] = ma[14] * s[2];
+  cmat[5][1] = ma[0] * s[0];
+  cmat[5][3] = -ma[28] * s[4];
+  cmat[5][4] = ma[21] * s[3];
+
+  std::array<double, 6> total{};
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+    {
+      double d = -_c.linear[i * 6 + j];
+      for (int k = 0; k < 6; ++k)
+      {
+        d -= _c.quadraticAbs[i * 36 + j * 6 + k] * std::abs(s[k]);
+        d -= _c.quadratic[i * 36 + j * 6 + k] * s[k];
+      }
+      total[i] += d * s[j];
+      if (!_c.disableAddedMass)
+        total[i] -= ma[i * 6 + j] * (s[j] - _prevState[j]) / _dt;
+      if (!_c.disableCoriolis)
+        total[i] -= cmat[i][j] * s[j];
+    }
+  }
+  for (auto &value : total)
+    value = -value;
+  return total;
+}
+
+/////////////////////////////////////////////////
+/// \brief Make coefficients with the diagonal terms, and a few cross terms.
+/// \param[in] _generator Random number generator.
+/// \return The coefficients.
+Coefficients randomCoefficients(std::mt19937 &_generator)
+{
+  std::uniform_real_distribution<double> distribution(-50.0, 0.0);
+  Coefficients c;
+  for (int i = 0; i < 6; ++i)
+  {
+    c.addedMass[i * 7] = distribution(_generator);
+    c.linear[i * 7] = distribution(_generator);
+    c.quadraticAbs[i * 43] = distribution(_generator);
+  }
+  c.addedMass[5] = distribution(_generator);
+  c.linear[6 * 2 + 4] = distribution(_generator);
+  c.quadratic[36 * 1 + 6 * 2 + 3] = distribution(_generator);
+  c.quadraticAbs[36 * 5 + 6 * 0 + 1] = distribution(_generator);
+  return c;
+}
+
+/////////////////////////////////////////////////
+TEST(HydrodynamicsBatch, Reference)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> velocity(-2.0, 2.0);
+
+  std::vector<Coefficients> coefficients;
+  for (int v = 0; v < 7; ++v)
+    coefficients.push_back(randomCoefficients(generator));
+  coefficients[2].disableAddedMass = true;
+  coefficients[4].disableCoriolis = true;
+  coefficients[5] = Coefficients();
+
+  HydrodynamicsBatch batch;
+  for (const auto &c : coefficients)
+    batch.Add(c);
+  ASSERT_EQ(coefficients.size(), batch.Size());
+  EXPECT_LT(batch.TermCount(), 36u * 2u + 216u * 2u);
+
+  const double dt = 0.01;
+  std::vector<std::array<double, 6>> prevStates(coefficients.size());
+  for (int step = 0; step < 3; ++step)
+  {
+    std::vector<std::array<double, 6>> states(coefficients.size());
+    for (std::size_t v = 0; v < states.size(); ++v)
+    {
+      for (auto &value : states[v])
+        value = velocity(generator);
+      batch.SetState(v, states[v]);
+    }
+
+    // Evaluate in two ranges, as from two threads
+    batch.Evaluate(dt, 0u, 3u);
+    batch.Evaluate(dt, 3u, states.size());
+
+    for (std::size_t v = 0; v < states.size(); ++v)
+    {
+      const auto expected =
+          reference(coefficients[v], states[v], prevStates[v], dt);
+      const auto wrench = batch.Wrench(v);
+      for (std::size_t i = 0; i < 6u; ++i)
+      {
+        EXPECT_NEAR(expected[i], wrench[i], 1e-9 * (1 + std::abs(expected[i])))
+            << "step " << step << ", vehicle " << v << ", axis " << i;
+      }
+    }
+    prevStates = states;
+  }
+
+  // The vehicle without coefficients feels nothing
+  for (double value : batch.Wrench(5))
+    EXPECT_DOUBLE_EQ(0.0, value);
+}
+
+/////////////////////////////////////////////////
+TEST(HydrodynamicsBatch, Remove)
+{
+  std::mt19937 generator(7);
+  const auto first = randomCoefficients(generator);
+  const auto second = randomCoefficients(generator);
+  const auto third = randomCoefficients(generator);
+
+  HydrodynamicsBatch batch;
+  batch.Add(first);
+  batch.Add(second);
+  batch.Add(third);
+
+  const std::array<double, 6> state{0.5, -0.2, 0.1, 0.05, -0.3, 0.2};
+  for (std::size_t v = 0; v < 3u; ++v)
+    batch.SetState(v, state);
+  batch.Evaluate(0.1);
+
+  // The last vehicle takes the index of the removed one, with its state
+  batch.Remove(0u);
+  ASSERT_EQ(2u, batch.Size());
+  batch.Evaluate(0.1);
+
+  const auto expected = reference(third, state, state, 0.1);
+  const auto wrench = batch.Wrench(0u);
+  for (std::size_t i = 0; i < 6u; ++i)
+    EXPECT_NEAR(expected[i], wrench[i], 1e-9 * (1 + std::abs(expected[i])));
+
+  batch.Remove(5u);
+  EXPECT_EQ(2u, batch.Size());
+}
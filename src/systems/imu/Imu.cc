@@ -17,6 +17,10 @@
 
 #include "Imu.hh"
 
+#include <gz/msgs/imu.pb.h>
+
+#include <chrono>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -28,6 +32,8 @@
 
 #include <gz/common/Profiler.hh>
 
+#include <gz/msgs/Utility.hh>
+
 #include <gz/sensors/SensorFactory.hh>
 #include <gz/sensors/ImuSensor.hh>
 
@@ -41,9 +47,13 @@
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+#include "../../SensorBatches.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -55,6 +65,12 @@ class gz::sim::systems::ImuPrivate
   public: std::unordered_map<Entity,
       std::unique_ptr<sensors::ImuSensor>> entitySensorMap;
 
+  /// \brief IMU sensors that need data at the current step.
+  public: DueSensors<sensors::ImuSensor> dueSensors;
+
+  /// \brief Batched publication of the readings.
+  public: SensorBatches batches{"imu"};
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -75,9 +91,13 @@ class gz::sim::systems::ImuPrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update IMU sensor data based on physics data
+  /// \brief Update IMU sensor data based on physics data. This may be
+  /// called concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the IMU
+  /// \param[in] _sensor IMU sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::ImuSensor &_sensor);
 
   /// \brief Create sensor
   /// \param[in] _ecm Immutable reference to ECM.
@@ -90,6 +110,15 @@ class gz::sim::systems::ImuPrivate
     const components::Imu *_imu,
     const components::ParentEntity *_parent);
 
+  /// \brief Add the readings of a sensor to its batch. This may be
+  /// called concurrently for different sensors.
+  /// \param[in] _entity Entity of the sensor
+  /// \param[in] _sensor Sensor that was just updated.
+  /// \param[in] _simTime Current simulation time.
+  public: void AddToBatch(const Entity _entity,
+    sensors::ImuSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime);
+
   /// \brief Remove IMU sensors if their entities have been removed from
   /// simulation.
   /// \param[in] _ecm Immutable reference to ECM.
@@ -104,6 +133,15 @@ Imu::Imu() : System(), dataPtr(std::make_unique<ImuPrivate>())
 //////////////////////////////////////////////////
 Imu::~Imu() = default;
 
+//////////////////////////////////////////////////
+void Imu::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->batches.Load(_sdf);
+}
+
 //////////////////////////////////////////////////
 void Imu::PreUpdate(const UpdateInfo &/*_info*/,
     EntityComponentManager &_ecm)
@@ -145,30 +183,32 @@ void Imu::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the ImuPrivate::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
+    std::function<bool(Entity)> batchConnections;
+    std::function<void(Entity, sensors::ImuSensor &)> updated;
+    if (this->dataPtr->batches.Enabled())
     {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
+      batchConnections = [&](const Entity _entity)
       {
-        needsUpdate = true;
-        break;
-      }
+        return this->dataPtr->batches.HasConnections(_entity);
+      };
+      updated = [&](const Entity _entity, sensors::ImuSensor &_sensor)
+      {
+        this->dataPtr->AddToBatch(_entity, _sensor, _info.simTime);
+      };
     }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->Update(_ecm);
 
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // we only update sensors that need data and have subscribers.
+    // note: gz-sensors does its own throttling. Here the check is mainly
+    // to avoid doing work in the ImuPrivate::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime, batchConnections))
     {
-      // Update measurement time
-      it.second->Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::ImuSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          }, updated);
+      this->dataPtr->batches.Publish(_info.simTime);
     }
   }
 
@@ -254,6 +294,7 @@ void ImuPrivate::AddSensor(
         data.ImuSensor()->OrientationEnabled());
   }
 
+  this->batches.AddSensor(_ecm, _entity, sensor->Name(), data.UpdateRate());
   this->entitySensorMap.insert(
       std::make_pair(_entity, std::move(sensor)));
   this->newSensors.insert(_entity);
@@ -300,39 +341,41 @@ void ImuPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void ImuPrivate::Update(const EntityComponentManager &_ecm)
+void ImuPrivate::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::ImuSensor &_sensor)
 {
-  GZ_PROFILE("ImuPrivate::Update");
-  _ecm.Each<components::Imu,
-            components::WorldPose,
-            components::AngularVelocity,
-            components::LinearAcceleration>(
-    [&](const Entity &_entity,
-        const components::Imu * /*_imu*/,
-        const components::WorldPose *_worldPose,
-        const components::AngularVelocity *_angularVel,
-        const components::LinearAcceleration *_linearAccel)->bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          const auto &imuWorldPose = _worldPose->Data();
-          it->second->SetWorldPose(imuWorldPose);
+  auto worldPose = _ecm.Component<components::WorldPose>(_entity);
+  auto angularVel = _ecm.Component<components::AngularVelocity>(_entity);
+  auto linearAccel =
+      _ecm.Component<components::LinearAcceleration>(_entity);
+  if (nullptr == worldPose || nullptr == angularVel ||
+      nullptr == linearAccel)
+  {
+    return;
+  }
 
-          // Set the IMU angular velocity (defined in imu's local frame)
-          it->second->SetAngularVelocity(_angularVel->Data());
+  _sensor.SetWorldPose(worldPose->Data());
 
-          // Set the IMU linear acceleration in the imu local frame
-          it->second->SetLinearAcceleration(_linearAccel->Data());
-         }
-        else
-        {
-          gzerr << "Failed to update IMU: " << _entity << ". "
-                 << "Entity not found." << std::endl;
-        }
+  // Set the IMU angular velocity (defined in imu's local frame)
+  _sensor.SetAngularVelocity(angularVel->Data());
 
-        return true;
-      });
+  // Set the IMU linear acceleration in the imu local frame
+  _sensor.SetLinearAcceleration(linearAccel->Data());
+}
+
+//////////////////////////////////////////////////
+void ImuPrivate::AddToBatch(const Entity _entity,
+    sensors::ImuSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  msgs::IMU msg;
+  *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(_simTime);
+  msg.set_entity_name(_sensor.Name());
+  if (_sensor.OrientationEnabled())
+    msgs::Set(msg.mutable_orientation(), _sensor.Orientation());
+  msgs::Set(msg.mutable_angular_velocity(), _sensor.AngularVelocity());
+  msgs::Set(msg.mutable_linear_acceleration(), _sensor.LinearAcceleration());
+  this->batches.SetMessage(_entity, msg);
 }
 
 //////////////////////////////////////////////////
@@ -353,12 +396,14 @@ void ImuPrivate::RemoveImuEntities(
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->batches.RemoveSensor(_entity);
 
         return true;
       });
 }
 
 GZ_ADD_PLUGIN(Imu, System,
+  Imu::ISystemConfigure,
   Imu::ISystemPreUpdate,
   Imu::ISystemPostUpdate
 )
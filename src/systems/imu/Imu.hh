@@ -36,8 +36,16 @@ namespace systems
   /// \brief This system manages all IMU sensors in simulation.
   /// Each IMU sensor eports vertical position, angular velocity
   /// and lienar acceleration readings over Gazebo Transport.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<batch_publish>`: Optional. `world` or `model` to also publish the
+  ///   readings of all IMUs of the world, or of each top level model, as one
+  ///   msgs::Dataframe per update rate and step on `<world or model scoped
+  ///   name>/imu_batch/<rate>hz`. The IMUs keep publishing on their own topics.
   class Imu:
     public System,
+    public ISystemConfigure,
     public ISystemPreUpdate,
     public ISystemPostUpdate
   {
@@ -47,6 +55,12 @@ namespace systems
     /// \brief Destructor
     public: ~Imu() override;
 
+    /// Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
     /// Documentation inherited
     public: void PreUpdate(const UpdateInfo &_info,
                            EntityComponentManager &_ecm) final;
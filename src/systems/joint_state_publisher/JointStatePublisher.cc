@@ -17,11 +17,18 @@
 
 #include "JointStatePublisher.hh"
 
+#include <gz/msgs/double_v.pb.h>
+#include <gz/msgs/empty.pb.h>
 #include <gz/msgs/model.pb.h>
+#include <gz/msgs/stringmsg_v.pb.h>
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+#include <gz/common/Profiler.hh>
 #include <gz/plugin/Register.hh>
 
 #include "gz/sim/components/ChildLinkName.hh"
@@ -31,26 +38,358 @@
 #include "gz/sim/components/JointForce.hh"
 #include "gz/sim/components/JointPosition.hh"
 #include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/Model.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/ParentLinkName.hh"
 #include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/ComponentHandle.hh"
 #include "gz/sim/Util.hh"
+#include "gz/sim/World.hh"
 
 using namespace gz;
 using namespace sim;
 using namespace systems;
 
+/// \brief Create the position, velocity and force components of a joint if
+/// they don't exist.
+/// \param[in] _ecm The EntityComponentManager.
+/// \param[in] _joint The joint entity.
+static void createJointComponents(EntityComponentManager &_ecm,
+    Entity _joint)
+{
+  // Create joint position component if one doesn't exist
+  if (!_ecm.EntityHasComponentType(_joint,
+        components::JointPosition().TypeId()))
+  {
+    _ecm.CreateComponent(_joint, components::JointPosition());
+  }
+
+  // Create joint velocity component if one doesn't exist
+  if (!_ecm.EntityHasComponentType(_joint,
+        components::JointVelocity().TypeId()))
+  {
+    _ecm.CreateComponent(_joint, components::JointVelocity());
+  }
+
+  // Create joint force component if one doesn't exist
+  if (!_ecm.EntityHasComponentType(_joint, components::JointForce().TypeId()))
+  {
+    _ecm.CreateComponent(_joint, components::JointForce());
+  }
+}
+
+/// \brief Publication of the joints of all models of a world.
+class gz::sim::systems::JointStatePublisher::Fleet
+{
+  /// \brief A published joint.
+  public: struct TrackedJoint
+  {
+    /// \brief Number of axes, which have an entry each in the packed
+    /// message.
+    std::size_t axes{0u};
+
+    /// \brief Position component.
+    ComponentHandle<components::JointPosition> position;
+
+    /// \brief Velocity component.
+    ComponentHandle<components::JointVelocity> velocity;
+
+    /// \brief Force component.
+    ComponentHandle<components::JointForce> force;
+  };
+
+  /// \brief A model whose joints are published.
+  public: struct TrackedModel
+  {
+    /// \brief Its joints.
+    std::vector<TrackedJoint> joints;
+
+    /// \brief Pose component of the model.
+    ComponentHandle<components::Pose> pose;
+
+    /// \brief Publisher of the model message, if publishing per model.
+    std::unique_ptr<transport::Node::Publisher> pub;
+
+    /// \brief Model message, reused between steps.
+    msgs::Model msg;
+  };
+
+  /// \brief Start tracking a model if it's selected.
+  /// \param[in] _ecm The EntityComponentManager.
+  /// \param[in] _model The model entity.
+  public: void AddModel(EntityComponentManager &_ecm, Entity _model);
+
+  /// \brief Resize the packed message and update the joint names after
+  /// models were added or removed.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void UpdateLayout(const EntityComponentManager &_ecm);
+
+  /// \brief Publish the joint states.
+  /// \param[in] _info Update information.
+  public: void Publish(const UpdateInfo &_info);
+
+  /// \brief Service callback for the names of the packed joints.
+  /// \param[out] _rep Joint name of each axis.
+  /// \return True.
+  public: bool OnNames(msgs::StringMsg_V &_rep);
+
+  /// \brief Names of the selected models. All models if empty.
+  public: std::unordered_set<std::string> modelNames;
+
+  /// \brief Whether to also publish each model on its own topic.
+  public: bool perModelTopics{false};
+
+  /// \brief Topic of the packed joint states.
+  public: std::string topic;
+
+  /// \brief True once the models existing before the first update were
+  /// added.
+  public: bool initialized{false};
+
+  /// \brief Models created since the last PreUpdate.
+  public: std::vector<Entity> newModels;
+
+  /// \brief True if models were added or removed since the last layout.
+  public: bool layoutChanged{true};
+
+  /// \brief Tracked models, ordered by entity so that the layout doesn't
+  /// depend on hashing.
+  public: std::map<Entity, TrackedModel> models;
+
+  /// \brief The communication node.
+  public: transport::Node node;
+
+  /// \brief Publisher of the packed joint states.
+  public: transport::Node::Publisher pub;
+
+  /// \brief Publisher of the joint names.
+  public: transport::Node::Publisher namesPub;
+
+  /// \brief Packed joint states, reused between steps.
+  public: msgs::Double_V packed;
+
+  /// \brief Joint name of each axis.
+  public: msgs::StringMsg_V names;
+
+  /// \brief Protects names, which the service reads.
+  public: std::mutex namesMutex;
+};
+
+//////////////////////////////////////////////////
+void JointStatePublisher::Fleet::AddModel(EntityComponentManager &_ecm,
+    Entity _model)
+{
+  Model model(_model);
+  if (!this->modelNames.empty() &&
+      this->modelNames.find(model.Name(_ecm)) == this->modelNames.end())
+  {
+    return;
+  }
+
+  std::vector<Entity> joints = _ecm.ChildrenByComponents(
+      _model, components::Joint());
+  if (joints.empty())
+    return;
+
+  TrackedModel &tracked = this->models[_model];
+  tracked.joints.clear();
+  tracked.msg.Clear();
+  tracked.msg.set_name(model.Name(_ecm));
+  tracked.msg.set_id(_model);
+  tracked.pose = _ecm.Handle<components::Pose>(_model);
+
+  for (const Entity &joint : joints)
+  {
+    createJointComponents(_ecm, joint);
+
+    TrackedJoint trackedJoint;
+    trackedJoint.position = _ecm.Handle<components::JointPosition>(joint);
+    trackedJoint.velocity = _ecm.Handle<components::JointVelocity>(joint);
+    trackedJoint.force = _ecm.Handle<components::JointForce>(joint);
+
+    // The parts of the message which don't change
+    msgs::Joint *jointMsg = tracked.msg.add_joint();
+    jointMsg->set_name(_ecm.Component<components::Name>(joint)->Data());
+    jointMsg->set_id(joint);
+    auto pose = _ecm.Component<components::Pose>(joint);
+    if (pose)
+      msgs::Set(jointMsg->mutable_pose(), pose->Data());
+    auto child = _ecm.Component<components::ChildLinkName>(joint);
+    if (child)
+      jointMsg->set_child(child->Data());
+    auto parent = _ecm.Component<components::ParentLinkName>(joint);
+    if (parent)
+      jointMsg->set_parent(parent->Data());
+
+    auto jointAxis = _ecm.Component<components::JointAxis>(joint);
+    if (jointAxis)
+    {
+      ++trackedJoint.axes;
+      msgs::Set(jointMsg->mutable_axis1()->mutable_xyz(),
+          jointAxis->Data().Xyz());
+      jointMsg->mutable_axis1()->set_limit_upper(jointAxis->Data().Upper());
+      jointMsg->mutable_axis1()->set_limit_lower(jointAxis->Data().Lower());
+      jointMsg->mutable_axis1()->set_damping(jointAxis->Data().Damping());
+      if (_ecm.Component<components::JointAxis2>(joint))
+        ++trackedJoint.axes;
+    }
+    tracked.joints.push_back(trackedJoint);
+  }
+
+  if (this->perModelTopics && !tracked.pub)
+  {
+    auto modelTopic = validTopic({
+        topicFromScopedName(_model, _ecm, false) + "/joint_state"});
+    if (!modelTopic.empty())
+    {
+      tracked.pub = std::make_unique<transport::Node::Publisher>(
+          this->node.Advertise<msgs::Model>(modelTopic));
+    }
+  }
+  this->layoutChanged = true;
+}
+
+//////////////////////////////////////////////////
+void JointStatePublisher::Fleet::UpdateLayout(
+    const EntityComponentManager &_ecm)
+{
+  std::lock_guard<std::mutex> lock(this->namesMutex);
+  this->names.clear_data();
+  for (const auto &[entity, tracked] : this->models)
+  {
+    for (const auto &joint : tracked.joints)
+    {
+      const auto name = scopedName(joint.position.Entity(), _ecm, "::",
+          false);
+      for (std::size_t axis = 0u; axis < joint.axes; ++axis)
+        this->names.add_data(name);
+    }
+  }
+
+  // Position, velocity and force of each axis
+  this->packed.mutable_data()->Resize(this->names.data_size() * 3, 0.0);
+  this->namesPub.Publish(this->names);
+  this->layoutChanged = false;
+}
+
+//////////////////////////////////////////////////
+bool JointStatePublisher::Fleet::OnNames(msgs::StringMsg_V &_rep)
+{
+  std::lock_guard<std::mutex> lock(this->namesMutex);
+  _rep = this->names;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void JointStatePublisher::Fleet::Publish(const UpdateInfo &_info)
+{
+  const auto stamp = convert<msgs::Time>(_info.simTime);
+  this->packed.mutable_header()->mutable_stamp()->CopyFrom(stamp);
+
+  int index = 0;
+  for (auto &[entity, tracked] : this->models)
+  {
+    if (tracked.pub)
+    {
+      tracked.msg.mutable_header()->mutable_stamp()->CopyFrom(stamp);
+      if (auto pose = tracked.pose.Get())
+        msgs::Set(tracked.msg.mutable_pose(), pose->Data());
+    }
+
+    for (std::size_t j = 0u; j < tracked.joints.size(); ++j)
+    {
+      auto &joint = tracked.joints[j];
+      const auto *position = joint.position.Get();
+      const auto *velocity = joint.velocity.Get();
+      const auto *force = joint.force.Get();
+      auto value = [](const auto *_component, std::size_t _axis)
+      {
+        return _component && _axis < _component->Data().size() ?
+            _component->Data()[_axis] : 0.0;
+      };
+
+      for (std::size_t axis = 0u; axis < joint.axes; ++axis)
+      {
+        const double p = value(position, axis);
+        const double v = value(velocity, axis);
+        const double f = value(force, axis);
+        this->packed.set_data(index++, p);
+        this->packed.set_data(index++, v);
+        this->packed.set_data(index++, f);
+
+        if (tracked.pub)
+        {
+          auto *jointMsg = tracked.msg.mutable_joint(static_cast<int>(j));
+          auto *axisMsg = axis == 0u ? jointMsg->mutable_axis1() :
+              jointMsg->mutable_axis2();
+          axisMsg->set_position(p);
+          axisMsg->set_velocity(v);
+          axisMsg->set_force(f);
+        }
+      }
+    }
+
+    if (tracked.pub)
+      tracked.pub->Publish(tracked.msg);
+  }
+
+  this->pub.Publish(this->packed);
+}
+
 //////////////////////////////////////////////////
 JointStatePublisher::JointStatePublisher()
     : System()
 {
 }
 
+//////////////////////////////////////////////////
+JointStatePublisher::~JointStatePublisher() = default;
+
 //////////////////////////////////////////////////
 void JointStatePublisher::Configure(
     const Entity &_entity, const std::shared_ptr<const sdf::Element> &_sdf,
     EntityComponentManager &_ecm, EventManager &)
 {
+  // Publish the joints of all models when attached to a world.
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->fleet = std::make_unique<Fleet>();
+    auto elem = _sdf->FindElement("model_name");
+    while (elem)
+    {
+      this->fleet->modelNames.insert(elem->Get<std::string>());
+      elem = elem->GetNextElement("model_name");
+    }
+    this->fleet->perModelTopics =
+        _sdf->Get<bool>("per_model_topics", false).first;
+
+    std::vector<std::string> topics;
+    if (_sdf->HasElement("topic"))
+      topics.push_back(_sdf->Get<std::string>("topic"));
+    topics.push_back("/world/" + World(_entity).Name(_ecm).value_or("") +
+        "/joint_state");
+    this->fleet->topic = validTopic(topics);
+    if (this->fleet->topic.empty())
+    {
+      gzerr << "No valid topics for JointStatePublisher could be found."
+        << "Make sure World name does'nt contain invalid characters.\n";
+      this->fleet.reset();
+      return;
+    }
+
+    this->fleet->pub =
+        this->fleet->node.Advertise<msgs::Double_V>(this->fleet->topic);
+    const std::string namesTopic = this->fleet->topic + "/names";
+    this->fleet->namesPub =
+        this->fleet->node.Advertise<msgs::StringMsg_V>(namesTopic);
+    this->fleet->node.Advertise(namesTopic, &Fleet::OnNames,
+        this->fleet.get());
+    gzmsg << "JointStatePublisher publishing the joints of all models on ["
+          << this->fleet->topic << "]" << std::endl;
+    return;
+  }
+
   // Get the model.
   this->model = Model(_entity);
   if (!this->model.Valid(_ecm))
@@ -113,32 +452,74 @@ void JointStatePublisher::CreateComponents(EntityComponentManager &_ecm,
   }
 
   this->joints.insert(_joint);
+  createJointComponents(_ecm, _joint);
+}
 
-  // Create joint position component if one doesn't exist
-  if (!_ecm.EntityHasComponentType(_joint,
-        components::JointPosition().TypeId()))
-  {
-    _ecm.CreateComponent(_joint, components::JointPosition());
-  }
+//////////////////////////////////////////////////
+void JointStatePublisher::PreUpdate(const UpdateInfo &,
+    EntityComponentManager &_ecm)
+{
+  if (!this->fleet)
+    return;
 
-  // Create joint velocity component if one doesn't exist
-  if (!_ecm.EntityHasComponentType(_joint,
-        components::JointVelocity().TypeId()))
+  GZ_PROFILE("JointStatePublisher::PreUpdate");
+
+  // Models which existed before the first update may not be new anymore
+  if (!this->fleet->initialized)
   {
-    _ecm.CreateComponent(_joint, components::JointVelocity());
+    this->fleet->initialized = true;
+    _ecm.Each<components::Model>(
+        [&](const Entity &_entity, const components::Model *) -> bool
+        {
+          this->fleet->AddModel(_ecm, _entity);
+          return true;
+        });
   }
 
-  // Create joint force component if one doesn't exist
-  if (!_ecm.EntityHasComponentType(_joint, components::JointForce().TypeId()))
+  // Models found by the previous PostUpdate
+  for (const Entity &entity : this->fleet->newModels)
   {
-    _ecm.CreateComponent(_joint, components::JointForce());
+    if (_ecm.HasEntity(entity))
+      this->fleet->AddModel(_ecm, entity);
   }
+  this->fleet->newModels.clear();
 }
 
 //////////////////////////////////////////////////
 void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
                                 const EntityComponentManager &_ecm)
 {
+  if (this->fleet)
+  {
+    GZ_PROFILE("JointStatePublisher::PostUpdate");
+
+    // New models get their joint components in the next PreUpdate, as
+    // models spawned during PreUpdate may not be seen as new there.
+    _ecm.EachNew<components::Model>(
+        [&](const Entity &_entity, const components::Model *) -> bool
+        {
+          if (this->fleet->models.find(_entity) == this->fleet->models.end())
+            this->fleet->newModels.push_back(_entity);
+          return true;
+        });
+    _ecm.EachRemoved<components::Model>(
+        [&](const Entity &_entity, const components::Model *) -> bool
+        {
+          if (this->fleet->models.erase(_entity) > 0u)
+            this->fleet->layoutChanged = true;
+          return true;
+        });
+
+    if (this->fleet->layoutChanged)
+      this->fleet->UpdateLayout(_ecm);
+    this->fleet->Publish(_info);
+    return;
+  }
+
+  // Skip if not attached to a model.
+  if (!this->model.Valid(_ecm))
+    return;
+
   // Create the model state publisher. This can't be done in ::Configure
   // because the World is not guaranteed to be accessible.
   if (!this->modelPub)
@@ -314,6 +695,7 @@ void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
 GZ_ADD_PLUGIN(JointStatePublisher,
                     System,
                     JointStatePublisher::ISystemConfigure,
+                    JointStatePublisher::ISystemPreUpdate,
                     JointStatePublisher::ISystemPostUpdate)
 
 GZ_ADD_PLUGIN_ALIAS(JointStatePublisher,
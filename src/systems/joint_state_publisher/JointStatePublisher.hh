@@ -50,22 +50,48 @@ namespace systems
   /// - `<joint_name>`: Name of a joint to publish. This parameter can be
   /// specified multiple times, and is optional. All joints in a model will
   /// be published if joint names are not specified.
+  ///
+  /// ## World-level publication
+  ///
+  /// When attached to a world, a single instance publishes the joints of all
+  /// models, including those spawned later, as a gz::msgs::Double_V which
+  /// packs the position, velocity and force of each joint axis in turn. The
+  /// messages are reused between steps. The scoped name of the joint of each
+  /// axis is published as a gz::msgs::StringMsg_V on `<topic>/names` when
+  /// joints are added or removed, and is available from the service of the
+  /// same name. It has these parameters:
+  ///
+  /// - `<topic>`: Topic of the packed joint states. Defaults to
+  /// "/world/<world_name>/joint_state".
+  ///
+  /// - `<model_name>`: Name of a model whose joints are published. This
+  /// parameter can be specified multiple times, and is optional. The joints
+  /// of all models are published if model names are not specified.
+  ///
+  /// - `<per_model_topics>`: If true, the gz::msgs::Model of each model is
+  /// also published on "/world/<world_name>/model/<model_name>/joint_state",
+  /// as by a model-level instance. Defaults to false.
   class JointStatePublisher
       : public System,
         public ISystemConfigure,
+        public ISystemPreUpdate,
         public ISystemPostUpdate
   {
     /// \brief Constructor
     public: JointStatePublisher();
 
     /// \brief Destructor
-    public: ~JointStatePublisher() override = default;
+    public: ~JointStatePublisher() override;
 
     // Documentation inherited
     public: void Configure(const Entity &_entity,
         const std::shared_ptr<const sdf::Element> &,
         EntityComponentManager &_ecm, EventManager &) override;
 
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) final;
+
     // Documentation inherited
     public: void PostUpdate(const UpdateInfo &_info,
                             const EntityComponentManager &_ecm) final;
@@ -90,6 +116,14 @@ namespace systems
 
     /// \brief The topic
     private: std::string topic;
+
+    /// \brief Publication of the joints of all models, when attached to a
+    /// world.
+    private: class Fleet;
+
+    /// \brief State of the world-level publication, or null when attached
+    /// to a model.
+    private: std::unique_ptr<Fleet> fleet;
   };
   }
 }
@@ -35,11 +35,13 @@
 #include <gz/transport/Publisher.hh>
 #include <gz/transport/TopicUtils.hh>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
 
 #include "JointTrajectoryController.hh"
+#include "TrajectorySpline.hh"
 
 using namespace gz;
 using namespace sim;
@@ -214,6 +216,24 @@ class Trajectory
   public: bool UpdateCurrentPoint(
               const std::chrono::steady_clock::duration &_simTime);
 
+  /// \brief Set the joints of a new trajectory
+  /// \param[in] _jointNames Ordered joints of the trajectory
+  /// \param[in] _actuatedJoints Joints configured in the controller
+  public: void SetJoints(
+              const google::protobuf::RepeatedPtrField<std::string>
+                  &_jointNames,
+              std::map<std::string, ActuatedJoint> &_actuatedJoints);
+
+  /// \brief Append a point after the existing ones, and to the spline if
+  /// interpolating
+  /// \param[in] _point The point
+  public: void AppendPoint(const gz::msgs::JointTrajectoryPoint &_point);
+
+  /// \brief Sample the spline and set the targets of the joints
+  /// \param[in] _simTime Current simulation time
+  public: void SampleTargets(
+              const std::chrono::steady_clock::duration &_simTime);
+
   /// \brief Determine if the trajectory goal was reached
   /// \return True if trajectory goal was reached, False otherwise
   public: bool IsGoalReached() const;
@@ -251,6 +271,35 @@ class Trajectory
   /// \brief Trajectory defined in terms of temporal points, whose members are
   /// ordered according to `jointNames`
   public: std::vector<gz::msgs::JointTrajectoryPoint> points;
+
+  /// \brief Time from start of each point, converted once on arrival
+  public: std::vector<std::chrono::steady_clock::duration> pointTimes;
+
+  /// \brief Actuated joint of each of `jointNames`, null for joints which
+  /// aren't configured
+  public: std::vector<ActuatedJoint *> joints;
+
+  /// \brief True to interpolate targets between points
+  public: bool interpolate{false};
+
+  /// \brief True while targets are sampled from the spline
+  public: bool sampling{false};
+
+  /// \brief Interpolation of the positions of the points
+  public: joint_traj_control::TrajectorySpline spline;
+
+  /// \brief Positions of the last appended point, held by joints which
+  /// don't have a position in the following points
+  public: std::vector<double> pointPositions;
+
+  /// \brief Velocities of the point being appended
+  public: std::vector<double> pointVelocities;
+
+  /// \brief Sampled positions, kept between updates to avoid allocations
+  public: std::vector<double> sampledPositions;
+
+  /// \brief Sampled velocities, kept between updates to avoid allocations
+  public: std::vector<double> sampledVelocities;
 };
 
 /// \brief Private data of the JointTrajectoryController plugin
@@ -275,6 +324,13 @@ class gz::sim::systems::JointTrajectoryControllerPrivate
   public: void JointTrajectoryCallback(
               const gz::msgs::JointTrajectory &_msg);
 
+  /// \brief Callback for the subscription to points appended to the current
+  /// trajectory
+  /// \param[in] _msg Points following those of the current trajectory, with
+  /// the same joints and start time
+  public: void JointTrajectoryAppendCallback(
+              const gz::msgs::JointTrajectory &_msg);
+
   /// \brief Reset internals of the plugin, without affecting already created
   /// components
   public: void Reset();
@@ -373,6 +429,8 @@ void JointTrajectoryController::Configure(
   {
     this->dataPtr->useHeaderStartTime = false;
   }
+  this->dataPtr->trajectory.interpolate =
+      _sdf->Get<bool>("interpolate", false).first;
 
   // Subscribe to joint trajectory commands
   auto trajectoryTopic = _sdf->Get<std::string>("topic");
@@ -398,6 +456,15 @@ void JointTrajectoryController::Configure(
       &JointTrajectoryControllerPrivate::JointTrajectoryCallback,
       this->dataPtr.get());
 
+  // Subscribe to points appended to the current trajectory
+  const auto appendTopic = validTrajectoryTopic + "_append";
+  gzmsg << "[JointTrajectoryController] Subscribing to joint trajectory"
+            " appends on topic [" << appendTopic << "].\n";
+  this->dataPtr->node.Subscribe(
+      appendTopic,
+      &JointTrajectoryControllerPrivate::JointTrajectoryAppendCallback,
+      this->dataPtr.get());
+
   // Advertise progress
   const auto progressTopic = validTrajectoryTopic + "_progress";
   gzmsg << "[JointTrajectoryController] Advertising joint trajectory progress"
@@ -461,6 +528,9 @@ void JointTrajectoryController::PreUpdate(
       {
         this->dataPtr->trajectory.status = Trajectory::Reached;
       }
+      this->dataPtr->trajectory.sampling =
+          this->dataPtr->trajectory.interpolate &&
+          !this->dataPtr->trajectory.points.empty();
 
       // Update is always needed for a new trajectory
       isTargetUpdateRequired = true;
@@ -485,16 +555,15 @@ void JointTrajectoryController::PreUpdate(
           this->dataPtr->trajectory.points[this->dataPtr->trajectory
                                                .pointIndex];
       for (auto jointIndex = 0u;
-           jointIndex < this->dataPtr->trajectory.jointNames.size();
+           jointIndex < this->dataPtr->trajectory.joints.size();
            ++jointIndex)
       {
-        const auto jointName = this->dataPtr->trajectory.jointNames[jointIndex];
-        if (this->dataPtr->actuatedJoints.count(jointName) == 0)
+        auto *joint = this->dataPtr->trajectory.joints[jointIndex];
+        if (nullptr == joint)
         {
           // Warning about unconfigured joint is already logged above
           continue;
         }
-        auto *joint = &this->dataPtr->actuatedJoints[jointName];
         joint->SetTarget(targetPoint, jointIndex);
       }
 
@@ -510,6 +579,12 @@ void JointTrajectoryController::PreUpdate(
       progressMsg.set_data(this->dataPtr->trajectory.ComputeProgress());
       this->dataPtr->progressPub.Publish(progressMsg);
     }
+
+    // Interpolate position and velocity targets between points
+    if (this->dataPtr->trajectory.sampling)
+    {
+      this->dataPtr->trajectory.SampleTargets(_info.simTime);
+    }
   }
 
   // Control loop
@@ -642,7 +717,7 @@ void JointTrajectoryControllerPrivate::JointTrajectoryCallback(
 
   // Warn user that accelerations are currently ignored if the first point
   // contains them
-  if (_msg.points(0).accelerations_size() > 0)
+  if (_msg.points_size() > 0 && _msg.points(0).accelerations_size() > 0)
   {
     gzwarn << "[JointTrajectoryController] JointTrajectory message contains"
                " acceleration commands, which are currently ignored.\n";
@@ -678,13 +753,58 @@ void JointTrajectoryControllerPrivate::JointTrajectoryCallback(
   this->trajectory.Reset();
 
   // Extract joint names and points
-  for (const auto &joint_name : _msg.joint_names())
+  this->trajectory.SetJoints(_msg.joint_names(), this->actuatedJoints);
+  for (const auto &point : _msg.points())
   {
-    this->trajectory.jointNames.push_back(joint_name);
+    this->trajectory.AppendPoint(point);
   }
+}
+
+//////////////////////////////////////////////////
+void JointTrajectoryControllerPrivate::JointTrajectoryAppendCallback(
+    const gz::msgs::JointTrajectory &_msg)
+{
+  std::unique_lock<std::mutex> lock(this->trajectoryMutex);
+
+  // Without a current trajectory, the points start a new one
+  if (this->trajectory.jointNames.empty())
+  {
+    lock.unlock();
+    this->JointTrajectoryCallback(_msg);
+    return;
+  }
+
+  if (_msg.joint_names_size() > 0 &&
+      !std::equal(_msg.joint_names().begin(), _msg.joint_names().end(),
+                  this->trajectory.jointNames.begin(),
+                  this->trajectory.jointNames.end()))
+  {
+    gzwarn << "[JointTrajectoryController] Ignoring appended points, whose"
+               " joint names differ from those of the current trajectory.\n";
+    return;
+  }
+
+  const auto previousCount = this->trajectory.points.size();
   for (const auto &point : _msg.points())
   {
-    this->trajectory.points.push_back(point);
+    const auto pointTime = std::chrono::seconds(point.time_from_start().sec())
+        + std::chrono::nanoseconds(point.time_from_start().nsec());
+    if (!this->trajectory.pointTimes.empty() &&
+        pointTime <= this->trajectory.pointTimes.back())
+    {
+      gzwarn << "[JointTrajectoryController] Ignoring an appended point which"
+                 " isn't later than the last point of the trajectory.\n";
+      continue;
+    }
+    this->trajectory.AppendPoint(point);
+  }
+
+  // Resume a trajectory whose goal was reached
+  if (this->trajectory.points.size() > previousCount &&
+      this->trajectory.status == Trajectory::Reached)
+  {
+    this->trajectory.status = Trajectory::Active;
+    this->trajectory.sampling = this->trajectory.interpolate;
   }
 }
 
@@ -1010,10 +1130,7 @@ bool Trajectory::UpdateCurrentPoint(
     }
 
     // Break if point needs to be followed
-    const auto pointTFS = this->points[this->pointIndex].time_from_start();
-    const auto pointTime = std::chrono::seconds(pointTFS.sec()) +
-                           std::chrono::nanoseconds(pointTFS.nsec());
-    if (pointTime >= trajectoryTime)
+    if (this->pointTimes[this->pointIndex] >= trajectoryTime)
     {
       break;
     }
@@ -1027,6 +1144,95 @@ bool Trajectory::UpdateCurrentPoint(
   return isUpdated;
 }
 
+//////////////////////////////////////////////////
+void Trajectory::SetJoints(
+    const google::protobuf::RepeatedPtrField<std::string> &_jointNames,
+    std::map<std::string, ActuatedJoint> &_actuatedJoints)
+{
+  this->jointNames.assign(_jointNames.begin(), _jointNames.end());
+  this->joints.clear();
+  this->pointPositions.clear();
+  for (const auto &jointName : this->jointNames)
+  {
+    auto it = _actuatedJoints.find(jointName);
+    ActuatedJoint *joint = it == _actuatedJoints.end() ? nullptr : &it->second;
+    this->joints.push_back(joint);
+    this->pointPositions.push_back(joint ? joint->initialPosition : 0.0);
+  }
+
+  const auto count = this->jointNames.size();
+  this->spline.Clear(count);
+  this->pointVelocities.resize(count);
+  this->sampledPositions.resize(count);
+  this->sampledVelocities.resize(count);
+}
+
+//////////////////////////////////////////////////
+void Trajectory::AppendPoint(const gz::msgs::JointTrajectoryPoint &_point)
+{
+  const auto pointTime = std::chrono::seconds(_point.time_from_start().sec()) +
+      std::chrono::nanoseconds(_point.time_from_start().nsec());
+  this->points.push_back(_point);
+  this->pointTimes.push_back(pointTime);
+
+  if (!this->interpolate)
+  {
+    return;
+  }
+
+  // Joints without a position in this point hold the previous one
+  const auto count = this->jointNames.size();
+  for (auto j = 0u; j < count && (int)j < _point.positions_size(); ++j)
+  {
+    this->pointPositions[j] = _point.positions(j);
+  }
+  const bool hasVelocities =
+      _point.velocities_size() >= static_cast<int>(count);
+  for (auto j = 0u; hasVelocities && j < count; ++j)
+  {
+    this->pointVelocities[j] = _point.velocities(j);
+  }
+
+  if (!this->spline.Append(
+          std::chrono::duration<double>(pointTime).count(),
+          this->pointPositions.data(),
+          hasVelocities ? this->pointVelocities.data() : nullptr))
+  {
+    gzwarn << "[JointTrajectoryController] Point is not later than the"
+               " previous one and won't be interpolated.\n";
+  }
+}
+
+//////////////////////////////////////////////////
+void Trajectory::SampleTargets(
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  const double trajectoryTime =
+      std::chrono::duration<double>(_simTime - this->startTime).count();
+  if (!this->spline.Sample(trajectoryTime, this->sampledPositions.data(),
+                           this->sampledVelocities.data()))
+  {
+    this->sampling = false;
+    return;
+  }
+
+  for (auto j = 0u; j < this->joints.size(); ++j)
+  {
+    if (nullptr == this->joints[j])
+    {
+      continue;
+    }
+    this->joints[j]->target.position = this->sampledPositions[j];
+    this->joints[j]->target.velocity = this->sampledVelocities[j];
+  }
+
+  // The last point is followed after the end of the spline
+  if (trajectoryTime >= this->spline.EndTime())
+  {
+    this->sampling = false;
+  }
+}
+
 //////////////////////////////////////////////////
 bool Trajectory::IsGoalReached() const
 {
@@ -1054,6 +1260,10 @@ void Trajectory::Reset()
   this->pointIndex = 0;
   this->jointNames.clear();
   this->points.clear();
+  this->pointTimes.clear();
+  this->joints.clear();
+  this->sampling = false;
+  this->spline.Clear(0u);
 }
 
 // Register plugin
@@ -58,6 +58,12 @@ namespace systems
   /// might already be implemented in the motion planning framework of your
   /// choice).
   ///
+  /// Points can be appended to the current trajectory without restarting it
+  /// by sending them on `<topic>_append`, with the same joint names (or none)
+  /// and times from the start of the current trajectory. They're ignored
+  /// unless they're later than its last point. Appending to a trajectory
+  /// whose goal was reached resumes it.
+  ///
   /// The progress of the current trajectory can be tracked on topic whose name
   /// is derived as `<topic>_progress`. This progress is indicated in the range
   /// of (0.0, 1.0] and is currently based purely on `time_from_start` contained
@@ -74,6 +80,14 @@ namespace systems
   ///  Optional parameter.
   ///  Defaults to false.
   ///
+  /// - `<interpolate>` If enabled, position and velocity targets are
+  ///  interpolated between points instead of jumping to the next point:
+  ///  cubic Hermite splines are used between points that have velocities,
+  ///  and linear segments otherwise. Spline coefficients are computed once
+  ///  when points arrive.
+  ///  Optional parameter.
+  ///  Defaults to false.
+  ///
   /// - `<joint_name>` Name of a joint to control.
   ///  This parameter can be specified multiple times, i.e. once for each joint.
   ///  Optional parameter.
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_JOINT_TRAJ_CONTROL_TRAJECTORYSPLINE_HH_
+#define GZ_SIM_SYSTEMS_JOINT_TRAJ_CONTROL_TRAJECTORYSPLINE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace joint_traj_control
+{
+/// \brief Piecewise polynomial interpolation of the positions of a set of
+/// joints between trajectory points.
+///
+/// Segments between two points which both have velocities are cubic Hermite
+/// splines, and other segments are linear. Coefficients are computed once
+/// when a point is appended, and sampling keeps a cursor into the current
+/// segment, so that following a trajectory forward in time takes constant
+/// time per sample regardless of its length. Points can be appended while
+/// the trajectory is being sampled.
+class TrajectorySpline
+{
+  /// \brief Remove all points.
+  /// \param[in] _joints Number of joints of the points appended next.
+  public: void Clear(std::size_t _joints)
+  {
+    this->joints = _joints;
+    this->times.clear();
+    this->positions.clear();
+    this->velocities.clear();
+    this->hasVelocities.clear();
+    this->coefficients.clear();
+    this->cursor = 0u;
+  }
+
+  /// \brief Get the number of joints.
+  /// \return Number of joints.
+  public: std::size_t JointCount() const
+  {
+    return this->joints;
+  }
+
+  /// \brief Get the number of points.
+  /// \return Number of points.
+  public: std::size_t PointCount() const
+  {
+    return this->times.size();
+  }
+
+  /// \brief Get the time of the last point.
+  /// \return Time of the last point [s], 0 if there are none.
+  public: double EndTime() const
+  {
+    return this->times.empty() ? 0.0 : this->times.back();
+  }
+
+  /// \brief Append a point after the existing ones.
+  /// \param[in] _time Time of the point [s], later than the last point.
+  /// \param[in] _positions Position of each joint.
+  /// \param[in] _velocities Velocity of each joint, or null if unknown.
+  /// \return False if the point isn't later than the last one.
+  public: bool Append(double _time, const double *_positions,
+                      const double *_velocities)
+  {
+    if (!this->times.empty() && !(_time > this->times.back()))
+      return false;
+
+    this->times.push_back(_time);
+    this->positions.insert(this->positions.end(), _positions,
+        _positions + this->joints);
+    if (_velocities)
+    {
+      this->velocities.insert(this->velocities.end(), _velocities,
+          _velocities + this->joints);
+    }
+    else
+    {
+      this->velocities.resize(this->velocities.size() + this->joints, 0.0);
+    }
+    this->hasVelocities.push_back(_velocities != nullptr);
+
+    if (this->times.size() > 1u)
+      this->AddSegment();
+    return true;
+  }
+
+  /// \brief Sample the positions and velocities of the joints. Before the
+  /// first point and after the last one, the positions of the closest point
+  /// are held with zero velocities.
+  /// \param[in] _time Time to sample at [s].
+  /// \param[out] _positions Position of each joint.
+  /// \param[out] _velocities Velocity of each joint.
+  /// \return False if there are no points.
+  public: bool Sample(double _time, double *_positions,
+                      double *_velocities)
+  {
+    if (this->times.empty())
+      return false;
+
+    const std::size_t last = this->times.size() - 1u;
+    if (_time <= this->times.front() || _time >= this->times[last])
+    {
+      const std::size_t point = _time <= this->times.front() ? 0u : last;
+      std::copy_n(this->positions.begin() + point * this->joints,
+          this->joints, _positions);
+      std::fill_n(_velocities, this->joints, 0.0);
+      return true;
+    }
+
+    // Move the cursor forward, or search again if time went backwards
+    if (this->cursor >= last || _time < this->times[this->cursor])
+    {
+      this->cursor = static_cast<std::size_t>(std::upper_bound(
+          this->times.begin(), this->times.end(), _time) -
+          this->times.begin()) - 1u;
+    }
+    while (_time >= this->times[this->cursor + 1u])
+      ++this->cursor;
+
+    const double s = _time - this->times[this->cursor];
+    const double *c = &this->coefficients[this->cursor * this->joints * 4u];
+    for (std::size_t j = 0u; j < this->joints; ++j, c += 4)
+    {
+      _positions[j] = c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+      _velocities[j] = c[1] + s * (2.0 * c[2] + s * 3.0 * c[3]);
+    }
+    return true;
+  }
+
+  /// \brief Compute the coefficients of the segment ending at the last
+  /// point.
+  private: void AddSegment()
+  {
+    const std::size_t end = this->times.size() - 1u;
+    const std::size_t start = end - 1u;
+    const double h = this->times[end] - this->times[start];
+    const bool cubic = this->hasVelocities[start] && this->hasVelocities[end];
+    const double *p0 = &this->positions[start * this->joints];
+    const double *p1 = &this->positions[end * this->joints];
+    const double *v0 = &this->velocities[start * this->joints];
+    const double *v1 = &this->velocities[end * this->joints];
+
+    for (std::size_t j = 0u; j < this->joints; ++j)
+    {
+      const double slope = (p1[j] - p0[j]) / h;
+      this->coefficients.push_back(p0[j]);
+      if (cubic)
+      {
+        this->coefficients.push_back(v0[j]);
+        this->coefficients.push_back((3.0 * slope - 2.0 * v0[j] - v1[j]) / h);
+        this->coefficients.push_back((v0[j] + v1[j] - 2.0 * slope) / (h * h));
+      }
+      else
+      {
+        this->coefficients.push_back(slope);
+        this->coefficients.push_back(0.0);
+        this->coefficients.push_back(0.0);
+      }
+    }
+  }
+
+  /// \brief Number of joints.
+  private: std::size_t joints{0u};
+
+  /// \brief Time of each point.
+  private: std::vector<double> times;
+
+  /// \brief Positions of the joints at each point, point after point.
+  private: std::vector<double> positions;
+
+  /// \brief Velocities of the joints at each point, point after point.
+  private: std::vector<double> velocities;
+
+  /// \brief Whether each point has velocities.
+  private: std::vector<bool> hasVelocities;
+
+  /// \brief 4 polynomial coefficients per joint and segment, in increasing
+  /// order of degree, in the time since the start of the segment.
+  private: std::vector<double> coefficients;
+
+  /// \brief Segment of the last sample.
+  private: std::size_t cursor{0u};
+};
+}
+}
+}
+}
+}
+
+#endif
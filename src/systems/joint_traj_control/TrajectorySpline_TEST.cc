@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "TrajectorySpline.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::joint_traj_control;
+
+/////////////////////////////////////////////////
+TEST(TrajectorySpline, Linear)
+{
+  TrajectorySpline spline;
+  spline.Clear(2u);
+  double pos[2];
+  double vel[2];
+  EXPECT_FALSE(spline.Sample(0.0, pos, vel));
+
+  const double p0[2]{0.0, 1.0};
+  const double p1[2]{1.0, -1.0};
+  EXPECT_TRUE(spline.Append(1.0, p0, nullptr));
+  EXPECT_TRUE(spline.Append(3.0, p1, nullptr));
+  EXPECT_FALSE(spline.Append(3.0, p1, nullptr));
+  EXPECT_EQ(2u, spline.PointCount());
+  EXPECT_DOUBLE_EQ(3.0, spline.EndTime());
+
+  ASSERT_TRUE(spline.Sample(2.0, pos, vel));
+  EXPECT_DOUBLE_EQ(0.5, pos[0]);
+  EXPECT_DOUBLE_EQ(0.0, pos[1]);
+  EXPECT_DOUBLE_EQ(0.5, vel[0]);
+  EXPECT_DOUBLE_EQ(-1.0, vel[1]);
+
+  // Points are held outside of the trajectory
+  ASSERT_TRUE(spline.Sample(0.0, pos, vel));
+  EXPECT_DOUBLE_EQ(1.0, pos[1]);
+  EXPECT_DOUBLE_EQ(0.0, vel[1]);
+  ASSERT_TRUE(spline.Sample(10.0, pos, vel));
+  EXPECT_DOUBLE_EQ(1.0, pos[0]);
+  EXPECT_DOUBLE_EQ(0.0, vel[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(TrajectorySpline, Cubic)
+{
+  // Samples of x^3 - x, whose cubic Hermite interpolation is exact
+  TrajectorySpline spline;
+  spline.Clear(1u);
+  for (int i = 0; i <= 20; ++i)
+  {
+    const double t = 0.1 * i;
+    const double p = t * t * t - t;
+    const double v = 3 * t * t - 1;
+    ASSERT_TRUE(spline.Append(t, &p, &v));
+  }
+
+  double pos;
+  double vel;
+  for (double t : {0.05, 0.33, 0.71, 1.5, 1.99})
+  {
+    ASSERT_TRUE(spline.Sample(t, &pos, &vel));
+    EXPECT_NEAR(t * t * t - t, pos, 1e-12) << t;
+    EXPECT_NEAR(3 * t * t - 1, vel, 1e-12) << t;
+  }
+
+  // Going back in time
+  ASSERT_TRUE(spline.Sample(0.42, &pos, &vel));
+  EXPECT_NEAR(0.42 * 0.42 * 0.42 - 0.42, pos, 1e-12);
+
+  // Points appended while sampling
+  const double p = 4.0;
+  const double v = 0.0;
+  ASSERT_TRUE(spline.Append(3.0, &p, &v));
+  ASSERT_TRUE(spline.Sample(2.5, &pos, &vel));
+  EXPECT_GT(pos, 6.0);
+  EXPECT_LT(pos, 8.0);
+  ASSERT_TRUE(spline.Sample(3.0, &pos, &vel));
+  EXPECT_DOUBLE_EQ(4.0, pos);
+}
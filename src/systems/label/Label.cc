@@ -23,7 +23,6 @@
 
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/components/Actor.hh"
-#include "gz/sim/components/Link.hh"
 #include "gz/sim/components/Model.hh"
 #include "gz/sim/components/SemanticLabel.hh"
 #include "gz/sim/components/Visual.hh"
@@ -64,7 +63,7 @@ void Label::Configure(const Entity &_entity,
   }
 
   // Attach a semantic label component to the visual.
-  // If the plugin is inside the <model> tag, get its visual child.
+  // If the plugin is inside the <model> tag, label all its visuals.
   if (_ecm.EntityHasComponentType(_entity, components::Visual::typeId) ||
       _ecm.EntityHasComponentType(_entity, components::Actor::typeId))
   {
@@ -72,27 +71,10 @@ void Label::Configure(const Entity &_entity,
   }
   else if (_ecm.EntityHasComponentType(_entity, components::Model::typeId))
   {
-    // TODO(anyone) add support for nested models. We will need to check for
-    // child models and their respective links/visuals
-    // https://github.com/gazebosim/gz-sim/issues/1041
-
-    // Get link childern of parent model
-    auto links = _ecm.ChildrenByComponents<components::Link>(
-      _entity, components::Link());
-
-    for (auto linkEntity : links)
-    {
-      // get visual child of parent link
-      auto visuals = _ecm.ChildrenByComponents<components::Visual>(
-        linkEntity, components::Visual());
-
-      // Create label component to all visual childern
-      for (auto visualEntity : visuals)
-      {
-        _ecm.CreateComponent(visualEntity,
-          components::SemanticLabel(label));
-      }
-    }
+    // The visuals of all links, including those of nested models, are
+    // labeled at once
+    _ecm.SetDescendantsComponentData<components::SemanticLabel,
+        components::Visual>(_entity, label);
   }
   else
   {
@@ -32,7 +32,9 @@ namespace systems
 {
   /// \brief A label plugin that annotates models by setting the label
   /// for the parent entity's visuals. The plugin can be attached to models,
-  /// visuals, or actors.
+  /// visuals, or actors. When attached to a model, the label is set on
+  /// all the visuals of the model in one pass, including the visuals of
+  /// nested models.
   ///
   /// Ex: "<label>1</label>" means the visual has a label of 1
   /// Label value must be in [0-255] range
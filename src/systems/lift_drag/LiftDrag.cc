@@ -18,7 +18,11 @@
 #include "LiftDrag.hh"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
 
@@ -42,11 +46,71 @@
 #include "gz/sim/components/ExternalWorldWrenchCmd.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Wind.hh"
+#include "gz/sim/components/World.hh"
+
+#include "LiftDragBatch.hh"
 
 using namespace gz;
 using namespace sim;
 using namespace systems;
 
+/// \brief Surfaces simulated by the lift drag systems of a world, so that
+/// a world-level instance can evaluate all of them together.
+struct LiftDragRegistry
+{
+  /// \brief A registered surface.
+  struct Entry
+  {
+    /// \brief Data of the surface's system.
+    LiftDragPrivate *data;
+
+    /// \brief Unique identifier of the registration.
+    uint64_t id;
+  };
+
+  /// \brief Protects surfaces and version.
+  std::mutex mutex;
+
+  /// \brief Registered surfaces.
+  std::vector<Entry> surfaces;
+
+  /// \brief Incremented whenever surfaces changes.
+  uint64_t version{0u};
+
+  /// \brief True while a world-level instance evaluates the surfaces.
+  std::atomic<bool> batched{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the registry of the world simulated by an ECM.
+/// \param[in] _ecm The Entity Component Manager
+/// \return The registry, shared by the systems of that world.
+std::shared_ptr<LiftDragRegistry> registryFor(
+    const EntityComponentManager &_ecm)
+{
+  static std::mutex mutex;
+  static std::unordered_map<const EntityComponentManager *,
+      std::weak_ptr<LiftDragRegistry>> registries;
+
+  std::lock_guard lock(mutex);
+  for (auto it = registries.begin(); it != registries.end();)
+  {
+    if (it->second.expired())
+      it = registries.erase(it);
+    else
+      ++it;
+  }
+
+  auto &weak = registries[&_ecm];
+  auto registry = weak.lock();
+  if (!registry)
+  {
+    registry = std::make_shared<LiftDragRegistry>();
+    weak = registry;
+  }
+  return registry;
+}
+
 class gz::sim::systems::LiftDragPrivate
 {
   // Initialize the system
@@ -58,6 +122,18 @@ class gz::sim::systems::LiftDragPrivate
   /// \param[in] _ecm Immutable reference to the EntityComponentManager
   public: void Update(EntityComponentManager &_ecm);
 
+  /// \brief Destructor, which unregisters the surface.
+  public: ~LiftDragPrivate();
+
+  /// \brief Get the parameters of the surface, for the batch.
+  /// \return The parameters.
+  public: lift_drag::Surface BatchSurface() const;
+
+  /// \brief Evaluate the wrenches of all the registered surfaces together,
+  /// and apply them. Called on the world-level instance.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager
+  public: void EvaluateBatch(EntityComponentManager &_ecm);
+
   /// \brief Model interface
   public: Model model{kNullEntity};
 
@@ -142,8 +218,172 @@ class gz::sim::systems::LiftDragPrivate
 
   /// \brief Initialization flag
   public: bool initialized{false};
+
+  /// \brief Registry of the surfaces of the world.
+  public: std::shared_ptr<LiftDragRegistry> registry;
+
+  /// \brief True if the system is attached to the world rather than to a
+  /// model.
+  public: bool worldLevel{false};
+
+  /// \brief True if this world-level instance evaluates the surfaces.
+  public: bool batching{false};
+
+  /// \brief Wrenches of the surfaces, evaluated together.
+  public: lift_drag::LiftDragBatch batch;
+
+  /// \brief Registered surfaces, in the order of the batch.
+  public: std::vector<LiftDragRegistry::Entry> batchSurfaces;
+
+  /// \brief Version of the registry that batchSurfaces mirrors.
+  public: uint64_t batchVersion{0u};
+
+  /// \brief Whether each surface has a state at this step.
+  public: std::vector<char> batchValid;
 };
 
+/////////////////////////////////////////////////
+/// \brief Get the velocity of the wind, if the world has wind.
+/// \param[in] _ecm The Entity Component Manager
+/// \return The velocity, or nullptr.
+const components::WorldLinearVelocity *worldWind(
+    const EntityComponentManager &_ecm)
+{
+  Entity windEntity = _ecm.EntityByComponents(components::Wind());
+  if (windEntity == kNullEntity)
+    return nullptr;
+  return _ecm.Component<components::WorldLinearVelocity>(windEntity);
+}
+
+//////////////////////////////////////////////////
+LiftDragPrivate::~LiftDragPrivate()
+{
+  if (!this->registry)
+    return;
+  if (this->batching)
+    this->registry->batched = false;
+
+  std::lock_guard lock(this->registry->mutex);
+  auto &surfaces = this->registry->surfaces;
+  auto it = std::remove_if(surfaces.begin(), surfaces.end(),
+      [this](const LiftDragRegistry::Entry &_entry)
+      {
+        return _entry.data == this;
+      });
+  if (it != surfaces.end())
+  {
+    surfaces.erase(it, surfaces.end());
+    ++this->registry->version;
+  }
+}
+
+//////////////////////////////////////////////////
+lift_drag::Surface LiftDragPrivate::BatchSurface() const
+{
+  lift_drag::Surface surface;
+  surface.cla = this->cla;
+  surface.cda = this->cda;
+  surface.cma = this->cma;
+  surface.alphaStall = this->alphaStall;
+  surface.claStall = this->claStall;
+  surface.cdaStall = this->cdaStall;
+  surface.cmaStall = this->cmaStall;
+  surface.cmDelta = this->cm_delta;
+  surface.rho = this->rho;
+  surface.radialSymmetry = this->radialSymmetry;
+  surface.area = this->area;
+  surface.alpha0 = this->alpha0;
+  surface.controlJointRadToCL = this->controlJointRadToCL;
+  surface.cp = this->cp;
+  surface.forward = this->forward;
+  surface.upward = this->upward;
+  return surface;
+}
+
+//////////////////////////////////////////////////
+void LiftDragPrivate::EvaluateBatch(EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("LiftDragPrivate::EvaluateBatch");
+
+  // Mirror the registered surfaces, keeping the order of those which stay
+  {
+    std::lock_guard lock(this->registry->mutex);
+    if (this->batchVersion != this->registry->version)
+    {
+      this->batchVersion = this->registry->version;
+      const auto &surfaces = this->registry->surfaces;
+      auto registered = [](const auto &_entries, uint64_t _id)
+      {
+        return std::any_of(_entries.begin(), _entries.end(),
+            [_id](const LiftDragRegistry::Entry &_entry)
+            {
+              return _entry.id == _id;
+            });
+      };
+      for (std::size_t i = this->batchSurfaces.size(); i-- > 0u;)
+      {
+        if (!registered(surfaces, this->batchSurfaces[i].id))
+        {
+          this->batch.Remove(i);
+          this->batchSurfaces[i] = this->batchSurfaces.back();
+          this->batchSurfaces.pop_back();
+        }
+      }
+      for (const auto &entry : surfaces)
+      {
+        if (!registered(this->batchSurfaces, entry.id))
+        {
+          this->batch.Add(entry.data->BatchSurface());
+          this->batchSurfaces.push_back(entry);
+        }
+      }
+    }
+  }
+
+  // Gather the state of every surface, and look the wind up once
+  const std::size_t count = this->batchSurfaces.size();
+  this->batchValid.assign(count, 0);
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    const auto *surface = this->batchSurfaces[i].data;
+    const auto worldLinVel = _ecm.Component<components::WorldLinearVelocity>(
+        surface->linkEntity);
+    const auto worldAngVel = _ecm.Component<components::WorldAngularVelocity>(
+        surface->linkEntity);
+    const auto worldPose =
+        _ecm.Component<components::WorldPose>(surface->linkEntity);
+    if (!worldLinVel || !worldAngVel || !worldPose)
+      continue;
+
+    double control{0.0};
+    if (surface->controlJointEntity != kNullEntity)
+    {
+      auto controlJointPosition = _ecm.Component<components::JointPosition>(
+          surface->controlJointEntity);
+      if (controlJointPosition && !controlJointPosition->Data().empty())
+        control = controlJointPosition->Data()[0];
+    }
+
+    this->batch.SetState(i, worldPose->Data().Rot(), worldLinVel->Data(),
+        worldAngVel->Data(), control);
+    this->batchValid[i] = 1;
+  }
+
+  const auto wind = worldWind(_ecm);
+  this->batch.Evaluate(wind ? wind->Data() : math::Vector3d::Zero);
+
+  math::Vector3d force;
+  math::Vector3d torque;
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    if (this->batchValid[i] && this->batch.Wrench(i, force, torque))
+    {
+      Link(this->batchSurfaces[i].data->linkEntity).AddWorldWrench(_ecm,
+          _ecm.Wrenches(), force, torque);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void LiftDragPrivate::Load(const EntityComponentManager &_ecm,
                            const sdf::ElementPtr &_sdf)
@@ -266,12 +506,7 @@ void LiftDragPrivate::Update(EntityComponentManager &_ecm)
       _ecm.Component<components::WorldPose>(this->linkEntity);
 
   // get wind as a component from the _ecm
-  components::WorldLinearVelocity *windLinearVel = nullptr;
-  if(_ecm.EntityByComponents(components::Wind()) != kNullEntity){
-    Entity windEntity = _ecm.EntityByComponents(components::Wind());
-    windLinearVel =
-        _ecm.Component<components::WorldLinearVelocity>(windEntity);
-  }
+  const auto windLinearVel = worldWind(_ecm);
   components::JointPosition *controlJointPosition = nullptr;
   if (this->controlJointEntity != kNullEntity)
   {
@@ -499,7 +734,7 @@ void LiftDragPrivate::Update(EntityComponentManager &_ecm)
   // positions
   const auto totalTorque = torque + cpWorld.Cross(force);
   Link link(this->linkEntity);
-  link.AddWorldWrench(_ecm, force, totalTorque);
+  link.AddWorldWrench(_ecm, _ecm.Wrenches(), force, totalTorque);
 
   // Debug
   // auto linkName = _ecm.Component<components::Name>(this->linkEntity)->Data();
@@ -531,6 +766,25 @@ void LiftDrag::Configure(const Entity &_entity,
                          const std::shared_ptr<const sdf::Element> &_sdf,
                          EntityComponentManager &_ecm, EventManager &)
 {
+  this->dataPtr->registry = registryFor(_ecm);
+
+  // Attached to the world, the system evaluates the surfaces of all the
+  // model-level instances together
+  if (nullptr != _ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->worldLevel = true;
+    if (this->dataPtr->registry->batched.exchange(true))
+    {
+      gzwarn << "LiftDrag is already attached to the world, ignoring "
+             << "this instance." << std::endl;
+      return;
+    }
+    this->dataPtr->batching = true;
+    gzdbg << "Evaluating lift and drag of all surfaces together."
+          << std::endl;
+    return;
+  }
+
   this->dataPtr->model = Model(_entity);
   if (!this->dataPtr->model.Valid(_ecm))
   {
@@ -546,6 +800,13 @@ void LiftDrag::PreUpdate(const UpdateInfo &_info, EntityComponentManager &_ecm)
 {
   GZ_PROFILE("LiftDrag::PreUpdate");
 
+  if (this->dataPtr->worldLevel)
+  {
+    if (this->dataPtr->batching && !_info.paused)
+      this->dataPtr->EvaluateBatch(_ecm);
+    return;
+  }
+
   // \TODO(anyone) Support rewind
   if (_info.dt < std::chrono::steady_clock::duration::zero())
   {
@@ -573,10 +834,15 @@ void LiftDrag::PreUpdate(const UpdateInfo &_info, EntityComponentManager &_ecm)
         _ecm.CreateComponent(this->dataPtr->controlJointEntity,
             components::JointPosition());
       }
+
+      std::lock_guard lock(this->dataPtr->registry->mutex);
+      this->dataPtr->registry->surfaces.push_back(
+          {this->dataPtr.get(), ++this->dataPtr->registry->version});
     }
   }
 
-  if (_info.paused)
+  // The world-level instance applies the wrench
+  if (_info.paused || this->dataPtr->registry->batched)
     return;
 
   // This is not an "else" because "initialized" can be set in the if block
@@ -66,6 +66,15 @@ namespace systems
   ///   for this lifting body (Optional)
   /// - `<cm_delta>`: How much Cm changes with a change in control
   ///   surface deflection angle
+  ///
+  /// ## World-level evaluation
+  ///
+  /// Attached to the world, without parameters, the system evaluates the
+  /// surfaces of all the model-level LiftDrag instances together: it looks
+  /// the wind up once, gathers the state of every surface and computes all
+  /// the wrenches in a single loop over contiguous arrays, which the
+  /// compiler can vectorize. The model-level instances then only load
+  /// their parameters. The forces are the same either way.
   class LiftDrag
       : public System,
         public ISystemConfigure,
@@ -0,0 +1,510 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_LIFT_DRAG_BATCH_HH_
+#define GZ_SIM_SYSTEMS_LIFT_DRAG_BATCH_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace lift_drag
+{
+/// \brief Parameters of a lifting surface, as loaded by the LiftDrag
+/// system.
+struct Surface
+{
+  /// \brief Coefficient of lift / alpha slope.
+  double cla{1.0};
+
+  /// \brief Coefficient of drag / alpha slope.
+  double cda{0.01};
+
+  /// \brief Coefficient of moment / alpha slope.
+  double cma{0.0};
+
+  /// \brief Angle of attack when the airfoil stalls.
+  double alphaStall{GZ_PI_2};
+
+  /// \brief Cl-alpha rate after stall.
+  double claStall{0.0};
+
+  /// \brief Cd-alpha rate after stall.
+  double cdaStall{1.0};
+
+  /// \brief Cm-alpha rate after stall.
+  double cmaStall{0.0};
+
+  /// \brief Change of Cm per radian of control surface deflection.
+  double cmDelta{0.0};
+
+  /// \brief Air density.
+  double rho{1.2041};
+
+  /// \brief If the upward direction is set by the inflow.
+  bool radialSymmetry{false};
+
+  /// \brief Planform area.
+  double area{1.0};
+
+  /// \brief Initial angle of attack.
+  double alpha0{0.0};
+
+  /// \brief Change of Cl per radian of control surface deflection.
+  double controlJointRadToCL{4.0};
+
+  /// \brief Center of pressure in the link frame.
+  math::Vector3d cp{math::Vector3d::Zero};
+
+  /// \brief Unit forward direction in the link frame.
+  math::Vector3d forward{math::Vector3d::UnitX};
+
+  /// \brief Unit upward direction in the link frame.
+  math::Vector3d upward{math::Vector3d::UnitZ};
+};
+
+/// \brief Lift, drag and moment of many surfaces, evaluated together.
+///
+/// The parameters and the state of the surfaces are stored in contiguous
+/// arrays, one per component, and Evaluate computes every wrench in a
+/// single loop over them. Branches of the scalar model, such as stall,
+/// are selects, so the loop has no early exits and the compiler can
+/// vectorize it. The results match LiftDrag's per-link evaluation.
+class LiftDragBatch
+{
+  /// \brief Get the number of surfaces.
+  /// \return Number of surfaces.
+  public: std::size_t Size() const
+  {
+    return this->cla.size();
+  }
+
+  /// \brief Add a surface at the end of the batch.
+  /// \param[in] _surface Parameters of the surface.
+  public: void Add(const Surface &_surface)
+  {
+    auto cp = _surface.cp;
+    cp.Correct();
+    this->cla.push_back(_surface.cla);
+    this->cda.push_back(_surface.cda);
+    this->cma.push_back(_surface.cma);
+    this->alphaStall.push_back(_surface.alphaStall);
+    this->claStall.push_back(_surface.claStall);
+    this->cdaStall.push_back(_surface.cdaStall);
+    this->cmaStall.push_back(_surface.cmaStall);
+    this->cmDelta.push_back(_surface.cmDelta);
+    this->halfRhoArea.push_back(0.5 * _surface.rho * _surface.area);
+    this->radial.push_back(_surface.radialSymmetry ? 1.0 : 0.0);
+    this->alpha0.push_back(_surface.alpha0);
+    this->clControl.push_back(_surface.controlJointRadToCL);
+    this->cp.push_back(cp);
+    this->forward.push_back(_surface.forward);
+    this->upward.push_back(_surface.upward);
+
+    this->cpWorld.Add();
+    this->forwardWorld.Add();
+    this->upwardWorld.Add();
+    this->velocity.Add();
+    this->control.push_back(0.0);
+    this->force.Add();
+    this->torque.Add();
+    this->valid.push_back(0);
+  }
+
+  /// \brief Remove a surface. The last surface takes its index.
+  /// \param[in] _index Index of the surface.
+  public: void Remove(std::size_t _index)
+  {
+    if (_index >= this->Size())
+      return;
+    swapRemove(this->cla, _index);
+    swapRemove(this->cda, _index);
+    swapRemove(this->cma, _index);
+    swapRemove(this->alphaStall, _index);
+    swapRemove(this->claStall, _index);
+    swapRemove(this->cdaStall, _index);
+    swapRemove(this->cmaStall, _index);
+    swapRemove(this->cmDelta, _index);
+    swapRemove(this->halfRhoArea, _index);
+    swapRemove(this->radial, _index);
+    swapRemove(this->alpha0, _index);
+    swapRemove(this->clControl, _index);
+    swapRemove(this->cp, _index);
+    swapRemove(this->forward, _index);
+    swapRemove(this->upward, _index);
+
+    this->cpWorld.Remove(_index);
+    this->forwardWorld.Remove(_index);
+    this->upwardWorld.Remove(_index);
+    this->velocity.Remove(_index);
+    swapRemove(this->control, _index);
+    this->force.Remove(_index);
+    this->torque.Remove(_index);
+    swapRemove(this->valid, _index);
+  }
+
+  /// \brief Set the state of a surface's link at this step.
+  /// \param[in] _index Index of the surface.
+  /// \param[in] _rotation World rotation of the link.
+  /// \param[in] _linearVelocity World linear velocity of the link.
+  /// \param[in] _angularVelocity World angular velocity of the link.
+  /// \param[in] _control Deflection of the control joint, 0 without one.
+  public: void SetState(std::size_t _index,
+              const math::Quaterniond &_rotation,
+              const math::Vector3d &_linearVelocity,
+              const math::Vector3d &_angularVelocity,
+              double _control = 0.0)
+  {
+    const auto cpI = _rotation.RotateVector(this->cp[_index]);
+    this->cpWorld.Set(_index, cpI);
+    this->forwardWorld.Set(_index,
+        _rotation.RotateVector(this->forward[_index]));
+    this->upwardWorld.Set(_index,
+        _rotation.RotateVector(this->upward[_index]));
+    this->velocity.Set(_index,
+        _linearVelocity + _angularVelocity.Cross(cpI));
+    this->control[_index] = _control;
+  }
+
+  /// \brief Evaluate the wrench of every surface.
+  /// \param[in] _wind World velocity of the air.
+  public: void Evaluate(const math::Vector3d &_wind)
+  {
+    const std::size_t count = this->Size();
+    const double *cpx = this->cpWorld.x.data();
+    const double *cpy = this->cpWorld.y.data();
+    const double *cpz = this->cpWorld.z.data();
+    const double *fwx = this->forwardWorld.x.data();
+    const double *fwy = this->forwardWorld.y.data();
+    const double *fwz = this->forwardWorld.z.data();
+    const double *upx = this->upwardWorld.x.data();
+    const double *upy = this->upwardWorld.y.data();
+    const double *upz = this->upwardWorld.z.data();
+    const double *vlx = this->velocity.x.data();
+    const double *vly = this->velocity.y.data();
+    const double *vlz = this->velocity.z.data();
+    double *fx = this->force.x.data();
+    double *fy = this->force.y.data();
+    double *fz = this->force.z.data();
+    double *tx = this->torque.x.data();
+    double *ty = this->torque.y.data();
+    double *tz = this->torque.z.data();
+    char *ok = this->valid.data();
+    const double wx = _wind.X();
+    const double wy = _wind.Y();
+    const double wz = _wind.Z();
+
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+      // Velocity of the air at the center of pressure
+      const double vx = vlx[i] - wx;
+      const double vy = vly[i] - wy;
+      const double vz = vlz[i] - wz;
+      const double speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+      const double inflow = fwx[i] * vx + fwy[i] * vy + fwz[i] * vz;
+      ok[i] = speed > 0.01 && inflow > 0.0;
+
+      const double invSpeed = 1.0 / speed;
+      const double vix = vx * invSpeed;
+      const double viy = vy * invSpeed;
+      const double viz = vz * invSpeed;
+
+      // Radially symmetric shapes lift towards the inflow
+      double ax = fwy[i] * viz - fwz[i] * viy;
+      double ay = fwz[i] * vix - fwx[i] * viz;
+      double az = fwx[i] * viy - fwy[i] * vix;
+      double rx = fwy[i] * az - fwz[i] * ay;
+      double ry = fwz[i] * ax - fwx[i] * az;
+      double rz = fwx[i] * ay - fwy[i] * ax;
+      normalize(rx, ry, rz);
+      const bool symmetric = this->radial[i] != 0.0;
+      const double ux = symmetric ? rx : upx[i];
+      const double uy = symmetric ? ry : upy[i];
+      const double uz = symmetric ? rz : upz[i];
+
+      // Normal to the lift-drag plane
+      double sx = fwy[i] * uz - fwz[i] * uy;
+      double sy = fwz[i] * ux - fwx[i] * uz;
+      double sz = fwx[i] * uy - fwy[i] * ux;
+      normalize(sx, sy, sz);
+
+      // The sweep scales the dynamic pressure by cos^2
+      const double sinSweep = std::clamp(sx * vix + sy * viy + sz * viz,
+          -1.0, 1.0);
+      const double cos2Sweep = 1.0 - sinSweep * sinSweep;
+
+      // Velocity in the lift-drag plane, with the directions of drag and
+      // lift
+      const double span = vx * sx + vy * sy + vz * sz;
+      const double px = vx - span * sx;
+      const double py = vy - span * sy;
+      const double pz = vz - span * sz;
+      double dx = -px;
+      double dy = -py;
+      double dz = -pz;
+      normalize(dx, dy, dz);
+      double lx = sy * pz - sz * py;
+      double ly = sz * px - sx * pz;
+      double lz = sx * py - sy * px;
+      normalize(lx, ly, lz);
+
+      // Angle of attack, within +/-90 deg
+      const double cosAlpha = std::clamp(lx * ux + ly * uy + lz * uz,
+          -1.0, 1.0);
+      const double angle = std::acos(cosAlpha);
+      double alpha = (lx * fwx[i] + ly * fwy[i] + lz * fwz[i]) >= 0.0 ?
+          this->alpha0[i] + angle : this->alpha0[i] - angle;
+      alpha = alpha > 0.5 * GZ_PI ? alpha - GZ_PI : alpha;
+      alpha = alpha < -0.5 * GZ_PI ? alpha + GZ_PI : alpha;
+      alpha = alpha > 0.5 * GZ_PI ? alpha - GZ_PI : alpha;
+
+      const double qa = this->halfRhoArea[i] *
+          (px * px + py * py + pz * pz);
+
+      // Coefficients, with stall
+      const double stall = this->alphaStall[i];
+      const bool above = alpha > stall;
+      const bool below = alpha < -stall;
+      const double sign = below ? -1.0 : 1.0;
+      const double past = above ? alpha - stall : alpha + stall;
+      const bool stalled = above || below;
+
+      double cl = stalled ?
+          (sign * this->cla[i] * stall + this->claStall[i] * past) :
+          this->cla[i] * alpha;
+      cl *= cos2Sweep;
+      cl = above ? std::max(0.0, cl) : cl;
+      cl = below ? std::min(0.0, cl) : cl;
+      cl += this->clControl[i] * this->control[i];
+
+      const double cd = std::fabs(cos2Sweep * (stalled ?
+          (sign * this->cda[i] * stall + this->cdaStall[i] * past) :
+          this->cda[i] * alpha));
+
+      double cm = stalled ?
+          (sign * this->cma[i] * stall + this->cmaStall[i] * past) :
+          this->cma[i] * alpha;
+      cm *= cos2Sweep;
+      cm = above ? std::max(0.0, cm) : cm;
+      cm = below ? std::min(0.0, cm) : cm;
+      cm += this->cmDelta[i] * this->control[i];
+
+      // Force and moment, without nan or inf, with the moment of the force
+      // about the center of mass
+      const double lift = cl * qa;
+      const double drag = cd * qa;
+      const double moment = cm * qa;
+      const double ox = finite(lift * lx + drag * dx);
+      const double oy = finite(lift * ly + drag * dy);
+      const double oz = finite(lift * lz + drag * dz);
+      fx[i] = ox;
+      fy[i] = oy;
+      fz[i] = oz;
+      tx[i] = finite(moment * sx) + cpy[i] * oz - cpz[i] * oy;
+      ty[i] = finite(moment * sy) + cpz[i] * ox - cpx[i] * oz;
+      tz[i] = finite(moment * sz) + cpx[i] * oy - cpy[i] * ox;
+    }
+  }
+
+  /// \brief Get the wrench of a surface, about its link's center of mass,
+  /// computed by the last Evaluate.
+  /// \param[in] _index Index of the surface.
+  /// \param[out] _force World force.
+  /// \param[out] _torque World torque.
+  /// \return False if the surface has no wrench, because the air is still
+  /// or flows from behind it.
+  public: bool Wrench(std::size_t _index, math::Vector3d &_force,
+              math::Vector3d &_torque) const
+  {
+    if (_index >= this->Size() || !this->valid[_index])
+      return false;
+    _force = this->force.Get(_index);
+    _torque = this->torque.Get(_index);
+    return true;
+  }
+
+  /// \brief Normalize a vector, leaving it as it is if its length is zero,
+  /// as math::Vector3d::Normalize does.
+  /// \param[in, out] _x X component.
+  /// \param[in, out] _y Y component.
+  /// \param[in, out] _z Z component.
+  private: static void normalize(double &_x, double &_y, double &_z)
+  {
+    const double length = std::sqrt(_x * _x + _y * _y + _z * _z);
+    const double scale = math::equal(length, 0.0) ? 1.0 : 1.0 / length;
+    _x *= scale;
+    _y *= scale;
+    _z *= scale;
+  }
+
+  /// \brief Replace nan and inf by 0, as math::Vector3d::Correct does.
+  /// \param[in] _value Value.
+  /// \return The value, or 0.
+  private: static double finite(double _value)
+  {
+    return std::isfinite(_value) ? _value : 0.0;
+  }
+
+  /// \brief Move the last element of an array to an index, and shrink it.
+  /// \param[in, out] _values The array.
+  /// \param[in] _index Index to overwrite.
+  private: template<typename T>
+  static void swapRemove(std::vector<T> &_values, std::size_t _index)
+  {
+    _values[_index] = _values.back();
+    _values.pop_back();
+  }
+
+  /// \brief World vectors of the surfaces, one array per component.
+  private: struct Vectors
+  {
+    /// \brief Add a zero vector.
+    void Add()
+    {
+      this->x.push_back(0.0);
+      this->y.push_back(0.0);
+      this->z.push_back(0.0);
+    }
+
+    /// \brief Remove a vector. The last vector takes its index.
+    /// \param[in] _index Index of the vector.
+    void Remove(std::size_t _index)
+    {
+      swapRemove(this->x, _index);
+      swapRemove(this->y, _index);
+      swapRemove(this->z, _index);
+    }
+
+    /// \brief Set a vector.
+    /// \param[in] _index Index of the vector.
+    /// \param[in] _value New value.
+    void Set(std::size_t _index, const math::Vector3d &_value)
+    {
+      this->x[_index] = _value.X();
+      this->y[_index] = _value.Y();
+      this->z[_index] = _value.Z();
+    }
+
+    /// \brief Get a vector.
+    /// \param[in] _index Index of the vector.
+    /// \return The vector.
+    math::Vector3d Get(std::size_t _index) const
+    {
+      return {this->x[_index], this->y[_index], this->z[_index]};
+    }
+
+    /// \brief X components.
+    std::vector<double> x;
+
+    /// \brief Y components.
+    std::vector<double> y;
+
+    /// \brief Z components.
+    std::vector<double> z;
+  };
+
+  /// \brief Lift slope of each surface.
+  private: std::vector<double> cla;
+
+  /// \brief Drag slope of each surface.
+  private: std::vector<double> cda;
+
+  /// \brief Moment slope of each surface.
+  private: std::vector<double> cma;
+
+  /// \brief Stall angle of each surface.
+  private: std::vector<double> alphaStall;
+
+  /// \brief Lift slope after stall of each surface.
+  private: std::vector<double> claStall;
+
+  /// \brief Drag slope after stall of each surface.
+  private: std::vector<double> cdaStall;
+
+  /// \brief Moment slope after stall of each surface.
+  private: std::vector<double> cmaStall;
+
+  /// \brief Moment per radian of control of each surface.
+  private: std::vector<double> cmDelta;
+
+  /// \brief Half the air density times the area of each surface.
+  private: std::vector<double> halfRhoArea;
+
+  /// \brief 1 for each radially symmetric surface.
+  private: std::vector<double> radial;
+
+  /// \brief Initial angle of attack of each surface.
+  private: std::vector<double> alpha0;
+
+  /// \brief Lift per radian of control of each surface.
+  private: std::vector<double> clControl;
+
+  /// \brief Center of pressure of each surface in its link frame.
+  private: std::vector<math::Vector3d> cp;
+
+  /// \brief Forward direction of each surface in its link frame.
+  private: std::vector<math::Vector3d> forward;
+
+  /// \brief Upward direction of each surface in its link frame.
+  private: std::vector<math::Vector3d> upward;
+
+  /// \brief World center of pressure of each surface, from the center of
+  /// mass.
+  private: Vectors cpWorld;
+
+  /// \brief World forward direction of each surface.
+  private: Vectors forwardWorld;
+
+  /// \brief World upward direction of each surface.
+  private: Vectors upwardWorld;
+
+  /// \brief World velocity of the center of pressure of each surface.
+  private: Vectors velocity;
+
+  /// \brief Control deflection of each surface.
+  private: std::vector<double> control;
+
+  /// \brief Force on each surface.
+  private: Vectors force;
+
+  /// \brief Torque on each surface.
+  private: Vectors torque;
+
+  /// \brief Whether each surface has a wrench.
+  private: std::vector<char> valid;
+};
+}
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+
+#include "LiftDragBatch.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::lift_drag;
+
+/////////////////////////////////////////////////
+/// \brief Wrench of a single surface, computed as the LiftDrag system does
+/// for each link.
+/// \param[in] _s Parameters of the surface.
+/// \param[in] _rot World rotation of the link.
+/// \param[in] _lin World linear velocity of the link.
+/// \param[in] _ang World angular velocity of the link.
+/// \param[in] _wind World velocity of the air.
+/// \param[in] _control Deflection of the control joint.
+/// \param[out] _force Force.
+/// \param[out] _torque Torque.
+/// \return False if the surface has no wrench.
+bool reference(const Surface &_s, const math::Quaterniond &_rot,
+    const math::Vector3d &_lin, const math::Vector3d &_ang,
+    const math::Vector3d &_wind, double _control,
+    math::Vector3d &_force, math::Vector3d &_torque)
+{
+  const auto cpWorld = _rot.RotateVector(_s.cp);
+  const auto vel = _lin + _ang.Cross(cpWorld) - _wind;
+  if (vel.Length() <= 0.01)
+    return false;
+  const auto velI = vel.Normalized();
+  const auto forwardI = _rot.RotateVector(_s.forward);
+  if (forwardI.Dot(vel) <= 0.0)
+    return false;
+
+  math::Vector3d upwardI;
+  if (_s.radialSymmetry)
+  {
+    math::Vector3d tmp = forwardI.Cross(velI);
+    upwardI = forwardI.Cross(tmp).Normalize();
+  }
+  else
+  {
+    upwardI = _rot.RotateVector(_s.upward);
+  }
+  const auto spanwiseI = forwardI.Cross(upwardI).Normalize();
+  const double sinSweepAngle = std::clamp(spanwiseI.Dot(velI), -1.0, 1.0);
+  const double cos2SweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
+  const auto velInLDPlane = vel - vel.Dot(spanwiseI) * spanwiseI;
+  const auto dragDirection = -velInLDPlane.Normalized();
+  const auto liftI = spanwiseI.Cross(velInLDPlane).Normalized();
+  const double cosAlpha = std::clamp(liftI.Dot(upwardI), -1.0, 1.0);
+  double alpha = _s.alpha0 - std::acos(cosAlpha);
+  if (liftI.Dot(forwardI) >= 0.0)
+    alpha = _s.alpha0 + std::acos(cosAlpha);
+  while (std::fabs(alpha) > 0.5 * GZ_PI)
+    alpha = alpha > 0 ? alpha - GZ_PI : alpha + GZ_PI;
+
+  const double speedInLDPlane = velInLDPlane.Length();
+  const double q = 0.5 * _s.rho * speedInLDPlane * speedInLDPlane;
+
+  double cl;
+  if (alpha > _s.alphaStall)
+  {
+    cl = std::max(0.0, (_s.cla * _s.alphaStall +
+        _s.claStall * (alpha - _s.alphaStall)) * cos2SweepAngle);
+  }
+  else if (alpha < -_s.alphaStall)
+  {
+    cl = std::min(0.0, (-_s.cla * _s.alphaStall +
+        _s.claStall * (alpha + _s.alphaStall)) * cos2SweepAngle);
+  }
+  else
+    cl = _s.cla * alpha * cos2SweepAngle;
+  cl += _s.controlJointRadToCL * _control;
+
+  double cd;
+  if (alpha > _s.alphaStall)
+  {
+    cd = (_s.cda * _s.alphaStall +
+        _s.cdaStall * (alpha - _s.alphaStall)) * cos2SweepAngle;
+  }
+  else if (alpha < -_s.alphaStall)
+  {
+    cd = (-_s.cda * _s.alphaStall +
+        _s.cdaStall * (alpha + _s.alphaStall)) * cos2SweepAngle;
+  }
+  else
+    cd = _s.cda * alpha * cos2SweepAngle;
+  cd = std::fabs(cd);
+
+  double cm;
+  if (alpha > _s.alphaStall)
+  {
+    cm = std::max(0.0, (_s.cma * _s.alphaStall +
+        _s.cmaStall * (alpha - _s.alphaStall)) * cos2SweepAngle);
+  }
+  else if (alpha < -_s.alphaStall)
+  {
+    cm = std::min(0.0, (-_s.cma * _s.alphaStall +
+        _s.cmaStall * (alpha + _s.alphaStall)) * cos2SweepAngle);
+  }
+  else
+    cm = _s.cma * alpha * cos2SweepAngle;
+  cm += _s.cmDelta * _control;
+
+  _force = cl * q * _s.area * liftI + cd * q * _s.area * dragDirection;
+  _torque = cm * q * _s.area * spanwiseI;
+  _force.Correct();
+  _torque.Correct();
+  _torque = _torque + cpWorld.Cross(_force);
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST(LiftDragBatch, Reference)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  auto vector = [&](double _scale)
+  {
+    return math::Vector3d(value(generator), value(generator),
+        value(generator)) * _scale;
+  };
+
+  std::vector<Surface> surfaces;
+  for (int i = 0; i < 40; ++i)
+  {
+    Surface s;
+    s.cla = 4.0 + value(generator);
+    s.cda = 0.3 + 0.1 * value(generator);
+    s.cma = 0.2 * value(generator);
+    s.alphaStall = 0.3 + 0.1 * value(generator);
+    s.claStall = -2.0 + value(generator);
+    s.cdaStall = 1.0 + 0.2 * value(generator);
+    s.cmaStall = 0.1 * value(generator);
+    s.cmDelta = 0.1 * value(generator);
+    s.area = 0.5 + 0.2 * value(generator);
+    s.alpha0 = 0.05 * value(generator);
+    s.radialSymmetry = i % 5 == 0;
+    s.cp = vector(0.5);
+    s.forward = math::Vector3d(1, 0.1 * value(generator), 0).Normalize();
+    s.upward = s.forward.Cross(math::Vector3d(0, 1, 0)).Normalize() * -1.0;
+    surfaces.push_back(s);
+  }
+
+  LiftDragBatch batch;
+  for (const auto &s : surfaces)
+    batch.Add(s);
+  ASSERT_EQ(surfaces.size(), batch.Size());
+
+  const math::Vector3d wind(1.0, -0.5, 0.2);
+  int evaluated{0};
+  for (int step = 0; step < 5; ++step)
+  {
+    std::vector<math::Quaterniond> rotations;
+    std::vector<math::Vector3d> linear;
+    std::vector<math::Vector3d> angular;
+    std::vector<double> controls;
+    for (std::size_t i = 0; i < surfaces.size(); ++i)
+    {
+      rotations.emplace_back(0.3 * value(generator), 0.3 * value(generator),
+          GZ_PI * value(generator));
+      linear.push_back(math::Vector3d(15, 0, 0) + vector(10.0));
+      angular.push_back(vector(2.0));
+      controls.push_back(i % 3 == 0 ? 0.0 : 0.2 * value(generator));
+      batch.SetState(i, rotations[i], linear[i], angular[i], controls[i]);
+    }
+    // Still air relative to one surface
+    linear[7] = wind;
+    angular[7] = math::Vector3d::Zero;
+    batch.SetState(7, rotations[7], linear[7], angular[7], controls[7]);
+
+    batch.Evaluate(wind);
+
+    for (std::size_t i = 0; i < surfaces.size(); ++i)
+    {
+      math::Vector3d expectedForce, expectedTorque, force, torque;
+      const bool expected = reference(surfaces[i], rotations[i], linear[i],
+          angular[i], wind, controls[i], expectedForce, expectedTorque);
+      ASSERT_EQ(expected, batch.Wrench(i, force, torque))
+          << "step " << step << ", surface " << i;
+      if (!expected)
+        continue;
+      ++evaluated;
+      for (std::size_t k = 0; k < 3u; ++k)
+      {
+        EXPECT_NEAR(expectedForce[k], force[k],
+            1e-9 * (1 + std::abs(expectedForce[k])));
+        EXPECT_NEAR(expectedTorque[k], torque[k],
+            1e-9 * (1 + std::abs(expectedTorque[k])));
+      }
+    }
+  }
+  EXPECT_GT(evaluated, 50);
+}
+
+/////////////////////////////////////////////////
+TEST(LiftDragBatch, Remove)
+{
+  Surface first;
+  Surface second;
+  second.cla = 2.0;
+  Surface third;
+  third.cla = 3.0;
+  third.cp = {0.1, 0.2, 0.0};
+
+  LiftDragBatch batch;
+  batch.Add(first);
+  batch.Add(second);
+  batch.Add(third);
+
+  // The last surface takes the index of the removed one
+  batch.Remove(0u);
+  ASSERT_EQ(2u, batch.Size());
+
+  const math::Quaterniond rotation(0.0, -0.1, 0.0);
+  const math::Vector3d linear(10, 0, 0);
+  const math::Vector3d angular(0, 0, 0.5);
+  batch.SetState(0u, rotation, linear, angular);
+  batch.SetState(1u, rotation, linear, angular);
+  batch.Evaluate(math::Vector3d::Zero);
+
+  math::Vector3d expectedForce, expectedTorque, force, torque;
+  ASSERT_TRUE(reference(third, rotation, linear, angular,
+      math::Vector3d::Zero, 0.0, expectedForce, expectedTorque));
+  ASSERT_TRUE(batch.Wrench(0u, force, torque));
+  for (std::size_t k = 0; k < 3u; ++k)
+  {
+    EXPECT_NEAR(expectedForce[k], force[k], 1e-9);
+    EXPECT_NEAR(expectedTorque[k], torque[k], 1e-9);
+  }
+
+  batch.Remove(5u);
+  EXPECT_EQ(2u, batch.Size());
+  EXPECT_FALSE(batch.Wrench(5u, force, torque));
+}
@@ -19,12 +19,23 @@
 
 #include <gz/msgs/log_playback_stats.pb.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <regex>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Filesystem.hh>
 #include <gz/common/Profiler.hh>
+#include <gz/common/Util.hh>
 #include <gz/fuel_tools/Zip.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/msgs/Utility.hh>
@@ -47,6 +58,11 @@
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/World.hh"
 
+#include "../../StateCompression.hh"
+#include "../../StateDeltaFilter.hh"
+#include "LogStreamer.hh"
+#include "ResourceStore.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -65,6 +81,10 @@ class gz::sim::systems::LogPlaybackPrivate
   /// \return True if any playback has been started successfully.
   public: bool Start(EntityComponentManager &_ecm);
 
+  /// \brief Link the resource files the log references by hash from the
+  /// shared store, if they aren't in the log directory.
+  public: void RestoreResources();
+
   /// \brief Replace URIs of resources in components with recorded path.
   public: void ReplaceResourceURIs(EntityComponentManager &_ecm);
 
@@ -79,18 +99,92 @@ class gz::sim::systems::LogPlaybackPrivate
   public: void Parse(EntityComponentManager &_ecm,
       const msgs::SerializedState &_msg);
 
-  /// \brief Updates the ECM according to the given message.
+  /// \brief Updates the ECM according to the given message. Components
+  /// that didn't change since they were last applied are removed from the
+  /// message first, unless skipping them is disabled.
   /// \param[in] _ecm Mutable ECM.
-  /// \param[in] _msg Message containing state updates.
+  /// \param[in,out] _msg Message containing state updates.
   public: void Parse(EntityComponentManager &_ecm,
-      const msgs::SerializedStateMap &_msg);
+      msgs::SerializedStateMap &_msg);
+
+  /// \brief Read the sim time of every keyframe in the log, if it has any.
+  public: void LoadKeyframeIndex();
+
+  /// \brief Find the latest keyframe at or before the given time.
+  /// \param[in] _time Sim time.
+  /// \return Sim time of the keyframe, or nullopt if there is none.
+  public: std::optional<std::chrono::steady_clock::duration> LatestKeyframe(
+      const std::chrono::steady_clock::duration &_time) const;
 
-  /// \brief A batch of data from log file, of all pose messages
-  public: transport::log::Batch batch;
+  /// \brief Set the ECM to the full state stored in a keyframe.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _keyframeTime Sim time of the keyframe.
+  /// \param[in] _time Sim time being sought, at or after the keyframe.
+  /// \param[in,out] _entitiesToRemove Entities to remove once the seek is
+  /// done, updated with the entities in the keyframe.
+  /// \return True if the keyframe was applied.
+  public: bool ApplyKeyframe(EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_keyframeTime,
+      const std::chrono::steady_clock::duration &_time,
+      std::set<Entity> &_entitiesToRemove);
+
+  /// \brief Find the latest cached state at or before the given time.
+  /// \param[in] _time Sim time.
+  /// \return Sim time of the state, or nullopt if there is none.
+  public: std::optional<std::chrono::steady_clock::duration>
+      LatestCachedState(const std::chrono::steady_clock::duration &_time)
+      const;
+
+  /// \brief Set the ECM to a cached full state.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _time Sim time of the state.
+  /// \param[in,out] _entitiesToRemove Entities to remove once the seek is
+  /// done, updated with the entities in the state.
+  /// \return True if the state was applied.
+  public: bool ApplyCachedState(EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_time,
+      std::set<Entity> &_entitiesToRemove);
+
+  /// \brief Cache the full state of the ECM, unless a state was cached
+  /// shortly before, and evict the least recently used states that don't
+  /// fit in memory.
+  /// \param[in] _ecm The ECM.
+  /// \param[in] _time Sim time of the state.
+  public: void CacheState(const EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_time);
+
+  /// \brief While seeking, update the list of entities to be removed so we
+  /// do not remove any entities that are to be created.
+  /// \param[in] _msg Message containing state updates.
+  /// \param[in,out] _entitiesToRemove Entities to be removed.
+  public: void UpdateEntitiesToRemove(const msgs::SerializedStateMap &_msg,
+      std::set<Entity> &_entitiesToRemove) const;
 
-  /// \brief Pointer to gz-transport Log
+  /// \brief Play back one recorded message.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _topic Topic of the message.
+  /// \param[in] _type Type of the message.
+  /// \param[in] _data Serialized message.
+  /// \param[in,out] _entitiesToRemove While seeking, entities to remove
+  /// once the seek is done. Null otherwise.
+  public: void Play(EntityComponentManager &_ecm, const std::string &_topic,
+      const std::string &_type, const std::string &_data,
+      std::set<Entity> *_entitiesToRemove);
+
+  /// \brief Pointer to gz-transport Log, used to read the initial state
+  /// and to seek
   public: std::unique_ptr<transport::log::Log> log;
 
+  /// \brief Reads the messages to play back on a background thread
+  public: std::unique_ptr<log_playback::LogStreamer> streamer;
+
+  /// \brief How far ahead of the playback time to read the log
+  public: std::chrono::steady_clock::duration prefetchWindow{
+      std::chrono::seconds(2)};
+
+  /// \brief Maximum size of the messages read ahead, in bytes
+  public: std::size_t prefetchMemory{64u * 1024u * 1024u};
+
   /// \brief Indicator of whether any playback instance has ever been started
   public: static bool started;
 
@@ -100,6 +194,17 @@ class gz::sim::systems::LogPlaybackPrivate
   /// \brief Directory to which compressed file is extracted to
   public: std::string extDest{""};
 
+  /// \brief Shared resource store, empty to use the one the log was
+  /// recorded with
+  public: std::string resourceStorePath;
+
+  /// \brief True to skip the recorded components that didn't change since
+  /// they were last applied
+  public: bool skipUnchanged{true};
+
+  /// \brief Removes unchanged components from the recorded states
+  public: StateDeltaFilter deltaFilter;
+
   /// \brief Indicator of whether this instance has been started
   public: bool instStarted{false};
 
@@ -115,6 +220,46 @@ class gz::sim::systems::LogPlaybackPrivate
 
   // \brief Saves which particle emitter emitting components have changed
   public: std::unordered_map<Entity, bool> prevParticleEmitterCmds;
+
+  /// \brief Topic holding the keyframes, empty if the log has none.
+  public: std::string keyframeTopic;
+
+  /// \brief Topic holding the sim time of each keyframe.
+  public: std::string keyframeIndexTopic;
+
+  /// \brief Sim time of every keyframe, sorted.
+  public: std::vector<std::chrono::steady_clock::duration> keyframeTimes;
+
+  /// \brief A full state reconstructed during playback
+  public: struct CachedState
+  {
+    /// \brief The state
+    msgs::SerializedStateMap msg;
+
+    /// \brief Serialized size of the state
+    std::size_t bytes{0u};
+
+    /// \brief Value of stateCacheUses when the state was last used
+    std::uint64_t lastUsed{0u};
+  };
+
+  /// \brief Full states around the times played back, by sim time, so
+  /// stepping back and short scrubs don't replay from a keyframe
+  public: std::map<std::chrono::steady_clock::duration, CachedState>
+      stateCache;
+
+  /// \brief Sim time between cached states, zero to disable the cache
+  public: std::chrono::steady_clock::duration stateCacheInterval{
+      std::chrono::milliseconds(200)};
+
+  /// \brief Maximum serialized size of the cached states
+  public: std::size_t stateCacheMemory{128u * 1024u * 1024u};
+
+  /// \brief Serialized size of the cached states
+  public: std::size_t stateCacheBytes{0u};
+
+  /// \brief Number of times states were cached or used
+  public: std::uint64_t stateCacheUses{0u};
 };
 
 bool LogPlaybackPrivate::started{false};
@@ -138,8 +283,10 @@ LogPlayback::~LogPlayback()
 
 //////////////////////////////////////////////////
 void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
-    const msgs::SerializedStateMap &_msg)
+    msgs::SerializedStateMap &_msg)
 {
+  if (this->skipUnchanged)
+    this->deltaFilter.Filter(_msg);
   _ecm.SetState(_msg);
 }
 
@@ -147,6 +294,8 @@ void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
 void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
     const msgs::SerializedState &_msg)
 {
+  // The filter doesn't know about this state
+  this->deltaFilter.Reset();
   _ecm.SetState(_msg);
 }
 
@@ -160,6 +309,45 @@ void LogPlayback::Configure(const Entity &,
 
   this->dataPtr->eventManager = &_eventMgr;
 
+  // Bounds of the part of the log read ahead of playback
+  const double prefetchWindow =
+      _sdf->Get<double>("prefetch_window", 2.0).first;
+  if (prefetchWindow > 0)
+  {
+    this->dataPtr->prefetchWindow =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(prefetchWindow));
+  }
+  const double prefetchMemory =
+      _sdf->Get<double>("prefetch_memory", 64.0).first;
+  if (prefetchMemory > 0)
+  {
+    this->dataPtr->prefetchMemory =
+        static_cast<std::size_t>(prefetchMemory * 1024.0 * 1024.0);
+  }
+
+  // Full states kept for scrubbing
+  const double scrubInterval =
+      _sdf->Get<double>("scrub_cache_interval", 0.2).first;
+  this->dataPtr->stateCacheInterval =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(std::max(0.0, scrubInterval)));
+  const double scrubMemory =
+      _sdf->Get<double>("scrub_cache_memory", 128.0).first;
+  this->dataPtr->stateCacheMemory =
+      static_cast<std::size_t>(std::max(0.0, scrubMemory) * 1024.0 * 1024.0);
+
+  this->dataPtr->skipUnchanged =
+      _sdf->Get<bool>("skip_unchanged", true).first;
+
+  this->dataPtr->resourceStorePath =
+      _sdf->Get<std::string>("resource_store", "").first;
+  if (this->dataPtr->resourceStorePath.empty())
+  {
+    common::env("GZ_SIM_LOG_RESOURCE_STORE",
+        this->dataPtr->resourceStorePath);
+  }
+
   // Prepend working directory if path is relative
   this->dataPtr->logPath = common::absPath(this->dataPtr->logPath);
 
@@ -223,6 +411,8 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
     return false;
   }
 
+  this->RestoreResources();
+
   // Call Log.hh directly to load a .tlog file
   this->log = std::make_unique<transport::log::Log>();
   if (!this->log->Open(dbPath))
@@ -230,31 +420,36 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
     gzerr << "Failed to open log file [" << dbPath << "]" << std::endl;
   }
 
-  // Access all messages in .tlog file
-  this->batch = this->log->QueryMessages();
-  auto iter = this->batch.begin();
+  // Look through the log until the initial state. The batch reads messages
+  // as it's iterated, and is released once done.
+  auto batch = this->log->QueryMessages();
+  auto iter = batch.begin();
 
-  if (iter == this->batch.end())
+  if (iter == batch.end())
   {
     gzerr << "No messages found in log file [" << dbPath << "]" << std::endl;
   }
 
   // Look for the first SerializedState message and use it to set the initial
   // state of the world. Messages received before this are ignored.
-  for (; iter != this->batch.end(); ++iter)
+  for (; iter != batch.end(); ++iter)
   {
     auto msgType = iter->Type();
+    auto msgData = iter->Data();
+    if (!uncompressMessage(msgType, msgData))
+      continue;
+
     if (msgType == "gz.msgs.SerializedState")
     {
       msgs::SerializedState msg;
-      msg.ParseFromString(iter->Data());
+      msg.ParseFromString(msgData);
       this->Parse(_ecm, msg);
       break;
     }
     else if (msgType == "gz.msgs.SerializedStateMap")
     {
       msgs::SerializedStateMap msg;
-      msg.ParseFromString(iter->Data());
+      msg.ParseFromString(msgData);
       this->Parse(_ecm, msg);
       break;
     }
@@ -289,12 +484,226 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
   }
 
   this->ReplaceResourceURIs(_ecm);
+  this->LoadKeyframeIndex();
+
+  // Stream the rest of the log, keeping only a window of it in memory
+  this->streamer = std::make_unique<log_playback::LogStreamer>(
+      this->prefetchWindow, this->prefetchMemory);
+  if (!this->streamer->Open(dbPath))
+    return false;
 
   this->instStarted = true;
   LogPlaybackPrivate::started = true;
   return true;
 }
 
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::LoadKeyframeIndex()
+{
+  GZ_PROFILE("LogPlaybackPrivate::LoadKeyframeIndex");
+  this->keyframeTimes.clear();
+
+  // The index only holds a timestamp per keyframe, so it's cheap to read
+  // in full. Logs recorded without keyframes don't have it.
+  const std::string indexSuffix{"/keyframe_index"};
+  auto indexBatch = this->log->QueryMessages(transport::log::TopicPattern(
+      std::regex(".*" + indexSuffix)));
+  for (const auto &msg : indexBatch)
+  {
+    this->keyframeIndexTopic = msg.Topic();
+    this->keyframeTimes.push_back(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        msg.TimeReceived()));
+  }
+
+  if (this->keyframeTimes.empty())
+    return;
+
+  this->keyframeTopic = this->keyframeIndexTopic.substr(0,
+      this->keyframeIndexTopic.size() - indexSuffix.size()) +
+      "/keyframe_state";
+  std::sort(this->keyframeTimes.begin(), this->keyframeTimes.end());
+  gzdbg << "Loaded index of [" << this->keyframeTimes.size()
+         << "] keyframes from topic [" << this->keyframeIndexTopic << "]."
+         << std::endl;
+}
+
+//////////////////////////////////////////////////
+std::optional<std::chrono::steady_clock::duration>
+    LogPlaybackPrivate::LatestKeyframe(
+    const std::chrono::steady_clock::duration &_time) const
+{
+  auto it = std::upper_bound(this->keyframeTimes.begin(),
+      this->keyframeTimes.end(), _time);
+  if (it == this->keyframeTimes.begin())
+    return std::nullopt;
+  return *std::prev(it);
+}
+
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::ApplyKeyframe(EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_keyframeTime,
+    const std::chrono::steady_clock::duration &_time,
+    std::set<Entity> &_entitiesToRemove)
+{
+  GZ_PROFILE("LogPlaybackPrivate::ApplyKeyframe");
+
+  // There are no other keyframes in this range, but take the last message
+  // anyway in case its bounds are inclusive
+  auto keyframeBatch = this->log->QueryMessages(transport::log::TopicName(
+      this->keyframeTopic, {_keyframeTime, _time}));
+  std::string data;
+  for (const auto &msg : keyframeBatch)
+  {
+    auto msgType = msg.Type();
+    auto msgData = msg.Data();
+    if (uncompressMessage(msgType, msgData) &&
+        msgType == "gz.msgs.SerializedStateMap")
+    {
+      data = std::move(msgData);
+    }
+  }
+
+  msgs::SerializedStateMap msg;
+  if (data.empty() || !msg.ParseFromString(data))
+  {
+    gzwarn << "Failed to load keyframe at ["
+           << std::chrono::duration<double>(_keyframeTime).count()
+           << "] s, replaying the log from the start." << std::endl;
+    return false;
+  }
+
+  this->UpdateEntitiesToRemove(msg, _entitiesToRemove);
+  this->Parse(_ecm, msg);
+  this->ReplaceResourceURIs(_ecm);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::optional<std::chrono::steady_clock::duration>
+    LogPlaybackPrivate::LatestCachedState(
+    const std::chrono::steady_clock::duration &_time) const
+{
+  auto it = this->stateCache.upper_bound(_time);
+  if (it == this->stateCache.begin())
+    return std::nullopt;
+  return std::prev(it)->first;
+}
+
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::ApplyCachedState(EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_time,
+    std::set<Entity> &_entitiesToRemove)
+{
+  GZ_PROFILE("LogPlaybackPrivate::ApplyCachedState");
+  auto it = this->stateCache.find(_time);
+  if (it == this->stateCache.end())
+    return false;
+
+  it->second.lastUsed = ++this->stateCacheUses;
+
+  // Parse filters the message, and the cached one has to stay complete
+  auto msg = it->second.msg;
+  this->UpdateEntitiesToRemove(msg, _entitiesToRemove);
+  this->Parse(_ecm, msg);
+  this->ReplaceResourceURIs(_ecm);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::CacheState(const EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_time)
+{
+  if (this->stateCacheInterval <= std::chrono::steady_clock::duration::zero()
+      || this->stateCacheMemory == 0u)
+  {
+    return;
+  }
+
+  const auto latest = this->LatestCachedState(_time);
+  if (latest && _time - *latest < this->stateCacheInterval)
+    return;
+
+  GZ_PROFILE("LogPlaybackPrivate::CacheState");
+  CachedState state;
+  _ecm.State(state.msg, {}, {}, true);
+  state.bytes = state.msg.ByteSizeLong();
+  state.lastUsed = ++this->stateCacheUses;
+  this->stateCacheBytes += state.bytes;
+  this->stateCache[_time] = std::move(state);
+
+  // The state that was just cached is the most recently used, so it's only
+  // evicted if it doesn't fit on its own
+  while (this->stateCacheBytes > this->stateCacheMemory &&
+      !this->stateCache.empty())
+  {
+    auto lru = std::min_element(this->stateCache.begin(),
+        this->stateCache.end(), [](const auto &_a, const auto &_b)
+        {
+          return _a.second.lastUsed < _b.second.lastUsed;
+        });
+    this->stateCacheBytes -= lru->second.bytes;
+    this->stateCache.erase(lru);
+  }
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::UpdateEntitiesToRemove(
+    const msgs::SerializedStateMap &_msg,
+    std::set<Entity> &_entitiesToRemove) const
+{
+  for (const auto &entIt : _msg.entities())
+  {
+    const auto &entityMsg = entIt.second;
+    Entity entity{entityMsg.id()};
+    if (entityMsg.remove())
+    {
+      _entitiesToRemove.insert(entity);
+    }
+    else
+    {
+      _entitiesToRemove.erase(entity);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::RestoreResources()
+{
+  const auto manifestPath = common::joinPaths(this->logPath,
+      log_resources::kManifestFileName);
+  std::string storePath;
+  std::map<std::string, std::string> hashes;
+  if (!log_resources::ResourceStore::ReadManifest(manifestPath, storePath,
+      hashes))
+  {
+    return;
+  }
+
+  if (!this->resourceStorePath.empty())
+    storePath = this->resourceStorePath;
+
+  // Only link the missing files, a log that was copied with its resources
+  // doesn't need the store
+  std::unique_ptr<log_resources::ResourceStore> store;
+  if (common::isDirectory(storePath))
+    store = std::make_unique<log_resources::ResourceStore>(storePath);
+  std::size_t missing{0u};
+  for (const auto &[file, hash] : hashes)
+  {
+    const auto path = common::joinPaths(this->logPath, file);
+    if (!common::exists(path) && (!store || !store->Checkout(hash, path)))
+      ++missing;
+  }
+
+  if (missing > 0u)
+  {
+    gzwarn << missing << " resource files of the log are missing from store ["
+           << storePath << "]. Set <resource_store> to the store they were "
+           << "recorded with." << std::endl;
+  }
+}
+
 //////////////////////////////////////////////////
 void LogPlaybackPrivate::ReplaceResourceURIs(EntityComponentManager &_ecm)
 {
@@ -453,6 +862,86 @@ bool LogPlaybackPrivate::ExtractStateAndResources()
   }
 }
 
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::Play(EntityComponentManager &_ecm,
+    const std::string &_topic, const std::string &_type,
+    const std::string &_data, std::set<Entity> *_entitiesToRemove)
+{
+  // Keyframes are only read when seeking
+  if (_topic == this->keyframeTopic || _topic == this->keyframeIndexTopic)
+    return;
+
+  // Recorded states may be compressed
+  if (_type == kCompressedStateType)
+  {
+    auto msgType = _type;
+    auto msgData = _data;
+    if (uncompressMessage(msgType, msgData))
+      this->Play(_ecm, _topic, msgType, msgData, _entitiesToRemove);
+    return;
+  }
+
+  auto msgType = _type;
+
+  // Support ignition.msgs for backwards compatibility. Remove on gz-sim9
+  std::string deprecatedPrefix{"ignition.msgs"};
+  auto pos = msgType.find(deprecatedPrefix);
+  if (pos != std::string::npos)
+  {
+    msgType.replace(pos, deprecatedPrefix.size(), "gz.msgs");
+  }
+
+  if (msgType == "gz.msgs.SerializedState")
+  {
+    msgs::SerializedState msg;
+    msg.ParseFromString(_data);
+
+    // For seeking back in time only:
+    // While stepping, update the list of entities to be removed
+    // so we do not remove any entities that are to be created
+    if (_entitiesToRemove)
+    {
+      for (const auto &entIt : msg.entities())
+      {
+        Entity entity{entIt.id()};
+        if (entIt.remove())
+        {
+          _entitiesToRemove->insert(entity);
+        }
+        else
+        {
+          _entitiesToRemove->erase(entity);
+        }
+      }
+    }
+
+    this->Parse(_ecm, msg);
+  }
+  else if (msgType == "gz.msgs.SerializedStateMap")
+  {
+    msgs::SerializedStateMap msg;
+    msg.ParseFromString(_data);
+
+    // For seeking back in time only:
+    // While stepping, update the list of entities to be removed
+    // so we do not remove any entities that are to be created
+    if (_entitiesToRemove)
+      this->UpdateEntitiesToRemove(msg, *_entitiesToRemove);
+
+    this->Parse(_ecm, msg);
+  }
+  else if (msgType == "gz.msgs.StringMsg")
+  {
+    // Do nothing, we assume this is the SDF string
+  }
+  else
+  {
+    gzwarn << "Trying to playback unsupported message type ["
+            << msgType << "]" << std::endl;
+  }
+  this->ReplaceResourceURIs(_ecm);
+}
+
 //////////////////////////////////////////////////
 void LogPlayback::Reset(const UpdateInfo &, EntityComponentManager &)
 {
@@ -474,114 +963,61 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
     return;
 
   // Get all messages from this timestep
-  // TODO(anyone) Jumping forward can be expensive for long jumps. For now,
-  // just playing every single step so we don't miss insertions and deletions.
   auto startTime = _info.simTime - _info.dt;
   auto endTime = _info.simTime;
 
+  // Each serialized state is a changed state and not an absolute state, so
+  // seeking has to play every single step from a known state so we don't
+  // miss insertions and deletions. That is the latest of the states cached
+  // during playback and the keyframes before the target time, or the start
+  // of the log if there are none. Jumping forward only plays every step
+  // since the last time if it doesn't skip a keyframe.
+  const auto keyframe = this->dataPtr->LatestKeyframe(endTime);
+  const auto cached = this->dataPtr->LatestCachedState(endTime);
   bool seekRewind = false;
   std::set<Entity> entitiesToRemove;
-  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  if (_info.dt < std::chrono::steady_clock::duration::zero() ||
+      (keyframe && *keyframe > startTime && *keyframe < endTime))
   {
-    // Detected jumping back in time. This can be expensive.
-    // To rewind / seek backward in time, we also need to play every single
-    // step from the beginning so we don't miss insertions and deletions
-    // This is because each serialized state is a changed state and not an
-    // absolute state.
-    // todo(anyone) Record absolute states during recording, i.e. key frames,
-    // so that playback can jump to these states without the need to
-    // incrementally build the states from the beginning
-
     // Create a list of entities to be removed. The list will be updated later
     // as the log steps forward below
     seekRewind = true;
+    this->dataPtr->deltaFilter.Reset();
     const auto &entities = _ecm.Entities().Vertices();
     for (const auto &entity : entities)
       entitiesToRemove.insert(Entity(entity.first));
 
     startTime = std::chrono::steady_clock::duration::zero();
-  }
-
-  this->dataPtr->batch = this->dataPtr->log->QueryMessages(
-      transport::log::AllTopics({startTime, endTime}));
-
-  auto iter = this->dataPtr->batch.begin();
-  while (iter != this->dataPtr->batch.end())
-  {
-    auto msgType = iter->Type();
-
-    // Support ignition.msgs for backwards compatibility. Remove on gz-sim9
-    std::string deprecatedPrefix{"ignition.msgs"};
-    auto pos = msgType.find(deprecatedPrefix);
-    if (pos != std::string::npos)
+    if (cached && (!keyframe || *cached >= *keyframe) &&
+        this->dataPtr->ApplyCachedState(_ecm, *cached, entitiesToRemove))
     {
-      msgType.replace(pos, deprecatedPrefix.size(), "gz.msgs");
+      startTime = *cached;
     }
-
-    if (msgType == "gz.msgs.SerializedState")
+    else if (keyframe && this->dataPtr->ApplyKeyframe(_ecm, *keyframe,
+        endTime, entitiesToRemove))
     {
-      msgs::SerializedState msg;
-      msg.ParseFromString(iter->Data());
-
-      // For seeking back in time only:
-      // While stepping, update the list of entities to be removed
-      // so we do not remove any entities that are to be created
-      if (seekRewind)
-      {
-        for (const auto &entIt : msg.entities())
-        {
-          Entity entity{entIt.id()};
-          if (entIt.remove())
-          {
-            entitiesToRemove.insert(entity);
-          }
-          else
-          {
-            entitiesToRemove.erase(entity);
-          }
-        }
-      }
-
-      this->dataPtr->Parse(_ecm, msg);
+      startTime = *keyframe;
     }
-    else if (msgType == "gz.msgs.SerializedStateMap")
-    {
-      msgs::SerializedStateMap msg;
-      msg.ParseFromString(iter->Data());
-
-      // For seeking back in time only:
-      // While stepping, update the list of entities to be removed
-      // so we do not remove any entities that are to be created
-      if (seekRewind)
-      {
-        for (const auto &entIt : msg.entities())
-        {
-          const auto &entityMsg = entIt.second;
-          Entity entity{entityMsg.id()};
-          if (entityMsg.remove())
-          {
-            entitiesToRemove.insert(entity);
-          }
-          else
-          {
-            entitiesToRemove.erase(entity);
-          }
-        }
-      }
+  }
 
-      this->dataPtr->Parse(_ecm, msg);
-    }
-    else if (msgType == "gz.msgs.StringMsg")
-    {
-      // Do nothing, we assume this is the SDF string
-    }
-    else
+  if (seekRewind)
+  {
+    // Seeks are rare, so query their range directly and continue streaming
+    // right after it
+    auto batch = this->dataPtr->log->QueryMessages(
+        transport::log::AllTopics({startTime, endTime}));
+    for (const auto &msg : batch)
     {
-      gzwarn << "Trying to playback unsupported message type ["
-              << msgType << "]" << std::endl;
+      this->dataPtr->Play(_ecm, msg.Topic(), msg.Type(), msg.Data(),
+          &entitiesToRemove);
     }
-    this->dataPtr->ReplaceResourceURIs(_ecm);
-    ++iter;
+    this->dataPtr->streamer->Seek(endTime);
+  }
+  else
+  {
+    log_playback::StreamedMessage msg;
+    while (this->dataPtr->streamer->Pop(endTime, msg))
+      this->dataPtr->Play(_ecm, msg.topic, msg.type, msg.data, nullptr);
   }
 
     // particle emitters
@@ -616,6 +1052,8 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
     _ecm.RequestRemoveEntity(entity);
   }
 
+  this->dataPtr->CacheState(_ecm, endTime);
+
   // pause playback if end of log is reached
   if (_info.simTime >= this->dataPtr->log->EndTime())
   {
@@ -18,13 +18,30 @@
 #include "LogRecord.hh"
 
 #include <sys/stat.h>
+#include <gz/msgs/param.pb.h>
+#include <gz/msgs/serialized_map.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
-
+#include <gz/msgs/time.pb.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <regex>
 #include <string>
 #include <fstream>
 #include <ctime>
 #include <set>
 #include <list>
+#include <map>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -34,6 +51,7 @@
 #include <gz/fuel_tools/Zip.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/transport/Clock.hh>
 #include <gz/transport/Node.hh>
 #include <gz/transport/log/Log.hh>
 #include <gz/transport/log/Recorder.hh>
@@ -48,22 +66,135 @@
 #include <sdf/Visual.hh>
 #include <sdf/World.hh>
 
+#include "gz/sim/components/Factory.hh"
 #include "gz/sim/components/Geometry.hh"
 #include "gz/sim/components/Light.hh"
 #include "gz/sim/components/Link.hh"
 #include "gz/sim/components/Material.hh"
 #include "gz/sim/components/Model.hh"
 #include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/SourceFilePath.hh"
 #include "gz/sim/components/Visual.hh"
 #include "gz/sim/components/World.hh"
 
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../StateCompression.hh"
+#include "ResourceStore.hh"
+
 using namespace gz;
 using namespace gz::sim;
 using namespace gz::sim::systems;
 
+namespace
+{
+/// \brief Clock that stamps the records published by the writer thread
+/// with the sim time they were queued at, and every other message with
+/// the current sim time. Messages published from this process are passed
+/// to the recorder on the publishing thread, so the thread tells them
+/// apart.
+class WriterClock : public transport::Clock
+{
+  /// \brief Constructor
+  /// \param[in] _clock Clock holding the current sim time.
+  public: explicit WriterClock(const transport::Clock *_clock)
+          : clock(_clock)
+  {
+  }
+
+  // Documentation inherited
+  public: std::chrono::nanoseconds Time() const override
+  {
+    if (std::this_thread::get_id() == this->writerId.load())
+      return std::chrono::nanoseconds(this->writeTime.load());
+    return this->clock->Time();
+  }
+
+  // Documentation inherited
+  public: bool IsReady() const override
+  {
+    return this->clock->IsReady();
+  }
+
+  /// \brief Set the thread that publishes the records.
+  /// \param[in] _id Id of the writer thread.
+  public: void SetWriter(const std::thread::id &_id)
+  {
+    this->writerId = _id;
+  }
+
+  /// \brief Set the sim time of the record being published.
+  /// \param[in] _time Sim time.
+  public: void SetWriteTime(const std::chrono::steady_clock::duration &_time)
+  {
+    this->writeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        _time).count();
+  }
+
+  /// \brief Clock holding the current sim time.
+  private: const transport::Clock *clock;
+
+  /// \brief Id of the writer thread.
+  private: std::atomic<std::thread::id> writerId;
+
+  /// \brief Sim time of the record being published, in nanoseconds.
+  private: std::atomic<std::int64_t> writeTime{0};
+};
+
+
+//////////////////////////////////////////////////
+/// \brief Get the scoped names of an entity and its ancestors below the
+/// world, outermost first, such as "model" and "model::link" for a link.
+/// \param[in] _entity The entity.
+/// \param[in] _ecm Entity component manager.
+/// \return The scoped names, empty for the world.
+std::vector<std::string> entityScopes(Entity _entity,
+    const EntityComponentManager &_ecm)
+{
+  std::vector<std::string> names;
+  for (auto entity = _entity; entity != kNullEntity;)
+  {
+    auto nameComp = _ecm.Component<components::Name>(entity);
+    if (nullptr == nameComp || _ecm.Component<components::World>(entity))
+      break;
+    names.push_back(nameComp->Data());
+
+    auto parentComp = _ecm.Component<components::ParentEntity>(entity);
+    entity = parentComp ? parentComp->Data() : kNullEntity;
+  }
+
+  std::vector<std::string> scopes;
+  std::string scope;
+  for (auto it = names.rbegin(); it != names.rend(); ++it)
+  {
+    scope += scope.empty() ? *it : "::" + *it;
+    scopes.push_back(scope);
+  }
+  return scopes;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether any of the scoped names matches any pattern.
+/// \param[in] _scopes Scoped names.
+/// \param[in] _patterns Regular expressions.
+/// \return True if there's a match.
+bool matchesAny(const std::vector<std::string> &_scopes,
+    const std::vector<std::regex> &_patterns)
+{
+  for (const auto &scope : _scopes)
+  {
+    for (const auto &pattern : _patterns)
+    {
+      if (std::regex_match(scope, pattern))
+        return true;
+    }
+  }
+  return false;
+}
+}
+
 // Private data class.
 class gz::sim::systems::LogRecordPrivate
 {
@@ -101,9 +232,72 @@ class gz::sim::systems::LogRecordPrivate
   /// there are errors saving the models.
   public: bool SaveModels(const std::set<std::string> &_models);
 
+  /// \brief Add resource files linked from the store to the manifest of
+  /// the log, and write it.
+  /// \param[in] _hashes Hash of each file, by its absolute path.
+  public: void SaveResourceManifest(
+              const std::map<std::string, std::string> &_hashes);
+
   /// \brief Compress model resource files and state file into one file.
   public: void CompressStateAndResources();
 
+  /// \brief Queue a record for the writer thread.
+  /// \param[in] _pub Publisher to write it with.
+  /// \param[in] _msg The message.
+  /// \param[in] _simTime Sim time to stamp it with.
+  /// \param[in] _compress True to compress the message.
+  /// \param[in] _force True to queue it even if the queue is full.
+  /// \return False if the record was dropped because the queue is full.
+  public: bool QueueRecord(transport::Node::Publisher &_pub,
+      std::unique_ptr<google::protobuf::Message> _msg,
+      const std::chrono::steady_clock::duration &_simTime, bool _compress,
+      bool _force);
+
+  /// \brief Start the thread that writes the queued records.
+  public: void StartWriteThread();
+
+  /// \brief Write the queued records and stop the writer thread.
+  public: void StopWriteThread();
+
+  /// \brief Serialize, compress and publish the queued records until
+  /// stopped.
+  public: void WriteLoop();
+
+  /// \brief Whether entities are filtered.
+  /// \return True if only some of the entities are recorded.
+  public: bool FilterEntities() const;
+
+  /// \brief Whether component types are filtered.
+  /// \return True if only some of the component types are recorded.
+  public: bool FilterComponents() const;
+
+  /// \brief Update the entities and component types to record, after
+  /// entities or components were added or removed.
+  /// \param[in] _ecm Entity component manager.
+  public: void UpdateFilters(const EntityComponentManager &_ecm);
+
+  /// \brief Stop recording the entities being removed. This is called after
+  /// their removal was recorded.
+  /// \param[in] _ecm Entity component manager.
+  public: void PruneRemovedEntities(const EntityComponentManager &_ecm);
+
+  /// \brief Check whether an entity should be recorded.
+  /// \param[in] _entity The entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \return True if the entity passes the entity filters.
+  public: bool RecordEntity(Entity _entity,
+      const EntityComponentManager &_ecm) const;
+
+  /// \brief Check whether a component type should be recorded.
+  /// \param[in] _typeName Name of the component type.
+  /// \return True if the type passes the component filters.
+  public: bool RecordComponent(const std::string &_typeName) const;
+
+  /// \brief Publish the writer statistics, at most once per second.
+  /// \param[in] _force True to publish even if the last statistics were
+  /// published less than a second ago.
+  public: void PublishStatus(bool _force);
+
   /// \brief Indicator of whether any recorder instance has ever been started.
   /// Currently, only one instance is allowed. This enforcement may be removed
   /// in the future.
@@ -128,6 +322,10 @@ class gz::sim::systems::LogRecordPrivate
   /// header should be the most accurate.
   public: std::unique_ptr<transport::NetworkClock> clock;
 
+  /// \brief Clock used by the recorder, which stamps the queued records
+  /// with the sim time they were queued at.
+  public: std::unique_ptr<WriterClock> writerClock;
+
   /// \brief Name of this world
   public: std::string worldName{""};
 
@@ -143,6 +341,13 @@ class gz::sim::systems::LogRecordPrivate
   /// \brief Publisher for state changes
   public: transport::Node::Publisher statePub;
 
+  /// \brief Publisher for keyframes, which hold the full state
+  public: transport::Node::Publisher keyframePub;
+
+  /// \brief Publisher for the sim time of each keyframe. Playback reads
+  /// this small topic to index the keyframes without loading them.
+  public: transport::Node::Publisher keyframeIndexPub;
+
   /// \brief Message holding SDF string of world
   public: msgs::StringMsg sdfMsg;
 
@@ -158,11 +363,120 @@ class gz::sim::systems::LogRecordPrivate
   /// \brief List of saved models if record with resources is enabled.
   public: std::set<std::string> savedModels;
 
+  /// \brief Shared store the resources are linked from, null to copy them
+  /// into the log directory.
+  public: std::unique_ptr<log_resources::ResourceStore> resourceStore;
+
+  /// \brief Hash of each resource file linked from the store, by its path
+  /// relative to the log directory.
+  public: std::map<std::string, std::string> resourceHashes;
+
   /// \brief Time period between state recording
   public: std::chrono::steady_clock::duration recordPeriod{0};
 
   /// \brief Last time states are recorded
   public: std::chrono::steady_clock::duration lastRecordSimTime{0};
+
+  /// \brief Time period between keyframes, zero to disable them
+  public: std::chrono::steady_clock::duration keyframePeriod{
+      std::chrono::seconds(10)};
+
+  /// \brief Last time a keyframe was recorded. The initial state holds
+  /// every entity, so it counts as the first keyframe.
+  public: std::chrono::steady_clock::duration lastKeyframeSimTime{0};
+
+  /// \brief Patterns of the scoped names of the entities to record. An
+  /// entity matches if its name or the name of one of its ancestors does.
+  /// Empty to record all the entities.
+  public: std::vector<std::regex> includeEntities;
+
+  /// \brief Patterns of the scoped names of the entities not to record
+  public: std::vector<std::regex> excludeEntities;
+
+  /// \brief Names of the component types to record, empty for all
+  public: std::set<std::string> includeComponents;
+
+  /// \brief Names of the component types not to record
+  public: std::set<std::string> excludeComponents;
+
+  /// \brief Entities that pass the entity filters
+  public: std::unordered_set<Entity> recordedEntities;
+
+  /// \brief Component types that pass the component filters
+  public: std::unordered_set<ComponentTypeId> recordedTypes;
+
+  /// \brief Number of registered component types when recordedTypes was
+  /// last updated
+  public: std::size_t registeredTypeCount{0u};
+
+  /// \brief True once the filters were first updated
+  public: bool filtersInitialized{false};
+
+  /// \brief A record waiting to be written
+  public: struct Record
+  {
+    /// \brief Publisher to write it with
+    transport::Node::Publisher *pub{nullptr};
+
+    /// \brief The message
+    std::unique_ptr<google::protobuf::Message> msg;
+
+    /// \brief Sim time to stamp it with
+    std::chrono::steady_clock::duration simTime{0};
+
+    /// \brief True to compress the message
+    bool compress{false};
+  };
+
+  /// \brief Records waiting to be written, oldest first
+  public: std::deque<Record> recordQueue;
+
+  /// \brief Maximum number of records waiting to be written
+  public: std::size_t maxQueuedRecords{256u};
+
+  /// \brief True to drop the records that arrive while the queue is full,
+  /// false to wait for the writer thread instead.
+  public: bool dropRecords{false};
+
+  /// \brief True to record the complete state on the next update, because
+  /// the changes of a previous update were dropped.
+  public: bool recordFullState{false};
+
+  /// \brief True to compress the recorded states with zlib
+  public: bool compressStates{false};
+
+  /// \brief Zlib compression level, -1 for the default
+  public: int compressionLevel{-1};
+
+  /// \brief Number of records written
+  public: uint64_t writtenRecords{0u};
+
+  /// \brief Number of records dropped because the queue was full
+  public: uint64_t droppedRecords{0u};
+
+  /// \brief Size of the written states before compression, in bytes
+  public: uint64_t stateBytes{0u};
+
+  /// \brief Size of the written states, in bytes
+  public: uint64_t writtenStateBytes{0u};
+
+  /// \brief True to stop the writer thread once the queue is empty
+  public: bool stopWriteThread{false};
+
+  /// \brief Protects the queue and the statistics
+  public: std::mutex queueMutex;
+
+  /// \brief Notified when records are queued or written
+  public: std::condition_variable queueCv;
+
+  /// \brief Thread that writes the queued records
+  public: std::thread writeThread;
+
+  /// \brief Publisher of the writer statistics
+  public: transport::Node::Publisher statusPub;
+
+  /// \brief Last time the statistics were published
+  public: std::chrono::steady_clock::time_point lastStatusTime;
 };
 
 bool LogRecordPrivate::started{false};
@@ -191,6 +505,9 @@ LogRecord::~LogRecord()
 {
   if (this->dataPtr->instStarted)
   {
+    // Write the queued records before closing the log
+    this->dataPtr->StopWriteThread();
+
     // Use gz-transport directly
     this->dataPtr->recorder.Stop();
 
@@ -220,6 +537,76 @@ void LogRecord::Configure(const Entity &_entity,
     std::chrono::duration<double>(
     _sdf->Get<double>("record_period", 0.0).first));
 
+  this->dataPtr->keyframePeriod =
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    std::chrono::duration<double>(
+    _sdf->Get<double>("keyframe_period", 10.0).first));
+
+  this->dataPtr->maxQueuedRecords = std::max(1, _sdf->Get<int>(
+      "max_queued_records", 256).first);
+  this->dataPtr->dropRecords = _sdf->Get<bool>("drop_records", false).first;
+
+  auto compression = _sdf->Get<std::string>("state_compression",
+      "none").first;
+  if (compression == "zlib")
+  {
+    this->dataPtr->compressStates = true;
+  }
+  else if (compression != "none")
+  {
+    gzerr << "Unknown <state_compression> [" << compression
+          << "], expected [none] or [zlib]. States won't be compressed."
+          << std::endl;
+  }
+  this->dataPtr->compressionLevel = std::clamp(_sdf->Get<int>(
+      "compression_level", -1).first, -1, 9);
+
+  // Entities are matched by their scoped name below the world, such as
+  // "model::link", and component types by their registered name, with or
+  // without the "gz_sim_components." prefix
+  auto addPatterns = [&_sdf](const std::string &_tag,
+      std::vector<std::regex> &_patterns)
+  {
+    for (auto elem = _sdf->FindElement(_tag); elem;
+         elem = elem->GetNextElement(_tag))
+    {
+      auto pattern = elem->Get<std::string>();
+      try
+      {
+        _patterns.emplace_back(pattern);
+      }
+      catch (const std::regex_error &_e)
+      {
+        gzerr << "Invalid <" << _tag << "> pattern [" << pattern << "]: "
+              << _e.what() << std::endl;
+      }
+    }
+  };
+  addPatterns("include_entity", this->dataPtr->includeEntities);
+  addPatterns("exclude_entity", this->dataPtr->excludeEntities);
+
+  auto addNames = [&_sdf](const std::string &_tag,
+      std::set<std::string> &_names)
+  {
+    for (auto elem = _sdf->FindElement(_tag); elem;
+         elem = elem->GetNextElement(_tag))
+    {
+      _names.insert(elem->Get<std::string>());
+    }
+  };
+  addNames("include_component", this->dataPtr->includeComponents);
+  addNames("exclude_component", this->dataPtr->excludeComponents);
+
+  // Resources can be shared by many logs through a content addressed store
+  auto storePath = _sdf->Get<std::string>("resource_store", "").first;
+  if (storePath.empty())
+    common::env("GZ_SIM_LOG_RESOURCE_STORE", storePath);
+  if (!storePath.empty())
+  {
+    this->dataPtr->resourceStore =
+        std::make_unique<log_resources::ResourceStore>(storePath);
+  }
+
   this->dataPtr->compress = _sdf->Get<bool>("compress", false).first;
   this->dataPtr->cmpPath = _sdf->Get<std::string>("compress_path", "").first;
 
@@ -284,6 +671,11 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   if (this->recordResources)
   {
     gzmsg << "Resources will be recorded\n";
+    if (this->resourceStore)
+    {
+      gzmsg << "Resources will be linked from store ["
+            << this->resourceStore->Root() << "]\n";
+    }
   }
 
   // Create log directory
@@ -306,13 +698,17 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
            << sdfTopic << "]." << std::endl;
   }
 
+  // Compressed states keep their type inside the compressed message
+  const std::string stateType = this->compressStates ?
+      std::string(kCompressedStateType) :
+      msgs::SerializedStateMap().GetTypeName();
+
   // TODO(louise) Combine with SceneBroadcaster's state topic
   std::string stateTopic = "/world/" + this->worldName + "/changed_state";
   auto validStateTopic = transport::TopicUtils::AsValidTopic(stateTopic);
   if (!validStateTopic.empty())
   {
-    this->statePub = this->node.Advertise<msgs::SerializedStateMap>(
-        validStateTopic);
+    this->statePub = this->node.Advertise(validStateTopic, stateType);
   }
   else
   {
@@ -320,6 +716,30 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
            << stateTopic << "]." << std::endl;
   }
 
+  // Keyframes let playback seek without replaying the log from the start
+  std::string keyframeTopic = "/world/" + this->worldName + "/keyframe_state";
+  std::string keyframeIndexTopic =
+      "/world/" + this->worldName + "/keyframe_index";
+  auto validKeyframeTopic = transport::TopicUtils::AsValidTopic(keyframeTopic);
+  auto validKeyframeIndexTopic =
+      transport::TopicUtils::AsValidTopic(keyframeIndexTopic);
+  if (this->keyframePeriod > std::chrono::steady_clock::duration::zero())
+  {
+    if (!validKeyframeTopic.empty() && !validKeyframeIndexTopic.empty())
+    {
+      this->keyframePub = this->node.Advertise(validKeyframeTopic,
+          stateType);
+      this->keyframeIndexPub = this->node.Advertise<msgs::Time>(
+          validKeyframeIndexTopic);
+    }
+    else
+    {
+      gzerr << "Failed to generate valid topics to publish keyframes. Tried ["
+             << keyframeTopic << "] and [" << keyframeIndexTopic << "]."
+             << std::endl;
+    }
+  }
+
   // Append file name
   std::string dbPath = common::joinPaths(this->logPath, "state.tlog");
   if (common::exists(dbPath))
@@ -335,6 +755,22 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   this->recorder.AddTopic(sdfTopic);
   this->recorder.AddTopic(stateTopic);
 
+  // Only published with ServerConfig::SetStateHashing, to compare runs
+  const auto stateHashTopic = transport::TopicUtils::AsValidTopic(
+      "/world/" + this->worldName + "/state_hash");
+  if (!stateHashTopic.empty())
+  {
+    gzdbg << "Recording default topic[" << stateHashTopic << "].\n";
+    this->recorder.AddTopic(stateHashTopic);
+  }
+  if (this->keyframePub)
+  {
+    gzdbg << "Recording default topic[" << keyframeTopic << "].\n";
+    gzdbg << "Recording default topic[" << keyframeIndexTopic << "].\n";
+    this->recorder.AddTopic(keyframeTopic);
+    this->recorder.AddTopic(keyframeIndexTopic);
+  }
+
   // Get the topics to record, if any.
   if (this->sdf->HasElement("record_topic"))
   {
@@ -365,13 +801,20 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   auto clockTopic = "/world/" + this->worldName + "/log/clock";
   this->clock = std::make_unique<transport::NetworkClock>(clockTopic,
       transport::NetworkClock::TimeBase::SIM);
-  this->recorder.Sync(this->clock.get());
+  this->writerClock = std::make_unique<WriterClock>(this->clock.get());
+  this->recorder.Sync(this->writerClock.get());
+
+  auto statusTopic = transport::TopicUtils::AsValidTopic(
+      "/world/" + this->worldName + "/log/status");
+  if (!statusTopic.empty())
+    this->statusPub = this->node.Advertise<msgs::Param>(statusTopic);
 
   // This calls Log::Open() and loads sql schema
   if (this->recorder.Start(dbPath) ==
       transport::log::RecorderError::SUCCESS)
   {
     this->instStarted = true;
+    this->StartWriteThread();
     return true;
   }
   else
@@ -592,9 +1035,13 @@ bool LogRecordPrivate::SaveModels(const std::set<std::string> &_models)
         }
       }
 
-      // Copy entire model directory
+      // Copy entire model directory, or link it from the store
+      std::map<std::string, std::string> hashes;
       if (!common::createDirectories(destPath) ||
-          !common::copyDirectory(srcPath, destPath))
+          (this->resourceStore &&
+          !this->resourceStore->AddDirectory(srcPath, destPath, hashes)) ||
+          (!this->resourceStore &&
+          !common::copyDirectory(srcPath, destPath)))
       {
         gzerr << "Failed to copy model directory from [" << srcPath
                << "] to [" << destPath << "]" << std::endl;
@@ -602,10 +1049,18 @@ bool LogRecordPrivate::SaveModels(const std::set<std::string> &_models)
       }
       else
       {
-        // Overwrite model SDF with newly generated SDF with relative paths
+        // Overwrite model SDF with newly generated SDF with relative paths.
+        // A linked file is removed first, so the stored file isn't changed.
+        common::removeFile(destModelPath);
         std::ofstream ofs(destModelPath);
         ofs << root.Element()->ToString("").c_str();
         ofs.close();
+
+        if (this->resourceStore)
+        {
+          hashes[destModelPath] = this->resourceStore->Add(destModelPath);
+          this->SaveResourceManifest(hashes);
+        }
       }
     }
     else
@@ -618,6 +1073,34 @@ bool LogRecordPrivate::SaveModels(const std::set<std::string> &_models)
   return !saveError;
 }
 
+//////////////////////////////////////////////////
+void LogRecordPrivate::SaveResourceManifest(
+    const std::map<std::string, std::string> &_hashes)
+{
+  for (const auto &[file, hash] : _hashes)
+  {
+    if (hash.empty() ||
+        file.compare(0, this->logPath.length(), this->logPath) != 0)
+    {
+      continue;
+    }
+
+    auto rel = file.substr(this->logPath.length());
+    while (!rel.empty() && rel[0] == '/')
+      rel = rel.substr(1);
+    this->resourceHashes[rel] = hash;
+  }
+
+  const auto manifestPath = common::joinPaths(this->logPath,
+      log_resources::kManifestFileName);
+  if (!log_resources::ResourceStore::WriteManifest(manifestPath,
+      this->resourceStore->Root(), this->resourceHashes))
+  {
+    gzerr << "Failed to write resource manifest [" << manifestPath << "]."
+          << std::endl;
+  }
+}
+
 //////////////////////////////////////////////////
 void LogRecordPrivate::CompressStateAndResources()
 {
@@ -627,6 +1110,17 @@ void LogRecordPrivate::CompressStateAndResources()
     common::removeFile(this->cmpPath);
   }
 
+  // Files linked from the store are left out, the manifest is enough to
+  // restore them on playback
+  if (this->resourceStore)
+  {
+    for (const auto &hashIt : this->resourceHashes)
+    {
+      if (this->resourceStore->Has(hashIt.second))
+        common::removeFile(common::joinPaths(this->logPath, hashIt.first));
+    }
+  }
+
   // Compress directory
   if (fuel_tools::Zip::Compress(this->logPath, this->cmpPath))
   {
@@ -644,6 +1138,259 @@ void LogRecordPrivate::CompressStateAndResources()
   }
 }
 
+//////////////////////////////////////////////////
+bool LogRecordPrivate::QueueRecord(transport::Node::Publisher &_pub,
+    std::unique_ptr<google::protobuf::Message> _msg,
+    const std::chrono::steady_clock::duration &_simTime, bool _compress,
+    bool _force)
+{
+  {
+    std::unique_lock<std::mutex> lock(this->queueMutex);
+    if (!_force && this->recordQueue.size() >= this->maxQueuedRecords)
+    {
+      if (this->dropRecords)
+      {
+        ++this->droppedRecords;
+        return false;
+      }
+
+      GZ_PROFILE("Wait for writer");
+      this->queueCv.wait(lock, [this]
+      {
+        return this->recordQueue.size() < this->maxQueuedRecords;
+      });
+    }
+
+    Record record;
+    record.pub = &_pub;
+    record.msg = std::move(_msg);
+    record.simTime = _simTime;
+    record.compress = _compress;
+    this->recordQueue.push_back(std::move(record));
+  }
+  this->queueCv.notify_all();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::StartWriteThread()
+{
+  this->StopWriteThread();
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stopWriteThread = false;
+  }
+  this->writeThread = std::thread(&LogRecordPrivate::WriteLoop, this);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::StopWriteThread()
+{
+  if (!this->writeThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stopWriteThread = true;
+  }
+  this->queueCv.notify_all();
+  this->writeThread.join();
+  this->PublishStatus(true);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::WriteLoop()
+{
+  GZ_PROFILE_THREAD_NAME("LogRecord");
+  this->writerClock->SetWriter(std::this_thread::get_id());
+  while (true)
+  {
+    Record record;
+    {
+      std::unique_lock<std::mutex> lock(this->queueMutex);
+      this->queueCv.wait(lock, [this]
+      {
+        return this->stopWriteThread || !this->recordQueue.empty();
+      });
+
+      // Write all queued records before stopping
+      if (this->recordQueue.empty())
+        return;
+
+      record = std::move(this->recordQueue.front());
+      this->recordQueue.pop_front();
+    }
+    this->queueCv.notify_all();
+
+    GZ_PROFILE("LogRecordPrivate::WriteLoop");
+    std::string type = record.msg->GetTypeName();
+    std::string data;
+    if (!record.msg->SerializeToString(&data))
+    {
+      gzerr << "Failed to serialize message of type [" << type
+            << "], it won't be recorded." << std::endl;
+      continue;
+    }
+    const auto size = data.size();
+
+    if (record.compress)
+    {
+      std::string compressed;
+      if (!compressMessage(type, data, this->compressionLevel, compressed))
+        continue;
+      type = kCompressedStateType;
+      data = std::move(compressed);
+    }
+
+    // The recorder stamps the message while it's published
+    this->writerClock->SetWriteTime(record.simTime);
+    record.pub->PublishRaw(data, type);
+
+    {
+      std::lock_guard<std::mutex> lock(this->queueMutex);
+      ++this->writtenRecords;
+      if (record.msg->GetTypeName() == "gz.msgs.SerializedStateMap")
+      {
+        this->stateBytes += size;
+        this->writtenStateBytes += data.size();
+      }
+    }
+    this->PublishStatus(false);
+  }
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::FilterEntities() const
+{
+  return !this->includeEntities.empty() || !this->excludeEntities.empty();
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::FilterComponents() const
+{
+  return !this->includeComponents.empty() || !this->excludeComponents.empty();
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::RecordEntity(Entity _entity,
+    const EntityComponentManager &_ecm) const
+{
+  auto scopes = entityScopes(_entity, _ecm);
+  if (matchesAny(scopes, this->excludeEntities))
+    return false;
+  return this->includeEntities.empty() ||
+      matchesAny(scopes, this->includeEntities);
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::RecordComponent(const std::string &_typeName) const
+{
+  auto listed = [&_typeName](const std::set<std::string> &_names)
+  {
+    auto pos = _typeName.rfind('.');
+    return _names.count(_typeName) > 0 || (pos != std::string::npos &&
+        _names.count(_typeName.substr(pos + 1)) > 0);
+  };
+  return (this->includeComponents.empty() || listed(this->includeComponents))
+      && !listed(this->excludeComponents);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::PruneRemovedEntities(const EntityComponentManager &_ecm)
+{
+  if (!this->FilterEntities() || !_ecm.HasEntitiesMarkedForRemoval())
+    return;
+
+  _ecm.EachRemoved<components::Name>(
+      [&](const Entity &_entity, const components::Name *) -> bool
+      {
+        this->recordedEntities.erase(_entity);
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::UpdateFilters(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("LogRecordPrivate::UpdateFilters");
+  const bool initialized = this->filtersInitialized;
+  this->filtersInitialized = true;
+
+  if (this->FilterEntities())
+  {
+    auto classify = [&](const Entity &_entity,
+        const components::Name *) -> bool
+    {
+      if (this->RecordEntity(_entity, _ecm))
+        this->recordedEntities.insert(_entity);
+      return true;
+    };
+    if (!initialized)
+      _ecm.Each<components::Name>(classify);
+    else if (_ecm.HasNewEntities())
+      _ecm.EachNew<components::Name>(classify);
+  }
+
+  // Systems may register component types after the filters were created
+  if (this->FilterComponents())
+  {
+    auto factory = components::Factory::Instance();
+    auto typeIds = factory->TypeIds();
+    if (typeIds.size() == this->registeredTypeCount)
+      return;
+    this->registeredTypeCount = typeIds.size();
+
+    this->recordedTypes.clear();
+    for (const auto &typeId : typeIds)
+    {
+      if (this->RecordComponent(factory->Name(typeId)))
+        this->recordedTypes.insert(typeId);
+    }
+
+    if (!initialized && this->recordedTypes.empty())
+    {
+      gzwarn << "No registered component type passes the <include_component> "
+             << "and <exclude_component> filters, no state will be recorded."
+             << std::endl;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::PublishStatus(bool _force)
+{
+  if (!this->statusPub)
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+  if (!_force && now - this->lastStatusTime < std::chrono::seconds(1))
+    return;
+  this->lastStatusTime = now;
+
+  msgs::Param msg;
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    auto addCount = [&msg](const std::string &_name, uint64_t _count)
+    {
+      auto &value = (*msg.mutable_params())[_name];
+      value.set_type(msgs::Any_ValueType_INT32);
+      value.set_int_value(static_cast<int32_t>(std::min<uint64_t>(_count,
+          std::numeric_limits<int32_t>::max())));
+    };
+    addCount("written_records", this->writtenRecords);
+    addCount("dropped_records", this->droppedRecords);
+    addCount("queued_records", this->recordQueue.size());
+
+    // Size of the written states over their size before compression
+    auto &ratio = (*msg.mutable_params())["state_compression_ratio"];
+    ratio.set_type(msgs::Any_ValueType_DOUBLE);
+    ratio.set_double_value(this->stateBytes == 0u ? 1.0 :
+        static_cast<double>(this->writtenStateBytes) / this->stateBytes);
+  }
+  this->statusPub.Publish(msg);
+}
+
 //////////////////////////////////////////////////
 void LogRecord::PreUpdate(const UpdateInfo &_info,
     EntityComponentManager &)
@@ -717,18 +1464,74 @@ void LogRecord::PostUpdate(const UpdateInfo &_info,
 
   // TODO(louise) Use the SceneBroadcaster's topic once that publishes
   // the changed state
-  // \todo(anyone) A potential enhancement here is have a keyframe mechanism
-  // to store complete state periodically, and then store incremental from
-  // that. It would reduce some of the compute on replaying
-  // (especially in tools like plotting or seeking through logs).
-  if (record)
+  //
+  // The messages are filled here, but serialized, compressed and written
+  // to the log by the writer thread.
+  //
+  // Filtered entities and components are left out while serializing. Since
+  // empty sets stand for everything, nothing is recorded if no entity or
+  // component passes the filters.
+  const bool filterEntities = this->dataPtr->FilterEntities();
+  const bool filterComponents = this->dataPtr->FilterComponents();
+  if ((filterEntities || filterComponents) &&
+      (!this->dataPtr->filtersInitialized || _ecm.HasNewEntities() ||
+       _ecm.HasEntitiesMarkedForRemoval() ||
+       _ecm.HasOneTimeComponentChanges()))
+  {
+    this->dataPtr->UpdateFilters(_ecm);
+  }
+  const auto &entities = this->dataPtr->recordedEntities;
+  const auto &types = this->dataPtr->recordedTypes;
+  const bool recordNothing = (filterEntities && entities.empty()) ||
+      (filterComponents && types.empty());
+
+  if (record && !recordNothing)
   {
-    msgs::SerializedStateMap stateMsg;
-    _ecm.ChangedState(stateMsg);
-    if (!stateMsg.entities().empty())
-      this->dataPtr->statePub.Publish(stateMsg);
+    // After dropping the changes of an update, record the complete state
+    // so playback doesn't miss them
+    auto stateMsg = std::make_unique<msgs::SerializedStateMap>();
+    if (this->dataPtr->recordFullState)
+      _ecm.State(*stateMsg, entities, types, true);
+    else
+      _ecm.ChangedState(*stateMsg, entities, types);
+
+    // Removals are only reported in the step they happen, and the complete
+    // state can't tell about them, so their records are never dropped
+    const bool removals = _ecm.HasEntitiesMarkedForRemoval() ||
+        _ecm.HasRemovedComponents();
+    if (!stateMsg->entities().empty())
+    {
+      this->dataPtr->recordFullState = !this->dataPtr->QueueRecord(
+          this->dataPtr->statePub, std::move(stateMsg), _info.simTime,
+          this->dataPtr->compressStates, removals);
+    }
   }
 
+  // Periodically store the complete state, so playback can seek to the
+  // latest keyframe and only apply the changes recorded after it. The
+  // changes are still recorded on every step, so keyframes are only read
+  // when seeking.
+  if (this->dataPtr->keyframePub && !recordNothing &&
+      (_info.simTime - this->dataPtr->lastKeyframeSimTime) >=
+      this->dataPtr->keyframePeriod)
+  {
+    GZ_PROFILE("Keyframe");
+    this->dataPtr->lastKeyframeSimTime = _info.simTime;
+
+    // Keyframes are never dropped, since seeking relies on them
+    auto keyframeMsg = std::make_unique<msgs::SerializedStateMap>();
+    _ecm.State(*keyframeMsg, entities, types, true);
+    this->dataPtr->QueueRecord(this->dataPtr->keyframePub,
+        std::move(keyframeMsg), _info.simTime, this->dataPtr->compressStates,
+        true);
+    this->dataPtr->QueueRecord(this->dataPtr->keyframeIndexPub,
+        std::make_unique<msgs::Time>(convert<msgs::Time>(_info.simTime)),
+        _info.simTime, false, true);
+  }
+
+  // Removed entities stay in the filter until their removal is recorded
+  this->dataPtr->PruneRemovedEntities(_ecm);
+
   // If there are new models loaded, save meshes and textures
   if (this->dataPtr->RecordResources() && _ecm.HasNewEntities())
     this->dataPtr->LogModelResources(_ecm);
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_LOG_LOGSTREAMER_HH_
+#define GZ_SIM_SYSTEMS_LOG_LOGSTREAMER_HH_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/log/Batch.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/transport/log/QualifiedTime.hh>
+#include <gz/transport/log/QueryOptions.hh>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::log_playback
+{
+  /// \brief A message read from a log file.
+  struct StreamedMessage
+  {
+    /// \brief Time the message was recorded at.
+    std::chrono::steady_clock::duration time{0};
+
+    /// \brief Topic of the message.
+    std::string topic;
+
+    /// \brief Type of the message.
+    std::string type;
+
+    /// \brief Serialized message.
+    std::string data;
+  };
+
+  /// \brief Reads the messages of a log file in order on a background
+  /// thread, so playback doesn't hold the whole log in memory.
+  ///
+  /// The reader keeps a sliding window of messages ahead of the time that
+  /// was last requested, bounded both in time and in memory. It stops
+  /// reading when either bound is reached, and resumes as messages are
+  /// consumed, so memory stays flat no matter how long the log is. A
+  /// single message larger than the memory cap is still read, so playback
+  /// can always make progress.
+  class LogStreamer
+  {
+    /// \brief Constructor
+    /// \param[in] _window How far ahead of the consumer to read.
+    /// \param[in] _maxBytes Maximum size of the buffered messages.
+    public: LogStreamer(const std::chrono::steady_clock::duration &_window,
+                std::size_t _maxBytes)
+      : window(_window), maxBytes(_maxBytes)
+    {
+    }
+
+    /// \brief Destructor, stops the reader.
+    public: ~LogStreamer()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+      }
+      this->cv.notify_all();
+      if (this->thread.joinable())
+        this->thread.join();
+    }
+
+    /// \brief Open a log file and start reading it from the beginning.
+    /// \param[in] _path Path to the log file.
+    /// \return True if the file was opened.
+    public: bool Open(const std::string &_path)
+    {
+      if (this->thread.joinable())
+      {
+        gzerr << "Log streamer is already open." << std::endl;
+        return false;
+      }
+
+      // The reader has its own connection, so it doesn't contend with
+      // queries made while seeking
+      this->log = std::make_unique<transport::log::Log>();
+      if (!this->log->Open(_path))
+      {
+        gzerr << "Failed to open log file [" << _path << "] for streaming."
+               << std::endl;
+        return false;
+      }
+
+      this->thread = std::thread(&LogStreamer::Run, this);
+      return true;
+    }
+
+    /// \brief Drop the buffered messages and continue reading from the
+    /// first message recorded after a time.
+    /// \param[in] _time Time already played back.
+    public: void Seek(const std::chrono::steady_clock::duration &_time)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ++this->generation;
+        this->buffer.clear();
+        this->bytes = 0;
+        this->endOfLog = false;
+        this->seekTime = _time;
+        this->seeked = true;
+        this->consumerTime = _time;
+      }
+      this->cv.notify_all();
+    }
+
+    /// \brief Get the next message, if it was recorded at or before a time.
+    /// Blocks until the reader caught up with that time.
+    /// \param[in] _until Latest time to get messages for.
+    /// \param[out] _msg The message.
+    /// \return True if a message was returned, false if there are no more
+    /// messages up to that time.
+    public: bool Pop(const std::chrono::steady_clock::duration &_until,
+                StreamedMessage &_msg)
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (_until > this->consumerTime)
+      {
+        this->consumerTime = _until;
+        this->cv.notify_all();
+      }
+
+      this->cv.wait(lock, [this]
+          {
+            return !this->buffer.empty() || this->endOfLog || this->stop;
+          });
+      if (this->buffer.empty() || this->buffer.front().time > _until)
+        return false;
+
+      _msg = std::move(this->buffer.front());
+      this->buffer.pop_front();
+      this->bytes -= Size(_msg);
+      lock.unlock();
+      this->cv.notify_all();
+      return true;
+    }
+
+    /// \brief Get the size of the buffered messages.
+    /// \return Size in bytes.
+    public: std::size_t BufferedBytes() const
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      return this->bytes;
+    }
+
+    /// \brief Memory used by a buffered message.
+    /// \param[in] _msg The message.
+    /// \return Size in bytes.
+    private: static std::size_t Size(const StreamedMessage &_msg)
+    {
+      return sizeof(_msg) + _msg.topic.size() + _msg.type.size() +
+          _msg.data.size();
+    }
+
+    /// \brief Read messages until stopped. Runs on the reader thread.
+    private: void Run()
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      while (!this->stop)
+      {
+        const auto currentGeneration = this->generation;
+        auto range = transport::log::QualifiedTimeRange::AllTime();
+        if (this->seeked)
+        {
+          range = transport::log::QualifiedTimeRange::From(
+              transport::log::QualifiedTime(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+              this->seekTime),
+              transport::log::QualifiedTime::Qualifier::EXCLUSIVE));
+        }
+        lock.unlock();
+
+        auto batch = this->log->QueryMessages(
+            transport::log::AllTopics(range));
+        for (auto iter = batch.begin(); iter != batch.end(); ++iter)
+        {
+          StreamedMessage msg;
+          msg.time = std::chrono::duration_cast<
+              std::chrono::steady_clock::duration>(iter->TimeReceived());
+          msg.topic = iter->Topic();
+          msg.type = iter->Type();
+          msg.data = iter->Data();
+          const auto size = Size(msg);
+
+          lock.lock();
+          this->cv.wait(lock, [&]
+              {
+                return this->stop || this->generation != currentGeneration ||
+                    this->buffer.empty() ||
+                    (this->bytes + size <= this->maxBytes &&
+                     msg.time <= this->consumerTime + this->window);
+              });
+          if (this->stop || this->generation != currentGeneration)
+            break;
+          this->bytes += size;
+          this->buffer.push_back(std::move(msg));
+          lock.unlock();
+          this->cv.notify_all();
+        }
+
+        if (!lock.owns_lock())
+          lock.lock();
+        if (this->stop || this->generation != currentGeneration)
+          continue;
+
+        // Wait for a seek once the whole log was read
+        this->endOfLog = true;
+        this->cv.notify_all();
+        this->cv.wait(lock, [&]
+            {
+              return this->stop || this->generation != currentGeneration;
+            });
+      }
+    }
+
+    /// \brief How far ahead of the consumer to read.
+    private: std::chrono::steady_clock::duration window;
+
+    /// \brief Maximum size of the buffered messages.
+    private: std::size_t maxBytes;
+
+    /// \brief Log read by the reader thread.
+    private: std::unique_ptr<transport::log::Log> log;
+
+    /// \brief Messages read ahead of the consumer, in time order.
+    private: std::deque<StreamedMessage> buffer;
+
+    /// \brief Size of the buffered messages.
+    private: std::size_t bytes{0};
+
+    /// \brief Latest time requested by the consumer.
+    private: std::chrono::steady_clock::duration consumerTime{0};
+
+    /// \brief Time of the latest seek.
+    private: std::chrono::steady_clock::duration seekTime{0};
+
+    /// \brief Whether there was a seek, otherwise the log is read from the
+    /// start.
+    private: bool seeked{false};
+
+    /// \brief Incremented on every seek, to restart the reader.
+    private: std::uint64_t generation{0};
+
+    /// \brief True once the reader got to the end of the log.
+    private: bool endOfLog{false};
+
+    /// \brief True to stop the reader.
+    private: bool stop{false};
+
+    /// \brief Protects the members shared with the reader thread.
+    private: mutable std::mutex mutex;
+
+    /// \brief Signals changes to the buffer, the consumer time and seeks.
+    private: std::condition_variable cv;
+
+    /// \brief Reader thread.
+    private: std::thread thread;
+  };
+}
+}
+}
+#endif
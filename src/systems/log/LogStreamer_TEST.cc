@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/transport/log/Log.hh>
+
+#include "LogStreamer.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::log_playback;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+class LogStreamerTest : public ::testing::Test
+{
+  // Write a log with a 1 kB message on each of 2 topics every millisecond
+  protected: void SetUp() override
+  {
+    ASSERT_TRUE(this->tempDir.Valid());
+    this->path = common::joinPaths(this->tempDir.Path(), "state.tlog");
+
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(this->path, std::ios_base::out));
+    const std::string data(1000, 'x');
+    for (int i = 1; i <= 100; ++i)
+    {
+      for (const std::string topic : {"/a", "/b"})
+      {
+        ASSERT_TRUE(log.InsertMessage(std::chrono::milliseconds(i), topic,
+            "gz.msgs.StringMsg", data.data(), data.size()));
+      }
+    }
+  }
+
+  /// \brief Temporary directory for the log.
+  protected: common::TempDirectory tempDir{"log_streamer", "gz_sim", true};
+
+  /// \brief Path to the log.
+  protected: std::string path;
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogStreamerTest, InOrder)
+{
+  LogStreamer streamer(5ms, 1024u * 1024u);
+  ASSERT_TRUE(streamer.Open(this->path));
+
+  // Messages are returned up to the requested time, in order
+  StreamedMessage msg;
+  int count = 0;
+  while (streamer.Pop(10ms, msg))
+  {
+    ++count;
+    EXPECT_EQ(std::chrono::milliseconds((count + 1) / 2), msg.time);
+    EXPECT_EQ(count % 2 ? "/a" : "/b", msg.topic);
+    EXPECT_EQ("gz.msgs.StringMsg", msg.type);
+    EXPECT_EQ(1000u, msg.data.size());
+  }
+  EXPECT_EQ(20, count);
+
+  // Then continue from there
+  while (streamer.Pop(1s, msg))
+    ++count;
+  EXPECT_EQ(200, count);
+  EXPECT_EQ(100ms, msg.time);
+  EXPECT_FALSE(streamer.Pop(2s, msg));
+  EXPECT_EQ(0u, streamer.BufferedBytes());
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogStreamerTest, MemoryCap)
+{
+  // Room for about 3 messages, with a window that would hold the whole log
+  const std::size_t cap = 3500u;
+  LogStreamer streamer(1s, cap);
+  ASSERT_TRUE(streamer.Open(this->path));
+
+  StreamedMessage msg;
+  int count = 0;
+  for (int i = 1; i <= 100; ++i)
+  {
+    while (streamer.Pop(std::chrono::milliseconds(i), msg))
+    {
+      EXPECT_LE(streamer.BufferedBytes(), cap);
+      ++count;
+    }
+  }
+  EXPECT_EQ(200, count);
+
+  // A cap smaller than a message still makes progress
+  LogStreamer tiny(1s, 1u);
+  ASSERT_TRUE(tiny.Open(this->path));
+  count = 0;
+  while (tiny.Pop(1s, msg))
+    ++count;
+  EXPECT_EQ(200, count);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogStreamerTest, Seek)
+{
+  LogStreamer streamer(5ms, 1024u * 1024u);
+  ASSERT_TRUE(streamer.Open(this->path));
+
+  StreamedMessage msg;
+  ASSERT_TRUE(streamer.Pop(50ms, msg));
+  EXPECT_EQ(1ms, msg.time);
+
+  // Forward, the messages at the seek time were already played
+  streamer.Seek(80ms);
+  ASSERT_TRUE(streamer.Pop(90ms, msg));
+  EXPECT_EQ(81ms, msg.time);
+  EXPECT_EQ("/a", msg.topic);
+
+  // Backward
+  streamer.Seek(10ms);
+  EXPECT_FALSE(streamer.Pop(10ms, msg));
+  int count = 0;
+  while (streamer.Pop(20ms, msg))
+  {
+    EXPECT_GT(msg.time, 10ms);
+    EXPECT_LE(msg.time, 20ms);
+    ++count;
+  }
+  EXPECT_EQ(20, count);
+}
@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_LOG_RESOURCESTORE_HH_
+#define GZ_SIM_SYSTEMS_LOG_RESOURCESTORE_HH_
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::log_resources
+{
+  /// \brief Name of the file listing the stored resources of a log,
+  /// relative to the log directory.
+  inline constexpr char kManifestFileName[] = "resources.manifest";
+
+  /// \brief A directory shared by many logs, which holds each resource
+  /// file once, named after the SHA-1 of its content.
+  ///
+  /// Logs get their resources as hard links to the stored files, falling
+  /// back to copies across file systems, so recording a model that is
+  /// already in the store only costs a link. The hash of each source file
+  /// is cached in an index together with its size and modification time,
+  /// so unchanged files aren't read again. Files are added under a
+  /// temporary name and renamed, so several recorders can share a store.
+  ///
+  /// Stored files must not be modified in place, since every log linking
+  /// to them would see the change.
+  class ResourceStore
+  {
+    /// \brief Constructor
+    /// \param[in] _root Directory of the store, created if needed.
+    public: explicit ResourceStore(const std::string &_root)
+      : root(common::absPath(_root))
+    {
+      this->LoadIndex();
+    }
+
+    /// \brief Directory of the store.
+    /// \return Absolute path.
+    public: const std::string &Root() const
+    {
+      return this->root;
+    }
+
+    /// \brief Path of a stored file.
+    /// \param[in] _hash Hash of its content.
+    /// \return Path, whether the file exists or not.
+    public: std::string ObjectPath(const std::string &_hash) const
+    {
+      return common::joinPaths(this->root, "objects",
+          _hash.substr(0, 2), _hash);
+    }
+
+    /// \brief Whether a file is in the store.
+    /// \param[in] _hash Hash of its content.
+    /// \return True if it's stored.
+    public: bool Has(const std::string &_hash) const
+    {
+      return !_hash.empty() && common::isFile(this->ObjectPath(_hash));
+    }
+
+    /// \brief Hash the content of a file, reusing the cached hash if the
+    /// file didn't change since it was last hashed.
+    /// \param[in] _file Path of the file.
+    /// \return SHA-1 of the content, or an empty string if the file
+    /// couldn't be read.
+    public: std::string Hash(const std::string &_file)
+    {
+      std::error_code ec;
+      const auto size = std::filesystem::file_size(_file, ec);
+      if (ec)
+        return std::string();
+      const auto mtime = static_cast<std::int64_t>(
+          std::filesystem::last_write_time(_file, ec)
+          .time_since_epoch().count());
+      if (ec)
+        return std::string();
+
+      const auto path = common::absPath(_file);
+      auto it = this->index.find(path);
+      if (it != this->index.end() && it->second.size == size &&
+          it->second.mtime == mtime)
+      {
+        return it->second.hash;
+      }
+
+      std::ifstream stream(_file, std::ios::binary);
+      if (!stream)
+        return std::string();
+      const std::string content((std::istreambuf_iterator<char>(stream)),
+          std::istreambuf_iterator<char>());
+      const auto hash = common::sha1(content);
+
+      this->index[path] = {hash, size, mtime};
+      std::ofstream indexFile(this->IndexPath(), std::ios::app);
+      indexFile << hash << " " << size << " " << mtime << " " << path
+                << "\n";
+      return hash;
+    }
+
+    /// \brief Add a file to the store, unless its content is already
+    /// stored.
+    /// \param[in] _file Path of the file.
+    /// \return Hash of its content, or an empty string on failure.
+    public: std::string Add(const std::string &_file)
+    {
+      const auto hash = this->Hash(_file);
+      if (hash.empty())
+      {
+        gzerr << "Failed to read resource [" << _file << "]." << std::endl;
+        return hash;
+      }
+      if (this->Has(hash))
+        return hash;
+
+      const auto object = this->ObjectPath(hash);
+      if (!common::createDirectories(common::parentPath(object)))
+      {
+        gzerr << "Failed to create resource store directory ["
+              << common::parentPath(object) << "]." << std::endl;
+        return std::string();
+      }
+
+      // Copy under a name no other recorder uses, then rename, so the
+      // object is never seen half written
+      std::ostringstream tmp;
+      tmp << object << ".tmp."
+          << std::hash<std::thread::id>()(std::this_thread::get_id());
+      std::error_code ec;
+      std::filesystem::copy_file(_file, tmp.str(),
+          std::filesystem::copy_options::overwrite_existing, ec);
+      if (!ec)
+        std::filesystem::rename(tmp.str(), object, ec);
+      if (ec)
+      {
+        std::filesystem::remove(tmp.str(), ec);
+        if (!this->Has(hash))
+        {
+          gzerr << "Failed to add resource [" << _file << "] to store ["
+                << this->root << "]." << std::endl;
+          return std::string();
+        }
+      }
+      return hash;
+    }
+
+    /// \brief Create a file with the content of a stored file, as a hard
+    /// link if possible. An existing file at the destination is replaced.
+    /// \param[in] _hash Hash of the stored file.
+    /// \param[in] _dest Path of the file to create.
+    /// \return True on success.
+    public: bool Checkout(const std::string &_hash,
+                const std::string &_dest) const
+    {
+      if (!this->Has(_hash))
+        return false;
+
+      const auto object = this->ObjectPath(_hash);
+      if (!common::createDirectories(common::parentPath(_dest)))
+        return false;
+
+      std::error_code ec;
+      std::filesystem::remove(_dest, ec);
+      std::filesystem::create_hard_link(object, _dest, ec);
+      if (ec)
+      {
+        ec.clear();
+        std::filesystem::copy_file(object, _dest, ec);
+      }
+      return !ec;
+    }
+
+    /// \brief Add every file in a directory to the store, and check them
+    /// out in another directory with the same layout.
+    /// \param[in] _src Directory to add.
+    /// \param[in] _dest Directory to check the files out in.
+    /// \param[out] _hashes Hash of each checked out file, by its path below
+    /// _dest.
+    /// \return True if all the files were added and checked out.
+    public: bool AddDirectory(const std::string &_src,
+                const std::string &_dest,
+                std::map<std::string, std::string> &_hashes)
+    {
+      std::error_code ec;
+      std::filesystem::recursive_directory_iterator it(_src, ec);
+      if (ec)
+      {
+        gzerr << "Failed to read resource directory [" << _src << "]."
+              << std::endl;
+        return false;
+      }
+
+      bool result{true};
+      for (const auto &entry : it)
+      {
+        if (!entry.is_regular_file(ec))
+          continue;
+
+        const auto rel = std::filesystem::relative(entry.path(), _src, ec);
+        if (ec)
+        {
+          result = false;
+          continue;
+        }
+        const auto dest = (std::filesystem::path(_dest) / rel).string();
+        const auto hash = this->Add(entry.path().string());
+        if (hash.empty() || !this->Checkout(hash, dest))
+        {
+          result = false;
+          continue;
+        }
+        _hashes[dest] = hash;
+      }
+      return result;
+    }
+
+    /// \brief Write the manifest of a log.
+    /// \param[in] _path Path of the manifest.
+    /// \param[in] _root Directory of the store the files are in.
+    /// \param[in] _hashes Hash of each file, by its path relative to the
+    /// log directory.
+    /// \return True on success.
+    public: static bool WriteManifest(const std::string &_path,
+                const std::string &_root,
+                const std::map<std::string, std::string> &_hashes)
+    {
+      std::ofstream out(_path, std::ios::trunc);
+      out << "store " << _root << "\n";
+      for (const auto &[file, hash] : _hashes)
+        out << hash << " " << file << "\n";
+      return static_cast<bool>(out);
+    }
+
+    /// \brief Read the manifest of a log.
+    /// \param[in] _path Path of the manifest.
+    /// \param[out] _root Directory of the store the files were added to.
+    /// \param[out] _hashes Hash of each file, by its path relative to the
+    /// log directory.
+    /// \return True if the manifest was read.
+    public: static bool ReadManifest(const std::string &_path,
+                std::string &_root,
+                std::map<std::string, std::string> &_hashes)
+    {
+      std::ifstream in(_path);
+      if (!in)
+        return false;
+
+      const std::string storePrefix{"store "};
+      std::string line;
+      while (std::getline(in, line))
+      {
+        // Paths may have spaces, so only split at the first one
+        const auto space = line.find(' ');
+        if (space == std::string::npos)
+          continue;
+        if (line.compare(0, storePrefix.size(), storePrefix) == 0)
+          _root = line.substr(storePrefix.size());
+        else
+          _hashes[line.substr(space + 1)] = line.substr(0, space);
+      }
+      return true;
+    }
+
+    /// \brief Path of the hash index.
+    /// \return Path.
+    private: std::string IndexPath() const
+    {
+      return common::joinPaths(this->root, "index");
+    }
+
+    /// \brief Load the hash index, keeping the latest entry of each file.
+    private: void LoadIndex()
+    {
+      if (!common::createDirectories(this->root))
+      {
+        gzerr << "Failed to create resource store [" << this->root << "]."
+              << std::endl;
+        return;
+      }
+
+      std::ifstream in(this->IndexPath());
+      std::string line;
+      while (std::getline(in, line))
+      {
+        std::istringstream stream(line);
+        IndexEntry entry;
+        std::string path;
+        stream >> entry.hash >> entry.size >> entry.mtime;
+        stream.ignore(1);
+        if (!stream || !std::getline(stream, path) || path.empty())
+          continue;
+        this->index[path] = entry;
+      }
+    }
+
+    /// \brief Cached hash of a file.
+    private: struct IndexEntry
+    {
+      /// \brief Hash of the content.
+      std::string hash;
+
+      /// \brief Size of the file when it was hashed.
+      std::uintmax_t size{0};
+
+      /// \brief Modification time of the file when it was hashed.
+      std::int64_t mtime{0};
+    };
+
+    /// \brief Directory of the store.
+    private: std::string root;
+
+    /// \brief Cached hash of each file, by absolute path.
+    private: std::unordered_map<std::string, IndexEntry> index;
+  };
+}
+}
+}
+#endif
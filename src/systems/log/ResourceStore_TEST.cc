@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+
+#include "ResourceStore.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::log_resources;
+
+/////////////////////////////////////////////////
+class ResourceStoreTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    ASSERT_TRUE(this->tempDir.Valid());
+    this->storePath = common::joinPaths(this->tempDir.Path(), "store");
+  }
+
+  /// \brief Write a file.
+  protected: std::string Write(const std::string &_rel,
+                 const std::string &_content)
+  {
+    const auto path = common::joinPaths(this->tempDir.Path(), _rel);
+    common::createDirectories(common::parentPath(path));
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << _content;
+    return path;
+  }
+
+  /// \brief Read a file.
+  protected: static std::string Read(const std::string &_path)
+  {
+    std::ifstream in(_path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+  }
+
+  /// \brief Number of stored files.
+  protected: std::size_t ObjectCount() const
+  {
+    std::size_t count{0u};
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(
+        common::joinPaths(this->storePath, "objects")))
+    {
+      if (entry.is_regular_file())
+        ++count;
+    }
+    return count;
+  }
+
+  protected: common::TempDirectory tempDir{"resource_store"};
+
+  protected: std::string storePath;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ResourceStoreTest, Deduplicate)
+{
+  const auto first = this->Write("a/mesh.dae", "mesh");
+  const auto second = this->Write("b/mesh.dae", "mesh");
+  const auto third = this->Write("b/texture.png", "texture");
+
+  ResourceStore store(this->storePath);
+  const auto hash = store.Add(first);
+  ASSERT_EQ(40u, hash.size());
+  EXPECT_TRUE(store.Has(hash));
+  EXPECT_EQ(hash, store.Add(second));
+  EXPECT_NE(hash, store.Add(third));
+  EXPECT_EQ(2u, this->ObjectCount());
+  EXPECT_EQ("mesh", Read(store.ObjectPath(hash)));
+
+  // Missing files aren't stored
+  EXPECT_TRUE(store.Add(common::joinPaths(this->tempDir.Path(),
+      "missing")).empty());
+  EXPECT_FALSE(store.Has(""));
+
+  // Checked out files have the stored content
+  const auto dest = common::joinPaths(this->tempDir.Path(), "log", "x.dae");
+  EXPECT_TRUE(store.Checkout(hash, dest));
+  EXPECT_EQ("mesh", Read(dest));
+  EXPECT_FALSE(store.Checkout(std::string(40, '0'), dest + "2"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ResourceStoreTest, CachedHash)
+{
+  const auto file = this->Write("model/mesh.dae", "before");
+  std::string hash;
+  {
+    ResourceStore store(this->storePath);
+    hash = store.Hash(file);
+    EXPECT_FALSE(hash.empty());
+  }
+
+  // A new store reuses the hash of the index
+  ResourceStore store(this->storePath);
+  EXPECT_EQ(hash, store.Hash(file));
+
+  // Changing the file invalidates it
+  this->Write("model/mesh.dae", "after!");
+  std::filesystem::last_write_time(file,
+      std::filesystem::last_write_time(file) + std::chrono::seconds(5));
+  const auto newHash = store.Hash(file);
+  EXPECT_FALSE(newHash.empty());
+  EXPECT_NE(hash, newHash);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ResourceStoreTest, DirectoryAndManifest)
+{
+  this->Write("model/model.sdf", "sdf");
+  this->Write("model/meshes/mesh one.dae", "mesh");
+  this->Write("model/materials/texture.png", "mesh");
+
+  ResourceStore store(this->storePath);
+  const auto logDir = common::joinPaths(this->tempDir.Path(), "log");
+  std::map<std::string, std::string> hashes;
+  EXPECT_TRUE(store.AddDirectory(
+      common::joinPaths(this->tempDir.Path(), "model"), logDir, hashes));
+  ASSERT_EQ(3u, hashes.size());
+  EXPECT_EQ(2u, this->ObjectCount());
+  const auto mesh = common::joinPaths(logDir, "meshes", "mesh one.dae");
+  EXPECT_EQ("mesh", Read(mesh));
+
+  // Paths with spaces survive the round trip
+  const auto manifest = common::joinPaths(logDir, kManifestFileName);
+  std::map<std::string, std::string> written{
+      {"meshes/mesh one.dae", hashes[mesh]}};
+  EXPECT_TRUE(ResourceStore::WriteManifest(manifest, store.Root(),
+      written));
+
+  std::string root;
+  std::map<std::string, std::string> read;
+  EXPECT_TRUE(ResourceStore::ReadManifest(manifest, root, read));
+  EXPECT_EQ(store.Root(), root);
+  EXPECT_EQ(written, read);
+
+  EXPECT_FALSE(ResourceStore::ReadManifest(manifest + "2", root, read));
+}
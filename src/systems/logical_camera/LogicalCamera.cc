@@ -19,17 +19,21 @@
 
 #include <gz/msgs/logical_camera_image.pb.h>
 
+#include <cmath>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <gz/common/Profiler.hh>
 #include <gz/plugin/Register.hh>
 
 #include <sdf/Sensor.hh>
 
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/transport/Node.hh>
 
@@ -50,6 +54,12 @@ using namespace gz;
 using namespace sim;
 using namespace systems;
 
+namespace
+{
+/// \brief Size of the cells of the model index, in meters.
+constexpr double kModelCellSize{1.0};
+}
+
 /// \brief Private LogicalCamera data class.
 class gz::sim::systems::LogicalCameraPrivate
 {
@@ -91,6 +101,51 @@ class gz::sim::systems::LogicalCameraPrivate
   /// from simulation.
   /// \param[in] _ecm Immutable reference to ECM.
   public: void RemoveLogicalCameraEntities(const EntityComponentManager &_ecm);
+
+  /// \brief Bring the model index up to date with the ECM. Only models that
+  /// moved to another cell, appeared or disappeared change the grid.
+  /// \param[in] _ecm Immutable reference to ECM.
+  public: void UpdateModelIndex(const EntityComponentManager &_ecm);
+
+  /// \brief Get the poses of the models that may be seen by a sensor,
+  /// which are the ones inside the bounding box of its frustum. The sensor
+  /// then tests them against the frustum itself.
+  /// \param[in] _sensor Sensor, with its pose up to date.
+  /// \return Map of model names to poses.
+  public: std::map<std::string, math::Pose3d> ModelsNear(
+              const sensors::LogicalCameraSensor &_sensor) const;
+
+  /// \brief Get the key of the cell containing a position.
+  /// \param[in] _x Cell X coordinate.
+  /// \param[in] _y Cell Y coordinate.
+  /// \return Key combining both coordinates.
+  public: static std::uint64_t CellKey(std::int64_t _x, std::int64_t _y);
+
+  /// \brief A model in the index.
+  public: struct IndexedModel
+  {
+    /// \brief Name of the model.
+    std::string name;
+
+    /// \brief Pose of the model.
+    math::Pose3d pose;
+
+    /// \brief Key of the cell holding the model.
+    std::uint64_t cell;
+
+    /// \brief Last index update which saw the model.
+    std::uint64_t generation;
+  };
+
+  /// \brief Models binned on a uniform grid in the XY plane, queried by all
+  /// sensors instead of each of them testing every model.
+  public: std::unordered_map<Entity, IndexedModel> indexedModels;
+
+  /// \brief Models in each non-empty cell of the index.
+  public: std::unordered_map<std::uint64_t, std::vector<Entity>> modelCells;
+
+  /// \brief Number of index updates.
+  public: std::uint64_t indexGeneration{0u};
 };
 
 //////////////////////////////////////////////////
@@ -253,20 +308,7 @@ void LogicalCameraPrivate::UpdateLogicalCameras(
     const EntityComponentManager &_ecm)
 {
   GZ_PROFILE("LogicalCameraPrivate::UpdateLogicalCameras");
-  std::map<std::string, math::Pose3d> modelPoses;
-
-  _ecm.Each<components::Model, components::Name, components::Pose>(
-      [&](const Entity &,
-        const components::Model *,
-        const components::Name *_name,
-        const components::Pose *_pose)->bool
-      {
-        /// todo(anyone) We currently assume there are only top level models
-        /// Update to retrieve world pose when nested models are supported.
-        modelPoses[_name->Data()] = _pose->Data();
-        return true;
-      });
-
+  this->UpdateModelIndex(_ecm);
 
   _ecm.Each<components::LogicalCamera, components::WorldPose>(
     [&](const Entity &_entity,
@@ -278,9 +320,7 @@ void LogicalCameraPrivate::UpdateLogicalCameras(
         {
           const math::Pose3d &worldPose = _worldPose->Data();
           it->second->SetPose(worldPose);
-          // Make a copy of modelPoses s.t. SetModelPoses can take ownership
-          auto modelPoses_ = modelPoses;
-          it->second->SetModelPoses(std::move(modelPoses_));
+          it->second->SetModelPoses(this->ModelsNear(*it->second));
         }
         else
         {
@@ -292,6 +332,163 @@ void LogicalCameraPrivate::UpdateLogicalCameras(
       });
 }
 
+//////////////////////////////////////////////////
+std::uint64_t LogicalCameraPrivate::CellKey(std::int64_t _x, std::int64_t _y)
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_x)) <<
+      32u) | static_cast<std::uint32_t>(_y);
+}
+
+//////////////////////////////////////////////////
+void LogicalCameraPrivate::UpdateModelIndex(const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("LogicalCameraPrivate::UpdateModelIndex");
+  const std::uint64_t generation = ++this->indexGeneration;
+
+  auto removeFromCell = [this](Entity _entity, std::uint64_t _cell)
+  {
+    auto &cell = this->modelCells[_cell];
+    for (auto &entity : cell)
+    {
+      if (entity == _entity)
+      {
+        entity = cell.back();
+        cell.pop_back();
+        break;
+      }
+    }
+    if (cell.empty())
+      this->modelCells.erase(_cell);
+  };
+
+  _ecm.Each<components::Model, components::Name, components::Pose>(
+      [&](const Entity &_entity,
+        const components::Model *,
+        const components::Name *_name,
+        const components::Pose *_pose)->bool
+      {
+        /// todo(anyone) We currently assume there are only top level models
+        /// Update to retrieve world pose when nested models are supported.
+        const math::Pose3d &pose = _pose->Data();
+        const std::uint64_t cell = CellKey(
+            static_cast<std::int64_t>(std::floor(pose.Pos().X() /
+            kModelCellSize)),
+            static_cast<std::int64_t>(std::floor(pose.Pos().Y() /
+            kModelCellSize)));
+
+        auto modelIt = this->indexedModels.find(_entity);
+        if (modelIt == this->indexedModels.end())
+        {
+          this->indexedModels.emplace(_entity,
+              IndexedModel{_name->Data(), pose, cell, generation});
+          this->modelCells[cell].push_back(_entity);
+          return true;
+        }
+
+        auto &model = modelIt->second;
+        model.generation = generation;
+        model.pose = pose;
+        if (model.name != _name->Data())
+          model.name = _name->Data();
+        if (model.cell != cell)
+        {
+          removeFromCell(_entity, model.cell);
+          this->modelCells[cell].push_back(_entity);
+          model.cell = cell;
+        }
+        return true;
+      });
+
+  // Models that weren't seen were removed
+  for (auto it = this->indexedModels.begin();
+       it != this->indexedModels.end();)
+  {
+    if (it->second.generation != generation)
+    {
+      removeFromCell(it->first, it->second.cell);
+      it = this->indexedModels.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, math::Pose3d> LogicalCameraPrivate::ModelsNear(
+    const sensors::LogicalCameraSensor &_sensor) const
+{
+  // Bounding box of the corners of the frustum, which looks along +X
+  const math::Pose3d sensorPose = _sensor.Pose();
+  const double tanHalfFov = std::tan(_sensor.HorizontalFOV().Radian() * 0.5);
+  const double aspect = _sensor.AspectRatio() > 0.0 ?
+      _sensor.AspectRatio() : 1.0;
+  math::Vector3d min(math::INF_D, math::INF_D, math::INF_D);
+  math::Vector3d max(-math::INF_D, -math::INF_D, -math::INF_D);
+  for (double distance : {_sensor.Near(), _sensor.Far()})
+  {
+    const double halfWidth = distance * tanHalfFov;
+    const double halfHeight = halfWidth / aspect;
+    for (double y : {-halfWidth, halfWidth})
+    {
+      for (double z : {-halfHeight, halfHeight})
+      {
+        auto corner = sensorPose.CoordPositionAdd(
+            math::Vector3d(distance, y, z));
+        min.Min(corner);
+        max.Max(corner);
+      }
+    }
+  }
+  const math::AxisAlignedBox bounds(min, max);
+
+  std::map<std::string, math::Pose3d> modelPoses;
+  auto addCell = [&](const std::vector<Entity> &_cell)
+  {
+    for (const auto &entity : _cell)
+    {
+      const auto &model = this->indexedModels.at(entity);
+      if (bounds.Contains(model.pose.Pos()))
+        modelPoses[model.name] = model.pose;
+    }
+  };
+
+  // Frustums covering more cells than there are occupied cells visit all
+  // the occupied cells instead
+  const double cellsX = std::floor(max.X() / kModelCellSize) -
+      std::floor(min.X() / kModelCellSize) + 1.0;
+  const double cellsY = std::floor(max.Y() / kModelCellSize) -
+      std::floor(min.Y() / kModelCellSize) + 1.0;
+  if (!std::isfinite(cellsX * cellsY) ||
+      cellsX * cellsY > static_cast<double>(this->modelCells.size()))
+  {
+    for (const auto &cell : this->modelCells)
+      addCell(cell.second);
+    return modelPoses;
+  }
+
+  const auto minX = static_cast<std::int64_t>(
+      std::floor(min.X() / kModelCellSize));
+  const auto maxX = static_cast<std::int64_t>(
+      std::floor(max.X() / kModelCellSize));
+  const auto minY = static_cast<std::int64_t>(
+      std::floor(min.Y() / kModelCellSize));
+  const auto maxY = static_cast<std::int64_t>(
+      std::floor(max.Y() / kModelCellSize));
+
+  for (std::int64_t x = minX; x <= maxX; ++x)
+  {
+    for (std::int64_t y = minY; y <= maxY; ++y)
+    {
+      auto it = this->modelCells.find(CellKey(x, y));
+      if (it != this->modelCells.end())
+        addCell(it->second);
+    }
+  }
+  return modelPoses;
+}
+
 //////////////////////////////////////////////////
 void LogicalCameraPrivate::RemoveLogicalCameraEntities(
     const EntityComponentManager &_ecm)
@@ -17,6 +17,10 @@
 
 #include "Magnetometer.hh"
 
+#include <gz/msgs/magnetometer.pb.h>
+
+#include <chrono>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -30,6 +34,8 @@
 
 #include <gz/transport/Node.hh>
 
+#include <gz/msgs/Utility.hh>
+
 #include <gz/sensors/SensorFactory.hh>
 #include <gz/sensors/MagnetometerSensor.hh>
 
@@ -40,9 +46,13 @@
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+#include "../../SensorBatches.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -123,6 +133,12 @@ class gz::sim::systems::MagnetometerPrivate
   public: std::unordered_map<Entity,
       std::unique_ptr<sensors::MagnetometerSensor>> entitySensorMap;
 
+  /// \brief Magnetometer sensors that need data at the current step.
+  public: DueSensors<sensors::MagnetometerSensor> dueSensors;
+
+  /// \brief Batched publication of the readings.
+  public: SensorBatches batches{"magnetometer"};
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -151,9 +167,22 @@ class gz::sim::systems::MagnetometerPrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update magnetometer sensor data based on physics data
+  /// \brief Update magnetometer sensor data based on physics data. This
+  /// may be called concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the magnetometer
+  /// \param[in] _sensor Magnetometer sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::MagnetometerSensor &_sensor);
+
+  /// \brief Add the readings of a sensor to its batch. This may be
+  /// called concurrently for different sensors.
+  /// \param[in] _entity Entity of the sensor
+  /// \param[in] _sensor Sensor that was just updated.
+  /// \param[in] _simTime Current simulation time.
+  public: void AddToBatch(const Entity _entity,
+    sensors::MagnetometerSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime);
 
   /// \brief Remove magnetometer sensors if their entities have been removed
   /// from simulation.
@@ -242,6 +271,15 @@ Magnetometer::Magnetometer() : System(), dataPtr(
 //////////////////////////////////////////////////
 Magnetometer::~Magnetometer() = default;
 
+//////////////////////////////////////////////////
+void Magnetometer::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->batches.Load(_sdf);
+}
+
 //////////////////////////////////////////////////
 void Magnetometer::PreUpdate(const UpdateInfo &/*_info*/,
     EntityComponentManager &_ecm)
@@ -283,30 +321,32 @@ void Magnetometer::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the MagnetometerPrivate::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
+    std::function<bool(Entity)> batchConnections;
+    std::function<void(Entity, sensors::MagnetometerSensor &)> updated;
+    if (this->dataPtr->batches.Enabled())
     {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
+      batchConnections = [&](const Entity _entity)
+      {
+        return this->dataPtr->batches.HasConnections(_entity);
+      };
+      updated = [&](const Entity _entity, sensors::MagnetometerSensor &_sensor)
       {
-        needsUpdate = true;
-        break;
-      }
+        this->dataPtr->AddToBatch(_entity, _sensor, _info.simTime);
+      };
     }
-    if (!needsUpdate)
-      return;
 
-    this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // we only update sensors that need data and have subscribers.
+    // note: gz-sensors does its own throttling. Here the check is mainly
+    // to avoid doing work in the MagnetometerPrivate::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime, batchConnections))
     {
-      // Update measurement time
-      it.second->Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::MagnetometerSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          }, updated);
+      this->dataPtr->batches.Publish(_info.simTime);
     }
   }
 
@@ -355,6 +395,7 @@ void MagnetometerPrivate::AddMagnetometer(
   math::Pose3d p = worldPose(_entity, _ecm);
   sensor->SetWorldPose(p);
 
+  this->batches.AddSensor(_ecm, _entity, sensor->Name(), data.UpdateRate());
   this->entitySensorMap.insert(
       std::make_pair(_entity, std::move(sensor)));
   this->newSensors.insert(_entity);
@@ -409,65 +450,60 @@ void MagnetometerPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void MagnetometerPrivate::Update(
-    const EntityComponentManager &_ecm)
+void MagnetometerPrivate::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::MagnetometerSensor &_sensor)
 {
-  GZ_PROFILE("MagnetometerPrivate::Update");
-  _ecm.Each<components::Magnetometer,
-            components::WorldPose>(
-    [&](const Entity &_entity,
-        const components::Magnetometer * /*_magnetometer*/,
-        const components::WorldPose *_worldPose)->bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          // Get the magnetometer physical position
-          const math::Pose3d &magnetometerWorldPose = _worldPose->Data();
-          it->second->SetWorldPose(magnetometerWorldPose);
+  auto worldPose = _ecm.Component<components::WorldPose>(_entity);
+  if (nullptr == worldPose)
+    return;
 
-          // Position
-          auto latLonEle = sphericalCoordinates(_entity, _ecm);
-          if (!latLonEle)
-          {
-            gzwarn << "Failed to update NavSat sensor enity [" << _entity
-                    << "]. Spherical coordinates not set." << std::endl;
-            return true;
-          }
-
-          auto lat_rad = GZ_DTOR(latLonEle.value().X());
-          auto lon_rad = GZ_DTOR(latLonEle.value().Y());
-
-          // Magnetic declination and inclination (radians)
-          float declination_rad =
-            get_mag_declination(
-              lat_rad * 180 / GZ_PI, lon_rad * 180 / GZ_PI) * GZ_PI / 180;
-          float inclination_rad =
-            get_mag_inclination(
-              lat_rad * 180 / GZ_PI, lon_rad * 180 / GZ_PI) * GZ_PI / 180;
-
-          // Magnetic strength (10^5xnanoTesla)
-          float strength_ga =
-            0.01f *
-            get_mag_strength(lat_rad * 180 / GZ_PI, lon_rad * 180 / GZ_PI);
-
-          // Magnetic filed components are calculated by http://geomag.nrcan.gc.ca/mag_fld/comp-en.php
-          float H = strength_ga * cosf(inclination_rad);
-          float Z = tanf(inclination_rad) * H;
-          float X = H * cosf(declination_rad);
-          float Y = H * sinf(declination_rad);
-
-          math::Vector3d magnetic_field_I(X, Y, Z);
-          it->second->SetWorldMagneticField(magnetic_field_I);
-        }
-        else
-        {
-          gzerr << "Failed to update magnetometer: " << _entity << ". "
-                 << "Entity not found." << std::endl;
-        }
+  // Get the magnetometer physical position
+  _sensor.SetWorldPose(worldPose->Data());
 
-        return true;
-      });
+  // Position
+  auto latLonEle = sphericalCoordinates(_entity, _ecm);
+  if (!latLonEle)
+  {
+    gzwarn << "Failed to update NavSat sensor enity [" << _entity
+            << "]. Spherical coordinates not set." << std::endl;
+    return;
+  }
+
+  auto lat_rad = GZ_DTOR(latLonEle.value().X());
+  auto lon_rad = GZ_DTOR(latLonEle.value().Y());
+
+  // Magnetic declination and inclination (radians)
+  float declination_rad =
+    get_mag_declination(
+      lat_rad * 180 / GZ_PI, lon_rad * 180 / GZ_PI) * GZ_PI / 180;
+  float inclination_rad =
+    get_mag_inclination(
+      lat_rad * 180 / GZ_PI, lon_rad * 180 / GZ_PI) * GZ_PI / 180;
+
+  // Magnetic strength (10^5xnanoTesla)
+  float strength_ga =
+    0.01f *
+    get_mag_strength(lat_rad * 180 / GZ_PI, lon_rad * 180 / GZ_PI);
+
+  // Magnetic filed components are calculated by http://geomag.nrcan.gc.ca/mag_fld/comp-en.php
+  float H = strength_ga * cosf(inclination_rad);
+  float Z = tanf(inclination_rad) * H;
+  float X = H * cosf(declination_rad);
+  float Y = H * sinf(declination_rad);
+
+  math::Vector3d magnetic_field_I(X, Y, Z);
+  _sensor.SetWorldMagneticField(magnetic_field_I);
+}
+
+//////////////////////////////////////////////////
+void MagnetometerPrivate::AddToBatch(const Entity _entity,
+    sensors::MagnetometerSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  msgs::Magnetometer msg;
+  *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(_simTime);
+  msgs::Set(msg.mutable_field_tesla(), _sensor.MagneticField());
+  this->batches.SetMessage(_entity, msg);
 }
 
 //////////////////////////////////////////////////
@@ -488,12 +524,14 @@ void MagnetometerPrivate::RemoveMagnetometerEntities(
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->batches.RemoveSensor(_entity);
 
         return true;
       });
 }
 
 GZ_ADD_PLUGIN(Magnetometer, System,
+  Magnetometer::ISystemConfigure,
   Magnetometer::ISystemPreUpdate,
   Magnetometer::ISystemPostUpdate
 )
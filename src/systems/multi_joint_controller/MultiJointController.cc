@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "MultiJointController.hh"
+
+#include <gz/msgs/double_v.pb.h>
+
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/sim/components/Joint.hh"
+#include "gz/sim/components/JointForceCmd.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/ComponentHandle.hh"
+#include "gz/sim/Util.hh"
+
+#include "PidArray.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+class gz::sim::systems::MultiJointControllerPrivate
+{
+  /// \brief Callback for the targets subscription
+  /// \param[in] _msg Target of each axis
+  public: void OnCmd(const msgs::Double_V &_msg);
+
+  /// \brief Find the joints, and create the components they need.
+  /// \param[in] _ecm The EntityComponentManager.
+  /// \return True if all joints were found.
+  public: bool FindJoints(EntityComponentManager &_ecm);
+
+  /// \brief A controlled joint axis.
+  public: struct ControlledAxis
+  {
+    /// \brief Scoped name of the joint.
+    std::string name;
+
+    /// \brief Index of the axis.
+    std::size_t index{0u};
+
+    /// \brief Joint entity.
+    Entity joint{kNullEntity};
+
+    /// \brief Joint position, if controlling positions.
+    ComponentHandle<components::JointPosition> position;
+
+    /// \brief Joint velocity, if controlling velocities.
+    ComponentHandle<components::JointVelocity> velocity;
+
+    /// \brief Joint force command.
+    ComponentHandle<components::JointForceCmd> forceCmd;
+  };
+
+  /// \brief Gazebo communication node.
+  public: transport::Node node;
+
+  /// \brief Entity the system is attached to.
+  public: Entity entity{kNullEntity};
+
+  /// \brief Controlled axes.
+  public: std::vector<ControlledAxis> axes;
+
+  /// \brief One PID per axis.
+  public: multi_joint_controller::PidArray pids;
+
+  /// \brief Target of each axis.
+  public: std::vector<double> targets;
+
+  /// \brief Error of each axis, kept between updates to avoid allocations.
+  public: std::vector<double> errors;
+
+  /// \brief Output of each PID, kept between updates to avoid allocations.
+  public: std::vector<double> outputs;
+
+  /// \brief Targets received since the last update.
+  public: std::vector<double> newTargets;
+
+  /// \brief True if newTargets holds targets which weren't applied yet.
+  public: bool hasNewTargets{false};
+
+  /// \brief Mutex to protect newTargets.
+  public: std::mutex targetsMutex;
+
+  /// \brief True to control velocities, false to control positions.
+  public: bool controlVelocity{false};
+
+  /// \brief True once all joints were found.
+  public: bool jointsFound{false};
+
+  /// \brief True once a missing joint was reported.
+  public: bool warned{false};
+};
+
+/// \brief Read the gains of a PID, keeping the given values for gains which
+/// aren't specified.
+/// \param[in] _sdf Element holding the gains.
+/// \param[in,out] _gains The gains.
+static void readGains(const sdf::ElementConstPtr &_sdf,
+    multi_joint_controller::PidGains &_gains)
+{
+  _gains.p = _sdf->Get<double>("p_gain", _gains.p).first;
+  _gains.i = _sdf->Get<double>("i_gain", _gains.i).first;
+  _gains.d = _sdf->Get<double>("d_gain", _gains.d).first;
+  _gains.iMax = _sdf->Get<double>("i_max", _gains.iMax).first;
+  _gains.iMin = _sdf->Get<double>("i_min", _gains.iMin).first;
+  _gains.cmdMax = _sdf->Get<double>("cmd_max", _gains.cmdMax).first;
+  _gains.cmdMin = _sdf->Get<double>("cmd_min", _gains.cmdMin).first;
+  _gains.cmdOffset = _sdf->Get<double>("cmd_offset", _gains.cmdOffset).first;
+}
+
+//////////////////////////////////////////////////
+MultiJointController::MultiJointController()
+  : dataPtr(std::make_unique<MultiJointControllerPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+void MultiJointController::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  const bool isWorld = _ecm.Component<components::World>(_entity) != nullptr;
+  auto name = _ecm.Component<components::Name>(_entity);
+  if (!name || (!isWorld &&
+      !_ecm.EntityHasComponentType(_entity, components::Model::typeId)))
+  {
+    gzerr << "MultiJointController plugin should be attached to a model or "
+           << "world entity. Failed to initialize." << std::endl;
+    return;
+  }
+
+  // System-wide gains, with the defaults of JointPositionController
+  multi_joint_controller::PidGains defaultGains{
+      1.0, 0.1, 0.01, 1.0, -1.0, 1000.0, -1000.0, 0.0};
+  readGains(_sdf, defaultGains);
+
+  std::vector<multi_joint_controller::PidGains> gains;
+  for (auto elem = _sdf->FindElement("joint"); elem;
+       elem = elem->GetNextElement("joint"))
+  {
+    MultiJointControllerPrivate::ControlledAxis axis;
+    axis.name = elem->Get<std::string>("name", "").first;
+    if (axis.name.empty())
+    {
+      gzerr << "<joint> provided without a <name>." << std::endl;
+      continue;
+    }
+    axis.index = elem->Get<unsigned int>("index", 0u).first;
+
+    gains.push_back(defaultGains);
+    readGains(elem, gains.back());
+    this->dataPtr->targets.push_back(
+        elem->Get<double>("initial_target", 0.0).first);
+    this->dataPtr->axes.push_back(axis);
+  }
+  if (this->dataPtr->axes.empty())
+  {
+    gzerr << "Failed to get any <joint>." << std::endl;
+    return;
+  }
+
+  const std::string controlType =
+      _sdf->Get<std::string>("control_type", "position").first;
+  if (controlType != "position" && controlType != "velocity")
+  {
+    gzerr << "Unknown <control_type> [" << controlType << "], expected "
+           << "[position] or [velocity]. Failed to initialize." << std::endl;
+    this->dataPtr->axes.clear();
+    return;
+  }
+  this->dataPtr->controlVelocity = controlType == "velocity";
+
+  const std::size_t count = this->dataPtr->axes.size();
+  this->dataPtr->pids.Resize(count);
+  for (std::size_t k = 0u; k < count; ++k)
+    this->dataPtr->pids.SetGains(k, gains[k]);
+  this->dataPtr->errors.resize(count, 0.0);
+  this->dataPtr->outputs.resize(count, 0.0);
+  this->dataPtr->newTargets.reserve(count);
+
+  // Subscribe to commands
+  std::string topic = (isWorld ? "/world/" : "/model/") + name->Data() +
+      "/joint_cmd";
+  topic = transport::TopicUtils::AsValidTopic(
+      _sdf->Get<std::string>("topic", topic).first);
+  if (topic.empty())
+  {
+    gzerr << "Failed to create a topic for MultiJointController."
+           << std::endl;
+    this->dataPtr->axes.clear();
+    return;
+  }
+  this->dataPtr->node.Subscribe(topic, &MultiJointControllerPrivate::OnCmd,
+      this->dataPtr.get());
+  this->dataPtr->entity = _entity;
+
+  gzmsg << "MultiJointController controlling the " << controlType << " of ["
+         << count << "] axes, subscribing to Double_V messages on [" << topic
+         << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+bool MultiJointControllerPrivate::FindJoints(EntityComponentManager &_ecm)
+{
+  for (auto &axis : this->axes)
+  {
+    if (axis.joint != kNullEntity)
+      continue;
+
+    auto entities = entitiesFromScopedName(axis.name, _ecm, this->entity);
+    for (const Entity &candidate : entities)
+    {
+      if (_ecm.EntityHasComponentType(candidate, components::Joint::typeId))
+      {
+        axis.joint = candidate;
+        break;
+      }
+    }
+    if (axis.joint == kNullEntity)
+    {
+      if (!this->warned)
+      {
+        gzwarn << "Failed to find joint [" << axis.name << "]" << std::endl;
+        this->warned = true;
+      }
+      continue;
+    }
+
+    // Create the components the axis needs if they don't exist
+    if (this->controlVelocity)
+    {
+      if (!_ecm.Component<components::JointVelocity>(axis.joint))
+        _ecm.CreateComponent(axis.joint, components::JointVelocity());
+      axis.velocity = _ecm.Handle<components::JointVelocity>(axis.joint);
+    }
+    else
+    {
+      if (!_ecm.Component<components::JointPosition>(axis.joint))
+        _ecm.CreateComponent(axis.joint, components::JointPosition());
+      axis.position = _ecm.Handle<components::JointPosition>(axis.joint);
+    }
+    if (!_ecm.Component<components::JointForceCmd>(axis.joint))
+      _ecm.CreateComponent(axis.joint, components::JointForceCmd());
+    axis.forceCmd = _ecm.Handle<components::JointForceCmd>(axis.joint);
+  }
+
+  for (const auto &axis : this->axes)
+  {
+    if (axis.joint == kNullEntity)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MultiJointController::PreUpdate(
+    const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("MultiJointController::PreUpdate");
+
+  if (kNullEntity == this->dataPtr->entity)
+    return;
+
+  if (!_ecm.HasEntity(this->dataPtr->entity))
+  {
+    gzwarn << "MultiJointController entity no longer valid. "
+           << "Disabling plugin." << std::endl;
+    this->dataPtr->entity = kNullEntity;
+    return;
+  }
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    gzwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  // If the joints haven't been identified yet, look for them
+  if (!this->dataPtr->jointsFound)
+  {
+    this->dataPtr->jointsFound = this->dataPtr->FindJoints(_ecm);
+    if (!this->dataPtr->jointsFound)
+      return;
+  }
+
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->targetsMutex);
+    if (this->dataPtr->hasNewTargets)
+    {
+      this->dataPtr->targets.swap(this->dataPtr->newTargets);
+      this->dataPtr->hasNewTargets = false;
+    }
+  }
+
+  // Gather the errors. Axes whose state isn't known yet, because the physics
+  // system hasn't filled it, get a zero command.
+  auto &axes = this->dataPtr->axes;
+  for (std::size_t k = 0u; k < axes.size(); ++k)
+  {
+    const std::vector<double> *state{nullptr};
+    if (this->dataPtr->controlVelocity)
+    {
+      if (auto velocity = axes[k].velocity.Get())
+        state = &velocity->Data();
+    }
+    else if (auto position = axes[k].position.Get())
+    {
+      state = &position->Data();
+    }
+    this->dataPtr->errors[k] = state && axes[k].index < state->size() ?
+        (*state)[axes[k].index] - this->dataPtr->targets[k] :
+        std::numeric_limits<double>::quiet_NaN();
+  }
+
+  this->dataPtr->pids.Update(this->dataPtr->errors.data(),
+      std::chrono::duration<double>(_info.dt).count(),
+      this->dataPtr->outputs.data());
+
+  // Scatter the outputs
+  for (std::size_t k = 0u; k < axes.size(); ++k)
+  {
+    auto *forceCmd = axes[k].forceCmd.Get();
+    if (!forceCmd)
+      continue;
+    auto &forces = forceCmd->Data();
+    if (forces.size() <= axes[k].index)
+      forces.resize(axes[k].index + 1u, 0.0);
+    forces[axes[k].index] = this->dataPtr->outputs[k];
+  }
+}
+
+//////////////////////////////////////////////////
+void MultiJointControllerPrivate::OnCmd(const msgs::Double_V &_msg)
+{
+  if (static_cast<std::size_t>(_msg.data_size()) != this->axes.size())
+  {
+    gzerr << "MultiJointController received [" << _msg.data_size()
+           << "] targets, expected [" << this->axes.size() << "]. Ignoring."
+           << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->targetsMutex);
+  this->newTargets.assign(_msg.data().begin(), _msg.data().end());
+  this->hasNewTargets = true;
+}
+
+GZ_ADD_PLUGIN(MultiJointController,
+                    System,
+                    MultiJointController::ISystemConfigure,
+                    MultiJointController::ISystemPreUpdate)
+
+GZ_ADD_PLUGIN_ALIAS(MultiJointController,
+                          "gz::sim::systems::MultiJointController")
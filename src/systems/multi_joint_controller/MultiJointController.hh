@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_MULTIJOINTCONTROLLER_HH_
+#define GZ_SIM_SYSTEMS_MULTIJOINTCONTROLLER_HH_
+
+#include <memory>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declaration
+  class MultiJointControllerPrivate;
+
+  /// \brief PID controller of any number of joint axes, which replaces one
+  /// JointPositionController or JointController instance per joint. The
+  /// gains and states of all controllers are stored in packed arrays and
+  /// updated in a single pass, and the targets of all axes are received
+  /// together.
+  ///
+  /// The controller subscribes to gz::msgs::Double_V messages holding the
+  /// target of each controlled axis, in the order of the `<joint>` elements.
+  /// Messages of another size are ignored. The default topic is
+  /// "/model/<model_name>/joint_cmd", or "/world/<world_name>/joint_cmd" when
+  /// attached to a world. The output of each PID is applied as a force
+  /// command on its axis.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<joint>` An axis to control. Required, and can be repeated. It holds:
+  ///   - `<name>` Scoped name of the joint, relative to the entity the
+  ///     system is attached to. Required.
+  ///   - `<index>` Axis of the joint. The default value is 0.
+  ///   - `<initial_target>` Target before the first command. The default
+  ///     value is 0.
+  ///   - Any of the gains below, overriding the system-wide gain for this
+  ///     axis.
+  ///
+  /// - `<control_type>` "position" to control joint positions, or
+  /// "velocity" to control joint velocities. The default is "position".
+  ///
+  /// - `<topic>` Topic of the targets.
+  ///
+  /// - `<p_gain>` The proportional gain of the PIDs. The default value is 1.
+  ///
+  /// - `<i_gain>` The integral gain of the PIDs. The default value is 0.1.
+  ///
+  /// - `<d_gain>` The derivative gain of the PIDs. The default value is 0.01.
+  ///
+  /// - `<i_max>` The integral upper limit of the PIDs. The default value is
+  /// 1.
+  ///
+  /// - `<i_min>` The integral lower limit of the PIDs. The default value is
+  /// -1.
+  ///
+  /// - `<cmd_max>` Output max value of the PIDs. The default value is 1000.
+  ///
+  /// - `<cmd_min>` Output min value of the PIDs. The default value is -1000.
+  ///
+  /// - `<cmd_offset>` Command offset (feed-forward) of the PIDs. The default
+  /// value is 0.
+  class MultiJointController
+      : public System,
+        public ISystemConfigure,
+        public ISystemPreUpdate
+  {
+    /// \brief Constructor
+    public: MultiJointController();
+
+    /// \brief Destructor
+    public: ~MultiJointController() override = default;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) override;
+
+    // Documentation inherited
+    public: void PreUpdate(
+                const gz::sim::UpdateInfo &_info,
+                gz::sim::EntityComponentManager &_ecm) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<MultiJointControllerPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_MULTI_JOINT_CONTROLLER_PIDARRAY_HH_
+#define GZ_SIM_SYSTEMS_MULTI_JOINT_CONTROLLER_PIDARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace multi_joint_controller
+{
+/// \brief Gains of a PID controller, with the meaning and defaults of
+/// math::PID.
+struct PidGains
+{
+  /// \brief Proportional gain.
+  double p{0.0};
+
+  /// \brief Integral gain.
+  double i{0.0};
+
+  /// \brief Derivative gain.
+  double d{0.0};
+
+  /// \brief Integral upper limit, ignored if lower than iMin.
+  double iMax{-1.0};
+
+  /// \brief Integral lower limit.
+  double iMin{0.0};
+
+  /// \brief Output upper limit, ignored if lower than cmdMin.
+  double cmdMax{-1.0};
+
+  /// \brief Output lower limit.
+  double cmdMin{0.0};
+
+  /// \brief Output offset (feed-forward).
+  double cmdOffset{0.0};
+};
+
+/// \brief A set of PID controllers, whose gains and states are stored as
+/// packed arrays so that all of them are updated in one pass over
+/// contiguous memory, instead of one math::PID object and one call each.
+///
+/// Each controller computes the same output as math::PID::Update.
+class PidArray
+{
+  /// \brief Set the number of controllers. New controllers have default
+  /// gains and a reset state.
+  /// \param[in] _size Number of controllers.
+  public: void Resize(std::size_t _size)
+  {
+    this->p.resize(_size, 0.0);
+    this->i.resize(_size, 0.0);
+    this->d.resize(_size, 0.0);
+    this->iMax.resize(_size, -1.0);
+    this->iMin.resize(_size, 0.0);
+    this->cmdMax.resize(_size, -1.0);
+    this->cmdMin.resize(_size, 0.0);
+    this->cmdOffset.resize(_size, 0.0);
+    this->iErr.resize(_size, 0.0);
+    this->pErrLast.resize(_size, 0.0);
+  }
+
+  /// \brief Get the number of controllers.
+  /// \return Number of controllers.
+  public: std::size_t Size() const
+  {
+    return this->p.size();
+  }
+
+  /// \brief Set the gains of a controller.
+  /// \param[in] _index Index of the controller.
+  /// \param[in] _gains Its gains.
+  public: void SetGains(std::size_t _index, const PidGains &_gains)
+  {
+    this->p[_index] = _gains.p;
+    this->i[_index] = _gains.i;
+    this->d[_index] = _gains.d;
+    this->iMax[_index] = _gains.iMax;
+    this->iMin[_index] = _gains.iMin;
+    this->cmdMax[_index] = _gains.cmdMax;
+    this->cmdMin[_index] = _gains.cmdMin;
+    this->cmdOffset[_index] = _gains.cmdOffset;
+  }
+
+  /// \brief Get the gains of a controller.
+  /// \param[in] _index Index of the controller.
+  /// \return Its gains.
+  public: PidGains Gains(std::size_t _index) const
+  {
+    return {this->p[_index], this->i[_index], this->d[_index],
+        this->iMax[_index], this->iMin[_index], this->cmdMax[_index],
+        this->cmdMin[_index], this->cmdOffset[_index]};
+  }
+
+  /// \brief Reset the integral and derivative states of all controllers.
+  public: void Reset()
+  {
+    std::fill(this->iErr.begin(), this->iErr.end(), 0.0);
+    std::fill(this->pErrLast.begin(), this->pErrLast.end(), 0.0);
+  }
+
+  /// \brief Update all controllers.
+  /// \param[in] _errors Error of each controller, Size() values. The output
+  /// of controllers whose error isn't finite is 0, and their state isn't
+  /// updated.
+  /// \param[in] _dt Time step [s]. Outputs are 0 if it isn't positive.
+  /// \param[out] _outputs Output of each controller, Size() values.
+  public: void Update(const double *_errors, double _dt,
+                      double *_outputs)
+  {
+    const std::size_t size = this->Size();
+    if (!(_dt > 0.0))
+    {
+      std::fill(_outputs, _outputs + size, 0.0);
+      return;
+    }
+
+    const double inverseDt = 1.0 / _dt;
+    for (std::size_t k = 0u; k < size; ++k)
+    {
+      const double error = _errors[k];
+      if (!std::isfinite(error))
+      {
+        _outputs[k] = 0.0;
+        continue;
+      }
+
+      double integral = this->iErr[k] + this->i[k] * _dt * error;
+      if (this->iMax[k] >= this->iMin[k])
+        integral = std::clamp(integral, this->iMin[k], this->iMax[k]);
+      this->iErr[k] = integral;
+
+      const double derivative = (error - this->pErrLast[k]) * inverseDt;
+      this->pErrLast[k] = error;
+
+      double cmd = this->cmdOffset[k] - this->p[k] * error - integral -
+          this->d[k] * derivative;
+      if (this->cmdMax[k] >= this->cmdMin[k])
+        cmd = std::clamp(cmd, this->cmdMin[k], this->cmdMax[k]);
+      _outputs[k] = cmd;
+    }
+  }
+
+  /// \brief Proportional gains.
+  private: std::vector<double> p;
+
+  /// \brief Integral gains.
+  private: std::vector<double> i;
+
+  /// \brief Derivative gains.
+  private: std::vector<double> d;
+
+  /// \brief Integral upper limits.
+  private: std::vector<double> iMax;
+
+  /// \brief Integral lower limits.
+  private: std::vector<double> iMin;
+
+  /// \brief Output upper limits.
+  private: std::vector<double> cmdMax;
+
+  /// \brief Output lower limits.
+  private: std::vector<double> cmdMin;
+
+  /// \brief Output offsets.
+  private: std::vector<double> cmdOffset;
+
+  /// \brief Integral terms.
+  private: std::vector<double> iErr;
+
+  /// \brief Errors of the previous update.
+  private: std::vector<double> pErrLast;
+};
+}
+}
+}
+}
+}
+
+#endif
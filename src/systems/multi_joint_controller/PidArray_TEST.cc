@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "PidArray.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::multi_joint_controller;
+
+/////////////////////////////////////////////////
+TEST(PidArray, Gains)
+{
+  PidArray pids;
+  pids.Resize(2u);
+  EXPECT_EQ(2u, pids.Size());
+  EXPECT_DOUBLE_EQ(0.0, pids.Gains(1u).p);
+  EXPECT_DOUBLE_EQ(-1.0, pids.Gains(1u).cmdMax);
+
+  pids.SetGains(1u, {1.0, 2.0, 3.0, 4.0, -4.0, 5.0, -5.0, 6.0});
+  const PidGains gains = pids.Gains(1u);
+  EXPECT_DOUBLE_EQ(1.0, gains.p);
+  EXPECT_DOUBLE_EQ(2.0, gains.i);
+  EXPECT_DOUBLE_EQ(3.0, gains.d);
+  EXPECT_DOUBLE_EQ(4.0, gains.iMax);
+  EXPECT_DOUBLE_EQ(-4.0, gains.iMin);
+  EXPECT_DOUBLE_EQ(5.0, gains.cmdMax);
+  EXPECT_DOUBLE_EQ(-5.0, gains.cmdMin);
+  EXPECT_DOUBLE_EQ(6.0, gains.cmdOffset);
+  EXPECT_DOUBLE_EQ(0.0, pids.Gains(0u).p);
+}
+
+/////////////////////////////////////////////////
+TEST(PidArray, Update)
+{
+  PidArray pids;
+  pids.Resize(3u);
+
+  // Proportional only, integral and derivative with limits, and offset
+  pids.SetGains(0u, {2.0, 0.0, 0.0, -1.0, 0.0, -1.0, 0.0, 0.0});
+  pids.SetGains(1u, {1.0, 10.0, 0.5, 0.3, -0.3, 100.0, -100.0, 0.0});
+  pids.SetGains(2u, {1.0, 0.0, 0.0, -1.0, 0.0, 1.0, -1.0, 0.5});
+
+  const double dt = 0.1;
+  std::vector<double> outputs(3u);
+  std::vector<double> errors{1.0, 1.0, -0.2};
+  pids.Update(errors.data(), dt, outputs.data());
+  EXPECT_DOUBLE_EQ(-2.0, outputs[0]);
+  // p = 1, i = 10 * 0.1 * 1 clamped to 0.3, d = 0.5 * 1 / 0.1
+  EXPECT_DOUBLE_EQ(-1.0 - 0.3 - 5.0, outputs[1]);
+  EXPECT_DOUBLE_EQ(0.7, outputs[2]);
+
+  errors = {-1.0, 0.5, -10.0};
+  pids.Update(errors.data(), dt, outputs.data());
+  EXPECT_DOUBLE_EQ(2.0, outputs[0]);
+  // i = 0.3 + 10 * 0.1 * 0.5 clamped to 0.3, d = 0.5 * (0.5 - 1) / 0.1
+  EXPECT_NEAR(-0.5 - 0.3 + 2.5, outputs[1], 1e-12);
+  // Output clamped
+  EXPECT_DOUBLE_EQ(1.0, outputs[2]);
+
+  // Non finite errors and time steps
+  errors = {std::numeric_limits<double>::quiet_NaN(), 0.5, 0.0};
+  pids.Update(errors.data(), 0.0, outputs.data());
+  EXPECT_DOUBLE_EQ(0.0, outputs[1]);
+  pids.Update(errors.data(), dt, outputs.data());
+  EXPECT_DOUBLE_EQ(0.0, outputs[0]);
+  EXPECT_NEAR(-0.5 - 0.3, outputs[1], 1e-12);
+
+  // After a reset, the derivative starts from zero again
+  pids.Reset();
+  errors = {0.0, 1.0, 0.0};
+  pids.Update(errors.data(), dt, outputs.data());
+  EXPECT_DOUBLE_EQ(-1.0 - 0.3 - 5.0, outputs[1]);
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_MULTICOPTER_MOTOR_MODEL_MOTORBATCH_HH_
+#define GZ_SIM_SYSTEMS_MULTICOPTER_MOTOR_MODEL_MOTORBATCH_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace multicopter_motor_model
+{
+/// \brief Parameters of a rotor, as loaded by the MulticopterMotorModel
+/// system.
+struct Motor
+{
+  /// \brief 1 for counter clockwise rotors, -1 for clockwise ones.
+  int turningDirection{-1};
+
+  /// \brief Thrust coefficient [N / (rad/s)^2].
+  double motorConstant{8.54858e-06};
+
+  /// \brief Drag torque per thrust [m].
+  double momentConstant{0.016};
+
+  /// \brief Rotor drag coefficient [N / (m/s^2)].
+  double rotorDragCoefficient{1.0e-4};
+
+  /// \brief Rolling moment coefficient [N*m / (m/s^2)].
+  double rollingMomentCoefficient{1.0e-6};
+
+  /// \brief Ratio of the rotor velocity to the simulated joint velocity.
+  double rotorVelocitySlowdownSim{10.0};
+
+  /// \brief Time constant of the rotor acceleration [s].
+  double timeConstantUp{1.0 / 80.0};
+
+  /// \brief Time constant of the rotor deceleration [s].
+  double timeConstantDown{1.0 / 40.0};
+};
+
+/// \brief Thrust, drag, moments and rotor dynamics of many rotors,
+/// evaluated together.
+///
+/// The parameters, the state of the rotor filters and the inputs of a step
+/// are stored in contiguous arrays, one per component, and Evaluate
+/// computes every rotor in a single loop over them, without branches, which
+/// the compiler can vectorize. The results match MulticopterMotorModel's
+/// per-rotor evaluation.
+class MotorBatch
+{
+  /// \brief Get the number of rotors.
+  /// \return Number of rotors.
+  public: std::size_t Size() const
+  {
+    return this->direction.size();
+  }
+
+  /// \brief Add a rotor at the end of the batch, at rest.
+  /// \param[in] _motor Parameters of the rotor.
+  public: void Add(const Motor &_motor)
+  {
+    this->direction.push_back(_motor.turningDirection);
+    this->motorConstant.push_back(_motor.motorConstant);
+    this->momentConstant.push_back(_motor.momentConstant);
+    this->dragCoefficient.push_back(_motor.rotorDragCoefficient);
+    this->rollingCoefficient.push_back(_motor.rollingMomentCoefficient);
+    this->slowdown.push_back(_motor.rotorVelocitySlowdownSim);
+    this->timeConstantUp.push_back(_motor.timeConstantUp);
+    this->timeConstantDown.push_back(_motor.timeConstantDown);
+
+    this->reference.push_back(0.0);
+    this->filtered.push_back(0.0);
+    this->jointVelocity.push_back(0.0);
+    this->thrustAxis.Add();
+    this->torqueAxis.Add();
+    this->jointAxis.Add();
+    this->airVelocity.Add();
+    this->force.Add();
+    this->torque.Add();
+    this->command.push_back(0.0);
+    this->active.push_back(0);
+  }
+
+  /// \brief Remove a rotor. The last rotor takes its index, with its state.
+  /// \param[in] _index Index of the rotor.
+  public: void Remove(std::size_t _index)
+  {
+    if (_index >= this->Size())
+      return;
+    swapRemove(this->direction, _index);
+    swapRemove(this->motorConstant, _index);
+    swapRemove(this->momentConstant, _index);
+    swapRemove(this->dragCoefficient, _index);
+    swapRemove(this->rollingCoefficient, _index);
+    swapRemove(this->slowdown, _index);
+    swapRemove(this->timeConstantUp, _index);
+    swapRemove(this->timeConstantDown, _index);
+
+    swapRemove(this->reference, _index);
+    swapRemove(this->filtered, _index);
+    swapRemove(this->jointVelocity, _index);
+    this->thrustAxis.Remove(_index);
+    this->torqueAxis.Remove(_index);
+    this->jointAxis.Remove(_index);
+    this->airVelocity.Remove(_index);
+    this->force.Remove(_index);
+    this->torque.Remove(_index);
+    swapRemove(this->command, _index);
+    swapRemove(this->active, _index);
+  }
+
+  /// \brief Set the reference input of a rotor, which its filtered
+  /// velocity follows.
+  /// \param[in] _index Index of the rotor.
+  /// \param[in] _reference Reference rotor velocity [rad/s].
+  public: void SetReference(std::size_t _index, double _reference)
+  {
+    this->reference[_index] = _reference;
+  }
+
+  /// \brief Set the state of a rotor at this step. Only rotors with a state
+  /// are evaluated by the next Evaluate.
+  /// \param[in] _index Index of the rotor.
+  /// \param[in] _jointVelocity Simulated velocity of the rotor joint.
+  /// \param[in] _thrustAxis World direction of the thrust, the z axis of
+  /// the rotor link.
+  /// \param[in] _torqueAxis World direction of the drag torque, the z axis
+  /// of the rotor link through the frame of its parent link.
+  /// \param[in] _jointAxis World axis of the rotor joint.
+  /// \param[in] _airVelocity World velocity of the rotor link relative to
+  /// the wind.
+  public: void SetState(std::size_t _index, double _jointVelocity,
+              const math::Vector3d &_thrustAxis,
+              const math::Vector3d &_torqueAxis,
+              const math::Vector3d &_jointAxis,
+              const math::Vector3d &_airVelocity)
+  {
+    this->jointVelocity[_index] = _jointVelocity;
+    this->thrustAxis.Set(_index, _thrustAxis);
+    this->torqueAxis.Set(_index, _torqueAxis);
+    this->jointAxis.Set(_index, _jointAxis);
+    this->airVelocity.Set(_index, _airVelocity);
+    this->active[_index] = 1;
+  }
+
+  /// \brief Evaluate every rotor with a state at this step, and advance its
+  /// filter. The filters of the other rotors keep their state.
+  /// \param[in] _dt Time step [s].
+  public: void Evaluate(double _dt)
+  {
+    const std::size_t count = this->Size();
+    const double *tax = this->thrustAxis.x.data();
+    const double *tay = this->thrustAxis.y.data();
+    const double *taz = this->thrustAxis.z.data();
+    const double *qax = this->torqueAxis.x.data();
+    const double *qay = this->torqueAxis.y.data();
+    const double *qaz = this->torqueAxis.z.data();
+    const double *jax = this->jointAxis.x.data();
+    const double *jay = this->jointAxis.y.data();
+    const double *jaz = this->jointAxis.z.data();
+    const double *avx = this->airVelocity.x.data();
+    const double *avy = this->airVelocity.y.data();
+    const double *avz = this->airVelocity.z.data();
+    double *fx = this->force.x.data();
+    double *fy = this->force.y.data();
+    double *fz = this->force.z.data();
+    double *tx = this->torque.x.data();
+    double *ty = this->torque.y.data();
+    double *tz = this->torque.z.data();
+
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+      // Thrust of a symmetric propeller
+      const double real = this->jointVelocity[i] * this->slowdown[i];
+      const double sign = (real > 0) - (real < 0);
+      const double direction = this->direction[i];
+      const double thrust =
+          direction * sign * real * real * this->motorConstant[i];
+
+      // Velocity of the air perpendicular to the rotor
+      const double along = avx[i] * jax[i] + avy[i] * jay[i] +
+          avz[i] * jaz[i];
+      const double px = avx[i] - along * jax[i];
+      const double py = avy[i] - along * jay[i];
+      const double pz = avz[i] - along * jaz[i];
+
+      // Thrust and air drag on the rotor link
+      const double drag = -std::abs(real) * this->dragCoefficient[i];
+      fx[i] = thrust * tax[i] + drag * px;
+      fy[i] = thrust * tay[i] + drag * py;
+      fz[i] = thrust * taz[i] + drag * pz;
+
+      // Drag torque and rolling moment on the parent link
+      const double dragTorque = -direction * thrust * this->momentConstant[i];
+      const double rolling = -std::abs(real) * this->rollingCoefficient[i];
+      tx[i] = dragTorque * qax[i] + rolling * px;
+      ty[i] = dragTorque * qay[i] + rolling * py;
+      tz[i] = dragTorque * qaz[i] + rolling * pz;
+
+      // First order filter on the rotor velocity, with different time
+      // constants to accelerate and decelerate
+      const double timeConstant = this->reference[i] > this->filtered[i] ?
+          this->timeConstantUp[i] : this->timeConstantDown[i];
+      const double alpha = std::exp(-_dt / timeConstant);
+      const double next = alpha * this->filtered[i] +
+          (1 - alpha) * this->reference[i];
+      this->filtered[i] = this->active[i] ? next : this->filtered[i];
+      this->command[i] = direction * this->filtered[i] / this->slowdown[i];
+      this->active[i] = 0;
+    }
+  }
+
+  /// \brief Get the world force on a rotor link, computed by the last
+  /// Evaluate.
+  /// \param[in] _index Index of the rotor.
+  /// \return Force [N].
+  public: math::Vector3d Force(std::size_t _index) const
+  {
+    return this->force.Get(_index);
+  }
+
+  /// \brief Get the world torque on the parent link of a rotor, computed by
+  /// the last Evaluate.
+  /// \param[in] _index Index of the rotor.
+  /// \return Torque [N*m].
+  public: math::Vector3d Torque(std::size_t _index) const
+  {
+    return this->torque.Get(_index);
+  }
+
+  /// \brief Get the velocity command of a rotor joint, computed by the last
+  /// Evaluate.
+  /// \param[in] _index Index of the rotor.
+  /// \return Joint velocity command [rad/s].
+  public: double VelocityCommand(std::size_t _index) const
+  {
+    return this->command[_index];
+  }
+
+  /// \brief Move the last element of an array to an index, and shrink it.
+  /// \param[in, out] _values The array.
+  /// \param[in] _index Index to overwrite.
+  private: template<typename T>
+  static void swapRemove(std::vector<T> &_values, std::size_t _index)
+  {
+    _values[_index] = _values.back();
+    _values.pop_back();
+  }
+
+  /// \brief World vectors of the rotors, one array per component.
+  private: struct Vectors
+  {
+    /// \brief Add a zero vector.
+    void Add()
+    {
+      this->x.push_back(0.0);
+      this->y.push_back(0.0);
+      this->z.push_back(0.0);
+    }
+
+    /// \brief Remove a vector. The last vector takes its index.
+    /// \param[in] _index Index of the vector.
+    void Remove(std::size_t _index)
+    {
+      swapRemove(this->x, _index);
+      swapRemove(this->y, _index);
+      swapRemove(this->z, _index);
+    }
+
+    /// \brief Set a vector.
+    /// \param[in] _index Index of the vector.
+    /// \param[in] _value New value.
+    void Set(std::size_t _index, const math::Vector3d &_value)
+    {
+      this->x[_index] = _value.X();
+      this->y[_index] = _value.Y();
+      this->z[_index] = _value.Z();
+    }
+
+    /// \brief Get a vector.
+    /// \param[in] _index Index of the vector.
+    /// \return The vector.
+    math::Vector3d Get(std::size_t _index) const
+    {
+      return {this->x[_index], this->y[_index], this->z[_index]};
+    }
+
+    /// \brief X components.
+    std::vector<double> x;
+
+    /// \brief Y components.
+    std::vector<double> y;
+
+    /// \brief Z components.
+    std::vector<double> z;
+  };
+
+  /// \brief Turning direction of each rotor.
+  private: std::vector<double> direction;
+
+  /// \brief Thrust coefficient of each rotor.
+  private: std::vector<double> motorConstant;
+
+  /// \brief Moment constant of each rotor.
+  private: std::vector<double> momentConstant;
+
+  /// \brief Rotor drag coefficient of each rotor.
+  private: std::vector<double> dragCoefficient;
+
+  /// \brief Rolling moment coefficient of each rotor.
+  private: std::vector<double> rollingCoefficient;
+
+  /// \brief Velocity slowdown of each rotor.
+  private: std::vector<double> slowdown;
+
+  /// \brief Acceleration time constant of each rotor.
+  private: std::vector<double> timeConstantUp;
+
+  /// \brief Deceleration time constant of each rotor.
+  private: std::vector<double> timeConstantDown;
+
+  /// \brief Reference velocity of each rotor.
+  private: std::vector<double> reference;
+
+  /// \brief Filtered velocity of each rotor.
+  private: std::vector<double> filtered;
+
+  /// \brief Simulated joint velocity of each rotor.
+  private: std::vector<double> jointVelocity;
+
+  /// \brief World thrust direction of each rotor.
+  private: Vectors thrustAxis;
+
+  /// \brief World drag torque direction of each rotor.
+  private: Vectors torqueAxis;
+
+  /// \brief World joint axis of each rotor.
+  private: Vectors jointAxis;
+
+  /// \brief World air velocity of each rotor.
+  private: Vectors airVelocity;
+
+  /// \brief Force on each rotor link.
+  private: Vectors force;
+
+  /// \brief Torque on the parent link of each rotor.
+  private: Vectors torque;
+
+  /// \brief Joint velocity command of each rotor.
+  private: std::vector<double> command;
+
+  /// \brief Whether each rotor has a state at this step.
+  private: std::vector<char> active;
+};
+}
+}
+}
+}
+}
+
+#endif
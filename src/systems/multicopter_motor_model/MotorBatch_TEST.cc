@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+
+#include "MotorBatch.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::multicopter_motor_model;
+
+/// \brief State of a rotor which the test keeps, as the system does.
+struct Rotor
+{
+  /// \brief Parameters.
+  Motor motor;
+
+  /// \brief State of the first order filter.
+  double filtered{0.0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Evaluate a rotor as the MulticopterMotorModel system does.
+/// \param[in, out] _rotor The rotor.
+/// \param[in] _jointVelocity Simulated joint velocity.
+/// \param[in] _reference Reference rotor velocity.
+/// \param[in] _link World rotation of the rotor link.
+/// \param[in] _parent World rotation of the parent link.
+/// \param[in] _joint Rotation of the joint in the rotor link.
+/// \param[in] _axis Joint axis in the joint frame.
+/// \param[in] _air Velocity of the rotor link relative to the wind.
+/// \param[in] _dt Time step.
+/// \param[out] _force Force on the rotor link.
+/// \param[out] _torque Torque on the parent link.
+/// \return Joint velocity command.
+double reference(Rotor &_rotor, double _jointVelocity, double _reference,
+    const math::Quaterniond &_link, const math::Quaterniond &_parent,
+    const math::Quaterniond &_joint, const math::Vector3d &_axis,
+    const math::Vector3d &_air, double _dt,
+    math::Vector3d &_force, math::Vector3d &_torque)
+{
+  const auto &m = _rotor.motor;
+  const double realMotorVelocity =
+      _jointVelocity * m.rotorVelocitySlowdownSim;
+  const int realMotorVelocitySign =
+      (realMotorVelocity > 0) - (realMotorVelocity < 0);
+  const double thrust = m.turningDirection * realMotorVelocitySign *
+      realMotorVelocity * realMotorVelocity * m.motorConstant;
+  _force = _link.RotateVector(math::Vector3d(0, 0, thrust));
+
+  const auto jointAxis = (_link * _joint).RotateVector(_axis);
+  const auto perpendicular = _air - (_air.Dot(jointAxis) * jointAxis);
+  _force += -std::abs(realMotorVelocity) * m.rotorDragCoefficient *
+      perpendicular;
+
+  const auto difference = _parent.Inverse() * _link;
+  const math::Vector3d dragTorque(
+      0, 0, -m.turningDirection * thrust * m.momentConstant);
+  _torque = _parent.RotateVector(difference.RotateVector(dragTorque));
+  _torque += -std::abs(realMotorVelocity) * m.rollingMomentCoefficient *
+      perpendicular;
+
+  double alpha;
+  if (_reference > _rotor.filtered)
+    alpha = std::exp(-_dt / m.timeConstantUp);
+  else
+    alpha = std::exp(-_dt / m.timeConstantDown);
+  _rotor.filtered = alpha * _rotor.filtered + (1 - alpha) * _reference;
+  return m.turningDirection * _rotor.filtered / m.rotorVelocitySlowdownSim;
+}
+
+/////////////////////////////////////////////////
+TEST(MotorBatch, Reference)
+{
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  auto vector = [&](double _scale)
+  {
+    return math::Vector3d(value(generator), value(generator),
+        value(generator)) * _scale;
+  };
+  auto rotation = [&]()
+  {
+    return math::Quaterniond(value(generator), value(generator),
+        GZ_PI * value(generator));
+  };
+
+  std::vector<Rotor> rotors(24);
+  MotorBatch batch;
+  for (std::size_t i = 0; i < rotors.size(); ++i)
+  {
+    auto &m = rotors[i].motor;
+    m.turningDirection = i % 2 == 0 ? 1 : -1;
+    m.motorConstant *= 1.0 + 0.2 * value(generator);
+    m.momentConstant *= 1.0 + 0.2 * value(generator);
+    m.rotorDragCoefficient *= 1.0 + 0.2 * value(generator);
+    m.rollingMomentCoefficient *= 1.0 + 0.2 * value(generator);
+    m.timeConstantUp *= 1.0 + 0.2 * value(generator);
+    m.timeConstantDown *= 1.0 + 0.2 * value(generator);
+    batch.Add(m);
+  }
+  ASSERT_EQ(rotors.size(), batch.Size());
+
+  const double dt = 0.004;
+  const std::size_t count = rotors.size();
+  for (int step = 0; step < 20; ++step)
+  {
+    std::vector<math::Vector3d> expectedForces(count);
+    std::vector<math::Vector3d> expectedTorques(count);
+    std::vector<double> expectedCommands(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const double jointVelocity = 80.0 * value(generator);
+      // Speed up, then slow down
+      const double target = step < 10 ? 700.0 + 100.0 * value(generator) :
+          100.0 * value(generator);
+      const auto link = rotation();
+      const auto parent = rotation();
+      const auto joint = rotation();
+      const math::Vector3d axis(0, 0, 1);
+      const auto air = vector(10.0);
+
+      expectedCommands[i] = reference(rotors[i], jointVelocity, target,
+          link, parent, joint, axis, air, dt, expectedForces[i],
+          expectedTorques[i]);
+
+      batch.SetReference(i, target);
+      batch.SetState(i, jointVelocity,
+          link.RotateVector(math::Vector3d(0, 0, 1)),
+          parent.RotateVector((parent.Inverse() * link).RotateVector(
+              math::Vector3d(0, 0, 1))),
+          (link * joint).RotateVector(axis), air);
+    }
+
+    batch.Evaluate(dt);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto force = batch.Force(i);
+      const auto torque = batch.Torque(i);
+      for (std::size_t k = 0; k < 3u; ++k)
+      {
+        EXPECT_NEAR(expectedForces[i][k], force[k],
+            1e-12 * (1 + std::abs(expectedForces[i][k])))
+            << "step " << step << ", rotor " << i;
+        EXPECT_NEAR(expectedTorques[i][k], torque[k],
+            1e-12 * (1 + std::abs(expectedTorques[i][k])))
+            << "step " << step << ", rotor " << i;
+      }
+      EXPECT_NEAR(expectedCommands[i], batch.VelocityCommand(i), 1e-12);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MotorBatch, Filter)
+{
+  Motor motor;
+  MotorBatch batch;
+  batch.Add(motor);
+  batch.Add(motor);
+  auto rest = [&batch](std::size_t _index)
+  {
+    batch.SetState(_index, 0.0, math::Vector3d::UnitZ,
+        math::Vector3d::UnitZ, math::Vector3d::UnitZ, math::Vector3d::Zero);
+  };
+
+  // A rotor follows its reference faster up than down, and rotors without
+  // a state keep theirs
+  batch.SetReference(0u, 100.0);
+  batch.SetReference(1u, 100.0);
+  rest(0u);
+  batch.Evaluate(0.01);
+  const double up = batch.VelocityCommand(0u) * motor.turningDirection *
+      motor.rotorVelocitySlowdownSim;
+  EXPECT_NEAR(100.0 * (1 - std::exp(-0.01 / motor.timeConstantUp)), up,
+      1e-9);
+  EXPECT_DOUBLE_EQ(0.0, batch.VelocityCommand(1u));
+
+  batch.SetReference(0u, 0.0);
+  rest(0u);
+  batch.Evaluate(0.01);
+  const double down = batch.VelocityCommand(0u) * motor.turningDirection *
+      motor.rotorVelocitySlowdownSim;
+  EXPECT_NEAR(up * std::exp(-0.01 / motor.timeConstantDown), down, 1e-9);
+
+  // The last rotor takes the index of the removed one, with its state
+  batch.SetReference(1u, 50.0);
+  rest(1u);
+  batch.Evaluate(0.01);
+  const double last = batch.VelocityCommand(1u);
+  batch.Remove(0u);
+  ASSERT_EQ(1u, batch.Size());
+  rest(0u);
+  batch.Evaluate(0.0);
+  EXPECT_DOUBLE_EQ(last, batch.VelocityCommand(0u));
+
+  batch.Remove(3u);
+  EXPECT_EQ(1u, batch.Size());
+}
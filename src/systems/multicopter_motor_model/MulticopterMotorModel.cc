@@ -24,8 +24,13 @@
 
 #include "MulticopterMotorModel.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <gz/msgs/actuators.pb.h>
 
@@ -50,10 +55,13 @@
 #include "gz/sim/components/ParentLinkName.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Wind.hh"
+#include "gz/sim/components/World.hh"
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
 
+#include "MotorBatch.hh"
+
 // from rotors_gazebo_plugins/include/rotors_gazebo_plugins/common.h
 /// \brief    This class can be used to apply a first order filter on a signal.
 ///           It allows different acceleration and deceleration time constants.
@@ -119,6 +127,86 @@ enum class MotorType {
   kForce
 };
 
+/// \brief Motors simulated by the multicopter motor model systems of a
+/// world, so that a world-level instance can drive all of them together.
+struct MulticopterMotorRegistry
+{
+  /// \brief A registered motor.
+  struct Entry
+  {
+    /// \brief Data of the motor's system.
+    MulticopterMotorModelPrivate *data;
+
+    /// \brief Unique identifier of the registration.
+    uint64_t id;
+  };
+
+  /// \brief Protects motors and version.
+  std::mutex mutex;
+
+  /// \brief Registered motors.
+  std::vector<Entry> motors;
+
+  /// \brief Incremented whenever motors changes.
+  uint64_t version{0u};
+
+  /// \brief True while a world-level instance drives the motors.
+  std::atomic<bool> batched{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the registry of the world simulated by an ECM.
+/// \param[in] _ecm The Entity Component Manager
+/// \return The registry, shared by the systems of that world.
+std::shared_ptr<MulticopterMotorRegistry> registryFor(
+    const EntityComponentManager &_ecm)
+{
+  static std::mutex mutex;
+  static std::unordered_map<const EntityComponentManager *,
+      std::weak_ptr<MulticopterMotorRegistry>> registries;
+
+  std::lock_guard lock(mutex);
+  for (auto it = registries.begin(); it != registries.end();)
+  {
+    if (it->second.expired())
+      it = registries.erase(it);
+    else
+      ++it;
+  }
+
+  auto &weak = registries[&_ecm];
+  auto registry = weak.lock();
+  if (!registry)
+  {
+    registry = std::make_shared<MulticopterMotorRegistry>();
+    weak = registry;
+  }
+  return registry;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a torque to the wrench applied to a link this step.
+/// \param[in] _ecm The Entity Component Manager
+/// \param[in] _link The link.
+/// \param[in] _torque World torque.
+void addWorldTorque(EntityComponentManager &_ecm, Entity _link,
+    const math::Vector3d &_torque)
+{
+  auto wrenchComp =
+    _ecm.Component<components::ExternalWorldWrenchCmd>(_link);
+  if (!wrenchComp)
+  {
+    components::ExternalWorldWrenchCmd wrench;
+    msgs::Set(wrench.Data().mutable_torque(), _torque);
+    _ecm.CreateComponent(_link, wrench);
+  }
+  else
+  {
+    msgs::Set(wrenchComp->Data().mutable_torque(),
+      msgs::Convert(wrenchComp->Data().torque()) + _torque);
+  }
+}
+
 class gz::sim::systems::MulticopterMotorModelPrivate
 {
   /// \brief Callback for actuator commands.
@@ -127,6 +215,31 @@ class gz::sim::systems::MulticopterMotorModelPrivate
   /// \brief Apply link forces and moments based on propeller state.
   public: void UpdateForcesAndMoments(EntityComponentManager &_ecm);
 
+  /// \brief Look for the joint and links if they haven't been found yet,
+  /// and create the components the update needs.
+  /// \param[in] _ecm The Entity Component Manager
+  /// \return True if the forces and moments can be updated.
+  public: bool Prepare(EntityComponentManager &_ecm);
+
+  /// \brief Update the reference input from the latest actuator command.
+  /// \param[in] _ecm The Entity Component Manager
+  /// \return False if the command has no value for this motor.
+  public: bool UpdateReference(const EntityComponentManager &_ecm);
+
+  /// \brief Get the parameters of the motor, for the batch.
+  /// \return The parameters.
+  public: multicopter_motor_model::Motor BatchMotor() const;
+
+  /// \brief Drive all the registered motors together. Called on the
+  /// world-level instance.
+  /// \param[in] _info Simulation update info
+  /// \param[in] _ecm The Entity Component Manager
+  public: void EvaluateBatch(const UpdateInfo &_info,
+                             EntityComponentManager &_ecm);
+
+  /// \brief Destructor, which unregisters the motor.
+  public: ~MulticopterMotorModelPrivate();
+
   /// \brief Joint Entity
   public: Entity jointEntity;
 
@@ -220,6 +333,28 @@ class gz::sim::systems::MulticopterMotorModelPrivate
 
   /// \brief Gazebo communication node.
   public: transport::Node node;
+
+  /// \brief Registry of the motors of the world.
+  public: std::shared_ptr<MulticopterMotorRegistry> registry;
+
+  /// \brief True if the system is attached to the world rather than to a
+  /// model.
+  public: bool worldLevel{false};
+
+  /// \brief True if this world-level instance drives the motors.
+  public: bool batching{false};
+
+  /// \brief Rotors of the motors, evaluated together.
+  public: multicopter_motor_model::MotorBatch batch;
+
+  /// \brief Registered motors, in the order of the batch.
+  public: std::vector<MulticopterMotorRegistry::Entry> batchMotors;
+
+  /// \brief Version of the registry that batchMotors mirrors.
+  public: uint64_t batchVersion{0u};
+
+  /// \brief Whether each motor is evaluated at this step.
+  public: std::vector<char> batchReady;
 };
 
 //////////////////////////////////////////////////
@@ -234,6 +369,24 @@ void MulticopterMotorModel::Configure(const Entity &_entity,
     EntityComponentManager &_ecm,
     EventManager &/*_eventMgr*/)
 {
+  this->dataPtr->registry = registryFor(_ecm);
+
+  // Attached to the world, the system drives the motors of all the
+  // model-level instances together
+  if (nullptr != _ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->worldLevel = true;
+    if (this->dataPtr->registry->batched.exchange(true))
+    {
+      gzwarn << "MulticopterMotorModel is already attached to the world, "
+             << "ignoring this instance." << std::endl;
+      return;
+    }
+    this->dataPtr->batching = true;
+    gzdbg << "Driving all multicopter motors together." << std::endl;
+    return;
+  }
+
   this->dataPtr->model = Model(_entity);
 
   if (!this->dataPtr->model.Valid(_ecm))
@@ -387,58 +540,73 @@ void MulticopterMotorModel::Configure(const Entity &_entity,
   }
   this->dataPtr->node.Subscribe(topic,
       &MulticopterMotorModelPrivate::OnActuatorMsg, this->dataPtr.get());
+
+  std::lock_guard lock(this->dataPtr->registry->mutex);
+  this->dataPtr->registry->motors.push_back(
+      {this->dataPtr.get(), ++this->dataPtr->registry->version});
 }
 
 //////////////////////////////////////////////////
-void MulticopterMotorModel::PreUpdate(const UpdateInfo &_info,
-    EntityComponentManager &_ecm)
+MulticopterMotorModelPrivate::~MulticopterMotorModelPrivate()
 {
-  GZ_PROFILE("MulticopterMotorModel::PreUpdate");
+  if (!this->registry)
+    return;
+  if (this->batching)
+    this->registry->batched = false;
 
-  // \TODO(anyone) Support rewind
-  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  std::lock_guard lock(this->registry->mutex);
+  auto &motors = this->registry->motors;
+  auto it = std::remove_if(motors.begin(), motors.end(),
+      [this](const MulticopterMotorRegistry::Entry &_entry)
+      {
+        return _entry.data == this;
+      });
+  if (it != motors.end())
   {
-    gzwarn << "Detected jump back in time ["
-        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
-        << "s]. System may not work properly." << std::endl;
+    motors.erase(it, motors.end());
+    ++this->registry->version;
   }
+}
 
+//////////////////////////////////////////////////
+bool MulticopterMotorModelPrivate::Prepare(EntityComponentManager &_ecm)
+{
   // If the joint or links haven't been identified yet, look for them
-  if (this->dataPtr->jointEntity == kNullEntity)
+  if (this->jointEntity == kNullEntity)
   {
-    this->dataPtr->jointEntity =
-        this->dataPtr->model.JointByName(_ecm, this->dataPtr->jointName);
+    this->jointEntity =
+        this->model.JointByName(_ecm, this->jointName);
 
     const auto parentLinkName = _ecm.Component<components::ParentLinkName>(
-        this->dataPtr->jointEntity);
-    this->dataPtr->parentLinkName = parentLinkName->Data();
+        this->jointEntity);
+    this->parentLinkName = parentLinkName->Data();
   }
 
-  if (this->dataPtr->linkEntity == kNullEntity)
+  if (this->linkEntity == kNullEntity)
   {
-    this->dataPtr->linkEntity =
-        this->dataPtr->model.LinkByName(_ecm, this->dataPtr->linkName);
+    this->linkEntity =
+        this->model.LinkByName(_ecm, this->linkName);
   }
 
-  if (this->dataPtr->parentLinkEntity == kNullEntity)
+  if (this->parentLinkEntity == kNullEntity)
   {
-    this->dataPtr->parentLinkEntity =
-        this->dataPtr->model.LinkByName(_ecm, this->dataPtr->parentLinkName);
+    this->parentLinkEntity =
+        this->model.LinkByName(_ecm, this->parentLinkName);
   }
 
-  if (this->dataPtr->jointEntity == kNullEntity ||
-      this->dataPtr->linkEntity == kNullEntity ||
-      this->dataPtr->parentLinkEntity == kNullEntity)
-    return;
+  if (this->jointEntity == kNullEntity ||
+      this->linkEntity == kNullEntity ||
+      this->parentLinkEntity == kNullEntity)
+    return false;
 
   // skip UpdateForcesAndMoments if needed components are missing
   bool doUpdateForcesAndMoments = true;
 
   const auto jointVelocity = _ecm.Component<components::JointVelocity>(
-      this->dataPtr->jointEntity);
+      this->jointEntity);
   if (!jointVelocity)
   {
-    _ecm.CreateComponent(this->dataPtr->jointEntity,
+    _ecm.CreateComponent(this->jointEntity,
         components::JointVelocity());
     doUpdateForcesAndMoments = false;
   }
@@ -448,59 +616,40 @@ void MulticopterMotorModel::PreUpdate(const UpdateInfo &_info,
   }
 
   if (!_ecm.Component<components::JointVelocityCmd>(
-      this->dataPtr->jointEntity))
+      this->jointEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->jointEntity,
+    _ecm.CreateComponent(this->jointEntity,
         components::JointVelocityCmd({0}));
     doUpdateForcesAndMoments = false;
   }
 
-  if (!_ecm.Component<components::WorldPose>(this->dataPtr->linkEntity))
+  if (!_ecm.Component<components::WorldPose>(this->linkEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->linkEntity, components::WorldPose());
+    _ecm.CreateComponent(this->linkEntity, components::WorldPose());
     doUpdateForcesAndMoments = false;
   }
   if (!_ecm.Component<components::WorldLinearVelocity>(
-      this->dataPtr->linkEntity))
+      this->linkEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->linkEntity,
+    _ecm.CreateComponent(this->linkEntity,
         components::WorldLinearVelocity());
     doUpdateForcesAndMoments = false;
   }
 
-  if (!_ecm.Component<components::WorldPose>(this->dataPtr->parentLinkEntity))
+  if (!_ecm.Component<components::WorldPose>(this->parentLinkEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->parentLinkEntity,
+    _ecm.CreateComponent(this->parentLinkEntity,
         components::WorldPose());
     doUpdateForcesAndMoments = false;
   }
 
-  // Nothing left to do if paused.
-  if (_info.paused)
-    return;
-
-  this->dataPtr->samplingTime =
-    std::chrono::duration<double>(_info.dt).count();
-  if (doUpdateForcesAndMoments)
-  {
-    this->dataPtr->UpdateForcesAndMoments(_ecm);
-  }
-}
-
-//////////////////////////////////////////////////
-void MulticopterMotorModelPrivate::OnActuatorMsg(
-    const msgs::Actuators &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->recvdActuatorsMsgMutex);
-  this->recvdActuatorsMsg = _msg;
+  return doUpdateForcesAndMoments;
 }
 
 //////////////////////////////////////////////////
-void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
-    EntityComponentManager &_ecm)
+bool MulticopterMotorModelPrivate::UpdateReference(
+    const EntityComponentManager &_ecm)
 {
-  GZ_PROFILE("MulticopterMotorModelPrivate::UpdateForcesAndMoments");
-
   std::optional<msgs::Actuators> msg;
   auto actuatorMsgComp =
       _ecm.Component<components::Actuators>(this->model.Entity());
@@ -528,7 +677,7 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
       gzerr << "You tried to access index " << this->actuatorNumber
         << " of the Actuator velocity array which is of size "
         << msg->velocity_size() << std::endl;
-      return;
+      return false;
     }
 
     if (this->motorType == MotorType::kVelocity)
@@ -544,6 +693,206 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
     }
   }
 
+  return true;
+}
+
+//////////////////////////////////////////////////
+multicopter_motor_model::Motor
+MulticopterMotorModelPrivate::BatchMotor() const
+{
+  multicopter_motor_model::Motor motor;
+  motor.turningDirection = this->turningDirection;
+  motor.motorConstant = this->motorConstant;
+  motor.momentConstant = this->momentConstant;
+  motor.rotorDragCoefficient = this->rotorDragCoefficient;
+  motor.rollingMomentCoefficient = this->rollingMomentCoefficient;
+  motor.rotorVelocitySlowdownSim = this->rotorVelocitySlowdownSim;
+  motor.timeConstantUp = this->timeConstantUp;
+  motor.timeConstantDown = this->timeConstantDown;
+  return motor;
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotorModelPrivate::EvaluateBatch(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("MulticopterMotorModelPrivate::EvaluateBatch");
+
+  // Mirror the registered motors, keeping the state of those which stay
+  {
+    std::lock_guard lock(this->registry->mutex);
+    if (this->batchVersion != this->registry->version)
+    {
+      this->batchVersion = this->registry->version;
+      const auto &motors = this->registry->motors;
+      auto registered = [](const auto &_entries, uint64_t _id)
+      {
+        return std::any_of(_entries.begin(), _entries.end(),
+            [_id](const MulticopterMotorRegistry::Entry &_entry)
+            {
+              return _entry.id == _id;
+            });
+      };
+      for (std::size_t i = this->batchMotors.size(); i-- > 0u;)
+      {
+        if (!registered(motors, this->batchMotors[i].id))
+        {
+          this->batch.Remove(i);
+          this->batchMotors[i] = this->batchMotors.back();
+          this->batchMotors.pop_back();
+        }
+      }
+      for (const auto &entry : motors)
+      {
+        if (!registered(this->batchMotors, entry.id))
+        {
+          this->batch.Add(entry.data->BatchMotor());
+          this->batchMotors.push_back(entry);
+        }
+      }
+    }
+  }
+
+  const std::size_t count = this->batchMotors.size();
+  this->batchReady.assign(count, 0);
+  for (std::size_t i = 0u; i < count; ++i)
+    this->batchReady[i] = this->batchMotors[i].data->Prepare(_ecm);
+
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  // Gather the state of each rotor, and look the wind up once
+  const double dt = std::chrono::duration<double>(_info.dt).count();
+  Entity windEntity = _ecm.EntityByComponents(components::Wind());
+  auto windLinearVel =
+      _ecm.Component<components::WorldLinearVelocity>(windEntity);
+  const math::Vector3d windSpeedWorld =
+      windLinearVel ? windLinearVel->Data() : math::Vector3d::Zero;
+
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    auto *motor = this->batchMotors[i].data;
+    motor->samplingTime = dt;
+    if (!this->batchReady[i] || !motor->UpdateReference(_ecm) ||
+        motor->motorType != MotorType::kVelocity)
+    {
+      this->batchReady[i] = 0;
+      continue;
+    }
+
+    const auto jointPose = _ecm.Component<components::Pose>(
+        motor->jointEntity);
+    const auto jointAxisComp = _ecm.Component<components::JointAxis>(
+        motor->jointEntity);
+    if (!jointPose || !jointAxisComp)
+    {
+      gzerr << "joint " << motor->jointName << " has no Pose or JointAxis "
+            << "component" << std::endl;
+      this->batchReady[i] = 0;
+      continue;
+    }
+
+    const double motorRotVel = _ecm.Component<components::JointVelocity>(
+        motor->jointEntity)->Data()[0];
+    if (motorRotVel / (2 * GZ_PI) > 1 / (2 * dt))
+    {
+      gzerr << "Aliasing on motor [" << motor->actuatorNumber
+            << "] might occur. Consider making smaller simulation time "
+               "steps or raising the rotorVelocitySlowdownSim param.\n";
+    }
+
+    Link link(motor->linkEntity);
+    const auto worldPose = link.WorldPose(_ecm);
+    const auto worldLinearVel = link.WorldLinearVelocity(_ecm);
+    const auto parentWorldPose =
+        Link(motor->parentLinkEntity).WorldPose(_ecm);
+    const math::Pose3d jointWorldPose = *worldPose * jointPose->Data();
+    const math::Pose3d poseDifference =
+        (*parentWorldPose).Inverse() * (*worldPose);
+
+    this->batch.SetReference(i, motor->refMotorInput);
+    this->batch.SetState(i, motorRotVel,
+        worldPose->Rot().RotateVector(math::Vector3d::UnitZ),
+        parentWorldPose->Rot().RotateVector(
+            poseDifference.Rot().RotateVector(math::Vector3d::UnitZ)),
+        jointWorldPose.Rot().RotateVector(jointAxisComp->Data().Xyz()),
+        *worldLinearVel - windSpeedWorld);
+  }
+
+  this->batch.Evaluate(dt);
+
+  for (std::size_t i = 0u; i < count; ++i)
+  {
+    if (!this->batchReady[i])
+      continue;
+    const auto *motor = this->batchMotors[i].data;
+    Link(motor->linkEntity).AddWorldForce(_ecm, this->batch.Force(i));
+    addWorldTorque(_ecm, motor->parentLinkEntity, this->batch.Torque(i));
+
+    const auto jointVelCmd = _ecm.Component<components::JointVelocityCmd>(
+        motor->jointEntity);
+    *jointVelCmd = components::JointVelocityCmd(
+        {this->batch.VelocityCommand(i)});
+  }
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotorModel::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("MulticopterMotorModel::PreUpdate");
+
+  if (this->dataPtr->worldLevel)
+  {
+    if (this->dataPtr->batching)
+      this->dataPtr->EvaluateBatch(_info, _ecm);
+    return;
+  }
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    gzwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  // The world-level instance drives the motor
+  if (this->dataPtr->registry->batched)
+    return;
+
+  const bool doUpdateForcesAndMoments = this->dataPtr->Prepare(_ecm);
+
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  this->dataPtr->samplingTime =
+    std::chrono::duration<double>(_info.dt).count();
+  if (doUpdateForcesAndMoments)
+  {
+    this->dataPtr->UpdateForcesAndMoments(_ecm);
+  }
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotorModelPrivate::OnActuatorMsg(
+    const msgs::Actuators &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->recvdActuatorsMsgMutex);
+  this->recvdActuatorsMsg = _msg;
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("MulticopterMotorModelPrivate::UpdateForcesAndMoments");
+
+  if (!this->UpdateReference(_ecm))
+    return;
+
   switch (this->motorType)
   {
     case (MotorType::kPosition):
@@ -637,9 +986,6 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
       // Moments get the parent link, such that the resulting torques can be
       // applied.
       Vector3 parentWorldTorque;
-      auto parentWrenchComp =
-        _ecm.Component<components::ExternalWorldWrenchCmd>(
-          this->parentLinkEntity);
       // gazebo_motor_model.cpp subtracts the GetWorldCoGPose() of the
       // child link from the parent but only uses the rotation component.
       // Since GetWorldCoGPose() uses the link frame orientation, it
@@ -666,17 +1012,7 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
                        this->rollingMomentCoefficient *
                        bodyVelocityPerpendicular;
       parentWorldTorque += rollingMoment;
-      if (!parentWrenchComp)
-      {
-        components::ExternalWorldWrenchCmd wrench;
-        msgs::Set(wrench.Data().mutable_torque(), parentWorldTorque);
-        _ecm.CreateComponent(this->parentLinkEntity, wrench);
-      }
-      else
-      {
-        msgs::Set(parentWrenchComp->Data().mutable_torque(),
-          msgs::Convert(parentWrenchComp->Data().torque()) + parentWorldTorque);
-      }
+      addWorldTorque(_ecm, this->parentLinkEntity, parentWorldTorque);
       // Apply the filter on the motor's velocity.
       double refMotorRotVel;
       refMotorRotVel = this->rotorVelocityFilter->UpdateFilter(
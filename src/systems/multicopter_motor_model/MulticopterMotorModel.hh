@@ -33,6 +33,13 @@ namespace systems
 
   /// \brief This system applies a thrust force to models with spinning
   /// propellers. See examples/worlds/quadcopter.sdf for a demonstration.
+  ///
+  /// Attached to the world, without parameters, the system drives the
+  /// motors of all the model-level instances together, which then only load
+  /// their parameters and receive their commands. It looks the wind up once
+  /// per step and evaluates thrust, drag, moments and rotor dynamics of all
+  /// the rotors in a single loop over contiguous arrays. The output of each
+  /// rotor is the same either way.
   class MulticopterMotorModel
       : public System,
         public ISystemConfigure,
@@ -19,6 +19,8 @@
 
 #include <gz/msgs/navsat.pb.h>
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -41,9 +43,13 @@
 #include "gz/sim/components/NavSat.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/Sensor.hh"
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../DueSensors.hh"
+#include "../../SensorBatches.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -55,6 +61,12 @@ class gz::sim::systems::NavSat::Implementation
   public: std::unordered_map<Entity,
       std::unique_ptr<sensors::NavSatSensor>> entitySensorMap;
 
+  /// \brief NavSat sensors that need data at the current step.
+  public: DueSensors<sensors::NavSatSensor> dueSensors;
+
+  /// \brief Batched publication of the readings.
+  public: SensorBatches batches{"navsat"};
+
   /// \brief gz-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
@@ -71,9 +83,22 @@ class gz::sim::systems::NavSat::Implementation
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update sensor data based on physics data
+  /// \brief Update sensor data based on physics data. This may be called
+  /// concurrently for different sensors.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  /// \param[in] _entity Entity of the NavSat
+  /// \param[in] _sensor NavSat sensor to update.
+  public: void SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::NavSatSensor &_sensor);
+
+  /// \brief Add the readings of a sensor to its batch. This may be
+  /// called concurrently for different sensors.
+  /// \param[in] _entity Entity of the sensor
+  /// \param[in] _sensor Sensor that was just updated.
+  /// \param[in] _simTime Current simulation time.
+  public: void AddToBatch(const Entity _entity,
+    sensors::NavSatSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime);
 
   /// \brief Remove sensors if their entities have been removed from simulation.
   /// \param[in] _ecm Immutable reference to ECM.
@@ -96,6 +121,15 @@ NavSat::NavSat() : System(), dataPtr(utils::MakeUniqueImpl<Implementation>())
 {
 }
 
+//////////////////////////////////////////////////
+void NavSat::Configure(const Entity &/*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &/*_ecm*/,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->batches.Load(_sdf);
+}
+
 //////////////////////////////////////////////////
 void NavSat::PreUpdate(const UpdateInfo &/*_info*/,
     EntityComponentManager &_ecm)
@@ -137,29 +171,32 @@ void NavSat::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: gz-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the NavSat::Implementation::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
+    std::function<bool(Entity)> batchConnections;
+    std::function<void(Entity, sensors::NavSatSensor &)> updated;
+    if (this->dataPtr->batches.Enabled())
     {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
+      batchConnections = [&](const Entity _entity)
       {
-        needsUpdate = true;
-        break;
-      }
+        return this->dataPtr->batches.HasConnections(_entity);
+      };
+      updated = [&](const Entity _entity, sensors::NavSatSensor &_sensor)
+      {
+        this->dataPtr->AddToBatch(_entity, _sensor, _info.simTime);
+      };
     }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->Update(_ecm);
 
-    for (auto &it : this->dataPtr->entitySensorMap)
+    // we only update sensors that need data and have subscribers.
+    // note: gz-sensors does its own throttling. Here the check is mainly
+    // to avoid doing work in the NavSat::Implementation::SetData function
+    if (this->dataPtr->dueSensors.Gather(this->dataPtr->entitySensorMap,
+        _info.simTime, batchConnections))
     {
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
+      this->dataPtr->dueSensors.Update(_info.simTime,
+          [&](const Entity _entity, sensors::NavSatSensor &_sensor)
+          {
+            this->dataPtr->SetData(_ecm, _entity, _sensor);
+          }, updated);
+      this->dataPtr->batches.Publish(_info.simTime);
     }
   }
 
@@ -198,6 +235,7 @@ void NavSat::Implementation::AddSensor(
       _parent->Data())->Data();
   sensor->SetParent(parentName);
 
+  this->batches.AddSensor(_ecm, _entity, sensor->Name(), data.UpdateRate());
   this->entitySensorMap.insert(
       std::make_pair(_entity, std::move(sensor)));
   this->newSensors.insert(_entity);
@@ -233,43 +271,48 @@ void NavSat::Implementation::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void NavSat::Implementation::Update(const EntityComponentManager &_ecm)
+void NavSat::Implementation::SetData(const EntityComponentManager &_ecm,
+    const Entity _entity, sensors::NavSatSensor &_sensor)
 {
-  GZ_PROFILE("NavSat::Update");
-
-  _ecm.Each<components::NavSat, components::WorldLinearVelocity>(
-    [&](const Entity &_entity,
-        const components::NavSat * /*_navsat*/,
-        const components::WorldLinearVelocity *_worldLinearVel
-        )->bool
-      {
-        auto it = this->entitySensorMap.find(_entity);
-
-        if (it == this->entitySensorMap.end())
-        {
-          gzerr << "Failed to update NavSat sensor entity [" << _entity
-                 << "]. Entity not found." << std::endl;
-          return true;
-        }
+  auto worldLinearVel =
+      _ecm.Component<components::WorldLinearVelocity>(_entity);
+  if (nullptr == worldLinearVel)
+    return;
 
-        // Position
-        auto latLonEle = sphericalCoordinates(_entity, _ecm);
-        if (!latLonEle)
-        {
-          gzwarn << "Failed to update NavSat sensor enity [" << _entity
-                  << "]. Spherical coordinates not set." << std::endl;
-          return true;
-        }
+  // Position
+  auto latLonEle = sphericalCoordinates(_entity, _ecm);
+  if (!latLonEle)
+  {
+    gzwarn << "Failed to update NavSat sensor enity [" << _entity
+            << "]. Spherical coordinates not set." << std::endl;
+    return;
+  }
 
-        it->second->SetLatitude(GZ_DTOR(latLonEle.value().X()));
-        it->second->SetLongitude(GZ_DTOR(latLonEle.value().Y()));
-        it->second->SetAltitude(latLonEle.value().Z());
+  _sensor.SetLatitude(GZ_DTOR(latLonEle.value().X()));
+  _sensor.SetLongitude(GZ_DTOR(latLonEle.value().Y()));
+  _sensor.SetAltitude(latLonEle.value().Z());
 
-        // Velocity in ENU frame
-        it->second->SetVelocity(_worldLinearVel->Data());
+  // Velocity in ENU frame
+  _sensor.SetVelocity(worldLinearVel->Data());
+}
 
-        return true;
-      });
+//////////////////////////////////////////////////
+void NavSat::Implementation::AddToBatch(const Entity _entity,
+    sensors::NavSatSensor &_sensor,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  msgs::NavSat msg;
+  *msg.mutable_header()->mutable_stamp() = convert<msgs::Time>(_simTime);
+  msg.set_frame_id(_sensor.FrameId());
+  msg.set_latitude_deg(_sensor.Latitude().Degree());
+  msg.set_longitude_deg(_sensor.Longitude().Degree());
+  msg.set_altitude(_sensor.Altitude());
+  // Velocity in ENU frame
+  const auto velocity = _sensor.Velocity();
+  msg.set_velocity_east(velocity.X());
+  msg.set_velocity_north(velocity.Y());
+  msg.set_velocity_up(velocity.Z());
+  this->batches.SetMessage(_entity, msg);
 }
 
 //////////////////////////////////////////////////
@@ -289,12 +332,14 @@ void NavSat::Implementation::RemoveSensors(const EntityComponentManager &_ecm)
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->batches.RemoveSensor(_entity);
 
         return true;
       });
 }
 
 GZ_ADD_PLUGIN(NavSat, System,
+  NavSat::ISystemConfigure,
   NavSat::ISystemPreUpdate,
   NavSat::ISystemPostUpdate
 )
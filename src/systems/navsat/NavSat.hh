@@ -38,14 +38,29 @@ namespace systems
   /// The NavSat sensors rely on the world origin's spherical coordinates
   /// being set, for example through SDF's `<spherical_coordinates>` tag
   /// or the `/world/world_name/set_spherical_coordinates` service.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<batch_publish>`: Optional. `world` or `model` to also publish the
+  ///   readings of all NavSat sensors of the world, or of each top level model,
+  ///   as one msgs::Dataframe per update rate and step on `<world or model
+  ///   scoped name>/navsat_batch/<rate>hz`. The NavSat sensors keep publishing
+  ///   on their own topics.
   class NavSat:
     public System,
+    public ISystemConfigure,
     public ISystemPreUpdate,
     public ISystemPostUpdate
   {
     /// \brief Constructor
     public: explicit NavSat();
 
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
     // Documentation inherited
     public: void PreUpdate(const UpdateInfo &_info,
                            EntityComponentManager &_ecm) final;
@@ -22,6 +22,7 @@
 #include <gz/msgs/odometry_with_covariance.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 
+#include <array>
 #include <limits>
 #include <string>
 #include <tuple>
@@ -42,6 +43,8 @@
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
 
+#include "../../NoiseGenerator.hh"
+
 using namespace gz;
 using namespace sim;
 using namespace systems;
@@ -55,6 +58,10 @@ class gz::sim::systems::OdometryPublisherPrivate
   public: void UpdateOdometry(const gz::sim::UpdateInfo &_info,
     const gz::sim::EntityComponentManager &_ecm);
 
+  /// \brief Set the parts of the messages which don't change between
+  /// publications, so that they're only updated in place afterwards.
+  public: void InitializeMessages();
+
   /// \brief Gazebo communication node.
   public: transport::Node node;
 
@@ -108,6 +115,18 @@ class gz::sim::systems::OdometryPublisherPrivate
 
   /// \brief Gaussian noise
   public: double gaussianNoise = 0.0;
+
+  /// \brief Generator of the noise, with the model as its stream.
+  public: NoiseGenerator noiseGenerator{0u, 0u};
+
+  /// \brief Odometry message, reused between updates to avoid allocations.
+  public: msgs::Odometry odomMsg;
+
+  /// \brief Odometry with covariance message, reused between publications.
+  public: msgs::OdometryWithCovariance odomCovMsg;
+
+  /// \brief Pose vector (TF) message, reused between publications.
+  public: msgs::Pose_V tfMsg;
 };
 
 //////////////////////////////////////////////////
@@ -139,6 +158,7 @@ void OdometryPublisher::Configure(const Entity &_entity,
     EventManager &/*_eventMgr*/)
 {
   this->dataPtr->model = Model(_entity);
+  this->dataPtr->noiseGenerator = NoiseGenerator(math::Rand::Seed(), _entity);
 
   if (!this->dataPtr->model.Valid(_ecm))
   {
@@ -270,6 +290,8 @@ void OdometryPublisher::Configure(const Entity &_entity,
     gzmsg << "OdometryPublisher publishing Pose_V (TF) on ["
            << tfTopicValid << "]" << std::endl;
   }
+
+  this->dataPtr->InitializeMessages();
 }
 
 //////////////////////////////////////////////////
@@ -332,6 +354,44 @@ void OdometryPublisher::PostUpdate(const UpdateInfo &_info,
   this->dataPtr->UpdateOdometry(_info, _ecm);
 }
 
+//////////////////////////////////////////////////
+void OdometryPublisherPrivate::InitializeMessages()
+{
+  // Set the frame ids.
+  msgs::Header header;
+  auto frame = header.add_data();
+  frame->set_key("frame_id");
+  frame->add_value(this->odomFrame);
+  auto childFrame = header.add_data();
+  childFrame->set_key("child_frame_id");
+  childFrame->add_value(this->robotBaseFrame);
+
+  this->odomMsg.mutable_header()->CopyFrom(header);
+  this->odomCovMsg.mutable_header()->CopyFrom(header);
+  this->tfMsg.add_pose()->mutable_header()->CopyFrom(header);
+
+  // Populate the covariance matrix.
+  // Should the matrix me populated for pose as well ?
+  auto gn2 = this->gaussianNoise * this->gaussianNoise;
+  for (int i = 0; i < 36; i++)
+  {
+    if (i % 7 == 0)
+    {
+      this->odomCovMsg.mutable_pose_with_covariance()->
+        mutable_covariance()->add_data(gn2);
+      this->odomCovMsg.mutable_twist_with_covariance()->
+        mutable_covariance()->add_data(gn2);
+    }
+    else
+    {
+      this->odomCovMsg.mutable_pose_with_covariance()->
+        mutable_covariance()->add_data(0);
+      this->odomCovMsg.mutable_twist_with_covariance()->
+        mutable_covariance()->add_data(0);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void OdometryPublisherPrivate::UpdateOdometry(
     const gz::sim::UpdateInfo &_info,
@@ -346,8 +406,8 @@ void OdometryPublisherPrivate::UpdateOdometry(
     return;
   }
 
-  // Construct the odometry message and publish it.
-  msgs::Odometry msg;
+  // Update the odometry message and publish it.
+  msgs::Odometry &msg = this->odomMsg;
 
   const std::chrono::duration<double> dt =
     std::chrono::steady_clock::time_point(_info.simTime) - lastUpdateTime;
@@ -367,6 +427,13 @@ void OdometryPublisherPrivate::UpdateOdometry(
     msg.mutable_pose()->mutable_position()->set_z(pose.Pos().Z());
   }
 
+  // Noise of the linear and angular velocities, drawn together so they
+  // only depend on the seed, the model and the iteration
+  std::array<double, 6> noise{};
+  this->noiseGenerator.Reset(_info.iterations);
+  this->noiseGenerator.AddNormal(noise.data(), noise.size(), 0.0,
+      this->gaussianNoise);
+
   // Get linear and angular displacements from last updated pose.
   double linearDisplacementX = pose.Pos().X() - this->lastUpdatePose.Pos().X();
   double linearDisplacementY = pose.Pos().Y() - this->lastUpdatePose.Pos().Y();
@@ -387,18 +454,13 @@ void OdometryPublisherPrivate::UpdateOdometry(
     std::get<0>(this->linearMean).Push(linearVelocityX);
     std::get<1>(this->linearMean).Push(linearVelocityY);
     msg.mutable_twist()->mutable_linear()->set_x(
-      std::get<0>(this->linearMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<0>(this->linearMean).Mean() + noise[0]);
     msg.mutable_twist()->mutable_linear()->set_y(
-      std::get<1>(this->linearMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
-    msg.mutable_twist()->mutable_linear()->set_z(
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<1>(this->linearMean).Mean() + noise[1]);
+    msg.mutable_twist()->mutable_linear()->set_z(noise[2]);
 
-    msg.mutable_twist()->mutable_angular()->set_x(
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
-    msg.mutable_twist()->mutable_angular()->set_y(
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+    msg.mutable_twist()->mutable_angular()->set_x(noise[3]);
+    msg.mutable_twist()->mutable_angular()->set_y(noise[4]);
   }
   // Get velocities and roll/pitch rates assuming 3D
   else if (this->dimensions == 3)
@@ -427,41 +489,25 @@ void OdometryPublisherPrivate::UpdateOdometry(
     std::get<0>(this->angularMean).Push(rollDiff / dt.count());
     std::get<1>(this->angularMean).Push(pitchDiff / dt.count());
     msg.mutable_twist()->mutable_linear()->set_x(
-      std::get<0>(this->linearMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<0>(this->linearMean).Mean() + noise[0]);
     msg.mutable_twist()->mutable_linear()->set_y(
-      std::get<1>(this->linearMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<1>(this->linearMean).Mean() + noise[1]);
     msg.mutable_twist()->mutable_linear()->set_z(
-      std::get<2>(this->linearMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<2>(this->linearMean).Mean() + noise[2]);
     msg.mutable_twist()->mutable_angular()->set_x(
-      std::get<0>(this->angularMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<0>(this->angularMean).Mean() + noise[3]);
     msg.mutable_twist()->mutable_angular()->set_y(
-      std::get<1>(this->angularMean).Mean() +
-      gz::math::Rand::DblNormal(0, this->gaussianNoise));
+      std::get<1>(this->angularMean).Mean() + noise[4]);
   }
 
   // Set yaw rate
   std::get<2>(this->angularMean).Push(yawDiff / dt.count());
   msg.mutable_twist()->mutable_angular()->set_z(
-    std::get<2>(this->angularMean).Mean() +
-    gz::math::Rand::DblNormal(0, this->gaussianNoise));
+    std::get<2>(this->angularMean).Mean() + noise[5]);
 
   // Set the time stamp in the header.
-  msgs::Header header;
-  header.mutable_stamp()->CopyFrom(convert<msgs::Time>(_info.simTime));
-
-  // Set the frame ids.
-  auto frame = header.add_data();
-  frame->set_key("frame_id");
-  frame->add_value(odomFrame);
-  auto childFrame = header.add_data();
-  childFrame->set_key("child_frame_id");
-  childFrame->add_value(robotBaseFrame);
-
-  msg.mutable_header()->CopyFrom(header);
+  const auto stamp = convert<msgs::Time>(_info.simTime);
+  msg.mutable_header()->mutable_stamp()->CopyFrom(stamp);
 
   this->lastUpdatePose = pose;
   this->lastUpdateTime = std::chrono::steady_clock::time_point(_info.simTime);
@@ -479,11 +525,11 @@ void OdometryPublisherPrivate::UpdateOdometry(
     this->odomPub.Publish(msg);
   }
 
-  // Generate odometry with covariance message and publish it.
-  msgs::OdometryWithCovariance msgCovariance;
+  // Update odometry with covariance message and publish it.
+  msgs::OdometryWithCovariance &msgCovariance = this->odomCovMsg;
 
   // Set the time stamp in the header.
-  msgCovariance.mutable_header()->CopyFrom(header);
+  msgCovariance.mutable_header()->mutable_stamp()->CopyFrom(stamp);
 
   // Copy position from odometry msg.
   msgCovariance.mutable_pose_with_covariance()->
@@ -512,26 +558,7 @@ void OdometryPublisherPrivate::UpdateOdometry(
   msgCovariance.mutable_twist_with_covariance()->
     mutable_twist()->mutable_linear()->set_z(msg.twist().linear().z());
 
-  // Populate the covariance matrix.
-  // Should the matrix me populated for pose as well ?
-  auto gn2 = this->gaussianNoise * this->gaussianNoise;
-  for (int i = 0; i < 36; i++)
-  {
-    if (i % 7 == 0)
-    {
-      msgCovariance.mutable_pose_with_covariance()->
-        mutable_covariance()->add_data(gn2);
-      msgCovariance.mutable_twist_with_covariance()->
-        mutable_covariance()->add_data(gn2);
-    }
-    else
-    {
-      msgCovariance.mutable_pose_with_covariance()->
-        mutable_covariance()->add_data(0);
-      msgCovariance.mutable_twist_with_covariance()->
-        mutable_covariance()->add_data(0);
-    }
-  }
+  // The covariance matrix is set once in InitializeMessages
   if (this->odomCovPub.Valid())
   {
     this->odomCovPub.Publish(msgCovariance);
@@ -539,12 +566,12 @@ void OdometryPublisherPrivate::UpdateOdometry(
 
   if (this->tfPub.Valid())
   {
-    msgs::Pose_V tfMsg;
-    auto tfMsgPose = tfMsg.add_pose();
-    tfMsgPose->CopyFrom(msg.pose());
-    tfMsgPose->mutable_header()->CopyFrom(header);
+    auto tfMsgPose = this->tfMsg.mutable_pose(0);
+    tfMsgPose->mutable_position()->CopyFrom(msg.pose().position());
+    tfMsgPose->mutable_orientation()->CopyFrom(msg.pose().orientation());
+    tfMsgPose->mutable_header()->mutable_stamp()->CopyFrom(stamp);
 
-    this->tfPub.Publish(tfMsg);
+    this->tfPub.Publish(this->tfMsg);
   }
 }
 
@@ -28,7 +28,7 @@
 #include <sdf/Element.hh>
 
 #include "gz/sim/components/ContactSensor.hh"
-#include "gz/sim/components/ContactSensorData.hh"
+#include "gz/sim/components/ContactBuffer.hh"
 #include "gz/sim/components/Collision.hh"
 #include "gz/sim/components/DepthCamera.hh"
 #include "gz/sim/components/Link.hh"
@@ -384,13 +384,12 @@ void OpticalTactilePlugin::PreUpdate(const UpdateInfo &_info,
   {
     // Get the first object being touched by the sensor
     // We assume there's only one object being touched
-    auto csd = _ecm.Component<components::ContactSensorData>(
+    auto contacts = _ecm.Component<components::ContactBuffer>(
       this->dataPtr->sensorCollisionEntity);
-    for (const auto &contact : csd->Data().contact())
+    if (!contacts->Data().pairs.empty())
     {
       this->dataPtr->objectCollisionEntity =
-        contact.collision2().id();
-      break;
+        contacts->Data().pairs.front().collision2;
     }
 
     // Get the tactile sensor pose, i.e. the model pose
@@ -425,7 +424,7 @@ void OpticalTactilePlugin::PostUpdate(
   if (this->dataPtr->visualizeContacts)
   {
     auto *contacts =
-      _ecm.Component<components::ContactSensorData>(
+      _ecm.Component<components::ContactBuffer>(
         this->dataPtr->sensorCollisionEntity);
 
     if (nullptr != contacts)
@@ -498,7 +497,7 @@ void OpticalTactilePluginPrivate::Load(const EntityComponentManager &_ecm)
   for (const Entity &colEntity : linkCollisions)
   {
     if (_ecm.EntityHasComponentType(colEntity,
-        components::ContactSensorData::typeId))
+        components::ContactBuffer::typeId))
     {
       this->sensorCollisionEntity = colEntity;
 
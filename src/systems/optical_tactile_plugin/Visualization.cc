@@ -103,34 +103,30 @@ void OpticalTactilePluginVisualization::InitializeContactsMarkerMsg(
 
 //////////////////////////////////////////////////
 void OpticalTactilePluginVisualization::AddContactToMarkerMsg(
-  gz::msgs::Contact const &_contact,
+  gz::math::Vector3d const &_position,
   gz::msgs::Marker &_contactMarkerMsg)
 {
   // todo(anyone) once available, use normal field in the Contact message
   gz::math::Vector3d contactNormal(0, 0, 0.03);
 
-  // For each contact, add a line marker starting from the contact position,
-  // ending at the endpoint of the normal.
-  for (auto const &position : _contact.position())
-  {
-    gz::math::Vector3d startPoint = gz::msgs::Convert(position);
-    gz::math::Vector3d endPoint = startPoint + contactNormal;
+  // Add a line marker starting from the contact position, ending at the
+  // endpoint of the normal.
+  gz::math::Vector3d endPoint = _position + contactNormal;
 
-    gz::msgs::Set(_contactMarkerMsg.add_point(), startPoint);
-    gz::msgs::Set(_contactMarkerMsg.add_point(), endPoint);
-  }
+  gz::msgs::Set(_contactMarkerMsg.add_point(), _position);
+  gz::msgs::Set(_contactMarkerMsg.add_point(), endPoint);
 }
 
 //////////////////////////////////////////////////
 void OpticalTactilePluginVisualization::RequestContactsMarkerMsg(
-  const components::ContactSensorData *_contacts)
+  const components::ContactBuffer *_contacts)
 {
   gz::msgs::Marker contactsMarkerMsg;
   this->InitializeContactsMarkerMsg(contactsMarkerMsg);
 
-  for (const auto &contact : _contacts->Data().contact())
+  for (const auto &position : _contacts->Data().positions)
   {
-    this->AddContactToMarkerMsg(contact, contactsMarkerMsg);
+    this->AddContactToMarkerMsg(position, contactsMarkerMsg);
   }
 
   this->node.Request("/marker", contactsMarkerMsg);
@@ -25,7 +25,7 @@
 #include <gz/sim/System.hh>
 #include <gz/msgs/marker.pb.h>
 
-#include "gz/sim/components/ContactSensorData.hh"
+#include "gz/sim/components/ContactBuffer.hh"
 
 namespace gz
 {
@@ -78,18 +78,18 @@ namespace optical_tactile_sensor
     private: void InitializeContactsMarkerMsg(
         gz::msgs::Marker &_contactsMarkerMsg);
 
-    /// \brief Add a contact to the marker message representing the contacts
-    /// from the contact sensor based on physics
-    /// \param[in] _contact Contact to be added
+    /// \brief Add a contact point to the marker message representing the
+    /// contacts from the contact sensor based on physics
+    /// \param[in] _position Position of the contact point to be added
     /// \param[out] _contactsMarkerMsg Message for visualizing the contacts
     public: void AddContactToMarkerMsg(
-        gz::msgs::Contact const &_contact,
+        gz::math::Vector3d const &_position,
         gz::msgs::Marker &_contactsMarkerMsg);
 
     /// \brief Request the "/marker" service for the contacts marker.
     /// \param[in] _contacts Contacts to visualize
     public: void RequestContactsMarkerMsg(
-        components::ContactSensorData const *_contacts);
+        components::ContactBuffer const *_contacts);
 
     /// \brief Initialize the marker messages representing the normal forces
     /// \param[out] _positionMarkerMsg Message for visualizing the contact
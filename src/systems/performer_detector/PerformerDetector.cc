@@ -17,6 +17,15 @@
 
 #include <gz/msgs/pose.pb.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <gz/common/Profiler.hh>
 #include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Vector3.hh>
@@ -41,6 +50,185 @@ using namespace gz;
 using namespace sim;
 using namespace systems;
 
+/// \brief Performers of a world, binned by the XY position of the minimum
+/// corner of their volume on a uniform grid. All the detectors of a world
+/// share an index, so the performers are gathered once per step, and each
+/// detector only tests the performers in the cells around its region.
+class gz::sim::systems::PerformerIndex
+{
+  /// \brief A performer.
+  public: struct Performer
+  {
+    /// \brief Performer entity.
+    Entity entity;
+
+    /// \brief Name of the parent of the performer.
+    std::string name;
+
+    /// \brief Pose of the parent of the performer.
+    math::Pose3d pose;
+
+    /// \brief Volume of the performer.
+    math::AxisAlignedBox volume;
+  };
+
+  /// \brief Gather the performers, unless it was already done on this
+  /// iteration. It can be called concurrently by all detectors.
+  /// \param[in] _info Current update info.
+  /// \param[in] _ecm Entity component manager.
+  public: void Update(const UpdateInfo &_info,
+              const EntityComponentManager &_ecm)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->built && this->iteration == _info.iterations)
+      return;
+
+    GZ_PROFILE("PerformerIndex::Update");
+    this->built = true;
+    this->iteration = _info.iterations;
+    this->performers.clear();
+    this->byEntity.clear();
+    this->cells.clear();
+
+    double maxSize{0.0};
+    _ecm.Each<components::Performer, components::Geometry,
+              components::ParentEntity>(
+        [&](const Entity &_entity, const components::Performer *,
+            const components::Geometry *_geometry,
+            const components::ParentEntity *_parent) -> bool
+        {
+          // We assume the geometry contains a box.
+          auto perfBox = _geometry->Data().BoxShape();
+          if (nullptr == perfBox)
+          {
+            gzerr << "Internal error: geometry of performer [" << _entity
+                   << "] missing box." << std::endl;
+            return true;
+          }
+
+          Performer performer;
+          performer.entity = _entity;
+          performer.pose =
+              _ecm.Component<components::Pose>(_parent->Data())->Data();
+          performer.name =
+              _ecm.Component<components::Name>(_parent->Data())->Data();
+          performer.volume = math::AxisAlignedBox(
+              performer.pose.Pos() - perfBox->Size() / 2,
+              performer.pose.Pos() + perfBox->Size() / 2);
+          maxSize = std::max({maxSize, perfBox->Size().X(),
+              perfBox->Size().Y()});
+          this->byEntity[_entity] = this->performers.size();
+          this->performers.push_back(std::move(performer));
+          return true;
+        });
+
+    // Cells as large as the largest performer keep queries to the cells
+    // overlapped by the region and by one more row and column
+    this->maxSize = maxSize;
+    this->cellSize = std::max(1.0, maxSize);
+    for (std::size_t i = 0u; i < this->performers.size(); ++i)
+    {
+      const auto &min = this->performers[i].volume.Min();
+      this->cells[this->Key(this->Coord(min.X()), this->Coord(min.Y()))]
+          .push_back(i);
+    }
+  }
+
+  /// \brief Find a performer.
+  /// \param[in] _entity Performer entity.
+  /// \return The performer, or null if it doesn't exist anymore.
+  public: const Performer *Find(const Entity &_entity) const
+  {
+    auto it = this->byEntity.find(_entity);
+    return it == this->byEntity.end() ? nullptr :
+        &this->performers[it->second];
+  }
+
+  /// \brief Call a function for each performer whose volume intersects a
+  /// region. Queries can run concurrently once the index is updated.
+  /// \param[in] _region Region to test.
+  /// \param[in] _f Function called with each intersecting performer.
+  public: template<typename Function>
+          void Query(const math::AxisAlignedBox &_region, Function _f) const
+  {
+    const std::int64_t minX = this->Coord(_region.Min().X() - this->maxSize);
+    const std::int64_t maxX = this->Coord(_region.Max().X());
+    const std::int64_t minY = this->Coord(_region.Min().Y() - this->maxSize);
+    const std::int64_t maxY = this->Coord(_region.Max().Y());
+
+    auto test = [&](std::size_t _i)
+    {
+      if (_region.Intersects(this->performers[_i].volume))
+        _f(this->performers[_i]);
+    };
+
+    // Regions covering more cells than there are occupied cells test all
+    // performers instead
+    const double regionCells = static_cast<double>(maxX - minX + 1) *
+        static_cast<double>(maxY - minY + 1);
+    if (regionCells > static_cast<double>(this->cells.size()))
+    {
+      for (std::size_t i = 0u; i < this->performers.size(); ++i)
+        test(i);
+      return;
+    }
+
+    for (std::int64_t x = minX; x <= maxX; ++x)
+    {
+      for (std::int64_t y = minY; y <= maxY; ++y)
+      {
+        auto it = this->cells.find(this->Key(x, y));
+        if (it == this->cells.end())
+          continue;
+        for (auto i : it->second)
+          test(i);
+      }
+    }
+  }
+
+  /// \brief Get the cell coordinate of a position coordinate.
+  /// \param[in] _value Position coordinate.
+  /// \return Cell coordinate.
+  private: std::int64_t Coord(double _value) const
+  {
+    return static_cast<std::int64_t>(std::floor(_value / this->cellSize));
+  }
+
+  /// \brief Get the key of a cell.
+  /// \param[in] _x Cell X coordinate.
+  /// \param[in] _y Cell Y coordinate.
+  /// \return Key combining both coordinates.
+  private: static std::uint64_t Key(std::int64_t _x, std::int64_t _y)
+  {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_x)) <<
+        32u) | static_cast<std::uint32_t>(_y);
+  }
+
+  /// \brief Protects updates.
+  private: std::mutex mutex;
+
+  /// \brief True once the index was updated.
+  private: bool built{false};
+
+  /// \brief Iteration of the last update.
+  private: std::uint64_t iteration{0u};
+
+  /// \brief All performers.
+  private: std::vector<Performer> performers;
+
+  /// \brief Index in performers of each performer entity.
+  private: std::unordered_map<Entity, std::size_t> byEntity;
+
+  /// \brief Indices in performers of the performers in each cell.
+  private: std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells;
+
+  /// \brief Size of the cells.
+  private: double cellSize{1.0};
+
+  /// \brief Largest X or Y size of a performer.
+  private: double maxSize{0.0};
+};
+
 /////////////////////////////////////////////////
 void PerformerDetector::Configure(const Entity &_entity,
                const std::shared_ptr<const sdf::Element> &_sdf,
@@ -125,6 +313,7 @@ void PerformerDetector::Configure(const Entity &_entity,
 
   transport::Node node;
   this->pub = node.Advertise<msgs::Pose>(topic);
+  this->index = _ecm.SystemSharedData<PerformerIndex>("PerformerDetector");
   this->initialized = true;
 }
 
@@ -159,44 +348,32 @@ void PerformerDetector::PostUpdate(
   auto region = this->detectorGeometry -
     (-(modelPose.Pos() + modelPose.Rot() * this->poseOffset.Pos()));
 
-  _ecm.Each<components::Performer, components::Geometry,
-            components::ParentEntity>(
-      [&](const Entity &_entity, const components::Performer *,
-          const components::Geometry *_geometry,
-          const components::ParentEntity *_parent) -> bool
-      {
-        auto pose = _ecm.Component<components::Pose>(_parent->Data())->Data();
-        auto name = _ecm.Component<components::Name>(_parent->Data())->Data();
-        const math::Pose3d relPose = modelPose.Inverse() * pose;
-
-        // We assume the geometry contains a box.
-        auto perfBox = _geometry->Data().BoxShape();
-        if (nullptr == perfBox)
-        {
-          gzerr << "Internal error: geometry of performer [" << _entity
-                 << "] missing box." << std::endl;
-          return true;
-        }
-
-        math::AxisAlignedBox performerVolume{pose.Pos() - perfBox->Size() / 2,
-                                             pose.Pos() + perfBox->Size() / 2};
+  this->index->Update(_info, _ecm);
 
-        bool alreadyDetected = this->IsAlreadyDetected(_entity);
-        if (region.Intersects(performerVolume))
-        {
-          if (!alreadyDetected)
-          {
-            this->AddToDetected(_entity);
-            this->Publish(_entity, name, true, relPose, _info.simTime);
-          }
-        }
-        else if (alreadyDetected)
-        {
-          this->RemoveFromDetected(_entity);
-          this->Publish(_entity, name, false, relPose, _info.simTime);
-        }
+  // Performers that left the region are among the detected ones, so only
+  // those are checked, and performers that entered are near the region
+  std::vector<const PerformerIndex::Performer *> exited;
+  for (const auto &entity : this->detectedEntities)
+  {
+    auto performer = this->index->Find(entity);
+    if (nullptr != performer && !region.Intersects(performer->volume))
+      exited.push_back(performer);
+  }
+  for (auto performer : exited)
+  {
+    this->RemoveFromDetected(performer->entity);
+    this->Publish(performer->entity, performer->name, false,
+        modelPose.Inverse() * performer->pose, _info.simTime);
+  }
 
-        return true;
+  this->index->Query(region,
+      [&](const PerformerIndex::Performer &_performer)
+      {
+        if (this->IsAlreadyDetected(_performer.entity))
+          return;
+        this->AddToDetected(_performer.entity);
+        this->Publish(_performer.entity, _performer.name, true,
+            modelPose.Inverse() * _performer.pose, _info.simTime);
       });
 }
 
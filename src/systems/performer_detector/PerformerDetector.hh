@@ -37,6 +37,9 @@ namespace sim
 inline namespace GZ_SIM_VERSION_NAMESPACE {
 namespace systems
 {
+  // Forward declarations.
+  class PerformerIndex;
+
   /// \brief A system system that publishes on a topic when a performer enters
   /// or leaves a specified region.
   ///
@@ -63,6 +66,10 @@ namespace systems
   /// The system does not assume that levels are enabled, but it does require
   /// performers to be specified.
   ///
+  /// All the detectors of a world share an index of the performers, which is
+  /// built once per step, so each detector only tests the performers near
+  /// its region instead of all of them.
+  ///
   /// ## System Parameters
   ///
   /// - `<topic>`: Custom topic to be used for publishing when a performer is
@@ -150,6 +157,9 @@ namespace systems
 
     /// \brief Optional extra header data.
     private: std::map<std::string, std::string> extraHeaderData;
+
+    /// \brief Performers of the world, shared with the other detectors.
+    private: std::shared_ptr<PerformerIndex> index;
   };
 
   }
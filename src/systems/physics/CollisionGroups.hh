@@ -0,0 +1,430 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_PHYSICS_COLLISION_GROUPS_HH_
+#define GZ_SIM_SYSTEMS_PHYSICS_COLLISION_GROUPS_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gz/sim/Entity.hh"
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::physics_system
+{
+  /// \brief Helper class that assigns top-level models to groups and turns
+  /// a matrix of which groups collide into collision filter bitmasks, so
+  /// the physics engine skips pairs of collisions that never interact.
+  ///
+  /// Two collisions are tested when their bitmasks share a bit, so all
+  /// models with the same bitmask collide with each other. Models of a
+  /// group that doesn't collide with itself are therefore spread over
+  /// several bitmasks, called colors, and only models of the same color
+  /// are still tested against each other. Groups that collide with
+  /// themselves have a single color. Each bit is given to a set of colors
+  /// that all collide with each other, and bits are added until every
+  /// colliding pair of colors shares one. Groups that don't collide never
+  /// share a bit. As many colors are used as the bits allow.
+  ///
+  /// Models that match no group are in the default group, which collides
+  /// with all groups.
+  ///
+  /// It also counts the collisions of each color, to report how many pairs
+  /// of collisions are filtered.
+  class CollisionGroups
+  {
+    /// \brief Number of bits in a collision filter bitmask.
+    public: static constexpr std::size_t kMaskBits{16u};
+
+    /// \brief Add a group.
+    /// \param[in] _name Name of the group.
+    /// \param[in] _prefixes Prefixes of the names of the top-level models in
+    /// the group.
+    /// \param[in] _static True if static models are in the group too.
+    /// \return False if a group with that name already exists.
+    public: bool AddGroup(const std::string &_name,
+                          const std::vector<std::string> &_prefixes,
+                          const bool _static)
+    {
+      if (this->Index(_name) < this->groups.size())
+        return false;
+      this->groups.push_back({_name, _prefixes, _static});
+      this->masks.clear();
+      return true;
+    }
+
+    /// \brief Stop two groups from colliding, which can be the same group.
+    /// \param[in] _first Name of a group.
+    /// \param[in] _second Name of the other group.
+    /// \return False if a group doesn't exist.
+    public: bool Disable(const std::string &_first,
+                         const std::string &_second)
+    {
+      const auto first = this->Index(_first);
+      const auto second = this->Index(_second);
+      if (first >= this->groups.size() || second >= this->groups.size())
+        return false;
+      this->disabled.emplace_back(std::min(first, second),
+          std::max(first, second));
+      this->masks.clear();
+      return true;
+    }
+
+    /// \brief Compute the colors and bitmasks of the groups, after adding
+    /// the groups and disabled pairs, and before assigning models.
+    /// \return False if the groups can't be expressed with kMaskBits bits.
+    public: bool Finalize()
+    {
+      for (std::size_t colors = kMaskBits; colors > 0u; --colors)
+      {
+        if (this->Cover(colors))
+          return true;
+      }
+      this->masks.clear();
+      return false;
+    }
+
+    /// \brief Check whether the bitmasks were computed.
+    /// \return True if Finalize was successful.
+    public: bool Enabled() const
+    {
+      return !this->masks.empty();
+    }
+
+    /// \brief Get the number of groups, including the default group.
+    /// \return Number of groups.
+    public: std::size_t GroupCount() const
+    {
+      return this->groups.size() + 1u;
+    }
+
+    /// \brief Get the name of a group.
+    /// \param[in] _group Index of the group.
+    /// \return Name of the group, "default" for the default group.
+    public: std::string Name(const std::size_t _group) const
+    {
+      return _group < this->groups.size() ? this->groups[_group].name :
+          "default";
+    }
+
+    /// \brief Get the number of colors of a group.
+    /// \param[in] _group Index of the group.
+    /// \return Number of colors, zero before finalizing.
+    public: std::size_t ColorCount(const std::size_t _group) const
+    {
+      if (_group + 1u >= this->firstColor.size())
+        return 0u;
+      return this->firstColor[_group + 1u] - this->firstColor[_group];
+    }
+
+    /// \brief Get the group of a top-level model. The first matching group
+    /// is used.
+    /// \param[in] _model Name of the model.
+    /// \param[in] _static Whether the model is static.
+    /// \return Index of the group, GroupCount() - 1 for the default group.
+    public: std::size_t Group(const std::string &_model,
+                              const bool _static) const
+    {
+      for (std::size_t i = 0; i < this->groups.size(); ++i)
+      {
+        const auto &group = this->groups[i];
+        if (_static && group.matchStatic)
+          return i;
+        for (const auto &prefix : group.prefixes)
+        {
+          if (_model.compare(0, prefix.size(), prefix) == 0)
+            return i;
+        }
+      }
+      return this->groups.size();
+    }
+
+    /// \brief Check whether two groups collide.
+    /// \param[in] _first Index of a group.
+    /// \param[in] _second Index of the other group.
+    /// \return True if they collide.
+    public: bool Collide(const std::size_t _first,
+                         const std::size_t _second) const
+    {
+      const auto pair = std::make_pair(std::min(_first, _second),
+          std::max(_first, _second));
+      return std::find(this->disabled.begin(), this->disabled.end(), pair) ==
+          this->disabled.end();
+    }
+
+    /// \brief Get the color of a top-level model, assigning the next color
+    /// of its group the first time it's queried. Colors are global indices
+    /// across groups.
+    /// \param[in] _model The top-level model.
+    /// \param[in] _name Name of the model.
+    /// \param[in] _static Whether the model is static.
+    /// \return The color, or kNoColor before finalizing.
+    public: std::size_t Color(const Entity _model, const std::string &_name,
+                              const bool _static)
+    {
+      if (!this->Enabled())
+        return kNoColor;
+      auto it = this->colorOfModel.find(_model);
+      if (it != this->colorOfModel.end())
+        return it->second;
+
+      const auto group = this->Group(_name, _static);
+      const auto color = this->firstColor[group] +
+          this->nextColor[group] % this->ColorCount(group);
+      ++this->nextColor[group];
+      this->colorOfModel[_model] = color;
+      return color;
+    }
+
+    /// \brief Forget a top-level model. Its collisions must be removed
+    /// separately.
+    /// \param[in] _model The model.
+    public: void RemoveModel(const Entity _model)
+    {
+      this->colorOfModel.erase(_model);
+    }
+
+    /// \brief Get the bitmask of a color.
+    /// \param[in] _color The color.
+    /// \return Bitmask, or all bits if the color doesn't exist.
+    public: std::uint16_t Mask(const std::size_t _color) const
+    {
+      if (_color >= this->masks.size())
+        return 0xFFFF;
+      return this->masks[_color];
+    }
+
+    /// \brief Count a collision of a color. Counting a collision again has
+    /// no effect, so islands can share the counts.
+    /// \param[in] _collision The collision.
+    /// \param[in] _color The color.
+    public: void AddCollision(const Entity _collision,
+                              const std::size_t _color)
+    {
+      if (_color >= this->counts.size() ||
+          !this->colorOfCollision.emplace(_collision, _color).second)
+      {
+        return;
+      }
+      ++this->counts[_color];
+    }
+
+    /// \brief Stop counting a collision.
+    /// \param[in] _collision The collision.
+    public: void RemoveCollision(const Entity _collision)
+    {
+      auto it = this->colorOfCollision.find(_collision);
+      if (it == this->colorOfCollision.end())
+        return;
+      --this->counts[it->second];
+      this->colorOfCollision.erase(it);
+    }
+
+    /// \brief Get the number of counted collisions in a group.
+    /// \param[in] _group Index of the group.
+    /// \return Number of collisions.
+    public: std::size_t CollisionCount(const std::size_t _group) const
+    {
+      std::size_t count{0u};
+      if (_group + 1u >= this->firstColor.size())
+        return count;
+      for (std::size_t color = this->firstColor[_group];
+           color < this->firstColor[_group + 1u]; ++color)
+      {
+        count += this->counts[color];
+      }
+      return count;
+    }
+
+    /// \brief Get the number of pairs of counted collisions.
+    /// \return Number of pairs.
+    public: std::size_t TotalPairCount() const
+    {
+      return Pairs(this->colorOfCollision.size());
+    }
+
+    /// \brief Get the number of pairs of counted collisions whose bitmasks
+    /// don't share a bit, so the engine doesn't test them.
+    /// \return Number of pairs.
+    public: std::size_t FilteredPairCount() const
+    {
+      std::size_t filtered{0u};
+      for (std::size_t a = 0; a < this->counts.size(); ++a)
+      {
+        if (0u == this->masks[a])
+          filtered += Pairs(this->counts[a]);
+        for (std::size_t b = a + 1u; b < this->counts.size(); ++b)
+        {
+          if (0u == (this->masks[a] & this->masks[b]))
+            filtered += this->counts[a] * this->counts[b];
+        }
+      }
+      return filtered;
+    }
+
+    /// \brief Color of models before finalizing.
+    public: static constexpr std::size_t kNoColor{static_cast<std::size_t>(
+        -1)};
+
+    /// \brief Get the number of pairs among some elements.
+    /// \param[in] _count Number of elements.
+    /// \return Number of pairs.
+    private: static std::size_t Pairs(const std::size_t _count)
+    {
+      return _count > 1u ? _count * (_count - 1u) / 2u : 0u;
+    }
+
+    /// \brief Try to compute the bitmasks with a number of colors for the
+    /// groups that don't collide with themselves.
+    /// \param[in] _colors Number of colors of these groups.
+    /// \return False if more than kMaskBits bits are needed.
+    private: bool Cover(const std::size_t _colors)
+    {
+      const std::size_t groupCount = this->GroupCount();
+      this->firstColor.assign(groupCount + 1u, 0u);
+      std::vector<std::size_t> groupOfColor;
+      for (std::size_t g = 0; g < groupCount; ++g)
+      {
+        const std::size_t colors = this->Collide(g, g) ? 1u : _colors;
+        this->firstColor[g + 1u] = this->firstColor[g] + colors;
+        groupOfColor.insert(groupOfColor.end(), colors, g);
+      }
+
+      // Different colors of a group never collide, and all collisions of a
+      // color collide with each other
+      const std::size_t count = groupOfColor.size();
+      auto collide = [&](std::size_t _a, std::size_t _b)
+      {
+        if (_a == _b)
+          return true;
+        const auto ga = groupOfColor[_a];
+        const auto gb = groupOfColor[_b];
+        return ga != gb && this->Collide(ga, gb);
+      };
+
+      this->masks.assign(count, 0u);
+      std::vector<std::vector<bool>> covered(count,
+          std::vector<bool>(count, false));
+      std::size_t bit{0u};
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        for (std::size_t j = i; j < count; ++j)
+        {
+          // Colors of groups that don't collide with themselves get a bit
+          // from their pairs with other colors
+          const bool needed = i != j ? collide(i, j) :
+              this->Collide(groupOfColor[i], groupOfColor[i]);
+          if (covered[i][j] || !needed)
+            continue;
+          if (bit >= kMaskBits)
+            return false;
+
+          // Grow a set of colors that all collide with each other around
+          // the pair
+          std::vector<std::size_t> members{i};
+          if (j != i)
+            members.push_back(j);
+          for (std::size_t k = 0; k < count; ++k)
+          {
+            if (k == i || k == j)
+              continue;
+            bool all{true};
+            for (auto member : members)
+              all = all && collide(k, member);
+            if (all)
+              members.push_back(k);
+          }
+
+          for (auto a : members)
+          {
+            this->masks[a] |= static_cast<std::uint16_t>(1u << bit);
+            for (auto b : members)
+              covered[std::min(a, b)][std::max(a, b)] = true;
+          }
+          ++bit;
+        }
+      }
+
+      this->nextColor.assign(groupCount, 0u);
+      this->counts.assign(count, 0u);
+      return true;
+    }
+
+    /// \brief Get the index of a group.
+    /// \param[in] _name Name of the group.
+    /// \return Index, or the number of groups if it doesn't exist.
+    private: std::size_t Index(const std::string &_name) const
+    {
+      for (std::size_t i = 0; i < this->groups.size(); ++i)
+      {
+        if (this->groups[i].name == _name)
+          return i;
+      }
+      return this->groups.size();
+    }
+
+    /// \brief A group of models.
+    private: struct GroupInfo
+    {
+      /// \brief Name of the group.
+      std::string name;
+
+      /// \brief Prefixes of the names of its top-level models.
+      std::vector<std::string> prefixes;
+
+      /// \brief Whether static models are in the group.
+      bool matchStatic;
+    };
+
+    /// \brief Groups, without the default group.
+    private: std::vector<GroupInfo> groups;
+
+    /// \brief Pairs of groups that don't collide, smaller index first.
+    private: std::vector<std::pair<std::size_t, std::size_t>> disabled;
+
+    /// \brief First color of each group, and the total number of colors at
+    /// the end.
+    private: std::vector<std::size_t> firstColor;
+
+    /// \brief Bitmask of each color, empty until finalized.
+    private: std::vector<std::uint16_t> masks;
+
+    /// \brief Number of models assigned to each group, to pick the color of
+    /// the next one.
+    private: std::vector<std::size_t> nextColor;
+
+    /// \brief Color of each top-level model.
+    private: std::unordered_map<Entity, std::size_t> colorOfModel;
+
+    /// \brief Color of each counted collision.
+    private: std::unordered_map<Entity, std::size_t> colorOfCollision;
+
+    /// \brief Number of counted collisions of each color.
+    private: std::vector<std::size_t> counts;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "CollisionGroups.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::physics_system;
+
+/////////////////////////////////////////////////
+/// \brief Check whether two bitmasks share a bit.
+/// \param[in] _a A bitmask.
+/// \param[in] _b Another bitmask.
+/// \return True if the engine tests them.
+bool tested(std::uint16_t _a, std::uint16_t _b)
+{
+  return 0u != (_a & _b);
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionGroups, Groups)
+{
+  CollisionGroups groups;
+  EXPECT_FALSE(groups.Enabled());
+  EXPECT_EQ(CollisionGroups::kNoColor, groups.Color(1, "robot_1", false));
+
+  EXPECT_TRUE(groups.AddGroup("terrain", {}, true));
+  EXPECT_TRUE(groups.AddGroup("props", {"crate", "barrel"}, false));
+  EXPECT_FALSE(groups.AddGroup("props", {}, false));
+  EXPECT_TRUE(groups.Disable("terrain", "props"));
+  EXPECT_FALSE(groups.Disable("terrain", "missing"));
+  ASSERT_TRUE(groups.Finalize());
+  EXPECT_TRUE(groups.Enabled());
+  EXPECT_EQ(3u, groups.GroupCount());
+  EXPECT_EQ("default", groups.Name(2));
+
+  EXPECT_EQ(0u, groups.Group("ground", true));
+  EXPECT_EQ(1u, groups.Group("crate_3", false));
+  EXPECT_EQ(1u, groups.Group("barrel", false));
+  EXPECT_EQ(2u, groups.Group("robot", false));
+  EXPECT_FALSE(groups.Collide(0, 1));
+  EXPECT_TRUE(groups.Collide(1, 1));
+  EXPECT_TRUE(groups.Collide(2, 0));
+
+  // Groups that collide with themselves have a single color
+  const auto terrain = groups.Mask(groups.Color(1, "ground", true));
+  const auto crate = groups.Mask(groups.Color(2, "crate", false));
+  const auto barrel = groups.Mask(groups.Color(3, "barrel", false));
+  const auto robot = groups.Mask(groups.Color(4, "robot", false));
+  EXPECT_EQ(crate, barrel);
+  EXPECT_FALSE(tested(terrain, crate));
+  EXPECT_TRUE(tested(terrain, terrain));
+  EXPECT_TRUE(tested(crate, crate));
+  EXPECT_TRUE(tested(robot, terrain));
+  EXPECT_TRUE(tested(robot, crate));
+  EXPECT_TRUE(tested(robot, robot));
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionGroups, Fleet)
+{
+  // Robots don't collide with each other, only with the rest of the world
+  CollisionGroups groups;
+  groups.AddGroup("robots", {"robot_"}, false);
+  groups.Disable("robots", "robots");
+  ASSERT_TRUE(groups.Finalize());
+  EXPECT_EQ(16u, groups.ColorCount(0));
+  EXPECT_EQ(1u, groups.ColorCount(1));
+
+  const auto world = groups.Mask(groups.Color(100, "ground", true));
+  std::vector<std::uint16_t> robots;
+  for (Entity robot = 0; robot < 32; ++robot)
+  {
+    robots.push_back(groups.Mask(groups.Color(robot,
+        "robot_" + std::to_string(robot), false)));
+    EXPECT_TRUE(tested(world, robots.back()));
+  }
+
+  // Only robots of the same color are tested against each other
+  for (std::size_t i = 0; i < robots.size(); ++i)
+  {
+    for (std::size_t j = i + 1u; j < robots.size(); ++j)
+      EXPECT_EQ(j - i == 16u, tested(robots[i], robots[j])) << i << " " << j;
+  }
+
+  // A robot keeps its color
+  EXPECT_EQ(robots[3], groups.Mask(groups.Color(3, "robot_3", false)));
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionGroups, Statistics)
+{
+  CollisionGroups groups;
+  groups.AddGroup("static", {}, true);
+  groups.Disable("static", "static");
+  ASSERT_TRUE(groups.Finalize());
+  EXPECT_EQ(0u, groups.TotalPairCount());
+
+  // Four static collisions on different colors, and two dynamic ones
+  for (Entity model = 1; model <= 4; ++model)
+    groups.AddCollision(10 + model, groups.Color(model, "wall", true));
+  const auto robot = groups.Color(5, "robot", false);
+  groups.AddCollision(20, robot);
+  groups.AddCollision(21, robot);
+  groups.AddCollision(21, robot);
+  EXPECT_EQ(4u, groups.CollisionCount(0));
+  EXPECT_EQ(2u, groups.CollisionCount(1));
+  EXPECT_EQ(15u, groups.TotalPairCount());
+  EXPECT_EQ(6u, groups.FilteredPairCount());
+
+  groups.RemoveCollision(11);
+  groups.RemoveCollision(11);
+  EXPECT_EQ(3u, groups.CollisionCount(0));
+  EXPECT_EQ(10u, groups.TotalPairCount());
+  EXPECT_EQ(3u, groups.FilteredPairCount());
+}
+
+/////////////////////////////////////////////////
+TEST(CollisionGroups, TooManyBits)
+{
+  // 17 groups that only collide with the default group need a bit each,
+  // even with a single color per group
+  CollisionGroups groups;
+  for (int i = 0; i < 17; ++i)
+  {
+    groups.AddGroup(std::to_string(i), {std::to_string(i)}, false);
+    for (int j = 0; j <= i; ++j)
+      groups.Disable(std::to_string(i), std::to_string(j));
+  }
+  EXPECT_FALSE(groups.Finalize());
+  EXPECT_FALSE(groups.Enabled());
+}
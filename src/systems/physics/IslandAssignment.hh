@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_PHYSICS_ISLAND_ASSIGNMENT_HH_
+#define GZ_SIM_SYSTEMS_PHYSICS_ISLAND_ASSIGNMENT_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/sim/Entity.hh"
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::physics_system
+{
+  /// \brief Helper class that assigns top-level models to simulation
+  /// islands. Each island is simulated by its own physics engine instance,
+  /// so models in different islands can't interact physically, and islands
+  /// can be stepped concurrently.
+  ///
+  /// A model is assigned to the island with the fewest models the first time
+  /// it's queried, and keeps that island until it's removed.
+  class IslandAssignment
+  {
+    /// \brief Constructor
+    /// \param[in] _count Number of islands, at least one.
+    public: explicit IslandAssignment(std::size_t _count)
+      : modelCounts(std::max<std::size_t>(_count, 1u), 0u)
+    {
+    }
+
+    /// \brief Get the number of islands.
+    /// \return Number of islands.
+    public: std::size_t Count() const
+    {
+      return this->modelCounts.size();
+    }
+
+    /// \brief Get the island of a top-level model, assigning one if the
+    /// model doesn't have one yet.
+    /// \param[in] _model The top-level model.
+    /// \return Index of the island, smaller than Count().
+    public: std::size_t Island(const Entity _model)
+    {
+      auto it = this->islandOfModel.find(_model);
+      if (it != this->islandOfModel.end())
+        return it->second;
+
+      auto minIt = std::min_element(this->modelCounts.begin(),
+          this->modelCounts.end());
+      const auto island =
+          static_cast<std::size_t>(minIt - this->modelCounts.begin());
+      ++(*minIt);
+      this->islandOfModel[_model] = island;
+      return island;
+    }
+
+    /// \brief Remove a top-level model, so its island can take other models.
+    /// Removing models that don't have an island has no effect.
+    /// \param[in] _model The top-level model.
+    public: void Remove(const Entity _model)
+    {
+      auto it = this->islandOfModel.find(_model);
+      if (it == this->islandOfModel.end())
+        return;
+
+      --this->modelCounts[it->second];
+      this->islandOfModel.erase(it);
+    }
+
+    /// \brief Get the number of models in an island.
+    /// \param[in] _island Index of the island.
+    /// \return Number of models, or zero if the island doesn't exist.
+    public: std::size_t ModelCount(const std::size_t _island) const
+    {
+      if (_island >= this->modelCounts.size())
+        return 0u;
+      return this->modelCounts[_island];
+    }
+
+    /// \brief Island of each top-level model.
+    private: std::unordered_map<Entity, std::size_t> islandOfModel;
+
+    /// \brief Number of models in each island.
+    private: std::vector<std::size_t> modelCounts;
+  };
+}
+}
+}
+
+#endif
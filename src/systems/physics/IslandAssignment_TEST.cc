@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "IslandAssignment.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::physics_system;
+
+/////////////////////////////////////////////////
+TEST(IslandAssignment, Balanced)
+{
+  IslandAssignment islands(3);
+  EXPECT_EQ(3u, islands.Count());
+
+  EXPECT_EQ(0u, islands.Island(10));
+  EXPECT_EQ(1u, islands.Island(11));
+  EXPECT_EQ(2u, islands.Island(12));
+  EXPECT_EQ(0u, islands.Island(13));
+
+  // Models keep their island
+  EXPECT_EQ(1u, islands.Island(11));
+  EXPECT_EQ(2u, islands.ModelCount(0));
+  EXPECT_EQ(1u, islands.ModelCount(1));
+  EXPECT_EQ(0u, islands.ModelCount(5));
+
+  // Removed models make room in their island
+  islands.Remove(12);
+  islands.Remove(12);
+  islands.Remove(99);
+  EXPECT_EQ(0u, islands.ModelCount(2));
+  EXPECT_EQ(2u, islands.Island(14));
+  EXPECT_EQ(1u, islands.Island(15));
+}
+
+/////////////////////////////////////////////////
+TEST(IslandAssignment, AtLeastOne)
+{
+  IslandAssignment islands(0);
+  EXPECT_EQ(1u, islands.Count());
+  EXPECT_EQ(0u, islands.Island(1));
+  EXPECT_EQ(0u, islands.Island(2));
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_PHYSICS_LINK_FRAME_DATA_LIST_HH_
+#define GZ_SIM_SYSTEMS_PHYSICS_LINK_FRAME_DATA_LIST_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gz/physics/FrameData.hh>
+
+#include "gz/sim/Entity.hh"
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::physics_system
+{
+  /// \brief Frame data of the links that experienced a pose change in the
+  /// most recent physics step, in the order in which they should be written
+  /// back to the ECM.
+  ///
+  /// Links are stored contiguously. The links reported by the physics engine
+  /// are sorted by entity, so that canonical links are visited in topological
+  /// order, and links that are added while updating model poses are appended
+  /// after them, so they're visited after the model that added them. The
+  /// storage is kept across steps to avoid reallocating it.
+  class LinkFrameDataList
+  {
+    /// \brief A link and its frame data.
+    public: using Entry = std::pair<Entity, physics::FrameData3d>;
+
+    /// \brief Remove all links, keeping the storage.
+    public: void Clear()
+    {
+      this->entries.clear();
+      this->sortedCount = 0;
+    }
+
+    /// \brief Add a link. Links added before Sort() is called are sorted,
+    /// links added after are kept in insertion order.
+    /// \param[in] _link The link entity. It must not be in the list yet.
+    /// \param[in] _data Frame data of the link.
+    public: void Add(const Entity _link, const physics::FrameData3d &_data)
+    {
+      this->entries.emplace_back(_link, _data);
+    }
+
+    /// \brief Sort the links added so far by entity.
+    public: void Sort()
+    {
+      std::sort(this->entries.begin(), this->entries.end(),
+          [](const Entry &_a, const Entry &_b)
+          {
+            return _a.first < _b.first;
+          });
+      this->sortedCount = this->entries.size();
+    }
+
+    /// \brief Check whether a link is in the list.
+    /// \param[in] _link The link entity.
+    /// \return True if the link is in the list.
+    public: bool Has(const Entity _link) const
+    {
+      auto sortedEnd = this->entries.begin() +
+          static_cast<std::ptrdiff_t>(this->sortedCount);
+      auto it = std::lower_bound(this->entries.begin(), sortedEnd, _link,
+          [](const Entry &_entry, const Entity _entity)
+          {
+            return _entry.first < _entity;
+          });
+      if (it != sortedEnd && it->first == _link)
+        return true;
+
+      return std::any_of(sortedEnd, this->entries.end(),
+          [&](const Entry &_entry)
+          {
+            return _entry.first == _link;
+          });
+    }
+
+    /// \brief Get the number of links.
+    /// \return Number of links.
+    public: std::size_t Size() const
+    {
+      return this->entries.size();
+    }
+
+    /// \brief Get a link. References are invalidated when links are added,
+    /// so the list should be indexed while links may be added to it.
+    /// \param[in] _index Index of the link, smaller than Size().
+    /// \return The link and its frame data.
+    public: const Entry &operator[](const std::size_t _index) const
+    {
+      return this->entries[_index];
+    }
+
+    /// \brief Iterator to the first link.
+    /// \return Begin iterator.
+    public: std::vector<Entry>::const_iterator begin() const
+    {
+      return this->entries.begin();
+    }
+
+    /// \brief Iterator past the last link.
+    /// \return End iterator.
+    public: std::vector<Entry>::const_iterator end() const
+    {
+      return this->entries.end();
+    }
+
+    /// \brief Links and their frame data.
+    private: std::vector<Entry> entries;
+
+    /// \brief Number of entries at the front that are sorted by entity.
+    private: std::size_t sortedCount{0};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "LinkFrameDataList.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::physics_system;
+
+/////////////////////////////////////////////////
+physics::FrameData3d frameDataAt(double _x)
+{
+  physics::FrameData3d data;
+  data.pose.translation() = Eigen::Vector3d(_x, 0, 0);
+  return data;
+}
+
+/////////////////////////////////////////////////
+TEST(LinkFrameDataList, SortedThenAppended)
+{
+  LinkFrameDataList list;
+  EXPECT_EQ(0u, list.Size());
+  EXPECT_FALSE(list.Has(1));
+
+  list.Add(5, frameDataAt(5));
+  list.Add(2, frameDataAt(2));
+  list.Add(9, frameDataAt(9));
+  list.Sort();
+
+  // Links added before sorting are in entity order
+  ASSERT_EQ(3u, list.Size());
+  EXPECT_EQ(2u, list[0].first);
+  EXPECT_EQ(5u, list[1].first);
+  EXPECT_EQ(9u, list[2].first);
+  EXPECT_DOUBLE_EQ(5.0, list[1].second.pose.translation().x());
+
+  // Links added after sorting keep their insertion order
+  list.Add(7, frameDataAt(7));
+  list.Add(1, frameDataAt(1));
+  ASSERT_EQ(5u, list.Size());
+  EXPECT_EQ(7u, list[3].first);
+  EXPECT_EQ(1u, list[4].first);
+
+  for (Entity link : {1u, 2u, 5u, 7u, 9u})
+    EXPECT_TRUE(list.Has(link)) << link;
+  for (Entity link : {0u, 3u, 6u, 8u, 10u})
+    EXPECT_FALSE(list.Has(link)) << link;
+
+  std::vector<Entity> visited;
+  for (const auto &[link, data] : list)
+    visited.push_back(link);
+  EXPECT_EQ(std::vector<Entity>({2, 5, 9, 7, 1}), visited);
+}
+
+/////////////////////////////////////////////////
+TEST(LinkFrameDataList, Clear)
+{
+  LinkFrameDataList list;
+  list.Add(3, frameDataAt(3));
+  list.Sort();
+  list.Add(4, frameDataAt(4));
+
+  list.Clear();
+  EXPECT_EQ(0u, list.Size());
+  EXPECT_FALSE(list.Has(3));
+  EXPECT_FALSE(list.Has(4));
+
+  // Links added after clearing without sorting are found too
+  list.Add(8, frameDataAt(8));
+  EXPECT_TRUE(list.Has(8));
+}
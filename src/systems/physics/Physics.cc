@@ -20,14 +20,21 @@
 #include <gz/msgs/contact.pb.h>
 #include <gz/msgs/contacts.pb.h>
 #include <gz/msgs/entity.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/Utility.hh>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <deque>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
+#include <sstream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -78,6 +85,7 @@
 #include <gz/plugin/Loader.hh>
 #include <gz/plugin/PluginPtr.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
 
 // SDF
 #include <sdf/Collision.hh>
@@ -90,11 +98,14 @@
 #include <sdf/Surface.hh>
 #include <sdf/World.hh>
 
+#include "gz/sim/ComponentHandle.hh"
 #include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
+#include "gz/sim/WrenchAccumulator.hh"
 
 // Components
+#include "gz/sim/components/ActivityLevel.hh"
 #include "gz/sim/components/Actor.hh"
 #include "gz/sim/components/AngularAcceleration.hh"
 #include "gz/sim/components/AngularVelocity.hh"
@@ -104,6 +115,7 @@
 #include "gz/sim/components/CanonicalLink.hh"
 #include "gz/sim/components/ChildLinkName.hh"
 #include "gz/sim/components/Collision.hh"
+#include "gz/sim/components/ContactBuffer.hh"
 #include "gz/sim/components/ContactSensorData.hh"
 #include "gz/sim/components/Geometry.hh"
 #include "gz/sim/components/Gravity.hh"
@@ -135,8 +147,10 @@
 #include "gz/sim/components/PhysicsEnginePlugin.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/PoseCmd.hh"
+#include "gz/sim/components/RaycastData.hh"
 #include "gz/sim/components/Recreate.hh"
 #include "gz/sim/components/SelfCollide.hh"
+#include "gz/sim/components/Sleeping.hh"
 #include "gz/sim/components/SlipComplianceCmd.hh"
 #include "gz/sim/components/SphericalCoordinates.hh"
 #include "gz/sim/components/Static.hh"
@@ -144,7 +158,13 @@
 #include "gz/sim/components/World.hh"
 #include "gz/sim/components/HaltMotion.hh"
 
+#include "../../CollisionRayCaster.hh"
+#include "../../ThreadPool.hh"
 #include "CanonicalLinkModelTracker.hh"
+#include "CollisionGroups.hh"
+#include "IslandAssignment.hh"
+#include "LinkFrameDataList.hh"
+#include "SleepTracker.hh"
 // Events
 #include "gz/sim/physics/Events.hh"
 
@@ -197,6 +217,15 @@ class gz::sim::systems::PhysicsPrivate
   public: using FreeGroupPtrType = physics::FreeGroupPtr<
             physics::FeaturePolicy3d, MinimumFeatureList>;
 
+  /// \brief Apply the commands in heldJointForces, heldJointVelocities,
+  /// heldLinkWrenches, heldLinearVelocities and heldAngularVelocities again.
+  public: void ReapplyHeldCommands();
+
+  /// \brief Update the number of substeps from the world's PhysicsSubsteps
+  /// component, if it has one.
+  /// \param[in] _ecm Constant reference to ECM.
+  public: void UpdateSubsteps(const EntityComponentManager &_ecm);
+
   /// \brief Create physics entities
   /// \param[in] _ecm Constant reference to ECM.
   /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
@@ -238,6 +267,135 @@ class gz::sim::systems::PhysicsPrivate
   public: void CreateJointEntities(const EntityComponentManager &_ecm,
                                    bool _warnIfEntityExists = true);
 
+  /// \brief Create a model entity
+  /// \param[in] _entity The model.
+  /// \param[in] _name Name of the model.
+  /// \param[in] _pose Pose of the model.
+  /// \param[in] _parent Parent of the model.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  /// \return False if no more models can be created.
+  public: bool CreateModelEntity(const Entity _entity,
+              const components::Name *_name, const components::Pose *_pose,
+              const components::ParentEntity *_parent,
+              const EntityComponentManager &_ecm, bool _warnIfEntityExists);
+
+  /// \brief Create a link entity
+  /// \param[in] _entity The link.
+  /// \param[in] _name Name of the link.
+  /// \param[in] _pose Pose of the link.
+  /// \param[in] _parent Parent of the link.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  /// \return False if no more links can be created.
+  public: bool CreateLinkEntity(const Entity _entity,
+              const components::Name *_name, const components::Pose *_pose,
+              const components::ParentEntity *_parent,
+              const EntityComponentManager &_ecm, bool _warnIfEntityExists);
+
+  /// \brief Create a collision entity
+  /// \param[in] _entity The collision.
+  /// \param[in] _name Name of the collision.
+  /// \param[in] _pose Pose of the collision.
+  /// \param[in] _geom Geometry of the collision.
+  /// \param[in] _collElement SDF element of the collision.
+  /// \param[in] _parent Parent of the collision.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  /// \return False if no more collisions can be created.
+  public: bool CreateCollisionEntity(const Entity _entity,
+              const components::Name *_name, const components::Pose *_pose,
+              const components::Geometry *_geom,
+              const components::CollisionElement *_collElement,
+              const components::ParentEntity *_parent,
+              const EntityComponentManager &_ecm, bool _warnIfEntityExists);
+
+  /// \brief Create a joint entity
+  /// \param[in] _entity The joint.
+  /// \param[in] _name Name of the joint.
+  /// \param[in] _jointType Type of the joint.
+  /// \param[in] _pose Pose of the joint.
+  /// \param[in] _threadPitch Thread pitch of the joint.
+  /// \param[in] _parentModel Model of the joint.
+  /// \param[in] _parentLinkName Name of the parent link.
+  /// \param[in] _childLinkName Name of the child link.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  /// \return False if no more joints can be created.
+  public: bool CreateJointEntity(const Entity _entity,
+              const components::Name *_name,
+              const components::JointType *_jointType,
+              const components::Pose *_pose,
+              const components::ThreadPitch *_threadPitch,
+              const components::ParentEntity *_parentModel,
+              const components::ParentLinkName *_parentLinkName,
+              const components::ChildLinkName *_childLinkName,
+              const EntityComponentManager &_ecm, bool _warnIfEntityExists);
+
+  /// \brief Create a detachable joint entity
+  /// \param[in] _entity The joint.
+  /// \param[in] _jointInfo Links and type of the joint.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  /// \return False if no more detachable joints can be created.
+  public: bool CreateDetachableJointEntity(const Entity _entity,
+              const components::DetachableJoint *_jointInfo,
+              const EntityComponentManager &_ecm, bool _warnIfEntityExists);
+
+  /// \brief Detach and re-attach the detachable joints whose
+  /// `components::DetachableJointEnabled` changed, keeping their entities.
+  /// \param[in] _ecm Constant reference to ECM.
+  public: void UpdateDetachableJoints(const EntityComponentManager &_ecm);
+
+  /// \brief Create a model, its nested models, and all of their links,
+  /// collisions and joints, in that order.
+  /// \param[in] _model The top-level model.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  public: void CreateModelTree(const Entity _model,
+              const EntityComponentManager &_ecm, bool _warnIfEntityExists);
+
+  /// \brief Create the models that were deferred in previous steps, within
+  /// the budget of this step.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _warnIfEntityExists True to emit warnings if the same entity
+  /// already exists in the physics system
+  public: void CreatePendingEntities(const EntityComponentManager &_ecm,
+              bool _warnIfEntityExists = true);
+
+  /// \brief Check whether the creation of a new model should be deferred
+  /// to a later step, because the budget of this step was used up. Only
+  /// top-level models are deferred, and their descendants with them.
+  /// \param[in] _model The new model.
+  /// \param[in] _parent Parent of the model.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \return True if the model shouldn't be created now.
+  public: bool DeferModel(const Entity _model, const Entity _parent,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Check whether an entity belongs to a model whose creation was
+  /// deferred.
+  /// \param[in] _entity The entity.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \return True if the entity will be created in a later step.
+  public: bool Pending(const Entity _entity,
+              const EntityComponentManager &_ecm) const;
+
+  /// \brief Get the top-level model of an entity, using the top-level model
+  /// of its parent if the parent was already created, so that new entities
+  /// don't need to walk up the entity tree.
+  /// \param[in] _entity The entity.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \return The top-level model, or kNullEntity if there's none.
+  public: Entity TopLevelModel(const Entity _entity,
+              const EntityComponentManager &_ecm) const;
+
   /// \brief Create Battery entities
   /// \param[in] _ecm Constant reference to ECM.
   public: void CreateBatteryEntities(const EntityComponentManager &_ecm);
@@ -267,28 +425,58 @@ class gz::sim::systems::PhysicsPrivate
   /// that were written to by the physics engine (some physics engines may
   /// not write this data to ForwardStep::Output. If not, _ecm is used to get
   /// this updated link pose data).
-  /// \return A map of gazebo link entities to their updated pose data.
-  /// std::map is used because canonical links must be in topological order
-  /// to ensure that nested models with multiple canonical links are updated
-  /// properly (models must be updated in topological order).
-  public: std::map<Entity, physics::FrameData3d> ChangedLinks(
-              EntityComponentManager &_ecm,
-              const gz::physics::ForwardStep::Output &_updatedLinks);
+  /// \param[out] _linkFrameData Gazebo link entities and their updated pose
+  /// data, sorted by entity because canonical links must be in topological
+  /// order to ensure that nested models with multiple canonical links are
+  /// updated properly (models must be updated in topological order).
+  public: void ChangedLinks(EntityComponentManager &_ecm,
+              const gz::physics::ForwardStep::Output &_updatedLinks,
+              LinkFrameDataList &_linkFrameData);
 
   /// \brief Helper function to update the pose of a model.
   /// \param[in] _model The model to update.
   /// \param[in] _canonicalLink The canonical link of _model.
+  /// \param[in] _linkWorldPose World pose of _canonicalLink.
   /// \param[in] _ecm The entity component manager.
   /// \param[in, out] _linkFrameData Links that experienced a pose change in the
-  /// most recent physics step. The key is the entity of the link, and the
-  /// value is the updated frame data corresponding to that entity. The
+  /// most recent physics step, with their updated frame data. The
   /// canonical links of _model's nested models are added to _linkFrameData to
   /// ensure that all of _model's nested models are marked as models to be
   /// updated (if a parent model's pose changes, all nested model poses must be
   /// updated since nested model poses are saved w.r.t. the parent model).
   public: void UpdateModelPose(const Entity _model,
-              const Entity _canonicalLink, EntityComponentManager &_ecm,
-              std::map<Entity, physics::FrameData3d> &_linkFrameData);
+              const Entity _canonicalLink, const math::Pose3d &_linkWorldPose,
+              EntityComponentManager &_ecm,
+              LinkFrameDataList &_linkFrameData);
+
+  /// \brief Update the sleep state of a link after a physics step, adding
+  /// or removing its Sleeping component when it falls asleep or wakes up.
+  /// \param[in] _link The link.
+  /// \param[in] _frameData Frame data of the link after the step.
+  /// \param[in] _ecm The entity component manager.
+  /// \return True if the link is asleep, so its results shouldn't be
+  /// written back.
+  public: bool UpdateSleep(const Entity _link,
+              const physics::FrameData3d &_frameData,
+              EntityComponentManager &_ecm);
+
+  /// \brief Check whether the results of a link should be written back
+  /// on a later iteration, because its model is far from the performers.
+  /// \param[in] _link The link.
+  /// \param[in] _ecm The entity component manager.
+  /// \return True if writing the link's results back is deferred.
+  public: bool ActivityDeferred(const Entity _link,
+              const EntityComponentManager &_ecm) const;
+
+  /// \brief Wake up the sleeping links that are about to be moved by pose,
+  /// velocity, wrench or joint commands.
+  /// \param[in] _ecm The entity component manager.
+  public: void WakeCommandedLinks(EntityComponentManager &_ecm);
+
+  /// \brief Wake up a link if it's asleep.
+  /// \param[in] _link The link.
+  /// \param[in] _ecm The entity component manager.
+  public: void WakeLink(const Entity _link, EntityComponentManager &_ecm);
 
   /// \brief Get an entity's frame data relative to world from physics.
   /// \param[in] _entity The entity.
@@ -301,15 +489,21 @@ class gz::sim::systems::PhysicsPrivate
   /// \brief Update components from physics simulation
   /// \param[in] _ecm Mutable reference to ECM.
   /// \param[in, out] _linkFrameData Links that experienced a pose change in the
-  /// most recent physics step. The key is the entity of the link, and the
-  /// value is the updated frame data corresponding to that entity.
+  /// most recent physics step, with their updated frame data.
   public: void UpdateSim(EntityComponentManager &_ecm,
-              std::map<Entity, physics::FrameData3d> &_linkFrameData);
+              LinkFrameDataList &_linkFrameData);
 
   /// \brief Update collision components from physics simulation
   /// \param[in] _ecm Mutable reference to ECM.
   public: void UpdateCollisions(EntityComponentManager &_ecm);
 
+  /// \brief Cast the rays of all RaycastData components against the
+  /// collisions at their current poses, and write the results.
+  /// \param[in] _info Update info.
+  /// \param[in] _ecm Mutable reference to ECM.
+  public: void UpdateRayIntersections(const UpdateInfo &_info,
+      EntityComponentManager &_ecm);
+
   /// \brief FrameData relative to world at a given offset pose
   /// \param[in] _link gz-physics link
   /// \param[in] _pose Offset pose in which to compute the frame data
@@ -337,6 +531,67 @@ class gz::sim::systems::PhysicsPrivate
   /// The key is an entity and the value is its top level model.
   public: std::unordered_map<Entity, Entity> topLevelModelMap;
 
+  /// \brief Maximum number of top-level models created per step. Zero
+  /// creates all new models right away.
+  public: std::size_t modelsPerStep{0u};
+
+  /// \brief Number of physics steps per simulation iteration. Each step
+  /// advances the worlds by the iteration's time step divided by this.
+  public: unsigned int substeps{1u};
+
+  /// \brief Force commands applied to joints in the current iteration, as
+  /// the joint and its forces per degree of freedom. Physics engines clear
+  /// commands after each step, so these are applied again before every
+  /// substep after the first. Only recorded when there are substeps.
+  public: std::vector<std::pair<Entity, std::vector<double>>>
+      heldJointForces;
+
+  /// \brief Velocity commands applied to joints in the current iteration,
+  /// see heldJointForces.
+  public: std::vector<std::pair<Entity, std::vector<double>>>
+      heldJointVelocities;
+
+  /// \brief Wrenches applied to links in the current iteration, as the link,
+  /// force and torque in the world frame, see heldJointForces.
+  public: std::vector<std::tuple<Entity, math::Vector3d, math::Vector3d>>
+      heldLinkWrenches;
+
+  /// \brief Linear velocity commands applied to models and links in the
+  /// current iteration, as the entity of the free group and the velocity in
+  /// the world frame, see heldJointForces.
+  public: std::vector<std::pair<Entity, math::Vector3d>>
+      heldLinearVelocities;
+
+  /// \brief Angular velocity commands applied to models and links in the
+  /// current iteration, see heldLinearVelocities.
+  public: std::vector<std::pair<Entity, math::Vector3d>>
+      heldAngularVelocities;
+
+  /// \brief Number of top-level models that can still be created in the
+  /// current step.
+  public: std::size_t modelBudget{0u};
+
+  /// \brief Top-level models whose creation was deferred, in the order in
+  /// which they should be created. Models that were removed since are
+  /// skipped.
+  public: std::deque<Entity> pendingModels;
+
+  /// \brief Set of the models in pendingModels that still have to be
+  /// created.
+  public: std::unordered_set<Entity> pendingModelSet;
+
+  /// \brief Detachable joints between links of pending models.
+  public: std::vector<Entity> pendingDetachableJoints;
+
+  /// \brief Detachable joints that are disabled by their
+  /// `components::DetachableJointEnabled`, so they have no physics joint.
+  public: std::unordered_set<Entity> disabledDetachableJoints;
+
+  /// \brief Slip compliance last set on each collision from its
+  /// `components::SlipComplianceCmd`, so unchanged commands are skipped.
+  public: std::unordered_map<Entity, std::array<double, 2>>
+          appliedSlipCompliance;
+
   /// \brief Keep track of what entities are static (models and links).
   public: std::unordered_set<Entity> staticEntities;
 
@@ -355,6 +610,67 @@ class gz::sim::systems::PhysicsPrivate
   /// most recent model world pose change that took place.
   public: std::unordered_map<Entity, math::Pose3d> modelWorldPoses;
 
+  /// \brief Links that experienced a pose change in the most recent physics
+  /// step. Kept across steps to reuse its storage.
+  public: LinkFrameDataList changedLinks;
+
+  /// \brief Tracks which links are resting, so their results aren't
+  /// written back. It's empty when sleeping is disabled.
+  public: std::optional<SleepTracker> sleepTracker;
+
+  /// \brief Links whose latest results weren't written back because of
+  /// the activity level of their models.
+  public: std::unordered_set<Entity> activityDeferredLinks;
+
+  /// \brief Iteration being updated, to update the links of far models at
+  /// reduced rates.
+  public: uint64_t iteration{0};
+
+  /// \brief Components of a link that are written after every physics step.
+  public: struct LinkComponents
+  {
+    /// \brief Pose of the link w.r.t. its model.
+    public: ComponentHandle<components::Pose> pose;
+
+    /// \brief Marks canonical links, whose pose isn't written.
+    public: ComponentHandle<components::CanonicalLink> canonicalLink;
+
+    /// \brief World pose, if requested by another system.
+    public: ComponentHandle<components::WorldPose> worldPose;
+
+    /// \brief World linear velocity, if requested by another system.
+    public: ComponentHandle<components::WorldLinearVelocity> worldLinVel;
+
+    /// \brief World angular velocity, if requested by another system.
+    public: ComponentHandle<components::WorldAngularVelocity> worldAngVel;
+
+    /// \brief World linear acceleration, if requested by another system.
+    public: ComponentHandle<components::WorldLinearAcceleration>
+                worldLinAccel;
+
+    /// \brief World angular acceleration, if requested by another system.
+    public: ComponentHandle<components::WorldAngularAcceleration>
+                worldAngAccel;
+
+    /// \brief Body linear velocity, if requested by another system.
+    public: ComponentHandle<components::LinearVelocity> bodyLinVel;
+
+    /// \brief Body angular velocity, if requested by another system.
+    public: ComponentHandle<components::AngularVelocity> bodyAngVel;
+
+    /// \brief Body linear acceleration, if requested by another system.
+    public: ComponentHandle<components::LinearAcceleration> bodyLinAccel;
+
+    /// \brief Body angular acceleration, if requested by another system.
+    public: ComponentHandle<components::AngularAcceleration> bodyAngAccel;
+  };
+
+  /// \brief Handles to the components of links that have been updated from
+  /// physics, so that they're looked up only once instead of once per step.
+  /// Most of these components are usually missing, and their handles only
+  /// look them up again after components are added to the ECM.
+  public: std::unordered_map<Entity, LinkComponents> linkComponents;
+
   /// \brief A map between model entity ids in the ECM to whether its battery
   /// has drained.
   public: std::unordered_map<Entity, bool> entityOffMap;
@@ -747,6 +1063,79 @@ class gz::sim::systems::PhysicsPrivate
   /// \brief Flag to store whether the names of colliding entities should
   /// be populated in the contact points.
   public: bool contactsEntityNames = true;
+
+  /// \brief Check whether an entity is simulated by this instance. Without
+  /// islands, all entities are. With islands, entities of non-static
+  /// top-level models belong to the island of their model, and the world,
+  /// static models and their descendants belong to all islands.
+  /// \param[in] _entity The entity.
+  /// \param[in] _ecm The entity component manager.
+  /// \return True if the entity should be created in this island.
+  public: bool InIsland(const Entity _entity,
+              const EntityComponentManager &_ecm) const;
+
+  /// \brief Whether entities that are missing from the physics maps should
+  /// be reported. With islands, the entities of other islands are missing
+  /// from the maps of this island, and the entities of models whose
+  /// creation was deferred are missing until they're created.
+  /// \return True if missing entities are unexpected.
+  public: bool ReportMissingEntities() const;
+
+  /// \brief Update all islands: create and update their physics entities,
+  /// step them concurrently, and write their results back to the ECM one
+  /// island at a time. This is only called on the first island.
+  /// \param[in] _info Update info.
+  /// \param[in] _ecm Mutable reference to ECM.
+  public: void UpdateIslands(const UpdateInfo &_info,
+              EntityComponentManager &_ecm);
+
+  /// \brief Assignment of top-level models to islands, shared by all
+  /// islands. It's null when the world isn't split into islands.
+  public: std::shared_ptr<IslandAssignment> islandAssignment;
+
+  /// \brief Index of the island simulated by this instance.
+  public: std::size_t island{0};
+
+  /// \brief The other islands, each with its own engine. Only the first
+  /// island, which is the one owned by the Physics system, holds them.
+  public: std::vector<std::unique_ptr<PhysicsPrivate>> otherIslands;
+
+  /// \brief True to step the islands concurrently on the shared thread
+  /// pool, false to step them one after the other.
+  public: bool concurrentIslands{false};
+
+  /// \brief Output of the latest step of this island.
+  public: gz::physics::ForwardStep::Output stepOutput;
+
+  /// \brief Collision shapes that RaycastData rays are cast against,
+  /// shared with the sensor systems that cast rays.
+  public: std::shared_ptr<CollisionRayCaster> rayCaster;
+
+  /// \brief Get the collision filter bitmask of a new collision. Collisions
+  /// that keep the default bitmask of SDF get the bitmask of their
+  /// top-level model's collision group, and are counted for the statistics.
+  /// \param[in] _collision The collision.
+  /// \param[in] _bitmask The collide_bitmask from SDF.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \return The bitmask to set on the physics engine.
+  public: std::uint16_t CollisionGroupMask(const Entity _collision,
+              const std::uint16_t _bitmask,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Publish the collision pair counts of the collision groups, if
+  /// anyone is listening.
+  public: void PublishCollisionGroupStatistics();
+
+  /// \brief Groups of models that don't collide with each other, shared by
+  /// all islands. It's null when the world has no collision groups.
+  public: std::shared_ptr<CollisionGroups> collisionGroups;
+
+  /// \brief Node that publishes collision group statistics. It's null
+  /// unless they were requested.
+  public: std::unique_ptr<transport::Node> collisionGroupsNode;
+
+  /// \brief Publisher of collision group statistics.
+  public: transport::Node::Publisher collisionGroupsPub;
 };
 
 //////////////////////////////////////////////////
@@ -840,6 +1229,7 @@ void Physics::Configure(const Entity &_entity,
   }
 
   // Get the first plugin that works
+  std::string engineClassName;
   for (auto className : classNames)
   {
     auto plugin = pluginLoader.Instantiate(className);
@@ -859,6 +1249,7 @@ void Physics::Configure(const Entity &_entity,
     {
       gzdbg << "Loaded [" << className << "] from library ["
              << pathToLib << "]" << std::endl;
+      engineClassName = className;
       break;
     }
 
@@ -885,6 +1276,166 @@ void Physics::Configure(const Entity &_entity,
   }
 
   this->dataPtr->eventManager = &_eventMgr;
+
+  // Optionally spread the creation of models that are spawned together
+  // over several steps
+  auto creationElem = _sdf->FindElement("creation");
+  if (creationElem)
+  {
+    this->dataPtr->modelsPerStep =
+        creationElem->Get<unsigned int>("models_per_step", 0u).first;
+  }
+
+  // Optionally run several physics steps per simulation iteration
+  if (_sdf->HasElement("substeps"))
+  {
+    const auto substeps = _sdf->Get<int>("substeps");
+    if (substeps >= 1)
+    {
+      this->dataPtr->substeps = static_cast<unsigned int>(substeps);
+    }
+    else
+    {
+      gzerr << "<substeps> must be at least 1, got [" << substeps
+             << "]. Using 1 substep." << std::endl;
+    }
+  }
+
+  // The world's PhysicsSubsteps component holds the number of substeps. If
+  // the server configuration didn't set it, it starts with the plugin's.
+  if (nullptr == _ecm.Component<components::PhysicsSubsteps>(_entity))
+  {
+    _ecm.CreateComponent(_entity,
+        components::PhysicsSubsteps(this->dataPtr->substeps));
+  }
+
+  // Optionally stop writing back the results of links that are resting
+  auto sleepElem = _sdf->FindElement("sleep");
+  if (sleepElem)
+  {
+    this->dataPtr->sleepTracker.emplace(
+        sleepElem->Get<double>("linear_threshold", 0.01).first,
+        sleepElem->Get<double>("angular_threshold", 0.01).first,
+        sleepElem->Get<unsigned int>("steps", 100u).first);
+  }
+
+  // Optionally filter out pairs of models that never collide with collision
+  // bitmasks
+  auto groupsElem = _sdf->FindElement("collision_groups");
+  if (groupsElem)
+  {
+    auto groups = std::make_shared<CollisionGroups>();
+    bool valid{true};
+    for (auto groupElem = groupsElem->FindElement("group"); groupElem;
+         groupElem = groupElem->GetNextElement("group"))
+    {
+      const auto name = groupElem->Get<std::string>("name", "").first;
+      std::vector<std::string> prefixes;
+      for (auto modelElem = groupElem->FindElement("model"); modelElem;
+           modelElem = modelElem->GetNextElement("model"))
+      {
+        prefixes.push_back(modelElem->Get<std::string>());
+      }
+      if (name.empty() || !groups->AddGroup(name, prefixes,
+          groupElem->Get<bool>("static", false).first))
+      {
+        gzerr << "Collision groups need unique, non-empty names, got ["
+               << name << "]." << std::endl;
+        valid = false;
+      }
+    }
+    for (auto disableElem = groupsElem->FindElement("disable"); disableElem;
+         disableElem = disableElem->GetNextElement("disable"))
+    {
+      std::istringstream stream(disableElem->Get<std::string>());
+      std::string first;
+      std::string second;
+      stream >> first >> second;
+      if (!groups->Disable(first, second))
+      {
+        gzerr << "<disable> needs the names of two collision groups, got ["
+               << disableElem->Get<std::string>() << "]." << std::endl;
+        valid = false;
+      }
+    }
+
+    if (!valid)
+    {
+      gzerr << "Ignoring <collision_groups>." << std::endl;
+    }
+    else if (!groups->Finalize())
+    {
+      gzerr << "<collision_groups> need more than ["
+             << CollisionGroups::kMaskBits << "] collision bitmask bits. "
+             << "Ignoring them." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->collisionGroups = groups;
+      gzmsg << "Filtering collisions with [" << groups->GroupCount() - 1u
+             << "] collision groups." << std::endl;
+
+      auto worldName = _ecm.Component<components::Name>(_entity);
+      if (groupsElem->Get<bool>("statistics", false).first && worldName)
+      {
+        this->dataPtr->collisionGroupsNode =
+            std::make_unique<transport::Node>();
+        this->dataPtr->collisionGroupsPub =
+            this->dataPtr->collisionGroupsNode->Advertise<msgs::Param>(
+            "/world/" + worldName->Data() + "/collision_groups/statistics");
+      }
+    }
+  }
+
+  // Optionally split the world into islands, each simulated by its own
+  // engine instance, so they can be stepped concurrently
+  auto islandsElem = _sdf->FindElement("islands");
+  if (!islandsElem)
+    return;
+
+  const auto islandCount = islandsElem->Get<unsigned int>("count", 1u).first;
+  if (islandCount <= 1u)
+    return;
+
+  this->dataPtr->islandAssignment =
+      std::make_shared<IslandAssignment>(islandCount);
+  for (std::size_t i = 1; i < islandCount; ++i)
+  {
+    auto plugin = pluginLoader.Instantiate(engineClassName);
+    auto island = std::make_unique<PhysicsPrivate>();
+    if (plugin)
+    {
+      island->engine = physics::RequestEngine<
+        physics::FeaturePolicy3d,
+        PhysicsPrivate::MinimumFeatureList>::From(plugin);
+    }
+    if (nullptr == island->engine)
+    {
+      gzerr << "Failed to create engine [" << engineClassName
+             << "] for physics island [" << i << "]. Simulating the world "
+             << "as a single island." << std::endl;
+      this->dataPtr->otherIslands.clear();
+      this->dataPtr->islandAssignment.reset();
+      return;
+    }
+    island->eventManager = &_eventMgr;
+    island->contactsEntityNames = this->dataPtr->contactsEntityNames;
+    island->sleepTracker = this->dataPtr->sleepTracker;
+    island->modelsPerStep = this->dataPtr->modelsPerStep;
+    island->substeps = this->dataPtr->substeps;
+    island->islandAssignment = this->dataPtr->islandAssignment;
+    island->collisionGroups = this->dataPtr->collisionGroups;
+    island->island = i;
+    this->dataPtr->otherIslands.push_back(std::move(island));
+  }
+
+  this->dataPtr->concurrentIslands =
+      islandsElem->Get<unsigned int>("threads", islandCount - 1u).first > 0u;
+
+  gzmsg << "Simulating physics in [" << islandCount << "] islands, "
+         << (this->dataPtr->concurrentIslands ? "concurrently" :
+             "sequentially")
+         << "." << std::endl;
 }
 
 //////////////////////////////////////////////////
@@ -895,7 +1446,22 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
 {
   GZ_PROFILE("Physics::Update");
 
+  // Wrenches added during Update by systems that run before physics
+  if (auto *wrenches = _ecm.Wrenches())
+    wrenches->Apply(_ecm);
+
+  this->dataPtr->iteration = _info.iterations;
+  for (auto &island : this->dataPtr->otherIslands)
+    island->iteration = _info.iterations;
+
   if (this->dataPtr->engine)
+    this->dataPtr->UpdateSubsteps(_ecm);
+
+  if (this->dataPtr->engine && this->dataPtr->islandAssignment)
+  {
+    this->dataPtr->UpdateIslands(_info, _ecm);
+  }
+  else if (this->dataPtr->engine)
   {
     this->dataPtr->CreatePhysicsEntities(_ecm);
     this->dataPtr->UpdatePhysics(_ecm);
@@ -905,14 +1471,21 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
     {
       stepOutput = this->dataPtr->Step(_info.dt);
     }
-    auto changedLinks = this->dataPtr->ChangedLinks(_ecm, stepOutput);
-    this->dataPtr->UpdateSim(_ecm, changedLinks);
+    this->dataPtr->ChangedLinks(_ecm, stepOutput,
+        this->dataPtr->changedLinks);
+    this->dataPtr->UpdateSim(_ecm, this->dataPtr->changedLinks);
 
     // Entities scheduled to be removed should be removed from physics after the
     // simulation step. Otherwise, since the to-be-removed entity still shows up
     // in the ECM::Each the UpdatePhysics and UpdateSim calls will have an error
     this->dataPtr->RemovePhysicsEntities(_ecm);
   }
+
+  if (this->dataPtr->engine)
+  {
+    this->dataPtr->UpdateRayIntersections(_info, _ecm);
+    this->dataPtr->PublishCollisionGroupStatistics();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -924,6 +1497,8 @@ void Physics::Reset(const UpdateInfo &, EntityComponentManager &_ecm)
   {
     gzdbg << "Resetting Physics\n";
     this->dataPtr->ResetPhysics(_ecm);
+    for (auto &island : this->dataPtr->otherIslands)
+      island->ResetPhysics(_ecm);
   }
 }
 
@@ -934,8 +1509,11 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm,
   // Clear the set of links that were added to a model.
   this->linkAddedToModel.clear();
   this->jointAddedToModel.clear();
+  this->modelBudget = this->modelsPerStep;
 
   this->CreateWorldEntities(_ecm, _warnIfEntityExists);
+  // Models that were spawned earlier go first
+  this->CreatePendingEntities(_ecm, _warnIfEntityExists);
   this->CreateModelEntities(_ecm, _warnIfEntityExists);
   this->CreateLinkEntities(_ecm, _warnIfEntityExists);
   // We don't need to add visuals to the physics engine.
@@ -1050,152 +1628,168 @@ void PhysicsPrivate::CreateModelEntities(const EntityComponentManager &_ecm,
           const components::Pose *_pose,
           const components::ParentEntity *_parent)->bool
       {
-        if (_ecm.EntityHasComponentType(_entity, components::Recreate::typeId))
+        if (this->DeferModel(_entity, _parent->Data(), _ecm))
           return true;
 
-        // Check if model already exists
-        if (this->entityModelMap.HasEntity(_entity))
-        {
-          if (_warnIfEntityExists)
-          {
-            gzwarn << "Model entity [" << _entity
-                    << "] marked as new, but it's already on the map."
-                    << std::endl;
-          }
-          return true;
-        }
-        // TODO(anyone) Don't load models unless they have collisions
+        return this->CreateModelEntity(_entity, _name, _pose, _parent, _ecm,
+            _warnIfEntityExists);
+      });
+}
 
-        // Check if parent world / model exists
-        sdf::Model model;
-        if (const auto *modelSdfComp =
-            _ecm.Component<components::ModelSdf>(_entity))
-        {
-          model = modelSdfComp->Data();
-        }
+//////////////////////////////////////////////////
+bool PhysicsPrivate::CreateModelEntity(const Entity _entity,
+    const components::Name *_name, const components::Pose *_pose,
+    const components::ParentEntity *_parent,
+    const EntityComponentManager &_ecm, bool _warnIfEntityExists)
+{
+  if (_ecm.EntityHasComponentType(_entity, components::Recreate::typeId))
+    return true;
+
+  if (!this->InIsland(_entity, _ecm))
+    return true;
+
+  // Check if model already exists
+  if (this->entityModelMap.HasEntity(_entity))
+  {
+    if (_warnIfEntityExists)
+    {
+      gzwarn << "Model entity [" << _entity
+              << "] marked as new, but it's already on the map."
+              << std::endl;
+    }
+    return true;
+  }
+  // TODO(anyone) Don't load models unless they have collisions
 
-        // Component values should override whatever values were put into the
-        // ModelSdf component.
-        model.SetName(_name->Data());
-        model.SetRawPose(_pose->Data());
-        model.SetPoseRelativeTo("");
+  // Check if parent world / model exists
+  sdf::Model model;
+  if (const auto *modelSdfComp =
+      _ecm.Component<components::ModelSdf>(_entity))
+  {
+    model = modelSdfComp->Data();
+  }
 
-        sdf::Root root;
-        root.SetModel(model);
-        root.UpdateGraphs();
+  // Component values should override whatever values were put into the
+  // ModelSdf component.
+  model.SetName(_name->Data());
+  model.SetRawPose(_pose->Data());
+  model.SetPoseRelativeTo("");
 
-        auto staticComp = _ecm.Component<components::Static>(_entity);
-        if (staticComp && staticComp->Data())
-        {
-          model.SetStatic(staticComp->Data());
-          this->staticEntities.insert(_entity);
-        }
-        auto selfCollideComp = _ecm.Component<components::SelfCollide>(_entity);
-        if (selfCollideComp && selfCollideComp ->Data())
-        {
-          model.SetSelfCollide(selfCollideComp->Data());
-        }
+  sdf::Root root;
+  root.SetModel(model);
+  root.UpdateGraphs();
+
+  auto staticComp = _ecm.Component<components::Static>(_entity);
+  if (staticComp && staticComp->Data())
+  {
+    model.SetStatic(staticComp->Data());
+    this->staticEntities.insert(_entity);
+  }
+  auto selfCollideComp = _ecm.Component<components::SelfCollide>(_entity);
+  if (selfCollideComp && selfCollideComp ->Data())
+  {
+    model.SetSelfCollide(selfCollideComp->Data());
+  }
 
-        // check if parent is a world
-        if (auto worldPtrPhys =
-                this->entityWorldMap.Get(_parent->Data()))
+  // check if parent is a world
+  if (auto worldPtrPhys =
+          this->entityWorldMap.Get(_parent->Data()))
+  {
+    // Use the ConstructNestedModel feature for nested models
+    if (model.ModelCount() > 0)
+    {
+      auto nestedModelFeature =
+          this->entityWorldMap.EntityCast<NestedModelFeatureList>(
+              _parent->Data());
+      if (!nestedModelFeature)
+      {
+        static bool informed{false};
+        if (!informed)
         {
-          // Use the ConstructNestedModel feature for nested models
-          if (model.ModelCount() > 0)
-          {
-            auto nestedModelFeature =
-                this->entityWorldMap.EntityCast<NestedModelFeatureList>(
-                    _parent->Data());
-            if (!nestedModelFeature)
-            {
-              static bool informed{false};
-              if (!informed)
-              {
-                gzdbg << "Attempting to construct nested models, but the "
-                       << "phyiscs engine doesn't support feature "
-                       << "[ConstructSdfNestedModelFeature]. "
-                       << "Nested model will be ignored."
-                       << std::endl;
-                informed = true;
-              }
-              return true;
-            }
-            auto modelPtrPhys =
-              nestedModelFeature->ConstructNestedModel(*root.Model());
-            if (modelPtrPhys)
-            {
-              this->entityModelMap.AddEntity(_entity, modelPtrPhys);
-              this->topLevelModelMap.insert(std::make_pair(_entity,
-                  topLevelModel(_entity, _ecm)));
-            }
-          }
-          else
-          {
-            auto modelPtrPhys = worldPtrPhys->ConstructModel(*root.Model());
-            if (modelPtrPhys)
-            {
-              this->entityModelMap.AddEntity(_entity, modelPtrPhys);
-              this->topLevelModelMap.insert(std::make_pair(_entity,
-                  topLevelModel(_entity, _ecm)));
-            }
-          }
+          gzdbg << "Attempting to construct nested models, but the "
+                 << "phyiscs engine doesn't support feature "
+                 << "[ConstructSdfNestedModelFeature]. "
+                 << "Nested model will be ignored."
+                 << std::endl;
+          informed = true;
         }
-        // check if parent is a model (nested model)
-        else
+        return true;
+      }
+      auto modelPtrPhys =
+        nestedModelFeature->ConstructNestedModel(*root.Model());
+      if (modelPtrPhys)
+      {
+        this->entityModelMap.AddEntity(_entity, modelPtrPhys);
+        this->topLevelModelMap.insert(std::make_pair(_entity,
+            this->TopLevelModel(_entity, _ecm)));
+      }
+    }
+    else
+    {
+      auto modelPtrPhys = worldPtrPhys->ConstructModel(*root.Model());
+      if (modelPtrPhys)
+      {
+        this->entityModelMap.AddEntity(_entity, modelPtrPhys);
+        this->topLevelModelMap.insert(std::make_pair(_entity,
+            this->TopLevelModel(_entity, _ecm)));
+      }
+    }
+  }
+  // check if parent is a model (nested model)
+  else
+  {
+    if (auto parentPtrPhys = this->entityModelMap.Get(_parent->Data()))
+    {
+      auto nestedModelFeature =
+          this->entityModelMap.EntityCast<NestedModelFeatureList>(
+              _parent->Data());
+      if (!nestedModelFeature)
+      {
+        static bool informed{false};
+        if (!informed)
         {
-          if (auto parentPtrPhys = this->entityModelMap.Get(_parent->Data()))
-          {
-            auto nestedModelFeature =
-                this->entityModelMap.EntityCast<NestedModelFeatureList>(
-                    _parent->Data());
-            if (!nestedModelFeature)
-            {
-              static bool informed{false};
-              if (!informed)
-              {
-                gzdbg << "Attempting to construct nested models, but the "
-                       << "physics engine doesn't support feature "
-                       << "[ConstructSdfNestedModelFeature]. "
-                       << "Nested model will be ignored."
-                       << std::endl;
-                informed = true;
-              }
-              return true;
-            }
+          gzdbg << "Attempting to construct nested models, but the "
+                 << "physics engine doesn't support feature "
+                 << "[ConstructSdfNestedModelFeature]. "
+                 << "Nested model will be ignored."
+                 << std::endl;
+          informed = true;
+        }
+        return true;
+      }
 
-            // override static property only if parent is static.
-            auto parentStaticComp =
-              _ecm.Component<components::Static>(_parent->Data());
-            if (parentStaticComp && parentStaticComp->Data())
-            {
-              model.SetStatic(true);
-              this->staticEntities.insert(_entity);
-            }
+      // override static property only if parent is static.
+      auto parentStaticComp =
+        _ecm.Component<components::Static>(_parent->Data());
+      if (parentStaticComp && parentStaticComp->Data())
+      {
+        model.SetStatic(true);
+        this->staticEntities.insert(_entity);
+      }
 
-            auto modelPtrPhys = nestedModelFeature->ConstructNestedModel(model);
-            if (modelPtrPhys)
-            {
-              this->entityModelMap.AddEntity(_entity, modelPtrPhys);
-              this->topLevelModelMap.insert(std::make_pair(_entity,
-                  topLevelModel(_entity, _ecm)));
-            }
-            else
-            {
-              gzerr << "Model: '" << _name->Data() << "' not loaded. "
-                     << "Failed to create nested model."
-                     << std::endl;
-            }
-          }
-          else
-          {
-            gzwarn << "Model's parent entity [" << _parent->Data()
-                    << "] not found on world / model map." << std::endl;
-            return true;
-          }
-        }
+      auto modelPtrPhys = nestedModelFeature->ConstructNestedModel(model);
+      if (modelPtrPhys)
+      {
+        this->entityModelMap.AddEntity(_entity, modelPtrPhys);
+        this->topLevelModelMap.insert(std::make_pair(_entity,
+            this->TopLevelModel(_entity, _ecm)));
+      }
+      else
+      {
+        gzerr << "Model: '" << _name->Data() << "' not loaded. "
+               << "Failed to create nested model."
+               << std::endl;
+      }
+    }
+    else
+    {
+      gzwarn << "Model's parent entity [" << _parent->Data()
+              << "] not found on world / model map." << std::endl;
+      return true;
+    }
+  }
 
-        return true;
-      });
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -1210,106 +1804,122 @@ void PhysicsPrivate::CreateLinkEntities(const EntityComponentManager &_ecm,
         const components::Pose *_pose,
         const components::ParentEntity *_parent)->bool
       {
-        // If the parent model is scheduled for recreation, then do not
-        // try to create a new link. This situation can occur when a link
-        // is added to a model from the GUI model editor.
-        if (_ecm.EntityHasComponentType(_parent->Data(),
-              components::Recreate::typeId))
-        {
-          // Add this entity to the set of newly added links to existing
-          // models.
-          this->linkAddedToModel.insert(_entity);
+        if (this->Pending(_entity, _ecm))
           return true;
-        }
 
-        // Check if link already exists
-        if (this->entityLinkMap.HasEntity(_entity))
-        {
-          if (_warnIfEntityExists)
-          {
-            gzwarn << "Link entity [" << _entity
-                    << "] marked as new, but it's already on the map."
-                    << std::endl;
-          }
-          return true;
-        }
+        return this->CreateLinkEntity(_entity, _name, _pose, _parent, _ecm,
+            _warnIfEntityExists);
+      });
+}
 
-        // TODO(anyone) Don't load links unless they have collisions
+//////////////////////////////////////////////////
+bool PhysicsPrivate::CreateLinkEntity(const Entity _entity,
+    const components::Name *_name, const components::Pose *_pose,
+    const components::ParentEntity *_parent,
+    const EntityComponentManager &_ecm, bool _warnIfEntityExists)
+{
+  if (!this->InIsland(_entity, _ecm))
+    return true;
+
+  // If the parent model is scheduled for recreation, then do not
+  // try to create a new link. This situation can occur when a link
+  // is added to a model from the GUI model editor.
+  if (_ecm.EntityHasComponentType(_parent->Data(),
+        components::Recreate::typeId))
+  {
+    // Add this entity to the set of newly added links to existing
+    // models.
+    this->linkAddedToModel.insert(_entity);
+    return true;
+  }
 
-        // Check if parent model exists
-        if (!this->entityModelMap.HasEntity(_parent->Data()))
-        {
-          gzwarn << "Link's parent entity [" << _parent->Data()
-                  << "] not found on model map." << std::endl;
-          return true;
-        }
-        auto basicModelPtrPhys = this->entityModelMap.Get(_parent->Data());
+  // Check if link already exists
+  if (this->entityLinkMap.HasEntity(_entity))
+  {
+    if (_warnIfEntityExists)
+    {
+      gzwarn << "Link entity [" << _entity
+              << "] marked as new, but it's already on the map."
+              << std::endl;
+    }
+    return true;
+  }
 
-        if (const auto existingLink = basicModelPtrPhys->GetLink(_name->Data()))
-        {
-          // No need to create this link because it was already created when
-          // parsing the model (links in models are required to have unique
-          // names). Instead we will register its existence and move along.
-          this->entityLinkMap.AddEntity(_entity, existingLink);
-          this->topLevelModelMap.insert(
-            std::make_pair(_entity, topLevelModel(_entity, _ecm)));
-          return true;
-        }
+  // TODO(anyone) Don't load links unless they have collisions
 
-        auto modelPtrPhys =
-            this->entityModelMap
-              .EntityCast<ConstructSdfLinkFeatureList>(_parent->Data());
+  // Check if parent model exists
+  if (!this->entityModelMap.HasEntity(_parent->Data()))
+  {
+    gzwarn << "Link's parent entity [" << _parent->Data()
+            << "] not found on model map." << std::endl;
+    return true;
+  }
+  auto basicModelPtrPhys = this->entityModelMap.Get(_parent->Data());
 
-        if (!modelPtrPhys)
-        {
-          gzwarn << "Cannot create a new link [" << _name->Data() << "] "
-                 << "because the physics engine plugin does not support "
-                 << "link construction during runtime" << std::endl;
-          return true;
-        }
+  if (const auto existingLink = basicModelPtrPhys->GetLink(_name->Data()))
+  {
+    // No need to create this link because it was already created when
+    // parsing the model (links in models are required to have unique
+    // names). Instead we will register its existence and move along.
+    this->entityLinkMap.AddEntity(_entity, existingLink);
+    this->topLevelModelMap.insert(
+      std::make_pair(_entity, this->TopLevelModel(_entity, _ecm)));
+    return true;
+  }
 
-        sdf::Link link;
-        link.SetName(_name->Data());
-        link.SetRawPose(_pose->Data());
-        link.SetPoseRelativeTo("");
+  auto modelPtrPhys =
+      this->entityModelMap
+        .EntityCast<ConstructSdfLinkFeatureList>(_parent->Data());
 
-        if (this->staticEntities.find(_parent->Data()) !=
-            this->staticEntities.end())
-        {
-          this->staticEntities.insert(_entity);
-        }
+  if (!modelPtrPhys)
+  {
+    gzwarn << "Cannot create a new link [" << _name->Data() << "] "
+           << "because the physics engine plugin does not support "
+           << "link construction during runtime" << std::endl;
+    return true;
+  }
 
-        // get link inertial
-        auto inertial = _ecm.Component<components::Inertial>(_entity);
-        if (inertial)
-        {
-          link.SetInertial(inertial->Data());
-        }
+  sdf::Link link;
+  link.SetName(_name->Data());
+  link.SetRawPose(_pose->Data());
+  link.SetPoseRelativeTo("");
 
-        auto constructLinkFeature =
-          this->entityModelMap.EntityCast<ConstructSdfLinkFeatureList>(
-            _parent->Data());
+  if (this->staticEntities.find(_parent->Data()) !=
+      this->staticEntities.end())
+  {
+    this->staticEntities.insert(_entity);
+  }
 
-        if (!constructLinkFeature)
-        {
-            static bool informed{false};
-            if (!informed)
-            {
-              gzdbg << "Attempting to construct sdf link, but the "
-                     << "physics engine doesn't support feature "
-                     << "[ConstructSdfLinkFeature]." << std::endl;
-              informed = true;
-            }
-            return true;
-        }
+  // get link inertial
+  auto inertial = _ecm.Component<components::Inertial>(_entity);
+  if (inertial)
+  {
+    link.SetInertial(inertial->Data());
+  }
 
-        auto linkPtrPhys = constructLinkFeature->ConstructLink(link);
-        this->entityLinkMap.AddEntity(_entity, linkPtrPhys);
-        this->topLevelModelMap.insert(std::make_pair(_entity,
-            topLevelModel(_entity, _ecm)));
+  auto constructLinkFeature =
+    this->entityModelMap.EntityCast<ConstructSdfLinkFeatureList>(
+      _parent->Data());
 
-        return true;
-      });
+  if (!constructLinkFeature)
+  {
+      static bool informed{false};
+      if (!informed)
+      {
+        gzdbg << "Attempting to construct sdf link, but the "
+               << "physics engine doesn't support feature "
+               << "[ConstructSdfLinkFeature]." << std::endl;
+        informed = true;
+      }
+      return true;
+  }
+
+  auto linkPtrPhys = constructLinkFeature->ConstructLink(link);
+  this->entityLinkMap.AddEntity(_entity, linkPtrPhys);
+  this->topLevelModelMap.insert(std::make_pair(_entity,
+      this->TopLevelModel(_entity, _ecm)));
+
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -1327,280 +1937,314 @@ void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm,
           const components::CollisionElement *_collElement,
           const components::ParentEntity *_parent) -> bool
       {
-        // Check to see if this collision's parent is a link that was
-        // not created because the parent model is marked for recreation.
-        if (this->linkAddedToModel.find(_parent->Data()) !=
-            this->linkAddedToModel.end())
-        {
+        if (this->Pending(_entity, _ecm))
           return true;
-        }
 
-        if (this->entityCollisionMap.HasEntity(_entity))
-        {
-          if (_warnIfEntityExists)
-          {
-            gzwarn << "Collision entity [" << _entity
-                    << "] marked as new, but it's already on the map."
-                    << std::endl;
-          }
-          return true;
-        }
+        return this->CreateCollisionEntity(_entity, _name, _pose, _geom,
+            _collElement, _parent, _ecm, _warnIfEntityExists);
+      });
+}
 
-        // Check if parent link exists
-        if (!this->entityLinkMap.HasEntity(_parent->Data()))
-        {
-          gzwarn << "Collision's parent entity [" << _parent->Data()
-                  << "] not found on link map." << std::endl;
-          return true;
-        }
-        auto linkPtrPhys = this->entityLinkMap.Get(_parent->Data());
+//////////////////////////////////////////////////
+bool PhysicsPrivate::CreateCollisionEntity(const Entity _entity,
+    const components::Name *_name, const components::Pose *_pose,
+    const components::Geometry *_geom,
+    const components::CollisionElement *_collElement,
+    const components::ParentEntity *_parent,
+    const EntityComponentManager &_ecm, bool _warnIfEntityExists)
+{
+  if (!this->InIsland(_entity, _ecm))
+    return true;
 
-        if (const auto existingShape = linkPtrPhys->GetShape(_name->Data()))
-        {
-          // No need to create this collision shape because it was already
-          // created when parsing the model.
-          auto linkCollisionFeature =
-              this->entityLinkMap.EntityCast<CollisionFeatureList>(
-                  _parent->Data());
-          this->entityCollisionMap.AddEntity(
-            _entity, linkCollisionFeature->GetShape(_name->Data()));
-          this->topLevelModelMap.insert(
-            std::make_pair(_entity, topLevelModel(_entity, _ecm)));
-          return true;
-        }
+  // Check to see if this collision's parent is a link that was
+  // not created because the parent model is marked for recreation.
+  if (this->linkAddedToModel.find(_parent->Data()) !=
+      this->linkAddedToModel.end())
+  {
+    return true;
+  }
 
-        // Make a copy of the collision DOM so we can set its pose which has
-        // been resolved and is now expressed w.r.t the parent link of the
-        // collision.
-        sdf::Collision collision = _collElement->Data();
-        collision.SetRawPose(_pose->Data());
-        collision.SetPoseRelativeTo("");
-        auto collideBitmask = collision.Surface()->Contact()->CollideBitmask();
+  if (this->entityCollisionMap.HasEntity(_entity))
+  {
+    if (_warnIfEntityExists)
+    {
+      gzwarn << "Collision entity [" << _entity
+              << "] marked as new, but it's already on the map."
+              << std::endl;
+    }
+    return true;
+  }
 
-        ShapePtrType collisionPtrPhys;
-        if (_geom->Data().Type() == sdf::GeometryType::MESH)
-        {
-          const sdf::Mesh *meshSdf = _geom->Data().MeshShape();
-          if (nullptr == meshSdf)
-          {
-            gzwarn << "Mesh geometry for collision [" << _name->Data()
-                    << "] missing mesh shape." << std::endl;
-            return true;
-          }
+  // Check if parent link exists
+  if (!this->entityLinkMap.HasEntity(_parent->Data()))
+  {
+    gzwarn << "Collision's parent entity [" << _parent->Data()
+            << "] not found on link map." << std::endl;
+    return true;
+  }
+  auto linkPtrPhys = this->entityLinkMap.Get(_parent->Data());
 
-          const common::Mesh *mesh = loadMesh(*meshSdf);
-          if (!mesh)
-            return true;
+  if (const auto existingShape = linkPtrPhys->GetShape(_name->Data()))
+  {
+    // No need to create this collision shape because it was already
+    // created when parsing the model.
+    auto linkCollisionFeature =
+        this->entityLinkMap.EntityCast<CollisionFeatureList>(
+            _parent->Data());
+    this->entityCollisionMap.AddEntity(
+      _entity, linkCollisionFeature->GetShape(_name->Data()));
+    this->topLevelModelMap.insert(
+      std::make_pair(_entity, this->TopLevelModel(_entity, _ecm)));
 
-          auto linkMeshFeature =
-              this->entityLinkMap.EntityCast<MeshFeatureList>(_parent->Data());
-          if (!linkMeshFeature)
-          {
-            static bool informed{false};
-            if (!informed)
-            {
-              gzdbg << "Attempting to process mesh geometries, but the physics"
-                     << " engine doesn't support feature "
-                     << "[AttachMeshShapeFeature]. Meshes will be ignored."
-                     << std::endl;
-              informed = true;
-            }
-            return true;
-          }
+    // The engine already set the bitmask from SDF
+    if (this->collisionGroups)
+    {
+      auto filterMaskFeature =
+          this->entityCollisionMap.EntityCast<CollisionMaskFeatureList>(
+              _entity);
+      if (filterMaskFeature)
+      {
+        filterMaskFeature->SetCollisionFilterMask(this->CollisionGroupMask(
+            _entity,
+            _collElement->Data().Surface()->Contact()->CollideBitmask(),
+            _ecm));
+      }
+    }
+    return true;
+  }
 
-          collisionPtrPhys = linkMeshFeature->AttachMeshShape(_name->Data(),
-              *mesh,
-              math::eigen3::convert(_pose->Data()),
-              math::eigen3::convert(meshSdf->Scale()));
-        }
-        else if (_geom->Data().Type() == sdf::GeometryType::HEIGHTMAP)
-        {
-          auto linkHeightmapFeature =
-              this->entityLinkMap.EntityCast<HeightmapFeatureList>(
-                  _parent->Data());
-          if (!linkHeightmapFeature)
-          {
-            static bool informed{false};
-            if (!informed)
-            {
-              gzdbg << "Attempting to process heightmap geometries, but the "
-                     << "physics engine doesn't support feature "
-                     << "[AttachHeightmapShapeFeature]. Heightmaps will be "
-                     << "ignored." << std::endl;
-              informed = true;
-            }
-            return true;
-          }
+  // Make a copy of the collision DOM so we can set its pose which has
+  // been resolved and is now expressed w.r.t the parent link of the
+  // collision.
+  sdf::Collision collision = _collElement->Data();
+  collision.SetRawPose(_pose->Data());
+  collision.SetPoseRelativeTo("");
+  auto collideBitmask = collision.Surface()->Contact()->CollideBitmask();
 
-          auto heightmapSdf = _geom->Data().HeightmapShape();
-          if (nullptr == heightmapSdf)
-          {
-            gzwarn << "Heightmap geometry for collision [" << _name->Data()
-                    << "] missing heightmap shape." << std::endl;
-            return true;
-          }
+  ShapePtrType collisionPtrPhys;
+  if (_geom->Data().Type() == sdf::GeometryType::MESH)
+  {
+    const sdf::Mesh *meshSdf = _geom->Data().MeshShape();
+    if (nullptr == meshSdf)
+    {
+      gzwarn << "Mesh geometry for collision [" << _name->Data()
+              << "] missing mesh shape." << std::endl;
+      return true;
+    }
 
-          auto fullPath = common::findFile(asFullPath(heightmapSdf->Uri(),
-              heightmapSdf->FilePath()));
-          if (fullPath.empty())
-          {
-            gzerr << "Heightmap geometry missing URI" << std::endl;
-            return true;
-          }
+    const common::Mesh *mesh = loadMesh(*meshSdf);
+    if (!mesh)
+      return true;
 
-          std::shared_ptr<common::HeightmapData> data;
-          std::string lowerFullPath = common::lowercase(fullPath);
-          // check if heightmap is an image
-          if (common::EndsWith(lowerFullPath, ".png")
-              || common::EndsWith(lowerFullPath, ".jpg")
-              || common::EndsWith(lowerFullPath, ".jpeg"))
-          {
-            auto img = std::make_shared<common::ImageHeightmap>();
-            if (img->Load(fullPath) < 0)
-            {
-              gzerr << "Failed to load heightmap image data from ["
-                     << fullPath << "]" << std::endl;
-              return true;
-            }
-            data = img;
-          }
-          // DEM
-          else
-          {
-            auto worldEntity = _ecm.EntityByComponents(components::World());
-            auto sphericalCoordinatesComponent =
-              _ecm.Component<components::SphericalCoordinates>(
-                worldEntity);
+    auto linkMeshFeature =
+        this->entityLinkMap.EntityCast<MeshFeatureList>(_parent->Data());
+    if (!linkMeshFeature)
+    {
+      static bool informed{false};
+      if (!informed)
+      {
+        gzdbg << "Attempting to process mesh geometries, but the physics"
+               << " engine doesn't support feature "
+               << "[AttachMeshShapeFeature]. Meshes will be ignored."
+               << std::endl;
+        informed = true;
+      }
+      return true;
+    }
 
-            auto dem = std::make_shared<common::Dem>();
-            if (sphericalCoordinatesComponent)
-            {
-              dem->SetSphericalCoordinates(
-                  sphericalCoordinatesComponent->Data());
-            }
-            if (dem->Load(fullPath) < 0)
-            {
-              gzerr << "Failed to load heightmap dem data from ["
-                     << fullPath << "]" << std::endl;
-              return true;
-            }
-            data = dem;
-          }
+    collisionPtrPhys = linkMeshFeature->AttachMeshShape(_name->Data(),
+        *mesh,
+        math::eigen3::convert(_pose->Data()),
+        math::eigen3::convert(meshSdf->Scale()));
+  }
+  else if (_geom->Data().Type() == sdf::GeometryType::HEIGHTMAP)
+  {
+    auto linkHeightmapFeature =
+        this->entityLinkMap.EntityCast<HeightmapFeatureList>(
+            _parent->Data());
+    if (!linkHeightmapFeature)
+    {
+      static bool informed{false};
+      if (!informed)
+      {
+        gzdbg << "Attempting to process heightmap geometries, but the "
+               << "physics engine doesn't support feature "
+               << "[AttachHeightmapShapeFeature]. Heightmaps will be "
+               << "ignored." << std::endl;
+        informed = true;
+      }
+      return true;
+    }
 
-          collisionPtrPhys = linkHeightmapFeature->AttachHeightmapShape(
-              _name->Data(),
-              *data,
-              math::eigen3::convert(_pose->Data()),
-              math::eigen3::convert(heightmapSdf->Size()),
-              heightmapSdf->Sampling());
-        }
-        else if (_geom->Data().Type() == sdf::GeometryType::POLYLINE)
-        {
-          auto polylineSdf = _geom->Data().PolylineShape();
-          if (polylineSdf.empty())
-          {
-            gzwarn << "Polyline geometry for collision [" << _name->Data()
-                    << "] missing polylines." << std::endl;
-            return true;
-          }
+    auto heightmapSdf = _geom->Data().HeightmapShape();
+    if (nullptr == heightmapSdf)
+    {
+      gzwarn << "Heightmap geometry for collision [" << _name->Data()
+              << "] missing heightmap shape." << std::endl;
+      return true;
+    }
 
-          std::vector<std::vector<math::Vector2d>> vertices;
-          for (const auto &polyline : _geom->Data().PolylineShape())
-          {
-            vertices.push_back(polyline.Points());
-          }
+    auto fullPath = common::findFile(asFullPath(heightmapSdf->Uri(),
+        heightmapSdf->FilePath()));
+    if (fullPath.empty())
+    {
+      gzerr << "Heightmap geometry missing URI" << std::endl;
+      return true;
+    }
 
-          std::string name("POLYLINE_" + common::Uuid().String());
-          auto meshManager = common::MeshManager::Instance();
-          meshManager->CreateExtrudedPolyline(name, vertices,
-              _geom->Data().PolylineShape()[0].Height());
+    std::shared_ptr<common::HeightmapData> data;
+    std::string lowerFullPath = common::lowercase(fullPath);
+    // check if heightmap is an image
+    if (common::EndsWith(lowerFullPath, ".png")
+        || common::EndsWith(lowerFullPath, ".jpg")
+        || common::EndsWith(lowerFullPath, ".jpeg"))
+    {
+      auto img = std::make_shared<common::ImageHeightmap>();
+      if (img->Load(fullPath) < 0)
+      {
+        gzerr << "Failed to load heightmap image data from ["
+               << fullPath << "]" << std::endl;
+        return true;
+      }
+      data = img;
+    }
+    // DEM
+    else
+    {
+      auto worldEntity = _ecm.EntityByComponents(components::World());
+      auto sphericalCoordinatesComponent =
+        _ecm.Component<components::SphericalCoordinates>(
+          worldEntity);
 
-          auto polyline = meshManager->MeshByName(name);
-          if (nullptr == polyline)
-          {
-            gzwarn << "Failed to create polyline for collision ["
-                    << _name->Data() << "]." << std::endl;
-            return true;
-          }
+      auto dem = std::make_shared<common::Dem>();
+      if (sphericalCoordinatesComponent)
+      {
+        dem->SetSphericalCoordinates(
+            sphericalCoordinatesComponent->Data());
+      }
+      if (dem->Load(fullPath) < 0)
+      {
+        gzerr << "Failed to load heightmap dem data from ["
+               << fullPath << "]" << std::endl;
+        return true;
+      }
+      data = dem;
+    }
 
-          auto linkMeshFeature =
-              this->entityLinkMap.EntityCast<MeshFeatureList>(_parent->Data());
-          if (!linkMeshFeature)
-          {
-            static bool informed{false};
-            if (!informed)
-            {
-              gzdbg << "Attempting to process polyline geometries, but the"
-                     << " physics engine doesn't support feature "
-                     << "[AttachMeshShapeFeature]. Polylines will be ignored."
-                     << std::endl;
-              informed = true;
-            }
-            return true;
-          }
+    collisionPtrPhys = linkHeightmapFeature->AttachHeightmapShape(
+        _name->Data(),
+        *data,
+        math::eigen3::convert(_pose->Data()),
+        math::eigen3::convert(heightmapSdf->Size()),
+        heightmapSdf->Sampling());
+  }
+  else if (_geom->Data().Type() == sdf::GeometryType::POLYLINE)
+  {
+    auto polylineSdf = _geom->Data().PolylineShape();
+    if (polylineSdf.empty())
+    {
+      gzwarn << "Polyline geometry for collision [" << _name->Data()
+              << "] missing polylines." << std::endl;
+      return true;
+    }
 
-          collisionPtrPhys = linkMeshFeature->AttachMeshShape(_name->Data(),
-              *polyline,
-              math::eigen3::convert(_pose->Data()));
-        }
-        else
-        {
-          auto linkCollisionFeature =
-              this->entityLinkMap.EntityCast<CollisionFeatureList>(
-                  _parent->Data());
-          if (!linkCollisionFeature)
-          {
-            static bool informed{false};
-            if (!informed)
-            {
-              gzdbg << "Attempting to process collisions, but the physics "
-                     << "engine doesn't support feature "
-                     << "[ConstructSdfCollision]. Collisions will be ignored."
-                     << std::endl;
-              informed = true;
-            }
-            return true;
-          }
+    std::vector<std::vector<math::Vector2d>> vertices;
+    for (const auto &polyline : _geom->Data().PolylineShape())
+    {
+      vertices.push_back(polyline.Points());
+    }
 
-          collisionPtrPhys =
-              linkCollisionFeature->ConstructCollision(collision);
-        }
+    std::string name("POLYLINE_" + common::Uuid().String());
+    auto meshManager = common::MeshManager::Instance();
+    meshManager->CreateExtrudedPolyline(name, vertices,
+        _geom->Data().PolylineShape()[0].Height());
 
-        if (nullptr == collisionPtrPhys)
-        {
-          gzdbg << "Failed to create collision [" << _name->Data()
-                 << "]. Does the physics engine support geometries of type ["
-                 << static_cast<int>(_geom->Data().Type()) << "]?" << std::endl;
-          return true;
-        }
+    auto polyline = meshManager->MeshByName(name);
+    if (nullptr == polyline)
+    {
+      gzwarn << "Failed to create polyline for collision ["
+              << _name->Data() << "]." << std::endl;
+      return true;
+    }
 
-        this->entityCollisionMap.AddEntity(_entity, collisionPtrPhys);
+    auto linkMeshFeature =
+        this->entityLinkMap.EntityCast<MeshFeatureList>(_parent->Data());
+    if (!linkMeshFeature)
+    {
+      static bool informed{false};
+      if (!informed)
+      {
+        gzdbg << "Attempting to process polyline geometries, but the"
+               << " physics engine doesn't support feature "
+               << "[AttachMeshShapeFeature]. Polylines will be ignored."
+               << std::endl;
+        informed = true;
+      }
+      return true;
+    }
 
-        // Check that the physics engine has a filter mask feature
-        // Set the collide_bitmask if it does
-        auto filterMaskFeature =
-            this->entityCollisionMap.EntityCast<CollisionMaskFeatureList>(
-                _entity);
-        if (filterMaskFeature)
-        {
-          filterMaskFeature->SetCollisionFilterMask(collideBitmask);
-        }
-        else
-        {
-          static bool informed{false};
-          if (!informed)
-          {
-            gzdbg << "Attempting to set collision bitmasks, but the physics "
-                   << "engine doesn't support feature [CollisionFilterMask]. "
-                   << "Collision bitmasks will be ignored." << std::endl;
-            informed = true;
-          }
-        }
+    collisionPtrPhys = linkMeshFeature->AttachMeshShape(_name->Data(),
+        *polyline,
+        math::eigen3::convert(_pose->Data()));
+  }
+  else
+  {
+    auto linkCollisionFeature =
+        this->entityLinkMap.EntityCast<CollisionFeatureList>(
+            _parent->Data());
+    if (!linkCollisionFeature)
+    {
+      static bool informed{false};
+      if (!informed)
+      {
+        gzdbg << "Attempting to process collisions, but the physics "
+               << "engine doesn't support feature "
+               << "[ConstructSdfCollision]. Collisions will be ignored."
+               << std::endl;
+        informed = true;
+      }
+      return true;
+    }
 
-        this->topLevelModelMap.insert(std::make_pair(_entity,
-            topLevelModel(_entity, _ecm)));
-        return true;
-      });
+    collisionPtrPhys =
+        linkCollisionFeature->ConstructCollision(collision);
+  }
+
+  if (nullptr == collisionPtrPhys)
+  {
+    gzdbg << "Failed to create collision [" << _name->Data()
+           << "]. Does the physics engine support geometries of type ["
+           << static_cast<int>(_geom->Data().Type()) << "]?" << std::endl;
+    return true;
+  }
+
+  this->entityCollisionMap.AddEntity(_entity, collisionPtrPhys);
+
+  // Check that the physics engine has a filter mask feature
+  // Set the collide_bitmask if it does
+  auto filterMaskFeature =
+      this->entityCollisionMap.EntityCast<CollisionMaskFeatureList>(
+          _entity);
+  if (filterMaskFeature)
+  {
+    filterMaskFeature->SetCollisionFilterMask(
+        this->CollisionGroupMask(_entity, collideBitmask, _ecm));
+  }
+  else
+  {
+    static bool informed{false};
+    if (!informed)
+    {
+      gzdbg << "Attempting to set collision bitmasks, but the physics "
+             << "engine doesn't support feature [CollisionFilterMask]. "
+             << "Collision bitmasks will be ignored." << std::endl;
+      informed = true;
+    }
+  }
+
+  this->topLevelModelMap.insert(std::make_pair(_entity,
+      this->TopLevelModel(_entity, _ecm)));
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -1621,293 +2265,558 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm,
           const components::ParentLinkName *_parentLinkName,
           const components::ChildLinkName *_childLinkName) -> bool
       {
-        // If the parent model is scheduled for recreation, then do not
-        // try to create a new joint. This situation can occur when a joint
-        // is added to a model from the GUI model editor.
-        if (_ecm.EntityHasComponentType(_parentModel->Data(),
-              components::Recreate::typeId))
+        if (this->Pending(_entity, _ecm))
+          return true;
+
+        return this->CreateJointEntity(_entity, _name, _jointType, _pose,
+            _threadPitch, _parentModel, _parentLinkName, _childLinkName, _ecm,
+            _warnIfEntityExists);
+      });
+
+  // Detachable joints
+  _ecm.EachNew<components::DetachableJoint>(
+      [&](const Entity &_entity,
+          const components::DetachableJoint *_jointInfo) -> bool
+      {
+        // Joints between links of models that aren't created yet are
+        // created together with the models
+        if (this->Pending(_jointInfo->Data().parentLink, _ecm) ||
+            this->Pending(_jointInfo->Data().childLink, _ecm))
         {
-          // Add this entity to the set of newly added joints to existing
-          // models.
-          this->jointAddedToModel.insert(_entity);
+          this->pendingDetachableJoints.push_back(_entity);
           return true;
         }
 
-        // Check if joint already exists
-        if (this->entityJointMap.HasEntity(_entity))
+        return this->CreateDetachableJointEntity(_entity, _jointInfo, _ecm,
+            _warnIfEntityExists);
+      });
+
+  // The components are removed after each update, so we want to process all
+  // components in every update.
+  _ecm.Each<components::EnableContactSurfaceCustomization,
+            components::Collision, components::Name>(
+      [&](const Entity & _entity,
+          const components::EnableContactSurfaceCustomization *_enable,
+          const components::Collision */*_collision*/,
+          const components::Name *_name) -> bool
+      {
+        const auto world = worldEntity(_entity, _ecm);
+        if (_enable->Data())
         {
-          if (_warnIfEntityExists)
+          if (this->customContactSurfaceEntities[world].empty())
           {
-            gzwarn << "Joint entity [" << _entity
-                    << "] marked as new, but it's already on the map."
-                    << std::endl;
+            this->EnableContactSurfaceCustomization(world);
           }
-          return true;
+          this->customContactSurfaceEntities[world].insert(_entity);
+          gzmsg << "Enabling contact surface customization for collision ["
+                 << _name->Data() << "]" << std::endl;
         }
-
-        // Check if parent model exists
-        if (!this->entityModelMap.HasEntity(_parentModel->Data()))
+        else
         {
-          gzerr << "Joint's parent model entity [" << _parentModel->Data()
-                  << "] not found on model map." << std::endl;
-          return true;
+          if (this->customContactSurfaceEntities[world].erase(_entity) > 0)
+          {
+            gzmsg << "Disabling contact surface customization for collision ["
+                   << _name->Data() << "]" << std::endl;
+            if (this->customContactSurfaceEntities[world].empty())
+            {
+              this->DisableContactSurfaceCustomization(world);
+            }
+          }
         }
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::CreateJointEntity(const Entity _entity,
+    const components::Name *_name, const components::JointType *_jointType,
+    const components::Pose *_pose,
+    const components::ThreadPitch *_threadPitch,
+    const components::ParentEntity *_parentModel,
+    const components::ParentLinkName *_parentLinkName,
+    const components::ChildLinkName *_childLinkName,
+    const EntityComponentManager &_ecm, bool _warnIfEntityExists)
+{
+  if (!this->InIsland(_entity, _ecm))
+    return true;
+
+  // If the parent model is scheduled for recreation, then do not
+  // try to create a new joint. This situation can occur when a joint
+  // is added to a model from the GUI model editor.
+  if (_ecm.EntityHasComponentType(_parentModel->Data(),
+        components::Recreate::typeId))
+  {
+    // Add this entity to the set of newly added joints to existing
+    // models.
+    this->jointAddedToModel.insert(_entity);
+    return true;
+  }
+
+  // Check if joint already exists
+  if (this->entityJointMap.HasEntity(_entity))
+  {
+    if (_warnIfEntityExists)
+    {
+      gzwarn << "Joint entity [" << _entity
+              << "] marked as new, but it's already on the map."
+              << std::endl;
+    }
+    return true;
+  }
+
+  // Check if parent model exists
+  if (!this->entityModelMap.HasEntity(_parentModel->Data()))
+  {
+    gzerr << "Joint's parent model entity [" << _parentModel->Data()
+            << "] not found on model map." << std::endl;
+    return true;
+  }
+
+  auto basicModelPtrPhys = this->entityModelMap
+      .EntityCast<JointFeatureList>(_parentModel->Data());
+  if (!basicModelPtrPhys)
+  {
+    static bool informed{false};
+    if (!informed)
+    {
+      gzerr << "Attempting to create a new joint [" <<_name->Data()
+            << "] but the chosen physics engine does not support the "
+            << "minimal joint features, so no joints will be created."
+            << std::endl;
+      informed = true;
+    }
+
+    // Skip all other attempts to create joints
+    return false;
+  }
+
+  if (const auto existingJoint =
+      basicModelPtrPhys->GetJoint(_name->Data()))
+  {
+    // No need to create this joint because it was already created when
+    // parsing the model.
+    this->entityJointMap.AddEntity(_entity, existingJoint);
+    this->topLevelModelMap.insert(
+      std::make_pair(_entity, this->TopLevelModel(_entity, _ecm)));
+
+    // Check if mimic constraint should be applied to this joint's axes.
+    using AxisIndex = std::size_t;
+    std::map<AxisIndex, sdf::JointAxis> jointAxisByIndex;
+    auto jointAxis = _ecm.Component<components::JointAxis>(_entity);
+    auto jointAxis2 = _ecm.Component<components::JointAxis2>(_entity);
+
+    if (jointAxis)
+    {
+      jointAxisByIndex[0] = jointAxis->Data();
+    }
+
+    if (jointAxis2)
+    {
+      jointAxisByIndex[1] = jointAxis2->Data();
+    }
 
-        auto basicModelPtrPhys = this->entityModelMap
-            .EntityCast<JointFeatureList>(_parentModel->Data());
-        if (!basicModelPtrPhys)
+    for (const auto &[axisIndex, axis] : jointAxisByIndex)
+    {
+      if (auto mimic = axis.Mimic())
+      {
+        auto jointPtrMimic = this->entityJointMap
+            .EntityCast<MimicConstraintJointFeatureList>(existingJoint);
+        if (jointPtrMimic)
+        {
+          const auto leaderJoint =
+              basicModelPtrPhys->GetJoint(mimic->Joint());
+          std::size_t leaderAxis = 0;
+          if (mimic->Axis() == "axis2")
+          {
+            leaderAxis = 1;
+          }
+          jointPtrMimic->SetMimicConstraint(axisIndex,
+              leaderJoint,
+              leaderAxis,
+              mimic->Multiplier(),
+              mimic->Offset(),
+              mimic->Reference());
+        }
+        else
         {
           static bool informed{false};
           if (!informed)
           {
-            gzerr << "Attempting to create a new joint [" <<_name->Data()
-                  << "] but the chosen physics engine does not support the "
-                  << "minimal joint features, so no joints will be created."
+            gzerr << "Attempting to create a mimic constraint for joint ["
+                  << _name->Data()
+                  << "] but the chosen physics engine does not support "
+                  << "mimic constraints, so no constraint will be "
+                  << "created."
                   << std::endl;
             informed = true;
           }
-
-          // Skip all other attempts to create joints
-          return false;
         }
+      }
+    }
+
+    return true;
+  }
+
+  auto modelPtrPhys =
+      this->entityModelMap.EntityCast<ConstructSdfJointFeatureList>(
+          _parentModel->Data());
+  if (!modelPtrPhys)
+  {
+    gzerr << "Attempting to create a new joint [" << _name->Data()
+          << "], but the physics engine doesn't support constructing "
+          << "joints at runtime." << std::endl;
+    return true;
+  }
+
+  sdf::Joint joint;
+  joint.SetName(_name->Data());
+  joint.SetType(_jointType->Data());
+  joint.SetRawPose(_pose->Data());
+  joint.SetThreadPitch(_threadPitch->Data());
+
+  joint.SetParentName(_parentLinkName->Data());
+  joint.SetChildName(_childLinkName->Data());
+
+  auto jointAxis = _ecm.Component<components::JointAxis>(_entity);
+  auto jointAxis2 = _ecm.Component<components::JointAxis2>(_entity);
+
+  // Since we're making copies of the joint axes that were created using
+  // `Model::Load`, frame semantics should work for resolving their xyz
+  // axis
+  if (jointAxis)
+    joint.SetAxis(0, jointAxis->Data());
+  if (jointAxis2)
+    joint.SetAxis(1, jointAxis2->Data());
+
+  // Use the parent link's parent model as the model of this joint
+  auto jointPtrPhys = modelPtrPhys->ConstructJoint(joint);
+
+  if (jointPtrPhys.Valid())
+  {
+    // Some joints may not be supported, so only add them to the map if
+    // the physics entity is valid
+    this->entityJointMap.AddEntity(_entity, jointPtrPhys);
+    this->topLevelModelMap.insert(std::make_pair(_entity,
+        this->TopLevelModel(_entity, _ecm)));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::CreateDetachableJointEntity(const Entity _entity,
+    const components::DetachableJoint *_jointInfo,
+    const EntityComponentManager &_ecm, bool _warnIfEntityExists)
+{
+  if (_jointInfo->Data().jointType != "fixed")
+  {
+    gzerr << "Detachable joint type [" << _jointInfo->Data().jointType
+           << "] is currently not supported" << std::endl;
+    return true;
+  }
+  // Check if joint already exists
+  if (this->entityJointMap.HasEntity(_entity))
+  {
+    if (_warnIfEntityExists)
+    {
+      gzwarn << "Joint entity [" << _entity
+              << "] marked as new, but it's already on the map."
+              << std::endl;
+    }
+    return true;
+  }
+
+  // Check if the link entities exist in the physics engine
+  auto parentLinkPhys =
+      this->entityLinkMap.Get(_jointInfo->Data().parentLink);
+  if (!parentLinkPhys)
+  {
+    // With islands, the link may be simulated by another island
+    if (this->ReportMissingEntities() ||
+        this->InIsland(_jointInfo->Data().parentLink, _ecm))
+    {
+      gzerr << "DetachableJoint's parent link entity ["
+            << _jointInfo->Data().parentLink
+            << "] not found in link map." << std::endl;
+    }
+    return true;
+  }
+
+  auto childLinkEntity = _jointInfo->Data().childLink;
+
+  // Get child link
+  auto childLinkPhys = this->entityLinkMap.Get(childLinkEntity);
+  if (!childLinkPhys)
+  {
+    gzerr << "Failed to find joint's child link [" << childLinkEntity
+          << "]." << std::endl;
+    return true;
+  }
+
+  auto childLinkDetachableJointFeature =
+      this->entityLinkMap.EntityCast<DetachableJointFeatureList>(
+          childLinkEntity);
+  if (!childLinkDetachableJointFeature)
+  {
+    static bool informed{false};
+    if (!informed)
+    {
+      gzerr << "Attempting to create a detachable joint, but the physics"
+             << " engine doesn't support feature "
+             << "[AttachFixedJointFeature]. Detachable joints will be "
+             << "ignored." << std::endl;
+      informed = true;
+    }
 
-        if (const auto existingJoint =
-            basicModelPtrPhys->GetJoint(_name->Data()))
-        {
-          // No need to create this joint because it was already created when
-          // parsing the model.
-          this->entityJointMap.AddEntity(_entity, existingJoint);
-          this->topLevelModelMap.insert(
-            std::make_pair(_entity, topLevelModel(_entity, _ecm)));
+    // Break Each call since no DetachableJoints can be processed
+    return false;
+  }
 
-          // Check if mimic constraint should be applied to this joint's axes.
-          using AxisIndex = std::size_t;
-          std::map<AxisIndex, sdf::JointAxis> jointAxisByIndex;
-          auto jointAxis = _ecm.Component<components::JointAxis>(_entity);
-          auto jointAxis2 = _ecm.Component<components::JointAxis2>(_entity);
+  // Disabled joints are attached once they're enabled
+  auto enabled = _ecm.Component<components::DetachableJointEnabled>(_entity);
+  if (enabled && !enabled->Data())
+  {
+    this->disabledDetachableJoints.insert(_entity);
+    return true;
+  }
 
-          if (jointAxis)
-          {
-            jointAxisByIndex[0] = jointAxis->Data();
-          }
+  const auto poseParent =
+      parentLinkPhys->FrameDataRelativeToWorld().pose;
+  const auto poseChild =
+      childLinkDetachableJointFeature->FrameDataRelativeToWorld().pose;
 
-          if (jointAxis2)
-          {
-            jointAxisByIndex[1] = jointAxis2->Data();
-          }
+  // Pose of child relative to parent
+  auto poseParentChild = poseParent.inverse() * poseChild;
+  auto jointPtrPhys =
+      childLinkDetachableJointFeature->AttachFixedJoint(parentLinkPhys);
+  if (jointPtrPhys.Valid())
+  {
+    // We let the joint be at the origin of the child link.
+    jointPtrPhys->SetTransformFromParent(poseParentChild);
 
-          for (const auto &[axisIndex, axis] : jointAxisByIndex)
-          {
-            if (auto mimic = axis.Mimic())
-            {
-              auto jointPtrMimic = this->entityJointMap
-                  .EntityCast<MimicConstraintJointFeatureList>(existingJoint);
-              if (jointPtrMimic)
-              {
-                const auto leaderJoint =
-                    basicModelPtrPhys->GetJoint(mimic->Joint());
-                std::size_t leaderAxis = 0;
-                if (mimic->Axis() == "axis2")
-                {
-                  leaderAxis = 1;
-                }
-                jointPtrMimic->SetMimicConstraint(axisIndex,
-                    leaderJoint,
-                    leaderAxis,
-                    mimic->Multiplier(),
-                    mimic->Offset(),
-                    mimic->Reference());
-              }
-              else
-              {
-                static bool informed{false};
-                if (!informed)
-                {
-                  gzerr << "Attempting to create a mimic constraint for joint ["
-                        << _name->Data()
-                        << "] but the chosen physics engine does not support "
-                        << "mimic constraints, so no constraint will be "
-                        << "created."
-                        << std::endl;
-                  informed = true;
-                }
-              }
-            }
-          }
+    gzdbg << "Creating detachable joint [" << _entity << "]"
+           << std::endl;
+    this->entityJointMap.AddEntity(_entity, jointPtrPhys);
+    this->topLevelModelMap.insert(std::make_pair(_entity,
+        this->TopLevelModel(_entity, _ecm)));
+  }
+  else
+  {
+    gzerr << "DetachableJoint could not be created." << std::endl;
+  }
+  return true;
+}
 
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateDetachableJoints(const EntityComponentManager &_ecm)
+{
+  _ecm.Each<components::DetachableJoint, components::DetachableJointEnabled>(
+      [&](const Entity &_entity,
+          const components::DetachableJoint *_jointInfo,
+          const components::DetachableJointEnabled *_enabled) -> bool
+      {
+        if (_enabled->Data())
+        {
+          // Only joints that this island disabled are attached again
+          if (this->disabledDetachableJoints.erase(_entity) > 0u)
+            this->CreateDetachableJointEntity(_entity, _jointInfo, _ecm, true);
           return true;
         }
 
-        auto modelPtrPhys =
-            this->entityModelMap.EntityCast<ConstructSdfJointFeatureList>(
-                _parentModel->Data());
-        if (!modelPtrPhys)
-        {
-          gzerr << "Attempting to create a new joint [" << _name->Data()
-                << "], but the physics engine doesn't support constructing "
-                << "joints at runtime." << std::endl;
+        if (!this->entityJointMap.HasEntity(_entity))
           return true;
-        }
 
-        sdf::Joint joint;
-        joint.SetName(_name->Data());
-        joint.SetType(_jointType->Data());
-        joint.SetRawPose(_pose->Data());
-        joint.SetThreadPitch(_threadPitch->Data());
+        auto castEntity =
+            this->entityJointMap.EntityCast<DetachableJointFeatureList>(
+                _entity);
+        if (!castEntity)
+          return true;
 
-        joint.SetParentName(_parentLinkName->Data());
-        joint.SetChildName(_childLinkName->Data());
+        gzdbg << "Disabling detachable joint [" << _entity << "]"
+               << std::endl;
+        castEntity->Detach();
+        this->entityJointMap.Remove(_entity);
+        this->disabledDetachableJoints.insert(_entity);
+        return true;
+      });
+}
 
-        auto jointAxis = _ecm.Component<components::JointAxis>(_entity);
-        auto jointAxis2 = _ecm.Component<components::JointAxis2>(_entity);
+//////////////////////////////////////////////////
+void PhysicsPrivate::CreateModelTree(const Entity _model,
+    const EntityComponentManager &_ecm, bool _warnIfEntityExists)
+{
+  // Parents are created before their children
+  std::vector<Entity> models{_model};
+  for (std::size_t i = 0; i < models.size(); ++i)
+  {
+    for (const auto &nested :
+         _ecm.ChildrenByComponents(models[i], components::Model()))
+    {
+      models.push_back(nested);
+    }
+  }
 
-        // Since we're making copies of the joint axes that were created using
-        // `Model::Load`, frame semantics should work for resolving their xyz
-        // axis
-        if (jointAxis)
-          joint.SetAxis(0, jointAxis->Data());
-        if (jointAxis2)
-          joint.SetAxis(1, jointAxis2->Data());
+  std::vector<Entity> links;
+  for (const auto &model : models)
+  {
+    auto name = _ecm.Component<components::Name>(model);
+    auto pose = _ecm.Component<components::Pose>(model);
+    auto parent = _ecm.Component<components::ParentEntity>(model);
+    if (name && pose && parent)
+      this->CreateModelEntity(model, name, pose, parent, _ecm,
+          _warnIfEntityExists);
+
+    auto modelLinks = _ecm.ChildrenByComponents(model, components::Link());
+    links.insert(links.end(), modelLinks.begin(), modelLinks.end());
+  }
 
-        // Use the parent link's parent model as the model of this joint
-        auto jointPtrPhys = modelPtrPhys->ConstructJoint(joint);
+  for (const auto &link : links)
+  {
+    auto name = _ecm.Component<components::Name>(link);
+    auto pose = _ecm.Component<components::Pose>(link);
+    auto parent = _ecm.Component<components::ParentEntity>(link);
+    if (name && pose && parent)
+      this->CreateLinkEntity(link, name, pose, parent, _ecm,
+          _warnIfEntityExists);
+  }
 
-        if (jointPtrPhys.Valid())
-        {
-          // Some joints may not be supported, so only add them to the map if
-          // the physics entity is valid
-          this->entityJointMap.AddEntity(_entity, jointPtrPhys);
-          this->topLevelModelMap.insert(std::make_pair(_entity,
-              topLevelModel(_entity, _ecm)));
-        }
-        return true;
-      });
+  for (const auto &link : links)
+  {
+    for (const auto &collision :
+         _ecm.ChildrenByComponents(link, components::Collision()))
+    {
+      auto name = _ecm.Component<components::Name>(collision);
+      auto pose = _ecm.Component<components::Pose>(collision);
+      auto geom = _ecm.Component<components::Geometry>(collision);
+      auto collElement =
+          _ecm.Component<components::CollisionElement>(collision);
+      auto parent = _ecm.Component<components::ParentEntity>(collision);
+      if (name && pose && geom && collElement && parent)
+      {
+        this->CreateCollisionEntity(collision, name, pose, geom, collElement,
+            parent, _ecm, _warnIfEntityExists);
+      }
+    }
+  }
 
-  // Detachable joints
-  _ecm.EachNew<components::DetachableJoint>(
-      [&](const Entity &_entity,
-          const components::DetachableJoint *_jointInfo) -> bool
+  for (const auto &model : models)
+  {
+    for (const auto &joint :
+         _ecm.ChildrenByComponents(model, components::Joint()))
+    {
+      auto name = _ecm.Component<components::Name>(joint);
+      auto jointType = _ecm.Component<components::JointType>(joint);
+      auto pose = _ecm.Component<components::Pose>(joint);
+      auto threadPitch = _ecm.Component<components::ThreadPitch>(joint);
+      auto parent = _ecm.Component<components::ParentEntity>(joint);
+      auto parentLinkName =
+          _ecm.Component<components::ParentLinkName>(joint);
+      auto childLinkName = _ecm.Component<components::ChildLinkName>(joint);
+      if (name && jointType && pose && threadPitch && parent &&
+          parentLinkName && childLinkName)
       {
-        if (_jointInfo->Data().jointType != "fixed")
-        {
-          gzerr << "Detachable joint type [" << _jointInfo->Data().jointType
-                 << "] is currently not supported" << std::endl;
-          return true;
-        }
-        // Check if joint already exists
-        if (this->entityJointMap.HasEntity(_entity))
-        {
-          if (_warnIfEntityExists)
-          {
-            gzwarn << "Joint entity [" << _entity
-                    << "] marked as new, but it's already on the map."
-                    << std::endl;
-          }
-          return true;
-        }
+        this->CreateJointEntity(joint, name, jointType, pose, threadPitch,
+            parent, parentLinkName, childLinkName, _ecm, _warnIfEntityExists);
+      }
+    }
+  }
+}
 
-        // Check if the link entities exist in the physics engine
-        auto parentLinkPhys =
-            this->entityLinkMap.Get(_jointInfo->Data().parentLink);
-        if (!parentLinkPhys)
-        {
-          gzerr << "DetachableJoint's parent link entity ["
-                << _jointInfo->Data().parentLink << "] not found in link map."
-                << std::endl;
-          return true;
-        }
+//////////////////////////////////////////////////
+void PhysicsPrivate::CreatePendingEntities(const EntityComponentManager &_ecm,
+    bool _warnIfEntityExists)
+{
+  if (this->pendingModels.empty())
+    return;
 
-        auto childLinkEntity = _jointInfo->Data().childLink;
+  GZ_PROFILE("PhysicsPrivate::CreatePendingEntities");
 
-        // Get child link
-        auto childLinkPhys = this->entityLinkMap.Get(childLinkEntity);
-        if (!childLinkPhys)
-        {
-          gzerr << "Failed to find joint's child link [" << childLinkEntity
-                << "]." << std::endl;
-          return true;
-        }
+  while (!this->pendingModels.empty() && this->modelBudget > 0u)
+  {
+    const Entity model = this->pendingModels.front();
+    this->pendingModels.pop_front();
 
-        auto childLinkDetachableJointFeature =
-            this->entityLinkMap.EntityCast<DetachableJointFeatureList>(
-                childLinkEntity);
-        if (!childLinkDetachableJointFeature)
-        {
-          static bool informed{false};
-          if (!informed)
-          {
-            gzerr << "Attempting to create a detachable joint, but the physics"
-                   << " engine doesn't support feature "
-                   << "[AttachFixedJointFeature]. Detachable joints will be "
-                   << "ignored." << std::endl;
-            informed = true;
-          }
+    // Skip models that were removed before being created
+    if (this->pendingModelSet.erase(model) == 0u || !_ecm.HasEntity(model))
+      continue;
 
-          // Break Each call since no DetachableJoints can be processed
-          return false;
-        }
+    --this->modelBudget;
+    this->CreateModelTree(model, _ecm, _warnIfEntityExists);
+  }
 
-        const auto poseParent =
-            parentLinkPhys->FrameDataRelativeToWorld().pose;
-        const auto poseChild =
-            childLinkDetachableJointFeature->FrameDataRelativeToWorld().pose;
+  auto joints = std::move(this->pendingDetachableJoints);
+  this->pendingDetachableJoints.clear();
+  for (const auto &joint : joints)
+  {
+    auto jointInfo = _ecm.Component<components::DetachableJoint>(joint);
+    if (!jointInfo)
+      continue;
 
-        // Pose of child relative to parent
-        auto poseParentChild = poseParent.inverse() * poseChild;
-        auto jointPtrPhys =
-            childLinkDetachableJointFeature->AttachFixedJoint(parentLinkPhys);
-        if (jointPtrPhys.Valid())
-        {
-          // We let the joint be at the origin of the child link.
-          jointPtrPhys->SetTransformFromParent(poseParentChild);
+    if (this->Pending(jointInfo->Data().parentLink, _ecm) ||
+        this->Pending(jointInfo->Data().childLink, _ecm))
+    {
+      this->pendingDetachableJoints.push_back(joint);
+      continue;
+    }
+    this->CreateDetachableJointEntity(joint, jointInfo, _ecm,
+        _warnIfEntityExists);
+  }
+}
 
-          gzdbg << "Creating detachable joint [" << _entity << "]"
-                 << std::endl;
-          this->entityJointMap.AddEntity(_entity, jointPtrPhys);
-          this->topLevelModelMap.insert(std::make_pair(_entity,
-              topLevelModel(_entity, _ecm)));
-        }
-        else
-        {
-          gzerr << "DetachableJoint could not be created." << std::endl;
-        }
-        return true;
-      });
+//////////////////////////////////////////////////
+bool PhysicsPrivate::DeferModel(const Entity _model, const Entity _parent,
+    const EntityComponentManager &_ecm)
+{
+  // Nested models are created with their top-level model
+  if (!_ecm.EntityHasComponentType(_parent, components::World::typeId))
+    return this->Pending(_model, _ecm);
+
+  if (0u == this->modelsPerStep ||
+      this->entityModelMap.HasEntity(_model) ||
+      _ecm.EntityHasComponentType(_model, components::Recreate::typeId) ||
+      !this->InIsland(_model, _ecm))
+  {
+    return false;
+  }
 
-  // The components are removed after each update, so we want to process all
-  // components in every update.
-  _ecm.Each<components::EnableContactSurfaceCustomization,
-            components::Collision, components::Name>(
-      [&](const Entity & _entity,
-          const components::EnableContactSurfaceCustomization *_enable,
-          const components::Collision */*_collision*/,
-          const components::Name *_name) -> bool
-      {
-        const auto world = worldEntity(_entity, _ecm);
-        if (_enable->Data())
-        {
-          if (this->customContactSurfaceEntities[world].empty())
-          {
-            this->EnableContactSurfaceCustomization(world);
-          }
-          this->customContactSurfaceEntities[world].insert(_entity);
-          gzmsg << "Enabling contact surface customization for collision ["
-                 << _name->Data() << "]" << std::endl;
-        }
-        else
-        {
-          if (this->customContactSurfaceEntities[world].erase(_entity) > 0)
-          {
-            gzmsg << "Disabling contact surface customization for collision ["
-                   << _name->Data() << "]" << std::endl;
-            if (this->customContactSurfaceEntities[world].empty())
-            {
-              this->DisableContactSurfaceCustomization(world);
-            }
-          }
-        }
-        return true;
-      });
+  if (this->modelBudget > 0u)
+  {
+    --this->modelBudget;
+    return false;
+  }
+
+  if (this->pendingModelSet.insert(_model).second)
+    this->pendingModels.push_back(_model);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::Pending(const Entity _entity,
+    const EntityComponentManager &_ecm) const
+{
+  if (this->pendingModelSet.empty())
+    return false;
+
+  return this->pendingModelSet.find(this->TopLevelModel(_entity, _ecm)) !=
+      this->pendingModelSet.end();
+}
+
+//////////////////////////////////////////////////
+Entity PhysicsPrivate::TopLevelModel(const Entity _entity,
+    const EntityComponentManager &_ecm) const
+{
+  auto it = this->topLevelModelMap.find(_entity);
+  if (it != this->topLevelModelMap.end())
+    return it->second;
+
+  auto parentComp = _ecm.Component<components::ParentEntity>(_entity);
+  if (parentComp)
+  {
+    it = this->topLevelModelMap.find(parentComp->Data());
+    if (it != this->topLevelModelMap.end())
+      return it->second;
+  }
+
+  return topLevelModel(_entity, _ecm);
 }
 
 //////////////////////////////////////////////////
@@ -1937,6 +2846,16 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
       [&](const Entity &_entity, const components::Model *
           /* _model */) -> bool
       {
+        // Let the model's island take other models
+        if (this->islandAssignment)
+          this->islandAssignment->Remove(_entity);
+        if (this->collisionGroups)
+          this->collisionGroups->RemoveModel(_entity);
+
+        // Models that were never created don't need to be removed
+        if (this->pendingModelSet.erase(_entity) > 0u)
+          return true;
+
         const auto world = worldEntity(_ecm);
         // Remove model if found
         if (auto modelPtrPhys = this->entityModelMap.Get(_entity))
@@ -1950,6 +2869,9 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
             {
               this->entityCollisionMap.Remove(childCollision);
               this->topLevelModelMap.erase(childCollision);
+              this->appliedSlipCompliance.erase(childCollision);
+              if (this->collisionGroups)
+                this->collisionGroups->RemoveCollision(childCollision);
               if (this->customContactSurfaceEntities[world].erase(
                 childCollision))
               {
@@ -1966,6 +2888,9 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
             this->topLevelModelMap.erase(childLink);
             this->staticEntities.erase(childLink);
             this->linkWorldPoses.erase(childLink);
+            this->linkComponents.erase(childLink);
+            if (this->sleepTracker)
+              this->sleepTracker->Remove(childLink);
             this->canonicalLinkModelTracker.RemoveLink(childLink);
           }
 
@@ -1990,10 +2915,16 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
   _ecm.EachRemoved<components::DetachableJoint>(
       [&](const Entity &_entity, const components::DetachableJoint *) -> bool
       {
+        if (this->disabledDetachableJoints.erase(_entity) > 0u)
+          return true;
+
         if (!this->entityJointMap.HasEntity(_entity))
         {
-          gzwarn << "Failed to find joint [" << _entity
-                  << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find joint [" << _entity
+                    << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2026,6 +2957,16 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
 void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 {
   GZ_PROFILE("PhysicsPrivate::UpdatePhysics");
+  this->WakeCommandedLinks(_ecm);
+  this->UpdateDetachableJoints(_ecm);
+
+  this->heldJointForces.clear();
+  this->heldJointVelocities.clear();
+  this->heldLinkWrenches.clear();
+  this->heldLinearVelocities.clear();
+  this->heldAngularVelocities.clear();
+  const bool holdCommands = this->substeps > 1u;
+
   // Battery state
   _ecm.Each<components::BatterySoC>(
       [&](const Entity & _entity, const components::BatterySoC *_bat)
@@ -2084,6 +3025,16 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
             if (haltMotion && jointVelFeature)
               jointVelFeature->SetVelocityCommand(i, 0);
           }
+          if (holdCommands)
+          {
+            this->heldJointForces.emplace_back(_entity,
+                std::vector<double>(nDofs, 0.0));
+            if (haltMotion && jointVelFeature)
+            {
+              this->heldJointVelocities.emplace_back(_entity,
+                  std::vector<double>(nDofs, 0.0));
+            }
+          }
           return true;
         }
 
@@ -2252,6 +3203,12 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           {
             jointPhys->SetForce(i, force->Data()[i]);
           }
+          if (holdCommands)
+          {
+            this->heldJointForces.emplace_back(_entity, std::vector<double>(
+                force->Data().begin(), force->Data().begin() +
+                static_cast<std::ptrdiff_t>(nDofs)));
+          }
         }
         // Only set joint velocity if joint force is not set.
         // If both the cmd and reset components are found, cmd is ignored.
@@ -2293,6 +3250,12 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           {
             jointVelFeature->SetVelocityCommand(i, velocityCmd[i]);
           }
+          if (holdCommands)
+          {
+            velocityCmd.resize(nDofs);
+            this->heldJointVelocities.emplace_back(_entity,
+                std::move(velocityCmd));
+          }
         }
 
         return true;
@@ -2305,8 +3268,11 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
       {
         if (!this->entityLinkMap.HasEntity(_entity))
         {
-          gzwarn << "Failed to find link [" << _entity
-                  << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find link [" << _entity
+                    << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2332,6 +3298,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         math::Vector3 torque = msgs::Convert(_wrenchComp->Data().torque());
         linkForceFeature->AddExternalForce(math::eigen3::convert(force));
         linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
+        if (holdCommands)
+          this->heldLinkWrenches.emplace_back(_entity, force, torque);
 
         return true;
       });
@@ -2403,41 +3371,53 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
     _ecm.RemoveComponent<components::WorldPoseCmd>(entity);
   }
 
-  // Slip compliance on Collisions
+  // Slip compliance on Collisions. Commands persist, so first collect the
+  // ones that differ from what was last set, then set them in one pass.
+  std::vector<std::pair<Entity, std::array<double, 2>>> slipCompliances;
   _ecm.Each<components::SlipComplianceCmd>(
       [&](const Entity &_entity,
           const components::SlipComplianceCmd *_slipCmdComp)
       {
-        if (!this->entityCollisionMap.HasEntity(_entity))
-        {
-          gzwarn << "Failed to find shape [" << _entity << "]." << std::endl;
+        const auto &data = _slipCmdComp->Data();
+        if (data.size() != 2)
           return true;
-        }
 
-        auto slipComplianceShape =
-            this->entityCollisionMap
-                .EntityCast<FrictionPyramidSlipComplianceFeatureList>(_entity);
+        const std::array<double, 2> slip{data[0], data[1]};
+        auto it = this->appliedSlipCompliance.find(_entity);
+        if (it == this->appliedSlipCompliance.end() || it->second != slip)
+          slipCompliances.emplace_back(_entity, slip);
+        return true;
+      });
 
-        if (!slipComplianceShape)
-        {
-          gzwarn << "Can't process Wheel Slip component, physics engine "
-                  << "missing SetShapeFrictionPyramidSlipCompliance"
-                  << std::endl;
+  for (const auto &[entity, slip] : slipCompliances)
+  {
+    if (!this->entityCollisionMap.HasEntity(entity))
+    {
+      if (this->ReportMissingEntities())
+      {
+        gzwarn << "Failed to find shape [" << entity << "]." << std::endl;
+      }
+      continue;
+    }
 
-          // Break Each call since no SlipCompliances can be processed
-          return false;
-        }
+    auto slipComplianceShape =
+        this->entityCollisionMap
+            .EntityCast<FrictionPyramidSlipComplianceFeatureList>(entity);
 
-        if (_slipCmdComp->Data().size() == 2)
-        {
-          slipComplianceShape->SetPrimarySlipCompliance(
-              _slipCmdComp->Data()[0]);
-          slipComplianceShape->SetSecondarySlipCompliance(
-              _slipCmdComp->Data()[1]);
-        }
+    if (!slipComplianceShape)
+    {
+      gzwarn << "Can't process Wheel Slip component, physics engine "
+              << "missing SetShapeFrictionPyramidSlipCompliance"
+              << std::endl;
 
-        return true;
-      });
+      // No SlipCompliances can be processed
+      break;
+    }
+
+    slipComplianceShape->SetPrimarySlipCompliance(slip[0]);
+    slipComplianceShape->SetSecondarySlipCompliance(slip[1]);
+    this->appliedSlipCompliance[entity] = slip;
+  }
 
   // Update model angular velocity
   _ecm.Each<components::Model, components::AngularVelocityCmd>(
@@ -2485,6 +3465,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 
         worldAngularVelFeature->SetWorldAngularVelocity(
             math::eigen3::convert(worldAngularVel));
+        if (holdCommands)
+          this->heldAngularVelocities.emplace_back(_entity, worldAngularVel);
         return true;
       });
 
@@ -2535,6 +3517,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 
         worldLinearVelFeature->SetWorldLinearVelocity(
             math::eigen3::convert(worldLinearVel));
+        if (holdCommands)
+          this->heldLinearVelocities.emplace_back(_entity, worldLinearVel);
 
         return true;
       });
@@ -2546,8 +3530,11 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
       {
         if (!this->entityLinkMap.HasEntity(_entity))
         {
-          gzwarn << "Failed to find link [" << _entity
-                  << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find link [" << _entity
+                    << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2587,6 +3574,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
             * modelToLinkTransform.Rot() * _angularVelocityCmd->Data();
         worldAngularVelFeature->SetWorldAngularVelocity(
             math::eigen3::convert(worldAngularVel));
+        if (holdCommands)
+          this->heldAngularVelocities.emplace_back(_entity, worldAngularVel);
 
         return true;
       });
@@ -2598,8 +3587,11 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
       {
         if (!this->entityLinkMap.HasEntity(_entity))
         {
-          gzwarn << "Failed to find link [" << _entity
-                  << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find link [" << _entity
+                    << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2639,6 +3631,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
             * modelToLinkTransform.Rot() * _linearVelocityCmd->Data();
         worldLinearVelFeature->SetWorldLinearVelocity(
             math::eigen3::convert(worldLinearVel));
+        if (holdCommands)
+          this->heldLinearVelocities.emplace_back(_entity, worldLinearVel);
 
         return true;
       });
@@ -2653,7 +3647,10 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
       {
         if (!this->entityModelMap.HasEntity(_entity))
         {
-          gzwarn << "Failed to find model [" << _entity << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find model [" << _entity << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2695,22 +3692,73 @@ void PhysicsPrivate::ResetPhysics(EntityComponentManager &_ecm)
   // Clear worldPoseCmdsToRemove because pose commands that were issued before
   // the reset will be ignored.
   this->linkWorldPoses.clear();
+  this->linkComponents.clear();
+  this->activityDeferredLinks.clear();
+  if (this->sleepTracker && this->sleepTracker->SleepingCount() > 0u)
+  {
+    // All links start awake again
+    std::vector<Entity> sleepingLinks;
+    _ecm.Each<components::Sleeping>(
+        [&](const Entity &_entity, const components::Sleeping *) -> bool
+        {
+          if (this->sleepTracker->Asleep(_entity))
+            sleepingLinks.push_back(_entity);
+          return true;
+        });
+    for (const auto &link : sleepingLinks)
+      _ecm.RemoveComponent<components::Sleeping>(link);
+    this->sleepTracker->Clear();
+  }
   this->canonicalLinkModelTracker = CanonicalLinkModelTracker();
   this->modelWorldPoses.clear();
   this->worldPoseCmdsToRemove.clear();
+  // Recreated shapes have the slip compliance of their SDF
+  this->appliedSlipCompliance.clear();
 
   this->RemovePhysicsEntities(_ecm);
   this->CreatePhysicsEntities(_ecm, false);
   this->canonicalLinkModelTracker.AddAllModels(_ecm);
 
+  // The reset marks the poses it changed, so only links that moved since the
+  // initial state, or whose models did, are reset, together with the joints
+  // of their models
+  auto poseReset = [&](Entity _entity)
+  {
+    for (; kNullEntity != _entity &&
+         _ecm.EntityHasComponentType(_entity, components::Pose::typeId);
+         _entity = _ecm.ParentEntity(_entity))
+    {
+      if (_ecm.ComponentState(_entity, components::Pose::typeId) !=
+          ComponentState::NoChange)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+  std::unordered_set<Entity> resetModels;
+
   // Update link pose, linear velocity, and angular velocity
   _ecm.Each<components::Link>(
       [&](const Entity &_entity, const components::Link *)
       {
+        if (!poseReset(_entity))
+          return true;
+
+        for (auto model = _ecm.ParentEntity(_entity); kNullEntity != model &&
+             _ecm.EntityHasComponentType(model, components::Model::typeId);
+             model = _ecm.ParentEntity(model))
+        {
+          resetModels.insert(model);
+        }
+
         auto linkPtrPhys = this->entityLinkMap.Get(_entity);
         if (nullptr == linkPtrPhys)
         {
-          gzwarn << "Failed to find link [" << _entity << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find link [" << _entity << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2778,10 +3826,19 @@ void PhysicsPrivate::ResetPhysics(EntityComponentManager &_ecm)
   _ecm.Each<components::Joint>(
       [&](const Entity &_entity, const components::Joint *)
       {
+        if (resetModels.find(_ecm.ParentEntity(_entity)) ==
+            resetModels.end())
+        {
+          return true;
+        }
+
         auto jointPhys = this->entityJointMap.Get(_entity);
         if (nullptr == jointPhys)
         {
-          gzwarn << "Failed to find joint [" << _entity << "]." << std::endl;
+          if (this->ReportMissingEntities())
+          {
+            gzwarn << "Failed to find joint [" << _entity << "]." << std::endl;
+          }
           return true;
         }
 
@@ -2821,16 +3878,230 @@ gz::physics::ForwardStep::Output PhysicsPrivate::Step(
   physics::ForwardStep::State state;
   physics::ForwardStep::Output output;
 
-  input.Get<std::chrono::steady_clock::duration>() = _dt;
+  if (this->substeps <= 1u)
+  {
+    input.Get<std::chrono::steady_clock::duration>() = _dt;
+
+    for (const auto &world : this->entityWorldMap.Map())
+    {
+      world.second->Step(output, state, input);
+    }
+
+    return output;
+  }
 
-  for (const auto &world : this->entityWorldMap.Map())
+  // Split the iteration into substeps. The last substep takes the remainder,
+  // so the worlds advance by exactly _dt. Links that changed in any substep
+  // are reported, and their final state is written back.
+  const auto substepDt = _dt / this->substeps;
+  std::unordered_map<std::size_t, std::size_t> changedIndex;
+  for (unsigned int i = 0; i < this->substeps; ++i)
   {
-    world.second->Step(output, state, input);
+    // Commands are held constant during the iteration
+    if (i > 0)
+      this->ReapplyHeldCommands();
+
+    input.Get<std::chrono::steady_clock::duration>() =
+        (i + 1 < this->substeps) ? substepDt :
+        _dt - substepDt * (this->substeps - 1);
+
+    physics::ForwardStep::Output substepOutput;
+    for (const auto &world : this->entityWorldMap.Map())
+    {
+      world.second->Step(substepOutput, state, input);
+    }
+
+    if (!substepOutput.Has<physics::ChangedWorldPoses>())
+      continue;
+
+    auto &changed = output.Get<physics::ChangedWorldPoses>().entries;
+    for (const auto &entry :
+        substepOutput.Query<physics::ChangedWorldPoses>()->entries)
+    {
+      auto [it, inserted] = changedIndex.emplace(entry.body, changed.size());
+      if (inserted)
+        changed.push_back(entry);
+      else
+        changed[it->second] = entry;
+    }
   }
 
   return output;
 }
 
+//////////////////////////////////////////////////
+void PhysicsPrivate::ReapplyHeldCommands()
+{
+  GZ_PROFILE("PhysicsPrivate::ReapplyHeldCommands");
+  for (const auto &[entity, forces] : this->heldJointForces)
+  {
+    auto jointPhys = this->entityJointMap.Get(entity);
+    if (nullptr == jointPhys)
+      continue;
+    for (std::size_t i = 0; i < forces.size(); ++i)
+      jointPhys->SetForce(i, forces[i]);
+  }
+
+  for (const auto &[entity, velocities] : this->heldJointVelocities)
+  {
+    auto jointVelFeature =
+        this->entityJointMap.EntityCast<JointVelocityCommandFeatureList>(
+            entity);
+    if (!jointVelFeature)
+      continue;
+    for (std::size_t i = 0; i < velocities.size(); ++i)
+      jointVelFeature->SetVelocityCommand(i, velocities[i]);
+  }
+
+  for (const auto &[entity, force, torque] : this->heldLinkWrenches)
+  {
+    auto linkForceFeature =
+        this->entityLinkMap.EntityCast<LinkForceFeatureList>(entity);
+    if (!linkForceFeature)
+      continue;
+    linkForceFeature->AddExternalForce(math::eigen3::convert(force));
+    linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
+  }
+
+  for (const auto &[entity, velocity] : this->heldLinearVelocities)
+  {
+    auto worldVelFeature =
+        this->entityFreeGroupMap.EntityCast<WorldVelocityCommandFeatureList>(
+            entity);
+    if (!worldVelFeature)
+      continue;
+    worldVelFeature->SetWorldLinearVelocity(math::eigen3::convert(velocity));
+  }
+
+  for (const auto &[entity, velocity] : this->heldAngularVelocities)
+  {
+    auto worldVelFeature =
+        this->entityFreeGroupMap.EntityCast<WorldVelocityCommandFeatureList>(
+            entity);
+    if (!worldVelFeature)
+      continue;
+    worldVelFeature->SetWorldAngularVelocity(
+        math::eigen3::convert(velocity));
+  }
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateSubsteps(const EntityComponentManager &_ecm)
+{
+  if (!_ecm.HasComponentType(components::PhysicsSubsteps::typeId))
+    return;
+
+  _ecm.Each<components::World, components::PhysicsSubsteps>(
+      [&](const Entity &, const components::World *,
+          const components::PhysicsSubsteps *_substeps) -> bool
+      {
+        const auto substepCount =
+            std::max<unsigned int>(_substeps->Data(), 1u);
+        if (substepCount == this->substeps)
+          return false;
+
+        gzdbg << "Running [" << substepCount
+               << "] physics substeps per iteration." << std::endl;
+        this->substeps = substepCount;
+        for (auto &island : this->otherIslands)
+          island->substeps = substepCount;
+        return false;
+      });
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::InIsland(const Entity _entity,
+    const EntityComponentManager &_ecm) const
+{
+  if (!this->islandAssignment)
+    return true;
+
+  // The world and entities directly under it are in all islands
+  const Entity model = this->TopLevelModel(_entity, _ecm);
+  if (kNullEntity == model)
+    return true;
+
+  // Static models are copied to all islands, so every island collides with
+  // them
+  auto staticComp = _ecm.Component<components::Static>(model);
+  if (staticComp && staticComp->Data())
+    return true;
+
+  return this->islandAssignment->Island(model) == this->island;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::ReportMissingEntities() const
+{
+  return nullptr == this->islandAssignment && this->pendingModelSet.empty();
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateIslands(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("PhysicsPrivate::UpdateIslands");
+
+  std::vector<PhysicsPrivate *> islands{this};
+  for (auto &other : this->otherIslands)
+    islands.push_back(other.get());
+
+  // Reading and writing the ECM happens on the simulation thread
+  for (auto *island : islands)
+  {
+    island->CreatePhysicsEntities(_ecm);
+    island->UpdatePhysics(_ecm);
+    island->stepOutput = gz::physics::ForwardStep::Output();
+  }
+
+  // Only step if not paused.
+  if (!_info.paused)
+  {
+    // Contact surface customization emits events from within the step, so
+    // islands that use it are stepped sequentially
+    const bool concurrent = this->concurrentIslands &&
+        std::none_of(islands.begin(), islands.end(),
+        [](const PhysicsPrivate *_island)
+        {
+          for (const auto &[world, entities] :
+              _island->customContactSurfaceEntities)
+          {
+            if (!entities.empty())
+              return true;
+          }
+          return false;
+        });
+
+    if (concurrent)
+    {
+      // The simulation thread takes part in stepping the islands
+      auto &pool = ThreadPool::Shared();
+      pool.ParallelFor(islands.size(), pool.GrainSize(islands.size()),
+          [&islands, &_info](std::size_t _begin, std::size_t _end)
+          {
+            for (std::size_t i = _begin; i < _end; ++i)
+              islands[i]->stepOutput = islands[i]->Step(_info.dt);
+          });
+    }
+    else
+    {
+      for (auto *island : islands)
+        island->stepOutput = island->Step(_info.dt);
+    }
+  }
+
+  for (auto *island : islands)
+  {
+    island->ChangedLinks(_ecm, island->stepOutput, island->changedLinks);
+    island->UpdateSim(_ecm, island->changedLinks);
+  }
+
+  // Entities scheduled to be removed should be removed from physics after the
+  // simulation step, see Physics::Update
+  for (auto *island : islands)
+    island->RemovePhysicsEntities(_ecm);
+}
+
 //////////////////////////////////////////////////
 math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
   const Entity &_to, const EntityComponentManager &_ecm) const
@@ -2868,13 +4139,13 @@ math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
 }
 
 //////////////////////////////////////////////////
-std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
-    EntityComponentManager &_ecm,
-    const gz::physics::ForwardStep::Output &_updatedLinks)
+void PhysicsPrivate::ChangedLinks(EntityComponentManager &_ecm,
+    const gz::physics::ForwardStep::Output &_updatedLinks,
+    LinkFrameDataList &_linkFrameData)
 {
   GZ_PROFILE("Links Frame Data");
 
-  std::map<Entity, physics::FrameData3d> linkFrameData;
+  _linkFrameData.Clear();
 
   // Check to see if the physics engine gave a list of changed poses. If not, we
   // will iterate through all of the links via the ECM to see which ones changed
@@ -2900,7 +4171,34 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
       }
 
       auto frameData = linkPhys->FrameDataRelativeToWorld();
-      linkFrameData[entity] = frameData;
+      if (this->UpdateSleep(entity, frameData, _ecm))
+        continue;
+
+      if (this->ActivityDeferred(entity, _ecm))
+      {
+        this->activityDeferredLinks.insert(entity);
+        continue;
+      }
+      this->activityDeferredLinks.erase(entity);
+
+      _linkFrameData.Add(entity, frameData);
+    }
+
+    // Deferred links that didn't move in this step still need their latest
+    // results written back
+    for (auto it = this->activityDeferredLinks.begin();
+         it != this->activityDeferredLinks.end();)
+    {
+      if (this->ActivityDeferred(*it, _ecm))
+      {
+        ++it;
+        continue;
+      }
+
+      auto linkPhys = this->entityLinkMap.Get(*it);
+      if (nullptr != linkPhys)
+        _linkFrameData.Add(*it, linkPhys->FrameDataRelativeToWorld());
+      it = this->activityDeferredLinks.erase(it);
     }
   }
   else
@@ -2925,7 +4223,9 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
             // ignore links from actors for now
             auto parentId =
                 _ecm.Component<components::ParentEntity>(_entity)->Data();
-            if (!_ecm.Component<components::Actor>(parentId))
+            if (!_ecm.Component<components::Actor>(parentId) &&
+                this->InIsland(_entity, _ecm) &&
+                !this->Pending(_entity, _ecm))
             {
               gzerr << "Internal error: link [" << _entity
                     << "] not in entity map" << std::endl;
@@ -2934,6 +4234,10 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
           return true;
         }
 
+        // The pose isn't cached, so the link is written back once it's due
+        if (this->ActivityDeferred(_entity, _ecm))
+          return true;
+
         auto frameData = linkPhys->FrameDataRelativeToWorld();
 
         // update the link pose if this is the first update,
@@ -2948,20 +4252,186 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
           // during the next iteration
           this->linkWorldPoses[_entity] = worldPoseMath3d;
 
-          linkFrameData[_entity] = frameData;
+          if (!this->UpdateSleep(_entity, frameData, _ecm))
+            _linkFrameData.Add(_entity, frameData);
         }
 
         return true;
       });
   }
 
-  return linkFrameData;
+  _linkFrameData.Sort();
+
+  // The pose of a model follows its canonical link. If links of a model are
+  // written back while its awake canonical link isn't, such as when it
+  // stopped being reported while it was asleep, write the canonical link too
+  // so the model pose is updated in the same pass.
+  if (this->sleepTracker)
+  {
+    const std::size_t changedCount = _linkFrameData.Size();
+    for (std::size_t i = 0; i < changedCount; ++i)
+    {
+      auto canonicalLinkComp = _ecm.Component<components::ModelCanonicalLink>(
+          _ecm.ParentEntity(_linkFrameData[i].first));
+      if (nullptr == canonicalLinkComp)
+        continue;
+
+      const Entity canonicalLink = canonicalLinkComp->Data();
+      if (this->sleepTracker->Asleep(canonicalLink) ||
+          _linkFrameData.Has(canonicalLink))
+      {
+        continue;
+      }
+
+      physics::FrameData3d frameData;
+      if (this->GetFrameDataRelativeToWorld(canonicalLink, frameData))
+        _linkFrameData.Add(canonicalLink, frameData);
+    }
+
+    if (_linkFrameData.Size() != changedCount)
+      _linkFrameData.Sort();
+  }
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::UpdateSleep(const Entity _link,
+    const physics::FrameData3d &_frameData, EntityComponentManager &_ecm)
+{
+  if (!this->sleepTracker)
+    return false;
+
+  const auto transition = this->sleepTracker->Update(_link,
+      _frameData.linearVelocity.norm(), _frameData.angularVelocity.norm());
+  if (transition == SleepTracker::Transition::kFellAsleep)
+    _ecm.CreateComponent(_link, components::Sleeping());
+  else if (transition == SleepTracker::Transition::kWokeUp)
+    _ecm.RemoveComponent<components::Sleeping>(_link);
+
+  return this->sleepTracker->Asleep(_link);
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::ActivityDeferred(const Entity _link,
+    const EntityComponentManager &_ecm) const
+{
+  if (!_ecm.HasComponentType(components::ActivityLevel::typeId))
+    return false;
+
+  return !activityUpdateDue(this->TopLevelModel(_link, _ecm), _ecm,
+      this->iteration);
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::WakeLink(const Entity _link,
+    EntityComponentManager &_ecm)
+{
+  if (this->sleepTracker->Wake(_link))
+    _ecm.RemoveComponent<components::Sleeping>(_link);
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::WakeCommandedLinks(EntityComponentManager &_ecm)
+{
+  if (!this->sleepTracker || this->sleepTracker->SleepingCount() == 0u)
+    return;
+
+  GZ_PROFILE("PhysicsPrivate::WakeCommandedLinks");
+
+  // Commands on a model or joint may move any link of the model, including
+  // the links of nested models
+  auto wakeModel = [&](const Entity _model)
+  {
+    for (const auto &descendant : _ecm.Descendants(_model))
+    {
+      if (_ecm.EntityHasComponentType(descendant, components::Link::typeId))
+        this->WakeLink(descendant, _ecm);
+    }
+  };
+  auto wakeEntity = [&](const Entity _entity)
+  {
+    if (_ecm.EntityHasComponentType(_entity, components::Link::typeId))
+      this->WakeLink(_entity, _ecm);
+    else
+      wakeModel(_entity);
+  };
+  auto wakeJoint = [&](const Entity _joint)
+  {
+    auto parent = _ecm.Component<components::ParentEntity>(_joint);
+    if (parent)
+      wakeModel(parent->Data());
+  };
+
+  auto nonZero = [](const std::vector<double> &_values)
+  {
+    return std::any_of(_values.begin(), _values.end(),
+        [](double _value) { return _value != 0.0; });
+  };
+
+  // Pose commands and resets are removed once they're applied, while the
+  // other commands are kept and zeroed, so only non-zero ones wake links up
+  _ecm.Each<components::WorldPoseCmd>(
+      [&](const Entity &_entity, const components::WorldPoseCmd *) -> bool
+      {
+        wakeModel(_entity);
+        return true;
+      });
+  _ecm.Each<components::LinearVelocityCmd>(
+      [&](const Entity &_entity, const components::LinearVelocityCmd *_cmd)
+      {
+        if (_cmd->Data() != math::Vector3d::Zero)
+          wakeEntity(_entity);
+        return true;
+      });
+  _ecm.Each<components::AngularVelocityCmd>(
+      [&](const Entity &_entity, const components::AngularVelocityCmd *_cmd)
+      {
+        if (_cmd->Data() != math::Vector3d::Zero)
+          wakeEntity(_entity);
+        return true;
+      });
+  _ecm.Each<components::ExternalWorldWrenchCmd>(
+      [&](const Entity &_entity,
+          const components::ExternalWorldWrenchCmd *_cmd)
+      {
+        if (msgs::Convert(_cmd->Data().force()) != math::Vector3d::Zero ||
+            msgs::Convert(_cmd->Data().torque()) != math::Vector3d::Zero)
+        {
+          this->WakeLink(_entity, _ecm);
+        }
+        return true;
+      });
+  _ecm.Each<components::JointForceCmd>(
+      [&](const Entity &_entity, const components::JointForceCmd *_cmd)
+      {
+        if (nonZero(_cmd->Data()))
+          wakeJoint(_entity);
+        return true;
+      });
+  _ecm.Each<components::JointVelocityCmd>(
+      [&](const Entity &_entity, const components::JointVelocityCmd *_cmd)
+      {
+        if (nonZero(_cmd->Data()))
+          wakeJoint(_entity);
+        return true;
+      });
+  _ecm.Each<components::JointPositionReset>(
+      [&](const Entity &_entity, const components::JointPositionReset *)
+      {
+        wakeJoint(_entity);
+        return true;
+      });
+  _ecm.Each<components::JointVelocityReset>(
+      [&](const Entity &_entity, const components::JointVelocityReset *)
+      {
+        wakeJoint(_entity);
+        return true;
+      });
 }
 
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateModelPose(const Entity _model,
-    const Entity _canonicalLink, EntityComponentManager &_ecm,
-    std::map<Entity, physics::FrameData3d> &_linkFrameData)
+    const Entity _canonicalLink, const math::Pose3d &_linkWorldPose,
+    EntityComponentManager &_ecm, LinkFrameDataList &_linkFrameData)
 {
   std::optional<math::Pose3d> parentWorldPose;
 
@@ -3000,9 +4470,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   // And X_WM is calculated from X_WL, which is obtained from physics as:
   //   X_WM = X_WL * (X_ML)^-1
   auto linkPoseFromModel = this->RelativePose(_model, _canonicalLink, _ecm);
-  const auto &linkWorldPose = _linkFrameData[_canonicalLink].pose;
-  const auto &modelWorldPose =
-      math::eigen3::convert(linkWorldPose) * linkPoseFromModel.Inverse();
+  const auto &modelWorldPose = _linkWorldPose * linkPoseFromModel.Inverse();
 
   this->modelWorldPoses[_model] = modelWorldPose;
 
@@ -3030,14 +4498,14 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   for (const auto &childLink : model.Links(_ecm))
   {
     // skip links that are already marked as a link to be updated
-    if (_linkFrameData.find(childLink) != _linkFrameData.end())
+    if (_linkFrameData.Has(childLink))
       continue;
 
     physics::FrameData3d childLinkFrameData;
     if (!this->GetFrameDataRelativeToWorld(childLink, childLinkFrameData))
       continue;
 
-    _linkFrameData[childLink] = childLinkFrameData;
+    _linkFrameData.Add(childLink, childLinkFrameData);
   }
 
   // since nested model poses are saved w.r.t. the nested model's parent
@@ -3059,7 +4527,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
 
     // skip links that are already marked as a link to be updated
     if (nestedCanonicalLink == _canonicalLink ||
-        _linkFrameData.find(nestedCanonicalLink) != _linkFrameData.end())
+        _linkFrameData.Has(nestedCanonicalLink))
       continue;
 
     // mark this canonical link as one that needs to be updated so that all of
@@ -3069,7 +4537,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
           canonicalLinkFrameData))
       continue;
 
-    _linkFrameData[nestedCanonicalLink] = canonicalLinkFrameData;
+    _linkFrameData.Add(nestedCanonicalLink, canonicalLinkFrameData);
   }
 }
 
@@ -3095,7 +4563,7 @@ bool PhysicsPrivate::GetFrameDataRelativeToWorld(const Entity _entity,
 
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
-    std::map<Entity, physics::FrameData3d> &_linkFrameData)
+    LinkFrameDataList &_linkFrameData)
 {
   GZ_PROFILE("PhysicsPrivate::UpdateSim");
 
@@ -3140,27 +4608,38 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // make sure we have an up-to-date mapping of canonical links to their models
   this->canonicalLinkModelTracker.AddNewModels(_ecm);
 
-  for (const auto &[linkEntity, frameData] : _linkFrameData)
+  // Links are indexed, because UpdateModelPose adds links to the list
+  for (std::size_t i = 0; i < _linkFrameData.Size(); ++i)
   {
+    const Entity linkEntity = _linkFrameData[i].first;
+
     // get a topological ordering of the models that have linkEntity as the
     // model's canonical link. If linkEntity isn't a canonical link for any
     // models, canonicalLinkModels will be empty
-    auto canonicalLinkModels =
+    const auto &canonicalLinkModels =
       this->canonicalLinkModelTracker.CanonicalLinkModels(linkEntity);
+    if (canonicalLinkModels.empty())
+      continue;
 
     // Update poses for all of the models that have this changed canonical link
     // (linkEntity). Since we have the models in topological order and
-    // _linkFrameData stores links in topological order thanks to the ordering
-    // of std::map (entity IDs are created in ascending order), this should
-    // properly handle pose updates for nested models that share the same
-    // canonical link.
+    // _linkFrameData stores the links from physics in topological order
+    // because they're sorted (entity IDs are created in ascending order), this
+    // should properly handle pose updates for nested models that share the
+    // same canonical link. Links added by UpdateModelPose are appended, so
+    // they're visited after the model that added them.
     //
     // Nested models that don't share the same canonical link will also need to
     // be updated since these nested models have their pose saved w.r.t. their
     // parent model, which just experienced a pose update. The UpdateModelPose
     // method also handles this case.
+    const auto linkWorldPose =
+        math::eigen3::convert(_linkFrameData[i].second.pose);
     for (auto &modelEnt : canonicalLinkModels)
-      this->UpdateModelPose(modelEnt, linkEntity, _ecm, _linkFrameData);
+    {
+      this->UpdateModelPose(modelEnt, linkEntity, linkWorldPose, _ecm,
+          _linkFrameData);
+    }
   }
   GZ_PROFILE_END();
 
@@ -3168,9 +4647,34 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   GZ_PROFILE_BEGIN("Links");
   for (const auto &[entity, frameData] : _linkFrameData)
   {
+    // Look the components of the link up the first time it's updated
+    auto compsIt = this->linkComponents.find(entity);
+    if (compsIt == this->linkComponents.end())
+    {
+      LinkComponents comps;
+      comps.pose = _ecm.Handle<components::Pose>(entity);
+      comps.canonicalLink = _ecm.Handle<components::CanonicalLink>(entity);
+      comps.worldPose = _ecm.Handle<components::WorldPose>(entity);
+      comps.worldLinVel =
+          _ecm.Handle<components::WorldLinearVelocity>(entity);
+      comps.worldAngVel =
+          _ecm.Handle<components::WorldAngularVelocity>(entity);
+      comps.worldLinAccel =
+          _ecm.Handle<components::WorldLinearAcceleration>(entity);
+      comps.worldAngAccel =
+          _ecm.Handle<components::WorldAngularAcceleration>(entity);
+      comps.bodyLinVel = _ecm.Handle<components::LinearVelocity>(entity);
+      comps.bodyAngVel = _ecm.Handle<components::AngularVelocity>(entity);
+      comps.bodyLinAccel =
+          _ecm.Handle<components::LinearAcceleration>(entity);
+      comps.bodyAngAccel =
+          _ecm.Handle<components::AngularAcceleration>(entity);
+      compsIt = this->linkComponents.emplace(entity, std::move(comps)).first;
+    }
+    auto &comps = compsIt->second;
+
     GZ_PROFILE_BEGIN("Local pose");
-    auto canonicalLink =
-        _ecm.Component<components::CanonicalLink>(entity);
+    auto canonicalLink = comps.canonicalLink.Get();
 
     const auto &worldPose = frameData.pose;
     const auto parentEntity = _ecm.ParentEntity(entity);
@@ -3190,7 +4694,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
 
       // Unlike canonical links, pose of regular links can move relative.
       // to the parent. Same for links inside nested models.
-      auto pose = _ecm.Component<components::Pose>(entity);
+      auto pose = comps.pose.Get();
       *pose = components::Pose(parentWorldPose.Inverse() *
                                 math::eigen3::convert(worldPose));
       _ecm.SetChanged(entity, components::Pose::typeId,
@@ -3201,7 +4705,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     // Populate world poses, velocities and accelerations of the link. For
     // now these components are updated only if another system has created
     // the corresponding component on the entity.
-    auto worldPoseComp = _ecm.Component<components::WorldPose>(entity);
+    auto worldPoseComp = comps.worldPose.Get();
     if (worldPoseComp)
     {
       auto state =
@@ -3213,8 +4717,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Velocity in world coordinates
-    auto worldLinVelComp =
-        _ecm.Component<components::WorldLinearVelocity>(entity);
+    auto worldLinVelComp = comps.worldLinVel.Get();
     if (worldLinVelComp)
     {
       auto state = worldLinVelComp->SetData(
@@ -3227,8 +4730,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Angular velocity in world frame coordinates
-    auto worldAngVelComp =
-        _ecm.Component<components::WorldAngularVelocity>(entity);
+    auto worldAngVelComp = comps.worldAngVel.Get();
     if (worldAngVelComp)
     {
       auto state = worldAngVelComp->SetData(
@@ -3241,8 +4743,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Acceleration in world frame coordinates
-    auto worldLinAccelComp =
-        _ecm.Component<components::WorldLinearAcceleration>(entity);
+    auto worldLinAccelComp = comps.worldLinAccel.Get();
     if (worldLinAccelComp)
     {
       auto state = worldLinAccelComp->SetData(
@@ -3255,8 +4756,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Angular acceleration in world frame coordinates
-    auto worldAngAccelComp =
-        _ecm.Component<components::WorldAngularAcceleration>(entity);
+    auto worldAngAccelComp = comps.worldAngAccel.Get();
 
     if (worldAngAccelComp)
     {
@@ -3272,8 +4772,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
 
     // Velocity in body-fixed frame coordinates
-    auto bodyLinVelComp =
-        _ecm.Component<components::LinearVelocity>(entity);
+    auto bodyLinVelComp = comps.bodyLinVel.Get();
     if (bodyLinVelComp)
     {
       Eigen::Vector3d bodyLinVel = R_bs * frameData.linearVelocity;
@@ -3286,8 +4785,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Angular velocity in body-fixed frame coordinates
-    auto bodyAngVelComp =
-        _ecm.Component<components::AngularVelocity>(entity);
+    auto bodyAngVelComp = comps.bodyAngVel.Get();
     if (bodyAngVelComp)
     {
       Eigen::Vector3d bodyAngVel = R_bs * frameData.angularVelocity;
@@ -3301,8 +4799,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Acceleration in body-fixed frame coordinates
-    auto bodyLinAccelComp =
-        _ecm.Component<components::LinearAcceleration>(entity);
+    auto bodyLinAccelComp = comps.bodyLinAccel.Get();
     if (bodyLinAccelComp)
     {
       Eigen::Vector3d bodyLinAccel = R_bs * frameData.linearAcceleration;
@@ -3316,8 +4813,7 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     }
 
     // Angular acceleration in world frame coordinates
-    auto bodyAngAccelComp =
-        _ecm.Component<components::AngularAcceleration>(entity);
+    auto bodyAngAccelComp = comps.bodyAngAccel.Get();
     if (bodyAngAccelComp)
     {
       Eigen::Vector3d bodyAngAccel = R_bs * frameData.angularAcceleration;
@@ -3635,12 +5131,6 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
         return true;
       });
 
-  _ecm.Each<components::SlipComplianceCmd>(
-      [&](const Entity &, components::SlipComplianceCmd *_slip) -> bool
-      {
-        std::fill(_slip->Data().begin(), _slip->Data().end(), 0.0);
-        return true;
-      });
   GZ_PROFILE_END();
 
   _ecm.Each<components::AngularVelocityCmd>(
@@ -3743,9 +5233,13 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
 void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
 {
   GZ_PROFILE("PhysicsPrivate::UpdateCollisions");
-  // Quit early if the ContactData component hasn't been created. This means
-  // there are no systems that need contact information
-  if (!_ecm.HasComponentType(components::ContactSensorData::typeId))
+  // Quit early if the ContactData and ContactBuffer components haven't been
+  // created. This means there are no systems that need contact information
+  const bool needsContactData =
+      _ecm.HasComponentType(components::ContactSensorData::typeId);
+  const bool needsContactBuffer =
+      _ecm.HasComponentType(components::ContactBuffer::typeId);
+  if (!needsContactData && !needsContactBuffer)
     return;
 
   // TODO(addisu) If systems are assumed to only have one world, we should
@@ -3824,6 +5318,80 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
     }
   }
 
+  // With islands, each island updates its own collisions. Collisions of
+  // static models are in all islands, so the contacts found by the other
+  // islands are added to the ones found by the first island.
+  auto skipOrMerge = [&](const Entity _collEntity, bool &_merge) -> bool
+  {
+    _merge = false;
+    if (!this->islandAssignment)
+      return false;
+    if (!this->entityCollisionMap.HasEntity(_collEntity))
+      return true;
+    _merge = this->island > 0 && this->staticEntities.find(
+        _ecm.ParentEntity(_collEntity)) != this->staticEntities.end();
+    return false;
+  };
+
+  // Go through each collision entity that has a ContactBuffer component and
+  // fill it with the contacts that correspond to the collision entity,
+  // reusing its storage
+  if (needsContactBuffer)
+  {
+    _ecm.Each<components::Collision, components::ContactBuffer>(
+        [&](const Entity &_collEntity1, components::Collision *,
+            components::ContactBuffer *_buffer) -> bool
+        {
+          bool merge{false};
+          if (skipOrMerge(_collEntity1, merge))
+            return true;
+
+          auto &buffer = _buffer->Data();
+          const bool wasEmpty = buffer.Empty();
+          if (!merge)
+            buffer.Clear();
+          buffer.entityNames = this->contactsEntityNames;
+
+          auto contactIt = entityContactMap.find(_collEntity1);
+          if (contactIt != entityContactMap.end())
+          {
+            for (const auto &[collEntity2, contactData] : contactIt->second)
+            {
+              components::ContactBufferData::Pair pair;
+              pair.collision2 = collEntity2;
+              pair.first = buffer.positions.size();
+              pair.count = contactData.size();
+              buffer.pairs.push_back(pair);
+
+              for (const auto &contact : contactData)
+              {
+                buffer.positions.push_back(
+                    math::eigen3::convert(contact.first->point));
+
+                // Not all physics engines support extra contact data
+                if (contact.second == nullptr)
+                  continue;
+
+                buffer.normals.push_back(
+                    math::eigen3::convert(contact.second->normal));
+                buffer.forces.push_back(
+                    math::eigen3::convert(contact.second->force));
+                buffer.depths.push_back(contact.second->depth);
+              }
+            }
+          }
+
+          const auto state = (wasEmpty && buffer.Empty()) ?
+              ComponentState::NoChange : ComponentState::PeriodicChange;
+          _ecm.SetChanged(
+              _collEntity1, components::ContactBuffer::typeId, state);
+          return true;
+        });
+  }
+
+  if (!needsContactData)
+    return;
+
   // Go through each collision entity that has a ContactData component and
   // set the component value to the list of contacts that correspond to
   // the collision entity
@@ -3831,9 +5399,19 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
       [&](const Entity &_collEntity1, components::Collision *,
           components::ContactSensorData *_contacts) -> bool
       {
+        bool merge{false};
+        if (skipOrMerge(_collEntity1, merge))
+          return true;
+
         msgs::Contacts contactsComp;
+        if (merge)
+          contactsComp = _contacts->Data();
+
         if (entityContactMap.find(_collEntity1) == entityContactMap.end())
         {
+          if (merge)
+            return true;
+
           // Clear the last contact data
           auto state = _contacts->SetData(contactsComp,
             this->contactsEql) ?
@@ -3905,6 +5483,125 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
       });
 }
 
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateRayIntersections(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("PhysicsPrivate::UpdateRayIntersections");
+  if (!_ecm.HasComponentType(components::RaycastData::typeId))
+    return;
+
+  /// \brief A ray in the world frame and where to write its result.
+  struct WorldRay
+  {
+    math::Vector3d start;
+    math::Vector3d dir;
+    double length;
+    components::RaycastResultInfo *result;
+  };
+  std::vector<WorldRay> rays;
+  _ecm.Each<components::RaycastData>(
+      [&](const Entity &_entity, components::RaycastData *_raycast) -> bool
+      {
+        auto &data = _raycast->Data();
+        data.results.assign(data.rays.size(),
+            components::RaycastResultInfo());
+        if (data.rays.empty())
+          return true;
+
+        const math::Pose3d pose = worldPose(_entity, _ecm);
+        for (std::size_t i = 0; i < data.rays.size(); ++i)
+        {
+          WorldRay ray;
+          ray.start = pose.CoordPositionAdd(data.rays[i].start);
+          ray.dir = pose.CoordPositionAdd(data.rays[i].end) - ray.start;
+          ray.length = ray.dir.Length();
+          ray.result = &data.results[i];
+          if (ray.length > 0.0)
+          {
+            ray.dir /= ray.length;
+            rays.push_back(ray);
+          }
+        }
+        _ecm.SetChanged(_entity, components::RaycastData::typeId,
+            ComponentState::PeriodicChange);
+        return true;
+      });
+  if (rays.empty())
+    return;
+
+  if (!this->rayCaster)
+    this->rayCaster = CollisionRayCaster::Shared(_ecm);
+  this->rayCaster->Update(_info, _ecm);
+
+  // Rays of all entities are cast as one batch
+  auto &pool = ThreadPool::Shared();
+  constexpr std::size_t kMinGrainSize{64u};
+  pool.ParallelFor(rays.size(), pool.GrainSize(rays.size(), kMinGrainSize),
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const auto &ray = rays[i];
+          const double t = this->rayCaster->Cast(ray.start, ray.dir,
+              ray.length);
+          if (std::isfinite(t))
+          {
+            ray.result->point = ray.start + ray.dir * t;
+            ray.result->fraction = t / ray.length;
+          }
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+std::uint16_t PhysicsPrivate::CollisionGroupMask(const Entity _collision,
+    const std::uint16_t _bitmask, const EntityComponentManager &_ecm)
+{
+  // Bitmasks set in SDF take precedence over the groups
+  constexpr std::uint16_t kDefaultBitmask{0xFF};
+  if (!this->collisionGroups || _bitmask != kDefaultBitmask)
+    return _bitmask;
+
+  const Entity model = this->TopLevelModel(_collision, _ecm);
+  if (kNullEntity == model)
+    return _bitmask;
+
+  auto nameComp = _ecm.Component<components::Name>(model);
+  auto staticComp = _ecm.Component<components::Static>(model);
+  const auto color = this->collisionGroups->Color(model,
+      nameComp ? nameComp->Data() : std::string(),
+      staticComp && staticComp->Data());
+  this->collisionGroups->AddCollision(_collision, color);
+  return this->collisionGroups->Mask(color);
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::PublishCollisionGroupStatistics()
+{
+  if (!this->collisionGroupsPub || !this->collisionGroupsPub.HasConnections())
+    return;
+
+  GZ_PROFILE("PhysicsPrivate::PublishCollisionGroupStatistics");
+  msgs::Param msg;
+  auto &params = *msg.mutable_params();
+  // Pair counts grow quadratically, so they may not fit an int32
+  params["collision_pairs"].set_type(msgs::Any::DOUBLE);
+  params["collision_pairs"].set_double_value(
+      static_cast<double>(this->collisionGroups->TotalPairCount()));
+  params["filtered_pairs"].set_type(msgs::Any::DOUBLE);
+  params["filtered_pairs"].set_double_value(
+      static_cast<double>(this->collisionGroups->FilteredPairCount()));
+  for (std::size_t g = 0; g < this->collisionGroups->GroupCount(); ++g)
+  {
+    auto &count = params["collisions/" + this->collisionGroups->Name(g)];
+    count.set_type(msgs::Any::INT32);
+    count.set_int_value(
+        static_cast<int>(this->collisionGroups->CollisionCount(g)));
+  }
+  this->collisionGroupsPub.Publish(msg);
+}
+
 //////////////////////////////////////////////////
 physics::FrameData3d PhysicsPrivate::LinkFrameDataAtOffset(
       const LinkPtrType &_link, const math::Pose3d &_pose) const
@@ -3933,13 +5630,18 @@ void PhysicsPrivate::EnableContactSurfaceCustomization(const Entity &_world)
   using ContactPoint = GCFeatureWorld::ContactPoint;
   using ExtraContactData = GCFeature::ExtraContactDataT<Policy>;
 
+  // The callback runs for every contact point, so get the event once
+  auto *collectEvent =
+      &this->eventManager->Channel<events::CollectContactSurfaceProperties>();
+
   const auto callbackID = "gz::sim::systems::Physics";
   setContactPropertiesCallbackFeature->AddContactPropertiesCallback(
     callbackID,
-    [this, _world](const GCFeatureWorld::Contact &_contact,
+    [this, _world, collectEvent](const GCFeatureWorld::Contact &_contact,
       const size_t _numContactsOnCollision,
       Feature::ContactSurfaceParams<Policy> &_params)
       {
+        GZ_PROFILE("PhysicsPrivate::ContactPropertiesCallback");
         const auto &contact = _contact.Get<ContactPoint>();
         auto coll1Entity = this->entityCollisionMap.GetByPhysicsId(
           contact.collision1->EntityID());
@@ -3948,10 +5650,10 @@ void PhysicsPrivate::EnableContactSurfaceCustomization(const Entity &_world)
 
         // check if at least one of the entities wants contact surface
         // customization
-        if (this->customContactSurfaceEntities[_world].find(coll1Entity) ==
-          this->customContactSurfaceEntities[_world].end() &&
-          this->customContactSurfaceEntities[_world].find(coll2Entity) ==
-          this->customContactSurfaceEntities[_world].end())
+        const auto &customEntities =
+          this->customContactSurfaceEntities[_world];
+        if (customEntities.find(coll1Entity) == customEntities.end() &&
+          customEntities.find(coll2Entity) == customEntities.end())
         {
           return;
         }
@@ -3970,8 +5672,7 @@ void PhysicsPrivate::EnableContactSurfaceCustomization(const Entity &_world)
         // broadcast the event that we want to collect the customized
         // contact surface properties; each connected client should
         // filter in the callback to treat just the entities it knows
-        this->eventManager->
-          Emit<events::CollectContactSurfaceProperties>(
+        collectEvent->Signal(
             coll1Entity, coll2Entity, math::eigen3::convert(contact.point),
             force, normal, depth, _numContactsOnCollision, _params);
       }
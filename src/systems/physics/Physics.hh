@@ -65,11 +65,100 @@ namespace systems
   /// \class Physics Physics.hh gz/sim/systems/Physics.hh
   /// \brief Base class for a System.
   ///
+  /// Contacts of the last step are written to collisions that have a
+  /// `components::ContactSensorData` component, as messages, or a
+  /// `components::ContactBuffer` component, as flat arrays that are reused
+  /// every step. Systems that read contacts every step, such as the contact
+  /// sensor, should prefer the latter.
+  ///
+  /// Systems that need ray casts, such as for ground clearance or line of
+  /// sight, set the rays of a `components::RaycastData` component on any
+  /// entity, in the frame of that entity. After every step, the rays of all
+  /// entities are cast together on the shared thread pool against the
+  /// collisions at their new poses, and the closest hit of each ray is
+  /// written to the component's results. Boxes, spheres, cylinders,
+  /// capsules, ellipsoids, planes and meshes are hit, and rays that start
+  /// inside a collision don't hit it. The collisions are gathered once per
+  /// step for these queries, the CPU lidars and the CPU DVLs.
+  ///
   /// ## System Parameters
   ///
   /// - `<include_entity_names>`: Optional. When set
   /// to false, the name of colliding entities is not populated in
-  /// the contacts. Remains true by default.
+  /// the contacts of `ContactSensorData`. Remains true by default.
+  ///
+  /// - `<islands>`: Optional. Splits the world into islands that are
+  /// simulated by separate instances of the physics engine, so they can be
+  /// stepped concurrently. Each non-static top-level model is assigned to
+  /// the island with the fewest models, and models in different islands
+  /// don't interact physically. Static models are copied to every island.
+  /// Joints between models of different islands aren't supported.
+  ///   - `<count>`: Number of islands. Defaults to 1, which disables
+  ///   islands.
+  ///   - `<threads>`: Any number above zero steps the islands concurrently
+  ///   on the threads of the process-wide pool, whose size is set by the
+  ///   GZ_SIM_THREADS environment variable. Zero steps the islands
+  ///   sequentially. Defaults to one less than the number of islands.
+  ///
+  /// - `<creation>`: Optional. Controls how new entities are created in the
+  /// physics engine.
+  ///   - `<models_per_step>`: Maximum number of top-level models created on
+  ///   each step. Models spawned together beyond that are created on the
+  ///   following steps, in the order they were spawned, so spawning many
+  ///   models at once doesn't stall the simulation. Defaults to 0, which
+  ///   creates all models right away.
+  ///
+  /// - `<sleep>`: Optional. Puts links to sleep once they've been resting
+  /// for a number of steps, which adds the `Sleeping` component to them.
+  /// The engine still simulates sleeping links, but their poses and
+  /// velocities aren't written back to the ECM and the scene broadcaster
+  /// doesn't publish them as dynamic poses. A link wakes up, and its
+  /// `Sleeping` component is removed, when either of its speeds exceeds
+  /// the threshold, for example after a contact, or when a pose, velocity,
+  /// wrench or joint command is given to it or its model.
+  ///   - `<linear_threshold>`: Linear speed in m/s below which a link is
+  ///   resting. Defaults to 0.01.
+  ///   - `<angular_threshold>`: Angular speed in rad/s below which a link is
+  ///   resting. Defaults to 0.01.
+  ///   - `<steps>`: Number of consecutive resting steps after which a link
+  ///   falls asleep. Defaults to 100.
+  ///
+  /// - `<collision_groups>`: Optional. Assigns top-level models to groups
+  /// and sets collision filter bitmasks so that the engine's broadphase
+  /// skips pairs of groups that never collide. Models that match no group
+  /// are in the `default` group, which collides with all groups.
+  /// Collisions whose `<collide_bitmask>` isn't the default keep it. Models
+  /// of a group that doesn't collide with itself are spread over up to 16
+  /// bitmasks, and models that share a bitmask are still tested.
+  ///   - `<group name="...">`: A group, matched in order. Contains any
+  ///   number of `<model>` elements with prefixes of model names, and
+  ///   `<static>`, which adds all static models when true.
+  ///   - `<disable>`: Names of two groups, separated by a space, that don't
+  ///   collide. Both names are the same for a group that doesn't collide
+  ///   with itself.
+  ///   - `<statistics>`: When true, the number of collisions of each group,
+  ///   the number of pairs of collisions, and the number of those pairs
+  ///   that are filtered are published as a `gz::msgs::Param` on
+  ///   `/world/<world>/collision_groups/statistics` every iteration.
+  ///   Defaults to false.
+  ///
+  /// - `<substeps>`: Optional. Number of physics steps run per simulation
+  /// iteration, each advancing the world by the iteration's step size
+  /// divided by this number. This lets the physics engine use a small step,
+  /// for example for stiff contacts, while the other systems run at the
+  /// iteration rate. Joint force and velocity commands, link wrenches and
+  /// model and link velocity commands are held constant during the
+  /// iteration, and only the state after the last substep is written back.
+  /// Contacts are the ones of the last substep. Defaults to 1. The number
+  /// is kept in the world's `PhysicsSubsteps` component, which
+  /// `ServerConfig::SetPhysicsSubsteps` overrides, and which can be changed
+  /// at runtime.
+  ///
+  /// When the level manager sets the `ActivityLevel` of models, see the
+  /// `<activity>` element of the levels tutorial, the poses and velocities
+  /// of the links of a model at activity level N are only written back to
+  /// the ECM every 2^N iterations. The engine still simulates them on every
+  /// iteration.
   ///
   /// ## Example
   ///
@@ -80,6 +169,13 @@ namespace systems
   ///    <contacts>
   ///      <include_entity_names>false</include_entity_names>
   ///    </contacts>
+  ///    <islands>
+  ///      <count>4</count>
+  ///    </islands>
+  ///    <sleep>
+  ///      <steps>200</steps>
+  ///    </sleep>
+  ///    <substeps>10</substeps>
   ///  </plugin>
   ///  ```
 
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_PHYSICS_SLEEP_TRACKER_HH_
+#define GZ_SIM_SYSTEMS_PHYSICS_SLEEP_TRACKER_HH_
+
+#include <cstddef>
+#include <unordered_map>
+
+#include "gz/sim/Entity.hh"
+#include "gz/sim/config.hh"
+
+namespace gz::sim
+{
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems::physics_system
+{
+  /// \brief Helper class that tracks which links are resting, so that the
+  /// results of the physics step don't need to be written back for them.
+  ///
+  /// A link falls asleep once its linear and angular speeds have stayed
+  /// below the thresholds for a number of consecutive steps, and wakes up as
+  /// soon as either speed exceeds its threshold or it's woken up explicitly.
+  class SleepTracker
+  {
+    /// \brief Change of state of a link after an update.
+    public: enum class Transition
+    {
+      /// \brief The link didn't change state.
+      kNone,
+
+      /// \brief The link fell asleep.
+      kFellAsleep,
+
+      /// \brief The link woke up.
+      kWokeUp
+    };
+
+    /// \brief Constructor
+    /// \param[in] _linearThreshold Linear speed in m/s below which a link
+    /// is resting.
+    /// \param[in] _angularThreshold Angular speed in rad/s below which a
+    /// link is resting.
+    /// \param[in] _steps Number of consecutive resting steps after which a
+    /// link falls asleep, at least one.
+    public: SleepTracker(double _linearThreshold, double _angularThreshold,
+                std::size_t _steps)
+      : linearThreshold(_linearThreshold),
+        angularThreshold(_angularThreshold),
+        steps(_steps > 0u ? _steps : 1u)
+    {
+    }
+
+    /// \brief Update a link with its speeds after a physics step.
+    /// \param[in] _link The link entity.
+    /// \param[in] _linearSpeed Linear speed of the link in m/s.
+    /// \param[in] _angularSpeed Angular speed of the link in rad/s.
+    /// \return Change of state of the link.
+    public: Transition Update(const Entity _link, double _linearSpeed,
+                double _angularSpeed)
+    {
+      const bool resting = _linearSpeed < this->linearThreshold &&
+          _angularSpeed < this->angularThreshold;
+      if (!resting)
+      {
+        auto it = this->restingSteps.find(_link);
+        if (it == this->restingSteps.end())
+          return Transition::kNone;
+
+        const bool wasAsleep = it->second >= this->steps;
+        this->restingSteps.erase(it);
+        if (!wasAsleep)
+          return Transition::kNone;
+
+        --this->sleepingCount;
+        return Transition::kWokeUp;
+      }
+
+      auto &count = this->restingSteps[_link];
+      if (count >= this->steps)
+        return Transition::kNone;
+
+      if (++count < this->steps)
+        return Transition::kNone;
+
+      ++this->sleepingCount;
+      return Transition::kFellAsleep;
+    }
+
+    /// \brief Check whether a link is asleep.
+    /// \param[in] _link The link entity.
+    /// \return True if the link is asleep.
+    public: bool Asleep(const Entity _link) const
+    {
+      auto it = this->restingSteps.find(_link);
+      return it != this->restingSteps.end() && it->second >= this->steps;
+    }
+
+    /// \brief Wake a link up, so it needs to rest for the full number of
+    /// steps again before it falls asleep.
+    /// \param[in] _link The link entity.
+    /// \return True if the link was asleep.
+    public: bool Wake(const Entity _link)
+    {
+      auto it = this->restingSteps.find(_link);
+      if (it == this->restingSteps.end())
+        return false;
+
+      const bool wasAsleep = it->second >= this->steps;
+      this->restingSteps.erase(it);
+      if (wasAsleep)
+        --this->sleepingCount;
+      return wasAsleep;
+    }
+
+    /// \brief Stop tracking a link, for example because it was removed.
+    /// \param[in] _link The link entity.
+    public: void Remove(const Entity _link)
+    {
+      this->Wake(_link);
+    }
+
+    /// \brief Stop tracking all links.
+    public: void Clear()
+    {
+      this->restingSteps.clear();
+      this->sleepingCount = 0u;
+    }
+
+    /// \brief Get the number of links that are asleep.
+    /// \return Number of sleeping links.
+    public: std::size_t SleepingCount() const
+    {
+      return this->sleepingCount;
+    }
+
+    /// \brief Linear speed below which a link is resting.
+    private: double linearThreshold;
+
+    /// \brief Angular speed below which a link is resting.
+    private: double angularThreshold;
+
+    /// \brief Number of resting steps after which a link falls asleep.
+    private: std::size_t steps;
+
+    /// \brief Number of consecutive resting steps of each resting link.
+    /// Links at or above the step threshold are asleep.
+    private: std::unordered_map<Entity, std::size_t> restingSteps;
+
+    /// \brief Number of links that are asleep.
+    private: std::size_t sleepingCount{0u};
+  };
+}
+}
+}
+
+#endif
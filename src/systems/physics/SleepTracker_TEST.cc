@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "SleepTracker.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::physics_system;
+
+/////////////////////////////////////////////////
+TEST(SleepTracker, FallAsleepAndWakeUp)
+{
+  SleepTracker tracker(0.1, 0.2, 3);
+  EXPECT_EQ(0u, tracker.SleepingCount());
+  EXPECT_FALSE(tracker.Asleep(1));
+
+  // Resting for fewer steps than required
+  using Transition = SleepTracker::Transition;
+  EXPECT_EQ(Transition::kNone, tracker.Update(1, 0.05, 0.1));
+  EXPECT_EQ(Transition::kNone, tracker.Update(1, 0.05, 0.1));
+  EXPECT_FALSE(tracker.Asleep(1));
+
+  // Moving resets the count
+  EXPECT_EQ(Transition::kNone, tracker.Update(1, 0.05, 0.3));
+  EXPECT_EQ(Transition::kNone, tracker.Update(1, 0.05, 0.1));
+  EXPECT_EQ(Transition::kNone, tracker.Update(1, 0.05, 0.1));
+  EXPECT_FALSE(tracker.Asleep(1));
+  EXPECT_EQ(Transition::kFellAsleep, tracker.Update(1, 0.05, 0.1));
+  EXPECT_TRUE(tracker.Asleep(1));
+  EXPECT_EQ(1u, tracker.SleepingCount());
+
+  // Keeps sleeping while resting
+  EXPECT_EQ(Transition::kNone, tracker.Update(1, 0.0, 0.0));
+  EXPECT_TRUE(tracker.Asleep(1));
+
+  // Wakes up when moving
+  EXPECT_EQ(Transition::kWokeUp, tracker.Update(1, 0.5, 0.0));
+  EXPECT_FALSE(tracker.Asleep(1));
+  EXPECT_EQ(0u, tracker.SleepingCount());
+
+  // Links that never rested don't change state
+  EXPECT_EQ(Transition::kNone, tracker.Update(2, 1.0, 1.0));
+  EXPECT_FALSE(tracker.Asleep(2));
+}
+
+/////////////////////////////////////////////////
+TEST(SleepTracker, Wake)
+{
+  SleepTracker tracker(0.1, 0.1, 1);
+  EXPECT_EQ(SleepTracker::Transition::kFellAsleep, tracker.Update(1, 0, 0));
+  EXPECT_EQ(SleepTracker::Transition::kFellAsleep, tracker.Update(2, 0, 0));
+  EXPECT_EQ(2u, tracker.SleepingCount());
+
+  EXPECT_TRUE(tracker.Wake(1));
+  EXPECT_FALSE(tracker.Wake(1));
+  EXPECT_FALSE(tracker.Asleep(1));
+  EXPECT_EQ(1u, tracker.SleepingCount());
+
+  tracker.Remove(2);
+  EXPECT_EQ(0u, tracker.SleepingCount());
+
+  EXPECT_EQ(SleepTracker::Transition::kFellAsleep, tracker.Update(3, 0, 0));
+  tracker.Clear();
+  EXPECT_FALSE(tracker.Asleep(3));
+  EXPECT_EQ(0u, tracker.SleepingCount());
+}
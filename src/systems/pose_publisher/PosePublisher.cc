@@ -49,6 +49,7 @@
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/Visual.hh"
+#include "gz/sim/components/World.hh"
 #include "gz/sim/Conversions.hh"
 #include "gz/sim/Model.hh"
 
@@ -64,6 +65,18 @@ class gz::sim::systems::PosePublisherPrivate
   /// \param[in] _ecm Immutable reference to the entity component manager
   public: void InitializeEntitiesToPublish(const EntityComponentManager &_ecm);
 
+  /// \brief Track the models added to and removed from the world, when
+  /// attached to a world.
+  /// \param[in] _ecm Immutable reference to the entity component manager
+  public: void UpdateWorldModels(const EntityComponentManager &_ecm);
+
+  /// \brief Cache the message of an entity, whose frame names don't change.
+  /// \param[in] _entity Entity whose pose is published
+  /// \param[in] _frame Scoped name of its parent
+  /// \param[in] _childFrame Scoped name of the entity
+  public: void AddEntityToPublish(Entity _entity, const std::string &_frame,
+      const std::string &_childFrame);
+
   /// \brief Helper function to collect entity pose data
   /// \param[in] _ecm Immutable reference to the entity component manager
   /// \param[out] _poses Pose vector to be filled
@@ -78,10 +91,15 @@ class gz::sim::systems::PosePublisherPrivate
   /// \param[in] _poses Pose to publish
   /// \param[in] _stampMsg Time stamp associated with published poses
   /// \param[in] _publisher Publisher to publish the message
+  /// \param[in,out] _poseVMsg Vector message updated in place, if publishing
+  /// pose vectors
+  /// \param[in,out] _poseVEntities Entity of each pose of _poseVMsg
   public: void PublishPoses(
       std::vector<std::pair<Entity, math::Pose3d>> &_poses,
       const msgs::Time &_stampMsg,
-      transport::Node::Publisher &_publisher);
+      transport::Node::Publisher &_publisher,
+      msgs::Pose_V &_poseVMsg,
+      std::vector<Entity> &_poseVEntities);
 
   /// \brief Gazebo communication node.
   public: transport::Node node;
@@ -98,6 +116,13 @@ class gz::sim::systems::PosePublisherPrivate
   /// \brief Model interface
   public: Model model{kNullEntity};
 
+  /// \brief World entity, if attached to a world to publish the poses of
+  /// all its models.
+  public: Entity world{kNullEntity};
+
+  /// \brief Name of the world, if attached to a world.
+  public: std::string worldName;
+
   /// \brief True to publish link pose
   public: bool publishLinkPose = true;
 
@@ -155,16 +180,25 @@ class gz::sim::systems::PosePublisherPrivate
   /// improves performance by avoiding memory allocation
   public: std::vector<std::pair<Entity, math::Pose3d>> staticPoses;
 
-  /// \brief A variable that gets populated with poses. This also here as a
-  /// member variable to avoid repeated memory allocations and improve
-  /// performance.
-  public: msgs::Pose poseMsg;
+  /// \brief Message of each entity, whose header and name are set once so
+  /// that only the stamp and pose are updated before publishing.
+  public: std::unordered_map<Entity, msgs::Pose> poseMsgs;
 
   /// \brief A variable that gets populated with poses. This also here as a
   /// member variable to avoid repeated memory allocations and improve
   /// performance.
   public: msgs::Pose_V poseVMsg;
 
+  /// \brief Entity of each pose of poseVMsg, whose headers are only copied
+  /// when the entities change.
+  public: std::vector<Entity> poseVEntities;
+
+  /// \brief Like poseVMsg, for static poses.
+  public: msgs::Pose_V staticPoseVMsg;
+
+  /// \brief Entity of each pose of staticPoseVMsg.
+  public: std::vector<Entity> staticPoseVEntities;
+
   /// \brief True to publish a vector of poses. False to publish individual pose
   /// msgs.
   public: bool usePoseV = false;
@@ -187,7 +221,13 @@ void PosePublisher::Configure(const Entity &_entity,
 {
   this->dataPtr->model = Model(_entity);
 
-  if (!this->dataPtr->model.Valid(_ecm))
+  auto worldName = _ecm.Component<components::Name>(_entity);
+  if (_ecm.Component<components::World>(_entity) && worldName)
+  {
+    this->dataPtr->world = _entity;
+    this->dataPtr->worldName = worldName->Data();
+  }
+  else if (!this->dataPtr->model.Valid(_ecm))
   {
     gzerr << "PosePublisher plugin should be attached to a model entity. "
       << "Failed to initialize." << std::endl;
@@ -252,6 +292,13 @@ void PosePublisher::Configure(const Entity &_entity,
   this->dataPtr->usePoseV =
     _sdf->Get<bool>("use_pose_vector_msg", this->dataPtr->usePoseV).first;
 
+  // The poses of all models of a world are published together
+  if (this->dataPtr->world != kNullEntity)
+  {
+    this->dataPtr->usePoseV = true;
+    this->dataPtr->staticPosePublisher = false;
+  }
+
   std::string poseTopic = scopedName(_entity, _ecm) + "/pose";
   poseTopic = transport::TopicUtils::AsValidTopic(poseTopic);
   if (poseTopic.empty())
@@ -293,6 +340,10 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
 {
   GZ_PROFILE("PosePublisher::PostUpdate");
 
+  // Models are tracked at every step, as they're only new for one step
+  if (this->dataPtr->world != kNullEntity)
+    this->dataPtr->UpdateWorldModels(_ecm);
+
   // \TODO(anyone) Support rewind
   if (_info.dt < std::chrono::steady_clock::duration::zero())
   {
@@ -343,7 +394,8 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
       this->dataPtr->staticPoses.clear();
       this->dataPtr->FillPoses(_ecm, this->dataPtr->staticPoses, true);
       this->dataPtr->PublishPoses(this->dataPtr->staticPoses,
-          convert<msgs::Time>(_info.simTime), this->dataPtr->poseStaticPub);
+          convert<msgs::Time>(_info.simTime), this->dataPtr->poseStaticPub,
+          this->dataPtr->staticPoseVMsg, this->dataPtr->staticPoseVEntities);
       this->dataPtr->lastStaticPosePubTime = _info.simTime;
     }
 
@@ -352,7 +404,8 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
       this->dataPtr->poses.clear();
       this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, false);
       this->dataPtr->PublishPoses(this->dataPtr->poses,
-          convert<msgs::Time>(_info.simTime), this->dataPtr->posePub);
+          convert<msgs::Time>(_info.simTime), this->dataPtr->posePub,
+          this->dataPtr->poseVMsg, this->dataPtr->poseVEntities);
       this->dataPtr->lastPosePubTime = _info.simTime;
     }
   }
@@ -363,7 +416,8 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
     this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, true);
     this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, false);
     this->dataPtr->PublishPoses(this->dataPtr->poses,
-        convert<msgs::Time>(_info.simTime), this->dataPtr->posePub);
+        convert<msgs::Time>(_info.simTime), this->dataPtr->posePub,
+        this->dataPtr->poseVMsg, this->dataPtr->poseVEntities);
     this->dataPtr->lastPosePubTime = _info.simTime;
   }
 }
@@ -431,7 +485,7 @@ void PosePublisherPrivate::InitializeEntitiesToPublish(
               scopedName(parent->Data(), _ecm, "::", false), "::");
         }
       }
-      this->entitiesToPublish[entity] = std::make_pair(frame, childFrame);
+      this->AddEntityToPublish(entity, frame, childFrame);
     }
 
     // get dynamic entities
@@ -503,6 +557,63 @@ void PosePublisherPrivate::InitializeEntitiesToPublish(
   }
 }
 
+//////////////////////////////////////////////////
+void PosePublisherPrivate::UpdateWorldModels(
+    const EntityComponentManager &_ecm)
+{
+  auto addModel = [&](const Entity &_entity, const components::Model *,
+      const components::Name *_name,
+      const components::ParentEntity *_parent) -> bool
+  {
+    if (_parent->Data() == this->world)
+      this->AddEntityToPublish(_entity, this->worldName, _name->Data());
+    return true;
+  };
+
+  // Models which existed before the first update may not be new anymore
+  if (!this->initialized)
+  {
+    _ecm.Each<components::Model, components::Name,
+        components::ParentEntity>(addModel);
+    this->initialized = true;
+  }
+  else
+  {
+    _ecm.EachNew<components::Model, components::Name,
+        components::ParentEntity>(addModel);
+  }
+
+  _ecm.EachRemoved<components::Model>(
+      [&](const Entity &_entity, const components::Model *) -> bool
+      {
+        this->entitiesToPublish.erase(_entity);
+        this->poseMsgs.erase(_entity);
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+void PosePublisherPrivate::AddEntityToPublish(Entity _entity,
+    const std::string &_frame, const std::string &_childFrame)
+{
+  this->entitiesToPublish[_entity] = std::make_pair(_frame, _childFrame);
+
+  // fill pose msg
+  // frame_id: parent entity name
+  // child_frame_id = entity name
+  // pose is the transform from frame_id to child_frame_id
+  msgs::Pose &msg = this->poseMsgs[_entity];
+  msg.Clear();
+  auto header = msg.mutable_header();
+  auto frame = header->add_data();
+  frame->set_key("frame_id");
+  frame->add_value(_frame);
+  auto childFrame = header->add_data();
+  childFrame->set_key("child_frame_id");
+  childFrame->add_value(_childFrame);
+  msg.set_name(_childFrame);
+}
+
 //////////////////////////////////////////////////
 void PosePublisherPrivate::FillPoses(const EntityComponentManager &_ecm,
     std::vector<std::pair<Entity, math::Pose3d>> &_poses, bool _static)
@@ -527,61 +638,60 @@ void PosePublisherPrivate::FillPoses(const EntityComponentManager &_ecm,
 void PosePublisherPrivate::PublishPoses(
     std::vector<std::pair<Entity, math::Pose3d>> &_poses,
     const msgs::Time &_stampMsg,
-    transport::Node::Publisher &_publisher)
+    transport::Node::Publisher &_publisher,
+    msgs::Pose_V &_poseVMsg,
+    std::vector<Entity> &_poseVEntities)
 {
   GZ_PROFILE("PosePublisher::PublishPoses");
 
   // publish poses
-  msgs::Pose *msg = nullptr;
-  if (this->usePoseV)
-    this->poseVMsg.Clear();
-
+  int count = 0;
   for (const auto &[entity, pose] : _poses)
   {
-    auto entityIt = this->entitiesToPublish.find(entity);
-    if (entityIt == this->entitiesToPublish.end())
+    auto msgIt = this->poseMsgs.find(entity);
+    if (msgIt == this->poseMsgs.end())
       continue;
 
+    msgs::Pose *msg = &msgIt->second;
     if (this->usePoseV)
     {
-      msg = this->poseVMsg.add_pose();
-    }
-    else
-    {
-      this->poseMsg.Clear();
-      msg = &this->poseMsg;
+      // Reuse the poses of the previous message, whose headers only need to
+      // be copied if the entities changed
+      msg = count < _poseVMsg.pose_size() ? _poseVMsg.mutable_pose(count) :
+          _poseVMsg.add_pose();
+      const auto index = static_cast<std::size_t>(count);
+      if (index >= _poseVEntities.size())
+        _poseVEntities.resize(index + 1u, kNullEntity);
+      if (_poseVEntities[index] != entity)
+      {
+        msg->CopyFrom(msgIt->second);
+        _poseVEntities[index] = entity;
+      }
+      ++count;
     }
 
-    // fill pose msg
-    // frame_id: parent entity name
-    // child_frame_id = entity name
-    // pose is the transform from frame_id to child_frame_id
     GZ_ASSERT(msg != nullptr, "Pose msg is null");
-    auto header = msg->mutable_header();
-
-    header->mutable_stamp()->CopyFrom(_stampMsg);
-    const std::string &frameId = entityIt->second.first;
-    const std::string &childFrameId = entityIt->second.second;
-    const math::Pose3d &transform = pose;
-    auto frame = header->add_data();
-    frame->set_key("frame_id");
-    frame->add_value(frameId);
-    auto childFrame = header->add_data();
-    childFrame->set_key("child_frame_id");
-    childFrame->add_value(childFrameId);
+    msg->mutable_header()->mutable_stamp()->CopyFrom(_stampMsg);
 
     // set pose
-    msg->set_name(childFrameId);
-    msgs::Set(msg, transform);
+    msgs::Set(msg, pose);
 
     // publish individual pose msgs
     if (!this->usePoseV)
-      _publisher.Publish(this->poseMsg);
+      _publisher.Publish(*msg);
   }
 
   // publish pose vector msg
   if (this->usePoseV)
-    _publisher.Publish(this->poseVMsg);
+  {
+    if (count < _poseVMsg.pose_size())
+    {
+      _poseVMsg.mutable_pose()->DeleteSubrange(count,
+          _poseVMsg.pose_size() - count);
+      _poseVEntities.resize(static_cast<std::size_t>(count));
+    }
+    _publisher.Publish(_poseVMsg);
+  }
 }
 
 GZ_ADD_PLUGIN(PosePublisher,
@@ -58,6 +58,13 @@ namespace systems
   /// - `<static_update_frequency>`: Frequency of static pose publications in
   ///   Hz. A negative frequency publishes as fast as possible (i.e, at the
   ///   rate of the simulation step).
+  ///
+  /// When attached to a world, the poses of all its top level models,
+  /// including those spawned later, are published in a single
+  /// gz::msgs::Pose_V message on the "/world/<world_name>/pose" topic, at
+  /// `<update_frequency>`. The other parameters are ignored in that case.
+  /// Messages and frame names are built once per entity and updated in place
+  /// before each publication.
   class PosePublisher
       : public System,
         public ISystemConfigure,
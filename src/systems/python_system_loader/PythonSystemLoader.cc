@@ -41,6 +41,10 @@ using namespace systems;
 
 PythonSystemLoader::~PythonSystemLoader()
 {
+  if (Py_IsInitialized() == 0)
+    return;
+
+  py::gil_scoped_acquire gil;
   if (this->pythonSystem)
   {
     if (py::hasattr(this->pythonSystem, "shutdown"))
@@ -48,6 +52,14 @@ PythonSystemLoader::~PythonSystemLoader()
       this->pythonSystem.attr("shutdown")();
     }
   }
+
+  // Release the Python objects while holding the GIL
+  this->preUpdateMethod = py::object();
+  this->updateMethod = py::object();
+  this->postUpdateMethod = py::object();
+  this->resetMethod = py::object();
+  this->pythonSystem = py::object();
+  this->pythonModule = py::module_();
 }
 
 void PythonSystemLoader::Configure(
@@ -62,6 +74,8 @@ void PythonSystemLoader::Configure(
     return;
   }
 
+  py::gil_scoped_acquire gil;
+
   // Load the `gz.sim` and sdformat modules to register all pybind bindings
   // necessary for System interface functions
   const auto gzSimModule =
@@ -168,7 +182,8 @@ void PythonSystemLoader::Configure(
 
 //////////////////////////////////////////////////
 template <typename... Args>
-void PythonSystemLoader::CallPythonMethod(py::object _method, Args &&..._args)
+void PythonSystemLoader::CallPythonMethod(const py::object &_method,
+                                          Args &&..._args)
 {
   if (!this->validConfig)
   {
@@ -177,6 +192,9 @@ void PythonSystemLoader::CallPythonMethod(py::object _method, Args &&..._args)
 
   if (_method)
   {
+    // The simulation runner doesn't hold the GIL while it updates systems,
+    // so it's only locked while Python code runs.
+    py::gil_scoped_acquire gil;
     try
     {
       _method(std::forward<Args>(_args)...);
@@ -208,7 +226,6 @@ void PythonSystemLoader::Update(const UpdateInfo &_info,
 void PythonSystemLoader::PostUpdate(const UpdateInfo &_info,
                                     const EntityComponentManager &_ecm)
 {
-  py::gil_scoped_acquire gil;
   CallPythonMethod(this->postUpdateMethod, _info, &_ecm);
 }
 //////////////////////////////////////////////////
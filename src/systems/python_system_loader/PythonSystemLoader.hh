@@ -55,6 +55,12 @@ namespace systems
 /// check if the corresponding method is implemented in the Python system and
 /// skip it if it's not found.
 ///
+/// The simulation runner doesn't hold the Python GIL while it updates
+/// systems. The GIL is only locked while the Python system runs, so that C++
+/// systems run concurrently with Python code from other threads, and
+/// `post_update` runs in the PostUpdate thread pool like the PostUpdate of
+/// other systems.
+///
 /// See `examples/scripts/python_api/systems/test_system.py` for an example
 ///
 /// ## System Parameters
@@ -99,7 +105,7 @@ class GZ_SIM_PYTHON_SYSTEM_LOADER_SYSTEM_HIDDEN PythonSystemLoader final
   /// \brief Function that calls each of the python equivalents of Configure,
   /// PreUpdate, etc.
   private: template <typename ...Args>
-  void CallPythonMethod(pybind11::object _method, Args&&...);
+  void CallPythonMethod(const pybind11::object &_method, Args&&...);
 
   /// \brief Whether we have a valid configuration after Configure has run. This
   /// includes checking if the Python module is found and that the system is
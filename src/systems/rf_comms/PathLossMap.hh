@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_RF_COMMS_PATHLOSSMAP_HH_
+#define GZ_SIM_SYSTEMS_RF_COMMS_PATHLOSSMAP_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace rf_comms
+{
+/// \brief Path loss caused by the static obstacles of a world, precomputed
+/// between every pair of cells of a regular 3D grid.
+///
+/// The loss between two positions is the one between the cells that contain
+/// them, so looking it up takes constant time. Positions outside of the grid
+/// use the closest cell.
+///
+/// Maps are stored in binary files made of the 8 byte magic "GZRFPLM1", the
+/// minimum corner of the grid and the cell size as 4 doubles, the number of
+/// cells along each axis as 3 unsigned 64 bit integers, and the losses in dB
+/// as a float for each pair of cells, all in the byte order of the host. The
+/// loss from cell i to cell j is at i * count + j, where cells are numbered
+/// with x varying fastest.
+class PathLossMap
+{
+  /// \brief Set the grid and its losses.
+  /// \param[in] _min Minimum corner of the grid.
+  /// \param[in] _cellSize Size of the cubic cells.
+  /// \param[in] _cells Number of cells along each axis.
+  /// \param[in] _losses Loss in dB for each pair of cells.
+  /// \param[out] _error Reason the map was rejected.
+  /// \return True if the map is valid. Otherwise it's left empty.
+  public: bool Set(const math::Vector3d &_min, double _cellSize,
+                   const std::array<std::size_t, 3> &_cells,
+                   std::vector<float> _losses, std::string &_error)
+  {
+    this->losses.clear();
+    this->count = 0u;
+    if (!(_cellSize > 0.0))
+    {
+      _error = "the cell size must be positive";
+      return false;
+    }
+    const std::size_t cellCount = _cells[0] * _cells[1] * _cells[2];
+    if (cellCount == 0u)
+    {
+      _error = "the grid must have at least one cell";
+      return false;
+    }
+    if (_losses.size() != cellCount * cellCount)
+    {
+      _error = "expected " + std::to_string(cellCount * cellCount) +
+          " losses, got " + std::to_string(_losses.size());
+      return false;
+    }
+
+    this->min = _min;
+    this->cellSize = _cellSize;
+    this->inverseCellSize = 1.0 / _cellSize;
+    this->cells = _cells;
+    this->count = cellCount;
+    this->losses = std::move(_losses);
+    return true;
+  }
+
+  /// \brief Compute the losses between the centers of every pair of cells.
+  /// The loss function is evaluated once per unordered pair, as losses are
+  /// assumed to be symmetric.
+  /// \param[in] _min Minimum corner of the grid.
+  /// \param[in] _cellSize Size of the cubic cells.
+  /// \param[in] _cells Number of cells along each axis.
+  /// \param[in] _loss Loss in dB between two positions.
+  /// \param[out] _error Reason the map was rejected.
+  /// \return True if the map is valid.
+  public: bool Generate(const math::Vector3d &_min, double _cellSize,
+      const std::array<std::size_t, 3> &_cells,
+      const std::function<double(const math::Vector3d &,
+                                 const math::Vector3d &)> &_loss,
+      std::string &_error)
+  {
+    const std::size_t cellCount = _cells[0] * _cells[1] * _cells[2];
+    std::vector<float> values(cellCount * cellCount, 0.0f);
+    if (!this->Set(_min, _cellSize, _cells, std::move(values), _error))
+      return false;
+
+    for (std::size_t i = 0u; i < cellCount; ++i)
+    {
+      const auto from = this->CellCenter(i);
+      for (std::size_t j = i; j < cellCount; ++j)
+      {
+        const auto loss = static_cast<float>(_loss(from, this->CellCenter(j)));
+        this->losses[i * cellCount + j] = loss;
+        this->losses[j * cellCount + i] = loss;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Load a map from a file.
+  /// \param[in] _path Path to the file.
+  /// \param[out] _error Reason the file couldn't be loaded.
+  /// \return True if the map was loaded. Otherwise it's left empty.
+  public: bool Load(const std::string &_path, std::string &_error)
+  {
+    this->losses.clear();
+    this->count = 0u;
+
+    std::ifstream file(_path, std::ios::binary);
+    if (!file)
+    {
+      _error = "unable to open [" + _path + "]";
+      return false;
+    }
+
+    char magic[8];
+    double header[4];
+    uint64_t cellCounts[3];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(header), sizeof(header));
+    file.read(reinterpret_cast<char *>(cellCounts), sizeof(cellCounts));
+    if (!file || std::memcmp(magic, kMagic, sizeof(magic)) != 0)
+    {
+      _error = "[" + _path + "] isn't a path loss map";
+      return false;
+    }
+
+    const std::array<std::size_t, 3> gridCells{
+        static_cast<std::size_t>(cellCounts[0]),
+        static_cast<std::size_t>(cellCounts[1]),
+        static_cast<std::size_t>(cellCounts[2])};
+    const std::size_t cellCount = gridCells[0] * gridCells[1] * gridCells[2];
+
+    // Check the size before allocating, in case the header is corrupt
+    const auto dataStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    const auto dataSize = static_cast<std::size_t>(file.tellg() - dataStart);
+    file.seekg(dataStart);
+    if (cellCount == 0u || dataSize / sizeof(float) / cellCount != cellCount)
+    {
+      _error = "[" + _path + "] doesn't hold the losses of its grid";
+      return false;
+    }
+
+    std::vector<float> values(cellCount * cellCount);
+    file.read(reinterpret_cast<char *>(values.data()),
+        static_cast<std::streamsize>(values.size() * sizeof(float)));
+    if (!file)
+    {
+      _error = "[" + _path + "] is truncated";
+      return false;
+    }
+
+    return this->Set(math::Vector3d(header[0], header[1], header[2]),
+        header[3], gridCells, std::move(values), _error);
+  }
+
+  /// \brief Save the map to a file.
+  /// \param[in] _path Path to the file.
+  /// \param[out] _error Reason the file couldn't be written.
+  /// \return True if the map was saved.
+  public: bool Save(const std::string &_path, std::string &_error) const
+  {
+    std::ofstream file(_path, std::ios::binary);
+    if (!file)
+    {
+      _error = "unable to open [" + _path + "] for writing";
+      return false;
+    }
+
+    const double header[4]{this->min.X(), this->min.Y(), this->min.Z(),
+        this->cellSize};
+    const uint64_t cellCounts[3]{this->cells[0], this->cells[1],
+        this->cells[2]};
+    file.write(kMagic, 8);
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(cellCounts),
+        sizeof(cellCounts));
+    file.write(reinterpret_cast<const char *>(this->losses.data()),
+        static_cast<std::streamsize>(this->losses.size() * sizeof(float)));
+    if (!file)
+    {
+      _error = "unable to write [" + _path + "]";
+      return false;
+    }
+    return true;
+  }
+
+  /// \brief Check whether the map has been set.
+  /// \return True if it's empty.
+  public: bool Empty() const
+  {
+    return this->losses.empty();
+  }
+
+  /// \brief Get the number of cells.
+  /// \return Number of cells.
+  public: std::size_t CellCount() const
+  {
+    return this->count;
+  }
+
+  /// \brief Get the center of a cell.
+  /// \param[in] _cell Index of the cell, with x varying fastest.
+  /// \return Position of its center.
+  public: math::Vector3d CellCenter(std::size_t _cell) const
+  {
+    const std::size_t x = _cell % this->cells[0];
+    const std::size_t y = (_cell / this->cells[0]) % this->cells[1];
+    const std::size_t z = _cell / (this->cells[0] * this->cells[1]);
+    return this->min + math::Vector3d(
+        (static_cast<double>(x) + 0.5) * this->cellSize,
+        (static_cast<double>(y) + 0.5) * this->cellSize,
+        (static_cast<double>(z) + 0.5) * this->cellSize);
+  }
+
+  /// \brief Get the loss between two positions.
+  /// \param[in] _from Position of the transmitter.
+  /// \param[in] _to Position of the receiver.
+  /// \return Loss in dB, 0 if the map is empty.
+  public: double Loss(const math::Vector3d &_from,
+                      const math::Vector3d &_to) const
+  {
+    if (this->losses.empty())
+      return 0.0;
+    return this->losses[this->Cell(_from) * this->count + this->Cell(_to)];
+  }
+
+  /// \brief Get the cell which contains a position, or the closest one.
+  /// \param[in] _pos The position.
+  /// \return Index of the cell.
+  private: std::size_t Cell(const math::Vector3d &_pos) const
+  {
+    std::size_t index[3];
+    for (std::size_t k = 0u; k < 3u; ++k)
+    {
+      const double offset = (_pos[k] - this->min[k]) * this->inverseCellSize;
+      const double last = static_cast<double>(this->cells[k] - 1u);
+      index[k] = static_cast<std::size_t>(std::clamp(offset, 0.0, last));
+    }
+    return index[0] + this->cells[0] * (index[1] + this->cells[1] * index[2]);
+  }
+
+  /// \brief Magic bytes at the start of map files.
+  private: static constexpr const char kMagic[9] = "GZRFPLM1";
+
+  /// \brief Minimum corner of the grid.
+  private: math::Vector3d min;
+
+  /// \brief Size of the cells.
+  private: double cellSize{1.0};
+
+  /// \brief Inverse of the size of the cells.
+  private: double inverseCellSize{1.0};
+
+  /// \brief Number of cells along each axis.
+  private: std::array<std::size_t, 3> cells{{0u, 0u, 0u}};
+
+  /// \brief Total number of cells.
+  private: std::size_t count{0u};
+
+  /// \brief Loss in dB for each pair of cells.
+  private: std::vector<float> losses;
+};
+}
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "PathLossMap.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::rf_comms;
+
+/////////////////////////////////////////////////
+/// \brief Loss of a wall at x = 2, crossed by the segments between cells on
+/// both of its sides.
+/// \param[in] _from Start of the segment.
+/// \param[in] _to End of the segment.
+/// \return Loss in dB.
+double wall(const math::Vector3d &_from, const math::Vector3d &_to)
+{
+  return (_from.X() < 2.0) != (_to.X() < 2.0) ? 20.0 : 0.0;
+}
+
+/////////////////////////////////////////////////
+TEST(PathLossMap, Invalid)
+{
+  PathLossMap map;
+  std::string error;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_DOUBLE_EQ(0.0, map.Loss(math::Vector3d::Zero, math::Vector3d::Zero));
+
+  EXPECT_FALSE(map.Set(math::Vector3d::Zero, 0.0, {1u, 1u, 1u}, {0.0f},
+      error));
+  EXPECT_FALSE(map.Set(math::Vector3d::Zero, 1.0, {2u, 1u, 1u}, {0.0f},
+      error));
+  EXPECT_FALSE(error.empty());
+  EXPECT_TRUE(map.Empty());
+  EXPECT_FALSE(map.Load("/nonexistent/path_loss_map.bin", error));
+}
+
+/////////////////////////////////////////////////
+TEST(PathLossMap, Lookup)
+{
+  PathLossMap map;
+  std::string error;
+  ASSERT_TRUE(map.Generate(math::Vector3d(0, 0, -1), 1.0, {4u, 2u, 1u}, wall,
+      error)) << error;
+  EXPECT_EQ(8u, map.CellCount());
+
+  const math::Vector3d center = map.CellCenter(5u);
+  EXPECT_DOUBLE_EQ(1.5, center.X());
+  EXPECT_DOUBLE_EQ(1.5, center.Y());
+  EXPECT_DOUBLE_EQ(-0.5, center.Z());
+
+  // Positions on the same side of the wall, or across it
+  EXPECT_DOUBLE_EQ(0.0, map.Loss({0.2, 0.2, -0.5}, {1.9, 1.7, -0.1}));
+  EXPECT_DOUBLE_EQ(20.0, map.Loss({0.2, 0.2, -0.5}, {2.1, 1.7, -0.1}));
+  EXPECT_DOUBLE_EQ(20.0, map.Loss({3.5, 0.5, -0.5}, {0.5, 0.5, -0.5}));
+
+  // Positions outside of the grid use the closest cell
+  EXPECT_DOUBLE_EQ(20.0, map.Loss({-10, 0.5, 5}, {100, 0.5, -5}));
+  EXPECT_DOUBLE_EQ(0.0, map.Loss({10, -3, 0}, {2.5, 5, 0}));
+}
+
+/////////////////////////////////////////////////
+TEST(PathLossMap, SaveLoad)
+{
+  PathLossMap map;
+  std::string error;
+  ASSERT_TRUE(map.Generate(math::Vector3d(-1, -1, 0), 0.5, {8u, 1u, 2u},
+      wall, error)) << error;
+
+  const std::string path = testing::TempDir() + "path_loss_map.bin";
+  ASSERT_TRUE(map.Save(path, error)) << error;
+
+  PathLossMap loaded;
+  ASSERT_TRUE(loaded.Load(path, error)) << error;
+  EXPECT_EQ(map.CellCount(), loaded.CellCount());
+  for (std::size_t i = 0u; i < map.CellCount(); ++i)
+  {
+    for (std::size_t j = 0u; j < map.CellCount(); ++j)
+    {
+      EXPECT_DOUBLE_EQ(map.Loss(map.CellCenter(i), map.CellCenter(j)),
+          loaded.Loss(map.CellCenter(i), map.CellCenter(j)));
+    }
+  }
+
+  // Files which aren't maps
+  {
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    std::fputs("not a map", file);
+    std::fclose(file);
+  }
+  EXPECT_FALSE(loaded.Load(path, error));
+  EXPECT_TRUE(loaded.Empty());
+  std::remove(path.c_str());
+}
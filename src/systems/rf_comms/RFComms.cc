@@ -17,6 +17,7 @@
 
 #include <gz/msgs/dataframe.pb.h>
 
+#include <cmath>
 #include <limits>
 #include <list>
 #include <random>
@@ -35,6 +36,7 @@
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
+#include "PathLossMap.hh"
 #include "RFComms.hh"
 
 using namespace gz;
@@ -56,6 +58,10 @@ struct RangeConfiguration
   /// \brief Standard deviation for received power.
   double sigma = 10;
 
+  /// \brief Path to the map of the losses caused by static obstacles, or
+  /// empty.
+  std::string pathLossMap;
+
   /// Output stream operator.
   /// \param[out] _oss Stream.
   /// \param[in] _config configuration to output.
@@ -67,6 +73,8 @@ struct RangeConfiguration
          << "-- fading_exponent: " << _config.fadingExponent << std::endl
          << "-- l0: " << _config.l0 << std::endl
          << "-- sigma: " << _config.sigma << std::endl;
+    if (!_config.pathLossMap.empty())
+      _oss << "-- path_loss_map: " << _config.pathLossMap << std::endl;
 
     return _oss;
   }
@@ -198,6 +206,9 @@ class gz::sim::systems::RFComms::Implementation
   /// \brief Radio configuration.
   public: RadioConfiguration radioConfig;
 
+  /// \brief Losses caused by the static obstacles of the world.
+  public: rf_comms::PathLossMap pathLossMap;
+
   /// \brief A map where the key is the address and the value its radio state.
   public: std::unordered_map<std::string, RadioState> radioStates;
 
@@ -229,13 +240,19 @@ RFPower RFComms::Implementation::LogNormalReceivedPower(
   const double &_txPower, const RadioState &_txState,
   const RadioState &_rxState) const
 {
-  const double kRange = _txState.pose.Pos().Distance(_rxState.pose.Pos());
-
-  if (this->rangeConfig.maxRange > 0.0 && kRange > this->rangeConfig.maxRange)
+  // Cull receivers out of range before evaluating the model
+  const double kRangeSquared =
+    (_txState.pose.Pos() - _rxState.pose.Pos()).SquaredLength();
+  const double kMaxRange = this->rangeConfig.maxRange;
+  if (kMaxRange > 0.0 && kRangeSquared > kMaxRange * kMaxRange)
     return {-std::numeric_limits<double>::infinity(), 0.0};
 
+  const double kRange = std::sqrt(kRangeSquared);
+
+  // Obstacles between the nodes, precomputed for the static world.
   const double kPL = this->rangeConfig.l0 +
-    10 * this->rangeConfig.fadingExponent * log10(kRange);
+    10 * this->rangeConfig.fadingExponent * log10(kRange) +
+    this->pathLossMap.Loss(_txState.pose.Pos(), _rxState.pose.Pos());
 
   return {_txPower - kPL, pow(this->rangeConfig.sigma, 2.)};
 }
@@ -281,6 +298,10 @@ std::tuple<bool, double> RFComms::Implementation::AttemptSend(
   auto rxPowerDist =
     this->LogNormalReceivedPower(this->radioConfig.txPower, _txState, _rxState);
 
+  // The receiver is out of range, and can't get the packet.
+  if (std::isinf(rxPowerDist.mean))
+    return std::make_tuple(false, std::numeric_limits<double>::lowest());
+
   double rxPower = rxPowerDist.mean;
   if (rxPowerDist.variance > 0.0)
   {
@@ -370,6 +391,19 @@ void RFComms::Load(const Entity &/*_entity*/,
 
     this->dataPtr->rangeConfig.sigma =
       elem->Get<double>("sigma", this->dataPtr->rangeConfig.sigma).first;
+
+    if (elem->HasElement("path_loss_map"))
+    {
+      this->dataPtr->rangeConfig.pathLossMap = asFullPath(
+        elem->Get<std::string>("path_loss_map"), _sdf->FilePath());
+      std::string error;
+      if (!this->dataPtr->pathLossMap.Load(
+          this->dataPtr->rangeConfig.pathLossMap, error))
+      {
+        gzerr << "Failed to load <path_loss_map>: " << error
+              << ". Obstacles will be ignored." << std::endl;
+      }
+    }
   }
 
   if (_sdf->HasElement("radio_config"))
@@ -405,6 +439,10 @@ void RFComms::Step(
       comms::Registry &_newRegistry,
       EntityComponentManager &_ecm)
 {
+  GZ_PROFILE("RFComms::Step");
+
+  const double kNow = std::chrono::duration<double>(_info.simTime).count();
+
   // Update ratio states.
   for (auto & [address, content] : _currentRegistry)
   {
@@ -426,11 +464,11 @@ void RFComms::Step(
     else
     {
       // Update radio state.
-      const auto kPose = sim::worldPose(content.entity, _ecm);
-      this->dataPtr->radioStates[address].pose = kPose;
-      this->dataPtr->radioStates[address].timeStamp =
-        std::chrono::duration<double>(_info.simTime).count();
-      this->dataPtr->radioStates[address].name = content.modelName;
+      auto &state = this->dataPtr->radioStates[address];
+      state.pose = sim::worldPose(content.entity, _ecm);
+      state.timeStamp = kNow;
+      if (state.name != content.modelName)
+        state.name = content.modelName;
     }
   }
 
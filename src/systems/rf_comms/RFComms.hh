@@ -55,6 +55,13 @@ namespace systems
   ///             Default is 40.
   ///   - `<sigma>`: Standard deviation of the normal distribution.
   ///                Default is 10.
+  ///   - `<path_loss_map>`: Path to a map of the losses caused by the static
+  ///                        obstacles of the world, which are added to the
+  ///                        log-distance path loss. The loss between two
+  ///                        radios is looked up in constant time between the
+  ///                        cells of a 3D grid that contain them. Maps are
+  ///                        generated with gz-sim-rf-path-loss-map.
+  ///                        Not used by default.
   ///
   /// - `<radio_config>`: Element used to capture the radio configuration.
   ///                     This block can contain any of the
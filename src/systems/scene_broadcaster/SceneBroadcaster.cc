@@ -16,6 +16,8 @@
 */
 
 #include "SceneBroadcaster.hh"
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/bytes.pb.h>
 
 #include <gz/msgs/camerasensor.pb.h>
 #include <gz/msgs/distortion.pb.h>
@@ -26,6 +28,7 @@
 #include <gz/msgs/link.pb.h>
 #include <gz/msgs/material.pb.h>
 #include <gz/msgs/model.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/particle_emitter.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/projector.pb.h>
@@ -36,6 +39,7 @@
 #include <gz/msgs/stringmsg.pb.h>
 #include <gz/msgs/uint32_v.pb.h>
 #include <gz/msgs/visual.pb.h>
+#include <gz/msgs/Utility.hh>
 
 #include <algorithm>
 #include <chrono>
@@ -46,6 +50,7 @@
 #include <unordered_set>
 
 #include <gz/common/Profiler.hh>
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/graph/Graph.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
@@ -54,6 +59,7 @@
 #include "gz/sim/components/AirSpeedSensor.hh"
 #include "gz/sim/components/Altimeter.hh"
 #include "gz/sim/components/Camera.hh"
+#include "gz/sim/components/CanonicalLink.hh"
 #include "gz/sim/components/CastShadows.hh"
 #include "gz/sim/components/ContactSensor.hh"
 #include "gz/sim/components/DepthCamera.hh"
@@ -71,18 +77,22 @@
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/ParticleEmitter.hh"
+#include "gz/sim/components/Performer.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Projector.hh"
 #include "gz/sim/components/RgbdCamera.hh"
 #include "gz/sim/components/Scene.hh"
 #include "gz/sim/components/Sensor.hh"
+#include "gz/sim/components/Sleeping.hh"
 #include "gz/sim/components/Static.hh"
 #include "gz/sim/components/ThermalCamera.hh"
 #include "gz/sim/components/Visual.hh"
 #include "gz/sim/components/World.hh"
 #include "gz/sim/Conversions.hh"
 #include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Util.hh"
 
+#include <sdf/Box.hh>
 #include <sdf/Camera.hh>
 #include <sdf/Imu.hh>
 #include <sdf/Lidar.hh>
@@ -90,12 +100,52 @@
 #include <sdf/Scene.hh>
 #include <sdf/Sensor.hh>
 
+#include "../../CompactPoses.hh"
+#include "../../CompactState.hh"
+#include "../../StateMerge.hh"
+
 using namespace std::chrono_literals;
 
 using namespace gz;
 using namespace sim;
 using namespace systems;
 
+/// \brief A subscriber-scoped stream, which only carries the entities of a
+/// model and, optionally, of the models around it.
+struct Interest
+{
+  /// \brief Name of the top level model of interest.
+  std::string modelName;
+
+  /// \brief The model, or kNullEntity while it doesn't exist.
+  Entity model{kNullEntity};
+
+  /// \brief Size of the box centered on the model whose models are also
+  /// included, like a performer's geometry. Zero to only include the model.
+  math::Vector3d size{math::Vector3d::Zero};
+
+  /// \brief False to use the box of the model's performer, if it has one.
+  bool explicitSize{false};
+
+  /// \brief Pose publisher.
+  transport::Node::Publisher posePub;
+
+  /// \brief State publisher.
+  transport::Node::Publisher statePub;
+
+  /// \brief Entities in the latest state message.
+  std::unordered_set<Entity> entities;
+
+  /// \brief Last time the poses were published.
+  std::chrono::time_point<std::chrono::system_clock> lastPosePubTime;
+
+  /// \brief Last time the state was published.
+  std::chrono::time_point<std::chrono::system_clock> lastStatePubTime;
+
+  /// \brief State message, reused across updates.
+  msgs::SerializedStepMap stepMsg;
+};
+
 // Private data class.
 class gz::sim::systems::SceneBroadcasterPrivate
 {
@@ -126,6 +176,36 @@ class gz::sim::systems::SceneBroadcasterPrivate
   /// \param[out] _res Response containing the last available full state.
   public: void StateAsyncService(const msgs::StringMsg &_req);
 
+  /// \brief Callback for the service that adds a stream scoped to a model.
+  /// \param[in] _req Name of the model in the "model" parameter and, to
+  /// also include the models around it, the size of the box centered on it
+  /// in "size".
+  /// \param[out] _res Namespace of the stream's topics.
+  /// \return True if successful.
+  public: bool InterestAddService(const msgs::Param &_req,
+      msgs::StringMsg &_res);
+
+  /// \brief Callback for the service that removes a scoped stream.
+  /// \param[in] _req Namespace returned when the stream was added.
+  /// \param[out] _res True if the stream existed.
+  /// \return True if successful.
+  public: bool InterestRemoveService(const msgs::StringMsg &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Replace the scene snapshot with a copy of the latest scene
+  /// graph and scene properties.
+  public: void UpdateSceneSnapshot();
+
+  /// \brief Keep the state snapshot up to date after the state message was
+  /// filled.
+  /// \param[in] _full True if the message holds the full state.
+  /// \param[in] _published True if the message is being published.
+  public: void UpdateStateSnapshot(bool _full, bool _published);
+
+  /// \brief Drop the state snapshot, so that the next request takes the
+  /// full state from the simulation.
+  public: void ResetStateSnapshot();
+
   /// \brief Updates the scene graph when entities are added
   /// \param[in] _manager The entity component manager
   public: void SceneGraphAddEntities(const EntityComponentManager &_manager);
@@ -209,6 +289,29 @@ class gz::sim::systems::SceneBroadcasterPrivate
   public: void PoseUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_manager);
 
+  /// \brief Create and send out a compact pose frame with the poses of
+  /// non-static models and links.
+  /// \param[in] _info The update information
+  /// \param[in] _manager The entity component manager
+  public: void CompactPoseUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager);
+
+  /// \brief Publish the poses and state of the scoped streams that are
+  /// due.
+  /// \param[in] _info The update information
+  /// \param[in] _manager The entity component manager
+  /// \param[in] _changeEvent True if entities or components were added or
+  /// removed.
+  public: void InterestUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager, bool _changeEvent);
+
+  /// \brief Get the entities a scoped stream carries.
+  /// \param[in] _interest The stream.
+  /// \param[in] _manager The entity component manager
+  /// \return The model's descendants and those of the models in its box.
+  public: std::unordered_set<Entity> InterestEntities(Interest &_interest,
+    const EntityComponentManager &_manager) const;
+
   /// \brief Transport node.
   public: std::unique_ptr<transport::Node> node{nullptr};
 
@@ -221,6 +324,33 @@ class gz::sim::systems::SceneBroadcasterPrivate
   /// \brief Rate at which to publish dynamic poses
   public: int dyPoseHertz{60};
 
+  /// \brief True to publish the compact pose stream.
+  public: bool compactPoses{false};
+
+  /// \brief Compact pose stream publisher.
+  public: transport::Node::Publisher compactPub;
+
+  /// \brief Encodes the compact pose stream.
+  public: CompactPoseEncoder compactEncoder;
+
+  /// \brief Sim time of the latest compact pose frame.
+  public: std::chrono::steady_clock::duration lastCompactTime{-1};
+
+  /// \brief Compact pose frame, reused across frames.
+  public: msgs::Bytes compactMsg;
+
+  /// \brief True to publish the compact state stream.
+  public: bool compactState{false};
+
+  /// \brief Compact state stream publisher.
+  public: transport::Node::Publisher compactStatePub;
+
+  /// \brief Encodes the compact state stream.
+  public: CompactStateEncoder compactStateEncoder;
+
+  /// \brief Compact state frame, reused across frames.
+  public: msgs::Bytes compactStateMsg;
+
   /// \brief Scene publisher
   public: transport::Node::Publisher scenePub;
 
@@ -246,7 +376,26 @@ class gz::sim::systems::SceneBroadcasterPrivate
   /// scene graphs
   public: std::string worldName;
 
-  /// \brief Protects scene graph.
+  /// \brief Immutable copy of the scene graph and its properties, so the
+  /// scene services never wait on the simulation.
+  public: struct SceneSnapshot
+  {
+    /// \brief Scene graph. Its messages are shared with sceneGraph, which
+    /// never modifies them once they're added.
+    SceneGraphType graph;
+
+    /// \brief Scene properties.
+    sdf::Scene sdfScene;
+  };
+
+  /// \brief Latest scene snapshot, replaced whenever the scene changes.
+  public: std::shared_ptr<const SceneSnapshot> sceneSnapshot;
+
+  /// \brief True if the scene changed since the latest snapshot.
+  public: bool sceneSnapshotDirty{true};
+
+  /// \brief Protects sceneSnapshot. The scene graph itself is only used
+  /// by the simulation thread.
   public: std::mutex graphMutex;
 
   /// \brief Protects stepMsg.
@@ -258,6 +407,15 @@ class gz::sim::systems::SceneBroadcasterPrivate
   /// \brief Filled on demand for the state service.
   public: msgs::SerializedStepMap stepMsg;
 
+  /// \brief Full state kept up to date with the published changes while
+  /// the state topic has subscribers, so the state services don't wait on
+  /// the simulation. Null when it may be out of date. Copied on write if the
+  /// services still hold it.
+  public: std::shared_ptr<msgs::SerializedStepMap> stateSnapshot;
+
+  /// \brief Protects stateSnapshot.
+  public: std::mutex snapshotMutex;
+
   /// \brief Last time the state was published.
   public: std::chrono::time_point<std::chrono::system_clock>
       lastStatePubTime{std::chrono::system_clock::now()};
@@ -288,6 +446,15 @@ class gz::sim::systems::SceneBroadcasterPrivate
   /// This is currently only used in playback mode.
   public: bool pubPeriodicChanges{false};
 
+  /// \brief Scoped streams, keyed by the namespace of their topics.
+  public: std::map<std::string, std::unique_ptr<Interest>> interests;
+
+  /// \brief Id of the next scoped stream.
+  public: unsigned int nextInterestId{0u};
+
+  /// \brief Protects interests.
+  public: std::mutex interestMutex;
+
   /// \brief Stores a cache of components that are changed. (This prevents
   ///  dropping of periodic change components which may not be updated
   ///  frequently enough)
@@ -322,6 +489,29 @@ void SceneBroadcaster::Configure(
   auto readHertz = _sdf->Get<int>("dynamic_pose_hertz", 60);
   this->dataPtr->dyPoseHertz = readHertz.first;
 
+  this->dataPtr->compactPoses = _sdf->Get<bool>("compact_poses",
+      this->dataPtr->compactPoses).first;
+  if (this->dataPtr->compactPoses)
+  {
+    auto &encoder = this->dataPtr->compactEncoder;
+    encoder.SetPositionResolution(
+        _sdf->Get<double>("compact_pose_resolution", 1e-3).first);
+    encoder.SetPositionThreshold(
+        _sdf->Get<double>("compact_pose_threshold", 1e-3).first);
+    encoder.SetAngleThreshold(
+        _sdf->Get<double>("compact_pose_angle_threshold", 1e-3).first);
+    encoder.SetKeyframeInterval(
+        _sdf->Get<unsigned int>("compact_pose_keyframe_interval", 60).first);
+  }
+
+  this->dataPtr->compactState = _sdf->Get<bool>("compact_state",
+      this->dataPtr->compactState).first;
+  if (this->dataPtr->compactState)
+  {
+    this->dataPtr->compactStateEncoder.SetKeyframeInterval(
+        _sdf->Get<unsigned int>("compact_state_keyframe_interval", 60).first);
+  }
+
   auto stateHertz = _sdf->Get<double>("state_hertz", 60);
   if (stateHertz.first > 0.0)
   {
@@ -343,11 +533,9 @@ void SceneBroadcaster::Configure(
   }
 
   // Add to graph
-  {
-    std::lock_guard<std::mutex> lock(this->dataPtr->graphMutex);
-    this->dataPtr->sceneGraph.AddVertex(this->dataPtr->worldName, nullptr,
-                                        this->dataPtr->worldEntity);
-  }
+  this->dataPtr->sceneGraph.AddVertex(this->dataPtr->worldName, nullptr,
+                                      this->dataPtr->worldEntity);
+  this->dataPtr->UpdateSceneSnapshot();
 }
 
 //////////////////////////////////////////////////
@@ -365,7 +553,14 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
   auto sceneComp =
     _manager.Component<components::Scene>(this->dataPtr->worldEntity);
   if (sceneComp)
+  {
     this->dataPtr->sdfScene = sceneComp->Data();
+    if (_manager.ComponentState(this->dataPtr->worldEntity,
+        components::Scene::typeId) != ComponentState::NoChange)
+    {
+      this->dataPtr->sceneSnapshotDirty = true;
+    }
+  }
 
   // Create and send pose update if transport connections exist.
   if (this->dataPtr->dyPosePub.HasConnections() ||
@@ -374,10 +569,23 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
     this->dataPtr->PoseUpdate(_info, _manager);
   }
 
+  if (this->dataPtr->compactPoses)
+  {
+    // Removed entities are only dropped by decoders on keyframes
+    if (_manager.HasEntitiesMarkedForRemoval())
+      this->dataPtr->compactEncoder.ForceKeyframe();
+
+    if (this->dataPtr->compactPub.HasConnections())
+      this->dataPtr->CompactPoseUpdate(_info, _manager);
+  }
+
   // call SceneGraphRemoveEntities at the end of this update cycle so that
   // removed entities are removed from the scene graph for the next update cycle
   this->dataPtr->SceneGraphRemoveEntities(_manager);
 
+  if (this->dataPtr->sceneSnapshotDirty)
+    this->dataPtr->UpdateSceneSnapshot();
+
   // Iterate through entities and their changes to cache them.
   _manager.UpdatePeriodicChangeCache(this->dataPtr->changedComponents);
 
@@ -399,12 +607,21 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
   // check if we need to publish periodic changes in playback mode.
   bool pubChanges = this->dataPtr->pubPeriodicChanges &&
       _manager.HasPeriodicComponentChanges();
-  auto shouldPublish = this->dataPtr->statePub.HasConnections() &&
+  const bool compactStateConnections = this->dataPtr->compactState &&
+      this->dataPtr->compactStatePub.HasConnections();
+  auto shouldPublish = (this->dataPtr->statePub.HasConnections() ||
+       compactStateConnections) &&
        (changeEvent || itsPubTime || pubChanges);
 
+  // Without subscribers the changes aren't merged into the snapshot, so it
+  // would be stale once one connects again
+  if (!this->dataPtr->statePub.HasConnections())
+    this->dataPtr->ResetStateSnapshot();
+
   if (this->dataPtr->stateServiceRequest || shouldPublish)
   {
     std::unique_lock<std::mutex> lock(this->dataPtr->stateMutex);
+    const bool fullState = this->dataPtr->stateServiceRequest;
     this->dataPtr->stepMsg.Clear();
 
     set(this->dataPtr->stepMsg.mutable_stats(), _info);
@@ -456,6 +673,9 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
       this->dataPtr->changedComponents.clear();
     }
 
+    this->dataPtr->UpdateStateSnapshot(this->dataPtr->stateServiceRequest,
+        shouldPublish);
+
     // Full state on demand
     if (this->dataPtr->stateServiceRequest)
     {
@@ -479,10 +699,25 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
     if (shouldPublish)
     {
       GZ_PROFILE("SceneBroadcast::PostUpdate Publish State");
-      this->dataPtr->statePub.Publish(this->dataPtr->stepMsg);
+      if (this->dataPtr->statePub.HasConnections())
+        this->dataPtr->statePub.Publish(this->dataPtr->stepMsg);
+      if (compactStateConnections)
+      {
+        // Start a new session with full states and after jumps back, so
+        // decoders that join the stream catch up with the right state
+        if (fullState || jumpBackInTime)
+          this->dataPtr->compactStateEncoder.ForceKeyframe();
+        this->dataPtr->compactStateEncoder.Encode(
+            this->dataPtr->stepMsg.state(), _info.simTime,
+            *this->dataPtr->compactStateMsg.mutable_data());
+        this->dataPtr->compactStatePub.Publish(
+            this->dataPtr->compactStateMsg);
+      }
       this->dataPtr->lastStatePubTime = now;
     }
   }
+
+  this->dataPtr->InterestUpdate(_info, _manager, changeEvent);
 }
 
 //////////////////////////////////////////////////
@@ -504,6 +739,20 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
   bool dyPoseConnections = this->dyPosePub.HasConnections();
   bool poseConnections = this->posePub.HasConnections();
 
+  // Links that the physics system put to sleep keep their pose, so they're
+  // left out of the dynamic poses
+  auto asleep = [&](const Entity _entity)
+  {
+    return _manager.EntityHasComponentType(_entity,
+        components::Sleeping::typeId);
+  };
+  auto canonicalLinkAsleep = [&](const Entity _model)
+  {
+    auto canonicalLinkComp =
+        _manager.Component<components::ModelCanonicalLink>(_model);
+    return canonicalLinkComp && asleep(canonicalLinkComp->Data());
+  };
+
   // Models
   _manager.Each<components::Model, components::Name, components::Pose,
                 components::Static>(
@@ -521,7 +770,9 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           pose->set_id(_entity);
         }
 
-        if (dyPoseConnections && !_staticComp->Data())
+        // Models whose canonical link is asleep aren't moving
+        if (dyPoseConnections && !_staticComp->Data() &&
+            !canonicalLinkAsleep(_entity))
         {
           // Add to dynamic pose msg
           auto dyPose = dyPoseMsg.add_pose();
@@ -552,7 +803,7 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
         // Check whether parent model is static
         auto staticComp = _manager.Component<components::Static>(
           _parentComp->Data());
-        if (dyPoseConnections && !staticComp->Data())
+        if (dyPoseConnections && !staticComp->Data() && !asleep(_entity))
         {
           // Add to dynamic pose msg
           auto dyPose = dyPoseMsg.add_pose();
@@ -610,6 +861,282 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
   }
 }
 
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::CompactPoseUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager)
+{
+  GZ_PROFILE("SceneBroadcast::CompactPoseUpdate");
+
+  // Throttle here instead of in transport, because dropping a frame between
+  // keyframes would lose the poses in it until the next keyframe
+  if (this->dyPoseHertz > 0 && _info.simTime >= this->lastCompactTime &&
+      this->lastCompactTime >= std::chrono::steady_clock::duration::zero())
+  {
+    const auto period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / this->dyPoseHertz));
+    if (_info.simTime - this->lastCompactTime < period)
+      return;
+  }
+  if (_info.simTime < this->lastCompactTime)
+    this->compactEncoder.ForceKeyframe();
+  this->lastCompactTime = _info.simTime;
+
+  // Same entities as the dynamic poses, including sleeping links, whose
+  // unchanged poses are left out by the encoder between keyframes
+  _manager.Each<components::Model, components::Pose, components::Static>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::Pose *_poseComp,
+          const components::Static *_staticComp) -> bool
+      {
+        if (!_staticComp->Data())
+          this->compactEncoder.Add(_entity, _poseComp->Data());
+        return true;
+      });
+
+  _manager.Each<components::Link, components::Pose,
+                components::ParentEntity>(
+      [&](const Entity &_entity, const components::Link *,
+          const components::Pose *_poseComp,
+          const components::ParentEntity *_parentComp) -> bool
+      {
+        auto staticComp = _manager.Component<components::Static>(
+          _parentComp->Data());
+        if (staticComp && !staticComp->Data())
+          this->compactEncoder.Add(_entity, _poseComp->Data());
+        return true;
+      });
+
+  this->compactEncoder.Encode(_info.simTime,
+      *this->compactMsg.mutable_data());
+  this->compactPub.Publish(this->compactMsg);
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::UpdateSceneSnapshot()
+{
+  GZ_PROFILE("SceneBroadcast::UpdateSceneSnapshot");
+
+  // The vertices only hold pointers to the messages, so this is much
+  // cheaper than building the scene message
+  auto snapshot = std::make_shared<SceneSnapshot>();
+  snapshot->graph = this->sceneGraph;
+  snapshot->sdfScene = this->sdfScene;
+
+  std::lock_guard<std::mutex> lock(this->graphMutex);
+  this->sceneSnapshot = std::move(snapshot);
+  this->sceneSnapshotDirty = false;
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::UpdateStateSnapshot(bool _full,
+    bool _published)
+{
+  GZ_PROFILE("SceneBroadcast::UpdateStateSnapshot");
+
+  std::lock_guard<std::mutex> lock(this->snapshotMutex);
+
+  // Changes are only serialized for subscribers, without them the snapshot
+  // would miss some
+  if (!this->statePub.HasConnections())
+  {
+    this->stateSnapshot.reset();
+    return;
+  }
+
+  if (_full)
+  {
+    this->stateSnapshot =
+        std::make_shared<msgs::SerializedStepMap>(this->stepMsg);
+    return;
+  }
+
+  if (!this->stateSnapshot || !_published)
+    return;
+
+  // A service is still copying the snapshot, leave it untouched
+  if (this->stateSnapshot.use_count() > 1)
+  {
+    this->stateSnapshot =
+        std::make_shared<msgs::SerializedStepMap>(*this->stateSnapshot);
+  }
+  mergeState(this->stepMsg, *this->stateSnapshot, true);
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::ResetStateSnapshot()
+{
+  std::lock_guard<std::mutex> lock(this->snapshotMutex);
+  this->stateSnapshot.reset();
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::InterestUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager, bool _changeEvent)
+{
+  GZ_PROFILE("SceneBroadcast::InterestUpdate");
+
+  std::lock_guard<std::mutex> lock(this->interestMutex);
+  if (this->interests.empty())
+    return;
+
+  const auto now = std::chrono::system_clock::now();
+  const auto posePeriod = this->dyPoseHertz > 0 ?
+      std::chrono::duration<double>(1.0 / this->dyPoseHertz) :
+      std::chrono::duration<double>::zero();
+
+  for (auto &[ns, interest] : this->interests)
+  {
+    const bool stateConnections = interest->statePub.HasConnections();
+    if (!stateConnections)
+    {
+      // The next subscriber gets the full state of every entity
+      interest->entities.clear();
+    }
+
+    const bool poseDue = interest->posePub.HasConnections() &&
+        now - interest->lastPosePubTime >= posePeriod;
+    const bool stateDue = stateConnections && (_changeEvent ||
+        now - interest->lastStatePubTime >
+        this->statePublishPeriod[_info.paused]);
+    if (!poseDue && !stateDue)
+      continue;
+
+    auto entities = this->InterestEntities(*interest, _manager);
+
+    if (poseDue)
+    {
+      msgs::Pose_V poseMsg;
+      poseMsg.mutable_header()->mutable_stamp()->CopyFrom(
+          convert<msgs::Time>(_info.simTime));
+
+      // Same entity types as the pose/info topic
+      for (const auto &entity : entities)
+      {
+        if (!_manager.EntityHasComponentType(entity,
+                components::Model::typeId) &&
+            !_manager.EntityHasComponentType(entity,
+                components::Link::typeId) &&
+            !_manager.EntityHasComponentType(entity,
+                components::Visual::typeId) &&
+            !_manager.EntityHasComponentType(entity,
+                components::Light::typeId))
+        {
+          continue;
+        }
+        auto poseComp = _manager.Component<components::Pose>(entity);
+        auto nameComp = _manager.Component<components::Name>(entity);
+        if (!poseComp || !nameComp)
+          continue;
+
+        auto pose = poseMsg.add_pose();
+        msgs::Set(pose, poseComp->Data());
+        pose->set_name(nameComp->Data());
+        pose->set_id(entity);
+      }
+
+      interest->posePub.Publish(poseMsg);
+      interest->lastPosePubTime = now;
+    }
+
+    if (!stateDue)
+      continue;
+
+    auto &stepMsg = interest->stepMsg;
+    stepMsg.Clear();
+    set(stepMsg.mutable_stats(), _info);
+    auto *state = stepMsg.mutable_state();
+
+    // Entities new to the stream get their full state, the others their
+    // changes on change events and their poses otherwise
+    std::unordered_set<Entity> added;
+    std::unordered_set<Entity> kept;
+    for (const auto &entity : entities)
+    {
+      if (interest->entities.find(entity) == interest->entities.end())
+        added.insert(entity);
+      else
+        kept.insert(entity);
+    }
+
+    // An empty set would serialize every entity
+    if (!added.empty())
+      _manager.State(*state, added, {}, true);
+    if (!kept.empty())
+    {
+      if (_changeEvent)
+        _manager.State(*state, kept, {}, false);
+      else
+        _manager.State(*state, kept, {components::Pose::typeId}, true);
+    }
+
+    // Entities that left the stream are removed for its subscribers
+    for (const auto &entity : interest->entities)
+    {
+      if (entities.find(entity) != entities.end())
+        continue;
+      auto &entityMsg = (*state->mutable_entities())[entity];
+      entityMsg.set_id(entity);
+      entityMsg.set_remove(true);
+    }
+
+    interest->statePub.Publish(stepMsg);
+    interest->lastStatePubTime = now;
+    interest->entities = std::move(entities);
+  }
+}
+
+//////////////////////////////////////////////////
+std::unordered_set<Entity> SceneBroadcasterPrivate::InterestEntities(
+    Interest &_interest, const EntityComponentManager &_manager) const
+{
+  if (_interest.model == kNullEntity || !_manager.HasEntity(_interest.model))
+  {
+    _interest.model = _manager.EntityByComponents(components::Model(),
+        components::Name(_interest.modelName),
+        components::ParentEntity(this->worldEntity));
+  }
+
+  std::unordered_set<Entity> entities;
+  if (_interest.model == kNullEntity)
+    return entities;
+  entities = _manager.Descendants(_interest.model);
+
+  // Like the level manager, use the box of the model's performer
+  auto size = _interest.size;
+  if (!_interest.explicitSize)
+  {
+    auto performer = _manager.EntityByComponents(components::Performer(),
+        components::ParentEntity(_interest.model));
+    auto geometryComp = _manager.Component<components::Geometry>(performer);
+    if (geometryComp && geometryComp->Data().BoxShape())
+      size = geometryComp->Data().BoxShape()->Size();
+  }
+  if (size == math::Vector3d::Zero)
+    return entities;
+
+  const auto center = worldPose(_interest.model, _manager).Pos();
+  const math::AxisAlignedBox region{center - size / 2, center + size / 2};
+  _manager.Each<components::Model, components::Pose,
+                components::ParentEntity>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::Pose *_poseComp,
+          const components::ParentEntity *_parentComp) -> bool
+      {
+        if (_parentComp->Data() != this->worldEntity ||
+            _entity == _interest.model ||
+            !region.Contains(_poseComp->Data().Pos()))
+        {
+          return true;
+        }
+        auto descendants = _manager.Descendants(_entity);
+        entities.insert(descendants.begin(), descendants.end());
+        return true;
+      });
+
+  return entities;
+}
+
 //////////////////////////////////////////////////
 void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
 {
@@ -710,23 +1237,127 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
 
   gzmsg << "Publishing dynamic pose messages on [" << opts.NameSpace() << "/"
          << dyPoseTopic << "]" << std::endl;
+
+  // Compact pose publisher
+  if (this->compactPoses)
+  {
+    std::string compactTopic{"dynamic_pose/compact"};
+    this->compactPub = this->node->Advertise<msgs::Bytes>(compactTopic);
+
+    gzmsg << "Publishing compact pose frames on [" << opts.NameSpace()
+           << "/" << compactTopic << "]" << std::endl;
+  }
+
+  // Compact state publisher
+  if (this->compactState)
+  {
+    std::string compactStateTopic{ns + "/state/compact"};
+    this->compactStatePub =
+        this->node->Advertise<msgs::Bytes>(compactStateTopic);
+
+    gzmsg << "Publishing compact state frames on [" << compactStateTopic
+           << "]" << std::endl;
+  }
+
+  // Scoped stream services
+  std::string interestAddService{"interest/add"};
+
+  this->node->Advertise(interestAddService,
+      &SceneBroadcasterPrivate::InterestAddService, this);
+
+  gzmsg << "Serving scoped streams on [" << opts.NameSpace() << "/"
+         << interestAddService << "]" << std::endl;
+
+  std::string interestRemoveService{"interest/remove"};
+
+  this->node->Advertise(interestRemoveService,
+      &SceneBroadcasterPrivate::InterestRemoveService, this);
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::InterestAddService(const msgs::Param &_req,
+    msgs::StringMsg &_res)
+{
+  auto interest = std::make_unique<Interest>();
+
+  const auto &params = _req.params();
+  auto modelIt = params.find("model");
+  if (modelIt != params.end())
+    interest->modelName = modelIt->second.string_value();
+  if (interest->modelName.empty())
+  {
+    gzerr << "Scoped streams need the name of a model in the [model] "
+           << "parameter." << std::endl;
+    return false;
+  }
+
+  auto sizeIt = params.find("size");
+  if (sizeIt != params.end())
+  {
+    interest->size = msgs::Convert(sizeIt->second.vector3d_value());
+    interest->explicitSize = true;
+    if (interest->size.Min() < 0)
+    {
+      gzerr << "Scoped stream size must not be negative, got ["
+             << interest->size << "]." << std::endl;
+      return false;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->interestMutex);
+  const std::string name = "interest/" +
+      std::to_string(this->nextInterestId++);
+  const std::string ns = this->node->Options().NameSpace() + "/" + name;
+
+  transport::AdvertiseMessageOptions poseAdvertOpts;
+  poseAdvertOpts.SetMsgsPerSec(this->dyPoseHertz);
+  interest->posePub = this->node->Advertise<msgs::Pose_V>(
+      name + "/pose/info", poseAdvertOpts);
+  interest->statePub = this->node->Advertise<msgs::SerializedStepMap>(
+      name + "/state");
+  if (!interest->posePub || !interest->statePub)
+  {
+    gzerr << "Failed to advertise scoped stream on [" << ns << "]"
+           << std::endl;
+    return false;
+  }
+
+  gzdbg << "Publishing model [" << interest->modelName
+         << "] on scoped stream [" << ns << "]" << std::endl;
+
+  this->interests[ns] = std::move(interest);
+  _res.set_data(ns);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::InterestRemoveService(
+    const msgs::StringMsg &_req, msgs::Boolean &_res)
+{
+  std::lock_guard<std::mutex> lock(this->interestMutex);
+  _res.set_data(this->interests.erase(_req.data()) > 0);
+  return true;
 }
 
 //////////////////////////////////////////////////
 bool SceneBroadcasterPrivate::SceneInfoService(msgs::Scene &_res)
 {
-  std::lock_guard<std::mutex> lock(this->graphMutex);
+  std::shared_ptr<const SceneSnapshot> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(this->graphMutex);
+    snapshot = this->sceneSnapshot;
+  }
 
   _res.Clear();
 
   // Populate scene message
-  _res.CopyFrom(convert<msgs::Scene>(this->sdfScene));
+  _res.CopyFrom(convert<msgs::Scene>(snapshot->sdfScene));
 
   // Add models
-  AddModels(&_res, this->worldEntity, this->sceneGraph);
+  AddModels(&_res, this->worldEntity, snapshot->graph);
 
   // Add lights
-  AddLights(&_res, this->worldEntity, this->sceneGraph);
+  AddLights(&_res, this->worldEntity, snapshot->graph);
 
   return true;
 }
@@ -735,6 +1366,17 @@ bool SceneBroadcasterPrivate::SceneInfoService(msgs::Scene &_res)
 void SceneBroadcasterPrivate::StateAsyncService(
     const msgs::StringMsg &_req)
 {
+  std::shared_ptr<const msgs::SerializedStepMap> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(this->snapshotMutex);
+    snapshot = this->stateSnapshot;
+  }
+  if (snapshot)
+  {
+    this->node->Request(_req.data(), *snapshot);
+    return;
+  }
+
   std::unique_lock<std::mutex> lock(this->stateMutex);
   this->stateServiceRequest = true;
   this->stateRequests.insert(_req.data());
@@ -746,6 +1388,19 @@ bool SceneBroadcasterPrivate::StateService(
 {
   _res.Clear();
 
+  // Copy outside of the lock, holding a reference so the simulation copies
+  // the snapshot instead of changing it
+  std::shared_ptr<const msgs::SerializedStepMap> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(this->snapshotMutex);
+    snapshot = this->stateSnapshot;
+  }
+  if (snapshot)
+  {
+    _res.CopyFrom(*snapshot);
+    return true;
+  }
+
   // Lock and wait for an iteration to be run and fill the state
   std::unique_lock<std::mutex> lock(this->stateMutex);
 
@@ -766,12 +1421,16 @@ bool SceneBroadcasterPrivate::StateService(
 //////////////////////////////////////////////////
 bool SceneBroadcasterPrivate::SceneGraphService(msgs::StringMsg &_res)
 {
-  std::lock_guard<std::mutex> lock(this->graphMutex);
+  std::shared_ptr<const SceneSnapshot> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(this->graphMutex);
+    snapshot = this->sceneSnapshot;
+  }
 
   _res.Clear();
 
   std::stringstream graphStr;
-  graphStr << this->sceneGraph;
+  graphStr << snapshot->graph;
 
   _res.set_data(graphStr.str());
 
@@ -1140,22 +1799,22 @@ void SceneBroadcasterPrivate::SceneGraphAddEntities(
       });
 
   // Update the whole scene graph from the new graph
+  for (const auto &[id, vert] : newGraph.Vertices())
   {
-    std::lock_guard<std::mutex> lock(this->graphMutex);
-    for (const auto &[id, vert] : newGraph.Vertices())
+    // Add the vertex only if it's not already in the graph
+    if (!this->sceneGraph.VertexFromId(id).Valid())
     {
-      // Add the vertex only if it's not already in the graph
-      if (!this->sceneGraph.VertexFromId(id).Valid())
-        this->sceneGraph.AddVertex(vert.get().Name(), vert.get().Data(), id);
+      this->sceneGraph.AddVertex(vert.get().Name(), vert.get().Data(), id);
+      this->sceneSnapshotDirty = true;
     }
-    for (const auto &[id, edge] : newGraph.Edges())
+  }
+  for (const auto &[id, edge] : newGraph.Edges())
+  {
+    // Add the edge only if it's not already in the graph
+    if (!this->sceneGraph.EdgeFromVertices(edge.get().Vertices().first,
+          edge.get().Vertices().second).Valid())
     {
-      // Add the edge only if it's not already in the graph
-      if (!this->sceneGraph.EdgeFromVertices(edge.get().Vertices().first,
-            edge.get().Vertices().second).Valid())
-      {
-        this->sceneGraph.AddEdge(edge.get().Vertices(), edge.get().Data());
-      }
+      this->sceneGraph.AddEdge(edge.get().Vertices(), edge.get().Data());
     }
   }
 
@@ -1182,7 +1841,6 @@ void SceneBroadcasterPrivate::SceneGraphAddEntities(
 void SceneBroadcasterPrivate::SceneGraphRemoveEntities(
     const EntityComponentManager &_manager)
 {
-  std::lock_guard<std::mutex> lock(this->graphMutex);
   // Handle Removed Entities
   std::vector<Entity> removedEntities;
 
@@ -1212,6 +1870,8 @@ void SceneBroadcasterPrivate::SceneGraphRemoveEntities(
 
   if (!removedEntities.empty())
   {
+    this->sceneSnapshotDirty = true;
+
     // Send the list of deleted entities
     msgs::UInt32_V deletionMsg;
 
@@ -37,6 +37,47 @@ namespace systems
   **/
   /// \brief System which periodically publishes a gz::msgs::Scene
   /// message with updated information.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<dynamic_pose_hertz>`: Rate at which the poses of non-static models
+  /// and links are published on `dynamic_pose/info`. Defaults to 60.
+  /// - `<state_hertz>`: Rate at which the state is published. Defaults to
+  /// 60.
+  /// - `<compact_poses>`: True to also publish the poses of non-static
+  /// models and links on `dynamic_pose/compact`, at the dynamic pose rate,
+  /// as gz::msgs::Bytes frames written by CompactPoseEncoder. Frames
+  /// between keyframes only hold the poses that changed, and positions and
+  /// orientations are quantized, which suits remote clients on slow links.
+  /// Defaults to false.
+  /// - `<compact_pose_resolution>`: Position quantization step in meters.
+  /// Defaults to 0.001.
+  /// - `<compact_pose_threshold>`: Distance in meters an entity has to move
+  /// before its pose is sent again. Defaults to 0.001.
+  /// - `<compact_pose_angle_threshold>`: Angle in radians an entity has to
+  /// rotate before its pose is sent again. Defaults to 0.001.
+  /// - `<compact_pose_keyframe_interval>`: Number of frames between
+  /// keyframes, which hold every pose. Defaults to 60.
+  /// - `<compact_state>`: True to also publish the state on `state/compact`
+  /// whenever it's published on `state`, as gz::msgs::Bytes frames written
+  /// by CompactStateEncoder. Entities and component types are sent in full
+  /// once per session, and referred to by small indices afterwards.
+  /// Defaults to false.
+  /// - `<compact_state_keyframe_interval>`: Number of frames between
+  /// keyframes, which start a new session. Defaults to 60.
+  ///
+  /// ## Scoped streams
+  ///
+  /// Subscribers that only care about part of a large world can call the
+  /// `interest/add` service with a gz::msgs::Param holding the name of a
+  /// top level model in its `model` parameter. The service responds with a
+  /// namespace whose `pose/info` and `state` topics only carry the model
+  /// and its descendants. An optional `size` parameter, a gz::msgs::Vector3d,
+  /// also includes the models whose origin is in a box of that size
+  /// centered on the model. Without it, a box geometry from the model's
+  /// level performer is used, if there's one. Entities that leave the box
+  /// are marked as removed in the stream's state. The `interest/remove`
+  /// service takes the namespace and removes the stream.
   class SceneBroadcaster final:
     public System,
     public ISystemConfigure,
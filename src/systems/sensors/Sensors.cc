@@ -17,16 +17,24 @@
 
 #include "Sensors.hh"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <set>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <gz/common/Console.hh>
 #include <gz/common/Profiler.hh>
+#include <gz/msgs/diagnostics.pb.h>
 #include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
 
 #include <sdf/Sensor.hh>
 
@@ -50,6 +58,7 @@
 #include "gz/sim/components/Camera.hh"
 #include "gz/sim/components/DepthCamera.hh"
 #include "gz/sim/components/GpuLidar.hh"
+#include "gz/sim/components/Name.hh"
 #include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/RenderEngineServerApiBackend.hh"
 #include "gz/sim/components/RenderEngineServerHeadless.hh"
@@ -59,11 +68,14 @@
 #include "gz/sim/components/ThermalCamera.hh"
 #include "gz/sim/components/WideAngleCamera.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/Conversions.hh"
 #include "gz/sim/Events.hh"
 #include "gz/sim/EntityComponentManager.hh"
 
+#include "gz/sim/rendering/AssetCache.hh"
 #include "gz/sim/rendering/Events.hh"
 #include "gz/sim/rendering/RenderUtil.hh"
+#include "gz/sim/rendering/SceneManager.hh"
 
 using namespace gz;
 using namespace sim;
@@ -173,12 +185,70 @@ class gz::sim::systems::SensorsPrivate
   /// \brief Pointer to the event manager
   public: EventManager *eventManager{nullptr};
 
+  /// \brief True to let the simulation continue while sensors are being
+  /// rendered, instead of waiting for the previous rendering iteration to
+  /// finish before handing off the next one.
+  public: bool asynchronous{false};
+
+  /// \brief Maximum number of simulation iterations that a rendering
+  /// iteration may lag behind the simulation in asynchronous mode.
+  public: uint64_t maxLagSteps{10u};
+
+  /// \brief Simulation iteration of the last hand-off to the rendering
+  /// thread.
+  public: uint64_t handOffIteration{0u};
+
+  /// \brief Number of camera render passes that are batched before the GPU
+  /// is flushed.
+  public: unsigned int cameraPassCountPerGpuFlush{6u};
+
+  /// \brief Render cost of a sensor, accumulated since the last report.
+  public: struct RenderCost
+  {
+    /// \brief Scoped name of the sensor.
+    std::string name;
+
+    /// \brief Number of updates that generated data.
+    uint64_t updates{0u};
+
+    /// \brief Total wall time spent in those updates.
+    std::chrono::steady_clock::duration total{0};
+
+    /// \brief Longest of those updates.
+    std::chrono::steady_clock::duration longest{0};
+  };
+
+  /// \brief Render cost of each sensor. Only accessed from the rendering
+  /// thread.
+  public: std::unordered_map<sensors::SensorId, RenderCost> renderCosts;
+
+  /// \brief Transport node used to report the render cost.
+  public: transport::Node node;
+
+  /// \brief Publisher of the render cost of the sensors.
+  public: transport::Node::Publisher renderCostPub;
+
+  /// \brief Wall time of the last render cost report.
+  public: std::chrono::steady_clock::time_point lastRenderCostReport;
+
   /// \brief Wait for initialization to happen
   private: void WaitForInit();
 
   /// \brief Run one rendering iteration
   private: void RunOnce();
 
+  /// \brief Update all sensors that are due, measuring how long each of
+  /// them takes to render and publish its data.
+  /// \param[in] _time Current simulation time.
+  private: void UpdateSensors(
+      const std::chrono::steady_clock::duration &_time);
+
+  /// \brief Publish the render cost accumulated since the last report, at
+  /// most once per wall clock second and only if there are subscribers.
+  /// \param[in] _time Current simulation time.
+  private: void PublishRenderCost(
+      const std::chrono::steady_clock::duration &_time);
+
   /// \brief Top level function for the rendering thread
   ///
   /// This function captures all of the behavior of the rendering thread.
@@ -228,6 +298,44 @@ class gz::sim::systems::SensorsPrivate
   /// \brief Check if any of the sensors have connections
   public: bool SensorsHaveConnections();
 
+  /// \brief Get a key that is the same for sensors that render the same
+  /// kind of output with the same resolution, so they can be updated one
+  /// after the other.
+  /// \param[in] _sensor The sensor.
+  /// \return The batch key, empty for sensors that are never batched.
+  public: static std::string BatchKey(sensors::Sensor *_sensor);
+
+  /// \brief Sort sensorIds into updateOrder, so that compatible sensors
+  /// are next to each other.
+  public: void SortUpdateOrder();
+
+  /// \brief True to update compatible sensors one after the other.
+  public: bool batchSensors{true};
+
+  /// \brief Order in which the sensors are updated, only used if
+  /// batchSensors is true.
+  public: std::vector<sensors::SensorId> updateOrder;
+
+  /// \brief True if sensors were added or removed since updateOrder was
+  /// sorted.
+  public: std::atomic<bool> updateOrderDirty{true};
+
+  /// \brief Check whether a sensor needs to generate data, because it has
+  /// connections or it's always on.
+  /// \param[in] _id Id of the sensor.
+  /// \param[in] _sensor The sensor.
+  /// \return True if the sensor needs to generate data.
+  public: bool SensorWanted(sensors::SensorId _id,
+      sensors::RenderingSensor *_sensor) const;
+
+  /// \brief True to generate data for sensors with `<always_on>` set even
+  /// if nobody is subscribed to them.
+  public: bool honorAlwaysOn{false};
+
+  /// \brief Sensors with `<always_on>` set, only populated if honorAlwaysOn
+  /// is true.
+  public: std::unordered_set<sensors::SensorId> alwaysOnSensors;
+
   /// \brief Use to optionally set the background color.
   public: std::optional<math::Color> backgroundColor;
 
@@ -284,7 +392,8 @@ void SensorsPrivate::WaitForInit()
       // See Sensors::Update.
 #endif
       this->scene = this->renderUtil.Scene();
-      this->scene->SetCameraPassCountPerGpuFlush(6u);
+      this->scene->SetCameraPassCountPerGpuFlush(
+          this->cameraPassCountPerGpuFlush);
       this->initialized = true;
     }
 
@@ -323,10 +432,21 @@ void SensorsPrivate::RunOnce()
     this->updateTimeCv.notify_one();
   }
 
+  // Skip the scene graph work if none of the due sensors needs to generate
+  // data anymore, for example because their subscribers went away
   bool activeSensorsEmpty = true;
   {
     std::unique_lock<std::mutex> lk(this->sensorsMutex);
-    activeSensorsEmpty = this->activeSensors.empty();
+    for (auto id : this->activeSensors)
+    {
+      auto rs = dynamic_cast<sensors::RenderingSensor *>(
+          this->sensorManager.Sensor(id));
+      if (nullptr != rs && this->SensorWanted(id, rs))
+      {
+        activeSensorsEmpty = false;
+        break;
+      }
+    }
   }
 
   if (!activeSensorsEmpty || this->forceUpdate)
@@ -367,7 +487,7 @@ void SensorsPrivate::RunOnce()
     {
       sensors::Sensor *s = this->sensorManager.Sensor(id);
       auto rs = dynamic_cast<sensors::RenderingSensor *>(s);
-      if (rs->IsActive() && !rs->HasConnections())
+      if (rs->IsActive() && !this->SensorWanted(id, rs))
       {
         rs->SetActive(false);
         tmpDisabledSensors.insert(rs);
@@ -382,7 +502,7 @@ void SensorsPrivate::RunOnce()
     {
       // publish data
       GZ_PROFILE("RunOnce");
-      this->sensorManager.RunOnce(this->updateTimeApplied);
+      this->UpdateSensors(this->updateTimeApplied);
       this->eventManager->Emit<events::Render>();
     }
 
@@ -414,6 +534,140 @@ void SensorsPrivate::RunOnce()
   }
 }
 
+//////////////////////////////////////////////////
+void SensorsPrivate::UpdateSensors(
+    const std::chrono::steady_clock::duration &_time)
+{
+  GZ_PROFILE("SensorsPrivate::UpdateSensors");
+  if (this->batchSensors && this->updateOrderDirty)
+    this->SortUpdateOrder();
+
+  auto update = [&](sensors::SensorId id)
+  {
+    sensors::Sensor *s = this->sensorManager.Sensor(id);
+    if (nullptr == s)
+      return;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!s->Update(_time, false))
+      return;
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto &cost = this->renderCosts[id];
+    ++cost.updates;
+    cost.total += elapsed;
+    cost.longest = std::max(cost.longest, elapsed);
+  };
+
+  if (this->batchSensors)
+  {
+    for (auto id : this->updateOrder)
+      update(id);
+  }
+  else
+  {
+    for (auto id : this->sensorIds)
+      update(id);
+  }
+
+  this->PublishRenderCost(_time);
+}
+
+//////////////////////////////////////////////////
+std::string SensorsPrivate::BatchKey(sensors::Sensor *_sensor)
+{
+  std::stringstream key;
+  if (auto lidar = dynamic_cast<sensors::GpuLidarSensor *>(_sensor))
+  {
+    key << "gpu_lidar " << lidar->RayCount() << "x"
+        << lidar->VerticalRayCount() << " "
+        << lidar->AngleMin().Radian() << ":" << lidar->AngleMax().Radian()
+        << " " << lidar->VerticalAngleMin().Radian() << ":"
+        << lidar->VerticalAngleMax().Radian() << " "
+        << lidar->RangeMin() << ":" << lidar->RangeMax();
+  }
+  else if (auto depth = dynamic_cast<sensors::DepthCameraSensor *>(_sensor))
+  {
+    key << "depth_camera " << depth->ImageWidth() << "x"
+        << depth->ImageHeight();
+  }
+  else if (auto camera = dynamic_cast<sensors::CameraSensor *>(_sensor))
+  {
+    key << "camera " << camera->ImageWidth() << "x" << camera->ImageHeight();
+  }
+  return key.str();
+}
+
+//////////////////////////////////////////////////
+void SensorsPrivate::SortUpdateOrder()
+{
+  GZ_PROFILE("SensorsPrivate::SortUpdateOrder");
+  this->updateOrderDirty = false;
+
+  std::vector<std::pair<std::string, sensors::SensorId>> keyed;
+  {
+    std::unique_lock<std::mutex> lock(this->sensorsMutex);
+    for (auto id : this->sensorIds)
+    {
+      sensors::Sensor *s = this->sensorManager.Sensor(id);
+      if (nullptr == s)
+        continue;
+      keyed.emplace_back(BatchKey(s), id);
+    }
+  }
+
+  // Stable, so sensors in a batch keep the order in which they were created
+  std::stable_sort(keyed.begin(), keyed.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  this->updateOrder.clear();
+  for (const auto &[key, id] : keyed)
+    this->updateOrder.push_back(id);
+}
+
+//////////////////////////////////////////////////
+void SensorsPrivate::PublishRenderCost(
+    const std::chrono::steady_clock::duration &_time)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto window = now - this->lastRenderCostReport;
+  if (window < std::chrono::seconds(1))
+    return;
+
+  if (this->renderCostPub && this->renderCostPub.HasConnections())
+  {
+    msgs::Diagnostics msg;
+    msg.mutable_header()->mutable_stamp()->CopyFrom(
+        convert<msgs::Time>(_time));
+    msg.mutable_sim_time()->CopyFrom(convert<msgs::Time>(_time));
+    msg.mutable_real_time()->CopyFrom(convert<msgs::Time>(window));
+    for (const auto &[id, cost] : this->renderCosts)
+    {
+      if (0u == cost.updates)
+        continue;
+
+      auto diag = msg.add_time();
+      diag->set_name(cost.name);
+      diag->mutable_elapsed()->CopyFrom(convert<msgs::Time>(
+          cost.total /
+          static_cast<std::chrono::steady_clock::rep>(cost.updates)));
+      diag->mutable_wall()->CopyFrom(convert<msgs::Time>(cost.longest));
+    }
+    this->renderCostPub.Publish(msg);
+  }
+
+  for (auto &[id, cost] : this->renderCosts)
+  {
+    cost.updates = 0u;
+    cost.total = std::chrono::steady_clock::duration::zero();
+    cost.longest = std::chrono::steady_clock::duration::zero();
+  }
+  this->lastRenderCostReport = now;
+}
+
 //////////////////////////////////////////////////
 void SensorsPrivate::RenderThread()
 {
@@ -435,6 +689,14 @@ void SensorsPrivate::RenderThread()
   for (const auto id : this->sensorIds)
     this->sensorManager.Remove(id);
 
+  // Estimating the memory of textures loads their images, so only do it
+  // when the report is printed
+  if (common::Console::Verbosity() >= 4)
+  {
+    gzdbg << "Rendering asset cache:\n"
+          << AssetCache::Instance().Report();
+  }
+
   this->scene.reset();
   this->renderUtil.Destroy();
   gzdbg << "SensorsPrivate::RenderThread stopped" << std::endl;
@@ -489,7 +751,9 @@ void Sensors::RemoveSensor(const Entity &_entity)
       std::unique_lock<std::mutex> lock(this->dataPtr->sensorsMutex);
       this->dataPtr->activeSensors.erase(idIter->second);
       this->dataPtr->sensorsToUpdate.erase(idIter->second);
+      this->dataPtr->alwaysOnSensors.erase(idIter->second);
     }
+    this->dataPtr->updateOrderDirty = true;
 
     // update cameras list
     for (auto &it : this->dataPtr->cameras)
@@ -502,6 +766,7 @@ void Sensors::RemoveSensor(const Entity &_entity)
     }
 
     this->dataPtr->sensorIds.erase(idIter->second);
+    this->dataPtr->renderCosts.erase(idIter->second);
     this->dataPtr->sensorManager.Remove(idIter->second);
     this->dataPtr->entityToIdMap.erase(idIter);
   }
@@ -538,6 +803,31 @@ void Sensors::Configure(const Entity &/*_id*/,
       _sdf->Get<bool>("disable_on_drained_battery",
      this->dataPtr-> disableOnDrainedBattery).first;
 
+  // get whether simulation may run ahead of the sensors, and by how much
+  this->dataPtr->asynchronous = _sdf->Get<bool>("asynchronous",
+      this->dataPtr->asynchronous).first;
+  this->dataPtr->maxLagSteps = _sdf->Get<uint64_t>("max_lag_steps",
+      this->dataPtr->maxLagSteps).first;
+  if (this->dataPtr->asynchronous)
+  {
+    gzmsg << "Sensors are rendered asynchronously, lagging up to ["
+          << this->dataPtr->maxLagSteps << "] iterations behind simulation."
+          << std::endl;
+  }
+
+  // get whether compatible sensors are updated one after the other
+  this->dataPtr->batchSensors = _sdf->Get<bool>("batch_sensors",
+      this->dataPtr->batchSensors).first;
+
+  // get whether sensors with <always_on> generate data without subscribers
+  this->dataPtr->honorAlwaysOn = _sdf->Get<bool>("honor_always_on",
+      this->dataPtr->honorAlwaysOn).first;
+
+  // get how many camera passes are batched before flushing the GPU
+  this->dataPtr->cameraPassCountPerGpuFlush =
+      _sdf->Get<unsigned int>("camera_pass_count_per_gpu_flush",
+      this->dataPtr->cameraPassCountPerGpuFlush).first;
+
   // Get the background color, if specified.
   if (_sdf->HasElement("background_color"))
     this->dataPtr->backgroundColor = _sdf->Get<math::Color>("background_color");
@@ -552,6 +842,18 @@ void Sensors::Configure(const Entity &/*_id*/,
     apiBackend = "metal";
 #endif
   this->dataPtr->renderUtil.SetApiBackend(apiBackend);
+  this->dataPtr->renderUtil.SetIncrementalPoseUpdates(
+      _sdf->Get<bool>("incremental_pose_updates", false).first);
+  this->dataPtr->renderUtil.SetSensorCullingDistance(
+      _sdf->Get<double>("culling_distance", 0.0).first);
+  this->dataPtr->renderUtil.SetActorAnimationCulling(
+      _sdf->Get<bool>("actor_animation_culling", false).first);
+  this->dataPtr->renderUtil.SetCreationTimeBudget(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(
+      _sdf->Get<double>("creation_time_budget", 0.0).first)));
+  this->dataPtr->renderUtil.SceneManager().SetShareMaterials(
+      _sdf->Get<bool>("share_materials", false).first);
   this->dataPtr->renderUtil.SetEnableSensors(true,
       std::bind(&Sensors::CreateSensor, this,
       std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -599,6 +901,19 @@ void Sensors::Configure(const Entity &/*_id*/,
       this->dataPtr->renderUtil.SetHeadlessRendering(
         renderEngineServerHeadlessComp->Data());
     }
+
+    // Report the render cost of the sensors
+    auto worldName = _ecm.Component<components::Name>(worldEntity);
+    if (worldName)
+    {
+      auto topic = transport::TopicUtils::AsValidTopic(
+          "/world/" + worldName->Data() + "/sensors/render_cost");
+      if (!topic.empty())
+      {
+        this->dataPtr->renderCostPub =
+            this->dataPtr->node.Advertise<msgs::Diagnostics>(topic);
+      }
+    }
   }
 
   this->dataPtr->eventManager = &_eventMgr;
@@ -641,6 +956,7 @@ void Sensors::Reset(const UpdateInfo &_info, EntityComponentManager &)
       s->SetNextDataUpdateTime(_info.simTime);
     }
     this->dataPtr->nextUpdateTime =  _info.simTime;
+    this->dataPtr->handOffIteration = _info.iterations;
     std::unique_lock<std::mutex> lock2(this->dataPtr->renderUtilMutex);
     this->dataPtr->updateTime =  _info.simTime;
     this->dataPtr->updateTimeToApply =  _info.simTime;
@@ -745,15 +1061,35 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
           this->dataPtr->sensorsToUpdate, _info.simTime);
     }
 
+    // in asynchronous mode, bound how far simulation runs ahead of the
+    // rendering iteration in flight, so sensor data is never too stale
+    if (this->dataPtr->asynchronous && this->dataPtr->updateAvailable &&
+        _info.iterations >=
+        this->dataPtr->handOffIteration + this->dataPtr->maxLagSteps)
+    {
+      GZ_PROFILE("WaitForLaggingRender");
+      std::unique_lock<std::mutex> cvLock(this->dataPtr->renderMutex);
+      this->dataPtr->renderCv.wait(cvLock, [this] {
+        return !this->dataPtr->running || !this->dataPtr->updateAvailable; });
+    }
+
     // notify the render thread if updates are available
     if (hasRenderConnections ||
         this->dataPtr->nextUpdateTime <= _info.simTime ||
         this->dataPtr->renderUtil.PendingSensors() > 0 ||
         this->dataPtr->forceUpdate)
     {
+      // the battery state is read from this step's ECM, so it's updated
+      // even when the rendering iteration in flight isn't waited for
       if (this->dataPtr->disableOnDrainedBattery)
         this->dataPtr->UpdateBatteryState(_ecm);
 
+      // in asynchronous mode, don't wait for the rendering iteration in
+      // flight. The sensors that are due are kept, and will be updated with
+      // the snapshot handed off once rendering is done.
+      if (this->dataPtr->asynchronous && this->dataPtr->updateAvailable)
+        return;
+
       {
         std::unique_lock<std::mutex> cvLock(this->dataPtr->renderMutex);
         this->dataPtr->renderCv.wait(cvLock, [this] {
@@ -789,6 +1125,7 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
       {
         std::unique_lock<std::mutex> cvLock(this->dataPtr->renderMutex);
         this->dataPtr->updateAvailable = true;
+        this->dataPtr->handOffIteration = _info.iterations;
         this->dataPtr->renderCv.notify_one();
       }
     }
@@ -919,6 +1256,15 @@ std::string Sensors::CreateSensor(const Entity &_entity,
   auto sensorId = sensor->Id();
   this->dataPtr->entityToIdMap.insert({_entity, sensorId});
   this->dataPtr->sensorIds.insert(sensorId);
+  this->dataPtr->updateOrderDirty = true;
+  if (this->dataPtr->honorAlwaysOn && _sdf.Element() &&
+      _sdf.Element()->Get<bool>("always_on", false).first)
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->sensorsMutex);
+    this->dataPtr->alwaysOnSensors.insert(sensorId);
+  }
+  this->dataPtr->renderCosts[sensorId].name =
+      _parentName + "::" + sensor->Name();
 
   // Set the scene so it can create the rendering sensor
   auto renderingSensor = dynamic_cast<sensors::RenderingSensor *>(sensor);
@@ -1019,7 +1365,7 @@ std::chrono::steady_clock::duration SensorsPrivate::NextUpdateTime(
       continue;
     }
 
-    if (!rs->HasConnections())
+    if (!this->SensorWanted(id, rs))
     {
       continue;
     }
@@ -1039,12 +1385,14 @@ std::chrono::steady_clock::duration SensorsPrivate::NextUpdateTime(
       time = rs->NextDataUpdateTime();
     }
 
-    if (time <= minNextUpdateTime)
+    // Only keep the sensors that are due first
+    if (time < minNextUpdateTime)
     {
       _sensorsToUpdate.clear();
       minNextUpdateTime = time;
     }
-    _sensorsToUpdate.insert(id);
+    if (time == minNextUpdateTime)
+      _sensorsToUpdate.insert(id);
   }
   return minNextUpdateTime;
 }
@@ -1067,7 +1415,7 @@ bool SensorsPrivate::SensorsHaveConnections()
       continue;
     }
 
-    if (rs->HasConnections())
+    if (this->SensorWanted(id, rs))
     {
       return true;
     }
@@ -1075,6 +1423,14 @@ bool SensorsPrivate::SensorsHaveConnections()
   return false;
 }
 
+//////////////////////////////////////////////////
+bool SensorsPrivate::SensorWanted(sensors::SensorId _id,
+    sensors::RenderingSensor *_sensor) const
+{
+  return _sensor->HasConnections() ||
+      this->alwaysOnSensors.find(_id) != this->alwaysOnSensors.end();
+}
+
 GZ_ADD_PLUGIN(Sensors, System,
   Sensors::ISystemConfigure,
   Sensors::ISystemReset,
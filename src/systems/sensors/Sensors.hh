@@ -50,6 +50,68 @@ namespace systems
   /// - `<disable_on_drained_battery>`: Disable sensors if the model's
   /// battery plugin charge reaches zero. Sensors that are in nested
   /// models are also affected.
+  /// - `<batch_sensors>`: True to update sensors that render the same kind
+  /// of output with the same resolution one after the other, such as GPU
+  /// lidars with the same rays and range, so the render passes of a batch
+  /// run back to back on the shared scene. Defaults to true.
+  /// - `<honor_always_on>`: Rendering sensors only generate data while
+  /// something is subscribed to them, and the scene is only updated and
+  /// rendered when one of those sensors is due. If this is true, sensors
+  /// with `<always_on>` set in their SDF generate data even without
+  /// subscribers. Defaults to false, because many worlds set `<always_on>`
+  /// on every sensor.
+  /// - `<camera_pass_count_per_gpu_flush>`: Number of camera render passes
+  /// that are submitted to the GPU before it's flushed. Larger values batch
+  /// more sensors per submission, at the cost of memory. Defaults to 6.
+  /// - `<incremental_pose_updates>`: If true, only the poses that are
+  /// marked as changed in the ECM are copied to the sensors' scene on each
+  /// update, so the cost of updating the scene scales with the number of
+  /// entities that move instead of the size of the world. Poses written
+  /// through component pointers without being marked as changed, which
+  /// the GUI also misses, aren't shown to the sensors, so only enable this
+  /// if every system that moves entities marks their poses as changed.
+  /// Defaults to false.
+  /// - `<share_materials>`: If true, visuals with identical materials, such
+  /// as copies of the same mesh, share a single rendering material so the
+  /// render engine can draw them as instanced batches. Material updates
+  /// from visual commands and transparency changes give a visual its own
+  /// copy first. Defaults to false.
+  /// - `<culling_distance>`: Models that are farther than this distance,
+  /// in meters, from every rendering sensor are hidden, so large worlds
+  /// only pay for what the sensors can actually see. The far clip distance
+  /// of each sensor also bounds its range. Defaults to 0, which disables
+  /// culling.
+  /// - `<actor_animation_culling>`: If true, the skeleton animation of
+  /// actors is only updated while they could be seen by a camera sensor.
+  /// Actors keep following their trajectories. Ignored while there are
+  /// rendering sensors other than cameras. Defaults to false.
+  /// - `<asynchronous>`: If true, simulation doesn't wait for sensors to
+  /// finish rendering. The scene is handed off to the rendering thread
+  /// whenever it's idle and sensors are due, and sensor data is stamped
+  /// with the simulation time of that hand-off, which may be later than
+  /// the time the sensor was due. This trades strict lockstep between
+  /// simulation and sensors for a higher real time factor. Defaults to
+  /// false.
+  /// - `<max_lag_steps>`: In asynchronous mode, the maximum number of
+  /// simulation iterations that rendering may lag behind simulation.
+  /// Simulation waits for rendering to finish once it's this far ahead.
+  /// Defaults to 10.
+  /// - `<creation_time_budget>`: Seconds that each rendering update may
+  /// spend creating new entities in the scene. Models with sensors are
+  /// created first, so the first sensor frames aren't delayed by creating
+  /// all of a large world, and the remaining models are created nearest
+  /// to the sensors first in the following updates. Until then, sensors
+  /// don't see them. Defaults to 0, which creates all new entities in the
+  /// same update.
+  ///
+  /// ## Topics
+  ///
+  /// - `/world/<world_name>/sensors/render_cost`: Render cost of each
+  /// sensor, published at most once per second as a gz::msgs::Diagnostics
+  /// message while there are subscribers. Each entry is named after the
+  /// scoped name of a sensor, its `elapsed` time is the average wall time
+  /// spent rendering and publishing one frame since the previous message,
+  /// and its `wall` time is the longest of those frames.
   ///
   /// \TODO(louise) Have one system for all sensors, or one per
   /// sensor / sensor type?
@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SharedMemoryState.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+#include <gz/plugin/Register.hh>
+
+#include "gz/sim/ComponentHandle.hh"
+#include "gz/sim/components/AngularVelocity.hh"
+#include "gz/sim/components/Joint.hh"
+#include "gz/sim/components/JointPosition.hh"
+#include "gz/sim/components/JointVelocity.hh"
+#include "gz/sim/components/Link.hh"
+#include "gz/sim/components/LinearVelocity.hh"
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/SharedStateRegion.hh"
+#include "gz/sim/Util.hh"
+#include "gz/sim/World.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+namespace
+{
+/// \brief An entity written to the region, with its components looked up
+/// once.
+struct TrackedEntity
+{
+  /// \brief Record with the fields that don't change between steps.
+  SharedStateEntity record;
+
+  /// \brief World pose of a link.
+  ComponentHandle<components::WorldPose> worldPose;
+
+  /// \brief Linear velocity of a link.
+  ComponentHandle<components::WorldLinearVelocity> worldLinVel;
+
+  /// \brief Angular velocity of a link.
+  ComponentHandle<components::WorldAngularVelocity> worldAngVel;
+
+  /// \brief Positions of a joint.
+  ComponentHandle<components::JointPosition> jointPosition;
+
+  /// \brief Velocities of a joint.
+  ComponentHandle<components::JointVelocity> jointVelocity;
+};
+
+/// \brief Copy a pose into a record.
+/// \param[in] _pose The pose.
+/// \param[out] _record Record to copy to.
+void setPose(const math::Pose3d &_pose, SharedStateEntity &_record)
+{
+  _record.pose[0] = _pose.Pos().X();
+  _record.pose[1] = _pose.Pos().Y();
+  _record.pose[2] = _pose.Pos().Z();
+  _record.pose[3] = _pose.Rot().W();
+  _record.pose[4] = _pose.Rot().X();
+  _record.pose[5] = _pose.Rot().Y();
+  _record.pose[6] = _pose.Rot().Z();
+}
+
+/// \brief Copy a vector into an array of a record.
+/// \param[in] _vector The vector.
+/// \param[out] _values Array to copy to.
+void setVector(const math::Vector3d &_vector, double (&_values)[3])
+{
+  _values[0] = _vector.X();
+  _values[1] = _vector.Y();
+  _values[2] = _vector.Z();
+}
+}
+
+/// \brief Private data class
+class gz::sim::systems::SharedMemoryStatePrivate
+{
+  /// \brief Start writing an entity.
+  /// \param[in] _entity The entity.
+  /// \param[in] _type Kind of entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \return The new tracked entity.
+  public: TrackedEntity &Track(Entity _entity, SharedStateEntityType _type,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Stop writing an entity.
+  /// \param[in] _entity The entity.
+  public: void Untrack(Entity _entity);
+
+  /// \brief Entities written to the region.
+  public: std::vector<TrackedEntity> entities;
+
+  /// \brief Index of each entity in entities.
+  public: std::unordered_map<Entity, std::size_t> indices;
+
+  /// \brief Frame written to the region, kept to reuse its memory.
+  public: SharedStateFrame frame;
+
+  /// \brief The region.
+  public: std::unique_ptr<SharedStateRegion> region;
+
+  /// \brief Whether to write models.
+  public: bool models{true};
+
+  /// \brief Whether to write links.
+  public: bool links{true};
+
+  /// \brief Whether to write joints.
+  public: bool joints{true};
+
+  /// \brief Iteration of the last frame written.
+  public: uint64_t lastIterations{std::numeric_limits<uint64_t>::max()};
+
+  /// \brief Entity set version of the last frame written.
+  public: uint64_t lastEntitySetVersion{0u};
+
+  /// \brief Whether a warning was printed because the frame didn't fit.
+  public: bool warnedTruncated{false};
+};
+
+//////////////////////////////////////////////////
+TrackedEntity &SharedMemoryStatePrivate::Track(Entity _entity,
+    SharedStateEntityType _type, const EntityComponentManager &_ecm)
+{
+  this->indices[_entity] = this->entities.size();
+  this->entities.emplace_back();
+  auto &tracked = this->entities.back();
+  tracked.record.entity = _entity;
+  tracked.record.parent = _ecm.ComponentData<components::ParentEntity>(
+      _entity).value_or(kNullEntity);
+  tracked.record.type = _type;
+  const auto name = _ecm.ComponentData<components::Name>(_entity).value_or(
+      std::string());
+  std::strncpy(tracked.record.name, name.c_str(),
+      sizeof(tracked.record.name) - 1u);
+  ++this->frame.entitySetVersion;
+  return tracked;
+}
+
+//////////////////////////////////////////////////
+void SharedMemoryStatePrivate::Untrack(Entity _entity)
+{
+  auto it = this->indices.find(_entity);
+  if (it == this->indices.end())
+    return;
+
+  // Move the last entity into the freed slot
+  const std::size_t index = it->second;
+  this->indices.erase(it);
+  if (index + 1u != this->entities.size())
+  {
+    this->entities[index] = std::move(this->entities.back());
+    this->indices[this->entities[index].record.entity] = index;
+  }
+  this->entities.pop_back();
+  ++this->frame.entitySetVersion;
+}
+
+//////////////////////////////////////////////////
+SharedMemoryState::SharedMemoryState()
+  : System(), dataPtr(std::make_unique<SharedMemoryStatePrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+SharedMemoryState::~SharedMemoryState() = default;
+
+//////////////////////////////////////////////////
+void SharedMemoryState::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  World world(_entity);
+  if (!world.Valid(_ecm))
+  {
+    gzerr << "SharedMemoryState should be attached to a world entity. "
+           << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  const auto maxEntities = _sdf->Get<int>("max_entities", 1024).first;
+  const auto maxJointValues = _sdf->Get<int>("max_joint_values", 4096).first;
+  if (maxEntities < 1 || maxJointValues < 0)
+  {
+    gzerr << "<max_entities> must be at least 1 and <max_joint_values> "
+           << "can't be negative, got [" << maxEntities << "] and ["
+           << maxJointValues << "]. Failed to initialize." << std::endl;
+    return;
+  }
+
+  this->dataPtr->models = _sdf->Get<bool>("models", true).first;
+  this->dataPtr->links = _sdf->Get<bool>("links", true).first;
+  this->dataPtr->joints = _sdf->Get<bool>("joints", true).first;
+
+  std::string defaultName{world.Name(_ecm).value_or("default")};
+  std::replace_if(defaultName.begin(), defaultName.end(),
+      [](unsigned char _c) { return !std::isalnum(_c); }, '_');
+  defaultName = "/gz_sim_state_" + defaultName;
+  auto name = _sdf->Get<std::string>("region_name", defaultName).first;
+  if (name.empty() || name[0] != '/')
+    name = "/" + name;
+
+  this->dataPtr->region = SharedStateRegion::Create(name,
+      static_cast<std::size_t>(maxEntities),
+      static_cast<std::size_t>(maxJointValues));
+  if (!this->dataPtr->region)
+  {
+    gzerr << "Failed to create shared memory region [" << name << "]."
+           << std::endl;
+    return;
+  }
+  this->dataPtr->frame.entities.reserve(
+      static_cast<std::size_t>(maxEntities));
+  this->dataPtr->frame.jointValues.reserve(
+      static_cast<std::size_t>(maxJointValues));
+
+  gzmsg << "SharedMemoryState writing to shared memory region [" << name
+         << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+void SharedMemoryState::PreUpdate(const UpdateInfo &,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("SharedMemoryState::PreUpdate");
+  if (!this->dataPtr->region)
+    return;
+
+  auto untrack = [this](const Entity &_entity, const auto *) -> bool
+  {
+    this->dataPtr->Untrack(_entity);
+    return true;
+  };
+  _ecm.EachRemoved<components::Model>(untrack);
+  _ecm.EachRemoved<components::Link>(untrack);
+  _ecm.EachRemoved<components::Joint>(untrack);
+
+  if (this->dataPtr->models)
+  {
+    _ecm.EachNew<components::Model>(
+        [&](const Entity &_entity, const components::Model *) -> bool
+        {
+          if (this->dataPtr->indices.count(_entity) == 0u)
+          {
+            this->dataPtr->Track(_entity, SharedStateEntityType::Model,
+                _ecm);
+          }
+          return true;
+        });
+  }
+
+  if (this->dataPtr->links)
+  {
+    _ecm.EachNew<components::Link>(
+        [&](const Entity &_entity, const components::Link *) -> bool
+        {
+          if (this->dataPtr->indices.count(_entity) > 0u)
+            return true;
+
+          // Physics only fills world states that exist
+          enableComponent<components::WorldPose>(_ecm, _entity);
+          enableComponent<components::WorldLinearVelocity>(_ecm, _entity);
+          enableComponent<components::WorldAngularVelocity>(_ecm, _entity);
+
+          auto &tracked = this->dataPtr->Track(_entity,
+              SharedStateEntityType::Link, _ecm);
+          tracked.worldPose = _ecm.Handle<components::WorldPose>(_entity);
+          tracked.worldLinVel =
+              _ecm.Handle<components::WorldLinearVelocity>(_entity);
+          tracked.worldAngVel =
+              _ecm.Handle<components::WorldAngularVelocity>(_entity);
+          return true;
+        });
+  }
+
+  if (this->dataPtr->joints)
+  {
+    _ecm.EachNew<components::Joint>(
+        [&](const Entity &_entity, const components::Joint *) -> bool
+        {
+          if (this->dataPtr->indices.count(_entity) > 0u)
+            return true;
+
+          enableComponent<components::JointPosition>(_ecm, _entity);
+          enableComponent<components::JointVelocity>(_ecm, _entity);
+
+          auto &tracked = this->dataPtr->Track(_entity,
+              SharedStateEntityType::Joint, _ecm);
+          tracked.jointPosition =
+              _ecm.Handle<components::JointPosition>(_entity);
+          tracked.jointVelocity =
+              _ecm.Handle<components::JointVelocity>(_entity);
+          return true;
+        });
+  }
+}
+
+//////////////////////////////////////////////////
+void SharedMemoryState::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("SharedMemoryState::PostUpdate");
+  auto &frame = this->dataPtr->frame;
+  if (!this->dataPtr->region ||
+      (_info.iterations == this->dataPtr->lastIterations &&
+       frame.entitySetVersion == this->dataPtr->lastEntitySetVersion))
+  {
+    return;
+  }
+  this->dataPtr->lastIterations = _info.iterations;
+  this->dataPtr->lastEntitySetVersion = frame.entitySetVersion;
+
+  frame.simTime = _info.simTime;
+  frame.iterations = _info.iterations;
+  frame.entities.resize(this->dataPtr->entities.size());
+  frame.jointValues.clear();
+  for (std::size_t i = 0; i < this->dataPtr->entities.size(); ++i)
+  {
+    auto &tracked = this->dataPtr->entities[i];
+    auto &record = frame.entities[i];
+    record = tracked.record;
+    switch (record.type)
+    {
+      case SharedStateEntityType::Model:
+      {
+        setPose(worldPose(record.entity, _ecm), record);
+        break;
+      }
+      case SharedStateEntityType::Link:
+      {
+        if (auto pose = tracked.worldPose.Get())
+          setPose(pose->Data(), record);
+        if (auto linVel = tracked.worldLinVel.Get())
+          setVector(linVel->Data(), record.linearVelocity);
+        if (auto angVel = tracked.worldAngVel.Get())
+          setVector(angVel->Data(), record.angularVelocity);
+        break;
+      }
+      case SharedStateEntityType::Joint:
+      {
+        auto position = tracked.jointPosition.Get();
+        if (!position)
+          break;
+        const auto &positions = position->Data();
+        record.jointDofs = static_cast<uint32_t>(positions.size());
+        record.jointOffset = frame.jointValues.size();
+        frame.jointValues.insert(frame.jointValues.end(), positions.begin(),
+            positions.end());
+
+        // Velocities line up with positions, even before physics sets them
+        const std::size_t start = frame.jointValues.size();
+        frame.jointValues.resize(start + positions.size(), 0.0);
+        if (auto velocity = tracked.jointVelocity.Get())
+        {
+          const auto &velocities = velocity->Data();
+          std::copy_n(velocities.begin(),
+              std::min(velocities.size(), positions.size()),
+              frame.jointValues.begin() + start);
+        }
+        break;
+      }
+    }
+  }
+
+  if (!this->dataPtr->region->Write(frame) &&
+      !this->dataPtr->warnedTruncated)
+  {
+    gzwarn << "[" << frame.entities.size() << "] entities and ["
+           << frame.jointValues.size() << "] joint values don't fit in "
+           << "shared memory region [" << this->dataPtr->region->Name()
+           << "], only the first ones are written. Increase <max_entities> "
+           << "or <max_joint_values>." << std::endl;
+    this->dataPtr->warnedTruncated = true;
+  }
+}
+
+GZ_ADD_PLUGIN(SharedMemoryState,
+              System,
+              SharedMemoryState::ISystemConfigure,
+              SharedMemoryState::ISystemPreUpdate,
+              SharedMemoryState::ISystemPostUpdate)
+
+GZ_ADD_PLUGIN_ALIAS(SharedMemoryState,
+                    "gz::sim::systems::SharedMemoryState")
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_SHARED_MEMORY_STATE_HH_
+#define GZ_SIM_SYSTEMS_SHARED_MEMORY_STATE_HH_
+
+#include <memory>
+#include <gz/sim/config.hh>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class SharedMemoryStatePrivate;
+
+  /// \brief A world system that writes the world poses and velocities of
+  /// models and links, and the positions and velocities of joints, to a
+  /// shared memory region after every step. Planners and controllers on
+  /// the same host read it with gz::sim::SharedStateRegion at the rate of
+  /// the simulation, without the latency of serializing and publishing
+  /// messages.
+  ///
+  /// Components are looked up once, when an entity is created, and the
+  /// frame is reused between steps, so writing doesn't allocate. A frame
+  /// is only written when the iteration or the set of entities changed, so
+  /// nothing is written while paused. Not available on Windows.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<region_name>`: Name of the shared memory region. Defaults to
+  /// `/gz_sim_state_<world name>`, with characters other than letters and
+  /// digits replaced by `_`.
+  ///
+  /// - `<max_entities>`: Number of entities the region can hold. Defaults
+  /// to 1024.
+  ///
+  /// - `<max_joint_values>`: Number of joint positions and velocities the
+  /// region can hold. Defaults to 4096.
+  ///
+  /// - `<models>`, `<links>`, `<joints>`: Whether to write each kind of
+  /// entity. All default to true.
+  ///
+  /// ## Example Usage
+  ///
+  /** \verbatim
+    <plugin filename="gz-sim-shared-memory-state-system"
+            name="gz::sim::systems::SharedMemoryState">
+      <region_name>/robot_state</region_name>
+      <models>false</models>
+    </plugin>
+   \endverbatim */
+  class SharedMemoryState
+      : public System,
+        public ISystemConfigure,
+        public ISystemPreUpdate,
+        public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: SharedMemoryState();
+
+    /// \brief Destructor
+    public: ~SharedMemoryState() override;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) override;
+
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) override;
+
+    // Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<SharedMemoryStatePrivate> dataPtr;
+  };
+  }
+}
+}
+}
+
+#endif
@@ -33,6 +33,10 @@ namespace systems
   class ThermalPrivate;
 
   /// \brief A thermal plugin that sets the temperature for the parent entity
+  ///
+  /// The temperature can be changed later by setting the Temperature or
+  /// TemperatureRange component and marking it as changed. Rendering picks
+  /// up the change once, for all thermal cameras.
   class Thermal:
     public System,
     public ISystemConfigure
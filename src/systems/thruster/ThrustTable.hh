@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_THRUSTER_THRUSTTABLE_HH_
+#define GZ_SIM_SYSTEMS_THRUSTER_THRUSTTABLE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gz/sim/config.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+namespace thruster
+{
+/// \brief Thrust and torque of a propeller as functions of its angular
+/// velocity, interpolated linearly between measured samples.
+///
+/// Lookups by angular velocity take constant time when the samples are
+/// evenly spaced, as tables generated from propeller diagrams usually are,
+/// and a binary search otherwise. Values outside of the table are those of
+/// its closest end.
+class ThrustTable
+{
+  /// \brief A measured sample.
+  public: struct Sample
+  {
+    /// \brief Angular velocity of the propeller [rad/s].
+    double angularVelocity{0.0};
+
+    /// \brief Thrust along the joint axis [N].
+    double thrust{0.0};
+
+    /// \brief Torque of the water on the propeller about the joint axis
+    /// [N m].
+    double torque{0.0};
+  };
+
+  /// \brief Set the samples.
+  /// \param[in] _samples At least two samples, sorted by strictly increasing
+  /// angular velocity.
+  /// \param[out] _error Reason the samples were rejected.
+  /// \return True if the samples are valid. Otherwise the table is left
+  /// empty.
+  public: bool Set(const std::vector<Sample> &_samples, std::string &_error)
+  {
+    this->angularVelocities.clear();
+    this->thrusts.clear();
+    this->torques.clear();
+    this->invertible = false;
+
+    if (_samples.size() < 2u)
+    {
+      _error = "a table needs at least 2 samples";
+      return false;
+    }
+    for (std::size_t i = 1u; i < _samples.size(); ++i)
+    {
+      if (!(_samples[i].angularVelocity > _samples[i - 1].angularVelocity))
+      {
+        _error = "angular velocities must be strictly increasing";
+        return false;
+      }
+    }
+
+    bool increasing{true};
+    bool decreasing{true};
+    for (std::size_t i = 0u; i < _samples.size(); ++i)
+    {
+      this->angularVelocities.push_back(_samples[i].angularVelocity);
+      this->thrusts.push_back(_samples[i].thrust);
+      this->torques.push_back(_samples[i].torque);
+      if (i > 0u)
+      {
+        increasing &= _samples[i].thrust > _samples[i - 1].thrust;
+        decreasing &= _samples[i].thrust < _samples[i - 1].thrust;
+      }
+    }
+    this->invertible = increasing || decreasing;
+
+    // Thrusts sorted in increasing order, for the inverse lookup
+    this->sortedThrusts = this->thrusts;
+    this->sortedAngularVelocities = this->angularVelocities;
+    if (decreasing)
+    {
+      std::reverse(this->sortedThrusts.begin(), this->sortedThrusts.end());
+      std::reverse(this->sortedAngularVelocities.begin(),
+          this->sortedAngularVelocities.end());
+    }
+
+    const double first = this->angularVelocities.front();
+    const double step = (this->angularVelocities.back() - first) /
+        static_cast<double>(this->angularVelocities.size() - 1u);
+    this->uniform = true;
+    for (std::size_t i = 0u; i < this->angularVelocities.size(); ++i)
+    {
+      const double expected = first + step * static_cast<double>(i);
+      this->uniform &= std::abs(this->angularVelocities[i] - expected) <=
+          1e-9 * step;
+    }
+    this->inverseStep = 1.0 / step;
+    return true;
+  }
+
+  /// \brief Check whether the table has samples.
+  /// \return True if it's empty.
+  public: bool Empty() const
+  {
+    return this->angularVelocities.empty();
+  }
+
+  /// \brief Check whether the thrust is strictly monotonic, so that the
+  /// angular velocity which gives a thrust can be looked up.
+  /// \return True if AngularVelocity can be used.
+  public: bool Invertible() const
+  {
+    return this->invertible;
+  }
+
+  /// \brief Get the thrust at an angular velocity.
+  /// \param[in] _angularVelocity Angular velocity [rad/s].
+  /// \return Thrust [N].
+  public: double Thrust(double _angularVelocity) const
+  {
+    return this->Interpolate(this->thrusts, _angularVelocity);
+  }
+
+  /// \brief Get the torque at an angular velocity.
+  /// \param[in] _angularVelocity Angular velocity [rad/s].
+  /// \return Torque [N m].
+  public: double Torque(double _angularVelocity) const
+  {
+    return this->Interpolate(this->torques, _angularVelocity);
+  }
+
+  /// \brief Get the angular velocity which gives a thrust. Only valid if the
+  /// table is invertible.
+  /// \param[in] _thrust Thrust [N].
+  /// \return Angular velocity [rad/s].
+  public: double AngularVelocity(double _thrust) const
+  {
+    if (this->Empty())
+      return 0.0;
+    const auto &x = this->sortedThrusts;
+    const auto &y = this->sortedAngularVelocities;
+    if (_thrust <= x.front())
+      return y.front();
+    if (_thrust >= x.back())
+      return y.back();
+    const std::size_t i = static_cast<std::size_t>(
+        std::upper_bound(x.begin(), x.end(), _thrust) - x.begin()) - 1u;
+    return lerp(x[i], x[i + 1], y[i], y[i + 1], _thrust);
+  }
+
+  /// \brief Interpolate values sampled at the angular velocities.
+  /// \param[in] _values Value at each angular velocity.
+  /// \param[in] _angularVelocity Angular velocity [rad/s].
+  /// \return The value.
+  private: double Interpolate(const std::vector<double> &_values,
+               double _angularVelocity) const
+  {
+    if (this->Empty())
+      return 0.0;
+    const auto &x = this->angularVelocities;
+    if (_angularVelocity <= x.front())
+      return _values.front();
+    if (_angularVelocity >= x.back())
+      return _values.back();
+
+    std::size_t i;
+    if (this->uniform)
+    {
+      i = std::min(static_cast<std::size_t>(
+          (_angularVelocity - x.front()) * this->inverseStep), x.size() - 2u);
+    }
+    else
+    {
+      i = static_cast<std::size_t>(std::upper_bound(x.begin(), x.end(),
+          _angularVelocity) - x.begin()) - 1u;
+    }
+    return lerp(x[i], x[i + 1], _values[i], _values[i + 1],
+        _angularVelocity);
+  }
+
+  /// \brief Interpolate linearly between two points.
+  /// \param[in] _x0 First abscissa.
+  /// \param[in] _x1 Second abscissa.
+  /// \param[in] _y0 Value at the first abscissa.
+  /// \param[in] _y1 Value at the second abscissa.
+  /// \param[in] _x Abscissa to interpolate at.
+  /// \return The value.
+  private: static double lerp(double _x0, double _x1, double _y0, double _y1,
+               double _x)
+  {
+    return _y0 + (_y1 - _y0) * (_x - _x0) / (_x1 - _x0);
+  }
+
+  /// \brief Angular velocity of each sample, increasing.
+  private: std::vector<double> angularVelocities;
+
+  /// \brief Thrust of each sample.
+  private: std::vector<double> thrusts;
+
+  /// \brief Torque of each sample.
+  private: std::vector<double> torques;
+
+  /// \brief Thrusts, increasing, for the inverse lookup.
+  private: std::vector<double> sortedThrusts;
+
+  /// \brief Angular velocities in the order of sortedThrusts.
+  private: std::vector<double> sortedAngularVelocities;
+
+  /// \brief True if the angular velocities are evenly spaced.
+  private: bool uniform{false};
+
+  /// \brief Inverse of the spacing of the angular velocities.
+  private: double inverseStep{0.0};
+
+  /// \brief True if the thrust is strictly monotonic.
+  private: bool invertible{false};
+};
+}
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "ThrustTable.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems::thruster;
+
+/////////////////////////////////////////////////
+TEST(ThrustTable, Invalid)
+{
+  ThrustTable table;
+  std::string error;
+  EXPECT_TRUE(table.Empty());
+  EXPECT_DOUBLE_EQ(0.0, table.Thrust(10.0));
+
+  EXPECT_FALSE(table.Set({{0.0, 1.0, 0.0}}, error));
+  EXPECT_FALSE(error.empty());
+  EXPECT_FALSE(table.Set({{1.0, 1.0, 0.0}, {1.0, 2.0, 0.0}}, error));
+  EXPECT_TRUE(table.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ThrustTable, Uniform)
+{
+  // Thrust of the Fossen model, sampled every 10 rad/s
+  const double k = 0.004 * 1000 * std::pow(0.2, 4);
+  std::vector<ThrustTable::Sample> samples;
+  for (int i = -10; i <= 10; ++i)
+  {
+    const double w = 10.0 * i;
+    samples.push_back({w, k * std::abs(w) * w, -0.1 * w});
+  }
+  ThrustTable table;
+  std::string error;
+  ASSERT_TRUE(table.Set(samples, error)) << error;
+  EXPECT_TRUE(table.Invertible());
+
+  // Exact at the samples, linear in between
+  EXPECT_NEAR(k * 900, table.Thrust(30.0), 1e-12);
+  EXPECT_NEAR(0.5 * k * (900 + 1600), table.Thrust(35.0), 1e-12);
+  EXPECT_NEAR(-3.5, table.Torque(35.0), 1e-12);
+
+  // Clamped outside of the table
+  EXPECT_DOUBLE_EQ(k * 10000, table.Thrust(500.0));
+  EXPECT_DOUBLE_EQ(-k * 10000, table.Thrust(-500.0));
+
+  // The inverse lookup gives back the angular velocity
+  for (double w : {-95.0, -42.0, 0.0, 3.0, 61.0})
+    EXPECT_NEAR(w, table.AngularVelocity(table.Thrust(w)), 1e-9) << w;
+  EXPECT_DOUBLE_EQ(100.0, table.AngularVelocity(1e6));
+}
+
+/////////////////////////////////////////////////
+TEST(ThrustTable, Irregular)
+{
+  // Finer samples near zero, and a propeller pushing backwards
+  ThrustTable table;
+  std::string error;
+  ASSERT_TRUE(table.Set({{-100, 40, 0}, {-10, 1, 0}, {0, 0, 0},
+      {10, -1, 0}, {25, -6, 0}, {100, -50, 0}}, error)) << error;
+  EXPECT_TRUE(table.Invertible());
+  EXPECT_NEAR(-0.5, table.Thrust(5.0), 1e-12);
+  EXPECT_NEAR(-6.0 - 44.0 / 15.0, table.Thrust(30.0), 1e-12);
+  EXPECT_NEAR(5.0, table.AngularVelocity(-0.5), 1e-12);
+  EXPECT_NEAR(-55.0, table.AngularVelocity(20.5), 1e-12);
+
+  // A thrust which doesn't always increase can't be inverted
+  ASSERT_TRUE(table.Set({{0, 0, 0}, {10, 2, 0}, {20, 1, 0}}, error));
+  EXPECT_FALSE(table.Invertible());
+  EXPECT_NEAR(1.5, table.Thrust(15.0), 1e-12);
+}
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include <gz/msgs/double.pb.h>
 
@@ -42,11 +43,13 @@
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/ComponentHandle.hh"
 #include "gz/sim/Link.hh"
 #include "gz/sim/Model.hh"
 #include "gz/sim/Util.hh"
 
 #include "Thruster.hh"
+#include "ThrustTable.hh"
 
 using namespace gz;
 using namespace sim;
@@ -137,6 +140,10 @@ class gz::sim::systems::ThrusterPrivateData
   /// calculation of the thrust coefficient.
   public: double alpha2 = 0;
 
+  /// \brief Measured thrust and torque of the propeller. If not empty, used
+  /// instead of the thrust coefficient.
+  public: thruster::ThrustTable thrustTable;
+
   /// \brief Density of fluid in kgm^-3, default: 1000kgm^-3
   public: double fluidDensity = 1000;
 
@@ -170,6 +177,20 @@ class gz::sim::systems::ThrusterPrivateData
   /// \brief Has the battery consumption being initialized.
   public: bool batteryInitialized = false;
 
+  /// \brief World pose of the link.
+  public: ComponentHandle<components::WorldPose> linkWorldPose;
+
+  /// \brief World angular velocity of the link.
+  public: ComponentHandle<components::WorldAngularVelocity>
+      linkWorldAngularVelocity;
+
+  /// \brief World linear velocity of the link.
+  public: ComponentHandle<components::WorldLinearVelocity>
+      linkWorldLinearVelocity;
+
+  /// \brief Velocity command of the joint, if using velocity control.
+  public: ComponentHandle<components::JointVelocityCmd> jointVelocityCmd;
+
   /// \brief Callback for handling thrust update
   public: void OnCmdThrust(const msgs::Double &_msg);
 
@@ -178,6 +199,12 @@ class gz::sim::systems::ThrusterPrivateData
   ///                 the deadband
   public: void OnDeadbandEnable(const msgs::Boolean &_msg);
 
+  /// \brief Load the thrust table from SDF.
+  /// \param[in] _sdf The <thrust_table> element.
+  /// \return True if the table is valid.
+  public: bool LoadThrustTable(
+      const std::shared_ptr<const sdf::Element> &_sdf);
+
   /// \brief Recalculates and updates the thrust coefficient.
   public: void UpdateThrustCoefficient();
 
@@ -260,6 +287,15 @@ void Thruster::Configure(
     this->dataPtr->fluidDensity = _sdf->Get<double>("fluid_density");
   }
 
+  // Get the thrust table, which replaces the coefficients
+  if (_sdf->HasElement("thrust_table") &&
+      !this->dataPtr->LoadThrustTable(
+      _sdf->FindElement("thrust_table")))
+  {
+    gzerr << "Ignoring <thrust_table>, using the thrust coefficient instead."
+          << std::endl;
+  }
+
   // Get the operation mode
   if (_sdf->HasElement("use_angvel_cmd"))
   {
@@ -426,6 +462,21 @@ void Thruster::Configure(
       this->dataPtr->linkEntity);
   enableComponent<components::WorldLinearVelocity>(_ecm,
       this->dataPtr->linkEntity);
+  if (!_ecm.Component<components::WorldPose>(this->dataPtr->linkEntity))
+  {
+    _ecm.CreateComponent(this->dataPtr->linkEntity,
+        components::WorldPose(worldPose(this->dataPtr->linkEntity, _ecm)));
+  }
+
+  // Keep pointers to the components read and written every step
+  this->dataPtr->linkWorldPose =
+      _ecm.Handle<components::WorldPose>(this->dataPtr->linkEntity);
+  this->dataPtr->linkWorldAngularVelocity =
+      _ecm.Handle<components::WorldAngularVelocity>(
+      this->dataPtr->linkEntity);
+  this->dataPtr->linkWorldLinearVelocity =
+      _ecm.Handle<components::WorldLinearVelocity>(
+      this->dataPtr->linkEntity);
 
   double minThrustCmd = this->dataPtr->cmdMin;
   double maxThrustCmd = this->dataPtr->cmdMax;
@@ -494,6 +545,14 @@ void Thruster::Configure(
   else
   {
     gzdbg << "Using velocity control for propeller joint." << std::endl;
+    if (!_ecm.Component<components::JointVelocityCmd>(
+        this->dataPtr->jointEntity))
+    {
+      _ecm.CreateComponent(this->dataPtr->jointEntity,
+          components::JointVelocityCmd({0.0}));
+    }
+    this->dataPtr->jointVelocityCmd =
+        _ecm.Handle<components::JointVelocityCmd>(this->dataPtr->jointEntity);
   }
 
   // Get power load and battery name info
@@ -558,9 +617,52 @@ void ThrusterPrivateData::OnCmdAngVel(const gz::msgs::Double &_msg)
   this->thrust = this->AngularVelToThrust(this->propellerAngVel);
 }
 
+/////////////////////////////////////////////////
+bool ThrusterPrivateData::LoadThrustTable(
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  std::vector<thruster::ThrustTable::Sample> samples;
+  for (auto entry = _sdf->FindElement("entry"); entry;
+       entry = entry->GetNextElement("entry"))
+  {
+    if (!entry->HasElement("angular_velocity") ||
+        !entry->HasElement("thrust"))
+    {
+      gzerr << "Each <entry> of <thrust_table> needs an <angular_velocity> "
+            << "and a <thrust>." << std::endl;
+      return false;
+    }
+    thruster::ThrustTable::Sample sample;
+    sample.angularVelocity = entry->Get<double>("angular_velocity");
+    sample.thrust = entry->Get<double>("thrust");
+    sample.torque = entry->Get<double>("torque", 0.0).first;
+    samples.push_back(sample);
+  }
+
+  std::string error;
+  if (!this->thrustTable.Set(samples, error))
+  {
+    gzerr << "Invalid <thrust_table>: " << error << "." << std::endl;
+    return false;
+  }
+  // Thrust commands and the PID limits need the angular velocity which gives
+  // a thrust
+  if (!this->thrustTable.Invertible())
+  {
+    gzerr << "Invalid <thrust_table>: the thrust must strictly increase or "
+          << "decrease with the angular velocity." << std::endl;
+    this->thrustTable.Set({}, error);
+    return false;
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 double ThrusterPrivateData::ThrustToAngularVec(double _thrust)
 {
+  if (!this->thrustTable.Empty())
+    return this->thrustTable.AngularVelocity(_thrust);
+
   // Only update if the thrust coefficient was not set by configuration
   // and angular velocity is not zero. Some velocity is needed to calculate
   // the thrust coefficient otherwise it will never start moving.
@@ -592,6 +694,9 @@ void ThrusterPrivateData::UpdateThrustCoefficient()
 /////////////////////////////////////////////////
 double ThrusterPrivateData::AngularVelToThrust(double _angVel)
 {
+  if (!this->thrustTable.Empty())
+    return this->thrustTable.Thrust(_angVel);
+
   // Thrust is proportional to the Rotation Rate squared
   // See Thor I Fossen's  "Guidance and Control of ocean vehicles" p. 246
   return this->thrustCoefficient * pow(this->propellerDiameter, 4)
@@ -694,12 +799,11 @@ void Thruster::PreUpdate(
 
   gz::sim::Link link(this->dataPtr->linkEntity);
 
-
-  auto pose = worldPose(this->dataPtr->linkEntity, _ecm);
-
   // TODO(arjo129): add logic for custom coordinate frame
   // Convert joint axis to the world frame
-  const auto linkWorldPose = worldPose(this->dataPtr->linkEntity, _ecm);
+  auto worldPoseComp = this->dataPtr->linkWorldPose.Get();
+  const auto linkWorldPose = worldPoseComp ? worldPoseComp->Data() :
+      worldPose(this->dataPtr->linkEntity, _ecm);
   auto jointWorldPose = linkWorldPose * this->dataPtr->jointPose;
   auto unitVector =
       jointWorldPose.Rot().RotateVector(this->dataPtr->jointAxis).Normalize();
@@ -726,9 +830,13 @@ void Thruster::PreUpdate(
   msgs::Double angvel;
   // PID control
   double torque = 0.0;
+  double propellerAngVel = desiredPropellerAngVel;
   if (!this->dataPtr->velocityControl)
   {
-    auto currentAngular = (link.WorldAngularVelocity(_ecm))->Dot(unitVector);
+    auto angularVelComp = this->dataPtr->linkWorldAngularVelocity.Get();
+    auto currentAngular = angularVelComp ?
+        angularVelComp->Data().Dot(unitVector) : 0.0;
+    propellerAngVel = currentAngular;
     auto angularError = currentAngular - desiredPropellerAngVel;
     if (abs(angularError) > 0.1)
     {
@@ -740,8 +848,19 @@ void Thruster::PreUpdate(
   // Velocity control
   else
   {
-    _ecm.SetComponentData<gz::sim::components::JointVelocityCmd>(
-      this->dataPtr->jointEntity, {desiredPropellerAngVel});
+    auto velocityCmdComp = this->dataPtr->jointVelocityCmd.Get();
+    if (velocityCmdComp)
+    {
+      velocityCmdComp->Data() = {desiredPropellerAngVel};
+      _ecm.SetChanged(this->dataPtr->jointEntity,
+          components::JointVelocityCmd::typeId,
+          ComponentState::PeriodicChange);
+    }
+    else
+    {
+      _ecm.SetComponentData<gz::sim::components::JointVelocityCmd>(
+        this->dataPtr->jointEntity, {desiredPropellerAngVel});
+    }
     angvel.set_data(desiredPropellerAngVel);
   }
 
@@ -755,17 +874,22 @@ void Thruster::PreUpdate(
     force.set_data(desiredThrust);
     this->dataPtr->pub.Publish(force);
   }
+  // Torque of the water on the propeller, if measured
+  if (!this->dataPtr->thrustTable.Empty())
+    torque += this->dataPtr->thrustTable.Torque(propellerAngVel);
+
   // Force: thrust
   // Torque: propeller rotation, if using PID
   link.AddWorldWrench(
     _ecm,
+    _ecm.Wrenches(),
     unitVector * desiredThrust,
     unitVector * torque);
 
   // Update the LinearVelocity of the vehicle
-  this->dataPtr->linearVelocity =
-      _ecm.Component<components::WorldLinearVelocity>(
-      this->dataPtr->linkEntity)->Data().Length();
+  auto linearVelComp = this->dataPtr->linkWorldLinearVelocity.Get();
+  if (linearVelComp)
+    this->dataPtr->linearVelocity = linearVelComp->Data().Length();
 }
 
 /////////////////////////////////////////////////
@@ -73,6 +73,25 @@ namespace systems
   ///       (fluid_density * thrust_coefficient * propeller_diameter ^ 4))
   ///   ```
   ///   where omega is the propeller's angular velocity in rad/s.
+  /// - `<thrust_table>`: Thrust and torque measured at several angular
+  ///   velocities of the propeller, used instead of the thrust coefficient
+  ///   and the fluid density. Each `<entry>` has an `<angular_velocity>` in
+  ///   rad/s, a `<thrust>` in N and an optional `<torque>` of the water on the
+  ///   propeller about the joint axis in Nm, defaulting to 0. Entries must be
+  ///   sorted by increasing angular velocity, and the thrust must strictly
+  ///   increase or decrease with it. Values are interpolated linearly, and
+  ///   looked up in constant time when the angular velocities are evenly
+  ///   spaced. [Optional]
+  ///   ```
+  ///   <thrust_table>
+  ///     <entry>
+  ///       <angular_velocity>-30</angular_velocity>
+  ///       <thrust>-36</thrust>
+  ///       <torque>0.4</torque>
+  ///     </entry>
+  ///     ...
+  ///   </thrust_table>
+  ///   ```
   /// - `<velocity_control>`: If true, use joint velocity commands to rotate the
   ///   propeller. If false, use a PID controller to apply wrenches directly to
   ///   the propeller link instead. [Optional, defaults to false].
@@ -29,7 +29,7 @@
 #include <sdf/Element.hh>
 
 #include "gz/sim/components/ContactSensor.hh"
-#include "gz/sim/components/ContactSensorData.hh"
+#include "gz/sim/components/ContactBuffer.hh"
 #include "gz/sim/components/Collision.hh"
 #include "gz/sim/components/Link.hh"
 #include "gz/sim/components/Name.hh"
@@ -148,7 +148,7 @@ void TouchPluginPrivate::Load(const EntityComponentManager &_ecm,
   this->AddTargetEntities(_ecm, potentialEntities);
 
   // Create a list of collision entities that have been marked as contact
-  // sensors in this model. These are collisions that have a ContactSensorData
+  // sensors in this model. These are collisions that have a ContactBuffer
   // component
   auto allLinks =
       _ecm.ChildrenByComponents(this->model.Entity(), components::Link());
@@ -160,7 +160,7 @@ void TouchPluginPrivate::Load(const EntityComponentManager &_ecm,
     for (const Entity colEntity : linkCollisions)
     {
       if (_ecm.EntityHasComponentType(colEntity,
-                                      components::ContactSensorData::typeId))
+                                      components::ContactBuffer::typeId))
       {
         this->collisionEntities.push_back(colEntity);
       }
@@ -269,18 +269,18 @@ void TouchPluginPrivate::Update(const UpdateInfo &_info,
   // between the target entity and this model
   for (const Entity colEntity : this->collisionEntities)
   {
-    auto *contacts = _ecm.Component<components::ContactSensorData>(colEntity);
+    auto *contacts = _ecm.Component<components::ContactBuffer>(colEntity);
     if (contacts)
     {
       // Check if the contacts include one of the target entities.
-      for (const auto &contact : contacts->Data().contact())
+      for (const auto &pair : contacts->Data().pairs)
       {
         bool col1Target = std::binary_search(this->targetEntities.begin(),
             this->targetEntities.end(),
-            contact.collision1().id());
+            colEntity);
         bool col2Target = std::binary_search(this->targetEntities.begin(),
             this->targetEntities.end(),
-            contact.collision2().id());
+            pair.collision2);
         if (col1Target || col2Target)
         {
           touching = true;
@@ -17,17 +17,19 @@
 
 #include "TrackController.hh"
 
+#include <chrono>
 #include <limits>
 #include <mutex>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 
 #include <gz/msgs/double.pb.h>
 #include <gz/msgs/marker.pb.h>
 #include <gz/msgs/odometry.pb.h>
 #include <gz/msgs/Utility.hh>
 
+#include <gz/common/Profiler.hh>
+
 #include <gz/math/eigen3.hh>
 #include <gz/math/SpeedLimiter.hh>
 #include <gz/math/Helpers.hh>
@@ -134,13 +136,36 @@ class gz::sim::systems::TrackControllerPrivate
   public: Model model;
   /// \brief Entity of the link this track is attached to.
   public: Entity linkEntity {kNullEntity};
-  /// \brief Entities of all collision elements of the track's link.
-  public: std::unordered_set<Entity> trackCollisions;
-
-  /// \brief World pose of the track's link.
-  public: math::Pose3d linkWorldPose;
-  /// \brief World poses of all collision elements of the track's link.
-  public: std::unordered_map<Entity, math::Pose3d> collisionsWorldPose;
+  /// \brief Per-collision data cached once per step for the contact
+  /// callbacks.
+  public: struct TrackCollision
+  {
+    /// \brief World position of the collision.
+    math::Vector3d worldPosition;
+
+    /// \brief Whether the world position has been cached yet.
+    bool hasPose{false};
+  };
+
+  /// \brief All collision elements of the track's link. A single lookup
+  /// tells whether a contact involves the track and gives its cached data.
+  public: std::unordered_map<Entity, TrackCollision> trackCollisions;
+
+  /// \brief World orientation of the track, updated once per step.
+  public: math::Quaterniond trackWorldRot;
+  /// \brief Y axis of the track in world coordinates, updated once per step.
+  public: math::Vector3d trackYAxisGlobal;
+  /// \brief Center of rotation used by the contact callbacks during this
+  /// step, copied from centerOfRotation so that they don't need to lock.
+  public: math::Vector3d stepCenterOfRotation
+    {math::Vector3d::Zero * math::INF_D};
+
+  /// \brief Number of contacts customized during this step, only counted in
+  /// debug mode.
+  public: uint64_t stepContacts{0};
+  /// \brief Time spent customizing contacts during this step, only measured
+  /// in debug mode.
+  public: std::chrono::steady_clock::duration stepContactsTime{0};
 
   /// \brief Track position
   public: double position {0};
@@ -399,6 +424,7 @@ void TrackController::Configure(const Entity &_entity,
 void TrackController::PreUpdate(
   const UpdateInfo& _info, EntityComponentManager& _ecm)
 {
+  GZ_PROFILE("TrackController::PreUpdate");
   _ecm.EachNew<components::Collision, components::Name,
                components::ParentEntity>(
     [&](const Entity & _entity,
@@ -424,11 +450,18 @@ void TrackController::PreUpdate(
     return;
   }
 
-  // Cache poses
-  this->dataPtr->linkWorldPose = worldPose(this->dataPtr->linkEntity, _ecm);
-  for (auto& collisionEntity : this->dataPtr->trackCollisions)
-    this->dataPtr->collisionsWorldPose[collisionEntity] =
-      worldPose(collisionEntity, _ecm);
+  // Cache everything the contact callbacks need which doesn't depend on the
+  // contact itself, so that they only do the per-contact math
+  const auto linkWorldPose = worldPose(this->dataPtr->linkEntity, _ecm);
+  this->dataPtr->trackWorldRot =
+    linkWorldPose.Rot() * this->dataPtr->trackOrientation;
+  this->dataPtr->trackYAxisGlobal =
+    this->dataPtr->trackWorldRot.RotateVector(math::Vector3d::UnitY);
+  for (auto& [collisionEntity, collision] : this->dataPtr->trackCollisions)
+  {
+    collision.worldPosition = worldPose(collisionEntity, _ecm).Pos();
+    collision.hasPose = true;
+  }
 
   std::chrono::steady_clock::duration lastCommandTimeCopy;
   {
@@ -439,6 +472,7 @@ void TrackController::PreUpdate(
       this->dataPtr->hasNewCommand = false;
     }
     lastCommandTimeCopy = this->dataPtr->lastCommandTime;
+    this->dataPtr->stepCenterOfRotation = this->dataPtr->centerOfRotation;
 
     // Compute limited velocity command
     this->dataPtr->limitedVelocity = this->dataPtr->velocity;
@@ -466,6 +500,8 @@ void TrackController::PreUpdate(
   {
     // Reset debug marker ID
     this->dataPtr->markerId = 1;
+    this->dataPtr->stepContacts = 0;
+    this->dataPtr->stepContactsTime = std::chrono::steady_clock::duration(0);
   }
 }
 
@@ -473,10 +509,20 @@ void TrackController::PreUpdate(
 void TrackController::PostUpdate(const UpdateInfo &_info,
     const EntityComponentManager & /*_ecm*/)
 {
+  GZ_PROFILE("TrackController::PostUpdate");
   // Nothing left to do if paused.
   if (_info.paused)
     return;
 
+  if (this->dataPtr->debug && this->dataPtr->stepContacts > 0)
+  {
+    gzdbg << "Link: " << this->dataPtr->linkName << " customized "
+          << this->dataPtr->stepContacts << " contacts in "
+          << std::chrono::duration<double, std::micro>(
+               this->dataPtr->stepContactsTime).count()
+          << " us" << std::endl;
+  }
+
   // Throttle publishing
   auto diff = _info.simTime - this->dataPtr->lastOdometryPubTime;
   if (diff < this->dataPtr->odometryPubPeriod)
@@ -543,8 +589,21 @@ void TrackControllerPrivate::ComputeSurfaceProperties(
   F::ContactSurfaceParams<P>& _params
   )
 {
+  GZ_PROFILE("TrackController::ComputeSurfaceProperties");
   using math::eigen3::convert;
 
+  // Every track receives every customized contact of the world, so reject
+  // the contacts of other entities with as few lookups as possible
+  auto trackCollisionIt = this->trackCollisions.find(_collision1);
+  const auto isCollision1Track = trackCollisionIt !=
+    this->trackCollisions.end();
+  if (!isCollision1Track)
+  {
+    trackCollisionIt = this->trackCollisions.find(_collision2);
+    if (trackCollisionIt == this->trackCollisions.end())
+      return;
+  }
+
   if (!_normal)
   {
     static bool informed = false;
@@ -557,46 +616,29 @@ void TrackControllerPrivate::ComputeSurfaceProperties(
     return;
   }
 
-  const auto isCollision1Track = this->trackCollisions.find(_collision1) !=
-    this->trackCollisions.end();
-  const auto isCollision2Track = this->trackCollisions.find(_collision2) !=
-    this->trackCollisions.end();
-  if (!isCollision1Track && !isCollision2Track)
+  // In case we have not yet cached the collision pose, skip this iteration
+  const auto& collision = trackCollisionIt->second;
+  if (!collision.hasPose)
     return;
 
-  const auto trackCollision = isCollision1Track ? _collision1 : _collision2;
+  const auto start = this->debug ?
+    std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
 
   auto contactNormal = _normal.value();
 
-  // In case we have not yet cached the collision pose, skip this iteration
-  if (this->collisionsWorldPose.find(trackCollision) ==
-      this->collisionsWorldPose.end())
-    return;
-  const auto& collisionPose = this->collisionsWorldPose[trackCollision];
-
   // Flip the contact normal if it points outside the track collision
-  if (contactNormal.Dot(collisionPose.Pos() - _point) < 0)
+  if (contactNormal.Dot(collision.worldPosition - _point) < 0)
     contactNormal = -contactNormal;
 
-  const auto trackWorldRot = this->linkWorldPose.Rot() * this->trackOrientation;
-  const auto trackYAxisGlobal =
-    trackWorldRot.RotateVector(math::Vector3d::UnitY);
-
   // Vector tangent to the belt pointing in the belt's movement direction
   // The belt's bottom moves backwards when the robot should move forward!
-  auto beltDirection = contactNormal.Cross(trackYAxisGlobal);
+  auto beltDirection = contactNormal.Cross(this->trackYAxisGlobal);
 
   if (this->limitedVelocity < 0)
     beltDirection = -beltDirection;
 
-  math::Vector3d cor;
-  {
-    std::lock_guard<std::mutex> lock(this->cmdMutex);
-    cor = this->centerOfRotation;
-  }
-
   const auto frictionDirection = this->ComputeFrictionDirection(
-    cor, _point, contactNormal, beltDirection);
+    this->stepCenterOfRotation, _point, contactNormal, beltDirection);
 
   _params.firstFrictionalDirection =
     convert(isCollision1Track ? frictionDirection : -frictionDirection);
@@ -610,6 +652,10 @@ void TrackControllerPrivate::ComputeSurfaceProperties(
 
   if (this->debug)
   {
+    // Measured before the debug output, which is much slower than the rest
+    ++this->stepContacts;
+    this->stepContactsTime += std::chrono::steady_clock::now() - start;
+
     gzdbg << "Link: " << linkName << std::endl;
     gzdbg << "- is collision 1 track " << (isCollision1Track ? "1" : "0")
            << std::endl;
@@ -619,8 +665,9 @@ void TrackControllerPrivate::ComputeSurfaceProperties(
     gzdbg << "- surface motion       " << surfaceMotion << std::endl;
     gzdbg << "- contact point        " << convert(_point) << std::endl;
     gzdbg << "- contact normal       " << contactNormal << std::endl;
-    gzdbg << "- track rot            " << trackWorldRot << std::endl;
-    gzdbg << "- track Y              " << trackYAxisGlobal << std::endl;
+    gzdbg << "- track rot            " << this->trackWorldRot << std::endl;
+    gzdbg << "- track Y              " << this->trackYAxisGlobal
+           << std::endl;
     gzdbg << "- belt direction       " << beltDirection << std::endl;
 
     this->debugMarker.set_id(++this->markerId);
@@ -692,7 +739,7 @@ void TrackControllerPrivate::RegisterCollision(EntityComponentManager& _ecm,
   if (_link != this->linkEntity)
     return;
 
-  this->trackCollisions.insert(_entity);
+  this->trackCollisions.emplace(_entity, TrackCollision());
 
   _ecm.SetComponentData<components::EnableContactSurfaceCustomization>(
     _entity, true);
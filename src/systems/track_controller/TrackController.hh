@@ -66,7 +66,9 @@ namespace systems
   /// - `<link>`: Name of the link the controller controls. Required parameter.
   ///
   /// - `<debug>`: If 1, the system will output debugging info and
-  ///   visualizations. The default value is 0.
+  ///   visualizations, including the number of contacts customized in each
+  ///   step and the time spent on them. The default value is 0. The contact
+  ///   callbacks are also instrumented for the profiler.
   ///
   /// - `<track_orientation>`: Orientation of the track relative to the link.
   ///   It is assumed that the track moves along the +x direction of the
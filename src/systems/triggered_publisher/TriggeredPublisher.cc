@@ -30,8 +30,11 @@
 #pragma warning(pop)
 #endif
 
+#include <cmath>
 #include <limits>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <gz/common/Profiler.hh>
 #include <gz/common/Util.hh>
@@ -97,6 +100,9 @@ class systems::InputMatcher
   /// \brief State of the matcher
   protected: bool valid{false};
 
+  /// \brief Tolerance for float comparisons, negative until it's set
+  protected: double tolerance{-1.0};
+
   /// \brief Field comparator used by MessageDifferencer. This is where
   /// tolerance for float comparisons is set
   protected: google::protobuf::util::DefaultFieldComparator comparator;
@@ -163,9 +169,37 @@ class FieldMatcher : public InputMatcher
                        const std::string &_fieldName,
                        const std::string &_fieldString);
 
+  /// \brief Constructor of a matcher which matches when a numeric field is
+  /// within a range.
+  /// \param[in] _msgType Input message type
+  /// \param[in] _logicType Determines what the returned value of Match() would
+  /// be on a successful comparison. If this is false, a successful match would
+  /// return false.
+  /// \param[in] _fieldName Name of the field to compare
+  /// \param[in] _min Minimum value of the field, inclusive
+  /// \param[in] _max Maximum value of the field, inclusive
+  public: FieldMatcher(const std::string &_msgType, bool _logicType,
+                       const std::string &_fieldName, double _min,
+                       double _max);
+
   // Documentation inherited
   public: bool DoMatch(const transport::ProtoMsg &_input) const override;
 
+  /// \brief Compare the field of the matcher and input messages directly
+  /// through reflection, if it's a singular scalar field.
+  /// \param[in] _input Message holding the field in the input message
+  /// \return True if the fields are equal.
+  protected: bool CompareScalar(const transport::ProtoMsg &_input) const;
+
+  /// \brief Get the value of a numeric field as a double.
+  /// \param[in] _msg Message holding the field
+  /// \param[in] _fieldDesc Field descriptor
+  /// \param[out] _value Value of the field
+  /// \return False if the field isn't a singular numeric field
+  protected: static bool NumericValue(const transport::ProtoMsg &_msg,
+                 const google::protobuf::FieldDescriptor *_fieldDesc,
+                 double &_value);
+
   /// \brief Helper function to find a subfield inside the message based on the
   /// given field name.
   /// \param[in] _msg The message containing the subfield
@@ -190,6 +224,23 @@ class FieldMatcher : public InputMatcher
   /// \brief Field descriptor of the field compared by this matcher
   protected: std::vector<const google::protobuf::FieldDescriptor *>
                  fieldDescMatcher;
+
+  /// \brief Submessage of matchMsg holding the compared field
+  protected: const transport::ProtoMsg *subMsgMatcher{nullptr};
+
+  /// \brief True if the field is a singular scalar field, which is compared
+  /// directly instead of with the MessageDifferencer
+  protected: bool scalar{false};
+
+  /// \brief True if this matcher checks if a numeric field is within
+  /// [rangeMin, rangeMax]
+  protected: bool range{false};
+
+  /// \brief Minimum value of the field for range matchers
+  protected: double rangeMin{-std::numeric_limits<double>::infinity()};
+
+  /// \brief Maximum value of the field for range matchers
+  protected: double rangeMax{std::numeric_limits<double>::infinity()};
 };
 
 //////////////////////////////////////////////////
@@ -216,6 +267,7 @@ void InputMatcher::SetTolerance(double _tol)
 {
   this->comparator.SetDefaultFractionAndMargin(
       std::numeric_limits<double>::min(), _tol);
+  this->tolerance = _tol;
 }
 
 //////////////////////////////////////////////////
@@ -306,9 +358,132 @@ FieldMatcher::FieldMatcher(const std::string &_msgType, bool _logicType,
     return;
   }
 
+  this->subMsgMatcher = matcherSubMsg;
+  this->scalar = !this->fieldDescMatcher.back()->is_repeated() &&
+      google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE !=
+      this->fieldDescMatcher.back()->cpp_type();
+  this->valid = true;
+}
+
+//////////////////////////////////////////////////
+FieldMatcher::FieldMatcher(const std::string &_msgType, bool _logicType,
+                           const std::string &_fieldName, double _min,
+                           double _max)
+    : InputMatcher(_msgType),
+      logicType(_logicType),
+      fieldName(_fieldName),
+      range(true),
+      rangeMin(_min),
+      rangeMax(_max)
+{
+  if (nullptr == this->matchMsg || !this->matchMsg->IsInitialized())
+    return;
+
+  transport::ProtoMsg *matcherSubMsg{nullptr};
+  if (!FindFieldSubMessage(this->matchMsg.get(), _fieldName,
+                          this->fieldDescMatcher, &matcherSubMsg) ||
+      this->fieldDescMatcher.empty() || nullptr == matcherSubMsg)
+  {
+    return;
+  }
+
+  double value;
+  if (!NumericValue(*matcherSubMsg, this->fieldDescMatcher.back(), value))
+  {
+    gzerr << "Range matcher for field [" << this->fieldName
+           << "] of input message type [" << _msgType
+           << "] requires a singular numeric field\n";
+    return;
+  }
+
   this->valid = true;
 }
 
+//////////////////////////////////////////////////
+bool FieldMatcher::NumericValue(const transport::ProtoMsg &_msg,
+    const google::protobuf::FieldDescriptor *_fieldDesc, double &_value)
+{
+  if (_fieldDesc->is_repeated())
+    return false;
+
+  auto *refl = _msg.GetReflection();
+  switch (_fieldDesc->cpp_type())
+  {
+    case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+      _value = refl->GetDouble(_msg, _fieldDesc);
+      return true;
+    case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+      _value = refl->GetFloat(_msg, _fieldDesc);
+      return true;
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+      _value = refl->GetInt32(_msg, _fieldDesc);
+      return true;
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+      _value = static_cast<double>(refl->GetInt64(_msg, _fieldDesc));
+      return true;
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+      _value = refl->GetUInt32(_msg, _fieldDesc);
+      return true;
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+      _value = static_cast<double>(refl->GetUInt64(_msg, _fieldDesc));
+      return true;
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool FieldMatcher::CompareScalar(const transport::ProtoMsg &_input) const
+{
+  auto *fieldDesc = this->fieldDescMatcher.back();
+  auto *matcherRefl = this->subMsgMatcher->GetReflection();
+  auto *inputRefl = _input.GetReflection();
+  const auto &matcher = *this->subMsgMatcher;
+
+  auto almostEqual = [this](double _a, double _b)
+  {
+    return _a == _b || std::abs(_a - _b) <= this->tolerance;
+  };
+
+  switch (fieldDesc->cpp_type())
+  {
+    case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+      return almostEqual(matcherRefl->GetDouble(matcher, fieldDesc),
+          inputRefl->GetDouble(_input, fieldDesc));
+    case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+      return almostEqual(matcherRefl->GetFloat(matcher, fieldDesc),
+          inputRefl->GetFloat(_input, fieldDesc));
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+      return matcherRefl->GetInt32(matcher, fieldDesc) ==
+          inputRefl->GetInt32(_input, fieldDesc);
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+      return matcherRefl->GetInt64(matcher, fieldDesc) ==
+          inputRefl->GetInt64(_input, fieldDesc);
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+      return matcherRefl->GetUInt32(matcher, fieldDesc) ==
+          inputRefl->GetUInt32(_input, fieldDesc);
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+      return matcherRefl->GetUInt64(matcher, fieldDesc) ==
+          inputRefl->GetUInt64(_input, fieldDesc);
+    case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+      return matcherRefl->GetBool(matcher, fieldDesc) ==
+          inputRefl->GetBool(_input, fieldDesc);
+    case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+      return matcherRefl->GetEnumValue(matcher, fieldDesc) ==
+          inputRefl->GetEnumValue(_input, fieldDesc);
+    case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+    {
+      std::string matcherScratch;
+      std::string inputScratch;
+      return matcherRefl->GetStringReference(matcher, fieldDesc,
+          &matcherScratch) == inputRefl->GetStringReference(_input,
+          fieldDesc, &inputScratch);
+    }
+    default:
+      return false;
+  }
+}
+
 //////////////////////////////////////////////////
 bool FieldMatcher::FindFieldSubMessage(
     transport::ProtoMsg *_msg, const std::string &_fieldName,
@@ -389,11 +564,9 @@ bool FieldMatcher::FindFieldSubMessage(
 bool FieldMatcher::DoMatch(
     const transport::ProtoMsg &_input) const
 {
-  google::protobuf::util::DefaultFieldComparator comp;
-
-  auto *matcherRefl = this->matchMsg->GetReflection();
+  // The path to the field was resolved into descriptors on construction,
+  // and the submessages of the matcher don't change
   auto *inputRefl = _input.GetReflection();
-  const transport::ProtoMsg *subMsgMatcher = this->matchMsg.get();
   const transport::ProtoMsg *subMsgInput = &_input;
   for (std::size_t i = 0; i < this->fieldDescMatcher.size() - 1; ++i)
   {
@@ -406,13 +579,24 @@ bool FieldMatcher::DoMatch(
     }
     else
     {
-      subMsgMatcher = &matcherRefl->GetMessage(*subMsgMatcher, fieldDesc);
       subMsgInput = &inputRefl->GetMessage(*subMsgInput, fieldDesc);
     }
   }
 
+  if (this->range)
+  {
+    double value;
+    if (!NumericValue(*subMsgInput, this->fieldDescMatcher.back(), value))
+      return false;
+    return this->logicType ==
+        (value >= this->rangeMin && value <= this->rangeMax);
+  }
+
+  if (this->scalar && this->tolerance >= 0.0)
+    return this->logicType == this->CompareScalar(*subMsgInput);
+
   return this->logicType ==
-         this->diff.CompareWithFields(*subMsgMatcher, *subMsgInput,
+         this->diff.CompareWithFields(*this->subMsgMatcher, *subMsgInput,
                                       {this->fieldDescMatcher.back()},
                                       {this->fieldDescMatcher.back()});
 }
@@ -446,7 +630,25 @@ std::unique_ptr<InputMatcher> InputMatcher::Create(
   const bool logicType = logicTypeStr == "positive";
 
   auto inputMatchString = common::trimmed(_matchElem->Get<std::string>());
-  if (!inputMatchString.empty())
+  if (_matchElem->HasAttribute("field") &&
+      (_matchElem->HasAttribute("min") || _matchElem->HasAttribute("max")))
+  {
+    const auto fieldName = _matchElem->Get<std::string>("field");
+    const auto min = _matchElem->Get<double>("min",
+        -std::numeric_limits<double>::infinity()).first;
+    const auto max = _matchElem->Get<double>("max",
+        std::numeric_limits<double>::infinity()).first;
+    matcher = std::make_unique<FieldMatcher>(_msgType, logicType, fieldName,
+                                             min, max);
+    if (!matcher->IsValid())
+    {
+      gzerr << "Range matcher for input type [" << _msgType
+             << "] could not be created for field [" << fieldName << "]"
+             << std::endl;
+      return nullptr;
+    }
+  }
+  else if (!inputMatchString.empty())
   {
     if (_matchElem->HasAttribute("field"))
     {
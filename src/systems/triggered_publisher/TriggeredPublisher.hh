@@ -61,7 +61,11 @@ namespace systems
   ///         fails. The default value is "positive"
   ///     * `tol`: Tolerance for floating point comparisons.
   ///     * `field`: If specified, only this field inside the input
-  ///         message is compared for a match.
+  ///         message is compared for a match. The path to the field is
+  ///         resolved once when the system is configured.
+  ///     * `min`, `max`: If either is specified along with `field`, the
+  ///         numeric field matches when it's within [min, max], and the
+  ///         value of `<match>` is ignored. A missing bound is unbounded.
   ///   * Value: String used to construct the protobuf message against which
   ///       input messages are matched. This is the human-readable
   ///       representation of a protobuf message as used by `gz topic` for
@@ -124,6 +128,17 @@ namespace systems
   ///    </plugin>
   /// \endcode
   ///
+  /// 4. Range match: An output is triggered when a numeric field is within a
+  ///    range
+  /// \code{.xml}
+  ///    <plugin>
+  ///      <input type="gz.msgs.Double" topic="/input_topic">
+  ///        <match field="data" min="0.5" max="1.5"/>
+  ///      </input>
+  ///      <output type="gz.msgs.Empty" topic="/output_topic"/>
+  ///    </plugin>
+  /// \endcode
+  ///
   /// The `logic_type` attribute can be used to negate a match. That is, to
   /// trigger an output when the input does not equal the value in `<match>`
   /// For example, the following will trigger an ouput when the input does not
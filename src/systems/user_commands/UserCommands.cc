@@ -36,15 +36,20 @@
 #include <gz/msgs/entity_factory_v.pb.h>
 #include <gz/msgs/light.pb.h>
 #include <gz/msgs/material_color.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/physics.pb.h>
 #include <gz/msgs/pose.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/spherical_coordinates.pb.h>
+#include <gz/msgs/stringmsg_v.pb.h>
 #include <gz/msgs/visual.pb.h>
 #include <gz/msgs/wheel_slip_parameters_cmd.pb.h>
 
+#include <memory>
+#include <chrono>
 #include <string>
 #include <utility>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -120,8 +125,17 @@ class UserCommandsInterface
   /// false otherwise
   public: bool HasContactSensor(const Entity _collision);
 
+  /// \brief Get the names of all top-level entities.
+  /// \return Names of the children of the world.
+  public: std::unordered_set<std::string> TopLevelNames() const;
+
   /// \brief Bool to set all matching light entities.
   public: bool setAllLightEntities = false;
+
+  /// \brief Registered prototypes, keyed by prototype name. Each root holds
+  /// a model.
+  public: std::unordered_map<std::string, std::unique_ptr<sdf::Root>>
+      prototypes;
 };
 
 /// \brief All user commands should inherit from this class so they can be
@@ -149,6 +163,18 @@ class UserCommandBase
   protected: const std::shared_ptr<UserCommandsInterface> iface{nullptr};
 };
 
+/// \brief State shared by the create commands of a batch, so that work
+/// which is the same for every entity is only done once.
+struct CreateBatchCache
+{
+  /// \brief Parsed SDF roots, keyed by SDF string or file name.
+  std::unordered_map<std::string, std::unique_ptr<sdf::Root>> roots;
+
+  /// \brief Names of all top-level entities, including the ones created by
+  /// the batch so far.
+  std::unordered_set<std::string> topLevelNames;
+};
+
 /// \brief Command to spawn an entity into simulation.
 class CreateCommand : public UserCommandBase
 {
@@ -160,6 +186,58 @@ class CreateCommand : public UserCommandBase
 
   // Documentation inherited
   public: bool Execute() final;
+
+  /// \brief Cache of the batch this command belongs to, null if the command
+  /// is executed on its own.
+  public: CreateBatchCache *cache{nullptr};
+};
+
+/// \brief Command to spawn many entities into simulation at once. SDF
+/// shared by several entities is only parsed once, names are checked against
+/// a set of the top-level entities built once, and all entities are inserted
+/// into the entity component manager in bulk.
+class CreateMultipleCommand : public UserCommandBase
+{
+  /// \brief Constructor
+  /// \param[in] _msg Factory messages.
+  /// \param[in] _iface Pointer to user commands interface.
+  public: CreateMultipleCommand(const msgs::EntityFactory_V &_msg,
+      std::shared_ptr<UserCommandsInterface> &_iface);
+
+  // Documentation inherited
+  public: bool Execute() final;
+
+  /// \brief One command per entity to create.
+  private: std::vector<std::unique_ptr<CreateCommand>> cmds;
+};
+
+/// \brief Command to parse a model once and keep it as a prototype, which
+/// can then be spawned many times by name.
+class RegisterPrototypeCommand : public UserCommandBase
+{
+  /// \brief Constructor
+  /// \param[in] _msg Factory message with the model's SDF. Its name is the
+  /// prototype name.
+  /// \param[in] _iface Pointer to user commands interface.
+  public: RegisterPrototypeCommand(msgs::EntityFactory *_msg,
+      std::shared_ptr<UserCommandsInterface> &_iface);
+
+  // Documentation inherited
+  public: bool Execute() final;
+};
+
+/// \brief Command to spawn instances of a registered prototype.
+class SpawnPrototypeCommand : public UserCommandBase
+{
+  /// \brief Constructor
+  /// \param[in] _msg Name and pose of each instance. The prototype name is
+  /// given by the "prototype" key of the header.
+  /// \param[in] _iface Pointer to user commands interface.
+  public: SpawnPrototypeCommand(msgs::Pose_V *_msg,
+      std::shared_ptr<UserCommandsInterface> &_iface);
+
+  // Documentation inherited
+  public: bool Execute() final;
 };
 
 /// \brief Command to remove an entity from simulation.
@@ -175,6 +253,20 @@ class RemoveCommand : public UserCommandBase
   public: bool Execute() final;
 };
 
+/// \brief Command to remove many top-level entities from simulation at once,
+/// looking their names up in a single pass over the top-level entities.
+class RemoveMultipleCommand : public UserCommandBase
+{
+  /// \brief Constructor
+  /// \param[in] _msg Names of the entities to be removed.
+  /// \param[in] _iface Pointer to user commands interface.
+  public: RemoveMultipleCommand(msgs::StringMsg_V *_msg,
+      std::shared_ptr<UserCommandsInterface> &_iface);
+
+  // Documentation inherited
+  public: bool Execute() final;
+};
+
 /// \brief Command to modify a light entity from simulation.
 class LightCommand : public UserCommandBase
 {
@@ -269,6 +361,10 @@ class PoseVectorCommand : public UserCommandBase
 
   // Documentation inherited
   public: bool Execute() final;
+
+  /// \brief Whether each pose has been superseded by a later command for the
+  /// same entity, in which case it isn't applied.
+  public: std::vector<bool> superseded;
 };
 
 /// \brief Command to modify the physics parameters of a simulation.
@@ -460,6 +556,33 @@ class gz::sim::systems::UserCommandsPrivate
   public: bool RemoveService(const msgs::Entity &_req,
       msgs::Boolean &_res);
 
+  /// \brief Callback for multiple remove service
+  /// \param[in] _req Request containing the names of the top-level entities
+  /// to be removed.
+  /// \param[out] _res True if message successfully received and queued.
+  /// It does not mean that the entities will be successfully removed.
+  /// \return True if successful.
+  public: bool RemoveServiceMultiple(const msgs::StringMsg_V &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Callback for register prototype service
+  /// \param[in] _req Request containing the model's SDF, and the prototype
+  /// name.
+  /// \param[out] _res True if message successfully received and queued.
+  /// It does not mean that the prototype will be successfully registered.
+  /// \return True if successful.
+  public: bool RegisterPrototypeService(const msgs::EntityFactory &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Callback for spawn prototype service
+  /// \param[in] _req Request containing the prototype name and the name and
+  /// pose of each instance.
+  /// \param[out] _res True if message successfully received and queued.
+  /// It does not mean that the instances will be successfully spawned.
+  /// \return True if successful.
+  public: bool SpawnPrototypeService(const msgs::Pose_V &_req,
+      msgs::Boolean &_res);
+
   /// \brief Callback for light service
   /// \param[in] _req Request containing light update of an entity.
   /// \param[out] _res True if message successfully received and queued.
@@ -548,8 +671,71 @@ class gz::sim::systems::UserCommandsPrivate
 
   /// \brief Mutex to protect pending queue.
   public: std::mutex pendingMutex;
+
+  /// \brief Push a command to the pending queue. Must be called with
+  /// pendingMutex locked.
+  /// \param[in] _cmd Command to push.
+  /// \param[in] _key Target of the command, see Supersede. Empty if the
+  /// command can't be coalesced.
+  public: void Push(std::unique_ptr<UserCommandBase> _cmd,
+      const std::string &_key = "");
+
+  /// \brief Make the pending command, or pose of a pose vector command, with
+  /// the given target skip its target, because a later command replaces it.
+  /// Must be called with pendingMutex locked.
+  /// \param[in] _key Entity and component targeted by the command.
+  /// \param[in] _index Index of the later command in pendingCmds.
+  /// \param[in] _element Index of the pose in the later pose vector
+  /// command, or -1 for the whole command.
+  public: void Supersede(const std::string &_key, std::size_t _index,
+      int _element);
+
+  /// \brief Publish the command statistics, at most once per second.
+  /// \param[in] _info Current simulation information.
+  public: void PublishStats(const UpdateInfo &_info);
+
+  /// \brief Pending command, and pose within it, which last targeted an
+  /// entity and component.
+  public: struct PendingTarget
+  {
+    /// \brief Index in pendingCmds.
+    std::size_t index;
+
+    /// \brief Index of the pose in a pose vector command, or -1.
+    int element;
+  };
+
+  /// \brief Latest pending command for each target, keyed by target.
+  /// Protected by pendingMutex.
+  public: std::unordered_map<std::string, PendingTarget> pendingTargets;
+
+  /// \brief Number of commands, or poses of pose vector commands, that were
+  /// dropped because a later one replaced them. Protected by pendingMutex.
+  public: uint64_t coalescedCount{0u};
+
+  /// \brief Number of commands executed successfully.
+  public: uint64_t executedCount{0u};
+
+  /// \brief Number of commands which failed to execute.
+  public: uint64_t failedCount{0u};
+
+  /// \brief Publisher of the command statistics.
+  public: transport::Node::Publisher statsPub;
+
+  /// \brief Wall time of the last statistics publication.
+  public: std::chrono::steady_clock::time_point lastStatsTime;
 };
 
+/// \brief Key of the entity and component targeted by a pose command.
+/// \param[in] _msg Pose command.
+/// \return Key of the target.
+std::string poseTargetKey(const msgs::Pose &_msg)
+{
+  if (_msg.id() != kNullEntity && _msg.id() != 0)
+    return "pose:id:" + std::to_string(_msg.id());
+  return "pose:name:" + _msg.name();
+}
+
 /// \brief Pose3d equality comparison function.
 /// \param[in] _a A pose to compare
 /// \param[in] _b Another pose to compare
@@ -611,6 +797,20 @@ bool UserCommandsInterface::HasContactSensor(const Entity _collision)
   return false;
 }
 
+//////////////////////////////////////////////////
+std::unordered_set<std::string> UserCommandsInterface::TopLevelNames() const
+{
+  std::unordered_set<std::string> names;
+  for (const auto &entity : this->ecm->EntitiesByComponents(
+      components::ParentEntity(this->worldEntity)))
+  {
+    auto nameComp = this->ecm->Component<components::Name>(entity);
+    if (nameComp)
+      names.insert(nameComp->Data());
+  }
+  return names;
+}
+
 //////////////////////////////////////////////////
 void UserCommands::Configure(const Entity &_entity,
     const std::shared_ptr<const sdf::Element> &_sdf,
@@ -656,6 +856,34 @@ void UserCommands::Configure(const Entity &_entity,
 
   gzmsg << "Remove service on [" << removeService << "]" << std::endl;
 
+  // Statistics of the executed and coalesced commands
+  std::string statsTopic{"/world/" + validWorldName + "/user_commands/stats"};
+  this->dataPtr->statsPub =
+      this->dataPtr->node.Advertise<msgs::Param>(statsTopic);
+
+  // Remove service for multiple entities
+  std::string removeServiceMultiple{"/world/" + validWorldName +
+      "/remove_multiple"};
+  this->dataPtr->node.Advertise(removeServiceMultiple,
+      &UserCommandsPrivate::RemoveServiceMultiple, this->dataPtr.get());
+
+  gzmsg << "Remove service on [" << removeServiceMultiple << "]"
+        << std::endl;
+
+  // Prototype services
+  std::string registerPrototypeService{"/world/" + validWorldName +
+      "/register_prototype"};
+  this->dataPtr->node.Advertise(registerPrototypeService,
+      &UserCommandsPrivate::RegisterPrototypeService, this->dataPtr.get());
+
+  std::string spawnPrototypeService{"/world/" + validWorldName +
+      "/spawn_prototype"};
+  this->dataPtr->node.Advertise(spawnPrototypeService,
+      &UserCommandsPrivate::SpawnPrototypeService, this->dataPtr.get());
+
+  gzmsg << "Prototype services on [" << registerPrototypeService << "] and ["
+        << spawnPrototypeService << "]" << std::endl;
+
   // Pose service
   std::string poseService{"/world/" + validWorldName + "/set_pose"};
   this->dataPtr->node.Advertise(poseService,
@@ -749,10 +977,12 @@ void UserCommands::Configure(const Entity &_entity,
 }
 
 //////////////////////////////////////////////////
-void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
+void UserCommands::PreUpdate(const UpdateInfo &_info,
     EntityComponentManager &)
 {
   GZ_PROFILE("UserCommands::PreUpdate");
+  this->dataPtr->PublishStats(_info);
+
   // make a copy the cmds so execution does not block receiving other
   // incoming cmds
   std::vector<std::unique_ptr<UserCommandBase>> cmds;
@@ -762,6 +992,7 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
       return;
     cmds = std::move(this->dataPtr->pendingCmds);
     this->dataPtr->pendingCmds.clear();
+    this->dataPtr->pendingTargets.clear();
   }
 
   // TODO(louise) Record current world state for undo
@@ -769,9 +1000,17 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
   // Execute pending commands
   for (auto &cmd : cmds)
   {
+    // Skip commands replaced by later ones
+    if (!cmd)
+      continue;
+
     // Execute
     if (!cmd->Execute())
+    {
+      ++this->dataPtr->failedCount;
       continue;
+    }
+    ++this->dataPtr->executedCount;
 
     // TODO(louise) Update command with current world state
 
@@ -781,18 +1020,89 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
   // TODO(louise) Clear redo list
 }
 
+//////////////////////////////////////////////////
+void UserCommandsPrivate::Push(std::unique_ptr<UserCommandBase> _cmd,
+    const std::string &_key)
+{
+  this->pendingCmds.push_back(std::move(_cmd));
+  if (!_key.empty())
+    this->Supersede(_key, this->pendingCmds.size() - 1u, -1);
+}
+
+//////////////////////////////////////////////////
+void UserCommandsPrivate::Supersede(const std::string &_key,
+    std::size_t _index, int _element)
+{
+  auto [it, inserted] =
+      this->pendingTargets.try_emplace(_key, PendingTarget{_index, _element});
+  if (inserted)
+    return;
+
+  // Every command with a key fully replaces the target's component, so
+  // only the latest one needs to be applied
+  auto &previous = this->pendingCmds[it->second.index];
+  if (previous)
+  {
+    if (it->second.element < 0)
+    {
+      previous.reset();
+    }
+    else
+    {
+      static_cast<PoseVectorCommand *>(previous.get())->superseded[
+          it->second.element] = true;
+    }
+    ++this->coalescedCount;
+  }
+  it->second = PendingTarget{_index, _element};
+}
+
+//////////////////////////////////////////////////
+void UserCommandsPrivate::PublishStats(const UpdateInfo &_info)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->lastStatsTime < std::chrono::seconds(1))
+    return;
+  this->lastStatsTime = now;
+
+  if (!this->statsPub || !this->statsPub.HasConnections())
+    return;
+
+  msgs::Param msg;
+  msg.mutable_header()->mutable_stamp()->CopyFrom(
+      convert<msgs::Time>(_info.simTime));
+  // The counts grow for the whole run, so they may not fit an int32, and
+  // Any has no 64 bit integers. Doubles hold them exactly up to 2^53.
+  auto addCount = [&msg](const std::string &_name, uint64_t _count)
+  {
+    auto &value = (*msg.mutable_params())[_name];
+    value.set_type(msgs::Any::DOUBLE);
+    value.set_double_value(static_cast<double>(_count));
+  };
+  uint64_t coalesced;
+  std::size_t pending;
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    coalesced = this->coalescedCount;
+    pending = this->pendingCmds.size();
+  }
+  addCount("executed", this->executedCount);
+  addCount("failed", this->failedCount);
+  addCount("coalesced", coalesced);
+  addCount("pending", pending);
+  this->statsPub.Publish(msg);
+}
+
 //////////////////////////////////////////////////
 bool UserCommandsPrivate::CreateServiceMultiple(
     const msgs::EntityFactory_V &_req, msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->pendingMutex);
-  for (int i = 0; i < _req.data_size(); ++i)
+  // Create a single command for the whole batch and push it to queue
+  auto cmd = std::make_unique<CreateMultipleCommand>(_req, this->iface);
+
+  // Push to pending
   {
-    const msgs::EntityFactory &msg = _req.data(i);
-    // Create command and push it to queue
-    auto msgCopy = msg.New();
-    msgCopy->CopyFrom(msg);
-    auto cmd = std::make_unique<CreateCommand>(msgCopy, this->iface);
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
     this->pendingCmds.push_back(std::move(cmd));
   }
 
@@ -838,6 +1148,63 @@ bool UserCommandsPrivate::RemoveService(const msgs::Entity &_req,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool UserCommandsPrivate::RemoveServiceMultiple(
+    const msgs::StringMsg_V &_req, msgs::Boolean &_res)
+{
+  // Create command and push it to queue
+  auto msg = _req.New();
+  msg->CopyFrom(_req);
+  auto cmd = std::make_unique<RemoveMultipleCommand>(msg, this->iface);
+
+  // Push to pending
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    this->pendingCmds.push_back(std::move(cmd));
+  }
+
+  _res.set_data(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool UserCommandsPrivate::RegisterPrototypeService(
+    const msgs::EntityFactory &_req, msgs::Boolean &_res)
+{
+  // Create command and push it to queue
+  auto msg = _req.New();
+  msg->CopyFrom(_req);
+  auto cmd = std::make_unique<RegisterPrototypeCommand>(msg, this->iface);
+
+  // Push to pending
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    this->pendingCmds.push_back(std::move(cmd));
+  }
+
+  _res.set_data(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool UserCommandsPrivate::SpawnPrototypeService(const msgs::Pose_V &_req,
+    msgs::Boolean &_res)
+{
+  // Create command and push it to queue
+  auto msg = _req.New();
+  msg->CopyFrom(_req);
+  auto cmd = std::make_unique<SpawnPrototypeCommand>(msg, this->iface);
+
+  // Push to pending
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    this->pendingCmds.push_back(std::move(cmd));
+  }
+
+  _res.set_data(true);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool UserCommandsPrivate::LightService(const msgs::Light &_req,
     msgs::Boolean &_res)
@@ -878,12 +1245,13 @@ bool UserCommandsPrivate::PoseService(const msgs::Pose &_req,
   // Create command and push it to queue
   auto msg = _req.New();
   msg->CopyFrom(_req);
+  auto key = poseTargetKey(*msg);
   auto cmd = std::make_unique<PoseCommand>(msg, this->iface);
 
   // Push to pending
   {
     std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
+    this->Push(std::move(cmd), key);
   }
 
   _res.set_data(true);
@@ -899,10 +1267,13 @@ bool UserCommandsPrivate::PoseVectorService(const msgs::Pose_V &_req,
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<PoseVectorCommand>(msg, this->iface);
 
-  // Push to pending
+  // Push to pending, and let each pose replace earlier ones for its entity
   {
     std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
+    this->Push(std::move(cmd));
+    const std::size_t index = this->pendingCmds.size() - 1u;
+    for (int i = 0; i < msg->pose_size(); ++i)
+      this->Supersede(poseTargetKey(msg->pose(i)), index, i);
   }
 
   _res.set_data(true);
@@ -972,11 +1343,14 @@ bool UserCommandsPrivate::VisualService(const msgs::Visual &_req,
   // Create command and push it to queue
   auto msg = _req.New();
   msg->CopyFrom(_req);
+  auto key = msg->id() != kNullEntity ?
+      "visual:id:" + std::to_string(msg->id()) :
+      "visual:name:" + msg->parent_name() + "::" + msg->name();
   auto cmd = std::make_unique<VisualCommand>(msg, this->iface);
   // Push to pending
   {
     std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
+    this->Push(std::move(cmd), key);
   }
 
   _res.set_data(true);
@@ -988,11 +1362,13 @@ void UserCommandsPrivate::OnCmdMaterialColor(const msgs::MaterialColor &_msg)
 {
   auto msg = _msg.New();
   msg->CopyFrom(_msg);
+  auto key = "color:" + msg->entity().name() + ":" +
+      std::to_string(msg->entity_match());
   auto cmd = std::make_unique<VisualCommand>(msg, this->iface);
   // Push to pending
   {
     std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
+    this->Push(std::move(cmd), key);
   }
 
   return;
@@ -1067,20 +1443,30 @@ bool CreateCommand::Execute()
     return false;
   }
 
-  // Load SDF
-  sdf::Root root;
+  // Load SDF, or reuse it if it was already parsed for this batch
+  sdf::Root loadedRoot;
+  const sdf::Root *root = &loadedRoot;
+  std::string rootKey;
   sdf::Light lightSdf;
   sdf::Errors errors;
   switch (createMsg->from_case())
   {
     case msgs::EntityFactory::kSdf:
     {
-      errors = root.LoadSdfString(createMsg->sdf());
+      rootKey = "sdf:" + createMsg->sdf();
+      if (this->cache && this->cache->roots.count(rootKey))
+        root = this->cache->roots[rootKey].get();
+      else
+        errors = loadedRoot.LoadSdfString(createMsg->sdf());
       break;
     }
     case msgs::EntityFactory::kSdfFilename:
     {
-      errors = root.Load(createMsg->sdf_filename());
+      rootKey = "file:" + createMsg->sdf_filename();
+      if (this->cache && this->cache->roots.count(rootKey))
+        root = this->cache->roots[rootKey].get();
+      else
+        errors = loadedRoot.Load(createMsg->sdf_filename());
       break;
     }
     case msgs::EntityFactory::kModel:
@@ -1130,6 +1516,14 @@ bool CreateCommand::Execute()
         this->iface->ecm->SetComponentData<components::Pose>(clonedEntity,
             pose);
       }
+
+      if (this->cache)
+      {
+        auto nameComp =
+          this->iface->ecm->Component<components::Name>(clonedEntity);
+        if (nameComp)
+          this->cache->topLevelNames.insert(nameComp->Data());
+      }
       return true;
     }
     default:
@@ -1146,21 +1540,28 @@ bool CreateCommand::Execute()
     return false;
   }
 
+  if (this->cache && !rootKey.empty() && root == &loadedRoot)
+  {
+    auto cached = std::make_unique<sdf::Root>(std::move(loadedRoot));
+    root = cached.get();
+    this->cache->roots[rootKey] = std::move(cached);
+  }
+
   bool isModel{false};
   bool isLight{false};
   bool isActor{false};
   bool isRoot{false};
-  if (nullptr != root.Model())
+  if (nullptr != root->Model())
   {
     isRoot = true;
     isModel = true;
   }
-  else if (nullptr != root.Light())
+  else if (nullptr != root->Light())
   {
     isRoot = true;
     isLight = true;
   }
-  else if (nullptr != root.Actor())
+  else if (nullptr != root->Actor())
   {
     isRoot = true;
     isActor = true;
@@ -1190,11 +1591,11 @@ bool CreateCommand::Execute()
   }
   else if (isModel)
   {
-    desiredName = root.Model()->Name();
+    desiredName = root->Model()->Name();
   }
   else if (isLight && isRoot)
   {
-    desiredName = root.Light()->Name();
+    desiredName = root->Light()->Name();
   }
   else if (isLight)
   {
@@ -1202,13 +1603,19 @@ bool CreateCommand::Execute()
   }
   else if (isActor)
   {
-    desiredName = root.Actor()->Name();
+    desiredName = root->Actor()->Name();
   }
 
   // Check if there's already a top-level entity with the given name
-  if (kNullEntity != this->iface->ecm->EntityByComponents(
-      components::Name(desiredName),
-      components::ParentEntity(this->iface->worldEntity)))
+  auto nameExists = [this](const std::string &_name)
+  {
+    if (this->cache)
+      return this->cache->topLevelNames.count(_name) > 0;
+    return kNullEntity != this->iface->ecm->EntityByComponents(
+        components::Name(_name),
+        components::ParentEntity(this->iface->worldEntity));
+  };
+  if (nameExists(desiredName))
   {
     if (!createMsg->allow_renaming())
     {
@@ -1221,9 +1628,7 @@ bool CreateCommand::Execute()
     // Generate unique name
     std::string newName = desiredName;
     int i = 0;
-    while (kNullEntity != this->iface->ecm->EntityByComponents(
-      components::Name(newName),
-      components::ParentEntity(this->iface->worldEntity)))
+    while (nameExists(newName))
     {
       newName = desiredName + "_" + std::to_string(i++);
     }
@@ -1234,13 +1639,13 @@ bool CreateCommand::Execute()
   Entity entity{kNullEntity};
   if (isModel)
   {
-    auto model = *root.Model();
+    auto model = *root->Model();
     model.SetName(desiredName);
     entity = this->iface->creator->CreateEntities(&model);
   }
   else if (isLight && isRoot)
   {
-    auto light = *root.Light();
+    auto light = *root->Light();
     light.SetName(desiredName);
     entity = this->iface->creator->CreateEntities(&light);
   }
@@ -1251,7 +1656,7 @@ bool CreateCommand::Execute()
   }
   else if (isActor)
   {
-    auto actor = *root.Actor();
+    auto actor = *root->Actor();
     actor.SetName(desiredName);
     entity = this->iface->creator->CreateEntities(&actor);
   }
@@ -1308,12 +1713,260 @@ bool CreateCommand::Execute()
     *poseComp = components::Pose(createPose.value());
   }
 
-  gzdbg << "Created entity [" << entity << "] named [" << desiredName << "]"
-         << std::endl;
+  if (this->cache)
+  {
+    this->cache->topLevelNames.insert(desiredName);
+  }
+  else
+  {
+    gzdbg << "Created entity [" << entity << "] named [" << desiredName
+           << "]" << std::endl;
+  }
 
   return true;
 }
 
+//////////////////////////////////////////////////
+CreateMultipleCommand::CreateMultipleCommand(
+    const msgs::EntityFactory_V &_msg,
+    std::shared_ptr<UserCommandsInterface> &_iface)
+    : UserCommandBase(nullptr, _iface)
+{
+  this->cmds.reserve(_msg.data_size());
+  for (int i = 0; i < _msg.data_size(); ++i)
+  {
+    auto msgCopy = _msg.data(i).New();
+    msgCopy->CopyFrom(_msg.data(i));
+    this->cmds.push_back(std::make_unique<CreateCommand>(msgCopy, _iface));
+  }
+}
+
+//////////////////////////////////////////////////
+bool CreateMultipleCommand::Execute()
+{
+  GZ_PROFILE("CreateMultipleCommand::Execute");
+  auto ecm = this->iface->ecm;
+
+  // Names of the existing top-level entities are gathered once instead of
+  // searching all entities for each new one
+  CreateBatchCache cache;
+  cache.topLevelNames = this->iface->TopLevelNames();
+
+  ecm->BeginBulkInsert();
+  std::size_t created{0u};
+  for (auto &cmd : this->cmds)
+  {
+    cmd->cache = &cache;
+    if (cmd->Execute())
+      ++created;
+    cmd->cache = nullptr;
+  }
+  ecm->EndBulkInsert();
+
+  gzdbg << "Created [" << created << "] out of [" << this->cmds.size()
+         << "] requested entities" << std::endl;
+  return created == this->cmds.size();
+}
+
+//////////////////////////////////////////////////
+RegisterPrototypeCommand::RegisterPrototypeCommand(
+    msgs::EntityFactory *_msg,
+    std::shared_ptr<UserCommandsInterface> &_iface)
+    : UserCommandBase(_msg, _iface)
+{
+}
+
+//////////////////////////////////////////////////
+bool RegisterPrototypeCommand::Execute()
+{
+  GZ_PROFILE("RegisterPrototypeCommand::Execute");
+  auto createMsg = dynamic_cast<const msgs::EntityFactory *>(this->msg);
+  if (nullptr == createMsg)
+  {
+    gzerr << "Internal error, null prototype message" << std::endl;
+    return false;
+  }
+
+  auto root = std::make_unique<sdf::Root>();
+  sdf::Errors errors;
+  switch (createMsg->from_case())
+  {
+    case msgs::EntityFactory::kSdf:
+    {
+      errors = root->LoadSdfString(createMsg->sdf());
+      break;
+    }
+    case msgs::EntityFactory::kSdfFilename:
+    {
+      errors = root->Load(createMsg->sdf_filename());
+      break;
+    }
+    default:
+    {
+      gzerr << "Prototypes can only be registered from the [sdf] or "
+             << "[sdf_filename] fields." << std::endl;
+      return false;
+    }
+  }
+
+  if (!errors.empty())
+  {
+    for (auto &err : errors)
+      gzerr << err << std::endl;
+    return false;
+  }
+
+  if (nullptr == root->Model())
+  {
+    gzerr << "Expected a top-level <model> for a prototype." << std::endl;
+    return false;
+  }
+
+  std::string name = createMsg->name().empty() ?
+      root->Model()->Name() : createMsg->name();
+  if (this->iface->prototypes.count(name))
+  {
+    gzmsg << "Replacing prototype [" << name << "]" << std::endl;
+  }
+  this->iface->prototypes[name] = std::move(root);
+
+  gzdbg << "Registered prototype [" << name << "]" << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+SpawnPrototypeCommand::SpawnPrototypeCommand(msgs::Pose_V *_msg,
+    std::shared_ptr<UserCommandsInterface> &_iface)
+    : UserCommandBase(_msg, _iface)
+{
+}
+
+//////////////////////////////////////////////////
+bool SpawnPrototypeCommand::Execute()
+{
+  GZ_PROFILE("SpawnPrototypeCommand::Execute");
+  auto spawnMsg = dynamic_cast<const msgs::Pose_V *>(this->msg);
+  if (nullptr == spawnMsg)
+  {
+    gzerr << "Internal error, null spawn message" << std::endl;
+    return false;
+  }
+
+  std::string prototypeName;
+  for (const auto &data : spawnMsg->header().data())
+  {
+    if (data.key() == "prototype" && data.value_size() > 0)
+      prototypeName = data.value(0);
+  }
+
+  auto it = this->iface->prototypes.find(prototypeName);
+  if (it == this->iface->prototypes.end())
+  {
+    gzerr << "Prototype [" << prototypeName << "] not registered, so no "
+           << "instances spawned." << std::endl;
+    return false;
+  }
+  const sdf::Model &prototype = *it->second->Model();
+
+  auto ecm = this->iface->ecm;
+  auto names = this->iface->TopLevelNames();
+
+  ecm->BeginBulkInsert(spawnMsg->pose_size());
+  int created{0};
+  int suffix{0};
+  for (const auto &poseMsg : spawnMsg->pose())
+  {
+    // Generate unique names for instances without one
+    std::string name = poseMsg.name();
+    if (name.empty())
+    {
+      do
+      {
+        name = prototypeName + "_" + std::to_string(suffix++);
+      }
+      while (names.count(name));
+    }
+    else if (names.count(name))
+    {
+      gzwarn << "Entity named [" << name << "] already exists. Instance "
+              << "of prototype [" << prototypeName << "] not spawned."
+              << std::endl;
+      continue;
+    }
+
+    auto model = prototype;
+    model.SetName(name);
+    Entity entity = this->iface->creator->CreateEntities(&model);
+    this->iface->creator->SetParent(entity, this->iface->worldEntity);
+    ecm->SetComponentData<components::Pose>(entity, msgs::Convert(poseMsg));
+
+    names.insert(name);
+    ++created;
+  }
+  ecm->EndBulkInsert();
+
+  gzdbg << "Spawned [" << created << "] out of [" << spawnMsg->pose_size()
+         << "] instances of prototype [" << prototypeName << "]"
+         << std::endl;
+  return created == spawnMsg->pose_size();
+}
+
+//////////////////////////////////////////////////
+RemoveMultipleCommand::RemoveMultipleCommand(msgs::StringMsg_V *_msg,
+    std::shared_ptr<UserCommandsInterface> &_iface)
+    : UserCommandBase(_msg, _iface)
+{
+}
+
+//////////////////////////////////////////////////
+bool RemoveMultipleCommand::Execute()
+{
+  GZ_PROFILE("RemoveMultipleCommand::Execute");
+  auto removeMsg = dynamic_cast<const msgs::StringMsg_V *>(this->msg);
+  if (nullptr == removeMsg)
+  {
+    gzerr << "Internal error, null remove message" << std::endl;
+    return false;
+  }
+
+  // Only top-level models and lights can be removed, so they are looked up
+  // by name in a single pass
+  auto ecm = this->iface->ecm;
+  std::unordered_map<std::string, Entity> removable;
+  for (const auto &entity : ecm->EntitiesByComponents(
+      components::ParentEntity(this->iface->worldEntity)))
+  {
+    auto nameComp = ecm->Component<components::Name>(entity);
+    if (nullptr == nameComp)
+      continue;
+    if (nullptr == ecm->Component<components::Model>(entity) &&
+        nullptr == ecm->Component<components::Light>(entity))
+    {
+      continue;
+    }
+    removable.emplace(nameComp->Data(), entity);
+  }
+
+  int removed{0};
+  for (const auto &name : removeMsg->data())
+  {
+    auto it = removable.find(name);
+    if (it == removable.end())
+    {
+      gzerr << "Top-level model or light named [" << name
+             << "] not found, so not removed." << std::endl;
+      continue;
+    }
+    this->iface->creator->RequestRemoveEntity(it->second);
+    removable.erase(it);
+    ++removed;
+  }
+
+  gzdbg << "Requesting removal of [" << removed << "] out of ["
+         << removeMsg->data_size() << "] requested entities" << std::endl;
+  return removed == removeMsg->data_size();
+}
+
 //////////////////////////////////////////////////
 RemoveCommand::RemoveCommand(msgs::Entity *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
@@ -1580,7 +2233,7 @@ bool PoseCommand::Execute()
 //////////////////////////////////////////////////
 PoseVectorCommand::PoseVectorCommand(msgs::Pose_V *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
-    : UserCommandBase(_msg, _iface)
+    : UserCommandBase(_msg, _iface), superseded(_msg->pose_size(), false)
 {
 }
 
@@ -1596,6 +2249,9 @@ bool PoseVectorCommand::Execute()
 
   for (int i = 0; i < poseVectorMsg->pose_size(); i++)
   {
+    if (this->superseded[i])
+      continue;
+
     if (!updatePose(poseVectorMsg->pose(i), this->iface))
     {
       return false;
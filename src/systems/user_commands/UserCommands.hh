@@ -48,11 +48,52 @@ namespace systems
   ///
   /// This service can spawn multiple entities in the same iteration,
   /// thereby eliminating simulation steps between entity spawn times.
+  /// The whole request is executed as a single command: SDF strings or files
+  /// shared by several entities are only parsed once, and the entities are
+  /// inserted in bulk, so this is much faster than spawning the same
+  /// entities one by one.
   ///
   /// * **Service**: `/world/<world name>/create_multiple`
   /// * **Request type**: gz.msgs.EntityFactory_V
   /// * **Response type**: gz.msgs.Boolean
   ///
+  /// ### Register a prototype
+  ///
+  /// Parses a model once and keeps it under a prototype name, so that it can
+  /// be spawned many times without sending or parsing its SDF again. The
+  /// request's `name` is the prototype name, and defaults to the model name.
+  /// Registering a name again replaces the prototype.
+  ///
+  /// * **Service**: `/world/<world name>/register_prototype`
+  /// * **Request type**: gz.msgs.EntityFactory, with `sdf` or `sdf_filename`
+  /// * **Response type**: gz.msgs.Boolean
+  ///
+  /// ### Spawn prototype instances
+  ///
+  /// Spawns one instance of a registered prototype per pose. The prototype
+  /// name is the value of the `prototype` key of the header. Each pose gives
+  /// the name of an instance, which is generated if empty, and its pose.
+  /// All instances are spawned in the same iteration.
+  ///
+  /// * **Service**: `/world/<world name>/spawn_prototype`
+  /// * **Request type**: gz.msgs.Pose_V
+  /// * **Response type**: gz.msgs.Boolean
+  ///
+  /// ### Remove entity
+  ///
+  /// * **Service**: `/world/<world name>/remove`
+  /// * **Request type**: gz.msgs.Entity
+  /// * **Response type**: gz.msgs.Boolean
+  ///
+  /// ### Remove multiple entities
+  ///
+  /// This service removes the top-level models and lights with the given
+  /// names in the same iteration.
+  ///
+  /// * **Service**: `/world/<world name>/remove_multiple`
+  /// * **Request type**: gz.msgs.StringMsg_V
+  /// * **Response type**: gz.msgs.Boolean
+  ///
   /// ### Set entity pose
   ///
   /// This service set the pose of entities
@@ -69,6 +110,23 @@ namespace systems
   /// * **Request type**: gz.msgs.Pose_V
   /// * **Response type**: gz.msgs.Boolean
   ///
+  /// ### Coalescing
+  ///
+  /// Pose, pose vector and visual commands replace the whole command
+  /// component of their target, so when several of them target the same
+  /// entity before they're executed, only the latest one is applied. This
+  /// keeps the queue bounded when commands are sent faster than they are
+  /// executed.
+  ///
+  /// ### Statistics
+  ///
+  /// The number of executed, failed, coalesced and pending commands since
+  /// the start is published once per second, as doubles so counts of long
+  /// runs don't overflow.
+  ///
+  /// * **Topic**: `/world/<world name>/user_commands/stats`
+  /// * **Message type**: gz.msgs.Param
+  ///
   /// Try some examples described in examples/worlds/empty.sdf
   class UserCommands final:
     public System,
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "Waves.hh"
+
+#include <memory>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Register.hh>
+
+#include <sdf/Element.hh>
+
+#include "gz/sim/components/Gravity.hh"
+#include "gz/sim/components/Waves.hh"
+#include "gz/sim/components/World.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/WaveField.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+//////////////////////////////////////////////////
+void Waves::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  if (nullptr == _ecm.Component<components::World>(_entity))
+  {
+    gzerr << "The Waves system must be attached to the world." << std::endl;
+    return;
+  }
+
+  double gravity{9.80665};
+  auto gravityComp = _ecm.Component<components::Gravity>(_entity);
+  if (nullptr != gravityComp && gravityComp->Data().Length() > 0.0)
+    gravity = gravityComp->Data().Length();
+
+  std::vector<WaveField::Wave> waves;
+  for (auto elem = _sdf->FindElement("wave"); elem != nullptr;
+       elem = elem->GetNextElement("wave"))
+  {
+    WaveField::Wave wave;
+    wave.amplitude = elem->Get<double>("amplitude", wave.amplitude).first;
+    wave.wavelength = elem->Get<double>("wavelength", wave.wavelength).first;
+    wave.direction = elem->Get<double>("direction", wave.direction).first;
+    wave.phase = elem->Get<double>("phase", wave.phase).first;
+    wave.steepness = elem->Get<double>("steepness", wave.steepness).first;
+    waves.push_back(wave);
+  }
+
+  if (_sdf->HasElement("spectrum"))
+  {
+    auto elem = _sdf->FindElement("spectrum");
+    WaveField::Spectrum spectrum;
+    spectrum.windSpeed =
+        elem->Get<double>("wind_speed", spectrum.windSpeed).first;
+    spectrum.windDirection =
+        elem->Get<double>("wind_direction", spectrum.windDirection).first;
+    spectrum.count = elem->Get<unsigned int>("count",
+        static_cast<unsigned int>(spectrum.count)).first;
+    spectrum.spread = elem->Get<double>("spread", spectrum.spread).first;
+    spectrum.steepness =
+        elem->Get<double>("steepness", spectrum.steepness).first;
+    spectrum.seed = elem->Get<unsigned int>("seed", spectrum.seed).first;
+
+    const auto sampled = WaveField::FromSpectrum(spectrum, gravity);
+    waves.insert(waves.end(), sampled.begin(), sampled.end());
+  }
+
+  auto field = std::make_shared<const WaveField>(waves, gravity);
+  if (field->Waves().empty())
+    gzwarn << "The Waves system has no waves, the water will be flat.\n";
+
+  gzdbg << "Loaded [" << field->Waves().size() << "] waves." << std::endl;
+  _ecm.CreateComponent(_entity, components::Waves(field));
+}
+
+GZ_ADD_PLUGIN(Waves,
+              System,
+              Waves::ISystemConfigure)
+
+GZ_ADD_PLUGIN_ALIAS(Waves, "gz::sim::systems::Waves")
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SIM_SYSTEMS_WAVES_HH_
+#define GZ_SIM_SYSTEMS_WAVES_HH_
+
+#include <memory>
+
+#include "gz/sim/config.hh"
+#include "gz/sim/System.hh"
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief A world plugin which adds waves to the surface of the water, at
+  /// z = 0. It sets a components::Waves on the world entity, holding a
+  /// WaveField which the other systems query:
+  ///
+  /// - Buoyancy, in graded mode, moves its layers up and down with the
+  ///   surface above each collision.
+  /// - Hydrodynamics adds the orbital velocity of the water to the current.
+  ///
+  /// The component is serialized as its waves, so that GUI plugins which
+  /// render the water can rebuild the same field and move their vertices
+  /// with WaveField::Displacements.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<wave>`: A wave, which may be repeated, with:
+  ///   - `<amplitude>`: Height of the crests [m].
+  ///   - `<wavelength>`: Distance between crests [m].
+  ///   - `<direction>`: Direction of propagation, counter clockwise from
+  ///     +x [rad]. Defaults to 0.
+  ///   - `<phase>`: Phase at the origin [rad]. Defaults to 0.
+  ///   - `<steepness>`: Between 0 for sine waves and 1 for sharp crests.
+  ///     Defaults to 0.
+  /// - `<spectrum>`: Waves of a fully developed sea, sampled from a
+  ///   Pierson-Moskowitz spectrum, with:
+  ///   - `<wind_speed>`: Wind speed [m/s]. Defaults to 5.
+  ///   - `<wind_direction>`: Direction the wind blows towards [rad].
+  ///     Defaults to 0.
+  ///   - `<count>`: Number of waves. Defaults to 16.
+  ///   - `<spread>`: Largest angle between a wave and the wind [rad].
+  ///     Defaults to 0.5.
+  ///   - `<steepness>`: Steepness of every wave. Defaults to 0.
+  ///   - `<seed>`: Seed of the phases and directions. Defaults to 0.
+  ///
+  /// The speed of the waves follows from the gravity of the world.
+  ///
+  /// ## Example
+  ///
+  /// ```
+  /// <plugin filename="gz-sim-waves-system"
+  ///         name="gz::sim::systems::Waves">
+  ///   <spectrum>
+  ///     <wind_speed>8</wind_speed>
+  ///     <steepness>0.5</steepness>
+  ///   </spectrum>
+  /// </plugin>
+  /// ```
+  class Waves :
+    public System,
+    public ISystemConfigure
+  {
+    /// \brief Constructor
+    public: Waves() = default;
+
+    /// \brief Destructor
+    public: ~Waves() override = default;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) override;
+  };
+  }
+}
+}
+}
+
+#endif
@@ -17,7 +17,11 @@
 
 #include "WheelSlip.hh"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -95,11 +99,18 @@ class gz::sim::systems::WheelSlipPrivate
       /// \brief Wheel radius extracted from collision shape if not
       /// specified as xml parameter.
       public: double wheelRadius = 0;
+
+      /// \brief Slip last written to the collision's SlipComplianceCmd.
+      public: std::optional<std::array<double, 2>> writtenSlip;
     };
 
   /// \brief The map relating links to their respective surface parameters.
   public: std::map<Entity, LinkSurfaceParams> mapLinkSurfaceParams;
 
+  /// \brief Relative change of the slip below which the slip compliance
+  /// command isn't updated.
+  public: double slipTolerance{1e-6};
+
   /// \brief Vector2d equality comparison function.
   public: std::function<bool(const std::vector<double> &,
               const std::vector<double> &)>
@@ -130,6 +141,21 @@ bool WheelSlipPrivate::Load(const EntityComponentManager &_ecm,
 {
   const std::string modelName = this->model.Name(_ecm);
 
+  if (_sdf->HasElement("slip_tolerance"))
+  {
+    const auto tolerance = _sdf->Get<double>("slip_tolerance");
+    if (tolerance < 0)
+    {
+      gzerr << "Found slip tolerance [" << tolerance
+            << "], which is negative in model [" << modelName << "]. "
+            << "Using [" << this->slipTolerance << "]." << std::endl;
+    }
+    else
+    {
+      this->slipTolerance = tolerance;
+    }
+  }
+
   if (!_sdf->HasElement("wheel"))
   {
     gzerr << "No wheel tags specified, plugin is disabled" << std::endl;
@@ -305,10 +331,24 @@ void WheelSlipPrivate::Update(EntityComponentManager &_ecm)
     double slip1 = speed / force * params.slipComplianceLateral;
     double slip2 = speed / force * params.slipComplianceLongitudinal;
 
-    components::SlipComplianceCmd newSlipCmdComp({slip1, slip2});
-
     auto currSlipCmdComp =
         _ecm.Component<components::SlipComplianceCmd>(params.collision);
+
+    // The command persists, so small changes aren't worth an update
+    auto withinTolerance = [this](double _written, double _slip)
+    {
+      return std::abs(_slip - _written) <=
+          this->slipTolerance * std::max(std::abs(_slip), std::abs(_written));
+    };
+    if (currSlipCmdComp && params.writtenSlip &&
+        withinTolerance((*params.writtenSlip)[0], slip1) &&
+        withinTolerance((*params.writtenSlip)[1], slip2))
+    {
+      continue;
+    }
+    params.writtenSlip = std::array<double, 2>{slip1, slip2};
+
+    components::SlipComplianceCmd newSlipCmdComp({slip1, slip2});
     if (currSlipCmdComp)
     {
       *currSlipCmdComp = newSlipCmdComp;
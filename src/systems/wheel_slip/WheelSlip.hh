@@ -56,6 +56,12 @@ namespace systems
   /// parameter specified below in order to match the units of the
   /// slip parameters.
   ///
+  /// The slip is only written to the collision's
+  /// `components::SlipComplianceCmd` when it changes by more than the
+  /// optional `<slip_tolerance>`, relative to the slip last written. It
+  /// defaults to 1e-6. Larger values skip more updates of wheels turning at
+  /// a nearly constant speed.
+  ///
   /// A graphical interpretation of these parameters is provided below
   /// for a positive value of slip compliance.
   /// The horizontal axis corresponds to the slip ratio at the wheel,
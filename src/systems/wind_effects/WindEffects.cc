@@ -30,7 +30,11 @@
 
 #include <gz/msgs/wind.pb.h>
 
+#include <array>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,8 +54,11 @@
 #include <gz/sensors/Noise.hh>
 
 #include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/RegularGrid.hh"
 #include "gz/sim/SdfEntityCreator.hh"
+#include "gz/sim/Util.hh"
 
+#include "gz/sim/components/Environment.hh"
 #include "gz/sim/components/Inertial.hh"
 #include "gz/sim/components/Light.hh"
 #include "gz/sim/components/LinearVelocity.hh"
@@ -236,6 +243,20 @@ class gz::sim::systems::WindEffectsPrivate
   public: void UpdateWindVelocity(const UpdateInfo &_info,
                                   EntityComponentManager &_ecm);
 
+  /// \brief Sample the wind field at the links affected by wind which
+  /// moved since they were last sampled, all at once.
+  /// \param[in] _info Simulation update info.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager.
+  public: void UpdateWindField(const UpdateInfo &_info,
+                               EntityComponentManager &_ecm);
+
+  /// \brief Start sampling new environmental data.
+  /// \param[in] _data The data.
+  /// \param[in] _time Simulation time [s].
+  public: void SetWindFieldData(
+              const std::shared_ptr<components::EnvironmentalData> &_data,
+              double _time);
+
   /// \brief Calculate and apply forces on links affected by wind.
   /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Mutable reference to the EntityComponentManager.
@@ -324,6 +345,67 @@ class gz::sim::systems::WindEffectsPrivate
   /// \brief Current wind velocity seed and global enable/disable state.
   /// This is set by a transport message.
   public: msgs::Wind currentWindInfo;
+
+  /// \brief Wind field sampled at a link.
+  public: struct WindFieldSample
+  {
+    /// \brief World position of the link when it was sampled.
+    math::Vector3d position;
+
+    /// \brief Simulation time when it was sampled [s].
+    double time;
+
+    /// \brief Wind velocity of the field.
+    math::Vector3d wind;
+  };
+
+  /// \brief True if the wind varies in space, as given by environmental
+  /// data.
+  public: bool useWindField{false};
+
+  /// \brief Name of the field holding the wind velocity along x, y and z.
+  /// Axes without a name have no wind from the field.
+  public: std::array<std::string, 3> windFieldNames;
+
+  /// \brief Distance a link must move before it's sampled again [m].
+  public: double windFieldCacheDistance{0.1};
+
+  /// \brief Time after which a link is sampled again, if the data varies
+  /// in time [s].
+  public: double windFieldCachePeriod{0.1};
+
+  /// \brief Environmental data being sampled.
+  public: std::shared_ptr<components::EnvironmentalData> windFieldData;
+
+  /// \brief Index of the field of each axis in the regular grid of the
+  /// data, if all of them are in it.
+  public: std::array<std::optional<std::size_t>, 3> windGridFields;
+
+  /// \brief True if the regular grid of the data is sampled.
+  public: bool useWindGrid{false};
+
+  /// \brief Time of the lookups in the regular grid.
+  public: std::optional<RegularGrid::Session> windGridSession;
+
+  /// \brief Time of the lookups in the frame, per axis.
+  public: std::array<std::optional<math::InMemorySession<double, double>>, 3>
+      windFieldSessions;
+
+  /// \brief Latest sample of each link.
+  public: std::unordered_map<Entity, WindFieldSample> windFieldSamples;
+
+  /// \brief Links sampled at this step.
+  public: std::vector<Entity> pendingEntities;
+
+  /// \brief World position of each link sampled at this step.
+  public: std::vector<math::Vector3d> pendingPositions;
+
+  /// \brief Position of each link sampled at this step, in the coordinates
+  /// of the data.
+  public: std::vector<math::Vector3d> pendingCoordinates;
+
+  /// \brief Values looked up at this step.
+  public: std::vector<std::optional<double>> pendingValues;
 };
 
 /////////////////////////////////////////////////
@@ -461,6 +543,27 @@ void WindEffectsPrivate::Load(EntityComponentManager &_ecm,
     return;
   }
 
+  if (_sdf->HasElement("field"))
+  {
+    auto sdfField = _sdf->GetElementImpl("field");
+    const char *axes[3] = {"x", "y", "z"};
+    for (std::size_t i = 0u; i < 3u; ++i)
+    {
+      this->windFieldNames[i] =
+          sdfField->Get<std::string>(axes[i], "").first;
+      this->useWindField |= !this->windFieldNames[i].empty();
+    }
+    this->windFieldCacheDistance = sdfField->Get<double>("cache_distance",
+        this->windFieldCacheDistance).first;
+    this->windFieldCachePeriod = sdfField->Get<double>("cache_period",
+        this->windFieldCachePeriod).first;
+    if (!this->useWindField)
+    {
+      gzwarn << "<field> has none of <x>, <y> and <z>, the wind won't vary "
+             << "in space." << std::endl;
+    }
+  }
+
   this->validConfig = true;
 }
 
@@ -565,6 +668,172 @@ void WindEffectsPrivate::UpdateWindVelocity(const UpdateInfo &_info,
   windLinVel->Data() = windVel;
 }
 
+//////////////////////////////////////////////////
+void WindEffectsPrivate::SetWindFieldData(
+    const std::shared_ptr<components::EnvironmentalData> &_data,
+    double _time)
+{
+  this->windFieldData = _data;
+  this->windFieldSamples.clear();
+  this->windGridSession.reset();
+  for (auto &session : this->windFieldSessions)
+    session.reset();
+  if (!_data)
+    return;
+
+  // Regular grids look up each axis for all links at once
+  this->useWindGrid = nullptr != _data->grid;
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    this->windGridFields[i].reset();
+    if (this->windFieldNames[i].empty())
+      continue;
+    if (!_data->frame.Has(this->windFieldNames[i]))
+    {
+      gzwarn << "Wind field [" << this->windFieldNames[i] << "] isn't in "
+             << "the environmental data." << std::endl;
+      this->useWindGrid = false;
+      continue;
+    }
+    if (this->useWindGrid)
+    {
+      this->windGridFields[i] =
+          _data->grid->FieldIndex(this->windFieldNames[i]);
+      this->useWindGrid = this->windGridFields[i].has_value();
+    }
+    this->windFieldSessions[i] =
+        _data->frame[this->windFieldNames[i]].CreateSession();
+    if (!_data->staticTime)
+    {
+      this->windFieldSessions[i] =
+          _data->frame[this->windFieldNames[i]].StepTo(
+              *this->windFieldSessions[i], _time);
+    }
+  }
+
+  if (this->useWindGrid)
+  {
+    this->windGridSession = _data->grid->CreateSession();
+    if (!_data->staticTime)
+    {
+      this->windGridSession =
+          _data->grid->StepTo(*this->windGridSession, _time);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void WindEffectsPrivate::UpdateWindField(const UpdateInfo &_info,
+                                         EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("WindEffectsPrivate::UpdateWindField");
+  const double simTime =
+      std::chrono::duration<double>(_info.simTime).count();
+
+  // The data is replaced whenever the preload system streams another
+  // window of time
+  auto environment =
+      _ecm.Component<components::Environment>(this->worldEntity);
+  auto data = environment ? environment->Data() : nullptr;
+  if (data != this->windFieldData)
+    this->SetWindFieldData(data, simTime);
+  if (!this->windFieldData)
+    return;
+
+  const bool timeVarying = !this->windFieldData->staticTime;
+  if (timeVarying)
+  {
+    if (this->windGridSession)
+    {
+      this->windGridSession = this->windFieldData->grid->StepTo(
+          *this->windGridSession, simTime);
+    }
+    for (std::size_t i = 0u; i < 3u; ++i)
+    {
+      if (this->windFieldSessions[i])
+      {
+        this->windFieldSessions[i] =
+            this->windFieldData->frame[this->windFieldNames[i]].StepTo(
+                *this->windFieldSessions[i], simTime);
+      }
+    }
+  }
+
+  _ecm.EachRemoved<components::Link>(
+      [&](const Entity &_entity, const components::Link *) -> bool
+      {
+        this->windFieldSamples.erase(_entity);
+        return true;
+      });
+
+  // Only links which moved, or whose sample is too old, are sampled again
+  this->pendingEntities.clear();
+  this->pendingPositions.clear();
+  this->pendingCoordinates.clear();
+  _ecm.Each<components::Link, components::WindMode, components::WorldPose>(
+      [&](const Entity &_entity,
+          const components::Link *,
+          const components::WindMode *_windMode,
+          const components::WorldPose *_linkPose) -> bool
+      {
+        if (!_windMode->Data())
+          return true;
+
+        const auto &position = _linkPose->Data().Pos();
+        auto it = this->windFieldSamples.find(_entity);
+        if (it != this->windFieldSamples.end() &&
+            it->second.position.Distance(position) <
+                this->windFieldCacheDistance &&
+            (!timeVarying ||
+             std::abs(simTime - it->second.time) < this->windFieldCachePeriod))
+        {
+          return true;
+        }
+
+        auto coordinates =
+            getGridFieldCoordinates(_ecm, position, this->windFieldData);
+        if (!coordinates)
+        {
+          this->windFieldSamples[_entity] =
+              {position, simTime, math::Vector3d::Zero};
+          return true;
+        }
+        this->pendingEntities.push_back(_entity);
+        this->pendingPositions.push_back(position);
+        this->pendingCoordinates.push_back(*coordinates);
+        return true;
+      });
+
+  const std::size_t count = this->pendingEntities.size();
+  std::vector<math::Vector3d> winds(count, math::Vector3d::Zero);
+  for (std::size_t i = 0u; count > 0u && i < 3u; ++i)
+  {
+    if (this->useWindGrid && this->windGridSession && this->windGridFields[i])
+    {
+      this->windFieldData->grid->LookUp(*this->windGridSession,
+          *this->windGridFields[i], this->pendingCoordinates,
+          this->pendingValues);
+      for (std::size_t p = 0u; p < count; ++p)
+        winds[p][i] = this->pendingValues[p].value_or(0.0);
+    }
+    else if (!this->useWindGrid && this->windFieldSessions[i])
+    {
+      const auto &grid = this->windFieldData->frame[this->windFieldNames[i]];
+      for (std::size_t p = 0u; p < count; ++p)
+      {
+        winds[p][i] = grid.LookUp(*this->windFieldSessions[i],
+            this->pendingCoordinates[p]).value_or(0.0);
+      }
+    }
+  }
+
+  for (std::size_t p = 0u; p < count; ++p)
+  {
+    this->windFieldSamples[this->pendingEntities[p]] =
+        {this->pendingPositions[p], simTime, winds[p]};
+  }
+}
+
 //////////////////////////////////////////////////
 void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
                                         EntityComponentManager &_ecm)
@@ -575,28 +844,32 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
   if (!windVel)
     return;
 
-  Link link;
-
-  _ecm.Each<components::Link,
-            components::Inertial,
-            components::WindMode,
-            components::WorldPose,
-            components::WorldLinearVelocity>(
+  // The force computation is independent for each link, so it's done in
+  // parallel. Forces are added to the wrench accumulator right away, which
+  // only reads the ECM. Without one, applying the forces modifies the ECM,
+  // which isn't allowed inside EachParallel, so it's done afterwards.
+  auto *accumulator = _ecm.Wrenches();
+  std::vector<std::pair<Entity, math::Vector3d>> forces;
+  std::mutex forcesMutex;
+
+  _ecm.EachParallel<components::Link,
+                    components::Inertial,
+                    components::WindMode,
+                    components::WorldPose,
+                    components::WorldLinearVelocity>(
       [&](const Entity &_entity,
-          components::Link *,
-          components::Inertial *_inertial,
-          components::WindMode *_windMode,
-          components::WorldPose *_linkPose,
-          components::WorldLinearVelocity *_linkVel) -> bool
+          const components::Link *,
+          const components::Inertial *_inertial,
+          const components::WindMode *_windMode,
+          const components::WorldPose *_linkPose,
+          const components::WorldLinearVelocity *_linkVel)
       {
         // Skip links for which the wind is disabled
         if (!_windMode->Data())
         {
-          return true;
+          return;
         }
 
-        link.ResetEntity(_entity);
-
         double forceScalingFactor =
             this->forceApproximationScalingFactor(_linkPose->Data().Pos());
         if (std::isnan(forceScalingFactor))
@@ -604,17 +877,39 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
           forceScalingFactor = 0.;
         }
 
+        // The field varies around the global wind
+        math::Vector3d wind = windVel->Data();
+        auto sample = this->windFieldSamples.find(_entity);
+        if (sample != this->windFieldSamples.end())
+          wind += sample->second.wind;
+
         const math::Vector3d windForce =
             _inertial->Data().MassMatrix().Mass() *
-            forceScalingFactor * (windVel->Data() - _linkVel->Data());
+            forceScalingFactor * (wind - _linkVel->Data());
 
-        // Apply force at center of mass
-        link.AddWorldForce(_ecm, windForce);
+        if (accumulator)
+        {
+          // Apply force at center of mass
+          const auto posComWorldCoord = _linkPose->Data().Rot().RotateVector(
+              _inertial->Data().Pose().Pos());
+          accumulator->Add(_entity, windForce,
+              posComWorldCoord.Cross(windForce));
+          return;
+        }
 
-        return true;
+        std::lock_guard<std::mutex> lock(forcesMutex);
+        forces.emplace_back(_entity, windForce);
       });
-}
 
+  Link link;
+  for (const auto &[entity, windForce] : forces)
+  {
+    link.ResetEntity(entity);
+
+    // Apply force at center of mass
+    link.AddWorldForce(_ecm, windForce);
+  }
+}
 
 //////////////////////////////////////////////////
 void WindEffectsPrivate::OnWindMsg(const msgs::Wind &_msg)
@@ -745,6 +1040,8 @@ void WindEffects::PreUpdate(const UpdateInfo &_info,
     return;
 
   this->dataPtr->UpdateWindVelocity(_info, _ecm);
+  if (this->dataPtr->useWindField)
+    this->dataPtr->UpdateWindField(_info, _ecm);
   this->dataPtr->ApplyWindForce(_info, _ecm);
 
 }
@@ -127,6 +127,23 @@ namespace systems
   /// ```
   /// Regions may not overlap.
   ///
+  /// - `<field>`:
+  /// Wind that varies in space, and maybe in time, added to the wind above.
+  /// It's looked up in the environmental data loaded by the
+  /// EnvironmentPreload system, for instance from a CFD simulation:
+  /// ```
+  ///   <field>
+  ///     <x>wind_x</x>  <!-- Fields of the velocity, missing ones are 0 -->
+  ///     <y>wind_y</y>
+  ///     <z>wind_z</z>
+  ///     <cache_distance>0.1</cache_distance>  <!-- Default 0.1 m -->
+  ///     <cache_period>0.1</cache_period>  <!-- Default 0.1 s -->
+  ///   </field>
+  /// ```
+  /// All links are looked up together at each step, except those that moved
+  /// less than the cache distance since they were last looked up, within
+  /// the cache period. Links outside of the data get no wind from it.
+  ///
   class WindEffects final:
     public System,
     public ISystemConfigure,
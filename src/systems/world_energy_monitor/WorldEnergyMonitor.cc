@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "WorldEnergyMonitor.hh"
+
+#include <gz/msgs/param.pb.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Profiler.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/sim/ComponentHandle.hh"
+#include "gz/sim/components/AngularVelocity.hh"
+#include "gz/sim/components/Gravity.hh"
+#include "gz/sim/components/Inertial.hh"
+#include "gz/sim/components/Link.hh"
+#include "gz/sim/components/LinearVelocity.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/Conversions.hh"
+#include "gz/sim/Util.hh"
+#include "gz/sim/World.hh"
+
+#include "../../ThreadPool.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace systems;
+
+namespace
+{
+/// \brief Energy and momentum of a set of links.
+struct Totals
+{
+  /// \brief Kinetic energy.
+  double kinetic{0.0};
+
+  /// \brief Gravitational potential energy.
+  double potential{0.0};
+
+  /// \brief Linear momentum.
+  math::Vector3d linearMomentum;
+
+  /// \brief Angular momentum about the world origin.
+  math::Vector3d angularMomentum;
+
+  /// \brief Number of links.
+  std::size_t links{0u};
+};
+
+/// \brief Components of a link, looked up once.
+struct LinkState
+{
+  /// \brief Mass properties.
+  ComponentHandle<components::Inertial> inertial;
+
+  /// \brief Pose of the link origin.
+  ComponentHandle<components::WorldPose> worldPose;
+
+  /// \brief Linear velocity of the link origin.
+  ComponentHandle<components::WorldLinearVelocity> worldLinVel;
+
+  /// \brief Angular velocity.
+  ComponentHandle<components::WorldAngularVelocity> worldAngVel;
+};
+}
+
+/// \brief Private data class
+class gz::sim::systems::WorldEnergyMonitorPrivate
+{
+  /// \brief Add the energy and momentum of a link.
+  /// \param[in] _link The link.
+  /// \param[in] _gravity Gravity of the world.
+  /// \param[in, out] _totals Totals to add to.
+  public: static void AddLink(LinkState &_link,
+              const math::Vector3d &_gravity, Totals &_totals);
+
+  /// \brief Compute the totals of all links.
+  /// \param[in] _gravity Gravity of the world.
+  /// \return The totals.
+  public: Totals Compute(const math::Vector3d &_gravity);
+
+  /// \brief Links, packed so they can be split between threads.
+  public: std::vector<LinkState> links;
+
+  /// \brief Index of each link in links.
+  public: std::unordered_map<Entity, std::size_t> linkIndices;
+
+  /// \brief Totals of each chunk of links, kept to reuse its memory.
+  public: std::vector<Totals> partials;
+
+  /// \brief The world.
+  public: Entity world{kNullEntity};
+
+  /// \brief Number of iterations between updates.
+  public: unsigned int updateInterval{100u};
+
+  /// \brief Energy increase in J above which a warning is printed.
+  public: std::optional<double> increaseThreshold;
+
+  /// \brief Totals of the previous update.
+  public: std::optional<Totals> previous;
+
+  /// \brief Communication node.
+  public: transport::Node node;
+
+  /// \brief Publisher of the totals.
+  public: transport::Node::Publisher pub;
+};
+
+//////////////////////////////////////////////////
+void WorldEnergyMonitorPrivate::AddLink(LinkState &_link,
+    const math::Vector3d &_gravity, Totals &_totals)
+{
+  auto inertial = _link.inertial.Get();
+  auto pose = _link.worldPose.Get();
+  auto linVel = _link.worldLinVel.Get();
+  auto angVel = _link.worldAngVel.Get();
+  if (!inertial || !pose || !linVel || !angVel)
+    return;
+
+  const double mass = inertial->Data().MassMatrix().Mass();
+  const auto &rot = pose->Data().Rot();
+  const math::Vector3d com = rot.RotateVector(inertial->Data().Pose().Pos());
+  const math::Vector3d worldCom = pose->Data().Pos() + com;
+
+  // Moment of inertia about the center of mass, in world coordinates
+  const math::Matrix3d rotation(rot);
+  const math::Matrix3d moi =
+      rotation * inertial->Data().Moi() * rotation.Transposed();
+
+  const auto &omega = angVel->Data();
+  const math::Vector3d velocity = linVel->Data() + omega.Cross(com);
+  const math::Vector3d momentum = mass * velocity;
+  const math::Vector3d spin = moi * omega;
+
+  _totals.kinetic += 0.5 * (mass * velocity.SquaredLength() +
+      omega.Dot(spin));
+  _totals.potential -= mass * _gravity.Dot(worldCom);
+  _totals.linearMomentum += momentum;
+  _totals.angularMomentum += worldCom.Cross(momentum) + spin;
+  ++_totals.links;
+}
+
+//////////////////////////////////////////////////
+Totals WorldEnergyMonitorPrivate::Compute(const math::Vector3d &_gravity)
+{
+  auto &pool = ThreadPool::Shared();
+  constexpr std::size_t kMinGrainSize{256u};
+  const std::size_t grain = pool.GrainSize(this->links.size(),
+      kMinGrainSize);
+
+  // Each chunk sums into its own slot, and the slots are added in order,
+  // so the totals don't depend on how the chunks were scheduled, nor in
+  // deterministic mode on the number of threads
+  this->partials.assign((this->links.size() + grain - 1u) / grain,
+      Totals());
+  pool.ParallelFor(this->links.size(), grain,
+    [&](std::size_t _begin, std::size_t _end)
+    {
+      auto &partial = this->partials[_begin / grain];
+      for (std::size_t i = _begin; i < _end; ++i)
+        AddLink(this->links[i], _gravity, partial);
+    });
+
+  Totals totals;
+  for (const auto &partial : this->partials)
+  {
+    totals.kinetic += partial.kinetic;
+    totals.potential += partial.potential;
+    totals.linearMomentum += partial.linearMomentum;
+    totals.angularMomentum += partial.angularMomentum;
+    totals.links += partial.links;
+  }
+  return totals;
+}
+
+//////////////////////////////////////////////////
+WorldEnergyMonitor::WorldEnergyMonitor()
+  : System(), dataPtr(std::make_unique<WorldEnergyMonitorPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+WorldEnergyMonitor::~WorldEnergyMonitor() = default;
+
+//////////////////////////////////////////////////
+void WorldEnergyMonitor::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  World world(_entity);
+  if (!world.Valid(_ecm))
+  {
+    gzerr << "WorldEnergyMonitor should be attached to a world entity. "
+           << "Failed to initialize." << std::endl;
+    return;
+  }
+  this->dataPtr->world = _entity;
+
+  const auto interval = _sdf->Get<int>("update_interval", 100).first;
+  if (interval < 1)
+  {
+    gzerr << "<update_interval> must be at least 1, got [" << interval
+           << "]. Using 100." << std::endl;
+  }
+  else
+  {
+    this->dataPtr->updateInterval = static_cast<unsigned int>(interval);
+  }
+
+  if (_sdf->HasElement("energy_increase_threshold"))
+  {
+    this->dataPtr->increaseThreshold =
+        _sdf->Get<double>("energy_increase_threshold");
+  }
+
+  const std::string defaultTopic{"/world/" +
+      world.Name(_ecm).value_or("default") + "/energy"};
+  const auto topic = validTopic({
+      _sdf->Get<std::string>("topic", defaultTopic).first, defaultTopic});
+  if (topic.empty())
+  {
+    gzerr << "Failed to create a valid topic for WorldEnergyMonitor."
+           << std::endl;
+    return;
+  }
+  this->dataPtr->pub = this->dataPtr->node.Advertise<msgs::Param>(topic);
+
+  gzmsg << "WorldEnergyMonitor publishing messages on [" << topic << "]"
+         << std::endl;
+}
+
+//////////////////////////////////////////////////
+void WorldEnergyMonitor::PreUpdate(const UpdateInfo &,
+    EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("WorldEnergyMonitor::PreUpdate");
+  if (kNullEntity == this->dataPtr->world)
+    return;
+
+  _ecm.EachRemoved<components::Link>(
+      [&](const Entity &_entity, const components::Link *) -> bool
+      {
+        auto it = this->dataPtr->linkIndices.find(_entity);
+        if (it == this->dataPtr->linkIndices.end())
+          return true;
+
+        // Move the last link into the freed slot
+        auto &links = this->dataPtr->links;
+        const std::size_t index = it->second;
+        this->dataPtr->linkIndices.erase(it);
+        if (index + 1u != links.size())
+        {
+          links[index] = std::move(links.back());
+          this->dataPtr->linkIndices[links[index].inertial.Entity()] = index;
+        }
+        links.pop_back();
+        return true;
+      });
+
+  _ecm.EachNew<components::Link, components::Inertial>(
+      [&](const Entity &_entity, const components::Link *,
+          const components::Inertial *) -> bool
+      {
+        if (this->dataPtr->linkIndices.count(_entity) > 0u)
+          return true;
+
+        // Physics only fills world states that exist
+        enableComponent<components::WorldPose>(_ecm, _entity);
+        enableComponent<components::WorldLinearVelocity>(_ecm, _entity);
+        enableComponent<components::WorldAngularVelocity>(_ecm, _entity);
+
+        this->dataPtr->linkIndices[_entity] = this->dataPtr->links.size();
+        this->dataPtr->links.push_back({
+            _ecm.Handle<components::Inertial>(_entity),
+            _ecm.Handle<components::WorldPose>(_entity),
+            _ecm.Handle<components::WorldLinearVelocity>(_entity),
+            _ecm.Handle<components::WorldAngularVelocity>(_entity)});
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+void WorldEnergyMonitor::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  GZ_PROFILE("WorldEnergyMonitor::PostUpdate");
+  if (_info.paused || kNullEntity == this->dataPtr->world ||
+      _info.iterations % this->dataPtr->updateInterval != 0u)
+  {
+    return;
+  }
+
+  const auto gravity = _ecm.ComponentData<components::Gravity>(
+      this->dataPtr->world).value_or(math::Vector3d::Zero);
+  const Totals totals = this->dataPtr->Compute(gravity);
+  const double energy = totals.kinetic + totals.potential;
+
+  auto &previous = this->dataPtr->previous;
+  if (this->dataPtr->increaseThreshold && previous &&
+      previous->links == totals.links &&
+      energy - (previous->kinetic + previous->potential) >
+      *this->dataPtr->increaseThreshold)
+  {
+    gzwarn << "World energy grew from [" <<
+           previous->kinetic + previous->potential << "] J to [" << energy
+           << "] J at iteration [" << _info.iterations
+           << "]. The physics solver may be unstable." << std::endl;
+  }
+  previous = totals;
+
+  if (!this->dataPtr->pub.HasConnections())
+    return;
+
+  msgs::Param msg;
+  msg.mutable_header()->mutable_stamp()->CopyFrom(
+      convert<msgs::Time>(_info.simTime));
+  auto &params = *msg.mutable_params();
+  auto setDouble = [&params](const std::string &_name, const double _value)
+  {
+    params[_name].set_type(msgs::Any::DOUBLE);
+    params[_name].set_double_value(_value);
+  };
+  auto setVector = [&params](const std::string &_name,
+      const math::Vector3d &_value)
+  {
+    params[_name].set_type(msgs::Any::VECTOR3D);
+    msgs::Set(params[_name].mutable_vector3d_value(), _value);
+  };
+  setDouble("kinetic_energy", totals.kinetic);
+  setDouble("potential_energy", totals.potential);
+  setDouble("energy", energy);
+  setVector("linear_momentum", totals.linearMomentum);
+  setVector("angular_momentum", totals.angularMomentum);
+  params["links"].set_type(msgs::Any::INT32);
+  params["links"].set_int_value(static_cast<int>(totals.links));
+  this->dataPtr->pub.Publish(msg);
+}
+
+GZ_ADD_PLUGIN(WorldEnergyMonitor,
+              System,
+              WorldEnergyMonitor::ISystemConfigure,
+              WorldEnergyMonitor::ISystemPreUpdate,
+              WorldEnergyMonitor::ISystemPostUpdate)
+
+GZ_ADD_PLUGIN_ALIAS(WorldEnergyMonitor,
+                    "gz::sim::systems::WorldEnergyMonitor")
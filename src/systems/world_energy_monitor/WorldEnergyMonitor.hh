@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SIM_SYSTEMS_WORLD_ENERGY_MONITOR_HH_
+#define GZ_SIM_SYSTEMS_WORLD_ENERGY_MONITOR_HH_
+
+#include <memory>
+#include <gz/sim/config.hh>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+namespace sim
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_SIM_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class WorldEnergyMonitorPrivate;
+
+  /// \brief A world system that periodically computes the total energy and
+  /// momentum of all links in the world, which is a cheap way of spotting
+  /// solver blow-ups in long runs.
+  ///
+  /// Each link's components are looked up once, when the link is created,
+  /// and the links are summed in parallel on the shared thread pool. The
+  /// result is published as a `gz::msgs::Param` with these parameters:
+  ///
+  /// - `kinetic_energy`: Total kinetic energy in J.
+  /// - `potential_energy`: Total gravitational potential energy in J,
+  /// relative to the world origin.
+  /// - `energy`: Sum of both.
+  /// - `linear_momentum`: Total linear momentum in kg m/s.
+  /// - `angular_momentum`: Total angular momentum about the world origin in
+  /// kg m^2/s.
+  /// - `links`: Number of links summed.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<topic>`: Topic to publish to. Defaults to
+  /// `/world/<world name>/energy`.
+  ///
+  /// - `<update_interval>`: Number of iterations between updates. Defaults
+  /// to 100.
+  ///
+  /// - `<energy_increase_threshold>`: If set, a warning is printed whenever
+  /// the energy grows by more than this many joules between two updates,
+  /// unless links were added or removed in between. Passive worlds only
+  /// lose energy, so a large increase usually means the solver became
+  /// unstable.
+  ///
+  /// ## Example Usage
+  ///
+  /** \verbatim
+    <plugin filename="gz-sim-world-energy-monitor-system"
+            name="gz::sim::systems::WorldEnergyMonitor">
+      <update_interval>1000</update_interval>
+      <energy_increase_threshold>100</energy_increase_threshold>
+    </plugin>
+   \endverbatim */
+  class WorldEnergyMonitor
+      : public System,
+        public ISystemConfigure,
+        public ISystemPreUpdate,
+        public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: WorldEnergyMonitor();
+
+    /// \brief Destructor
+    public: ~WorldEnergyMonitor() override;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) override;
+
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) override;
+
+    // Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<WorldEnergyMonitorPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+
+#endif
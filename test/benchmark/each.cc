@@ -18,12 +18,15 @@
 #include <benchmark/benchmark.h>
 
 #include <memory>
+#include <vector>
 
+#include "gz/sim/ComponentHandle.hh"
 #include "gz/sim/Entity.hh"
 #include "gz/sim/EntityComponentManager.hh"
 
 #include "gz/sim/components/AngularVelocity.hh"
 #include "gz/sim/components/Inertial.hh"
+#include "gz/sim/components/Link.hh"
 #include "gz/sim/components/LinearAcceleration.hh"
 #include "gz/sim/components/LinearVelocity.hh"
 #include "gz/sim/components/Name.hh"
@@ -359,6 +362,91 @@ BENCHMARK_DEFINE_F(ManyComponentFixture, Each10ComponentNoCache)
   }
 }
 
+/// Fixture that mimics a world with many links, each with a handful of
+/// components, where the components of interest are interleaved with
+/// allocations of other components. The second argument selects the
+/// ComponentStorageType.
+class LinkPoseFixture: public benchmark::Fixture
+{
+  protected: void SetUp(const ::benchmark::State &_state) override
+  {
+    mgr = std::make_unique<EntityComponentManager>();
+    mgr->SetComponentStorage(
+        static_cast<ComponentStorageType>(_state.range(1)));
+    this->Populate(_state.range(0));
+  }
+
+  protected: void Populate(int _entityCount)
+  {
+    for (int i = 0; i < _entityCount; ++i)
+    {
+      Entity entity = mgr->CreateEntity();
+      mgr->CreateComponent(entity, Link());
+      mgr->CreateComponent(entity, components::Name("link"));
+      mgr->CreateComponent(entity, Pose(math::Pose3d(i, 0, 0, 0, 0, 0)));
+      mgr->CreateComponent(entity, Inertial());
+      mgr->CreateComponent(entity, LinearVelocity());
+      mgr->CreateComponent(entity, AngularVelocity());
+    }
+  }
+
+  std::unique_ptr<EntityComponentManager> mgr;
+};
+
+BENCHMARK_DEFINE_F(LinkPoseFixture, EachLinkPose)
+(benchmark::State &_st)
+{
+  for (auto _ : _st)
+  {
+    for (int eachIter = 0; eachIter < kEachIterations; eachIter++)
+    {
+      double sum{0.0};
+      mgr->Each<Link, Pose>(
+          [&](const Entity &, const Link *, const Pose *_pose)->bool
+          {
+            sum += _pose->Data().Pos().X();
+            return true;
+          });
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+}
+
+BENCHMARK_DEFINE_F(LinkPoseFixture, ComponentLookup)
+(benchmark::State &_st)
+{
+  auto entityCount = static_cast<Entity>(_st.range(0));
+  for (auto _ : _st)
+  {
+    double sum{0.0};
+    for (Entity entity = 1; entity <= entityCount; ++entity)
+    {
+      auto pose = mgr->Component<Pose>(entity);
+      sum += pose->Data().Pos().X();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK_DEFINE_F(LinkPoseFixture, HandleLookup)
+(benchmark::State &_st)
+{
+  auto entityCount = static_cast<Entity>(_st.range(0));
+  std::vector<ComponentHandle<Pose>> handles;
+  for (Entity entity = 1; entity <= entityCount; ++entity)
+    handles.push_back(mgr->Handle<Pose>(entity));
+
+  for (auto _ : _st)
+  {
+    double sum{0.0};
+    for (auto &handle : handles)
+    {
+      sum += handle->Data().Pos().X();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
 /// Method to generate test argument combinations.  google/benchmark does
 /// powers of 2 by default, which looks kind of ugly.
 static void EachTestArgs(benchmark::internal::Benchmark *_b)
@@ -422,6 +510,24 @@ BENCHMARK_REGISTER_F(ManyComponentFixture, Each10ComponentCache)
   ->Arg(1000)
   ->Unit(benchmark::kMillisecond);
 
+BENCHMARK_REGISTER_F(LinkPoseFixture, EachLinkPose)
+  ->ArgsProduct({{1000, 10000, 20000},
+      {static_cast<int>(ComponentStorageType::kHeap),
+       static_cast<int>(ComponentStorageType::kContiguous)}})
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(LinkPoseFixture, ComponentLookup)
+  ->ArgsProduct({{1000, 10000, 20000},
+      {static_cast<int>(ComponentStorageType::kHeap),
+       static_cast<int>(ComponentStorageType::kContiguous)}})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(LinkPoseFixture, HandleLookup)
+  ->ArgsProduct({{1000, 10000, 20000},
+      {static_cast<int>(ComponentStorageType::kHeap),
+       static_cast<int>(ComponentStorageType::kContiguous)}})
+  ->Unit(benchmark::kMicrosecond);
+
 // OSX needs the semicolon, Ubuntu complains that there's an extra ';'
 #if !defined(_MSC_VER)
 #pragma GCC diagnostic push
@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <gz/msgs/serialized_map.pb.h>
+
+#include <memory>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/sim/Entity.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Util.hh"
+
+#include "gz/sim/components/Link.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
+#include "gz/sim/components/Pose.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace components;
+
+/// \brief Entity component manager that exposes the functions the
+/// simulation runner calls between steps.
+class BenchmarkEcm : public EntityComponentManager
+{
+  public: using EntityComponentManager::ClearNewlyCreatedEntities;
+  public: using EntityComponentManager::ProcessRemoveEntityRequests;
+};
+
+/// \brief Create entities with the components of a link.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _count Number of entities.
+/// \return The created entities.
+std::vector<Entity> createLinks(EntityComponentManager &_ecm, int64_t _count)
+{
+  std::vector<Entity> entities;
+  entities.reserve(static_cast<std::size_t>(_count));
+  for (int64_t i = 0; i < _count; ++i)
+  {
+    Entity entity = _ecm.CreateEntity();
+    _ecm.CreateComponent(entity, Link());
+    _ecm.CreateComponent(entity, components::Name("link"));
+    _ecm.CreateComponent(entity,
+        Pose(math::Pose3d(static_cast<double>(i), 0, 0, 0, 0, 0)));
+    entities.push_back(entity);
+  }
+  return entities;
+}
+
+/// \brief Measure creating entities and removing them over two steps, as
+/// when models are spawned and deleted.
+// NOLINTNEXTLINE
+void BM_CreateRemoveEntities(benchmark::State &_st)
+{
+  BenchmarkEcm ecm;
+  // A view to be updated on creation and removal
+  ecm.Each<Link, Pose>([](const Entity &, const Link *, const Pose *)
+      {
+        return true;
+      });
+
+  for (auto _ : _st)
+  {
+    auto entities = createLinks(ecm, _st.range(0));
+    ecm.ClearNewlyCreatedEntities();
+    for (auto entity : entities)
+      ecm.RequestRemoveEntity(entity, false);
+    ecm.ProcessRemoveEntityRequests();
+  }
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0));
+}
+
+/// \brief Measure iterating over newly created entities.
+// NOLINTNEXTLINE
+void BM_EachNew(benchmark::State &_st)
+{
+  BenchmarkEcm ecm;
+  createLinks(ecm, _st.range(0));
+
+  for (auto _ : _st)
+  {
+    int64_t matched = 0;
+    ecm.EachNew<Link, Pose>(
+        [&](const Entity &, const Link *, const Pose *)
+        {
+          ++matched;
+          return true;
+        });
+    if (matched != _st.range(0))
+      _st.SkipWithError("Failed to match correct number of entities");
+  }
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0));
+}
+
+/// \brief Measure iterating over entities marked for removal.
+// NOLINTNEXTLINE
+void BM_EachRemoved(benchmark::State &_st)
+{
+  BenchmarkEcm ecm;
+  auto entities = createLinks(ecm, _st.range(0));
+  ecm.ClearNewlyCreatedEntities();
+  for (auto entity : entities)
+    ecm.RequestRemoveEntity(entity, false);
+
+  for (auto _ : _st)
+  {
+    int64_t matched = 0;
+    ecm.EachRemoved<Link, Pose>(
+        [&](const Entity &, const Link *, const Pose *)
+        {
+          ++matched;
+          return true;
+        });
+    if (matched != _st.range(0))
+      _st.SkipWithError("Failed to match correct number of entities");
+  }
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0));
+}
+
+/// \brief Measure the overhead of looking up an existing view, which is paid
+/// on every Each call, by iterating over very few entities.
+// NOLINTNEXTLINE
+void BM_EachViewLookup(benchmark::State &_st)
+{
+  BenchmarkEcm ecm;
+  createLinks(ecm, 1);
+  ecm.ClearNewlyCreatedEntities();
+
+  for (auto _ : _st)
+  {
+    for (int64_t i = 0; i < _st.range(0); ++i)
+    {
+      ecm.Each<Link, Pose>(
+          [&](const Entity &, const Link *, const Pose *)
+          {
+            return true;
+          });
+    }
+  }
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0));
+}
+
+/// \brief Measure the creation of a view over existing entities, which
+/// happens the first time a system asks for a set of components.
+// NOLINTNEXTLINE
+void BM_ViewCreation(benchmark::State &_st)
+{
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    auto ecm = std::make_unique<BenchmarkEcm>();
+    createLinks(*ecm, _st.range(0));
+    _st.ResumeTiming();
+
+    ecm->Each<Link, components::Name, Pose>(
+        [](const Entity &, const Link *, const components::Name *,
+           const Pose *)
+        {
+          return true;
+        });
+
+    _st.PauseTiming();
+    ecm.reset();
+    _st.ResumeTiming();
+  }
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0));
+}
+
+/// \brief Measure computing the world pose of an entity nested a number of
+/// levels deep.
+// NOLINTNEXTLINE
+void BM_WorldPoseDepth(benchmark::State &_st)
+{
+  EntityComponentManager ecm;
+  Entity parent = ecm.CreateEntity();
+  for (int64_t i = 0; i < _st.range(0); ++i)
+  {
+    Entity child = ecm.CreateEntity();
+    ecm.CreateComponent(child, Pose(math::Pose3d(1, 0, 0, 0, 0, 0.1)));
+    ecm.CreateComponent(child, ParentEntity(parent));
+    parent = child;
+  }
+
+  for (auto _ : _st)
+  {
+    benchmark::DoNotOptimize(worldPose(parent, ecm));
+  }
+  _st.counters["depth"] = static_cast<double>(_st.range(0));
+}
+
+/// \brief Measure applying a state message, as done by secondaries and
+/// the GUI on every update.
+// NOLINTNEXTLINE
+void BM_SetState(benchmark::State &_st)
+{
+  EntityComponentManager source;
+  createLinks(source, _st.range(0));
+  msgs::SerializedStateMap stateMsg;
+  source.State(stateMsg);
+
+  EntityComponentManager destination;
+  destination.SetState(stateMsg);
+
+  for (auto _ : _st)
+  {
+    destination.SetState(stateMsg);
+  }
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0));
+}
+
+/// \brief Overwrite the poses of some links, as a step would.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _entities Links.
+/// \param[in] _count Number of links to move.
+void moveLinks(EntityComponentManager &_ecm,
+    const std::vector<Entity> &_entities, int64_t _count)
+{
+  for (int64_t i = 0; i < _count; ++i)
+  {
+    _ecm.CreateComponent(_entities[static_cast<std::size_t>(i)],
+        Pose(math::Pose3d(0, static_cast<double>(i), 0, 0, 0, 0)));
+  }
+}
+
+/// \brief Measure resetting the ECM to an earlier copy with ResetTo, which
+/// compares every component, for comparison with BM_IncrementalResetTo.
+// NOLINTNEXTLINE
+void BM_ResetTo(benchmark::State &_st)
+{
+  BenchmarkEcm ecm;
+  auto entities = createLinks(ecm, _st.range(0));
+  ecm.ClearNewlyCreatedEntities();
+  EntityComponentManager initial;
+  initial.CopyFrom(ecm);
+
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    moveLinks(ecm, entities, _st.range(1));
+    _st.ResumeTiming();
+    ecm.ResetTo(initial);
+  }
+  _st.counters["changed"] = static_cast<double>(_st.range(1));
+}
+
+/// \brief Measure resetting the ECM to an earlier copy with
+/// IncrementalResetTo, which only restores the components that changed
+/// since the copy.
+// NOLINTNEXTLINE
+void BM_IncrementalResetTo(benchmark::State &_st)
+{
+  BenchmarkEcm ecm;
+  auto entities = createLinks(ecm, _st.range(0));
+  ecm.ClearNewlyCreatedEntities();
+  EntityComponentManager initial;
+  initial.CopyFrom(ecm);
+
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    moveLinks(ecm, entities, _st.range(1));
+    _st.ResumeTiming();
+    ecm.IncrementalResetTo(initial);
+  }
+  _st.counters["changed"] = static_cast<double>(_st.range(1));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_CreateRemoveEntities)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_EachNew)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_EachRemoved)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_EachViewLookup)
+  ->Arg(100)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_ViewCreation)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_WorldPoseDepth)
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->Arg(64)
+  ->Unit(benchmark::kNanosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_SetState)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_ResetTo)
+  ->Args({10000, 10})
+  ->Args({10000, 1000})
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_IncrementalResetTo)
+  ->Args({10000, 1})
+  ->Args({10000, 10})
+  ->Args({10000, 100})
+  ->Args({10000, 1000})
+  ->Args({10000, 10000})
+  ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+BENCHMARK_MAIN();
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic pop
+#endif
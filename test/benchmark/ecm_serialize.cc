@@ -17,7 +17,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "gz/sim/Entity.hh"
 #include "gz/sim/EntityComponentManager.hh"
@@ -130,6 +132,74 @@ void BM_Serialize5Component(benchmark::State &_st)
   _st.counters["num_components"] = 5;
 }
 
+/// \brief Create entities with a pose and a linear velocity.
+/// \param[in] _entityCount Number of entities.
+/// \return The populated manager.
+std::unique_ptr<EntityComponentManager> PoseVelocityEcm(int64_t _entityCount)
+{
+  auto mgr = std::make_unique<EntityComponentManager>();
+  for (int ii = 0; ii < _entityCount; ++ii)
+  {
+    auto e = mgr->CreateEntity();
+    mgr->CreateComponent(e, Pose(math::Pose3d(ii, 0, 0, 0, 0, 0)));
+    mgr->CreateComponent(e, LinearVelocity(math::Vector3d(ii, 0, 0)));
+  }
+  return mgr;
+}
+
+// NOLINTNEXTLINE
+void BM_SerializePoseVelocityMap(benchmark::State &_st)
+{
+  size_t serializedSize = 0;
+  auto entityCount = _st.range(0);
+  auto mgr = PoseVelocityEcm(entityCount);
+  for (auto _: _st)
+  {
+    msgs::SerializedStateMap stateMsg;
+    mgr->State(stateMsg, {}, {}, true);
+    serializedSize = stateMsg.ByteSizeLong();
+  }
+  _st.counters["serialized_size"] = static_cast<double>(serializedSize);
+  _st.counters["num_entities"] = static_cast<double>(entityCount);
+  _st.counters["num_components"] = 2;
+}
+
+// NOLINTNEXTLINE
+void BM_SerializePoseVelocitySnapshot(benchmark::State &_st)
+{
+  auto entityCount = _st.range(0);
+  auto mgr = PoseVelocityEcm(entityCount);
+  std::vector<std::uint8_t> buffer;
+  for (auto _: _st)
+  {
+    mgr->StateSnapshot(buffer, {}, {}, true);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  _st.counters["serialized_size"] = static_cast<double>(buffer.size());
+  _st.counters["num_entities"] = static_cast<double>(entityCount);
+  _st.counters["num_components"] = 2;
+}
+
+// NOLINTNEXTLINE
+void BM_DeserializePoseVelocitySnapshot(benchmark::State &_st)
+{
+  auto entityCount = _st.range(0);
+  auto mgr = PoseVelocityEcm(entityCount);
+  std::vector<std::uint8_t> buffer;
+  mgr->StateSnapshot(buffer, {}, {}, true);
+
+  // Deserialize into a manager that already has the entities, as a
+  // secondary or the GUI does on every update
+  EntityComponentManager remote;
+  remote.SetStateSnapshot(buffer.data(), buffer.size());
+  for (auto _: _st)
+  {
+    remote.SetStateSnapshot(buffer.data(), buffer.size());
+  }
+  _st.counters["num_entities"] = static_cast<double>(entityCount);
+  _st.counters["num_components"] = 2;
+}
+
 // NOLINTNEXTLINE
 BENCHMARK(BM_Serialize1Component)
   ->Arg(10)
@@ -148,6 +218,27 @@ BENCHMARK(BM_Serialize5Component)
   ->Arg(1000)
   ->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE
+BENCHMARK(BM_SerializePoseVelocityMap)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_SerializePoseVelocitySnapshot)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_DeserializePoseVelocitySnapshot)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
 // OSX needs the semicolon, Ubuntu complains that there's an extra ';'
 #if !defined(_MSC_VER)
 #pragma GCC diagnostic push
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <gz/common/Event.hh>
+
+#include "gz/sim/EventChannel.hh"
+#include "gz/sim/EventManager.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Event dispatched with common::EventT.
+using CommonEvent = common::EventT<void(int64_t &), struct CommonEventTag>;
+
+/// \brief Event dispatched with EventChannel.
+using ChannelEvent = EventChannel<void(int64_t &), struct ChannelEventTag>;
+
+/// \brief Connect subscribers that add to their argument.
+/// \param[in] _manager Event manager to connect through.
+/// \param[in] _count Number of subscribers.
+/// \tparam E Event type.
+/// \return The connections.
+template <typename E>
+std::vector<common::ConnectionPtr> connect(EventManager &_manager,
+    int64_t _count)
+{
+  std::vector<common::ConnectionPtr> connections;
+  for (int64_t i = 0; i < _count; ++i)
+  {
+    connections.push_back(_manager.Connect<E>(
+        [](int64_t &_sum) { ++_sum; }));
+  }
+  return connections;
+}
+
+/// \brief Emit through EventManager::Emit, which looks up the event on
+/// every call.
+/// \tparam E Event type.
+template <typename E>
+void BM_Emit(benchmark::State &_st)
+{
+  EventManager manager;
+  auto connections = connect<E>(manager, _st.range(0));
+  int64_t sum{0};
+  for (auto _ : _st)
+  {
+    manager.Emit<E>(sum);
+  }
+  benchmark::DoNotOptimize(sum);
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+/// \brief Emit on an event got once with EventManager::Channel.
+/// \tparam E Event type.
+template <typename E>
+void BM_Channel(benchmark::State &_st)
+{
+  EventManager manager;
+  auto connections = connect<E>(manager, _st.range(0));
+  auto &event = manager.Channel<E>();
+  int64_t sum{0};
+  for (auto _ : _st)
+  {
+    event.Signal(sum);
+  }
+  benchmark::DoNotOptimize(sum);
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_Emit, CommonEvent)
+  ->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_Emit, ChannelEvent)
+  ->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_Channel, CommonEvent)
+  ->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_Channel, ChannelEvent)
+  ->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+BENCHMARK_MAIN();
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+
+#include "MeshInertiaCalculator.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Create the triangles of a unit sphere, in both layouts.
+/// \param[in] _count Approximate number of triangles.
+/// \param[out] _triangles Triangles as a vector of structs.
+/// \param[out] _arrays Triangles as a structure of arrays.
+void sphereTriangles(int64_t _count, std::vector<Triangle> &_triangles,
+    TriangleArrays &_arrays)
+{
+  const int segments = std::max(2,
+      static_cast<int>(std::sqrt(static_cast<double>(_count) / 2)));
+  const math::Vector3d center(1, 2, 3);
+  auto vertex = [&](int _i, int _j)
+  {
+    const double theta = GZ_PI * _i / segments;
+    const double phi = 2 * GZ_PI * _j / segments;
+    return center + math::Vector3d(std::sin(theta) * std::cos(phi),
+        std::sin(theta) * std::sin(phi), std::cos(theta));
+  };
+
+  auto add = [&](const math::Vector3d &_v0, const math::Vector3d &_v1,
+      const math::Vector3d &_v2)
+  {
+    _triangles.push_back({_v0, _v1, _v2, (_v0 + _v1 + _v2) / 3});
+    _arrays.Add(_v0, _v1, _v2);
+  };
+
+  for (int i = 0; i < segments; ++i)
+  {
+    for (int j = 0; j < segments; ++j)
+    {
+      add(vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1));
+      add(vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1));
+    }
+  }
+}
+
+/// \brief Check that two results match up to rounding.
+/// \param[in] _a First mass matrix.
+/// \param[in] _b Second mass matrix.
+/// \return True if they match.
+bool sameResult(const math::MassMatrix3d &_a, const math::MassMatrix3d &_b)
+{
+  const double tol = 1e-9 * std::abs(_a.Mass());
+  bool same = std::abs(_a.Mass() - _b.Mass()) <= tol;
+  for (int i = 0; i < 3; ++i)
+  {
+    same = same &&
+      std::abs(_a.DiagonalMoments()[i] - _b.DiagonalMoments()[i]) <= tol &&
+      std::abs(_a.OffDiagonalMoments()[i] - _b.OffDiagonalMoments()[i]) <=
+      tol;
+  }
+  return same;
+}
+
+// NOLINTNEXTLINE
+void BM_MassPropertiesTriangles(benchmark::State &_st)
+{
+  std::vector<Triangle> triangles;
+  TriangleArrays arrays;
+  sphereTriangles(_st.range(0), triangles, arrays);
+
+  MeshInertiaCalculator calculator;
+  math::MassMatrix3d massMatrix;
+  math::Pose3d centerOfMass;
+  for (auto _ : _st)
+  {
+    calculator.CalculateMassProperties(triangles, 1000.0, massMatrix,
+        centerOfMass);
+    benchmark::DoNotOptimize(massMatrix);
+  }
+  _st.SetItemsProcessed(_st.iterations() *
+      static_cast<int64_t>(triangles.size()));
+}
+
+// NOLINTNEXTLINE
+void BM_MassPropertiesTriangleArrays(benchmark::State &_st)
+{
+  std::vector<Triangle> triangles;
+  TriangleArrays arrays;
+  sphereTriangles(_st.range(0), triangles, arrays);
+
+  MeshInertiaCalculator calculator;
+  math::MassMatrix3d expected;
+  math::Pose3d expectedCenter;
+  calculator.CalculateMassProperties(triangles, 1000.0, expected,
+      expectedCenter);
+
+  math::MassMatrix3d massMatrix;
+  math::Pose3d centerOfMass;
+  calculator.CalculateMassProperties(arrays, 1000.0, massMatrix,
+      centerOfMass);
+  if (!sameResult(expected, massMatrix) ||
+      expectedCenter.Pos() != centerOfMass.Pos())
+  {
+    _st.SkipWithError("Results differ from the vector of Triangles");
+    return;
+  }
+
+  for (auto _ : _st)
+  {
+    calculator.CalculateMassProperties(arrays, 1000.0, massMatrix,
+        centerOfMass);
+    benchmark::DoNotOptimize(massMatrix);
+  }
+  _st.SetItemsProcessed(_st.iterations() *
+      static_cast<int64_t>(arrays.Size()));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_MassPropertiesTriangles)
+  ->Arg(1000)
+  ->Arg(100000)
+  ->Arg(1000000)
+  ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_MassPropertiesTriangleArrays)
+  ->Arg(1000)
+  ->Arg(100000)
+  ->Arg(1000000)
+  ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+BENCHMARK_MAIN();
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <sdf/Root.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/EventManager.hh"
+#include "gz/sim/SdfEntityCreator.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/ServerConfig.hh"
+#include "gz/sim/System.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Number of simulation iterations run by each benchmark iteration.
+constexpr const int kStepIterations {100};
+
+/// \brief System that does nothing, to measure the overhead of the loop.
+class EmptySystem :
+  public System,
+  public ISystemPreUpdate,
+  public ISystemUpdate,
+  public ISystemPostUpdate
+{
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &, EntityComponentManager &) override
+  {
+  }
+
+  // Documentation inherited
+  public: void Update(const UpdateInfo &, EntityComponentManager &) override
+  {
+  }
+
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &,
+                          const EntityComponentManager &) override
+  {
+  }
+};
+
+/// \brief Generate a world with free falling boxes.
+/// \param[in] _count Number of boxes.
+/// \param[in] _physics Whether to load the physics system.
+/// \return World SDF string.
+std::string boxesWorld(int64_t _count, bool _physics)
+{
+  std::string sdf = "<?xml version=\"1.0\" ?><sdf version=\"1.6\">"
+      "<world name=\"boxes\">";
+  if (_physics)
+  {
+    sdf += "<plugin filename=\"gz-sim-physics-system\""
+           " name=\"gz::sim::systems::Physics\"/>";
+  }
+  for (int64_t i = 0; i < _count; ++i)
+  {
+    sdf += "<model name=\"box_" + std::to_string(i) + "\">"
+        "<pose>" + std::to_string(i % 100) + " " + std::to_string(i / 100) +
+        " 1 0 0 0</pose><link name=\"link\"><collision name=\"collision\">"
+        "<geometry><box><size>0.5 0.5 0.5</size></box></geometry>"
+        "</collision></link></model>";
+  }
+  sdf += "</world></sdf>";
+  return sdf;
+}
+
+/// \brief Measure the overhead of the simulation loop with a number of
+/// systems that do nothing.
+// NOLINTNEXTLINE
+void BM_StepEmptySystems(benchmark::State &_st)
+{
+  common::Console::SetVerbosity(0);
+  ServerConfig config;
+  config.SetSdfString(boxesWorld(0, false));
+  Server server(config);
+  for (int64_t i = 0; i < _st.range(0); ++i)
+    server.AddSystem(std::make_shared<EmptySystem>());
+
+  for (auto _ : _st)
+  {
+    server.Run(true, kStepIterations, false);
+  }
+  _st.SetItemsProcessed(_st.iterations() * kStepIterations);
+  _st.counters["num_systems"] = static_cast<double>(_st.range(0));
+}
+
+/// \brief Measure steps with the physics system, including the write-back
+/// of poses and velocities to the ECM.
+// NOLINTNEXTLINE
+void BM_StepPhysics(benchmark::State &_st)
+{
+  common::Console::SetVerbosity(0);
+  ServerConfig config;
+  config.SetSdfString(boxesWorld(_st.range(0), true));
+  Server server(config);
+
+  for (auto _ : _st)
+  {
+    server.Run(true, kStepIterations, false);
+  }
+  _st.SetItemsProcessed(_st.iterations() * kStepIterations);
+  _st.counters["num_models"] = static_cast<double>(_st.range(0));
+}
+
+/// \brief Measure the creation of the entities of a world.
+// NOLINTNEXTLINE
+void BM_LoadWorld(benchmark::State &_st)
+{
+  common::Console::SetVerbosity(0);
+  sdf::Root root;
+  if (!root.LoadSdfString(boxesWorld(_st.range(0), false)).empty())
+  {
+    _st.SkipWithError("Failed to load world");
+    return;
+  }
+
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    auto ecm = std::make_unique<EntityComponentManager>();
+    EventManager eventMgr;
+    SdfEntityCreator creator(*ecm, eventMgr);
+    _st.ResumeTiming();
+
+    creator.CreateEntities(root.WorldByIndex(0));
+
+    _st.PauseTiming();
+    ecm.reset();
+    _st.ResumeTiming();
+  }
+  _st.counters["num_models"] = static_cast<double>(_st.range(0));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_StepEmptySystems)
+  ->Arg(0)
+  ->Arg(10)
+  ->Arg(100)
+  ->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_StepPhysics)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_LoadWorld)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+BENCHMARK_MAIN();
+#if !defined(_MSC_VER)
+#pragma GCC diagnostic pop
+#endif
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -167,3 +169,77 @@ TEST_F(ActorFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(ActorTrajectoryNoMesh))
 
   g_scene.reset();
 }
+
+/////////////////////////////////////////////////
+// Cull the animation of the box, which the camera doesn't see, and run past
+// the end of its looping trajectory. Verify that its pose keeps changing.
+TEST_F(ActorFixture,
+    GZ_UTILS_TEST_DISABLED_ON_MAC(ActorTrajectoryCulledAndLooping))
+{
+  std::ifstream file(std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/actor_trajectory.sdf");
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string sdfString = buffer.str();
+
+  const std::string renderEngine{"<render_engine>ogre2</render_engine>"};
+  auto pos = sdfString.find(renderEngine);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.insert(pos + renderEngine.size(),
+      "<actor_animation_culling>true</actor_animation_culling>");
+
+  // Turn the camera away from the box
+  const std::string cameraPose{"<pose>-5 0 0 0 0.5 0</pose>"};
+  pos = sdfString.find(cameraPose);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.replace(pos, cameraPose.size(), "<pose>-5 0 0 0 0.5 3.14</pose>");
+
+  sim::ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+  sim::Server server(serverConfig);
+
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_modelPoses.clear();
+  }
+
+  common::ConnectionPtr postRenderConn;
+  this->mockSystem->configureCallback =
+    [&](const sim::Entity &,
+           const std::shared_ptr<const sdf::Element> &,
+           sim::EntityComponentManager &,
+           sim::EventManager &_eventMgr)
+    {
+      postRenderConn = _eventMgr.Connect<sim::events::PostRender>(
+          std::bind(&::OnPostRender));
+    };
+
+  // The trajectory lasts 4 s
+  server.AddSystem(this->systemPtr);
+  server.Run(true, 5000, false);
+
+  const std::string boxName = "animated_box";
+  bool hasBoxPose = false;
+  int sleep = 0;
+  while (!hasBoxPose && sleep++ < 50)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::lock_guard<std::mutex> lock(g_mutex);
+    hasBoxPose = g_modelPoses.find(boxName) != g_modelPoses.end();
+  }
+  ASSERT_TRUE(hasBoxPose);
+
+  // The poses of culled actors are still updated, after looping as well
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto &poses = g_modelPoses[boxName];
+    ASSERT_LT(2u, poses.size());
+    for (unsigned int i = 0; i < poses.size()-2; i+=2)
+    {
+      EXPECT_NE(poses[i], poses[i+2]);
+      EXPECT_NEAR(1.0, poses[i].Pos().Z(), 1e-3);
+    }
+  }
+
+  g_scene.reset();
+}
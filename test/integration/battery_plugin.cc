@@ -17,7 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <gz/msgs/battery_state.pb.h>
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <gz/common/Battery.hh>
 #include <gz/common/Console.hh>
@@ -423,3 +429,60 @@ TEST_F(BatteryPluginTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(PowerDrainTopic))
   // The state of charge should be the same since the discharge was stopped
   EXPECT_DOUBLE_EQ(batComp->Data(), stateOfCharge);
 }
+
+/////////////////////////////////////////////////
+// Battery state messages are throttled in simulation time
+TEST_F(BatteryPluginTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(StatePublishRate))
+{
+  std::ifstream file(common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+    "test", "worlds", "battery.sdf"));
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string sdfString = buffer.str();
+  const std::string batteryName{
+      "<battery_name>linear_battery</battery_name>"};
+  const auto pos = sdfString.find(batteryName);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.insert(pos + batteryName.size(),
+      "<state_publish_rate>10</state_publish_rate>");
+
+  // Run in real time, so that the wall time limit of 50 messages per second
+  // isn't reached
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+  serverConfig.SetUpdateRate(1000.0);
+  Server server(serverConfig);
+
+  std::mutex mutex;
+  std::vector<double> stamps;
+  std::function<void(const msgs::BatteryState &)> stateCb =
+      [&](const msgs::BatteryState &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stamps.push_back(_msg.header().stamp().sec() +
+            _msg.header().stamp().nsec() * 1e-9);
+      };
+
+  transport::Node node;
+  node.Subscribe(
+      "/model/linear_battery_demo_model/battery/linear_battery/state",
+      stateCb);
+
+  // Let the publisher discover the subscriber
+  server.Run(true, 100, false);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stamps.clear();
+  }
+
+  // 1 s of simulation time
+  server.Run(true, 1000, false);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_LE(9u, stamps.size());
+  EXPECT_GE(11u, stamps.size());
+  for (std::size_t i = 1u; i < stamps.size(); ++i)
+    EXPECT_LE(0.1 - 1e-6, stamps[i] - stamps[i - 1u]);
+}
@@ -20,8 +20,11 @@
 #include <gz/msgs/empty.pb.h>
 #include <gz/msgs/twist.pb.h>
 
+#include <fstream>
 #include <optional>
 #include <regex>
+#include <sstream>
+#include <vector>
 
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
@@ -34,9 +37,13 @@
 #include "gz/sim/Entity.hh"
 #include "gz/sim/Server.hh"
 #include "gz/sim/SystemLoader.hh"
+#include "gz/sim/components/DetachableJoint.hh"
+#include "gz/sim/components/Link.hh"
 #include "gz/sim/components/Name.hh"
+#include "gz/sim/components/ParentEntity.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Static.hh"
 #include "test_config.hh"
 
 #include "helpers/Relay.hh"
@@ -512,6 +519,156 @@ TEST_F(BreadcrumbsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(DeployDisablePhysics))
   this->server->Run(true, iterTestStart + 2001, false);
 }
 
+/////////////////////////////////////////////////
+// The test verifies that breadcrumbs frozen by disable_physics_time are all
+// attached to a single shared static model.
+TEST_F(BreadcrumbsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SharedStaticModel))
+{
+  // Start server
+  this->LoadWorld(common::joinPaths("test", "worlds", "breadcrumbs.sdf"));
+
+  test::Relay testSystem;
+  transport::Node node;
+  auto cmdVel = node.Advertise<msgs::Twist>("/model/vehicle_blue/cmd_vel");
+  auto deployB2 =
+      node.Advertise<msgs::Empty>("/model/vehicle_blue/breadcrumbs/B2/deploy");
+
+  std::size_t iterTestStart = 1000;
+  testSystem.OnPostUpdate([&](const UpdateInfo &_info,
+                              const EntityComponentManager &_ecm)
+  {
+    // Deploy a breadcrumb, move the vehicle forward, then deploy another one
+    // and check that both are attached to the same static model
+    if (_info.iterations == iterTestStart)
+    {
+      deployB2.Publish(msgs::Empty());
+      msgs::Twist msg;
+      msg.mutable_linear()->set_x(0.5);
+      cmdVel.Publish(msg);
+    }
+    else if (_info.iterations == iterTestStart + 2000)
+    {
+      // Stop vehicle
+      cmdVel.Publish(msgs::Twist());
+    }
+    else if (_info.iterations == iterTestStart + 2200)
+    {
+      deployB2.Publish(msgs::Empty());
+    }
+    else if (_info.iterations == iterTestStart + 3000)
+    {
+      EXPECT_NE(kNullEntity, _ecm.EntityByComponents(components::Model(),
+          components::Name("B2_0")));
+      EXPECT_NE(kNullEntity, _ecm.EntityByComponents(components::Model(),
+          components::Name("B2_1")));
+
+      // Only one static model is created for the breadcrumbs
+      std::vector<Entity> staticModels;
+      _ecm.Each<components::Model, components::Name>(
+          [&](const Entity &_entity, const components::Model *,
+              const components::Name *_name) -> bool
+          {
+            if (_name->Data().find("__static__") != std::string::npos)
+              staticModels.push_back(_entity);
+            return true;
+          });
+      ASSERT_EQ(1u, staticModels.size());
+      EXPECT_EQ("vehicle_blue_B2__static__",
+          _ecm.Component<components::Name>(staticModels[0])->Data());
+
+      auto staticComp =
+          _ecm.Component<components::Static>(staticModels[0]);
+      ASSERT_NE(nullptr, staticComp);
+      EXPECT_TRUE(staticComp->Data());
+
+      Entity staticLink = _ecm.EntityByComponents(components::Link(),
+          components::ParentEntity(staticModels[0]),
+          components::Name("static_link"));
+      ASSERT_NE(kNullEntity, staticLink);
+
+      // Both breadcrumbs are attached to the shared static link
+      std::size_t jointCount = 0;
+      _ecm.Each<components::DetachableJoint>(
+          [&](const Entity &,
+              const components::DetachableJoint *_joint) -> bool
+          {
+            if (_joint->Data().parentLink == staticLink)
+              ++jointCount;
+            return true;
+          });
+      EXPECT_EQ(2u, jointCount);
+    }
+  });
+
+  this->server->AddSystem(testSystem.systemPtr);
+  this->server->Run(true, iterTestStart + 3001, false);
+}
+
+/////////////////////////////////////////////////
+// The test verifies that breadcrumbs are spawned as static models when
+// spawn_static is set.
+TEST_F(BreadcrumbsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SpawnStatic))
+{
+  std::ifstream sdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "breadcrumbs.sdf"));
+  std::stringstream ss;
+  ss << sdfFile.rdbuf();
+  std::string sdfStr = ss.str();
+
+  // Enable spawn_static in the plugin that deploys B1
+  auto modelPos = sdfStr.find("<model name=\"B1\">");
+  ASSERT_NE(std::string::npos, modelPos);
+  auto breadcrumbPos = sdfStr.rfind("<breadcrumb>", modelPos);
+  ASSERT_NE(std::string::npos, breadcrumbPos);
+  sdfStr.insert(breadcrumbPos, "<spawn_static>true</spawn_static>\n");
+
+  this->serverConfig.SetResourceCache(test::UniqueTestDirectoryEnv::Path());
+  this->serverConfig.SetSdfString(sdfStr);
+  this->server = std::make_unique<Server>(this->serverConfig);
+  using namespace std::chrono_literals;
+  this->server->SetUpdatePeriod(1ns);
+
+  test::Relay testSystem;
+  transport::Node node;
+  auto deployB1 =
+      node.Advertise<msgs::Empty>("/model/vehicle_blue/breadcrumbs/B1/deploy");
+
+  std::size_t iterTestStart = 1000;
+  std::optional<math::Pose3d> initialPose;
+  testSystem.OnPostUpdate([&](const UpdateInfo &_info,
+                              const EntityComponentManager &_ecm)
+  {
+    if (_info.iterations == iterTestStart)
+    {
+      deployB1.Publish(msgs::Empty());
+    }
+    else if (_info.iterations == iterTestStart + 200 ||
+             _info.iterations == iterTestStart + 1000)
+    {
+      Entity b1 = _ecm.EntityByComponents(components::Model(),
+                                          components::Name("B1_0"));
+      ASSERT_NE(kNullEntity, b1);
+
+      auto staticComp = _ecm.Component<components::Static>(b1);
+      ASSERT_NE(nullptr, staticComp);
+      EXPECT_TRUE(staticComp->Data());
+
+      auto poseB1 = _ecm.Component<components::Pose>(b1);
+      ASSERT_NE(nullptr, poseB1);
+
+      // The breadcrumb does not move after it is spawned
+      if (!initialPose)
+        initialPose = poseB1->Data();
+      else
+        EXPECT_EQ(*initialPose, poseB1->Data());
+    }
+  });
+
+  this->server->AddSystem(testSystem.systemPtr);
+  this->server->Run(true, iterTestStart + 1001, false);
+  EXPECT_TRUE(initialPose.has_value());
+}
+
 /////////////////////////////////////////////////
 // The test verifies that if allow_renaming is true, the Breadcrumb system
 // renames spawned models if a model with the same name exists.
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/System.hh"
+#include "gz/sim/Util.hh"
+#include "test_config.hh"
+#include "../helpers/EnvTestFixture.hh"
+#include "../helpers/Relay.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test simulation checkpoints
+class CheckpointTest : public InternalFixture<::testing::Test>
+{
+};
+
+/// \brief System that counts its PostUpdate calls and saves the count in
+/// checkpoints.
+class CountingSystem : public System,
+                       public ISystemPostUpdate,
+                       public ISystemSerialize
+{
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &_info,
+              const EntityComponentManager &) override
+  {
+    if (!_info.paused)
+      ++this->count;
+  }
+
+  // Documentation inherited
+  public: bool SerializeState(std::ostream &_out) const override
+  {
+    _out << this->count;
+    return true;
+  }
+
+  // Documentation inherited
+  public: bool DeserializeState(std::istream &_in) override
+  {
+    _in >> this->count;
+    return !_in.fail();
+  }
+
+  /// \brief Number of unpaused PostUpdate calls.
+  public: uint64_t count{0u};
+};
+
+/////////////////////////////////////////////////
+// A falling box is checkpointed and resumed by another server, which doesn't
+// need the world file
+TEST_F(CheckpointTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SaveAndRestore))
+{
+  common::TempDirectory tempDir("checkpoint", "gz_sim", true);
+  ASSERT_TRUE(tempDir.Valid());
+  const auto path = common::joinPaths(tempDir.Path(), "sim.ckpt");
+
+  double savedZ{0.0};
+  {
+    ServerConfig serverConfig;
+    serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+        "test", "worlds", "world_energy_monitor.sdf"));
+    Server server(serverConfig);
+
+    auto counter = std::make_shared<CountingSystem>();
+    server.AddSystem(counter);
+
+    test::Relay testSystem;
+    testSystem.OnPostUpdate(
+        [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+        {
+          auto box = _ecm.EntityByComponents(components::Name("falling_box"));
+          savedZ = worldPose(box, _ecm).Pos().Z();
+        });
+    server.AddSystem(testSystem.systemPtr);
+
+    server.Run(true, 500u, false);
+    EXPECT_EQ(500u, counter->count);
+    EXPECT_LT(savedZ, 10.0);
+
+    transport::Node node;
+    msgs::StringMsg req;
+    req.set_data(path);
+    msgs::Boolean res;
+    bool result{false};
+    ASSERT_TRUE(node.Request("/world/world_energy_monitor/checkpoint", req,
+        5000u, res, result));
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(res.data());
+  }
+  ASSERT_TRUE(common::exists(path));
+
+  ServerConfig serverConfig;
+  serverConfig.SetRestoreFile(path);
+  Server server(serverConfig);
+  EXPECT_EQ(500u, *server.IterationCount());
+
+  auto counter = std::make_shared<CountingSystem>();
+  server.AddSystem(counter);
+
+  uint64_t firstIteration{0u};
+  double firstZ{0.0};
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+      [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+      {
+        if (0u != firstIteration)
+          return;
+        firstIteration = _info.iterations;
+        auto box = _ecm.EntityByComponents(components::Name("falling_box"));
+        firstZ = worldPose(box, _ecm).Pos().Z();
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(true, 1u, false);
+  EXPECT_EQ(501u, firstIteration);
+  EXPECT_EQ(501u, counter->count);
+
+  // The box keeps falling from where it was
+  EXPECT_LT(firstZ, savedZ);
+  EXPECT_GT(firstZ, savedZ - 0.01);
+}
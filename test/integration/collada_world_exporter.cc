@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <sstream>
+#include <string>
+
 #include <gz/common/ColladaLoader.hh>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -173,6 +177,85 @@ TEST_F(ColladaWorldExporterFixture,
   common::removeAll("./collada_world_exporter_lights_test");
 }
 
+TEST_F(ColladaWorldExporterFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(ExportWorldSharedMesh))
+{
+  const std::string sdfStr = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="collada_world_exporter_shared_test">
+    <plugin
+      filename="gz-sim-collada-world-exporter-system"
+      name="gz::sim::systems::ColladaWorldExporter">
+    </plugin>
+    <model name="box">
+      <static>true</static>
+      <pose>0 0 0.5 0 0 0</pose>
+      <link name="link">
+        <visual name="visual">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </visual>
+      </link>
+    </model>
+    <model name="long_box">
+      <static>true</static>
+      <pose>3 0 0.5 0 0 0</pose>
+      <link name="link">
+        <visual name="visual">
+          <geometry><box><size>2 1 1</size></box></geometry>
+        </visual>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  ServerConfig serverConfig;
+  serverConfig.SetResourceCache(test::UniqueTestDirectoryEnv::Path());
+  serverConfig.SetSdfString(sdfStr);
+  this->server = std::make_unique<Server>(serverConfig);
+
+  const std::string outputPath = "./collada_world_exporter_shared_test";
+  const std::string daePath = common::joinPaths(outputPath, "meshes",
+      "collada_world_exporter_shared_test.dae");
+
+  // Cleanup
+  common::removeAll(outputPath);
+  EXPECT_FALSE(common::exists(outputPath));
+
+  // Run one iteration which should export the world.
+  server->Run(true, 1, false);
+  ASSERT_TRUE(common::exists(daePath));
+
+  // Both boxes instance the same geometry, which is only written once
+  std::ifstream daeFile(daePath);
+  std::stringstream ss;
+  ss << daeFile.rdbuf();
+  const std::string dae = ss.str();
+  auto count = [&dae](const std::string &_pattern)
+  {
+    std::size_t n = 0;
+    for (auto pos = dae.find(_pattern); pos != std::string::npos;
+         pos = dae.find(_pattern, pos + 1))
+    {
+      ++n;
+    }
+    return n;
+  };
+  EXPECT_EQ(1u, count("<geometry id="));
+  EXPECT_EQ(2u, count("<instance_geometry"));
+
+  // Each instance is loaded as a submesh, scaled and placed by its node
+  common::ColladaLoader loader;
+  const common::Mesh *meshExported = loader.Load(daePath);
+  ASSERT_NE(nullptr, meshExported);
+  EXPECT_EQ(2u, meshExported->SubMeshCount());
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, 0), meshExported->Min());
+  EXPECT_EQ(math::Vector3d(4, 0.5, 1), meshExported->Max());
+
+  // Cleanup
+  common::removeAll(outputPath);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int _argc, char **_argv)
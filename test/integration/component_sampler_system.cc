@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/double_v.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/Server.hh"
+#include "test_config.hh"
+
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test ComponentSampler system
+class ComponentSamplerTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+// A ball falling from 10 m
+const char kWorld[] = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="sampler">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-component-sampler-system"
+            name="gz::sim::systems::ComponentSampler">
+      <publish_rate>1000</publish_rate>
+      <max_points>1000</max_points>
+    </plugin>
+    <model name="ball">
+      <pose>0 0 10 0 0 0</pose>
+      <link name="link">
+        <inertial>
+          <mass>1</mass>
+        </inertial>
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+TEST_F(ComponentSamplerTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Envelope))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(kWorld);
+
+  Server server(serverConfig);
+  auto ball = server.EntityByName("ball");
+  ASSERT_TRUE(ball.has_value());
+
+  transport::Node node;
+  const std::string addService{"/world/sampler/sampler/add"};
+  const std::string key = std::to_string(*ball) + "," +
+      std::to_string(components::Pose::typeId);
+  const unsigned int timeout{5000u};
+  msgs::StringMsg req;
+  msgs::StringMsg res;
+  bool result{false};
+
+  // Unsupported fields and malformed requests are rejected
+  req.set_data(key + ",foo");
+  EXPECT_TRUE(node.Request(addService, req, timeout, res, result));
+  EXPECT_FALSE(result);
+  req.set_data("ball,pose,z");
+  EXPECT_TRUE(node.Request(addService, req, timeout, res, result));
+  EXPECT_FALSE(result);
+
+  req.set_data(key + ",z");
+  EXPECT_TRUE(node.Request(addService, req, timeout, res, result));
+  ASSERT_TRUE(result);
+  const std::string topic = res.data();
+  EXPECT_EQ(0u, topic.find("/world/sampler/sampler/"));
+
+  // The same field shares the channel
+  EXPECT_TRUE(node.Request(addService, req, timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(topic, res.data());
+
+  std::mutex mutex;
+  std::vector<double> points;
+  std::function<void(const msgs::Double_V &)> cb =
+      [&](const msgs::Double_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(0, _msg.data_size() % 3);
+        points.insert(points.end(), _msg.data().begin(), _msg.data().end());
+      };
+  EXPECT_TRUE(node.Subscribe(topic, cb));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    server.Run(true, 100, false);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (points.size() >= 3u * 100u)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(points.size(), 3u * 100u);
+
+  // Every step is a bucket of its own, and the ball keeps falling
+  for (std::size_t i = 3; i + 2 < points.size(); i += 3)
+  {
+    EXPECT_GT(points[i], points[i - 3]);
+    EXPECT_DOUBLE_EQ(points[i + 1], points[i + 2]);
+    EXPECT_LT(points[i + 1], points[i - 2]);
+  }
+  EXPECT_LT(points[1], 10.0);
+
+  // Both clients have to release the channel
+  msgs::Boolean removed;
+  const std::string removeService{"/world/sampler/sampler/remove"};
+  req.set_data(topic);
+  EXPECT_TRUE(node.Request(removeService, req, timeout, removed, result));
+  EXPECT_TRUE(removed.data());
+  EXPECT_TRUE(node.Request(removeService, req, timeout, removed, result));
+  EXPECT_TRUE(removed.data());
+  EXPECT_TRUE(node.Request(removeService, req, timeout, removed, result));
+  EXPECT_FALSE(removed.data());
+}
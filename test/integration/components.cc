@@ -43,6 +43,7 @@
 #include "gz/sim/components/CanonicalLink.hh"
 #include "gz/sim/components/ChildLinkName.hh"
 #include "gz/sim/components/Collision.hh"
+#include "gz/sim/components/ContactBuffer.hh"
 #include "gz/sim/components/DetachableJoint.hh"
 #include "gz/sim/components/Geometry.hh"
 #include "gz/sim/components/Gravity.hh"
@@ -78,6 +79,7 @@
 #include "gz/sim/components/PhysicsEnginePlugin.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/Projector.hh"
+#include "gz/sim/components/RaycastData.hh"
 #include "gz/sim/components/Scene.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/components/SourceFilePath.hh"
@@ -383,6 +385,72 @@ TEST_F(ComponentsTest, Collision)
   comp3.Deserialize(istr);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ComponentsTest, ContactBuffer)
+{
+  components::ContactBufferData data1;
+  data1.pairs.push_back({3, 0, 2});
+  data1.pairs.push_back({4, 2, 1});
+  data1.positions = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+  data1.normals = {{0, 0, 1}, {0, 0, 1}, {1, 0, 0}};
+  data1.forces = {{0, 0, 10}, {0, 0, 20}, {5, 0, 0}};
+  data1.depths = {0.1, 0.2, 0.3};
+  EXPECT_TRUE(data1.HasExtraData());
+
+  // Create components
+  auto comp1 = components::ContactBuffer(data1);
+  auto comp2 = components::ContactBuffer(data1);
+  auto data2 = data1;
+  data2.depths[2] = 0.4;
+  auto comp3 = components::ContactBuffer(data2);
+
+  // Equality operators
+  EXPECT_EQ(comp1, comp2);
+  EXPECT_TRUE(comp1 == comp2);
+  EXPECT_FALSE(comp1 != comp2);
+  EXPECT_TRUE(comp1 != comp3);
+
+  // Stream operators
+  std::ostringstream ostr;
+  comp1.Serialize(ostr);
+
+  std::istringstream istr(ostr.str());
+  components::ContactBuffer comp4;
+  comp4.Deserialize(istr);
+  EXPECT_EQ(comp1, comp4);
+
+  // Conversion to messages, one contact per pair
+  msgs::Contacts contactsMsg;
+  comp1.Data().AppendTo(2, contactsMsg);
+  ASSERT_EQ(2, contactsMsg.contact_size());
+  EXPECT_EQ(2u, contactsMsg.contact(0).collision1().id());
+  EXPECT_EQ(3u, contactsMsg.contact(0).collision2().id());
+  ASSERT_EQ(2, contactsMsg.contact(0).position_size());
+  EXPECT_EQ(math::Vector3d(4, 5, 6),
+      msgs::Convert(contactsMsg.contact(0).position(1)));
+  EXPECT_EQ(math::Vector3d(0, 0, -20), msgs::Convert(
+      contactsMsg.contact(0).wrench(1).body_2_wrench().force()));
+  EXPECT_EQ(4u, contactsMsg.contact(1).collision2().id());
+  ASSERT_EQ(1, contactsMsg.contact(1).depth_size());
+  EXPECT_DOUBLE_EQ(0.3, contactsMsg.contact(1).depth(0));
+
+  // Without extra data, only positions are set
+  components::ContactBufferData data3;
+  data3.pairs.push_back({3, 0, 1});
+  data3.positions = {{1, 2, 3}};
+  EXPECT_FALSE(data3.HasExtraData());
+  msgs::Contacts positionsMsg;
+  data3.AppendTo(2, positionsMsg);
+  ASSERT_EQ(1, positionsMsg.contact_size());
+  EXPECT_EQ(1, positionsMsg.contact(0).position_size());
+  EXPECT_EQ(0, positionsMsg.contact(0).normal_size());
+
+  // Clearing
+  data1.Clear();
+  EXPECT_TRUE(data1.Empty());
+  EXPECT_TRUE(data1.pairs.empty());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ComponentsTest, DetachableJoint)
 {
@@ -1496,6 +1564,47 @@ TEST_F(ComponentsTest, Pose)
   EXPECT_EQ(math::Pose3d(3, 2, 1, 0.3, 0.2, 0.1), comp3.Data());
 }
 
+/////////////////////////////////////////////////
+TEST_F(ComponentsTest, RaycastData)
+{
+  components::RaycastDataInfo data1;
+  data1.rays.push_back({{0, 0, 0}, {0, 0, -10}});
+  data1.rays.push_back({{1, 2, 3}, {4, 5, 6}});
+
+  // Create components
+  auto comp1 = components::RaycastData(data1);
+  auto comp2 = components::RaycastData(data1);
+  auto data2 = data1;
+  data2.rays[1].end.Z(7);
+  auto comp3 = components::RaycastData(data2);
+
+  // Equality operators
+  EXPECT_EQ(comp1, comp2);
+  EXPECT_TRUE(comp1 == comp2);
+  EXPECT_FALSE(comp1 != comp2);
+  EXPECT_TRUE(comp1 != comp3);
+
+  // Results without hits are equal even though they're NaN
+  data1.results.resize(2);
+  data2 = data1;
+  EXPECT_FALSE(data1.results[0].Hit());
+  EXPECT_EQ(data1, data2);
+  data2.results[0].point = {0, 0, -4};
+  data2.results[0].fraction = 0.4;
+  EXPECT_TRUE(data2.results[0].Hit());
+  EXPECT_NE(data1, data2);
+
+  // Stream operators only keep the rays
+  std::ostringstream ostr;
+  components::RaycastData(data2).Serialize(ostr);
+
+  std::istringstream istr(ostr.str());
+  components::RaycastData comp4;
+  comp4.Deserialize(istr);
+  EXPECT_EQ(comp1, comp4);
+  EXPECT_TRUE(comp4.Data().results.empty());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ComponentsTest, Sensor)
 {
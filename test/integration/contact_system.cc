@@ -26,12 +26,17 @@
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
+#include "gz/sim/components/Collision.hh"
+#include "gz/sim/components/ContactBuffer.hh"
+#include "gz/sim/components/ContactSensorData.hh"
+#include "gz/sim/components/Name.hh"
 #include "gz/sim/Server.hh"
 #include "gz/sim/SystemLoader.hh"
 #include "test_config.hh"
 
 #include "plugins/MockSystem.hh"
 #include "../helpers/EnvTestFixture.hh"
+#include "../helpers/Relay.hh"
 
 using namespace gz;
 using namespace sim;
@@ -413,3 +418,70 @@ TEST_F(ContactSystemTest,
     EXPECT_EQ(0u, contactMsgs.size());
   }
 }
+
+/////////////////////////////////////////////////
+// The test checks that the contact system creates the components filled by
+// physics on its collisions, and that physics passes the
+// <include_entity_names> configuration along with the contacts
+TEST_F(ContactSystemTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(SensorCollisionComponents))
+{
+  for (const auto &[world, entityNames] :
+       {std::make_pair(std::string("contact.sdf"), true),
+        std::make_pair(std::string("contact_without_entity_names.sdf"),
+            false)})
+  {
+    ServerConfig serverConfig;
+    serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+        "/test/worlds/" + world);
+
+    Server server(serverConfig);
+
+    std::size_t sensorCollisions{0};
+    std::size_t buffersWithContacts{0};
+    std::size_t dataWithContacts{0};
+    test::Relay testSystem;
+    testSystem.OnPostUpdate(
+        [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+        {
+          sensorCollisions = 0;
+          buffersWithContacts = 0;
+          dataWithContacts = 0;
+          _ecm.Each<components::Collision, components::ContactBuffer>(
+              [&](const Entity &_entity, const components::Collision *,
+                  const components::ContactBuffer *_buffer) -> bool
+              {
+                ++sensorCollisions;
+                auto data =
+                    _ecm.Component<components::ContactSensorData>(_entity);
+                EXPECT_NE(nullptr, data);
+                if (_buffer->Data().Empty())
+                  return true;
+
+                ++buffersWithContacts;
+                EXPECT_EQ(entityNames, _buffer->Data().entityNames);
+                if (nullptr != data && data->Data().contact_size() > 0)
+                  ++dataWithContacts;
+                return true;
+              });
+        });
+    server.AddSystem(testSystem.systemPtr);
+
+    // Let "contact_model" fall and rest on the boxes
+    server.Run(true, 1000, false);
+
+    // Both collisions used as sensors have the components, and physics
+    // fills them both
+    EXPECT_EQ(2u, sensorCollisions) << world;
+    EXPECT_EQ(2u, buffersWithContacts) << world;
+    EXPECT_EQ(2u, dataWithContacts) << world;
+
+    // Remove the colliding boxes, the sensors forget about them and have no
+    // more contacts
+    server.RequestRemoveEntity("box1");
+    server.RequestRemoveEntity("box2");
+    server.Run(true, 10, false);
+    EXPECT_EQ(2u, sensorCollisions) << world;
+    EXPECT_EQ(0u, buffersWithContacts) << world;
+  }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/laserscan.pb.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Lidar.hh"
+#include "gz/sim/components/Sensor.hh"
+#include "gz/sim/Server.hh"
+#include "test_config.hh"
+
+#include "../helpers/Relay.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test CpuLidar system
+class CpuLidarTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+// A lidar with 3 horizontal rays facing a wall, a sphere and nothing
+const char kWorld[] = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="cpu_lidar">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-cpu-lidar-system"
+            name="gz::sim::systems::CpuLidar">
+      <threads>2</threads>
+    </plugin>
+    <model name="wall">
+      <static>true</static>
+      <pose>5 0 1 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 2 2</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="ball">
+      <static>true</static>
+      <pose>0 3 1 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="lidar_model">
+      <static>true</static>
+      <pose>0 0 1 0 0 0</pose>
+      <link name="link">
+        <sensor name="lidar" type="lidar">
+          <topic>cpu_lidar</topic>
+          <update_rate>100</update_rate>
+          <lidar>
+            <scan>
+              <horizontal>
+                <samples>3</samples>
+                <resolution>1</resolution>
+                <min_angle>-1.5707963267948966</min_angle>
+                <max_angle>1.5707963267948966</max_angle>
+              </horizontal>
+            </scan>
+            <range>
+              <min>0.1</min>
+              <max>10</max>
+            </range>
+          </lidar>
+        </sensor>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+TEST_F(CpuLidarTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Ranges))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(kWorld);
+
+  Server server(serverConfig);
+
+  // The lidar's topic is stored in its component
+  test::Relay testSystem;
+  std::string topic;
+  testSystem.OnPostUpdate([&](const UpdateInfo &,
+                              const EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Lidar, components::SensorTopic>(
+            [&](const Entity &, const components::Lidar *,
+                const components::SensorTopic *_topic) -> bool
+            {
+              topic = _topic->Data();
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  std::mutex mutex;
+  std::vector<msgs::LaserScan> scans;
+  std::function<void(const msgs::LaserScan &)> cb =
+      [&](const msgs::LaserScan &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        scans.push_back(_msg);
+      };
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe("/cpu_lidar", cb));
+
+  server.Run(true, 100, false);
+  EXPECT_NE(std::string::npos, topic.find("cpu_lidar"));
+
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (scans.size() >= 5u)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(scans.size(), 5u);
+  const auto &scan = scans.back();
+  EXPECT_EQ(3u, scan.count());
+  EXPECT_EQ(1u, scan.vertical_count());
+  ASSERT_EQ(3, scan.ranges_size());
+
+  // Rays go from right to left, so the first one hits nothing
+  EXPECT_TRUE(std::isinf(scan.ranges(0)));
+  EXPECT_GT(scan.ranges(0), 0.0);
+  EXPECT_NEAR(4.5, scan.ranges(1), 1e-6);
+  EXPECT_NEAR(2.5, scan.ranges(2), 1e-6);
+  EXPECT_DOUBLE_EQ(0.1, scan.range_min());
+  EXPECT_DOUBLE_EQ(10.0, scan.range_max());
+}
@@ -20,6 +20,9 @@
 #include <gz/msgs/empty.pb.h>
 #include <gz/msgs/twist.pb.h>
 
+#include <optional>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
 #include <gz/msgs/Utility.hh>
@@ -31,6 +34,7 @@
 #include "gz/sim/SystemLoader.hh"
 #include "test_config.hh"
 
+#include "gz/sim/components/DetachableJoint.hh"
 #include "gz/sim/components/LinearAcceleration.hh"
 #include "gz/sim/components/LinearVelocity.hh"
 #include "gz/sim/components/Link.hh"
@@ -359,3 +363,74 @@ TEST_F(DetachableJointTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LinksInSameModel))
    // should be close.
    EXPECT_TRUE(abs(distTraveledB1 - distTraveledVehicle) < 0.01);
  }
+
+/////////////////////////////////////////////////
+// A persistent detachable joint keeps its entity while detached, and
+// attaching it again holds the child at its new pose.
+TEST_F(DetachableJointTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Persistent))
+{
+  using namespace std::chrono_literals;
+
+  this->StartServer("/test/worlds/detachable_joint_persistent.sdf");
+
+  std::vector<math::Pose3d> m2Poses;
+  std::vector<Entity> joints;
+  std::optional<bool> enabled;
+  test::Relay testSystem;
+  testSystem.OnPostUpdate([&](const UpdateInfo &,
+                              const EntityComponentManager &_ecm)
+      {
+        auto m2 = _ecm.EntityByComponents(components::Model(),
+            components::Name("M2"));
+        m2Poses.push_back(_ecm.Component<components::Pose>(m2)->Data());
+
+        joints.clear();
+        _ecm.Each<components::DetachableJoint>(
+            [&](const Entity &_entity,
+                const components::DetachableJoint *) -> bool
+            {
+              joints.push_back(_entity);
+              enabled =
+                  _ecm.ComponentData<components::DetachableJointEnabled>(
+                      _entity);
+              return true;
+            });
+      });
+  this->server->AddSystem(testSystem.systemPtr);
+
+  const std::size_t nIters{20};
+  this->server->Run(true, nIters, false);
+  ASSERT_EQ(1u, joints.size());
+  const Entity joint = joints.front();
+  ASSERT_TRUE(enabled.has_value());
+  EXPECT_TRUE(*enabled);
+  EXPECT_EQ(m2Poses.front(), m2Poses.back());
+
+  // Detaching disables the joint without removing it
+  transport::Node node;
+  auto detachPub =
+      node.Advertise<msgs::Empty>("/model/M1/detachable_joint/detach");
+  detachPub.Publish(msgs::Empty());
+  std::this_thread::sleep_for(250ms);
+  m2Poses.clear();
+  this->server->Run(true, 100, false);
+
+  ASSERT_EQ(1u, joints.size());
+  EXPECT_EQ(joint, joints.front());
+  EXPECT_FALSE(*enabled);
+  EXPECT_GT(m2Poses.front().Pos().Z() - m2Poses.back().Pos().Z(), 0.01);
+
+  // Attaching enables the same joint, which holds M2 where it is now
+  auto attachPub =
+      node.Advertise<msgs::Empty>("/model/M1/detachable_joint/attach");
+  attachPub.Publish(msgs::Empty());
+  std::this_thread::sleep_for(250ms);
+  this->server->Run(true, 10, false);
+  m2Poses.clear();
+  this->server->Run(true, 100, false);
+
+  ASSERT_EQ(1u, joints.size());
+  EXPECT_EQ(joint, joints.front());
+  EXPECT_TRUE(*enabled);
+  EXPECT_NEAR(m2Poses.front().Pos().Z(), m2Poses.back().Pos().Z(), 1e-3);
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/empty.pb.h>
+#include <gz/msgs/serialized_map.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/ServerConfig.hh"
+#include "test_config.hh"
+
+#include "../helpers/EnvTestFixture.hh"
+#include "../helpers/Relay.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/// \brief Test FlightRecorder system
+class FlightRecorderTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(FlightRecorderTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Dump))
+{
+  common::TempDirectory tempDir("flight_recorder");
+  ASSERT_TRUE(tempDir.Valid());
+
+  // A falling sphere, keeping 0.2 s with a keyframe every 0.1 s
+  const std::string sdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="flight">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-flight-recorder-system"
+            name="gz::sim::systems::FlightRecorder">
+      <duration>0.2</duration>
+      <keyframe_period>0.1</keyframe_period>
+      <output_path>)" + tempDir.Path() + R"(</output_path>
+      <trigger_topic>/flight_failure</trigger_topic>
+    </plugin>
+    <model name="sphere">
+      <pose>0 0 100 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf);
+  Server server(serverConfig);
+  server.Run(true, 1000, false);
+
+  // Dump while the server runs, since the records are copied on an update
+  server.Run(false, 0, false);
+  transport::Node node;
+  msgs::StringMsg req;
+  msgs::StringMsg res;
+  bool result{false};
+  EXPECT_TRUE(node.Request("/world/flight/flight_recorder/dump", req, 5000,
+      res, result));
+  EXPECT_TRUE(result);
+  const auto dir = res.data();
+  ASSERT_FALSE(dir.empty());
+  EXPECT_EQ(0u, dir.find(tempDir.Path()));
+  EXPECT_TRUE(common::exists(common::joinPaths(dir, "flight_recorder.txt")));
+
+  // The log starts at zero with a full state, and holds at least the
+  // duration and at most another keyframe period
+  transport::log::Log log;
+  ASSERT_TRUE(log.Open(common::joinPaths(dir, "state.tlog")));
+  int stateCount{0};
+  int keyframeCount{0};
+  std::chrono::nanoseconds lastTime{0};
+  auto batch = log.QueryMessages();
+  for (const auto &msg : batch)
+  {
+    if (msg.Topic() == "/world/flight/changed_state")
+    {
+      if (stateCount == 0)
+      {
+        EXPECT_EQ(0ns, msg.TimeReceived());
+        msgs::SerializedStateMap state;
+        ASSERT_TRUE(state.ParseFromString(msg.Data()));
+        EXPECT_GT(state.entities_size(), 4);
+      }
+      lastTime = msg.TimeReceived();
+      ++stateCount;
+    }
+    else if (msg.Topic() == "/world/flight/keyframe_index")
+    {
+      ++keyframeCount;
+    }
+  }
+  EXPECT_GE(lastTime, 200ms);
+  EXPECT_LE(lastTime, 300ms);
+  EXPECT_GE(keyframeCount, 2);
+  EXPECT_GT(stateCount, 200);
+
+  // The trigger topic dumps another log
+  auto pub = node.Advertise<msgs::Empty>("/flight_failure");
+  for (int sleep = 0; sleep < 30 && !pub.HasConnections(); ++sleep)
+    std::this_thread::sleep_for(100ms);
+  pub.Publish(msgs::Empty());
+
+  int dumps{0};
+  for (int sleep = 0; sleep < 50 && dumps < 2; ++sleep)
+  {
+    std::this_thread::sleep_for(100ms);
+    dumps = 0;
+    for (common::DirIter it(tempDir.Path()); it != common::DirIter(); ++it)
+    {
+      if (common::exists(common::joinPaths(*it, "flight_recorder.txt")))
+        ++dumps;
+    }
+  }
+  EXPECT_EQ(2, dumps);
+}
+
+/////////////////////////////////////////////////
+// Spawns and removals in steps that aren't recorded otherwise, paused or
+// within the record period, are still in the log
+TEST_F(FlightRecorderTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SkippedSteps))
+{
+  common::TempDirectory tempDir("flight_recorder");
+  ASSERT_TRUE(tempDir.Valid());
+
+  const std::string sdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="flight">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-flight-recorder-system"
+            name="gz::sim::systems::FlightRecorder">
+      <record_period>1</record_period>
+      <output_path>)" + tempDir.Path() + R"(</output_path>
+    </plugin>
+  </world>
+</sdf>)";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf);
+  Server server(serverConfig);
+
+  enum class Action { None, Spawn, Remove };
+  Action action{Action::None};
+  Entity spawned{kNullEntity};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+      [&](const UpdateInfo &, EntityComponentManager &_ecm)
+      {
+        if (action == Action::Spawn)
+        {
+          spawned = _ecm.CreateEntity();
+          _ecm.CreateComponent(spawned, components::Name("spawned"));
+        }
+        else if (action == Action::Remove)
+        {
+          _ecm.RequestRemoveEntity(spawned);
+        }
+        action = Action::None;
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  // The first step is recorded, and the next ones are within the period
+  server.Run(true, 10, false);
+
+  action = Action::Spawn;
+  server.RunOnce(true);
+  ASSERT_NE(kNullEntity, spawned);
+  server.Run(true, 10, false);
+
+  action = Action::Remove;
+  server.Run(true, 10, false);
+
+  server.Run(false, 0, false);
+  transport::Node node;
+  msgs::StringMsg req;
+  msgs::StringMsg res;
+  bool result{false};
+  EXPECT_TRUE(node.Request("/world/flight/flight_recorder/dump", req, 5000,
+      res, result));
+  EXPECT_TRUE(result);
+  const auto dir = res.data();
+  ASSERT_FALSE(dir.empty());
+
+  transport::log::Log log;
+  ASSERT_TRUE(log.Open(common::joinPaths(dir, "state.tlog")));
+  bool created{false};
+  bool removed{false};
+  for (const auto &msg : log.QueryMessages())
+  {
+    if (msg.Topic() != "/world/flight/changed_state")
+      continue;
+
+    msgs::SerializedStateMap state;
+    ASSERT_TRUE(state.ParseFromString(msg.Data()));
+    auto it = state.entities().find(spawned);
+    if (it == state.entities().end())
+      continue;
+    if (it->second.remove())
+    {
+      EXPECT_TRUE(created);
+      removed = true;
+    }
+    else
+    {
+      created = true;
+    }
+  }
+  EXPECT_TRUE(created);
+  EXPECT_TRUE(removed);
+}
@@ -17,9 +17,18 @@
 
 #include <gtest/gtest.h>
 
+#include <gz/msgs/double_v.pb.h>
+#include <gz/msgs/empty.pb.h>
 #include <gz/msgs/model.pb.h>
+#include <gz/msgs/stringmsg_v.pb.h>
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
 
 #include <gz/common/Console.hh>
+#include <gz/common/StringUtils.hh>
 #include <gz/common/Util.hh>
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
@@ -201,3 +210,71 @@ TEST_F(JointStatePublisherTest,
   // Make sure the callback was triggered at least once.
   EXPECT_GT(count, 0);
 }
+
+/////////////////////////////////////////////////
+TEST_F(JointStatePublisherTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(WorldPublisher))
+{
+  // Attach a publisher to the world of the diff drive test
+  std::ifstream file(common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "test", "worlds", "diff_drive.sdf"));
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string sdfString = buffer.str();
+  const std::string worldTag{"<world name=\"diff_drive\">"};
+  const auto pos = sdfString.find(worldTag);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.insert(pos + worldTag.size(), R"(
+    <plugin
+      filename="gz-sim-joint-state-publisher-system"
+      name="gz::sim::systems::JointStatePublisher">
+      <model_name>vehicle</model_name>
+    </plugin>)");
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(0ns);
+
+  std::mutex mutex;
+  int count = 0;
+  int packedSize = 0;
+  std::function<void(const msgs::Double_V &)> packedCb =
+    [&](const msgs::Double_V &_msg)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      packedSize = _msg.data_size();
+      count++;
+    };
+
+  transport::Node node;
+  node.Subscribe("/world/diff_drive/joint_state", packedCb);
+
+  server.Run(true, 10, false);
+
+  // The ball joint of the caster has no axis, so only the wheels are packed
+  msgs::Empty req;
+  msgs::StringMsg_V names;
+  bool result{false};
+  ASSERT_TRUE(node.Request("/world/diff_drive/joint_state/names", req, 5000,
+      names, result));
+  EXPECT_TRUE(result);
+  ASSERT_EQ(2, names.data_size());
+
+  bool foundLeftWheelJoint{false}, foundRightWheelJoint{false};
+  for (const auto &name : names.data())
+  {
+    if (common::EndsWith(name, "vehicle::left_wheel_joint"))
+      foundLeftWheelJoint = true;
+    else if (common::EndsWith(name, "vehicle::right_wheel_joint"))
+      foundRightWheelJoint = true;
+  }
+  EXPECT_TRUE(foundLeftWheelJoint);
+  EXPECT_TRUE(foundRightWheelJoint);
+
+  // Position, velocity and force of each axis
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_GT(count, 0);
+  EXPECT_EQ(6, packedSize);
+}
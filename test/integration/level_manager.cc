@@ -18,7 +18,11 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <optional>
+#include <set>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include <gz/common/Console.hh>
@@ -478,3 +482,71 @@ TEST_F(LevelManagerFixture,
   testSequence(perf1, perf2);
   testSequence(perf2, perf1);
 }
+
+///////////////////////////////////////////////
+/// Check that streamed levels are loaded from their buffer over several
+/// steps
+class LevelStreamingTest : public InternalFixture<::testing::Test>
+{
+};
+
+///////////////////////////////////////////////
+TEST_F(LevelStreamingTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LoadFromBuffer))
+{
+  std::ifstream file(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/levels.sdf");
+  ASSERT_TRUE(file.good());
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string world = buffer.str();
+
+  // Create one entity per step
+  const std::string pluginTag{R"(<plugin name="gz::sim" filename="dummy">)"};
+  auto pluginPos = world.find(pluginTag);
+  ASSERT_NE(std::string::npos, pluginPos);
+  world.insert(pluginPos + pluginTag.size(),
+      "<level_streaming><step_budget>0</step_budget>"
+      "<prefetch_time>0</prefetch_time></level_streaming>");
+
+  sim::ServerConfig serverConfig;
+  serverConfig.SetSdfString(world);
+  serverConfig.SetUseLevels(true);
+  sim::Server server(serverConfig);
+
+  ModelMover perf1(*server.EntityByName("sphere"));
+  server.AddSystem(perf1.systemPtr);
+
+  std::set<std::string> models;
+  test::Relay testSystem;
+  testSystem.OnPostUpdate([&](const sim::UpdateInfo &,
+                              const sim::EntityComponentManager &_ecm)
+  {
+    models.clear();
+    _ecm.Each<components::Model, components::Name>(
+        [&](const Entity &, const components::Model *,
+            const components::Name *_name) -> bool
+        {
+          models.insert(_name->Data());
+          return true;
+        });
+  });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(true, 1, false);
+  EXPECT_EQ(1u, models.count("tile_0"));
+  EXPECT_EQ(0u, models.count("tile_1"));
+
+  // Unlike regular levels, streamed levels are loaded when a performer
+  // enters their buffer
+  perf1.SetPose({22, -3, 0, 0, 0, 0});
+  for (int i = 0; i < 100 && models.count("tile_1") == 0u; ++i)
+    server.Run(true, 1, false);
+  EXPECT_EQ(1u, models.count("tile_1"));
+  EXPECT_EQ(0u, models.count("tile_2"));
+
+  // And unloaded when it leaves
+  perf1.SetPose({0, 0, 0, 0, 0, 0});
+  server.Run(true, 3, false);
+  EXPECT_EQ(0u, models.count("tile_1"));
+  EXPECT_EQ(1u, models.count("tile_0"));
+}
@@ -39,6 +39,7 @@
 #include "gz/sim/Server.hh"
 #include "gz/sim/SystemLoader.hh"
 #include "gz/sim/Util.hh"
+#include "gz/sim/WrenchAccumulator.hh"
 #include "test_config.hh"
 
 #include "../helpers/Relay.hh"
@@ -181,11 +182,19 @@ TEST_P(VerticalForceParamFixture,
           linearVelocities.push_back(math::Vector3d::Zero);
         }
 
-        if (wrenchComp)
+        // The lift drag system adds its wrench to the accumulator, which is
+        // applied after PreUpdate
+        math::Vector3d force;
+        math::Vector3d torque;
+        if (_ecm.Wrenches() &&
+            _ecm.Wrenches()->Wrench(bladeLink, force, torque))
         {
-          math::Vector3d force = msgs::Convert(wrenchComp->Data().force());
           forces.push_back(force);
         }
+        else if (wrenchComp)
+        {
+          forces.push_back(msgs::Convert(wrenchComp->Data().force()));
+        }
         else
         {
           forces.push_back(math::Vector3d::Zero);
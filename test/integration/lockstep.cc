@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/clock.pb.h>
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/uint32.pb.h>
+#include <gz/msgs/world_control.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include <gz/common/Util.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/sim/Server.hh"
+#include "gz/sim/ServerConfig.hh"
+#include "test_config.hh"
+
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+using namespace std::chrono_literals;
+
+/// \brief Test stepping in lockstep with an external process
+class LockstepTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(LockstepTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(StepCredits))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "empty.sdf"));
+  serverConfig.SetLockstep(true);
+
+  Server server(serverConfig);
+
+  std::atomic<int> doneCount{0};
+  std::atomic<int64_t> lastSimNsec{0};
+  std::function<void(const msgs::Clock &)> onDone =
+      [&](const msgs::Clock &_msg)
+      {
+        lastSimNsec = _msg.sim().sec() * 1000000000 + _msg.sim().nsec();
+        ++doneCount;
+      };
+
+  transport::Node node;
+  ASSERT_TRUE(node.Subscribe("/world/empty/lockstep/done", onDone));
+  auto creditsPub =
+      node.Advertise<msgs::UInt32>("/world/empty/lockstep/step");
+
+  // Without credits, the unpaused world doesn't step
+  server.Run(false, 0, false);
+  std::this_thread::sleep_for(300ms);
+  EXPECT_EQ(0u, *server.IterationCount());
+  EXPECT_EQ(0, doneCount);
+
+  // Wait for the discovery of the publisher
+  for (int sleep = 0; sleep < 50 && !creditsPub.HasConnections(); ++sleep)
+    std::this_thread::sleep_for(100ms);
+  ASSERT_TRUE(creditsPub.HasConnections());
+
+  msgs::UInt32 credits;
+  credits.set_data(5);
+  creditsPub.Publish(credits);
+
+  for (int sleep = 0; sleep < 50 && doneCount < 5; ++sleep)
+    std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(5, doneCount);
+  EXPECT_EQ(5u, *server.IterationCount());
+  EXPECT_EQ(5000000, lastSimNsec);
+
+  // Credits are used up
+  std::this_thread::sleep_for(300ms);
+  EXPECT_EQ(5, doneCount);
+  EXPECT_EQ(5u, *server.IterationCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(LockstepTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(MultiStep))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "empty.sdf"));
+  serverConfig.SetLockstep(true);
+
+  Server server(serverConfig);
+
+  std::atomic<int> doneCount{0};
+  std::function<void(const msgs::Clock &)> onDone =
+      [&](const msgs::Clock &)
+      {
+        ++doneCount;
+      };
+
+  transport::Node node;
+  ASSERT_TRUE(node.Subscribe("/world/empty/lockstep/done", onDone));
+
+  // Start paused, and let a few credit timeouts go by
+  server.Run(false, 0, true);
+  std::this_thread::sleep_for(300ms);
+  EXPECT_EQ(0u, *server.IterationCount());
+
+  // A multi_step request steps the world without credits
+  msgs::WorldControl req;
+  req.set_pause(true);
+  req.set_multi_step(3);
+  msgs::Boolean rep;
+  bool result{false};
+  ASSERT_TRUE(node.Request("/world/empty/control", req, 5000, rep, result));
+  EXPECT_TRUE(result);
+
+  for (int sleep = 0; sleep < 50 && *server.IterationCount() < 3; ++sleep)
+    std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(3u, *server.IterationCount());
+
+  // The world pauses again once the steps are done
+  std::this_thread::sleep_for(300ms);
+  EXPECT_EQ(3u, *server.IterationCount());
+  ASSERT_TRUE(server.Paused().has_value());
+  EXPECT_TRUE(*server.Paused());
+
+  // Steps that weren't credited aren't acknowledged
+  EXPECT_EQ(0, doneCount);
+}
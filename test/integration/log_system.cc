@@ -20,17 +20,25 @@
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/clock.pb.h>
 #include <gz/msgs/log_playback_control.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 #include <gz/msgs/serialized_map.pb.h>
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
 #ifndef __APPLE__
 #include <filesystem>
 #endif
+#include <functional>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
@@ -49,8 +57,10 @@
 #include <sdf/World.hh>
 #include <sdf/Element.hh>
 
+#include "gz/sim/components/Inertial.hh"
 #include "gz/sim/components/Name.hh"
 #include "gz/sim/components/LogPlaybackStatistics.hh"
+#include "gz/sim/components/Model.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/Server.hh"
 #include "gz/sim/ServerConfig.hh"
@@ -1730,3 +1740,683 @@ TEST_F(LogSystemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RecordPeriod))
   this->CreateLogsDir();
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(KeyframeSeek))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  // A falling sphere, recorded with a keyframe every 0.2 s
+  const std::string recordSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="keyframes">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-log-system"
+            name="gz::sim::systems::LogRecord">
+      <record_path>)" + this->logDir + R"(</record_path>
+      <keyframe_period>0.2</keyframe_period>
+    </plugin>
+    <model name="sphere">
+      <pose>0 0 100 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  // Get the sphere's pose at each time
+  std::map<std::chrono::steady_clock::duration, math::Pose3d> poses;
+  auto spherePose = [](const EntityComponentManager &_ecm)
+  {
+    math::Pose3d pose;
+    _ecm.Each<components::Pose, components::Name>(
+        [&](const Entity &, const components::Pose *_pose,
+            const components::Name *_name)->bool
+        {
+          if (_name->Data() != "sphere")
+            return true;
+          pose = _pose->Data();
+          return false;
+        });
+    return pose;
+  };
+
+  // Record
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdf);
+    Server recordServer(recordServerConfig);
+
+    test::Relay recordTester;
+    recordTester.OnPostUpdate(
+        [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+        {
+          poses[_info.simTime] = spherePose(_ecm);
+        });
+    recordServer.AddSystem(recordTester.systemPtr);
+    recordServer.Run(true, 1000, false);
+  }
+
+  // There is a keyframe with the full state every 0.2 s, and an index entry
+  // for each of them
+  const auto statePath = common::joinPaths(this->logDir, "state.tlog");
+  {
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(statePath));
+
+    int indexCount = 0;
+    auto batch = log.QueryMessages(transport::log::TopicName(
+        "/world/keyframes/keyframe_index"));
+    for (const auto &msg : batch)
+    {
+      EXPECT_EQ("gz.msgs.Time", msg.Type());
+      ++indexCount;
+    }
+    EXPECT_EQ(5, indexCount);
+
+    int keyframeCount = 0;
+    batch = log.QueryMessages(transport::log::TopicName(
+        "/world/keyframes/keyframe_state"));
+    for (const auto &msg : batch)
+    {
+      msgs::SerializedStateMap stateMsg;
+      ASSERT_TRUE(stateMsg.ParseFromString(msg.Data()));
+      EXPECT_GT(stateMsg.entities_size(), 4);
+      ++keyframeCount;
+    }
+    EXPECT_EQ(indexCount, keyframeCount);
+  }
+
+  // Playback
+  ServerConfig playServerConfig;
+  playServerConfig.SetLogPlaybackPath(this->logDir);
+  Server playServer(playServerConfig);
+
+  std::chrono::steady_clock::duration playTime{0};
+  math::Pose3d playPose;
+  test::Relay playbackTester;
+  playbackTester.OnPostUpdate(
+      [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+      {
+        playTime = _info.simTime;
+        playPose = spherePose(_ecm);
+      });
+  playServer.AddSystem(playbackTester.systemPtr);
+  playServer.Run(true, 10, false);
+
+  // Seek forward past several keyframes, then back between them. The
+  // played back pose matches the recorded one.
+  transport::Node node;
+  msgs::LogPlaybackControl req;
+  msgs::Boolean res;
+  bool result{false};
+  const std::string service{"/world/keyframes/playback/control"};
+  for (auto nsec : {750000000, 300000000, 50000000, 610000000})
+  {
+    req.mutable_seek()->set_sec(0);
+    req.mutable_seek()->set_nsec(nsec);
+    EXPECT_TRUE(node.Request(service, req, 1000, res, result));
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(res.data());
+
+    // Run 2 iterations because control messages are processed in the end of
+    // an update cycle
+    playServer.Run(true, 2, false);
+
+    ASSERT_EQ(1u, poses.count(playTime));
+    EXPECT_EQ(poses[playTime], playPose) << "Nanoseconds: [" << nsec << "]";
+    EXPECT_GT(100.0, playPose.Pos().Z());
+  }
+
+  this->RemoveLogsDir();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ScrubCache))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  // A falling sphere, recorded without keyframes, so seeking back can only
+  // start from the states cached during playback or the start of the log
+  const std::string recordSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="scrub">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-log-system"
+            name="gz::sim::systems::LogRecord">
+      <record_path>)" + this->logDir + R"(</record_path>
+      <keyframe_period>0</keyframe_period>
+    </plugin>
+    <model name="sphere">
+      <pose>0 0 100 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  // Get the sphere's pose at each time
+  std::map<std::chrono::steady_clock::duration, math::Pose3d> poses;
+  auto spherePose = [](const EntityComponentManager &_ecm)
+  {
+    math::Pose3d pose;
+    _ecm.Each<components::Pose, components::Name>(
+        [&](const Entity &, const components::Pose *_pose,
+            const components::Name *_name)->bool
+        {
+          if (_name->Data() != "sphere")
+            return true;
+          pose = _pose->Data();
+          return false;
+        });
+    return pose;
+  };
+
+  // Record
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdf);
+    Server recordServer(recordServerConfig);
+
+    test::Relay recordTester;
+    recordTester.OnPostUpdate(
+        [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+        {
+          poses[_info.simTime] = spherePose(_ecm);
+        });
+    recordServer.AddSystem(recordTester.systemPtr);
+    recordServer.Run(true, 1000, false);
+  }
+
+  // Play back most of the log, caching states along the way
+  ServerConfig playServerConfig;
+  playServerConfig.SetLogPlaybackPath(this->logDir);
+  Server playServer(playServerConfig);
+
+  std::chrono::steady_clock::duration playTime{0};
+  math::Pose3d playPose;
+  test::Relay playbackTester;
+  playbackTester.OnPostUpdate(
+      [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+      {
+        playTime = _info.simTime;
+        playPose = spherePose(_ecm);
+      });
+  playServer.AddSystem(playbackTester.systemPtr);
+  playServer.Run(true, 800, false);
+
+  // Step back frame by frame, scrub back and forth, and then jump before
+  // the first cached state. The played back pose matches the recorded one.
+  transport::Node node;
+  msgs::LogPlaybackControl req;
+  msgs::Boolean res;
+  bool result{false};
+  const std::string service{"/world/scrub/playback/control"};
+  for (auto nsec : {700000000, 699000000, 698000000, 450000000, 520000000,
+      410000000, 100000})
+  {
+    req.mutable_seek()->set_sec(0);
+    req.mutable_seek()->set_nsec(nsec);
+    EXPECT_TRUE(node.Request(service, req, 1000, res, result));
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(res.data());
+
+    // Run 2 iterations because control messages are processed in the end of
+    // an update cycle
+    playServer.Run(true, 2, false);
+
+    ASSERT_EQ(1u, poses.count(playTime));
+    EXPECT_EQ(poses[playTime], playPose) << "Nanoseconds: [" << nsec << "]";
+  }
+
+  this->RemoveLogsDir();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(CompressedStates))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  // A falling sphere, recorded with compressed states
+  const std::string recordSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="compressed">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-log-system"
+            name="gz::sim::systems::LogRecord">
+      <record_path>)" + this->logDir + R"(</record_path>
+      <keyframe_period>0.1</keyframe_period>
+      <state_compression>zlib</state_compression>
+      <max_queued_records>16</max_queued_records>
+    </plugin>
+    <model name="sphere">
+      <pose>0 0 100 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  auto spherePose = [](const EntityComponentManager &_ecm)
+  {
+    math::Pose3d pose;
+    _ecm.Each<components::Pose, components::Name>(
+        [&](const Entity &, const components::Pose *_pose,
+            const components::Name *_name)->bool
+        {
+          if (_name->Data() != "sphere")
+            return true;
+          pose = _pose->Data();
+          return false;
+        });
+    return pose;
+  };
+
+  // The writer reports its statistics once a second and when it stops
+  std::mutex statusMutex;
+  msgs::Param status;
+  std::function<void(const msgs::Param &)> statusCb =
+      [&](const msgs::Param &_msg)
+      {
+        std::lock_guard<std::mutex> lock(statusMutex);
+        status = _msg;
+      };
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe("/world/compressed/log/status", statusCb));
+
+  // Record
+  std::map<std::chrono::steady_clock::duration, math::Pose3d> poses;
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdf);
+    Server recordServer(recordServerConfig);
+
+    test::Relay recordTester;
+    recordTester.OnPostUpdate(
+        [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+        {
+          poses[_info.simTime] = spherePose(_ecm);
+        });
+    recordServer.AddSystem(recordTester.systemPtr);
+    recordServer.Run(true, 300, false);
+  }
+
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(statusMutex);
+      if (status.params().count("written_records"))
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  {
+    std::lock_guard<std::mutex> lock(statusMutex);
+    ASSERT_EQ(1u, status.params().count("written_records"));
+
+    // Records aren't dropped by default, the simulation waits instead
+    EXPECT_GT(status.params().at("written_records").int_value(), 300);
+    EXPECT_EQ(0, status.params().at("dropped_records").int_value());
+    EXPECT_EQ(0, status.params().at("queued_records").int_value());
+    EXPECT_LT(status.params().at("state_compression_ratio").double_value(),
+        1.0);
+  }
+
+  // The states are compressed, and stamped with the sim time they were
+  // recorded at
+  const auto statePath = common::joinPaths(this->logDir, "state.tlog");
+  {
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(statePath));
+
+    int stateCount = 0;
+    auto batch = log.QueryMessages(transport::log::TopicName(
+        "/world/compressed/changed_state"));
+    for (const auto &msg : batch)
+    {
+      EXPECT_EQ("gz.sim.private_msgs.CompressedState", msg.Type());
+      EXPECT_EQ(1u, poses.count(msg.TimeReceived()));
+      ++stateCount;
+    }
+    EXPECT_EQ(300, stateCount);
+  }
+
+  // Playback matches the recording, before and after seeking
+  ServerConfig playServerConfig;
+  playServerConfig.SetLogPlaybackPath(this->logDir);
+  Server playServer(playServerConfig);
+
+  std::chrono::steady_clock::duration playTime{0};
+  math::Pose3d playPose;
+  test::Relay playbackTester;
+  playbackTester.OnPostUpdate(
+      [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+      {
+        playTime = _info.simTime;
+        playPose = spherePose(_ecm);
+      });
+  playServer.AddSystem(playbackTester.systemPtr);
+  playServer.Run(true, 50, false);
+  ASSERT_EQ(1u, poses.count(playTime));
+  EXPECT_EQ(poses[playTime], playPose);
+  EXPECT_GT(100.0, playPose.Pos().Z());
+
+  msgs::LogPlaybackControl req;
+  msgs::Boolean res;
+  bool result{false};
+  req.mutable_seek()->set_sec(0);
+  req.mutable_seek()->set_nsec(250000000);
+  EXPECT_TRUE(node.Request("/world/compressed/playback/control", req, 1000,
+      res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+  playServer.Run(true, 2, false);
+  ASSERT_EQ(1u, poses.count(playTime));
+  EXPECT_EQ(poses[playTime], playPose);
+
+  this->RemoveLogsDir();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RecordFilters))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  // Two models, of which the prop and its children aren't recorded, nor
+  // the inertial of the ball
+  const std::string recordSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="filters">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-log-system"
+            name="gz::sim::systems::LogRecord">
+      <record_path>)" + this->logDir + R"(</record_path>
+      <keyframe_period>0.05</keyframe_period>
+      <exclude_entity>prop</exclude_entity>
+      <exclude_component>Inertial</exclude_component>
+    </plugin>
+    <model name="ball">
+      <pose>0 0 10 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="prop">
+      <static>true</static>
+      <pose>5 0 0 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdf);
+    Server recordServer(recordServerConfig);
+    recordServer.Run(true, 100, false);
+  }
+
+  // Collect the recorded names and component types
+  std::multiset<std::string> names;
+  std::set<ComponentTypeId> types;
+  const auto statePath = common::joinPaths(this->logDir, "state.tlog");
+  transport::log::Log log;
+  ASSERT_TRUE(log.Open(statePath));
+  int stateCount = 0;
+  for (const auto &topic : {"/world/filters/changed_state",
+                            "/world/filters/keyframe_state"})
+  {
+    auto batch = log.QueryMessages(transport::log::TopicName(topic));
+    for (const auto &msg : batch)
+    {
+      msgs::SerializedStateMap stateMsg;
+      ASSERT_TRUE(stateMsg.ParseFromString(msg.Data()));
+      for (const auto &[id, entity] : stateMsg.entities())
+      {
+        for (const auto &[type, component] : entity.components())
+        {
+          types.insert(type);
+          if (type != components::Name::typeId || stateCount > 0)
+            continue;
+          components::Name name;
+          std::istringstream istr(component.component());
+          name.Deserialize(istr);
+          names.insert(name.Data());
+        }
+      }
+      ++stateCount;
+    }
+  }
+  EXPECT_GT(stateCount, 2);
+
+  // The first state holds every recorded entity
+  EXPECT_EQ(1u, names.count("filters"));
+  EXPECT_EQ(1u, names.count("ball"));
+  EXPECT_EQ(1u, names.count("link"));
+  EXPECT_EQ(1u, names.count("collision"));
+  EXPECT_EQ(0u, names.count("prop"));
+
+  EXPECT_EQ(0u, types.count(components::Inertial::typeId));
+  EXPECT_EQ(1u, types.count(components::Pose::typeId));
+
+  this->RemoveLogsDir();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(RecordFilteredRemoval))
+{
+  this->CreateLogsDir();
+
+  // Entity filters are on, and the ball is removed while recording
+  const std::string recordSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="filters">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-physics-system"
+            name="gz::sim::systems::Physics">
+    </plugin>
+    <plugin filename="gz-sim-log-system"
+            name="gz::sim::systems::LogRecord">
+      <record_path>)" + this->logDir + R"(</record_path>
+      <exclude_entity>prop</exclude_entity>
+    </plugin>
+    <model name="ball">
+      <pose>0 0 10 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><sphere><radius>0.5</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="prop">
+      <static>true</static>
+      <pose>5 0 0 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdf);
+    Server recordServer(recordServerConfig);
+
+    test::Relay remover;
+    remover.OnPreUpdate(
+        [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+        {
+          if (_info.iterations != 50)
+            return;
+          auto ball = _ecm.EntityByComponents(components::Model(),
+              components::Name("ball"));
+          ASSERT_NE(kNullEntity, ball);
+          _ecm.RequestRemoveEntity(ball);
+        });
+    recordServer.AddSystem(remover.systemPtr);
+    recordServer.Run(true, 100, false);
+  }
+
+  // The removal is in the log, so the ball disappears during playback
+  ServerConfig playServerConfig;
+  playServerConfig.SetLogPlaybackPath(this->logDir);
+  Server playServer(playServerConfig);
+
+  bool ballAtStart{false};
+  bool ballAtEnd{true};
+  test::Relay checker;
+  checker.OnPostUpdate(
+      [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+      {
+        const bool ball = kNullEntity != _ecm.EntityByComponents(
+            components::Model(), components::Name("ball"));
+        if (_info.iterations == 10)
+          ballAtStart = ball;
+        else if (_info.iterations == 90)
+          ballAtEnd = ball;
+      });
+  playServer.AddSystem(checker.systemPtr);
+  playServer.Run(true, 90, false);
+
+  EXPECT_TRUE(ballAtStart);
+  EXPECT_FALSE(ballAtEnd);
+
+  this->RemoveLogsDir();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(DroppedRecordsKeepRemovals))
+{
+  this->CreateLogsDir();
+
+  // Records are dropped while the short queue is full
+  const std::string recordSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="drops">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <plugin filename="gz-sim-log-system"
+            name="gz::sim::systems::LogRecord">
+      <record_path>)" + this->logDir + R"(</record_path>
+      <max_queued_records>1</max_queued_records>
+      <drop_records>true</drop_records>
+    </plugin>
+  </world>
+</sdf>)";
+
+  // Models are spawned on odd iterations and removed on the next one
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdf);
+    Server recordServer(recordServerConfig);
+
+    Entity spawned{kNullEntity};
+    test::Relay spawner;
+    spawner.OnPreUpdate(
+        [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+        {
+          if (_info.iterations % 2 == 1)
+          {
+            spawned = _ecm.CreateEntity();
+            _ecm.CreateComponent(spawned, components::Model());
+            _ecm.CreateComponent(spawned, components::Name(
+                "temp_" + std::to_string(_info.iterations)));
+          }
+          else if (kNullEntity != spawned)
+          {
+            _ecm.RequestRemoveEntity(spawned);
+            spawned = kNullEntity;
+          }
+        });
+    recordServer.AddSystem(spawner.systemPtr);
+    recordServer.Run(true, 500, false);
+  }
+
+  // The complete states recorded after drops don't bring back the removed
+  // models
+  ServerConfig playServerConfig;
+  playServerConfig.SetLogPlaybackPath(this->logDir);
+  Server playServer(playServerConfig);
+
+  std::size_t maxModels{0u};
+  test::Relay checker;
+  checker.OnPostUpdate(
+      [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+      {
+        std::size_t models{0u};
+        _ecm.Each<components::Model, components::Name>(
+            [&](const Entity &, const components::Model *,
+                const components::Name *_name)
+            {
+              if (0u == _name->Data().find("temp_"))
+                ++models;
+              return true;
+            });
+        maxModels = std::max(maxModels, models);
+      });
+  playServer.AddSystem(checker.systemPtr);
+  playServer.Run(true, 500, false);
+
+  EXPECT_LE(maxModels, 1u);
+
+  this->RemoveLogsDir();
+}
@@ -28,6 +28,7 @@
 #include "gz/sim/components/LogicalCamera.hh"
 #include "gz/sim/components/Model.hh"
 #include "gz/sim/components/Name.hh"
+#include "gz/sim/components/PoseCmd.hh"
 #include "gz/sim/components/Sensor.hh"
 #include "gz/sim/Server.hh"
 #include "gz/sim/SystemLoader.hh"
@@ -196,3 +197,84 @@ TEST_F(LogicalCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LogicalCameraBox))
   EXPECT_EQ(boxPoseCamera2Frame, msgs::Convert(img2.model(0).pose()));
   mutex.unlock();
 }
+
+/////////////////////////////////////////////////
+// This test moves the box across the cells of the index of models shared by
+// the cameras, and removes it, checking what the first camera sees.
+TEST_F(LogicalCameraTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(LogicalCameraMovingBox))
+{
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/logical_camera_sensor.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const UpdateInfo &_info,
+                             EntityComponentManager &_ecm)
+      {
+        Entity box = _ecm.EntityByComponents(
+            components::Model(), components::Name("box"));
+        if (box == kNullEntity)
+          return;
+
+        // Behind the cameras, then in front of them, farther than before
+        if (_info.iterations == 100)
+        {
+          _ecm.CreateComponent(box,
+              components::WorldPoseCmd(math::Pose3d(-3, 0, 0.5, 0, 0, 0)));
+        }
+        else if (_info.iterations == 300)
+        {
+          _ecm.CreateComponent(box,
+              components::WorldPoseCmd(math::Pose3d(3, 0, 0.5, 0, 0, 0)));
+        }
+        else if (_info.iterations == 500)
+        {
+          _ecm.RequestRemoveEntity(box);
+        }
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  mutex.lock();
+  logicalCamera1Msgs.clear();
+  mutex.unlock();
+
+  transport::Node node;
+  node.Subscribe(std::string("/world/logical_camera_sensor/") +
+      "model/logical_camera-1/link/logical_camera_link" +
+      "/sensor/logical_camera-1/logical_camera", &logicalCamera1Cb);
+
+  const math::Pose3d sensor1Pose(0.05, 0.05, 0.55, 0, 0, 0);
+  auto lastImage = [&]() -> msgs::LogicalCameraImage
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_FALSE(logicalCamera1Msgs.empty());
+    if (logicalCamera1Msgs.empty())
+      return msgs::LogicalCameraImage();
+    return logicalCamera1Msgs.back();
+  };
+
+  // The box moved to a cell outside of the frustum
+  server.Run(true, 250, false);
+  EXPECT_EQ(0, lastImage().model().size());
+
+  // The box moved to a cell within the frustum
+  server.Run(true, 200, false);
+  auto img = lastImage();
+  ASSERT_EQ(1, img.model().size());
+  EXPECT_EQ("box", img.model(0).name());
+  const auto expectedPose =
+      sensor1Pose.Inverse() * math::Pose3d(3, 0, 0.5, 0, 0, 0);
+  const auto boxPose = msgs::Convert(img.model(0).pose());
+  EXPECT_NEAR(expectedPose.Pos().X(), boxPose.Pos().X(), 1e-3);
+  EXPECT_NEAR(expectedPose.Pos().Y(), boxPose.Pos().Y(), 1e-3);
+  EXPECT_NEAR(expectedPose.Pos().Z(), boxPose.Pos().Z(), 1e-2);
+
+  // The box was removed from the index
+  server.Run(true, 200, false);
+  EXPECT_EQ(0, lastImage().model().size());
+}
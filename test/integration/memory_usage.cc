@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <atomic>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Server.hh"
+#include "test_config.hh"
+#include "../helpers/EnvTestFixture.hh"
+#include "../helpers/Relay.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test the memory usage service
+class MemoryUsageTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+// The report is written between steps, so it can be requested while the
+// systems keep changing the ECM
+TEST_F(MemoryUsageTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(WhileRunning))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "world_energy_monitor.sdf"));
+  Server server(serverConfig);
+
+  // Entities are created and removed on every step
+  std::atomic<uint64_t> steps{0u};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+      [&](const UpdateInfo &, EntityComponentManager &_ecm)
+      {
+        auto entity = _ecm.EntityByComponents(components::Name("temp"));
+        if (kNullEntity != entity)
+        {
+          _ecm.RequestRemoveEntity(entity);
+        }
+        else
+        {
+          entity = _ecm.CreateEntity();
+          _ecm.CreateComponent(entity, components::Name("temp"));
+          _ecm.CreateComponent(entity, components::Pose());
+        }
+        ++steps;
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  transport::Node node;
+  const std::string service{"/world/world_energy_monitor/memory_usage"};
+
+  // Stopped
+  msgs::StringMsg res;
+  bool result{false};
+  ASSERT_TRUE(node.Request(service, 5000u, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_NE(std::string::npos, res.data().find("component type"));
+  EXPECT_NE(std::string::npos, res.data().find("falling_box ["));
+
+  // Running
+  ASSERT_TRUE(server.Run(false, 0, false));
+  while (steps < 10u)
+    GZ_SLEEP_MS(10);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    res.Clear();
+    result = false;
+    ASSERT_TRUE(node.Request(service, 5000u, res, result));
+    EXPECT_TRUE(result);
+    EXPECT_NE(std::string::npos, res.data().find("component type"));
+    EXPECT_NE(std::string::npos, res.data().find("falling_box ["));
+    EXPECT_NE(std::string::npos, res.data().find("(outside models)"));
+  }
+
+  server.Stop();
+}
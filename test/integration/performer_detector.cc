@@ -265,3 +265,83 @@ TEST_F(PerformerDetectorTest,
   }
   EXPECT_EQ(2u, this->poseMsgs.size());
 }
+
+/////////////////////////////////////////////////
+// Test that performers teleported between cells of the index shared by the
+// detectors enter and exit the detectors they overlap
+TEST_F(PerformerDetectorTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(TeleportedPerformer))
+{
+  auto server = this->StartServer("/test/worlds/performer_detector.sdf");
+
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const UpdateInfo &_info,
+                             EntityComponentManager &_ecm)
+  {
+    Entity vehicle = _ecm.EntityByComponents(
+        components::Model(), components::Name("vehicle_blue"));
+    ASSERT_FALSE(kNullEntity == vehicle);
+
+    // Only in detector1's region, far away from both, then only in
+    // detector2's region
+    if (_info.iterations == 2)
+    {
+      _ecm.CreateComponent(vehicle,
+          components::WorldPoseCmd(math::Pose3d({3, -2, 0.325}, {})));
+    }
+    else if (_info.iterations == 4)
+    {
+      _ecm.CreateComponent(vehicle,
+          components::WorldPoseCmd(math::Pose3d({-100, -100, 0.325}, {})));
+    }
+    else if (_info.iterations == 6)
+    {
+      _ecm.CreateComponent(vehicle,
+          components::WorldPoseCmd(math::Pose3d({5, 4, 0.325}, {})));
+    }
+  });
+
+  server->AddSystem(testSystem.systemPtr);
+
+  auto detectorCb = std::function<void(const msgs::Pose &)>(
+      [this](const auto &_msg)
+      {
+        std::lock_guard<std::mutex> lock(this->poseMsgsMutex);
+        this->poseMsgs.push_back(_msg);
+      });
+
+  transport::Node node;
+  node.Subscribe("/performer_detector", detectorCb);
+
+  server->Run(true, 10, false);
+
+  // Wait for messages to arrive in poseMsgs or a timeout is reached
+  const auto timeOut = 5s;
+  auto tInit = std::chrono::steady_clock::now();
+  auto tNow = tInit;
+  while (tNow - tInit < timeOut)
+  {
+    std::this_thread::sleep_for(100ms);
+
+    std::lock_guard<std::mutex> lock(this->poseMsgsMutex);
+    if (this->poseMsgs.size() >= 3)
+      break;
+
+    tNow = std::chrono::steady_clock::now();
+  }
+
+  std::lock_guard<std::mutex> lock(this->poseMsgsMutex);
+  ASSERT_EQ(3u, this->poseMsgs.size());
+  EXPECT_EQ("detector1", this->poseMsgs[0].header().data(0).value(0));
+  EXPECT_EQ("1", this->poseMsgs[0].header().data(1).value(0));
+  EXPECT_EQ("detector1", this->poseMsgs[1].header().data(0).value(0));
+  EXPECT_EQ("0", this->poseMsgs[1].header().data(1).value(0));
+  EXPECT_EQ("detector2", this->poseMsgs[2].header().data(0).value(0));
+  EXPECT_EQ("1", this->poseMsgs[2].header().data(1).value(0));
+
+  // The reported position is relative to the detector
+  EXPECT_NEAR(-1.0, this->poseMsgs[0].position().x(), 1e-2);
+  EXPECT_NEAR(-2.0, this->poseMsgs[0].position().y(), 1e-2);
+  EXPECT_NEAR(0.0, this->poseMsgs[2].position().x(), 1e-2);
+  EXPECT_NEAR(1.0, this->poseMsgs[2].position().y(), 1e-2);
+}
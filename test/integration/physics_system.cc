@@ -18,6 +18,13 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -27,6 +34,8 @@
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
 #include <gz/msgs/Utility.hh>
+#include <gz/msgs/twist.pb.h>
+#include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 #include <sdf/Collision.hh>
 #include <sdf/Cylinder.hh>
@@ -42,6 +51,7 @@
 #include "gz/sim/Link.hh"
 #include "gz/sim/Server.hh"
 #include "gz/sim/SystemLoader.hh"
+#include "gz/sim/TestFixture.hh"
 #include "gz/sim/Types.hh"
 #include "gz/sim/Util.hh"
 #include "test_config.hh"  // NOLINT(build/include)
@@ -67,6 +77,7 @@
 #include "gz/sim/components/Link.hh"
 #include "gz/sim/components/LinearAcceleration.hh"
 #include "gz/sim/components/LinearVelocity.hh"
+#include "gz/sim/components/LinearVelocityCmd.hh"
 #include "gz/sim/components/Material.hh"
 #include "gz/sim/components/Model.hh"
 #include "gz/sim/components/Name.hh"
@@ -74,9 +85,12 @@
 #include "gz/sim/components/Physics.hh"
 #include "gz/sim/components/Pose.hh"
 #include "gz/sim/components/PoseCmd.hh"
+#include "gz/sim/components/RaycastData.hh"
+#include "gz/sim/components/Sleeping.hh"
 #include "gz/sim/components/Static.hh"
 #include "gz/sim/components/Visual.hh"
 #include "gz/sim/components/World.hh"
+#include "gz/sim/physics/Events.hh"
 
 #include "../helpers/Relay.hh"
 #include "../helpers/EnvTestFixture.hh"
@@ -190,6 +204,564 @@ TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(FallingObject))
   EXPECT_NEAR(spherePoses.back().Pos().Z(), zStopped, 5e-2);
 }
 
+/////////////////////////////////////////////////
+// Models simulated in different physics islands all collide with static
+// models, which are copied to every island.
+TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(Islands))
+{
+  const int sphereCount = 6;
+  const double radius = 0.5;
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='islands'>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'>"
+      << "<islands><count>3</count></islands>"
+      << "</plugin>"
+      << "<model name='ground'><static>true</static><link name='link'>"
+      << "<collision name='collision'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>100 100</size></plane>"
+      << "</geometry></collision></link></model>";
+  for (int i = 0; i < sphereCount; ++i)
+  {
+    sdf << "<model name='sphere_" << i << "'>"
+        << "<pose>" << i * 2.0 << " 0 " << 1.0 + i * 0.2 << " 0 0 0</pose>"
+        << "<link name='link'><collision name='collision'><geometry>"
+        << "<sphere><radius>" << radius << "</radius></sphere>"
+        << "</geometry></collision></link></model>";
+  }
+  sdf << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  std::map<std::string, math::Pose3d> spherePoses;
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+    [&spherePoses](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      _ecm.Each<components::Model, components::Name, components::Pose>(
+        [&](const Entity &, const components::Model *,
+        const components::Name *_name, const components::Pose *_pose)->bool
+        {
+          if (_name->Data().find("sphere_") == 0)
+            spherePoses[_name->Data()] = _pose->Data();
+          return true;
+        });
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  // All spheres fall freely at first
+  const size_t iters = 10;
+  server.Run(true, iters, false);
+  ASSERT_EQ(static_cast<std::size_t>(sphereCount), spherePoses.size());
+  const double dt = 0.001;
+  for (int i = 0; i < sphereCount; ++i)
+  {
+    const double zExpected = 1.0 + i * 0.2 - 0.5 * 9.8 * pow(iters * dt, 2);
+    EXPECT_NEAR(zExpected,
+        spherePoses["sphere_" + std::to_string(i)].Pos().Z(), 2e-4) << i;
+  }
+
+  // And then all of them land on the ground, whatever their island
+  server.Run(true, 2000, false);
+  for (int i = 0; i < sphereCount; ++i)
+  {
+    const auto &pose = spherePoses["sphere_" + std::to_string(i)];
+    EXPECT_NEAR(radius, pose.Pos().Z(), 5e-2) << i;
+    EXPECT_NEAR(i * 2.0, pose.Pos().X(), 1e-3) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+// Contact surfaces can be customized for collisions of every island
+TEST_F(PhysicsSystemFixture,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(IslandsContactSurfaceCustomization))
+{
+  const int sphereCount = 4;
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='islands_contact_surface'>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'>"
+      << "<islands><count>2</count></islands>"
+      << "</plugin>"
+      << "<model name='ground'><static>true</static><link name='link'>"
+      << "<collision name='collision'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>100 100</size></plane>"
+      << "</geometry></collision></link></model>";
+  for (int i = 0; i < sphereCount; ++i)
+  {
+    sdf << "<model name='sphere_" << i << "'>"
+        << "<pose>" << i * 2.0 << " 0 0.5 0 0 0</pose>"
+        << "<link name='link'><collision name='collision'><geometry>"
+        << "<sphere><radius>0.5</radius></sphere>"
+        << "</geometry></collision></link></model>";
+  }
+  sdf << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+
+  // Collisions of the spheres, and the ones seen by the callback
+  std::set<Entity> sphereCollisions;
+  std::set<Entity> customized;
+  std::mutex mutex;
+  common::ConnectionPtr connection;
+
+  TestFixture fixture(serverConfig);
+  fixture.OnConfigure(
+    [&](const Entity &, const std::shared_ptr<const sdf::Element> &,
+        EntityComponentManager &, EventManager &_eventMgr)
+    {
+      connection = _eventMgr.Connect<
+          events::CollectContactSurfaceProperties>(
+        [&](const Entity &_collision1, const Entity &_collision2,
+            const math::Vector3d &, const std::optional<math::Vector3d>,
+            const std::optional<math::Vector3d>, const std::optional<double>,
+            const size_t, physics::SetContactPropertiesCallbackFeature::
+                ContactSurfaceParams<physics::FeaturePolicy3d> &)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          customized.insert(_collision1);
+          customized.insert(_collision2);
+        });
+    })
+  .OnPreUpdate(
+    [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    {
+      if (_info.iterations != 1u)
+        return;
+
+      _ecm.Each<components::Collision, components::ParentEntity>(
+        [&](const Entity &_entity, const components::Collision *,
+            const components::ParentEntity *_parent) -> bool
+        {
+          auto model = _ecm.Component<components::ParentEntity>(
+              _parent->Data());
+          auto name = _ecm.Component<components::Name>(model->Data());
+          if (name->Data().find("sphere_") != 0)
+            return true;
+
+          sphereCollisions.insert(_entity);
+          _ecm.CreateComponent(_entity,
+              components::EnableContactSurfaceCustomization(true));
+          return true;
+        });
+    }).Finalize();
+
+  fixture.Server()->Run(true, 100, false);
+
+  ASSERT_EQ(static_cast<std::size_t>(sphereCount), sphereCollisions.size());
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto collision : sphereCollisions)
+    EXPECT_EQ(1u, customized.count(collision)) << collision;
+}
+
+/////////////////////////////////////////////////
+// Models spawned together are created over several steps when the creation
+// budget is limited
+TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(CreationBudget))
+{
+  const int sphereCount = 5;
+  const double z0 = 10.0;
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='creation_budget'>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'>"
+      << "<creation><models_per_step>2</models_per_step></creation>"
+      << "</plugin>";
+  for (int i = 0; i < sphereCount; ++i)
+  {
+    sdf << "<model name='sphere_" << i << "'>"
+        << "<pose>" << i * 2.0 << " 0 " << z0 << " 0 0 0</pose>"
+        << "<link name='link'><collision name='collision'><geometry>"
+        << "<sphere><radius>0.5</radius></sphere>"
+        << "</geometry></collision></link></model>";
+  }
+  sdf << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  // Models that haven't been created in physics yet don't fall
+  int fallingCount{0};
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+    [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      fallingCount = 0;
+      _ecm.Each<components::Model, components::Pose>(
+        [&](const Entity &, const components::Model *,
+            const components::Pose *_pose)->bool
+        {
+          if (_pose->Data().Pos().Z() < z0)
+            ++fallingCount;
+          return true;
+        });
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(true, 1, false);
+  EXPECT_EQ(2, fallingCount);
+
+  server.Run(true, 1, false);
+  EXPECT_EQ(4, fallingCount);
+
+  server.Run(true, 1, false);
+  EXPECT_EQ(sphereCount, fallingCount);
+
+  server.Run(true, 10, false);
+  EXPECT_EQ(sphereCount, fallingCount);
+}
+
+/////////////////////////////////////////////////
+// Each iteration runs several physics steps of a fraction of the step size
+TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(Substeps))
+{
+  const double z0 = 10.0;
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='substeps'>"
+      << "<physics name='10ms' type='ode'>"
+      << "<max_step_size>0.01</max_step_size>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'>"
+      << "<substeps>10</substeps>"
+      << "</plugin>"
+      << "<model name='sphere'><pose>0 0 " << z0 << " 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<sphere><radius>0.5</radius></sphere>"
+      << "</geometry></collision></link></model>"
+      << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  int postUpdates{0};
+  double z{z0};
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+    [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      ++postUpdates;
+      auto sphere = _ecm.EntityByComponents(components::Model(),
+          components::Name("sphere"));
+      z = _ecm.Component<components::Pose>(sphere)->Data().Pos().Z();
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  const int iterations = 10;
+  server.Run(true, iterations, false);
+  EXPECT_EQ(iterations, postUpdates);
+
+  // The engine integrates with semi-implicit Euler, so after n steps of
+  // size h the sphere fell by g * h^2 * n * (n + 1) / 2. With 1 ms substeps
+  // that's noticeably less than with 10 ms steps.
+  const double g = 9.8;
+  auto drop = [&](double _h, int _n)
+  {
+    return g * _h * _h * _n * (_n + 1) / 2.0;
+  };
+  EXPECT_NEAR(z0 - drop(0.001, 10 * iterations), z, 1e-4);
+  EXPECT_GT(std::abs(z0 - drop(0.01, iterations) - z), 1e-3);
+}
+
+/////////////////////////////////////////////////
+// The server configuration sets the number of substeps, and velocity
+// commands are held during all substeps of an iteration
+TEST_F(PhysicsSystemFixture,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(SubstepsHoldVelocityCommands))
+{
+  const double z0 = 10.0;
+
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='substeps'>"
+      << "<physics name='10ms' type='ode'>"
+      << "<max_step_size>0.01</max_step_size>"
+      << "</physics>"
+      << "<model name='sphere'><pose>0 0 " << z0 << " 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<sphere><radius>0.5</radius></sphere>"
+      << "</geometry></collision></link></model>"
+      << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+  serverConfig.SetPhysicsSubsteps(10u);
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  std::optional<uint32_t> substeps;
+  math::Vector3d pos;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &, EntityComponentManager &_ecm)
+    {
+      // Command the sphere to move sideways without falling
+      auto sphere = _ecm.EntityByComponents(components::Model(),
+          components::Name("sphere"));
+      _ecm.SetComponentData<components::LinearVelocityCmd>(sphere,
+          math::Vector3d(1, 0, 0));
+    });
+  testSystem.OnPostUpdate(
+    [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      auto world = _ecm.EntityByComponents(components::World());
+      substeps = _ecm.ComponentData<components::PhysicsSubsteps>(world);
+      auto sphere = _ecm.EntityByComponents(components::Model(),
+          components::Name("sphere"));
+      pos = _ecm.Component<components::Pose>(sphere)->Data().Pos();
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  const int iterations = 10;
+  server.Run(true, iterations, false);
+
+  ASSERT_TRUE(substeps.has_value());
+  EXPECT_EQ(10u, *substeps);
+
+  // The commanded velocity is applied on every substep, so gravity only acts
+  // for one 1 ms substep at a time instead of building up over the whole
+  // iteration
+  EXPECT_NEAR(0.1, pos.X(), 1e-3);
+  EXPECT_LT(z0 - pos.Z(), 2e-3);
+}
+
+/////////////////////////////////////////////////
+// Resting links fall asleep, and pose commands wake them up
+TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(Sleep))
+{
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='sleep'>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'>"
+      << "<sleep><steps>50</steps></sleep>"
+      << "</plugin>"
+      << "<model name='ground'><static>true</static><link name='link'>"
+      << "<collision name='collision'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>100 100</size></plane>"
+      << "</geometry></collision></link></model>"
+      << "<model name='box'><pose>0 0 0.6 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<box><size>1 1 1</size></box>"
+      << "</geometry></collision></link></model>"
+      << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  bool sendPoseCmd{false};
+  bool sleeping{false};
+  math::Pose3d boxPose;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&sendPoseCmd](const UpdateInfo &, EntityComponentManager &_ecm)
+    {
+      if (!sendPoseCmd)
+        return;
+      sendPoseCmd = false;
+
+      auto box = _ecm.EntityByComponents(components::Model(),
+          components::Name("box"));
+      _ecm.CreateComponent(box,
+          components::WorldPoseCmd(math::Pose3d(0, 0, 2, 0, 0, 0)));
+    });
+  testSystem.OnPostUpdate(
+    [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      auto box = _ecm.EntityByComponents(components::Model(),
+          components::Name("box"));
+      auto link = _ecm.EntityByComponents(components::Link(),
+          components::ParentEntity(box));
+      sleeping = _ecm.EntityHasComponentType(link,
+          components::Sleeping::typeId);
+      boxPose = _ecm.Component<components::Pose>(box)->Data();
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  // The box is awake while it falls
+  server.Run(true, 50, false);
+  EXPECT_FALSE(sleeping);
+
+  // And falls asleep after resting on the ground for a while
+  server.Run(true, 1000, false);
+  EXPECT_TRUE(sleeping);
+  EXPECT_NEAR(0.5, boxPose.Pos().Z(), 1e-2);
+
+  // Teleporting the box wakes it up, and it falls again
+  sendPoseCmd = true;
+  server.Run(true, 1, false);
+  EXPECT_FALSE(sleeping);
+  EXPECT_NEAR(2.0, boxPose.Pos().Z(), 1e-2);
+
+  server.Run(true, 100, false);
+  EXPECT_FALSE(sleeping);
+  EXPECT_LT(boxPose.Pos().Z(), 2.0 - 1e-2);
+}
+
+/////////////////////////////////////////////////
+// Get a world with a vehicle that has no joints, moved by a drive system in
+// kinematic mode.
+// \param[in] _plugin Plugin element of the drive system, without the
+// kinematic element.
+// \return The SDF of the world.
+std::string kinematicVehicleWorld(const std::string &_plugin)
+{
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='kinematic'>"
+      << "<gravity>0 0 0</gravity>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'/>"
+      << "<model name='vehicle'>"
+      << "<link name='chassis'><inertial><mass>10</mass></inertial>"
+      << "<collision name='collision'><geometry>"
+      << "<box><size>2 1 0.5</size></box>"
+      << "</geometry></collision></link>"
+      << _plugin.substr(0, _plugin.rfind("</plugin>"))
+      << "<kinematic>true</kinematic></plugin>"
+      << "</model>"
+      << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+// Drive the vehicle of kinematicVehicleWorld for one second.
+// \param[in] _plugin Plugin element of the drive system.
+// \param[in] _linVel Commanded linear velocity.
+// \param[in] _angVel Commanded angular velocity.
+// \return Pose of the vehicle after one second.
+math::Pose3d driveKinematicVehicle(const std::string &_plugin,
+    double _linVel, double _angVel)
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(kinematicVehicleWorld(_plugin));
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Twist>("/model/vehicle/cmd_vel");
+  msgs::Twist msg;
+  msgs::Set(msg.mutable_linear(), math::Vector3d(_linVel, 0, 0));
+  msgs::Set(msg.mutable_angular(), math::Vector3d(0, 0, _angVel));
+
+  math::Pose3d pose;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &, EntityComponentManager &)
+    {
+      pub.Publish(msg);
+    });
+  testSystem.OnPostUpdate(
+    [&pose](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      auto vehicle = _ecm.EntityByComponents(components::Model(),
+          components::Name("vehicle"));
+      pose = _ecm.Component<components::Pose>(vehicle)->Data();
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(true, 1000, false);
+  return pose;
+}
+
+/////////////////////////////////////////////////
+// In kinematic mode, DiffDrive moves the vehicle at the commanded velocities
+// through velocity commands, without any wheel joints
+TEST_F(PhysicsSystemFixture,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(DiffDriveKinematic))
+{
+  const double linVel = 1.0;
+  const double angVel = 0.5;
+  const auto pose = driveKinematicVehicle(
+      "<plugin filename='gz-sim-diff-drive-system'"
+      " name='gz::sim::systems::DiffDrive'>"
+      "<wheel_separation>1.0</wheel_separation>"
+      "<wheel_radius>0.2</wheel_radius>"
+      "</plugin>", linVel, angVel);
+
+  // The vehicle follows an arc of radius linVel / angVel, once the commands
+  // arrive
+  const double yaw = angVel * 1.0;
+  const double radius = linVel / angVel;
+  EXPECT_NEAR(yaw, pose.Rot().Yaw(), 0.02);
+  EXPECT_NEAR(radius * std::sin(yaw), pose.Pos().X(), 0.03);
+  EXPECT_NEAR(radius * (1.0 - std::cos(yaw)), pose.Pos().Y(), 0.03);
+  EXPECT_NEAR(0.0, pose.Pos().Z(), 1e-6);
+}
+
+/////////////////////////////////////////////////
+// In kinematic mode, AckermannSteering moves the vehicle at the commanded
+// linear velocity, turning no tighter than its steering limit allows,
+// without any wheel or steering joints
+TEST_F(PhysicsSystemFixture,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(AckermannSteeringKinematic))
+{
+  const double wheelBase = 1.0;
+  const double steeringLimit = 0.5;
+  const double linVel = 1.0;
+  const auto pose = driveKinematicVehicle(
+      "<plugin filename='gz-sim-ackermann-steering-system'"
+      " name='gz::sim::systems::AckermannSteering'>"
+      "<wheel_base>1.0</wheel_base>"
+      "<steering_limit>0.5</steering_limit>"
+      "</plugin>", linVel, 10.0);
+
+  // The commanded yaw rate is too high, so the vehicle turns at the minimum
+  // turning radius
+  const double radius = wheelBase / std::sin(steeringLimit);
+  const double yaw = linVel / radius * 1.0;
+  EXPECT_NEAR(yaw, pose.Rot().Yaw(), 0.02);
+  EXPECT_NEAR(radius * std::sin(yaw), pose.Pos().X(), 0.03);
+  EXPECT_NEAR(radius * (1.0 - std::cos(yaw)), pose.Pos().Y(), 0.03);
+  EXPECT_NEAR(0.0, pose.Pos().Z(), 1e-6);
+}
+
 /////////////////////////////////////////////////
 // This tests whether links with fixed joints keep their relative transforms
 // after physics. For that to work properly, the canonical link implementation
@@ -2621,3 +3193,72 @@ TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(JointsInWorld))
   server.AddSystem(testSystem.systemPtr);
   server.Run(true, 1000, false);
 }
+
+/////////////////////////////////////////////////
+// Rays of RaycastData components are cast after each step
+TEST_F(PhysicsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_WIN32(RaycastData))
+{
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='raycast'>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'>"
+      << "</plugin>"
+      << "<model name='ground'><static>true</static><link name='link'>"
+      << "<collision name='collision'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>10 10</size></plane>"
+      << "</geometry></collision></link></model>"
+      << "<model name='sphere'><pose>0 0 2 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<sphere><radius>0.5</radius></sphere>"
+      << "</geometry></collision></link></model>"
+      << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+  Server server(serverConfig);
+
+  int checked{0};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    {
+      if (_info.iterations != 1)
+        return;
+      // Rays in the frame of the world: down through the sphere, down next
+      // to it onto the ground, and outside of the ground
+      components::RaycastDataInfo data;
+      data.rays.push_back({{0, 0, 5}, {0, 0, -5}});
+      data.rays.push_back({{2, 0, 5}, {2, 0, -5}});
+      data.rays.push_back({{20, 0, 5}, {20, 0, -5}});
+      _ecm.CreateComponent(worldEntity(_ecm), components::RaycastData(data));
+    });
+  testSystem.OnPostUpdate(
+    [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      auto raycast = _ecm.Component<components::RaycastData>(
+          worldEntity(_ecm));
+      if (nullptr == raycast)
+        return;
+      const auto &results = raycast->Data().results;
+      ASSERT_EQ(3u, results.size());
+
+      const auto sphere = _ecm.EntityByComponents(components::Model(),
+          components::Name("sphere"));
+      const double top = worldPose(sphere, _ecm).Pos().Z() + 0.5;
+      ASSERT_TRUE(results[0].Hit());
+      EXPECT_NEAR(top, results[0].point.Z(), 1e-6);
+      EXPECT_NEAR((5.0 - top) / 10.0, results[0].fraction, 1e-6);
+
+      ASSERT_TRUE(results[1].Hit());
+      EXPECT_EQ(math::Vector3d(2, 0, 0), results[1].point);
+      EXPECT_DOUBLE_EQ(0.5, results[1].fraction);
+
+      EXPECT_FALSE(results[2].Hit());
+      ++checked;
+    });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 100, false);
+  EXPECT_EQ(100, checked);
+}
@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <mutex>
 
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/entity.pb.h>
 #include <gz/msgs/pose.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 
@@ -763,3 +765,94 @@ TEST_F(PosePublisherTest,
   }
 
 }
+
+/////////////////////////////////////////////////
+TEST_F(PosePublisherTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(WorldPosePublisher))
+{
+  const std::string sdfString = R"(
+  <sdf version="1.6">
+    <world name="pose_world">
+      <plugin
+        filename="gz-sim-user-commands-system"
+        name="gz::sim::systems::UserCommands">
+      </plugin>
+      <plugin
+        filename="gz-sim-pose-publisher-system"
+        name="gz::sim::systems::PosePublisher">
+      </plugin>
+      <model name="box">
+        <pose>1 2 3 0 0 0</pose>
+        <link name="link"/>
+      </model>
+      <model name="sphere">
+        <pose>-1 0 0 0 0 0</pose>
+        <link name="link"/>
+      </model>
+    </world>
+  </sdf>)";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+
+  Server server(serverConfig);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    poseVMsgs.clear();
+  }
+
+  transport::Node node;
+  node.Subscribe(std::string("/world/pose_world/pose"), &poseVCb);
+
+  server.Run(true, 100, false);
+
+  int sleep = 0;
+  while (sleep++ < 30)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!poseVMsgs.empty())
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  // The poses of all the models are published together, from the world
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_FALSE(poseVMsgs.empty());
+    const auto &msg = poseVMsgs.back();
+    ASSERT_EQ(2, msg.pose_size());
+    for (const auto &pose : msg.pose())
+    {
+      ASSERT_LT(1, pose.header().data_size());
+      EXPECT_EQ("pose_world", pose.header().data(0).value(0));
+      EXPECT_EQ(pose.name(), pose.header().data(1).value(0));
+      if (pose.name() == "box")
+        EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), msgs::Convert(pose));
+      else
+        EXPECT_EQ("sphere", pose.name());
+    }
+  }
+
+  // Removed models aren't published anymore
+  msgs::Entity req;
+  req.set_name("box");
+  req.set_type(msgs::Entity::MODEL);
+  msgs::Boolean rep;
+  bool result{false};
+  EXPECT_TRUE(node.Request("/world/pose_world/remove", req, 5000, rep,
+      result));
+  EXPECT_TRUE(result);
+
+  server.Run(true, 100, false);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_FALSE(poseVMsgs.empty());
+  const auto &msg = poseVMsgs.back();
+  ASSERT_EQ(1, msg.pose_size());
+  EXPECT_EQ("sphere", msg.pose(0).name());
+  EXPECT_EQ(math::Pose3d(-1, 0, 0, 0, 0, 0), msgs::Convert(msg.pose(0)));
+}
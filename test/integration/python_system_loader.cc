@@ -16,6 +16,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <pybind11/pybind11.h>
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/world_control.pb.h>
 
@@ -25,6 +26,7 @@
 #include <gz/utils/ExtraTestMacros.hh>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "gz/sim/Server.hh"
 #include "gz/sim/ServerConfig.hh"
@@ -116,3 +118,62 @@ TEST_F(PythonSystemLoaderTest,
   ASSERT_TRUE(afterResetModelPose.has_value());
   EXPECT_NEAR(10.0, afterResetModelPose->X(), 1e-3);
 }
+
+/////////////////////////////////////////////////
+// Check that C++ systems are updated without holding the GIL while Python
+// systems keep running.
+TEST_F(PythonSystemLoaderTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(CppSystemsRunWithoutGil))
+{
+  common::setenv("GZ_SIM_SYSTEM_PLUGIN_PATH",
+                 common::joinPaths(std::string(PROJECT_SOURCE_PATH), "python",
+                                   "test", "plugins"));
+
+  sim::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "test", "worlds", "python_system_loader.sdf"));
+
+  sim::Server server(serverConfig);
+  using namespace std::chrono_literals;
+  server.SetUpdatePeriod(1ns);
+  ASSERT_NE(0, Py_IsInitialized());
+
+  std::vector<int> gilStates;
+  std::optional<math::Pose3d> postUpdateModelPose;
+  auto testSystem = std::make_shared<sim::MockSystem>();
+  testSystem->preUpdateCallback =
+      [&](const sim::UpdateInfo &, sim::EntityComponentManager &)
+  {
+    gilStates.push_back(PyGILState_Check());
+  };
+  testSystem->updateCallback =
+      [&](const sim::UpdateInfo &, sim::EntityComponentManager &)
+  {
+    gilStates.push_back(PyGILState_Check());
+  };
+  testSystem->postUpdateCallback =
+      [&](const sim::UpdateInfo &, const sim::EntityComponentManager &_ecm)
+  {
+    gilStates.push_back(PyGILState_Check());
+    auto testModel = _ecm.EntityByComponents(components::Model(),
+        components::Name("box"));
+    if (testModel != sim::kNullEntity)
+    {
+      postUpdateModelPose = sim::worldPose(testModel, _ecm);
+    }
+  };
+  server.AddSystem(testSystem);
+  server.Run(true, 10, false);
+
+  // None of the C++ system callbacks held the GIL
+  ASSERT_EQ(30u, gilStates.size());
+  for (int state : gilStates)
+    EXPECT_EQ(0, state);
+
+  // The Python systems still ran
+  ASSERT_TRUE(postUpdateModelPose.has_value());
+  EXPECT_EQ(math::Pose3d(0, 0, 10, 0, 0, 0), *postUpdateModelPose);
+
+  // The GIL is held again by this thread once the update is done
+  EXPECT_EQ(1, PyGILState_Check());
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Image.hh>
+#include <gz/rendering/Scene.hh>
+
+#include <sdf/Box.hh>
+#include <sdf/Geometry.hh>
+#include <sdf/Link.hh>
+#include <sdf/Material.hh>
+#include <sdf/Root.hh>
+#include <sdf/Sensor.hh>
+#include <sdf/Visual.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/EventManager.hh"
+#include "gz/sim/SdfEntityCreator.hh"
+#include "gz/sim/Types.hh"
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/rendering/RenderUtil.hh"
+
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief World with a camera looking down the X axis at a box
+const char kWorld[] = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="culling">
+    <model name="box">
+      <static>true</static>
+      <pose>30 0 0 0 0 0</pose>
+      <link name="link">
+        <visual name="visual">
+          <geometry>
+            <box><size>4 4 4</size></box>
+          </geometry>
+          <material>
+            <ambient>1 1 1 1</ambient>
+            <diffuse>1 1 1 1</diffuse>
+            <emissive>1 1 1 1</emissive>
+          </material>
+        </visual>
+      </link>
+    </model>
+    <model name="camera">
+      <static>true</static>
+      <link name="link">
+        <sensor name="camera" type="camera">
+          <camera>
+            <horizontal_fov>1.047</horizontal_fov>
+            <image>
+              <width>64</width>
+              <height>48</height>
+            </image>
+            <clip>
+              <near>0.1</near>
+              <far>100</far>
+            </clip>
+          </camera>
+        </sensor>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+/// \brief ECM that lets the test clear the new entities after an update,
+/// like the simulation runner does.
+class CullingEcm : public EntityComponentManager
+{
+  public: using EntityComponentManager::ClearNewlyCreatedEntities;
+};
+
+/////////////////////////////////////////////////
+class RenderUtilCullingTest : public InternalFixture<::testing::Test>
+{
+  /// \brief Update the scene from the ECM, render the camera, and get
+  /// the brightness of the center of its image.
+  /// \return Sum of the channels of the center pixel.
+  protected: int RenderCenter()
+  {
+    UpdateInfo info;
+    this->renderUtil.UpdateECM(info, this->ecm);
+    this->renderUtil.UpdateFromECM(info, this->ecm);
+    this->renderUtil.Update();
+    this->ecm.ClearNewlyCreatedEntities();
+
+    if (!this->camera)
+      return -1;
+    this->camera->Update();
+    this->camera->Capture(this->image);
+    const auto *data = this->image.Data<unsigned char>();
+    const auto center = (this->camera->ImageHeight() / 2 *
+        this->camera->ImageWidth() + this->camera->ImageWidth() / 2) * 3;
+    return data[center] + data[center + 1] + data[center + 2];
+  }
+
+  /// \brief Move the box along the X axis.
+  /// \param[in] _x New position.
+  protected: void MoveBox(double _x)
+  {
+    auto box = this->ecm.EntityByComponents(components::Model(),
+        components::Name("box"));
+    this->ecm.SetComponentData<components::Pose>(box,
+        math::Pose3d(_x, 0, 0, 0, 0, 0));
+  }
+
+  protected: CullingEcm ecm;
+  protected: EventManager eventMgr;
+  protected: RenderUtil renderUtil;
+  protected: rendering::CameraPtr camera;
+  protected: rendering::Image image;
+};
+
+/////////////////////////////////////////////////
+// Visuals out of range of the sensors are culled, visuals hidden through
+// RenderUtil::SetEntityVisible stay hidden when they come back in range, and
+// the bounds of visuals follow their geometry
+TEST_F(RenderUtilCullingTest,
+       GZ_UTILS_TEST_DISABLED_ON_MAC(CulledAndHiddenVisuals))
+{
+  sdf::Root root;
+  ASSERT_TRUE(root.LoadSdfString(kWorld).empty());
+  SdfEntityCreator creator(this->ecm, this->eventMgr);
+  creator.CreateEntities(root.WorldByIndex(0));
+
+  this->renderUtil.SetEngineName("ogre2");
+  this->renderUtil.SetSceneName("culling");
+  this->renderUtil.SetBackgroundColor(math::Color::Black);
+  this->renderUtil.SetAmbientLight(math::Color::White);
+  this->renderUtil.SetSensorCullingDistance(20.0);
+  this->renderUtil.SetEnableSensors(true,
+      [&](const Entity &, const sdf::Sensor &_sdf,
+          const std::string &) -> std::string
+      {
+        auto cameraSdf = _sdf.CameraSensor();
+        this->camera = this->renderUtil.Scene()->CreateCamera(_sdf.Name());
+        this->camera->SetImageWidth(cameraSdf->ImageWidth());
+        this->camera->SetImageHeight(cameraSdf->ImageHeight());
+        this->camera->SetHFOV(cameraSdf->HorizontalFov());
+        this->camera->SetNearClipPlane(cameraSdf->NearClip());
+        this->camera->SetFarClipPlane(cameraSdf->FarClip());
+        this->camera->SetImageFormat(rendering::PF_R8G8B8);
+        this->image = this->camera->CreateImage();
+        return this->camera->Name();
+      });
+  this->renderUtil.Init();
+  ASSERT_NE(nullptr, this->renderUtil.Scene());
+
+  // The box is beyond the culling distance
+  const int background = this->RenderCenter();
+  ASSERT_NE(nullptr, this->camera);
+
+  // It's shown once it's in range
+  this->MoveBox(10.0);
+  const int box = this->RenderCenter();
+  EXPECT_GT(box, background);
+
+  // Out of range and back, it's shown again
+  this->MoveBox(30.0);
+  EXPECT_EQ(background, this->RenderCenter());
+  this->MoveBox(10.0);
+  EXPECT_EQ(box, this->RenderCenter());
+
+  // Once hidden, it stays hidden after coming back in range
+  auto boxEntity = this->ecm.EntityByComponents(components::Model(),
+      components::Name("box"));
+  this->renderUtil.SetEntityVisible(boxEntity, false);
+  EXPECT_EQ(background, this->RenderCenter());
+  this->MoveBox(30.0);
+  EXPECT_EQ(background, this->RenderCenter());
+  this->MoveBox(10.0);
+  EXPECT_EQ(background, this->RenderCenter());
+
+  // And it's shown when it's made visible
+  this->renderUtil.SetEntityVisible(boxEntity, true);
+  EXPECT_EQ(box, this->RenderCenter());
+
+  // A larger visual added to the culled model brings it in range
+  this->MoveBox(30.0);
+  EXPECT_EQ(background, this->RenderCenter());
+
+  sdf::Box boxShape;
+  boxShape.SetSize(math::Vector3d(24, 24, 24));
+  sdf::Geometry geometry;
+  geometry.SetType(sdf::GeometryType::BOX);
+  geometry.SetBoxShape(boxShape);
+  sdf::Material material;
+  material.SetAmbient(math::Color::White);
+  material.SetDiffuse(math::Color::White);
+  material.SetEmissive(math::Color::White);
+  sdf::Visual visual;
+  visual.SetName("large_visual");
+  visual.SetGeom(geometry);
+  visual.SetMaterial(material);
+  sdf::Link link;
+  link.SetName("large_link");
+  link.AddVisual(visual);
+  auto linkEntity = creator.CreateEntities(&link);
+  creator.SetParent(linkEntity, boxEntity);
+
+  EXPECT_GT(this->RenderCenter(), background);
+}
@@ -18,8 +18,11 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <fstream>
 #include <functional>
 #include <mutex>
+#include <sstream>
+#include <string>
 
 #include <gz/msgs/dataframe.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
@@ -120,3 +123,61 @@ TEST_F(RFCommsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RFComms))
   }
   EXPECT_LT(expectedMsgCount, msgCounter);
 }
+
+/////////////////////////////////////////////////
+TEST_F(RFCommsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(OutOfRange))
+{
+  // The radios of the example world are 52 m apart, reduce the max range
+  // below that
+  const auto sdfFile =
+    gz::common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "examples", "worlds", "rf_comms.sdf");
+  std::ifstream file(sdfFile);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string sdfString = buffer.str();
+  const std::string maxRange{"<max_range>500000.0</max_range>"};
+  const auto pos = sdfString.find(maxRange);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.replace(pos, maxRange.size(), "<max_range>10.0</max_range>");
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+
+  Server server(serverConfig);
+  server.Run(true, 1000, false);
+
+  unsigned int msgCounter = 0u;
+  std::mutex mutex;
+  std::function<void(const msgs::Dataframe &)> cb =
+      [&](const msgs::Dataframe &)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        msgCounter++;
+      };
+
+  gz::transport::Node node;
+  EXPECT_TRUE(node.Subscribe("addr1/rx", cb));
+  auto pub = node.Advertise<gz::msgs::Dataframe>("/broker/msgs");
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  gz::msgs::Dataframe msg;
+  msg.set_src_address("addr2");
+  msg.set_dst_address("addr1");
+
+  gz::msgs::StringMsg payload;
+  for (unsigned int i = 0u; i < 10u; ++i)
+  {
+    payload.set_data("hello world " + std::to_string(i));
+    std::string serializedData;
+    EXPECT_TRUE(payload.SerializeToString(&serializedData));
+    msg.set_data(serializedData);
+    EXPECT_TRUE(pub.Publish(msg));
+    server.Run(true, 100, false);
+  }
+
+  // The receiver is out of range, so no packet gets through
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(0u, msgCounter);
+}
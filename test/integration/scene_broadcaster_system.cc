@@ -20,6 +20,7 @@
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/empty.pb.h>
 #include <gz/msgs/entity_factory.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/particle_emitter.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/projector.pb.h>
@@ -39,6 +40,10 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
 #include <thread>
 
 #include <gz/common/Console.hh>
@@ -49,6 +54,7 @@
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
+#include "gz/sim/EntityComponentManager.hh"
 #include "gz/sim/Server.hh"
 #include "test_config.hh"
 
@@ -538,6 +544,243 @@ TEST_P(SceneBroadcasterTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(State))
   EXPECT_TRUE(received);
 }
 
+/////////////////////////////////////////////////
+// While the state topic has subscribers, the services answer from snapshots
+// that follow the published changes, without waiting for the simulation
+TEST_P(SceneBroadcasterTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(StateSnapshot))
+{
+  // Start server
+  sim::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  sim::Server server(serverConfig);
+
+  const math::Pose3d boxPose(1, 2, 3, 0, 0, 0);
+  bool moveBox{false};
+  bool removeSphere{false};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const sim::UpdateInfo &, sim::EntityComponentManager &_ecm)
+    {
+      if (moveBox)
+      {
+        moveBox = false;
+        auto box = _ecm.EntityByComponents(sim::components::Model(),
+            sim::components::Name("box"));
+        _ecm.SetComponentData<sim::components::Pose>(box, boxPose);
+        _ecm.SetChanged(box, sim::components::Pose::typeId,
+            sim::ComponentState::OneTimeChange);
+      }
+      if (removeSphere)
+      {
+        removeSphere = false;
+        _ecm.RequestRemoveEntity(_ecm.EntityByComponents(
+            sim::components::Model(), sim::components::Name("sphere")));
+      }
+    });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+
+  // Subscribe, and wait for the subscription to be seen
+  transport::Node node;
+  std::mutex mutex;
+  bool published{false};
+  std::function<void(const msgs::SerializedStepMap &)> stateCb =
+      [&](const msgs::SerializedStepMap &)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    published = true;
+  };
+  EXPECT_TRUE(node.Subscribe("/world/default/state", stateCb));
+  auto received = [&]
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return published;
+  };
+
+  unsigned int sleep{0u};
+  unsigned int maxSleep{30u};
+  while (!received() && sleep++ < maxSleep)
+  {
+    GZ_SLEEP_MS(100);
+    server.Run(true, 1, false);
+  }
+  ASSERT_TRUE(received());
+
+  // The first request takes the full state from the simulation
+  bool result{false};
+  unsigned int timeout{5000u};
+  msgs::SerializedStepMap res;
+  std::atomic<bool> done{false};
+  auto requestThread = std::thread([&]
+  {
+    EXPECT_TRUE(node.Request("/world/default/state", timeout, res, result));
+    done = true;
+  });
+  sleep = 0u;
+  while (!done && sleep++ < maxSleep)
+  {
+    GZ_SLEEP_MS(100);
+    server.Run(true, 1, false);
+  }
+  requestThread.join();
+  ASSERT_TRUE(result);
+  EXPECT_EQ(25, res.state().entities_size());
+
+  // Change a component and remove a model, which are merged into the
+  // snapshot as they're published
+  moveBox = true;
+  removeSphere = true;
+  server.Run(true, 10, false);
+  ASSERT_FALSE(moveBox);
+  ASSERT_FALSE(removeSphere);
+
+  // The changes are published on another thread
+  GZ_SLEEP_MS(500);
+
+  // The simulation isn't running, so these are answered from the snapshots
+  result = false;
+  res.Clear();
+  EXPECT_TRUE(node.Request("/world/default/state", timeout, res, result));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(static_cast<int>(*server.EntityCount()),
+      res.state().entities_size());
+
+  sim::EntityComponentManager ecm;
+  ecm.SetState(res.state());
+  EXPECT_EQ(sim::kNullEntity, ecm.EntityByComponents(
+      sim::components::Model(), sim::components::Name("sphere")));
+  auto box = ecm.EntityByComponents(sim::components::Model(),
+      sim::components::Name("box"));
+  ASSERT_NE(sim::kNullEntity, box);
+  auto poseComp = ecm.Component<sim::components::Pose>(box);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_EQ(boxPose, poseComp->Data());
+
+  result = false;
+  msgs::Scene sceneRes;
+  EXPECT_TRUE(node.Request("/world/default/scene/info", timeout, sceneRes,
+      result));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(4, sceneRes.model_size());
+  for (const auto &model : sceneRes.model())
+    EXPECT_NE("sphere", model.name());
+}
+
+/////////////////////////////////////////////////
+// Changes made while nobody subscribes to the state aren't merged into the
+// snapshot, so it's taken again after a subscriber reconnects
+TEST_P(SceneBroadcasterTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(StateSnapshotReconnect))
+{
+  // Start server
+  sim::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  sim::Server server(serverConfig);
+
+  math::Pose3d boxPose(1, 2, 3, 0, 0, 0);
+  bool moveBox{false};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const sim::UpdateInfo &, sim::EntityComponentManager &_ecm)
+    {
+      if (!moveBox)
+        return;
+      moveBox = false;
+      auto box = _ecm.EntityByComponents(sim::components::Model(),
+          sim::components::Name("box"));
+      _ecm.SetComponentData<sim::components::Pose>(box, boxPose);
+      _ecm.SetChanged(box, sim::components::Pose::typeId,
+          sim::ComponentState::OneTimeChange);
+    });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+
+  transport::Node node;
+  std::mutex mutex;
+  bool published{false};
+  std::function<void(const msgs::SerializedStepMap &)> stateCb =
+      [&](const msgs::SerializedStepMap &)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    published = true;
+  };
+  auto subscribe = [&]
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      published = false;
+    }
+    EXPECT_TRUE(node.Subscribe("/world/default/state", stateCb));
+    for (unsigned int sleep = 0u; sleep < 30u; ++sleep)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (published)
+          return;
+      }
+      GZ_SLEEP_MS(100);
+      server.Run(true, 1, false);
+    }
+    FAIL() << "Didn't receive the state";
+  };
+
+  // Request the state while the simulation runs, in case it's taken from
+  // the simulation
+  auto boxPoseFromService = [&]
+  {
+    bool result{false};
+    msgs::SerializedStepMap res;
+    std::atomic<bool> done{false};
+    auto requestThread = std::thread([&]
+    {
+      EXPECT_TRUE(node.Request("/world/default/state", 5000u, res, result));
+      done = true;
+    });
+    for (unsigned int sleep = 0u; !done && sleep < 30u; ++sleep)
+    {
+      GZ_SLEEP_MS(100);
+      server.Run(true, 1, false);
+    }
+    requestThread.join();
+    EXPECT_TRUE(result);
+
+    sim::EntityComponentManager ecm;
+    ecm.SetState(res.state());
+    auto box = ecm.EntityByComponents(sim::components::Model(),
+        sim::components::Name("box"));
+    auto poseComp = ecm.Component<sim::components::Pose>(box);
+    return nullptr == poseComp ? math::Pose3d::Zero : poseComp->Data();
+  };
+
+  // Take the first snapshot while subscribed
+  subscribe();
+  moveBox = true;
+  server.Run(true, 10, false);
+  EXPECT_EQ(boxPose, boxPoseFromService());
+
+  // Move the box while nobody subscribes, giving the publisher time to see
+  // that the subscriber left
+  EXPECT_TRUE(node.Unsubscribe("/world/default/state"));
+  for (int i = 0; i < 10; ++i)
+  {
+    GZ_SLEEP_MS(100);
+    server.Run(true, 1, false);
+  }
+  boxPose = math::Pose3d(4, 5, 6, 0, 0, 0);
+  moveBox = true;
+  server.Run(true, 10, false);
+  ASSERT_FALSE(moveBox);
+
+  // The new subscriber gets the latest pose, not the one of the snapshot
+  // taken before it left
+  subscribe();
+  EXPECT_EQ(boxPose, boxPoseFromService());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneBroadcasterTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(StateStatic))
 {
@@ -1101,6 +1344,110 @@ TEST_P(SceneBroadcasterTest,
   EXPECT_EQ(1, count);
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ScopedStreams))
+{
+  // Start server
+  sim::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  sim::Server server(serverConfig);
+  server.Run(true, 1, false);
+
+  transport::Node node;
+  unsigned int timeout{5000u};
+  bool result{false};
+
+  // Only the sphere
+  msgs::Param req;
+  (*req.mutable_params())["model"].set_string_value("sphere");
+  msgs::StringMsg sphereNs;
+  EXPECT_TRUE(node.Request("/world/default/interest/add", req, timeout,
+      sphereNs, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ("/world/default/interest/0", sphereNs.data());
+
+  // The sphere, and the box and cylinder which are within 3.5 m of it
+  auto size = (*req.mutable_params())["size"].mutable_vector3d_value();
+  msgs::Set(size, math::Vector3d(7, 7, 7));
+  msgs::StringMsg regionNs;
+  EXPECT_TRUE(node.Request("/world/default/interest/add", req, timeout,
+      regionNs, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ("/world/default/interest/1", regionNs.data());
+
+  // The model name is required
+  msgs::StringMsg badNs;
+  EXPECT_FALSE(node.Request("/world/default/interest/add", msgs::Param(),
+      timeout, badNs, result));
+
+  std::mutex mutex;
+  std::set<std::string> sphereNames;
+  std::set<std::string> regionNames;
+  std::size_t stateEntities{0u};
+  std::function<void(const msgs::Pose_V &)> sphereCb =
+      [&](const msgs::Pose_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &pose : _msg.pose())
+          sphereNames.insert(pose.name());
+      };
+  std::function<void(const msgs::Pose_V &)> regionCb =
+      [&](const msgs::Pose_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &pose : _msg.pose())
+          regionNames.insert(pose.name());
+      };
+  std::function<void(const msgs::SerializedStepMap &)> stateCb =
+      [&](const msgs::SerializedStepMap &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stateEntities = std::max(stateEntities,
+            static_cast<std::size_t>(_msg.state().entities_size()));
+      };
+  EXPECT_TRUE(node.Subscribe(sphereNs.data() + "/pose/info", sphereCb));
+  EXPECT_TRUE(node.Subscribe(regionNs.data() + "/pose/info", regionCb));
+  EXPECT_TRUE(node.Subscribe(sphereNs.data() + "/state", stateCb));
+
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    server.Run(true, 10, false);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!sphereNames.empty() && !regionNames.empty() && stateEntities > 0)
+      break;
+    GZ_SLEEP_MS(100);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Model, link and visual
+    EXPECT_EQ((std::set<std::string>{"sphere", "sphere_link",
+        "sphere_visual"}), sphereNames);
+    EXPECT_EQ(9u, regionNames.size());
+    EXPECT_EQ(1u, regionNames.count("box"));
+    EXPECT_EQ(1u, regionNames.count("cylinder"));
+    EXPECT_EQ(0u, regionNames.count("capsule"));
+    EXPECT_EQ(0u, regionNames.count("ellipsoid"));
+
+    // Model, link, visual and collision
+    EXPECT_EQ(4u, stateEntities);
+  }
+
+  msgs::StringMsg removeReq;
+  removeReq.set_data(regionNs.data());
+  msgs::Boolean removeRes;
+  EXPECT_TRUE(node.Request("/world/default/interest/remove", removeReq,
+      timeout, removeRes, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(removeRes.data());
+  EXPECT_TRUE(node.Request("/world/default/interest/remove", removeReq,
+      timeout, removeRes, result));
+  EXPECT_FALSE(removeRes.data());
+}
+
 // Run multiple times
 INSTANTIATE_TEST_SUITE_P(ServerRepeat, SceneBroadcasterTest,
     ::testing::Range(1, 2));
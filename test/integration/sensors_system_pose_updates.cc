@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/EventManager.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/SystemLoader.hh"
+#include "gz/sim/Types.hh"
+#include "test_config.hh"
+
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Pose.hh"
+
+#include "gz/sim/rendering/Events.hh"
+
+#include "plugins/MockSystem.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+namespace components = gz::sim::components;
+
+std::mutex g_mutex;
+rendering::ScenePtr g_scene;
+math::Pose3d g_boxPose;
+
+/////////////////////////////////////////////////
+void OnPostRender()
+{
+  if (!g_scene)
+    g_scene = rendering::sceneFromFirstRenderEngine();
+  ASSERT_TRUE(g_scene);
+
+  auto visual = g_scene->VisualByName("box");
+  ASSERT_TRUE(visual);
+  std::lock_guard<std::mutex> lock(g_mutex);
+  g_boxPose = visual->WorldPose();
+}
+
+//////////////////////////////////////////////////
+class SensorsFixture : public InternalFixture<InternalFixture<::testing::Test>>
+{
+  protected: void SetUp() override
+  {
+    InternalFixture::SetUp();
+
+    sdf::Plugin sdfPlugin;
+    sdfPlugin.SetName("gz::sim::MockSystem");
+    sdfPlugin.SetFilename("MockSystem");
+    auto plugin = sm.LoadPlugin(sdfPlugin);
+    EXPECT_TRUE(plugin.has_value());
+    this->systemPtr = plugin.value();
+    this->mockSystem = static_cast<sim::MockSystem *>(
+        systemPtr->QueryInterface<sim::System>());
+  }
+
+  public: gz::sim::SystemPluginPtr systemPtr;
+  public: sim::MockSystem *mockSystem;
+
+  private: sim::SystemLoader sm;
+};
+
+/////////////////////////////////////////////////
+/// This test checks that poses written through component pointers, without
+/// being marked as changed, still reach the sensors' scene by default
+TEST_F(SensorsFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(PoseWrittenThroughPointer))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "test", "worlds", "sensor.sdf"));
+
+  const math::Pose3d target(1, 2, 3, 0, 0, 0);
+  bool moved{false};
+  common::ConnectionPtr postRenderConn;
+  this->mockSystem->configureCallback =
+    [&](const Entity &,
+        const std::shared_ptr<const sdf::Element> &,
+        EntityComponentManager &,
+        EventManager &_eventMgr)
+    {
+      postRenderConn = _eventMgr.Connect<events::PostRender>(
+          std::bind(&::OnPostRender));
+    };
+  this->mockSystem->preUpdateCallback =
+    [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    {
+      if (moved || _info.iterations < 50)
+        return;
+
+      auto box = _ecm.EntityByComponents(components::Model(),
+          components::Name("box"));
+      ASSERT_NE(kNullEntity, box);
+      auto poseComp = _ecm.Component<components::Pose>(box);
+      ASSERT_NE(nullptr, poseComp);
+      poseComp->Data() = target;
+      moved = true;
+    };
+
+  Server server(serverConfig);
+  server.AddSystem(this->systemPtr);
+  server.Run(true, 1000, false);
+  ASSERT_TRUE(moved);
+
+  // Rendering happens on its own thread, so wait for the new pose
+  int sleep{0};
+  const int maxSleep{50};
+  math::Pose3d boxPose;
+  for (; sleep < maxSleep; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_mutex);
+      boxPose = g_boxPose;
+    }
+    if (boxPose == target)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  EXPECT_EQ(target, boxPose);
+
+  g_scene.reset();
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/math/Color.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/msgs/visual.pb.h>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include <gz/rendering/Geometry.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/EventManager.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/SystemLoader.hh"
+#include "gz/sim/Types.hh"
+#include "test_config.hh"
+
+#include "gz/sim/components/Link.hh"
+#include "gz/sim/components/Model.hh"
+#include "gz/sim/components/Name.hh"
+#include "gz/sim/components/Visual.hh"
+#include "gz/sim/components/VisualCmd.hh"
+
+#include "gz/sim/rendering/Events.hh"
+
+#include "plugins/MockSystem.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+namespace components = gz::sim::components;
+
+std::mutex g_mutex;
+rendering::ScenePtr g_scene;
+rendering::MaterialPtr g_box1Material;
+rendering::MaterialPtr g_box2Material;
+math::Color g_box1Diffuse;
+math::Color g_box2Diffuse;
+
+/////////////////////////////////////////////////
+/// \brief Find the material of the first geometry under a node.
+/// \param[in] _node Node to search.
+/// \return The material, null if there's no geometry with a material.
+rendering::MaterialPtr geometryMaterial(const rendering::NodePtr &_node)
+{
+  auto vis = std::dynamic_pointer_cast<rendering::Visual>(_node);
+  if (vis)
+  {
+    for (auto g = 0u; g < vis->GeometryCount(); ++g)
+    {
+      auto mat = vis->GeometryByIndex(g)->Material();
+      if (mat)
+        return mat;
+    }
+  }
+
+  for (auto n = 0u; _node && n < _node->ChildCount(); ++n)
+  {
+    auto mat = geometryMaterial(_node->ChildByIndex(n));
+    if (mat)
+      return mat;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void OnPostRender()
+{
+  if (!g_scene)
+    g_scene = rendering::sceneFromFirstRenderEngine();
+  ASSERT_TRUE(g_scene);
+
+  auto box1 = g_scene->VisualByName("box1");
+  auto box2 = g_scene->VisualByName("box2");
+  if (!box1 || !box2)
+    return;
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+  g_box1Material = geometryMaterial(box1);
+  g_box2Material = geometryMaterial(box2);
+  if (g_box1Material)
+    g_box1Diffuse = g_box1Material->Diffuse();
+  if (g_box2Material)
+    g_box2Diffuse = g_box2Material->Diffuse();
+}
+
+//////////////////////////////////////////////////
+class SensorsFixture : public InternalFixture<InternalFixture<::testing::Test>>
+{
+  protected: void SetUp() override
+  {
+    InternalFixture::SetUp();
+
+    sdf::Plugin sdfPlugin;
+    sdfPlugin.SetName("gz::sim::MockSystem");
+    sdfPlugin.SetFilename("MockSystem");
+    auto plugin = sm.LoadPlugin(sdfPlugin);
+    EXPECT_TRUE(plugin.has_value());
+    this->systemPtr = plugin.value();
+    this->mockSystem = static_cast<sim::MockSystem *>(
+        systemPtr->QueryInterface<sim::System>());
+  }
+
+  public: gz::sim::SystemPluginPtr systemPtr;
+  public: sim::MockSystem *mockSystem;
+
+  private: sim::SystemLoader sm;
+};
+
+/////////////////////////////////////////////////
+/// This test checks that identical visuals share a material when
+/// <share_materials> is enabled, and that changing the material of one of
+/// them doesn't change the others
+TEST_F(SensorsFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(SharedMaterialUpdate))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "test", "worlds", "shared_materials.sdf"));
+
+  const math::Color green(0, 1, 0, 1);
+  const math::Color red(1, 0, 0, 1);
+  bool commanded{false};
+  common::ConnectionPtr postRenderConn;
+  this->mockSystem->configureCallback =
+    [&](const Entity &,
+        const std::shared_ptr<const sdf::Element> &,
+        EntityComponentManager &,
+        EventManager &_eventMgr)
+    {
+      postRenderConn = _eventMgr.Connect<events::PostRender>(
+          std::bind(&::OnPostRender));
+    };
+  this->mockSystem->preUpdateCallback =
+    [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    {
+      if (commanded || _info.iterations < 500)
+        return;
+
+      // Change the color of box1 only
+      auto box1 = _ecm.EntityByComponents(components::Model(),
+          components::Name("box1"));
+      ASSERT_NE(kNullEntity, box1);
+      auto links = _ecm.ChildrenByComponents(box1, components::Link());
+      ASSERT_EQ(1u, links.size());
+      auto visuals = _ecm.ChildrenByComponents(links[0],
+          components::Visual());
+      ASSERT_EQ(1u, visuals.size());
+
+      msgs::Visual visualMsg;
+      msgs::Set(visualMsg.mutable_material()->mutable_diffuse(), red);
+      _ecm.CreateComponent(visuals[0], components::VisualCmd(visualMsg));
+      commanded = true;
+    };
+
+  Server server(serverConfig);
+  server.AddSystem(this->systemPtr);
+  server.Run(true, 400, false);
+
+  // Rendering happens on its own thread, so wait for the visuals
+  rendering::MaterialPtr box1Material;
+  rendering::MaterialPtr box2Material;
+  for (int sleep = 0; sleep < 50 && !box2Material; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::lock_guard<std::mutex> lock(g_mutex);
+    box1Material = g_box1Material;
+    box2Material = g_box2Material;
+  }
+  ASSERT_NE(nullptr, box1Material);
+  ASSERT_NE(nullptr, box2Material);
+  EXPECT_EQ(box1Material, box2Material);
+
+  server.Run(true, 600, false);
+  ASSERT_TRUE(commanded);
+
+  // box1 gets its own material, and box2 keeps the shared one
+  math::Color box1Diffuse;
+  math::Color box2Diffuse;
+  for (int sleep = 0; sleep < 50; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_mutex);
+      box1Material = g_box1Material;
+      box2Material = g_box2Material;
+      box1Diffuse = g_box1Diffuse;
+      box2Diffuse = g_box2Diffuse;
+    }
+    if (box1Diffuse == red)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  EXPECT_EQ(red, box1Diffuse);
+  EXPECT_EQ(green, box2Diffuse);
+  EXPECT_NE(box1Material, box2Material);
+
+  g_box1Material.reset();
+  g_box2Material.reset();
+  g_scene.reset();
+}
@@ -17,12 +17,18 @@
 
 #include <gtest/gtest.h>
 
+#include <gz/msgs/diagnostics.pb.h>
 #include <gz/msgs/image.pb.h>
 #include <gz/msgs/laserscan.pb.h>
 
+#include <cmath>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include <gz/common/Util.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -313,3 +319,151 @@ TEST_F(SensorsFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(UpdateRate))
     EXPECT_FLOAT_EQ(1.0 / segmentationRate, dt);
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(SensorsFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(Asynchronous))
+{
+  const std::string sdfFile =
+    common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+    "test", "worlds", "sensor.sdf");
+
+  // Let simulation run up to 20 iterations ahead of the sensors
+  const uint64_t maxLagSteps = 20u;
+  std::string sdfString = common::readFile(sdfFile);
+  const std::string renderEngine = "<render_engine>ogre2</render_engine>";
+  auto pos = sdfString.find(renderEngine);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.insert(pos + renderEngine.size(),
+      "<asynchronous>true</asynchronous><max_lag_steps>" +
+      std::to_string(maxLagSteps) + "</max_lag_steps>");
+
+  gz::sim::ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+
+  sim::Server server(serverConfig);
+
+  std::mutex mutex;
+  std::vector<double> imageTimestamps;
+  auto cameraCb = std::function<void(const msgs::Image &)>(
+      [&](const auto &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        imageTimestamps.push_back(_msg.header().stamp().sec() +
+            _msg.header().stamp().nsec() * 1e-9);
+      });
+  transport::Node node;
+  node.Subscribe(std::string("/world/camera_sensor/model/default_topics/") +
+      "link/camera_link/sensor/camera/image", cameraCb);
+
+  const unsigned int iterations = 2000u;
+  server.Run(true, iterations, false);
+
+  unsigned int sleep = 0;
+  unsigned int maxSleep = 30;
+  while (sleep++ < maxSleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!imageTimestamps.empty() && imageTimestamps.back() >= 1.9)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_FALSE(imageTimestamps.empty());
+
+  // Images are stamped with the time of the snapshot they were rendered
+  // from, which is a simulation step, and never go back in time
+  const double stepSize = 0.001;
+  for (unsigned int i = 0; i < imageTimestamps.size(); ++i)
+  {
+    EXPECT_NEAR(0.0, std::remainder(imageTimestamps[i], stepSize), 1e-6);
+    if (i > 0)
+    {
+      EXPECT_LT(imageTimestamps[i-1], imageTimestamps[i]);
+      // The camera updates at 30 Hz, and it's never delayed past the lag
+      EXPECT_LE(imageTimestamps[i] - imageTimestamps[i-1],
+          1.0 / 30 + (maxLagSteps + 1) * stepSize);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorsFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(RenderCost))
+{
+  const std::string sdfFile =
+    common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+    "test", "worlds", "sensor.sdf");
+
+  std::string sdfString = common::readFile(sdfFile);
+  const std::string renderEngine = "<render_engine>ogre2</render_engine>";
+  auto pos = sdfString.find(renderEngine);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.insert(pos + renderEngine.size(),
+      "<camera_pass_count_per_gpu_flush>2</camera_pass_count_per_gpu_flush>");
+
+  gz::sim::ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+
+  sim::Server server(serverConfig);
+
+  std::mutex mutex;
+  std::vector<msgs::Diagnostics> costMsgs;
+  auto costCb = std::function<void(const msgs::Diagnostics &)>(
+      [&](const auto &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        costMsgs.push_back(_msg);
+      });
+  transport::Node node;
+  node.Subscribe("/world/camera_sensor/sensors/render_cost", costCb);
+
+  // The world runs in real time, and the cost is reported once per second
+  server.Run(true, 3000u, false);
+
+  unsigned int sleep = 0;
+  unsigned int maxSleep = 30;
+  while (sleep++ < maxSleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!costMsgs.empty())
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  // The camera pass batching is configured on the scene
+  auto scene = rendering::sceneFromFirstRenderEngine();
+  ASSERT_NE(nullptr, scene);
+  EXPECT_EQ(2u, scene->CameraPassCountPerGpuFlush());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_FALSE(costMsgs.empty());
+
+  bool foundCamera = false;
+  for (const auto &msg : costMsgs)
+  {
+    EXPECT_LT(0, msg.real_time().sec() * 1e9 + msg.real_time().nsec());
+    for (const auto &cost : msg.time())
+    {
+      // The average frame is never longer than the longest one
+      const double average =
+          cost.elapsed().sec() + cost.elapsed().nsec() * 1e-9;
+      const double longest = cost.wall().sec() + cost.wall().nsec() * 1e-9;
+      EXPECT_LT(0.0, average) << cost.name();
+      EXPECT_LE(average, longest) << cost.name();
+
+      const std::string suffix{"camera_link::camera"};
+      const std::string &name = cost.name();
+      if (name.size() >= suffix.size() &&
+          name.compare(name.size() - suffix.size(), suffix.size(),
+          suffix) == 0)
+      {
+        foundCamera = true;
+      }
+    }
+  }
+  EXPECT_TRUE(foundCamera);
+}
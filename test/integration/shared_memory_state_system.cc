@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/Server.hh"
+#include "gz/sim/SharedStateRegion.hh"
+#include "test_config.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test SharedMemoryState system
+class SharedMemoryStateTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryStateTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Frame))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shared_memory_state.sdf");
+
+  Server server(serverConfig);
+  server.Run(true, 100u, false);
+
+  auto region = SharedStateRegion::Open("/gz_sim_state_shared_memory_state");
+  ASSERT_NE(nullptr, region);
+  EXPECT_EQ(16u, region->MaxEntities());
+
+  SharedStateFrame frame;
+  ASSERT_TRUE(region->Read(frame));
+  EXPECT_EQ(100u, frame.iterations);
+  EXPECT_EQ(region->Sequence(), frame.sequence);
+
+  // 2 models, 3 links and a joint
+  ASSERT_EQ(6u, frame.entities.size());
+  auto find = [&](const char *_name) -> const SharedStateEntity *
+  {
+    for (const auto &entity : frame.entities)
+    {
+      if (std::strcmp(entity.name, _name) == 0)
+        return &entity;
+    }
+    return nullptr;
+  };
+
+  // The box fell for 0.1 s
+  const auto *box = find("falling_box");
+  const auto *link = find("link");
+  ASSERT_NE(nullptr, box);
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(SharedStateEntityType::Model, box->type);
+  EXPECT_EQ(SharedStateEntityType::Link, link->type);
+  EXPECT_EQ(box->entity, link->parent);
+  EXPECT_NEAR(9.95, link->pose[2], 0.01);
+  EXPECT_NEAR(link->pose[2], box->pose[2], 1e-9);
+  EXPECT_NEAR(1.0, link->pose[3], 1e-6);
+  EXPECT_NEAR(-1.0, link->linearVelocity[2], 0.02);
+
+  const auto *hinge = find("hinge");
+  ASSERT_NE(nullptr, hinge);
+  EXPECT_EQ(SharedStateEntityType::Joint, hinge->type);
+  ASSERT_EQ(1u, hinge->jointDofs);
+  ASSERT_EQ(2u, frame.jointValues.size());
+  EXPECT_NEAR(0.0, frame.jointValues[hinge->jointOffset], 1e-3);
+
+  // Paused steps don't write new frames
+  const auto sequence = region->Sequence();
+  server.RunOnce(true);
+  EXPECT_EQ(sequence, region->Sequence());
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/param.pb.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/Server.hh"
+#include "test_config.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test state hashing
+class StateHashTest : public InternalFixture<::testing::Test>
+{
+  /// \brief Run the falling box world and collect the published hashes.
+  /// \param[in] _iterations Number of iterations to run.
+  /// \return Last hash message of each iteration.
+  protected: std::map<uint64_t, msgs::Param> Run(unsigned int _iterations)
+  {
+    ServerConfig serverConfig;
+    serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+        "/test/worlds/world_energy_monitor.sdf");
+    serverConfig.SetStateHashing(true);
+    Server server(serverConfig);
+
+    std::mutex mutex;
+    std::map<uint64_t, msgs::Param> hashes;
+    std::function<void(const msgs::Param &)> cb =
+        [&](const msgs::Param &_msg)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          const auto iterations = static_cast<uint64_t>(
+              _msg.params().at("iterations").double_value());
+          hashes[iterations] = _msg;
+        };
+    transport::Node node;
+    node.Subscribe("/world/world_energy_monitor/state_hash", cb);
+
+    // Hashes are only computed once there's a subscriber
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    server.Run(true, _iterations, false);
+
+    for (int sleep = 0; sleep < 30; ++sleep)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hashes.count(_iterations) > 0u)
+          break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    return hashes;
+  }
+};
+
+/////////////////////////////////////////////////
+// Two runs of the same world have the same state at every step, and the
+// hashes tell which model and component types changed
+TEST_F(StateHashTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Reproducible))
+{
+  const auto first = this->Run(100u);
+  const auto second = this->Run(100u);
+  ASSERT_EQ(1u, first.count(100u));
+  ASSERT_EQ(1u, second.count(100u));
+
+  std::size_t compared{0u};
+  for (const auto &[iterations, msg] : first)
+  {
+    auto it = second.find(iterations);
+    if (it == second.end())
+      continue;
+    EXPECT_EQ(msg.params().at("total").string_value(),
+        it->second.params().at("total").string_value()) << iterations;
+    ++compared;
+  }
+  EXPECT_LT(50u, compared);
+
+  const auto &early = first.begin()->second.params();
+  const auto &late = first.at(100u).params();
+  ASSERT_EQ(1u, late.count("entity/falling_box"));
+  ASSERT_EQ(1u, late.count("type/gz_sim_components.Pose"));
+  ASSERT_EQ(1u, late.count("type/gz_sim_components.Name"));
+  EXPECT_EQ(16u, late.at("total").string_value().size());
+
+  // The box falls, but its name stays the same
+  EXPECT_NE(early.at("entity/falling_box").string_value(),
+      late.at("entity/falling_box").string_value());
+  EXPECT_EQ(early.at("type/gz_sim_components.Name").string_value(),
+      late.at("type/gz_sim_components.Name").string_value());
+}
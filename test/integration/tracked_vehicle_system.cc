@@ -705,3 +705,73 @@ TEST_F(TrackedVehicleTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Conveyor))
     "/model/conveyor/link/base_link/track_cmd_vel",
     "/model/conveyor/link/base_link/odometry");
 }
+
+/////////////////////////////////////////////////
+TEST_F(TrackedVehicleTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TwoConveyors))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/conveyors.sdf");
+
+  Server server(serverConfig);
+
+  test::Relay ecmGetterSystem;
+  EntityComponentManager* ecm {nullptr};
+  ecmGetterSystem.OnPreUpdate([&ecm](const UpdateInfo &,
+    EntityComponentManager &_ecm)
+    {
+      if (ecm == nullptr)
+        ecm = &_ecm;
+    });
+  server.AddSystem(ecmGetterSystem.systemPtr);
+  server.Run(true, 1, false);
+
+  ASSERT_NE(nullptr, ecm);
+  bool shouldSkipTest = false;
+  this->SkipTestIfNotSupported(*ecm, shouldSkipTest);
+  if (shouldSkipTest)
+  {
+    GTEST_SKIP() << "Skipping test because physics engine does not support "
+      "SetContactPropertiesCallbackFeature";
+  }
+
+  // Each track receives the contacts of both conveyors
+  test::Relay testSystem;
+  math::Pose3d boxPose;
+  math::Pose3d box2Pose;
+  testSystem.OnPostUpdate([&](const UpdateInfo &,
+    const EntityComponentManager &_ecm)
+    {
+      auto boxEntity = _ecm.EntityByComponents(
+        components::Model(), components::Name("box"));
+      auto box2Entity = _ecm.EntityByComponents(
+        components::Model(), components::Name("box_2"));
+      ASSERT_NE(kNullEntity, boxEntity);
+      ASSERT_NE(kNullEntity, box2Entity);
+      boxPose = _ecm.Component<components::Pose>(boxEntity)->Data();
+      box2Pose = _ecm.Component<components::Pose>(box2Entity)->Data();
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  // Let the boxes fall on the conveyors
+  server.Run(true, 1000, false);
+  const auto box2Start = box2Pose;
+
+  // Only the first conveyor is commanded
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Double>(
+      "/model/conveyor/link/base_link/track_cmd_vel");
+  msgs::Double msg;
+  msg.set_data(1.0);
+  pub.Publish(msg);
+
+  server.Run(true, 2000, false);
+
+  // The box on the first conveyor moves as in the Conveyor test, and the
+  // other one stays in place
+  EXPECT_NEAR(0.5, boxPose.Pos().X(), 1e-1);
+  EXPECT_NEAR(0.0, boxPose.Pos().Y(), 1e-2);
+  EXPECT_NEAR(box2Start.Pos().X(), box2Pose.Pos().X(), 1e-6);
+  EXPECT_NEAR(box2Start.Pos().Y(), box2Pose.Pos().Y(), 1e-6);
+  EXPECT_ANGLE_NEAR(box2Pose.Rot().Yaw(), 0, 1e-3);
+}
@@ -353,6 +353,44 @@ TEST_F(TriggeredPublisherTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(FieldMatchers))
   EXPECT_EQ(9u, recvCount[1]);
 }
 
+/////////////////////////////////////////////////
+TEST_F(TriggeredPublisherTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(FieldRangeMatchers))
+{
+  transport::Node node;
+  auto inputPub = node.Advertise<msgs::Vector2d>("/in_20");
+  std::atomic<std::size_t> recvCount[2]{0, 0};
+
+  auto cbCreator = [](std::atomic<std::size_t> &_counter)
+  {
+    return std::function<void(const msgs::Empty &)>(
+        [&_counter](const msgs::Empty &)
+        {
+          ++_counter;
+        });
+  };
+
+  auto msgCb0 = cbCreator(recvCount[0]);
+  auto msgCb1 = cbCreator(recvCount[1]);
+  node.Subscribe("/out_20_0", msgCb0);
+  node.Subscribe("/out_20_1", msgCb1);
+
+  const int pubCount{10};
+  msgs::Vector2d msg;
+  for (int i = 0; i < pubCount; ++i)
+  {
+    msg.set_x(static_cast<double>(i));
+    msg.set_y(i % 2 == 0 ? 1.0 : -1.0);
+    EXPECT_TRUE(inputPub.Publish(msg));
+    GZ_SLEEP_MS(10);
+  }
+
+  // The first plugin matches 2<=x<=5 and y>=0, which are x = 2 and x = 4
+  EXPECT_EQ(2u, recvCount[0]);
+  // The second plugin matches x>7, which are x = 8 and x = 9
+  EXPECT_EQ(2u, recvCount[1]);
+}
+
 /////////////////////////////////////////////////
 /// Tests that if the specified field is a repeated field, a partial match is
 /// used when comparing against the input.
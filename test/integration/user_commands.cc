@@ -15,18 +15,24 @@
  *
  */
 
+#include <functional>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/entity.pb.h>
 #include <gz/msgs/entity_factory.pb.h>
+#include <gz/msgs/entity_factory_v.pb.h>
 #include <gz/msgs/light.pb.h>
 #include <gz/msgs/material_color.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/physics.pb.h>
 #include <gz/msgs/pose.pb.h>
 #include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/stringmsg_v.pb.h>
 #include <gz/msgs/visual.pb.h>
 #include <gz/msgs/wheel_slip_parameters_cmd.pb.h>
 
@@ -530,6 +536,184 @@ TEST_F(UserCommandsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Remove))
   EXPECT_EQ(kNullEntity, ecm->EntityByComponents(components::Name("sun")));
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCommandsTest,
+       GZ_UTILS_TEST_DISABLED_ON_WIN32(CreateAndRemoveMultiple))
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/shapes.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const UpdateInfo &,
+                             EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+      });
+
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(nullptr, ecm);
+  EXPECT_EQ(25u, ecm->EntityCount());
+
+  // Many copies of the same model, with different poses
+  const std::string modelStr = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+<model name="crate">
+  <link name="link"/>
+</model>
+</sdf>)";
+
+  msgs::EntityFactory_V req;
+  for (int i = 0; i < 10; ++i)
+  {
+    auto factory = req.add_data();
+    factory->set_sdf(modelStr);
+    factory->set_allow_renaming(true);
+    msgs::Set(factory->mutable_pose(), math::Pose3d(i, 0, 0, 0, 0, 0));
+  }
+  // Names can't clash with existing entities
+  req.mutable_data(9)->set_name("box");
+  req.mutable_data(9)->set_allow_renaming(false);
+
+  msgs::Boolean res;
+  bool result;
+  unsigned int timeout = 5000;
+  transport::Node node;
+  EXPECT_TRUE(node.Request("/world/default/create_multiple", req, timeout,
+      res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  // All entities are created in the same iteration
+  server.Run(true, 1, false);
+  EXPECT_EQ(25u + 9u * 2u, ecm->EntityCount());
+
+  std::vector<std::string> names{"crate"};
+  for (int i = 0; i < 8; ++i)
+    names.push_back("crate_" + std::to_string(i));
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    auto entity = ecm->EntityByComponents(components::Model(),
+        components::Name(names[i]));
+    ASSERT_NE(kNullEntity, entity) << names[i];
+    auto poseComp = ecm->Component<components::Pose>(entity);
+    ASSERT_NE(nullptr, poseComp);
+    EXPECT_DOUBLE_EQ(static_cast<double>(i), poseComp->Data().Pos().X());
+  }
+
+  // Remove some of them, with a name which doesn't exist
+  msgs::StringMsg_V removeReq;
+  removeReq.add_data("crate");
+  removeReq.add_data("crate_3");
+  removeReq.add_data("not_a_model");
+  EXPECT_TRUE(node.Request("/world/default/remove_multiple", removeReq,
+      timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  server.Run(true, 1, false);
+  EXPECT_EQ(25u + 7u * 2u, ecm->EntityCount());
+  EXPECT_EQ(kNullEntity, ecm->EntityByComponents(components::Model(),
+      components::Name("crate")));
+  EXPECT_EQ(kNullEntity, ecm->EntityByComponents(components::Model(),
+      components::Name("crate_3")));
+  EXPECT_NE(kNullEntity, ecm->EntityByComponents(components::Model(),
+      components::Name("crate_4")));
+}
+
+/////////////////////////////////////////////////
+TEST_F(UserCommandsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Prototype))
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/shapes.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const UpdateInfo &,
+                             EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+      });
+
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(nullptr, ecm);
+  EXPECT_EQ(25u, ecm->EntityCount());
+
+  msgs::EntityFactory registerReq;
+  registerReq.set_name("crate_prototype");
+  registerReq.set_sdf(R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+<model name="crate">
+  <link name="link"/>
+</model>
+</sdf>)");
+
+  msgs::Boolean res;
+  bool result;
+  unsigned int timeout = 5000;
+  transport::Node node;
+  EXPECT_TRUE(node.Request("/world/default/register_prototype", registerReq,
+      timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  // Instances with and without names, in the same request as the
+  // registration is processed
+  msgs::Pose_V spawnReq;
+  auto data = spawnReq.mutable_header()->add_data();
+  data->set_key("prototype");
+  data->add_value("crate_prototype");
+  auto pose = spawnReq.add_pose();
+  msgs::Set(pose, math::Pose3d(1, 2, 3, 0, 0, 0));
+  pose->set_name("first");
+  pose = spawnReq.add_pose();
+  msgs::Set(pose, math::Pose3d(4, 5, 6, 0, 0, 0));
+  // A name which is taken
+  pose = spawnReq.add_pose();
+  pose->set_name("box");
+
+  EXPECT_TRUE(node.Request("/world/default/spawn_prototype", spawnReq,
+      timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  server.Run(true, 1, false);
+  EXPECT_EQ(25u + 2u * 2u, ecm->EntityCount());
+
+  auto first = ecm->EntityByComponents(components::Model(),
+      components::Name("first"));
+  ASSERT_NE(kNullEntity, first);
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0),
+      ecm->Component<components::Pose>(first)->Data());
+
+  auto second = ecm->EntityByComponents(components::Model(),
+      components::Name("crate_prototype_0"));
+  ASSERT_NE(kNullEntity, second);
+  EXPECT_EQ(math::Pose3d(4, 5, 6, 0, 0, 0),
+      ecm->Component<components::Pose>(second)->Data());
+
+  // Unknown prototypes don't spawn anything
+  data->set_value(0, "unknown");
+  EXPECT_TRUE(node.Request("/world/default/spawn_prototype", spawnReq,
+      timeout, res, result));
+  server.Run(true, 1, false);
+  EXPECT_EQ(25u + 2u * 2u, ecm->EntityCount());
+}
+
 /////////////////////////////////////////////////
 TEST_F(UserCommandsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Pose))
 {
@@ -776,6 +960,130 @@ TEST_F(UserCommandsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(PoseVector))
   poseComp = ecm->Component<components::Pose>(sphereEntity);
   ASSERT_NE(nullptr, poseComp);
   EXPECT_NEAR(456, poseComp->Data().Pos().Y(), 0.2);
+
+  // Commands queued for the same entity before an iteration are coalesced,
+  // and only the latest one is applied
+  poseBoxMsg->mutable_position()->set_y(10.0);
+  poseSphereMsg->mutable_position()->set_y(20.0);
+  EXPECT_TRUE(node.Request(service, req, timeout, res, result));
+
+  msgs::Pose poseReq;
+  poseReq.set_name("box");
+  poseReq.mutable_position()->set_y(30.0);
+  EXPECT_TRUE(node.Request("/world/default/set_pose", poseReq, timeout, res,
+      result));
+
+  server.Run(true, 1, false);
+
+  poseComp = ecm->Component<components::Pose>(boxEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(30.0, poseComp->Data().Pos().Y(), 0.2);
+
+  poseComp = ecm->Component<components::Pose>(sphereEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(20.0, poseComp->Data().Pos().Y(), 0.2);
+}
+
+/////////////////////////////////////////////////
+TEST_F(UserCommandsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(CoalescedStats))
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/shapes.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+
+  // Create a system just to get the ECM
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const UpdateInfo &,
+                             EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(nullptr, ecm);
+
+  std::mutex mutex;
+  msgs::Param stats;
+  std::function<void(const msgs::Param &)> statsCb =
+      [&](const msgs::Param &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = _msg;
+  };
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe("/world/default/user_commands/stats", statsCb));
+
+  msgs::Boolean res;
+  bool result;
+  unsigned int timeout = 5000;
+
+  // All these box poses are replaced by the pose vector
+  msgs::Pose poseReq;
+  poseReq.set_name("box");
+  for (int i = 0; i < 5; ++i)
+  {
+    poseReq.mutable_position()->set_y(i);
+    EXPECT_TRUE(node.Request("/world/default/set_pose", poseReq, timeout,
+        res, result));
+    EXPECT_TRUE(result);
+  }
+
+  msgs::Pose_V vectorReq;
+  auto poseBoxMsg = vectorReq.add_pose();
+  poseBoxMsg->set_name("box");
+  poseBoxMsg->mutable_position()->set_y(10.0);
+  auto poseSphereMsg = vectorReq.add_pose();
+  poseSphereMsg->set_name("sphere");
+  poseSphereMsg->mutable_position()->set_y(20.0);
+  EXPECT_TRUE(node.Request("/world/default/set_pose_vector", vectorReq,
+      timeout, res, result));
+  EXPECT_TRUE(result);
+
+  // And the sphere pose of the vector is replaced by this one
+  poseReq.set_name("sphere");
+  poseReq.mutable_position()->set_y(30.0);
+  EXPECT_TRUE(node.Request("/world/default/set_pose", poseReq, timeout, res,
+      result));
+  EXPECT_TRUE(result);
+
+  server.Run(true, 1, false);
+
+  auto boxEntity = ecm->EntityByComponents(components::Name("box"));
+  auto poseComp = ecm->Component<components::Pose>(boxEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(10.0, poseComp->Data().Pos().Y(), 0.2);
+
+  auto sphereEntity = ecm->EntityByComponents(components::Name("sphere"));
+  poseComp = ecm->Component<components::Pose>(sphereEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(30.0, poseComp->Data().Pos().Y(), 0.2);
+
+  // Statistics are published at most once per second
+  auto count = [&](const std::string &_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = stats.params().find(_name);
+    if (it == stats.params().end())
+      return -1.0;
+    EXPECT_EQ(msgs::Any::DOUBLE, it->second.type());
+    return it->second.double_value();
+  };
+  int sleep{0};
+  const int maxSleep{30};
+  for (; count("executed") < 2.0 && sleep < maxSleep; ++sleep)
+  {
+    GZ_SLEEP_MS(100);
+    server.Run(true, 1, false);
+  }
+  EXPECT_DOUBLE_EQ(2.0, count("executed"));
+  EXPECT_DOUBLE_EQ(0.0, count("failed"));
+  EXPECT_DOUBLE_EQ(6.0, count("coalesced"));
+  EXPECT_DOUBLE_EQ(0.0, count("pending"));
 }
 
 /////////////////////////////////////////////////
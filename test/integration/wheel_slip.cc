@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <gz/msgs/entity_factory.pb.h>
 
 #include <gz/common/Console.hh>
@@ -583,3 +588,160 @@ TEST_F(WheelSlipTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TricyclesUphill))
       noSlipLinearSpeed * forceRatio, 5e-3);
 #endif
 }
+
+/////////////////////////////////////////////////
+// Slip compliance commands stay in effect until they're changed
+TEST_F(WheelSlipTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SlipCompliancePersists))
+{
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='slip_compliance'>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'/>"
+      << "<model name='ground'><static>true</static><link name='link'>"
+      << "<collision name='collision'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>100 100</size></plane>"
+      << "</geometry></collision></link></model>"
+      << "<model name='ball'><pose>0 0 0.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<sphere><radius>0.5</radius></sphere>"
+      << "</geometry></collision></link></model>"
+      << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdf.str());
+
+  Server server(serverConfig);
+
+  std::vector<double> command{0.1, 0.2};
+  bool sendCommand{false};
+  std::vector<std::vector<double>> slips;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const UpdateInfo &,
+        EntityComponentManager &_ecm)
+      {
+        if (!sendCommand)
+          return;
+        sendCommand = false;
+
+        auto ball = _ecm.EntityByComponents(components::Model(),
+            components::Name("ball"));
+        auto link = _ecm.EntityByComponents(components::ParentEntity(ball),
+            components::Link());
+        auto collision = _ecm.EntityByComponents(
+            components::ParentEntity(link), components::Collision());
+        ASSERT_NE(kNullEntity, collision);
+        _ecm.SetComponentData<components::SlipComplianceCmd>(collision,
+            command);
+      });
+  testSystem.OnPostUpdate([&](const UpdateInfo &,
+        const EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::SlipComplianceCmd>(
+            [&](const Entity &, const components::SlipComplianceCmd *_slip)
+            {
+              slips.push_back(_slip->Data());
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  EXPECT_TRUE(slips.empty());
+
+  // The physics system no longer zeroes the command after each step
+  sendCommand = true;
+  server.Run(true, 100, false);
+  ASSERT_EQ(100u, slips.size());
+  for (const auto &slip : slips)
+    EXPECT_EQ(command, slip);
+
+  // Changing the command replaces it
+  slips.clear();
+  command = {0.3, 0.4};
+  sendCommand = true;
+  server.Run(true, 10, false);
+  ASSERT_EQ(10u, slips.size());
+  for (const auto &slip : slips)
+    EXPECT_EQ(command, slip);
+}
+
+/////////////////////////////////////////////////
+// The slip is only written when it changes by more than <slip_tolerance>
+TEST_F(WheelSlipTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SlipTolerance))
+{
+  // Count how often the slip of a wheel whose speed ramps up is written
+  auto countSlipWrites = [](const std::string &_tolerance)
+  {
+    std::ifstream file(common::joinPaths(PROJECT_SOURCE_PATH, "test",
+        "worlds", "trisphere_cycle_wheel_slip.sdf"));
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string sdf = buffer.str();
+
+    // Set the tolerance of the second model, whose wheels slip
+    if (!_tolerance.empty())
+    {
+      const std::string plugin{"name=\"gz::sim::systems::WheelSlip\">"};
+      auto pos = sdf.find(plugin, sdf.find(plugin) + 1);
+      EXPECT_NE(std::string::npos, pos);
+      sdf.insert(pos + plugin.size(),
+          "<slip_tolerance>" + _tolerance + "</slip_tolerance>");
+    }
+
+    ServerConfig serverConfig;
+    serverConfig.SetSdfString(sdf);
+    Server server(serverConfig);
+
+    Entity spinJoint{kNullEntity};
+    Entity wheelCollision{kNullEntity};
+    std::vector<double> lastSlip;
+    int writes{0};
+    test::Relay testSystem;
+    testSystem.OnPreUpdate([&](const UpdateInfo &,
+          EntityComponentManager &_ecm)
+        {
+          if (kNullEntity == spinJoint)
+          {
+            auto model = _ecm.EntityByComponents(components::Model(),
+                components::Name("trisphere_cycle1"));
+            spinJoint = _ecm.EntityByComponents(
+                components::ParentEntity(model),
+                components::Name("wheel_rear_left_spin"),
+                components::Joint());
+            auto wheel = _ecm.EntityByComponents(
+                components::ParentEntity(model),
+                components::Name("wheel_rear_left"), components::Link());
+            wheelCollision = _ecm.EntityByComponents(
+                components::ParentEntity(wheel), components::Collision());
+          }
+          _ecm.SetComponentData<components::JointVelocityCmd>(spinJoint,
+              {6.0});
+        });
+    testSystem.OnPostUpdate([&](const UpdateInfo &,
+          const EntityComponentManager &_ecm)
+        {
+          auto slip = _ecm.Component<components::SlipComplianceCmd>(
+              wheelCollision);
+          if (slip && slip->Data() != lastSlip)
+          {
+            lastSlip = slip->Data();
+            ++writes;
+          }
+        });
+    server.AddSystem(testSystem.systemPtr);
+    server.Run(true, 500, false);
+    EXPECT_NE(kNullEntity, wheelCollision);
+    return writes;
+  };
+
+  // By default, the slip follows the wheel speed
+  const int defaultWrites = countSlipWrites("");
+  EXPECT_LT(10, defaultWrites);
+
+  // Slips of the same sign are all within a relative tolerance of 1, so the
+  // command is only written again if the wheel changes direction
+  const int tolerantWrites = countSlipWrites("1.0");
+  EXPECT_LE(1, tolerantWrites);
+  EXPECT_LT(tolerantWrites * 5, defaultWrites);
+}
@@ -422,3 +422,40 @@ TEST_F(WindEffectsTest,
   this->server->Run(true, 10, false);
   ASSERT_FALSE(linkVelocityComponent.values.empty());
 }
+
+////////////////////////////////////////////////
+TEST_F(WindEffectsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(WindField))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", "worlds", "wind_field.sdf"));
+  this->server = std::make_unique<Server>(serverConfig);
+
+  LinkComponentRecorder<components::WorldLinearVelocity> inFieldVelocities(
+      "in_field_link", true);
+  LinkComponentRecorder<components::WorldLinearVelocity> outOfFieldVelocities(
+      "out_of_field_link", true);
+
+  using namespace std::chrono_literals;
+  this->server->SetUpdatePeriod(0ns);
+
+  this->server->AddSystem(inFieldVelocities.systemPtr);
+  this->server->AddSystem(outOfFieldVelocities.systemPtr);
+
+  // Without global wind, only the link within the data is pushed by the
+  // wind of the field, along x.
+  const std::size_t nIters{1000};
+  this->server->Run(true, nIters, false);
+
+  ASSERT_EQ(nIters, inFieldVelocities.values.size());
+  ASSERT_EQ(nIters, outOfFieldVelocities.values.size());
+
+  const auto &inFieldVel = inFieldVelocities.values.back().Data();
+  EXPECT_LT(1.0, inFieldVel.X());
+  EXPECT_GT(5.0, inFieldVel.X());
+  EXPECT_NEAR(0.0, inFieldVel.Y(), 1e-6);
+  EXPECT_NEAR(0.0, inFieldVel.Z(), 1e-6);
+
+  for (const auto &vel : outOfFieldVelocities.values)
+    EXPECT_NEAR(0.0, vel.Data().Length(), 1e-6);
+}
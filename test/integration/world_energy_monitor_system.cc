@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/param.pb.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/Server.hh"
+#include "test_config.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace gz;
+using namespace sim;
+
+/// \brief Test WorldEnergyMonitor system
+class WorldEnergyMonitorTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+// A box falls freely for one second, so potential energy turns into kinetic
+// energy while the total stays the same
+TEST_F(WorldEnergyMonitorTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(FreeFall))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/world_energy_monitor.sdf");
+
+  Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+
+  std::mutex mutex;
+  std::vector<msgs::Param> msgs;
+  std::function<void(const msgs::Param &)> cb =
+      [&](const msgs::Param &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        msgs.push_back(_msg);
+      };
+  transport::Node node;
+  node.Subscribe("/world/world_energy_monitor/energy", cb);
+
+  // Published at iterations 500 and 1000
+  server.Run(true, 1000u, false);
+
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (msgs.size() >= 2u)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(2u, msgs.size());
+
+  auto value = [](const msgs::Param &_msg, const std::string &_name)
+  {
+    return _msg.params().at(_name);
+  };
+
+  // Free fall from rest: after t seconds the box moves at g t and its
+  // kinetic energy is m (g t)^2 / 2
+  const double mass{2.0};
+  const double gravity{10.0};
+  for (std::size_t i = 0; i < msgs.size(); ++i)
+  {
+    const auto &msg = msgs[i];
+    const double time = 0.5 * static_cast<double>(i + 1);
+    const double speed = gravity * time;
+    EXPECT_EQ(1, value(msg, "links").int_value());
+    EXPECT_NEAR(0.5 * mass * speed * speed,
+        value(msg, "kinetic_energy").double_value(), 0.5);
+
+    // The total stays at the potential energy the box started with
+    EXPECT_NEAR(mass * gravity * 10.0,
+        value(msg, "energy").double_value(), 0.5);
+
+    const auto momentum =
+        msgs::Convert(value(msg, "linear_momentum").vector3d_value());
+    EXPECT_NEAR(0.0, momentum.X(), 1e-6);
+    EXPECT_NEAR(0.0, momentum.Y(), 1e-6);
+    EXPECT_NEAR(-mass * speed, momentum.Z(), 0.1);
+  }
+}
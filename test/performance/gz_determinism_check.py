@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+
+# Run a world twice with different numbers of threads and check that the
+# ECM state is the same after every step.
+#
+# Example, from the build directory:
+#
+#   gz_determinism_check.py --runner ./bin/PERFORMANCE_state_hasher \
+#     --threads 1,8 --iterations 2000 world.sdf
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def int_list(text):
+    return [int(v) for v in text.split(',')]
+
+
+def run(runner, world, iterations, threads, workdir, verbose=False):
+    path = os.path.join(workdir, f'hashes_{threads}.txt')
+    env = dict(os.environ, GZ_SIM_THREADS=str(threads))
+    subprocess.run(
+        [runner, world, str(iterations), path], env=env, check=True,
+        stdout=subprocess.DEVNULL if not verbose else None,
+        stderr=subprocess.DEVNULL if not verbose else None)
+
+    hashes = []
+    with open(path) as f:
+        for line in f:
+            iteration, value = line.split()
+            hashes.append((int(iteration), value))
+    return hashes
+
+
+def first_difference(reference, other):
+    for (a, b) in zip(reference, other):
+        if a != b:
+            return a[0]
+    if len(reference) != len(other):
+        longer = reference if len(reference) > len(other) else other
+        return longer[min(len(reference), len(other))][0]
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Check that a world steps the same with any number of '
+                    'threads')
+    parser.add_argument('world', help='SDF file to run')
+    parser.add_argument('--runner', required=True,
+                        help='path to the PERFORMANCE_state_hasher')
+    parser.add_argument('--threads', type=int_list, default=[1, 4],
+                        help='comma-separated numbers of threads to compare')
+    parser.add_argument('--iterations', type=int, default=1000)
+    parser.add_argument('--verbose', action='store_true')
+    args = parser.parse_args()
+
+    if len(args.threads) < 2:
+        print('Give at least two numbers of threads', file=sys.stderr)
+        return 2
+
+    with tempfile.TemporaryDirectory() as workdir:
+        runs = [(threads, run(args.runner, args.world, args.iterations,
+                              threads, workdir, args.verbose))
+                for threads in args.threads]
+
+    reference_threads, reference = runs[0]
+    if not reference:
+        print('The runner wrote no hashes', file=sys.stderr)
+        return 2
+
+    failed = False
+    for (threads, hashes) in runs[1:]:
+        iteration = first_difference(reference, hashes)
+        if iteration is None:
+            print(f'{threads} threads: {len(hashes)} steps identical to '
+                  f'{reference_threads} threads')
+        else:
+            print(f'{threads} threads: state differs from '
+                  f'{reference_threads} threads at iteration {iteration}')
+            failed = True
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -4,8 +4,6 @@ import argparse
 import numpy as np
 import csv
 
-import matplotlib.pyplot as plt
-
 def read_data(filename):
     header = []
     entries = []
@@ -69,6 +67,9 @@ if __name__ == '__main__':
         print(f'  Sim Time:  {mx_sim:0.5f}')
         print(f'  Real Time: {mx_real:0.5f}')
 
+    if args.plot or args.hist:
+        import matplotlib.pyplot as plt
+
     if args.plot:
         plt.figure()
         plt.plot(sim_time[:-1], rtfs)
@@ -85,5 +86,5 @@ if __name__ == '__main__':
         plt.ylabel('Iteration Count')
         plt.grid(True)
 
-
-    plt.show()
+    if args.plot or args.hist:
+        plt.show()
@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+
+# Run the benchmarks and the scalable worlds, store the results keyed by
+# commit, and compare them against a baseline.
+#
+# Examples, from the build directory:
+#
+#   # Record the results of the current commit in perf_results/<commit>.json
+#   gz_perf_regression.py run --bin-dir ./bin
+#
+#   # Compare two recorded runs, failing if the contender regressed
+#   gz_perf_regression.py compare perf_results/<a>.json perf_results/<b>.json
+
+import argparse
+import datetime
+import glob
+import itertools
+import json
+import math
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+FILE_PATH = os.path.dirname(os.path.realpath(__file__))
+
+
+def current_commit():
+    try:
+        return subprocess.run(
+            ['git', 'rev-parse', '--short', 'HEAD'], cwd=FILE_PATH,
+            check=True, capture_output=True, text=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def add_sample(metrics, name, value, unit, higher_is_better=False):
+    if value is None or math.isnan(value):
+        return
+    metric = metrics.setdefault(name, {
+        'unit': unit, 'higher_is_better': higher_is_better, 'samples': []})
+    metric['samples'].append(value)
+
+
+def run_benchmarks(bin_dir, repetitions, metrics):
+    for executable in sorted(glob.glob(os.path.join(bin_dir, 'BENCHMARK_*'))):
+        with tempfile.TemporaryDirectory() as workdir:
+            out = os.path.join(workdir, 'out.json')
+            print(f'Running {os.path.basename(executable)}', file=sys.stderr)
+            try:
+                subprocess.run(
+                    [executable, f'--benchmark_repetitions={repetitions}',
+                     '--benchmark_out_format=json',
+                     f'--benchmark_out={out}'],
+                    check=True, stdout=subprocess.DEVNULL)
+            except subprocess.CalledProcessError as e:
+                print(f'Failed to run {executable}: {e}', file=sys.stderr)
+                continue
+            with open(out) as f:
+                results = json.load(f)
+        for bench in results.get('benchmarks', []):
+            if bench.get('run_type', 'iteration') != 'iteration':
+                continue
+            add_sample(metrics, 'benchmark/' + bench['name'],
+                       bench['real_time'], bench['time_unit'])
+
+
+def run_worlds(runner, erb, iterations, sweeps, repetitions, metrics):
+    # Imported here, since it needs numpy
+    from gz_perf_sweep import run
+
+    for values in sweeps:
+        name = 'world/' + ','.join(f'{k}={v}' for k, v in values.items())
+        print(f'Running {name}', file=sys.stderr)
+        for _ in range(repetitions):
+            with tempfile.TemporaryDirectory() as workdir:
+                try:
+                    results = run(runner, erb, iterations, values, workdir)
+                except subprocess.CalledProcessError as e:
+                    print(f'Failed to run {name}: {e}', file=sys.stderr)
+                    break
+            add_sample(metrics, name + '/mean_rtf', results['mean_rtf'],
+                       'x', higher_is_better=True)
+            for key in ['step_ms_p50', 'step_ms_p95', 'step_ms_p99']:
+                add_sample(metrics, f'{name}/{key}', results[key], 'ms')
+            add_sample(metrics, name + '/startup_s', results['startup_s'],
+                       's')
+            add_sample(metrics, name + '/max_rss_kb', results['max_rss_kb'],
+                       'kB')
+
+
+def parse_sweep(text):
+    # robots=10,100;props=100 -> all combinations of the values
+    from gz_perf_sweep import PARAMS
+    values = {}
+    for item in text.split(';'):
+        key, vals = item.split('=', 1)
+        if key not in PARAMS:
+            raise argparse.ArgumentTypeError(f'Unknown parameter {key}')
+        values[key] = [int(v) for v in vals.split(',')]
+    return [dict(zip(values.keys(), c))
+            for c in itertools.product(*values.values())]
+
+
+def welch_t(a, b):
+    # Welch's t statistic, or None if there aren't enough samples
+    if len(a) < 2 or len(b) < 2:
+        return None
+    va = statistics.variance(a) / len(a)
+    vb = statistics.variance(b) / len(b)
+    if va + vb == 0:
+        return math.inf if statistics.mean(a) != statistics.mean(b) else 0
+    return (statistics.mean(b) - statistics.mean(a)) / math.sqrt(va + vb)
+
+
+def compare(baseline, contender, threshold, t_threshold):
+    regressions = []
+    improvements = []
+    for name, metric in sorted(contender['metrics'].items()):
+        base = baseline['metrics'].get(name)
+        if base is None or not base['samples'] or not metric['samples']:
+            continue
+        base_median = statistics.median(base['samples'])
+        median = statistics.median(metric['samples'])
+        if base_median == 0:
+            continue
+        change = (median - base_median) / abs(base_median)
+        if metric['higher_is_better']:
+            change = -change
+
+        # With repetitions, the change must also be significant
+        t = welch_t(base['samples'], metric['samples'])
+        significant = t is None or abs(t) >= t_threshold
+
+        entry = (name, base_median, median, change, metric['unit'])
+        if change > threshold and significant:
+            regressions.append(entry)
+        elif change < -threshold and significant:
+            improvements.append(entry)
+    return regressions, improvements
+
+
+def print_report(title, entries):
+    if not entries:
+        return
+    print(f'{title}:')
+    width = max(len(e[0]) for e in entries)
+    for name, base, value, change, unit in entries:
+        print(f'  {name:<{width}}  {base:12.4g} -> {value:12.4g} {unit:<3}'
+              f'  {"worse" if change > 0 else "better"} by '
+              f'{abs(change) * 100:.1f}%')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Record performance results per commit and compare '
+                    'them against a baseline.')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser(
+        'run', help='Run the benchmarks and worlds, and store the results')
+    run_parser.add_argument('--bin-dir', default='./bin',
+                            help='Directory with the BENCHMARK_* and '
+                                 'PERFORMANCE_sdf_runner executables')
+    run_parser.add_argument('--output-dir', default='perf_results')
+    run_parser.add_argument('--commit', default=None,
+                            help='Key of the results, defaults to the '
+                                 'current commit')
+    run_parser.add_argument('--repetitions', type=int, default=5)
+    run_parser.add_argument('--iterations', type=int, default=2000,
+                            help='Iterations of each world')
+    run_parser.add_argument(
+        '--sweep', type=parse_sweep, action='append',
+        help='World parameters, such as "robots=10,100;props=1000". Can be '
+             'repeated. Defaults to a small and a large world')
+    run_parser.add_argument('--skip-benchmarks', action='store_true')
+    run_parser.add_argument('--skip-worlds', action='store_true')
+
+    compare_parser = subparsers.add_parser(
+        'compare', help='Compare results, failing on regressions')
+    compare_parser.add_argument('baseline')
+    compare_parser.add_argument('contender')
+    compare_parser.add_argument(
+        '--threshold', type=float, default=0.1,
+        help='Relative change of the median considered a regression')
+    compare_parser.add_argument(
+        '--t-threshold', type=float, default=3.0,
+        help="Minimum Welch's t statistic for a change to be significant, "
+             'when both runs have repetitions')
+
+    args = parser.parse_args()
+
+    if args.command == 'run':
+        metrics = {}
+        if not args.skip_benchmarks:
+            run_benchmarks(args.bin_dir, args.repetitions, metrics)
+        if not args.skip_worlds:
+            sweeps = list(itertools.chain.from_iterable(args.sweep)) \
+                if args.sweep else [
+                    {'robots': 10, 'links': 5, 'props': 100},
+                    {'robots': 100, 'links': 5, 'levels': 4, 'props': 5000}]
+            run_worlds(
+                os.path.join(args.bin_dir, 'PERFORMANCE_sdf_runner'),
+                os.path.join(FILE_PATH, '..', 'worlds',
+                             'scalable_benchmark.sdf.erb'),
+                args.iterations, sweeps, args.repetitions, metrics)
+
+        commit = args.commit or current_commit()
+        os.makedirs(args.output_dir, exist_ok=True)
+        path = os.path.join(args.output_dir, commit + '.json')
+        with open(path, 'w') as f:
+            json.dump({'commit': commit,
+                       'date': datetime.datetime.now().isoformat(),
+                       'metrics': metrics}, f, indent=2)
+        print(f'Wrote {len(metrics)} metrics to {path}')
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    with open(args.contender) as f:
+        contender = json.load(f)
+
+    regressions, improvements = compare(
+        baseline, contender, args.threshold, args.t_threshold)
+    print(f'Baseline {baseline["commit"]}, contender {contender["commit"]}, '
+          f'threshold {args.threshold * 100:.0f}%')
+    print_report('Regressions', regressions)
+    print_report('Improvements', improvements)
+    if not regressions:
+        print('No regressions')
+        return 0
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
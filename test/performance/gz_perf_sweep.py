@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+# Sweep the parameters of the scalable benchmark world, running each
+# generated world with the sdf_runner and summarizing the results.
+
+import argparse
+import csv
+import itertools
+import os
+import subprocess
+import sys
+import tempfile
+
+import numpy as np
+
+from gz_perf import read_data, compute_rtfs
+
+PARAMS = ['robots', 'links', 'sensors', 'levels', 'props']
+
+
+def int_list(text):
+    return [int(v) for v in text.split(',')]
+
+
+def header_value(header, key):
+    for row in header:
+        if row[0].startswith(f'# {key}:'):
+            return float(row[0].split(':')[1])
+    return float('nan')
+
+
+def run(runner, erb, iterations, values, workdir, verbose=False):
+    world = os.path.join(workdir, 'world.sdf')
+    with open(world, 'w') as sdf:
+        subprocess.run(
+            ['erb'] + [f'{k}={v}' for k, v in values.items()] + [erb],
+            stdout=sdf, check=True)
+
+    use_levels = '1' if values.get('levels', 0) > 0 else '0'
+    subprocess.run(
+        [runner, world, str(iterations), '-1', use_levels],
+        cwd=workdir, check=True,
+        stdout=subprocess.DEVNULL if not verbose else None,
+        stderr=subprocess.DEVNULL if not verbose else None)
+
+    (header, data) = read_data(os.path.join(workdir, 'data.csv'))
+    real_time = data[:, 0] + 1e-9 * data[:, 1]
+    sim_time = data[:, 2] + 1e-9 * data[:, 3]
+    rtfs = compute_rtfs(real_time, sim_time)
+    step_ms = np.diff(real_time) * 1e3
+
+    return {
+        'mean_rtf': np.mean(rtfs),
+        'step_ms_p50': np.percentile(step_ms, 50),
+        'step_ms_p95': np.percentile(step_ms, 95),
+        'step_ms_p99': np.percentile(step_ms, 99),
+        'startup_s': header_value(header, 'Startup s'),
+        'max_rss_kb': header_value(header, 'Max RSS kB'),
+    }
+
+
+if __name__ == '__main__':
+    file_path = os.path.dirname(os.path.realpath(__file__))
+    parser = argparse.ArgumentParser(
+        description='Run the scalable benchmark world for every '
+                    'combination of the given parameters.')
+    parser.add_argument('--runner', default='./PERFORMANCE_sdf_runner',
+                        help='Path to the sdf_runner executable')
+    parser.add_argument('--erb', default=os.path.join(
+        file_path, '..', 'worlds', 'scalable_benchmark.sdf.erb'),
+        help='World template')
+    parser.add_argument('--iterations', type=int, default=2000)
+    parser.add_argument('--robots', type=int_list, default=[10])
+    parser.add_argument('--links', type=int_list, default=[5])
+    parser.add_argument('--sensors', type=int_list, default=[1])
+    parser.add_argument('--levels', type=int_list, default=[0])
+    parser.add_argument('--props', type=int_list, default=[100])
+    parser.add_argument('--output', default='sweep.csv',
+                        help='CSV file with one row per combination')
+    parser.add_argument('--verbose', action='store_true')
+    args = parser.parse_args()
+
+    with open(args.output, 'w', newline='') as out:
+        writer = None
+        for combination in itertools.product(
+                *[getattr(args, p) for p in PARAMS]):
+            values = dict(zip(PARAMS, combination))
+            with tempfile.TemporaryDirectory() as workdir:
+                try:
+                    results = run(args.runner, args.erb, args.iterations,
+                                  values, workdir, args.verbose)
+                except subprocess.CalledProcessError as e:
+                    print(f'Failed to run {values}: {e}', file=sys.stderr)
+                    continue
+            row = {**values, **results}
+            if writer is None:
+                writer = csv.DictWriter(out, fieldnames=list(row.keys()))
+                writer.writeheader()
+            writer.writerow(row)
+            out.flush()
+            print(', '.join(f'{k}: {v:.4g}' if isinstance(v, float)
+                            else f'{k}: {v}' for k, v in row.items()))
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/Stopwatch.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/sim/Server.hh"
+#include "gz/sim/ServerConfig.hh"
+#include "gz/sim/components/Link.hh"
+#include "gz/sim/components/Pose.hh"
+#include "gz/sim/components/LinearVelocity.hh"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "../helpers/Relay.hh"
+
+using namespace gz;
+using namespace sim;
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with free falling models, each with a canonical
+/// link and a child link attached by a revolute joint, so that every physics
+/// step writes back the poses of all links and models.
+/// \param[in] _models Number of models.
+/// \return The world SDF.
+std::string fallingModelsWorld(int _models)
+{
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='physics_write_back'>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "<real_time_factor>0</real_time_factor>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-physics-system'"
+      << " name='gz::sim::systems::Physics'/>";
+
+  const int side = 100;
+  for (int i = 0; i < _models; ++i)
+  {
+    // Spread the models out so they never collide
+    sdf << "<model name='model_" << i << "'>"
+        << "<pose>" << (i % side) * 2.0 << " " << (i / side) * 2.0
+        << " 10 0 0 0</pose>"
+        << "<link name='base'><inertial><mass>1</mass></inertial></link>"
+        << "<link name='arm'><pose>0 0 0.5 0 0 0</pose>"
+        << "<inertial><mass>0.1</mass></inertial></link>"
+        << "<joint name='hinge' type='revolute'>"
+        << "<parent>base</parent><child>arm</child>"
+        << "<axis><xyz>1 0 0</xyz></axis>"
+        << "</joint>"
+        << "</model>";
+  }
+  sdf << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+// Measures the cost of a physics step in a world with 10k moving links, which
+// is dominated by writing the results back to the ECM.
+TEST(PhysicsWriteBackPerformance,
+     GZ_UTILS_TEST_DISABLED_ON_WIN32(LargeWorld))
+{
+  using namespace std::chrono;
+
+  common::Console::SetVerbosity(3);
+  common::setenv("GZ_SIM_SYSTEM_PLUGIN_PATH",
+         (std::string(PROJECT_BINARY_PATH) + "/lib").c_str());
+
+  const int models = 5000;
+  const std::size_t iters = 200;
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(fallingModelsWorld(models));
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(0ns);
+
+  // Request velocities for half of the links, so that the optional
+  // components are written back too
+  test::Relay testSystem;
+  int linkCount{0};
+  bool requested{false};
+  testSystem.OnPreUpdate(
+      [&](const UpdateInfo &, EntityComponentManager &_ecm)
+      {
+        if (requested)
+          return;
+        requested = true;
+
+        _ecm.Each<components::Link>(
+            [&](const Entity &_entity, const components::Link *) -> bool
+            {
+              if (linkCount++ % 2 == 0)
+                _ecm.CreateComponent(_entity, components::LinearVelocity());
+              return true;
+            });
+      });
+
+  double firstZ{0.0};
+  double lastZ{0.0};
+  testSystem.OnPostUpdate(
+      [&](const UpdateInfo &_info, const EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Link, components::LinearVelocity>(
+            [&](const Entity &, const components::Link *,
+                const components::LinearVelocity *_vel) -> bool
+            {
+              if (_info.iterations == 1)
+                firstZ = _vel->Data().Z();
+              lastZ = _vel->Data().Z();
+              return false;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  // Load the world and create the physics entities before measuring
+  server.Run(true, 1, false);
+  EXPECT_EQ(2 * models, linkCount);
+
+  math::Stopwatch watch;
+  watch.Start(true);
+  server.Run(true, iters, false);
+  watch.Stop();
+
+  const auto duration = watch.ElapsedRunTime();
+  gzdbg << "\nLinks: " << linkCount << "\n"
+        << "Iterations: " << iters << "\n"
+        << "Total: " << duration_cast<milliseconds>(duration).count()
+        << " ms\n"
+        << "Per iteration: "
+        << duration_cast<microseconds>(duration).count() /
+           static_cast<double>(iters) << " us\n";
+
+  // The models fall, so the velocities were written back on every step
+  EXPECT_LT(lastZ, firstZ);
+}
@@ -16,6 +16,11 @@
  */
 
 #include <array>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 #include <gz/msgs/clock.pb.h>
 #include <gz/msgs/world_stats.pb.h>
@@ -58,6 +63,13 @@ int main(int _argc, char** _argv)
   }
   gzdbg << "Update rate: " << updateRate << std::endl;
 
+  bool useLevels{false};
+  if (_argc >= 5)
+  {
+    useLevels = atoi(_argv[4]) != 0;
+  }
+  gzdbg << "Levels: " << useLevels << std::endl;
+
   ServerConfig serverConfig;
   if (!serverConfig.SetSdfFile(sdfFile))
   {
@@ -69,8 +81,13 @@ int main(int _argc, char** _argv)
   if (updateRate > 0.0)
     serverConfig.SetUpdateRate(updateRate);
 
-  // Create the Gazebo server
+  serverConfig.SetUseLevels(useLevels);
+
+  // Create the Gazebo server, which loads the world and its systems
+  math::Stopwatch startupWatch;
+  startupWatch.Start();
   Server server(serverConfig);
+  startupWatch.Stop();
 
   transport::Node node;
 
@@ -108,6 +125,14 @@ int main(int _argc, char** _argv)
   ofs << "# Filename: " << sdfFile << std::endl;
   ofs << "# Iterations: " << iterations << std::endl;
   ofs << "# Rate: " << updateRate << std::endl;
+  ofs << "# Startup s: " << std::chrono::duration<double>(
+      startupWatch.ElapsedRunTime()).count() << std::endl;
+#ifndef _WIN32
+  // Peak resident memory of the process, in kilobytes on Linux
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    ofs << "# Max RSS kB: " << usage.ru_maxrss << std::endl;
+#endif
   ofs << "# Real s, Real ns, sim s, sim ns" << std::endl;
 
   for (auto &msg : msgs)
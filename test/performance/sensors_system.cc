@@ -22,7 +22,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <sstream>
+#include <string>
+
 #include <gz/common/Console.hh>
+#include <gz/math/Stopwatch.hh>
 #include <gz/rendering/RenderingIface.hh>
 
 #include <gz/utils/ExtraTestMacros.hh>
@@ -134,3 +139,106 @@ TEST_F(SensorsSystemFixture, GZ_UTILS_TEST_DISABLED_ON_MAC(MemLeak))
     EXPECT_LT(sharePercentChange, shareMaxPercentChange);
   }
 }
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with static models that each carry a GPU lidar
+/// with the same configuration, so the Sensors system can batch them.
+/// \param[in] _lidars Number of lidars.
+/// \param[in] _batch Value of the Sensors system's <batch_sensors>.
+/// \return The world SDF.
+std::string lidarsWorld(int _lidars, bool _batch)
+{
+  std::stringstream sdf;
+  sdf << "<?xml version='1.0'?>"
+      << "<sdf version='1.6'>"
+      << "<world name='lidars'>"
+      << "<physics name='10ms' type='ode'>"
+      << "<max_step_size>0.01</max_step_size>"
+      << "<real_time_factor>0</real_time_factor>"
+      << "</physics>"
+      << "<plugin filename='gz-sim-sensors-system'"
+      << " name='gz::sim::systems::Sensors'>"
+      << "<render_engine>ogre2</render_engine>"
+      << "<honor_always_on>true</honor_always_on>"
+      << "<batch_sensors>" << (_batch ? "true" : "false")
+      << "</batch_sensors>"
+      << "</plugin>"
+      << "<model name='ground'><static>true</static>"
+      << "<link name='link'><visual name='visual'><geometry>"
+      << "<box><size>1000 1000 0.1</size></box>"
+      << "</geometry></visual></link></model>";
+
+  for (int i = 0; i < _lidars; ++i)
+  {
+    sdf << "<model name='robot_" << i << "'><static>true</static>"
+        << "<pose>" << (i % 10) * 3.0 << " " << (i / 10) * 3.0
+        << " 0.5 0 0 0</pose>"
+        << "<link name='link'>"
+        << "<visual name='visual'><geometry>"
+        << "<box><size>0.5 0.5 0.5</size></box>"
+        << "</geometry></visual>"
+        << "<sensor name='lidar' type='gpu_lidar'>"
+        << "<pose>0 0 0.5 0 0 0</pose>"
+        << "<topic>lidar_" << i << "</topic>"
+        << "<always_on>true</always_on>"
+        << "<update_rate>10</update_rate>"
+        << "<lidar><scan>"
+        << "<horizontal><samples>640</samples><resolution>1</resolution>"
+        << "<min_angle>-3.14</min_angle><max_angle>3.14</max_angle>"
+        << "</horizontal>"
+        << "<vertical><samples>16</samples><resolution>1</resolution>"
+        << "<min_angle>-0.26</min_angle><max_angle>0.26</max_angle>"
+        << "</vertical>"
+        << "</scan>"
+        << "<range><min>0.1</min><max>30</max></range>"
+        << "</lidar>"
+        << "</sensor>"
+        << "</link></model>";
+  }
+  sdf << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+// Measures the rendering throughput of the Sensors system as the number of
+// GPU lidars grows, with and without batching compatible lidars.
+TEST_F(SensorsSystemFixture,
+       GZ_UTILS_TEST_DISABLED_ON_MAC(LidarThroughput))
+{
+  using namespace std::chrono;
+  gz::common::Console::SetVerbosity(3);
+
+  // 10 lidar updates for each world
+  const std::size_t iters = 100;
+
+  for (int lidars : {1, 10, 50})
+  {
+    for (bool batch : {false, true})
+    {
+      gz::sim::ServerConfig serverConfig;
+      serverConfig.SetSdfString(lidarsWorld(lidars, batch));
+
+      gz::sim::Server server(serverConfig);
+      server.SetUpdatePeriod(0ns);
+
+      // Load the world and create the sensors before measuring
+      server.Run(true, 1, false);
+
+      gz::math::Stopwatch watch;
+      watch.Start(true);
+      server.Run(true, iters, false);
+      watch.Stop();
+
+      const auto elapsed = watch.ElapsedRunTime();
+      const double seconds = duration_cast<duration<double>>(elapsed).count();
+      const double scans = lidars * iters / 10.0;
+      gzdbg << "\nLidars: " << lidars << "\n"
+            << "Batched: " << (batch ? "yes" : "no") << "\n"
+            << "Total: " << duration_cast<milliseconds>(elapsed).count()
+            << " ms\n"
+            << "Scans per second: " << scans / seconds << "\n";
+
+      EXPECT_EQ(iters + 1, *server.IterationCount());
+    }
+  }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/serialized.pb.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/sim/EntityComponentManager.hh"
+#include "gz/sim/Server.hh"
+#include "gz/sim/System.hh"
+
+using namespace gz;
+using namespace sim;
+
+namespace
+{
+/// \brief Add bytes to a 64-bit FNV-1a hash.
+/// \param[in] _data The bytes.
+/// \param[in] _size Number of bytes.
+/// \param[in, out] _hash The hash.
+void hashBytes(const void *_data, std::size_t _size, std::uint64_t &_hash)
+{
+  const auto *bytes = static_cast<const unsigned char *>(_data);
+  for (std::size_t i = 0; i < _size; ++i)
+  {
+    _hash ^= bytes[i];
+    _hash *= 1099511628211ull;
+  }
+}
+
+/// \brief Writes a hash of the whole ECM state after every step. Entities
+/// and components are hashed in a fixed order, so the hash doesn't depend
+/// on the order of the containers of the ECM.
+class StateHasher : public System, public ISystemPostUpdate
+{
+  /// \brief Constructor.
+  /// \param[in] _path File to write the hashes to.
+  public: explicit StateHasher(const std::string &_path)
+    : out(_path)
+  {
+  }
+
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm) override
+  {
+    if (_info.paused)
+      return;
+
+    const auto state = _ecm.State();
+    std::vector<const msgs::SerializedEntity *> entities;
+    for (const auto &entity : state.entities())
+      entities.push_back(&entity);
+    std::sort(entities.begin(), entities.end(),
+        [](const auto *_a, const auto *_b) { return _a->id() < _b->id(); });
+
+    std::uint64_t hash{14695981039346656037ull};
+    std::vector<const msgs::SerializedComponent *> components;
+    for (const auto *entity : entities)
+    {
+      const std::uint64_t id = entity->id();
+      hashBytes(&id, sizeof(id), hash);
+
+      components.clear();
+      for (const auto &component : entity->components())
+        components.push_back(&component);
+      std::sort(components.begin(), components.end(),
+          [](const auto *_a, const auto *_b)
+          {
+            return _a->type() < _b->type();
+          });
+      for (const auto *component : components)
+      {
+        const std::uint64_t type = component->type();
+        hashBytes(&type, sizeof(type), hash);
+        hashBytes(component->component().data(),
+            component->component().size(), hash);
+      }
+    }
+
+    this->out << _info.iterations << " " << std::hex << std::setw(16)
+              << std::setfill('0') << hash << std::dec << "\n";
+  }
+
+  /// \brief File the hashes are written to.
+  private: std::ofstream out;
+};
+}
+
+//////////////////////////////////////////////////
+/// \brief Run a world in deterministic mode and write the hash of the ECM
+/// state after each step, to compare runs with different numbers of
+/// threads with gz_determinism_check.py.
+int main(int _argc, char **_argv)
+{
+  if (_argc < 4)
+  {
+    std::cerr << "Usage: " << _argv[0]
+              << " <sdf file> <iterations> <output file>" << std::endl;
+    return -1;
+  }
+  common::Console::SetVerbosity(1);
+
+  ServerConfig serverConfig;
+  if (!serverConfig.SetSdfFile(_argv[1]))
+  {
+    gzerr << "Failed to set SDF file [" << _argv[1] << "]" << std::endl;
+    return -1;
+  }
+  serverConfig.SetDeterministic(true);
+
+  Server server(serverConfig);
+  if (!server.AddSystem(std::make_shared<StateHasher>(_argv[3])).value_or(
+      false))
+  {
+    gzerr << "Failed to add the state hasher" << std::endl;
+    return -1;
+  }
+  server.Run(true, static_cast<uint64_t>(std::atoll(_argv[2])), false);
+  return 0;
+}